@@ -5,7 +5,14 @@
  */
 #include "app.h"
 #include "hal/hal.h"
+#include "shared/shared.h"
 #include "apps/app_installer.h"
+#include "apps/utils/ui/activity.h"
+#include "apps/utils/ui/anim_clock.h"
+#include "apps/utils/audio/audio.h"
+#include "apps/utils/background/jobs.h"
+#include "apps/utils/memory/frame_arena.h"
+#include "assets/image_decoder.h"
 #include <mooncake.h>
 #include <mooncake_log.h>
 #include <string>
@@ -14,6 +21,7 @@
 using namespace mooncake;
 
 static const std::string _tag = "app";
+static bool _is_done          = false;
 
 void app::Init(InitCallback_t callback)
 {
@@ -25,25 +33,51 @@ void app::Init(InitCallback_t callback)
     }
 
     GetMooncake();
+    // Label text and the like for one frame, small and read on the render path, so internal RAM
+    memory::get_frame_arena().init(8 * 1024, hal::HalBase::MEMORY_INTERNAL);
+    ui::activity::init();
+    ui::anim_clock::init();
+    assets::init_image_decoder();
+    audio::init_sound_bank();
 
+    // Installs the apps too, once the hardware is up
     on_startup_anim();
-    on_install_apps();
 }
 
 void app::Update()
 {
+    // Watched by the stall monitor, up to the wait for the next update
+    GetHAL()->markUiSection(hal::HalBase::UI_SECTION_APP_UPDATE, true);
+    memory::get_frame_arena().reset();
+    // Every animation of the frame steps to this instant
+    ui::anim_clock::begin_frame();
+
+    // Events published by HAL tasks and callbacks of finished jobs since the last frame, handed out before the apps
+    // update
+    GetEventBus().dispatch();
+    background::dispatch_done_jobs();
     GetMooncake().update();
 
-#if defined(__APPLE__) && defined(__MACH__)
+#if defined(__APPLE__) && defined(__MACH__) && !defined(PLATFORM_DESKTOP_HEADLESS)
     // 'nextEventMatchingMask should only be called from the Main Thread!'
     auto time_till_next = lv_timer_handler();
     std::this_thread::sleep_for(std::chrono::milliseconds(time_till_next));
 #endif
+
+    GetHAL()->markUiSection(hal::HalBase::UI_SECTION_APP_UPDATE, false);
+    // Full rate while the UI animates, otherwise sleep until an input or HAL event
+    ui::activity::wait_for_next_update();
 }
 
 bool app::IsDone()
 {
-    return false;
+    return _is_done;
+}
+
+void app::Quit()
+{
+    mclog::tagInfo(_tag, "quit");
+    _is_done = true;
 }
 
 void app::Destroy()
@@ -38,6 +38,12 @@ void Update();
  */
 bool IsDone();
 
+/**
+ * @brief Make IsDone() return true, for runs that end on their own like the headless benchmark
+ *
+ */
+void Quit();
+
 /**
  * @brief
  *
@@ -0,0 +1,453 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "app_benchmark.h"
+#include <app.h>
+#include <hal/hal.h>
+#include <mooncake.h>
+#include <mooncake_log.h>
+#include <apps/utils/ui/toast.h>
+#include <apps/utils/ui/activity.h>
+#include <lvgl.h>
+#include <lv_demos.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#if LV_USE_PERF_MONITOR
+#include <src/display/lv_display_private.h>
+#endif
+
+using namespace mooncake;
+
+static const std::string _tag = "benchmark";
+
+// Launcher buttons that open a window, offsets from the screen center like the panel layouts
+struct WindowButton_t {
+    const char* name;
+    int16_t x;
+    int16_t y;
+};
+static const WindowButton_t _window_buttons[] = {
+    {"rtc_setting", 422, -228},        {"wifi_ap", -309, -187},           {"power_off", 562, -319},
+    {"sleep_touch_wakeup", 562, -245}, {"sleep_shake_wakeup", 562, -172}, {"sleep_rtc_wakeup", 562, -98},
+    {"camera", 598, 10},               {"dual_mic", -154, -311},          {"headphone", -310, 301},
+    {"sd_card", -46, 300},             {"i2c_scan", -505, 229},           {"gpio", 413, -115},
+    {"music", 225, 279},               {"com_monitor", 497, 5},
+};
+
+// Bottom left corner, no opened window reaches it, so a tap there hits the window background close area
+static constexpr int16_t _close_tap_x = -630;
+static constexpr int16_t _close_tap_y = 350;
+
+static constexpr uint32_t _idle_duration        = 3000;
+static constexpr uint32_t _window_duration      = 2500;
+static constexpr uint32_t _window_close_time    = 1200;
+static constexpr uint32_t _toast_storm_duration = 5000;
+static constexpr uint32_t _toast_storm_interval = 100;
+static constexpr uint32_t _toast_storm_count    = 30;
+
+// Recorded with startInputRecord(), replayed after the scripted scenarios when present
+static const char* _input_replay_path = "bench_input.trace";
+
+// Full screen refreshes forced one after another, the flush has no render cache to hide behind
+static constexpr int _flush_frames = 30;
+
+#if LV_USE_DEMO_BENCHMARK
+static std::atomic<bool> _lvgl_benchmark_done{false};
+static lv_demo_benchmark_summary_t _lvgl_benchmark_summary;
+
+// Called from the LVGL task once the last scene is measured
+static void on_lvgl_benchmark_end(const lv_demo_benchmark_summary_t* summary)
+{
+    _lvgl_benchmark_summary = *summary;
+    _lvgl_benchmark_done    = true;
+}
+#endif
+
+static int64_t now_us()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// Time spent in the flush callbacks and waiting for the flushes to finish, summed over the forced refreshes
+struct FlushTiming_t {
+    int64_t markUs      = 0;
+    int64_t flushUs     = 0;
+    int64_t flushWaitUs = 0;
+    uint32_t flushes    = 0;
+};
+static FlushTiming_t _flush_timing;
+
+static void on_flush_event(lv_event_t* e)
+{
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_FLUSH_START:
+        case LV_EVENT_FLUSH_WAIT_START:
+            _flush_timing.markUs = now_us();
+            break;
+        case LV_EVENT_FLUSH_FINISH:
+            _flush_timing.flushUs += now_us() - _flush_timing.markUs;
+            _flush_timing.flushes++;
+            break;
+        case LV_EVENT_FLUSH_WAIT_FINISH:
+            _flush_timing.flushWaitUs += now_us() - _flush_timing.markUs;
+            break;
+        default:
+            break;
+    }
+}
+
+static void print_json(const std::string& json)
+{
+    // One line per record, the prefix lets scripts pick them out of the log
+    std::printf("BENCHMARK %s\n", json.c_str());
+    std::fflush(stdout);
+}
+
+static void tap(int16_t x, int16_t y)
+{
+    lv_obj_t* screen = lv_screen_active();
+    lv_point_t point = {lv_obj_get_width(screen) / 2 + x, lv_obj_get_height(screen) / 2 + y};
+
+    lv_obj_t* obj = lv_indev_search_obj(screen, &point);
+    while (obj && !lv_obj_has_flag(obj, LV_OBJ_FLAG_CLICKABLE)) {
+        obj = lv_obj_get_parent(obj);
+    }
+    if (obj == nullptr || obj == screen) {
+        mclog::tagWarn(_tag, "nothing to tap at ({}, {})", x, y);
+        return;
+    }
+    lv_obj_send_event(obj, LV_EVENT_CLICKED, nullptr);
+}
+
+AppBenchmark::AppBenchmark()
+{
+    setAppInfo().name = "AppBenchmark";
+}
+
+void AppBenchmark::onCreate()
+{
+    mclog::tagInfo(getAppInfo().name, "on create");
+
+    open();
+}
+
+void AppBenchmark::onOpen()
+{
+    mclog::tagInfo(getAppInfo().name, "on open");
+    GetHAL()->setPowerProfileApp(getAppInfo().name);
+
+    create_scenarios();
+    start_lvgl_benchmark();
+}
+
+void AppBenchmark::onRunning()
+{
+    // Measure with the app loop at full rate, like a user interacting with the UI
+    ui::activity::keep_awake();
+
+    switch (_state) {
+        case State_LvglBenchmark: {
+#if LV_USE_DEMO_BENCHMARK
+            if (!_lvgl_benchmark_done) {
+                break;
+            }
+            auto& s = _lvgl_benchmark_summary;
+            print_json(fmt::format(
+                "{{\"type\":\"lvgl_benchmark\",\"platform\":\"{}\",\"fps\":{},\"cpu\":{},\"render_ms\":{},"
+                "\"flush_ms\":{},\"scenes\":{}}}",
+                GetHAL()->type(), s.total_avg_fps, s.total_avg_cpu, s.total_avg_render_time, s.total_avg_flush_time,
+                s.valid_scene_cnt));
+#endif
+            start_launcher_scenarios();
+            break;
+        }
+        case State_LauncherScenarios: {
+            _launcher_view->update();
+
+            LvglLockGuard lock;
+            auto& scenario   = _scenarios[_scenario_index];
+            uint32_t elapsed = GetHAL()->millis() - _scenario_start_time;
+            while (_step_index < scenario.steps.size() && elapsed >= scenario.steps[_step_index].timeMs) {
+                scenario.steps[_step_index].action();
+                _step_index++;
+            }
+            sample_perf();
+
+            if (elapsed >= scenario.durationMs) {
+                report_scenario(scenario.name, scenario.durationMs);
+                _scenario_index++;
+                if (_scenario_index < _scenarios.size()) {
+                    start_scenario();
+                } else {
+                    start_input_replay();
+                }
+            }
+            break;
+        }
+        case State_InputReplay: {
+            _launcher_view->update();
+
+            LvglLockGuard lock;
+            sample_perf();
+            auto status = GetHAL()->getInputTraceStatus();
+            if (status.state == hal::HalBase::INPUT_TRACE_REPLAYING) {
+                break;
+            }
+            report_scenario("input_replay", GetHAL()->millis() - _scenario_start_time);
+            run_math_benchmark();
+            break;
+        }
+        case State_HalBenchmark: {
+            _launcher_view->update();
+
+            auto result = GetHAL()->getHalBenchmarkResult();
+            if (result.state == hal::HalBase::HAL_BENCHMARK_RUNNING) {
+                break;
+            }
+            for (const auto& r : result.records) {
+                print_json(fmt::format("{{\"type\":\"hal_benchmark\",\"platform\":\"{}\",\"group\":\"{}\","
+                                       "\"name\":\"{}\",\"unit\":\"{}\",\"value\":{:.3f},\"max\":{:.3f}}}",
+                                       GetHAL()->type(), r.group, r.name, r.unit, r.value, r.maxValue));
+            }
+            start_sd_card_benchmark();
+            break;
+        }
+        case State_SdCardBenchmark: {
+            _launcher_view->update();
+
+            auto result = GetHAL()->getSdCardBenchmarkResult();
+            if (result.state == hal::HalBase::SD_BENCHMARK_RUNNING) {
+                break;
+            }
+            if (result.state == hal::HalBase::SD_BENCHMARK_DONE) {
+                print_json(fmt::format("{{\"type\":\"sd_benchmark\",\"platform\":\"{}\",\"bus_khz\":{},\"ddr\":{},"
+                                       "\"seq_write_mbps\":{:.2f},\"seq_read_mbps\":{:.2f},\"rand_write_iops\":{:.0f},"
+                                       "\"rand_read_iops\":{:.0f}}}",
+                                       GetHAL()->type(), result.busFreqKhz, result.isDdr, result.seqWriteMBps,
+                                       result.seqReadMBps, result.randWriteIops, result.randReadIops));
+            } else {
+                print_json(fmt::format("{{\"type\":\"sd_benchmark\",\"platform\":\"{}\",\"error\":\"{}\"}}",
+                                       GetHAL()->type(), result.error));
+            }
+            finish();
+            break;
+        }
+        case State_Done: {
+            _launcher_view->update();
+            break;
+        }
+    }
+}
+
+void AppBenchmark::onClose()
+{
+    mclog::tagInfo(getAppInfo().name, "on close");
+    GetHAL()->setPowerProfileApp("");
+
+    _launcher_view.reset();
+}
+
+void AppBenchmark::start_lvgl_benchmark()
+{
+#if LV_USE_DEMO_BENCHMARK
+    mclog::tagInfo(_tag, "start lvgl benchmark");
+
+    LvglLockGuard lock;
+    _lvgl_benchmark_done = false;
+    lv_demo_benchmark_set_end_cb(on_lvgl_benchmark_end);
+    lv_demo_benchmark();
+#else
+    mclog::tagWarn(_tag, "lvgl benchmark demo not enabled, skip");
+#endif
+    _state = State_LvglBenchmark;
+}
+
+void AppBenchmark::start_launcher_scenarios()
+{
+    mclog::tagInfo(_tag, "start launcher scenarios");
+
+    {
+        // The benchmark leaves its scenes and styles on the screen, start the launcher on a fresh one
+        LvglLockGuard lock;
+        lv_obj_t* old_screen = lv_screen_active();
+        lv_screen_load(lv_obj_create(nullptr));
+        lv_obj_delete(old_screen);
+    }
+
+    _launcher_view = std::make_unique<launcher_view::LauncherView>();
+    _launcher_view->init();
+
+    _scenario_index = 0;
+    start_scenario();
+    _state = State_LauncherScenarios;
+}
+
+void AppBenchmark::create_scenarios()
+{
+    _scenarios.clear();
+
+    _scenarios.push_back({"launcher_idle", _idle_duration, {}});
+
+    for (const auto& button : _window_buttons) {
+        Scenario_t scenario;
+        scenario.name       = fmt::format("window_{}", button.name);
+        scenario.durationMs = _window_duration;
+        scenario.steps.push_back({0, [button]() { tap(button.x, button.y); }});
+        scenario.steps.push_back({_window_close_time, []() { tap(_close_tap_x, _close_tap_y); }});
+        _scenarios.push_back(scenario);
+    }
+
+    Scenario_t toast_storm;
+    toast_storm.name       = "toast_storm";
+    toast_storm.durationMs = _toast_storm_duration;
+    for (uint32_t i = 0; i < _toast_storm_count; i++) {
+        toast_storm.steps.push_back({i * _toast_storm_interval, [i]() {
+                                         ui::pop_a_toast(fmt::format("Toast storm {}", i),
+                                                         static_cast<ui::toast_type::Type_t>(i % 8), 800);
+                                     }});
+    }
+    _scenarios.push_back(toast_storm);
+}
+
+void AppBenchmark::start_scenario()
+{
+    mclog::tagInfo(_tag, "scenario: {}", _scenarios[_scenario_index].name);
+
+    _step_index          = 0;
+    _scenario_start_time = GetHAL()->millis();
+    _perf                = PerfAccumulator_t();
+#if LV_USE_PERF_MONITOR
+    _perf.lastRunCount = lv_display_get_default()->perf_sysmon_info.calculated.run_cnt;
+#endif
+}
+
+void AppBenchmark::sample_perf()
+{
+#if LV_USE_PERF_MONITOR
+    // Sysmon publishes a new sample every perf period, take each one once
+    const auto& perf = lv_display_get_default()->perf_sysmon_info.calculated;
+    if (perf.run_cnt == _perf.lastRunCount) {
+        return;
+    }
+    _perf.lastRunCount = perf.run_cnt;
+    _perf.samples++;
+    _perf.fps += perf.fps;
+    _perf.cpu += perf.cpu;
+    _perf.refrTime += perf.refr_avg_time;
+    _perf.renderTime += perf.render_avg_time;
+    _perf.flushTime += perf.flush_avg_time;
+#endif
+}
+
+void AppBenchmark::report_scenario(const std::string& name, uint32_t durationMs)
+{
+    uint32_t n = _perf.samples ? _perf.samples : 1;
+    print_json(fmt::format("{{\"type\":\"scenario\",\"platform\":\"{}\",\"name\":\"{}\",\"duration_ms\":{},"
+                           "\"samples\":{},\"fps\":{},\"cpu\":{},\"refr_ms\":{},\"render_ms\":{},\"flush_ms\":{}}}",
+                           GetHAL()->type(), name, durationMs, _perf.samples, _perf.fps / n, _perf.cpu / n,
+                           _perf.refrTime / n, _perf.renderTime / n, _perf.flushTime / n));
+}
+
+void AppBenchmark::start_input_replay()
+{
+    // The toast storm leaves the launcher on its home page, a trace recorded from there lines up
+    if (!GetHAL()->startInputReplay(_input_replay_path)) {
+        mclog::tagWarn(_tag, "no input trace {}, skip replay", _input_replay_path);
+        run_math_benchmark();
+        return;
+    }
+    mclog::tagInfo(_tag, "scenario: input_replay");
+
+    _scenario_start_time = GetHAL()->millis();
+    _perf                = PerfAccumulator_t();
+#if LV_USE_PERF_MONITOR
+    _perf.lastRunCount = lv_display_get_default()->perf_sysmon_info.calculated.run_cnt;
+#endif
+    _state = State_InputReplay;
+}
+
+// Synchronous, a few tens of ms with the UI idle between scenarios
+void AppBenchmark::run_math_benchmark()
+{
+    auto results = GetHAL()->runMathBenchmark();
+    for (const auto& r : results) {
+        print_json(fmt::format("{{\"type\":\"math_benchmark\",\"platform\":\"{}\",\"name\":\"{}\","
+                               "\"scalar_ns\":{:.2f},\"batch_ns\":{:.2f},\"max_error\":{:.3g}}}",
+                               GetHAL()->type(), r.name, r.scalarNsPerElement, r.batchNsPerElement, r.maxError));
+    }
+    if (results.empty()) {
+        mclog::tagWarn(_tag, "math benchmark not available, skip");
+    }
+    run_flush_benchmark();
+    start_hal_benchmark();
+}
+
+// Synchronous, the forced refreshes take well under a second. The caller holds the LVGL lock, onRunning() takes it
+// for the stages that chain here and a second guard would deadlock on the desktop mutex
+void AppBenchmark::run_flush_benchmark()
+{
+    mclog::tagInfo(_tag, "start lvgl flush benchmark");
+
+    lv_display_t* display = lv_display_get_default();
+    _flush_timing         = FlushTiming_t();
+    lv_display_add_event_cb(display, on_flush_event, LV_EVENT_ALL, nullptr);
+
+    int64_t refr_total_us = 0;
+    int64_t refr_max_us   = 0;
+    for (int i = 0; i < _flush_frames; i++) {
+        lv_obj_invalidate(lv_screen_active());
+        int64_t start = now_us();
+        lv_refr_now(display);
+        int64_t us = now_us() - start;
+        refr_total_us += us;
+        refr_max_us = std::max(refr_max_us, us);
+    }
+    lv_display_remove_event_cb_with_user_data(display, on_flush_event, nullptr);
+
+    // A flush still in flight at the end is waited for by the next refresh, the averages are per frame
+    auto& t = _flush_timing;
+    print_json(fmt::format("{{\"type\":\"lvgl_flush\",\"platform\":\"{}\",\"frames\":{},\"flushes\":{},"
+                           "\"refr_ms\":{:.3f},\"refr_max_ms\":{:.3f},\"flush_ms\":{:.3f},\"flush_wait_ms\":{:.3f}}}",
+                           GetHAL()->type(), _flush_frames, t.flushes, refr_total_us / 1000.0 / _flush_frames,
+                           refr_max_us / 1000.0, t.flushUs / 1000.0 / _flush_frames,
+                           t.flushWaitUs / 1000.0 / _flush_frames));
+}
+
+void AppBenchmark::start_hal_benchmark()
+{
+    if (!GetHAL()->startHalBenchmark()) {
+        mclog::tagWarn(_tag, "hal benchmark not available, skip");
+        start_sd_card_benchmark();
+        return;
+    }
+    mclog::tagInfo(_tag, "start hal benchmark");
+    _state = State_HalBenchmark;
+}
+
+void AppBenchmark::start_sd_card_benchmark()
+{
+    if (!GetHAL()->startSdCardBenchmark(hal::HalBase::SdCardBenchmarkConfig_t())) {
+        mclog::tagWarn(_tag, "sd card benchmark not available, skip");
+        finish();
+        return;
+    }
+    mclog::tagInfo(_tag, "start sd card benchmark");
+    _state = State_SdCardBenchmark;
+}
+
+void AppBenchmark::finish()
+{
+    print_json(fmt::format("{{\"type\":\"done\",\"platform\":\"{}\"}}", GetHAL()->type()));
+    ui::pop_a_toast("Benchmark done", ui::toast_type::success);
+    _state = State_Done;
+#ifdef APP_BENCHMARK_QUIT
+    // Headless runs end with the last record
+    app::Quit();
+#endif
+}
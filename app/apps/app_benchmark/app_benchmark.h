@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <mooncake.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include <stdint.h>
+#include <apps/app_launcher/view/view.h>
+
+/**
+ * @brief Runs the LVGL benchmark, then scripted launcher scenarios, and prints the results as JSON lines
+ *
+ */
+class AppBenchmark : public mooncake::AppAbility {
+public:
+    AppBenchmark();
+
+    void onCreate() override;
+    void onOpen() override;
+    void onRunning() override;
+    void onClose() override;
+
+private:
+    enum State_t {
+        State_LvglBenchmark = 0,
+        State_LauncherScenarios,
+        State_InputReplay,
+        State_HalBenchmark,
+        State_SdCardBenchmark,
+        State_Done,
+    };
+
+    // A step runs once at its time offset from the scenario start
+    struct Step_t {
+        uint32_t timeMs;
+        std::function<void()> action;
+    };
+
+    struct Scenario_t {
+        std::string name;
+        uint32_t durationMs;
+        std::vector<Step_t> steps;
+    };
+
+    struct PerfAccumulator_t {
+        uint32_t lastRunCount = 0;
+        uint32_t samples      = 0;
+        uint64_t fps          = 0;
+        uint64_t cpu          = 0;
+        uint64_t refrTime     = 0;
+        uint64_t renderTime   = 0;
+        uint64_t flushTime    = 0;
+    };
+
+    State_t _state = State_LvglBenchmark;
+    std::unique_ptr<launcher_view::LauncherView> _launcher_view;
+    std::vector<Scenario_t> _scenarios;
+    size_t _scenario_index        = 0;
+    size_t _step_index            = 0;
+    uint32_t _scenario_start_time = 0;
+    PerfAccumulator_t _perf;
+
+    void start_lvgl_benchmark();
+    void start_launcher_scenarios();
+    void create_scenarios();
+    void start_scenario();
+    void sample_perf();
+    void report_scenario(const std::string& name, uint32_t durationMs);
+    void start_input_replay();
+    void run_math_benchmark();
+    void run_flush_benchmark();
+    void start_hal_benchmark();
+    void start_sd_card_benchmark();
+    void finish();
+};
@@ -7,9 +7,13 @@
 #include <mooncake.h>
 #include <memory>
 #include <hal/hal.h>
+#include <shared/shared.h>
+#include "utils/ui/activity.h"
+#include <assets/font_engine.h>
 #include "app_template/app_template.h"
 #include "app_launcher/app_launcher.h"
 #include "app_startup_anim/app_startup_anim.h"
+#include "app_benchmark/app_benchmark.h"
 /* Header files locator (Don't remove) */
 
 // Start boot anim app and wait for it to finish
@@ -19,6 +23,15 @@ inline void on_startup_anim()
     mooncake::GetMooncake().openApp(app_id);
     while (1) {
         mooncake::GetMooncake().update();
+        // The hardware finishes booting under the animation, the apps are installed then and build their first
+        // frames behind it
+        if (!GetBootState().isAppsInstalled && GetHAL()->isBootDone()) {
+            ui::activity::init();
+            // The asset pack is mapped by now, the glyphs of the UI sizes get rasterized while the logo still plays
+            assets::prewarm_fonts();
+            on_install_apps();
+            GetBootState().isAppsInstalled = true;
+        }
         if (mooncake::GetMooncake().getAppCurrentState(app_id) == mooncake::AppAbility::StateSleeping) {
             break;
         }
@@ -36,6 +49,11 @@ inline void on_install_apps()
 {
     // 安装 App
     // mooncake::GetMooncake().installApp(std::make_unique<AppTemplate>());
+#ifdef APP_BENCHMARK
+    // Benchmark build, runs the benchmark in place of the launcher
+    mooncake::GetMooncake().installApp(std::make_unique<AppBenchmark>());
+#else
     mooncake::GetMooncake().installApp(std::make_unique<AppLauncher>());
+#endif
     /* Install app locator (Don't remove) */
 }
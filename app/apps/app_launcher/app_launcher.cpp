@@ -9,12 +9,15 @@
 #include <mooncake_log.h>
 #include <smooth_lvgl.h>
 #include <assets/assets.h>
+#include <shared/shared.h>
 
 using namespace mooncake;
 
 AppLauncher::AppLauncher()
 {
     setAppInfo().name = "AppLauncher";
+    // The startup animation stays up until every panel is built
+    GetBootState().isLauncherBuilding = true;
 }
 
 void AppLauncher::onCreate()
@@ -27,7 +30,38 @@ void AppLauncher::onCreate()
 void AppLauncher::onOpen()
 {
     mclog::tagInfo(getAppInfo().name, "on open");
+    GetHAL()->setPowerProfileApp(getAppInfo().name);
 
+    // Frames that hold the UI for too long get the blocking call logged, and a report on the card
+    GetHAL()->startStallMonitor(hal::HalBase::StallMonitorConfig_t());
+    // Panels read the cached sensor values, so no I2C transfer runs under the LVGL lock
+    GetHAL()->startSensorService(hal::HalBase::SensorServiceConfig_t());
+    // The clock label is redrawn on the second boundaries, without reading the RTC
+    GetHAL()->startClockService(hal::HalBase::ClockServiceConfig_t());
+    // The CPU temperature panel reads the filtered value, throttling steps in before the chip gets hot
+    GetHAL()->startThermalService(hal::HalBase::ThermalConfig_t());
+    // Power, motion and temperature go to the card for weeks, averaged from the sensor service history
+    GetHAL()->startTimeSeries(hal::HalBase::TimeSeriesConfig_t());
+    // Between batches the station wakes every few beacons, senders keep the radio awake while they transfer
+    hal::HalBase::WifiPowerSaveConfig_t power_save;
+    power_save.idleLevel = hal::HalBase::RADIO_LEVEL_SLEEP;
+    GetHAL()->setWifiPowerSave(power_save);
+    // Batched readings to the broker set in menuconfig, does nothing when none is set
+    GetHAL()->startMqtt(hal::HalBase::MqttConfig_t());
+    // The same readings for a phone nearby, over GATT notifications
+    GetHAL()->startBleTelemetry(hal::HalBase::BleTelemetryConfig_t());
+    // Idle screens fade down, screen on power is mostly the backlight
+    GetHAL()->startBacklightPolicy(hal::HalBase::BacklightPolicyConfig_t());
+    // A static screen is scanned out at a lower frame rate, less PSRAM read and a longer idle link
+    GetHAL()->startRefreshGovernor(hal::HalBase::RefreshGovernorConfig_t());
+    // A keyboard accessory on Port A drives the focused widgets, Port A is left free when none answers
+    GetHAL()->startKeypad(hal::HalBase::KeypadConfig_t());
+
+    // Reopened after a close, the panels kept their state and only the widgets are built again
+    if (_view) {
+        _view->resume();
+        return;
+    }
     _view = std::make_unique<launcher_view::LauncherView>();
     _view->init();
 }
@@ -40,6 +74,16 @@ void AppLauncher::onRunning()
 void AppLauncher::onClose()
 {
     mclog::tagInfo(getAppInfo().name, "on close");
+    GetHAL()->setPowerProfileApp("");
+
+    // While closed only the panel state stays resident, no LVGL object
+    _view->suspend();
+    GetHAL()->stopSensorService();
+}
+
+void AppLauncher::onDestroy()
+{
+    mclog::tagInfo(getAppInfo().name, "on destroy");
 
     _view.reset();
 }
@@ -21,6 +21,7 @@ public:
     void onOpen() override;
     void onRunning() override;
     void onClose() override;
+    void onDestroy() override;
 
 private:
     std::unique_ptr<launcher_view::LauncherView> _view;
@@ -10,6 +10,9 @@
 #include <smooth_ui_toolkit.h>
 #include <smooth_lvgl.h>
 #include <apps/utils/audio/audio.h>
+#include <assets/font_engine.h>
+#include <algorithm>
+#include <cmath>
 
 using namespace launcher_view;
 using namespace smooth_ui_toolkit;
@@ -20,6 +23,38 @@ static const std::string _tag = "panel-camera";
 static const ui::Window::KeyFrame_t _kf_camera_close = {598, 0, 74, 74, 0};
 static const ui::Window::KeyFrame_t _kf_camera_open  = {141, 0, 800, 480, 255};
 
+static constexpr float _zoom_max                = 8.0f;
+static constexpr float _zoom_step               = 0.01f;  // Smaller pinch moves are not sent to the capture
+static constexpr uint32_t _pinch_click_guard_ms = 300;    // The release of a pinch is not a tap on the preview
+static constexpr uint32_t _snapshot_label_ms    = 1500;
+
+// Touch reports are in panel coordinates, mapped the way the indev does for the current rotation
+static lv_point_t touch_to_screen(lv_display_t* disp, int32_t x, int32_t y)
+{
+    int32_t hor_res           = lv_display_get_physical_horizontal_resolution(disp);
+    int32_t ver_res           = lv_display_get_physical_vertical_resolution(disp);
+    lv_display_rotation_t rot = lv_display_get_rotation(disp);
+    if (rot == LV_DISPLAY_ROTATION_180 || rot == LV_DISPLAY_ROTATION_270) {
+        x = hor_res - x - 1;
+        y = ver_res - y - 1;
+    }
+    if (rot == LV_DISPLAY_ROTATION_90 || rot == LV_DISPLAY_ROTATION_270) {
+        int32_t tmp = y;
+        y           = x;
+        x           = ver_res - tmp - 1;
+    }
+    return {x, y};
+}
+
+// Name from the RTC, so files sort by when they were taken
+static std::string camera_file_name(const char* prefix, const char* extension)
+{
+    tm time = {};
+    GetHAL()->getRtcTime(&time);
+    return fmt::format("{}_{:04}{:02}{:02}_{:02}{:02}{:02}.{}", prefix, time.tm_year + 1900, time.tm_mon + 1,
+                       time.tm_mday, time.tm_hour, time.tm_min, time.tm_sec, extension);
+}
+
 class CameraWindow : public ui::Window {
 public:
     CameraWindow()
@@ -38,7 +73,23 @@ public:
         if (!_is_camera_closing) {
             _is_camera_closing = true;
             _camera_canvas->setOpa(0);
+            _label_stats->setOpa(0);
+            _label_uvc->setOpa(0);
+            _label_scan->setOpa(0);
+            _label_snapshot->setOpa(0);
+            _label_record->setOpa(0);
             _label_msg->setText("Closing Camera ...");
+            if (GetHAL()->isCameraRecording()) {
+                GetHAL()->stopCameraRecording();
+            }
+            if (_is_uvc_enabled) {
+                GetHAL()->stopUvcCamera();
+                _is_uvc_enabled = false;
+            }
+            if (_is_scan_enabled) {
+                GetHAL()->stopCameraBarcodeScan();
+                _is_scan_enabled = false;
+            }
             GetHAL()->stopCameraCapture();
         }
     }
@@ -49,7 +100,7 @@ public:
 
         _label_msg = std::make_unique<Label>(_window->get());
         _label_msg->align(LV_ALIGN_CENTER, 0, -24);
-        _label_msg->setTextFont(&lv_font_montserrat_24);
+        _label_msg->setTextFont(assets::get_font(24));
         _label_msg->setText("Opening Camera ...");
 
         _camera_canvas = std::make_unique<Canvas>(lv_screen_active());
@@ -57,10 +108,117 @@ public:
         _camera_canvas->addFlag(LV_OBJ_FLAG_CLICKABLE);
         _camera_canvas->setOpa(0);
         _camera_canvas->onClick().connect([&]() {
+            // Lifting the fingers of a pinch ends in a click too
+            if (_is_pinching || GetHAL()->millis() - _pinch_end_ms < _pinch_click_guard_ms) {
+                return;
+            }
             _is_camera_minimized = !_is_camera_minimized;
             update_camera_canvas();
         });
 
+        // Frame-timing overlay, tap to expand
+        _label_stats = std::make_unique<Label>(lv_screen_active());
+        _label_stats->setTextFont(assets::get_font(16));
+        _label_stats->setTextColor(lv_color_hex(0xFFFFFF));
+        _label_stats->setBgColor(lv_color_hex(0x000000));
+        _label_stats->setBgOpa(LV_OPA_60);
+        _label_stats->setRadius(6);
+        _label_stats->addFlag(LV_OBJ_FLAG_CLICKABLE);
+        _label_stats->setText("Stats");
+        _label_stats->setOpa(0);
+        _label_stats->onClick().connect([&]() {
+            _is_stats_shown   = !_is_stats_shown;
+            _stats_time_count = 0;
+            if (!_is_stats_shown) {
+                _label_stats->setText("Stats");
+            }
+        });
+
+        // Feeds the running capture to a PC on the USB-C port as a webcam
+        _label_uvc = std::make_unique<Label>(lv_screen_active());
+        _label_uvc->setTextFont(assets::get_font(16));
+        _label_uvc->setTextColor(lv_color_hex(0xFFFFFF));
+        _label_uvc->setBgColor(lv_color_hex(0x000000));
+        _label_uvc->setBgOpa(LV_OPA_60);
+        _label_uvc->setRadius(6);
+        _label_uvc->addFlag(LV_OBJ_FLAG_CLICKABLE);
+        _label_uvc->setOpa(0);
+        _label_uvc->onClick().connect([&]() {
+            if (_is_uvc_enabled) {
+                GetHAL()->stopUvcCamera();
+                _is_uvc_enabled = false;
+            } else {
+                _is_uvc_enabled = GetHAL()->startUvcCamera();
+            }
+            update_uvc_label();
+        });
+        update_uvc_label();
+
+        // Asset tag scanning, the capture goes grey so the decoder reads the Bayer plane directly
+        _label_scan = std::make_unique<Label>(lv_screen_active());
+        _label_scan->setTextFont(assets::get_font(16));
+        _label_scan->setTextColor(lv_color_hex(0xFFFFFF));
+        _label_scan->setBgColor(lv_color_hex(0x000000));
+        _label_scan->setBgOpa(LV_OPA_60);
+        _label_scan->setRadius(6);
+        _label_scan->addFlag(LV_OBJ_FLAG_CLICKABLE);
+        _label_scan->setOpa(0);
+        _label_scan->onClick().connect([&]() {
+            hal::HalBase::CameraConfig_t config;
+            if (_is_scan_enabled) {
+                GetHAL()->stopCameraBarcodeScan();
+                GetHAL()->switchCameraConfig(config);
+                _is_scan_enabled = false;
+            } else {
+                config.pixelFormat = hal::HalBase::CAMERA_PIXEL_FORMAT_RAW8;
+                _is_scan_enabled   = GetHAL()->startCameraBarcodeScan(hal::HalBase::CameraBarcodeConfig_t());
+                if (_is_scan_enabled) {
+                    GetHAL()->switchCameraConfig(config);
+                }
+            }
+            _scan_text.clear();
+            update_scan_label();
+        });
+        _barcode_sequence = GetHAL()->getCameraBarcode().sequence;
+        update_scan_label();
+
+        // JPEG snapshot and MJPEG recording of the running capture to the SD card root
+        _label_snapshot = std::make_unique<Label>(lv_screen_active());
+        _label_snapshot->setTextFont(assets::get_font(16));
+        _label_snapshot->setTextColor(lv_color_hex(0xFFFFFF));
+        _label_snapshot->setBgColor(lv_color_hex(0x000000));
+        _label_snapshot->setBgOpa(LV_OPA_60);
+        _label_snapshot->setRadius(6);
+        _label_snapshot->addFlag(LV_OBJ_FLAG_CLICKABLE);
+        _label_snapshot->setText(" Snapshot ");
+        _label_snapshot->setOpa(0);
+        _label_snapshot->onClick().connect([&]() {
+            bool is_ok = GetHAL()->cameraSnapshot(camera_file_name("IMG", "jpg"));
+            if (is_ok) {
+                audio::play_next_tone_progression();
+            }
+            _label_snapshot->setText(is_ok ? " Snapshot: Saved " : " Snapshot: Failed ");
+            _snapshot_time_count = GetHAL()->millis();
+        });
+
+        _label_record = std::make_unique<Label>(lv_screen_active());
+        _label_record->setTextFont(assets::get_font(16));
+        _label_record->setTextColor(lv_color_hex(0xFFFFFF));
+        _label_record->setBgColor(lv_color_hex(0x000000));
+        _label_record->setBgOpa(LV_OPA_60);
+        _label_record->setRadius(6);
+        _label_record->addFlag(LV_OBJ_FLAG_CLICKABLE);
+        _label_record->setOpa(0);
+        _label_record->onClick().connect([&]() {
+            if (GetHAL()->isCameraRecording()) {
+                GetHAL()->stopCameraRecording();
+            } else {
+                GetHAL()->startCameraRecording(camera_file_name("VID", "avi"));
+            }
+            update_record_label();
+        });
+        update_record_label();
+
         update_camera_canvas();
     }
 
@@ -83,6 +241,42 @@ public:
             GetHAL()->startCameraCapture(_camera_canvas->get());
             _is_camera_opened = true;
             _camera_canvas->setOpa(255);
+            _label_stats->setOpa(255);
+            _label_uvc->setOpa(255);
+            _label_scan->setOpa(255);
+            _label_snapshot->setOpa(255);
+            _label_record->setOpa(255);
+            GetHAL()->setCameraZoom(1.0f);
+        }
+
+        update_pinch();
+
+        if (_snapshot_time_count && GetHAL()->millis() - _snapshot_time_count > _snapshot_label_ms) {
+            _label_snapshot->setText(" Snapshot ");
+            _snapshot_time_count = 0;
+        }
+
+        if (GetHAL()->isCameraRecording() != _is_recording) {
+            update_record_label();
+        }
+
+        if (_is_stats_shown && GetHAL()->millis() - _stats_time_count > 500) {
+            update_stats();
+            _stats_time_count = GetHAL()->millis();
+        }
+
+        if (_is_uvc_enabled && GetHAL()->isUvcCameraStreaming() != _is_uvc_streaming) {
+            update_uvc_label();
+        }
+
+        if (_is_scan_enabled) {
+            auto barcode = GetHAL()->getCameraBarcode();
+            if (barcode.sequence != _barcode_sequence) {
+                _barcode_sequence = barcode.sequence;
+                _scan_text        = barcode.text;
+                audio::play_next_tone_progression();
+                update_scan_label();
+            }
         }
     }
 
@@ -94,9 +288,123 @@ public:
 private:
     std::unique_ptr<Label> _label_msg;
     std::unique_ptr<Canvas> _camera_canvas;
-    bool _is_camera_opened    = false;
-    bool _is_camera_minimized = true;
-    bool _is_camera_closing   = false;
+    std::unique_ptr<Label> _label_stats;
+    std::unique_ptr<Label> _label_uvc;
+    std::unique_ptr<Label> _label_scan;
+    std::unique_ptr<Label> _label_snapshot;
+    std::unique_ptr<Label> _label_record;
+    std::string _scan_text;
+    bool _is_camera_opened     = false;
+    bool _is_camera_minimized  = true;
+    bool _is_camera_closing    = false;
+    bool _is_stats_shown       = false;
+    bool _is_uvc_enabled       = false;
+    bool _is_uvc_streaming     = false;
+    bool _is_scan_enabled      = false;
+    bool _is_recording         = false;
+    uint32_t _barcode_sequence = 0;
+    uint32_t _stats_time_count = 0;
+    // Non zero while the snapshot result is shown
+    uint32_t _snapshot_time_count = 0;
+
+    // Pinch to zoom. The point of the capture window under the fingers at the start of the pinch stays under them
+    bool _is_pinching       = false;
+    uint32_t _pinch_end_ms  = 0;
+    float _pinch_start_dist = 0.0f;
+    float _pinch_start_zoom = 1.0f;
+    float _pinch_anchor_x   = 0.5f;
+    float _pinch_anchor_y   = 0.5f;
+    float _zoom             = 1.0f;
+    float _zoom_center_x    = 0.5f;
+    float _zoom_center_y    = 0.5f;
+
+    void update_pinch()
+    {
+        auto touch = GetHAL()->getTouchState();
+        if (touch.count < 2 || _is_camera_closing) {
+            if (_is_pinching) {
+                _is_pinching  = false;
+                _pinch_end_ms = GetHAL()->millis();
+            }
+            return;
+        }
+
+        lv_display_t* disp = lv_obj_get_display(_camera_canvas->get());
+        lv_point_t a       = touch_to_screen(disp, touch.points[0].x, touch.points[0].y);
+        lv_point_t b       = touch_to_screen(disp, touch.points[1].x, touch.points[1].y);
+        float dist         = std::hypot((float)(a.x - b.x), (float)(a.y - b.y));
+
+        // Finger midpoint in the preview, 0 to 1. The preview is mirrored horizontally
+        lv_area_t coords;
+        lv_obj_get_coords(_camera_canvas->get(), &coords);
+        float mid_x = ((a.x + b.x) / 2.0f - coords.x1) / std::max<int32_t>(lv_area_get_width(&coords), 1);
+        float mid_y = ((a.y + b.y) / 2.0f - coords.y1) / std::max<int32_t>(lv_area_get_height(&coords), 1);
+        mid_x       = 1.0f - std::clamp(mid_x, 0.0f, 1.0f);
+        mid_y       = std::clamp(mid_y, 0.0f, 1.0f);
+
+        if (!_is_pinching) {
+            if (dist < 1.0f) {
+                return;
+            }
+            _is_pinching      = true;
+            _pinch_start_dist = dist;
+            _pinch_start_zoom = _zoom;
+            _pinch_anchor_x   = _zoom_center_x + (mid_x - 0.5f) / _zoom;
+            _pinch_anchor_y   = _zoom_center_y + (mid_y - 0.5f) / _zoom;
+            return;
+        }
+
+        float zoom = std::clamp(_pinch_start_zoom * dist / _pinch_start_dist, 1.0f, _zoom_max);
+        if (std::fabs(zoom - _zoom) < _zoom_step * _zoom) {
+            return;
+        }
+        _zoom          = zoom;
+        _zoom_center_x = std::clamp(_pinch_anchor_x - (mid_x - 0.5f) / zoom, 0.0f, 1.0f);
+        _zoom_center_y = std::clamp(_pinch_anchor_y - (mid_y - 0.5f) / zoom, 0.0f, 1.0f);
+        GetHAL()->setCameraZoom(_zoom, _zoom_center_x, _zoom_center_y);
+    }
+
+    void update_record_label()
+    {
+        _is_recording = GetHAL()->isCameraRecording();
+        _label_record->setText(_is_recording ? " Record: On " : " Record: Off ");
+    }
+
+    void update_uvc_label()
+    {
+        _is_uvc_streaming = _is_uvc_enabled && GetHAL()->isUvcCameraStreaming();
+        if (!_is_uvc_enabled) {
+            _label_uvc->setText(" USB Webcam: Off ");
+        } else {
+            _label_uvc->setText(_is_uvc_streaming ? " USB Webcam: Streaming " : " USB Webcam: Waiting ");
+        }
+    }
+
+    void update_scan_label()
+    {
+        if (!_is_scan_enabled) {
+            _label_scan->setText(" Scan: Off ");
+        } else if (_scan_text.empty()) {
+            _label_scan->setText(" Scan: Waiting ");
+        } else {
+            // Long payloads would run off the preview
+            std::string text = _scan_text.size() > 48 ? _scan_text.substr(0, 45) + "..." : _scan_text;
+            _label_scan->setText(fmt::format(" Scan: {} ", text));
+        }
+    }
+
+    void update_stats()
+    {
+        auto stats = GetHAL()->getCameraStats();
+        _label_stats->setText(
+            fmt::format(" {:.1f} fps  dropped {}\n"
+                        " dqbuf    {:>6} / {:>6} us\n"
+                        " ppa      {:>6} / {:>6} us\n"
+                        " present  {:>6} / {:>6} us\n"
+                        " qbuf     {:>6} / {:>6} us ",
+                        stats.fps, stats.framesDropped, stats.dqbuf.p50, stats.dqbuf.p99, stats.ppa.p50,
+                        stats.ppa.p99, stats.present.p50, stats.present.p99, stats.qbuf.p50, stats.qbuf.p99));
+    }
 
     void update_camera_canvas()
     {
@@ -104,16 +412,31 @@ private:
             _camera_canvas->setPos(141, 0);
             _camera_canvas->setSize(760, 440);
             _camera_canvas->setRadius(12);
+            _label_stats->setPos(141 + 12, 12);
+            _label_uvc->setPos(141 + 12, 440 - 12 - 28);
+            _label_scan->setPos(141 + 12 + 240, 440 - 12 - 28);
+            _label_snapshot->align(LV_ALIGN_TOP_RIGHT, -(1280 - 141 - 760) - 12, 12);
+            _label_record->align(LV_ALIGN_TOP_RIGHT, -(1280 - 141 - 760) - 12, 12 + 40);
+            GetHAL()->setCameraPreviewSize(760, 440);
         } else {
             _camera_canvas->setPos(0, 0);
             _camera_canvas->setSize(1280, 720);
             _camera_canvas->setRadius(0);
+            _label_stats->setPos(12, 12);
+            _label_uvc->setPos(12, 720 - 12 - 28);
+            _label_scan->setPos(12 + 240, 720 - 12 - 28);
+            _label_snapshot->align(LV_ALIGN_TOP_RIGHT, -12, 12);
+            _label_record->align(LV_ALIGN_TOP_RIGHT, -12, 12 + 40);
+            GetHAL()->setCameraPreviewSize(1280, 720);
         }
     }
 };
 
 void PanelCamera::init()
 {
+    // Scanned codes arrive while the window is open, the update runs on them
+    subscribeEvent(shared_data::EVENT_TOPIC_BARCODE);
+
     _btn_camera = std::make_unique<Container>(lv_screen_active());
     _btn_camera->align(LV_ALIGN_CENTER, 598, 10);
     _btn_camera->setSize(83, 97);
@@ -125,6 +448,7 @@ void PanelCamera::init()
         _window = std::make_unique<CameraWindow>();
         _window->init(lv_screen_active());
         _window->open();
+        requestUpdate();
     });
 }
 
@@ -134,6 +458,14 @@ void PanelCamera::update(bool isStacked)
         _window->update();
         if (_window->getState() == ui::Window::State_t::Closed) {
             _window.reset();
+        } else {
+            requestUpdate();
         }
     }
 }
+
+void PanelCamera::evict()
+{
+    _window.reset();
+    _btn_camera.reset();
+}
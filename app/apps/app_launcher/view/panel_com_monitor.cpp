@@ -8,6 +8,8 @@
 #include "view.h"
 #include <lvgl.h>
 #include <hal/hal.h>
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <mooncake_log.h>
 #include <smooth_ui_toolkit.h>
@@ -15,6 +17,8 @@
 #include <apps/utils/audio/audio.h>
 #include <apps/utils/ui/window.h>
 #include <apps/utils/ui/toast.h>
+#include <apps/utils/ui/terminal.h>
+#include <assets/font_engine.h>
 
 using namespace launcher_view;
 using namespace smooth_ui_toolkit;
@@ -29,43 +33,54 @@ class ComMonitorWindow : public ui::Window {
 public:
     ComMonitorWindow()
     {
-        config.kfClosed = _kf_com_monitor_close;
-        config.kfOpened = _kf_com_monitor_open;
+        config.kfClosed     = _kf_com_monitor_close;
+        config.kfOpened     = _kf_com_monitor_open;
+        config.snapshotAnim = true;
     }
 
     void onOpen() override
     {
+        // The port only runs while someone watches it
+        GetHAL()->claimPeripheral(hal::HalBase::PERIPHERAL_RS485, "com_monitor");
+
         _window->setScrollbarMode(LV_SCROLLBAR_MODE_OFF);
 
-        _msg_panel = std::make_unique<TextArea>(_window->get());
-        _msg_panel->setSize(600, 333);
-        _msg_panel->align(LV_ALIGN_CENTER, 0, -33);
-        _msg_panel->setMaxLength(4096);
-        _msg_panel->setCursorClickPos(false);
-        _msg_panel->setText("");
-        _msg_panel->setPasswordMode(false);
-        _msg_panel->setOneLine(false);
-        _msg_panel->setBorderWidth(0);
-        _msg_panel->setBgColor(lv_color_hex(0x383838));
-        _msg_panel->setTextFont(&lv_font_montserrat_18);
+        _terminal = std::make_unique<ui::Terminal>();
+        _terminal->init(_window->get());
+        _terminal->get()->align(LV_ALIGN_CENTER, 0, -33);
 
         _label_msg = std::make_unique<Label>(_window->get());
         _label_msg->align(LV_ALIGN_LEFT_MID, 46, 172);
         _label_msg->setText("Port: RS485\nBaud: 115200");
-        _label_msg->setTextFont(&lv_font_montserrat_18);
+        _label_msg->setTextFont(assets::get_font(18));
         _label_msg->setTextColor(lv_color_hex(0xDEDEDE));
 
+        _btn_hex = create_toggle_button("HEX", -118);
+        _btn_hex->onClick().connect([&] {
+            audio::play_next_tone_progression();
+            bool is_hex = _terminal->getMode() != ui::Terminal::MODE_HEX;
+            _terminal->setMode(is_hex ? ui::Terminal::MODE_HEX : ui::Terminal::MODE_TEXT);
+            update_toggle_button(_btn_hex.get(), is_hex);
+        });
+
+        _btn_time = create_toggle_button("TIME", -44);
+        _btn_time->onClick().connect([&] {
+            audio::play_next_tone_progression();
+            _terminal->setTimestamp(!_terminal->isTimestampEnabled());
+            update_toggle_button(_btn_time.get(), _terminal->isTimestampEnabled());
+        });
+
         _btn_send_msg = std::make_unique<Button>(_window->get());
-        _btn_send_msg->setSize(314, 48);
-        _btn_send_msg->align(LV_ALIGN_CENTER, 128, 174);
+        _btn_send_msg->setSize(260, 48);
+        _btn_send_msg->align(LV_ALIGN_CENTER, 155, 174);
         _btn_send_msg->setBgColor(lv_color_hex(0x616161));
         _btn_send_msg->setRadius(18);
-        _btn_send_msg->label().setTextFont(&lv_font_montserrat_22);
+        _btn_send_msg->label().setTextFont(assets::get_font(22));
         _btn_send_msg->label().setTextColor(lv_color_hex(0xE7E7E7));
         _btn_send_msg->label().setText("Send \"Hello M5Stack!\"");
         _btn_send_msg->onClick().connect([&] {
             audio::play_next_tone_progression();
-            _msg_panel->addText("<<< Hello M5Stack!\n");
+            _terminal->append("<<< Hello M5Stack!\n");
             GetHAL()->uartMonitorSend("Hello M5Stack!");
         });
     }
@@ -76,26 +91,52 @@ public:
             return;
         }
 
-        std::lock_guard<std::mutex> lock(GetHAL()->uartMonitorData.mutex);
-        while (!GetHAL()->uartMonitorData.rxQueue.empty()) {
-            uint8_t c = GetHAL()->uartMonitorData.rxQueue.front();
-            GetHAL()->uartMonitorData.rxQueue.pop();
-            _msg_panel->addChar(c);
+        // Everything received since the last frame goes into the line ring, the rows are laid out once
+        auto& rx_ring = GetHAL()->uartMonitorData.rxRing;
+        auto span     = rx_ring.readSpan();
+        while (span.size > 0) {
+            _terminal->append(span.data, span.size);
+            rx_ring.consume(span.size);
+            span = rx_ring.readSpan();
         }
+        _terminal->render();
     }
 
     void onClose() override
     {
         audio::play_next_tone_progression();
-        _msg_panel.reset();
+        GetHAL()->releasePeripheral(hal::HalBase::PERIPHERAL_RS485, "com_monitor");
+        _terminal.reset();
         _label_msg.reset();
+        _btn_hex.reset();
+        _btn_time.reset();
         _btn_send_msg.reset();
     }
 
 private:
-    std::unique_ptr<TextArea> _msg_panel;
+    std::unique_ptr<ui::Terminal> _terminal;
     std::unique_ptr<Label> _label_msg;
+    std::unique_ptr<Button> _btn_hex;
+    std::unique_ptr<Button> _btn_time;
     std::unique_ptr<Button> _btn_send_msg;
+
+    std::unique_ptr<Button> create_toggle_button(const char* text, int32_t x)
+    {
+        auto button = std::make_unique<Button>(_window->get());
+        button->setSize(64, 48);
+        button->align(LV_ALIGN_CENTER, x, 174);
+        button->setRadius(18);
+        button->label().setTextFont(assets::get_font(18));
+        button->label().setTextColor(lv_color_hex(0xE7E7E7));
+        button->label().setText(text);
+        update_toggle_button(button.get(), false);
+        return button;
+    }
+
+    void update_toggle_button(Button* button, bool isActive)
+    {
+        button->setBgColor(lv_color_hex(isActive ? 0x58B358 : 0x616161));
+    }
 };
 
 void PanelComMonitor::init()
@@ -111,6 +152,7 @@ void PanelComMonitor::init()
         _window = std::make_unique<ComMonitorWindow>();
         _window->init(lv_screen_active());
         _window->open();
+        requestUpdate();
     });
 }
 
@@ -120,6 +162,14 @@ void PanelComMonitor::update(bool isStacked)
         _window->update();
         if (_window->getState() == ui::Window::State_t::Closed) {
             _window.reset();
+        } else {
+            requestUpdate();
         }
     }
 }
+
+void PanelComMonitor::evict()
+{
+    _window.reset();
+    _btn_com_monitor.reset();
+}
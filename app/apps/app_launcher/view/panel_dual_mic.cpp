@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: MIT
  */
 #include "view.h"
+#include <algorithm>
 #include <cstdint>
 #include <lvgl.h>
 #include <hal/hal.h>
@@ -12,7 +13,9 @@
 #include <smooth_ui_toolkit.h>
 #include <smooth_lvgl.h>
 #include <apps/utils/audio/audio.h>
+#include <apps/utils/audio/spectrum.h>
 #include <apps/utils/ui/window.h>
+#include <assets/font_engine.h>
 
 using namespace launcher_view;
 using namespace smooth_ui_toolkit;
@@ -23,6 +26,10 @@ static const std::string _tag = "panel-dual-mic";
 static const ui::Window::KeyFrame_t _kf_mic_test_close = {-154, -318, 75, 75, 0};
 static const ui::Window::KeyFrame_t _kf_mic_test_open  = {-215, -217, 670, 171, 255};
 
+static constexpr size_t _meter_bands = 32;
+// Meter bars span this range, dB full scale
+static constexpr float _meter_floor_db = -90.0f;
+
 class MicTestWindow : public ui::Window {
 public:
     MicTestWindow()
@@ -35,11 +42,7 @@ public:
     {
         _window->setScrollbarMode(LV_SCROLLBAR_MODE_OFF);
 
-        _chart_mic_left = std::make_unique<Chart>(_window->get());
-        apply_chart_style(_chart_mic_left.get(), -189, 0);
-
-        _chart_mic_right = std::make_unique<Chart>(_window->get());
-        apply_chart_style(_chart_mic_right.get(), 80, 0);
+        create_charts();
 
         _rec_btn = std::make_unique<Button>(_window->get());
         _rec_btn->align(LV_ALIGN_CENTER, 267, 0);
@@ -49,11 +52,15 @@ public:
         _rec_btn->setBorderColor(lv_color_hex(0x383838));
         _rec_btn->setShadowWidth(0);
         _rec_btn->onClick().connect([&]() {
+            // The record test reads the mics itself
+            if (_is_meter_mode) {
+                set_meter_mode(false);
+            }
             GetHAL()->startDualMicRecordTest();
             update_rec_button();
         });
 
-        _rec_btn->label().setTextFont(&lv_font_montserrat_16);
+        _rec_btn->label().setTextFont(assets::get_font(16));
         _rec_btn->label().setTextColor(lv_color_hex(0xF4F3F3));
     }
 
@@ -64,6 +71,11 @@ public:
             _time_count = GetHAL()->millis();
         }
 
+        if (_is_meter_mode) {
+            update_meter();
+            return;
+        }
+
         // Record and plot
         if (_chart_mic_left && _chart_mic_right) {
             GetHAL()->audioRecord(_record_data, 4);  // 48000 * 4 / 1000 = 192
@@ -78,6 +90,10 @@ public:
     void onClose() override
     {
         audio::play_next_tone_progression();
+        if (_is_capturing) {
+            GetHAL()->stopAudioCapture();
+            _is_capturing = false;
+        }
         _chart_mic_left.reset();
         _chart_mic_right.reset();
     }
@@ -89,6 +105,115 @@ private:
     std::unique_ptr<Chart> _chart_mic_right;
     std::unique_ptr<Button> _rec_btn;
     std::unique_ptr<Spinner> _rec_btn_spinner;
+    bool _is_meter_mode = false;
+    bool _is_capturing  = false;
+    std::vector<int16_t> _capture_buffer;
+    audio::SpectrumAnalyzer _spectrum_left;
+    audio::SpectrumAnalyzer _spectrum_right;
+
+    void create_charts()
+    {
+        _chart_mic_left = std::make_unique<Chart>(_window->get());
+        apply_chart_style(_chart_mic_left.get(), -189, 0);
+
+        _chart_mic_right = std::make_unique<Chart>(_window->get());
+        apply_chart_style(_chart_mic_right.get(), 80, 0);
+
+        // Tap a chart to switch between the waveform and the live spectrum
+        for (auto chart : {_chart_mic_left.get(), _chart_mic_right.get()}) {
+            chart->addFlag(LV_OBJ_FLAG_CLICKABLE);
+            lv_obj_add_event_cb(
+                chart->get(),
+                [](lv_event_t* e) {
+                    auto window = static_cast<MicTestWindow*>(lv_event_get_user_data(e));
+                    audio::play_next_tone_progression();
+                    window->set_meter_mode(!window->_is_meter_mode);
+                },
+                LV_EVENT_CLICKED, this);
+        }
+    }
+
+    void apply_mode_style(Chart* chart)
+    {
+        lv_chart_series_t* series = lv_chart_get_series_next(chart->get(), nullptr);
+        if (_is_meter_mode) {
+            lv_chart_set_type(chart->get(), LV_CHART_TYPE_BAR);
+            chart->setPointCount(_meter_bands);
+            chart->setRange(LV_CHART_AXIS_PRIMARY_Y, 0, 100);
+            chart->setUpdateMode(LV_CHART_UPDATE_MODE_CIRCULAR);
+            lv_obj_set_style_pad_column(chart->get(), 1, LV_PART_MAIN);
+        } else {
+            lv_chart_set_type(chart->get(), LV_CHART_TYPE_LINE);
+            chart->setPointCount(512);
+            chart->setRange(LV_CHART_AXIS_PRIMARY_Y, -32768, 32767);
+            chart->setUpdateMode(LV_CHART_UPDATE_MODE_SHIFT);
+        }
+        lv_chart_set_all_value(chart->get(), series, 0);
+    }
+
+    void set_meter_mode(bool meterMode)
+    {
+        if (_is_meter_mode == meterMode) {
+            return;
+        }
+        _is_meter_mode = meterMode;
+        mclog::tagInfo(_tag, "meter mode: {}", _is_meter_mode);
+
+        if (_is_meter_mode) {
+            // Streaming capture, falls back to polling short records where the hal has none
+            hal::HalBase::AudioCaptureConfig_t config;
+            config.channelMask = hal::HalBase::AUDIO_CAPTURE_MIC_L | hal::HalBase::AUDIO_CAPTURE_MIC_R;
+            _is_capturing      = GetHAL()->startAudioCapture(config);
+            _spectrum_left.init(48000, _meter_bands);
+            _spectrum_right.init(48000, _meter_bands);
+        } else if (_is_capturing) {
+            GetHAL()->stopAudioCapture();
+            _is_capturing = false;
+        }
+
+        if (_chart_mic_left && _chart_mic_right) {
+            apply_mode_style(_chart_mic_left.get());
+            apply_mode_style(_chart_mic_right.get());
+        }
+    }
+
+    void update_meter()
+    {
+        if (!_chart_mic_left || !_chart_mic_right) {
+            return;
+        }
+
+        if (_is_capturing) {
+            // [MIC-L, MIC-R]
+            _capture_buffer.resize(audio::SpectrumAnalyzer::FftSize * 2);
+            while (1) {
+                size_t frames = GetHAL()->readAudioCapture(_capture_buffer.data(), audio::SpectrumAnalyzer::FftSize);
+                if (frames == 0) {
+                    break;
+                }
+                _spectrum_left.push(_capture_buffer.data(), frames, 2, 0);
+                _spectrum_right.push(_capture_buffer.data(), frames, 2, 1);
+            }
+        } else {
+            GetHAL()->audioRecord(_record_data, 11);  // A bit more than one FFT window
+            // [MIC-L, AEC, MIC-R, MIC-HP]
+            _spectrum_left.push(_record_data.data(), _record_data.size() / 4, 4, 0);
+            _spectrum_right.push(_record_data.data(), _record_data.size() / 4, 4, 2);
+        }
+
+        update_meter_chart(_chart_mic_left.get(), _spectrum_left.analyze());
+        update_meter_chart(_chart_mic_right.get(), _spectrum_right.analyze());
+    }
+
+    void update_meter_chart(Chart* chart, const std::vector<float>& bands)
+    {
+        lv_chart_series_t* series = lv_chart_get_series_next(chart->get(), nullptr);
+        for (size_t i = 0; i < bands.size(); i++) {
+            int32_t value = (bands[i] - _meter_floor_db) * 100 / -_meter_floor_db;
+            lv_chart_set_value_by_id(chart->get(), series, i, std::clamp<int32_t>(value, 0, 100));
+        }
+        lv_chart_refresh(chart->get());
+    }
 
     void apply_chart_style(Chart* chart, int16_t x, int16_t y)
     {
@@ -153,6 +278,7 @@ void PanelDualMic::init()
         _window = std::make_unique<MicTestWindow>();
         _window->init(lv_screen_active());
         _window->open();
+        requestUpdate();
     });
 }
 
@@ -162,6 +288,14 @@ void PanelDualMic::update(bool isStacked)
         _window->update();
         if (_window->getState() == ui::Window::State_t::Closed) {
             _window.reset();
+        } else {
+            requestUpdate();
         }
     }
 }
+
+void PanelDualMic::evict()
+{
+    _window.reset();
+    _btn_mic_test.reset();
+}
@@ -15,6 +15,7 @@
 #include <apps/utils/ui/window.h>
 #include <apps/utils/ui/toast.h>
 #include <array>
+#include <assets/font_engine.h>
 
 using namespace launcher_view;
 using namespace smooth_ui_toolkit;
@@ -29,6 +30,7 @@ static const ui::Window::KeyFrame_t _kf_mbus_open      = {183, -15, 520, 547, 25
 class GpioOutputTestPanel {
 public:
     std::function<void(uint8_t ioPin, bool level)> onToggle;
+    std::function<void(uint8_t ioPin, bool isPwm)> onPwm;
 
     void init(lv_obj_t* parent, uint8_t ioPin)
     {
@@ -44,16 +46,33 @@ public:
 
         _label_io_num = std::make_unique<Label>(_panel->get());
         _label_io_num->align(LV_ALIGN_CENTER, -67, 0);
-        _label_io_num->setTextFont(&lv_font_montserrat_28);
+        _label_io_num->setTextFont(assets::get_font(28));
         _label_io_num->setText(fmt::format("G{}", _io_pin));
 
+        // Tap the pin number for a hardware timed square wave, the toggle button takes the pin back
+        _label_io_num->addFlag(LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_add_event_cb(
+            _label_io_num->get(),
+            [](lv_event_t* e) {
+                auto panel     = static_cast<GpioOutputTestPanel*>(lv_event_get_user_data(e));
+                // The wave stops at the idle level, low
+                panel->_is_pwm = !panel->_is_pwm;
+                panel->_is_on  = false;
+                panel->update_btn_style();
+                if (panel->onPwm) {
+                    panel->onPwm(panel->_io_pin, panel->_is_pwm);
+                }
+            },
+            LV_EVENT_CLICKED, this);
+
         _btn_io_toggle = std::make_unique<Button>(_panel->get());
         _btn_io_toggle->align(LV_ALIGN_CENTER, 47, 0);
         _btn_io_toggle->setSize(114, 42);
         _btn_io_toggle->setRadius(16);
-        _btn_io_toggle->label().setTextFont(&lv_font_montserrat_22);
+        _btn_io_toggle->label().setTextFont(assets::get_font(22));
         _btn_io_toggle->onClick().connect([&]() {
-            _is_on = !_is_on;
+            _is_on  = !_is_on;
+            _is_pwm = false;
             update_btn_style();
             if (onToggle) {
                 onToggle(_io_pin, _is_on);
@@ -78,10 +97,17 @@ protected:
     std::unique_ptr<Label> _label_io_num;
     std::unique_ptr<Button> _btn_io_toggle;
     bool _is_on     = false;
+    bool _is_pwm    = false;
     uint8_t _io_pin = 0;
 
     void update_btn_style()
     {
+        _label_io_num->setTextColor(lv_color_hex(_is_pwm ? 0xF5C242 : 0xFFFFFF));
+        if (_is_pwm) {
+            _btn_io_toggle->setBgColor(lv_color_hex(0x4A6FD8));
+            _btn_io_toggle->label().setText("1 kHz");
+            return;
+        }
         if (_is_on) {
             _btn_io_toggle->setBgColor(lv_color_hex(0xDD380D));
             _btn_io_toggle->label().setText("HIGH");
@@ -92,6 +118,101 @@ protected:
     }
 };
 
+class LogicCapturePanel {
+public:
+    // Sample rate of the capture, the time bases below are in samples of it
+    static constexpr uint32_t sampleRateHz = 1000000;
+
+    void init(lv_obj_t* parent, const std::vector<uint8_t>& pins)
+    {
+        _lanes = pins.size();
+        _canvas_buf.assign(_canvas_w * _row_h * _lanes, lv_color_to_u16(lv_color_hex(0x2A2A2A)));
+        _min.resize(_canvas_w);
+        _max.resize(_canvas_w);
+
+        _canvas = std::make_unique<Canvas>(parent);
+        _canvas->align(LV_ALIGN_TOP_MID, 28, 60);
+        lv_canvas_set_buffer(_canvas->get(), _canvas_buf.data(), _canvas_w, _row_h * _lanes, LV_COLOR_FORMAT_RGB565);
+
+        // Tap the waveform for the next time base
+        _canvas->addFlag(LV_OBJ_FLAG_CLICKABLE);
+        _canvas->onClick().connect([&]() {
+            audio::play_next_tone_progression();
+            _time_base = (_time_base + 1) % _time_bases.size();
+        });
+
+        for (int i = 0; i < _lanes; i++) {
+            _label_lanes.push_back(std::make_unique<Label>(parent));
+            _label_lanes.back()->align(LV_ALIGN_TOP_MID, -_canvas_w / 2 - 6, 60 + _row_h * i + _row_h / 2 - 11);
+            _label_lanes.back()->setTextFont(assets::get_font(18));
+            _label_lanes.back()->setTextColor(lv_color_hex(_lane_colors[i % _lane_colors.size()]));
+            _label_lanes.back()->setText(fmt::format("G{}", pins[i]));
+        }
+
+        _label_info = std::make_unique<Label>(parent);
+        _label_info->align(LV_ALIGN_TOP_MID, 0, 68 + _row_h * _lanes);
+        _label_info->setTextFont(assets::get_font(16));
+        _label_info->setTextColor(lv_color_hex(0xB0B0B0));
+        _label_info->setText("Waiting ...");
+    }
+
+    void update()
+    {
+        // Each refresh reduces the whole window, a 1 s one is a MB of PSRAM reads
+        if (GetHAL()->millis() - _last_render_tick < 100) {
+            return;
+        }
+        _last_render_tick = GetHAL()->millis();
+
+        uint32_t window = _time_bases[_time_base];
+        uint32_t got    = GetHAL()->getLogicEnvelope(window, _min, _max);
+        if (got == 0) {
+            return;
+        }
+        render();
+        _label_info->setText(fmt::format("{} ms  {}", window * 1000 / sampleRateHz,
+                                         got < window ? "filling ..." : "tap for time base"));
+    }
+
+protected:
+    static constexpr int _canvas_w                        = 180;
+    static constexpr int _row_h                           = 40;
+    static constexpr std::array<uint32_t, 4> _time_bases  = {1000, 10000, 100000, 1000000};
+    static constexpr std::array<uint32_t, 4> _lane_colors = {0x58B358, 0xF5C242, 0x4A9FE8, 0xDD7A5C};
+
+    std::unique_ptr<Canvas> _canvas;
+    std::vector<std::unique_ptr<Label>> _label_lanes;
+    std::unique_ptr<Label> _label_info;
+    std::vector<uint16_t> _canvas_buf;
+    std::vector<uint8_t> _min;
+    std::vector<uint8_t> _max;
+    int _lanes                 = 0;
+    size_t _time_base          = 1;
+    uint32_t _last_render_tick = 0;
+
+    // A column that stayed at one level is a line at it, one where the lane toggled spans the row
+    void render()
+    {
+        uint16_t bg = lv_color_to_u16(lv_color_hex(0x2A2A2A));
+        std::fill(_canvas_buf.begin(), _canvas_buf.end(), bg);
+        for (int lane = 0; lane < _lanes; lane++) {
+            uint16_t color = lv_color_to_u16(lv_color_hex(_lane_colors[lane % _lane_colors.size()]));
+            int top        = _row_h * lane + 8;
+            int bottom     = _row_h * (lane + 1) - 8;
+            for (int x = 0; x < _canvas_w; x++) {
+                bool low_seen  = !((_min[x] >> lane) & 1);
+                bool high_seen = (_max[x] >> lane) & 1;
+                int from       = high_seen ? top : bottom - 1;
+                int to         = low_seen ? bottom : top + 1;
+                for (int y = from; y <= to; y++) {
+                    _canvas_buf[y * _canvas_w + x] = color;
+                }
+            }
+        }
+        lv_obj_invalidate(_canvas->get());
+    }
+};
+
 class MbusWindow : public ui::Window {
 public:
     MbusWindow()
@@ -108,7 +229,7 @@ public:
 
         _label_msg = std::make_unique<Label>(_window->get());
         _label_msg->align(LV_ALIGN_CENTER, 0, 0);
-        _label_msg->setTextFont(&lv_font_montserrat_24);
+        _label_msg->setTextFont(assets::get_font(24));
         _label_msg->setTextColor(lv_color_hex(0xECEBEB));
         _label_msg->setText("Loading ...");
     }
@@ -128,9 +249,18 @@ public:
                     _io_panels.back()->get()->align(LV_ALIGN_TOP_MID, i > 8 ? -124 : 124, 55 + 81 * (i % 9));
                     _io_panels.back()->onToggle = [&](uint8_t ioPin, bool isOn) {
                         audio::play_tone_from_midi(isOn ? (63 + 24) : (60 + 24));
+                        GetHAL()->stopGpioWaveform(ioPin);
                         GetHAL()->gpioSetLevel(ioPin, isOn);
                         mclog::tagInfo(_tag, "set G{}: {}", ioPin, isOn ? "high" : "low");
                     };
+                    _io_panels.back()->onPwm = [&](uint8_t ioPin, bool isPwm) {
+                        audio::play_next_tone_progression();
+                        if (isPwm) {
+                            GetHAL()->startGpioPwm(ioPin, 1000, 0.5f);
+                        } else {
+                            GetHAL()->stopGpioWaveform(ioPin);
+                        }
+                    };
                 }
             }
         }
@@ -140,6 +270,7 @@ public:
     {
         _io_panels.clear();
         for (const auto& io : _io_pins) {
+            GetHAL()->stopGpioWaveform(io);
             GetHAL()->gpioReset(io);
         }
     }
@@ -166,10 +297,23 @@ public:
 
         _label_msg = std::make_unique<Label>(_window->get());
         _label_msg->align(LV_ALIGN_CENTER, 0, 0);
-        _label_msg->setTextFont(&lv_font_montserrat_24);
+        _label_msg->setTextFont(assets::get_font(24));
         _label_msg->setTextColor(lv_color_hex(0xECEBEB));
         _label_msg->setText("Loading ...");
 
+        // Switches the port pins between the output toggles and a logic capture of them
+        _btn_mode = std::make_unique<Button>(_window->get());
+        _btn_mode->align(LV_ALIGN_TOP_RIGHT, -12, -14);
+        _btn_mode->setSize(82, 34);
+        _btn_mode->setRadius(12);
+        _btn_mode->setBgColor(lv_color_hex(0x4A6FD8));
+        _btn_mode->label().setTextFont(assets::get_font(16));
+        _btn_mode->label().setText("Logic");
+        _btn_mode->onClick().connect([&]() {
+            audio::play_next_tone_progression();
+            set_logic_mode(!_logic_panel);
+        });
+
         // Create mbus window
         _mbus_window = std::make_unique<MbusWindow>();
         _mbus_window->init(lv_screen_active());
@@ -183,7 +327,9 @@ public:
         }
 
         if (_state == Opened) {
-            if (_io_panels.empty()) {
+            if (_logic_panel) {
+                _logic_panel->update();
+            } else if (_io_panels.empty()) {
                 _label_msg.reset();
                 for (int i = 0; i < _io_pins.size(); i++) {
                     GetHAL()->gpioReset(_io_pins[i]);
@@ -195,9 +341,18 @@ public:
                     _io_panels.back()->get()->align(LV_ALIGN_TOP_MID, 0, 55 + 81 * i);
                     _io_panels.back()->onToggle = [&](uint8_t ioPin, bool isOn) {
                         audio::play_tone_from_midi(isOn ? (63 + 24) : (60 + 24));
+                        GetHAL()->stopGpioWaveform(ioPin);
                         GetHAL()->gpioSetLevel(ioPin, isOn);
                         mclog::tagInfo(_tag, "set G{}: {}", ioPin, isOn ? "high" : "low");
                     };
+                    _io_panels.back()->onPwm = [&](uint8_t ioPin, bool isPwm) {
+                        audio::play_next_tone_progression();
+                        if (isPwm) {
+                            GetHAL()->startGpioPwm(ioPin, 1000, 0.5f);
+                        } else {
+                            GetHAL()->stopGpioWaveform(ioPin);
+                        }
+                    };
                 }
             }
         }
@@ -207,7 +362,12 @@ public:
     {
         audio::play_next_tone_progression();
         _io_panels.clear();
+        if (_logic_panel) {
+            _logic_panel.reset();
+            GetHAL()->stopLogicCapture();
+        }
         for (const auto& io : _io_pins) {
+            GetHAL()->stopGpioWaveform(io);
             GetHAL()->gpioReset(io);
         }
         _mbus_window->close();
@@ -216,9 +376,36 @@ public:
 private:
     std::vector<std::unique_ptr<GpioOutputTestPanel>> _io_panels;
     std::unique_ptr<Label> _label_msg;
+    std::unique_ptr<Button> _btn_mode;
+    std::unique_ptr<LogicCapturePanel> _logic_panel;
     const std::array<uint8_t, 6> _io_pins = {49, 50, 0, 1, 54, 53};
 
     std::unique_ptr<ui::Window> _mbus_window;
+
+    void set_logic_mode(bool isLogic)
+    {
+        if (!isLogic) {
+            // The output panels are rebuilt by the next update, which takes the pins back as outputs
+            _logic_panel.reset();
+            GetHAL()->stopLogicCapture();
+            _btn_mode->label().setText("Logic");
+            return;
+        }
+
+        hal::HalBase::LogicCaptureConfig_t config;
+        config.pins.assign(_io_pins.begin(), _io_pins.end());
+        config.sampleRateHz = LogicCapturePanel::sampleRateHz;
+        if (!GetHAL()->startLogicCapture(config)) {
+            ui::pop_a_toast("Logic capture not available", ui::toast_type::error);
+            return;
+        }
+
+        _io_panels.clear();
+        _logic_panel = std::make_unique<LogicCapturePanel>();
+        _logic_panel->init(_window->get(), config.pins);
+        _btn_mode->label().setText("Output");
+        mclog::tagInfo(_tag, "logic capture on {} pins", config.pins.size());
+    }
 };
 
 void PanelGpioTest::init()
@@ -234,6 +421,7 @@ void PanelGpioTest::init()
         _window = std::make_unique<ExtPortWindow>();
         _window->init(lv_screen_active());
         _window->open();
+        requestUpdate();
     });
 }
 
@@ -243,6 +431,14 @@ void PanelGpioTest::update(bool isStacked)
         _window->update();
         if (_window->getState() == ui::Window::State_t::Closed) {
             _window.reset();
+        } else {
+            requestUpdate();
         }
     }
 }
+
+void PanelGpioTest::evict()
+{
+    _window.reset();
+    _btn_gpio_test.reset();
+}
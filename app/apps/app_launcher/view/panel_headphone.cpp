@@ -13,6 +13,7 @@
 #include <smooth_lvgl.h>
 #include <apps/utils/audio/audio.h>
 #include <apps/utils/ui/window.h>
+#include <assets/font_engine.h>
 
 using namespace launcher_view;
 using namespace smooth_ui_toolkit;
@@ -50,11 +51,11 @@ public:
             update_rec_button();
         });
 
-        _rec_btn->label().setTextFont(&lv_font_montserrat_16);
+        _rec_btn->label().setTextFont(assets::get_font(16));
         _rec_btn->label().setTextColor(lv_color_hex(0xF4F3F3));
 
         _label_hp_detect = std::make_unique<Label>(_window->get());
-        _label_hp_detect->setTextFont(&lv_font_montserrat_18);
+        _label_hp_detect->setTextFont(assets::get_font(18));
         _label_hp_detect->align(LV_ALIGN_CENTER, 0, 70);
     }
 
@@ -164,6 +165,7 @@ void PanelHeadphone::init()
         _window = std::make_unique<HeadphoneTestWindow>();
         _window->init(lv_screen_active());
         _window->open();
+        requestUpdate();
     });
 }
 
@@ -173,6 +175,14 @@ void PanelHeadphone::update(bool isStacked)
         _window->update();
         if (_window->getState() == ui::Window::State_t::Closed) {
             _window.reset();
+        } else {
+            requestUpdate();
         }
     }
 }
+
+void PanelHeadphone::evict()
+{
+    _window.reset();
+    _btn_headphone_test.reset();
+}
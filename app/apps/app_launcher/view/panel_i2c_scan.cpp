@@ -14,7 +14,10 @@
 #include <apps/utils/ui/window.h>
 #include <apps/utils/ui/toast.h>
 #include <assets/assets.h>
+#include <assets/font_engine.h>
 #include <stdint.h>
+#include <algorithm>
+#include <map>
 #include <vector>
 
 using namespace launcher_view;
@@ -50,10 +53,10 @@ public:
         _btn_porta_scan->setOpa(0);
         _btn_porta_scan->onClick().connect([&] {
             _is_scanning_internal = false;
-            _scan_time_count      = 0;
             audio::play_tone_from_midi(60 + 24);
             update_i2c_dev_chart();
             update_btn_ext5v_on();
+            restart_scan();
         });
 
         _btn_internal_scan = std::make_unique<Container>(_window->get());
@@ -62,10 +65,10 @@ public:
         _btn_internal_scan->setOpa(0);
         _btn_internal_scan->onClick().connect([&] {
             _is_scanning_internal = true;
-            _scan_time_count      = 0;
             audio::play_tone_from_midi(63 + 24);
             update_i2c_dev_chart();
             update_btn_ext5v_on();
+            restart_scan();
         });
 
         _btn_ext5v_on = std::make_unique<Image>(_window->get());
@@ -92,29 +95,29 @@ public:
             return;
         }
 
-        if (GetHAL()->millis() - _scan_time_count < 300) {
+        // The scan runs on its own task, labels show up as the devices answer
+        if (_scan_id != 0) {
+            update_scan_labels();
             return;
         }
 
-        // Scan and create labels
-        std::vector<uint8_t> addrs;
-        if (!_is_scanning_internal && !GetHAL()->getExt5vEnable()) {
-            // Scan without ext 5v cause no response blocking
-        } else {
-            addrs = GetHAL()->i2cScan(_is_scanning_internal);
+        if (GetHAL()->millis() - _scan_time_count < 300) {
+            return;
         }
-        _label_addrs.clear();
-        for (auto addr : addrs) {
-            _label_addrs.push_back(std::make_unique<Label>(_window->get()));
-            apply_addr_label_style(_label_addrs.back().get(), addr);
+        if (!_is_scanning_internal && !GetHAL()->getExt5vEnable()) {
+            // Without ext 5v nothing answers on Port A
+            _label_addrs.clear();
+            _scan_time_count = GetHAL()->millis();
+            return;
         }
-
+        _scan_id         = GetHAL()->startI2cScan(_is_scanning_internal);
         _scan_time_count = GetHAL()->millis();
     }
 
     void onClose() override
     {
         audio::play_next_tone_progression();
+        GetHAL()->cancelI2cScan();
         _label_addrs.clear();
         _img_i2c_dev_chart.reset();
         GetHAL()->deinitPortAI2c();
@@ -125,9 +128,48 @@ private:
     std::unique_ptr<Container> _btn_porta_scan;
     std::unique_ptr<Container> _btn_internal_scan;
     std::unique_ptr<Image> _btn_ext5v_on;
-    std::vector<std::unique_ptr<Label>> _label_addrs;
+    std::map<uint8_t, std::unique_ptr<Label>> _label_addrs;
     bool _is_scanning_internal = true;
     uint32_t _scan_time_count  = 0;
+    uint32_t _scan_id          = 0;
+
+    // Switching bus, the old labels go and the next update starts a scan
+    void restart_scan()
+    {
+        GetHAL()->cancelI2cScan();
+        _label_addrs.clear();
+        _scan_id         = 0;
+        _scan_time_count = 0;
+    }
+
+    void update_scan_labels()
+    {
+        hal::HalBase::I2cScanProgress_t progress;
+        if (!GetHAL()->getI2cScanProgress(progress) || progress.scanId != _scan_id) {
+            _scan_id = 0;
+            return;
+        }
+
+        for (auto addr : progress.addresses) {
+            if (_label_addrs.find(addr) == _label_addrs.end()) {
+                auto label = std::make_unique<Label>(_window->get());
+                apply_addr_label_style(label.get(), addr);
+                _label_addrs[addr] = std::move(label);
+            }
+        }
+        if (!progress.isDone) {
+            return;
+        }
+
+        // Kept until the scan is through, so a device that is still there does not blink
+        for (auto it = _label_addrs.begin(); it != _label_addrs.end();) {
+            bool is_found =
+                std::find(progress.addresses.begin(), progress.addresses.end(), it->first) != progress.addresses.end();
+            it = is_found ? std::next(it) : _label_addrs.erase(it);
+        }
+        _scan_id         = 0;
+        _scan_time_count = GetHAL()->millis();
+    }
 
     void update_i2c_dev_chart()
     {
@@ -147,7 +189,7 @@ private:
         int16_t y = 136 + row * 27 - 356 / 2;
 
         label->align(LV_ALIGN_CENTER, x, y);
-        label->setTextFont(&lv_font_montserrat_16);
+        label->setTextFont(assets::get_font(16));
         label->setTextColor(lv_color_hex(0x352B2A));
         label->setText(fmt::format("{:02X}", addr));
     }
@@ -180,6 +222,7 @@ void PanelI2cScan::init()
         _window = std::make_unique<I2cScanWindow>();
         _window->init(lv_screen_active());
         _window->open();
+        requestUpdate();
     });
 }
 
@@ -189,6 +232,14 @@ void PanelI2cScan::update(bool isStacked)
         _window->update();
         if (_window->getState() == ui::Window::State_t::Closed) {
             _window.reset();
+        } else {
+            requestUpdate();
         }
     }
 }
+
+void PanelI2cScan::evict()
+{
+    _window.reset();
+    _btn_i2c_scan.reset();
+}
@@ -6,12 +6,18 @@
 #include "view.h"
 #include <algorithm>
 #include <cstdint>
+#include <iterator>
 #include <lvgl.h>
 #include <hal/hal.h>
 #include <mooncake_log.h>
 #include <smooth_ui_toolkit.h>
 #include <smooth_lvgl.h>
 #include <apps/utils/audio/audio.h>
+#include <apps/utils/ui/anim_clock.h>
+#include <apps/utils/ui/window.h>
+#include <apps/utils/ui/history_chart.h>
+#include <apps/utils/ui/label_binding.h>
+#include <assets/font_engine.h>
 
 using namespace launcher_view;
 using namespace smooth_ui_toolkit;
@@ -29,26 +35,152 @@ static constexpr int16_t _accel_dot_pos_x     = 371;
 static constexpr int16_t _accel_dot_pos_y     = 198;
 static constexpr uint32_t _label_color        = 0x606060;
 static constexpr uint32_t _accel_dot_color    = 0xFF589D;
+// Older than this the cached reading is refreshed with a blocking read
+static constexpr uint32_t _stale_time = 300;
+
+static const ui::Window::KeyFrame_t _kf_history_close = {371, 198, 75, 75, 0};
+static const ui::Window::KeyFrame_t _kf_history_open  = {0, 40, 900, 520, 255};
+// Seconds across the chart, a tap on the span button moves to the next
+static constexpr uint32_t _history_spans[]    = {60, 600, 3600};
+static constexpr const char* _history_names[] = {"1 min", "10 min", "1 h"};
+static constexpr uint16_t _history_points     = 300;
+static constexpr uint32_t _axis_colors[]      = {0xFF5A5A, 0x5AE07A, 0x4FA8FF};
+
+class ImuHistoryWindow : public ui::Window {
+public:
+    ImuHistoryWindow()
+    {
+        config.title    = "IMU History";
+        config.kfClosed = _kf_history_close;
+        config.kfOpened = _kf_history_open;
+    }
+
+    void onOpen() override
+    {
+        _window->setScrollbarMode(LV_SCROLLBAR_MODE_OFF);
+    }
+
+    void onUpdate() override
+    {
+        // Built once opened, the chart is too heavy to redraw through the open animation
+        if (_state != Opened) {
+            return;
+        }
+        if (!_chart.get()) {
+            create_chart();
+        }
+
+        // Everything the sensor service read since the last update, several per redraw
+        hal::HalBase::IMUData_t samples[32];
+        size_t size = 0;
+        while ((size = GetHAL()->imuHistory.read(_cursor, samples, 32)) > 0) {
+            for (size_t i = 0; i < size; i++) {
+                float accel[3] = {samples[i].accelX, samples[i].accelY, samples[i].accelZ};
+                _chart.push(accel);
+            }
+        }
+
+        _max_text.set("{:.2f}g", _chart.getRangeMax());
+        _min_text.set("{:.2f}g", _chart.getRangeMin());
+    }
+
+    void onClose() override
+    {
+        audio::play_next_tone_progression();
+        _btn_span.reset();
+        _labels.clear();
+    }
+
+private:
+    ui::HistoryChart _chart;
+    std::vector<std::unique_ptr<Label>> _labels;
+    std::unique_ptr<Button> _btn_span;
+    ui::LabelBinding<16> _max_text;
+    ui::LabelBinding<16> _min_text;
+    uint32_t _cursor   = 0;
+    size_t _span_index = 0;
+
+    uint16_t samples_per_point() const
+    {
+        uint32_t interval_ms = hal::HalBase::SensorServiceConfig_t().imuIntervalMs;
+        return std::max<uint32_t>(_history_spans[_span_index] * 1000 / interval_ms / _history_points, 1);
+    }
+
+    void create_chart()
+    {
+        ui::HistoryChart::Config_t chart_config;
+        chart_config.points          = _history_points;
+        chart_config.samplesPerPoint = samples_per_point();
+        chart_config.minSpan         = 0.2f;
+        chart_config.bgColor         = config.bgColor;
+        _chart.init(_window->get(), chart_config);
+        _chart.get()->setSize(840, 380);
+        _chart.get()->align(LV_ALIGN_TOP_MID, 0, 50);
+        for (auto color : _axis_colors) {
+            _chart.addTrace(lv_color_hex(color));
+        }
+
+        _max_text.bind(create_label(LV_ALIGN_TOP_LEFT, 40, 56, 0xA0A0A0));
+        _min_text.bind(create_label(LV_ALIGN_TOP_LEFT, 40, 404, 0xA0A0A0));
+        create_label(LV_ALIGN_BOTTOM_LEFT, 40, -20, _axis_colors[0])->setText("X");
+        create_label(LV_ALIGN_BOTTOM_LEFT, 80, -20, _axis_colors[1])->setText("Y");
+        create_label(LV_ALIGN_BOTTOM_LEFT, 120, -20, _axis_colors[2])->setText("Z");
+
+        _btn_span = std::make_unique<Button>(_window->get());
+        _btn_span->align(LV_ALIGN_BOTTOM_RIGHT, -30, -12);
+        _btn_span->setSize(140, 40);
+        _btn_span->label().setText(_history_names[_span_index]);
+        _btn_span->label().setTextFont(assets::get_font(20));
+        _btn_span->setShadowWidth(0);
+        _btn_span->setRadius(18);
+        _btn_span->setBgColor(lv_color_hex(0xF26F42));
+        _btn_span->onClick().connect([&] {
+            audio::play_next_tone_progression();
+            _span_index = (_span_index + 1) % std::size(_history_spans);
+            _btn_span->label().setText(_history_names[_span_index]);
+            // The ring still holds the last seconds, they are drawn again at the new span
+            _chart.reset(samples_per_point());
+            _cursor = 0;
+        });
+    }
+
+    Label* create_label(lv_align_t align, int16_t x, int16_t y, uint32_t color)
+    {
+        auto label = std::make_unique<Label>(_window->get());
+        label->align(align, x, y);
+        label->setTextFont(assets::get_font(16));
+        label->setTextColor(lv_color_hex(color));
+        label->setText("..");
+        _labels.push_back(std::move(label));
+        return _labels.back().get();
+    }
+};
 
 void PanelImu::init()
 {
+    // Samples come from the sensor task, the UI loop only picks up the latest
+    GetHAL()->startImuStream();
+
     _label_accel_x = std::make_unique<Label>(lv_screen_active());
     _label_accel_x->align(LV_ALIGN_LEFT_MID, _label_accel_x_pos_x, _label_accel_x_pos_y);
     _label_accel_x->setTextColor(lv_color_hex(_label_color));
-    _label_accel_x->setTextFont(&lv_font_montserrat_16);
+    _label_accel_x->setTextFont(assets::get_font(16));
     _label_accel_x->setText("..");
+    _accel_x_text.bind(_label_accel_x.get());
 
     _label_accel_y = std::make_unique<Label>(lv_screen_active());
     _label_accel_y->align(LV_ALIGN_LEFT_MID, _label_accel_y_pos_x, _label_accel_y_pos_y);
     _label_accel_y->setTextColor(lv_color_hex(_label_color));
-    _label_accel_y->setTextFont(&lv_font_montserrat_16);
+    _label_accel_y->setTextFont(assets::get_font(16));
     _label_accel_y->setText("..");
+    _accel_y_text.bind(_label_accel_y.get());
 
     _label_accel_z = std::make_unique<Label>(lv_screen_active());
     _label_accel_z->align(LV_ALIGN_LEFT_MID, _label_accel_z_pos_x, _label_accel_z_pos_y);
     _label_accel_z->setTextColor(lv_color_hex(_label_color));
-    _label_accel_z->setTextFont(&lv_font_montserrat_16);
+    _label_accel_z->setTextFont(assets::get_font(16));
     _label_accel_z->setText("..");
+    _accel_z_text.bind(_label_accel_z.get());
 
     _accel_dot = std::make_unique<Container>(lv_screen_active());
     _accel_dot->align(LV_ALIGN_CENTER, _accel_dot_pos_x, _accel_dot_pos_y);
@@ -75,36 +207,83 @@ void PanelImu::init()
     _anim_size.easingOptions().easingFunction = ease::linear;
     _anim_size.teleport(22);
     _anim_size.play();
+
+    // Over the readings and the dot
+    _btn_history = std::make_unique<Container>(lv_screen_active());
+    _btn_history->align(LV_ALIGN_CENTER, 371, 198);
+    _btn_history->setSize(240, 150);
+    _btn_history->setOpa(0);
+    _btn_history->onClick().connect([&] {
+        audio::play_next_tone_progression();
+
+        // Create window
+        _window = std::make_unique<ImuHistoryWindow>();
+        _window->init(lv_screen_active());
+        _window->open();
+        requestUpdate();
+    });
+
+    setUpdatePeriod(100);
 }
 
 void PanelImu::update(bool isStacked)
 {
-    if (!(_anim_x.done() && _anim_y.done() && _anim_size.done())) {
+    // Every frame only while it moves, open it follows the panel period
+    if (_window) {
+        _window->update();
+        if (_window->getState() == ui::Window::State_t::Closed) {
+            _window.reset();
+        } else if (_window->getState() != ui::Window::State_t::Opened) {
+            requestUpdate();
+        }
+    }
+
+    if (ui::anim_clock::is_running(_anim_x, _anim_y, _anim_size)) {
         _accel_dot->setPos(_anim_x, _anim_y);
         _anim_size.update();
         _accel_dot->setSize(_anim_size.directValue(), _anim_size.directValue());
+        requestUpdate();
+    }
+
+    if (!isPeriodElapsed()) {
+        return;
     }
 
-    if (GetHAL()->millis() - _time_count < 100) {
+    // Kept fresh by the sensor service or the stream, the blocking read only runs when it went stale
+    hal::HalBase::IMUData_t imu_data;
+    uint32_t version = 0;
+    uint32_t time    = 0;
+    if (!GetHAL()->imuSnapshot.read(imu_data, &version, &time) || GetHAL()->millis() - time > _stale_time) {
+        GetHAL()->updateImuData();
+        GetHAL()->imuSnapshot.read(imu_data, &version);
+    }
+    // Same reading as the last redraw
+    if (version == _imu_version) {
         return;
     }
+    _imu_version = version;
 
-    GetHAL()->updateImuData();
-    _label_accel_x->setText(fmt::format("X:{:.1f}", GetHAL()->imuData.accelX));
-    _label_accel_y->setText(fmt::format("Y:{:.1f}", GetHAL()->imuData.accelY));
-    _label_accel_z->setText(fmt::format("Z:{:.1f}", GetHAL()->imuData.accelZ));
+    // A new sample mostly rounds to the same text, those labels are left alone
+    _accel_x_text.set("X:{:.1f}", imu_data.accelX);
+    _accel_y_text.set("Y:{:.1f}", imu_data.accelY);
+    _accel_z_text.set("Z:{:.1f}", imu_data.accelZ);
 
-    // Update dot position
-    int dot_offset_x = std::clamp((int)(GetHAL()->imuData.accelX * 50), -50, 50);
-    int dot_offset_y = std::clamp((int)(GetHAL()->imuData.accelY * 50), -50, 50);
+    // Update dot position, from the fused gravity when there is one, it stays still while shaking
+    float tilt_x = imu_data.accelX;
+    float tilt_y = imu_data.accelY;
+    hal::HalBase::ImuOrientation_t orientation;
+    if (GetHAL()->getImuOrientation(orientation)) {
+        tilt_x = orientation.gravityX;
+        tilt_y = orientation.gravityY;
+    }
+    int dot_offset_x = std::clamp((int)(tilt_x * 50), -50, 50);
+    int dot_offset_y = std::clamp((int)(tilt_y * 50), -50, 50);
     _anim_x          = _accel_dot_pos_x + dot_offset_x;
     _anim_y          = _accel_dot_pos_y + dot_offset_y;
 
     // Update dot size
-    float gyro_mag = std::max(
-        {std::abs(GetHAL()->imuData.gyroX), std::abs(GetHAL()->imuData.gyroY), std::abs(GetHAL()->imuData.gyroZ)});
-    float accel_mag = std::max(
-        {std::abs(GetHAL()->imuData.accelX), std::abs(GetHAL()->imuData.accelY), std::abs(GetHAL()->imuData.accelZ)});
+    float gyro_mag     = std::max({std::abs(imu_data.gyroX), std::abs(imu_data.gyroY), std::abs(imu_data.gyroZ)});
+    float accel_mag    = std::max({std::abs(imu_data.accelX), std::abs(imu_data.accelY), std::abs(imu_data.accelZ)});
     float motion_score = std::max(gyro_mag, accel_mag) * 10;
 
     // (10, 20) -> (22, 58)
@@ -115,6 +294,19 @@ void PanelImu::update(bool isStacked)
     } else {
         _anim_size = 22 + (motion_score - 10) * (58 - 22) / (20 - 10);
     }
+}
 
-    _time_count = GetHAL()->millis();
+void PanelImu::evict()
+{
+    _accel_x_text.bind(nullptr);
+    _accel_y_text.bind(nullptr);
+    _accel_z_text.bind(nullptr);
+    _window.reset();
+    _btn_history.reset();
+    _accel_dot.reset();
+    _label_accel_z.reset();
+    _label_accel_y.reset();
+    _label_accel_x.reset();
+    // The version describes what the old labels show, the new ones start empty
+    _imu_version = 0;
 }
@@ -11,6 +11,8 @@
 #include <smooth_ui_toolkit.h>
 #include <smooth_lvgl.h>
 #include <apps/utils/audio/audio.h>
+#include <apps/utils/ui/anim_clock.h>
+#include <assets/font_engine.h>
 
 using namespace launcher_view;
 using namespace smooth_ui_toolkit;
@@ -34,7 +36,7 @@ void PanelLcdBacklight::init()
 {
     _label_brightness = std::make_unique<Label>(lv_screen_active());
     _label_brightness->align(LV_ALIGN_CENTER, _label_pos_x, _label_pos_y);
-    _label_brightness->setTextFont(&lv_font_montserrat_36);
+    _label_brightness->setTextFont(assets::get_font(36));
     _label_brightness->setTextColor(lv_color_hex(0xFEFEFE));
     _label_brightness->setText(fmt::format("{}", GetHAL()->getDisplayBrightness()));
 
@@ -46,6 +48,7 @@ void PanelLcdBacklight::init()
         // Animation
         _label_y_anim.teleport(_label_pos_y - 8);
         _label_y_anim = _label_pos_y;
+        requestUpdate();
 
         // SFX
         if (GetHAL()->getDisplayBrightness() >= 100) {
@@ -69,6 +72,7 @@ void PanelLcdBacklight::init()
         // Animation
         _label_y_anim.teleport(_label_pos_y + 8);
         _label_y_anim = _label_pos_y;
+        requestUpdate();
 
         // SFX
         if (GetHAL()->getDisplayBrightness() <= 20) {
@@ -90,7 +94,15 @@ void PanelLcdBacklight::init()
 
 void PanelLcdBacklight::update(bool isStacked)
 {
-    if (!_label_y_anim.done()) {
+    if (ui::anim_clock::is_running(_label_y_anim)) {
         _label_brightness->setY(_label_y_anim);
+        requestUpdate();
     }
 }
+
+void PanelLcdBacklight::evict()
+{
+    _btn_down.reset();
+    _btn_up.reset();
+    _label_brightness.reset();
+}
@@ -13,6 +13,7 @@
 #include <apps/utils/audio/audio.h>
 #include <apps/utils/ui/window.h>
 #include <apps/utils/ui/toast.h>
+#include <assets/font_engine.h>
 
 using namespace launcher_view;
 using namespace smooth_ui_toolkit;
@@ -46,7 +47,7 @@ public:
         _label_aec->align(LV_ALIGN_CENTER, -60, 59);
         _label_aec->setText("Speaker Output Capture");
         _label_aec->setTextColor(lv_color_hex(0xD6D6D6));
-        _label_aec->setTextFont(&lv_font_montserrat_16);
+        _label_aec->setTextFont(assets::get_font(16));
 
         _chart_aec = std::make_unique<Chart>(_window->get());
         apply_chart_style(_chart_aec.get(), -60, -17);
@@ -68,7 +69,7 @@ public:
             update_rec_button();
         });
 
-        _rec_btn->label().setTextFont(&lv_font_montserrat_18);
+        _rec_btn->label().setTextFont(assets::get_font(18));
         _rec_btn->label().setTextColor(lv_color_hex(0x0B4D2C));
 
         update_rec_button();
@@ -166,6 +167,7 @@ void PanelMusic::init()
         _window = std::make_unique<MusicTestWindow>();
         _window->init(lv_screen_active());
         _window->open();
+        requestUpdate();
     });
 }
 
@@ -175,6 +177,14 @@ void PanelMusic::update(bool isStacked)
         _window->update();
         if (_window->getState() == ui::Window::State_t::Closed) {
             _window.reset();
+        } else {
+            requestUpdate();
         }
     }
 }
+
+void PanelMusic::evict()
+{
+    _window.reset();
+    _btn_music_test.reset();
+}
@@ -0,0 +1,333 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "view.h"
+#include <algorithm>
+#include <ctime>
+#include <lvgl.h>
+#include <hal/hal.h>
+#include <mooncake_log.h>
+#include <smooth_ui_toolkit.h>
+#include <smooth_lvgl.h>
+#include <apps/utils/audio/audio.h>
+#include <apps/utils/ui/toast.h>
+#include <apps/utils/memory/frame_arena.h>
+#include <assets/font_engine.h>
+#if LV_USE_PERF_MONITOR
+#include <src/display/lv_display_private.h>
+#endif
+
+using namespace launcher_view;
+using namespace smooth_ui_toolkit;
+using namespace smooth_ui_toolkit::lvgl_cpp;
+
+static const std::string _tag = "panel-perf-hud";
+
+static constexpr uint32_t _update_interval = 500;
+static constexpr size_t _max_task_num      = 8;
+static constexpr size_t _max_stack_num     = 6;
+static constexpr size_t _max_lock_site_num = 6;
+// The trace AppBenchmark replays after its scripted scenarios
+static const char* _input_trace_path = "bench_input.trace";
+
+static std::string format_kb(uint32_t bytes)
+{
+    if (bytes >= 1024 * 1024) {
+        return fmt::format("{:.1f}M", bytes / 1024.0f / 1024.0f);
+    }
+    return fmt::format("{}K", bytes / 1024);
+}
+
+static const char* perf_level_name(hal::HalBase::PerfLevel_t level)
+{
+    switch (level) {
+        case hal::HalBase::PERF_LEVEL_AWAKE:
+            return "awake";
+        case hal::HalBase::PERF_LEVEL_MAX:
+            return "max";
+        default:
+            return "idle";
+    }
+}
+
+static const char* audio_dma_profile_name(hal::HalBase::AudioDmaProfile_t profile)
+{
+    switch (profile) {
+        case hal::HalBase::AUDIO_DMA_LOW_LATENCY:
+            return "low latency";
+        case hal::HalBase::AUDIO_DMA_RECORDING:
+            return "recording";
+        default:
+            return "music";
+    }
+}
+
+static std::string format_hit_rate(uint32_t hits, uint32_t misses)
+{
+    if (hits + misses == 0) {
+        return "--";
+    }
+    return fmt::format("{}%", hits * 100 / (hits + misses));
+}
+
+void PanelPerfHud::init()
+{
+#if LV_USE_PERF_MONITOR
+    // Keep the sysmon perf sampling running, but draw its numbers in the HUD instead of the builtin label
+    lv_sysmon_show_performance(lv_display_get_default());
+    lv_sysmon_hide_performance(lv_display_get_default());
+#endif
+
+    // Hidden hot spot in the top left corner toggles the HUD, the HUD itself only exists while shown
+    _btn_toggle = std::make_unique<Container>(lv_screen_active());
+    _btn_toggle->align(LV_ALIGN_TOP_LEFT, 0, 0);
+    _btn_toggle->setSize(64, 64);
+    _btn_toggle->setOpa(0);
+    _btn_toggle->onClick().connect([&]() {
+        audio::play_next_tone_progression();
+        _is_shown = !_is_shown;
+        mclog::tagInfo(_tag, "hud {}", _is_shown ? "on" : "off");
+        if (_is_shown) {
+            create_hud();
+            requestUpdate();
+        } else {
+            destroy_hud();
+        }
+        // Not scheduled at all while hidden
+        setUpdatePeriod(_is_shown ? _update_interval : 0);
+    });
+
+    // Built again after a suspend, the HUD comes back the way it was left
+    if (_is_shown) {
+        create_hud();
+        requestUpdate();
+    }
+}
+
+void PanelPerfHud::create_hud()
+{
+    // On the top layer, so the HUD stays above opened windows
+    _panel = std::make_unique<Container>(lv_layer_top());
+    _panel->align(LV_ALIGN_TOP_LEFT, 12, 12);
+    _panel->setSize(440, LV_SIZE_CONTENT);
+    _panel->setRadius(12);
+    _panel->setBorderWidth(0);
+    _panel->setBgColor(lv_color_hex(0x000000));
+    _panel->setBgOpa(LV_OPA_70, LV_PART_MAIN);
+    _panel->removeFlag(LV_OBJ_FLAG_SCROLLABLE);
+    _panel->removeFlag(LV_OBJ_FLAG_CLICKABLE);
+
+    _label_stats = std::make_unique<Label>(_panel->get());
+    _label_stats->align(LV_ALIGN_TOP_LEFT, 0, 0);
+    _label_stats->setTextFont(assets::get_font(16));
+    _label_stats->setTextColor(lv_color_hex(0x7CFC9A));
+    _label_stats->setText("..");
+
+    // Records the power draw tagged with the app state to SD, for offline analysis
+    _btn_profile = std::make_unique<Button>(_panel->get());
+    _btn_profile->align(LV_ALIGN_TOP_RIGHT, 0, 0);
+    _btn_profile->setSize(90, 40);
+    _btn_profile->setRadius(12);
+    _btn_profile->setShadowWidth(0);
+    _btn_profile->setBgColor(lv_color_hex(0x3A3A3A));
+    _btn_profile->label().setTextFont(assets::get_font(16));
+    _btn_profile->label().setText("REC");
+    _btn_profile->onClick().connect([&]() {
+        audio::play_next_tone_progression();
+        toggle_power_profile();
+    });
+
+    // Records the taps to the trace the benchmark replays
+    _btn_input = std::make_unique<Button>(_panel->get());
+    _btn_input->align(LV_ALIGN_TOP_RIGHT, -100, 0);
+    _btn_input->setSize(90, 40);
+    _btn_input->setRadius(12);
+    _btn_input->setShadowWidth(0);
+    _btn_input->setBgColor(lv_color_hex(0x3A3A3A));
+    _btn_input->label().setTextFont(assets::get_font(16));
+    _btn_input->onClick().connect([&]() {
+        audio::play_next_tone_progression();
+        toggle_input_record();
+    });
+
+    update_profile_button();
+    update_input_button();
+}
+
+void PanelPerfHud::destroy_hud()
+{
+    // Children before their parent
+    _btn_input.reset();
+    _btn_profile.reset();
+    _label_stats.reset();
+    _panel.reset();
+}
+
+void PanelPerfHud::toggle_power_profile()
+{
+    if (GetHAL()->isPowerProfiling()) {
+        GetHAL()->stopPowerProfile();
+        ui::pop_a_toast("Power profile saved", ui::toast_type::success);
+    } else {
+        std::time_t now = std::time(nullptr);
+        char path[48];
+        std::strftime(path, sizeof(path), "power_%Y%m%d_%H%M%S.bin", std::localtime(&now));
+        if (GetHAL()->startPowerProfile(path)) {
+            ui::pop_a_toast(fmt::format("Recording {}", path), ui::toast_type::info);
+        } else {
+            ui::pop_a_toast("Power profile needs an SD card", ui::toast_type::error);
+        }
+    }
+    update_profile_button();
+}
+
+void PanelPerfHud::update_profile_button()
+{
+    bool is_profiling = GetHAL()->isPowerProfiling();
+    _btn_profile->label().setText(is_profiling ? "STOP" : "REC");
+    _btn_profile->setBgColor(lv_color_hex(is_profiling ? 0xC0392B : 0x3A3A3A));
+}
+
+void PanelPerfHud::toggle_input_record()
+{
+    auto status = GetHAL()->getInputTraceStatus();
+    if (status.state == hal::HalBase::INPUT_TRACE_RECORDING) {
+        // The tap on this button is not part of the trace
+        GetHAL()->stopInputTrace(true);
+        ui::pop_a_toast(fmt::format("Input trace saved, {} events", status.events), ui::toast_type::success);
+    } else if (GetHAL()->startInputRecord(_input_trace_path)) {
+        ui::pop_a_toast(fmt::format("Recording {}", _input_trace_path), ui::toast_type::info);
+    } else {
+        ui::pop_a_toast("Input record failed", ui::toast_type::error);
+    }
+    update_input_button();
+}
+
+void PanelPerfHud::update_input_button()
+{
+    bool is_recording = GetHAL()->getInputTraceStatus().state == hal::HalBase::INPUT_TRACE_RECORDING;
+    _btn_input->label().setText(is_recording ? "STOP" : "INPUT");
+    _btn_input->setBgColor(lv_color_hex(is_recording ? 0xC0392B : 0x3A3A3A));
+}
+
+void PanelPerfHud::update(bool isStacked)
+{
+    if (!_is_shown) {
+        return;
+    }
+
+    // Rebuilt on every update, from the frame arena instead of a growing heap string
+    memory::FrameText text(memory::get_frame_arena(), 2048);
+
+#if LV_USE_PERF_MONITOR
+    const auto& perf = lv_display_get_default()->perf_sysmon_info.calculated;
+    text.append("FPS {}   LVGL CPU {}%\n", perf.fps, perf.cpu);
+    text.append("Refr {} ms  Render {} ms  Flush {} ms\n", perf.refr_avg_time, perf.render_avg_time,
+                perf.flush_avg_time);
+#else
+    text.append("LVGL sysmon disabled\n");
+#endif
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    lv_mem_monitor_t mem_mon;
+    lv_mem_monitor(&mem_mon);
+    text.append("LVGL heap {} / {}  frag {}%\n", format_kb(mem_mon.total_size - mem_mon.free_size),
+                format_kb(mem_mon.total_size), mem_mon.frag_pct);
+#endif
+
+    auto lvgl_mem_stats = GetHAL()->getLvglMemStats();
+    if (lvgl_mem_stats.supported) {
+        text.append("LVGL sram {} ({})  peak {}\n", format_kb(lvgl_mem_stats.internalUsed),
+                    lvgl_mem_stats.internalCount, format_kb(lvgl_mem_stats.internalPeak));
+        text.append("LVGL psram {} ({})  peak {}  spill {}\n", format_kb(lvgl_mem_stats.psramUsed),
+                    lvgl_mem_stats.psramCount, format_kb(lvgl_mem_stats.psramPeak), lvgl_mem_stats.fallbacks);
+    }
+    if (lvgl_mem_stats.layerBuffers > 0) {
+        text.append("Layer pool {}  hit {}\n", lvgl_mem_stats.layerBuffers,
+                    format_hit_rate(lvgl_mem_stats.layerHits, lvgl_mem_stats.layerMisses));
+    }
+
+    auto vsync_stats = GetHAL()->getVsyncStats();
+    if (vsync_stats.supported) {
+        text.append("Vsync {}  frames {}  missed {}\n", vsync_stats.vsyncs, vsync_stats.frames,
+                    vsync_stats.missedVsyncs);
+    }
+
+    auto system_stats = GetHAL()->getSystemStats();
+    text.append("Perf level {}  panel {} Hz\n", perf_level_name(GetHAL()->getPerfLevel()),
+                GetHAL()->getDisplayRefreshRate());
+    text.append("Internal free {}  min {}  block {}\n", format_kb(system_stats.internalFree),
+                format_kb(system_stats.internalMinFree), format_kb(system_stats.internalLargestFree));
+    text.append("PSRAM free {}  min {}  block {}\n", format_kb(system_stats.psramFree),
+                format_kb(system_stats.psramMinFree), format_kb(system_stats.psramLargestFree));
+
+    // Underruns only count while the mixer plays, overruns while a capture reads
+    auto dma_stats = GetHAL()->getAudioDmaStats();
+    if (dma_stats.supported) {
+        text.append("Audio DMA {} {}x{} {:.1f}ms  underrun {}  overrun {}\n", audio_dma_profile_name(dma_stats.profile),
+                    dma_stats.descNum, dma_stats.frameNum, dma_stats.latencyMs, dma_stats.txUnderruns,
+                    dma_stats.rxOverruns);
+    }
+
+    auto cache_stats = GetHAL()->getLvglCacheStats();
+    text.append("Cache hit  image {}  glyph {}\n", format_hit_rate(cache_stats.imageHits, cache_stats.imageMisses),
+                format_hit_rate(cache_stats.glyphHits, cache_stats.glyphMisses));
+
+    // Wait is the time queued behind other devices on the internal bus
+    auto i2c_stats = GetHAL()->getI2cStats();
+    if (!i2c_stats.empty()) {
+        text.append("\nI2C   wait avg/max   bus avg/max us\n");
+        for (const auto& device : i2c_stats) {
+            text.append("0x{:02X}  {:>5}/{:<6} {:>5}/{:<6} {}\n", device.address, device.avgWaitUs, device.maxWaitUs,
+                        device.avgBusUs, device.maxBusUs, device.errors ? fmt::format("err {}", device.errors) : "");
+        }
+    }
+
+    // Longest total hold first, the callers that keep the others waiting on LVGL
+    auto lock_stats = GetHAL()->getLvglLockStats();
+    if (lock_stats.supported && !lock_stats.sites.empty()) {
+        text.append("\nLVGL lock   wait avg/max   hold avg/max us\n");
+        size_t site_num = std::min(lock_stats.sites.size(), _max_lock_site_num);
+        for (size_t i = 0; i < site_num; i++) {
+            const auto& site = lock_stats.sites[i];
+            text.append("{:<16.16} {:>5}/{:<6} {:>5}/{:<6}\n", site.site, site.avgWaitUs, site.maxWaitUs,
+                        site.avgHoldUs, site.maxHoldUs);
+        }
+        if (lock_stats.droppedCommands) {
+            text.append("UI commands dropped {}\n", lock_stats.droppedCommands);
+        }
+    }
+
+    if (!system_stats.tasks.empty()) {
+        text.append("\n");
+        size_t task_num = std::min(system_stats.tasks.size(), _max_task_num);
+        for (size_t i = 0; i < task_num; i++) {
+            const auto& task = system_stats.tasks[i];
+            text.append("{:<16} {:>5.1f}%  {}B\n", task.name, task.cpuLoad, task.stackFree);
+        }
+    }
+
+    // Lowest headroom since boot, the ones to look at before shrinking or growing a stack
+    auto watermarks = GetHAL()->getStackWatermarks();
+    if (!watermarks.empty()) {
+        text.append("\nStack min free\n");
+        size_t mark_num = std::min(watermarks.size(), _max_stack_num);
+        for (size_t i = 0; i < mark_num; i++) {
+            const auto& mark = watermarks[i];
+            text.append("{:<16} {}B{}\n", mark.name, mark.minFree, mark.isAlive ? "" : "  exited");
+        }
+    }
+
+    lv_label_set_text(_label_stats->get(), text.c_str());
+    // The recorder stops itself on a write error
+    update_profile_button();
+}
+
+void PanelPerfHud::evict()
+{
+    // Shown or not is kept, init() brings the HUD back with the toggle
+    destroy_hud();
+    _btn_toggle.reset();
+}
@@ -11,6 +11,8 @@
 #include <smooth_ui_toolkit.h>
 #include <smooth_lvgl.h>
 #include <apps/utils/audio/audio.h>
+#include <apps/utils/background/jobs.h>
+#include <assets/font_engine.h>
 
 using namespace launcher_view;
 using namespace smooth_ui_toolkit;
@@ -41,7 +43,7 @@ public:
     {
         label->align(LV_ALIGN_LEFT_MID, x, y);
         label->setTextColor(lv_color_hex(0xFFFFFF));
-        label->setTextFont(&lv_font_montserrat_36);
+        label->setTextFont(assets::get_font(36));
         label->setText(text);
     }
 
@@ -49,7 +51,7 @@ public:
     {
         label->align(LV_ALIGN_LEFT_MID, x, y);
         label->setTextColor(lv_color_hex(0xFFFFFF));
-        label->setTextFont(&lv_font_montserrat_24);
+        label->setTextFont(assets::get_font(24));
         label->setText(text);
     }
 
@@ -62,7 +64,7 @@ public:
         btn->setShadowWidth(0);
         btn->label().setText(label);
         btn->label().setTextColor(lv_color_hex(0xFFFFFF));
-        btn->label().setTextFont(&lv_font_montserrat_24);
+        btn->label().setTextFont(assets::get_font(24));
     }
 
 protected:
@@ -142,7 +144,10 @@ public:
         apply_button_style(_btn_cancel.get(), -24, 78, 0x54553D, "Cancel");
 
         _btn_confirm->onClick().connect([&]() {
-            GetHAL()->sleepAndTouchWakeup();
+            // Off the LVGL task, which the sleep only pauses, the window closes while the backlight fades out
+            if (!background::run_job([]() { GetHAL()->sleepAndTouchWakeup(); })) {
+                GetHAL()->sleepAndTouchWakeup();
+            }
             close();
         });
         apply_button_style(_btn_confirm.get(), 207, 78, 0x979A60, "Sleep");
@@ -221,6 +226,7 @@ void PanelPower::init()
         _window = std::make_unique<PowerOffWindow>();
         _window->init(lv_screen_active());
         _window->open();
+        requestUpdate();
     });
 
     _btn_sleep_touch_wakeup = std::make_unique<Container>(lv_screen_active());
@@ -234,6 +240,7 @@ void PanelPower::init()
         _window = std::make_unique<SleepTouchWakeupWindow>();
         _window->init(lv_screen_active());
         _window->open();
+        requestUpdate();
     });
 
     _btn_sleep_shake_wakeup = std::make_unique<Container>(lv_screen_active());
@@ -247,6 +254,7 @@ void PanelPower::init()
         _window = std::make_unique<SleepShakeWakeupWindow>();
         _window->init(lv_screen_active());
         _window->open();
+        requestUpdate();
     });
 
     _btn_sleep_rtc_wakeup = std::make_unique<Container>(lv_screen_active());
@@ -260,6 +268,7 @@ void PanelPower::init()
         _window = std::make_unique<SleepRtcWakeupWindow>();
         _window->init(lv_screen_active());
         _window->open();
+        requestUpdate();
     });
 }
 
@@ -269,6 +278,17 @@ void PanelPower::update(bool isStacked)
         _window->update();
         if (_window->getState() == ui::Window::State_t::Closed) {
             _window.reset();
+        } else {
+            requestUpdate();
         }
     }
 }
+
+void PanelPower::evict()
+{
+    _window.reset();
+    _btn_sleep_rtc_wakeup.reset();
+    _btn_sleep_shake_wakeup.reset();
+    _btn_sleep_touch_wakeup.reset();
+    _btn_power_off.reset();
+}
@@ -4,14 +4,21 @@
  * SPDX-License-Identifier: MIT
  */
 #include "view.h"
+#include <algorithm>
 #include <cstdint>
+#include <iterator>
+#include <vector>
 #include <lvgl.h>
 #include <hal/hal.h>
 #include <mooncake_log.h>
 #include <smooth_ui_toolkit.h>
 #include <smooth_lvgl.h>
 #include <apps/utils/audio/audio.h>
+#include <apps/utils/ui/window.h>
+#include <apps/utils/ui/history_chart.h>
+#include <apps/utils/ui/label_binding.h>
 #include <assets/assets.h>
+#include <assets/font_engine.h>
 
 using namespace launcher_view;
 using namespace smooth_ui_toolkit;
@@ -24,6 +31,135 @@ static constexpr int16_t _label_voltage_pos_y = -335;
 static constexpr int16_t _label_current_pos_x = -442;
 static constexpr int16_t _label_current_pos_y = -303;
 static constexpr uint32_t _label_color        = 0x333333;
+// Older than this the cached reading is refreshed with a blocking read
+static constexpr uint32_t _stale_time = 300;
+
+static const ui::Window::KeyFrame_t _kf_history_close = {150, -320, 75, 75, 0};
+static const ui::Window::KeyFrame_t _kf_history_open  = {0, 40, 900, 520, 255};
+// Seconds across the chart, a tap on the span button moves to the next
+static constexpr uint32_t _history_spans[]    = {60, 600, 3600};
+static constexpr const char* _history_names[] = {"1 min", "10 min", "1 h"};
+static constexpr uint16_t _history_points     = 300;
+
+class PowerHistoryWindow : public ui::Window {
+public:
+    PowerHistoryWindow()
+    {
+        config.title    = "Power History";
+        config.kfClosed = _kf_history_close;
+        config.kfOpened = _kf_history_open;
+    }
+
+    void onOpen() override
+    {
+        _window->setScrollbarMode(LV_SCROLLBAR_MODE_OFF);
+    }
+
+    void onUpdate() override
+    {
+        // Built once opened, the charts are too heavy to redraw through the open animation
+        if (_state != Opened) {
+            return;
+        }
+        if (!_chart_voltage.get()) {
+            create_charts();
+        }
+
+        // Everything the sensor service read since the last update, several per redraw
+        hal::HalBase::PMData_t samples[32];
+        size_t size = 0;
+        while ((size = GetHAL()->powerMonitorHistory.read(_cursor, samples, 32)) > 0) {
+            for (size_t i = 0; i < size; i++) {
+                _chart_voltage.push(&samples[i].busVoltage);
+                _chart_current.push(&samples[i].shuntCurrent);
+            }
+        }
+
+        _voltage_max_text.set("{:.2f}V", _chart_voltage.getRangeMax());
+        _voltage_min_text.set("{:.2f}V", _chart_voltage.getRangeMin());
+        _current_max_text.set("{:.2f}A", _chart_current.getRangeMax());
+        _current_min_text.set("{:.2f}A", _chart_current.getRangeMin());
+    }
+
+    void onClose() override
+    {
+        audio::play_next_tone_progression();
+        _btn_span.reset();
+        _labels.clear();
+    }
+
+private:
+    ui::HistoryChart _chart_voltage;
+    ui::HistoryChart _chart_current;
+    std::vector<std::unique_ptr<Label>> _labels;
+    std::unique_ptr<Button> _btn_span;
+    ui::LabelBinding<16> _voltage_max_text;
+    ui::LabelBinding<16> _voltage_min_text;
+    ui::LabelBinding<16> _current_max_text;
+    ui::LabelBinding<16> _current_min_text;
+    uint32_t _cursor   = 0;
+    size_t _span_index = 0;
+
+    uint16_t samples_per_point() const
+    {
+        uint32_t interval_ms = hal::HalBase::SensorServiceConfig_t().powerMonitorIntervalMs;
+        return std::max<uint32_t>(_history_spans[_span_index] * 1000 / interval_ms / _history_points, 1);
+    }
+
+    void create_charts()
+    {
+        ui::HistoryChart::Config_t chart_config;
+        chart_config.points          = _history_points;
+        chart_config.samplesPerPoint = samples_per_point();
+        chart_config.bgColor         = config.bgColor;
+
+        chart_config.minSpan = 0.1f;
+        _chart_voltage.init(_window->get(), chart_config);
+        _chart_voltage.get()->setSize(840, 180);
+        _chart_voltage.get()->align(LV_ALIGN_TOP_MID, 0, 50);
+        _chart_voltage.addTrace(lv_color_hex(0x40C4FF));
+
+        chart_config.minSpan = 0.05f;
+        _chart_current.init(_window->get(), chart_config);
+        _chart_current.get()->setSize(840, 180);
+        _chart_current.get()->align(LV_ALIGN_TOP_MID, 0, 250);
+        _chart_current.addTrace(lv_color_hex(0xFFB340));
+
+        _voltage_max_text.bind(create_label(LV_ALIGN_TOP_LEFT, 40, 56));
+        _voltage_min_text.bind(create_label(LV_ALIGN_TOP_LEFT, 40, 204));
+        _current_max_text.bind(create_label(LV_ALIGN_TOP_LEFT, 40, 256));
+        _current_min_text.bind(create_label(LV_ALIGN_TOP_LEFT, 40, 404));
+
+        _btn_span = std::make_unique<Button>(_window->get());
+        _btn_span->align(LV_ALIGN_BOTTOM_RIGHT, -30, -12);
+        _btn_span->setSize(140, 40);
+        _btn_span->label().setText(_history_names[_span_index]);
+        _btn_span->label().setTextFont(assets::get_font(20));
+        _btn_span->setShadowWidth(0);
+        _btn_span->setRadius(18);
+        _btn_span->setBgColor(lv_color_hex(0xF26F42));
+        _btn_span->onClick().connect([&] {
+            audio::play_next_tone_progression();
+            _span_index = (_span_index + 1) % std::size(_history_spans);
+            _btn_span->label().setText(_history_names[_span_index]);
+            // The ring still holds the last seconds, they are drawn again at the new span
+            _chart_voltage.reset(samples_per_point());
+            _chart_current.reset(samples_per_point());
+            _cursor = 0;
+        });
+    }
+
+    Label* create_label(lv_align_t align, int16_t x, int16_t y)
+    {
+        auto label = std::make_unique<Label>(_window->get());
+        label->align(align, x, y);
+        label->setTextFont(assets::get_font(16));
+        label->setTextColor(lv_color_hex(0xA0A0A0));
+        label->setText("..");
+        _labels.push_back(std::move(label));
+        return _labels.back().get();
+    }
+};
 
 void PanelPowerMonitor::init()
 {
@@ -31,19 +167,22 @@ void PanelPowerMonitor::init()
     _label_voltage->align(LV_ALIGN_RIGHT_MID, _label_voltage_pos_x, _label_voltage_pos_y);
     _label_voltage->setText("..");
     _label_voltage->setTextColor(lv_color_hex(_label_color));
-    _label_voltage->setTextFont(&lv_font_montserrat_22);
+    _label_voltage->setTextFont(assets::get_font(22));
+    _voltage_text.bind(_label_voltage.get());
 
     _label_current = std::make_unique<Label>(lv_screen_active());
     _label_current->align(LV_ALIGN_RIGHT_MID, _label_current_pos_x, _label_current_pos_y);
     _label_current->setText("..");
     _label_current->setTextColor(lv_color_hex(_label_color));
-    _label_current->setTextFont(&lv_font_montserrat_22);
+    _label_current->setTextFont(assets::get_font(22));
+    _current_text.bind(_label_current.get());
 
     _label_cpu_temp = std::make_unique<Label>(lv_screen_active());
     _label_cpu_temp->align(LV_ALIGN_CENTER, -25, 82);
     _label_cpu_temp->setText("..");
     _label_cpu_temp->setTextColor(lv_color_hex(0x535353));
-    _label_cpu_temp->setTextFont(&lv_font_montserrat_18);
+    _label_cpu_temp->setTextFont(assets::get_font(18));
+    _cpu_temp_text.bind(_label_cpu_temp.get());
 
     _img_chg_arrow_up = std::make_unique<Image>(lv_screen_active());
     _img_chg_arrow_up->align(LV_ALIGN_CENTER, 286, -281);
@@ -52,29 +191,82 @@ void PanelPowerMonitor::init()
     _img_chg_arrow_down = std::make_unique<Image>(lv_screen_active());
     _img_chg_arrow_down->align(LV_ALIGN_CENTER, 216, -264);
     _img_chg_arrow_down->setSrc(&chg_arrow_down);
+
+    // Over the voltage and current readings
+    _btn_history = std::make_unique<Container>(lv_screen_active());
+    _btn_history->align(LV_ALIGN_RIGHT_MID, -430, -319);
+    _btn_history->setSize(150, 80);
+    _btn_history->setOpa(0);
+    _btn_history->onClick().connect([&] {
+        audio::play_next_tone_progression();
+
+        // Create window
+        _window = std::make_unique<PowerHistoryWindow>();
+        _window->init(lv_screen_active());
+        _window->open();
+        requestUpdate();
+    });
+
+    setUpdatePeriod(100);
 }
 
 void PanelPowerMonitor::update(bool isStacked)
 {
-    if (GetHAL()->millis() - _pm_data_update_time_count > 100) {
+    // Every frame only while it moves, open it follows the panel period like the labels
+    if (_window) {
+        _window->update();
+        if (_window->getState() == ui::Window::State_t::Closed) {
+            _window.reset();
+        } else if (_window->getState() != ui::Window::State_t::Opened) {
+            requestUpdate();
+        }
+    }
+
+    // Kept fresh by the sensor service, the blocking read only runs when it went stale
+    hal::HalBase::PMData_t pm_data;
+    uint32_t version = 0;
+    uint32_t time    = 0;
+    if (!GetHAL()->powerMonitorSnapshot.read(pm_data, &version, &time) || GetHAL()->millis() - time > _stale_time) {
         GetHAL()->updatePowerMonitorData();
+        GetHAL()->powerMonitorSnapshot.read(pm_data, &version);
+    }
+
+    // Labels are only touched for a new reading, and then only when the rounded value moved
+    if (version != _pm_version) {
+        _pm_version = version;
 
-        _label_voltage->setText(fmt::format("{:.2f}V", GetHAL()->powerMonitorData.busVoltage));
-        _label_current->setText(fmt::format("{:.2f}A", GetHAL()->powerMonitorData.shuntCurrent));
+        _voltage_text.set("{:.2f}V", pm_data.busVoltage);
+        _current_text.set("{:.2f}A", pm_data.shuntCurrent);
 
-        if (GetHAL()->powerMonitorData.shuntCurrent < 0) {
+        if (pm_data.shuntCurrent < 0) {
             _img_chg_arrow_up->setOpa(0);
             _img_chg_arrow_down->setOpa(0);
         } else {
             _img_chg_arrow_up->setOpa(255);
             _img_chg_arrow_down->setOpa(255);
         }
-
-        _pm_data_update_time_count = GetHAL()->millis();
     }
 
+    // Slower than the power data, on its own clock
     if (GetHAL()->millis() - _cpu_temp_update_time_count > 1000) {
-        _label_cpu_temp->setText(fmt::format("{}", GetHAL()->getCpuTemp()));
+        _cpu_temp_text.set("{}", GetHAL()->getCpuTemp());
         _cpu_temp_update_time_count = GetHAL()->millis();
     }
 }
+
+void PanelPowerMonitor::evict()
+{
+    _voltage_text.bind(nullptr);
+    _current_text.bind(nullptr);
+    _cpu_temp_text.bind(nullptr);
+    _window.reset();
+    _btn_history.reset();
+    _img_chg_arrow_down.reset();
+    _img_chg_arrow_up.reset();
+    _label_cpu_temp.reset();
+    _label_current.reset();
+    _label_voltage.reset();
+    // The versions describe what the old labels show, the new ones start empty
+    _pm_version                 = 0;
+    _cpu_temp_update_time_count = 0;
+}
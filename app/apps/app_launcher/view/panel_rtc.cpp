@@ -13,6 +13,7 @@
 #include <apps/utils/ui/window.h>
 #include <apps/utils/ui/toast.h>
 #include <ctime>
+#include <assets/font_engine.h>
 
 using namespace launcher_view;
 using namespace smooth_ui_toolkit;
@@ -38,7 +39,7 @@ public:
 
         _label_msg = std::make_unique<Label>(_window->get());
         _label_msg->align(LV_ALIGN_CENTER, 0, 0);
-        _label_msg->setTextFont(&lv_font_montserrat_24);
+        _label_msg->setTextFont(assets::get_font(24));
         _label_msg->setTextColor(lv_color_hex(0xECEBEB));
         _label_msg->setText("Loading ...");
     }
@@ -67,7 +68,7 @@ public:
                 _btn_apply->align(LV_ALIGN_CENTER, 280, 184);
                 _btn_apply->setSize(155, 43);
                 _btn_apply->label().setText("Apply");
-                _btn_apply->label().setTextFont(&lv_font_montserrat_24);
+                _btn_apply->label().setTextFont(assets::get_font(24));
                 _btn_apply->setShadowWidth(0);
                 _btn_apply->setRadius(18);
                 _btn_apply->setBgColor(lv_color_hex(0xF26F42));
@@ -106,12 +107,12 @@ public:
                 apply_roller_style(_roller_s.get(), 70, 185);
 
                 _label_colon_a = std::make_unique<Label>(_window->get());
-                _label_colon_a->setTextFont(&lv_font_montserrat_24);
+                _label_colon_a->setTextFont(assets::get_font(24));
                 _label_colon_a->align(LV_ALIGN_CENTER, -200, 183);
                 _label_colon_a->setText(":");
 
                 _label_colon_b = std::make_unique<Label>(_window->get());
-                _label_colon_b->setTextFont(&lv_font_montserrat_24);
+                _label_colon_b->setTextFont(assets::get_font(24));
                 _label_colon_b->align(LV_ALIGN_CENTER, -20, 183);
                 _label_colon_b->setText(":");
             }
@@ -148,7 +149,7 @@ private:
         roller->setVisibleRowCount(1);
         roller->align(LV_ALIGN_CENTER, x, y);
         roller->setSize(150, 44);
-        roller->setTextFont(&lv_font_montserrat_24, LV_PART_MAIN);
+        roller->setTextFont(assets::get_font(24), LV_PART_MAIN);
         roller->setBgColor(lv_color_hex(config.bgColor), LV_PART_SELECTED);
         roller->setRadius(12, LV_PART_MAIN);
     }
@@ -158,15 +159,17 @@ void PanelRtc::init()
 {
     _label_time = std::make_unique<Label>(lv_screen_active());
     _label_time->align(LV_ALIGN_CENTER, 335, -249);
-    _label_time->setTextFont(&lv_font_montserrat_22);
+    _label_time->setTextFont(assets::get_font(22));
     _label_time->setTextColor(lv_color_hex(0xD86037));
     _label_time->setText("..");
+    _time_text.bind(_label_time.get());
 
     _label_date = std::make_unique<Label>(lv_screen_active());
     _label_date->align(LV_ALIGN_CENTER, 335, -223);
-    _label_date->setTextFont(&lv_font_montserrat_18);
+    _label_date->setTextFont(assets::get_font(18));
     _label_date->setTextColor(lv_color_hex(0xD86037));
     _label_date->setText("..");
+    _date_text.bind(_label_date.get());
 
     _btn_rtc_setting = std::make_unique<Container>(lv_screen_active());
     _btn_rtc_setting->align(LV_ALIGN_CENTER, 422, -228);
@@ -179,7 +182,14 @@ void PanelRtc::init()
         _window = std::make_unique<RtcSettingWindow>();
         _window->init(lv_screen_active());
         _window->open();
+        requestUpdate();
     });
+
+    // Woken on the clock ticks, polled only where there is no clock service
+    subscribeEvent(shared_data::EVENT_TOPIC_CLOCK);
+    if (!GetHAL()->isClockServiceRunning()) {
+        setUpdatePeriod(1000);
+    }
 }
 
 void PanelRtc::update(bool isStacked)
@@ -188,18 +198,30 @@ void PanelRtc::update(bool isStacked)
         _window->update();
         if (_window->getState() == ui::Window::State_t::Closed) {
             _window.reset();
+        } else {
+            requestUpdate();
         }
     }
 
-    if (GetHAL()->millis() - _time_count < 1000) {
+    if (!isPeriodElapsed() && !isEventReceived() && !_time_text.text().empty()) {
         return;
     }
 
-    std::time_t now    = std::time(nullptr);
-    std::tm* localTime = std::localtime(&now);
+    // The system time is kept in step with the RTC by the clock service
+    std::time_t now = std::time(nullptr);
+    std::tm local_time = *std::localtime(&now);
 
-    _label_time->setText(fmt::format("{}:{:02d}:{:02d}", localTime->tm_hour, localTime->tm_min, localTime->tm_sec));
-    _label_date->setText(fmt::format("{}/{}/{}", localTime->tm_year + 1900, localTime->tm_mon + 1, localTime->tm_mday));
+    // Set only on a change, the date label is redrawn once a day
+    _time_text.set("{}:{:02d}:{:02d}", local_time.tm_hour, local_time.tm_min, local_time.tm_sec);
+    _date_text.set("{}/{}/{}", local_time.tm_year + 1900, local_time.tm_mon + 1, local_time.tm_mday);
+}
 
-    _time_count = GetHAL()->millis();
+void PanelRtc::evict()
+{
+    _time_text.bind(nullptr);
+    _date_text.bind(nullptr);
+    _window.reset();
+    _btn_rtc_setting.reset();
+    _label_date.reset();
+    _label_time.reset();
 }
@@ -7,6 +7,10 @@
 #include "view.h"
 #include <lvgl.h>
 #include <hal/hal.h>
+#include <algorithm>
+#include <cctype>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <mooncake_log.h>
 #include <smooth_ui_toolkit.h>
@@ -14,7 +18,9 @@
 #include <apps/utils/audio/audio.h>
 #include <apps/utils/ui/window.h>
 #include <apps/utils/ui/toast.h>
+#include <apps/utils/ui/recycled_list.h>
 #include <src/widgets/label/lv_label.h>
+#include <assets/font_engine.h>
 
 using namespace launcher_view;
 using namespace smooth_ui_toolkit;
@@ -24,35 +30,292 @@ static const std::string _tag = "panel-sd";
 
 static const ui::Window::KeyFrame_t _kf_sd_card_scan_close = {-46, 300, 75, 75, 0};
 static const ui::Window::KeyFrame_t _kf_sd_card_scan_open  = {-40, 43, 566, 411, 255};
+static constexpr size_t _scan_page_size                    = 16;
+// Only the rows in view have labels, the entries themselves are kept up to this many and the rest is only counted
+static constexpr size_t _max_entries = 4096;
+static constexpr int32_t _row_height = 42;
+
+static const ui::Window::KeyFrame_t _kf_gallery_open = {0, 0, 1240, 680, 255};
+static constexpr size_t _max_pictures                = 4096;
+static constexpr int32_t _gallery_columns            = 7;
+static constexpr int32_t _gallery_cell_size          = 168;
+static constexpr int32_t _gallery_thumb_size         = 160;
+static constexpr int32_t _gallery_view_width         = 1200;
+static constexpr int32_t _gallery_view_height        = 600;
+
+static constexpr int32_t _video_width          = 1024;
+static constexpr int32_t _video_height         = 576;
+static constexpr uint32_t _video_info_interval = 500;
+
+static std::string lower_extension(const std::string& name)
+{
+    auto dot = name.find_last_of('.');
+    if (dot == std::string::npos) {
+        return "";
+    }
+    std::string ext = name.substr(dot + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext;
+}
+
+static bool is_jpeg(const std::string& name)
+{
+    std::string ext = lower_extension(name);
+    return ext == "jpg" || ext == "jpeg";
+}
+
+// What the camera records, and raw streams of JPEGs
+static bool is_video(const std::string& name)
+{
+    std::string ext = lower_extension(name);
+    return ext == "avi" || ext == "mjpeg" || ext == "mjpg";
+}
 
 class SdCardScanWindow : public ui::Window {
 public:
-    SdCardScanWindow()
+    SdCardScanWindow(std::function<void()> onGallery, std::function<void(const std::string&)> onVideo)
+        : _on_gallery(std::move(onGallery)), _on_video(std::move(onVideo))
     {
-        config.title    = "SD-Card File Scan";
-        config.kfClosed = _kf_sd_card_scan_close;
-        config.kfOpened = _kf_sd_card_scan_open;
+        config.title        = "SD-Card File Scan";
+        config.kfClosed     = _kf_sd_card_scan_close;
+        config.kfOpened     = _kf_sd_card_scan_open;
+        config.snapshotAnim = true;
     }
 
     void onOpen() override
     {
         _window->setScrollbarMode(LV_SCROLLBAR_MODE_OFF);
 
-        _panel_file_entries = std::make_unique<Container>(_window->get());
-        _panel_file_entries->align(LV_ALIGN_CENTER, 0, 18);
-        _panel_file_entries->setSize(535, 345);
-        _panel_file_entries->setBorderWidth(0);
-        _panel_file_entries->setBgColor(lv_color_hex(0x393939));
-        _panel_file_entries->setPadding(12, 12, 24, 24);
+        _btn_gallery = std::make_unique<Container>(_window->get());
+        _btn_gallery->align(LV_ALIGN_TOP_LEFT, 16, 8);
+        _btn_gallery->setSize(120, 34);
+        _btn_gallery->setRadius(17);
+        _btn_gallery->setBorderWidth(0);
+        _btn_gallery->setBgColor(lv_color_hex(0x393939));
+        _btn_gallery->removeFlag(LV_OBJ_FLAG_SCROLLABLE);
+        _btn_gallery->onClick().connect([&] {
+            _on_gallery();
+            close();
+        });
+        lv_obj_t* label = lv_label_create(_btn_gallery->get());
+        lv_obj_center(label);
+        lv_obj_set_style_text_font(label, assets::get_font(18), LV_PART_MAIN);
+        lv_obj_set_style_text_color(label, lv_color_hex(0x43D2FF), LV_PART_MAIN);
+        lv_label_set_text(label, LV_SYMBOL_IMAGE " Gallery");
+
+        ui::RecycledList::Config_t list_config;
+        list_config.rowHeight   = _row_height;
+        list_config.onCreateRow = [&](lv_obj_t* row, size_t slot) { create_row(row, slot); };
+        list_config.onBindRow   = [&](size_t slot, size_t index) { bind_row(slot, index); };
+        _list_file_entries.init(_window->get(), list_config);
+        _list_file_entries.get()->align(LV_ALIGN_CENTER, 0, 18);
+        _list_file_entries.get()->setSize(535, 345);
+        _list_file_entries.get()->setBorderWidth(0);
+        _list_file_entries.get()->setBgColor(lv_color_hex(0x393939));
+        _list_file_entries.get()->setPadding(12, 12, 24, 24);
+
+        if (GetHAL()->isSdCardMounted()) {
+            show_message("Scanning SD Card ...");
+        } else {
+            show_message("SD Card not mounted.\n\nPlease insert SD Card.", true);
+        }
+    }
+
+    void onUpdate() override
+    {
+        if (_state != Opened || _is_scanned) {
+            return;
+        }
+
+        // The card may go in while the window is open
+        if (_scan_id == 0) {
+            if (GetHAL()->isSdCardMounted()) {
+                _scan_id = GetHAL()->startSdCardScan("/", _scan_page_size);
+                if (_scan_id != 0) {
+                    show_message("Scanning SD Card ...");
+                }
+            }
+            return;
+        }
+
+        // One page per frame, a large directory is laid out over many frames
+        hal::HalBase::SdCardScanPage_t page;
+        if (!GetHAL()->getSdCardScanPage(page) || page.scanId != _scan_id) {
+            return;
+        }
+        for (auto& entry : page.entries) {
+            if (_entry_count++ < _max_entries) {
+                _entries.push_back(std::move(entry));
+            }
+        }
+        if (_entry_count > 0) {
+            _label_msg.reset();
+            _list_file_entries.setItemCount(_entries.size());
+        }
+
+        if (!page.isLast) {
+            return;
+        }
+        _is_scanned = true;
+        if (page.isFailed) {
+            show_message("Failed to read SD Card.", true);
+        } else if (_entry_count == 0) {
+            show_message("No files found on SD Card.");
+        } else if (_entry_count > _max_entries) {
+            // One more row past the entries
+            _list_file_entries.setItemCount(_entries.size() + 1);
+        }
+    }
+
+    void onClose() override
+    {
+        audio::play_next_tone_progression();
+        GetHAL()->cancelSdCardScan();
+        _label_msg.reset();
+        _btn_gallery.reset();
+    }
 
+private:
+    struct RowLabels_t {
+        lv_obj_t* row  = nullptr;
+        lv_obj_t* icon = nullptr;
+        lv_obj_t* name = nullptr;
+        size_t index   = SIZE_MAX;
+    };
+
+    std::function<void()> _on_gallery;
+    std::function<void(const std::string&)> _on_video;
+    std::unique_ptr<Label> _label_msg;
+    std::unique_ptr<Container> _btn_gallery;
+    ui::RecycledList _list_file_entries;
+    // Children of the rows, deleted with the list
+    std::vector<RowLabels_t> _row_labels;
+    std::vector<hal::HalBase::FileEntry_t> _entries;
+    uint32_t _scan_id   = 0;
+    size_t _entry_count = 0;
+    bool _is_scanned    = false;
+
+    void show_message(const std::string& text, bool isError = false)
+    {
         _label_msg = std::make_unique<Label>(_window->get());
         _label_msg->align(LV_ALIGN_CENTER, 0, -24);
-        _label_msg->setTextFont(&lv_font_montserrat_24);
+        _label_msg->setTextFont(assets::get_font(24));
+        if (isError) {
+            _label_msg->setTextColor(lv_color_hex(0xFD4444));
+        }
+        _label_msg->setText(text);
+    }
+
+    lv_obj_t* create_label(lv_obj_t* row, int32_t x)
+    {
+        lv_obj_t* label = lv_label_create(row);
+        lv_obj_align(label, LV_ALIGN_TOP_LEFT, x, 0);
+        lv_obj_set_style_text_font(label, assets::get_font(24), LV_PART_MAIN);
+        return label;
+    }
+
+    void create_row(lv_obj_t* row, size_t slot)
+    {
+        if (_row_labels.size() <= slot) {
+            _row_labels.resize(slot + 1);
+        }
+        _row_labels[slot].row  = row;
+        _row_labels[slot].icon = create_label(row, 0);
+        _row_labels[slot].name = create_label(row, 36);
+        lv_label_set_long_mode(_row_labels[slot].name, LV_LABEL_LONG_DOT);
+        lv_obj_set_width(_row_labels[slot].name, 450);
+        // Videos play on a tap
+        lv_obj_add_flag(row, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_add_event_cb(row, on_row_clicked, LV_EVENT_SHORT_CLICKED, this);
+    }
+
+    void bind_row(size_t slot, size_t index)
+    {
+        auto& labels = _row_labels[slot];
+        labels.index = index;
+        if (index >= _entries.size()) {
+            lv_obj_set_style_text_color(labels.icon, lv_color_hex(0xDEDEDE), LV_PART_MAIN);
+            lv_obj_set_style_text_color(labels.name, lv_color_hex(0xDEDEDE), LV_PART_MAIN);
+            lv_label_set_text(labels.icon, "");
+            lv_label_set_text(labels.name, fmt::format("... and {} more", _entry_count - _max_entries).c_str());
+            return;
+        }
+
+        const auto& entry = _entries[index];
+        bool is_playable  = !entry.isDir && is_video(entry.name);
+        uint32_t color    = entry.isDir ? 0xFDBE1A : is_playable ? 0x7CE38B : 0x43D2FF;
+        const char* icon  = entry.isDir ? LV_SYMBOL_DIRECTORY : is_playable ? LV_SYMBOL_VIDEO : LV_SYMBOL_FILE;
+        lv_obj_set_style_text_color(labels.icon, lv_color_hex(color), LV_PART_MAIN);
+        lv_obj_set_style_text_color(labels.name, lv_color_hex(color), LV_PART_MAIN);
+        lv_label_set_text(labels.icon, icon);
+        lv_label_set_text(labels.name, entry.name.c_str());
+    }
+
+    static void on_row_clicked(lv_event_t* e)
+    {
+        auto window = (SdCardScanWindow*)lv_event_get_user_data(e);
+        auto row    = (lv_obj_t*)lv_event_get_current_target(e);
+        for (const auto& labels : window->_row_labels) {
+            if (labels.row != row || labels.index >= window->_entries.size()) {
+                continue;
+            }
+            const auto& entry = window->_entries[labels.index];
+            if (!entry.isDir && is_video(entry.name)) {
+                // The scan lists the root only
+                window->_on_video(entry.name);
+                window->close();
+            }
+            return;
+        }
+    }
+};
+
+/**
+ * @brief Thumbnail grid of the JPEGs on the card, a tap shows the picture and a swipe goes to the next one. The HAL
+ * decodes and prefetches, the window only shows what is ready: the thumbnail stands in, scaled up, while a picture
+ * is still decoding
+ *
+ */
+class GalleryWindow : public ui::Window {
+public:
+    GalleryWindow()
+    {
+        config.title        = "Gallery";
+        config.kfClosed     = _kf_sd_card_scan_close;
+        config.kfOpened     = _kf_gallery_open;
+        config.closeBtn     = true;
+        config.clickBgClose = false;
+        config.snapshotAnim = true;
+    }
+
+    ~GalleryWindow()
+    {
+        clear_images();
+    }
+
+    void onOpen() override
+    {
+        _window->setScrollbarMode(LV_SCROLLBAR_MODE_OFF);
+        _window->removeFlag(LV_OBJ_FLAG_SCROLLABLE);
+
+        ui::RecycledList::Config_t list_config;
+        list_config.rowHeight   = _gallery_cell_size;
+        list_config.onCreateRow = [&](lv_obj_t* row, size_t slot) { create_row(row, slot); };
+        list_config.onBindRow   = [&](size_t slot, size_t index) { bind_row(slot, index); };
+        _grid.init(_window->get(), list_config);
+        _grid.get()->align(LV_ALIGN_CENTER, 0, 22);
+        _grid.get()->setSize(_gallery_view_width, _gallery_view_height);
+        _grid.get()->setBorderWidth(0);
+        _grid.get()->setBgOpa(0);
+        _grid.get()->setPadding(0, 0, 0, 0);
+
+        create_viewer();
+
         if (GetHAL()->isSdCardMounted()) {
-            _label_msg->setText("Scanning SD Card ...");
+            _scan_dirs.push_back("/");
+            show_message("Looking for pictures ...");
         } else {
-            _label_msg->setTextColor(lv_color_hex(0xFD4444));
-            _label_msg->setText("SD Card not mounted.\n\nPlease insert SD Card and reboot.");
+            show_message("SD Card not mounted.\n\nPlease insert SD Card.", true);
         }
     }
 
@@ -61,53 +324,438 @@ public:
         if (_state != Opened) {
             return;
         }
+        if (!_is_scanned) {
+            update_scan();
+            return;
+        }
+        if (_viewer_index >= 0) {
+            update_viewer();
+        } else {
+            update_thumbnails();
+        }
+    }
+
+    void onClose() override
+    {
+        audio::play_next_tone_progression();
+        GetHAL()->cancelSdCardScan();
+        GetHAL()->closeGallery();
+        clear_images();
+        _label_msg.reset();
+    }
+
+private:
+    // An lv_image showing a gallery picture, the descriptor points into the pixels it holds on to
+    struct Image_t {
+        lv_obj_t* obj      = nullptr;
+        lv_image_dsc_t dsc = {};
+        hal::HalBase::GalleryPicture_t picture;
+        size_t index   = SIZE_MAX;
+        bool isPending = false;
+    };
+
+    std::unique_ptr<Label> _label_msg;
+    ui::RecycledList _grid;
+    // Stable addresses, the images point at their descriptors
+    std::vector<std::unique_ptr<Image_t>> _cells;
+    std::unique_ptr<Container> _viewer;
+    Image_t _viewer_image;
+    lv_obj_t* _viewer_label = nullptr;
+    int32_t _viewer_index   = -1;
+    bool _is_viewer_full    = false;
+    bool _is_gesture        = false;
+
+    std::deque<std::string> _scan_dirs;
+    std::string _scan_dir;
+    uint32_t _scan_id = 0;
+    std::vector<std::string> _paths;
+    bool _is_scanned = false;
 
-        if (GetHAL()->isSdCardMounted() && !_is_scanned) {
-            _is_scanned       = true;
-            auto file_entries = GetHAL()->scanSdCard("/");
-            if (file_entries.empty()) {
-                _label_msg->setText("No files found on SD Card.");
+    void show_message(const std::string& text, bool isError = false)
+    {
+        _label_msg = std::make_unique<Label>(_window->get());
+        _label_msg->align(LV_ALIGN_CENTER, 0, -24);
+        _label_msg->setTextFont(assets::get_font(24));
+        if (isError) {
+            _label_msg->setTextColor(lv_color_hex(0xFD4444));
+        }
+        _label_msg->setText(text);
+    }
+
+    /* ---------------------------------- Scan ---------------------------------- */
+    // Root and the folders right under it, where the camera and the time-lapse put their pictures
+    void update_scan()
+    {
+        if (_scan_id == 0) {
+            if (_scan_dirs.empty()) {
+                finish_scan();
                 return;
             }
+            _scan_dir = _scan_dirs.front();
+            _scan_dirs.pop_front();
+            _scan_id = GetHAL()->startSdCardScan(_scan_dir, _scan_page_size);
+            if (_scan_id == 0) {
+                _scan_dirs.clear();
+            }
+            return;
+        }
 
-            _label_file_entries.clear();
-
-            for (size_t i = 0; i < file_entries.size(); i++) {
-                _label_file_entries.push_back(std::make_unique<Label>(_panel_file_entries->get()));
-                _label_file_entries.back()->align(LV_ALIGN_TOP_LEFT, 0, i * 42);
-                _label_file_entries.back()->setTextFont(&lv_font_montserrat_24);
-                if (file_entries[i].isDir) {
-                    _label_file_entries.back()->setTextColor(lv_color_hex(0xFDBE1A));
-                    lv_label_set_text(_label_file_entries.back()->get(), LV_SYMBOL_DIRECTORY);
-                } else {
-                    _label_file_entries.back()->setTextColor(lv_color_hex(0x43D2FF));
-                    lv_label_set_text(_label_file_entries.back()->get(), LV_SYMBOL_FILE);
+        hal::HalBase::SdCardScanPage_t page;
+        if (!GetHAL()->getSdCardScanPage(page) || page.scanId != _scan_id) {
+            return;
+        }
+        bool is_root = _scan_dir == "/";
+        for (const auto& entry : page.entries) {
+            if (entry.name.empty() || entry.name[0] == '.') {
+                continue;
+            }
+            std::string path = is_root ? entry.name : _scan_dir + "/" + entry.name;
+            if (entry.isDir) {
+                if (is_root) {
+                    _scan_dirs.push_back(path);
                 }
+            } else if (is_jpeg(entry.name) && _paths.size() < _max_pictures) {
+                _paths.push_back(path);
+            }
+        }
+        if (page.isLast) {
+            _scan_id = 0;
+        }
+    }
+
+    void finish_scan()
+    {
+        _is_scanned = true;
+        if (_paths.empty()) {
+            show_message("No pictures found on SD Card.");
+            return;
+        }
+        std::sort(_paths.begin(), _paths.end());
+
+        hal::HalBase::GalleryConfig_t gallery_config;
+        gallery_config.fitWidth  = _gallery_view_width;
+        gallery_config.fitHeight = _gallery_view_height;
+        gallery_config.thumbSize = _gallery_thumb_size;
+        if (!GetHAL()->openGallery(_paths, gallery_config)) {
+            show_message("Failed to open the gallery.", true);
+            return;
+        }
+        _label_msg.reset();
+        _grid.setItemCount((_paths.size() + _gallery_columns - 1) / _gallery_columns);
+    }
 
-                _label_file_entries.push_back(std::make_unique<Label>(_panel_file_entries->get()));
-                _label_file_entries.back()->align(LV_ALIGN_TOP_LEFT, 36, i * 42);
-                _label_file_entries.back()->setTextFont(&lv_font_montserrat_24);
-                _label_file_entries.back()->setTextColor(lv_color_hex(file_entries[i].isDir ? 0xFDBE1A : 0x43D2FF));
-                _label_file_entries.back()->setText(file_entries[i].name);
+    /* ------------------------------- Thumbnails ------------------------------- */
+    static void set_image(Image_t& image, const hal::HalBase::GalleryPicture_t& picture)
+    {
+        // The same descriptor shows another picture from now on
+        lv_image_set_src(image.obj, nullptr);
+        lv_image_cache_drop(&image.dsc);
+        image.picture = picture;
+        if (!picture.data) {
+            return;
+        }
+        image.dsc.header.magic  = LV_IMAGE_HEADER_MAGIC;
+        image.dsc.header.cf     = LV_COLOR_FORMAT_RGB565;
+        image.dsc.header.w      = picture.width;
+        image.dsc.header.h      = picture.height;
+        image.dsc.header.stride = picture.width * 2;
+        image.dsc.data_size     = picture.width * picture.height * 2;
+        image.dsc.data          = picture.data.get();
+        lv_image_set_src(image.obj, &image.dsc);
+    }
+
+    void clear_images()
+    {
+        for (auto& cell : _cells) {
+            lv_image_cache_drop(&cell->dsc);
+            cell->picture = hal::HalBase::GalleryPicture_t();
+        }
+        lv_image_cache_drop(&_viewer_image.dsc);
+        _viewer_image.picture = hal::HalBase::GalleryPicture_t();
+    }
+
+    void create_row(lv_obj_t* row, size_t slot)
+    {
+        for (int32_t col = 0; col < _gallery_columns; col++) {
+            auto cell = std::make_unique<Image_t>();
+            cell->obj = lv_image_create(row);
+            lv_obj_set_size(cell->obj, _gallery_thumb_size, _gallery_thumb_size);
+            lv_obj_set_pos(cell->obj, col * (_gallery_view_width / _gallery_columns), 0);
+            lv_obj_set_style_bg_color(cell->obj, lv_color_hex(0x393939), LV_PART_MAIN);
+            lv_obj_set_style_bg_opa(cell->obj, LV_OPA_COVER, LV_PART_MAIN);
+            lv_obj_set_style_radius(cell->obj, 8, LV_PART_MAIN);
+            lv_image_set_inner_align(cell->obj, LV_IMAGE_ALIGN_CENTER);
+            lv_obj_add_flag(cell->obj, LV_OBJ_FLAG_CLICKABLE);
+            lv_obj_set_user_data(cell->obj, cell.get());
+            lv_obj_add_event_cb(cell->obj, on_cell_clicked, LV_EVENT_SHORT_CLICKED, this);
+            _cells.push_back(std::move(cell));
+        }
+    }
+
+    void bind_row(size_t slot, size_t index)
+    {
+        for (int32_t col = 0; col < _gallery_columns; col++) {
+            auto& cell      = *_cells[slot * _gallery_columns + col];
+            size_t picture  = index * _gallery_columns + col;
+            bool is_picture = picture < _paths.size();
+            cell.index      = is_picture ? picture : SIZE_MAX;
+            cell.isPending  = is_picture;
+            set_image(cell, hal::HalBase::GalleryPicture_t());
+            lv_obj_set_style_bg_color(cell.obj, lv_color_hex(0x393939), LV_PART_MAIN);
+            if (is_picture) {
+                lv_obj_remove_flag(cell.obj, LV_OBJ_FLAG_HIDDEN);
+            } else {
+                lv_obj_add_flag(cell.obj, LV_OBJ_FLAG_HIDDEN);
             }
+        }
+    }
 
-            _label_msg.reset();
+    // The rows in view ask for their thumbnails every frame, the last asked for are made first
+    void update_thumbnails()
+    {
+        for (auto& cell : _cells) {
+            if (!cell->isPending || lv_obj_has_flag(lv_obj_get_parent(cell->obj), LV_OBJ_FLAG_HIDDEN)) {
+                continue;
+            }
+            hal::HalBase::GalleryPicture_t thumb;
+            auto state = GetHAL()->getGalleryThumbnail(cell->index, thumb);
+            if (state == hal::HalBase::GALLERY_READY) {
+                set_image(*cell, thumb);
+                cell->isPending = false;
+            } else if (state == hal::HalBase::GALLERY_FAILED) {
+                lv_obj_set_style_bg_color(cell->obj, lv_color_hex(0x6B2B2B), LV_PART_MAIN);
+                cell->isPending = false;
+            }
+        }
+    }
+
+    static void on_cell_clicked(lv_event_t* e)
+    {
+        auto window = (GalleryWindow*)lv_event_get_user_data(e);
+        auto cell   = (Image_t*)lv_obj_get_user_data((lv_obj_t*)lv_event_get_target(e));
+        if (cell->index != SIZE_MAX) {
+            audio::play_next_tone_progression();
+            window->show_viewer(cell->index);
+        }
+    }
+
+    /* --------------------------------- Viewer --------------------------------- */
+    void create_viewer()
+    {
+        _viewer = std::make_unique<Container>(_window->get());
+        _viewer->align(LV_ALIGN_CENTER, 0, 22);
+        _viewer->setSize(_gallery_view_width, _gallery_view_height);
+        _viewer->setBorderWidth(0);
+        _viewer->setRadius(0);
+        _viewer->setPadding(0, 0, 0, 0);
+        _viewer->setBgColor(lv_color_hex(0x000000));
+        _viewer->removeFlag(LV_OBJ_FLAG_SCROLLABLE);
+        _viewer->addFlag(LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_event_cb(_viewer->get(), on_viewer_event, LV_EVENT_PRESSED, this);
+        lv_obj_add_event_cb(_viewer->get(), on_viewer_event, LV_EVENT_GESTURE, this);
+        lv_obj_add_event_cb(_viewer->get(), on_viewer_event, LV_EVENT_SHORT_CLICKED, this);
+
+        _viewer_image.obj = lv_image_create(_viewer->get());
+        lv_obj_set_size(_viewer_image.obj, _gallery_view_width, _gallery_view_height);
+        lv_obj_center(_viewer_image.obj);
+
+        _viewer_label = lv_label_create(_viewer->get());
+        lv_obj_align(_viewer_label, LV_ALIGN_BOTTOM_MID, 0, -12);
+        lv_obj_set_style_text_font(_viewer_label, assets::get_font(18), LV_PART_MAIN);
+        lv_obj_set_style_text_color(_viewer_label, lv_color_hex(0xDEDEDE), LV_PART_MAIN);
+    }
+
+    void show_viewer(int32_t index)
+    {
+        _viewer_index   = index;
+        _is_viewer_full = false;
+        GetHAL()->setGalleryIndex(index);
+        _viewer->removeFlag(LV_OBJ_FLAG_HIDDEN);
+        _grid.get()->addFlag(LV_OBJ_FLAG_HIDDEN);
+        lv_label_set_text(_viewer_label, fmt::format("{} / {}", index + 1, _paths.size()).c_str());
+
+        // Straight from the prefetch when it is ready, otherwise the thumbnail until it is
+        hal::HalBase::GalleryPicture_t picture;
+        if (GetHAL()->getGalleryThumbnail(index, picture) == hal::HalBase::GALLERY_READY) {
+            lv_image_set_inner_align(_viewer_image.obj, LV_IMAGE_ALIGN_CONTAIN);
+            set_image(_viewer_image, picture);
+        } else {
+            set_image(_viewer_image, hal::HalBase::GalleryPicture_t());
         }
+        update_viewer();
+    }
+
+    void hide_viewer()
+    {
+        _viewer_index = -1;
+        GetHAL()->setGalleryIndex(-1);
+        set_image(_viewer_image, hal::HalBase::GalleryPicture_t());
+        _viewer->addFlag(LV_OBJ_FLAG_HIDDEN);
+        _grid.get()->removeFlag(LV_OBJ_FLAG_HIDDEN);
+    }
+
+    void update_viewer()
+    {
+        if (_is_viewer_full) {
+            return;
+        }
+        hal::HalBase::GalleryPicture_t picture;
+        auto state = GetHAL()->getGalleryPicture(_viewer_index, picture);
+        if (state == hal::HalBase::GALLERY_READY) {
+            // Fitted by the HAL, shown 1:1 so LVGL draws it without a transform
+            lv_image_set_inner_align(_viewer_image.obj, LV_IMAGE_ALIGN_CENTER);
+            set_image(_viewer_image, picture);
+            _is_viewer_full = true;
+        } else if (state == hal::HalBase::GALLERY_FAILED) {
+            lv_label_set_text(_viewer_label,
+                              fmt::format("{} / {}  failed to decode", _viewer_index + 1, _paths.size()).c_str());
+            _is_viewer_full = true;
+        }
+    }
+
+    static void on_viewer_event(lv_event_t* e)
+    {
+        auto window = (GalleryWindow*)lv_event_get_user_data(e);
+        switch (lv_event_get_code(e)) {
+            case LV_EVENT_PRESSED:
+                window->_is_gesture = false;
+                break;
+            case LV_EVENT_GESTURE: {
+                window->_is_gesture = true;
+
+                lv_dir_t dir  = lv_indev_get_gesture_dir(lv_indev_active());
+                int32_t index = window->_viewer_index + (dir == LV_DIR_LEFT ? 1 : dir == LV_DIR_RIGHT ? -1 : 0);
+                if (index != window->_viewer_index && index >= 0 && index < (int32_t)window->_paths.size()) {
+                    window->show_viewer(index);
+                }
+                break;
+            }
+            case LV_EVENT_SHORT_CLICKED:
+                // A tap goes back to the grid, the end of a swipe does not
+                if (!window->_is_gesture) {
+                    window->hide_viewer();
+                }
+                break;
+            default:
+                break;
+        }
+    }
+};
+
+/**
+ * @brief Plays a video from the card on a canvas of its own, which the display port shows as its video plane. The HAL
+ * reads, decodes and keeps the time, the window only starts it and shows how it goes
+ *
+ */
+class VideoPlayerWindow : public ui::Window {
+public:
+    VideoPlayerWindow(std::string path) : _path(std::move(path))
+    {
+        config.title        = _path;
+        config.kfClosed     = _kf_sd_card_scan_close;
+        config.kfOpened     = _kf_gallery_open;
+        config.closeBtn     = true;
+        config.clickBgClose = false;
+        config.snapshotAnim = true;
+    }
+
+    ~VideoPlayerWindow()
+    {
+        // Before the canvas goes with the window
+        GetHAL()->stopVideoPlayback();
+    }
+
+    void onOpen() override
+    {
+        _window->setScrollbarMode(LV_SCROLLBAR_MODE_OFF);
+        _window->removeFlag(LV_OBJ_FLAG_SCROLLABLE);
+
+        _canvas_buf.assign(_video_width * _video_height, 0);
+        _canvas = lv_canvas_create(_window->get());
+        lv_canvas_set_buffer(_canvas, _canvas_buf.data(), _video_width, _video_height, LV_COLOR_FORMAT_RGB565);
+        lv_obj_align(_canvas, LV_ALIGN_CENTER, 0, 4);
+
+        _label_info = std::make_unique<Label>(_window->get());
+        _label_info->align(LV_ALIGN_BOTTOM_MID, 0, -10);
+        _label_info->setTextFont(assets::get_font(18));
+        _label_info->setTextColor(lv_color_hex(0xA0A0A0));
+        _label_info->setText("");
+    }
+
+    void onUpdate() override
+    {
+        if (_state != Opened) {
+            return;
+        }
+        // Once the window stands still, the canvas is a plain rectangle on screen from then on
+        if (!_is_started) {
+            _is_started = true;
+            start();
+            return;
+        }
+        if (_is_failed || lv_tick_elaps(_info_tick) < _video_info_interval) {
+            return;
+        }
+        _info_tick = lv_tick_get();
+        update_info();
     }
 
     void onClose() override
     {
         audio::play_next_tone_progression();
-        _label_msg.reset();
-        _label_file_entries.clear();
-        _panel_file_entries.reset();
+        GetHAL()->stopVideoPlayback();
+        _label_info.reset();
     }
 
 private:
-    std::unique_ptr<Label> _label_msg;
-    std::unique_ptr<Container> _panel_file_entries;
-    std::vector<std::unique_ptr<Label>> _label_file_entries;
-    bool _is_scanned = false;
+    std::string _path;
+    std::vector<uint16_t> _canvas_buf;
+    lv_obj_t* _canvas = nullptr;
+    std::unique_ptr<Label> _label_info;
+    uint32_t _info_tick = 0;
+    bool _is_started    = false;
+    bool _is_failed     = false;
+
+    void start()
+    {
+        hal::HalBase::VideoPlayerConfig_t video_config;
+        video_config.canvas = _canvas;
+        if (!GetHAL()->startVideoPlayback(_path, video_config)) {
+            show_error("Failed to play the video.");
+        }
+    }
+
+    void show_error(const std::string& text)
+    {
+        _is_failed = true;
+        _label_info->setTextColor(lv_color_hex(0xFD4444));
+        _label_info->setText(text);
+    }
+
+    static std::string format_time(uint32_t ms)
+    {
+        uint32_t seconds = ms / 1000;
+        return fmt::format("{}:{:02}", seconds / 60, seconds % 60);
+    }
+
+    void update_info()
+    {
+        auto stats = GetHAL()->getVideoPlayerStats();
+        if (stats.state == hal::HalBase::VIDEO_PLAYER_FAILED) {
+            show_error("No frame of the video could be decoded.");
+            return;
+        }
+
+        std::string position = format_time(stats.positionMs);
+        if (stats.durationMs) {
+            position += " / " + format_time(stats.durationMs);
+        }
+        _label_info->setText(fmt::format("{}{}  |  {}x{} at {:.0f} fps{}  |  {} dropped  |  decode {:.1f} ms  |  {}",
+                                         stats.state == hal::HalBase::VIDEO_PLAYER_ENDED ? "Ended  " : "", position,
+                                         stats.width, stats.height, stats.fps, stats.hasAudio ? " with sound" : "",
+                                         stats.framesDropped, stats.lastDecodeUs / 1000.0f,
+                                         stats.isVideoPlane ? "video plane" : "canvas"));
+    }
 };
 
 void PanelSdCard::init()
@@ -120,9 +768,11 @@ void PanelSdCard::init()
         audio::play_next_tone_progression();
 
         // Create window
-        _window = std::make_unique<SdCardScanWindow>();
+        _window = std::make_unique<SdCardScanWindow>([&] { _is_gallery_requested = true; },
+                                                     [&](const std::string& path) { _video_request = path; });
         _window->init(lv_screen_active());
         _window->open();
+        requestUpdate();
     });
 }
 
@@ -132,6 +782,32 @@ void PanelSdCard::update(bool isStacked)
         _window->update();
         if (_window->getState() == ui::Window::State_t::Closed) {
             _window.reset();
+        } else {
+            requestUpdate();
         }
     }
+
+    // The gallery and the player open once the file scan window is out of the way
+    if (!_window && _is_gallery_requested) {
+        _is_gallery_requested = false;
+        _window               = std::make_unique<GalleryWindow>();
+        _window->init(lv_screen_active());
+        _window->open();
+        requestUpdate();
+    }
+    if (!_window && !_video_request.empty()) {
+        _window = std::make_unique<VideoPlayerWindow>(_video_request);
+        _video_request.clear();
+        _window->init(lv_screen_active());
+        _window->open();
+        requestUpdate();
+    }
+}
+
+void PanelSdCard::evict()
+{
+    _is_gallery_requested = false;
+    _video_request.clear();
+    _window.reset();
+    _btn_sd_card_scan.reset();
 }
@@ -11,6 +11,8 @@
 #include <smooth_ui_toolkit.h>
 #include <smooth_lvgl.h>
 #include <apps/utils/audio/audio.h>
+#include <apps/utils/ui/anim_clock.h>
+#include <assets/font_engine.h>
 
 using namespace launcher_view;
 using namespace smooth_ui_toolkit;
@@ -33,7 +35,7 @@ void PanelSpeakerVolume::init()
 {
     _label_volume = std::make_unique<Label>(lv_screen_active());
     _label_volume->align(LV_ALIGN_CENTER, _label_pos_x, _label_pos_y);
-    _label_volume->setTextFont(&lv_font_montserrat_24);
+    _label_volume->setTextFont(assets::get_font(24));
     _label_volume->setTextColor(lv_color_hex(0xFEFEFE));
     _label_volume->setText(fmt::format("{}", GetHAL()->getSpeakerVolume()));
 
@@ -45,6 +47,7 @@ void PanelSpeakerVolume::init()
         // Animation
         _label_y_anim.teleport(_label_pos_y - 8);
         _label_y_anim = _label_pos_y;
+        requestUpdate();
 
         // SFX
         if (GetHAL()->getSpeakerVolume() >= 100) {
@@ -69,6 +72,7 @@ void PanelSpeakerVolume::init()
         // Animation
         _label_y_anim.teleport(_label_pos_y + 8);
         _label_y_anim = _label_pos_y;
+        requestUpdate();
 
         // SFX
         if (GetHAL()->getSpeakerVolume() <= 0) {
@@ -89,7 +93,15 @@ void PanelSpeakerVolume::init()
 
 void PanelSpeakerVolume::update(bool isStacked)
 {
-    if (!_label_y_anim.done()) {
+    if (ui::anim_clock::is_running(_label_y_anim)) {
         _label_volume->setY(_label_y_anim);
+        requestUpdate();
     }
 }
+
+void PanelSpeakerVolume::evict()
+{
+    _btn_down.reset();
+    _btn_up.reset();
+    _label_volume.reset();
+}
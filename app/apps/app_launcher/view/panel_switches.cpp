@@ -7,6 +7,7 @@
 #include <lvgl.h>
 #include <hal/hal.h>
 #include <assets/assets.h>
+#include <assets/font_engine.h>
 #include <mooncake_log.h>
 #include <smooth_ui_toolkit.h>
 #include <smooth_lvgl.h>
@@ -55,13 +56,13 @@ public:
 
         _label_a = std::make_unique<Label>(_window->get());
         _label_a->align(LV_ALIGN_LEFT_MID, 32, -80);
-        _label_a->setTextFont(&lv_font_montserrat_24);
+        _label_a->setTextFont(assets::get_font(24));
         _label_a->setTextColor(lv_color_hex(0xFFFFFF));
         _label_a->setText("Connect to:");
 
         _label_b = std::make_unique<Label>(_window->get());
         _label_b->align(LV_ALIGN_LEFT_MID, 32, 0);
-        _label_b->setTextFont(&lv_font_montserrat_24);
+        _label_b->setTextFont(assets::get_font(24));
         _label_b->setTextColor(lv_color_hex(0xFFFFFF));
         _label_b->setText("And open url:");
 
@@ -74,7 +75,7 @@ public:
 
         _label_ssid = std::make_unique<Label>(_panel_ssid->get());
         _label_ssid->align(LV_ALIGN_CENTER, 0, 0);
-        _label_ssid->setTextFont(&lv_font_montserrat_24);
+        _label_ssid->setTextFont(assets::get_font(24));
         _label_ssid->setTextColor(lv_color_hex(0xFFFFFF));
         _label_ssid->setText("M5Tab5-UserDemo-WiFi");
 
@@ -87,7 +88,7 @@ public:
 
         _label_url = std::make_unique<Label>(_panel_url->get());
         _label_url->align(LV_ALIGN_CENTER, 0, 0);
-        _label_url->setTextFont(&lv_font_montserrat_24);
+        _label_url->setTextFont(assets::get_font(24));
         _label_url->setTextColor(lv_color_hex(0xFFFFFF));
         _label_url->setText("http://192.168.4.1");
 
@@ -148,19 +149,19 @@ private:
         if (GetHAL()->getExtAntennaEnable()) {
             _label_msg_a = std::make_unique<Label>(_panel_msg->get());
             _label_msg_a->align(LV_ALIGN_CENTER, 0, -13);
-            _label_msg_a->setTextFont(&lv_font_montserrat_22);
+            _label_msg_a->setTextFont(assets::get_font(22));
             _label_msg_a->setTextColor(lv_color_hex(0xFFFFFF));
             _label_msg_a->setText("Using external antenna");
 
             _label_msg_b = std::make_unique<Label>(_panel_msg->get());
             _label_msg_b->align(LV_ALIGN_CENTER, 0, 13);
-            _label_msg_b->setTextFont(&lv_font_montserrat_22);
+            _label_msg_b->setTextFont(assets::get_font(22));
             _label_msg_b->setTextColor(lv_color_hex(0xFFFFFF));
             _label_msg_b->setText("please make sure it's connected.");
         } else {
             _label_msg_a = std::make_unique<Label>(_panel_msg->get());
             _label_msg_a->align(LV_ALIGN_CENTER, 0, 0);
-            _label_msg_a->setTextFont(&lv_font_montserrat_22);
+            _label_msg_a->setTextFont(assets::get_font(22));
             _label_msg_a->setTextColor(lv_color_hex(0xFFFFFF));
             _label_msg_a->setText("Using internal antenna.");
 
@@ -250,6 +251,7 @@ void PanelSwitches::init()
             _window = std::make_unique<WifiApMsgWindow>();
             _window->init(lv_screen_active());
             _window->open();
+            requestUpdate();
         }
     });
 
@@ -264,6 +266,7 @@ void PanelSwitches::init()
             _window = std::make_unique<WifiApMsgWindow>();
             _window->init(lv_screen_active());
             _window->open();
+            requestUpdate();
         }
     });
 
@@ -286,6 +289,10 @@ void PanelSwitches::init()
     _last_hp_detect    = GetHAL()->headPhoneDetect();
 
     update_detect_images();
+
+    // Plug changes come in as events, the poll catches the switches changed elsewhere and HALs without events
+    setUpdatePeriod(500);
+    subscribeEvent(shared_data::EVENT_TOPIC_PORT);
 }
 
 void PanelSwitches::update(bool isStacked)
@@ -294,13 +301,16 @@ void PanelSwitches::update(bool isStacked)
         _window->update();
         if (_window->getState() == ui::Window::State_t::Closed) {
             _window.reset();
+        } else {
+            requestUpdate();
         }
     }
 
-    if (GetHAL()->millis() - _time_count > 200) {
+    if (isPeriodElapsed()) {
         update_images();
+    }
+    if (isPeriodElapsed() || isEventReceived()) {
         update_detect_images();
-        _time_count = GetHAL()->millis();
     }
 }
 
@@ -348,3 +358,22 @@ void PanelSwitches::play_sfx(bool isPlugedIn)
         audio::play_melody({64 + 24, 60 + 24});
     }
 }
+
+void PanelSwitches::evict()
+{
+    _window.reset();
+    _btn_ap_msg.reset();
+    _img_hp_detect.reset();
+    _img_usb_a_detect.reset();
+    _img_usb_c_detect.reset();
+    _btn_ext_antenna_en_sw.reset();
+    _btn_usba_5v_en_sw.reset();
+    _btn_ext_5v_en_sw.reset();
+    _btn_charge_qc_en_sw.reset();
+    _btn_charge_en_sw.reset();
+    _img_ext_antenna_en_sw.reset();
+    _img_usba_5v_en_sw.reset();
+    _img_ext_5v_en_sw.reset();
+    _img_charge_qc_en_sw.reset();
+    _img_charge_en_sw.reset();
+}
@@ -8,8 +8,10 @@
 #include <hal/hal.h>
 #include <mooncake_log.h>
 #include <assets/assets.h>
+#include <assets/image_decoder.h>
 #include <smooth_ui_toolkit.h>
 #include <smooth_lvgl.h>
+#include <shared/shared.h>
 #include <apps/utils/audio/audio.h>
 
 using namespace launcher_view;
@@ -18,22 +20,36 @@ using namespace smooth_ui_toolkit::lvgl_cpp;
 
 static const std::string _tag = "launcher-view";
 
-void LauncherView::init()
+// Time a frame may spend building panels, at least one is built per frame
+static constexpr uint32_t _panel_init_budget_ms = 8;
+
+bool PanelBase::checkUpdateDue(uint32_t now)
 {
-    mclog::tagInfo(_tag, "init");
+    _is_period_elapsed = false;
+    if (_update_period > 0 && (_is_first_update || now - _last_period_time >= _update_period)) {
+        _is_period_elapsed = true;
+        _is_first_update   = false;
+        _last_period_time  = now;
+    }
+    _is_event_received = _is_event_pending;
+    _is_event_pending  = false;
 
-    ui::signal_window_opened().clear();
-    ui::signal_window_opened().connect([&](bool opened) { _is_stacked = opened; });
+    bool is_requested = _is_update_requested.exchange(false);
+    return is_requested || _is_period_elapsed || _is_event_received;
+}
 
-    LvglLockGuard lock;
+LauncherView::~LauncherView()
+{
+    if (_event_subscription) {
+        GetEventBus().unsubscribe(_event_subscription);
+    }
+}
 
-    // Base screen
-    lv_obj_remove_flag(lv_screen_active(), LV_OBJ_FLAG_SCROLLABLE);
+void LauncherView::init()
+{
+    mclog::tagInfo(_tag, "init");
 
-    // Background image
-    _img_bg = std::make_unique<Image>(lv_screen_active());
-    _img_bg->setAlign(LV_ALIGN_CENTER);
-    _img_bg->setSrc(&launcher_bg);
+    LvglLockGuard lock;
 
     // Install panels
     _panels.push_back(std::make_unique<PanelRtc>());
@@ -51,17 +67,125 @@ void LauncherView::init()
     _panels.push_back(std::make_unique<PanelGpioTest>());
     _panels.push_back(std::make_unique<PanelMusic>());
     _panels.push_back(std::make_unique<PanelComMonitor>());
+    _panels.push_back(std::make_unique<PanelPerfHud>());
+    _due_panels.reserve(_panels.size());
 
-    for (auto& panel : _panels) {
-        panel->init();
+    build();
+}
+
+void LauncherView::build()
+{
+    ui::signal_window_opened().clear();
+    ui::signal_window_opened().connect([&](bool opened) { _is_stacked = opened; });
+
+    // Dispatched on the app loop before the update, panels that care are due the same frame. Every topic, the
+    // panels filter by their own subscriptions
+    _event_subscription = GetEventBus().subscribe(UINT32_MAX, [&](const shared_data::Event_t& event) {
+        for (auto& panel : _panels) {
+            panel->notifyEvent(event);
+        }
+    });
+
+    // Base screen
+    lv_obj_remove_flag(lv_screen_active(), LV_OBJ_FLAG_SCROLLABLE);
+
+    // Background image, from its decoded buffer. A panel redraw then restores the area under it with a PPA rectangle
+    // copy before the widgets are drawn on top, the compressed source would have it blended by SW every time
+    _img_bg = std::make_unique<Image>(lv_screen_active());
+    _img_bg->setAlign(LV_ALIGN_CENTER);
+    _img_bg->setSrc(assets::get_cached_image(&launcher_bg));
+
+    // Panels build their widgets over the first frames, the background shows up before all of them are done
+    _inited_panel_num = 0;
+    _init_start_time  = GetHAL()->millis();
+}
+
+void LauncherView::suspend()
+{
+    if (_is_suspended) {
+        return;
+    }
+
+    LvglLockGuard lock;
+
+    // Windows go with their panel, and no event can reach a panel without widgets
+    for (size_t i = 0; i < _inited_panel_num; i++) {
+        _panels[i]->evict();
+    }
+    _inited_panel_num = 0;
+    _img_bg.reset();
+    ui::signal_window_opened().clear();
+    if (_event_subscription) {
+        GetEventBus().unsubscribe(_event_subscription);
+        _event_subscription = 0;
     }
+
+    _is_stacked   = false;
+    _is_suspended = true;
+
+    lv_mem_monitor_t mem_mon;
+    lv_mem_monitor(&mem_mon);
+    mclog::tagInfo(_tag, "suspend, lvgl heap free {} bytes", mem_mon.free_size);
 }
 
-void LauncherView::update()
+void LauncherView::resume()
 {
+    if (!_is_suspended) {
+        return;
+    }
+
     LvglLockGuard lock;
 
+    // Rebuilt within the same frame budget as the first start, each panel then redraws from the state it kept
+    build();
     for (auto& panel : _panels) {
+        panel->requestUpdate();
+    }
+    _is_suspended = false;
+    mclog::tagInfo(_tag, "resume");
+}
+
+void LauncherView::init_pending_panels()
+{
+    // In install order, so the stacking on screen stays the same as building them all at once
+    uint32_t frame_start = GetHAL()->millis();
+    LvglLockGuard lock;
+    do {
+        _panels[_inited_panel_num]->init();
+        _inited_panel_num++;
+    } while (_inited_panel_num < _panels.size() && GetHAL()->millis() - frame_start < _panel_init_budget_ms);
+
+    if (_inited_panel_num == _panels.size()) {
+        mclog::tagInfo(_tag, "{} panels ready in {} ms", _panels.size(), GetHAL()->millis() - _init_start_time);
+        GetBootState().isLauncherBuilding = false;
+    }
+}
+
+void LauncherView::update()
+{
+    if (_is_suspended) {
+        return;
+    }
+
+    if (_inited_panel_num < _panels.size()) {
+        init_pending_panels();
+    }
+
+    // Only panels with a due period, a pending event or a request run, an idle frame skips the LVGL lock too
+    uint32_t now = GetHAL()->millis();
+    _due_panels.clear();
+    for (size_t i = 0; i < _inited_panel_num; i++) {
+        if (_panels[i]->checkUpdateDue(now)) {
+            _due_panels.push_back(_panels[i].get());
+        }
+    }
+    if (_due_panels.empty()) {
+        return;
+    }
+
+    LvglLockGuard lock("launcher update");
+
+    for (auto panel : _due_panels) {
         panel->update(_is_stacked);
     }
 }
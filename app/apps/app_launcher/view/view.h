@@ -4,12 +4,15 @@
  * SPDX-License-Identifier: MIT
  */
 #pragma once
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <lvgl.h>
 #include <apps/utils/ui/window.h>
+#include <apps/utils/ui/label_binding.h>
 #include <smooth_ui_toolkit.h>
 #include <smooth_lvgl.h>
+#include <shared/shared.h>
 #include <vector>
 
 namespace launcher_view {
@@ -26,6 +29,85 @@ public:
 
     virtual void init()                 = 0;
     virtual void update(bool isStacked) = 0;
+
+    /**
+     * @brief Destroy the widgets while the app is suspended. State that is not a widget stays, the next init() builds
+     * the widgets again from it
+     *
+     */
+    virtual void evict() = 0;
+
+    /**
+     * @brief Run update() on the next frame, safe to call from LVGL callbacks
+     *
+     */
+    void requestUpdate()
+    {
+        _is_update_requested = true;
+    }
+
+    /**
+     * @brief Called by the view for every bus event, marks the panel due when it subscribed to the topic
+     *
+     * @param event
+     */
+    void notifyEvent(const shared_data::Event_t& event)
+    {
+        if (_subscribed_topics & (1u << event.topic)) {
+            _is_event_pending = true;
+        }
+    }
+
+    /**
+     * @brief Called by the view once per frame, true when update() should run this frame
+     *
+     * @param now
+     * @return true
+     * @return false
+     */
+    bool checkUpdateDue(uint32_t now);
+
+protected:
+    /**
+     * @brief Run update() every periodMs, 0 to only run on requests and events
+     *
+     * @param periodMs
+     */
+    void setUpdatePeriod(uint32_t periodMs)
+    {
+        _update_period = periodMs;
+    }
+
+    /**
+     * @brief Run update() when an event of this topic is published on the event bus
+     *
+     * @param topic
+     */
+    void subscribeEvent(shared_data::EventTopic_t topic)
+    {
+        _subscribed_topics |= 1u << topic;
+    }
+
+    // Why the current update() runs, both can be false when it was only requested
+    bool isPeriodElapsed() const
+    {
+        return _is_period_elapsed;
+    }
+    bool isEventReceived() const
+    {
+        return _is_event_received;
+    }
+
+private:
+    // Requests and the period can be changed from LVGL callbacks
+    std::atomic<bool> _is_update_requested = true;
+    std::atomic<uint32_t> _update_period   = 0;
+    uint32_t _last_period_time             = 0;
+    bool _is_first_update                  = true;
+    bool _is_period_elapsed                = false;
+    bool _is_event_pending                 = false;
+    bool _is_event_received                = false;
+    uint32_t _subscribed_topics            = 0;
 };
 
 /**
@@ -36,13 +118,15 @@ class PanelRtc : public PanelBase {
 public:
     void init() override;
     void update(bool isStacked) override;
+    void evict() override;
 
 private:
-    uint32_t _time_count = 0;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Label> _label_time;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Label> _label_date;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _btn_rtc_setting;
     std::unique_ptr<ui::Window> _window;
+    ui::LabelBinding<16> _time_text;
+    ui::LabelBinding<16> _date_text;
 };
 
 /**
@@ -53,6 +137,7 @@ class PanelLcdBacklight : public PanelBase {
 public:
     void init() override;
     void update(bool isStacked) override;
+    void evict() override;
 
 private:
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Label> _label_brightness;
@@ -69,6 +154,7 @@ class PanelSpeakerVolume : public PanelBase {
 public:
     void init() override;
     void update(bool isStacked) override;
+    void evict() override;
 
 private:
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Label> _label_volume;
@@ -85,15 +171,21 @@ class PanelPowerMonitor : public PanelBase {
 public:
     void init() override;
     void update(bool isStacked) override;
+    void evict() override;
 
 private:
-    uint32_t _pm_data_update_time_count  = 0;
     uint32_t _cpu_temp_update_time_count = 0;
+    uint32_t _pm_version                 = 0;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Label> _label_voltage;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Label> _label_current;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Label> _label_cpu_temp;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Image> _img_chg_arrow_up;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Image> _img_chg_arrow_down;
+    std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _btn_history;
+    std::unique_ptr<ui::Window> _window;
+    ui::LabelBinding<16> _voltage_text;
+    ui::LabelBinding<16> _current_text;
+    ui::LabelBinding<16> _cpu_temp_text;
 };
 
 /**
@@ -104,16 +196,22 @@ class PanelImu : public PanelBase {
 public:
     void init() override;
     void update(bool isStacked) override;
+    void evict() override;
 
 private:
-    uint32_t _time_count = 0;
+    uint32_t _imu_version = 0;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Label> _label_accel_x;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Label> _label_accel_y;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Label> _label_accel_z;
+    ui::LabelBinding<16> _accel_x_text;
+    ui::LabelBinding<16> _accel_y_text;
+    ui::LabelBinding<16> _accel_z_text;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _accel_dot;
     smooth_ui_toolkit::AnimateValue _anim_x;
     smooth_ui_toolkit::AnimateValue _anim_y;
     smooth_ui_toolkit::AnimateValue _anim_size;
+    std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _btn_history;
+    std::unique_ptr<ui::Window> _window;
 };
 
 /**
@@ -124,9 +222,9 @@ class PanelSwitches : public PanelBase {
 public:
     void init() override;
     void update(bool isStacked) override;
+    void evict() override;
 
 private:
-    uint32_t _time_count = 0;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Image> _img_charge_en_sw;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Image> _img_charge_qc_en_sw;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Image> _img_ext_5v_en_sw;
@@ -162,6 +260,7 @@ class PanelPower : public PanelBase {
 public:
     void init() override;
     void update(bool isStacked) override;
+    void evict() override;
 
 private:
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _btn_power_off;
@@ -179,6 +278,7 @@ class PanelCamera : public PanelBase {
 public:
     void init() override;
     void update(bool isStacked) override;
+    void evict() override;
 
 private:
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _btn_camera;
@@ -193,6 +293,7 @@ class PanelDualMic : public PanelBase {
 public:
     void init() override;
     void update(bool isStacked) override;
+    void evict() override;
 
 private:
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _btn_mic_test;
@@ -207,6 +308,7 @@ class PanelHeadphone : public PanelBase {
 public:
     void init() override;
     void update(bool isStacked) override;
+    void evict() override;
 
 private:
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _btn_headphone_test;
@@ -221,10 +323,14 @@ class PanelSdCard : public PanelBase {
 public:
     void init() override;
     void update(bool isStacked) override;
+    void evict() override;
 
 private:
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _btn_sd_card_scan;
     std::unique_ptr<ui::Window> _window;
+    bool _is_gallery_requested = false;
+    // Path of the video to play once the scan window has closed
+    std::string _video_request;
 };
 
 /**
@@ -235,6 +341,7 @@ class PanelI2cScan : public PanelBase {
 public:
     void init() override;
     void update(bool isStacked) override;
+    void evict() override;
 
 private:
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _btn_i2c_scan;
@@ -249,6 +356,7 @@ class PanelGpioTest : public PanelBase {
 public:
     void init() override;
     void update(bool isStacked) override;
+    void evict() override;
 
 private:
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _btn_gpio_test;
@@ -263,6 +371,7 @@ class PanelMusic : public PanelBase {
 public:
     void init() override;
     void update(bool isStacked) override;
+    void evict() override;
 
 private:
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _btn_music_test;
@@ -277,25 +386,79 @@ class PanelComMonitor : public PanelBase {
 public:
     void init() override;
     void update(bool isStacked) override;
+    void evict() override;
 
 private:
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _btn_com_monitor;
     std::unique_ptr<ui::Window> _window;
 };
 
+/**
+ * @brief
+ *
+ */
+class PanelPerfHud : public PanelBase {
+public:
+    void init() override;
+    void update(bool isStacked) override;
+    void evict() override;
+
+private:
+    bool _is_shown = false;
+    std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _panel;
+    std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Label> _label_stats;
+    std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _btn_toggle;
+    std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Button> _btn_profile;
+    std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Button> _btn_input;
+
+    void create_hud();
+    void destroy_hud();
+    void toggle_power_profile();
+    void update_profile_button();
+    void toggle_input_record();
+    void update_input_button();
+};
+
 /**
  * @brief
  *
  */
 class LauncherView {
 public:
+    ~LauncherView();
+
     void init();
     void update();
 
+    /**
+     * @brief Drop every widget but keep the panels, the app holds no LVGL memory until resume()
+     *
+     */
+    void suspend();
+
+    /**
+     * @brief Build the widgets again over the next frames, from the state the panels kept
+     *
+     */
+    void resume();
+
+    bool isSuspended() const
+    {
+        return _is_suspended;
+    }
+
 private:
-    bool _is_stacked = false;
+    bool _is_stacked   = false;
+    bool _is_suspended = false;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Image> _img_bg;
     std::vector<std::unique_ptr<PanelBase>> _panels;
+    std::vector<PanelBase*> _due_panels;
+    size_t _inited_panel_num  = 0;
+    uint32_t _init_start_time = 0;
+    int _event_subscription   = 0;
+
+    void build();
+    void init_pending_panels();
 
     void update_anim();
 };
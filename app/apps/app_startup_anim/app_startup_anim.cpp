@@ -8,6 +8,9 @@
 #include <mooncake.h>
 #include <mooncake_log.h>
 #include <assets/assets.h>
+#include <assets/image_decoder.h>
+#include <apps/utils/ui/activity.h>
+#include <shared/shared.h>
 
 using namespace mooncake;
 using namespace smooth_ui_toolkit;
@@ -30,15 +33,21 @@ void AppStartupAnim::onOpen()
 
     LvglLockGuard lock;
 
-    lv_obj_set_style_bg_color(lv_screen_active(), lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_remove_flag(lv_screen_active(), LV_OBJ_FLAG_SCROLLABLE);
+    // On the top layer, so the launcher can build its screen underneath while the logo plays
+    _overlay = std::make_unique<Container>(lv_layer_top());
+    _overlay->setSize(lv_pct(100), lv_pct(100));
+    _overlay->setBgColor(lv_color_hex(0xFFFFFF));
+    _overlay->setBorderWidth(0);
+    _overlay->setRadius(0);
+    _overlay->setPadding(0, 0, 0, 0);
+    _overlay->removeFlag(LV_OBJ_FLAG_SCROLLABLE);
 
-    _logo_tab = std::make_unique<Image>(lv_screen_active());
+    _logo_tab = std::make_unique<Image>(_overlay->get());
     _logo_tab->setAlign(LV_ALIGN_TOP_MID);
     _logo_tab->setSrc(&logo_tab);
     _logo_tab->setPos(-46, 785);
 
-    _logo_5 = std::make_unique<Image>(lv_screen_active());
+    _logo_5 = std::make_unique<Image>(_overlay->get());
     _logo_5->setAlign(LV_ALIGN_TOP_MID);
     _logo_5->setSrc(&logo_5);
     _logo_5->setPos(700, 308);
@@ -63,6 +72,9 @@ void AppStartupAnim::onOpen()
 
 void AppStartupAnim::onRunning()
 {
+    // The whole startup sequence is one animation
+    ui::activity::keep_awake();
+
     if (_anime_state == AnimState_StartupDelay) {
         if (GetHAL()->millis() - _time_count > 400) {
             _anime_state = AnimState_LogoTabMoveUp;
@@ -86,18 +98,19 @@ void AppStartupAnim::onRunning()
         if (_anim_logo_5_x.done()) {
             _anime_state = AnimState_FinalDelay;
             _time_count  = GetHAL()->millis();
-            GetHAL()->startWifiAp();
+            // Decoded while the logo sits still, the launcher's first frame does not pay for it
+            assets::preload_image(&launcher_bg);
         }
-        if (!_is_sfx_played) {
-            if (_anim_logo_5_x.directValue() < 90) {
-                GetHAL()->playStartupSfx();
-                _is_sfx_played = true;
-            }
+        if (_anim_logo_5_x.directValue() < 90) {
+            on_boot_step();
         }
     }
 
     else if (_anime_state == AnimState_FinalDelay) {
-        if (GetHAL()->millis() - _time_count > 1000) {
+        on_boot_step();
+        // Held until the launcher behind is complete, a slow boot keeps the logo up instead of showing half a screen
+        if (GetHAL()->millis() - _time_count > 1000 && _is_boot_handled && GetBootState().isAppsInstalled &&
+            !GetBootState().isLauncherBuilding) {
             close();
         }
         return;
@@ -110,6 +123,17 @@ void AppStartupAnim::onRunning()
     _logo_5->setX(_anim_logo_5_x);
 }
 
+// Audio and wifi are brought up by the boot graph, they are touched only once it is done
+void AppStartupAnim::on_boot_step()
+{
+    if (_is_boot_handled || !GetHAL()->isBootDone()) {
+        return;
+    }
+    GetHAL()->playStartupSfx();
+    GetHAL()->startWifiAp();
+    _is_boot_handled = true;
+}
+
 void AppStartupAnim::onClose()
 {
     mclog::tagInfo(getAppInfo().name, "on close");
@@ -118,4 +142,7 @@ void AppStartupAnim::onClose()
 
     _logo_tab.reset();
     _logo_5.reset();
+    _overlay.reset();
+    assets::release_image(&logo_tab);
+    assets::release_image(&logo_5);
 }
@@ -32,12 +32,15 @@ private:
         AnimState_FinalDelay
     };
 
+    void on_boot_step();
+
     AnimState_t _anime_state = AnimState_StartupDelay;
+    std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _overlay;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Image> _logo_tab;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Image> _logo_5;
     smooth_ui_toolkit::AnimateValue _anim_logo_tab_y;
     smooth_ui_toolkit::AnimateValue _anim_logo_tab_opa;
     smooth_ui_toolkit::AnimateValue _anim_logo_5_x;
-    uint32_t _time_count = 0;
-    bool _is_sfx_played  = false;
+    uint32_t _time_count  = 0;
+    bool _is_boot_handled = false;
 };
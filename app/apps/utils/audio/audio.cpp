@@ -8,7 +8,10 @@
 #include <cstdlib>
 #include <cstdint>
 #include <algorithm>
+#include <map>
+#include <tuple>
 #include <hal/hal.h>
+#include <apps/utils/math/math.h>
 
 static constexpr int SAMPLE_RATE = 48000;
 static constexpr double PI       = 3.14159265358979323846;
@@ -35,17 +38,11 @@ void generate_tone_with_linear_envelope(std::vector<int16_t>& buffer, double fre
     }
 }
 
-namespace audio {
-
-void play_tone(int frequency, double durationSec)
+static void render_tone(std::vector<int16_t>& buffer, int frequency, double durationSec)
 {
-    if (GetHAL()->getSpeakerVolume() <= 0) {
-        return;
-    }
-
     const int sample_rate = 48000;
     const int samples     = static_cast<int>(sample_rate * durationSec);
-    std::vector<int16_t> buffer(samples * 2);  // 双声道
+    buffer.resize(samples * 2);  // 双声道
 
     const int fade_len    = 200;  // 淡出长度（采样点）
     const float amplitude = 32767.0f / 5;
@@ -63,22 +60,16 @@ void play_tone(int frequency, double durationSec)
         buffer[i * 2]     = value;  // 左声道
         buffer[i * 2 + 1] = value;  // 右声道
     }
-
-    GetHAL()->audioPlay(buffer);
 }
 
-void play_melody(const std::vector<int>& midiList, double durationSec = 0.1)
+static void render_melody(std::vector<int16_t>& buffer, const std::vector<int>& midiList, double durationSec)
 {
-    if (GetHAL()->getSpeakerVolume() <= 0) {
-        return;
-    }
-
     const int sample_rate      = 48000;
     const int samples_per_note = static_cast<int>(sample_rate * durationSec);
     const int fade_len         = 200;  // 每个音符结尾的淡出长度
     const float amplitude      = 32767.0f / 5;
 
-    std::vector<int16_t> buffer;                             // 大 buffer 存放整首旋律
+    buffer.clear();                                          // 大 buffer 存放整首旋律
     buffer.reserve(midiList.size() * samples_per_note * 2);  // 双声道预留空间
 
     for (int midiNote : midiList) {
@@ -101,8 +92,187 @@ void play_melody(const std::vector<int>& midiList, double durationSec = 0.1)
             buffer.push_back(sample);  // 右声道
         }
     }
+}
+
+static void render_chord(std::vector<int16_t>& buffer, const std::vector<int>& midiNotes, double durationSec)
+{
+    std::vector<double> freqs;
+    for (int midi : midiNotes) {
+        double freq = 440.0 * std::pow(2.0, (midi - 69) / 12.0);
+        freqs.push_back(freq);
+    }
+
+    std::vector<std::vector<int16_t>> tones;
+    for (double freq : freqs) {
+        std::vector<int16_t> tone;
+        generate_tone_with_linear_envelope(tone, freq, durationSec, 0.35);
+        tones.push_back(tone);
+    }
+
+    size_t num_samples = tones.empty() ? 0 : tones[0].size();
+    buffer.assign(num_samples, 0);
+    for (size_t i = 0; i < num_samples; ++i) {
+        int32_t mixed = 0;
+        for (auto& tone : tones) {
+            mixed += tone[i];
+        }
+        buffer[i] = std::clamp((int)mixed, -32768, 32767);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                 Sound bank                                 */
+/* -------------------------------------------------------------------------- */
+enum SoundType_t {
+    SOUND_TONE,
+    SOUND_MELODY,
+    SOUND_CHORD,
+};
+
+// Type, notes (frequency for tones, midi otherwise), duration in ms
+using SoundKey_t = std::tuple<SoundType_t, std::vector<int>, int>;
+
+// Rendered buffers are never freed, so the HAL plays them without a copy
+// On Tab5 one 0.1s tone is above the internal malloc threshold, the bank lives in PSRAM
+static std::map<SoundKey_t, std::vector<int16_t>> _sound_bank;
+
+static int to_duration_ms(double durationSec)
+{
+    return static_cast<int>(std::lround(durationSec * 1000));
+}
+
+static void render_sound(SoundType_t type, const std::vector<int>& notes, double durationSec)
+{
+    int duration_ms = to_duration_ms(durationSec);
+
+    // Render with the quantized duration, so every lookup of the key gets the same sound
+    std::vector<int16_t>& buffer = _sound_bank[SoundKey_t(type, notes, duration_ms)];
+    switch (type) {
+        case SOUND_TONE:
+            render_tone(buffer, notes[0], duration_ms / 1000.0);
+            break;
+        case SOUND_MELODY:
+            render_melody(buffer, notes, duration_ms / 1000.0);
+            break;
+        case SOUND_CHORD:
+            render_chord(buffer, notes, duration_ms / 1000.0);
+            break;
+    }
+}
+
+// Play the prebuilt buffer if the bank has one
+static bool try_play_sound(SoundType_t type, const std::vector<int>& notes, double durationSec)
+{
+    auto it = _sound_bank.find(SoundKey_t(type, notes, to_duration_ms(durationSec)));
+    if (it == _sound_bank.end() || it->second.empty()) {
+        return false;
+    }
+    GetHAL()->audioPlayBuffer(it->second.data(), it->second.size());
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Synth                                   */
+/* -------------------------------------------------------------------------- */
+// Sounds missing from the bank are synthesized by the HAL instead of rendered here, one note per mixer voice
+static constexpr size_t MAX_SYNTH_NOTES = 8;
+static constexpr uint16_t TONE_FADE_MS  = 4;  // ~200 samples like the rendered tones
+static constexpr uint8_t TONE_LEVEL     = 20;
+static constexpr uint16_t CHORD_ATTACK  = 5;
+static constexpr uint8_t CHORD_LEVEL    = 35;
+
+static double midi_to_frequency_exact(int midi)
+{
+    return 440.0 * std::pow(2.0, (midi - 69) / 12.0);
+}
+
+static void synth_melody(const int* midiList, size_t count, double durationSec, bool isChord)
+{
+    hal::HalBase::AudioNote_t notes[MAX_SYNTH_NOTES];
+    uint16_t duration_ms = to_duration_ms(durationSec);
+    size_t note_num      = 0;
+
+    for (size_t i = 0; i < count && note_num < MAX_SYNTH_NOTES; i++) {
+        if (midiList[i] < 0) {
+            continue;  // Rest
+        }
+        auto& note      = notes[note_num++];
+        note.frequency  = midi_to_frequency_exact(midiList[i]);
+        note.durationMs = duration_ms;
+        if (isChord) {
+            note.attackMs  = CHORD_ATTACK;
+            note.releaseMs = duration_ms > CHORD_ATTACK ? duration_ms - CHORD_ATTACK : 0;
+            note.level     = CHORD_LEVEL;
+        } else {
+            note.delayMs   = i * duration_ms;
+            note.releaseMs = TONE_FADE_MS;
+            note.level     = TONE_LEVEL;
+        }
+    }
+
+    GetHAL()->audioPlayNotes(notes, note_num);
+}
 
-    GetHAL()->audioPlay(buffer);
+static int midi_to_frequency(int midi)
+{
+    return static_cast<int>(midi_to_frequency_exact(midi));
+}
+
+static const std::vector<int> _c_major_scale   = {60, 62, 64, 65, 67, 69, 71};  // C大调音阶（C D E F G A B）
+static const std::vector<int> _progression     = {60, 67, 69, 64, 65, 60, 65, 67};  // 15634145
+static constexpr int TONE_PROGRESSION_SHIFT    = 24;
+static constexpr int CHORD_PROGRESSION_SHIFT   = 0;
+static constexpr double DEFAULT_TONE_DURATION  = 0.1;
+static constexpr double DEFAULT_CHORD_DURATION = 0.15;
+
+static std::vector<int> progression_chord(int root)
+{
+    // 判断是否为小和弦（只处理 Am）
+    bool is_minor = (root % 12 == 9);  // MIDI 69, 81, 等都是 A
+    return {root, root + (is_minor ? 3 : 4), root + 7};
+}
+
+namespace audio {
+
+void init_sound_bank()
+{
+    for (int midi : _progression) {
+        render_sound(SOUND_TONE, {midi_to_frequency(midi + TONE_PROGRESSION_SHIFT)}, DEFAULT_TONE_DURATION);
+        render_sound(SOUND_CHORD, progression_chord(midi + CHORD_PROGRESSION_SHIFT), DEFAULT_CHORD_DURATION);
+    }
+    for (int midi : _c_major_scale) {
+        render_sound(SOUND_TONE, {midi_to_frequency(midi + TONE_PROGRESSION_SHIFT)}, DEFAULT_TONE_DURATION);
+    }
+}
+
+void play_tone(int frequency, double durationSec)
+{
+    if (GetHAL()->getSpeakerVolume() <= 0) {
+        return;
+    }
+
+    if (try_play_sound(SOUND_TONE, {frequency}, durationSec)) {
+        return;
+    }
+
+    hal::HalBase::AudioNote_t note;
+    note.frequency  = frequency;
+    note.durationMs = to_duration_ms(durationSec);
+    note.releaseMs  = TONE_FADE_MS;
+    note.level      = TONE_LEVEL;
+    GetHAL()->audioPlayNotes(&note, 1);
+}
+
+void play_melody(const std::vector<int>& midiList, double durationSec = 0.1)
+{
+    if (GetHAL()->getSpeakerVolume() <= 0) {
+        return;
+    }
+
+    if (try_play_sound(SOUND_MELODY, midiList, durationSec)) {
+        return;
+    }
+    synth_melody(midiList.data(), midiList.size(), durationSec, false);
 }
 
 void play_tone_from_midi(int midi, double durationSec)
@@ -111,8 +281,7 @@ void play_tone_from_midi(int midi, double durationSec)
         return;
     }
 
-    double freq = 440.0 * std::pow(2.0, (midi - 69) / 12.0);
-    play_tone(static_cast<int>(freq), durationSec);
+    play_tone(midi_to_frequency(midi), durationSec);
 }
 
 void play_random_tone(int semitoneShift = 0, double durationSec = 0.15)
@@ -121,10 +290,8 @@ void play_random_tone(int semitoneShift = 0, double durationSec = 0.15)
         return;
     }
 
-    std::vector<int> scale = {60, 62, 64, 65, 67, 69, 71};  // C大调音阶（C D E F G A B）
-
-    int index = rand() % scale.size();
-    int midi  = scale[index] + semitoneShift;
+    int index = math::random_int(0, _c_major_scale.size());
+    int midi  = _c_major_scale[index] + semitoneShift;
 
     play_tone_from_midi(midi, durationSec);
 }
@@ -136,9 +303,6 @@ void play_next_tone_progression(double durationSec)
     }
 
     constexpr int REPEAT_EACH_CHORD = 1;
-    constexpr int SEMITONE_SHIFT    = 24;
-
-    static std::vector<int> melody = {60, 67, 69, 64, 65, 60, 65, 67};  // 15634145
 
     static size_t index       = 0;
     static int repeat_counter = -1;
@@ -148,7 +312,7 @@ void play_next_tone_progression(double durationSec)
         index++;
     }
 
-    int midi = melody[index % melody.size()] + SEMITONE_SHIFT;
+    int midi = _progression[index % _progression.size()] + TONE_PROGRESSION_SHIFT;
 
     play_tone_from_midi(midi, durationSec);
 }
@@ -159,31 +323,10 @@ void play_chord(const std::vector<int>& midiNotes, double durationSec)
         return;
     }
 
-    std::vector<double> freqs;
-    for (int midi : midiNotes) {
-        double freq = 440.0 * std::pow(2.0, (midi - 69) / 12.0);
-        freqs.push_back(freq);
-    }
-
-    std::vector<int16_t> buffer;
-    std::vector<std::vector<int16_t>> tones;
-    for (double freq : freqs) {
-        std::vector<int16_t> tone;
-        generate_tone_with_linear_envelope(tone, freq, durationSec, 0.35);
-        tones.push_back(tone);
-    }
-
-    size_t num_samples = tones[0].size();
-    buffer.resize(num_samples, 0);
-    for (size_t i = 0; i < num_samples; ++i) {
-        int32_t mixed = 0;
-        for (auto& tone : tones) {
-            mixed += tone[i];
-        }
-        buffer[i] = std::clamp((int)mixed, -32768, 32767);
+    if (try_play_sound(SOUND_CHORD, midiNotes, durationSec)) {
+        return;
     }
-
-    GetHAL()->audioPlay(buffer);
+    synth_melody(midiNotes.data(), midiNotes.size(), durationSec, true);
 }
 
 void play_random_chord(int semitoneShift, double durationSec)
@@ -192,14 +335,11 @@ void play_random_chord(int semitoneShift, double durationSec)
         return;
     }
 
-    // C大调音阶
-    std::vector<int> scale = {60, 62, 64, 65, 67, 69, 71};  // C D E F G A B
-
     // 随机 root 和和弦结构
-    int root_index              = rand() % 4;  // 留出空间给三度五度
-    int root                    = scale[root_index] + semitoneShift;
-    int third                   = scale[root_index + 2] + semitoneShift;
-    int fifth                   = scale[root_index + 4] + semitoneShift;
+    int root_index              = math::random_int(0, 4);  // 留出空间给三度五度
+    int root                    = _c_major_scale[root_index] + semitoneShift;
+    int third                   = _c_major_scale[root_index + 2] + semitoneShift;
+    int fifth                   = _c_major_scale[root_index + 4] + semitoneShift;
     std::vector<int> chord_midi = {root, third, fifth};
 
     play_chord(chord_midi, durationSec);
@@ -212,9 +352,8 @@ void play_next_chord_progression(double durationSec)
     }
 
     constexpr int REPEAT_EACH_CHORD = 2;
-    constexpr int SEMITONE_SHIFT    = 0;
 
-    static std::vector<int> chord_roots = {60, 67, 69, 64, 65, 60, 65, 67};  // 15634145
+    // Chord roots follow _progression, 15634145
     // static std::vector<int> chord_roots = { 60, 71, 69, 67, 65, 64, 62, 60 }; // 17654321
     // static std::vector<int> chord_roots = { 65, 67, 64, 69, 62, 67, 60 }; // 4536251
     // static std::vector<int> chord_roots = {65, 65, 64, 69, 62, 67, 60}; // 4436251
@@ -227,14 +366,9 @@ void play_next_chord_progression(double durationSec)
         current_chord_index++;
     }
 
-    int root = chord_roots[current_chord_index % chord_roots.size()] + SEMITONE_SHIFT;
+    int root = _progression[current_chord_index % _progression.size()] + CHORD_PROGRESSION_SHIFT;
 
-    // 判断是否为小和弦（只处理 Am）
-    bool is_minor = (root % 12 == 9);  // MIDI 69, 81, 等都是 A
-
-    std::vector<int> chord_midi = {root, root + (is_minor ? 3 : 4), root + 7};
-
-    play_chord(chord_midi, durationSec);
+    play_chord(progression_chord(root), durationSec);
 }
 
 }  // namespace audio
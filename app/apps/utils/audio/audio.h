@@ -9,6 +9,12 @@
 
 namespace audio {
 
+/**
+ * @brief Render the progression and scale sounds into the sound bank, so button presses only reference them
+ *
+ */
+void init_sound_bank();
+
 void play_tone(int frequency, double durationSec = 0.1);
 
 void play_melody(const std::vector<int>& midiList, double durationSec = 0.1);
@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "spectrum.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace audio;
+
+static constexpr float PI         = 3.14159265358979323846f;
+static constexpr float FLOOR_DB   = -120.0f;
+static constexpr float FALLOFF_DB = 1.5f;
+
+static float power_to_db(float power)
+{
+    return power > 1e-12f ? 10.0f * std::log10(power) : FLOOR_DB;
+}
+
+void SpectrumAnalyzer::init(uint32_t sampleRate, size_t bandCount, float minFreq, float maxFreq)
+{
+    _history.assign(FftSize, 0.0f);
+    _history_pos = 0;
+    _re.resize(FftSize);
+    _im.resize(FftSize);
+
+    // Hann window, normalized so a full scale sine reads 0 dB
+    _window.resize(FftSize);
+    float window_sum = 0.0f;
+    for (size_t i = 0; i < FftSize; i++) {
+        _window[i] = 0.5f - 0.5f * std::cos(2.0f * PI * i / FftSize);
+        window_sum += _window[i];
+    }
+    for (auto& w : _window) {
+        w = w * 2.0f / window_sum / 32768.0f;
+    }
+
+    _cos.resize(FftSize / 2);
+    _sin.resize(FftSize / 2);
+    for (size_t i = 0; i < FftSize / 2; i++) {
+        _cos[i] = std::cos(2.0f * PI * i / FftSize);
+        _sin[i] = -std::sin(2.0f * PI * i / FftSize);
+    }
+
+    int bits = 0;
+    while ((1u << bits) < FftSize) {
+        bits++;
+    }
+    _bit_reverse.resize(FftSize);
+    for (size_t i = 0; i < FftSize; i++) {
+        uint16_t r = 0;
+        for (int b = 0; b < bits; b++) {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        _bit_reverse[i] = r;
+    }
+
+    // Log spaced bands, every band gets at least one bin
+    maxFreq        = std::min(maxFreq, sampleRate / 2.0f);
+    float bin_freq = (float)sampleRate / FftSize;
+    _band_edges.resize(bandCount + 1);
+    for (size_t b = 0; b <= bandCount; b++) {
+        float freq     = minFreq * std::pow(maxFreq / minFreq, (float)b / bandCount);
+        _band_edges[b] = std::clamp<int>(std::lround(freq / bin_freq), 1, FftSize / 2);
+        if (b > 0 && _band_edges[b] <= _band_edges[b - 1]) {
+            _band_edges[b] = std::min<int>(_band_edges[b - 1] + 1, FftSize / 2);
+        }
+    }
+    _bands.assign(bandCount, FLOOR_DB);
+    _level = FLOOR_DB;
+}
+
+void SpectrumAnalyzer::push(const int16_t* data, size_t frames, uint8_t channels, uint8_t channel)
+{
+    if (_history.empty()) {
+        return;
+    }
+    for (size_t i = 0; i < frames; i++) {
+        _history[_history_pos] = data[i * channels + channel];
+        _history_pos           = (_history_pos + 1) % FftSize;
+    }
+}
+
+const std::vector<float>& SpectrumAnalyzer::analyze()
+{
+    if (_history.empty()) {
+        return _bands;
+    }
+
+    // Oldest sample first, windowed and bit reversed on the way in
+    float square_sum = 0.0f;
+    for (size_t i = 0; i < FftSize; i++) {
+        float sample = _history[(_history_pos + i) % FftSize];
+        square_sum += sample * sample;
+        size_t r = _bit_reverse[i];
+        _re[r]   = sample * _window[i];
+        _im[r]   = 0.0f;
+    }
+    _level = power_to_db(square_sum / FftSize / (32768.0f * 32768.0f));
+
+    fft();
+
+    for (size_t b = 0; b < _bands.size(); b++) {
+        float peak = 0.0f;
+        for (size_t k = _band_edges[b]; k < _band_edges[b + 1]; k++) {
+            peak = std::max(peak, _re[k] * _re[k] + _im[k] * _im[k]);
+        }
+        _bands[b] = std::max(power_to_db(peak), _bands[b] - FALLOFF_DB);
+    }
+    return _bands;
+}
+
+void SpectrumAnalyzer::fft()
+{
+    // Iterative radix 2, the inner loop runs over separate re/im arrays so it stays friendly to auto vectorization
+    float* re = _re.data();
+    float* im = _im.data();
+    for (size_t half = 1; half < FftSize; half <<= 1) {
+        size_t twiddle_step = FftSize / (half * 2);
+        for (size_t start = 0; start < FftSize; start += half * 2) {
+            for (size_t k = 0; k < half; k++) {
+                float wr = _cos[k * twiddle_step];
+                float wi = _sin[k * twiddle_step];
+                size_t a = start + k;
+                size_t b = a + half;
+                float tr = re[b] * wr - im[b] * wi;
+                float ti = re[b] * wi + im[b] * wr;
+                re[b]    = re[a] - tr;
+                im[b]    = im[a] - ti;
+                re[a] += tr;
+                im[a] += ti;
+            }
+        }
+    }
+}
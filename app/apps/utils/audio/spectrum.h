@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace audio {
+
+/**
+ * @brief Sliding window FFT over a mono sample stream, reduced to log spaced band levels for meters
+ *
+ */
+class SpectrumAnalyzer {
+public:
+    static constexpr size_t FftSize = 512;
+
+    /**
+     * @brief
+     *
+     * @param sampleRate
+     * @param bandCount bars of the meter
+     * @param minFreq lower edge of the first band
+     * @param maxFreq upper edge of the last band, clamped to Nyquist
+     */
+    void init(uint32_t sampleRate, size_t bandCount, float minFreq = 100.0f, float maxFreq = 16000.0f);
+
+    /**
+     * @brief Append one channel of interleaved samples to the analysis window
+     *
+     * @param data
+     * @param frames
+     * @param channels interleave stride
+     * @param channel which channel to take
+     */
+    void push(const int16_t* data, size_t frames, uint8_t channels = 1, uint8_t channel = 0);
+
+    /**
+     * @brief Run the FFT over the latest FftSize samples
+     *
+     * @return band levels in dB full scale, falling back slowly like a peak meter
+     */
+    const std::vector<float>& analyze();
+
+    // RMS of the latest window, dB full scale
+    float getLevel() const
+    {
+        return _level;
+    }
+
+private:
+    std::vector<float> _history;
+    size_t _history_pos = 0;
+    std::vector<float> _window;
+    std::vector<float> _cos;
+    std::vector<float> _sin;
+    std::vector<uint16_t> _bit_reverse;
+    std::vector<float> _re;
+    std::vector<float> _im;
+    // Bin range of each band, [start, end)
+    std::vector<uint16_t> _band_edges;
+    std::vector<float> _bands;
+    float _level = -120.0f;
+
+    void fft();
+};
+
+}  // namespace audio
@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "background_app.h"
+#include <mooncake_log.h>
+#include <algorithm>
+
+using namespace background;
+
+BackgroundAppAbility::BackgroundAppAbility(const Config_t& config) : _config(config)
+{
+    _config.periodMs = std::max<uint32_t>(_config.periodMs, 1);
+}
+
+void BackgroundAppAbility::onOpen()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stats = Stats_t();
+        _ui_jobs.clear();
+    }
+    _is_stop_requested = false;
+
+    // UI first, the task may post to it right away
+    onUiOpen();
+
+    _is_task_running = true;
+    _is_inline       = !GetHAL()->startAppTask(_config.task, [this]() { task_loop(); });
+    if (_is_inline) {
+        _is_task_running = false;
+        mclog::tagInfo(getAppInfo().name, "no app task, loop runs on the app loop");
+        onTaskStart();
+        _next_run_time = GetHAL()->millis();
+    }
+}
+
+void BackgroundAppAbility::onRunning()
+{
+    if (_is_inline && (int32_t)(GetHAL()->millis() - _next_run_time) >= 0) {
+        run_task_once();
+        _next_run_time += _config.periodMs;
+        if ((int32_t)(GetHAL()->millis() - _next_run_time) > 0) {
+            _next_run_time = GetHAL()->millis();
+        }
+    }
+
+    run_ui_jobs();
+    onUiRunning();
+}
+
+void BackgroundAppAbility::onClose()
+{
+    _is_stop_requested = true;
+    if (_is_inline) {
+        onTaskStop();
+    } else {
+        // A period at most, the task checks the flag between runs
+        while (_is_task_running) {
+            GetHAL()->delay(1);
+        }
+    }
+
+    // Jobs still queued were meant for the UI that goes now
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _ui_jobs.clear();
+    }
+    onUiClose();
+}
+
+bool BackgroundAppAbility::postToUi(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_ui_jobs.size() >= _config.queueSize) {
+            _stats.droppedJobs++;
+            return false;
+        }
+        _ui_jobs.push_back(std::move(job));
+    }
+    GetHAL()->wakeAppLoop();
+    return true;
+}
+
+BackgroundAppAbility::Stats_t BackgroundAppAbility::getTaskStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+void BackgroundAppAbility::task_loop()
+{
+    onTaskStart();
+
+    // Fixed rate, a late run is not caught up on with a burst
+    uint32_t next_run_time = GetHAL()->millis();
+    while (!_is_stop_requested) {
+        run_task_once();
+
+        next_run_time += _config.periodMs;
+        int32_t wait_time = next_run_time - GetHAL()->millis();
+        if (wait_time > 0) {
+            GetHAL()->delay(wait_time);
+        } else {
+            next_run_time = GetHAL()->millis();
+        }
+    }
+
+    onTaskStop();
+    _is_task_running = false;
+}
+
+void BackgroundAppAbility::run_task_once()
+{
+    uint32_t start_time = GetHAL()->millis();
+    onTaskRunning();
+    uint32_t run_time = GetHAL()->millis() - start_time;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.runCount++;
+    _stats.maxRunTimeMs = std::max(_stats.maxRunTimeMs, run_time);
+    if (run_time > _config.periodMs) {
+        _stats.overrunCount++;
+    }
+}
+
+void BackgroundAppAbility::run_ui_jobs()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_ui_jobs.empty()) {
+            return;
+        }
+        _running_jobs.swap(_ui_jobs);
+    }
+
+    // Outside the queue mutex, a job may post again
+    LvglLockGuard lock;
+    for (auto& job : _running_jobs) {
+        job();
+    }
+    _running_jobs.clear();
+}
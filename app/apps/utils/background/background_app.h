@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <mooncake.h>
+#include <hal/hal.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace background {
+
+/**
+ * @brief App with a loop of its own on a HAL app task, so its deadlines do not slip behind UI rendering. The task
+ * never touches LVGL, UI changes are posted and run on the app loop under the LVGL lock. Runs the task loop on the app
+ * loop instead where the platform has no tasks
+ *
+ */
+class BackgroundAppAbility : public mooncake::AppAbility {
+public:
+    struct Config_t {
+        hal::HalBase::AppTaskConfig_t task;
+        // Task loop period, counted from the start of each run
+        uint32_t periodMs = 10;
+        // Posted jobs over this are dropped
+        size_t queueSize = 32;
+    };
+
+    struct Stats_t {
+        uint32_t runCount     = 0;
+        uint32_t overrunCount = 0;  // Runs that took longer than a period
+        uint32_t maxRunTimeMs = 0;
+        uint32_t droppedJobs  = 0;
+    };
+
+    BackgroundAppAbility(const Config_t& config);
+
+    // Lifecycle of the app loop side, override the onUi* callbacks instead
+    void onOpen() final;
+    void onRunning() final;
+    void onClose() final;
+
+    // App loop
+    virtual void onUiOpen()
+    {
+    }
+    virtual void onUiRunning()
+    {
+    }
+    virtual void onUiClose()
+    {
+    }
+
+    // Task, onTaskStart() and onTaskStop() run on the task before and after the loop
+    virtual void onTaskStart()
+    {
+    }
+    virtual void onTaskRunning()
+    {
+    }
+    virtual void onTaskStop()
+    {
+    }
+
+    /**
+     * @brief Run a job on the app loop with the LVGL lock held, from any thread. Wakes the app loop up
+     *
+     * @param job
+     * @return false if the queue is full
+     */
+    bool postToUi(std::function<void()> job);
+
+    // From any thread
+    Stats_t getTaskStats();
+
+private:
+    void task_loop();
+    void run_task_once();
+    void run_ui_jobs();
+
+    Config_t _config;
+    std::mutex _mutex;
+    std::vector<std::function<void()>> _ui_jobs;
+    std::vector<std::function<void()>> _running_jobs;
+    Stats_t _stats;
+    std::atomic<bool> _is_stop_requested = false;
+    std::atomic<bool> _is_task_running   = false;
+    bool _is_inline                      = false;
+    uint32_t _next_run_time              = 0;
+};
+
+}  // namespace background
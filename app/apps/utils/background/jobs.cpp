@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "jobs.h"
+#include <mutex>
+#include <vector>
+
+struct JobsData_t {
+    std::mutex mutex;
+    std::vector<std::function<void()>> doneCallbacks;
+    // App loop only, swapped with doneCallbacks so a callback can start another job
+    std::vector<std::function<void()>> runningCallbacks;
+};
+static JobsData_t _jobs_data;
+
+bool background::run_job(std::function<void()> job, std::function<void()> onDone, int core)
+{
+    if (!onDone) {
+        return GetHAL()->submitJob(std::move(job), core);
+    }
+    return GetHAL()->submitJob(
+        [job = std::move(job), onDone = std::move(onDone)]() mutable {
+            job();
+            {
+                std::lock_guard<std::mutex> lock(_jobs_data.mutex);
+                _jobs_data.doneCallbacks.push_back(std::move(onDone));
+            }
+            GetHAL()->wakeAppLoop();
+        },
+        core);
+}
+
+void background::dispatch_done_jobs()
+{
+    {
+        std::lock_guard<std::mutex> lock(_jobs_data.mutex);
+        if (_jobs_data.doneCallbacks.empty()) {
+            return;
+        }
+        _jobs_data.runningCallbacks.swap(_jobs_data.doneCallbacks);
+    }
+
+    for (auto& callback : _jobs_data.runningCallbacks) {
+        callback();
+    }
+    _jobs_data.runningCallbacks.clear();
+}
@@ -0,0 +1,53 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <hal/hal.h>
+#include <functional>
+#include <future>
+#include <memory>
+
+/**
+ * @brief Jobs on the HAL worker pool, for work that would stall a frame, e.g. file or network IO. A job never touches
+ * LVGL, its completion callback runs on the app loop and takes the LVGL lock itself, as event handlers do
+ *
+ */
+namespace background {
+
+/**
+ * @brief Run a job on the pool, onDone runs on the app loop after it, from dispatch_done_jobs()
+ *
+ * @param job
+ * @param onDone
+ * @param core preferred core, -1 for the caller's
+ * @return false if the pool is full, neither runs then
+ */
+bool run_job(std::function<void()> job, std::function<void()> onDone = nullptr, int core = -1);
+
+/**
+ * @brief Run a job on the pool and take its result through a future
+ *
+ * @param job
+ * @param core preferred core, -1 for the caller's
+ * @return std::future<T> without a shared state if the pool is full
+ */
+template <typename T>
+std::future<T> run_async(std::function<T()> job, int core = -1)
+{
+    auto task          = std::make_shared<std::packaged_task<T()>>(std::move(job));
+    std::future<T> ret = task->get_future();
+    if (!GetHAL()->submitJob([task]() { (*task)(); }, core)) {
+        return std::future<T>();
+    }
+    return ret;
+}
+
+/**
+ * @brief Run the completion callbacks of finished jobs, app loop only, once per frame
+ *
+ */
+void dispatch_done_jobs();
+
+}  // namespace background
@@ -4,16 +4,105 @@
  * SPDX-License-Identifier: MIT
  */
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <random>
 
 namespace math {
 
+/**
+ * @brief xoshiro128++, 16 bytes of state and a few adds and rotates per number. Not for anything security related
+ *
+ */
+class FastRandom {
+public:
+    explicit FastRandom(uint64_t seed)
+    {
+        // Spread the seed with splitmix64, an all zero state would stay zero
+        for (int i = 0; i < 4; i += 2) {
+            seed += 0x9E3779B97F4A7C15ull;
+            uint64_t z = seed;
+            z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z          = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            z ^= z >> 31;
+            _state[i]     = (uint32_t)z;
+            _state[i + 1] = (uint32_t)(z >> 32);
+        }
+    }
+
+    uint32_t next()
+    {
+        uint32_t result = rotl(_state[0] + _state[3], 7) + _state[0];
+        uint32_t t      = _state[1] << 9;
+        _state[2] ^= _state[0];
+        _state[3] ^= _state[1];
+        _state[1] ^= _state[2];
+        _state[0] ^= _state[3];
+        _state[2] ^= t;
+        _state[3] = rotl(_state[3], 11);
+        return result;
+    }
+
+private:
+    uint32_t _state[4];
+
+    static uint32_t rotl(uint32_t x, int k)
+    {
+        return (x << k) | (x >> (32 - k));
+    }
+};
+
+/**
+ * @brief The calling thread's generator, seeded from std::random_device on its first use only
+ *
+ * @return FastRandom&
+ */
+inline FastRandom& thread_random()
+{
+    thread_local FastRandom generator([]() {
+        std::random_device rd;
+        return ((uint64_t)rd() << 32) | rd();
+    }());
+    return generator;
+}
+
+inline uint32_t random_u32()
+{
+    return thread_random().next();
+}
+
+// [min, max), the top 24 bits fill the float mantissa
 inline float random(float min, float max)
 {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution dis(min, max);
-    return dis(gen);
+    return min + (max - min) * ((random_u32() >> 8) * (1.0f / 16777216.0f));
+}
+
+// [min, max), by multiply and shift instead of a modulo
+inline int random_int(int min, int max)
+{
+    if (max <= min) {
+        return min;
+    }
+    uint32_t range = (uint32_t)(max - min);
+    return min + (int)(((uint64_t)random_u32() * range) >> 32);
+}
+
+// Batch fill, the generator is looked up once
+inline void random_fill(uint32_t* out, size_t count)
+{
+    auto& generator = thread_random();
+    for (size_t i = 0; i < count; i++) {
+        out[i] = generator.next();
+    }
+}
+
+inline void random_fill(float* out, size_t count, float min, float max)
+{
+    auto& generator = thread_random();
+    float scale     = (max - min) * (1.0f / 16777216.0f);
+    for (size_t i = 0; i < count; i++) {
+        out[i] = min + (generator.next() >> 8) * scale;
+    }
 }
 
 }  // namespace math
@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "frame_arena.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace memory;
+
+static const std::string _tag = "frame-arena";
+
+FrameArena::~FrameArena()
+{
+    if (_buffer != nullptr) {
+        GetHAL()->freeMemory(_buffer);
+    }
+}
+
+bool FrameArena::init(size_t capacity, hal::HalBase::MemoryPlacement_t placement)
+{
+    if (_buffer != nullptr) {
+        return true;
+    }
+    _buffer = static_cast<uint8_t*>(GetHAL()->allocMemory(capacity, placement));
+    if (_buffer == nullptr) {
+        mclog::tagError(_tag, "alloc {} bytes failed", capacity);
+        return false;
+    }
+    _stats          = Stats_t();
+    _stats.capacity = capacity;
+    return true;
+}
+
+void* FrameArena::alloc(size_t size, size_t align)
+{
+    // On the address, the buffer itself is only as aligned as the allocator makes it
+    uintptr_t base  = reinterpret_cast<uintptr_t>(_buffer);
+    uintptr_t start = (base + _stats.used + align - 1) & ~(uintptr_t)(align - 1);
+    if (_buffer == nullptr || start + size > base + _stats.capacity) {
+        _stats.overflows++;
+        return nullptr;
+    }
+    _stats.used = start + size - base;
+    _stats.peak = std::max(_stats.peak, _stats.used);
+    return reinterpret_cast<void*>(start);
+}
+
+void FrameArena::reset()
+{
+    _stats.used = 0;
+}
+
+FrameText::FrameText(FrameArena& arena, size_t capacity)
+{
+    _data = arena.allocArray<char>(capacity);
+    if (_data != nullptr) {
+        _capacity = capacity;
+        _data[0]  = '\0';
+    }
+}
+
+void FrameText::append(const char* text)
+{
+    if (_size + 1 >= _capacity) {
+        return;
+    }
+    size_t length = std::min(strlen(text), _capacity - 1 - _size);
+    memcpy(_data + _size, text, length);
+    _size += length;
+    _data[_size] = '\0';
+}
+
+FrameArena& memory::get_frame_arena()
+{
+    static FrameArena arena;
+    return arena;
+}
@@ -0,0 +1,106 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <hal/hal.h>
+#include <mooncake_log.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Bump arena for data that only lives through one frame, e.g. label text. An allocation is a pointer bump, the
+ * whole arena is freed in one go at the start of the next frame. App loop only
+ *
+ */
+namespace memory {
+
+class FrameArena {
+public:
+    struct Stats_t {
+        size_t capacity    = 0;
+        size_t used        = 0;
+        size_t peak        = 0;  // Most used in one frame
+        uint32_t overflows = 0;  // Allocations that did not fit
+    };
+
+    FrameArena() = default;
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    ~FrameArena();
+
+    bool init(size_t capacity, hal::HalBase::MemoryPlacement_t placement);
+
+    // Null when the frame's share is used up, callers fall back or skip
+    void* alloc(size_t size, size_t align = alignof(std::max_align_t));
+
+    // Nothing is destructed on reset, so only for trivially destructible types
+    template <typename T>
+    T* allocArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "arena memory is never destructed");
+        return static_cast<T*>(alloc(sizeof(T) * count, alignof(T)));
+    }
+
+    void reset();
+
+    Stats_t getStats() const
+    {
+        return _stats;
+    }
+
+private:
+    uint8_t* _buffer = nullptr;
+    Stats_t _stats;
+};
+
+/**
+ * @brief Fixed capacity text in the frame arena, the end is cut off once full
+ *
+ */
+class FrameText {
+public:
+    FrameText(FrameArena& arena, size_t capacity);
+
+    template <typename... Args>
+    void append(fmt::format_string<Args...> format, Args&&... args)
+    {
+        if (_size + 1 >= _capacity) {
+            return;
+        }
+        auto result = fmt::format_to_n(_data + _size, _capacity - 1 - _size, format, std::forward<Args>(args)...);
+        _size += result.size;
+        if (_size > _capacity - 1) {
+            _size = _capacity - 1;
+        }
+        _data[_size] = '\0';
+    }
+
+    void append(const char* text);
+
+    const char* c_str() const
+    {
+        return _data != nullptr ? _data : "";
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+private:
+    char* _data      = nullptr;
+    size_t _capacity = 0;
+    size_t _size     = 0;
+};
+
+/**
+ * @brief The app loop's arena, reset by app::Update() ahead of each frame
+ *
+ * @return FrameArena&
+ */
+FrameArena& get_frame_arena();
+
+}  // namespace memory
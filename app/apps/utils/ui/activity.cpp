@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "activity.h"
+#include <hal/hal.h>
+#include <lvgl.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+using namespace ui;
+
+// Full rate is kept a little after the last activity, for animation tails and transitions chained from callbacks
+static constexpr uint32_t _active_hold_time = 200;
+// Panels poll sensors every 100 ms and up, so a static UI still updates often enough
+static constexpr uint32_t _idle_poll_interval = 50;
+
+static std::atomic<uint32_t> _last_active_time{0};
+// Only the app loop touches these
+static bool _is_perf_claimed = false;
+static std::vector<lv_indev_t*> _hooked_indevs;
+
+static void on_indev_event(lv_event_t* e)
+{
+    // Click handlers run on the LVGL task and often start a transition the app loop has to drive
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_PRESSED:
+        case LV_EVENT_PRESSING:
+        case LV_EVENT_RELEASED:
+        case LV_EVENT_KEY:
+            activity::wake();
+            break;
+        default:
+            break;
+    }
+}
+
+void activity::init()
+{
+    LvglLockGuard lock;
+    lv_indev_t* indev = lv_indev_get_next(nullptr);
+    while (indev) {
+        if (std::find(_hooked_indevs.begin(), _hooked_indevs.end(), indev) == _hooked_indevs.end()) {
+            lv_indev_add_event_cb(indev, on_indev_event, LV_EVENT_ALL, nullptr);
+            _hooked_indevs.push_back(indev);
+        }
+        indev = lv_indev_get_next(indev);
+    }
+    keep_awake();
+}
+
+void activity::keep_awake()
+{
+    _last_active_time = GetHAL()->millis();
+}
+
+void activity::wake()
+{
+    keep_awake();
+    GetHAL()->wakeAppLoop();
+}
+
+bool activity::is_active()
+{
+    return GetHAL()->millis() - _last_active_time < _active_hold_time;
+}
+
+void activity::wait_for_next_update()
+{
+    // Animations run at the max clock, a static UI leaves the level to the other claims
+    bool is_animating = is_active();
+    if (is_animating != _is_perf_claimed) {
+        _is_perf_claimed = is_animating;
+        GetHAL()->claimPerfLevel("ui", is_animating ? hal::HalBase::PERF_LEVEL_MAX : hal::HalBase::PERF_LEVEL_NONE);
+        // The panel scans out at the full rate too, a static UI lets the refresh governor lower it
+        GetHAL()->setUiAnimating(is_animating);
+    }
+
+    GetHAL()->waitAppLoopWakeup(is_animating ? 0 : _idle_poll_interval);
+}
@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief Idle aware app loop scheduling. The loop runs at full rate while the UI animates, and sleeps until an input
+ * or HAL event, or the idle poll interval, while the UI is static
+ *
+ */
+namespace ui {
+namespace activity {
+
+/**
+ * @brief Hook the LVGL input devices, so any input wakes the app loop. Call once LVGL is up, and again once the HAL
+ * has finished booting, only devices added since are hooked then
+ *
+ */
+void init();
+
+/**
+ * @brief Keep the app loop at full rate, call on every update while an animation is running
+ *
+ */
+void keep_awake();
+
+/**
+ * @brief Wake a sleeping app loop, safe from any task and from LVGL callbacks
+ *
+ */
+void wake();
+
+/**
+ * @brief Wait before the next app update, returns after a tick while active. The max perf level is claimed while
+ * active
+ *
+ */
+void wait_for_next_update();
+
+/**
+ * @brief Whether the app loop is running at full rate
+ *
+ */
+bool is_active();
+
+}  // namespace activity
+}  // namespace ui
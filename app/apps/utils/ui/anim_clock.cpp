@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "anim_clock.h"
+#include "activity.h"
+#include <hal/hal.h>
+#include <smooth_ui_toolkit.h>
+#include <atomic>
+
+using namespace ui;
+
+// Read by the toolkit from the app loop and the LVGL callbacks it runs, written by the app loop only
+static std::atomic<uint32_t> _frame_time{0};
+// Only the app loop touches these
+static bool _is_running_this_frame = false;
+static bool _is_running_last_frame = false;
+
+void anim_clock::init()
+{
+    _frame_time = GetHAL()->millis();
+    smooth_ui_toolkit::ui_hal::on_get_tick([]() -> uint32_t { return _frame_time.load(std::memory_order_relaxed); });
+}
+
+void anim_clock::begin_frame()
+{
+    _frame_time.store(GetHAL()->millis(), std::memory_order_relaxed);
+    _is_running_last_frame = _is_running_this_frame;
+    _is_running_this_frame = false;
+}
+
+uint32_t anim_clock::now()
+{
+    return _frame_time.load(std::memory_order_relaxed);
+}
+
+bool anim_clock::is_settled()
+{
+    return !_is_running_last_frame && !_is_running_this_frame;
+}
+
+void anim_clock::mark_running()
+{
+    if (!_is_running_this_frame) {
+        _is_running_this_frame = true;
+        activity::keep_awake();
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief One clock for every AnimateValue. The toolkit clock reads a time latched once per app frame, so all the
+ * animations of a frame step to the same instant and none of them reads the hardware timer. The frame also records
+ * whether any animation still moved, so a settled UI can let the app loop and the display idle
+ *
+ */
+namespace ui {
+namespace anim_clock {
+
+/**
+ * @brief Hook the toolkit clock to the frame time, call once before the first animation
+ *
+ */
+void init();
+
+/**
+ * @brief Latch the time the animations of this frame see, once at the start of every app frame
+ *
+ */
+void begin_frame();
+
+/**
+ * @brief Frame time in ms, on the HAL clock
+ *
+ */
+uint32_t now();
+
+/**
+ * @brief Whether any of the animations is still moving. A moving one is counted for the frame and keeps the app
+ * loop at full rate, a settled one costs a done() check and nothing else
+ *
+ */
+template <typename... Anims>
+bool is_running(Anims&... anims);
+
+/**
+ * @brief Whether no animation was running in the last frame
+ *
+ */
+bool is_settled();
+
+// Counted for the frame by is_running()
+void mark_running();
+
+template <typename... Anims>
+bool is_running(Anims&... anims)
+{
+    if ((anims.done() && ...)) {
+        return false;
+    }
+    mark_running();
+    return true;
+}
+
+}  // namespace anim_clock
+}  // namespace ui
@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "history_chart.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace ui;
+using namespace smooth_ui_toolkit;
+using namespace smooth_ui_toolkit::lvgl_cpp;
+
+void HistoryChart::init(lv_obj_t* parent, const Config_t& config)
+{
+    _config                 = config;
+    _config.points          = std::max<uint16_t>(_config.points, 2);
+    _config.samplesPerPoint = std::max<uint16_t>(_config.samplesPerPoint, 1);
+
+    _chart = std::make_unique<Chart>(parent);
+    _chart->setBgColor(lv_color_hex(_config.bgColor));
+    _chart->setRadius(12);
+    _chart->setBorderWidth(0, LV_PART_MAIN | LV_STATE_DEFAULT);
+    _chart->setStyleSize(0, 0, LV_PART_INDICATOR);
+    _chart->setBgOpa(LV_OPA_TRANSP, LV_PART_ITEMS);
+    _chart->setDivLineCount(3, 0);
+    _chart->setPointCount(_config.points);
+    _chart->setUpdateMode(LV_CHART_UPDATE_MODE_SHIFT);
+    lv_obj_set_style_line_width(_chart->get(), 2, LV_PART_ITEMS);
+    _traces.clear();
+    _range_min = 0;
+    _range_max = 0;
+}
+
+void HistoryChart::addTrace(lv_color_t color)
+{
+    // The min line a little darker, the band between the two is the spread within a point
+    lv_color_t min_color = lv_color_mix(color, lv_color_hex(_config.bgColor), 180);
+    Trace_t trace;
+    trace.maxSeries = lv_chart_add_series(_chart->get(), color, LV_CHART_AXIS_PRIMARY_Y);
+    trace.minSeries = lv_chart_add_series(_chart->get(), min_color, LV_CHART_AXIS_PRIMARY_Y);
+    lv_chart_set_all_value(_chart->get(), trace.maxSeries, LV_CHART_POINT_NONE);
+    lv_chart_set_all_value(_chart->get(), trace.minSeries, LV_CHART_POINT_NONE);
+    _traces.push_back(trace);
+}
+
+void HistoryChart::push(const float* values)
+{
+    for (size_t i = 0; i < _traces.size(); i++) {
+        auto& trace = _traces[i];
+        if (_bucket_samples == 0) {
+            trace.bucketMin = trace.bucketMax = values[i];
+        } else {
+            trace.bucketMin = std::min(trace.bucketMin, values[i]);
+            trace.bucketMax = std::max(trace.bucketMax, values[i]);
+        }
+    }
+    if (++_bucket_samples >= _config.samplesPerPoint) {
+        commit_bucket();
+    }
+}
+
+void HistoryChart::reset(uint16_t samplesPerPoint)
+{
+    _config.samplesPerPoint = std::max<uint16_t>(samplesPerPoint, 1);
+    _bucket_samples         = 0;
+    for (auto& trace : _traces) {
+        lv_chart_set_all_value(_chart->get(), trace.maxSeries, LV_CHART_POINT_NONE);
+        lv_chart_set_all_value(_chart->get(), trace.minSeries, LV_CHART_POINT_NONE);
+    }
+    _range_min = 0;
+    _range_max = 0;
+}
+
+void HistoryChart::commit_bucket()
+{
+    // Shift mode only moves the start index of each series, the chart redraws once for all of them
+    for (auto& trace : _traces) {
+        lv_chart_set_next_value(_chart->get(), trace.maxSeries, std::lround(trace.bucketMax * _config.scale));
+        lv_chart_set_next_value(_chart->get(), trace.minSeries, std::lround(trace.bucketMin * _config.scale));
+    }
+    _bucket_samples = 0;
+    update_range();
+}
+
+void HistoryChart::update_range()
+{
+    int32_t lo = INT32_MAX;
+    int32_t hi = INT32_MIN;
+    for (auto& trace : _traces) {
+        for (auto series : {trace.minSeries, trace.maxSeries}) {
+            const int32_t* points = lv_chart_get_y_array(_chart->get(), series);
+            for (uint16_t i = 0; i < _config.points; i++) {
+                if (points[i] == LV_CHART_POINT_NONE) {
+                    continue;
+                }
+                lo = std::min(lo, points[i]);
+                hi = std::max(hi, points[i]);
+            }
+        }
+    }
+    if (lo > hi) {
+        return;
+    }
+
+    // Kept while the window fits and fills a third of it, a new range gets a margin so it holds for a while
+    int32_t span = std::max<int32_t>(hi - lo, std::lround(_config.minSpan * _config.scale));
+    bool is_set  = _range_max > _range_min;
+    if (is_set && lo >= _range_min && hi <= _range_max && (_range_max - _range_min) <= span * 3) {
+        return;
+    }
+    int32_t center = lo / 2 + hi / 2;
+    _range_min     = center - span * 3 / 4;
+    _range_max     = center + span * 3 / 4;
+    _chart->setRange(LV_CHART_AXIS_PRIMARY_Y, _range_min, _range_max);
+}
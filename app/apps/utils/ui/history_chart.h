@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <lvgl.h>
+#include <smooth_ui_toolkit.h>
+#include <smooth_lvgl.h>
+
+namespace ui {
+
+/**
+ * @brief Scrolling line chart of a sample stream. Each point holds the min and the max of samplesPerPoint samples, so
+ * a transient shorter than a point still shows at its full height. A full bucket shifts the series by one point, the
+ * series are never rebuilt, and the y range only changes once the window no longer fits it
+ *
+ */
+class HistoryChart {
+public:
+    struct Config_t {
+        uint16_t points          = 300;
+        uint16_t samplesPerPoint = 1;
+        // Chart values are integers, samples are multiplied by this
+        float scale = 1000.0f;
+        // Smallest y span in sample units, so noise does not fill the chart
+        float minSpan    = 0.1f;
+        uint32_t bgColor = 0x383838;
+    };
+
+    void init(lv_obj_t* parent, const Config_t& config);
+    // A trace is drawn as its min and its max line, add all of them before the first push
+    void addTrace(lv_color_t color);
+    // One sample of every trace, in the order they were added
+    void push(const float* values);
+    // Empties the window, e.g. for another samplesPerPoint
+    void reset(uint16_t samplesPerPoint);
+
+    // Y range shown, in sample units
+    float getRangeMin() const
+    {
+        return _range_min / _config.scale;
+    }
+    float getRangeMax() const
+    {
+        return _range_max / _config.scale;
+    }
+    uint16_t getSamplesPerPoint() const
+    {
+        return _config.samplesPerPoint;
+    }
+    smooth_ui_toolkit::lvgl_cpp::Chart* get()
+    {
+        return _chart.get();
+    }
+
+private:
+    struct Trace_t {
+        lv_chart_series_t* minSeries = nullptr;
+        lv_chart_series_t* maxSeries = nullptr;
+        float bucketMin              = 0.0f;
+        float bucketMax              = 0.0f;
+    };
+
+    Config_t _config;
+    std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Chart> _chart;
+    std::vector<Trace_t> _traces;
+    uint16_t _bucket_samples = 0;
+    int32_t _range_min       = 0;
+    int32_t _range_max       = 0;
+
+    void commit_bucket();
+    void update_range();
+};
+
+}  // namespace ui
@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <utility>
+#include <lvgl.h>
+#include <mooncake_log.h>
+#include <smooth_ui_toolkit.h>
+#include <smooth_lvgl.h>
+
+namespace ui {
+
+/**
+ * @brief Label text that only reaches LVGL when it changes. Values are formatted into a stack buffer and compared with
+ * the text set last, so an unchanged value costs no allocation, no relayout and no invalidation. Text longer than
+ * Capacity - 1 is cut
+ *
+ */
+template <size_t Capacity = 32>
+class LabelBinding {
+public:
+    LabelBinding() = default;
+    explicit LabelBinding(smooth_ui_toolkit::lvgl_cpp::Label* label) : _label(label)
+    {
+    }
+
+    // The last text is forgotten, the next set always writes
+    void bind(smooth_ui_toolkit::lvgl_cpp::Label* label)
+    {
+        _label = label;
+        _size  = _unset;
+    }
+
+    // Returns true if the label was written
+    template <typename... Args>
+    bool set(fmt::format_string<Args...> format, Args&&... args)
+    {
+        char buffer[Capacity];
+        auto result = fmt::format_to_n(buffer, Capacity - 1, format, std::forward<Args>(args)...);
+        return assign(buffer, std::min<size_t>(result.size, Capacity - 1));
+    }
+    bool set(std::string_view text)
+    {
+        return assign(text.data(), std::min(text.size(), Capacity - 1));
+    }
+
+    // Empty until the first set after a bind
+    std::string_view text() const
+    {
+        return _size == _unset ? std::string_view() : std::string_view(_text, _size);
+    }
+
+private:
+    static_assert(Capacity > 1, "no room for the text");
+    static constexpr size_t _unset = Capacity;
+
+    smooth_ui_toolkit::lvgl_cpp::Label* _label = nullptr;
+    size_t _size                               = _unset;
+    char _text[Capacity];
+
+    bool assign(const char* text, size_t size)
+    {
+        if (_label == nullptr || (size == _size && memcmp(text, _text, size) == 0)) {
+            return false;
+        }
+        memcpy(_text, text, size);
+        _text[size] = '\0';
+        _size       = size;
+        lv_label_set_text(_label->get(), _text);
+        return true;
+    }
+};
+
+}  // namespace ui
@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "recycled_list.h"
+#include <algorithm>
+
+using namespace ui;
+using namespace smooth_ui_toolkit;
+using namespace smooth_ui_toolkit::lvgl_cpp;
+
+void RecycledList::init(lv_obj_t* parent, const Config_t& config)
+{
+    _config           = config;
+    _config.rowHeight = std::max<int32_t>(_config.rowHeight, 1);
+
+    _list = std::make_unique<Container>(parent);
+    _list->setScrollbarMode(LV_SCROLLBAR_MODE_AUTO);
+    lv_obj_set_scroll_dir(_list->get(), LV_DIR_VER);
+    lv_obj_add_event_cb(_list->get(), on_scroll, LV_EVENT_SCROLL, this);
+
+    // Only there to stretch the content to the full list height
+    _spacer = lv_obj_create(_list->get());
+    lv_obj_remove_style_all(_spacer);
+    lv_obj_remove_flag(_spacer, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_size(_spacer, 1, 0);
+    lv_obj_set_pos(_spacer, 0, 0);
+
+    _rows.clear();
+    _item_count = 0;
+}
+
+void RecycledList::setItemCount(size_t count)
+{
+    if (_rows.empty()) {
+        create_rows();
+    }
+    _item_count = count;
+    lv_obj_set_height(_spacer, (int32_t)count * _config.rowHeight);
+    layout_rows();
+}
+
+void RecycledList::invalidate()
+{
+    for (auto& row : _rows) {
+        row.index = SIZE_MAX;
+    }
+    layout_rows();
+}
+
+void RecycledList::create_rows()
+{
+    // Enough to cover the view with a row cut at both edges
+    lv_obj_update_layout(_list->get());
+    int32_t view_height = std::max<int32_t>(lv_obj_get_content_height(_list->get()), _config.rowHeight);
+    size_t row_num      = view_height / _config.rowHeight + 2;
+
+    _rows.resize(row_num);
+    for (size_t slot = 0; slot < row_num; slot++) {
+        auto& row = _rows[slot];
+        row.obj   = lv_obj_create(_list->get());
+        lv_obj_remove_style_all(row.obj);
+        // Drags fall through to the list
+        lv_obj_remove_flag(row.obj, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_remove_flag(row.obj, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_set_size(row.obj, lv_pct(100), _config.rowHeight);
+        lv_obj_add_flag(row.obj, LV_OBJ_FLAG_HIDDEN);
+        if (_config.onCreateRow) {
+            _config.onCreateRow(row.obj, slot);
+        }
+    }
+}
+
+void RecycledList::layout_rows()
+{
+    int32_t scroll_y = std::max<int32_t>(lv_obj_get_scroll_y(_list->get()), 0);
+    size_t first     = scroll_y / _config.rowHeight;
+
+    // Every row keeps the item it had if that is still in view, so a scroll by less than a row binds nothing
+    for (size_t i = 0; i < _rows.size(); i++) {
+        size_t index = first + i;
+        size_t slot  = index % _rows.size();
+        auto& row    = _rows[slot];
+        if (index >= _item_count) {
+            if (row.index != SIZE_MAX) {
+                lv_obj_add_flag(row.obj, LV_OBJ_FLAG_HIDDEN);
+                row.index = SIZE_MAX;
+            }
+            continue;
+        }
+        if (row.index == index) {
+            continue;
+        }
+        lv_obj_set_pos(row.obj, 0, (int32_t)index * _config.rowHeight);
+        lv_obj_remove_flag(row.obj, LV_OBJ_FLAG_HIDDEN);
+        row.index = index;
+        if (_config.onBindRow) {
+            _config.onBindRow(slot, index);
+        }
+    }
+}
+
+void RecycledList::on_scroll(lv_event_t* e)
+{
+    static_cast<RecycledList*>(lv_event_get_user_data(e))->layout_rows();
+}
@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <lvgl.h>
+#include <smooth_ui_toolkit.h>
+#include <smooth_lvgl.h>
+
+namespace ui {
+
+/**
+ * @brief Scrolling list of fixed height rows that only has widgets for the rows in view. A spacer gives the list the
+ * full scroll height, and on every scroll the rows are moved to the items now in view and bound to them by index. The
+ * LVGL objects and the layout cost depend on the list height only, not on the item count
+ *
+ */
+class RecycledList {
+public:
+    struct Config_t {
+        int32_t rowHeight = 42;
+        // Builds the widgets of a row once, slot is the row's index in the pool
+        std::function<void(lv_obj_t* row, size_t slot)> onCreateRow;
+        // Fills the row in slot with the item at index, only when the row moves to another item
+        std::function<void(size_t slot, size_t index)> onBindRow;
+    };
+
+    // A plain container, size, align and style it through get() before the first setItemCount()
+    void init(lv_obj_t* parent, const Config_t& config);
+    // Items added at the end keep the scroll position, the rows in view are bound again
+    void setItemCount(size_t count);
+    // Binds every row in view again, e.g. after the items changed in place
+    void invalidate();
+
+    size_t getItemCount() const
+    {
+        return _item_count;
+    }
+    smooth_ui_toolkit::lvgl_cpp::Container* get()
+    {
+        return _list.get();
+    }
+
+private:
+    struct Row_t {
+        lv_obj_t* obj = nullptr;
+        // Item the row shows, SIZE_MAX while hidden
+        size_t index = SIZE_MAX;
+    };
+
+    Config_t _config;
+    std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _list;
+    lv_obj_t* _spacer = nullptr;
+    std::vector<Row_t> _rows;
+    size_t _item_count = 0;
+
+    void create_rows();
+    void layout_rows();
+    static void on_scroll(lv_event_t* e);
+};
+
+}  // namespace ui
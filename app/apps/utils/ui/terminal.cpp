@@ -0,0 +1,215 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "terminal.h"
+#include <lvgl.h>
+#include <hal/hal.h>
+#include <assets/font_engine.h>
+#include <algorithm>
+#include <cstdio>
+#include <smooth_ui_toolkit.h>
+#include <smooth_lvgl.h>
+
+using namespace ui;
+using namespace smooth_ui_toolkit;
+using namespace smooth_ui_toolkit::lvgl_cpp;
+
+static constexpr int32_t _padding = 8;
+// "XX " per byte
+static constexpr uint16_t _max_hex_line_bytes = 16;
+static const char* _hex_digits                = "0123456789ABCDEF";
+static const std::string _empty_line;
+
+void Terminal::init(lv_obj_t* parent)
+{
+    _lines.assign(std::max<uint16_t>(config.maxLines, 1), std::string());
+    clear();
+
+    _panel = std::make_unique<Container>(parent);
+    _panel->setSize(config.w, config.h);
+    _panel->setPadding(_padding, _padding, _padding, _padding);
+    _panel->setBorderWidth(0);
+    _panel->setBgColor(lv_color_hex(config.bgColor));
+    _panel->setScrollbarMode(LV_SCROLLBAR_MODE_OFF);
+    _panel->removeFlag(LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(_panel->get(), on_pressing, LV_EVENT_PRESSING, this);
+
+    if (config.font == nullptr) {
+        config.font = assets::get_font(18);
+    }
+
+    // A fixed set of rows, scrolling and new lines only change their text
+    _line_height      = std::max<int32_t>(lv_font_get_line_height(config.font), 1);
+    int32_t row_count = std::max<int32_t>((config.h - _padding * 2) / _line_height, 1);
+    _rows.clear();
+    _row_texts.assign(row_count, std::string());
+    for (int32_t i = 0; i < row_count; i++) {
+        auto row = std::make_unique<Label>(_panel->get());
+        row->setPos(0, i * _line_height);
+        row->setWidth(config.w - _padding * 2);
+        row->setLongMode(LV_LABEL_LONG_CLIP);
+        row->setTextFont(config.font);
+        row->setTextColor(lv_color_hex(config.textColor));
+        row->setText("");
+        row->removeFlag(LV_OBJ_FLAG_CLICKABLE);
+        _rows.push_back(std::move(row));
+    }
+}
+
+std::string& Terminal::open_line()
+{
+    size_t capacity = _lines.size();
+    if (!_line_closed) {
+        return _lines[(_line_head + _line_count - 1) % capacity];
+    }
+
+    // The oldest line is reused once the ring is full
+    if (_line_count == capacity) {
+        _line_head = (_line_head + 1) % capacity;
+    } else {
+        _line_count++;
+    }
+    // A scrolled back view stays on the same lines
+    if (_scroll_offset > 0) {
+        size_t max_offset = _line_count > _rows.size() ? _line_count - _rows.size() : 0;
+        _scroll_offset    = std::min(_scroll_offset + 1, max_offset);
+    }
+
+    auto& line = _lines[(_line_head + _line_count - 1) % capacity];
+    line.clear();
+    if (_timestamp) {
+        uint32_t time = GetHAL()->millis();
+        char stamp[20];
+        snprintf(stamp, sizeof(stamp), "[%lu.%03lu] ", (unsigned long)(time / 1000), (unsigned long)(time % 1000));
+        line += stamp;
+    }
+    _line_closed     = false;
+    _line_byte_count = _mode == MODE_TEXT ? line.size() : 0;
+    return line;
+}
+
+void Terminal::close_line()
+{
+    _line_closed = true;
+}
+
+void Terminal::append(const uint8_t* data, size_t size)
+{
+    if (size == 0) {
+        return;
+    }
+    _is_dirty = true;
+
+    if (_mode == MODE_HEX) {
+        uint16_t line_bytes = std::clamp<uint16_t>(config.maxColumns / 3, 1, _max_hex_line_bytes);
+        for (size_t i = 0; i < size; i++) {
+            auto& line = open_line();
+            line += _hex_digits[data[i] >> 4];
+            line += _hex_digits[data[i] & 0x0F];
+            line += ' ';
+            if (++_line_byte_count >= line_bytes) {
+                close_line();
+            }
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        char c = data[i];
+        if (c == '\r') {
+            continue;
+        }
+        if (c == '\n') {
+            open_line();
+            close_line();
+            continue;
+        }
+
+        // The fonts only carry printable ASCII
+        auto& line = open_line();
+        line += c == '\t' ? ' ' : (c >= 0x20 && c < 0x7F ? c : '.');
+        if (++_line_byte_count >= config.maxColumns) {
+            close_line();
+        }
+    }
+}
+
+void Terminal::append(const std::string& text)
+{
+    append((const uint8_t*)text.data(), text.size());
+}
+
+void Terminal::clear()
+{
+    _line_head        = 0;
+    _line_count       = 0;
+    _line_closed      = true;
+    _scroll_offset    = 0;
+    _scroll_remainder = 0;
+    _is_dirty         = true;
+}
+
+void Terminal::setMode(Mode_t mode)
+{
+    if (mode == _mode) {
+        return;
+    }
+    // Text and hex never share a line
+    close_line();
+    _mode = mode;
+}
+
+void Terminal::setTimestamp(bool enable)
+{
+    // Applies from the next line on
+    _timestamp = enable;
+}
+
+void Terminal::scroll(int32_t dy)
+{
+    _scroll_remainder += dy;
+    int32_t lines = _scroll_remainder / _line_height;
+    if (lines == 0) {
+        return;
+    }
+    _scroll_remainder -= lines * _line_height;
+
+    // Dragging down brings back older lines
+    int64_t max_offset = _line_count > _rows.size() ? _line_count - _rows.size() : 0;
+    size_t offset      = std::clamp<int64_t>((int64_t)_scroll_offset + lines, 0, max_offset);
+    if (offset != _scroll_offset) {
+        _scroll_offset = offset;
+        _is_dirty      = true;
+    }
+}
+
+void Terminal::on_pressing(lv_event_t* e)
+{
+    auto terminal = static_cast<Terminal*>(lv_event_get_user_data(e));
+    lv_point_t vect;
+    lv_indev_get_vect(lv_indev_active(), &vect);
+    terminal->scroll(vect.y);
+}
+
+void Terminal::render()
+{
+    if (!_is_dirty || _rows.empty()) {
+        return;
+    }
+    _is_dirty = false;
+
+    size_t row_count = _rows.size();
+    size_t bottom    = _line_count > _scroll_offset ? _line_count - _scroll_offset : 0;
+    size_t top       = bottom > row_count ? bottom - row_count : 0;
+    for (size_t i = 0; i < row_count; i++) {
+        size_t index     = top + i;
+        const auto& text = index < bottom ? _lines[(_line_head + index) % _lines.size()] : _empty_line;
+        // Rows that kept their text are not laid out again
+        if (_row_texts[i] != text) {
+            _row_texts[i] = text;
+            _rows[i]->setText(text);
+        }
+    }
+}
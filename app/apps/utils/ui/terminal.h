@@ -0,0 +1,89 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <lvgl.h>
+#include <smooth_ui_toolkit.h>
+#include <smooth_lvgl.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ui {
+
+/**
+ * @brief Log view for byte streams, keeps a bounded ring of lines and only lays out the visible rows
+ *
+ */
+class Terminal {
+public:
+    enum Mode_t {
+        MODE_TEXT = 0,
+        MODE_HEX,
+    };
+
+    struct Config_t {
+        int16_t w         = 600;
+        int16_t h         = 333;
+        uint16_t maxLines = 512;
+        // Longer text lines are wrapped, also the width of a hex line
+        uint16_t maxColumns   = 56;
+        // Null for the 18 px UI font
+        const lv_font_t* font = nullptr;
+        uint32_t textColor    = 0xDEDEDE;
+        uint32_t bgColor      = 0x383838;
+    };
+
+    Config_t config;
+
+    void init(lv_obj_t* parent);
+    // Only goes into the line ring, the rows change on the next render()
+    void append(const uint8_t* data, size_t size);
+    void append(const std::string& text);
+    void clear();
+    void setMode(Mode_t mode);
+    void setTimestamp(bool enable);
+    // Call once per frame, does nothing without new lines or a scroll
+    void render();
+    inline smooth_ui_toolkit::lvgl_cpp::Container* get()
+    {
+        return _panel.get();
+    }
+    inline Mode_t getMode() const
+    {
+        return _mode;
+    }
+    inline bool isTimestampEnabled() const
+    {
+        return _timestamp;
+    }
+
+protected:
+    Mode_t _mode      = MODE_TEXT;
+    bool _timestamp   = false;
+    bool _is_dirty    = false;
+    bool _line_closed = true;
+    // Oldest line in the ring
+    size_t _line_head  = 0;
+    size_t _line_count = 0;
+    // Lines between the bottom row and the newest line, 0 follows the stream
+    size_t _scroll_offset     = 0;
+    int32_t _scroll_remainder = 0;
+    int32_t _line_height      = 0;
+    uint16_t _line_byte_count = 0;
+
+    std::vector<std::string> _lines;
+    std::vector<std::string> _row_texts;
+    std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _panel;
+    std::vector<std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Label>> _rows;
+
+    std::string& open_line();
+    void close_line();
+    void scroll(int32_t dy);
+    static void on_pressing(lv_event_t* e);
+};
+
+}  // namespace ui
@@ -4,12 +4,15 @@
  * SPDX-License-Identifier: MIT
  */
 #include "toast.h"
+#include "anim_clock.h"
 #include <hal/hal.h>
 #include <mooncake.h>
 #include <mooncake_log.h>
 #include <memory>
 #include <stdint.h>
-#include <queue>
+#include <deque>
+#include <mutex>
+#include <assets/font_engine.h>
 
 using namespace ui;
 using namespace smooth_ui_toolkit;
@@ -65,33 +68,66 @@ static ToastColor_t get_toast_color(toast_type::Type_t type)
 
 void Toast::init(lv_obj_t* parent)
 {
-    auto toast_color = get_toast_color(config.type);
-
     _toast = std::make_unique<Container>(parent);
     _toast->setBorderWidth(1);
-    _toast->setBorderColor(lv_color_hex(toast_color.border));
-    _toast->setBgColor(lv_color_hex(toast_color.bg));
     _toast->setRadius(24);
     _toast->setAlign(LV_ALIGN_TOP_MID);
     _toast->removeFlag(LV_OBJ_FLAG_SCROLLABLE);
     _toast->onClick().connect([&]() { close(); });
 
     _msg_label = std::make_unique<Label>(_toast->get());
-    _msg_label->setTextFont(&lv_font_montserrat_24);
-    _msg_label->setText(config.msg);
-    _msg_label->setTextColor(lv_color_hex(toast_color.msg));
+    _msg_label->setTextFont(assets::get_font(24));
     _msg_label->align(LV_ALIGN_CENTER, 0, 0);
-    if (_msg_label->getWidth() > 580) {
-        _msg_label->setWidth(580);
-        _msg_label->setLongMode(LV_LABEL_LONG_SCROLL_CIRCULAR);
-    }
 
     _anim_y.springOptions().visualDuration = 0.4;
     _anim_y.springOptions().bounce         = 0.3;
     _anim_w.springOptions().visualDuration = 0.4;
     _anim_w.springOptions().bounce         = 0.3;
 
+    apply_config();
     close(true);
+    _toast->addFlag(LV_OBJ_FLAG_HIDDEN);
+}
+
+void Toast::apply_config()
+{
+    auto toast_color = get_toast_color(config.type);
+    _toast->setBorderColor(lv_color_hex(toast_color.border));
+    _toast->setBgColor(lv_color_hex(toast_color.bg));
+    _msg_label->setTextColor(lv_color_hex(toast_color.msg));
+    _msg_label->setText(config.msg);
+
+    // Measured on the text, asking the label would force a layout pass per message
+    lv_point_t text_size;
+    lv_text_get_size(&text_size, config.msg.c_str(), assets::get_font(24), 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    if (text_size.x > 580) {
+        _msg_label->setWidth(580);
+        _msg_label->setLongMode(LV_LABEL_LONG_SCROLL_CIRCULAR);
+    } else {
+        _msg_label->setLongMode(LV_LABEL_LONG_WRAP);
+        _msg_label->setWidth(LV_SIZE_CONTENT);
+    }
+}
+
+void Toast::show(const Config_t& newConfig, uint32_t serial)
+{
+    config       = newConfig;
+    _serial      = serial;
+    _stack_depth = 0;
+    apply_config();
+
+    // Comes in from the top above the older ones
+    close(true);
+    _toast->removeFlag(LV_OBJ_FLAG_HIDDEN);
+    _toast->moveForeground();
+    open();
+}
+
+void Toast::refresh()
+{
+    if (_state == Opened) {
+        _time_count = GetHAL()->millis();
+    }
 }
 
 void Toast::update()
@@ -105,12 +141,13 @@ void Toast::update()
     }
 
     // Update state
-    if (_anim_y.done() && _anim_w.done()) {
+    if (!anim_clock::is_running(_anim_y, _anim_w)) {
         if (_state == Opening) {
             _state      = Opened;
             _time_count = GetHAL()->millis();
         } else if (_state == Closing) {
             _state = Closed;
+            _toast->addFlag(LV_OBJ_FLAG_HIDDEN);
         }
     }
 
@@ -133,13 +170,13 @@ void Toast::open(bool teleport)
     update_anim(_toast_kf_opened, teleport);
 }
 
-void Toast::stack(bool teleport)
+void Toast::stack(uint8_t depth, bool teleport)
 {
-    if (_state == Closing || _state == Closed) {
+    if (_state == Closing || _state == Closed || depth == _stack_depth) {
         return;
     }
 
-    _stack_depth++;
+    _stack_depth = depth;
 
     auto kf_stack = _toast_kf_opened;
     kf_stack.y += _stack_depth * (12 - _stack_depth * 2);
@@ -165,50 +202,107 @@ void Toast::update_anim(const KeyFrame_t& target, bool teleport)
 /* -------------------------------------------------------------------------- */
 /*                                Toast Manager                               */
 /* -------------------------------------------------------------------------- */
-static std::queue<Toast::Config_t> _toast_request_queue;
+// Filled from any task, drained by the manager once per frame
+static constexpr size_t _max_toast_requests = 5;
+static std::mutex _toast_request_mutex;
+static std::deque<Toast::Config_t> _toast_request_queue;
 static int _toast_manager_id = -1;
 
+static bool is_same_toast(const Toast::Config_t& a, const Toast::Config_t& b)
+{
+    return a.type == b.type && a.msg == b.msg;
+}
+
 void ToastManager::onCreate()
 {
     // 3 toasts max
     _toast_list.resize(3);
 }
 
+bool ToastManager::has_shown_toast() const
+{
+    for (const auto& toast : _toast_list) {
+        if (toast && toast->getState() != Toast::Closed) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ToastManager::restack()
+{
+    // Depth is the number of newer toasts on screen, each toast is moved once however many came in
+    for (auto& toast : _toast_list) {
+        if (!toast || !toast->isShown()) {
+            continue;
+        }
+        uint8_t depth = 0;
+        for (const auto& other : _toast_list) {
+            if (other && other->isShown() && other->getSerial() > toast->getSerial()) {
+                depth++;
+            }
+        }
+        toast->stack(depth);
+    }
+}
+
 void ToastManager::onRunning()
 {
+    std::deque<Toast::Config_t> requests;
+    {
+        std::lock_guard<std::mutex> lock(_toast_request_mutex);
+        requests.swap(_toast_request_queue);
+    }
+    if (requests.empty() && !has_shown_toast()) {
+        return;
+    }
+
     LvglLockGuard lock;
 
-    // Handle toast request
-    if (!_toast_request_queue.empty()) {
-        auto toast_request = _toast_request_queue.front();
-        _toast_request_queue.pop();
+    if (!_toast_list[0]) {
+        for (auto& toast : _toast_list) {
+            toast = std::make_unique<Toast>();
+            toast->init(lv_screen_active());
+        }
+    }
+
+    // Only the newest ones would still be on screen after this frame
+    while (requests.size() > _toast_list.size()) {
+        requests.pop_front();
+    }
 
-        // Stack current toast
+    // Handle toast request
+    bool is_stack_changed = false;
+    for (const auto& toast_request : requests) {
+        // Same message already up, it just stays longer
+        bool is_coalesced = false;
         for (auto& toast : _toast_list) {
-            if (toast) {
-                toast->stack();
+            if (toast->isShown() && is_same_toast(toast->config, toast_request)) {
+                toast->refresh();
+                is_coalesced = true;
+                break;
             }
         }
+        if (is_coalesced) {
+            continue;
+        }
 
-        // Create new toast
-        _toast_list[_current_toast_index]         = std::make_unique<Toast>();
-        _toast_list[_current_toast_index]->config = toast_request;
-        _toast_list[_current_toast_index]->init(lv_screen_active());
-        _toast_list[_current_toast_index]->open();
+        _toast_list[_current_toast_index]->show(toast_request, _next_serial++);
+        is_stack_changed = true;
 
         _current_toast_index++;
         if (_current_toast_index >= _toast_list.size()) {
             _current_toast_index = 0;
         }
     }
+    if (is_stack_changed) {
+        restack();
+    }
 
     // Update toast
     for (auto& toast : _toast_list) {
-        if (toast) {
+        if (toast->getState() != Toast::Closed) {
             toast->update();
-            if (toast->getState() == Toast::Closed) {
-                toast.reset();
-            }
         }
     }
 }
@@ -224,9 +318,17 @@ void ui::pop_a_toast(std::string msg, toast_type::Type_t type, uint32_t duration
         mclog::tagInfo(_tag, "create toast manager success");
     }
 
-    if (_toast_request_queue.size() >= 5) {
-        mclog::tagError(_tag, "toast request queue is full: {}", _toast_request_queue.size());
-        return;
+    std::lock_guard<std::mutex> lock(_toast_request_mutex);
+    Toast::Config_t request = {type, durationMs, std::move(msg)};
+    for (const auto& queued : _toast_request_queue) {
+        if (is_same_toast(queued, request)) {
+            return;
+        }
+    }
+    // In a burst the oldest message is the least interesting one
+    if (_toast_request_queue.size() >= _max_toast_requests) {
+        mclog::tagWarn(_tag, "toast request queue is full, dropped: {}", _toast_request_queue.front().msg);
+        _toast_request_queue.pop_front();
     }
-    _toast_request_queue.push({type, durationMs, msg});
+    _toast_request_queue.push_back(std::move(request));
 }
@@ -54,7 +54,20 @@ public:
     void update();
     void close(bool teleport = false);
     void open(bool teleport = false);
-    void stack(bool teleport = false);
+    // Pushes the toast down behind depth newer ones, 0 is the front
+    void stack(uint8_t depth, bool teleport = false);
+    // Reuses the widgets for a new message and opens it
+    void show(const Config_t& newConfig, uint32_t serial);
+    // Starts the display time over, for a repeated message
+    void refresh();
+    inline bool isShown() const
+    {
+        return _state == Opening || _state == Opened;
+    }
+    inline uint32_t getSerial() const
+    {
+        return _serial;
+    }
     inline smooth_ui_toolkit::lvgl_cpp::Container* get()
     {
         return _toast.get();
@@ -68,6 +81,7 @@ protected:
     uint32_t _time_count = 0;
     State_t _state       = Closed;
     uint8_t _stack_depth = 0;
+    uint32_t _serial     = 0;
 
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Container> _toast;
     std::unique_ptr<smooth_ui_toolkit::lvgl_cpp::Label> _msg_label;
@@ -76,6 +90,7 @@ protected:
     smooth_ui_toolkit::AnimateValue _anim_w;
 
     void update_anim(const KeyFrame_t& target, bool teleport);
+    void apply_config();
 };
 
 class ToastManager : public mooncake::BasicAbility {
@@ -85,7 +100,12 @@ public:
 
 protected:
     int _current_toast_index = 0;
+    uint32_t _next_serial    = 1;
+    // Widgets are built once and recycled, a closed toast is only hidden
     std::vector<std::unique_ptr<Toast>> _toast_list;
+
+    bool has_shown_toast() const;
+    void restack();
 };
 
 void pop_a_toast(std::string msg, toast_type::Type_t type = toast_type::info, uint32_t durationMs = 1600);
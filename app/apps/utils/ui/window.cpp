@@ -4,11 +4,14 @@
  * SPDX-License-Identifier: MIT
  */
 #include "window.h"
+#include "anim_clock.h"
 #include <lvgl.h>
 #include <hal/hal.h>
 #include <smooth_ui_toolkit.h>
 #include <smooth_lvgl.h>
 #include <apps/utils/audio/audio.h>
+#include <algorithm>
+#include <assets/font_engine.h>
 
 using namespace ui;
 using namespace smooth_ui_toolkit;
@@ -21,6 +24,11 @@ smooth_ui_toolkit::Signal<bool>& ui::signal_window_opened()
     return _signal_window_opened;
 }
 
+Window::~Window()
+{
+    end_snapshot_anim();
+}
+
 void Window::init(lv_obj_t* parent)
 {
     _window = std::make_unique<Container>(parent);
@@ -35,7 +43,7 @@ void Window::init(lv_obj_t* parent)
         _title_label = std::make_unique<Label>(_window->get());
         _title_label->align(LV_ALIGN_TOP_MID, 0, 15);
         _title_label->setTextColor(lv_color_hex(config.titleColor));
-        _title_label->setTextFont(&lv_font_montserrat_18);
+        _title_label->setTextFont(assets::get_font(18));
         _title_label->setText(config.title);
         _title_label->removeFlag(LV_OBJ_FLAG_CLICKABLE);
     }
@@ -90,23 +98,28 @@ void Window::init(lv_obj_t* parent)
 void Window::update()
 {
     // Apply animation
-    if (!(_anim_x.done() && _anim_y.done())) {
-        _window->setPos(_anim_x, _anim_y);
-    }
-    if (!(_anim_w.done() && _anim_h.done())) {
-        _window->setSize(_anim_w, _anim_h);
-    }
-    if (!_anim_opa.done()) {
-        _window->setOpa(_anim_opa);
+    if (_snapshot_img) {
+        apply_anim_frame();
+    } else {
+        if (!(_anim_x.done() && _anim_y.done())) {
+            _window->setPos(_anim_x, _anim_y);
+        }
+        if (!(_anim_w.done() && _anim_h.done())) {
+            _window->setSize(_anim_w, _anim_h);
+        }
+        if (!_anim_opa.done()) {
+            _window->setOpa(_anim_opa);
+        }
     }
 
     // Update state
-    if (_anim_x.done() && _anim_y.done() && _anim_w.done() && _anim_h.done() && _anim_opa.done()) {
+    if (!anim_clock::is_running(_anim_x, _anim_y, _anim_w, _anim_h, _anim_opa)) {
         if (_state == Opening) {
             _state = Opened;
         } else if (_state == Closing) {
             _state = Closed;
         }
+        end_snapshot_anim();
     }
 
     onUpdate();
@@ -124,10 +137,18 @@ void Window::close(bool teleport, bool triggerCallback)
     }
     _window->removeFlag(LV_OBJ_FLAG_CLICKABLE);
 
+    // Captured before onClose() tears the content down
+    if (teleport) {
+        end_snapshot_anim();
+    } else {
+        begin_snapshot_anim();
+    }
+
     _anim_opa.easingOptions().duration = 0.8;
     update_anim(config.kfClosed, teleport);
 
     signal_window_opened().emit(false);
+    GetHAL()->setPowerProfileWindow("");
 
     if (triggerCallback) {
         onClose();
@@ -150,10 +171,19 @@ void Window::open(bool teleport, bool triggerCallback)
     update_anim(config.kfOpened, teleport);
 
     signal_window_opened().emit(true);
+    GetHAL()->setPowerProfileWindow(config.title);
+
+    // A snapshot left from closing shows the old content
+    end_snapshot_anim();
 
     if (triggerCallback) {
         onOpen();
     }
+
+    // Captured after onOpen() has built the content
+    if (!teleport) {
+        begin_snapshot_anim();
+    }
 }
 
 void Window::update_anim(const KeyFrame_t& target, bool teleport)
@@ -176,3 +206,79 @@ void Window::update_anim(const KeyFrame_t& target, bool teleport)
         _anim_opa = target.opa;
     }
 }
+
+void Window::apply_anim_frame()
+{
+    if (_snapshot_img == nullptr) {
+        _window->setPos(_anim_x, _anim_y);
+        _window->setSize(_anim_w, _anim_h);
+        _window->setOpa(_anim_opa);
+        return;
+    }
+
+    // Size is a scale on the bitmap, it was captured at the opened size
+    int32_t w = std::max(static_cast<int32_t>(_anim_w), (int32_t)0);
+    int32_t h = std::max(static_cast<int32_t>(_anim_h), (int32_t)0);
+    lv_obj_set_pos(_snapshot_img, _anim_x, _anim_y);
+    lv_image_set_scale_x(_snapshot_img, w * LV_SCALE_NONE / std::max(config.kfOpened.w, (int16_t)1));
+    lv_image_set_scale_y(_snapshot_img, h * LV_SCALE_NONE / std::max(config.kfOpened.h, (int16_t)1));
+    lv_obj_set_style_opa(_snapshot_img, _anim_opa, LV_PART_MAIN);
+}
+
+bool Window::begin_snapshot_anim()
+{
+#if LV_USE_SNAPSHOT
+    if (!config.snapshotAnim) {
+        return false;
+    }
+    // Closed while still opening, the bitmap is still good
+    if (_snapshot_img) {
+        return true;
+    }
+
+    // Rendered once at the opened size, where the content is laid out for good
+    _window->setPos(config.kfOpened.x, config.kfOpened.y);
+    _window->setSize(config.kfOpened.w, config.kfOpened.h);
+    _window->setOpa(255);
+    lv_obj_update_layout(_window->get());
+
+    // Large enough to land in PSRAM
+    _snapshot = lv_snapshot_take(_window->get(), LV_COLOR_FORMAT_ARGB8888);
+    if (_snapshot == nullptr) {
+        // No memory for it, the live widgets animate instead
+        apply_anim_frame();
+        return false;
+    }
+
+    _snapshot_img = lv_image_create(lv_obj_get_parent(_window->get()));
+    lv_image_set_src(_snapshot_img, _snapshot);
+    lv_obj_set_align(_snapshot_img, LV_ALIGN_CENTER);
+    lv_obj_remove_flag(_snapshot_img, LV_OBJ_FLAG_CLICKABLE);
+    _window->addFlag(LV_OBJ_FLAG_HIDDEN);
+    if (_close_btn) {
+        _close_btn->moveForeground();
+    }
+
+    apply_anim_frame();
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Window::end_snapshot_anim()
+{
+    if (_snapshot_img == nullptr) {
+        return;
+    }
+
+    lv_obj_delete(_snapshot_img);
+    _snapshot_img = nullptr;
+    lv_image_cache_drop(_snapshot);
+    lv_draw_buf_destroy(_snapshot);
+    _snapshot = nullptr;
+
+    // Back to the live widgets where the animation is now
+    apply_anim_frame();
+    _window->removeFlag(LV_OBJ_FLAG_HIDDEN);
+}
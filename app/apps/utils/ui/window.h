@@ -15,9 +15,7 @@ namespace ui {
 
 class Window {
 public:
-    virtual ~Window()
-    {
-    }
+    virtual ~Window();
 
     enum State_t {
         Closed,
@@ -44,6 +42,8 @@ public:
         uint32_t closeDotColor = 0xFF5F57;
         uint32_t borderColor   = 0x000000;
         uint32_t bgColor       = 0x232323;
+        // Animate a bitmap of the opened window instead of the live widgets, for windows with heavy content
+        bool snapshotAnim = false;
     };
 
     Config_t config;
@@ -89,7 +89,14 @@ protected:
 
     State_t _state = Closed;
 
+    // Stands in for the hidden window while a snapshot animation runs
+    lv_draw_buf_t* _snapshot = nullptr;
+    lv_obj_t* _snapshot_img  = nullptr;
+
     void update_anim(const KeyFrame_t& target, bool teleport);
+    void apply_anim_frame();
+    bool begin_snapshot_anim();
+    void end_snapshot_anim();
 };
 
 /**
@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "font_engine.h"
+#include <hal/hal.h>
+#include <mooncake_log.h>
+#include <apps/utils/background/jobs.h>
+#include <string>
+#include <vector>
+
+static const std::string _tag = "font-engine";
+
+static const char* _ttf_asset_name = "Montserrat-Medium.ttf";
+// Glyphs cached per size, the printable ASCII of a size fits with room for the odd symbol
+static constexpr size_t _glyph_cache_count = 160;
+// Sizes the UI uses, the ones prewarm_fonts() rasterizes
+static constexpr int32_t _prewarm_sizes[] = {16, 18, 20, 22, 24, 28, 36};
+// Glyphs rasterized per LVGL lock, a few ms at the larger sizes
+static constexpr uint32_t _prewarm_slice = 16;
+
+struct Font_t {
+    int32_t size    = 0;
+    lv_font_t* font = nullptr;
+};
+
+struct FontEngineData_t {
+    // Only touched with the LVGL lock held
+    std::vector<Font_t> fonts;
+    hal::HalBase::Asset_t ttf;
+    bool isMissingLogged = false;
+};
+static FontEngineData_t _font_engine_data;
+
+static const lv_font_t* get_builtin_font(int32_t size)
+{
+    switch (size) {
+#if LV_FONT_MONTSERRAT_16
+        case 16:
+            return &lv_font_montserrat_16;
+#endif
+#if LV_FONT_MONTSERRAT_18
+        case 18:
+            return &lv_font_montserrat_18;
+#endif
+#if LV_FONT_MONTSERRAT_20
+        case 20:
+            return &lv_font_montserrat_20;
+#endif
+#if LV_FONT_MONTSERRAT_22
+        case 22:
+            return &lv_font_montserrat_22;
+#endif
+#if LV_FONT_MONTSERRAT_24
+        case 24:
+            return &lv_font_montserrat_24;
+#endif
+#if LV_FONT_MONTSERRAT_28
+        case 28:
+            return &lv_font_montserrat_28;
+#endif
+#if LV_FONT_MONTSERRAT_36
+        case 36:
+            return &lv_font_montserrat_36;
+#endif
+        default:
+            return LV_FONT_DEFAULT;
+    }
+}
+
+// The pack is mapped by a boot stage, so the lookup is tried again until the TTF shows up
+static bool load_ttf()
+{
+    auto& data = _font_engine_data;
+    if (data.ttf.data != nullptr) {
+        return true;
+    }
+#if LV_USE_TINY_TTF
+    if (GetHAL()->getAsset(_ttf_asset_name, data.ttf)) {
+        mclog::tagInfo(_tag, "{} from the asset pack, {} KB", _ttf_asset_name, data.ttf.size / 1024);
+        return true;
+    }
+#endif
+    if (!data.isMissingLogged) {
+        data.isMissingLogged = true;
+        mclog::tagWarn(_tag, "no {}, using the baked fonts", _ttf_asset_name);
+    }
+    return false;
+}
+
+const lv_font_t* assets::get_font(int32_t size)
+{
+    auto& data = _font_engine_data;
+    for (const auto& font : data.fonts) {
+        if (font.size == size) {
+            return font.font;
+        }
+    }
+    if (!load_ttf()) {
+        return get_builtin_font(size);
+    }
+
+#if LV_USE_TINY_TTF
+    // Rasterized straight from the mapped flash, the TTF is never copied
+    lv_font_t* font = lv_tiny_ttf_create_data_ex(data.ttf.data, data.ttf.size, size, LV_FONT_KERNING_NORMAL,
+                                                 _glyph_cache_count);
+    if (font == nullptr) {
+        mclog::tagError(_tag, "create {} px failed", size);
+        return get_builtin_font(size);
+    }
+    // Symbols are not in the TTF, they come from the default font
+    font->fallback = LV_FONT_DEFAULT;
+    data.fonts.push_back({size, font});
+    return font;
+#else
+    return get_builtin_font(size);
+#endif
+}
+
+// Returns false once every glyph of the size is cached
+static bool prewarm_slice(int32_t size, uint32_t& letter)
+{
+    LvglLockGuard lock("font prewarm");
+    const lv_font_t* font = assets::get_font(size);
+    for (uint32_t end = letter + _prewarm_slice; letter < end; letter++) {
+        if (letter > '~') {
+            return false;
+        }
+        lv_font_glyph_dsc_t glyph;
+        if (!lv_font_get_glyph_dsc(font, &glyph, letter, 0) || glyph.resolved_font != font) {
+            continue;
+        }
+        // The tiny_ttf cache keeps the bitmap once its entry is released
+        lv_font_get_glyph_bitmap(&glyph, nullptr);
+        lv_font_glyph_release_draw_data(&glyph);
+    }
+    return true;
+}
+
+void assets::prewarm_fonts()
+{
+    {
+        LvglLockGuard lock("font prewarm");
+        if (!load_ttf()) {
+            return;
+        }
+    }
+
+    bool is_queued = background::run_job([]() {
+        uint32_t start = GetHAL()->millis();
+        for (int32_t size : _prewarm_sizes) {
+            uint32_t letter = ' ';
+            while (prewarm_slice(size, letter)) {
+            }
+        }
+        mclog::tagInfo(_tag, "prewarmed {} sizes in {} ms", sizeof(_prewarm_sizes) / sizeof(_prewarm_sizes[0]),
+                       GetHAL()->millis() - start);
+    });
+    if (!is_queued) {
+        mclog::tagWarn(_tag, "job pool full, glyphs are rasterized on their first draw");
+    }
+}
@@ -0,0 +1,34 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <lvgl.h>
+#include <cstdint>
+
+/**
+ * @brief UI fonts by pixel size, rasterized at runtime from the Montserrat TTF in the asset pack. Each size is one
+ * tiny_ttf font with its own glyph cache, so after the first draw of a glyph the text renders from the cache like a
+ * baked font. Without the TTF, e.g. an old pack or with tiny_ttf disabled, the baked font of the size is used if it
+ * is compiled in, the default font otherwise
+ *
+ */
+namespace assets {
+
+/**
+ * @brief Font for a pixel size, created on the first request and kept. Call with the LVGL lock held
+ *
+ * @param size
+ * @return never null
+ */
+const lv_font_t* get_font(int32_t size);
+
+/**
+ * @brief Rasterize the printable ASCII of the sizes the UI uses on the job pool, ahead of their first draw. The LVGL
+ * lock is taken in short slices, so a running animation keeps its frame rate
+ *
+ */
+void prewarm_fonts();
+
+}  // namespace assets
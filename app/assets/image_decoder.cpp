@@ -0,0 +1,256 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "image_decoder.h"
+#include <hal/hal.h>
+#include <mooncake_log.h>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+static const std::string _tag = "image-decoder";
+
+// Same layout as LVGL's compressed image header, method in the low 4 bits of the first word
+static constexpr uint32_t _compressed_header_size = 12;
+static constexpr uint32_t _compress_method_rle    = 1;
+// USER1 tells these apart from images LVGL's own bin decoder is meant to handle
+static constexpr uint32_t _image_flags = LV_IMAGE_FLAGS_COMPRESSED | LV_IMAGE_FLAGS_USER1;
+
+struct DecodedImage_t {
+    const lv_image_dsc_t* src = nullptr;
+    // Null when the decode failed, so a broken image is not decoded again on every draw
+    lv_draw_buf_t* buffer = nullptr;
+};
+
+struct ImageDecoderData_t {
+    // Draw units may open images from their own threads
+    std::mutex mutex;
+    std::vector<DecodedImage_t> images;
+    lv_image_decoder_t* decoder = nullptr;
+};
+static ImageDecoderData_t _image_decoder_data;
+
+static bool is_compressed_image(const lv_image_dsc_t* image)
+{
+    return image != nullptr && image->header.magic == LV_IMAGE_HEADER_MAGIC &&
+           (image->header.flags & _image_flags) == _image_flags;
+}
+
+// Bytes per pixel and RLE block size, 0 for formats the compressor does not produce
+static uint32_t get_block_size(lv_color_format_t cf)
+{
+    switch (cf) {
+        case LV_COLOR_FORMAT_L8:
+        case LV_COLOR_FORMAT_A8:
+            return 1;
+        case LV_COLOR_FORMAT_RGB565:
+            return 2;
+        case LV_COLOR_FORMAT_RGB888:
+            return 3;
+        case LV_COLOR_FORMAT_ARGB8888:
+        case LV_COLOR_FORMAT_XRGB8888:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+// Control byte with bit 7 set: N literal blocks follow, clear: one block repeated N times
+static bool rle_decode(const uint8_t* in, uint32_t inSize, uint8_t* out, uint32_t outSize, uint32_t blockSize)
+{
+    const uint8_t* in_end = in + inSize;
+    uint8_t* out_end      = out + outSize;
+
+    while (in < in_end) {
+        uint8_t ctrl   = *in++;
+        uint32_t bytes = (ctrl & 0x7F) * blockSize;
+        if ((uint32_t)(out_end - out) < bytes) {
+            return false;
+        }
+
+        if (ctrl & 0x80) {
+            if ((uint32_t)(in_end - in) < bytes) {
+                return false;
+            }
+            memcpy(out, in, bytes);
+            in += bytes;
+        } else {
+            if ((uint32_t)(in_end - in) < blockSize) {
+                return false;
+            }
+            // Long runs of background color, the written part is copied onto itself in doubling chunks
+            if (bytes > 0) {
+                memcpy(out, in, blockSize);
+                for (uint32_t done = blockSize; done < bytes;) {
+                    uint32_t chunk = std::min(done, bytes - done);
+                    memcpy(out + done, out, chunk);
+                    done += chunk;
+                }
+            }
+            in += blockSize;
+        }
+        out += bytes;
+    }
+    return out == out_end;
+}
+
+static lv_draw_buf_t* decode_image(const lv_image_dsc_t* src)
+{
+    uint32_t start_time = lv_tick_get();
+
+    uint32_t method            = 0;
+    uint32_t compressed_size   = 0;
+    uint32_t decompressed_size = 0;
+    if (src->data_size < _compressed_header_size) {
+        return nullptr;
+    }
+    memcpy(&method, src->data, 4);
+    memcpy(&compressed_size, src->data + 4, 4);
+    memcpy(&decompressed_size, src->data + 8, 4);
+
+    auto cf             = static_cast<lv_color_format_t>(src->header.cf);
+    uint32_t block_size = get_block_size(cf);
+    uint32_t row_size   = src->header.w * block_size;
+    if ((method & 0xF) != _compress_method_rle || compressed_size != src->data_size - _compressed_header_size ||
+        block_size == 0 || decompressed_size != row_size * src->header.h) {
+        mclog::tagError(_tag, "bad header on {}x{} image", src->header.w, src->header.h);
+        return nullptr;
+    }
+
+    // Allocated through LVGL, which is PSRAM on the device. The image handlers keep it out of the port's layer pool
+    lv_draw_buf_t* buffer =
+        lv_draw_buf_create_ex(lv_draw_buf_get_image_handlers(), src->header.w, src->header.h, cf, LV_STRIDE_AUTO);
+    if (buffer == nullptr) {
+        mclog::tagError(_tag, "no memory for {}x{} image", src->header.w, src->header.h);
+        return nullptr;
+    }
+    if (!rle_decode(src->data + _compressed_header_size, compressed_size, buffer->data, decompressed_size,
+                    block_size)) {
+        mclog::tagError(_tag, "corrupt stream in {}x{} image", src->header.w, src->header.h);
+        lv_draw_buf_destroy(buffer);
+        return nullptr;
+    }
+
+    // Decoded packed, rows are spread out to an aligned stride from the last one back
+    uint32_t stride = buffer->header.stride;
+    if (stride != row_size) {
+        for (uint32_t y = src->header.h - 1; y > 0; y--) {
+            memmove(buffer->data + y * stride, buffer->data + y * row_size, row_size);
+        }
+    }
+
+    mclog::tagInfo(_tag, "{}x{} image decoded from {} bytes in {} ms", src->header.w, src->header.h,
+                   compressed_size, lv_tick_elaps(start_time));
+    return buffer;
+}
+
+static lv_draw_buf_t* get_decoded(const lv_image_dsc_t* src)
+{
+    std::lock_guard<std::mutex> lock(_image_decoder_data.mutex);
+
+    auto& images = _image_decoder_data.images;
+    auto it      = std::find_if(images.begin(), images.end(), [src](const DecodedImage_t& image) {
+        return image.src == src;
+    });
+    if (it != images.end()) {
+        return it->buffer;
+    }
+
+    DecodedImage_t image;
+    image.src    = src;
+    image.buffer = decode_image(src);
+    images.push_back(image);
+    return image.buffer;
+}
+
+static lv_result_t decoder_info(lv_image_decoder_t* decoder, lv_image_decoder_dsc_t* dsc, lv_image_header_t* header)
+{
+    if (dsc->src_type != LV_IMAGE_SRC_VARIABLE) {
+        return LV_RESULT_INVALID;
+    }
+    auto image = static_cast<const lv_image_dsc_t*>(dsc->src);
+    if (!is_compressed_image(image)) {
+        return LV_RESULT_INVALID;
+    }
+
+    // What the draw units get is a plain image
+    *header        = image->header;
+    header->flags  = image->header.flags & ~_image_flags;
+    header->stride = lv_draw_buf_width_to_stride(image->header.w, static_cast<lv_color_format_t>(image->header.cf));
+    return LV_RESULT_OK;
+}
+
+static lv_result_t decoder_open(lv_image_decoder_t* decoder, lv_image_decoder_dsc_t* dsc)
+{
+    lv_draw_buf_t* buffer = get_decoded(static_cast<const lv_image_dsc_t*>(dsc->src));
+    if (buffer == nullptr) {
+        return LV_RESULT_INVALID;
+    }
+    dsc->decoded = buffer;
+    return LV_RESULT_OK;
+}
+
+static void decoder_close(lv_image_decoder_t* decoder, lv_image_decoder_dsc_t* dsc)
+{
+    // The buffer stays for the next draw, it goes in release_image()
+}
+
+void assets::init_image_decoder()
+{
+    LvglLockGuard lock;
+
+    if (_image_decoder_data.decoder != nullptr) {
+        return;
+    }
+    // New decoders go to the head of the list, ahead of the bin decoder
+    _image_decoder_data.decoder = lv_image_decoder_create();
+    lv_image_decoder_set_info_cb(_image_decoder_data.decoder, decoder_info);
+    lv_image_decoder_set_open_cb(_image_decoder_data.decoder, decoder_open);
+    lv_image_decoder_set_close_cb(_image_decoder_data.decoder, decoder_close);
+}
+
+bool assets::preload_image(const lv_image_dsc_t* src)
+{
+    if (!is_compressed_image(src)) {
+        return src != nullptr;
+    }
+    // LVGL's allocator wants the lock, taken ahead of the decoder mutex as on the draw path
+    LvglLockGuard lock;
+    return get_decoded(src) != nullptr;
+}
+
+const lv_image_dsc_t* assets::get_cached_image(const lv_image_dsc_t* src)
+{
+    if (!is_compressed_image(src)) {
+        return src;
+    }
+    // A draw buffer starts with the same fields as an image descriptor, LVGL takes one as an image source. Its flags
+    // carry neither the compressed nor the premultiplied bit, and its rows are aligned to the draw buffer alignment
+    lv_draw_buf_t* buffer = get_decoded(src);
+    if (buffer == nullptr) {
+        return src;
+    }
+    return reinterpret_cast<const lv_image_dsc_t*>(buffer);
+}
+
+// Under the LVGL lock, as the objects that showed the image are deleted
+void assets::release_image(const lv_image_dsc_t* src)
+{
+    std::lock_guard<std::mutex> lock(_image_decoder_data.mutex);
+
+    auto& images = _image_decoder_data.images;
+    auto it      = std::find_if(images.begin(), images.end(), [src](const DecodedImage_t& image) {
+        return image.src == src;
+    });
+    if (it == images.end()) {
+        return;
+    }
+    if (it->buffer != nullptr) {
+        lv_draw_buf_destroy(it->buffer);
+    }
+    images.erase(it);
+}
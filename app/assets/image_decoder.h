@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <lvgl.h>
+
+/**
+ * @brief Decoder for the RLE compressed images from tools/compress_image.py. An image is decoded on its first draw
+ * into a draw buffer that stays until released, so later draws cost the same as a raw C array
+ *
+ */
+namespace assets {
+
+/**
+ * @brief Register the decoder with LVGL, call once after LVGL is up and before the first compressed image is drawn
+ *
+ */
+void init_image_decoder();
+
+/**
+ * @brief Decode ahead of the first draw, e.g. while a screen that does not use the image is shown. Takes the LVGL
+ * lock
+ *
+ * @param src
+ * @return true if the image is ready
+ */
+bool preload_image(const lv_image_dsc_t* src);
+
+/**
+ * @brief Decode once and get the result as a plain image, to be used as the source in place of the compressed one.
+ * Draw units that only take plain images, like the PPA blit, can then copy from it, so a redrawn area of a full
+ * screen background is a rectangle copy instead of a SW blend. The image stays until release_image(src). Call with the
+ * LVGL lock held
+ *
+ * @param src
+ * @return the decoded image, or src itself if it is not compressed or failed to decode
+ */
+const lv_image_dsc_t* get_cached_image(const lv_image_dsc_t* src);
+
+/**
+ * @brief Free the decoded buffer of an image, only once no object shows it. A later draw decodes it again. Call with
+ * the LVGL lock held
+ *
+ * @param src
+ */
+void release_image(const lv_image_dsc_t* src);
+
+}  // namespace assets
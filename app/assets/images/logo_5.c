@@ -21,94 +21,85 @@
 #define LV_ATTRIBUTE_IMAGE_LOGO_5
 #endif
 
+// RLE compressed by app/assets/tools/compress_image.py, 9600 bytes raw
 const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMAGE_LOGO_5 uint8_t logo_5_map[] = {
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0x9f, 0xcf, 0x9f, 0xc7, 0xbf, 0xc7, 0xbf, 0xcf, 0xdf, 0xcf, 0xdf, 0xcf, 0xdf, 0xcf, 0xdf, 0xcf, 0xdf, 0xcf, 0xdf, 0xcf, 0xdf, 0xcf, 0xdf, 0xcf, 0xff, 0xd7, 0xff, 0xd7, 0xff, 0xd7, 0xff, 0xd7, 0xff, 0xd7, 0xff, 0xd7, 0xff, 0xd7, 0xff, 0xd7, 0xff, 0xd7, 0xff, 0xd7, 0xff, 0xd7, 0xdf, 0xd7, 0xdf, 0xcf, 0xdf, 0xcf, 0xdf, 0xcf, 0xdf, 0xcf, 0xdf, 0xcf, 0xdf, 0xcf, 0xdf, 0xcf, 0xbf, 0xcf, 0xbf, 0xc7, 0xbf, 0xc7, 0x7f, 0xd7, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xd7, 0x16, 0x34, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x38, 0x24, 0x38, 0x24, 0x38, 0x24, 0x38, 0x24, 0x38, 0x24, 0x58, 0x1c, 0x58, 0x1c, 0x38, 0x24, 0x38, 0x24, 0x58, 0x1c, 0x58, 0x1c, 0x38, 0x24, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x37, 0x24, 0x38, 0x24, 0x58, 0x1c, 0x38, 0x24, 0x14, 0x3c, 0x5f, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xbf, 0x58, 0x1c, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7a, 0x0c, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0x9a, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0x7a, 0x0c, 0x9c, 0x04, 0x7a, 0x0c, 0x36, 0x2c, 0xbf, 0xc7, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0x3f, 0xb7, 0x58, 0x1c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0x7b, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0x16, 0x2c, 0xff, 0xcf, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xdf, 0xa6, 0x58, 0x1c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0x7b, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0x16, 0x2c, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x9e, 0x96, 0x58, 0x1c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0x9a, 0x04, 0xbc, 0x04, 0x7a, 0x0c, 0x35, 0x34, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x3d, 0x86, 0x59, 0x14, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0x9a, 0x04, 0xbc, 0x04, 0x7a, 0x0c, 0x36, 0x34, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xfc, 0x7d, 0x59, 0x14, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0x9a, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0x9a, 0x04, 0xbc, 0x04, 0x7a, 0x0c, 0x56, 0x3c, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x9b, 0x6d, 0x59, 0x14, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0x79, 0x0c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x79, 0x0c, 0x58, 0x1c, 0x55, 0x4c, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x5a, 0x5d, 0x79, 0x14, 0x9b, 0x04, 0x7b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x79, 0x14, 0x3f, 0x66, 0xbf, 0xbf, 0x9f, 0xc7, 0xbf, 0xc7, 0xbf, 0xc7, 0xbf, 0xcf, 0xbf, 0xc7, 0x9f, 0xc7, 0x9f, 0xc7, 0x9f, 0xc7, 0x7f, 0xbf, 0x7f, 0xbf, 0x5f, 0xbf, 0x5f, 0xb7, 0x5f, 0xb7, 0x3f, 0xb7, 0x3f, 0xb7, 0x3f, 0xaf, 0x1f, 0xaf, 0xff, 0xa6, 0xde, 0x9e, 0xbf, 0x96, 0x7d, 0x96, 0x3b, 0xa6, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0xf9, 0x4c, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9a, 0x04, 0x58, 0x1c, 0xff, 0x96, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xff, 0xf7, 0xff, 0xf7, 0xff, 0xf7, 0xff, 0xf7, 0xff, 0xf7, 0xff, 0xf7, 0xff, 0xf7, 0xff, 0xf7, 0xff, 0xef, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x98, 0x3c, 0x7a, 0x0c, 0x9c, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0x57, 0x24, 0x5f, 0xaf, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0x56, 0x2c, 0x7a, 0x0c, 0x9c, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x7a, 0x04, 0x37, 0x24, 0xbf, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd7, 0x36, 0x24, 0x7a, 0x0c, 0x9c, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0x37, 0x24, 0xff, 0xcf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc7, 0x37, 0x24, 0x7a, 0x0c, 0x9c, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0x36, 0x2c, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xb7, 0x37, 0x24, 0x7a, 0x0c, 0x9c, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0x77, 0x3c, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0x3f, 0xa7, 0x58, 0x1c, 0x7a, 0x0c, 0x9c, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0xf9, 0x4c, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xdf, 0x96, 0x58, 0x1c, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x79, 0x14, 0x3a, 0x5d, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0x7e, 0x86, 0x58, 0x1c, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x59, 0x14, 0xbb, 0x6d, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x1d, 0x76, 0x59, 0x14, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x59, 0x14, 0xfc, 0x7d, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xbc, 0x65, 0x79, 0x14, 0x9a, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x59, 0x14, 0x5e, 0x8e, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x5b, 0x55, 0x79, 0x14, 0x9a, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x58, 0x1c, 0xdf, 0x9e, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xfa, 0x44, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x79, 0x14, 0x5f, 0x9f, 0xff, 0xdf, 0xff, 0xe7, 0xff, 0xdf, 0xdf, 0xcf, 0x9f, 0xc7, 0xbf, 0xcf, 0xdf, 0xcf, 0xff, 0xd7, 0xff, 0xe7, 0xff, 0xe7, 0xff, 0xef, 0xff, 0xef, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xb9, 0x34, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0x1b, 0x2d, 0xb9, 0x2c, 0x58, 0x24, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x57, 0x24, 0x57, 0x24, 0xb9, 0x34, 0x3a, 0x4d, 0xfc, 0x6d, 0xdf, 0x96, 0xbf, 0xc7, 0xff, 0xe7, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x58, 0x24, 0x7a, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x7a, 0x0c, 0x7a, 0x0c, 0x9a, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9a, 0x04, 0x7a, 0x0c, 0x7a, 0x0c, 0x79, 0x0c, 0x58, 0x14, 0x58, 0x1c, 0x37, 0x24, 0xb8, 0x44, 0xfc, 0x7d, 0x7f, 0xbf, 0xff, 0xef, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd7, 0x37, 0x24, 0x7a, 0x0c, 0x7b, 0x04, 0x7b, 0x04, 0x7a, 0x0c, 0x7a, 0x0c, 0x7b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9a, 0x04, 0x9a, 0x04, 0x9b, 0x0c, 0x9a, 0x04, 0x9a, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9a, 0x04, 0x7a, 0x0c, 0x7a, 0x0c, 0x79, 0x14, 0x58, 0x1c, 0x3a, 0x55, 0x7f, 0xb7, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xc7, 0x58, 0x1c, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x9c, 0x04, 0x9c, 0x04, 0x9b, 0x04, 0x9a, 0x04, 0x79, 0x14, 0x37, 0x24, 0xbb, 0x75, 0xff, 0xdf, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0x5f, 0xb7, 0x58, 0x1c, 0x9b, 0x04, 0x9c, 0x04, 0x9c, 0x04, 0x9c, 0x04, 0x9c, 0x04, 0x9c, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x9c, 0x04, 0x9c, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x7a, 0x0c, 0x59, 0x14, 0xf9, 0x44, 0xff, 0xd7, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xff, 0xa6, 0x58, 0x1c, 0x7a, 0x0c, 0x7a, 0x0c, 0x7a, 0x0c, 0x7a, 0x0c, 0x7a, 0x0c, 0x7a, 0x0c, 0x7a, 0x0c, 0x79, 0x14, 0x79, 0x14, 0x79, 0x14, 0x79, 0x14, 0x79, 0x14, 0x79, 0x14, 0x79, 0x0c, 0x7a, 0x0c, 0x7a, 0x0c, 0x7a, 0x0c, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9a, 0x04, 0x7a, 0x0c, 0x9a, 0x04, 0x9a, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x79, 0x14, 0xd8, 0x4c, 0xff, 0xdf, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0x7d, 0x9e, 0x36, 0x2c, 0x58, 0x1c, 0x57, 0x24, 0x37, 0x24, 0x36, 0x2c, 0x97, 0x3c, 0xd8, 0x4c, 0x39, 0x55, 0x7a, 0x65, 0x9b, 0x6d, 0xbb, 0x6d, 0xbb, 0x6d, 0x9b, 0x6d, 0x7b, 0x65, 0x39, 0x55, 0xb8, 0x44, 0x37, 0x2c, 0x57, 0x24, 0x59, 0x1c, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0x58, 0x1c, 0x9b, 0x65, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xdd, 0xb6, 0x1c, 0x86, 0xdf, 0x96, 0x5f, 0xaf, 0xdf, 0xc7, 0xff, 0xdf, 0xff, 0xdf, 0xff, 0xe7, 0xff, 0xe7, 0xff, 0xe7, 0xff, 0xef, 0xff, 0xef, 0xff, 0xef, 0xff, 0xef, 0xff, 0xe7, 0xff, 0xe7, 0xff, 0xe7, 0xff, 0xd7, 0x9f, 0xb7, 0x5e, 0x7e, 0xd9, 0x3c, 0x58, 0x1c, 0x7a, 0x0c, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x58, 0x1c, 0x1f, 0xb7, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xff, 0xf7, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xff, 0xf7, 0xff, 0xe7, 0xff, 0xa6, 0xb8, 0x3c, 0x59, 0x14, 0x9b, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x79, 0x0c, 0xf8, 0x54, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xff, 0xcf, 0x3a, 0x4d, 0x59, 0x14, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9a, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0x37, 0x24, 0x7f, 0xb7, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xff, 0xd7, 0xb8, 0x44, 0x7a, 0x0c, 0x9c, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x59, 0x1c, 0xfd, 0x75, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xff, 0xa6, 0x58, 0x1c, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0xf9, 0x44, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x98, 0x34, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9a, 0x04, 0x58, 0x24, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x9b, 0x5d, 0x79, 0x14, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x58, 0x1c, 0xbf, 0xcf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xfd, 0x6d, 0x79, 0x14, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x58, 0x1c, 0x7f, 0xc7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xfd, 0x6d, 0x79, 0x14, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x58, 0x1c, 0x9f, 0xc7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7b, 0x55, 0x79, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x58, 0x1c, 0xdf, 0xcf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x78, 0x2c, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9a, 0x04, 0x58, 0x24, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xff, 0xa6, 0x58, 0x1c, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0x1a, 0x45, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xff, 0xdf, 0xd8, 0x4c, 0x7a, 0x0c, 0x9c, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x7b, 0x04, 0x58, 0x1c, 0x1d, 0x76, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x5e, 0x7e, 0x58, 0x1c, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0x37, 0x24, 0x5f, 0xb7, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xdf, 0x9e, 0x58, 0x24, 0x7a, 0x0c, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9a, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0xb7, 0x4c, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xff, 0xdf, 0x7f, 0x7e, 0x58, 0x1c, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x58, 0x1c, 0x9e, 0x9e, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xb9, 0x8d, 0xff, 0xa6, 0xff, 0xd7, 0xff, 0xef, 0xff, 0xef, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xff, 0xe7, 0x3f, 0xb7, 0x19, 0x55, 0x58, 0x1c, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9a, 0x04, 0x7a, 0x0c, 0xd9, 0x3c, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x56, 0x34, 0x58, 0x1c, 0x57, 0x24, 0xfa, 0x3c, 0xdc, 0x65, 0xbf, 0x8e, 0x7f, 0xb7, 0xff, 0xcf, 0xff, 0xdf, 0xff, 0xe7, 0xff, 0xe7, 0xff, 0xef, 0xff, 0xef, 0xff, 0xef, 0xff, 0xe7, 0xff, 0xe7, 0xff, 0xdf, 0xbf, 0xbf, 0x9f, 0x86, 0xf9, 0x44, 0x58, 0x1c, 0x79, 0x14, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0x9a, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0x37, 0x24, 0x3f, 0xaf, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xfa, 0x3c, 0x7a, 0x0c, 0x7a, 0x0c, 0x7a, 0x0c, 0x59, 0x14, 0x58, 0x1c, 0x37, 0x24, 0x37, 0x24, 0x77, 0x34, 0xf9, 0x4c, 0x5a, 0x5d, 0x7b, 0x65, 0xbc, 0x6d, 0xbb, 0x6d, 0x7a, 0x65, 0xf9, 0x4c, 0x57, 0x34, 0x37, 0x24, 0x58, 0x1c, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9a, 0x04, 0x7a, 0x04, 0x9b, 0x04, 0x58, 0x1c, 0xfc, 0x7d, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x5b, 0x55, 0x79, 0x14, 0x9a, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x7a, 0x0c, 0x7a, 0x0c, 0x7a, 0x0c, 0x7a, 0x0c, 0x7a, 0x0c, 0x79, 0x14, 0x79, 0x14, 0x59, 0x14, 0x59, 0x14, 0x79, 0x14, 0x7a, 0x0c, 0x7a, 0x0c, 0x7a, 0x0c, 0x7a, 0x0c, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x9b, 0x04, 0x58, 0x1c, 0x5a, 0x5d, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xbc, 0x65, 0x59, 0x14, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x9c, 0x04, 0x9c, 0x04, 0x9c, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x7a, 0x0c, 0x59, 0x14, 0x5a, 0x5d, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0x1d, 0x76, 0x59, 0x14, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0x37, 0x24, 0xdb, 0x75, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0x5e, 0x86, 0x58, 0x1c, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x0c, 0x7a, 0x0c, 0x7a, 0x14, 0x58, 0x1c, 0xb8, 0x34, 0xff, 0xa6, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbf, 0x8e, 0x58, 0x1c, 0x9b, 0x04, 0x9c, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7a, 0x0c, 0x59, 0x14, 0x77, 0x2c, 0x1c, 0x7e, 0xff, 0xdf, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xdf, 0xa6, 0x36, 0x2c, 0x79, 0x14, 0x7a, 0x0c, 0x7a, 0x0c, 0x9a, 0x0c, 0x7a, 0x0c, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x7b, 0x0c, 0x7a, 0x0c, 0x7a, 0x0c, 0x7a, 0x0c, 0x7a, 0x14, 0x59, 0x14, 0x58, 0x1c, 0xb9, 0x34, 0x5e, 0x7e, 0xff, 0xcf, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xd7, 0x9a, 0x7d, 0xb8, 0x44, 0x37, 0x24, 0x57, 0x1c, 0x58, 0x1c, 0x59, 0x14, 0x7a, 0x14, 0x7a, 0x0c, 0x7a, 0x0c, 0x7b, 0x04, 0x9b, 0x04, 0x9b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x7a, 0x0c, 0x7a, 0x0c, 0x7a, 0x0c, 0x79, 0x14, 0x58, 0x1c, 0x58, 0x1c, 0x37, 0x24, 0xb8, 0x44, 0xfc, 0x7d, 0x3f, 0xb7, 0xff, 0xe7, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xff, 0xe7, 0xff, 0xcf, 0x5f, 0xa7, 0x9e, 0x86, 0xfd, 0x6d, 0x5b, 0x55, 0xfa, 0x44, 0x98, 0x2c, 0x57, 0x24, 0x37, 0x1c, 0x58, 0x1c, 0x58, 0x1c, 0x38, 0x1c, 0x58, 0x1c, 0x38, 0x24, 0x37, 0x24, 0x78, 0x2c, 0xfa, 0x44, 0x9c, 0x5d, 0x5e, 0x7e, 0x1f, 0xa7, 0xff, 0xc7, 0xff, 0xe7, 0xff, 0xef, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xff, 0xf7, 0xff, 0xef, 0xff, 0xef, 0xff, 0xef, 0xff, 0xe7, 0xff, 0xe7, 0xff, 0xd7, 0xbf, 0xcf, 0x9f, 0xc7, 0x9f, 0xc7, 0xdf, 0xcf, 0xff, 0xd7, 0xff, 0xe7, 0xff, 0xe7, 0xff, 0xef, 0xff, 0xef, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
+  0x01, 0x00, 0x00, 0x00, 0x8a, 0x08, 0x00, 0x00, 0x80, 0x25, 0x00, 0x00, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x24, 0xff, 0xff, 0x85, 0xff,
+  0xf7, 0x9f, 0xcf, 0x9f, 0xc7, 0xbf, 0xc7, 0xbf, 0xcf, 0x08, 0xdf, 0xcf, 0x0b, 0xff, 0xd7, 0x81, 0xdf, 0xd7, 0x07, 0xdf, 0xcf, 0x81, 0xbf, 0xcf, 0x02, 0xbf, 0xc7, 0x82, 0x7f, 0xd7, 0xff, 0xef,
+  0x17, 0xff, 0xff, 0x82, 0xbf, 0xd7, 0x16, 0x34, 0x0e, 0x58, 0x1c, 0x05, 0x38, 0x24, 0x02, 0x58, 0x1c, 0x02, 0x38, 0x24, 0x02, 0x58, 0x1c, 0x81, 0x38, 0x24, 0x03, 0x58, 0x1c, 0x86, 0x37, 0x24,
+  0x38, 0x24, 0x58, 0x1c, 0x38, 0x24, 0x14, 0x3c, 0x5f, 0xbf, 0x17, 0xff, 0xff, 0x83, 0x7f, 0xbf, 0x58, 0x1c, 0x7b, 0x04, 0x04, 0x9b, 0x04, 0x92, 0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9a, 0x04,
+  0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7a, 0x0c, 0x7b, 0x04, 0x02, 0x9b, 0x04, 0x82,
+  0x7a, 0x0c, 0x9a, 0x04, 0x02, 0x9b, 0x04, 0x02, 0x7a, 0x0c, 0x85, 0x9c, 0x04, 0x7a, 0x0c, 0x36, 0x2c, 0xbf, 0xc7, 0xff, 0xf7, 0x15, 0xff, 0xff, 0x83, 0xff, 0xf7, 0x3f, 0xb7, 0x58, 0x1c, 0x19,
+  0x9b, 0x04, 0x81, 0x7b, 0x04, 0x03, 0x9b, 0x04, 0x87, 0x7a, 0x0c, 0x7b, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0x16, 0x2c, 0xff, 0xcf, 0xff, 0xf7, 0x15, 0xff, 0xff, 0x83, 0xff, 0xf7, 0xdf, 0xa6, 0x58,
+  0x1c, 0x1d, 0x9b, 0x04, 0x86, 0x7a, 0x0c, 0x7b, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0x16, 0x2c, 0xff, 0xdf, 0x16, 0xff, 0xff, 0x83, 0xff, 0xef, 0x9e, 0x96, 0x58, 0x1c, 0x1d, 0x9b, 0x04, 0x86, 0x7a,
+  0x0c, 0x9a, 0x04, 0xbc, 0x04, 0x7a, 0x0c, 0x35, 0x34, 0xff, 0xe7, 0x16, 0xff, 0xff, 0x83, 0xff, 0xef, 0x3d, 0x86, 0x59, 0x14, 0x05, 0x9b, 0x04, 0x81, 0x7b, 0x04, 0x13, 0x9b, 0x04, 0x81, 0x7b,
+  0x04, 0x03, 0x9b, 0x04, 0x86, 0x7a, 0x0c, 0x9a, 0x04, 0xbc, 0x04, 0x7a, 0x0c, 0x36, 0x34, 0xff, 0xe7, 0x16, 0xff, 0xff, 0x83, 0xff, 0xef, 0xfc, 0x7d, 0x59, 0x14, 0x0d, 0x9b, 0x04, 0x85, 0x7b,
+  0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x03, 0x9b, 0x04, 0x02, 0x7b, 0x04, 0x02, 0x9b, 0x04, 0x82, 0x7a, 0x0c, 0x9a, 0x04, 0x02, 0x9b, 0x04, 0x86, 0x7a, 0x0c, 0x9a, 0x04, 0xbc,
+  0x04, 0x7a, 0x0c, 0x56, 0x3c, 0xff, 0xe7, 0x16, 0xff, 0xff, 0x83, 0xff, 0xef, 0x9b, 0x6d, 0x59, 0x14, 0x09, 0x9b, 0x04, 0x82, 0x7a, 0x0c, 0x79, 0x0c, 0x14, 0x58, 0x1c, 0x84, 0x79, 0x0c, 0x58,
+  0x1c, 0x55, 0x4c, 0xff, 0xef, 0x16, 0xff, 0xff, 0x84, 0xff, 0xe7, 0x5a, 0x5d, 0x79, 0x14, 0x9b, 0x04, 0x02, 0x7b, 0x04, 0x05, 0x9b, 0x04, 0x85, 0x7b, 0x04, 0x79, 0x14, 0x3f, 0x66, 0xbf, 0xbf,
+  0x9f, 0xc7, 0x02, 0xbf, 0xc7, 0x82, 0xbf, 0xcf, 0xbf, 0xc7, 0x03, 0x9f, 0xc7, 0x02, 0x7f, 0xbf, 0x81, 0x5f, 0xbf, 0x02, 0x5f, 0xb7, 0x02, 0x3f, 0xb7, 0x88, 0x3f, 0xaf, 0x1f, 0xaf, 0xff, 0xa6,
+  0xde, 0x9e, 0xbf, 0x96, 0x7d, 0x96, 0x3b, 0xa6, 0xff, 0xf7, 0x16, 0xff, 0xff, 0x83, 0xff, 0xe7, 0xf9, 0x4c, 0x7a, 0x0c, 0x08, 0x9b, 0x04, 0x84, 0x9a, 0x04, 0x58, 0x1c, 0xff, 0x96, 0xff, 0xef,
+  0x0a, 0xff, 0xff, 0x09, 0xff, 0xf7, 0x82, 0xff, 0xef, 0xff, 0xf7, 0x18, 0xff, 0xff, 0x84, 0xff, 0xe7, 0x98, 0x3c, 0x7a, 0x0c, 0x9c, 0x04, 0x07, 0x9b, 0x04, 0x84, 0x7a, 0x0c, 0x57, 0x24, 0x5f,
+  0xaf, 0xff, 0xf7, 0x2d, 0xff, 0xff, 0x84, 0xff, 0xdf, 0x56, 0x2c, 0x7a, 0x0c, 0x9c, 0x04, 0x02, 0x9b, 0x04, 0x81, 0x7b, 0x04, 0x03, 0x9b, 0x04, 0x84, 0x9c, 0x04, 0x7a, 0x04, 0x37, 0x24, 0xbf,
+  0xbf, 0x2e, 0xff, 0xff, 0x84, 0xff, 0xd7, 0x36, 0x24, 0x7a, 0x0c, 0x9c, 0x04, 0x02, 0x9b, 0x04, 0x88, 0x7b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0x37, 0x24, 0xff,
+  0xcf, 0x2e, 0xff, 0xff, 0x84, 0xff, 0xc7, 0x37, 0x24, 0x7a, 0x0c, 0x9c, 0x04, 0x04, 0x9b, 0x04, 0x86, 0x7b, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0x36, 0x2c, 0xff, 0xdf, 0x2e, 0xff, 0xff,
+  0x84, 0x7f, 0xb7, 0x37, 0x24, 0x7a, 0x0c, 0x9c, 0x04, 0x06, 0x9b, 0x04, 0x84, 0x9c, 0x04, 0x7a, 0x0c, 0x77, 0x3c, 0xff, 0xdf, 0x2d, 0xff, 0xff, 0x85, 0xff, 0xf7, 0x3f, 0xa7, 0x58, 0x1c, 0x7a,
+  0x0c, 0x9c, 0x04, 0x07, 0x9b, 0x04, 0x83, 0x7a, 0x0c, 0xf9, 0x4c, 0xff, 0xe7, 0x2d, 0xff, 0xff, 0x84, 0xff, 0xf7, 0xdf, 0x96, 0x58, 0x1c, 0x7a, 0x0c, 0x08, 0x9b, 0x04, 0x83, 0x79, 0x14, 0x3a,
+  0x5d, 0xff, 0xe7, 0x2d, 0xff, 0xff, 0x84, 0xff, 0xf7, 0x7e, 0x86, 0x58, 0x1c, 0x7a, 0x0c, 0x08, 0x9b, 0x04, 0x83, 0x59, 0x14, 0xbb, 0x6d, 0xff, 0xef, 0x2d, 0xff, 0xff, 0x84, 0xff, 0xef, 0x1d,
+  0x76, 0x59, 0x14, 0x7a, 0x0c, 0x08, 0x9b, 0x04, 0x83, 0x59, 0x14, 0xfc, 0x7d, 0xff, 0xef, 0x2d, 0xff, 0xff, 0x84, 0xff, 0xef, 0xbc, 0x65, 0x79, 0x14, 0x9a, 0x04, 0x08, 0x9b, 0x04, 0x83, 0x59,
+  0x14, 0x5e, 0x8e, 0xff, 0xef, 0x2d, 0xff, 0xff, 0x84, 0xff, 0xef, 0x5b, 0x55, 0x79, 0x14, 0x9a, 0x04, 0x08, 0x9b, 0x04, 0x83, 0x58, 0x1c, 0xdf, 0x9e, 0xff, 0xef, 0x2d, 0xff, 0xff, 0x83, 0xff,
+  0xef, 0xfa, 0x44, 0x7a, 0x0c, 0x09, 0x9b, 0x04, 0x8a, 0x79, 0x14, 0x5f, 0x9f, 0xff, 0xdf, 0xff, 0xe7, 0xff, 0xdf, 0xdf, 0xcf, 0x9f, 0xc7, 0xbf, 0xcf, 0xdf, 0xcf, 0xff, 0xd7, 0x02, 0xff, 0xe7,
+  0x02, 0xff, 0xef, 0x81, 0xff, 0xf7, 0x21, 0xff, 0xff, 0x83, 0xff, 0xef, 0xb9, 0x34, 0x7a, 0x0c, 0x09, 0x9b, 0x04, 0x84, 0x7a, 0x0c, 0x1b, 0x2d, 0xb9, 0x2c, 0x58, 0x24, 0x05, 0x58, 0x1c, 0x02,
+  0x57, 0x24, 0x87, 0xb9, 0x34, 0x3a, 0x4d, 0xfc, 0x6d, 0xdf, 0x96, 0xbf, 0xc7, 0xff, 0xe7, 0xff, 0xef, 0x1e, 0xff, 0xff, 0x83, 0xff, 0xe7, 0x58, 0x24, 0x7a, 0x04, 0x09, 0x9b, 0x04, 0x81, 0x7b,
+  0x04, 0x02, 0x7a, 0x0c, 0x81, 0x9a, 0x04, 0x05, 0x9b, 0x04, 0x81, 0x9a, 0x04, 0x02, 0x7a, 0x0c, 0x89, 0x79, 0x0c, 0x58, 0x14, 0x58, 0x1c, 0x37, 0x24, 0xb8, 0x44, 0xfc, 0x7d, 0x7f, 0xbf, 0xff,
+  0xef, 0xff, 0xf7, 0x1b, 0xff, 0xff, 0x83, 0xff, 0xd7, 0x37, 0x24, 0x7a, 0x0c, 0x02, 0x7b, 0x04, 0x02, 0x7a, 0x0c, 0x02, 0x7b, 0x04, 0x82, 0x9b, 0x04, 0x7b, 0x04, 0x02, 0x9b, 0x04, 0x02, 0x9a,
+  0x04, 0x81, 0x9b, 0x0c, 0x03, 0x9a, 0x04, 0x81, 0x7b, 0x04, 0x06, 0x9b, 0x04, 0x81, 0x9a, 0x04, 0x02, 0x7a, 0x0c, 0x85, 0x79, 0x14, 0x58, 0x1c, 0x3a, 0x55, 0x7f, 0xb7, 0xff, 0xef, 0x1a, 0xff,
+  0xff, 0x83, 0xbf, 0xc7, 0x58, 0x1c, 0x7b, 0x04, 0x17, 0x9b, 0x04, 0x03, 0x9c, 0x04, 0x87, 0x9b, 0x04, 0x9a, 0x04, 0x79, 0x14, 0x37, 0x24, 0xbb, 0x75, 0xff, 0xdf, 0xff, 0xf7, 0x17, 0xff, 0xff,
+  0x84, 0xff, 0xf7, 0x5f, 0xb7, 0x58, 0x1c, 0x9b, 0x04, 0x05, 0x9c, 0x04, 0x08, 0x9b, 0x04, 0x03, 0x9c, 0x04, 0x0c, 0x9b, 0x04, 0x86, 0x7b, 0x04, 0x7a, 0x0c, 0x59, 0x14, 0xf9, 0x44, 0xff, 0xd7,
+  0xff, 0xf7, 0x16, 0xff, 0xff, 0x83, 0xff, 0xf7, 0xff, 0xa6, 0x58, 0x1c, 0x07, 0x7a, 0x0c, 0x06, 0x79, 0x14, 0x81, 0x79, 0x0c, 0x03, 0x7a, 0x0c, 0x81, 0x7b, 0x04, 0x06, 0x9b, 0x04, 0x82, 0x9a,
+  0x04, 0x7a, 0x0c, 0x02, 0x9a, 0x04, 0x04, 0x9b, 0x04, 0x84, 0x79, 0x14, 0xd8, 0x4c, 0xff, 0xdf, 0xff, 0xf7, 0x15, 0xff, 0xff, 0x8c, 0xff, 0xf7, 0x7d, 0x9e, 0x36, 0x2c, 0x58, 0x1c, 0x57, 0x24,
+  0x37, 0x24, 0x36, 0x2c, 0x97, 0x3c, 0xd8, 0x4c, 0x39, 0x55, 0x7a, 0x65, 0x9b, 0x6d, 0x02, 0xbb, 0x6d, 0x88, 0x9b, 0x6d, 0x7b, 0x65, 0x39, 0x55, 0xb8, 0x44, 0x37, 0x2c, 0x57, 0x24, 0x59, 0x1c,
+  0x7a, 0x0c, 0x06, 0x9b, 0x04, 0x81, 0x7b, 0x04, 0x06, 0x9b, 0x04, 0x84, 0x7a, 0x0c, 0x58, 0x1c, 0x9b, 0x65, 0xff, 0xef, 0x15, 0xff, 0xff, 0x86, 0xff, 0xf7, 0xdd, 0xb6, 0x1c, 0x86, 0xdf, 0x96,
+  0x5f, 0xaf, 0xdf, 0xc7, 0x02, 0xff, 0xdf, 0x03, 0xff, 0xe7, 0x04, 0xff, 0xef, 0x03, 0xff, 0xe7, 0x85, 0xff, 0xd7, 0x9f, 0xb7, 0x5e, 0x7e, 0xd9, 0x3c, 0x58, 0x1c, 0x02, 0x7a, 0x0c, 0x0c, 0x9b,
+  0x04, 0x83, 0x58, 0x1c, 0x1f, 0xb7, 0xff, 0xf7, 0x16, 0xff, 0xff, 0x03, 0xff, 0xf7, 0x0e, 0xff, 0xff, 0x02, 0xff, 0xf7, 0x85, 0xff, 0xe7, 0xff, 0xa6, 0xb8, 0x3c, 0x59, 0x14, 0x9b, 0x0c, 0x03,
+  0x9b, 0x04, 0x81, 0x7b, 0x04, 0x04, 0x9b, 0x04, 0x86, 0x7b, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x79, 0x0c, 0xf8, 0x54, 0xff, 0xe7, 0x2a, 0xff, 0xff, 0x85, 0xff, 0xef, 0xff, 0xcf, 0x3a, 0x4d, 0x59,
+  0x14, 0x7a, 0x0c, 0x03, 0x9b, 0x04, 0x81, 0x7b, 0x04, 0x03, 0x9b, 0x04, 0x87, 0x9a, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0x37, 0x24, 0x7f, 0xb7, 0xff, 0xf7, 0x2a, 0xff, 0xff, 0x85, 0xff,
+  0xf7, 0xff, 0xd7, 0xb8, 0x44, 0x7a, 0x0c, 0x9c, 0x04, 0x0a, 0x9b, 0x04, 0x83, 0x59, 0x1c, 0xfd, 0x75, 0xff, 0xef, 0x2b, 0xff, 0xff, 0x85, 0xff, 0xf7, 0xff, 0xa6, 0x58, 0x1c, 0x9b, 0x04, 0x7b,
+  0x04, 0x09, 0x9b, 0x04, 0x83, 0x7a, 0x0c, 0xf9, 0x44, 0xff, 0xef, 0x2c, 0xff, 0xff, 0x83, 0xff, 0xe7, 0x98, 0x34, 0x7a, 0x0c, 0x05, 0x9b, 0x04, 0x81, 0x7b, 0x04, 0x02, 0x9b, 0x04, 0x85, 0x7b,
+  0x04, 0x9b, 0x04, 0x9a, 0x04, 0x58, 0x24, 0xff, 0xdf, 0x2c, 0xff, 0xff, 0x84, 0xff, 0xef, 0x9b, 0x5d, 0x79, 0x14, 0x7b, 0x04, 0x0a, 0x9b, 0x04, 0x82, 0x58, 0x1c, 0xbf, 0xcf, 0x2c, 0xff, 0xff,
+  0x84, 0xff, 0xef, 0xfd, 0x6d, 0x79, 0x14, 0x7b, 0x04, 0x08, 0x9b, 0x04, 0x84, 0x7b, 0x04, 0x9b, 0x04, 0x58, 0x1c, 0x7f, 0xc7, 0x2c, 0xff, 0xff, 0x83, 0xff, 0xef, 0xfd, 0x6d, 0x79, 0x14, 0x0b,
+  0x9b, 0x04, 0x82, 0x58, 0x1c, 0x9f, 0xc7, 0x2c, 0xff, 0xff, 0x83, 0xff, 0xef, 0x7b, 0x55, 0x79, 0x0c, 0x0b, 0x9b, 0x04, 0x82, 0x58, 0x1c, 0xdf, 0xcf, 0x2c, 0xff, 0xff, 0x83, 0xff, 0xe7, 0x78,
+  0x2c, 0x7a, 0x0c, 0x0a, 0x9b, 0x04, 0x83, 0x9a, 0x04, 0x58, 0x24, 0xff, 0xe7, 0x2b, 0xff, 0xff, 0x83, 0xff, 0xf7, 0xff, 0xa6, 0x58, 0x1c, 0x02, 0x9b, 0x04, 0x81, 0x7b, 0x04, 0x08, 0x9b, 0x04,
+  0x83, 0x7a, 0x0c, 0x1a, 0x45, 0xff, 0xef, 0x2a, 0xff, 0xff, 0x87, 0xff, 0xf7, 0xff, 0xdf, 0xd8, 0x4c, 0x7a, 0x0c, 0x9c, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x06, 0x9b, 0x04, 0x85, 0x9c, 0x04, 0x7b,
+  0x04, 0x58, 0x1c, 0x1d, 0x76, 0xff, 0xef, 0x2a, 0xff, 0xff, 0x84, 0xff, 0xef, 0x5e, 0x7e, 0x58, 0x1c, 0x7a, 0x0c, 0x07, 0x9b, 0x04, 0x87, 0x9a, 0x04, 0x7b, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0x37,
+  0x24, 0x5f, 0xb7, 0xff, 0xf7, 0x29, 0xff, 0xff, 0x85, 0xff, 0xef, 0xdf, 0x9e, 0x58, 0x24, 0x7a, 0x0c, 0x7b, 0x04, 0x07, 0x9b, 0x04, 0x86, 0x9a, 0x04, 0x9b, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0xb7,
+  0x4c, 0xff, 0xe7, 0x14, 0xff, 0xff, 0x02, 0xff, 0xf7, 0x12, 0xff, 0xff, 0x85, 0xff, 0xf7, 0xff, 0xdf, 0x7f, 0x7e, 0x58, 0x1c, 0x7a, 0x0c, 0x0a, 0x9b, 0x04, 0x85, 0x7b, 0x04, 0x9b, 0x04, 0x58,
+  0x1c, 0x9e, 0x9e, 0xff, 0xf7, 0x13, 0xff, 0xff, 0x84, 0xff, 0xef, 0xb9, 0x8d, 0xff, 0xa6, 0xff, 0xd7, 0x02, 0xff, 0xef, 0x81, 0xff, 0xf7, 0x0c, 0xff, 0xff, 0x86, 0xff, 0xf7, 0xff, 0xe7, 0x3f,
+  0xb7, 0x19, 0x55, 0x58, 0x1c, 0x7a, 0x0c, 0x0b, 0x9b, 0x04, 0x84, 0x9a, 0x04, 0x7a, 0x0c, 0xd9, 0x3c, 0xff, 0xe7, 0x14, 0xff, 0xff, 0x8a, 0xff, 0xef, 0x56, 0x34, 0x58, 0x1c, 0x57, 0x24, 0xfa,
+  0x3c, 0xdc, 0x65, 0xbf, 0x8e, 0x7f, 0xb7, 0xff, 0xcf, 0xff, 0xdf, 0x02, 0xff, 0xe7, 0x03, 0xff, 0xef, 0x02, 0xff, 0xe7, 0x87, 0xff, 0xdf, 0xbf, 0xbf, 0x9f, 0x86, 0xf9, 0x44, 0x58, 0x1c, 0x79,
+  0x14, 0x7a, 0x0c, 0x04, 0x9b, 0x04, 0x81, 0x7b, 0x04, 0x04, 0x9b, 0x04, 0x87, 0x7a, 0x0c, 0x9a, 0x04, 0x9c, 0x04, 0x7a, 0x0c, 0x37, 0x24, 0x3f, 0xaf, 0xff, 0xf7, 0x14, 0xff, 0xff, 0x82, 0xff,
+  0xef, 0xfa, 0x3c, 0x03, 0x7a, 0x0c, 0x82, 0x59, 0x14, 0x58, 0x1c, 0x02, 0x37, 0x24, 0x8c, 0x77, 0x34, 0xf9, 0x4c, 0x5a, 0x5d, 0x7b, 0x65, 0xbc, 0x6d, 0xbb, 0x6d, 0x7a, 0x65, 0xf9, 0x4c, 0x57,
+  0x34, 0x37, 0x24, 0x58, 0x1c, 0x7a, 0x0c, 0x06, 0x9b, 0x04, 0x83, 0x7b, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x03, 0x9b, 0x04, 0x86, 0x9a, 0x04, 0x7a, 0x04, 0x9b, 0x04, 0x58, 0x1c, 0xfc, 0x7d, 0xff,
+  0xef, 0x15, 0xff, 0xff, 0x86, 0xff, 0xef, 0x5b, 0x55, 0x79, 0x14, 0x9a, 0x04, 0x9b, 0x04, 0x7b, 0x04, 0x05, 0x7a, 0x0c, 0x02, 0x79, 0x14, 0x02, 0x59, 0x14, 0x81, 0x79, 0x14, 0x04, 0x7a, 0x0c,
+  0x08, 0x9b, 0x04, 0x81, 0x7b, 0x04, 0x04, 0x9b, 0x04, 0x85, 0x9c, 0x04, 0x9b, 0x04, 0x58, 0x1c, 0x5a, 0x5d, 0xff, 0xe7, 0x16, 0xff, 0xff, 0x83, 0xff, 0xef, 0xbc, 0x65, 0x59, 0x14, 0x04, 0x9b,
+  0x04, 0x04, 0x9c, 0x04, 0x06, 0x9b, 0x04, 0x81, 0x9c, 0x04, 0x0e, 0x9b, 0x04, 0x85, 0x7b, 0x04, 0x7a, 0x0c, 0x59, 0x14, 0x5a, 0x5d, 0xff, 0xdf, 0x17, 0xff, 0xff, 0x84, 0xff, 0xf7, 0x1d, 0x76,
+  0x59, 0x14, 0x7b, 0x04, 0x17, 0x9b, 0x04, 0x81, 0x7b, 0x04, 0x04, 0x9b, 0x04, 0x84, 0x7a, 0x0c, 0x37, 0x24, 0xdb, 0x75, 0xff, 0xe7, 0x18, 0xff, 0xff, 0x84, 0xff, 0xf7, 0x5e, 0x86, 0x58, 0x1c,
+  0x7b, 0x04, 0x02, 0x9b, 0x04, 0x81, 0x7b, 0x04, 0x09, 0x9b, 0x04, 0x81, 0x7b, 0x04, 0x0b, 0x9b, 0x04, 0x87, 0x9b, 0x0c, 0x7a, 0x0c, 0x7a, 0x14, 0x58, 0x1c, 0xb8, 0x34, 0xff, 0xa6, 0xff, 0xef,
+  0x19, 0xff, 0xff, 0x85, 0xff, 0xf7, 0xbf, 0x8e, 0x58, 0x1c, 0x9b, 0x04, 0x9c, 0x04, 0x17, 0x9b, 0x04, 0x86, 0x7a, 0x0c, 0x59, 0x14, 0x77, 0x2c, 0x1c, 0x7e, 0xff, 0xdf, 0xff, 0xf7, 0x1a, 0xff,
+  0xff, 0x84, 0xff, 0xf7, 0xdf, 0xa6, 0x36, 0x2c, 0x79, 0x14, 0x02, 0x7a, 0x0c, 0x83, 0x9a, 0x0c, 0x7a, 0x0c, 0x7b, 0x04, 0x0b, 0x9b, 0x04, 0x82, 0x7b, 0x04, 0x7b, 0x0c, 0x03, 0x7a, 0x0c, 0x87,
+  0x7a, 0x14, 0x59, 0x14, 0x58, 0x1c, 0xb9, 0x34, 0x5e, 0x7e, 0xff, 0xcf, 0xff, 0xef, 0x1d, 0xff, 0xff, 0x88, 0xbf, 0xd7, 0x9a, 0x7d, 0xb8, 0x44, 0x37, 0x24, 0x57, 0x1c, 0x58, 0x1c, 0x59, 0x14,
+  0x7a, 0x14, 0x02, 0x7a, 0x0c, 0x81, 0x7b, 0x04, 0x02, 0x9b, 0x04, 0x84, 0x9a, 0x04, 0x7b, 0x04, 0x9a, 0x04, 0x7b, 0x04, 0x03, 0x7a, 0x0c, 0x81, 0x79, 0x14, 0x02, 0x58, 0x1c, 0x86, 0x37, 0x24,
+  0xb8, 0x44, 0xfc, 0x7d, 0x3f, 0xb7, 0xff, 0xe7, 0xff, 0xf7, 0x20, 0xff, 0xff, 0x8b, 0xff, 0xef, 0xff, 0xe7, 0xff, 0xcf, 0x5f, 0xa7, 0x9e, 0x86, 0xfd, 0x6d, 0x5b, 0x55, 0xfa, 0x44, 0x98, 0x2c,
+  0x57, 0x24, 0x37, 0x1c, 0x02, 0x58, 0x1c, 0x8d, 0x38, 0x1c, 0x58, 0x1c, 0x38, 0x24, 0x37, 0x24, 0x78, 0x2c, 0xfa, 0x44, 0x9c, 0x5d, 0x5e, 0x7e, 0x1f, 0xa7, 0xff, 0xc7, 0xff, 0xe7, 0xff, 0xef,
+  0xff, 0xf7, 0x25, 0xff, 0xff, 0x02, 0xff, 0xf7, 0x03, 0xff, 0xef, 0x02, 0xff, 0xe7, 0x82, 0xff, 0xd7, 0xbf, 0xcf, 0x02, 0x9f, 0xc7, 0x82, 0xdf, 0xcf, 0xff, 0xd7, 0x02, 0xff, 0xe7, 0x02, 0xff,
+  0xef, 0x81, 0xff, 0xf7, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x37, 0xff, 0xff,
 };
 
 const lv_image_dsc_t logo_5 = {
   .header.cf = LV_COLOR_FORMAT_RGB565,
   .header.magic = LV_IMAGE_HEADER_MAGIC,
+  .header.flags = LV_IMAGE_FLAGS_COMPRESSED | LV_IMAGE_FLAGS_USER1,
   .header.w = 60,
   .header.h = 80,
-  .data_size = 4800 * 2,
+  .data_size = 2198,
   .data = logo_5_map,
 };
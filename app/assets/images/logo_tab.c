@@ -21,94 +21,187 @@
 #define LV_ATTRIBUTE_IMAGE_LOGO_TAB
 #endif
 
+// RLE compressed by app/assets/tools/compress_image.py, 28800 bytes raw
 const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMAGE_LOGO_TAB uint8_t logo_tab_map[] = {
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7e, 0xf7, 0x7d, 0xf7, 0x7e, 0xf7, 0x9e, 0xf7, 0x9e, 0xf7, 0xbe, 0xf7, 0xbe, 0xff, 0xbe, 0xff, 0xbf, 0xff, 0xdf, 0xff, 0xdf, 0xff, 0xdf, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xdf, 0xff, 0xdf, 0xff, 0xdf, 0xff, 0xbf, 0xff, 0xdf, 0xff, 0xbf, 0xff, 0xbe, 0xff, 0xbe, 0xff, 0xbe, 0xf7, 0x9e, 0xf7, 0xbe, 0xff, 0x9e, 0xf7, 0x9e, 0xf7, 0x9e, 0xf7, 0x9e, 0xf7, 0x7e, 0xf7, 0x7e, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9e, 0xf7, 0x9e, 0xf7, 0xbe, 0xff, 0xbe, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xbf, 0xff, 0x9e, 0xf7, 0x7e, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0x7e, 0xf7, 0x9e, 0xff, 0xbf, 0xff, 0xdf, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xdf, 0xff, 0xbf, 0xff, 0x9e, 0xf7, 0x5d, 0xf7, 0x3d, 0xef, 0x1c, 0xef, 0xfb, 0xe6, 0xbb, 0xde, 0xba, 0xde, 0x9a, 0xd6, 0x79, 0xd6, 0x59, 0xd6, 0x59, 0xce, 0x59, 0xce, 0x59, 0xd6, 0x7a, 0xd6, 0xba, 0xde, 0xfb, 0xe6, 0x7d, 0xef, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7e, 0xf7, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x51, 0x8c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfb, 0xe6, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0xd7, 0xbd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb6, 0xbd, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x49, 0x52, 0x8e, 0x73, 0x14, 0xa5, 0x1c, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5d, 0xef, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xb2, 0x9c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xcf, 0x7b, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x66, 0x31, 0x6d, 0x73, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd7, 0xbd, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x0c, 0x63, 0x38, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1c, 0xe7, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x34, 0xad, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3c, 0xef, 0x86, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0xa6, 0x39, 0x9e, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd7, 0xc5, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x66, 0x31, 0x6d, 0x73, 0x9e, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfb, 0xde, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x76, 0xb5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x10, 0x84, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x75, 0xb5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd7, 0xc5, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x69, 0x52, 0x7d, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9a, 0xd6, 0x66, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x66, 0x39, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x66, 0x31, 0xd7, 0xc5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3c, 0xef, 0x86, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x85, 0x31, 0x2c, 0x6b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xc5, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0xcb, 0x5a, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x38, 0xce, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x66, 0x31, 0x38, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x10, 0x84, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x66, 0x31, 0x5d, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd7, 0xbd, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xb2, 0x94, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xc5, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x59, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5d, 0xef, 0x86, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x34, 0xad, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb6, 0xbd, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0xa6, 0x39, 0x7d, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x96, 0xb5, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x66, 0x31, 0x9a, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x10, 0x8c, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xcb, 0x62, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb6, 0xbd, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x2c, 0x6b, 0xef, 0x83, 0xef, 0x83, 0xef, 0x83, 0xef, 0x83, 0xef, 0x83, 0xef, 0x83, 0xef, 0x83, 0xef, 0x83, 0xef, 0x83, 0xef, 0x83, 0xaf, 0x7b, 0x4d, 0x73, 0xaa, 0x5a, 0xc6, 0x39, 0x66, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xb3, 0x9c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd7, 0xbd, 0x0c, 0x6b, 0x4d, 0x6b, 0x6e, 0x73, 0x8e, 0x7b, 0xcf, 0x83, 0x10, 0x84, 0x31, 0x8c, 0x71, 0x94, 0x92, 0x94, 0xb2, 0x9c, 0xd3, 0x9c, 0xd3, 0xa4, 0xf3, 0xa4, 0xf4, 0xa4, 0x14, 0xa5, 0x14, 0xa5, 0x51, 0x94, 0x66, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x14, 0xa5, 0x14, 0xa5, 0x14, 0xa5, 0x14, 0xa5, 0xf3, 0xa4, 0xf3, 0xa4, 0xf3, 0xa4, 0xd3, 0x9c, 0xb2, 0x9c, 0x92, 0x9c, 0x71, 0x94, 0x31, 0x8c, 0x10, 0x84, 0xcf, 0x83, 0x8e, 0x7b, 0x4d, 0x73, 0x2c, 0x63, 0xfc, 0xe6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3c, 0xef, 0x86, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x48, 0x4a, 0x86, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x1c, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x96, 0xb5, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x59, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x39, 0xce, 0x4d, 0x6b, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x8a, 0x52, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7a, 0xd6, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xc7, 0x41, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x83, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x55, 0xb5, 0x6d, 0x73, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xd3, 0x9c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x75, 0xb5, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xba, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x55, 0xb5, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x9e, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x59, 0xce, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x49, 0x4a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1c, 0xef, 0x86, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x08, 0x4a, 0xff, 0xff, 0xb6, 0xbd, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x8a, 0x52, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x35, 0xad, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x66, 0x31, 0xfb, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x92, 0x9c, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x79, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xc6, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xaa, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xcf, 0x83, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x34, 0xad, 0xff, 0xff, 0xdf, 0xff, 0xa6, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xdb, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x34, 0xad, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x3c, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xc7, 0x41, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xb7, 0xbd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd7, 0xc5, 0x86, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x0c, 0x6b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfb, 0xe6, 0x86, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x08, 0x42, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8e, 0x7b, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x72, 0x94, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf3, 0xa4, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x7d, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xae, 0x7b, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x55, 0xad, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb6, 0xbd, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x6e, 0x73, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8e, 0x7b, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xd3, 0xa4, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd7, 0xc5, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x28, 0x4a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd3, 0x9c, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd3, 0x9c, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x76, 0xb5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x75, 0xb5, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xef, 0x83, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbb, 0xde, 0x66, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xc7, 0x41, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xc7, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x7a, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x92, 0x9c, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf4, 0xa4, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xf8, 0xc5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x34, 0xad, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x51, 0x94, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4d, 0x73, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xb2, 0x9c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xcf, 0x7b, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x30, 0x8c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x71, 0x94, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0xa6, 0x39, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x92, 0x94, 0x66, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xdb, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf4, 0xa4, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xb2, 0x9c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9a, 0xd6, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xc7, 0x39, 0x9e, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xc6, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xe8, 0x41, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x31, 0x8c, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0xe7, 0x41, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x2d, 0x6b, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0xa7, 0x39, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd3, 0xa4, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xf3, 0xa4, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0c, 0x63, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x92, 0x94, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xc7, 0x41, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x18, 0xc6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x10, 0x84, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x29, 0x4a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9e, 0xf7, 0xa6, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x4d, 0x73, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x92, 0x9c, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x34, 0xad, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x38, 0xce, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xc6, 0x39, 0x9e, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x83, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x8e, 0x7b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xcf, 0x7b, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x6a, 0x52, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb3, 0x9c, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xb6, 0xbd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x51, 0x94, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x76, 0xb5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xcb, 0x62, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x71, 0x94, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x38, 0xce, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xa6, 0x39, 0x9e, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8e, 0x7b, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0xab, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdb, 0xde, 0x86, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x28, 0x4a, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x30, 0x8c, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xb7, 0xbd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xc5, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0xa6, 0x39, 0x7d, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x41, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x55, 0xb5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4d, 0x73, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xec, 0x62, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfb, 0xe6, 0x08, 0x4a, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xb6, 0xbd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0x83, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xf8, 0xc5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8a, 0x52, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x71, 0x94, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x10, 0x8c, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xeb, 0x62, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x2c, 0x6b, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x2c, 0x6b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5d, 0xf7, 0xb2, 0x9c, 0xa7, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x8e, 0x73, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xaf, 0x7b, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x39, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb6, 0xbd, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xa6, 0x39, 0x7d, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x59, 0xce, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x1c, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xeb, 0x62, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x0c, 0x6b, 0xdb, 0xde, 0xdb, 0xde, 0xdb, 0xde, 0xdb, 0xde, 0xdb, 0xde, 0xdb, 0xde, 0xdb, 0xde, 0xbb, 0xde, 0xba, 0xde, 0x9a, 0xd6, 0x38, 0xce, 0x96, 0xbd, 0x92, 0x94, 0xeb, 0x62, 0x85, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xcb, 0x5a, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8e, 0x73, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x7a, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x69, 0x52, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x51, 0x8c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x08, 0x4a, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xb2, 0x9c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xaa, 0x5a, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x4d, 0x73, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4d, 0x73, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xbb, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x75, 0xb5, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xa6, 0x39, 0x5d, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x30, 0x8c, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x49, 0x4a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6a, 0x52, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xa7, 0x39, 0xf3, 0xa4, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0c, 0x6b, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xfc, 0xe6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0x28, 0x4a, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x30, 0x8c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x79, 0xd6, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x79, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x49, 0x4a, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0xc6, 0x39, 0x51, 0x94, 0x5d, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xcb, 0x62, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x5d, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x14, 0xad, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0xa6, 0x39, 0x5d, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x28, 0x4a, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xf0, 0x83, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x08, 0x42, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x66, 0x39, 0x66, 0x39, 0x66, 0x39, 0x66, 0x39, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0xf0, 0x83, 0x7e, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6a, 0x52, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x9e, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbe, 0xff, 0x07, 0x42, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x86, 0x39, 0x49, 0x52, 0x49, 0x4a, 0x49, 0x52, 0x49, 0x52, 0x49, 0x52, 0x29, 0x4a, 0x29, 0x4a, 0x49, 0x4a, 0x49, 0x52, 0x49, 0x4a, 0x49, 0x4a, 0x49, 0x4a, 0x49, 0x52, 0x49, 0x52, 0x49, 0x52, 0xa7, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0xc7, 0x41, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc7, 0x41, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x66, 0x39, 0x66, 0x39, 0x66, 0x39, 0x66, 0x39, 0x66, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xa6, 0x39, 0x4d, 0x73, 0xb6, 0xbd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x28, 0x4a, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd3, 0xa4, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x66, 0x31, 0xb6, 0xbd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x86, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x69, 0x52, 0x18, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc7, 0x41, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x85, 0x31, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9e, 0xf7, 0xe7, 0x41, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x4d, 0x6b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x65, 0x39, 0x66, 0x39, 0x65, 0x39, 0x66, 0x39, 0x65, 0x39, 0x66, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x51, 0x8c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0xc6, 0x39, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x92, 0x94, 0x85, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x5d, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbe, 0xf7, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0xab, 0x5a, 0x6d, 0x73, 0x6d, 0x73, 0x6d, 0x73, 0x6e, 0x73, 0x6d, 0x73, 0x6e, 0x73, 0x6d, 0x73, 0x6e, 0x73, 0x6d, 0x73, 0x6d, 0x73, 0x4d, 0x6b, 0x0c, 0x6b, 0xaa, 0x5a, 0xc7, 0x41, 0x66, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xcf, 0x7b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x07, 0x42, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7d, 0xf7, 0xc6, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x14, 0xa5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7d, 0xf7, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0xd7, 0xc5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1c, 0xef, 0x14, 0xad, 0x48, 0x4a, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xb3, 0x9c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7d, 0xf7, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x48, 0x4a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x51, 0x8c, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x8a, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3c, 0xe7, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x38, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0x51, 0x8c, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x86, 0x39, 0xbb, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1c, 0xef, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x8a, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5d, 0xef, 0xa6, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xdb, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdb, 0xe6, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x79, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x92, 0x94, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x2c, 0x6b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbb, 0xde, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0xcb, 0x62, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x10, 0x84, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x66, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x65, 0x31, 0x65, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x65, 0x31, 0x65, 0x31, 0x66, 0x31, 0x66, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x51, 0x94, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xba, 0xde, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x66, 0x31, 0xba, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xcb, 0x62, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x85, 0x31, 0xfc, 0xe6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x79, 0xd6, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x0c, 0x6b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1c, 0xe7, 0x86, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x65, 0x31, 0xef, 0x83, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x30, 0x8c, 0x0c, 0x6b, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x08, 0x4a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x59, 0xd6, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x66, 0x31, 0xfc, 0xe6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xc6, 0x66, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xf3, 0xa4, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xc6, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x4d, 0x73, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xaf, 0x7b, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x0c, 0x6b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1c, 0xe7, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x18, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x38, 0xce, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x3c, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0x86, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x4d, 0x6b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd7, 0xbd, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x8e, 0x7b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdb, 0xe6, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x59, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xeb, 0x62, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xae, 0x7b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd7, 0xc5, 0x66, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x7e, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8a, 0x52, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x08, 0x4a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x75, 0xb5, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xcf, 0x83, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6d, 0x73, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0xeb, 0x62, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x55, 0xb5, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xa6, 0x39, 0xbe, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x96, 0xb5, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xcb, 0x5a, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x34, 0xa5, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x10, 0x8c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xba, 0xd6, 0x66, 0x31, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x39, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9e, 0xf7, 0xa6, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x75, 0xb5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x55, 0xad, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x69, 0x52, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x9e, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb3, 0x9c, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x71, 0x94, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x2c, 0x6b, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xcb, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x6e, 0x73, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xec, 0x62, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf3, 0xa4, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0xa6, 0x39, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0x86, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x71, 0x94, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x92, 0x9c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x79, 0xd6, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xd7, 0xc5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd7, 0xc5, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x85, 0x31, 0x3c, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x92, 0x9c, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0xe7, 0x41, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x39, 0xce, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x86, 0x39, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x10, 0x8c, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xd3, 0xa4, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xeb, 0x62, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x8a, 0x52, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xc7, 0x41, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xb3, 0x9c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x30, 0x8c, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x28, 0x4a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xae, 0x7b, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x69, 0x52, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xcf, 0x7b, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x34, 0xad, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x18, 0xc6, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x96, 0xb5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xcf, 0x83, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x49, 0x52, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xcf, 0x7b, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x69, 0x52, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xba, 0xde, 0x85, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xae, 0x7b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4d, 0x6b, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x75, 0xb5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8a, 0x5a, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x85, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x48, 0x4a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x38, 0xce, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x7a, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x4d, 0x73, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xaa, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7d, 0xf7, 0x69, 0x52, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x96, 0xb5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xcb, 0x5a, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x75, 0xb5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x96, 0xbd, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x34, 0xad, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x41, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x10, 0x8c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xcb, 0x62, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xec, 0x62, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x38, 0xce, 0x49, 0x4a, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x86, 0x39, 0x7e, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x49, 0x52, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x96, 0xbd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x49, 0x52, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0xe7, 0x41, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x10, 0x84, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0xe7, 0x41, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x69, 0x52, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x2c, 0x6b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5d, 0xf7, 0x55, 0xb5, 0xcb, 0x62, 0x66, 0x31, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xef, 0x83, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc7, 0x41, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xb7, 0xbd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x34, 0xad, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0xb3, 0x9c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x59, 0xce, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xd7, 0xbd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x41, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x28, 0x4a, 0x10, 0x8c, 0x10, 0x84, 0x10, 0x84, 0x10, 0x84, 0x10, 0x84, 0x10, 0x84, 0x10, 0x84, 0x10, 0x84, 0x10, 0x84, 0x10, 0x84, 0xcf, 0x83, 0x8e, 0x73, 0x0c, 0x6b, 0x28, 0x4a, 0x66, 0x31, 0x66, 0x31, 0x66, 0x39, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0xa6, 0x39, 0x3c, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x86, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xd7, 0xc5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbe, 0xff, 0xe7, 0x41, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0xa6, 0x39, 0x9e, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe8, 0x41, 0x66, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x4d, 0x73, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xf3, 0xa4, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7d, 0xf7, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0xf7, 0xc5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x92, 0x9c, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x31, 0x8c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x10, 0x84, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x86, 0x39, 0x7d, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7d, 0xf7, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x4d, 0x73, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfb, 0xe6, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x18, 0xc6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x5d, 0xef, 0xa7, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x86, 0x39, 0x3c, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x38, 0xce, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x34, 0xad, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfb, 0xe6, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x2c, 0x6b, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7a, 0xd6, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x18, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0x83, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0xae, 0x7b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc7, 0x41, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x8a, 0x5a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7a, 0xd6, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x30, 0x8c, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0xc5, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x38, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdb, 0xe6, 0x86, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x65, 0x31, 0xbb, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xae, 0x7b, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x66, 0x39, 0x9a, 0xde, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd7, 0xbd, 0x66, 0x39, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x8a, 0x5a, 0x39, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x96, 0xb5, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x66, 0x31, 0x38, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x2d, 0x6b, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x31, 0x0c, 0x6b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x96, 0xbd, 0x66, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x66, 0x39, 0x66, 0x39, 0x10, 0x84, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x55, 0xad, 0x66, 0x31, 0x66, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x86, 0x39, 0x4d, 0x73, 0xf8, 0xc5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x14, 0xa5, 0x65, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x38, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x38, 0xce, 0x66, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x39, 0x66, 0x31, 0x66, 0x31, 0x18, 0xc6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7d, 0xf7, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x66, 0x31, 0x66, 0x39, 0x66, 0x31, 0xc7, 0x39, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb3, 0x9c, 0x66, 0x31, 0x66, 0x31, 0x66, 0x39, 0x66, 0x31, 0x66, 0x31, 0x85, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x65, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0x66, 0x31, 0xe7, 0x41, 0x8a, 0x5a, 0x4d, 0x73, 0x51, 0x94, 0xd7, 0xbd, 0x9e, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3c, 0xef, 0x59, 0xd6, 0x79, 0xd6, 0x9a, 0xd6, 0xba, 0xde, 0xdb, 0xde, 0xdb, 0xde, 0xbb, 0xde, 0xba, 0xde, 0x9a, 0xde, 0x9a, 0xd6, 0x79, 0xd6, 0x79, 0xce, 0x9e, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0xe6, 0x79, 0xd6, 0x7a, 0xd6, 0x9a, 0xd6, 0xba, 0xde, 0xdb, 0xde, 0xdb, 0xde, 0xdb, 0xde, 0xba, 0xde, 0xba, 0xde, 0x9a, 0xd6, 0x79, 0xd6, 0x79, 0xd6, 0x59, 0xce, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9a, 0xd6, 0x79, 0xd6, 0x9a, 0xd6, 0xba, 0xde, 0xba, 0xde, 0xdb, 0xde, 0xdb, 0xde, 0xdb, 0xde, 0xba, 0xde, 0xba, 0xde, 0x9a, 0xd6, 0x79, 0xd6, 0x59, 0xce, 0x9e, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1c, 0xe7, 0x59, 0xce, 0x59, 0xd6, 0x79, 0xd6, 0x79, 0xd6, 0x79, 0xd6, 0x7a, 0xd6, 0x7a, 0xd6, 0x79, 0xd6, 0x7a, 0xd6, 0x79, 0xd6, 0x79, 0xd6, 0x59, 0xd6, 0x59, 0xd6, 0x79, 0xd6, 0x59, 0xd6, 0x59, 0xce, 0x59, 0xce, 0x59, 0xce, 0x59, 0xd6, 0x79, 0xd6, 0x79, 0xd6, 0x9a, 0xd6, 0x9a, 0xde, 0xdb, 0xde, 0xfb, 0xe6, 0x3c, 0xe7, 0x5d, 0xf7, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
+  0x01, 0x00, 0x00, 0x00, 0x45, 0x15, 0x00, 0x00, 0x80, 0x70, 0x00, 0x00, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff,
+  0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x53, 0xff, 0xff, 0x83, 0x7e, 0xf7, 0x7d,
+  0xf7, 0x7e, 0xf7, 0x02, 0x9e, 0xf7, 0x81, 0xbe, 0xf7, 0x02, 0xbe, 0xff, 0x81, 0xbf, 0xff, 0x04, 0xdf, 0xff, 0x81, 0xff, 0xff, 0x02, 0xdf, 0xff, 0x0c, 0xff, 0xff, 0x04, 0xdf, 0xff, 0x83, 0xbf,
+  0xff, 0xdf, 0xff, 0xbf, 0xff, 0x02, 0xbe, 0xff, 0x83, 0xbe, 0xf7, 0x9e, 0xf7, 0xbe, 0xff, 0x04, 0x9e, 0xf7, 0x02, 0x7e, 0xf7, 0x81, 0xbe, 0xff, 0x1d, 0xff, 0xff, 0x02, 0x9e, 0xf7, 0x02, 0xbe,
+  0xff, 0x81, 0xdf, 0xff, 0x06, 0xff, 0xff, 0x84, 0xdf, 0xff, 0xbf, 0xff, 0x9e, 0xf7, 0x7e, 0xf7, 0x20, 0xff, 0xff, 0x84, 0xdf, 0xff, 0x7e, 0xf7, 0x9e, 0xff, 0xbf, 0xff, 0x02, 0xdf, 0xff, 0x05,
+  0xff, 0xff, 0x02, 0xdf, 0xff, 0x8b, 0xbf, 0xff, 0x9e, 0xf7, 0x5d, 0xf7, 0x3d, 0xef, 0x1c, 0xef, 0xfb, 0xe6, 0xbb, 0xde, 0xba, 0xde, 0x9a, 0xd6, 0x79, 0xd6, 0x59, 0xd6, 0x02, 0x59, 0xce, 0x86,
+  0x59, 0xd6, 0x7a, 0xd6, 0xba, 0xde, 0xfb, 0xe6, 0x7d, 0xef, 0xdf, 0xff, 0x18, 0xff, 0xff, 0xa8, 0x7e, 0xf7, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31,
+  0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31,
+  0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31,
+  0x03, 0x65, 0x31, 0x85, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x51, 0x8c, 0x1c, 0xff, 0xff, 0x8d, 0xfb, 0xe6, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31,
+  0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x03, 0x66, 0x31, 0x81, 0xd7, 0xbd, 0x1f, 0xff, 0xff, 0xa4, 0xb6, 0xbd, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31,
+  0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31,
+  0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x49, 0x52, 0x8e, 0x73, 0x14, 0xa5, 0x1c, 0xe7, 0x14, 0xff,
+  0xff, 0x82, 0x5d, 0xef, 0x66, 0x31, 0x29, 0x65, 0x39, 0x81, 0x65, 0x31, 0x02, 0x65, 0x39, 0x82, 0x65, 0x31, 0xb2, 0x9c, 0x1c, 0xff, 0xff, 0x81, 0xcf, 0x7b, 0x02, 0x65, 0x31, 0x0a, 0x65, 0x39,
+  0x02, 0x65, 0x31, 0x82, 0x66, 0x31, 0x6d, 0x73, 0x1f, 0xff, 0xff, 0x82, 0xd7, 0xbd, 0x65, 0x31, 0x1f, 0x65, 0x39, 0x03, 0x66, 0x31, 0x82, 0x0c, 0x63, 0x38, 0xce, 0x12, 0xff, 0xff, 0x82, 0x1c,
+  0xe7, 0x66, 0x31, 0x29, 0x65, 0x39, 0x81, 0x65, 0x31, 0x02, 0x65, 0x39, 0x82, 0x65, 0x31, 0x34, 0xad, 0x1b, 0xff, 0xff, 0x83, 0x3c, 0xef, 0x86, 0x31, 0x65, 0x31, 0x05, 0x65, 0x39, 0x02, 0x66,
+  0x39, 0x07, 0x65, 0x39, 0x82, 0xa6, 0x39, 0x9e, 0xf7, 0x1e, 0xff, 0xff, 0x82, 0xd7, 0xc5, 0x65, 0x31, 0x22, 0x65, 0x39, 0x84, 0x65, 0x31, 0x66, 0x31, 0x6d, 0x73, 0x9e, 0xf7, 0x10, 0xff, 0xff,
+  0x82, 0xfb, 0xde, 0x66, 0x31, 0x2c, 0x65, 0x39, 0x82, 0x65, 0x31, 0x76, 0xb5, 0x1b, 0xff, 0xff, 0x82, 0x10, 0x84, 0x66, 0x31, 0x06, 0x65, 0x39, 0x02, 0x66, 0x39, 0x07, 0x65, 0x39, 0x82, 0x65,
+  0x31, 0x75, 0xb5, 0x1e, 0xff, 0xff, 0x82, 0xd7, 0xc5, 0x66, 0x31, 0x15, 0x65, 0x39, 0x81, 0x65, 0x31, 0x0d, 0x65, 0x39, 0x02, 0x65, 0x31, 0x82, 0x69, 0x52, 0x7d, 0xef, 0x0f, 0xff, 0xff, 0x83,
+  0x9a, 0xd6, 0x66, 0x31, 0x65, 0x31, 0x15, 0x65, 0x39, 0x81, 0x65, 0x31, 0x02, 0x66, 0x39, 0x12, 0x65, 0x39, 0x83, 0x66, 0x39, 0x66, 0x31, 0xd7, 0xc5, 0x1a, 0xff, 0xff, 0x84, 0x3c, 0xef, 0x86,
+  0x39, 0x65, 0x39, 0x65, 0x31, 0x04, 0x65, 0x39, 0x81, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82, 0x85, 0x31, 0x2c, 0x6b, 0x1e, 0xff, 0xff, 0x82, 0xf7, 0xc5, 0x66, 0x31, 0x1b, 0x65, 0x39, 0x02, 0x65,
+  0x31, 0x03, 0x65, 0x39, 0x81, 0x65, 0x31, 0x03, 0x65, 0x39, 0x02, 0x65, 0x31, 0x82, 0xcb, 0x5a, 0xdf, 0xff, 0x0e, 0xff, 0xff, 0x82, 0x38, 0xce, 0x66, 0x31, 0x17, 0x65, 0x39, 0x82, 0x66, 0x39,
+  0x65, 0x31, 0x04, 0x65, 0x39, 0x81, 0x65, 0x31, 0x0d, 0x65, 0x39, 0x83, 0x66, 0x39, 0x66, 0x31, 0x38, 0xce, 0x1a, 0xff, 0xff, 0x82, 0x10, 0x84, 0x65, 0x31, 0x0b, 0x65, 0x39, 0x81, 0x65, 0x31,
+  0x03, 0x65, 0x39, 0x84, 0x65, 0x31, 0x65, 0x39, 0x66, 0x31, 0x5d, 0xf7, 0x1d, 0xff, 0xff, 0x82, 0xd7, 0xbd, 0x66, 0x31, 0x06, 0x65, 0x39, 0x81, 0x65, 0x31, 0x1f, 0x65, 0x39, 0x82, 0x65, 0x31,
+  0xb2, 0x94, 0x0e, 0xff, 0xff, 0x82, 0xf7, 0xc5, 0x66, 0x31, 0x19, 0x65, 0x39, 0x81, 0x65, 0x31, 0x12, 0x65, 0x39, 0x82, 0x66, 0x31, 0x59, 0xd6, 0x19, 0xff, 0xff, 0x83, 0x5d, 0xef, 0x86, 0x39,
+  0x65, 0x31, 0x02, 0x65, 0x39, 0x81, 0x65, 0x31, 0x0e, 0x65, 0x39, 0x82, 0x66, 0x31, 0x34, 0xad, 0x1d, 0xff, 0xff, 0x82, 0xb6, 0xbd, 0x66, 0x31, 0x0c, 0x65, 0x39, 0x09, 0x65, 0x31, 0x12, 0x65,
+  0x39, 0x82, 0xa6, 0x39, 0x7d, 0xef, 0x0d, 0xff, 0xff, 0x91, 0x96, 0xb5, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31,
+  0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x0d, 0x65, 0x39, 0x05, 0x65, 0x31, 0x02, 0x65, 0x39, 0x04, 0x65, 0x31, 0x81, 0x66, 0x31, 0x04, 0x65, 0x31, 0x82, 0x66,
+  0x31, 0x9a, 0xd6, 0x19, 0xff, 0xff, 0x82, 0x10, 0x8c, 0x66, 0x31, 0x12, 0x65, 0x39, 0x82, 0x66, 0x31, 0xcb, 0x62, 0x1d, 0xff, 0xff, 0x82, 0xb6, 0xbd, 0x66, 0x31, 0x0a, 0x65, 0x39, 0x81, 0x2c,
+  0x6b, 0x0a, 0xef, 0x83, 0x86, 0xaf, 0x7b, 0x4d, 0x73, 0xaa, 0x5a, 0xc6, 0x39, 0x66, 0x31, 0x65, 0x31, 0x0c, 0x65, 0x39, 0x82, 0x66, 0x31, 0xb3, 0x9c, 0x0d, 0xff, 0xff, 0x8f, 0xd7, 0xbd, 0x0c,
+  0x6b, 0x4d, 0x6b, 0x6e, 0x73, 0x8e, 0x7b, 0xcf, 0x83, 0x10, 0x84, 0x31, 0x8c, 0x71, 0x94, 0x92, 0x94, 0xb2, 0x9c, 0xd3, 0x9c, 0xd3, 0xa4, 0xf3, 0xa4, 0xf4, 0xa4, 0x02, 0x14, 0xa5, 0x84, 0x51,
+  0x94, 0x66, 0x31, 0x65, 0x39, 0x65, 0x31, 0x08, 0x65, 0x39, 0x81, 0x66, 0x31, 0x04, 0x14, 0xa5, 0x03, 0xf3, 0xa4, 0x8b, 0xd3, 0x9c, 0xb2, 0x9c, 0x92, 0x9c, 0x71, 0x94, 0x31, 0x8c, 0x10, 0x84,
+  0xcf, 0x83, 0x8e, 0x7b, 0x4d, 0x73, 0x2c, 0x63, 0xfc, 0xe6, 0x18, 0xff, 0xff, 0x82, 0x3c, 0xef, 0x86, 0x39, 0x08, 0x65, 0x39, 0x83, 0x65, 0x31, 0x48, 0x4a, 0x86, 0x39, 0x09, 0x65, 0x39, 0x82,
+  0x66, 0x31, 0x1c, 0xef, 0x1c, 0xff, 0xff, 0x82, 0x96, 0xb5, 0x66, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0x59, 0xd6, 0x0e, 0xff, 0xff, 0x83, 0x39, 0xce, 0x4d, 0x6b, 0x65, 0x31, 0x04, 0x65,
+  0x39, 0x81, 0x65, 0x31, 0x06, 0x65, 0x39, 0x82, 0x65, 0x31, 0x8a, 0x52, 0x1e, 0xff, 0xff, 0x82, 0x7a, 0xd6, 0x66, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0xc7, 0x41, 0x2a, 0xff, 0xff, 0x82,
+  0xef, 0x83, 0x65, 0x31, 0x04, 0x65, 0x39, 0x81, 0x65, 0x31, 0x03, 0x65, 0x39, 0x84, 0x65, 0x31, 0x55, 0xb5, 0x6d, 0x73, 0x65, 0x31, 0x08, 0x65, 0x39, 0x82, 0x65, 0x31, 0xd3, 0x9c, 0x1c, 0xff,
+  0xff, 0x82, 0x75, 0xb5, 0x66, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0xba, 0xd6, 0x10, 0xff, 0xff, 0x81, 0x55, 0xb5, 0x0b, 0x65, 0x39, 0x02, 0x65, 0x31, 0x81, 0x9e, 0xf7, 0x1d, 0xff, 0xff,
+  0x82, 0x59, 0xce, 0x66, 0x31, 0x08, 0x65, 0x39, 0x02, 0x65, 0x31, 0x81, 0x49, 0x4a, 0x29, 0xff, 0xff, 0x82, 0x1c, 0xef, 0x86, 0x39, 0x08, 0x65, 0x39, 0x85, 0x66, 0x31, 0x08, 0x4a, 0xff, 0xff,
+  0xb6, 0xbd, 0x65, 0x31, 0x08, 0x65, 0x39, 0x82, 0x65, 0x31, 0x8a, 0x52, 0x1c, 0xff, 0xff, 0x82, 0x35, 0xad, 0x66, 0x31, 0x08, 0x65, 0x39, 0x83, 0x65, 0x31, 0x66, 0x31, 0xfb, 0xde, 0x11, 0xff,
+  0xff, 0x81, 0x92, 0x9c, 0x0b, 0x65, 0x39, 0x82, 0x65, 0x31, 0x79, 0xd6, 0x1d, 0xff, 0xff, 0x82, 0x18, 0xc6, 0x66, 0x31, 0x04, 0x65, 0x39, 0x81, 0x65, 0x31, 0x04, 0x65, 0x39, 0x82, 0x65, 0x31,
+  0xaa, 0x5a, 0x29, 0xff, 0xff, 0x82, 0xcf, 0x83, 0x65, 0x31, 0x08, 0x65, 0x39, 0x85, 0x66, 0x31, 0x34, 0xad, 0xff, 0xff, 0xdf, 0xff, 0xa6, 0x39, 0x09, 0x65, 0x39, 0x82, 0x66, 0x31, 0xdb, 0xde,
+  0x1b, 0xff, 0xff, 0x82, 0x34, 0xad, 0x65, 0x31, 0x03, 0x65, 0x39, 0x81, 0x65, 0x31, 0x05, 0x65, 0x39, 0x82, 0x66, 0x31, 0x3c, 0xef, 0x11, 0xff, 0xff, 0x82, 0xdf, 0xff, 0xc7, 0x41, 0x03, 0x65,
+  0x39, 0x81, 0x65, 0x31, 0x06, 0x65, 0x39, 0x82, 0x65, 0x31, 0xb7, 0xbd, 0x1d, 0xff, 0xff, 0x82, 0xd7, 0xc5, 0x86, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0x0c, 0x6b, 0x28, 0xff, 0xff, 0x82,
+  0xfb, 0xe6, 0x86, 0x39, 0x08, 0x65, 0x39, 0x83, 0x65, 0x31, 0x08, 0x42, 0xdf, 0xff, 0x02, 0xff, 0xff, 0x81, 0x8e, 0x7b, 0x03, 0x65, 0x39, 0x81, 0x65, 0x31, 0x05, 0x65, 0x39, 0x82, 0x65, 0x31,
+  0x72, 0x94, 0x1b, 0xff, 0xff, 0x82, 0xf3, 0xa4, 0x65, 0x31, 0x02, 0x65, 0x39, 0x81, 0x65, 0x31, 0x06, 0x65, 0x39, 0x82, 0x65, 0x31, 0x7d, 0xf7, 0x12, 0xff, 0xff, 0x82, 0xae, 0x7b, 0x65, 0x31,
+  0x02, 0x65, 0x39, 0x02, 0x65, 0x31, 0x05, 0x65, 0x39, 0x82, 0x65, 0x31, 0x55, 0xad, 0x1d, 0xff, 0xff, 0x82, 0xb6, 0xbd, 0x66, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0x6e, 0x73, 0x28, 0xff,
+  0xff, 0x81, 0x8e, 0x7b, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0xd3, 0xa4, 0x03, 0xff, 0xff, 0x82, 0xd7, 0xc5, 0x65, 0x31, 0x08, 0x65, 0x39, 0x82, 0x65, 0x31, 0x28, 0x4a, 0x1b, 0xff, 0xff, 0x82,
+  0xd3, 0x9c, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82, 0x66, 0x31, 0xbe, 0xff, 0x12, 0xff, 0xff, 0x82, 0xd3, 0x9c, 0x65, 0x31, 0x03, 0x65, 0x39, 0x81, 0x65, 0x31, 0x04, 0x65, 0x39, 0x02, 0x65, 0x31,
+  0x81, 0x76, 0xb5, 0x1d, 0xff, 0xff, 0x82, 0x75, 0xb5, 0x66, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0xef, 0x83, 0x27, 0xff, 0xff, 0x83, 0xbb, 0xde, 0x66, 0x31, 0x65, 0x31, 0x07, 0x65, 0x39,
+  0x83, 0x65, 0x31, 0xc7, 0x41, 0xbe, 0xff, 0x03, 0xff, 0xff, 0x82, 0xdf, 0xff, 0xc7, 0x39, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0x7a, 0xd6, 0x1a, 0xff, 0xff, 0x82, 0x92, 0x9c, 0x65, 0x31, 0x05,
+  0x65, 0x39, 0x81, 0x65, 0x31, 0x03, 0x65, 0x39, 0x81, 0x66, 0x31, 0x13, 0xff, 0xff, 0x82, 0xf4, 0xa4, 0x66, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0xf8, 0xc5, 0x1d, 0xff, 0xff, 0x82, 0x34,
+  0xad, 0x66, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0x51, 0x94, 0x27, 0xff, 0xff, 0x82, 0x4d, 0x73, 0x66, 0x39, 0x08, 0x65, 0x39, 0x82, 0x65, 0x31, 0xb2, 0x9c, 0x05, 0xff, 0xff, 0x81, 0xcf,
+  0x7b, 0x06, 0x65, 0x39, 0x81, 0x65, 0x31, 0x02, 0x65, 0x39, 0x82, 0x65, 0x31, 0x30, 0x8c, 0x1a, 0xff, 0xff, 0x82, 0x71, 0x94, 0x65, 0x31, 0x05, 0x65, 0x39, 0x02, 0x65, 0x31, 0x02, 0x65, 0x39,
+  0x81, 0xa6, 0x39, 0x13, 0xff, 0xff, 0x85, 0x92, 0x94, 0x66, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x06, 0x65, 0x39, 0x82, 0x66, 0x31, 0xdb, 0xde, 0x1d, 0xff, 0xff, 0x82, 0xf4, 0xa4, 0x66,
+  0x39, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0xb2, 0x9c, 0x26, 0xff, 0xff, 0x82, 0x9a, 0xd6, 0x66, 0x39, 0x08, 0x65, 0x39, 0x83, 0x65, 0x31, 0xc7, 0x39, 0x9e, 0xf7, 0x05, 0xff, 0xff, 0x82, 0x18,
+  0xc6, 0x65, 0x31, 0x08, 0x65, 0x39, 0x82, 0x65, 0x31, 0xe8, 0x41, 0x1a, 0xff, 0xff, 0x82, 0x31, 0x8c, 0x65, 0x31, 0x05, 0x65, 0x39, 0x02, 0x65, 0x31, 0x02, 0x65, 0x39, 0x81, 0xe7, 0x41, 0x13,
+  0xff, 0xff, 0x81, 0x2d, 0x6b, 0x02, 0x65, 0x39, 0x81, 0x65, 0x31, 0x06, 0x65, 0x39, 0x82, 0x66, 0x39, 0xa7, 0x39, 0x1e, 0xff, 0xff, 0x82, 0xd3, 0xa4, 0x66, 0x39, 0x06, 0x65, 0x39, 0x81, 0x65,
+  0x31, 0x02, 0x65, 0x39, 0x82, 0x65, 0x31, 0xf3, 0xa4, 0x26, 0xff, 0xff, 0x81, 0x0c, 0x63, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0x92, 0x94, 0x06, 0xff, 0xff, 0x82, 0xdf, 0xff, 0xc7, 0x41, 0x09,
+  0x65, 0x39, 0x82, 0x66, 0x31, 0x18, 0xc6, 0x19, 0xff, 0xff, 0x82, 0x10, 0x84, 0x65, 0x31, 0x05, 0x65, 0x39, 0x03, 0x65, 0x31, 0x82, 0x65, 0x39, 0x29, 0x4a, 0x12, 0xff, 0xff, 0x82, 0x9e, 0xf7,
+  0xa6, 0x39, 0x09, 0x65, 0x39, 0x82, 0x66, 0x39, 0x4d, 0x73, 0x1e, 0xff, 0xff, 0x82, 0x92, 0x9c, 0x66, 0x39, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0x34, 0xad, 0x25, 0xff, 0xff, 0x82, 0x38, 0xce,
+  0x66, 0x31, 0x08, 0x65, 0x39, 0x83, 0x65, 0x31, 0xc6, 0x39, 0x9e, 0xf7, 0x07, 0xff, 0xff, 0x82, 0xef, 0x83, 0x66, 0x31, 0x03, 0x65, 0x39, 0x81, 0x65, 0x31, 0x04, 0x65, 0x39, 0x82, 0x66, 0x31,
+  0x8e, 0x7b, 0x19, 0xff, 0xff, 0x82, 0xcf, 0x7b, 0x65, 0x31, 0x05, 0x65, 0x39, 0x02, 0x65, 0x31, 0x02, 0x65, 0x39, 0x81, 0x6a, 0x52, 0x12, 0xff, 0xff, 0x83, 0xb3, 0x9c, 0x65, 0x31, 0x65, 0x39,
+  0x02, 0x65, 0x31, 0x06, 0x65, 0x39, 0x82, 0x65, 0x31, 0xb6, 0xbd, 0x1e, 0xff, 0xff, 0x82, 0x51, 0x94, 0x66, 0x39, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0x76, 0xb5, 0x25, 0xff, 0xff, 0x82, 0xcb,
+  0x62, 0x66, 0x39, 0x07, 0x65, 0x39, 0x02, 0x65, 0x31, 0x81, 0x71, 0x94, 0x08, 0xff, 0xff, 0x82, 0x38, 0xce, 0x66, 0x31, 0x08, 0x65, 0x39, 0x83, 0x66, 0x31, 0xa6, 0x39, 0x9e, 0xf7, 0x18, 0xff,
+  0xff, 0x82, 0x8e, 0x7b, 0x65, 0x31, 0x06, 0x65, 0x39, 0x84, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0xab, 0x5a, 0x11, 0xff, 0xff, 0x82, 0xdb, 0xde, 0x86, 0x39, 0x02, 0x65, 0x39, 0x02, 0x65, 0x31,
+  0x05, 0x65, 0x39, 0x83, 0x65, 0x31, 0x28, 0x4a, 0xdf, 0xff, 0x1e, 0xff, 0xff, 0x82, 0x30, 0x8c, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0xb7, 0xbd, 0x24, 0xff, 0xff, 0x82, 0xf7, 0xc5,
+  0x66, 0x31, 0x09, 0x65, 0x39, 0x82, 0xa6, 0x39, 0x7d, 0xf7, 0x09, 0xff, 0xff, 0x81, 0xe7, 0x41, 0x09, 0x65, 0x39, 0x82, 0x66, 0x31, 0x55, 0xb5, 0x18, 0xff, 0xff, 0x82, 0x4d, 0x73, 0x65, 0x31,
+  0x08, 0x65, 0x39, 0x82, 0x65, 0x31, 0xec, 0x62, 0x10, 0xff, 0xff, 0x82, 0xfb, 0xe6, 0x08, 0x4a, 0x0a, 0x65, 0x39, 0x82, 0x65, 0x31, 0xb6, 0xbd, 0x1f, 0xff, 0xff, 0x82, 0xef, 0x83, 0x65, 0x31,
+  0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0xf8, 0xc5, 0x24, 0xff, 0xff, 0x82, 0x8a, 0x52, 0x65, 0x31, 0x08, 0x65, 0x39, 0x82, 0x65, 0x31, 0x71, 0x94, 0x0a, 0xff, 0xff, 0x84, 0x10, 0x8c, 0x65, 0x31,
+  0x65, 0x39, 0x65, 0x31, 0x06, 0x65, 0x39, 0x82, 0x65, 0x31, 0xeb, 0x62, 0x18, 0xff, 0xff, 0x82, 0x2c, 0x6b, 0x66, 0x39, 0x09, 0x65, 0x39, 0x81, 0x2c, 0x6b, 0x0e, 0xff, 0xff, 0x84, 0x5d, 0xf7,
+  0xb2, 0x9c, 0xa7, 0x39, 0x65, 0x31, 0x06, 0x65, 0x39, 0x81, 0x65, 0x31, 0x02, 0x65, 0x39, 0x82, 0x65, 0x31, 0x8e, 0x73, 0x20, 0xff, 0xff, 0x82, 0xaf, 0x7b, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82,
+  0x65, 0x31, 0x39, 0xce, 0x23, 0xff, 0xff, 0x82, 0xb6, 0xbd, 0x65, 0x31, 0x08, 0x65, 0x39, 0x83, 0x65, 0x31, 0xa6, 0x39, 0x7d, 0xf7, 0x0a, 0xff, 0xff, 0x82, 0x59, 0xce, 0x65, 0x31, 0x09, 0x65,
+  0x39, 0x82, 0x66, 0x31, 0x1c, 0xe7, 0x17, 0xff, 0xff, 0x82, 0xeb, 0x62, 0x66, 0x31, 0x09, 0x65, 0x39, 0x81, 0x0c, 0x6b, 0x07, 0xdb, 0xde, 0x88, 0xbb, 0xde, 0xba, 0xde, 0x9a, 0xd6, 0x38, 0xce,
+  0x96, 0xbd, 0x92, 0x94, 0xeb, 0x62, 0x85, 0x31, 0x02, 0x65, 0x31, 0x06, 0x65, 0x39, 0x81, 0x65, 0x31, 0x02, 0x65, 0x39, 0x83, 0x65, 0x31, 0xcb, 0x5a, 0xbf, 0xff, 0x20, 0xff, 0xff, 0x82, 0x8e,
+  0x73, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0x7a, 0xd6, 0x23, 0xff, 0xff, 0x82, 0x69, 0x52, 0x65, 0x31, 0x08, 0x65, 0x39, 0x82, 0x66, 0x31, 0x51, 0x8c, 0x0c, 0xff, 0xff, 0x81, 0x08,
+  0x4a, 0x09, 0x65, 0x39, 0x82, 0x66, 0x31, 0xb2, 0x9c, 0x17, 0xff, 0xff, 0x82, 0xaa, 0x5a, 0x65, 0x31, 0x09, 0x65, 0x39, 0x0d, 0x66, 0x31, 0x81, 0x66, 0x39, 0x0c, 0x65, 0x39, 0x83, 0x65, 0x31,
+  0x4d, 0x73, 0xbe, 0xff, 0x21, 0xff, 0xff, 0x82, 0x4d, 0x73, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0xbb, 0xde, 0x22, 0xff, 0xff, 0x82, 0x75, 0xb5, 0x65, 0x31, 0x08, 0x65, 0x39, 0x83,
+  0x65, 0x31, 0xa6, 0x39, 0x5d, 0xef, 0x0c, 0xff, 0xff, 0x82, 0x30, 0x8c, 0x66, 0x31, 0x08, 0x65, 0x39, 0x82, 0x65, 0x31, 0x49, 0x4a, 0x17, 0xff, 0xff, 0x82, 0x6a, 0x52, 0x65, 0x31, 0x0c, 0x65,
+  0x39, 0x85, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x05, 0x65, 0x39, 0x81, 0x65, 0x31, 0x0a, 0x65, 0x39, 0x83, 0x66, 0x31, 0xa7, 0x39, 0xf3, 0xa4, 0x23, 0xff, 0xff, 0x82,
+  0x0c, 0x6b, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0xfc, 0xe6, 0x21, 0xff, 0xff, 0x83, 0xdf, 0xff, 0x28, 0x4a, 0x65, 0x31, 0x08, 0x65, 0x39, 0x82, 0x65, 0x31, 0x30, 0x8c, 0x0d, 0xff,
+  0xff, 0x82, 0x79, 0xd6, 0x66, 0x31, 0x03, 0x65, 0x39, 0x81, 0x65, 0x31, 0x03, 0x65, 0x39, 0x03, 0x65, 0x31, 0x81, 0x79, 0xd6, 0x16, 0xff, 0xff, 0x81, 0x49, 0x4a, 0x07, 0x65, 0x39, 0x81, 0x65,
+  0x31, 0x19, 0x65, 0x39, 0x83, 0xc6, 0x39, 0x51, 0x94, 0x5d, 0xef, 0x24, 0xff, 0xff, 0x81, 0xcb, 0x62, 0x0a, 0x65, 0x39, 0x82, 0x65, 0x31, 0x5d, 0xef, 0x21, 0xff, 0xff, 0x82, 0x14, 0xad, 0x65,
+  0x31, 0x09, 0x65, 0x39, 0x82, 0xa6, 0x39, 0x5d, 0xef, 0x0e, 0xff, 0xff, 0x81, 0x28, 0x4a, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0xf0, 0x83, 0x16, 0xff, 0xff, 0x81, 0x08, 0x42, 0x10, 0x65, 0x39,
+  0x05, 0x66, 0x39, 0x81, 0x66, 0x31, 0x0a, 0x65, 0x39, 0x82, 0xf0, 0x83, 0x7e, 0xf7, 0x26, 0xff, 0xff, 0x81, 0x6a, 0x52, 0x0a, 0x65, 0x39, 0x82, 0x65, 0x31, 0x9e, 0xf7, 0x20, 0xff, 0xff, 0x83,
+  0xbe, 0xff, 0x07, 0x42, 0x65, 0x31, 0x09, 0x65, 0x39, 0x83, 0x86, 0x39, 0x49, 0x52, 0x49, 0x4a, 0x03, 0x49, 0x52, 0x02, 0x29, 0x4a, 0x82, 0x49, 0x4a, 0x49, 0x52, 0x03, 0x49, 0x4a, 0x03, 0x49,
+  0x52, 0x81, 0xa7, 0x39, 0x0a, 0x65, 0x39, 0x82, 0xc7, 0x41, 0xdf, 0xff, 0x15, 0xff, 0xff, 0x81, 0xc7, 0x41, 0x10, 0x65, 0x39, 0x05, 0x66, 0x39, 0x81, 0x66, 0x31, 0x02, 0x65, 0x31, 0x08, 0x65,
+  0x39, 0x84, 0x66, 0x31, 0xa6, 0x39, 0x4d, 0x73, 0xb6, 0xbd, 0x24, 0xff, 0xff, 0x81, 0x28, 0x4a, 0x02, 0x65, 0x39, 0x81, 0x65, 0x31, 0x06, 0x65, 0x39, 0x02, 0x65, 0x31, 0x81, 0xdf, 0xff, 0x20,
+  0xff, 0xff, 0x81, 0xd3, 0xa4, 0x09, 0x65, 0x39, 0x81, 0x65, 0x31, 0x03, 0x65, 0x39, 0x81, 0x65, 0x31, 0x05, 0x65, 0x39, 0x81, 0x65, 0x31, 0x10, 0x65, 0x39, 0x84, 0x65, 0x31, 0x65, 0x39, 0x66,
+  0x31, 0xb6, 0xbd, 0x15, 0xff, 0xff, 0x81, 0x86, 0x31, 0x0a, 0x65, 0x39, 0x81, 0x65, 0x31, 0x10, 0x65, 0x39, 0x03, 0x65, 0x31, 0x04, 0x65, 0x39, 0x02, 0x65, 0x31, 0x82, 0x69, 0x52, 0x18, 0xce,
+  0x22, 0xff, 0xff, 0x81, 0xc7, 0x41, 0x0a, 0x65, 0x39, 0x81, 0x85, 0x31, 0x20, 0xff, 0xff, 0x82, 0x9e, 0xf7, 0xe7, 0x41, 0x1e, 0x65, 0x39, 0x81, 0x65, 0x31, 0x08, 0x65, 0x39, 0x81, 0x4d, 0x6b,
+  0x15, 0xff, 0xff, 0x81, 0x65, 0x31, 0x06, 0x65, 0x39, 0x81, 0x65, 0x31, 0x07, 0x65, 0x39, 0x87, 0x66, 0x39, 0x65, 0x39, 0x66, 0x39, 0x65, 0x39, 0x66, 0x39, 0x65, 0x39, 0x66, 0x31, 0x04, 0x65,
+  0x31, 0x03, 0x65, 0x39, 0x02, 0x65, 0x31, 0x03, 0x65, 0x39, 0x86, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x51, 0x8c, 0x21, 0xff, 0xff, 0x81, 0x66, 0x31, 0x0a, 0x65, 0x39,
+  0x81, 0xc6, 0x39, 0x20, 0xff, 0xff, 0x82, 0x92, 0x94, 0x85, 0x31, 0x03, 0x65, 0x39, 0x81, 0x65, 0x31, 0x06, 0x65, 0x39, 0x02, 0x66, 0x39, 0x1b, 0x65, 0x39, 0x82, 0x66, 0x31, 0x5d, 0xf7, 0x13,
+  0xff, 0xff, 0x82, 0xbe, 0xf7, 0x66, 0x31, 0x0a, 0x65, 0x39, 0x81, 0xab, 0x5a, 0x03, 0x6d, 0x73, 0x85, 0x6e, 0x73, 0x6d, 0x73, 0x6e, 0x73, 0x6d, 0x73, 0x6e, 0x73, 0x02, 0x6d, 0x73, 0x85, 0x4d,
+  0x6b, 0x0c, 0x6b, 0xaa, 0x5a, 0xc7, 0x41, 0x66, 0x31, 0x02, 0x65, 0x31, 0x06, 0x65, 0x39, 0x81, 0x65, 0x31, 0x03, 0x65, 0x39, 0x82, 0x66, 0x31, 0xcf, 0x7b, 0x1f, 0xff, 0xff, 0x82, 0xdf, 0xff,
+  0x65, 0x31, 0x0a, 0x65, 0x39, 0x81, 0x07, 0x42, 0x1f, 0xff, 0xff, 0x82, 0x7d, 0xf7, 0xc6, 0x39, 0x0b, 0x65, 0x39, 0x81, 0x66, 0x39, 0x06, 0x65, 0x39, 0x81, 0x65, 0x31, 0x06, 0x65, 0x39, 0x02,
+  0x65, 0x31, 0x02, 0x65, 0x39, 0x81, 0x65, 0x31, 0x05, 0x65, 0x39, 0x81, 0x65, 0x31, 0x05, 0x65, 0x39, 0x81, 0x14, 0xa5, 0x13, 0xff, 0xff, 0x82, 0x7d, 0xf7, 0x66, 0x31, 0x07, 0x65, 0x39, 0x84,
+  0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0xd7, 0xc5, 0x0e, 0xff, 0xff, 0x84, 0x1c, 0xef, 0x14, 0xad, 0x48, 0x4a, 0x65, 0x31, 0x0a, 0x65, 0x39, 0x82, 0x66, 0x31, 0xb3, 0x9c, 0x1e, 0xff, 0xff, 0x82,
+  0x7d, 0xf7, 0x66, 0x31, 0x0a, 0x65, 0x39, 0x81, 0x48, 0x4a, 0x1f, 0xff, 0xff, 0x82, 0x51, 0x8c, 0x65, 0x31, 0x25, 0x65, 0x39, 0x81, 0x65, 0x31, 0x03, 0x65, 0x39, 0x81, 0x8a, 0x5a, 0x13, 0xff,
+  0xff, 0x82, 0x3c, 0xe7, 0x66, 0x31, 0x07, 0x65, 0x39, 0x84, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x38, 0xce, 0x10, 0xff, 0xff, 0x83, 0xdf, 0xff, 0x51, 0x8c, 0x65, 0x31, 0x05, 0x65, 0x39, 0x03,
+  0x65, 0x31, 0x02, 0x65, 0x39, 0x82, 0x86, 0x39, 0xbb, 0xde, 0x1d, 0xff, 0xff, 0x82, 0x1c, 0xef, 0x66, 0x31, 0x0a, 0x65, 0x39, 0x81, 0x8a, 0x5a, 0x1e, 0xff, 0xff, 0x83, 0x5d, 0xef, 0xa6, 0x39,
+  0x65, 0x31, 0x25, 0x65, 0x39, 0x81, 0x65, 0x31, 0x03, 0x65, 0x39, 0x82, 0x66, 0x31, 0xdb, 0xde, 0x12, 0xff, 0xff, 0x82, 0xdb, 0xe6, 0x66, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0x79, 0xd6,
+  0x12, 0xff, 0xff, 0x82, 0x92, 0x94, 0x66, 0x39, 0x04, 0x65, 0x39, 0x81, 0x65, 0x31, 0x04, 0x65, 0x39, 0x82, 0x65, 0x31, 0x2c, 0x6b, 0x1d, 0xff, 0xff, 0x82, 0xbb, 0xde, 0x65, 0x31, 0x0a, 0x65,
+  0x39, 0x81, 0xcb, 0x62, 0x1e, 0xff, 0xff, 0x82, 0x10, 0x84, 0x65, 0x31, 0x03, 0x65, 0x39, 0x81, 0x65, 0x31, 0x04, 0x65, 0x39, 0x82, 0x65, 0x31, 0x66, 0x39, 0x05, 0x65, 0x31, 0x05, 0x66, 0x31,
+  0x02, 0x65, 0x31, 0x04, 0x66, 0x31, 0x02, 0x65, 0x31, 0x02, 0x66, 0x31, 0x02, 0x65, 0x31, 0x03, 0x65, 0x39, 0x81, 0x65, 0x31, 0x06, 0x65, 0x39, 0x82, 0x65, 0x31, 0x51, 0x94, 0x12, 0xff, 0xff,
+  0x82, 0xba, 0xde, 0x66, 0x31, 0x02, 0x65, 0x39, 0x02, 0x65, 0x31, 0x03, 0x65, 0x39, 0x84, 0x65, 0x31, 0x65, 0x39, 0x66, 0x31, 0xba, 0xd6, 0x13, 0xff, 0xff, 0x82, 0xcb, 0x62, 0x66, 0x31, 0x08,
+  0x65, 0x39, 0x83, 0x65, 0x31, 0x85, 0x31, 0xfc, 0xe6, 0x1c, 0xff, 0xff, 0x86, 0x79, 0xd6, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x06, 0x65, 0x39, 0x81, 0x0c, 0x6b, 0x1d,
+  0xff, 0xff, 0x83, 0x1c, 0xe7, 0x86, 0x39, 0x65, 0x31, 0x08, 0x65, 0x39, 0x83, 0x66, 0x39, 0x65, 0x31, 0xef, 0x83, 0x14, 0x30, 0x8c, 0x81, 0x0c, 0x6b, 0x06, 0x65, 0x39, 0x81, 0x65, 0x31, 0x03,
+  0x65, 0x39, 0x82, 0x65, 0x31, 0x08, 0x4a, 0x12, 0xff, 0xff, 0x82, 0x59, 0xd6, 0x65, 0x31, 0x02, 0x65, 0x39, 0x02, 0x65, 0x31, 0x02, 0x65, 0x39, 0x02, 0x65, 0x31, 0x83, 0x65, 0x39, 0x66, 0x31,
+  0xfc, 0xe6, 0x13, 0xff, 0xff, 0x83, 0x18, 0xc6, 0x66, 0x31, 0x65, 0x31, 0x08, 0x65, 0x39, 0x82, 0x65, 0x31, 0xf3, 0xa4, 0x1c, 0xff, 0xff, 0x82, 0x18, 0xc6, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82,
+  0x66, 0x31, 0x4d, 0x73, 0x1d, 0xff, 0xff, 0x82, 0xaf, 0x7b, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0x0c, 0x6b, 0x15, 0xff, 0xff, 0x82, 0x1c, 0xe7, 0x65, 0x31, 0x0a, 0x65, 0x39, 0x82,
+  0x65, 0x31, 0x18, 0xce, 0x11, 0xff, 0xff, 0x82, 0x38, 0xce, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82, 0x66, 0x31, 0x3c, 0xef, 0x13, 0xff, 0xff, 0x83, 0xdf, 0xff, 0x86, 0x39, 0x65, 0x31, 0x06, 0x65,
+  0x39, 0x84, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x4d, 0x6b, 0x1c, 0xff, 0xff, 0x82, 0xd7, 0xbd, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82, 0x66, 0x31, 0x8e, 0x7b, 0x1c, 0xff, 0xff, 0x82, 0xdb, 0xe6,
+  0x66, 0x31, 0x05, 0x65, 0x39, 0x81, 0x65, 0x31, 0x04, 0x65, 0x39, 0x82, 0x66, 0x31, 0x59, 0xd6, 0x16, 0xff, 0xff, 0x81, 0xeb, 0x62, 0x0a, 0x65, 0x39, 0x82, 0x65, 0x31, 0xae, 0x7b, 0x11, 0xff,
+  0xff, 0x84, 0xd7, 0xc5, 0x66, 0x31, 0x65, 0x39, 0x65, 0x31, 0x07, 0x65, 0x39, 0x82, 0x65, 0x31, 0x7e, 0xf7, 0x14, 0xff, 0xff, 0x82, 0x8a, 0x52, 0x65, 0x31, 0x03, 0x65, 0x39, 0x82, 0x65, 0x31,
+  0x65, 0x39, 0x02, 0x65, 0x31, 0x83, 0x65, 0x39, 0x65, 0x31, 0x08, 0x4a, 0x1c, 0xff, 0xff, 0x82, 0x75, 0xb5, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82, 0x66, 0x31, 0xcf, 0x83, 0x1c, 0xff, 0xff, 0x82,
+  0x6d, 0x73, 0x66, 0x31, 0x08, 0x65, 0x39, 0x83, 0x65, 0x31, 0x65, 0x39, 0xeb, 0x62, 0x17, 0xff, 0xff, 0x82, 0x55, 0xb5, 0x66, 0x31, 0x02, 0x65, 0x39, 0x02, 0x65, 0x31, 0x05, 0x65, 0x39, 0x83,
+  0x65, 0x31, 0xa6, 0x39, 0xbe, 0xf7, 0x10, 0xff, 0xff, 0x82, 0x96, 0xb5, 0x66, 0x31, 0x08, 0x65, 0x39, 0x02, 0x65, 0x31, 0x81, 0xbf, 0xff, 0x14, 0xff, 0xff, 0x82, 0xcb, 0x5a, 0x65, 0x31, 0x02,
+  0x65, 0x39, 0x81, 0x65, 0x31, 0x02, 0x65, 0x39, 0x02, 0x65, 0x31, 0x02, 0x65, 0x39, 0x81, 0x66, 0x31, 0x1c, 0xff, 0xff, 0x82, 0x34, 0xa5, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82, 0x66, 0x31, 0x10,
+  0x8c, 0x1b, 0xff, 0xff, 0x81, 0xba, 0xd6, 0x02, 0x66, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0x39, 0xce, 0x17, 0xff, 0xff, 0x82, 0x9e, 0xf7, 0xa6, 0x39, 0x03, 0x65, 0x39, 0x81, 0x65, 0x31,
+  0x06, 0x65, 0x39, 0x82, 0x66, 0x31, 0x75, 0xb5, 0x10, 0xff, 0xff, 0x82, 0x55, 0xad, 0x66, 0x31, 0x03, 0x65, 0x39, 0x81, 0x65, 0x31, 0x05, 0x65, 0x39, 0x81, 0x65, 0x31, 0x15, 0xff, 0xff, 0x82,
+  0x69, 0x52, 0x65, 0x31, 0x05, 0x65, 0x39, 0x02, 0x65, 0x31, 0x02, 0x65, 0x39, 0x82, 0x66, 0x31, 0x9e, 0xf7, 0x1b, 0xff, 0xff, 0x82, 0xb3, 0x9c, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82, 0x66, 0x31,
+  0x71, 0x94, 0x1b, 0xff, 0xff, 0x82, 0x2c, 0x6b, 0x66, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0xcb, 0x5a, 0x19, 0xff, 0xff, 0x81, 0x6e, 0x73, 0x0a, 0x65, 0x39, 0x82, 0x65, 0x31, 0xec, 0x62,
+  0x10, 0xff, 0xff, 0x82, 0xf3, 0xa4, 0x66, 0x31, 0x09, 0x65, 0x39, 0x81, 0xa6, 0x39, 0x14, 0xff, 0xff, 0x83, 0xdf, 0xff, 0x86, 0x39, 0x65, 0x31, 0x02, 0x65, 0x39, 0x81, 0x66, 0x39, 0x02, 0x65,
+  0x39, 0x02, 0x66, 0x31, 0x02, 0x65, 0x39, 0x82, 0x66, 0x31, 0xbe, 0xff, 0x1b, 0xff, 0xff, 0x82, 0x71, 0x94, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82, 0x66, 0x31, 0x92, 0x9c, 0x1a, 0xff, 0xff, 0x82,
+  0x79, 0xd6, 0x66, 0x31, 0x0a, 0x65, 0x39, 0x82, 0x65, 0x31, 0xd7, 0xc5, 0x19, 0xff, 0xff, 0x82, 0xd7, 0xc5, 0x66, 0x39, 0x09, 0x65, 0x39, 0x83, 0x65, 0x31, 0x85, 0x31, 0x3c, 0xe7, 0x0f, 0xff,
+  0xff, 0x82, 0x92, 0x9c, 0x66, 0x31, 0x04, 0x65, 0x39, 0x81, 0x65, 0x31, 0x04, 0x65, 0x39, 0x81, 0xe7, 0x41, 0x14, 0xff, 0xff, 0x82, 0x39, 0xce, 0x65, 0x31, 0x03, 0x65, 0x39, 0x81, 0x66, 0x39,
+  0x02, 0x65, 0x39, 0x82, 0x66, 0x31, 0x66, 0x39, 0x02, 0x65, 0x39, 0x81, 0x86, 0x39, 0x1c, 0xff, 0xff, 0x82, 0x10, 0x8c, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82, 0x66, 0x31, 0xd3, 0xa4, 0x1a, 0xff,
+  0xff, 0x82, 0xeb, 0x62, 0x65, 0x31, 0x0a, 0x65, 0x39, 0x81, 0x8a, 0x52, 0x1a, 0xff, 0xff, 0x82, 0xdf, 0xff, 0xc7, 0x41, 0x0a, 0x65, 0x39, 0x82, 0x65, 0x31, 0xb3, 0x9c, 0x0f, 0xff, 0xff, 0x82,
+  0x30, 0x8c, 0x66, 0x31, 0x04, 0x65, 0x39, 0x81, 0x65, 0x31, 0x03, 0x65, 0x39, 0x82, 0x66, 0x39, 0x28, 0x4a, 0x14, 0xff, 0xff, 0x81, 0xae, 0x7b, 0x05, 0x65, 0x39, 0x81, 0x65, 0x31, 0x02, 0x65,
+  0x39, 0x84, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x69, 0x52, 0x1c, 0xff, 0xff, 0x82, 0xcf, 0x7b, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82, 0x66, 0x31, 0x34, 0xad, 0x19, 0xff, 0xff, 0x81, 0x18, 0xc6,
+  0x02, 0x65, 0x31, 0x0a, 0x65, 0x39, 0x81, 0x96, 0xb5, 0x1b, 0xff, 0xff, 0x81, 0xcf, 0x83, 0x0a, 0x65, 0x39, 0x82, 0x65, 0x31, 0x49, 0x52, 0x0f, 0xff, 0xff, 0x82, 0xcf, 0x7b, 0x66, 0x31, 0x08,
+  0x65, 0x39, 0x82, 0x66, 0x39, 0x69, 0x52, 0x13, 0xff, 0xff, 0x82, 0xba, 0xde, 0x85, 0x31, 0x0a, 0x65, 0x39, 0x82, 0x65, 0x31, 0xae, 0x7b, 0x1c, 0xff, 0xff, 0x82, 0x4d, 0x6b, 0x65, 0x31, 0x09,
+  0x65, 0x39, 0x82, 0x66, 0x31, 0x75, 0xb5, 0x19, 0xff, 0xff, 0x84, 0x8a, 0x5a, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x03, 0x65, 0x39, 0x81, 0x85, 0x31, 0x04, 0x65, 0x39, 0x81, 0x48, 0x4a, 0x1c,
+  0xff, 0xff, 0x82, 0x38, 0xce, 0x66, 0x31, 0x0a, 0x65, 0x39, 0x82, 0x65, 0x31, 0x7a, 0xd6, 0x0e, 0xff, 0xff, 0x81, 0x4d, 0x73, 0x06, 0x65, 0x39, 0x81, 0x65, 0x31, 0x02, 0x65, 0x39, 0x82, 0x66,
+  0x31, 0xaa, 0x5a, 0x12, 0xff, 0xff, 0x83, 0x7d, 0xf7, 0x69, 0x52, 0x65, 0x31, 0x04, 0x65, 0x39, 0x03, 0x65, 0x31, 0x03, 0x65, 0x39, 0x82, 0x65, 0x31, 0x96, 0xb5, 0x1c, 0xff, 0xff, 0x81, 0xcb,
+  0x5a, 0x0a, 0x65, 0x39, 0x82, 0x66, 0x31, 0x75, 0xb5, 0x18, 0xff, 0xff, 0x82, 0x96, 0xbd, 0x66, 0x31, 0x06, 0x65, 0x39, 0x02, 0x65, 0x31, 0x02, 0x65, 0x39, 0x82, 0x65, 0x31, 0x34, 0xad, 0x1d,
+  0xff, 0xff, 0x82, 0xe7, 0x41, 0x65, 0x31, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0x10, 0x8c, 0x0e, 0xff, 0xff, 0x81, 0xcb, 0x62, 0x09, 0x65, 0x39, 0x82, 0x66, 0x31, 0xec, 0x62, 0x11, 0xff, 0xff,
+  0x83, 0x38, 0xce, 0x49, 0x4a, 0x66, 0x31, 0x06, 0x65, 0x39, 0x02, 0x65, 0x31, 0x03, 0x65, 0x39, 0x82, 0x86, 0x39, 0x7e, 0xf7, 0x1c, 0xff, 0xff, 0x81, 0x49, 0x52, 0x0a, 0x65, 0x39, 0x82, 0x66,
+  0x31, 0x96, 0xbd, 0x18, 0xff, 0xff, 0x81, 0x49, 0x52, 0x07, 0x65, 0x39, 0x02, 0x65, 0x31, 0x02, 0x65, 0x39, 0x82, 0xe7, 0x41, 0xbf, 0xff, 0x1d, 0xff, 0xff, 0x82, 0x10, 0x84, 0x65, 0x31, 0x0a,
+  0x65, 0x39, 0x82, 0xe7, 0x41, 0xdf, 0xff, 0x0d, 0xff, 0xff, 0x81, 0x69, 0x52, 0x09, 0x65, 0x39, 0x82, 0x65, 0x31, 0x2c, 0x6b, 0x0e, 0xff, 0xff, 0x83, 0x5d, 0xf7, 0x55, 0xb5, 0xcb, 0x62, 0x02,
+  0x66, 0x31, 0x07, 0x65, 0x39, 0x02, 0x65, 0x31, 0x02, 0x65, 0x39, 0x82, 0x65, 0x31, 0xef, 0x83, 0x1d, 0xff, 0xff, 0x81, 0xc7, 0x41, 0x0a, 0x65, 0x39, 0x82, 0x66, 0x31, 0xb7, 0xbd, 0x17, 0xff,
+  0xff, 0x82, 0x34, 0xad, 0x65, 0x31, 0x07, 0x65, 0x39, 0x81, 0x65, 0x31, 0x03, 0x65, 0x39, 0x81, 0xb3, 0x9c, 0x1e, 0xff, 0xff, 0x82, 0x59, 0xce, 0x66, 0x31, 0x0a, 0x65, 0x39, 0x82, 0x65, 0x31,
+  0xd7, 0xbd, 0x0d, 0xff, 0xff, 0x81, 0xe7, 0x41, 0x09, 0x65, 0x39, 0x83, 0x65, 0x31, 0x28, 0x4a, 0x10, 0x8c, 0x09, 0x10, 0x84, 0x84, 0xcf, 0x83, 0x8e, 0x73, 0x0c, 0x6b, 0x28, 0x4a, 0x02, 0x66,
+  0x31, 0x02, 0x66, 0x39, 0x03, 0x65, 0x39, 0x81, 0x65, 0x31, 0x04, 0x65, 0x39, 0x81, 0x65, 0x31, 0x03, 0x65, 0x39, 0x82, 0xa6, 0x39, 0x3c, 0xef, 0x1d, 0xff, 0xff, 0x81, 0x86, 0x31, 0x0a, 0x65,
+  0x39, 0x82, 0x66, 0x31, 0xd7, 0xc5, 0x16, 0xff, 0xff, 0x83, 0xbe, 0xff, 0xe7, 0x41, 0x65, 0x31, 0x0a, 0x65, 0x39, 0x82, 0xa6, 0x39, 0x9e, 0xf7, 0x1f, 0xff, 0xff, 0x84, 0xe8, 0x41, 0x66, 0x31,
+  0x65, 0x39, 0x65, 0x31, 0x07, 0x65, 0x39, 0x82, 0x65, 0x31, 0x4d, 0x73, 0x0d, 0xff, 0xff, 0x81, 0x66, 0x31, 0x0a, 0x65, 0x39, 0x0e, 0x65, 0x31, 0x10, 0x65, 0x39, 0x82, 0x65, 0x31, 0xf3, 0xa4,
+  0x1d, 0xff, 0xff, 0x82, 0x7d, 0xf7, 0x66, 0x31, 0x0a, 0x65, 0x39, 0x82, 0x66, 0x31, 0xf7, 0xc5, 0x16, 0xff, 0xff, 0x82, 0x92, 0x9c, 0x66, 0x31, 0x02, 0x65, 0x39, 0x81, 0x65, 0x31, 0x07, 0x65,
+  0x39, 0x82, 0x65, 0x31, 0x31, 0x8c, 0x20, 0xff, 0xff, 0x82, 0x10, 0x84, 0x66, 0x31, 0x0a, 0x65, 0x39, 0x82, 0x86, 0x39, 0x7d, 0xf7, 0x0b, 0xff, 0xff, 0x82, 0x7d, 0xf7, 0x66, 0x31, 0x0b, 0x65,
+  0x39, 0x02, 0x65, 0x31, 0x1a, 0x65, 0x39, 0x82, 0x65, 0x31, 0x4d, 0x73, 0x1e, 0xff, 0xff, 0x82, 0xfb, 0xe6, 0x66, 0x31, 0x0a, 0x65, 0x39, 0x82, 0x66, 0x31, 0x18, 0xc6, 0x15, 0xff, 0xff, 0x82,
+  0x5d, 0xef, 0xa7, 0x39, 0x09, 0x65, 0x39, 0x84, 0x65, 0x31, 0x65, 0x39, 0x86, 0x39, 0x3c, 0xef, 0x20, 0xff, 0xff, 0x82, 0x38, 0xce, 0x66, 0x31, 0x06, 0x65, 0x39, 0x81, 0x65, 0x31, 0x03, 0x65,
+  0x39, 0x82, 0x65, 0x31, 0x34, 0xad, 0x0b, 0xff, 0xff, 0x82, 0xfb, 0xe6, 0x66, 0x31, 0x1a, 0x65, 0x39, 0x81, 0x65, 0x31, 0x02, 0x65, 0x39, 0x82, 0x65, 0x31, 0x65, 0x39, 0x02, 0x65, 0x31, 0x04,
+  0x65, 0x39, 0x02, 0x65, 0x31, 0x82, 0x2c, 0x6b, 0xdf, 0xff, 0x1e, 0xff, 0xff, 0x82, 0x7a, 0xd6, 0x65, 0x31, 0x0a, 0x65, 0x39, 0x82, 0x66, 0x31, 0x18, 0xce, 0x15, 0xff, 0xff, 0x82, 0xf0, 0x83,
+  0x65, 0x31, 0x0a, 0x65, 0x39, 0x82, 0x65, 0x31, 0xae, 0x7b, 0x22, 0xff, 0xff, 0x82, 0xc7, 0x41, 0x65, 0x31, 0x0a, 0x65, 0x39, 0x81, 0x8a, 0x5a, 0x0b, 0xff, 0xff, 0x82, 0x7a, 0xd6, 0x66, 0x31,
+  0x0c, 0x65, 0x39, 0x81, 0x65, 0x31, 0x12, 0x65, 0x39, 0x02, 0x65, 0x31, 0x03, 0x65, 0x39, 0x02, 0x65, 0x31, 0x82, 0x30, 0x8c, 0xdf, 0xff, 0x1f, 0xff, 0xff, 0x82, 0xf8, 0xc5, 0x66, 0x31, 0x0a,
+  0x65, 0x39, 0x82, 0x65, 0x31, 0x38, 0xce, 0x14, 0xff, 0xff, 0x82, 0xdb, 0xe6, 0x86, 0x39, 0x05, 0x65, 0x39, 0x81, 0x65, 0x31, 0x04, 0x65, 0x39, 0x83, 0x66, 0x39, 0x65, 0x31, 0xbb, 0xde, 0x22,
+  0xff, 0xff, 0x82, 0xae, 0x7b, 0x65, 0x31, 0x09, 0x65, 0x39, 0x02, 0x66, 0x39, 0x81, 0x9a, 0xde, 0x0a, 0xff, 0xff, 0x81, 0xd7, 0xbd, 0x02, 0x66, 0x39, 0x1c, 0x65, 0x39, 0x02, 0x65, 0x31, 0x04,
+  0x65, 0x39, 0x83, 0x66, 0x31, 0x8a, 0x5a, 0x39, 0xce, 0x21, 0xff, 0xff, 0x82, 0x96, 0xb5, 0x66, 0x31, 0x09, 0x65, 0x39, 0x83, 0x65, 0x31, 0x66, 0x31, 0x38, 0xce, 0x14, 0xff, 0xff, 0x82, 0x2d,
+  0x6b, 0x65, 0x31, 0x0a, 0x65, 0x39, 0x82, 0x66, 0x31, 0x0c, 0x6b, 0x23, 0xff, 0xff, 0x82, 0x96, 0xbd, 0x66, 0x31, 0x02, 0x65, 0x39, 0x81, 0x65, 0x31, 0x06, 0x65, 0x39, 0x02, 0x66, 0x39, 0x81,
+  0x10, 0x84, 0x0a, 0xff, 0xff, 0x83, 0x55, 0xad, 0x66, 0x31, 0x66, 0x39, 0x0d, 0x65, 0x39, 0x96, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39,
+  0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x65, 0x39, 0x65, 0x31, 0x66, 0x31, 0x65, 0x31, 0x86, 0x39, 0x4d, 0x73, 0xf8, 0xc5, 0x23, 0xff, 0xff, 0x82,
+  0x14, 0xa5, 0x65, 0x31, 0x03, 0x66, 0x31, 0x81, 0x65, 0x31, 0x07, 0x66, 0x31, 0x81, 0x38, 0xce, 0x13, 0xff, 0xff, 0x81, 0x38, 0xce, 0x02, 0x66, 0x31, 0x81, 0x65, 0x31, 0x03, 0x66, 0x31, 0x81,
+  0x65, 0x31, 0x03, 0x66, 0x31, 0x81, 0x66, 0x39, 0x02, 0x66, 0x31, 0x81, 0x18, 0xc6, 0x23, 0xff, 0xff, 0x81, 0x7d, 0xf7, 0x06, 0x66, 0x31, 0x03, 0x65, 0x31, 0x85, 0x66, 0x31, 0x66, 0x39, 0x66,
+  0x31, 0xc7, 0x39, 0xbf, 0xff, 0x09, 0xff, 0xff, 0x81, 0xb3, 0x9c, 0x02, 0x66, 0x31, 0x81, 0x66, 0x39, 0x02, 0x66, 0x31, 0x81, 0x85, 0x31, 0x04, 0x65, 0x31, 0x13, 0x66, 0x31, 0x86, 0xe7, 0x41,
+  0x8a, 0x5a, 0x4d, 0x73, 0x51, 0x94, 0xd7, 0xbd, 0x9e, 0xf7, 0x25, 0xff, 0xff, 0x85, 0x3c, 0xef, 0x59, 0xd6, 0x79, 0xd6, 0x9a, 0xd6, 0xba, 0xde, 0x02, 0xdb, 0xde, 0x87, 0xbb, 0xde, 0xba, 0xde,
+  0x9a, 0xde, 0x9a, 0xd6, 0x79, 0xd6, 0x79, 0xce, 0x9e, 0xf7, 0x13, 0xff, 0xff, 0x85, 0xfc, 0xe6, 0x79, 0xd6, 0x7a, 0xd6, 0x9a, 0xd6, 0xba, 0xde, 0x03, 0xdb, 0xde, 0x02, 0xba, 0xde, 0x81, 0x9a,
+  0xd6, 0x02, 0x79, 0xd6, 0x81, 0x59, 0xce, 0x25, 0xff, 0xff, 0x83, 0x9a, 0xd6, 0x79, 0xd6, 0x9a, 0xd6, 0x02, 0xba, 0xde, 0x03, 0xdb, 0xde, 0x02, 0xba, 0xde, 0x84, 0x9a, 0xd6, 0x79, 0xd6, 0x59,
+  0xce, 0x9e, 0xf7, 0x09, 0xff, 0xff, 0x83, 0x1c, 0xe7, 0x59, 0xce, 0x59, 0xd6, 0x03, 0x79, 0xd6, 0x02, 0x7a, 0xd6, 0x82, 0x79, 0xd6, 0x7a, 0xd6, 0x02, 0x79, 0xd6, 0x02, 0x59, 0xd6, 0x82, 0x79,
+  0xd6, 0x59, 0xd6, 0x03, 0x59, 0xce, 0x81, 0x59, 0xd6, 0x02, 0x79, 0xd6, 0x87, 0x9a, 0xd6, 0x9a, 0xde, 0xdb, 0xde, 0xfb, 0xe6, 0x3c, 0xe7, 0x5d, 0xf7, 0xdf, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff,
+  0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f,
+  0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x17, 0xff, 0xff,
 };
 
 const lv_image_dsc_t logo_tab = {
   .header.cf = LV_COLOR_FORMAT_RGB565,
   .header.magic = LV_IMAGE_HEADER_MAGIC,
+  .header.flags = LV_IMAGE_FLAGS_COMPRESSED | LV_IMAGE_FLAGS_USER1,
   .header.w = 180,
   .header.h = 80,
-  .data_size = 14400 * 2,
+  .data_size = 5457,
   .data = logo_tab_map,
 };
@@ -0,0 +1,172 @@
+"""
+RLE compress an LVGL image C file in place, for the compressed image decoder in app/assets/image_decoder.cpp
+
+The input is a C file from the LVGL image converter, true color formats only. The output keeps the symbol names and
+the header, the map becomes a 12 byte compressed header followed by the RLE stream, the same layout LVGL's own bin
+decoder reads for LV_IMAGE_FLAGS_COMPRESSED
+
+Usage: python compress_image.py app/assets/images/launcher_bg.c [more.c ...]
+"""
+
+import re
+import struct
+import sys
+
+# Bytes per pixel, also the RLE block size
+_color_format_sizes = {
+    'LV_COLOR_FORMAT_L8': 1,
+    'LV_COLOR_FORMAT_A8': 1,
+    'LV_COLOR_FORMAT_RGB565': 2,
+    'LV_COLOR_FORMAT_RGB888': 3,
+    'LV_COLOR_FORMAT_ARGB8888': 4,
+    'LV_COLOR_FORMAT_XRGB8888': 4,
+}
+
+_compress_method_rle = 1
+_max_run = 127
+_bytes_per_line = 32
+
+
+def rle_encode(data, block_size):
+    """lv_rle format: a control byte, bit 7 set for a literal run of N blocks, clear for one block repeated N times"""
+    blocks = [data[i:i + block_size] for i in range(0, len(data), block_size)]
+    out = bytearray()
+    i = 0
+    while i < len(blocks):
+        # Repeat
+        j = i + 1
+        while j < len(blocks) and j - i < _max_run and blocks[j] == blocks[i]:
+            j += 1
+        if j - i > 1:
+            out.append(j - i)
+            out += blocks[i]
+            i = j
+            continue
+
+        # Literal, until the next pair of equal blocks
+        j = i + 1
+        while j < len(blocks) and j - i < _max_run and not (j + 1 < len(blocks) and blocks[j] == blocks[j + 1]):
+            j += 1
+        out.append(0x80 | (j - i))
+        for block in blocks[i:j]:
+            out += block
+        i = j
+    return bytes(out)
+
+
+def rle_decode(data, block_size):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        ctrl = data[i]
+        i += 1
+        if ctrl & 0x80:
+            size = (ctrl & 0x7F) * block_size
+            out += data[i:i + size]
+            i += size
+        else:
+            out += data[i:i + block_size] * ctrl
+            i += block_size
+    return bytes(out)
+
+
+def parse_image(source):
+    if 'LV_IMAGE_FLAGS_COMPRESSED' in source:
+        raise ValueError('already compressed')
+
+    map_match = re.search(r'uint8_t (\w+)_map\[\] = \{(.*?)\};', source, re.S)
+    if not map_match:
+        raise ValueError('no image map found')
+    name = map_match.group(1)
+    data = bytes(int(x, 16) for x in re.findall(r'0x([0-9a-fA-F]{2})', map_match.group(2)))
+
+    def field(key):
+        match = re.search(r'\.header\.' + key + r' = (\w+),', source)
+        if not match:
+            raise ValueError('no header.' + key)
+        return match.group(1)
+
+    cf = field('cf')
+    w = int(field('w'))
+    h = int(field('h'))
+    if cf not in _color_format_sizes:
+        raise ValueError(cf + ' is not supported')
+    if len(data) != w * h * _color_format_sizes[cf]:
+        raise ValueError('map size does not match {}x{} {}'.format(w, h, cf))
+    return name, cf, w, h, data
+
+
+def format_source(name, cf, w, h, data):
+    block_size = _color_format_sizes[cf]
+    stream = rle_encode(data, block_size)
+    if rle_decode(stream, block_size) != data:
+        raise ValueError('round trip failed')
+    payload = struct.pack('<III', _compress_method_rle, len(stream), len(data)) + stream
+
+    attribute = 'LV_ATTRIBUTE_IMAGE_' + name.upper()
+    lines = []
+    for i in range(0, len(payload), _bytes_per_line):
+        lines.append('  ' + ', '.join('0x{:02x}'.format(b) for b in payload[i:i + _bytes_per_line]) + ',')
+
+    return '''#ifdef __has_include
+    #if __has_include("lvgl.h")
+        #ifndef LV_LVGL_H_INCLUDE_SIMPLE
+            #define LV_LVGL_H_INCLUDE_SIMPLE
+        #endif
+    #endif
+#endif
+
+#if defined(LV_LVGL_H_INCLUDE_SIMPLE)
+    #include "lvgl.h"
+#else
+    #include "lvgl/lvgl.h"
+#endif
+
+
+#ifndef LV_ATTRIBUTE_MEM_ALIGN
+#define LV_ATTRIBUTE_MEM_ALIGN
+#endif
+
+#ifndef {attribute}
+#define {attribute}
+#endif
+
+// RLE compressed by app/assets/tools/compress_image.py, {raw} bytes raw
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST {attribute} uint8_t {name}_map[] = {{
+{lines}
+}};
+
+const lv_image_dsc_t {name} = {{
+  .header.cf = {cf},
+  .header.magic = LV_IMAGE_HEADER_MAGIC,
+  .header.flags = LV_IMAGE_FLAGS_COMPRESSED | LV_IMAGE_FLAGS_USER1,
+  .header.w = {w},
+  .header.h = {h},
+  .data_size = {size},
+  .data = {name}_map,
+}};
+'''.format(attribute=attribute, raw=len(data), name=name, lines='\n'.join(lines), cf=cf, w=w, h=h, size=len(payload))
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        return 1
+
+    for path in sys.argv[1:]:
+        with open(path) as f:
+            source = f.read()
+        try:
+            name, cf, w, h, data = parse_image(source)
+            output = format_source(name, cf, w, h, data)
+        except ValueError as e:
+            print('{}: {}'.format(path, e))
+            return 1
+        with open(path, 'w') as f:
+            f.write(output)
+        print('{}: {} -> {} bytes'.format(path, len(data), re.search(r'\.data_size = (\d+)', output).group(1)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
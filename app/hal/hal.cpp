@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: MIT
  */
 #include "hal.h"
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <mooncake_log.h>
@@ -57,3 +59,47 @@ bool hal::Check()
     }
     return false;
 }
+
+/* -------------------------------------------------------------------------- */
+/*                                    Audio                                   */
+/* -------------------------------------------------------------------------- */
+void hal::HalBase::audioPlayNotes(const AudioNote_t* notes, size_t count)
+{
+    const int sample_rate = 48000;
+
+    size_t total_frames = 0;
+    for (size_t i = 0; i < count; i++) {
+        total_frames = std::max(total_frames, (size_t)(notes[i].delayMs + notes[i].durationMs) * sample_rate / 1000);
+    }
+    if (total_frames == 0) {
+        return;
+    }
+
+    std::vector<int32_t> mixed(total_frames, 0);
+    for (size_t n = 0; n < count; n++) {
+        const auto& note = notes[n];
+        size_t start     = (size_t)note.delayMs * sample_rate / 1000;
+        size_t frames    = (size_t)note.durationMs * sample_rate / 1000;
+        size_t attack    = std::min((size_t)note.attackMs * sample_rate / 1000, frames);
+        size_t release   = std::min((size_t)note.releaseMs * sample_rate / 1000, frames - attack);
+        float peak       = std::min<int>(note.level, 100) / 100.0f * 32767.0f;
+
+        for (size_t i = 0; i < frames; i++) {
+            float env = 1.0f;
+            if (i < attack) {
+                env = (float)i / attack;
+            } else if (i >= frames - release) {
+                env = (float)(frames - i) / release;
+            }
+            mixed[start + i] += (int32_t)(std::sin(2.0 * M_PI * note.frequency * i / sample_rate) * peak * env);
+        }
+    }
+
+    std::vector<int16_t> buffer(total_frames * 2);
+    for (size_t i = 0; i < total_frames; i++) {
+        int16_t sample    = std::clamp<int32_t>(mixed[i], INT16_MIN, INT16_MAX);
+        buffer[i * 2]     = sample;
+        buffer[i * 2 + 1] = sample;
+    }
+    audioPlay(buffer);
+}
@@ -4,13 +4,19 @@
  * SPDX-License-Identifier: MIT
  */
 #pragma once
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
+#include <functional>
 #include <memory>
-#include <queue>
+#include <atomic>
 #include <string>
 #include <lvgl.h>
 #include <mutex>
 #include <vector>
+#include "spsc_ring.h"
+#include "snapshot.h"
+#include "history.h"
 
 /**
  * @brief Hardware abstraction layer
@@ -45,6 +51,12 @@ public:
     }
 
     /* --------------------------------- System --------------------------------- */
+    // init() may return once the display and touch are up, the rest of the hardware keeps coming up in the
+    // background. Apps that touch it are opened after this turns true
+    virtual bool isBootDone()
+    {
+        return true;
+    }
     virtual void delay(uint32_t ms)
     {
     }
@@ -56,6 +68,115 @@ public:
     {
         return 0.0f;
     }
+    // Per task CPU load over the window since the previous call, and heap watermarks
+    struct TaskLoad_t {
+        std::string name;
+        float cpuLoad      = 0.0f;  // Percent of one core
+        uint32_t stackFree = 0;     // Stack high water mark in bytes
+    };
+    struct SystemStats_t {
+        std::vector<TaskLoad_t> tasks;  // Busiest first
+        uint32_t internalFree    = 0;
+        uint32_t internalMinFree = 0;
+        uint32_t psramFree       = 0;
+        uint32_t psramMinFree    = 0;
+        // Largest free block, far below the free size when the heap is fragmented
+        uint32_t internalLargestFree = 0;
+        uint32_t psramLargestFree    = 0;
+    };
+    virtual SystemStats_t getSystemStats()
+    {
+        return SystemStats_t();
+    }
+    // Lowest stack headroom seen per task name, tasks that have exited included. Every task sample updates it, the
+    // diagnostics service samples at a fixed rate so short lived tasks are caught too
+    struct StackWatermark_t {
+        std::string name;
+        uint32_t minFree    = 0;  // Bytes
+        uint32_t lastSeenMs = 0;
+        bool isAlive        = false;
+    };
+    // Least headroom first
+    virtual std::vector<StackWatermark_t> getStackWatermarks()
+    {
+        return {};
+    }
+    // Sample stacks and heaps at a fixed rate, logs each drop of a heap minimum, the first hint of a leak
+    virtual bool startDiagnostics(uint16_t intervalMs = 1000)
+    {
+        return false;
+    }
+    virtual void stopDiagnostics()
+    {
+    }
+    // Block the app loop for up to timeoutMs (at least a tick), returns early once wakeAppLoop() is called
+    virtual void waitAppLoopWakeup(uint32_t timeoutMs)
+    {
+    }
+    virtual void wakeAppLoop()
+    {
+    }
+    // Task owned by the app layer, core -1 for no affinity. The task returns from its function to end, returns false
+    // if the platform has no tasks or the task could not be created
+    struct AppTaskConfig_t {
+        std::string name   = "app_task";
+        int core           = -1;
+        uint8_t priority   = 5;
+        uint32_t stackSize = 8 * 1024;
+    };
+    virtual bool startAppTask(const AppTaskConfig_t& config, std::function<void()> task)
+    {
+        return false;
+    }
+    // Short job on the shared worker pool, queued for a core, -1 for the caller's. An idle worker on the other core
+    // takes it when its own is busy. Returns false if the pool is full, runs the job in place where there is no pool
+    virtual bool submitJob(std::function<void()> job, int core = -1)
+    {
+        job();
+        return true;
+    }
+    // Fast math kernels (exp, log2, atan2, min/max) timed per element as scalar calls and as batches. Blocks the
+    // caller for a few tens of ms, empty where the kernels are not built
+    struct MathBenchmarkResult_t {
+        std::string name;
+        float scalarNsPerElement = 0.0f;
+        float batchNsPerElement  = 0.0f;
+        // Largest error against libm, relative for exp, 0 for the exact min/max
+        float maxError = 0.0f;
+    };
+    virtual std::vector<MathBenchmarkResult_t> runMathBenchmark()
+    {
+        return {};
+    }
+    // Baselines of the primitives the features are built on: I2C register reads per device, memcpy between SRAM and
+    // PSRAM, PPA scale/blend/fill, JPEG encode/decode and the I2S round trip. Run on a background task, one record per
+    // measurement, groups a platform does not have are left out. The SD card has its own benchmark
+    struct HalBenchmarkRecord_t {
+        // "i2c", "memcpy", "ppa", "jpeg" or "i2s"
+        std::string group;
+        std::string name;
+        std::string unit;
+        float value = 0.0f;
+        // Worst sample of a latency, 0 for a throughput
+        float maxValue = 0.0f;
+    };
+    enum HalBenchmarkState_t {
+        HAL_BENCHMARK_IDLE = 0,
+        HAL_BENCHMARK_RUNNING,
+        HAL_BENCHMARK_DONE,
+    };
+    struct HalBenchmarkResult_t {
+        HalBenchmarkState_t state = HAL_BENCHMARK_IDLE;
+        std::vector<HalBenchmarkRecord_t> records;
+    };
+    virtual bool startHalBenchmark()
+    {
+        return false;
+    }
+    virtual HalBenchmarkResult_t getHalBenchmarkResult()
+    {
+        return HalBenchmarkResult_t();
+    }
 
     /* --------------------------------- Display -------------------------------- */
     virtual int getDisplayWidth()
@@ -73,15 +194,240 @@ public:
     {
         return 0;
     }
+    // Same as setDisplayBrightness(), ramped by the PWM hardware from the current level without any CPU time
+    virtual void fadeDisplayBrightness(uint8_t brightness, uint16_t durationMs)
+    {
+        setDisplayBrightness(brightness);
+    }
+    // Runs on top of the brightness set above, which stays what getDisplayBrightness() returns. Without input for
+    // dimTimeoutSec the backlight fades down to dimBrightness, the next touch or key brings it back
+    struct BacklightPolicyConfig_t {
+        // 0 never dims
+        uint16_t dimTimeoutSec = 30;
+        uint8_t dimBrightness  = 10;
+        uint16_t dimFadeMs     = 1500;
+        uint16_t wakeFadeMs    = 150;
+        // Scales the brightness by setBacklightAmbient() readings, logarithmic up to fullScaleLux
+        bool ambientAdaptive  = false;
+        float fullScaleLux    = 500.0f;
+        float minAmbientScale = 0.2f;
+    };
+    virtual bool startBacklightPolicy(const BacklightPolicyConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopBacklightPolicy()
+    {
+    }
+    // The board has no light sensor, readings come from whatever the app has, e.g. a light unit on Port A
+    virtual void setBacklightAmbient(float lux)
+    {
+    }
+    // Static screens are scanned out at idleRefreshHz. The vertical blanking is stretched at the same pixel clock, so
+    // fewer frames are read from PSRAM and the link idles longer. The full rate is back on the next LVGL invalidation,
+    // and is held while there is input, the app loop animates or the camera runs
+    struct RefreshGovernorConfig_t {
+        uint8_t idleRefreshHz = 30;
+        // Without an invalidation or input for this long the rate drops
+        uint16_t idleTimeoutMs = 1000;
+    };
+    virtual bool startRefreshGovernor(const RefreshGovernorConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopRefreshGovernor()
+    {
+    }
+    // Set by the app loop scheduler while it runs at full rate
+    virtual void setUiAnimating(bool animating)
+    {
+    }
+    // Frames per second the panel is scanned out at now, 0 when unknown
+    virtual uint8_t getDisplayRefreshRate()
+    {
+        return 0;
+    }
 
     /* ---------------------------------- Lvgl ---------------------------------- */
     lv_indev_t* lvTouchpad = nullptr;
-    virtual void lvglLock()
+    // Touch reports, the controller is read once per report it signals, lvTouchpad follows the first point
+    struct TouchPoint_t {
+        uint16_t x        = 0;
+        uint16_t y        = 0;
+        uint16_t strength = 0;
+    };
+    struct TouchState_t {
+        uint64_t timestampUs = 0;
+        uint8_t count        = 0;
+        TouchPoint_t points[5];
+    };
+    // Latest report, in panel coordinates
+    virtual TouchState_t getTouchState()
+    {
+        return TouchState_t();
+    }
+    // Drags are extrapolated ahead by up to leadMs to hide the report latency, 0 turns it off
+    virtual void setTouchPrediction(uint16_t leadMs)
+    {
+    }
+    // Ink for signature capture. While on, each touch report inside the canvas is drawn as an anti-aliased segment
+    // from the touch read straight into the frame buffers on screen, so the stroke shows within a scanout instead of
+    // after an LVGL render. The canvas buffer gets the same pixels and the area drawn is invalidated syncMs later and
+    // at the end of each stroke, LVGL then renders what the panel shows already. Touches still reach LVGL as well
+    struct InkConfig_t {
+        // RGB565 lv_canvas, which has to be on top of whatever it overlaps while inking
+        lv_obj_t* canvas = nullptr;
+        lv_color_t color = lv_color_black();
+        float width      = 3.0f;
+        uint16_t syncMs  = 100;
+    };
+    virtual bool startInk(const InkConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopInk()
+    {
+    }
+    virtual bool isInking()
+    {
+        return false;
+    }
+    // Fills the canvas with bg and forgets the strokes, the canvas must not be cleared behind the HAL's back
+    // while inking or the pixels under old strokes would stay blank
+    virtual void clearInk(lv_color_t bg)
+    {
+    }
+    // USB mice, motion is scaled by sensitivity and sped up by accel for every count per ms it is faster than
+    // threshold, up to maxGain. accel 0 keeps it linear
+    struct PointerAccelConfig_t {
+        float sensitivity = 1.0f;
+        float accel       = 0.0f;
+        float threshold   = 1.0f;
+        float maxGain     = 4.0f;
+    };
+    virtual void setPointerAcceleration(const PointerAccelConfig_t& config)
+    {
+    }
+    // Pointer samples seen by lvTouchpad, recorded to a file or replayed from one in place of the real input. Paths
+    // are relative to the SD card root on the device and to the working directory on desktop
+    enum InputTraceState_t {
+        INPUT_TRACE_IDLE = 0,
+        INPUT_TRACE_RECORDING,
+        INPUT_TRACE_REPLAYING,
+    };
+    struct InputTraceStatus_t {
+        InputTraceState_t state = INPUT_TRACE_IDLE;
+        uint32_t events         = 0;  // Recorded so far, or replayed so far
+        uint32_t elapsedMs      = 0;
+        uint32_t durationMs     = 0;  // Length of the replayed trace
+    };
+    virtual bool startInputRecord(const std::string& path)
+    {
+        return false;
+    }
+    virtual bool startInputReplay(const std::string& path)
+    {
+        return false;
+    }
+    // Ends either, a recording is written to its file here. dropLastTap leaves out the tap that stopped it
+    virtual void stopInputTrace(bool dropLastTap = false)
+    {
+    }
+    virtual InputTraceStatus_t getInputTraceStatus()
+    {
+        return InputTraceStatus_t();
+    }
+    // site names the caller in the lock stats, a string literal, the calling function by default
+    virtual void lvglLock(const char* site = __builtin_FUNCTION())
     {
     }
     virtual void lvglUnlock()
     {
     }
+    // Per call site since boot, wait is the time blocked on the lock and hold from the outermost lock to its unlock
+    struct LvglLockSiteStats_t {
+        std::string site;
+        uint32_t count     = 0;
+        uint32_t avgWaitUs = 0;
+        uint32_t maxWaitUs = 0;
+        uint32_t avgHoldUs = 0;
+        uint32_t maxHoldUs = 0;
+    };
+    struct LvglLockStats_t {
+        bool supported = false;
+        // Empty while the lock is free
+        std::string holder;
+        std::string holderTask;
+        uint32_t heldUs = 0;
+        // UI commands dropped on a full queue
+        uint32_t droppedCommands = 0;
+        // Longest total hold first
+        std::vector<LvglLockSiteStats_t> sites;
+    };
+    virtual LvglLockStats_t getLvglLockStats()
+    {
+        return LvglLockStats_t();
+    }
+    /**
+     * @brief Run a command on the LVGL task right before its next lv_timer_handler(), from any task but not an
+     * interrupt. Background tasks post their widget changes this way and never wait on rendering. Runs right away
+     * under the lock where the platform has no queue
+     *
+     * @param command
+     * @return false if the queue is full, the command does not run then
+     */
+    virtual bool postUiCommand(std::function<void()> command)
+    {
+        lvglLock("ui command");
+        command();
+        lvglUnlock();
+        return true;
+    }
+    // Image decoder cache and glyph bitmap cache counters since boot
+    struct LvglCacheStats_t {
+        uint32_t imageHits    = 0;
+        uint32_t imageMisses  = 0;
+        uint32_t glyphHits    = 0;
+        uint32_t glyphMisses  = 0;
+        uint32_t glyphBytes   = 0;  // PSRAM held by cached glyph bitmaps
+        uint32_t glyphEntries = 0;
+    };
+    virtual LvglCacheStats_t getLvglCacheStats()
+    {
+        return LvglCacheStats_t();
+    }
+    // Where the LVGL heap lives, small objects in internal SRAM and large buffers in PSRAM. Only filled where the
+    // platform provides the LVGL allocator
+    struct LvglMemStats_t {
+        bool supported         = false;
+        uint32_t internalUsed  = 0;
+        uint32_t internalPeak  = 0;
+        uint32_t internalCount = 0;
+        uint32_t psramUsed     = 0;
+        uint32_t psramPeak     = 0;
+        uint32_t psramCount    = 0;
+        uint32_t fallbacks     = 0;  // Small allocations sent to PSRAM, the internal budget was used up
+        uint32_t failures      = 0;
+        // Simple layer strips served from buffers kept in internal SRAM
+        uint32_t layerBuffers = 0;
+        uint32_t layerHits    = 0;
+        uint32_t layerMisses  = 0;
+    };
+    virtual LvglMemStats_t getLvglMemStats()
+    {
+        return LvglMemStats_t();
+    }
+
+    struct VsyncStats_t {
+        bool supported        = false;  // Frames are presented on vsync
+        uint32_t vsyncs       = 0;
+        uint32_t frames       = 0;
+        uint32_t missedVsyncs = 0;  // Vsyncs that repeated the previous frame while a new one was rendering
+    };
+    virtual VsyncStats_t getVsyncStats()
+    {
+        return VsyncStats_t();
+    }
 
     /* ---------------------------------- Power --------------------------------- */
     struct PMData_t {
@@ -90,10 +436,137 @@ public:
         float shuntVoltage = 0.0f;
         float shuntCurrent = 0.0f;
     };
-    PMData_t powerMonitorData;
+    // Latest reading with its version and millis(), kept fresh by the sensor service
+    Snapshot<PMData_t> powerMonitorSnapshot;
+    // Every reading of the sensor service, for charts, its interval apart
+    History<PMData_t, 256> powerMonitorHistory;
+    // Blocking read into powerMonitorSnapshot, for when the sensor service is not running
     virtual void updatePowerMonitorData()
     {
     }
+
+    // Power sampling, a task follows every INA226 conversion, updatePowerMonitorData() then reads the latest one
+    struct PowerSample_t {
+        uint64_t timestampUs = 0;
+        float busVoltage     = 0.0f;
+        float shuntCurrent   = 0.0f;
+        // Bus voltage times the signed current, negative while discharging
+        float busPower = 0.0f;
+    };
+    struct PowerWindowStats_t {
+        uint32_t samples    = 0;
+        uint32_t durationMs = 0;
+        float minVoltage    = 0.0f;
+        float maxVoltage    = 0.0f;
+        float avgVoltage    = 0.0f;
+        float minCurrent    = 0.0f;
+        float maxCurrent    = 0.0f;
+        float avgCurrent    = 0.0f;
+        float avgPower      = 0.0f;
+        // Signed like busPower
+        float energyMwh = 0.0f;
+    };
+    // averages is the on-chip averaging count per sample, 1 ~ 1024, each conversion pair takes 2.2 ms
+    virtual bool startPowerSampling(uint16_t averages = 16)
+    {
+        return false;
+    }
+    virtual void stopPowerSampling()
+    {
+    }
+    virtual bool isPowerSampling()
+    {
+        return false;
+    }
+    // Oldest first, returns the count read
+    virtual size_t readPowerSamples(PowerSample_t* samples, size_t maxCount)
+    {
+        return 0;
+    }
+    // Stats since the previous call, each call starts a new window
+    virtual PowerWindowStats_t takePowerWindowStats()
+    {
+        return PowerWindowStats_t();
+    }
+    // Energy integrated since sampling started
+    virtual float getPowerEnergyMwh()
+    {
+        return 0.0f;
+    }
+
+    // Power profiling, sampled power tagged with the app context and peripheral state, written to SD as binary
+    // records. It consumes the power sample ring while running
+    virtual bool startPowerProfile(const std::string& path)
+    {
+        return false;
+    }
+    virtual void stopPowerProfile()
+    {
+    }
+    virtual bool isPowerProfiling()
+    {
+        return false;
+    }
+    // Context tags, set by the app layer on app and window transitions, empty for none
+    virtual void setPowerProfileApp(const std::string& name)
+    {
+    }
+    virtual void setPowerProfileWindow(const std::string& name)
+    {
+    }
+
+    // Power policy, subsystems claim a performance level under an owner name and the highest claim wins. With no
+    // claim the CPU clock follows the load and the chip light sleeps between scheduled work
+    enum PerfLevel_t {
+        PERF_LEVEL_NONE = 0,
+        // Light sleep is blocked, the clock still follows the load
+        PERF_LEVEL_AWAKE,
+        // Light sleep is blocked and the CPU stays at its max clock
+        PERF_LEVEL_MAX,
+    };
+    // A new claim from the same owner replaces its previous one
+    virtual void claimPerfLevel(const std::string& owner, PerfLevel_t level)
+    {
+    }
+    virtual void releasePerfLevel(const std::string& owner)
+    {
+        claimPerfLevel(owner, PERF_LEVEL_NONE);
+    }
+    virtual PerfLevel_t getPerfLevel()
+    {
+        return PERF_LEVEL_MAX;
+    }
+    // Wi-Fi power save of the station, claimed the same way. Subsystems claim the radio awake around their transfers,
+    // without a claim the station sleeps at the idle level, so a unit that reports once a minute only keeps the
+    // coprocessor radio up around its batches. Only a station on its own sleeps, the AP stays up for its clients
+    enum RadioLevel_t {
+        // Wakes every listenInterval beacons
+        RADIO_LEVEL_SLEEP = 0,
+        // Wakes for every DTIM beacon
+        RADIO_LEVEL_DTIM,
+        // No power save
+        RADIO_LEVEL_AWAKE,
+    };
+    struct WifiPowerSaveConfig_t {
+        RadioLevel_t idleLevel = RADIO_LEVEL_DTIM;
+        // Beacons between wakes at RADIO_LEVEL_SLEEP, takes effect at the next association
+        uint8_t listenInterval = 10;
+    };
+    virtual void setWifiPowerSave(const WifiPowerSaveConfig_t& config)
+    {
+    }
+    // A new claim from the same owner replaces its previous one, RADIO_LEVEL_SLEEP drops it
+    virtual void claimRadioLevel(const std::string& owner, RadioLevel_t level)
+    {
+    }
+    virtual void releaseRadioLevel(const std::string& owner)
+    {
+        claimRadioLevel(owner, RADIO_LEVEL_SLEEP);
+    }
+    virtual RadioLevel_t getRadioLevel()
+    {
+        return RADIO_LEVEL_AWAKE;
+    }
     virtual void setChargeQcEnable(bool enable)
     {
     }
@@ -135,6 +608,75 @@ public:
     {
     }
 
+    /* ------------------------------- Peripherals ------------------------------ */
+    // Rarely used peripherals are not brought up at boot. The first claim brings one up, and releasing the last claim
+    // powers it down again
+    enum Peripheral_t {
+        // UART, its receive task and driver buffers
+        PERIPHERAL_RS485 = 0,
+        // Host stack with the HID and flash drive drivers, once up it stays up
+        PERIPHERAL_USB_HOST,
+        // 24 MHz clock output to the camera sensor
+        PERIPHERAL_CAMERA_OSC,
+        PERIPHERAL_NUM,
+    };
+    // A second claim from the same owner is a no-op, returns false if the peripheral failed to come up
+    virtual bool claimPeripheral(Peripheral_t peripheral, const std::string& owner)
+    {
+        return true;
+    }
+    virtual void releasePeripheral(Peripheral_t peripheral, const std::string& owner)
+    {
+    }
+    virtual bool isPeripheralUp(Peripheral_t peripheral)
+    {
+        return true;
+    }
+
+    /* ------------------------------- Memory ------------------------------- */
+    // Internal SRAM for small buffers on a deadline, PSRAM for bulk data. Internal RAM is scarce, a failed internal
+    // allocation returns null rather than falling back
+    enum MemoryPlacement_t {
+        MEMORY_INTERNAL = 0,
+        MEMORY_PSRAM,
+    };
+    virtual void* allocMemory(size_t size, MemoryPlacement_t placement)
+    {
+        return malloc(size);
+    }
+    // For memory from allocMemory() only
+    virtual void freeMemory(void* ptr)
+    {
+        free(ptr);
+    }
+
+    /* -------------------------------- Settings -------------------------------- */
+    // Display brightness, speaker volume, QC charging and the external antenna come back after a reboot. A setter
+    // only updates RAM, the values go to flash once they stop changing for a moment and on power off
+    virtual void flushSettings()
+    {
+    }
+
+    /* ------------------------------- Asset pack ------------------------------- */
+    // Sounds and other assets live on their own flash partition, so they can be updated without a firmware build
+    enum AssetFormat_t {
+        ASSET_FORMAT_RAW = 0,
+        ASSET_FORMAT_MP3,
+        ASSET_FORMAT_WAV,
+        // LVGL binary image, lv_image_header_t followed by the pixels
+        ASSET_FORMAT_LV_IMAGE,
+    };
+    struct Asset_t {
+        const uint8_t* data  = nullptr;
+        size_t size          = 0;
+        AssetFormat_t format = ASSET_FORMAT_RAW;
+    };
+    // Zero copy, data points into the memory mapped partition and stays valid. False if the pack has no such asset
+    virtual bool getAsset(const std::string& name, Asset_t& asset)
+    {
+        return false;
+    }
+
     /* ----------------------------------- IMU ---------------------------------- */
     struct IMUData_t {
         float accelX = 0.0f;
@@ -144,7 +686,11 @@ public:
         float gyroY  = 0.0f;
         float gyroZ  = 0.0f;
     };
-    IMUData_t imuData;
+    // Latest reading with its version and millis(), kept fresh by the sensor service or the IMU stream
+    Snapshot<IMUData_t> imuSnapshot;
+    // Every reading of the sensor service, for charts, its interval apart. The IMU stream does not feed it
+    History<IMUData_t, 256> imuHistory;
+    // Blocking read into imuSnapshot, for when neither is running
     virtual void updateImuData()
     {
     }
@@ -152,127 +698,1552 @@ public:
     {
     }
 
-    /* ----------------------------------- RTC ---------------------------------- */
-    virtual void getRtcTime(tm* time)
+    // IMU streaming, a sensor task drains the FIFO in bursts so readers never wait on the bus
+    struct ImuSample_t {
+        // Microseconds since boot, spaced by the stream rate
+        uint64_t timestampUs = 0;
+        float accelX         = 0.0f;
+        float accelY         = 0.0f;
+        float accelZ         = 0.0f;
+        float gyroX          = 0.0f;
+        float gyroY          = 0.0f;
+        float gyroZ          = 0.0f;
+    };
+    virtual bool startImuStream(uint16_t rateHz = 400)
     {
+        return false;
     }
-    virtual void setRtcTime(tm time)
+    virtual void stopImuStream()
     {
     }
-    virtual void clearRtcIrq()
+    virtual bool isImuStreaming()
     {
+        return false;
     }
-
-    /* --------------------------------- Camera --------------------------------- */
-    virtual void startCameraCapture(lv_obj_t* imgCanvas)
+    // Oldest first, returns the count read
+    virtual size_t readImuSamples(ImuSample_t* samples, size_t maxCount)
     {
+        return 0;
     }
-    virtual void stopCameraCapture()
+    // Gyro integrated since the stream started, radians about the IMUData_t axes, at a time within the last few
+    // hundred ms. Times past the newest sample are extrapolated from its rate
+    virtual bool getImuGyroAngle(uint64_t timestampUs, float angle[3])
     {
+        return false;
     }
-    virtual bool isCameraCapturing()
+
+    // Orientation fused on the sensor task while streaming
+    struct ImuOrientation_t {
+        uint64_t timestampUs = 0;
+        // Sensor to world rotation, w x y z, in the sensor's own frame
+        float quaternion[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+        // Unit gravity direction, same axes as IMUData_t, reads +1 on the axis pointing up
+        float gravityX = 0.0f;
+        float gravityY = 0.0f;
+        float gravityZ = 0.0f;
+    };
+    // Returns false until the stream has produced an estimate
+    virtual bool getImuOrientation(ImuOrientation_t& orientation)
     {
         return false;
     }
 
-    /* ---------------------------------- USB-A --------------------------------- */
-    struct HidMouseData_t {
-        std::mutex mutex;
-        int x         = 0;
-        int y         = 0;
-        bool btnLeft  = false;
-        bool btnRight = false;
+    // Gestures detected by the IMU itself, the host only picks up the latched result
+    enum ImuGesture_t {
+        IMU_GESTURE_SINGLE_TAP  = 1 << 0,
+        IMU_GESTURE_DOUBLE_TAP  = 1 << 1,
+        IMU_GESTURE_ORIENTATION = 1 << 2,
+        IMU_GESTURE_NO_MOTION   = 1 << 3,
+        IMU_GESTURE_ALL         = 0x0F,
     };
-    HidMouseData_t hidMouseData;
-
-    /* ---------------------------------- Audio --------------------------------- */
-    virtual void setSpeakerVolume(uint8_t volume)
+    enum ImuOrientationState_t {
+        IMU_ORIENTATION_PORTRAIT_UP = 0,
+        IMU_ORIENTATION_LANDSCAPE_LEFT,
+        IMU_ORIENTATION_PORTRAIT_DOWN,
+        IMU_ORIENTATION_LANDSCAPE_RIGHT,
+    };
+    struct ImuGestureEvent_t {
+        ImuGesture_t gesture = IMU_GESTURE_SINGLE_TAP;
+        // For IMU_GESTURE_ORIENTATION
+        ImuOrientationState_t orientation = IMU_ORIENTATION_PORTRAIT_UP;
+        bool faceDown                     = false;
+    };
+    // Called on the sensor task, the app loop is woken up after each event
+    using ImuGestureCallback_t = std::function<void(const ImuGestureEvent_t& event)>;
+    virtual bool startImuGestures(uint8_t gestureMask, ImuGestureCallback_t onGesture)
     {
+        return false;
     }
-    virtual uint8_t getSpeakerVolume()
+    virtual void stopImuGestures()
     {
-        return 0;
     }
-    // [MIC-L, AEC, MIC-R, MIC-HP]
-    virtual void audioRecord(std::vector<int16_t>& data, uint16_t durationMs, float gain = 80.0f)
+
+    /* ----------------------------------- RTC ---------------------------------- */
+    virtual void getRtcTime(tm* time)
+    {
+    }
+    virtual void setRtcTime(tm time)
     {
     }
-    virtual void audioPlay(std::vector<int16_t>& data, bool async = true)
+    virtual void clearRtcIrq()
     {
     }
 
-    // Mic record test
-    enum MicTestState_t {
-        MIC_TEST_IDLE,
-        MIC_TEST_RECORDING,
-        MIC_TEST_PLAYING,
+    /* ---------------------------------- Clock --------------------------------- */
+    // Wall clock served from the system time, so reading it never touches the bus. A service task resyncs the system
+    // time with the RTC on a long interval, on the edge of an RTC second, and slews out the drift it measured between
+    // two syncs. Second and minute boundaries are published on GetEventBus() as EVENT_TOPIC_CLOCK
+    struct ClockServiceConfig_t {
+        uint16_t resyncIntervalMin = 60;
+        // Minute ticks only when false
+        bool secondTicks = true;
     };
-    virtual void startDualMicRecordTest()
+    struct ClockStats_t {
+        uint32_t resyncs = 0;
+        // RTC minus system time at the last resync
+        int32_t lastOffsetUs = 0;
+        // System clock against the RTC, positive when it runs slow
+        float driftPpm = 0.0f;
+    };
+    virtual bool startClockService(const ClockServiceConfig_t& config)
     {
+        return false;
     }
-    virtual MicTestState_t getDualMicRecordTestState()
+    virtual void stopClockService()
     {
-        return MIC_TEST_IDLE;
     }
-    virtual void startHeadphoneMicRecordTest()
+    virtual bool isClockServiceRunning()
     {
+        return false;
     }
-    virtual MicTestState_t getHeadphoneMicRecordTestState()
+    virtual ClockStats_t getClockStats()
     {
-        return MIC_TEST_IDLE;
+        return {};
     }
 
-    // Play music test
-    enum MusicPlayState_t {
-        MUSIC_PLAY_IDLE,
-        MUSIC_PLAY_PLAYING,
+    /* ----------------------------- Sensor service ----------------------------- */
+    // A service task polls the internal bus sensors, so UI code only ever copies cached values
+    struct SensorServiceConfig_t {
+        // 0 skips the sensor
+        uint16_t powerMonitorIntervalMs = 100;
+        uint16_t imuIntervalMs          = 100;
+        // The clock service serves the time, the RTC only needs polling to watch the chip itself
+        uint16_t rtcIntervalMs = 0;
     };
-    virtual void startPlayMusicTest()
+    struct SensorSnapshot_t {
+        // Bumped on every publish
+        uint32_t sequence = 0;
+        // millis() of the last read, 0 until the first one
+        uint32_t powerMonitorTime = 0;
+        uint32_t imuTime          = 0;
+        uint32_t rtcTime          = 0;
+        PMData_t powerMonitor;
+        IMUData_t imu;
+        tm rtc = {};
+    };
+    virtual bool startSensorService(const SensorServiceConfig_t& config)
     {
+        return false;
     }
-    virtual MusicPlayState_t getMusicPlayTestState()
+    virtual void stopSensorService()
     {
-        return MUSIC_PLAY_IDLE;
     }
-    virtual void stopPlayMusicTest()
+    // Returns false when the service is not running, callers fall back to the blocking reads
+    virtual bool getSensorSnapshot(SensorSnapshot_t& snapshot)
     {
+        return false;
     }
 
-    // Sfx
-    virtual void playStartupSfx()
+    /* -------------------------------- Telemetry ------------------------------- */
+    // JSON telemetry on the Wi-Fi web server, GET /api/telemetry and pushed on the /ws/telemetry WebSocket. The
+    // document is rebuilt at a fixed rate from the sensor service snapshot, requests only get the cached copy
+    struct TelemetryConfig_t {
+        // Document rebuild and WebSocket push
+        uint16_t intervalMs = 1000;
+        // Task loads cost a scheduler walk, so they are sampled less often. 0 leaves them out
+        uint16_t taskStatsIntervalMs = 5000;
+        uint8_t maxWsClients         = 4;
+    };
+    struct TelemetryStats_t {
+        uint32_t documents    = 0;
+        uint32_t restRequests = 0;
+        uint32_t wsClients    = 0;
+        uint32_t wsFramesSent = 0;
+        // Skipped because the previous frame to that client was still in flight
+        uint32_t wsFramesDropped = 0;
+    };
+    virtual bool startTelemetry(const TelemetryConfig_t& config)
     {
+        return false;
     }
-    virtual void playShutdownSfx()
+    virtual void stopTelemetry()
     {
     }
-
-    /* --------------------------------- Network -------------------------------- */
-    virtual void setExtAntennaEnable(bool enable)
+    virtual TelemetryStats_t getTelemetryStats()
     {
+        return TelemetryStats_t();
     }
-    virtual bool getExtAntennaEnable()
-    {
-        return false;
+
+    /* ---------------------------------- MQTT ---------------------------------- */
+    // Publishes sensor readings to a broker over the Wi-Fi station. Readings are averaged per sample interval and sent
+    // as one columnar JSON payload per batch. Batches the broker has not acknowledged in time, or made while it is out
+    // of reach, wait in a queue on the card and are replayed once it is back. A link that keeps the window of
+    // unacknowledged batches full gets longer batches, so fewer messages
+    struct MqttConfig_t {
+        // For example mqtt://host:1883, empty takes the one set in menuconfig
+        std::string brokerUri;
+        // Empty takes one made from the MAC
+        std::string clientId;
+        std::string username;
+        std::string password;
+        std::string topic = "m5tab5/telemetry";
+        uint8_t qos       = 1;
+        // One reading per sample, one payload per batch
+        uint32_t sampleIntervalMs = 1000;
+        uint32_t batchIntervalMs  = 10000;
+        // Batches sent and not acknowledged yet, more are queued
+        uint8_t maxInFlight = 4;
+        // Space the queue may take on the card, batches beyond it are dropped
+        uint32_t offlineQueueKb = 1024;
+    };
+    struct MqttStats_t {
+        bool isRunning   = false;
+        bool isConnected = false;
+        uint32_t batches = 0;
+        uint32_t acked   = 0;
+        // Batches waiting on the card, and sent from it
+        uint32_t queued   = 0;
+        uint32_t replayed = 0;
+        // Queue full, or no card while the broker was out of reach
+        uint32_t dropped = 0;
+        // Batch interval after throttling, and the acknowledge round trip
+        uint32_t batchIntervalMs = 0;
+        uint32_t ackRttMs        = 0;
+    };
+    virtual bool startMqtt(const MqttConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopMqtt()
+    {
+    }
+    virtual MqttStats_t getMqttStats()
+    {
+        return MqttStats_t();
+    }
+
+    /* ---------------------------------- BLE ----------------------------------- */
+    // GATT peripheral on the C6 radio, the NimBLE host runs here and talks HCI over ESP-Hosted. One service carries
+    // sensor readings, averaged per sample interval and packed as many to a notification as the MTU fits, so the
+    // radio wakes once per batch. The connection interval is asked for from the batch period
+    struct BleTelemetryConfig_t {
+        // Empty takes one made from the MAC
+        std::string name;
+        uint32_t sampleIntervalMs = 200;
+        // Longest a sample waits for its notification, a full one goes earlier
+        uint32_t maxLatencyMs = 1000;
+    };
+    struct BleTelemetryStats_t {
+        bool isRunning    = false;
+        bool isConnected  = false;
+        bool isSubscribed = false;
+        uint16_t mtu      = 0;
+        // Of the current connection, 0 without one
+        uint32_t connIntervalUs = 0;
+        uint32_t notifications  = 0;
+        uint32_t samples        = 0;
+        // No buffer in the host for the notification
+        uint32_t dropped = 0;
+    };
+    virtual bool startBleTelemetry(const BleTelemetryConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopBleTelemetry()
+    {
+    }
+    virtual BleTelemetryStats_t getBleTelemetryStats()
+    {
+        return BleTelemetryStats_t();
+    }
+
+    /* ------------------------------ Screen Mirror ----------------------------- */
+    // Streams the flushed screen regions as JPEG over the /ws/mirror WebSocket, /mirror serves a viewer page. Regions
+    // flushed while the previous push is still in flight are merged, so a slow link gets fewer and larger updates
+    struct ScreenMirrorConfig_t {
+        uint8_t quality = 60;
+        // Shortest time between two pushes
+        uint16_t minIntervalMs = 40;
+        uint8_t maxClients     = 2;
+    };
+    struct ScreenMirrorStats_t {
+        uint32_t clients = 0;
+        // Pushes, each sends one or more regions
+        uint32_t frames      = 0;
+        uint32_t regions     = 0;
+        uint64_t bytesSent   = 0;
+        uint32_t encodeFails = 0;
+        // Flushed areas folded into a region that was already waiting
+        uint32_t mergedAreas = 0;
+    };
+    virtual bool startScreenMirror(const ScreenMirrorConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopScreenMirror()
+    {
+    }
+    virtual ScreenMirrorStats_t getScreenMirrorStats()
+    {
+        return ScreenMirrorStats_t();
+    }
+
+    /* ----------------------------- Screen Capture ----------------------------- */
+    // Screenshots and low frame rate recordings of what the panel shows, camera preview and cursor included. Each frame
+    // is rotated out of the panel frame buffer by the PPA between two LVGL frames, the JPEG encode and the SD card
+    // writes run on their own task. Files go to /sd/captures, GET /screenshot.jpg on the web server returns a fresh one
+    struct ScreenRecordConfig_t {
+        uint8_t fps     = 2;
+        uint8_t quality = 70;
+        // Stops on its own after this long, 0 to record until stopScreenRecording()
+        uint32_t maxDurationSec = 0;
+    };
+    struct ScreenCaptureStats_t {
+        bool isRecording     = false;
+        uint32_t screenshots = 0;
+        // Recording frames written, and the ones dropped while both frame buffers were still being encoded
+        uint32_t frames        = 0;
+        uint32_t droppedFrames = 0;
+        uint32_t encodeFails   = 0;
+        uint64_t bytesWritten  = 0;
+        // Time the LVGL task spent on the last PPA copy, and the encode of the last frame
+        uint32_t lastCopyUs   = 0;
+        uint32_t lastEncodeUs = 0;
+        // Last screenshot or recording
+        std::string lastFile;
+    };
+    // Asynchronous, the path shows up in lastFile once written. False without an SD card or with the capture queue full
+    virtual bool takeScreenshot(uint8_t quality = 90)
+    {
+        return false;
+    }
+    // One .mjpeg file of concatenated JPEG frames, plays with ffplay -f mjpeg or converts with ffmpeg
+    virtual bool startScreenRecording(const ScreenRecordConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopScreenRecording()
+    {
+    }
+    virtual ScreenCaptureStats_t getScreenCaptureStats()
+    {
+        return ScreenCaptureStats_t();
+    }
+
+    /* ---------------------------- Display Rotation ---------------------------- */
+    // The UI turns with the tablet, following the gravity of the IMU. Every rotation goes through the PPA on the way to
+    // the panel, so all four cost the same, and the widget trees are only laid out again. The rotation and the auto
+    // setting are saved, a portrait kiosk sets its rotation once instead of needing its own firmware
+    struct AutoRotateConfig_t {
+        // Bits of the lv_display_rotation_t it may pick. The launcher is laid out for landscape, the portrait ones
+        // are for apps that lay themselves out from the screen size
+        uint8_t rotationMask = (1 << LV_DISPLAY_ROTATION_90) | (1 << LV_DISPLAY_ROTATION_270);
+        // Past the 45 degrees between two rotations the tablet has to tilt before it switches
+        float hysteresisDeg = 15.0f;
+        // How long the new orientation has to hold
+        uint32_t settleMs = 500;
+        // In g, below this the tablet lies too flat to tell, the rotation stays
+        float minPlaneGravity = 0.4f;
+    };
+    // Fixes the rotation, stops the auto rotation
+    virtual void setDisplayRotation(lv_display_rotation_t rotation)
+    {
+    }
+    virtual lv_display_rotation_t getDisplayRotation()
+    {
+        return LV_DISPLAY_ROTATION_0;
+    }
+    virtual bool startAutoRotate(const AutoRotateConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopAutoRotate()
+    {
+    }
+    virtual bool isAutoRotating()
+    {
+        return false;
+    }
+
+    /* --------------------------------- Camera --------------------------------- */
+    enum CameraPixelFormat_t {
+        CAMERA_PIXEL_FORMAT_RGB565,
+        CAMERA_PIXEL_FORMAT_YUV420,
+        CAMERA_PIXEL_FORMAT_RAW8,
+    };
+    struct CameraConfig_t {
+        uint16_t width  = 1280;
+        uint16_t height = 720;
+        // YUV420 is 1.5 bytes a pixel against 2 for RGB565, the PPA converts to RGB565 on the way to the screen
+        CameraPixelFormat_t pixelFormat = CAMERA_PIXEL_FORMAT_YUV420;
+        uint8_t fps                     = 30;
+        uint8_t bufferCount             = 2;
+
+        // Skip frames while the previous one is still waiting to be shown
+        bool dropUnconsumedFrames = true;
+
+        // Crop window in sensor coordinates, zero size means the largest centered window with the output aspect
+        uint16_t cropX = 0;
+        uint16_t cropY = 0;
+        uint16_t cropW = 0;
+        uint16_t cropH = 0;
+
+        // While the canvas is drawn as a plain opaque rectangle, e.g. maximized with no radius, frames go under the
+        // LVGL frame straight from the PPA and LVGL only renders the widgets on top of them
+        bool videoPlane = true;
+
+        // Electronic stabilization of the preview, the PPA block slides against the gyro inside a window over-scanned
+        // by the margin on each side. Needs the IMU stream running, roll about the lens is not compensated
+        bool stabilize        = false;
+        float stabilizeMargin = 0.1f;
+        // Horizontal field of view of the capture frame, turns the gyro angle into pixels
+        float horizontalFovDeg = 68.0f;
+    };
+    virtual void startCameraCapture(lv_obj_t* imgCanvas, const CameraConfig_t& config)
+    {
+    }
+    void startCameraCapture(lv_obj_t* imgCanvas)
+    {
+        startCameraCapture(imgCanvas, CameraConfig_t());
+    }
+    // Switch a running capture to another config at its next frame, the sensor is not re-initialized, only the
+    // registers that differ are written. False if nothing is capturing, the capture carries on then
+    virtual bool switchCameraConfig(const CameraConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopCameraCapture()
+    {
+    }
+    virtual bool isCameraCapturing()
+    {
+        return false;
+    }
+    // Snapshot and MJPEG recording to SD card, path is relative to the SD card root
+    virtual bool cameraSnapshot(const std::string& path)
+    {
+        return false;
+    }
+    virtual bool startCameraRecording(const std::string& path, uint8_t fps = 15)
+    {
+        return false;
+    }
+    virtual void stopCameraRecording()
+    {
+    }
+    virtual bool isCameraRecording()
+    {
+        return false;
+    }
+    // RAW capture, the Bayer frames of a RAW8 capture go to the SD card unprocessed as DNG files. Frames are copied into
+    // a ring in PSRAM at the sensor rate, preview skips included, and written out behind it, so a burst longer than the
+    // ring keeps what the card takes and drops the rest
+    struct CameraRawCaptureConfig_t {
+        // Relative to the SD card root, frames are numbered from 0 in it
+        std::string directory = "raw";
+        // 0 runs until stopped
+        uint32_t maxFrames = 0;
+        // Frames the PSRAM ring holds, one byte a pixel each, up to 16
+        uint8_t ringFrames = 8;
+        // Bilinear demosaic with the as-shot white balance to a JPEG next to each DNG, on a task that only runs in
+        // idle time and keeps going after the capture stops
+        bool develop = false;
+    };
+    struct CameraRawStats_t {
+        uint32_t captured = 0;
+        uint32_t written  = 0;
+        // Found the ring full
+        uint32_t dropped   = 0;
+        uint32_t developed = 0;
+    };
+    virtual bool startCameraRawCapture(const CameraRawCaptureConfig_t& config)
+    {
+        return false;
+    }
+    // Waits for the frames still in the ring to be written
+    virtual void stopCameraRawCapture()
+    {
+    }
+    // False once maxFrames are taken, stop still has to be called
+    virtual bool isCameraRawCapturing()
+    {
+        return false;
+    }
+    virtual CameraRawStats_t getCameraRawStats()
+    {
+        return CameraRawStats_t();
+    }
+    // H.264 stream over the Wi-Fi AP, needs a YUV420 capture
+    virtual bool isCameraStreaming()
+    {
+        return false;
+    }
+    // USB webcam, the USB-C port enumerates as a UVC MJPEG camera fed from the running capture. Needs a capture at
+    // the frame size the UVC descriptors announce
+    virtual bool startUvcCamera()
+    {
+        return false;
+    }
+    virtual void stopUvcCamera()
+    {
+    }
+    // The host has the video stream open
+    virtual bool isUvcCameraStreaming()
+    {
+        return false;
+    }
+    // Digital zoom inside the capture window, done by the PPA scaler. Center is normalized to the window
+    virtual void setCameraZoom(float zoom, float centerX = 0.5f, float centerY = 0.5f)
+    {
+    }
+    virtual float getCameraZoom()
+    {
+        return 1.0f;
+    }
+    // Size the preview is shown at, the PPA scales straight to it. Capped at the config size, 0 means the config size
+    virtual void setCameraPreviewSize(uint16_t width, uint16_t height)
+    {
+    }
+    // Per-stage timings over the last frames of the pipeline, in microseconds
+    struct CameraStageStats_t {
+        uint32_t p50 = 0;
+        uint32_t p99 = 0;
+    };
+    struct CameraStats_t {
+        float fps              = 0.0f;
+        uint32_t framesDropped = 0;
+        CameraStageStats_t dqbuf;    // Waiting for the sensor in DQBUF
+        CameraStageStats_t ppa;      // PPA transform, submit to done
+        CameraStageStats_t present;  // Published frame waiting for LVGL to pick it up
+        CameraStageStats_t qbuf;     // Returning the buffer to the driver
+    };
+    virtual CameraStats_t getCameraStats()
+    {
+        return CameraStats_t();
+    }
+    // Hardware statistics the ISP computes for every frame, read in place, the pointers are only valid during the
+    // callback. A part the frame does not have is null or false
+    struct CameraIspStats_t {
+        uint64_t sequence = 0;
+        // Luminance histogram over the AE window
+        const uint32_t* histogram = nullptr;
+        uint8_t histogramBins     = 0;
+        // Mean luminance per AE block, indexed [x * aeBlocksY + y]
+        const int* aeLuminance = nullptr;
+        uint8_t aeBlocksX      = 0;
+        uint8_t aeBlocksY      = 0;
+        // Channel sums over the white patches the AWB counted
+        bool hasAwb         = false;
+        uint32_t awbCounted = 0;
+        uint32_t awbSumR    = 0;
+        uint32_t awbSumG    = 0;
+        uint32_t awbSumB    = 0;
+        // Largest high frequency value out of the sharpen filter, a focus score
+        bool hasSharpness = false;
+        uint8_t sharpness = 0;
+    };
+    // Called on the ISP task, which also runs the auto exposure and white balance, keep it short
+    using CameraIspStatsCallback_t = std::function<void(const CameraIspStats_t& stats)>;
+    virtual bool startCameraIspStats(CameraIspStatsCallback_t onStats)
+    {
+        return false;
+    }
+    virtual void stopCameraIspStats()
+    {
+    }
+    // Manual image controls. A locked setting stays as set, or where the automatic loop left it when its value is 0,
+    // and the loop only drives the others. With the IPA off nothing is adjusted per frame, the frame timing is then
+    // fixed and the ISP task only hands out statistics. Kept across captures
+    struct CameraImageControl_t {
+        bool aeLock  = false;
+        bool awbLock = false;
+        bool ccmLock = false;
+        bool ipaOff  = false;
+        // With aeLock, the analog gain is a multiple of the sensor minimum
+        uint32_t exposureUs = 0;
+        float analogGain    = 0.0f;
+        // With awbLock, gains against green
+        float redGain  = 0.0f;
+        float blueGain = 0.0f;
+        // With ccmLock, row major in (-4, 4)
+        bool hasCcm  = false;
+        float ccm[9] = {1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+    };
+    virtual bool setCameraImageControl(const CameraImageControl_t& control)
+    {
+        return false;
+    }
+    // As last written to the sensor and the ISP, by either the loop or setCameraImageControl()
+    struct CameraImageState_t {
+        uint32_t exposureUs    = 0;
+        uint32_t minExposureUs = 0;
+        uint32_t maxExposureUs = 0;
+        float analogGain       = 0.0f;
+        float maxAnalogGain    = 0.0f;
+        float redGain          = 0.0f;
+        float blueGain         = 0.0f;
+    };
+    virtual bool getCameraImageState(CameraImageState_t& state)
+    {
+        return false;
+    }
+    // Motion detection on a small capture the PPA scales the sensor frame down to, needs neither the preview nor the
+    // display. It owns the camera, a capture can only start once it is stopped
+    struct CameraMotionConfig_t {
+        uint8_t fps     = 5;
+        uint16_t width  = 160;
+        uint16_t height = 90;
+        // Square blocks of the difference grid, in pixels of the small frame
+        uint8_t blockSize = 10;
+        // Mean luma difference of a changed block, 0 ~ 255
+        uint8_t threshold = 10;
+        // Changed blocks that make an event
+        uint16_t minBlocks = 3;
+        // No further event for this long after one
+        uint16_t holdOffMs = 1000;
+    };
+    struct CameraMotionEvent_t {
+        uint16_t changedBlocks = 0;
+        uint16_t totalBlocks   = 0;
+        uint8_t maxDiff        = 0;
+    };
+    // Called on the camera task, the app loop is woken up after each event
+    using CameraMotionCallback_t = std::function<void(const CameraMotionEvent_t& event)>;
+    virtual bool startCameraMotionDetect(const CameraMotionConfig_t& config, CameraMotionCallback_t onMotion)
+    {
+        return false;
+    }
+    virtual void stopCameraMotionDetect()
+    {
+    }
+    virtual bool isCameraMotionDetecting()
+    {
+        return false;
+    }
+    // Time-lapse, one JPEG per interval to the SD card with the sensor stopped in between. For a shot the sensor
+    // streams without a preview until the auto exposure settles, then the next frame goes to the hardware encoder. It
+    // owns the camera like motion detection
+    struct CameraTimelapseConfig_t {
+        uint32_t intervalSec = 60;
+        // 0 runs until stopped
+        uint32_t maxShots = 0;
+        // Relative to the SD card root, shots are numbered from 0 in it
+        std::string directory = "timelapse";
+        // Picks the sensor mode, the JPEG has the full capture size
+        uint16_t width  = 1280;
+        uint16_t height = 720;
+        // The shot is taken once exposure and gain hold for a few frames, or after this many
+        uint8_t maxWarmupFrames = 30;
+        // Backlight off while it runs, back to the previous brightness on stop
+        bool displayOff = true;
+    };
+    virtual bool startCameraTimelapse(const CameraTimelapseConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopCameraTimelapse()
+    {
+    }
+    virtual bool isCameraTimelapseRunning()
+    {
+        return false;
+    }
+    virtual uint32_t getCameraTimelapseShots()
+    {
+        return 0;
+    }
+    // Inference on the preview, e.g. a face or object detector. The shown view is scaled down to a small frame for the
+    // detector, which runs on its own task on the other core and always gets the newest frame, older ones are
+    // overwritten. The preview keeps its own rate however slow the detector is, results are drawn on it as they come
+    struct CameraInferenceConfig_t {
+        // Inference frames fit in this size, aspect of the preview kept
+        uint16_t maxWidth  = 320;
+        uint16_t maxHeight = 320;
+        // Cap on the detector rate, 0 for as fast as it runs
+        uint8_t maxFps = 0;
+        // Boxes and labels on the preview, RGB565 previews only
+        bool drawOverlay      = true;
+        uint16_t overlayColor = 0x07E0;
+    };
+    // In pixels of the inference frame
+    struct CameraDetection_t {
+        int16_t x     = 0;
+        int16_t y     = 0;
+        int16_t w     = 0;
+        int16_t h     = 0;
+        float score   = 0.0f;
+        std::string label;
+    };
+    // Runs on the inference task with an RGB565 frame, rows packed. The frame stays valid until it returns
+    using CameraDetector_t =
+        std::function<std::vector<CameraDetection_t>(const uint16_t* frame, uint16_t width, uint16_t height)>;
+    // Called on the inference task after each run, the app loop is woken up after it
+    using CameraDetectionCallback_t = std::function<void(const std::vector<CameraDetection_t>& detections)>;
+    virtual bool startCameraInference(const CameraInferenceConfig_t& config, CameraDetector_t detector,
+                                      CameraDetectionCallback_t onDetections = nullptr)
+    {
+        return false;
+    }
+    virtual void stopCameraInference()
+    {
+    }
+    // Detector runs per second, 0 when not running
+    virtual float getCameraInferenceFps()
+    {
+        return 0.0f;
+    }
+    // QR and barcode scanning on a running RAW8 capture. Each frame is binned 2x2 straight from the Bayer plane into a
+    // grey frame, no RGB565 on the way, and decoded on a worker task on the other core, only while the picture changes
+    // and for a few frames after it settles. Decodes are published on GetEventBus() as EVENT_TOPIC_BARCODE
+    struct CameraBarcodeConfig_t {
+        // Grey frames fit in this size, the capture is binned down by even steps
+        uint16_t maxWidth  = 640;
+        uint16_t maxHeight = 480;
+        // Change detection between grey frames, see CameraMotionConfig_t
+        uint8_t blockSize = 16;
+        uint8_t threshold = 8;
+        // Frames still decoded after the picture stopped changing, the sharp ones
+        uint8_t settleFrames = 3;
+        // The same code again is only published after this long
+        uint16_t repeatMs = 2000;
+    };
+    struct CameraBarcode_t {
+        // Counts up with each published code, 0 before the first
+        uint32_t sequence = 0;
+        // Symbology from the decoder, e.g. "QR-Code" or "EAN-13"
+        std::string type;
+        std::string text;
+    };
+    virtual bool startCameraBarcodeScan(const CameraBarcodeConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopCameraBarcodeScan()
+    {
+    }
+    virtual bool isCameraBarcodeScanning()
+    {
+        return false;
+    }
+    // Last published code
+    virtual CameraBarcode_t getCameraBarcode()
+    {
+        return {};
+    }
+    // Captured frames shared in place with any number of consumers alongside the preview, the recorder and the
+    // encoders. Each one holds a reference on the driver buffer, which goes back to the sensor once the last handle is
+    // gone. Holding one a long time takes a buffer away from the capture, the preview slows down instead of copying
+    struct CameraFrame_t {
+        const uint8_t* data = nullptr;
+        uint32_t size       = 0;
+        uint16_t width      = 0;
+        uint16_t height     = 0;
+        // RAW8 captures are the Bayer plane
+        CameraPixelFormat_t pixelFormat = CAMERA_PIXEL_FORMAT_YUV420;
+        uint32_t sequence               = 0;
+        int64_t timestampUs             = 0;
+    };
+    using CameraFrameHandle_t = std::shared_ptr<const CameraFrame_t>;
+    // What a subscriber misses is its own, a busy subscriber never holds back the others
+    struct CameraFrameSubscriberConfig_t {
+        // Handles held at once, a frame that finds them all held is dropped for this subscriber
+        uint8_t maxHeld = 1;
+        // Cap on the rate, 0 for every frame it can take
+        uint8_t maxFps = 0;
+        // Also take the frames the preview skips for its own rate, see dropUnconsumedFrames
+        bool takeSkippedFrames = false;
+    };
+    struct CameraFrameSubscriberStats_t {
+        uint32_t delivered = 0;
+        uint32_t dropped   = 0;
+    };
+    // Called on the camera's requeue task, keep the handle and work on it elsewhere. Every handle has to be released
+    // for the capture to stop or switch its config
+    using CameraFrameCallback_t = std::function<void(CameraFrameHandle_t frame)>;
+    // Returns the subscriber id, 0 on failure
+    virtual int subscribeCameraFrames(const CameraFrameSubscriberConfig_t& config, CameraFrameCallback_t onFrame)
+    {
+        return 0;
+    }
+    // Handles already out stay valid
+    virtual void unsubscribeCameraFrames(int id)
+    {
+    }
+    virtual CameraFrameSubscriberStats_t getCameraFrameSubscriberStats(int id)
+    {
+        return {};
+    }
+
+    /* ---------------------------------- Audio --------------------------------- */
+    virtual void setSpeakerVolume(uint8_t volume)
+    {
+    }
+    virtual uint8_t getSpeakerVolume()
+    {
+        return 0;
+    }
+    // [MIC-L, AEC, MIC-R, MIC-HP]
+    virtual void audioRecord(std::vector<int16_t>& data, uint16_t durationMs, float gain = 80.0f)
+    {
+    }
+    // Interleaved 48kHz stereo, mixed over whatever is playing, volume 0~100 scales this sound only
+    virtual void audioPlay(std::vector<int16_t>& data, bool async = true, uint8_t volume = 100)
+    {
+    }
+    // Async play without a copy, data must stay valid until the sound ends, e.g. a prebuilt sound bank buffer
+    virtual void audioPlayBuffer(const int16_t* data, size_t size, uint8_t volume = 100)
+    {
+        std::vector<int16_t> buffer(data, data + size);
+        audioPlay(buffer, true, volume);
+    }
+    // Sine note with a linear attack and release, level is the peak in percent of full scale
+    struct AudioNote_t {
+        float frequency     = 440.0f;
+        uint16_t delayMs    = 0;
+        uint16_t durationMs = 100;
+        uint16_t attackMs   = 0;
+        uint16_t releaseMs  = 0;
+        uint8_t level       = 20;
+    };
+    // Async play synthesized notes, all mixed together, the base version renders them into one buffer
+    virtual void audioPlayNotes(const AudioNote_t* notes, size_t count);
+
+    // I2S DMA buffering, shared by playback and capture. The channels are created once at boot, so the profile is kept
+    // in the settings and a change takes effect after a restart
+    enum AudioDmaProfile_t {
+        // 4 x 2.5ms, UI sounds react fast, the mixer has little slack
+        AUDIO_DMA_LOW_LATENCY = 0,
+        // 6 x 5ms, the driver default
+        AUDIO_DMA_MUSIC,
+        // 8 x 10ms, rides out long SD card stalls
+        AUDIO_DMA_RECORDING,
+    };
+    virtual bool setAudioDmaProfile(AudioDmaProfile_t profile)
+    {
+        return false;
+    }
+    // The saved profile, may differ from the running one until the next boot
+    virtual AudioDmaProfile_t getAudioDmaProfile()
+    {
+        return AUDIO_DMA_MUSIC;
+    }
+    struct AudioDmaStats_t {
+        bool supported = false;
+        // Running profile and its buffering
+        AudioDmaProfile_t profile = AUDIO_DMA_MUSIC;
+        uint16_t descNum          = 0;
+        uint16_t frameNum         = 0;
+        float latencyMs           = 0.0f;
+        // Since boot, only counted while the mixer plays, the output went silent for a buffer each time
+        uint32_t txUnderruns = 0;
+        // Since boot, only counted while a capture runs, a buffer of input was lost each time
+        uint32_t rxOverruns = 0;
+    };
+    virtual AudioDmaStats_t getAudioDmaStats()
+    {
+        return AudioDmaStats_t();
+    }
+
+    // Streaming capture of the 48kHz TDM slots [MIC-L, AEC, MIC-R, MIC-HP]
+    // Shares the input channel with audioRecord() and the mic tests, they should not run at the same time
+    enum AudioCaptureChannel_t {
+        AUDIO_CAPTURE_MIC_L  = 1 << 0,
+        AUDIO_CAPTURE_AEC    = 1 << 1,
+        AUDIO_CAPTURE_MIC_R  = 1 << 2,
+        AUDIO_CAPTURE_MIC_HP = 1 << 3,
+        AUDIO_CAPTURE_ALL    = 0x0F,
+    };
+    struct AudioCaptureConfig_t {
+        // Routed slots, interleaved in slot order
+        uint8_t channelMask = AUDIO_CAPTURE_ALL;
+        // Output rate is 48kHz / decimation, each output frame averages that many input frames
+        uint8_t decimation = 1;
+        // Input frames per read, 480 is 10ms
+        uint16_t blockFrames = 480;
+        float gain           = 80.0f;
+        // Capacity of the pull ring, in output frames
+        uint32_t ringFrames = 24000;
+    };
+    // Called on the capture task for every routed block
+    using AudioCaptureCallback_t = std::function<void(const int16_t* data, size_t frames, uint8_t channels)>;
+    virtual bool startAudioCapture(const AudioCaptureConfig_t& config, AudioCaptureCallback_t onBlock = nullptr)
+    {
+        return false;
+    }
+    virtual void stopAudioCapture()
+    {
+    }
+    virtual bool isAudioCapturing()
+    {
+        return false;
+    }
+    // Pop routed frames from the capture ring without blocking, frames that do not fit the ring are dropped
+    virtual size_t readAudioCapture(int16_t* data, size_t maxFrames)
+    {
+        return 0;
+    }
+
+    // Full duplex voice capture at 16kHz, keeps running while sounds play, the playback echo is cancelled against
+    // the AEC slot and noise is suppressed, blocks only hold the selected mics and are read like a capture
+    struct AudioVoiceConfig_t {
+        uint8_t micMask    = AUDIO_CAPTURE_MIC_L | AUDIO_CAPTURE_MIC_R;
+        bool echoCancel    = true;
+        bool noiseSuppress = true;
+        float gain         = 80.0f;
+    };
+    virtual bool startVoiceCapture(const AudioVoiceConfig_t& config, AudioCaptureCallback_t onBlock = nullptr)
+    {
+        return false;
+    }
+
+    // Mic recording to a WAV file on the SD card, streamed from the capture ring and written in large blocks, so the
+    // length is only limited by the card. Runs a capture of its own, stop it with stopAudioRecorder()
+    enum AudioRecorderCodec_t {
+        AUDIO_RECORDER_PCM16 = 0,
+        // 4 bits a sample, a quarter of the PCM size for little CPU
+        AUDIO_RECORDER_IMA_ADPCM,
+    };
+    struct AudioRecorderConfig_t {
+        // Relative to the SD card root
+        std::string path           = "recordings/rec.wav";
+        AudioRecorderCodec_t codec = AUDIO_RECORDER_IMA_ADPCM;
+        uint8_t channelMask        = AUDIO_CAPTURE_MIC_L | AUDIO_CAPTURE_MIC_R;
+        // 48kHz / decimation
+        uint8_t decimation = 1;
+        float gain         = 80.0f;
+    };
+    struct AudioRecorderStatus_t {
+        bool recording      = false;
+        uint32_t durationMs = 0;
+        uint64_t bytes      = 0;
+        // Lost while the card was too slow
+        uint32_t droppedFrames = 0;
+        // Set when the recording ended on its own, e.g. the card is full
+        std::string error;
+    };
+    virtual bool startAudioRecorder(const AudioRecorderConfig_t& config)
+    {
+        return false;
+    }
+    // Writes the frames still in the ring and finishes the file header
+    virtual void stopAudioRecorder()
+    {
+    }
+    virtual AudioRecorderStatus_t getAudioRecorderStatus()
+    {
+        return AudioRecorderStatus_t();
+    }
+
+    // Low power listening, one mic at a low rate feeds a fixed point voice activity detector on the capture task.
+    // No performance level is claimed, so the CPU clock follows the light load. On detection the callback gets the
+    // audio just before it on the job pool, the app then wakes the display and starts the full voice pipeline
+    struct AudioListenConfig_t {
+        uint8_t micMask = AUDIO_CAPTURE_MIC_L;
+        // 48kHz / decimation, 6 is 8kHz
+        uint8_t decimation = 6;
+        float gain         = 80.0f;
+        // Frames above the noise floor by this much count as voice, minSpeechMs of them trigger
+        float thresholdDb    = 12.0f;
+        uint16_t minSpeechMs = 120;
+        // Kept ahead of the trigger, handed to the callback
+        uint16_t preRollMs = 500;
+    };
+    using AudioListenCallback_t = std::function<void(const int16_t* preRoll, size_t frames, uint32_t sampleRate)>;
+    virtual bool startAudioListening(const AudioListenConfig_t& config, AudioListenCallback_t onVoice)
+    {
+        return false;
+    }
+    // Stops the capture as well, same as stopAudioCapture()
+    virtual void stopAudioListening()
+    {
+    }
+    virtual bool isAudioListening()
+    {
+        return false;
+    }
+
+    // Mic record test
+    enum MicTestState_t {
+        MIC_TEST_IDLE,
+        MIC_TEST_RECORDING,
+        MIC_TEST_PLAYING,
+    };
+    virtual void startDualMicRecordTest()
+    {
+    }
+    virtual MicTestState_t getDualMicRecordTestState()
+    {
+        return MIC_TEST_IDLE;
+    }
+    virtual void startHeadphoneMicRecordTest()
+    {
+    }
+    virtual MicTestState_t getHeadphoneMicRecordTestState()
+    {
+        return MIC_TEST_IDLE;
+    }
+
+    // Play music test
+    enum MusicPlayState_t {
+        MUSIC_PLAY_IDLE,
+        MUSIC_PLAY_PLAYING,
+    };
+    virtual void startPlayMusicTest()
+    {
+    }
+    virtual MusicPlayState_t getMusicPlayTestState()
+    {
+        return MUSIC_PLAY_IDLE;
+    }
+    virtual void stopPlayMusicTest()
+    {
+    }
+
+    // Music queue, paths are relative to the SD card root, mp3 or wav
+    virtual bool queueMusic(const std::string& path)
+    {
+        return false;
+    }
+    // Stop the playing track and go on with the next queued one
+    virtual void skipMusic()
+    {
+    }
+    // Drop the queued tracks, the playing one keeps playing
+    virtual void clearMusicQueue()
+    {
+    }
+    virtual std::vector<std::string> getMusicQueue()
+    {
+        return {};
+    }
+    virtual std::string getPlayingMusic()
+    {
+        return "";
+    }
+
+    // Sfx
+    virtual void playStartupSfx()
+    {
+    }
+    virtual void playShutdownSfx()
+    {
+    }
+
+    /* --------------------------------- Network -------------------------------- */
+    virtual void setExtAntennaEnable(bool enable)
+    {
+    }
+    virtual bool getExtAntennaEnable()
+    {
+        return false;
+    }
+    virtual void startWifiAp()
+    {
+    }
+    // Station mode, credentials are kept in NVS. The BSSID and channel of the last AP are cached as well, so a
+    // reconnect joins it directly instead of scanning. Changes are published on GetEventBus() as EVENT_TOPIC_WIFI
+    enum WifiState_t {
+        WIFI_STATE_IDLE = 0,
+        WIFI_STATE_CONNECTING,
+        // Associated and holding an IP
+        WIFI_STATE_CONNECTED,
+        // Lost the AP, retrying with a backoff
+        WIFI_STATE_DISCONNECTED,
+        // The AP rejected the credentials, still retrying at the longest backoff
+        WIFI_STATE_FAILED,
+    };
+    struct WifiStatus_t {
+        WifiState_t state = WIFI_STATE_IDLE;
+        std::string ssid;
+        std::string ip;
+        int8_t rssi     = 0;
+        uint8_t channel = 0;
+        // From the connect call to the IP of the last connection, and whether it used the cached AP
+        uint32_t connectTimeMs = 0;
+        bool isFastConnect     = false;
+        uint32_t retries       = 0;
+    };
+    virtual bool setWifiCredentials(const std::string& ssid, const std::string& password)
+    {
+        return false;
+    }
+    virtual void clearWifiCredentials()
+    {
+    }
+    virtual bool hasWifiCredentials()
+    {
+        return false;
+    }
+    // Connects with the stored credentials and keeps reconnecting until stopWifiSta()
+    virtual bool startWifiSta()
+    {
+        return false;
+    }
+    virtual void stopWifiSta()
+    {
+    }
+    virtual WifiStatus_t getWifiStatus()
+    {
+        return WifiStatus_t();
+    }
+    // Drive strength of the SDIO pins to the ESP32-C6 coprocessor, 0 weakest to 3 strongest. Kept in the settings and
+    // applied at the end of boot, a change takes effect right away
+    virtual bool setWifiLinkDrive(uint8_t level)
+    {
+        return false;
+    }
+    virtual uint8_t getWifiLinkDrive()
+    {
+        return 0;
+    }
+    // iperf style throughput through the coprocessor link, on whichever interface reaches the peer. The TX modes send
+    // to iperf 2 on a PC (iperf -s, iperf -s -u), the RX modes take iperf -c <tab5 ip> (-u) for the duration
+    enum WifiBenchmarkMode_t {
+        WIFI_BENCHMARK_TCP_TX = 0,
+        WIFI_BENCHMARK_TCP_RX,
+        WIFI_BENCHMARK_UDP_TX,
+        WIFI_BENCHMARK_UDP_RX,
+    };
+    struct WifiBenchmarkConfig_t {
+        WifiBenchmarkMode_t mode = WIFI_BENCHMARK_TCP_TX;
+        // Peer of the TX modes
+        std::string host;
+        uint16_t port        = 5001;
+        uint16_t durationSec = 10;
+        // Bytes per send, 0 for 16 KB on TCP and 1470 on UDP
+        uint16_t blockSize = 0;
+        // UDP TX pace, 0 sends as fast as the link takes it
+        uint32_t udpRateKbps = 0;
+        // One run per drive strength, the fastest is kept
+        bool isDriveSweep = false;
+    };
+    enum WifiBenchmarkState_t {
+        WIFI_BENCHMARK_IDLE = 0,
+        WIFI_BENCHMARK_RUNNING,
+        WIFI_BENCHMARK_DONE,
+        WIFI_BENCHMARK_FAILED,
+    };
+    struct WifiBenchmarkRun_t {
+        uint8_t drive  = 0;
+        float mbps     = 0.0f;
+        uint64_t bytes = 0;
+        // UDP RX, from the iperf sequence numbers
+        uint32_t packets = 0;
+        uint32_t lost    = 0;
+    };
+    struct WifiBenchmarkResult_t {
+        WifiBenchmarkState_t state = WIFI_BENCHMARK_IDLE;
+        std::vector<WifiBenchmarkRun_t> runs;
+        // The link as built, clock and queues are set in menuconfig under ESP-Hosted
+        uint32_t sdioClockKhz = 0;
+        uint8_t sdioBusWidth  = 0;
+        uint16_t sdioTxQueue  = 0;
+        uint16_t sdioRxQueue  = 0;
+        int8_t rssi           = 0;
+        std::string error;
+    };
+    virtual bool startWifiBenchmark(const WifiBenchmarkConfig_t& config)
+    {
+        return false;
+    }
+    virtual WifiBenchmarkResult_t getWifiBenchmarkResult()
+    {
+        return WifiBenchmarkResult_t();
+    }
+
+    /* --------------------------------- SD Card -------------------------------- */
+    struct FileEntry_t {
+        std::string name;
+        bool isDir;
+    };
+    // The card stays mounted at /sd, a swapped card is picked up again in the background
+    virtual bool isSdCardMounted()
+    {
+        return false;
+    }
+    // Blocks until the whole directory is read
+    virtual std::vector<FileEntry_t> scanSdCard(const std::string& dirPath)
+    {
+        return {};
+    }
+    // Directory listing on a background task, handed out in pages so large directories never stall the UI loop
+    struct SdCardScanPage_t {
+        uint32_t scanId = 0;
+        std::vector<FileEntry_t> entries;
+        // Set on the final page, which may be empty
+        bool isLast   = false;
+        bool isFailed = false;
+    };
+    // Returns the scan id, 0 when no card is mounted. A new scan cancels the one still running
+    virtual uint32_t startSdCardScan(const std::string& dirPath, size_t pageSize)
+    {
+        return 0;
+    }
+    // Non blocking, false until the next page of the current scan is ready
+    virtual bool getSdCardScanPage(SdCardScanPage_t& page)
+    {
+        return false;
+    }
+    virtual void cancelSdCardScan()
+    {
+    }
+    // Sequential and random throughput against a scratch file on the card, run on a background task
+    struct SdCardBenchmarkConfig_t {
+        uint32_t fileSizeKb = 16 * 1024;
+        // Sequential transfers, a multiple of the cluster size
+        uint32_t blockSizeKb = 64;
+        // Random transfers, spread over the whole file
+        uint32_t randomBlockSize = 4096;
+        uint32_t randomOps       = 512;
+    };
+    enum SdCardBenchmarkState_t {
+        SD_BENCHMARK_IDLE = 0,
+        SD_BENCHMARK_RUNNING,
+        SD_BENCHMARK_DONE,
+        SD_BENCHMARK_FAILED,
+    };
+    struct SdCardBenchmarkResult_t {
+        SdCardBenchmarkState_t state = SD_BENCHMARK_IDLE;
+        // Bus the card was mounted with
+        uint32_t busFreqKhz = 0;
+        bool isDdr          = false;
+        float seqWriteMBps  = 0.0f;
+        float seqReadMBps   = 0.0f;
+        float randWriteIops = 0.0f;
+        float randReadIops  = 0.0f;
+        std::string error;
+    };
+    virtual bool startSdCardBenchmark(const SdCardBenchmarkConfig_t& config)
+    {
+        return false;
+    }
+    virtual SdCardBenchmarkResult_t getSdCardBenchmarkResult()
+    {
+        return SdCardBenchmarkResult_t();
+    }
+
+    /* --------------------------------- Gallery -------------------------------- */
+    // JPEGs on the SD card decoded by the hardware codec on a background task, fitted into a box and kept in PSRAM.
+    // The current picture is decoded first, then its neighbours, nearest and next one first, so a swipe finds the
+    // picture ready. Thumbnails are kept in a cache file on the card, keyed by path, size and modification time, and
+    // are only decoded the first time a picture is seen
+    struct GalleryConfig_t {
+        // Pictures are scaled down to fit, never up
+        uint16_t fitWidth  = 1280;
+        uint16_t fitHeight = 720;
+        uint16_t thumbSize = 160;
+        // Pictures kept decoded on each side of the current one
+        uint8_t prefetch = 2;
+        // Thumbnails kept in PSRAM, the cache file holds up to thumbCacheEntries
+        uint16_t thumbsInMemory    = 64;
+        uint16_t thumbCacheEntries = 2048;
+        // Larger JPEGs are skipped, the decode buffer holds one picture of this size
+        uint32_t maxPixels = 2592 * 1944;
+    };
+    enum GalleryItemState_t {
+        GALLERY_PENDING = 0,
+        GALLERY_READY,
+        GALLERY_FAILED,
+    };
+    struct GalleryPicture_t {
+        uint16_t width  = 0;
+        uint16_t height = 0;
+        // RGB565 rows of width pixels, shared with the cache, so a picture on screen outlives its eviction
+        std::shared_ptr<uint8_t> data;
+    };
+    struct GalleryStats_t {
+        uint32_t decodes       = 0;
+        uint32_t failures      = 0;
+        uint32_t lastDecodeMs  = 0;
+        uint32_t pictureHits   = 0;  // Current pictures that were decoded already
+        uint32_t pictureMisses = 0;
+        uint32_t thumbHits     = 0;  // Thumbnails read from the cache file
+        uint32_t thumbDecodes  = 0;
+    };
+    // paths are relative to the SD card root, the index of a picture is its place in paths
+    virtual bool openGallery(const std::vector<std::string>& paths, const GalleryConfig_t& config)
+    {
+        return false;
+    }
+    virtual void closeGallery()
+    {
+    }
+    // Picture on screen, decoded before anything else. -1 while the pictures are browsed as thumbnails
+    virtual void setGalleryIndex(int32_t index)
+    {
+    }
+    // Non blocking, a pending picture is only decoded while it is current or a neighbour
+    virtual GalleryItemState_t getGalleryPicture(size_t index, GalleryPicture_t& picture)
+    {
+        return GALLERY_FAILED;
+    }
+    // Non blocking, a pending thumbnail is queued, the thumbnails asked for last are made first
+    virtual GalleryItemState_t getGalleryThumbnail(size_t index, GalleryPicture_t& thumbnail)
+    {
+        return GALLERY_FAILED;
+    }
+    virtual GalleryStats_t getGalleryStats()
+    {
+        return GalleryStats_t();
+    }
+
+    /* ------------------------------ Video Player ------------------------------ */
+    // MJPEG from the SD card, AVIs as the camera records them or raw concatenated JPEGs. A reader task demuxes the file
+    // behind a read ahead ring, the hardware codec decodes into a ring of frames and the PPA scales each one into the
+    // canvas, which the display port rotates straight into the frame buffer as the video plane. A PCM track plays
+    // through the mixer stream and frames are shown against the samples heard, late ones are dropped before decoding
+    struct VideoPlayerConfig_t {
+        // RGB565 canvas without row padding, the video is fitted inside its buffer and centered. The player's frames
+        // take the place of the buffer while playing, stop before the canvas is deleted
+        lv_obj_t* canvas = nullptr;
+        // Frame rate of a raw MJPEG file, AVIs carry their own
+        uint8_t fps    = 30;
+        uint8_t volume = 80;
+        bool loop      = false;
+        // Frames decoded ahead of the one on screen
+        uint8_t framesAhead = 3;
+    };
+    enum VideoPlayerState_t {
+        VIDEO_PLAYER_IDLE = 0,
+        VIDEO_PLAYER_PLAYING,
+        VIDEO_PLAYER_ENDED,
+        VIDEO_PLAYER_FAILED,
+    };
+    struct VideoPlayerStats_t {
+        VideoPlayerState_t state = VIDEO_PLAYER_IDLE;
+        uint16_t width           = 0;
+        uint16_t height          = 0;
+        float fps                = 0.0f;
+        uint32_t positionMs      = 0;
+        uint32_t durationMs      = 0;  // 0 when the file does not say
+        uint32_t framesShown     = 0;
+        uint32_t framesDropped   = 0;  // Late, skipped before or after decoding
+        uint32_t decodeFailures  = 0;
+        uint32_t lastDecodeUs    = 0;  // Codec and PPA for the last frame
+        bool hasAudio            = false;
+        bool isVideoPlane        = false;
+    };
+    // path is relative to the SD card root. At the end the state turns ENDED, the last frame stays up until stopped
+    virtual bool startVideoPlayback(const std::string& path, const VideoPlayerConfig_t& config)
+    {
+        return false;
+    }
+    // The canvas gets its own buffer back, with the frame on screen copied in
+    virtual void stopVideoPlayback()
+    {
+    }
+    virtual VideoPlayerStats_t getVideoPlayerStats()
+    {
+        return VideoPlayerStats_t();
+    }
+
+    /* ------------------------------- Binary Log ------------------------------- */
+    // Log lines from mooncake_log (and ESP_LOGx when captured) are copied into a PSRAM ring without blocking, a low
+    // priority task writes them to /sd/logs in CRC framed segments. Lines logged before the card is mounted wait in
+    // the ring, lines that do not fit are counted as dropped
+    struct BinaryLogConfig_t {
+        uint32_t ringSizeKb = 256;
+        // A segment is written once this much is pending, or flushIntervalMs after the oldest pending line
+        uint32_t segmentSizeKb   = 32;
+        uint32_t flushIntervalMs = 2000;
+        // A new file is started past fileSizeKb, the oldest files are deleted past maxFiles
+        uint32_t fileSizeKb = 4096;
+        uint32_t maxFiles   = 64;
+        bool captureEspLog  = true;
+    };
+    struct BinaryLogStats_t {
+        bool isRunning        = false;
+        uint32_t records      = 0;
+        uint32_t dropped      = 0;
+        uint32_t segments     = 0;
+        uint64_t bytesWritten = 0;
+        uint32_t writeErrors  = 0;
+        // Empty while no card is mounted
+        std::string file;
+    };
+    virtual bool startBinaryLog(const BinaryLogConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopBinaryLog()
+    {
     }
-    virtual void startWifiAp()
+    virtual BinaryLogStats_t getBinaryLogStats()
     {
+        return BinaryLogStats_t();
     }
 
-    /* --------------------------------- SD Card -------------------------------- */
-    struct FileEntry_t {
-        std::string name;
-        bool isDir;
+    /* ------------------------------- Time Series ------------------------------ */
+    // Sensor values kept for weeks on the SD card under /sd/tsdb, a directory per series. Samples are batched in RAM
+    // and written as compressed blocks, indexed with their time range, min, max and sum, next to per minute and per
+    // hour rollups. A range query reads the aggregates that cover it and decodes only the blocks cut by its ends
+    struct TimeSeriesConfig_t {
+        // A series is written once it has this many samples pending
+        uint16_t blockSamples = 512;
+        // Shorter blocks go out after this long, a power loss costs at most this much
+        uint16_t flushIntervalSec = 120;
+        // The built in series pm_voltage, pm_current, pm_power, imu_accel and cpu_temp are means of the sensor
+        // service history over this period. 0 leaves them out
+        uint16_t sensorIntervalMs = 1000;
     };
-    virtual bool isSdCardMounted()
+    struct TimeSeriesStats_t {
+        bool isRunning        = false;
+        uint32_t series       = 0;
+        uint32_t samples      = 0;
+        uint32_t dropped      = 0;
+        uint32_t blocks       = 0;
+        uint64_t bytesWritten = 0;
+        uint32_t writeErrors  = 0;
+    };
+    struct TimeSeriesResult_t {
+        uint32_t count = 0;
+        float min      = 0.0f;
+        float max      = 0.0f;
+        float mean     = 0.0f;
+        // What the query read from the card
+        uint32_t rollupsRead   = 0;
+        uint32_t indexRead     = 0;
+        uint32_t blocksDecoded = 0;
+    };
+    virtual bool startTimeSeries(const TimeSeriesConfig_t& config)
     {
         return false;
     }
-    virtual std::vector<FileEntry_t> scanSdCard(const std::string& dirPath)
+    // Writes what is pending
+    virtual void stopTimeSeries()
+    {
+    }
+    virtual TimeSeriesStats_t getTimeSeriesStats()
+    {
+        return TimeSeriesStats_t();
+    }
+    // Any task, for RS485 readings and other app values. Times are unix ms and increase per series, names are up to
+    // 15 characters. False if it is not running or the sample was dropped
+    virtual bool timeSeriesAppend(const std::string& series, int64_t timeMs, float value)
+    {
+        return false;
+    }
+    // Over [startMs, endMs) in unix ms. Reads the card, so not from the LVGL task. False if it is not running, no card
+    // is mounted or the series is unknown
+    virtual bool timeSeriesQuery(const std::string& series, int64_t startMs, int64_t endMs, TimeSeriesResult_t& result)
+    {
+        return false;
+    }
+
+    /* ------------------------------- USB Export ------------------------------- */
+    // Bulk data to a PC over the USB-C console port, in CRC framed packets a host tool picks out of the console
+    // text. Producers copy into a PSRAM ring without waiting on USB, a task sends it out while a host has the port open
+    enum ExportChannel_t : uint8_t {
+        EXPORT_CHANNEL_LOG = 1,  // Binary log segments as written to the card
+        EXPORT_CHANNEL_POWER,    // PMData_t samples from powerMonitorHistory
+        EXPORT_CHANNEL_IMU,      // IMUData_t samples from imuHistory
+        EXPORT_CHANNEL_IMAGE,
+        EXPORT_CHANNEL_USER = 16,
+    };
+    struct UsbExportConfig_t {
+        uint32_t ringSizeKb = 1024;
+        bool exportLog      = true;
+        // History rings are read this often, 0 leaves them out
+        uint16_t sensorIntervalMs = 50;
+    };
+    struct UsbExportStats_t {
+        bool isRunning       = false;
+        bool isHostConnected = false;
+        uint32_t frames      = 0;
+        uint32_t dropped     = 0;
+        uint64_t bytesSent   = 0;
+    };
+    virtual bool startUsbExport(const UsbExportConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopUsbExport()
+    {
+    }
+    virtual UsbExportStats_t getUsbExportStats()
+    {
+        return UsbExportStats_t();
+    }
+    // Queues one frame from any task, false if it is not running or the ring has no room for the whole frame
+    virtual bool usbExportWrite(uint8_t channel, const void* data, size_t size)
+    {
+        return false;
+    }
+
+    /* ------------------------------- USB Storage ------------------------------ */
+    // A flash drive on the USB-A port is mounted at /usb while it is attached, more drives behind a hub at /usb1 on
+    virtual bool isUsbDriveMounted()
+    {
+        return false;
+    }
+    virtual std::vector<std::string> getUsbDriveMountPoints()
+    {
+        return {};
+    }
+    enum FileCopyState_t {
+        FILE_COPY_IDLE = 0,
+        FILE_COPY_SCANNING,
+        FILE_COPY_COPYING,
+        FILE_COPY_DONE,
+        FILE_COPY_FAILED,
+        FILE_COPY_CANCELLED,
+    };
+    struct FileCopyProgress_t {
+        FileCopyState_t state   = FILE_COPY_IDLE;
+        uint32_t filesDone      = 0;
+        uint32_t filesTotal     = 0;
+        uint64_t bytesDone      = 0;
+        uint64_t bytesTotal     = 0;
+        uint32_t bytesPerSecond = 0;
+        std::string currentFile;
+        std::string error;
+    };
+    // Copies a file or a directory tree in the background, paths are absolute such as "/usb/logs" and "/sd/logs"
+    virtual bool startFileCopy(const std::string& srcPath, const std::string& dstPath)
+    {
+        return false;
+    }
+    virtual void cancelFileCopy()
+    {
+    }
+    virtual FileCopyProgress_t getFileCopyProgress()
     {
         return {};
     }
 
+    /* ------------------------------- USB Serial ------------------------------- */
+    // CDC-ACM devices on the USB-A port or behind a hub, ports 0 and 1 in the order they connected. Received bytes
+    // are buffered until read, writes block for up to 100 ms
+    virtual bool isUsbSerialConnected(int port)
+    {
+        return false;
+    }
+    virtual size_t usbSerialWrite(int port, const void* data, size_t size)
+    {
+        return 0;
+    }
+    virtual size_t usbSerialRead(int port, void* data, size_t size)
+    {
+        return 0;
+    }
+    virtual bool setUsbSerialBaudRate(int port, uint32_t baudRate)
+    {
+        return false;
+    }
+
     /* -------------------------------- Interface ------------------------------- */
+    // Port states are cached by a background service, these are cheap to call every frame. Debounced changes are
+    // published on GetEventBus() as EVENT_TOPIC_PORT, SD card changes as EVENT_TOPIC_SD_CARD
     virtual bool usbCDetect()
     {
         return false;
@@ -289,6 +2260,42 @@ public:
     {
         return {};
     }
+    // Bus scan on a background task with a short per address timeout, the UI polls the progress and draws the
+    // addresses as they answer. Port A is brought up for it and left up, deinitPortAI2c() cancels a running scan
+    struct I2cScanProgress_t {
+        uint32_t scanId = 0;
+        bool isInternal = true;
+        bool isDone     = false;
+        // The bus timed out on every probe, most likely held low
+        bool isFailed       = false;
+        uint8_t nextAddress = 0;
+        std::vector<uint8_t> addresses;
+    };
+    virtual uint32_t startI2cScan(bool isInternal)
+    {
+        return 0;
+    }
+    virtual bool getI2cScanProgress(I2cScanProgress_t& progress)
+    {
+        return false;
+    }
+    virtual void cancelI2cScan()
+    {
+    }
+    // Per device turns on the internal bus, wait is the time queued behind other devices
+    struct I2cDeviceStats_t {
+        uint8_t address    = 0;
+        uint32_t batches   = 0;
+        uint32_t errors    = 0;
+        uint32_t avgWaitUs = 0;
+        uint32_t maxWaitUs = 0;
+        uint32_t avgBusUs  = 0;
+        uint32_t maxBusUs  = 0;
+    };
+    virtual std::vector<I2cDeviceStats_t> getI2cStats()
+    {
+        return {};
+    }
     virtual void initPortAI2c()
     {
     }
@@ -306,22 +2313,558 @@ public:
     {
     }
 
+    /* ----------------------------- Port A sensors ----------------------------- */
+    // External I2C units on Port A, the platform keeps drivers by the address their unit answers on. Start probes
+    // those addresses, binds a driver for each unit found and polls them all from one task, the triggers and burst
+    // reads of the units due on a tick go out together. Readings land in per unit snapshots, the UI only copies them
+    struct ExtSensorReading_t {
+        uint8_t count   = 0;
+        float values[8] = {};
+    };
+    struct ExtSensorInfo_t {
+        std::string name;
+        uint8_t address     = 0;
+        uint16_t intervalMs = 0;
+        // One per value, with the unit, e.g. "temp C"
+        std::vector<std::string> valueNames;
+        uint32_t reads  = 0;
+        uint32_t errors = 0;
+    };
+    // False when no known unit answers, Port A is left as it was then
+    virtual bool startExtSensors()
+    {
+        return false;
+    }
+    virtual void stopExtSensors()
+    {
+    }
+    virtual bool isExtSensorsRunning()
+    {
+        return false;
+    }
+    // The bound units, the index is the one readExtSensor() takes
+    virtual std::vector<ExtSensorInfo_t> getExtSensors()
+    {
+        return {};
+    }
+    // Latest reading of a bound unit, false until its first good read
+    virtual bool readExtSensor(size_t index, ExtSensorReading_t& reading, uint32_t* timeMs = nullptr)
+    {
+        return false;
+    }
+
+    /* ------------------------------ GPIO waveform ----------------------------- */
+    // Hardware timed output on a header pin, the edges come from the peripheral without the CPU in the loop
+    struct GpioWaveformStep_t {
+        bool level          = false;
+        uint32_t durationNs = 0;
+    };
+    struct GpioWaveformConfig_t {
+        uint8_t pin = 0;
+        // Tick the step durations are rounded to
+        uint32_t resolutionHz = 10000000;
+        // Times the pattern is sent, 0 repeats until stopped
+        uint32_t repeat = 1;
+        bool idleLevel  = false;
+    };
+    struct GpioWaveformStatus_t {
+        bool running   = false;
+        bool looping   = false;  // Repeats until stopped
+        bool dma       = false;
+        uint32_t steps = 0;  // After splitting steps longer than a symbol
+        float tickNs   = 0.0f;
+    };
+    // Patterns that fit in the channel memory repeat seamlessly, longer ones stream from DMA and only play once
+    virtual bool startGpioPattern(const GpioWaveformConfig_t& config, const std::vector<GpioWaveformStep_t>& steps)
+    {
+        return false;
+    }
+    // Runs until stopped, duty 0 to 1
+    virtual bool startGpioPwm(uint8_t pin, uint32_t frequencyHz, float duty)
+    {
+        return false;
+    }
+    // Leaves the pin a plain output at the idle level
+    virtual void stopGpioWaveform(uint8_t pin)
+    {
+    }
+    virtual GpioWaveformStatus_t getGpioWaveformStatus(uint8_t pin)
+    {
+        return {};
+    }
+    // MSB first, each bit held for bitNs
+    bool startGpioBits(const GpioWaveformConfig_t& config,
+                       const std::vector<uint8_t>& bits,
+                       size_t bitCount,
+                       uint32_t bitNs)
+    {
+        std::vector<GpioWaveformStep_t> steps;
+        bitCount = std::min(bitCount, bits.size() * 8);
+        for (size_t i = 0; i < bitCount; i++) {
+            bool level = (bits[i / 8] >> (7 - i % 8)) & 1;
+            if (!steps.empty() && steps.back().level == level) {
+                steps.back().durationNs += bitNs;
+            } else {
+                steps.push_back({level, bitNs});
+            }
+        }
+        return startGpioPattern(config, steps);
+    }
+
+    /* ------------------------------ Logic capture ----------------------------- */
+    // Header pins sampled together by the peripheral into a PSRAM ring, bit i of a sample is pins[i]. The pins are
+    // switched to inputs
+    struct LogicCaptureConfig_t {
+        std::vector<uint8_t> pins;  // Up to 8
+        uint32_t sampleRateHz  = 1000000;
+        uint32_t bufferSamples = 2 * 1024 * 1024;
+    };
+    struct LogicCaptureStatus_t {
+        bool running          = false;
+        uint8_t lanes         = 0;
+        uint32_t sampleRateHz = 0;  // Actual, after the clock divider
+        uint64_t samples      = 0;  // Since the start
+    };
+    virtual bool startLogicCapture(const LogicCaptureConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopLogicCapture()
+    {
+    }
+    virtual LogicCaptureStatus_t getLogicCaptureStatus()
+    {
+        return {};
+    }
+    // Latest windowSamples reduced to min.size() buckets, oldest first. Per lane the min is the AND and the max the OR
+    // of the bucket, a lane that differs toggled within it. Returns the samples covered
+    virtual uint32_t getLogicEnvelope(uint32_t windowSamples, std::vector<uint8_t>& min, std::vector<uint8_t>& max)
+    {
+        return 0;
+    }
+
+    /* --------------------------------- Keypad --------------------------------- */
+    // Keyboard accessory on the TCA8418 scanner of Port A. Its event FIFO is drained on the interrupt line and fed to
+    // an LVGL keypad indev driving the default group, a held key repeats on its own timer
+    struct KeypadConfig_t {
+        uint16_t repeatDelayMs    = 400;
+        uint16_t repeatIntervalMs = 60;  // 0 for no repeat
+    };
+    struct KeypadStats_t {
+        uint32_t events  = 0;
+        uint32_t repeats = 0;
+        uint32_t dropped = 0;  // The LVGL side fell behind
+    };
+    // False when no scanner answers, Port A is left free then
+    virtual bool startKeypad(const KeypadConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopKeypad()
+    {
+    }
+    virtual bool isKeypadRunning()
+    {
+        return false;
+    }
+    virtual void setKeypadRepeat(uint16_t delayMs, uint16_t intervalMs)
+    {
+    }
+    virtual KeypadStats_t getKeypadStats()
+    {
+        return {};
+    }
+
     /* ------------------------------ UART monitor ------------------------------ */
     struct UartMonitorData_t {
-        std::mutex mutex;
-        std::queue<uint8_t> rxQueue;
-        std::queue<uint8_t> txQueue;
+        // Receive task to the com monitor panel, bytes that do not fit are dropped and counted
+        SpscRing<uint8_t> rxRing;
+        std::atomic<uint32_t> rxDropped{0};
+
+        UartMonitorData_t()
+        {
+            rxRing.init(4096);
+        }
     };
     UartMonitorData_t uartMonitorData;
+    // Sent by the platform straight to its transmit path
     virtual void uartMonitorSend(std::string msg, bool newLine = true)
     {
-        std::lock_guard<std::mutex> lock(uartMonitorData.mutex);
-        for (auto c : msg) {
-            uartMonitorData.txQueue.push(c);
-        }
-        if (newLine) {
-            uartMonitorData.txQueue.push('\n');
-        }
+    }
+
+    /* ---------------------------------- RS485 --------------------------------- */
+    enum Rs485Parity_t {
+        RS485_PARITY_NONE = 0,
+        RS485_PARITY_EVEN,
+        RS485_PARITY_ODD,
+    };
+    struct Rs485Config_t {
+        // Up to 5 Mbaud
+        uint32_t baudRate    = 115200;
+        Rs485Parity_t parity = RS485_PARITY_NONE;
+        uint32_t rxRingSize  = 16384;
+        uint32_t txRingSize  = 8192;
+        // A frame ends after this many idle symbols on the line
+        uint8_t frameTimeoutSymbols = 10;
+        // With a pattern set, frames end after patternCount of patternChar in a row instead, e.g. '\n' for text lines
+        int16_t patternChar  = -1;
+        uint8_t patternCount = 1;
+    };
+    struct Rs485Stats_t {
+        uint64_t rxBytes       = 0;
+        uint64_t txBytes       = 0;
+        uint32_t frames        = 0;
+        uint32_t fifoOverflows = 0;
+        uint32_t ringOverflows = 0;
+        uint32_t lineErrors    = 0;
+    };
+    // Called from the RS485 task with each received frame
+    using Rs485FrameCallback_t = std::function<void(const uint8_t* data, size_t size)>;
+    // Reinstall the port with config, without onFrame the received bytes go to uartMonitorData as in monitor mode
+    virtual bool setRs485Config(const Rs485Config_t& config, Rs485FrameCallback_t onFrame = nullptr)
+    {
+        return false;
+    }
+    // Queued to the tx ring, returns the count accepted
+    virtual size_t rs485Write(const uint8_t* data, size_t size)
+    {
+        return 0;
+    }
+    virtual Rs485Stats_t getRs485Stats()
+    {
+        return Rs485Stats_t();
+    }
+
+    /* ------------------------------- Modbus RTU ------------------------------- */
+    enum ModbusFunction_t : uint8_t {
+        MODBUS_READ_COILS               = 0x01,
+        MODBUS_READ_DISCRETE_INPUTS     = 0x02,
+        MODBUS_READ_HOLDING_REGISTERS   = 0x03,
+        MODBUS_READ_INPUT_REGISTERS     = 0x04,
+        MODBUS_WRITE_SINGLE_REGISTER    = 0x06,
+        MODBUS_WRITE_MULTIPLE_REGISTERS = 0x10,
+    };
+    struct ModbusPoll_t {
+        uint8_t slaveId           = 1;
+        ModbusFunction_t function = MODBUS_READ_HOLDING_REGISTERS;
+        uint16_t address          = 0;
+        // Registers, or bits for the coil and discrete input reads
+        uint16_t count      = 1;
+        uint16_t intervalMs = 1000;
+    };
+    struct ModbusConfig_t {
+        // The frame timeout is derived from the baud rate, the pattern settings are ignored
+        Rs485Config_t port;
+        bool isSlave = false;
+        // Own address in slave mode
+        uint8_t slaveId            = 1;
+        uint16_t responseTimeoutMs = 100;
+        // Master mode schedule, the values are published to the shared data in this order
+        std::vector<ModbusPoll_t> polls;
+        // Slave mode holding register map, also served to the input register reads
+        uint16_t slaveRegisterCount = 128;
+    };
+    struct ModbusStats_t {
+        uint32_t requests   = 0;
+        uint32_t responses  = 0;
+        uint32_t timeouts   = 0;
+        uint32_t crcErrors  = 0;
+        uint32_t exceptions = 0;
+        // Polls started later than their interval allows
+        uint32_t overruns = 0;
+    };
+    // Takes over the RS485 port, stopModbus() hands it back to monitor mode
+    virtual bool startModbus(const ModbusConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopModbus()
+    {
+    }
+    virtual bool isModbusRunning()
+    {
+        return false;
+    }
+    // Master mode, sent ahead of the next due poll
+    virtual bool modbusWriteRegisters(uint8_t slaveId, uint16_t address, const std::vector<uint16_t>& values)
+    {
+        return false;
+    }
+    // Slave mode register map
+    virtual void setModbusSlaveRegister(uint16_t address, uint16_t value)
+    {
+    }
+    virtual uint16_t getModbusSlaveRegister(uint16_t address)
+    {
+        return 0;
+    }
+    virtual ModbusStats_t getModbusStats()
+    {
+        return ModbusStats_t();
+    }
+
+    /* ------------------------------ RS485 gateway ----------------------------- */
+    // Transparent bridge between the RS485 port and one TCP client, e.g. nc <tab5 ip> 4001 over the STA link. Each
+    // frame the UART idle timeout ends goes out as one TCP segment, the bytes from the client go out on the line as
+    // they arrive. Neither side is read while the other can't take more, RS485 has no flow control so a client that
+    // stalls longer than sendTimeoutMs loses frames once the rx ring is full
+    struct Rs485GatewayConfig_t {
+        // The pattern settings are ignored, frames are cut by frameTimeoutSymbols
+        Rs485Config_t port;
+        uint16_t tcpPort       = 4001;
+        uint16_t sendTimeoutMs = 1000;
+    };
+    struct Rs485GatewayStats_t {
+        uint64_t toTcpBytes   = 0;
+        uint64_t toRs485Bytes = 0;
+        uint32_t frames       = 0;
+        // Not sent, no client or timed out, a timed out frame may have gone out in part
+        uint32_t droppedFrames = 0;
+        // Accepted since start, a new client takes over from the one before
+        uint32_t clients = 0;
+        std::string client;
+    };
+    // Takes over the RS485 port, stopRs485Gateway() hands it back to monitor mode
+    virtual bool startRs485Gateway(const Rs485GatewayConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopRs485Gateway()
+    {
+    }
+    virtual bool isRs485GatewayRunning()
+    {
+        return false;
+    }
+    virtual Rs485GatewayStats_t getRs485GatewayStats()
+    {
+        return Rs485GatewayStats_t();
+    }
+
+    /* ------------------------------- Duty cycle ------------------------------- */
+    // Remote sensing on battery, the board stays powered off between RTC timer wakes. A wake brings up only the
+    // sensors below, appends one line to the SD card log and powers off again, the display and the apps never start.
+    // Booting from the power button ends the cycle
+    struct DutyCycleConfig_t {
+        // RTC countdown, auto reloaded so the wakes stay on a fixed grid, 1 ~ 65535
+        uint16_t intervalSec  = 60;
+        bool withPowerMonitor = true;
+        bool withImu          = true;
+        // One Modbus read per wake, the port goes back off right after
+        bool withModbus          = false;
+        Rs485Config_t modbusPort = Rs485Config_t();
+        ModbusPoll_t modbusPoll  = ModbusPoll_t();
+        uint16_t modbusTimeoutMs = 100;
+        // CSV, the header goes in when the file is new
+        std::string logPath = "/sd/duty_cycle.csv";
+    };
+    // Saves the config, arms the RTC timer and powers off, does not return unless the config is invalid
+    virtual bool startDutyCycle(const DutyCycleConfig_t& config)
+    {
+        return false;
+    }
+
+    /* --------------------------------- Thermal -------------------------------- */
+    // A service task samples the chip temperature sensor, low pass filters it and follows its trend, getCpuTemp()
+    // then returns the filtered value without touching the sensor. Crossing a threshold throttles the board in steps
+    // and publishes the new level on GetEventBus() as EVENT_TOPIC_THERMAL, a level is left hysteresisC below it
+    enum ThermalLevel_t {
+        THERMAL_LEVEL_NORMAL = 0,
+        // Camera FPS and display refresh capped
+        THERMAL_LEVEL_WARM,
+        // CPU frequency capped on top
+        THERMAL_LEVEL_HOT,
+    };
+    struct ThermalConfig_t {
+        uint16_t sampleIntervalMs = 1000;
+        // Time constant of the filter, a single reading jumps by a degree or two
+        uint16_t filterTimeSec = 8;
+        float warmC       = 75.0f;
+        float hotC        = 85.0f;
+        float hysteresisC = 5.0f;
+        // Caps from the warm level on, 0 leaves it alone
+        uint8_t warmCameraFps        = 15;
+        uint16_t warmRefreshPeriodMs = 50;
+        // On a DFS step of the CPU PLL, 0 leaves it alone
+        uint16_t hotCpuFreqMhz = 180;
+    };
+    struct ThermalStatus_t {
+        float tempC = 0.0f;
+        float rawC  = 0.0f;
+        // Of the filtered temperature, in degrees per minute
+        float trendCPerMin   = 0.0f;
+        float peakC          = 0.0f;
+        ThermalLevel_t level = THERMAL_LEVEL_NORMAL;
+    };
+    // Latest filtered reading with its version and millis(), kept fresh by the thermal service
+    Snapshot<ThermalStatus_t> thermalSnapshot;
+    virtual bool startThermalService(const ThermalConfig_t& config)
+    {
+        return false;
+    }
+    // Lifts the throttling
+    virtual void stopThermalService()
+    {
+    }
+    virtual bool isThermalServiceRunning()
+    {
+        return false;
+    }
+
+    /* ----------------------------- Firmware update ---------------------------- */
+    // OTA over the Wi-Fi web server, POST the app image to /api/ota with the device token in the X-OTA-Token header,
+    // optionally with its SHA-256 in hex in the X-Firmware-SHA256 header. Uploads on the open soft AP are refused, and
+    // only a signed build takes updates, of images signed with the key of the running one. The upload goes into the
+    // spare app partition as it arrives, is checked and the board restarts into it. A new image that does not reach
+    // boot done is rolled back by the bootloader on the next reset.
+    // State changes are published on GetEventBus() as EVENT_TOPIC_OTA
+    enum OtaState_t {
+        OTA_STATE_IDLE = 0,
+        OTA_STATE_RECEIVING,
+        // Image checks, then the boot partition switch
+        OTA_STATE_VERIFYING,
+        // Restarting into the new image
+        OTA_STATE_DONE,
+        OTA_STATE_FAILED,
+    };
+    struct OtaStatus_t {
+        OtaState_t state  = OTA_STATE_IDLE;
+        uint32_t received = 0;
+        uint32_t total    = 0;
+        // Why the last update failed
+        std::string error;
+        // Of the running image
+        std::string runningVersion;
+        std::string runningPartition;
+        bool canRollback = false;
+    };
+    virtual OtaStatus_t getOtaStatus()
+    {
+        return OtaStatus_t();
+    }
+    // Marks the running image invalid and restarts into the previous one, returns false if there is none
+    virtual bool rollbackFirmware()
+    {
+        return false;
+    }
+
+    /* -------------------------------- Profiler -------------------------------- */
+    // Sampling CPU profiler, a timer interrupt on each core records the interrupted PC and task into a ring in PSRAM.
+    // The ring keeps the latest samples, so it can stay on through a field test. The dump counts samples per task and
+    // PC, tools/profile_to_folded.py symbolizes it against the ELF into folded stacks for a flamegraph. Also served as
+    // GET /api/profile on the Wi-Fi web server
+    struct ProfilerConfig_t {
+        // Per core
+        uint32_t rateHz = 1000;
+        // Of both rings together, 8 bytes a sample
+        uint32_t bufferKb = 1024;
+    };
+    struct ProfilerStats_t {
+        bool isRunning    = false;
+        uint32_t rateHz   = 0;
+        uint32_t capacity = 0;
+        // Since the start, samples held are the latest capacity of them
+        uint32_t samples = 0;
+        // Skipped while a dump was being read
+        uint32_t skipped = 0;
+        // Average time in the sampling interrupt
+        uint32_t isrCycles = 0;
+    };
+    virtual bool startProfiler(const ProfilerConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopProfiler()
+    {
+    }
+    virtual ProfilerStats_t getProfilerStats()
+    {
+        return ProfilerStats_t();
+    }
+    // Writes the dump to the path, an empty path prints it on the console
+    virtual bool exportProfile(const std::string& path)
+    {
+        return false;
+    }
+
+    /* ------------------------------- Event trace ------------------------------ */
+    // Timeline of the HAL trace points: LVGL refresh, flush and timer runs, LVGL lock waits, camera buffers and PPA,
+    // I2S reads and writes, I2C bus turns. Exported as Chrome trace event JSON for Perfetto, also served as
+    // GET /api/trace on the Wi-Fi web server
+    struct EventTraceConfig_t {
+        // Of both per core rings together, 24 bytes an event
+        uint32_t bufferKb = 1024;
+    };
+    struct EventTraceStats_t {
+        bool isRecording  = false;
+        uint32_t capacity = 0;
+        // Since the start, the rings hold the latest capacity of them
+        uint32_t events = 0;
+    };
+    virtual bool startEventTrace(const EventTraceConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopEventTrace()
+    {
+    }
+    virtual EventTraceStats_t getEventTraceStats()
+    {
+        return EventTraceStats_t();
+    }
+    // Writes the trace to the path, an empty path prints it on the console
+    virtual bool exportEventTrace(const std::string& path)
+    {
+        return false;
+    }
+
+    /* ------------------------------ Stall monitor ----------------------------- */
+    // Watches how long app::Update() and lv_timer_handler() run. A run over the threshold gets the stalled task's
+    // saved PC, return address and the code addresses found on its stack, logged while it is still stalled. Once it
+    // ends, the report and the event trace, when one is recording, are written to /sd/stalls
+    enum UiSection_t {
+        UI_SECTION_APP_UPDATE = 0,
+        UI_SECTION_LVGL_TIMER,
+        UI_SECTION_NUM,
+    };
+    struct StallMonitorConfig_t {
+        uint32_t thresholdMs = 200;
+        // A copy of the event trace next to each report
+        bool saveTrace = true;
+    };
+    struct StallReport_t {
+        uint32_t id         = 0;
+        UiSection_t section = UI_SECTION_APP_UPDATE;
+        // 0 while the stall is still going on
+        uint32_t durationMs = 0;
+        std::string task;
+        // Innermost first: the saved PC, the return address, then code addresses from the stack, newest first.
+        // Empty when the task was running on its core at every look, there is no saved context to read then
+        std::vector<uint32_t> backtrace;
+        // Report file on the SD card, empty when it was not written
+        std::string path;
+    };
+    struct StallMonitorStats_t {
+        bool isRunning  = false;
+        uint32_t stalls = 0;
+        // Longest run of each section since the start
+        uint32_t maxSectionMs[UI_SECTION_NUM] = {};
+        StallReport_t last;
+    };
+    virtual bool startStallMonitor(const StallMonitorConfig_t& config)
+    {
+        return false;
+    }
+    virtual void stopStallMonitor()
+    {
+    }
+    virtual StallMonitorStats_t getStallMonitorStats()
+    {
+        return StallMonitorStats_t();
+    }
+    // Called around the watched sections by the task that runs them, cheap while the monitor is stopped
+    virtual void markUiSection(UiSection_t section, bool isBegin)
+    {
     }
 };
 
@@ -371,9 +2914,10 @@ inline hal::HalBase* GetHAL()
  */
 class LvglLockGuard {
 public:
-    LvglLockGuard()
+    // The lock stats name it after the enclosing function unless a site is passed
+    LvglLockGuard(const char* site = __builtin_FUNCTION())
     {
-        GetHAL()->lvglLock();
+        GetHAL()->lvglLock(site);
     }
     ~LvglLockGuard()
     {
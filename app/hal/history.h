@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+/**
+ * @brief The last N values of a sensor, at the rate they were read. Each reader keeps its own cursor and copies what
+ * came after it, readers never lock and never wait on a writer, writers are serialized among themselves
+ *
+ * @tparam T trivially copyable
+ * @tparam N ring size, only has to cover how far a reader can fall behind
+ */
+template <typename T, size_t N>
+class History {
+public:
+    // Writer side, from tasks only
+    void push(const T& value)
+    {
+        std::lock_guard<std::mutex> lock(_write_mutex);
+
+        uint32_t count     = _count.load(std::memory_order_relaxed);
+        _buffer[count % N] = value;
+        _count.store(count + 1, std::memory_order_release);
+    }
+
+    // Reader side, any task. Copies up to maxCount values after cursor, oldest first, and moves the cursor past them.
+    // A reader further back than N loses the oldest, a cursor of 0 starts from the oldest kept
+    size_t read(uint32_t& cursor, T* out, size_t maxCount) const
+    {
+        uint32_t count  = _count.load(std::memory_order_acquire);
+        uint32_t oldest = count > N ? count - N : 0;
+        if (cursor < oldest || cursor > count) {
+            cursor = oldest;
+        }
+
+        size_t size = std::min<size_t>(count - cursor, maxCount);
+        for (size_t i = 0; i < size; i++) {
+            out[i] = _buffer[(cursor + i) % N];
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // Values the writer may have gone over while they were copied are dropped from the front
+        uint32_t after = _count.load(std::memory_order_relaxed);
+        uint32_t valid = after + 1 > N ? after + 1 - N : 0;
+        if (cursor < valid) {
+            size_t torn = std::min<size_t>(valid - cursor, size);
+            memmove(out, out + torn, (size - torn) * sizeof(T));
+            size -= torn;
+            cursor += torn;
+        }
+        cursor += size;
+        return size;
+    }
+
+    // Values pushed so far
+    uint32_t count() const
+    {
+        return _count.load(std::memory_order_acquire);
+    }
+
+private:
+    T _buffer[N];
+    std::atomic<uint32_t> _count{0};
+    std::mutex _write_mutex;
+};
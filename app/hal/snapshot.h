@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @brief Latest value of a sensor with a version and a timestamp. Readers never lock and never wait on a writer,
+ * writers are serialized among themselves
+ *
+ * @tparam T trivially copyable
+ */
+template <typename T>
+class Snapshot {
+public:
+    // Writer side, from tasks only
+    void publish(const T& data, uint32_t timeMs)
+    {
+        std::lock_guard<std::mutex> lock(_write_mutex);
+
+        // Odd while a write is running, publish n goes to buffer n & 1, the other one holds the latest
+        uint32_t seq = _seq.load(std::memory_order_relaxed);
+        _seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        auto& buffer  = _buffers[(seq >> 1) & 1];
+        buffer.data   = data;
+        buffer.timeMs = timeMs;
+        _seq.store(seq + 2, std::memory_order_release);
+    }
+
+    // Reader side, any task. False until the first publish, version counts the publishes
+    bool read(T& data, uint32_t* version = nullptr, uint32_t* timeMs = nullptr) const
+    {
+        while (true) {
+            uint32_t seq       = _seq.load(std::memory_order_acquire);
+            uint32_t published = seq >> 1;
+            if (published == 0) {
+                return false;
+            }
+
+            const auto& buffer = _buffers[(published - 1) & 1];
+            T copy             = buffer.data;
+            uint32_t time      = buffer.timeMs;
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // Torn only when the writer went on to the buffer being read, that takes it past one more publish
+            if (_seq.load(std::memory_order_relaxed) - (seq & ~1u) > 2) {
+                continue;
+            }
+            data = copy;
+            if (version) {
+                *version = published;
+            }
+            if (timeMs) {
+                *timeMs = time;
+            }
+            return true;
+        }
+    }
+
+    uint32_t version() const
+    {
+        return _seq.load(std::memory_order_acquire) >> 1;
+    }
+
+private:
+    struct Buffer_t {
+        T data;
+        uint32_t timeMs = 0;
+    };
+
+    Buffer_t _buffers[2];
+    std::atomic<uint32_t> _seq{0};
+    std::mutex _write_mutex;
+};
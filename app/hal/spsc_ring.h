@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <atomic>
+#include <algorithm>
+#include <vector>
+#include <stddef.h>
+
+/**
+ * @brief Lock free ring for one producer task and one consumer task
+ *
+ * @tparam T
+ */
+template <typename T>
+class SpscRing {
+public:
+    // Not thread safe, call while neither side is running, capacity is rounded up to a power of two
+    void init(size_t capacity)
+    {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        _buffer.assign(size, T());
+        _mask = size - 1;
+        _head = 0;
+        _tail = 0;
+    }
+
+    size_t capacity() const
+    {
+        return _buffer.size();
+    }
+
+    size_t available() const
+    {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+
+    size_t space() const
+    {
+        return capacity() - available();
+    }
+
+    // Producer side, returns the count written
+    size_t write(const T* data, size_t count)
+    {
+        size_t head = _head.load(std::memory_order_relaxed);
+        size_t tail = _tail.load(std::memory_order_acquire);
+        count       = std::min(count, capacity() - (head - tail));
+        for (size_t i = 0; i < count; i++) {
+            _buffer[(head + i) & _mask] = data[i];
+        }
+        _head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // Consumer side, returns the count read
+    size_t read(T* data, size_t count)
+    {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t head = _head.load(std::memory_order_acquire);
+        count       = std::min(count, head - tail);
+        for (size_t i = 0; i < count; i++) {
+            data[i] = _buffer[(tail + i) & _mask];
+        }
+        _tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // A run of contiguous elements inside the ring
+    struct Span_t {
+        T* data     = nullptr;
+        size_t size = 0;
+    };
+
+    // Producer side, the free run at the head up to the wrap point, fill it and commit() what was written
+    Span_t writeSpan()
+    {
+        size_t head  = _head.load(std::memory_order_relaxed);
+        size_t tail  = _tail.load(std::memory_order_acquire);
+        size_t index = head & _mask;
+        return {_buffer.data() + index, std::min(capacity() - (head - tail), capacity() - index)};
+    }
+
+    void commit(size_t count)
+    {
+        _head.store(_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // Consumer side, the oldest run up to the wrap point, read it in place and consume() what was used
+    Span_t readSpan()
+    {
+        size_t tail  = _tail.load(std::memory_order_relaxed);
+        size_t head  = _head.load(std::memory_order_acquire);
+        size_t index = tail & _mask;
+        return {_buffer.data() + index, std::min(head - tail, capacity() - index)};
+    }
+
+    void consume(size_t count)
+    {
+        _tail.store(_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+private:
+    std::vector<T> _buffer;
+    size_t _mask = 0;
+    // Free running counters, the difference is the fill level, the power of two size keeps them valid across wrap
+    std::atomic<size_t> _head{0};
+    std::atomic<size_t> _tail{0};
+};
@@ -22,3 +22,85 @@ void shared_data::Destroy()
         _shared_data_instance = nullptr;
     }
 }
+
+shared_data::EventBus::EventBus()
+{
+    for (uint32_t i = 0; i < _capacity; i++) {
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool shared_data::EventBus::publish(const Event_t& event)
+{
+    // 单元格序号等于写位置时可写，生产者之间用 CAS 抢占写位置
+    uint32_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+    Cell_t* cell = nullptr;
+    while (true) {
+        cell         = &_cells[pos & (_capacity - 1)];
+        uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+        int32_t diff = static_cast<int32_t>(seq - pos);
+        if (diff == 0) {
+            if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // 消费者还没读走，队列已满
+            _dropped_count.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = _enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->event = event;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool shared_data::EventBus::pop(Event_t& event)
+{
+    Cell_t& cell = _cells[_dequeue_pos & (_capacity - 1)];
+    uint32_t seq = cell.sequence.load(std::memory_order_acquire);
+    if (static_cast<int32_t>(seq - (_dequeue_pos + 1)) < 0) {
+        return false;
+    }
+
+    event = cell.event;
+    // 留给绕一圈后的生产者
+    cell.sequence.store(_dequeue_pos + _capacity, std::memory_order_release);
+    _dequeue_pos++;
+    return true;
+}
+
+int shared_data::EventBus::subscribe(uint32_t topicMask, Handler_t handler)
+{
+    Subscriber_t subscriber;
+    subscriber.id        = _next_subscriber_id++;
+    subscriber.topicMask = topicMask;
+    subscriber.handler   = std::move(handler);
+    _subscribers.push_back(std::move(subscriber));
+    return _subscribers.back().id;
+}
+
+void shared_data::EventBus::unsubscribe(int id)
+{
+    for (auto it = _subscribers.begin(); it != _subscribers.end(); ++it) {
+        if (it->id == id) {
+            _subscribers.erase(it);
+            return;
+        }
+    }
+}
+
+void shared_data::EventBus::dispatch(size_t maxEvents)
+{
+    Event_t event;
+    for (size_t i = 0; i < maxEvents && pop(event); i++) {
+        uint32_t topic_bit = 1u << event.topic;
+        for (const auto& subscriber : _subscribers) {
+            if (subscriber.topicMask & topic_bit) {
+                subscriber.handler(event);
+            }
+        }
+    }
+}
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: MIT
  */
 #pragma once
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <thread>
 #include <mutex>
@@ -23,9 +25,168 @@ namespace shared_data {
  * @brief 共享数据定义
  *
  */
+/**
+ * @brief Modbus 轮询结果，由 HAL 的 Modbus 任务写入
+ *
+ */
+struct ModbusPollValues_t {
+    // 最近一次成功响应的 millis()，0 表示还没有
+    uint32_t updateTime = 0;
+    // 最近一次响应的异常码，0 表示正常
+    uint8_t exception   = 0;
+    uint32_t errorCount = 0;
+    // 寄存器值，线圈和离散输入每位占一个元素
+    std::vector<uint16_t> values;
+};
+
+struct ModbusData_t {
+    std::mutex mutex;
+    // 每次写入后递增，UI 据此判断是否需要刷新
+    uint32_t sequence = 0;
+    // 与轮询表顺序一致
+    std::vector<ModbusPollValues_t> polls;
+};
+
+/**
+ * @brief 事件主题
+ *
+ */
+enum EventTopic_t : uint8_t {
+    // value 为 HalBase::WifiState_t
+    EVENT_TOPIC_WIFI = 0,
+    // id 为 EventPort_t，value 为 1 接入、0 拔出，已消抖
+    EVENT_TOPIC_PORT,
+    // value 为 1 挂载、0 移除
+    EVENT_TOPIC_SD_CARD,
+    // 输入设备事件，id 与 value 由发布者定义
+    EVENT_TOPIC_INPUT,
+    // value 为条码序号，内容由 HalBase::getCameraBarcode() 读取
+    EVENT_TOPIC_BARCODE,
+    // id 为 EventClock_t，value 为 Unix 时间（秒）
+    EVENT_TOPIC_CLOCK,
+    // value 为 HalBase::ThermalLevel_t，等级变化时发布
+    EVENT_TOPIC_THERMAL,
+    // value 为 HalBase::OtaState_t，固件更新状态变化时发布
+    EVENT_TOPIC_OTA,
+    EVENT_TOPIC_NUM,
+};
+
+enum EventPort_t : uint8_t {
+    EVENT_PORT_USB_C = 0,
+    EVENT_PORT_USB_A,
+    EVENT_PORT_HEADPHONE,
+};
+
+// 整分时只发布 MINUTE，不再另发 SECOND
+enum EventClock_t : uint8_t {
+    EVENT_CLOCK_SECOND = 0,
+    EVENT_CLOCK_MINUTE,
+};
+
+/**
+ * @brief 事件，纯数据，发布时按值拷贝进队列
+ *
+ */
+struct Event_t {
+    EventTopic_t topic = EVENT_TOPIC_WIFI;
+    uint8_t id         = 0;
+    int32_t value      = 0;
+};
+
+/**
+ * @brief 类型化事件总线。任意任务或中断发布，进入无锁的多生产者单消费者环形队列，不分配堆内存、不加锁；
+ * UI 线程每帧调用一次 dispatch() 批量派发给订阅者
+ *
+ */
+class EventBus {
+public:
+    using Handler_t = std::function<void(const Event_t&)>;
+
+    EventBus();
+
+    /**
+     * @brief 发布事件，可在中断中调用，队列满时丢弃并计数
+     *
+     * @param event
+     * @return true 已入队
+     * @return false 队列已满
+     */
+    bool publish(const Event_t& event);
+
+    /**
+     * @brief 订阅一个或多个主题，仅限 UI 线程
+     *
+     * @param topicMask 按 1 << EventTopic_t 组合
+     * @param handler
+     * @return int 订阅 ID，用于取消订阅
+     */
+    int subscribe(uint32_t topicMask, Handler_t handler);
+
+    /**
+     * @brief 取消订阅，仅限 UI 线程，不可在回调中调用
+     *
+     * @param id
+     */
+    void unsubscribe(int id);
+
+    /**
+     * @brief 派发队列中的事件，仅限 UI 线程，每帧调用一次
+     *
+     * @param maxEvents 单次最多派发数量，其余留到下一帧
+     */
+    void dispatch(size_t maxEvents = 32);
+
+    /**
+     * @brief 因队列满而丢弃的事件数
+     *
+     * @return uint32_t
+     */
+    uint32_t getDroppedCount() const
+    {
+        return _dropped_count.load(std::memory_order_relaxed);
+    }
+
+private:
+    // 必须为 2 的幂，序号回绕时仍能正确取模
+    static constexpr uint32_t _capacity = 64;
+
+    struct Cell_t {
+        std::atomic<uint32_t> sequence;
+        Event_t event;
+    };
+
+    struct Subscriber_t {
+        int id             = 0;
+        uint32_t topicMask = 0;
+        Handler_t handler;
+    };
+
+    Cell_t _cells[_capacity];
+    std::atomic<uint32_t> _enqueue_pos{0};
+    std::atomic<uint32_t> _dropped_count{0};
+    // 以下仅 UI 线程访问
+    uint32_t _dequeue_pos   = 0;
+    int _next_subscriber_id = 1;
+    std::vector<Subscriber_t> _subscribers;
+
+    bool pop(Event_t& event);
+};
+
+/**
+ * @brief 启动流程状态，启动动画在硬件初始化和启动器构建都完成后才退场，仅限 UI 线程
+ *
+ */
+struct BootState_t {
+    // 应用已安装，在 HAL 报告启动完成后进行
+    bool isAppsInstalled = false;
+    // 启动器从安装到所有面板构建完成期间为 true，期间启动动画盖在其上
+    bool isLauncherBuilding = false;
+};
+
 struct SharedData_t {
-    smooth_ui_toolkit::Signal<std::string> systemStateEvents;
-    smooth_ui_toolkit::Signal<std::string> inputEvents;
+    EventBus eventBus;
+    ModbusData_t modbus;
+    BootState_t bootState;
 };
 
 /**
@@ -53,12 +214,17 @@ inline shared_data::SharedData_t* GetSharedData()
     return shared_data::Get();
 }
 
-inline smooth_ui_toolkit::Signal<std::string>& GetSystemStateEvents()
+inline shared_data::EventBus& GetEventBus()
+{
+    return GetSharedData()->eventBus;
+}
+
+inline shared_data::ModbusData_t& GetModbusData()
 {
-    return GetSharedData()->systemStateEvents;
+    return GetSharedData()->modbus;
 }
 
-inline smooth_ui_toolkit::Signal<std::string>& GetInputEvents()
+inline shared_data::BootState_t& GetBootState()
 {
-    return GetSharedData()->inputEvents;
+    return GetSharedData()->bootState;
 }
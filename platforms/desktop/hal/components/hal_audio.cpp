@@ -5,11 +5,13 @@
  */
 #include "../hal_desktop.h"
 #include "hal/hal.h"
+#include "../../../tab5/main/hal/utils/audio_mixer/audio_mixer.h"
 #include <cmath>
 #include <mooncake_log.h>
 #include <SDL2/SDL.h>
 #include <thread>
 #include <iostream>
+#include <string.h>
 
 static const std::string _tag = "audio";
 
@@ -24,14 +26,39 @@ uint8_t HalDesktop::getSpeakerVolume()
     return _current_speaker_volume;
 }
 
-void HalDesktop::audioPlay(std::vector<int16_t>& data, bool async)
+// Same mixer as Tab5, pulled by the SDL audio callback
+static AudioMixer _mixer;
+static SDL_AudioDeviceID _audio_device_id = 0;
+
+static void _sdl_audio_callback(void* userdata, Uint8* stream, int len)
+{
+    // Mixer blocks rarely match the SDL buffer size, the rest of a block is kept for the next call
+    static int16_t block[AudioMixer::BlockFrames * 2];
+    static size_t block_pos = AudioMixer::BlockFrames * 2;
+
+    int16_t* out   = (int16_t*)stream;
+    size_t samples = len / sizeof(int16_t);
+    while (samples > 0) {
+        if (block_pos >= AudioMixer::BlockFrames * 2) {
+            if (!_mixer.mix(block)) {
+                memset(block, 0, sizeof(block));
+            }
+            block_pos = 0;
+        }
+        size_t n = std::min(samples, AudioMixer::BlockFrames * 2 - block_pos);
+        memcpy(out, block + block_pos, n * sizeof(int16_t));
+        block_pos += n;
+        out += n;
+        samples -= n;
+    }
+}
+
+static bool open_audio_device()
 {
-    static std::once_flag initFlag;
-    static SDL_AudioDeviceID deviceId = 0;
-    static std::mutex audioMutex;
+    static std::once_flag init_flag;
 
     // 音频初始化 & 打开设备（只执行一次）
-    std::call_once(initFlag, []() {
+    std::call_once(init_flag, []() {
         if (!(SDL_WasInit(SDL_INIT_AUDIO) & SDL_INIT_AUDIO)) {
             if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
                 std::cerr << "Failed to init SDL audio: " << SDL_GetError() << std::endl;
@@ -41,46 +68,74 @@ void HalDesktop::audioPlay(std::vector<int16_t>& data, bool async)
 
         SDL_AudioSpec want, have;
         SDL_memset(&want, 0, sizeof(want));
-        want.freq     = 48000;
+        want.freq     = AudioMixer::SampleRate;
         want.format   = AUDIO_S16SYS;
         want.channels = 2;
-        want.samples  = 4096;
-        want.callback = nullptr;
+        want.samples  = 1024;
+        want.callback = _sdl_audio_callback;
 
-        deviceId = SDL_OpenAudioDevice(nullptr, 0, &want, &have, 0);
-        if (deviceId == 0) {
+        _audio_device_id = SDL_OpenAudioDevice(nullptr, 0, &want, &have, 0);
+        if (_audio_device_id == 0) {
             std::cerr << "SDL_OpenAudioDevice failed: " << SDL_GetError() << std::endl;
         } else {
-            SDL_PauseAudioDevice(deviceId, 0);  // 开启播放
+            SDL_PauseAudioDevice(_audio_device_id, 0);  // 开启播放
         }
     });
 
-    // 若设备打开失败，直接返回
-    if (deviceId == 0) return;
-
-    // 异步线程提交音频数据
-    auto volume = getSpeakerVolume();
-    std::thread([data, volume]() {
-        std::vector<int16_t> adjustedData = data;
-
-        // 音量缩放
-        float scale = volume / 100.0f;
-        for (size_t i = 0; i < adjustedData.size(); ++i) {
-            int sample = static_cast<int>(adjustedData[i] * scale);
-            if (sample > INT16_MAX) sample = INT16_MAX;
-            if (sample < INT16_MIN) sample = INT16_MIN;
-            adjustedData[i] = static_cast<int16_t>(sample);
-        }
+    return _audio_device_id != 0;
+}
 
-        // 加锁提交数据（线程安全）
-        {
-            std::lock_guard<std::mutex> lock(audioMutex);
-            int byteSize = adjustedData.size() * sizeof(int16_t);
-            if (SDL_QueueAudio(deviceId, adjustedData.data(), byteSize) < 0) {
-                std::cerr << "SDL_QueueAudio failed: " << SDL_GetError() << std::endl;
-            }
+// The desktop has no codec volume, the speaker volume scales every voice instead
+static uint8_t scale_volume(uint8_t speakerVolume, uint8_t volume)
+{
+    return speakerVolume * std::min<int>(volume, 100) / 100;
+}
+
+void HalDesktop::audioPlay(std::vector<int16_t>& data, bool async, uint8_t volume)
+{
+    if (!open_audio_device()) {
+        return;
+    }
+
+    volume = scale_volume(getSpeakerVolume(), volume);
+    if (!async) {
+        // Played in place, the caller's buffer outlives the voice
+        uint32_t voice_id = _mixer.play(data.data(), data.size(), volume);
+        while (_mixer.isPlaying(voice_id)) {
+            delay(AudioMixer::BlockTimeMs);
         }
-    }).detach();
+        return;
+    }
+
+    auto owner = std::make_shared<std::vector<int16_t>>(data);
+    _mixer.play(owner->data(), owner->size(), volume, owner);
+}
+
+void HalDesktop::audioPlayBuffer(const int16_t* data, size_t size, uint8_t volume)
+{
+    if (!open_audio_device()) {
+        return;
+    }
+    _mixer.play(data, size, scale_volume(getSpeakerVolume(), volume));
+}
+
+void HalDesktop::audioPlayNotes(const AudioNote_t* notes, size_t count)
+{
+    if (!open_audio_device()) {
+        return;
+    }
+
+    auto speaker_volume = getSpeakerVolume();
+    for (size_t i = 0; i < count; i++) {
+        SynthVoice::Config_t config;
+        config.frequency  = notes[i].frequency;
+        config.delayMs    = notes[i].delayMs;
+        config.durationMs = notes[i].durationMs;
+        config.attackMs   = notes[i].attackMs;
+        config.releaseMs  = notes[i].releaseMs;
+        config.level      = scale_volume(speaker_volume, notes[i].level);
+        _mixer.playNote(config);
+    }
 }
 
 void HalDesktop::audioRecord(std::vector<int16_t>& data, uint16_t durationMs, float gain)
@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "../hal_desktop.h"
+#include "hal/hal.h"
+#include <mooncake_log.h>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Counterpart of the Tab5 HAL benchmark, only memcpy has a meaning on a PC. The buses, the PPA, the JPEG codec and
+// the I2S loop are hardware, their groups are left out
+static const std::string _tag = "hal-bench";
+
+// One buffer that stays in the cache and one well past the last level
+static constexpr size_t _cached_size = 64 * 1024;
+static constexpr size_t _dram_size   = 64 * 1024 * 1024;
+static constexpr size_t _copy_total  = 1024 * 1024 * 1024;
+
+struct HalBenchmarkData_t {
+    std::mutex mutex;
+    hal::HalBase::HalBenchmarkResult_t result;
+};
+static HalBenchmarkData_t _hal_bench_data;
+
+static void time_copy(const char* name, uint8_t* dst, size_t dstSize, const uint8_t* src, size_t srcSize)
+{
+    size_t dst_offset = 0;
+    size_t src_offset = 0;
+    auto start        = std::chrono::steady_clock::now();
+    for (size_t copied = 0; copied < _copy_total; copied += _cached_size) {
+        std::memcpy(dst + dst_offset, src + src_offset, _cached_size);
+        dst_offset = (dst_offset + _cached_size) % dstSize;
+        src_offset = (src_offset + _cached_size) % srcSize;
+    }
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    hal::HalBase::HalBenchmarkRecord_t record;
+    record.group = "memcpy";
+    record.name  = name;
+    record.unit  = "MB/s";
+    record.value = us > 0 ? (float)_copy_total / us : 0.0f;
+    mclog::tagInfo(_tag, "memcpy {}: {:.0f} MB/s", name, record.value);
+
+    std::lock_guard<std::mutex> lock(_hal_bench_data.mutex);
+    _hal_bench_data.result.records.push_back(record);
+}
+
+static void hal_benchmark_job()
+{
+    std::vector<uint8_t> cached_a(_cached_size, 0x5a);
+    std::vector<uint8_t> cached_b(_cached_size);
+    std::vector<uint8_t> dram_a(_dram_size, 0xa5);
+    std::vector<uint8_t> dram_b(_dram_size);
+    time_copy("cache_to_cache", cached_b.data(), _cached_size, cached_a.data(), _cached_size);
+    time_copy("cache_to_dram", dram_b.data(), _dram_size, cached_a.data(), _cached_size);
+    time_copy("dram_to_cache", cached_b.data(), _cached_size, dram_a.data(), _dram_size);
+    time_copy("dram_to_dram", dram_b.data(), _dram_size, dram_a.data(), _dram_size);
+
+    std::lock_guard<std::mutex> lock(_hal_bench_data.mutex);
+    _hal_bench_data.result.state = hal::HalBase::HAL_BENCHMARK_DONE;
+}
+
+bool HalDesktop::startHalBenchmark()
+{
+    std::lock_guard<std::mutex> lock(_hal_bench_data.mutex);
+    if (_hal_bench_data.result.state == HAL_BENCHMARK_RUNNING) {
+        return false;
+    }
+    _hal_bench_data.result       = HalBenchmarkResult_t();
+    _hal_bench_data.result.state = HAL_BENCHMARK_RUNNING;
+    std::thread(hal_benchmark_job).detach();
+    return true;
+}
+
+hal::HalBase::HalBenchmarkResult_t HalDesktop::getHalBenchmarkResult()
+{
+    std::lock_guard<std::mutex> lock(_hal_bench_data.mutex);
+    return _hal_bench_data.result;
+}
@@ -0,0 +1,204 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#ifdef PLATFORM_DESKTOP_HEADLESS
+#include "../hal_desktop.h"
+#include "../hal_config.h"
+#include "hal/hal.h"
+#include <mooncake_log.h>
+#include <smooth_ui_toolkit.h>
+#include <lvgl.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static const std::string _tag = "headless";
+
+// Virtual time limit when HEADLESS_MAX_MS is not set, a run that never finishes still ends
+static constexpr uint32_t _default_max_ms = 10 * 60 * 1000;
+
+struct HeadlessData_t {
+    // Only the driving thread moves the clock, the other threads wait for it in delay()
+    std::atomic<uint32_t> virtualMs = 0;
+    std::mutex clockMutex;
+    std::condition_variable clockCv;
+    std::thread::id driverThread;
+
+    std::vector<uint16_t> framebuffer;
+    bool isFlushed  = false;
+    bool isFrameLog = false;
+    uint32_t maxMs  = _default_max_ms;
+
+    uint32_t frames        = 0;
+    uint32_t changedFrames = 0;
+    uint64_t lastHash      = 0;
+    uint64_t renderUs      = 0;
+    uint64_t maxRenderUs   = 0;
+    std::chrono::steady_clock::time_point startTime;
+};
+static HeadlessData_t _headless_data;
+
+// FNV-1a, stable across runs and platforms, enough to spot a changed frame
+static uint64_t hash_frame(const std::vector<uint16_t>& frame)
+{
+    uint64_t hash   = 0xcbf29ce484222325ull;
+    auto bytes      = reinterpret_cast<const uint8_t*>(frame.data());
+    size_t byte_num = frame.size() * sizeof(uint16_t);
+    for (size_t i = 0; i < byte_num; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+static void print_json(const std::string& json)
+{
+    // Same line format as the benchmark records, with its own prefix
+    std::printf("HEADLESS %s\n", json.c_str());
+    std::fflush(stdout);
+}
+
+static void flush_cb(lv_display_t* display, const lv_area_t* area, uint8_t* px_map)
+{
+    // Direct mode, LVGL rendered into the frame buffer already
+    if (lv_display_flush_is_last(display)) {
+        _headless_data.isFlushed = true;
+    }
+    lv_display_flush_ready(display);
+}
+
+static void touchpad_read_cb(lv_indev_t* indev, lv_indev_data_t* data)
+{
+    // Scenarios send their events straight to the objects, only an input replay presses
+    data->state = LV_INDEV_STATE_RELEASED;
+}
+
+void HalDesktop::headless_display_init()
+{
+    // No window and no sound card on a CI runner, SDL is only left with the audio callback
+    setenv("SDL_VIDEODRIVER", "dummy", 0);
+    setenv("SDL_AUDIODRIVER", "dummy", 0);
+
+    if (const char* max_ms = std::getenv("HEADLESS_MAX_MS")) {
+        _headless_data.maxMs = std::strtoul(max_ms, nullptr, 10);
+    }
+    if (const char* frame_log = std::getenv("HEADLESS_FRAME_LOG")) {
+        _headless_data.isFrameLog = std::atoi(frame_log) != 0;
+    }
+    _headless_data.driverThread = std::this_thread::get_id();
+    _headless_data.startTime    = std::chrono::steady_clock::now();
+
+    lv_tick_set_cb([]() -> uint32_t { return _headless_data.virtualMs; });
+    // The window animations run on the toolkit clock, the app latches it off millis() once per frame after init
+    smooth_ui_toolkit::ui_hal::on_get_tick([]() -> uint32_t { return _headless_data.virtualMs; });
+
+    auto display = lv_display_create(HAL_SCREEN_WIDTH, HAL_SCREEN_HEIGHT);
+    _headless_data.framebuffer.resize(HAL_SCREEN_WIDTH * HAL_SCREEN_HEIGHT);
+    lv_display_set_buffers(display, _headless_data.framebuffer.data(), nullptr,
+                           _headless_data.framebuffer.size() * sizeof(uint16_t), LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(display, flush_cb);
+    lv_display_set_default(display);
+
+    lvTouchpad = lv_indev_create();
+    lv_indev_set_type(lvTouchpad, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(lvTouchpad, touchpad_read_cb);
+    lv_indev_set_group(lvTouchpad, lv_group_get_default());
+    lv_indev_set_display(lvTouchpad, display);
+
+    mclog::tagInfo(_tag, "{}x{} in memory, virtual time limit {} ms", HAL_SCREEN_WIDTH, HAL_SCREEN_HEIGHT,
+                   _headless_data.maxMs);
+}
+
+uint32_t HalDesktop::headless_millis()
+{
+    return _headless_data.virtualMs;
+}
+
+void HalDesktop::headless_delay(uint32_t ms)
+{
+    if (std::this_thread::get_id() == _headless_data.driverThread) {
+        headless_step(ms);
+        return;
+    }
+
+    // Other threads sleep in virtual time, they are woken as the driving thread moves the clock past the target
+    uint32_t target = _headless_data.virtualMs + ms;
+    std::unique_lock<std::mutex> lock(_headless_data.clockMutex);
+    _headless_data.clockCv.wait(lock, [target]() {
+        return (int32_t)(_headless_data.virtualMs - target) >= 0 || _headless_data.virtualMs >= _headless_data.maxMs;
+    });
+}
+
+void HalDesktop::headless_step(uint32_t ms)
+{
+    // Frame by frame, so every LVGL timer still runs at its period however far the clock jumps
+    while (ms > 0) {
+        uint32_t step = std::min(ms, (uint32_t)LV_DEF_REFR_PERIOD);
+        ms -= step;
+        {
+            std::lock_guard<std::mutex> lock(_headless_data.clockMutex);
+            _headless_data.virtualMs += step;
+        }
+        _headless_data.clockCv.notify_all();
+
+        lvglLock();
+        _headless_data.isFlushed = false;
+        auto start               = std::chrono::steady_clock::now();
+        lv_timer_handler();
+        uint64_t render_us =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        bool is_flushed = _headless_data.isFlushed;
+        lvglUnlock();
+        if (!is_flushed) {
+            continue;
+        }
+
+        // The hash is taken after the timing, it is not part of the render cost
+        uint64_t hash = hash_frame(_headless_data.framebuffer);
+        _headless_data.frames++;
+        _headless_data.renderUs += render_us;
+        _headless_data.maxRenderUs = std::max(_headless_data.maxRenderUs, render_us);
+        if (hash != _headless_data.lastHash) {
+            _headless_data.changedFrames++;
+            _headless_data.lastHash = hash;
+        }
+        if (_headless_data.isFrameLog) {
+            print_json(fmt::format("{{\"type\":\"frame\",\"index\":{},\"time_ms\":{},\"hash\":\"{:016x}\","
+                                   "\"render_us\":{}}}",
+                                   _headless_data.frames, (uint32_t)_headless_data.virtualMs, hash, render_us));
+        }
+    }
+}
+
+void HalDesktop::waitAppLoopWakeup(uint32_t timeoutMs)
+{
+    // An animating UI asks for no wait, it gets one frame
+    headless_step(timeoutMs > 0 ? timeoutMs : LV_DEF_REFR_PERIOD);
+}
+
+bool HalDesktop::isHeadlessDone()
+{
+    return _headless_data.virtualMs >= _headless_data.maxMs;
+}
+
+void HalDesktop::printHeadlessReport()
+{
+    auto elapsed        = std::chrono::steady_clock::now() - _headless_data.startTime;
+    uint64_t real_ms    = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+    uint32_t virtual_ms = _headless_data.virtualMs;
+    uint32_t frames     = _headless_data.frames ? _headless_data.frames : 1;
+    print_json(fmt::format("{{\"type\":\"summary\",\"virtual_ms\":{},\"real_ms\":{},\"speedup\":{:.1f},"
+                           "\"frames\":{},\"changed_frames\":{},\"render_avg_us\":{},\"render_max_us\":{},"
+                           "\"last_hash\":\"{:016x}\"}}",
+                           virtual_ms, real_ms, real_ms ? (double)virtual_ms / real_ms : 0.0, _headless_data.frames,
+                           _headless_data.changedFrames, _headless_data.renderUs / frames, _headless_data.maxRenderUs,
+                           _headless_data.lastHash));
+}
+#endif
@@ -6,6 +6,7 @@
 #include "../hal_desktop.h"
 #include "../hal_config.h"
 #include "hal/hal.h"
+#include "../../../tab5/main/hal/utils/input_trace/input_trace.h"
 #include <mooncake_log.h>
 #include <lvgl.h>
 #include <mutex>
@@ -15,6 +16,19 @@
 
 static const std::string _tag = "lvgl";
 static std::mutex _lvgl_mutex;
+static InputTrace _input_trace;
+static lv_indev_read_cb_t _touchpad_read_cb = nullptr;
+
+static void traced_read_cb(lv_indev_t* indev, lv_indev_data_t* data)
+{
+    _touchpad_read_cb(indev, data);
+
+    bool is_pressed = data->state == LV_INDEV_STATE_PRESSED;
+    if (_input_trace.process(lv_tick_get(), is_pressed, data->point.x, data->point.y)) {
+        data->continue_reading = true;
+    }
+    data->state = is_pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
 
 void HalDesktop::lvgl_init()
 {
@@ -24,12 +38,25 @@ void HalDesktop::lvgl_init()
 
     lv_group_set_default(lv_group_create());
 
+#ifdef PLATFORM_DESKTOP_HEADLESS
+    // Driven from the app loop in virtual time, no LVGL thread
+    headless_display_init();
+    input_trace_init();
+    return;
+#endif
+
+#if not defined(__APPLE__) && not defined(__MACH__)
+    // Own SDL window on a render thread, with its own pointer, wheel and keyboard
+    lv_display_set_default(sdl_display_init());
+    input_trace_init();
+#else
     auto display = lv_sdl_window_create(HAL_SCREEN_WIDTH, HAL_SCREEN_HEIGHT);
     lv_display_set_default(display);
 
     lvTouchpad = lv_sdl_mouse_create();
     lv_indev_set_group(lvTouchpad, lv_group_get_default());
     lv_indev_set_display(lvTouchpad, display);
+    input_trace_init();
 
     // // LV_IMAGE_DECLARE(mouse_cursor_icon); /*Declare the image file.*/
     // lv_obj_t* cursor_obj;
@@ -44,6 +71,7 @@ void HalDesktop::lvgl_init()
     auto keyboard = lv_sdl_keyboard_create();
     lv_indev_set_display(keyboard, display);
     lv_indev_set_group(keyboard, lv_group_get_default());
+#endif
 
 #if not defined(__APPLE__) && not defined(__MACH__)
     std::thread([]() {
@@ -60,7 +88,7 @@ void HalDesktop::lvgl_init()
 #endif
 }
 
-void HalDesktop::lvglLock()
+void HalDesktop::lvglLock(const char* site)
 {
     _lvgl_mutex.lock();
 }
@@ -69,3 +97,45 @@ void HalDesktop::lvglUnlock()
 {
     _lvgl_mutex.unlock();
 }
+
+void HalDesktop::input_trace_init()
+{
+    // Same file format as Tab5, a trace recorded on the device replays here
+    _touchpad_read_cb = lv_indev_get_read_cb(lvTouchpad);
+    lv_indev_set_read_cb(lvTouchpad, traced_read_cb);
+}
+
+bool HalDesktop::startInputRecord(const std::string& path)
+{
+    if (!_input_trace.startRecord(path, lv_tick_get())) {
+        mclog::tagError(_tag, "start input record {} failed", path);
+        return false;
+    }
+    mclog::tagInfo(_tag, "input record to {}", path);
+    return true;
+}
+
+bool HalDesktop::startInputReplay(const std::string& path)
+{
+    if (!_input_trace.startReplay(path, lv_tick_get())) {
+        mclog::tagError(_tag, "start input replay {} failed", path);
+        return false;
+    }
+    mclog::tagInfo(_tag, "input replay from {}, {} ms", path, _input_trace.getDurationMs());
+    return true;
+}
+
+void HalDesktop::stopInputTrace(bool dropLastTap)
+{
+    _input_trace.stop(dropLastTap);
+}
+
+hal::HalBase::InputTraceStatus_t HalDesktop::getInputTraceStatus()
+{
+    InputTraceStatus_t status;
+    status.state      = static_cast<InputTraceState_t>(_input_trace.getState());
+    status.events     = _input_trace.getEventCount();
+    status.elapsedMs  = _input_trace.getElapsedMs(lv_tick_get());
+    status.durationMs = _input_trace.getDurationMs();
+    return status;
+}
@@ -0,0 +1,390 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+// SDL windows have to live on the main thread on macOS, it keeps the stock lv_sdl_window driver
+#if !defined(PLATFORM_DESKTOP_HEADLESS) && !defined(__APPLE__)
+#include "../hal_desktop.h"
+#include "../hal_config.h"
+#include "hal/hal.h"
+#include <mooncake_log.h>
+#include <lvgl.h>
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static const std::string _tag = "sdl-display";
+
+// The Tab5 panel is portrait and the app runs it at LV_DISPLAY_ROTATION_90, the window is the device held landscape
+static constexpr int32_t _panel_width  = HAL_SCREEN_HEIGHT;
+static constexpr int32_t _panel_height = HAL_SCREEN_WIDTH;
+// Wakes the render thread to pump events when LVGL has nothing to show
+static constexpr uint32_t _event_poll_ms = 10;
+
+struct SdlDisplayData_t {
+    lv_display_t* display = nullptr;
+    // LVGL renders the whole logical frame here, direct mode
+    std::vector<uint8_t> drawBuffer;
+
+    // Dirty areas handed to the render thread
+    std::mutex frameMutex;
+    std::condition_variable frameCv;
+    std::vector<uint8_t> frame;
+    std::vector<SDL_Rect> dirty;
+    int32_t frameWidth             = HAL_SCREEN_WIDTH;
+    int32_t frameHeight            = HAL_SCREEN_HEIGHT;
+    uint32_t frameStride           = 0;
+    lv_display_rotation_t rotation = LV_DISPLAY_ROTATION_90;
+    // Texture size changes with the rotation, it is created again and uploaded whole
+    bool isResized = true;
+
+    // Written by the render thread, read by the indev callbacks
+    std::mutex inputMutex;
+    int32_t pointX      = 0;
+    int32_t pointY      = 0;
+    bool isPressed      = false;
+    int32_t wheelDiff   = 0;
+    bool isWheelPressed = false;
+    std::deque<uint32_t> keys;
+    uint32_t lastKey     = 0;
+    bool isKeyPressed    = false;
+    int32_t windowWidth  = HAL_SCREEN_WIDTH;
+    int32_t windowHeight = HAL_SCREEN_HEIGHT;
+};
+static SdlDisplayData_t _sdl_display_data;
+
+/* -------------------------------------------------------------------------- */
+/*                                   Display                                  */
+/* -------------------------------------------------------------------------- */
+static void flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* pxMap)
+{
+    auto& data = _sdl_display_data;
+    {
+        std::lock_guard<std::mutex> lock(data.frameMutex);
+        // Direct mode, pxMap is the frame and the area is in it
+        uint32_t row_size = lv_area_get_width(area) * 2;
+        for (int32_t y = area->y1; y <= area->y2; y++) {
+            uint32_t offset = y * data.frameStride + area->x1 * 2;
+            std::memcpy(data.frame.data() + offset, pxMap + offset, row_size);
+        }
+        data.dirty.push_back({area->x1, area->y1, lv_area_get_width(area), lv_area_get_height(area)});
+        if (lv_display_flush_is_last(disp)) {
+            data.frameCv.notify_one();
+        }
+    }
+    lv_display_flush_ready(disp);
+}
+
+// Sized for the current rotation, LVGL takes the stride from the resolution when the buffer is set
+static void set_buffers(SdlDisplayData_t& data)
+{
+    std::lock_guard<std::mutex> lock(data.frameMutex);
+    data.frameWidth  = lv_display_get_horizontal_resolution(data.display);
+    data.frameHeight = lv_display_get_vertical_resolution(data.display);
+    data.frameStride = lv_draw_buf_width_to_stride(data.frameWidth, LV_COLOR_FORMAT_RGB565);
+    data.rotation    = lv_display_get_rotation(data.display);
+    data.drawBuffer.assign(data.frameStride * data.frameHeight, 0);
+    data.frame.assign(data.drawBuffer.size(), 0);
+    data.dirty.clear();
+    data.isResized = true;
+
+    lv_display_set_buffers(data.display, data.drawBuffer.data(), nullptr, data.drawBuffer.size(),
+                           LV_DISPLAY_RENDER_MODE_DIRECT);
+}
+
+static void resolution_changed_cb(lv_event_t* e)
+{
+    set_buffers(_sdl_display_data);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Input                                   */
+/* -------------------------------------------------------------------------- */
+static void pointer_read_cb(lv_indev_t* indev, lv_indev_data_t* data)
+{
+    auto& sdl = _sdl_display_data;
+    std::lock_guard<std::mutex> lock(sdl.inputMutex);
+    data->point.x = sdl.pointX;
+    data->point.y = sdl.pointY;
+    data->state   = sdl.isPressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+static void encoder_read_cb(lv_indev_t* indev, lv_indev_data_t* data)
+{
+    auto& sdl = _sdl_display_data;
+    std::lock_guard<std::mutex> lock(sdl.inputMutex);
+    data->enc_diff = sdl.wheelDiff;
+    data->state    = sdl.isWheelPressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    sdl.wheelDiff  = 0;
+}
+
+// Every queued key is a press and a release
+static void keypad_read_cb(lv_indev_t* indev, lv_indev_data_t* data)
+{
+    auto& sdl = _sdl_display_data;
+    std::lock_guard<std::mutex> lock(sdl.inputMutex);
+    if (sdl.isKeyPressed) {
+        sdl.isKeyPressed = false;
+    } else if (!sdl.keys.empty()) {
+        sdl.lastKey = sdl.keys.front();
+        sdl.keys.pop_front();
+        sdl.isKeyPressed = true;
+    }
+    data->key              = sdl.lastKey;
+    data->state            = sdl.isKeyPressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    data->continue_reading = sdl.isKeyPressed || !sdl.keys.empty();
+}
+
+static uint32_t map_key(SDL_Keycode key)
+{
+    switch (key) {
+        case SDLK_UP:
+            return LV_KEY_UP;
+        case SDLK_DOWN:
+            return LV_KEY_DOWN;
+        case SDLK_LEFT:
+            return LV_KEY_LEFT;
+        case SDLK_RIGHT:
+            return LV_KEY_RIGHT;
+        case SDLK_RETURN:
+        case SDLK_KP_ENTER:
+            return LV_KEY_ENTER;
+        case SDLK_ESCAPE:
+            return LV_KEY_ESC;
+        case SDLK_BACKSPACE:
+            return LV_KEY_BACKSPACE;
+        case SDLK_DELETE:
+            return LV_KEY_DEL;
+        case SDLK_TAB:
+            return (SDL_GetModState() & KMOD_SHIFT) ? LV_KEY_PREV : LV_KEY_NEXT;
+        case SDLK_HOME:
+            return LV_KEY_HOME;
+        case SDLK_END:
+            return LV_KEY_END;
+        case SDLK_PAGEUP:
+            return LV_KEY_PREV;
+        case SDLK_PAGEDOWN:
+            return LV_KEY_NEXT;
+        default:
+            return 0;
+    }
+}
+
+// Window position to raw panel coordinates, LVGL rotates them like the Tab5 touch. The window shows the device at
+// LV_DISPLAY_ROTATION_90 whatever the rotation, so the mapping is fixed
+static void update_point(SdlDisplayData_t& data, int32_t x, int32_t y)
+{
+    float scale    = std::min((float)data.windowWidth / HAL_SCREEN_WIDTH, (float)data.windowHeight / HAL_SCREEN_HEIGHT);
+    float offset_x = (data.windowWidth - HAL_SCREEN_WIDTH * scale) / 2;
+    float offset_y = (data.windowHeight - HAL_SCREEN_HEIGHT * scale) / 2;
+    int32_t wx     = std::clamp((int32_t)((x - offset_x) / scale), 0, HAL_SCREEN_WIDTH - 1);
+    int32_t wy     = std::clamp((int32_t)((y - offset_y) / scale), 0, HAL_SCREEN_HEIGHT - 1);
+    data.pointX    = wy;
+    data.pointY    = _panel_height - 1 - wx;
+}
+
+static void handle_event(SdlDisplayData_t& data, const SDL_Event& event, bool& isRedraw)
+{
+    std::lock_guard<std::mutex> lock(data.inputMutex);
+    switch (event.type) {
+        case SDL_QUIT:
+            std::exit(0);
+        case SDL_WINDOWEVENT:
+            if (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+                data.windowWidth  = event.window.data1;
+                data.windowHeight = event.window.data2;
+            }
+            isRedraw = true;
+            break;
+        case SDL_MOUSEMOTION:
+            update_point(data, event.motion.x, event.motion.y);
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            if (event.button.button == SDL_BUTTON_LEFT) {
+                update_point(data, event.button.x, event.button.y);
+                data.isPressed = event.type == SDL_MOUSEBUTTONDOWN;
+            } else if (event.button.button == SDL_BUTTON_MIDDLE) {
+                data.isWheelPressed = event.type == SDL_MOUSEBUTTONDOWN;
+            }
+            break;
+        case SDL_MOUSEWHEEL:
+            data.wheelDiff -= event.wheel.y;
+            break;
+        case SDL_KEYDOWN: {
+            uint32_t key = map_key(event.key.keysym.sym);
+            if (key != 0) {
+                data.keys.push_back(key);
+            }
+            break;
+        }
+        case SDL_TEXTINPUT: {
+            // One UTF-8 character per key, packed the way lv_textarea_add_char() reads it
+            const char* text = event.text.text;
+            while (*text != '\0') {
+                uint32_t length = std::max<uint32_t>(lv_text_encoded_size(text), 1);
+                uint32_t key    = 0;
+                std::memcpy(&key, text, std::min<uint32_t>(length, sizeof(key)));
+                data.keys.push_back(key);
+                text += length;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                Render thread                               */
+/* -------------------------------------------------------------------------- */
+// The GPU turns the logical frame to the way it sits on the panel, then the panel the way the device is held
+static double get_rotation_angle(lv_display_rotation_t rotation)
+{
+    return (double)((450 - (int)rotation * 90) % 360);
+}
+
+static void render(SDL_Renderer* renderer, SDL_Texture* texture, lv_display_rotation_t rotation)
+{
+    int output_w  = 0;
+    int output_h  = 0;
+    int texture_w = 0;
+    int texture_h = 0;
+    SDL_GetRendererOutputSize(renderer, &output_w, &output_h);
+    SDL_QueryTexture(texture, nullptr, nullptr, &texture_w, &texture_h);
+
+    double angle    = get_rotation_angle(rotation);
+    bool is_swapped = angle == 90 || angle == 270;
+    float visual_w  = is_swapped ? texture_h : texture_w;
+    float visual_h  = is_swapped ? texture_w : texture_h;
+    float scale     = std::min(output_w / visual_w, output_h / visual_h);
+    SDL_Rect dst_rect;
+    dst_rect.w = (int)(texture_w * scale);
+    dst_rect.h = (int)(texture_h * scale);
+    dst_rect.x = (output_w - dst_rect.w) / 2;
+    dst_rect.y = (output_h - dst_rect.h) / 2;
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    SDL_RenderCopyEx(renderer, texture, nullptr, &dst_rect, angle, nullptr, SDL_FLIP_NONE);
+    SDL_RenderPresent(renderer);
+}
+
+static void render_thread(SdlDisplayData_t& data)
+{
+    if (SDL_InitSubSystem(SDL_INIT_VIDEO) < 0) {
+        mclog::tagError(_tag, "sdl video init failed: {}", SDL_GetError());
+        return;
+    }
+    SDL_Window* window = SDL_CreateWindow("M5Tab5 UserDemo", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                                          HAL_SCREEN_WIDTH, HAL_SCREEN_HEIGHT, SDL_WINDOW_RESIZABLE);
+    SDL_Renderer* renderer =
+        window ? SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC) : nullptr;
+    if (renderer == nullptr) {
+        mclog::tagError(_tag, "create window failed: {}", SDL_GetError());
+        return;
+    }
+    SDL_StartTextInput();
+
+    SDL_Texture* texture           = nullptr;
+    lv_display_rotation_t rotation = LV_DISPLAY_ROTATION_90;
+    bool is_redraw                 = false;
+    while (true) {
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+            handle_event(data, event, is_redraw);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(data.frameMutex);
+            data.frameCv.wait_for(lock, std::chrono::milliseconds(_event_poll_ms),
+                                  [&data]() { return data.isResized || !data.dirty.empty(); });
+            if (data.isResized) {
+                if (texture) {
+                    SDL_DestroyTexture(texture);
+                }
+                texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGB565, SDL_TEXTUREACCESS_STREAMING,
+                                            data.frameWidth, data.frameHeight);
+                if (texture == nullptr) {
+                    mclog::tagError(_tag, "create texture failed: {}", SDL_GetError());
+                    return;
+                }
+                SDL_UpdateTexture(texture, nullptr, data.frame.data(), data.frameStride);
+                rotation       = data.rotation;
+                data.isResized = false;
+                is_redraw      = true;
+            }
+            // Only what LVGL redrew goes to the GPU
+            for (const auto& rect : data.dirty) {
+                SDL_UpdateTexture(texture, &rect, data.frame.data() + rect.y * data.frameStride + rect.x * 2,
+                                  data.frameStride);
+                is_redraw = true;
+            }
+            data.dirty.clear();
+        }
+
+        // Vsync paces the loop while frames keep coming
+        if (is_redraw && texture) {
+            render(renderer, texture, rotation);
+            is_redraw = false;
+        }
+    }
+}
+
+lv_display_t* HalDesktop::sdl_display_init()
+{
+    mclog::tagInfo(_tag, "init, panel {}x{}", _panel_width, _panel_height);
+
+    auto& data   = _sdl_display_data;
+    data.display = lv_display_create(_panel_width, _panel_height);
+    lv_display_set_color_format(data.display, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_rotation(data.display, LV_DISPLAY_ROTATION_90);
+    lv_display_set_flush_cb(data.display, flush_cb);
+    set_buffers(data);
+    lv_display_add_event_cb(data.display, resolution_changed_cb, LV_EVENT_RESOLUTION_CHANGED, nullptr);
+
+    lvTouchpad = lv_indev_create();
+    lv_indev_set_type(lvTouchpad, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(lvTouchpad, pointer_read_cb);
+    lv_indev_set_display(lvTouchpad, data.display);
+    lv_indev_set_group(lvTouchpad, lv_group_get_default());
+
+    auto mouse_wheel = lv_indev_create();
+    lv_indev_set_type(mouse_wheel, LV_INDEV_TYPE_ENCODER);
+    lv_indev_set_read_cb(mouse_wheel, encoder_read_cb);
+    lv_indev_set_display(mouse_wheel, data.display);
+    lv_indev_set_group(mouse_wheel, lv_group_get_default());
+
+    auto keyboard = lv_indev_create();
+    lv_indev_set_type(keyboard, LV_INDEV_TYPE_KEYPAD);
+    lv_indev_set_read_cb(keyboard, keypad_read_cb);
+    lv_indev_set_display(keyboard, data.display);
+    lv_indev_set_group(keyboard, lv_group_get_default());
+
+    std::thread([&data]() { render_thread(data); }).detach();
+    return data.display;
+}
+
+void HalDesktop::setDisplayRotation(lv_display_rotation_t rotation)
+{
+    postUiCommand([rotation]() {
+        if (lv_display_get_rotation(_sdl_display_data.display) != rotation) {
+            lv_display_set_rotation(_sdl_display_data.display, rotation);
+        }
+    });
+}
+
+lv_display_rotation_t HalDesktop::getDisplayRotation()
+{
+    std::lock_guard<std::mutex> lock(_sdl_display_data.frameMutex);
+    return _sdl_display_data.rotation;
+}
+#endif
@@ -0,0 +1,687 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "../hal_desktop.h"
+#include "hal/hal.h"
+#include <shared/shared.h>
+#include <mooncake_log.h>
+#include <lvgl.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Simulated sensors, produced on background threads at the device's rates, so the streaming, ring buffer and
+// scheduler paths see the same load shape on a PC. The sources sleep with GetHAL()->delay(), in virtual time headless
+static const std::string _tag = "sim";
+
+// Same burst period as the Tab5 IMU FIFO drain
+static constexpr uint32_t _imu_burst_ms = 20;
+// Same tick as the Tab5 sensor service
+static constexpr uint32_t _service_tick_ms = 10;
+// Line rate of the simulated RS485 peer
+static constexpr uint32_t _rs485_peer_interval_ms = 100;
+static constexpr size_t _camera_stats_size        = 64;
+
+/* -------------------------------------------------------------------------- */
+/*                                   Models                                   */
+/* -------------------------------------------------------------------------- */
+static float noise(float amplitude)
+{
+    static std::mutex mutex;
+    static std::mt19937 gen(std::random_device{}());
+    std::uniform_real_distribution<float> dis(-amplitude, amplitude);
+    std::lock_guard<std::mutex> lock(mutex);
+    return dis(gen);
+}
+
+// A device held in the hand, tilting slowly. Same scales as the Tab5 conversion, about 1.0 per g and 0.1 per dps
+static hal::HalBase::ImuSample_t imu_model(uint64_t timestampUs)
+{
+    float t      = timestampUs / 1000000.0f;
+    float pitch  = 0.15f * std::sin(2.0f * (float)M_PI * 0.2f * t);
+    float roll   = 0.10f * std::sin(2.0f * (float)M_PI * 0.13f * t + 1.0f);
+    float dpitch = 0.15f * 2.0f * (float)M_PI * 0.2f * std::cos(2.0f * (float)M_PI * 0.2f * t);
+    float droll  = 0.10f * 2.0f * (float)M_PI * 0.13f * std::cos(2.0f * (float)M_PI * 0.13f * t + 1.0f);
+
+    hal::HalBase::ImuSample_t sample;
+    sample.timestampUs = timestampUs;
+    sample.accelX      = 0.981f * std::sin(roll) + noise(0.01f);
+    sample.accelY      = -0.981f * std::sin(pitch) * std::cos(roll) + noise(0.01f);
+    sample.accelZ      = 0.981f * std::cos(pitch) * std::cos(roll) + noise(0.01f);
+    sample.gyroX       = dpitch * 180.0f / (float)M_PI / 10.0f + noise(0.02f);
+    sample.gyroY       = droll * 180.0f / (float)M_PI / 10.0f + noise(0.02f);
+    sample.gyroZ       = noise(0.02f);
+    return sample;
+}
+
+static void to_imu_data(const hal::HalBase::ImuSample_t& sample, hal::HalBase::IMUData_t& data)
+{
+    data.accelX = sample.accelX;
+    data.accelY = sample.accelY;
+    data.accelZ = sample.accelZ;
+    data.gyroX  = sample.gyroX;
+    data.gyroY  = sample.gyroY;
+    data.gyroZ  = sample.gyroZ;
+}
+
+// A 2S battery discharging, the draw follows the backlight
+static hal::HalBase::PMData_t power_monitor_model(uint32_t nowMs, uint8_t brightness)
+{
+    hal::HalBase::PMData_t data;
+    float hours       = nowMs / 3600000.0f;
+    data.busVoltage   = std::max(8.2f - 0.3f * hours, 6.8f) + noise(0.01f);
+    data.shuntCurrent = -(0.35f + brightness * 0.004f) * (1.0f + noise(0.03f));
+    data.shuntVoltage = data.shuntCurrent * 0.005f;
+    data.busPower     = data.busVoltage * -data.shuntCurrent;
+    return data;
+}
+
+/**
+ * @brief A source thread ticking at a fixed period, detached so a stop never waits on a sleep in virtual time. A stop
+ * bumps the generation, the thread sees it on its next tick and returns without touching anything
+ *
+ */
+struct SimSource_t {
+    std::atomic<uint32_t> generation{0};
+
+    void start(uint32_t periodMs, std::function<void(uint32_t generation)> tick)
+    {
+        uint32_t current = ++generation;
+        std::thread([this, current, periodMs, tick]() {
+            uint32_t next = GetHAL()->millis();
+            while (generation == current) {
+                tick(current);
+                next += periodMs;
+                int32_t wait = (int32_t)(next - GetHAL()->millis());
+                GetHAL()->delay(wait > 0 ? wait : 1);
+            }
+        }).detach();
+    }
+
+    void stop()
+    {
+        generation++;
+    }
+
+    bool isCurrent(uint32_t current)
+    {
+        return generation == current;
+    }
+};
+
+/* -------------------------------------------------------------------------- */
+/*                                     IMU                                    */
+/* -------------------------------------------------------------------------- */
+struct ImuStreamData_t {
+    SimSource_t source;
+    std::mutex mutex;
+    bool isRunning = false;
+    SpscRing<hal::HalBase::ImuSample_t> ring;
+    uint64_t nextSampleUs = 0;
+    hal::HalBase::ImuSample_t latest;
+    hal::HalBase::ImuOrientation_t orientation;
+    bool hasOrientation = false;
+};
+static ImuStreamData_t _imu_stream_data;
+
+// Rotation taking the measured gravity to the world up axis
+static void update_orientation(const hal::HalBase::ImuSample_t& sample, hal::HalBase::ImuOrientation_t& orientation)
+{
+    float norm = std::sqrt(sample.accelX * sample.accelX + sample.accelY * sample.accelY +
+                           sample.accelZ * sample.accelZ);
+    if (norm < 1e-3f) {
+        return;
+    }
+    float gx = sample.accelX / norm;
+    float gy = sample.accelY / norm;
+    float gz = sample.accelZ / norm;
+
+    float half = std::acos(std::clamp(gz, -1.0f, 1.0f)) / 2.0f;
+    float axis = std::sqrt(gx * gx + gy * gy);
+    float s    = axis > 1e-6f ? std::sin(half) / axis : 0.0f;
+
+    orientation.timestampUs   = sample.timestampUs;
+    orientation.quaternion[0] = std::cos(half);
+    orientation.quaternion[1] = gy * s;
+    orientation.quaternion[2] = -gx * s;
+    orientation.quaternion[3] = 0.0f;
+    orientation.gravityX      = gx;
+    orientation.gravityY      = gy;
+    orientation.gravityZ      = gz;
+}
+
+void HalDesktop::updateImuData()
+{
+    IMUData_t data;
+    to_imu_data(imu_model((uint64_t)millis() * 1000), data);
+    imuSnapshot.publish(data, millis());
+}
+
+bool HalDesktop::startImuStream(uint16_t rateHz)
+{
+    if (rateHz == 0) {
+        return false;
+    }
+    stopImuStream();
+
+    {
+        std::lock_guard<std::mutex> lock(_imu_stream_data.mutex);
+        _imu_stream_data.ring.init(rateHz / 2);
+        _imu_stream_data.nextSampleUs   = (uint64_t)millis() * 1000;
+        _imu_stream_data.hasOrientation = false;
+        _imu_stream_data.isRunning      = true;
+    }
+
+    // One FIFO burst per tick, the samples carry their own spacing like the device's
+    uint64_t period_us = 1000000 / rateHz;
+    _imu_stream_data.source.start(_imu_burst_ms, [this, period_us](uint32_t generation) {
+        std::lock_guard<std::mutex> lock(_imu_stream_data.mutex);
+        if (!_imu_stream_data.source.isCurrent(generation)) {
+            return;
+        }
+        uint64_t now_us = (uint64_t)millis() * 1000;
+        while (_imu_stream_data.nextSampleUs <= now_us) {
+            auto sample = imu_model(_imu_stream_data.nextSampleUs);
+            _imu_stream_data.ring.write(&sample, 1);
+            update_orientation(sample, _imu_stream_data.orientation);
+            _imu_stream_data.latest = sample;
+            _imu_stream_data.nextSampleUs += period_us;
+        }
+        _imu_stream_data.hasOrientation = true;
+
+        IMUData_t data;
+        to_imu_data(_imu_stream_data.latest, data);
+        imuSnapshot.publish(data, millis());
+    });
+
+    mclog::tagInfo(_tag, "imu stream {} Hz", rateHz);
+    return true;
+}
+
+void HalDesktop::stopImuStream()
+{
+    std::lock_guard<std::mutex> lock(_imu_stream_data.mutex);
+    _imu_stream_data.source.stop();
+    _imu_stream_data.isRunning = false;
+}
+
+bool HalDesktop::isImuStreaming()
+{
+    std::lock_guard<std::mutex> lock(_imu_stream_data.mutex);
+    return _imu_stream_data.isRunning;
+}
+
+size_t HalDesktop::readImuSamples(ImuSample_t* samples, size_t maxCount)
+{
+    // Single consumer, the ring needs no lock on this side
+    if (!isImuStreaming()) {
+        return 0;
+    }
+    return _imu_stream_data.ring.read(samples, maxCount);
+}
+
+bool HalDesktop::getImuOrientation(ImuOrientation_t& orientation)
+{
+    std::lock_guard<std::mutex> lock(_imu_stream_data.mutex);
+    if (!_imu_stream_data.isRunning || !_imu_stream_data.hasOrientation) {
+        return false;
+    }
+    orientation = _imu_stream_data.orientation;
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                Power monitor                               */
+/* -------------------------------------------------------------------------- */
+void HalDesktop::updatePowerMonitorData()
+{
+    powerMonitorSnapshot.publish(power_monitor_model(millis(), getDisplayBrightness()), millis());
+}
+
+/* -------------------------------------------------------------------------- */
+/*                               Sensor service                               */
+/* -------------------------------------------------------------------------- */
+struct SensorServiceData_t {
+    SimSource_t source;
+    std::mutex mutex;
+    bool isRunning = false;
+    hal::HalBase::SensorServiceConfig_t config;
+    hal::HalBase::SensorSnapshot_t snapshot;
+};
+static SensorServiceData_t _service_data;
+
+static bool is_due(uint32_t now, uint32_t lastTime, uint16_t intervalMs)
+{
+    if (intervalMs == 0) {
+        return false;
+    }
+    return lastTime == 0 || now - lastTime >= intervalMs;
+}
+
+bool HalDesktop::startSensorService(const SensorServiceConfig_t& config)
+{
+    stopSensorService();
+
+    {
+        std::lock_guard<std::mutex> lock(_service_data.mutex);
+        _service_data.config    = config;
+        _service_data.snapshot  = SensorSnapshot_t();
+        _service_data.isRunning = true;
+    }
+
+    _service_data.source.start(_service_tick_ms, [this](uint32_t generation) {
+        std::lock_guard<std::mutex> lock(_service_data.mutex);
+        if (!_service_data.source.isCurrent(generation)) {
+            return;
+        }
+        auto& snapshot     = _service_data.snapshot;
+        const auto& config = _service_data.config;
+        uint32_t now       = millis();
+        bool updated       = false;
+        if (is_due(now, snapshot.powerMonitorTime, config.powerMonitorIntervalMs)) {
+            snapshot.powerMonitor     = power_monitor_model(now, getDisplayBrightness());
+            snapshot.powerMonitorTime = now;
+            updated                   = true;
+            powerMonitorSnapshot.publish(snapshot.powerMonitor, now);
+            powerMonitorHistory.push(snapshot.powerMonitor);
+        }
+        if (is_due(now, snapshot.imuTime, config.imuIntervalMs)) {
+            to_imu_data(imu_model((uint64_t)now * 1000), snapshot.imu);
+            snapshot.imuTime = now;
+            updated          = true;
+            imuSnapshot.publish(snapshot.imu, now);
+            imuHistory.push(snapshot.imu);
+        }
+        if (is_due(now, snapshot.rtcTime, config.rtcIntervalMs)) {
+            std::time_t time = std::time(nullptr);
+            snapshot.rtc     = *std::localtime(&time);
+            snapshot.rtcTime = now;
+            updated          = true;
+        }
+        if (updated) {
+            snapshot.sequence++;
+        }
+    });
+
+    mclog::tagInfo(_tag, "sensor service pm {} ms, imu {} ms, rtc {} ms", config.powerMonitorIntervalMs,
+                   config.imuIntervalMs, config.rtcIntervalMs);
+    return true;
+}
+
+void HalDesktop::stopSensorService()
+{
+    std::lock_guard<std::mutex> lock(_service_data.mutex);
+    _service_data.source.stop();
+    _service_data.isRunning = false;
+}
+
+bool HalDesktop::getSensorSnapshot(SensorSnapshot_t& snapshot)
+{
+    std::lock_guard<std::mutex> lock(_service_data.mutex);
+    if (!_service_data.isRunning) {
+        return false;
+    }
+    snapshot = _service_data.snapshot;
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Clock                                   */
+/* -------------------------------------------------------------------------- */
+// The PC clock is already disciplined, the service only publishes the boundaries of the system time
+static constexpr uint32_t _clock_poll_ms = 20;
+
+struct ClockServiceData_t {
+    SimSource_t source;
+    std::atomic<bool> isRunning{false};
+    std::time_t lastSecond = 0;
+    int lastMinute         = -1;
+};
+static ClockServiceData_t _clock_data;
+
+bool HalDesktop::startClockService(const ClockServiceConfig_t& config)
+{
+    if (_clock_data.isRunning) {
+        return true;
+    }
+    _clock_data.lastSecond = 0;
+    _clock_data.lastMinute = -1;
+    _clock_data.isRunning  = true;
+
+    bool second_ticks = config.secondTicks;
+    _clock_data.source.start(_clock_poll_ms, [second_ticks](uint32_t generation) {
+        std::time_t now = std::time(nullptr);
+        if (!_clock_data.source.isCurrent(generation) || now == _clock_data.lastSecond) {
+            return;
+        }
+        _clock_data.lastSecond = now;
+        std::tm local          = *std::localtime(&now);
+        bool is_minute         = local.tm_min != _clock_data.lastMinute;
+        _clock_data.lastMinute = local.tm_min;
+        if (!is_minute && !second_ticks) {
+            return;
+        }
+        GetEventBus().publish({shared_data::EVENT_TOPIC_CLOCK,
+                               is_minute ? shared_data::EVENT_CLOCK_MINUTE : shared_data::EVENT_CLOCK_SECOND,
+                               (int32_t)now});
+        GetHAL()->wakeAppLoop();
+    });
+
+    mclog::tagInfo(_tag, "clock service, second ticks {}", second_ticks);
+    return true;
+}
+
+void HalDesktop::stopClockService()
+{
+    _clock_data.source.stop();
+    _clock_data.isRunning = false;
+}
+
+bool HalDesktop::isClockServiceRunning()
+{
+    return _clock_data.isRunning;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    RS485                                   */
+/* -------------------------------------------------------------------------- */
+struct Rs485Data_t {
+    SimSource_t source;
+    std::mutex mutex;
+    hal::HalBase::Rs485Config_t config;
+    hal::HalBase::Rs485FrameCallback_t onFrame;
+    hal::HalBase::Rs485Stats_t stats;
+    // Written bytes, the peer echoes them back once they have been on the line
+    std::vector<uint8_t> echo;
+    uint32_t echoDueMs = 0;
+    uint32_t sequence  = 0;
+};
+static Rs485Data_t _rs485_data;
+
+// Time the bytes take on the line, start, 8 data, parity and stop bits
+static uint32_t line_time_ms(size_t size, const hal::HalBase::Rs485Config_t& config)
+{
+    uint32_t bits = config.parity == hal::HalBase::RS485_PARITY_NONE ? 10 : 11;
+    return (uint32_t)((uint64_t)size * bits * 1000 / std::max<uint32_t>(config.baudRate, 1));
+}
+
+// Lock _rs485_data.mutex before calling
+static void dispatch_frame(const std::vector<uint8_t>& frame)
+{
+    _rs485_data.stats.rxBytes += frame.size();
+    _rs485_data.stats.frames++;
+    if (_rs485_data.onFrame) {
+        _rs485_data.onFrame(frame.data(), frame.size());
+    } else {
+        auto& monitor  = GetHAL()->uartMonitorData;
+        size_t written = monitor.rxRing.write(frame.data(), frame.size());
+        monitor.rxDropped += frame.size() - written;
+    }
+}
+
+bool HalDesktop::setRs485Config(const Rs485Config_t& config, Rs485FrameCallback_t onFrame)
+{
+    std::lock_guard<std::mutex> lock(_rs485_data.mutex);
+    _rs485_data.source.stop();
+    _rs485_data.config  = config;
+    _rs485_data.onFrame = std::move(onFrame);
+    _rs485_data.echo.clear();
+
+    // A peer sending a text line every interval, like a sensor on the bus
+    _rs485_data.source.start(_rs485_peer_interval_ms, [this](uint32_t generation) {
+        std::lock_guard<std::mutex> lock(_rs485_data.mutex);
+        if (!_rs485_data.source.isCurrent(generation)) {
+            return;
+        }
+        uint32_t now = millis();
+        if (!_rs485_data.echo.empty() && (int32_t)(now - _rs485_data.echoDueMs) >= 0) {
+            dispatch_frame(_rs485_data.echo);
+            _rs485_data.echo.clear();
+        }
+
+        std::string line = fmt::format("[sim-peer] seq {} temp {:.2f}\n", _rs485_data.sequence++, 24.0f + noise(0.5f));
+        // A frame longer than the interval at this baud rate would not make it, the peer is cut short like the line
+        size_t max_size = (size_t)_rs485_peer_interval_ms * std::max<uint32_t>(_rs485_data.config.baudRate, 1) / 11000;
+        if (line.size() > max_size) {
+            line.resize(max_size);
+        }
+        dispatch_frame(std::vector<uint8_t>(line.begin(), line.end()));
+    });
+
+    mclog::tagInfo(_tag, "rs485 {} baud, {}", config.baudRate, _rs485_data.onFrame ? "frames" : "monitor");
+    return true;
+}
+
+size_t HalDesktop::rs485Write(const uint8_t* data, size_t size)
+{
+    std::lock_guard<std::mutex> lock(_rs485_data.mutex);
+    size_t queued   = _rs485_data.echo.size();
+    size_t room     = _rs485_data.config.txRingSize > queued ? _rs485_data.config.txRingSize - queued : 0;
+    size_t accepted = std::min(size, room);
+    _rs485_data.echo.insert(_rs485_data.echo.end(), data, data + accepted);
+    _rs485_data.echoDueMs = millis() + line_time_ms(_rs485_data.echo.size(), _rs485_data.config);
+    _rs485_data.stats.txBytes += accepted;
+    return accepted;
+}
+
+hal::HalBase::Rs485Stats_t HalDesktop::getRs485Stats()
+{
+    std::lock_guard<std::mutex> lock(_rs485_data.mutex);
+    return _rs485_data.stats;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                   Camera                                   */
+/* -------------------------------------------------------------------------- */
+// Same slot exchange as the Tab5 presentation ring, LVGL owns front, middle holds the newest frame
+static constexpr uint8_t _slot_mask  = 0x03;
+static constexpr uint8_t _slot_fresh = 0x04;
+
+struct CameraData_t {
+    SimSource_t source;
+    std::mutex mutex;
+    bool isCapturing   = false;
+    lv_obj_t* canvas   = nullptr;
+    lv_timer_t* timer  = nullptr;
+    uint16_t previewW  = 0;
+    uint16_t previewH  = 0;
+    hal::HalBase::CameraConfig_t config;
+    std::vector<uint16_t> slots[3];
+    uint16_t slotW[3] = {0};
+    uint16_t slotH[3] = {0};
+    std::atomic<uint8_t> middle{1};
+    uint8_t front = 0;
+    uint8_t back  = 2;
+    uint32_t frame = 0;
+
+    // Stage times, microseconds
+    uint32_t framesDropped = 0;
+    int64_t publishedUs    = 0;
+    int64_t presentedUs    = 0;
+    std::vector<uint32_t> renderUs;
+    std::vector<uint32_t> presentUs;
+    std::vector<uint32_t> frameUs;
+};
+static CameraData_t _camera_data;
+
+static int64_t now_us()
+{
+    return (int64_t)GetHAL()->millis() * 1000;
+}
+
+static void push_stat(std::vector<uint32_t>& ring, int64_t us)
+{
+    if (ring.size() >= _camera_stats_size) {
+        ring.erase(ring.begin());
+    }
+    ring.push_back((uint32_t)std::max<int64_t>(us, 0));
+}
+
+static hal::HalBase::CameraStageStats_t stage_stats(std::vector<uint32_t> samples)
+{
+    hal::HalBase::CameraStageStats_t stats;
+    if (samples.empty()) {
+        return stats;
+    }
+    std::sort(samples.begin(), samples.end());
+    stats.p50 = samples[samples.size() / 2];
+    stats.p99 = samples[(samples.size() * 99) / 100];
+    return stats;
+}
+
+// Colour bars with a box sweeping across, every frame differs so the canvas is redrawn at the capture rate
+static void render_test_pattern(std::vector<uint16_t>& frame, uint16_t w, uint16_t h, uint32_t index)
+{
+    static const uint16_t bars[] = {0xFFFF, 0xFFE0, 0x07FF, 0x07E0, 0xF81F, 0xF800, 0x001F, 0x0000};
+    frame.resize((size_t)w * h);
+
+    std::vector<uint16_t> row(w);
+    for (uint16_t x = 0; x < w; x++) {
+        row[x] = bars[x * 8 / w];
+    }
+    for (uint16_t y = 0; y < h; y++) {
+        std::copy(row.begin(), row.end(), frame.begin() + (size_t)y * w);
+    }
+
+    uint16_t box   = std::max<uint16_t>(h / 6, 1);
+    uint16_t box_x = (index * 8) % std::max<uint16_t>(w - box, 1);
+    uint16_t box_y = (h - box) / 2;
+    for (uint16_t y = box_y; y < box_y + box; y++) {
+        std::fill_n(frame.begin() + (size_t)y * w + box_x, box, 0x8410);
+    }
+}
+
+// Runs in LVGL context, picks up the newest frame if there is one
+static void camera_present_timer_cb(lv_timer_t* timer)
+{
+    std::lock_guard<std::mutex> lock(_camera_data.mutex);
+    if (!(_camera_data.middle.load() & _slot_fresh)) {
+        return;
+    }
+    _camera_data.front = _camera_data.middle.exchange(_camera_data.front) & _slot_mask;
+    uint8_t front      = _camera_data.front;
+    lv_canvas_set_buffer(_camera_data.canvas, _camera_data.slots[front].data(), _camera_data.slotW[front],
+                         _camera_data.slotH[front], LV_COLOR_FORMAT_RGB565);
+
+    int64_t now = now_us();
+    push_stat(_camera_data.presentUs, now - _camera_data.publishedUs);
+    if (_camera_data.presentedUs) {
+        push_stat(_camera_data.frameUs, now - _camera_data.presentedUs);
+    }
+    _camera_data.presentedUs = now;
+}
+
+void HalDesktop::startCameraCapture(lv_obj_t* imgCanvas, const CameraConfig_t& config)
+{
+    mclog::tagInfo(_tag, "start camera test pattern {}x{} {}fps", config.width, config.height, config.fps);
+    stopCameraCapture();
+
+    {
+        std::lock_guard<std::mutex> lock(_camera_data.mutex);
+        _camera_data.canvas        = imgCanvas;
+        _camera_data.config        = config;
+        _camera_data.isCapturing   = true;
+        _camera_data.front         = 0;
+        _camera_data.back          = 2;
+        _camera_data.frame         = 0;
+        _camera_data.framesDropped = 0;
+        _camera_data.publishedUs   = 0;
+        _camera_data.presentedUs   = 0;
+        _camera_data.middle        = 1;
+        _camera_data.renderUs.clear();
+        _camera_data.presentUs.clear();
+        _camera_data.frameUs.clear();
+        // The panels start and stop the capture with the LVGL lock held
+        _camera_data.timer = lv_timer_create(camera_present_timer_cb, 5, nullptr);
+    }
+
+    uint32_t period_ms = 1000 / std::max<uint8_t>(config.fps, 1);
+    _camera_data.source.start(period_ms, [this](uint32_t generation) {
+        std::lock_guard<std::mutex> lock(_camera_data.mutex);
+        if (!_camera_data.source.isCurrent(generation)) {
+            return;
+        }
+
+        const auto& config = _camera_data.config;
+        _camera_data.frame++;
+        if (config.dropUnconsumedFrames && (_camera_data.middle.load() & _slot_fresh)) {
+            _camera_data.framesDropped++;
+            return;
+        }
+
+        // The preview size stands in for the PPA scaling, capped at the capture size
+        uint16_t w   = _camera_data.previewW ? std::min(_camera_data.previewW, config.width) : config.width;
+        uint16_t h   = _camera_data.previewH ? std::min(_camera_data.previewH, config.height) : config.height;
+        uint8_t back = _camera_data.back;
+        auto start   = std::chrono::steady_clock::now();
+        render_test_pattern(_camera_data.slots[back], w, h, _camera_data.frame);
+        auto render_us = std::chrono::steady_clock::now() - start;
+        push_stat(_camera_data.renderUs, std::chrono::duration_cast<std::chrono::microseconds>(render_us).count());
+        _camera_data.slotW[back] = w;
+        _camera_data.slotH[back] = h;
+        _camera_data.publishedUs = now_us();
+        _camera_data.back        = _camera_data.middle.exchange(back | _slot_fresh) & _slot_mask;
+    });
+}
+
+bool HalDesktop::switchCameraConfig(const CameraConfig_t& config)
+{
+    if (!isCameraCapturing()) {
+        return false;
+    }
+    // No sensor to keep warm, a restart on the same canvas is the switch
+    startCameraCapture(_camera_data.canvas, config);
+    return true;
+}
+
+void HalDesktop::stopCameraCapture()
+{
+    // Called with the LVGL lock held, the slots on screen stay allocated for the next start
+    std::lock_guard<std::mutex> lock(_camera_data.mutex);
+    _camera_data.source.stop();
+    if (_camera_data.timer) {
+        lv_timer_delete(_camera_data.timer);
+        _camera_data.timer = nullptr;
+    }
+    _camera_data.isCapturing = false;
+}
+
+bool HalDesktop::isCameraCapturing()
+{
+    std::lock_guard<std::mutex> lock(_camera_data.mutex);
+    return _camera_data.isCapturing;
+}
+
+void HalDesktop::setCameraPreviewSize(uint16_t width, uint16_t height)
+{
+    std::lock_guard<std::mutex> lock(_camera_data.mutex);
+    _camera_data.previewW = width;
+    _camera_data.previewH = height;
+}
+
+hal::HalBase::CameraStats_t HalDesktop::getCameraStats()
+{
+    std::lock_guard<std::mutex> lock(_camera_data.mutex);
+    CameraStats_t stats;
+    stats.framesDropped = _camera_data.framesDropped;
+    stats.ppa           = stage_stats(_camera_data.renderUs);
+    stats.present       = stage_stats(_camera_data.presentUs);
+
+    uint64_t total = 0;
+    for (uint32_t interval : _camera_data.frameUs) {
+        total += interval;
+    }
+    if (total) {
+        stats.fps = _camera_data.frameUs.size() * 1000000.0f / total;
+    }
+    return stats;
+}
@@ -6,6 +6,7 @@
 #include "hal_desktop.h"
 #include <SDL2/SDL.h>
 #include <mooncake_log.h>
+#include <algorithm>
 #include <random>
 #include <filesystem>
 #include <thread>
@@ -23,12 +24,20 @@ void HalDesktop::init()
 /* -------------------------------------------------------------------------- */
 void HalDesktop::delay(uint32_t ms)
 {
+#ifdef PLATFORM_DESKTOP_HEADLESS
+    headless_delay(ms);
+#else
     SDL_Delay(ms);
+#endif
 }
 
 uint32_t HalDesktop::millis()
 {
+#ifdef PLATFORM_DESKTOP_HEADLESS
+    return headless_millis();
+#else
     return SDL_GetTicks();
+#endif
 }
 
 int HalDesktop::getCpuTemp()
@@ -40,45 +49,33 @@ int HalDesktop::getCpuTemp()
     return dis(gen) * 45.0f;
 }
 
-/* -------------------------------------------------------------------------- */
-/*                                   Display                                  */
-/* -------------------------------------------------------------------------- */
-void HalDesktop::setDisplayBrightness(uint8_t brightness)
+// Plain thread, the core and priority have no meaning here
+bool HalDesktop::startAppTask(const AppTaskConfig_t& config, std::function<void()> task)
 {
-    _current_lcd_brightness = std::clamp((int)brightness, 0, 100);
-    mclog::tagInfo(_tag, "set display brightness: {}%", _current_lcd_brightness);
+    mclog::tagInfo(_tag, "start app task: {}", config.name);
+    std::thread(std::move(task)).detach();
+    return true;
 }
 
-uint8_t HalDesktop::getDisplayBrightness()
+// A thread per job, the pool only matters on the device
+bool HalDesktop::submitJob(std::function<void()> job, int core)
 {
-    return _current_lcd_brightness;
+    std::thread(std::move(job)).detach();
+    return true;
 }
 
 /* -------------------------------------------------------------------------- */
-/*                                Power monitor                               */
+/*                                   Display                                  */
 /* -------------------------------------------------------------------------- */
-void HalDesktop::updatePowerMonitorData()
+void HalDesktop::setDisplayBrightness(uint8_t brightness)
 {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<> dis(0.95, 1.0);
-
-    powerMonitorData.busVoltage   = dis(gen) * 8.0f;
-    powerMonitorData.shuntCurrent = -dis(gen) * 0.5f;
+    _current_lcd_brightness = std::clamp((int)brightness, 0, 100);
+    mclog::tagInfo(_tag, "set display brightness: {}%", _current_lcd_brightness);
 }
 
-/* -------------------------------------------------------------------------- */
-/*                                     IMU                                    */
-/* -------------------------------------------------------------------------- */
-void HalDesktop::updateImuData()
+uint8_t HalDesktop::getDisplayBrightness()
 {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<> dis(-0.1, 0.1);
-
-    imuData.accelX = dis(gen);
-    imuData.accelY = dis(gen);
-    imuData.accelZ = dis(gen);
+    return _current_lcd_brightness;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -157,6 +154,44 @@ std::vector<hal::HalBase::FileEntry_t> HalDesktop::scanSdCard(const std::string&
     return file_entries;
 }
 
+// A local directory reads fast enough, it is paged up front only to behave like the device
+uint32_t HalDesktop::startSdCardScan(const std::string& dirPath, size_t pageSize)
+{
+    _sd_scan_pages.clear();
+    _sd_scan_id++;
+    pageSize = std::max<size_t>(pageSize, 1);
+
+    SdCardScanPage_t page;
+    page.scanId = _sd_scan_id;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(dirPath, error)) {
+        page.entries.push_back({entry.path().filename().string(), entry.is_directory()});
+        if (page.entries.size() >= pageSize) {
+            _sd_scan_pages.push_back(page);
+            page.entries.clear();
+        }
+    }
+    page.isLast   = true;
+    page.isFailed = (bool)error;
+    _sd_scan_pages.push_back(page);
+    return _sd_scan_id;
+}
+
+bool HalDesktop::getSdCardScanPage(SdCardScanPage_t& page)
+{
+    if (_sd_scan_pages.empty()) {
+        return false;
+    }
+    page = std::move(_sd_scan_pages.front());
+    _sd_scan_pages.pop_front();
+    return true;
+}
+
+void HalDesktop::cancelSdCardScan()
+{
+    _sd_scan_pages.clear();
+}
+
 /* -------------------------------------------------------------------------- */
 /*                                  Interface                                 */
 /* -------------------------------------------------------------------------- */
@@ -188,6 +223,29 @@ std::vector<uint8_t> HalDesktop::i2cScan(bool isInternal)
     return addrs;
 }
 
+uint32_t HalDesktop::startI2cScan(bool isInternal)
+{
+    auto addrs = i2cScan(isInternal);
+    std::sort(addrs.begin(), addrs.end());
+
+    uint32_t scan_id              = _i2c_scan_progress.scanId + 1;
+    _i2c_scan_progress            = I2cScanProgress_t();
+    _i2c_scan_progress.scanId     = scan_id;
+    _i2c_scan_progress.isInternal = isInternal;
+    _i2c_scan_progress.isDone     = true;
+    _i2c_scan_progress.addresses  = addrs;
+    return scan_id;
+}
+
+bool HalDesktop::getI2cScanProgress(I2cScanProgress_t& progress)
+{
+    if (_i2c_scan_progress.scanId == 0) {
+        return false;
+    }
+    progress = _i2c_scan_progress;
+    return true;
+}
+
 /* -------------------------------------------------------------------------- */
 /*                                UART monitor                                */
 /* -------------------------------------------------------------------------- */
@@ -202,12 +260,9 @@ void HalDesktop::uartMonitorSend(std::string msg, bool newLine)
     std::thread([&]() {
         for (int i = 0; i < 6; i++) {
             std::this_thread::sleep_for(std::chrono::seconds(1));
-            std::lock_guard<std::mutex> lock(GetHAL()->uartMonitorData.mutex);
             std::string send_msg = "[2025-04-24 14:32:38.111] [info] [panel-com] recv msg: 32\n";
             mclog::tagInfo(_tag, "send msg: {}", send_msg);
-            for (auto c : send_msg) {
-                GetHAL()->uartMonitorData.rxQueue.push(c);
-            }
+            GetHAL()->uartMonitorData.rxRing.write((const uint8_t*)send_msg.data(), send_msg.size());
         }
         is_test_thread_running = false;
     }).detach();
@@ -5,6 +5,7 @@
  */
 #pragma once
 #include <hal/hal.h>
+#include <deque>
 
 class HalDesktop : public hal::HalBase {
 public:
@@ -18,16 +19,31 @@ public:
     void delay(uint32_t ms) override;
     uint32_t millis() override;
     int getCpuTemp() override;
+    bool startAppTask(const AppTaskConfig_t& config, std::function<void()> task) override;
+    bool submitJob(std::function<void()> job, int core = -1) override;
+    bool startHalBenchmark() override;
+    HalBenchmarkResult_t getHalBenchmarkResult() override;
 
     void setDisplayBrightness(uint8_t brightness) override;
     uint8_t getDisplayBrightness() override;
+#if !defined(PLATFORM_DESKTOP_HEADLESS) && !defined(__APPLE__)
+    // Turned on the GPU, the window stays the device held landscape
+    void setDisplayRotation(lv_display_rotation_t rotation) override;
+    lv_display_rotation_t getDisplayRotation() override;
+#endif
 
-    void lvglLock() override;
+    void lvglLock(const char* site = __builtin_FUNCTION()) override;
     void lvglUnlock() override;
+    bool startInputRecord(const std::string& path) override;
+    bool startInputReplay(const std::string& path) override;
+    void stopInputTrace(bool dropLastTap = false) override;
+    InputTraceStatus_t getInputTraceStatus() override;
 
     void setSpeakerVolume(uint8_t volume) override;
     uint8_t getSpeakerVolume() override;
-    void audioPlay(std::vector<int16_t>& data, bool async = true) override;
+    void audioPlay(std::vector<int16_t>& data, bool async = true, uint8_t volume = 100) override;
+    void audioPlayBuffer(const int16_t* data, size_t size, uint8_t volume = 100) override;
+    void audioPlayNotes(const AudioNote_t* notes, size_t count) override;
     void audioRecord(std::vector<int16_t>& data, uint16_t durationMs, float gain = 80.0f) override;
     void startDualMicRecordTest() override;
     MicTestState_t getDualMicRecordTestState() override;
@@ -48,19 +64,57 @@ public:
     bool getExt5vEnable() override;
 
     void updateImuData() override;
+    bool startImuStream(uint16_t rateHz = 400) override;
+    void stopImuStream() override;
+    bool isImuStreaming() override;
+    size_t readImuSamples(ImuSample_t* samples, size_t maxCount) override;
+    bool getImuOrientation(ImuOrientation_t& orientation) override;
+
+    bool startSensorService(const SensorServiceConfig_t& config) override;
+    void stopSensorService() override;
+    bool getSensorSnapshot(SensorSnapshot_t& snapshot) override;
+
+    bool startClockService(const ClockServiceConfig_t& config) override;
+    void stopClockService() override;
+    bool isClockServiceRunning() override;
+
+    using HalBase::startCameraCapture;
+    void startCameraCapture(lv_obj_t* imgCanvas, const CameraConfig_t& config) override;
+    bool switchCameraConfig(const CameraConfig_t& config) override;
+    void stopCameraCapture() override;
+    bool isCameraCapturing() override;
+    void setCameraPreviewSize(uint16_t width, uint16_t height) override;
+    CameraStats_t getCameraStats() override;
 
     void setExtAntennaEnable(bool enable) override;
     bool getExtAntennaEnable() override;
 
     bool isSdCardMounted() override;
     std::vector<FileEntry_t> scanSdCard(const std::string& dirPath) override;
+    uint32_t startSdCardScan(const std::string& dirPath, size_t pageSize) override;
+    bool getSdCardScanPage(SdCardScanPage_t& page) override;
+    void cancelSdCardScan() override;
 
     bool usbCDetect() override;
     bool usbADetect() override;
     bool headPhoneDetect() override;
     std::vector<uint8_t> i2cScan(bool isInternal) override;
+    uint32_t startI2cScan(bool isInternal) override;
+    bool getI2cScanProgress(I2cScanProgress_t& progress) override;
 
     void uartMonitorSend(std::string msg, bool newLine = true) override;
+    bool setRs485Config(const Rs485Config_t& config, Rs485FrameCallback_t onFrame = nullptr) override;
+    size_t rs485Write(const uint8_t* data, size_t size) override;
+    Rs485Stats_t getRs485Stats() override;
+
+#ifdef PLATFORM_DESKTOP_HEADLESS
+    // Each wait moves the virtual clock instead of sleeping
+    void waitAppLoopWakeup(uint32_t timeoutMs) override;
+    // The virtual time limit is reached
+    bool isHeadlessDone();
+    // Run time, frame count, render times and the last frame hash, one JSON line
+    void printHeadlessReport();
+#endif
 
 private:
     uint8_t _current_lcd_brightness = 100;
@@ -70,6 +124,21 @@ private:
     bool _ext_5v_enable             = true;
     bool _usba_5v_enable            = true;
     bool _ext_antenna_enable        = false;
+    uint32_t _sd_scan_id            = 0;
+    std::deque<SdCardScanPage_t> _sd_scan_pages;
+    I2cScanProgress_t _i2c_scan_progress;
 
     void lvgl_init();
+    void input_trace_init();
+#if !defined(PLATFORM_DESKTOP_HEADLESS) && !defined(__APPLE__)
+    // 720x1280 panel at LV_DISPLAY_ROTATION_90, dirty areas streamed to an SDL texture from a render thread
+    lv_display_t* sdl_display_init();
+#endif
+
+#ifdef PLATFORM_DESKTOP_HEADLESS
+    void headless_display_init();
+    uint32_t headless_millis();
+    void headless_delay(uint32_t ms);
+    void headless_step(uint32_t ms);
+#endif
 };
@@ -12,17 +12,28 @@ int main()
 {
     // 应用层初始化回调
     app::InitCallback_t callback;
+    HalDesktop* hal_desktop = nullptr;
 
-    callback.onHalInjection = []() {
+    callback.onHalInjection = [&hal_desktop]() {
         // 注入桌面平台的硬件抽象
-        hal::Inject(std::make_unique<HalDesktop>());
+        auto hal    = std::make_unique<HalDesktop>();
+        hal_desktop = hal.get();
+        hal::Inject(std::move(hal));
     };
 
     // 启动应用层
     app::Init(callback);
+#ifdef PLATFORM_DESKTOP_HEADLESS
+    // 无头模式: 虚拟时间到达上限或基准测试结束时退出
+    while (!app::IsDone() && !hal_desktop->isHeadlessDone()) {
+        app::Update();
+    }
+    hal_desktop->printHeadlessReport();
+#else
     while (!app::IsDone()) {
         app::Update();
     }
+#endif
     app::Destroy();
 
     return 0;
@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file
+ * @brief DMA buffers that own whole cache lines
+ *
+ * A buffer starts on a cache line of its memory and its size is padded to whole lines, so no other data shares a line
+ * with it. A cache sync of part of it is then rounded out to lines without touching anything else, and costs only the
+ * lines of that part. Every buffer records whether the CPU or a peripheral owns it, the hand-overs do the sync.
+ *
+ * Drivers that sync on their own, e.g. PPA and JPEG, only need the alignment and padding, the buffer stays CPU owned
+ * for them. The hand-overs are for transfers the caller syncs, e.g. GDMA copies and the camera's DMA.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Who may touch a buffer
+ */
+typedef enum {
+    DMA_BUFFER_OWNER_CPU = 0,  /*!< The CPU reads and writes it through the cache */
+    DMA_BUFFER_OWNER_DEVICE,   /*!< A peripheral reads or writes the memory, the CPU keeps off */
+} dma_buffer_owner_t;
+
+/**
+ * @brief Direction of a transfer handed to a peripheral
+ */
+typedef enum {
+    DMA_BUFFER_DIR_TO_DEVICE = 0,  /*!< The peripheral reads what the CPU wrote */
+    DMA_BUFFER_DIR_FROM_DEVICE,    /*!< The peripheral writes, the CPU reads it after */
+} dma_buffer_dir_t;
+
+/**
+ * @brief Allocate a DMA buffer aligned to the cache line of its memory and padded to whole lines
+ *
+ * @param size Bytes the caller needs, dma_buffer_get_size() returns the padded size
+ * @param caps Heap caps, usually MALLOC_CAP_DMA with MALLOC_CAP_SPIRAM or MALLOC_CAP_INTERNAL
+ * @return The buffer, CPU owned, or NULL when out of memory
+ */
+void *dma_buffer_alloc(size_t size, uint32_t caps);
+
+/**
+ * @brief Same as dma_buffer_alloc(), aligned to at least align bytes, e.g. for LVGL draw buffers
+ *
+ * @param align Power of two, the cache line is used when it is larger
+ */
+void *dma_buffer_aligned_alloc(size_t align, size_t size, uint32_t caps);
+
+/**
+ * @brief Same as dma_buffer_alloc(), zeroed
+ */
+void *dma_buffer_calloc(size_t size, uint32_t caps);
+
+/**
+ * @brief Free a buffer from dma_buffer_alloc() or dma_buffer_calloc(), NULL is ignored
+ *
+ * @note Must not be owned by a peripheral any more
+ */
+void dma_buffer_free(void *buf);
+
+/**
+ * @brief Padded size of a buffer, a peripheral may use all of it
+ */
+size_t dma_buffer_get_size(const void *buf);
+
+/**
+ * @brief Cache line of the memory the caps allocate from, the alignment of its buffers
+ */
+size_t dma_buffer_get_alignment(uint32_t caps);
+
+/**
+ * @brief Current owner of a buffer
+ */
+dma_buffer_owner_t dma_buffer_get_owner(const void *buf);
+
+/**
+ * @brief Hand part of a buffer to a peripheral
+ *
+ * To the device the lines the CPU wrote are written back, from the device the lines are dropped from the cache so
+ * nothing dirty is evicted over the transfer. Only the lines of the range are synced.
+ *
+ * @param buf The buffer, CPU owned
+ * @param offset Start of the range the peripheral uses
+ * @param len Bytes of the range
+ * @param dir Direction of the transfer
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   when buf is not a DMA buffer or the range is outside it
+ *      - ESP_ERR_INVALID_STATE when a peripheral owns it already
+ */
+esp_err_t dma_buffer_begin_device(void *buf, size_t offset, size_t len, dma_buffer_dir_t dir);
+
+/**
+ * @brief Take a buffer back from the peripheral once the transfer is done
+ *
+ * After a transfer from the device the lines of its range are invalidated, so the CPU reads what was written.
+ *
+ * @param buf The buffer, owned by a peripheral
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   when buf is not a DMA buffer
+ *      - ESP_ERR_INVALID_STATE when the CPU owns it already
+ */
+esp_err_t dma_buffer_end_device(void *buf);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,169 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <inttypes.h>
+#include <string.h>
+#include <sys/param.h>
+#include "dma_buffer.h"
+#include "esp_cache.h"
+#include "esp_log.h"
+
+static const char *TAG = "dma_buffer";
+
+#define DMA_BUFFER_MAGIC 0x444d4142u  // "DMAB"
+
+// Right before the data, in the lines reserved ahead of it that only the CPU touches
+typedef struct {
+    uint32_t magic;
+    uint32_t size;         // Padded to whole lines
+    uint32_t line_size;    // 0 when the memory is not cached
+    uint32_t align;        // Bytes reserved ahead of the data, the allocation starts there
+    uint32_t sync_offset;  // Range handed to the peripheral, rounded out to lines
+    uint32_t sync_len;
+    uint8_t owner;
+    uint8_t dir;
+} dma_buffer_header_t;
+
+static dma_buffer_header_t *get_header(const void *buf)
+{
+    if (buf == NULL) {
+        return NULL;
+    }
+    dma_buffer_header_t *header = (dma_buffer_header_t *)((uint8_t *)buf - sizeof(dma_buffer_header_t));
+    if (header->magic != DMA_BUFFER_MAGIC) {
+        ESP_LOGE(TAG, "%p is not a DMA buffer", buf);
+        return NULL;
+    }
+    return header;
+}
+
+// Whole alignment units, at least enough for the header
+static size_t get_reserved_size(size_t align)
+{
+    return (sizeof(dma_buffer_header_t) + align - 1) & ~(align - 1);
+}
+
+static esp_err_t sync_range(dma_buffer_header_t *header, int flags)
+{
+    if (header->line_size == 0 || header->sync_len == 0) {
+        return ESP_OK;
+    }
+    uint8_t *data = (uint8_t *)header + sizeof(dma_buffer_header_t);
+    return esp_cache_msync(data + header->sync_offset, header->sync_len, flags);
+}
+
+size_t dma_buffer_get_alignment(uint32_t caps)
+{
+    size_t line_size = 0;
+    if (esp_cache_get_alignment(caps, &line_size) != ESP_OK) {
+        return 0;
+    }
+    return line_size > 1 ? line_size : 0;
+}
+
+void *dma_buffer_aligned_alloc(size_t align, size_t size, uint32_t caps)
+{
+    size_t line_size = dma_buffer_get_alignment(caps);
+    align            = MAX(align, MAX(line_size, sizeof(uint32_t)));
+    size_t reserved  = get_reserved_size(align);
+    size_t padded    = (size + align - 1) & ~(align - 1);
+
+    uint8_t *base = heap_caps_aligned_alloc(align, reserved + padded, caps);
+    if (base == NULL) {
+        ESP_LOGD(TAG, "no memory for %u bytes, caps 0x%" PRIx32, (unsigned)size, caps);
+        return NULL;
+    }
+    uint8_t *data               = base + reserved;
+    dma_buffer_header_t *header = (dma_buffer_header_t *)(data - sizeof(dma_buffer_header_t));
+    memset(header, 0, sizeof(*header));
+    header->magic     = DMA_BUFFER_MAGIC;
+    header->size      = padded;
+    header->line_size = line_size;
+    header->align     = reserved;
+    header->owner     = DMA_BUFFER_OWNER_CPU;
+    return data;
+}
+
+void *dma_buffer_alloc(size_t size, uint32_t caps)
+{
+    return dma_buffer_aligned_alloc(0, size, caps);
+}
+
+void *dma_buffer_calloc(size_t size, uint32_t caps)
+{
+    void *buf = dma_buffer_alloc(size, caps);
+    if (buf != NULL) {
+        memset(buf, 0, dma_buffer_get_size(buf));
+    }
+    return buf;
+}
+
+void dma_buffer_free(void *buf)
+{
+    dma_buffer_header_t *header = get_header(buf);
+    if (header == NULL) {
+        return;
+    }
+    if (header->owner != DMA_BUFFER_OWNER_CPU) {
+        ESP_LOGW(TAG, "%p freed while a peripheral owns it", buf);
+    }
+    header->magic = 0;
+    heap_caps_free((uint8_t *)buf - header->align);
+}
+
+size_t dma_buffer_get_size(const void *buf)
+{
+    dma_buffer_header_t *header = get_header(buf);
+    return header ? header->size : 0;
+}
+
+dma_buffer_owner_t dma_buffer_get_owner(const void *buf)
+{
+    dma_buffer_header_t *header = get_header(buf);
+    return header ? (dma_buffer_owner_t)header->owner : DMA_BUFFER_OWNER_CPU;
+}
+
+esp_err_t dma_buffer_begin_device(void *buf, size_t offset, size_t len, dma_buffer_dir_t dir)
+{
+    dma_buffer_header_t *header = get_header(buf);
+    if (header == NULL || offset > header->size || len > header->size - offset) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (header->owner != DMA_BUFFER_OWNER_CPU) {
+        ESP_LOGE(TAG, "%p handed to a peripheral twice", buf);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // The buffer owns its lines, rounding out never reaches another allocation
+    size_t line  = header->line_size > 0 ? header->line_size : 1;
+    size_t start = offset & ~(line - 1);
+    size_t end   = (offset + len + line - 1) & ~(line - 1);
+
+    header->sync_offset = start;
+    header->sync_len    = end - start;
+    header->dir         = dir;
+    header->owner       = DMA_BUFFER_OWNER_DEVICE;
+    return sync_range(header, dir == DMA_BUFFER_DIR_TO_DEVICE ? ESP_CACHE_MSYNC_FLAG_DIR_C2M
+                                                              : ESP_CACHE_MSYNC_FLAG_DIR_M2C);
+}
+
+esp_err_t dma_buffer_end_device(void *buf)
+{
+    dma_buffer_header_t *header = get_header(buf);
+    if (header == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (header->owner != DMA_BUFFER_OWNER_DEVICE) {
+        ESP_LOGE(TAG, "%p taken back but was not handed over", buf);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    header->owner = DMA_BUFFER_OWNER_CPU;
+    // Lines the CPU prefetched while the peripheral wrote are stale
+    if (header->dir == DMA_BUFFER_DIR_FROM_DEVICE) {
+        return sync_range(header, ESP_CACHE_MSYNC_FLAG_DIR_M2C);
+    }
+    return ESP_OK;
+}
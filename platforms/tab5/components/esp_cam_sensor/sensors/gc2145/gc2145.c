@@ -182,18 +182,27 @@ static esp_err_t gc2145_write(esp_sccb_io_handle_t sccb_handle, uint8_t reg, uin
     return esp_sccb_transmit_reg_a8v8(sccb_handle, reg, data);
 }
 
-/* write a array of registers  */
+/* write a array of registers, a run of consecutive registers goes out as one auto-increment burst */
 static esp_err_t gc2145_write_array(esp_sccb_io_handle_t sccb_handle, gc2145_reginfo_t *regarray, size_t regs_size)
 {
     int i         = 0;
     esp_err_t ret = ESP_OK;
+    uint8_t vals[CONFIG_ESP_SCCB_BURST_WRITE_MAX_LEN];
     while ((ret == ESP_OK) && (i < regs_size)) {
         if (regarray[i].reg != GC2145_REG_DELAY) {
-            ret = gc2145_write(sccb_handle, regarray[i].reg, regarray[i].val);
+            /* The delay marker 0xff is the register after the page select, a run never crosses a page */
+            size_t count = 0;
+            do {
+                vals[count] = regarray[i + count].val;
+                count++;
+            } while (count < CONFIG_ESP_SCCB_BURST_WRITE_MAX_LEN && i + count < regs_size &&
+                     regarray[i + count].reg != GC2145_REG_DELAY && regarray[i + count].reg == regarray[i].reg + count);
+            ret = esp_sccb_transmit_burst_reg_a8v8(sccb_handle, regarray[i].reg, vals, count);
+            i += count;
         } else {
             delay_ms(regarray[i].val);
+            i++;
         }
-        i++;
     }
     ESP_LOGD(TAG, "Set array done[i=%d]", i);
     return ret;
@@ -158,18 +158,25 @@ static esp_err_t ov5645_write(esp_sccb_io_handle_t sccb_handle, uint16_t reg, ui
     return esp_sccb_transmit_reg_a16v8(sccb_handle, reg, data);
 }
 
-/* write a array of registers  */
+/* write a array of registers, a run of consecutive registers goes out as one auto-increment burst */
 static esp_err_t ov5645_write_array(esp_sccb_io_handle_t sccb_handle, const ov5645_reginfo_t *regarray)
 {
     int i         = 0;
     esp_err_t ret = ESP_OK;
+    uint8_t vals[CONFIG_ESP_SCCB_BURST_WRITE_MAX_LEN];
     while ((ret == ESP_OK) && regarray[i].reg != OV5645_REG_END) {
         if (regarray[i].reg != OV5645_REG_DELAY) {
-            ret = ov5645_write(sccb_handle, regarray[i].reg, regarray[i].val);
+            size_t count = 0;
+            do {
+                vals[count] = regarray[i + count].val;
+                count++;
+            } while (count < CONFIG_ESP_SCCB_BURST_WRITE_MAX_LEN && regarray[i + count].reg == regarray[i].reg + count);
+            ret = esp_sccb_transmit_burst_reg_a16v8(sccb_handle, regarray[i].reg, vals, count);
+            i += count;
         } else {
             delay_ms(regarray[i].val);
+            i++;
         }
-        i++;
     }
     ESP_LOGD(TAG, "count=%d", i);
     return ret;
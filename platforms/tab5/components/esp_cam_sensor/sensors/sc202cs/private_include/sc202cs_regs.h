@@ -46,6 +46,7 @@ extern "C" {
 #define SC202CS_REG_OUT_START_LINE_L  0x3213
 
 #define SC202CS_REG_FLIP_MIRROR 0x3221
+#define SC202CS_REG_SOFT_RESET  0x0103
 #define SC202CS_REG_SLEEP_MODE  0x0100
 
 #ifdef __cplusplus
@@ -39,6 +39,7 @@ typedef struct {
 
 struct sc202cs_cam {
     sc202cs_para_t sc202cs_para;
+    const sc202cs_reginfo_t *loaded_regs; /* Table the registers were last programmed from, NULL when unknown */
 };
 
 #define SC202CS_IO_MUX_LOCK(mux)
@@ -1004,22 +1005,137 @@ static esp_err_t sc202cs_write(esp_sccb_io_handle_t sccb_handle, uint16_t reg, u
     return esp_sccb_transmit_reg_a16v8(sccb_handle, reg, data);
 }
 
-/* write a array of registers  */
+/* write a array of registers, a run of consecutive registers goes out as one auto-increment burst */
 static esp_err_t sc202cs_write_array(esp_sccb_io_handle_t sccb_handle, sc202cs_reginfo_t *regarray)
 {
     int i         = 0;
     esp_err_t ret = ESP_OK;
+    uint8_t vals[CONFIG_ESP_SCCB_BURST_WRITE_MAX_LEN];
     while ((ret == ESP_OK) && regarray[i].reg != SC202CS_REG_END) {
         if (regarray[i].reg != SC202CS_REG_DELAY) {
-            ret = sc202cs_write(sccb_handle, regarray[i].reg, regarray[i].val);
+            size_t count = 0;
+            do {
+                vals[count] = regarray[i + count].val;
+                count++;
+            } while (count < CONFIG_ESP_SCCB_BURST_WRITE_MAX_LEN && regarray[i + count].reg == regarray[i].reg + count);
+            ret = esp_sccb_transmit_burst_reg_a16v8(sccb_handle, regarray[i].reg, vals, count);
+            i += count;
         } else {
             delay_ms(regarray[i].val);
+            i++;
         }
-        i++;
     }
     return ret;
 }
 
+/* Registers the driver writes at runtime, a format switch always writes them instead of trusting the old table */
+static bool sc202cs_is_runtime_reg(uint16_t reg)
+{
+    switch (reg) {
+        case SC202CS_REG_SLEEP_MODE:
+        case SC202CS_REG_GROUP_HOLD:
+        case SC202CS_REG_SHUTTER_TIME_H:
+        case SC202CS_REG_SHUTTER_TIME_M:
+        case SC202CS_REG_SHUTTER_TIME_L:
+        case SC202CS_REG_DIG_COARSE_GAIN:
+        case SC202CS_REG_DIG_FINE_GAIN:
+        case SC202CS_REG_ANG_GAIN:
+        case SC202CS_REG_FLIP_MIRROR:
+        case 0x4501: /* test pattern */
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* Index of the last write of reg in regarray, -1 if the table does not write it */
+static int sc202cs_find_reg(const sc202cs_reginfo_t *regarray, uint16_t reg, int *writes)
+{
+    int last = -1;
+    int num  = 0;
+    for (int i = 0; regarray[i].reg != SC202CS_REG_END; i++) {
+        if (regarray[i].reg == reg) {
+            last = i;
+            num++;
+        }
+    }
+    if (writes) {
+        *writes = num;
+    }
+    return last;
+}
+
+/**
+ * @brief Build the writes that take the sensor from the registers of cur to those of next, without the soft reset.
+ *        Registers next writes more than once keep their whole sequence.
+ *
+ * @return Entries in delta, or -1 if cur writes a register that next leaves alone. Its reset value is not known
+ *         here, so the full table has to go out.
+ */
+static int sc202cs_build_delta(const sc202cs_reginfo_t *cur, const sc202cs_reginfo_t *next, sc202cs_reginfo_t *delta)
+{
+    int count = 0;
+
+    for (int i = 0; cur[i].reg != SC202CS_REG_END; i++) {
+        if (cur[i].reg != SC202CS_REG_DELAY && cur[i].reg != SC202CS_REG_SOFT_RESET &&
+            sc202cs_find_reg(next, cur[i].reg, NULL) < 0) {
+            return -1;
+        }
+    }
+
+    for (int i = 0; next[i].reg != SC202CS_REG_END; i++) {
+        uint16_t reg = next[i].reg;
+        if (reg == SC202CS_REG_SOFT_RESET) {
+            continue;
+        }
+        if (reg != SC202CS_REG_DELAY && !sc202cs_is_runtime_reg(reg)) {
+            int writes = 0;
+            int last   = sc202cs_find_reg(cur, reg, NULL);
+            sc202cs_find_reg(next, reg, &writes);
+            if (writes == 1 && last >= 0 && cur[last].val == next[i].val) {
+                continue;
+            }
+        }
+        delta[count++] = next[i];
+    }
+    delta[count].reg = SC202CS_REG_END;
+    delta[count].val = 0;
+
+    return count;
+}
+
+/* write a format table, only the registers that differ from the loaded table when that one is known */
+static esp_err_t sc202cs_write_format_regs(esp_cam_sensor_device_t *dev, const sc202cs_reginfo_t *regs)
+{
+    struct sc202cs_cam *cam_sc202cs = (struct sc202cs_cam *)dev->priv;
+    esp_err_t ret                   = ESP_FAIL;
+    bool is_written                 = false;
+
+#if CONFIG_CAMERA_SC202CS_DELTA_FORMAT_SWITCH
+    if (cam_sc202cs->loaded_regs && cam_sc202cs->loaded_regs != regs) {
+        int size                 = 0;
+        sc202cs_reginfo_t *delta = NULL;
+        while (regs[size].reg != SC202CS_REG_END) {
+            size++;
+        }
+        delta     = heap_caps_malloc((size + 1) * sizeof(sc202cs_reginfo_t), MALLOC_CAP_DEFAULT);
+        int count = delta ? sc202cs_build_delta(cam_sc202cs->loaded_regs, regs, delta) : -1;
+        if (count >= 0) {
+            ESP_LOGD(TAG, "format switch writes %d of %d registers", count, size);
+            ret        = sc202cs_write_array(dev->sccb_handle, delta);
+            is_written = true;
+        }
+        heap_caps_free(delta);
+    }
+#endif
+
+    if (!is_written) {
+        ret = sc202cs_write_array(dev->sccb_handle, (sc202cs_reginfo_t *)regs);
+    }
+    cam_sc202cs->loaded_regs = ret == ESP_OK ? regs : NULL;
+    return ret;
+}
+
 static esp_err_t sc202cs_set_reg_bits(esp_sccb_io_handle_t sccb_handle, uint16_t reg, uint8_t offset, uint8_t length,
                                       uint8_t value)
 {
@@ -1043,7 +1159,10 @@ static esp_err_t sc202cs_set_test_pattern(esp_cam_sensor_device_t *dev, int enab
 
 static esp_err_t sc202cs_hw_reset(esp_cam_sensor_device_t *dev)
 {
+    struct sc202cs_cam *cam_sc202cs = (struct sc202cs_cam *)dev->priv;
+
     if (dev->reset_pin >= 0) {
+        cam_sc202cs->loaded_regs = NULL;
         gpio_set_level(dev->reset_pin, 0);
         delay_ms(10);
         gpio_set_level(dev->reset_pin, 1);
@@ -1054,7 +1173,9 @@ static esp_err_t sc202cs_hw_reset(esp_cam_sensor_device_t *dev)
 
 static esp_err_t sc202cs_soft_reset(esp_cam_sensor_device_t *dev)
 {
-    esp_err_t ret = sc202cs_set_reg_bits(dev->sccb_handle, 0x0103, 0, 1, 0x01);
+    struct sc202cs_cam *cam_sc202cs = (struct sc202cs_cam *)dev->priv;
+    esp_err_t ret                   = sc202cs_set_reg_bits(dev->sccb_handle, SC202CS_REG_SOFT_RESET, 0, 1, 0x01);
+    cam_sc202cs->loaded_regs        = NULL;
     delay_ms(5);
     return ret;
 }
@@ -1234,7 +1355,7 @@ static esp_err_t sc202cs_set_format(esp_cam_sensor_device_t *dev, const esp_cam_
         format = &sc202cs_format_info[CONFIG_CAMERA_SC202CS_MIPI_IF_FORMAT_INDEX_DAFAULT];
     }
 
-    ret = sc202cs_write_array(dev->sccb_handle, (sc202cs_reginfo_t *)format->regs);
+    ret = sc202cs_write_format_regs(dev, (const sc202cs_reginfo_t *)format->regs);
 
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Set format regs fail");
@@ -1280,6 +1401,8 @@ static esp_err_t sc202cs_priv_ioctl(esp_cam_sensor_device_t *dev, uint32_t cmd,
         case ESP_CAM_SENSOR_IOC_S_REG:
             sensor_reg = (esp_cam_sensor_reg_val_t *)arg;
             ret        = sc202cs_write(dev->sccb_handle, sensor_reg->regaddr, sensor_reg->value);
+            /* The tables no longer tell what is in the sensor */
+            ((struct sc202cs_cam *)dev->priv)->loaded_regs = NULL;
             break;
         case ESP_CAM_SENSOR_IOC_S_STREAM:
             ret = sc202cs_set_stream(dev, *(int *)arg);
@@ -8,6 +8,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "esp_err.h"
 #include "esp_sccb_types.h"
 
@@ -63,6 +64,40 @@ esp_err_t esp_sccb_transmit_reg_a8v16(esp_sccb_io_handle_t io_handle, uint8_t re
  */
 esp_err_t esp_sccb_transmit_reg_a16v16(esp_sccb_io_handle_t io_handle, uint16_t reg_addr, uint16_t reg_val);
 
+/**
+ * @brief Perform a burst write transaction for 8-bit reg_addr and consecutive 8-bit reg_vals.
+ *
+ * @note The device must auto-increment the register address after each data byte. Runs longer than
+ *       CONFIG_ESP_SCCB_BURST_WRITE_MAX_LEN are split into several transactions.
+ *
+ * @param[in] handle SCCB IO handle
+ * @param[in] reg_addr address of the first register.
+ * @param[in] reg_vals Data of count registers starting at reg_addr.
+ * @param[in] count    Number of registers to write.
+ * @return
+ *      - ESP_OK: sccb transmit success
+ *      - ESP_ERR_INVALID_ARG: sccb transmit parameter invalid.
+ */
+esp_err_t esp_sccb_transmit_burst_reg_a8v8(esp_sccb_io_handle_t io_handle, uint8_t reg_addr, const uint8_t *reg_vals,
+                                           size_t count);
+
+/**
+ * @brief Perform a burst write transaction for 16-bit reg_addr and consecutive 8-bit reg_vals.
+ *
+ * @note The device must auto-increment the register address after each data byte. Runs longer than
+ *       CONFIG_ESP_SCCB_BURST_WRITE_MAX_LEN are split into several transactions.
+ *
+ * @param[in] handle SCCB IO handle
+ * @param[in] reg_addr address of the first register.
+ * @param[in] reg_vals Data of count registers starting at reg_addr.
+ * @param[in] count    Number of registers to write.
+ * @return
+ *      - ESP_OK: sccb transmit success
+ *      - ESP_ERR_INVALID_ARG: sccb transmit parameter invalid.
+ */
+esp_err_t esp_sccb_transmit_burst_reg_a16v8(esp_sccb_io_handle_t io_handle, uint16_t reg_addr, const uint8_t *reg_vals,
+                                            size_t count);
+
 /**
  * @brief Perform a write-read transaction for 8-bit reg_addr and 8-bit reg_val.
  *
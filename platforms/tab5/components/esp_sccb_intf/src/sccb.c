@@ -15,6 +15,7 @@
 #include "esp_sccb_intf.h"
 
 #define ESP_SCCB_TRANS_DEALY CONFIG_ESP_SCCB_TRANS_TIMEOUT_DEFAULT
+#define ESP_SCCB_BURST_MAX_LEN CONFIG_ESP_SCCB_BURST_WRITE_MAX_LEN
 
 static const char *TAG = "sccb";
 
@@ -82,6 +83,57 @@ esp_err_t esp_sccb_transmit_reg_a16v16(esp_sccb_io_handle_t io_handle, uint16_t
     return ret;
 }
 
+esp_err_t esp_sccb_transmit_burst_reg_a8v8(esp_sccb_io_handle_t io_handle, uint8_t reg_addr, const uint8_t *reg_vals,
+                                           size_t count)
+{
+    ESP_RETURN_ON_FALSE(io_handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
+    ESP_RETURN_ON_FALSE(io_handle->transmit_reg_a8v8, ESP_ERR_NOT_SUPPORTED, TAG,
+                        "controller driver function not supported");
+    ESP_RETURN_ON_FALSE(reg_vals || !count, ESP_ERR_INVALID_ARG, TAG, "invalid argument: reg_vals null pointer");
+    ESP_RETURN_ON_FALSE(reg_addr + count <= 0x100, ESP_ERR_INVALID_ARG, TAG, "invalid argument: register range");
+
+    uint8_t data[1 + ESP_SCCB_BURST_MAX_LEN];
+    while (count > 0) {
+        size_t len = count > ESP_SCCB_BURST_MAX_LEN ? ESP_SCCB_BURST_MAX_LEN : count;
+        data[0]    = reg_addr & 0xff;
+        memcpy(&data[1], reg_vals, len);
+
+        ESP_RETURN_ON_ERROR(io_handle->transmit_reg_a8v8(io_handle, data, 1 + len, ESP_SCCB_TRANS_DEALY), TAG,
+                            "failed to transmit_burst_reg_a8v8");
+        reg_addr += len;
+        reg_vals += len;
+        count -= len;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t esp_sccb_transmit_burst_reg_a16v8(esp_sccb_io_handle_t io_handle, uint16_t reg_addr, const uint8_t *reg_vals,
+                                            size_t count)
+{
+    ESP_RETURN_ON_FALSE(io_handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
+    ESP_RETURN_ON_FALSE(io_handle->transmit_reg_a16v8, ESP_ERR_NOT_SUPPORTED, TAG,
+                        "controller driver function not supported");
+    ESP_RETURN_ON_FALSE(reg_vals || !count, ESP_ERR_INVALID_ARG, TAG, "invalid argument: reg_vals null pointer");
+    ESP_RETURN_ON_FALSE(reg_addr + count <= 0x10000, ESP_ERR_INVALID_ARG, TAG, "invalid argument: register range");
+
+    uint8_t data[2 + ESP_SCCB_BURST_MAX_LEN];
+    while (count > 0) {
+        size_t len = count > ESP_SCCB_BURST_MAX_LEN ? ESP_SCCB_BURST_MAX_LEN : count;
+        data[0]    = (reg_addr & 0xff00) >> 8;
+        data[1]    = reg_addr & 0xff;
+        memcpy(&data[2], reg_vals, len);
+
+        ESP_RETURN_ON_ERROR(io_handle->transmit_reg_a16v8(io_handle, data, 2 + len, ESP_SCCB_TRANS_DEALY), TAG,
+                            "failed to transmit_burst_reg_a16v8");
+        reg_addr += len;
+        reg_vals += len;
+        count -= len;
+    }
+
+    return ESP_OK;
+}
+
 esp_err_t esp_sccb_transmit_receive_reg_a8v8(esp_sccb_io_handle_t io_handle, uint8_t reg_addr, uint8_t *reg_val)
 {
     ESP_RETURN_ON_FALSE(io_handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
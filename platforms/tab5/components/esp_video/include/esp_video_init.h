@@ -37,6 +37,15 @@ typedef struct esp_video_init_sccb_config {
     uint32_t freq; /*!< SCCB I2C frequency */
 } esp_video_init_sccb_config_t;
 
+/**
+ * @brief Camera sensor found by the MIPI CSI probe, saved by the application to skip probing on the next boot
+ */
+typedef struct esp_video_init_sensor_hint {
+    uint8_t detect_index; /*!< Index of the sensor driver in the detect function array */
+    uint16_t sccb_addr;   /*!< SCCB address the sensor answered on */
+    uint16_t pid;         /*!< Sensor product ID */
+} esp_video_init_sensor_hint_t;
+
 /**
  * @brief MIPI CSI initialization and camera sensor connection configuration
  */
@@ -45,6 +54,9 @@ typedef struct esp_video_init_csi_config {
 
     int8_t reset_pin; /*!< Camera sensor reset pin, if hardware has no reset pin, set reset_pin to be -1 */
     int8_t pwdn_pin;  /*!< Camera sensor power down pin, if hardware has no power down pin, set pwdn_pin to be -1 */
+
+    const esp_video_init_sensor_hint_t *sensor_hint; /*!< Sensor driver to try first, all the drivers are probed when
+                                                          it is NULL, stale or the sensor does not answer */
 } esp_video_init_csi_config_t;
 
 /**
@@ -101,6 +113,18 @@ typedef struct esp_video_init_config {
  */
 esp_err_t esp_video_init(const esp_video_init_config_t *config);
 
+/**
+ * @brief Get the MIPI CSI camera sensor detected by esp_video_init
+ *
+ * @param hint Detected sensor, to be passed back in esp_video_init_csi_config_t::sensor_hint
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if hint is NULL
+ *      - ESP_ERR_NOT_FOUND if no MIPI CSI sensor was detected
+ */
+esp_err_t esp_video_init_get_sensor_hint(esp_video_init_sensor_hint_t *hint);
+
 #ifdef __cplusplus
 }
 #endif
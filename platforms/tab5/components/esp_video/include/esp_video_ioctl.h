@@ -13,8 +13,9 @@
 extern "C" {
 #endif
 
-#define VIDIOC_S_SENSOR_FMT _IOWR('V', BASE_VIDIOC_PRIVATE + 1, esp_cam_sensor_format_t)
-#define VIDIOC_G_SENSOR_FMT _IOWR('V', BASE_VIDIOC_PRIVATE + 2, esp_cam_sensor_format_t)
+#define VIDIOC_S_SENSOR_FMT     _IOWR('V', BASE_VIDIOC_PRIVATE + 1, esp_cam_sensor_format_t)
+#define VIDIOC_G_SENSOR_FMT     _IOWR('V', BASE_VIDIOC_PRIVATE + 2, esp_cam_sensor_format_t)
+#define VIDIOC_QUERY_SENSOR_FMT _IOWR('V', BASE_VIDIOC_PRIVATE + 3, esp_cam_sensor_format_array_t)
 
 #ifdef __cplusplus
 }
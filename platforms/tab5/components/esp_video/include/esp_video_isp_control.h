@@ -0,0 +1,83 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: ESPRESSIF MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_video_isp_ioctl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Settings held by the application, the IPA output for them is dropped
+ */
+#define ESP_VIDEO_ISP_MANUAL_EXPOSURE (1 << 0) /*!< Exposure time and sensor gain, i.e. AE lock */
+#define ESP_VIDEO_ISP_MANUAL_WB       (1 << 1) /*!< Red and blue gains, i.e. AWB lock */
+#define ESP_VIDEO_ISP_MANUAL_CCM      (1 << 2) /*!< Color correction matrix */
+#define ESP_VIDEO_ISP_MANUAL_IPA_OFF  (1 << 3) /*!< The IPA does not run at all, every setting stays as it is */
+
+/**
+ * @brief Manual ISP and sensor settings.
+ *
+ * A value of 0 under a held flag keeps what the IPA wrote last, so a flag alone is a lock.
+ */
+typedef struct esp_video_isp_manual {
+    uint32_t flags;       /*!< ESP_VIDEO_ISP_MANUAL_x */
+    uint32_t exposure_us; /*!< Exposure time, the sensor rounds it to its line time */
+    float gain;           /*!< Sensor gain as a multiple of its minimum, the nearest step is taken */
+    float red_gain;       /*!< White balance gains against green */
+    float blue_gain;
+    bool has_ccm;                                    /*!< Write ccm with ESP_VIDEO_ISP_MANUAL_CCM */
+    float ccm[ISP_CCM_DIMENSION][ISP_CCM_DIMENSION]; /*!< Color correction matrix, range is (-4, 4) */
+} esp_video_isp_manual_t;
+
+/**
+ * @brief Settings as last written to the sensor and the ISP.
+ */
+typedef struct esp_video_isp_state {
+    uint32_t exposure_us;
+    uint32_t min_exposure_us; /*!< Range of the current sensor mode */
+    uint32_t max_exposure_us;
+    float gain;
+    float max_gain;
+    float red_gain;
+    float blue_gain;
+} esp_video_isp_state_t;
+
+/**
+ * @brief Hold settings against the IPA and write the given values.
+ *
+ * @note The ISP pipeline task takes the settings at its next statistics frame and writes them, so they never race
+ *       an IPA write. Held values are written again after a sensor mode switch, which reloads the sensor defaults.
+ *
+ * @param manual Settings, flags 0 hands everything back to the IPA
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if manual is NULL
+ *      - ESP_ERR_INVALID_STATE if the ISP pipeline is not initialized
+ */
+esp_err_t esp_video_isp_pipeline_set_manual(const esp_video_isp_manual_t *manual);
+
+/**
+ * @brief Read the settings as last written.
+ *
+ * @param state State buffer
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if state is NULL
+ *      - ESP_ERR_INVALID_STATE if the ISP pipeline is not initialized
+ */
+esp_err_t esp_video_isp_pipeline_get_state(esp_video_isp_state_t *state);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: ESPRESSIF MIT
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "esp_video_isp_ioctl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief ISP statistics callback.
+ *
+ * Called from the ISP pipeline task for every statistics frame, before the buffer goes back to the ISP driver.
+ * The statistics are not copied, the pointer is only valid until the callback returns. The callback blocks
+ * the IPA, it must not block and should only take what it needs from the statistics.
+ *
+ * @param stats     ISP statistics of one frame, check stats->flags for the valid parts
+ * @param user_data User data passed to esp_video_isp_stats_subscribe
+ */
+typedef void (*esp_video_isp_stats_cb_t)(const esp_video_isp_stats_t *stats, void *user_data);
+
+/**
+ * @brief Subscribe to the per-frame ISP statistics.
+ *
+ * @note The ISP pipeline controller must be initialized, i.e. esp_video_init must have been called.
+ *
+ * @param cb        Callback
+ * @param user_data User data passed to the callback
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if cb is NULL
+ *      - ESP_ERR_INVALID_STATE if the ISP pipeline is not initialized
+ *      - ESP_ERR_NO_MEM if all subscriber slots are taken
+ */
+esp_err_t esp_video_isp_stats_subscribe(esp_video_isp_stats_cb_t cb, void *user_data);
+
+/**
+ * @brief Unsubscribe from the per-frame ISP statistics.
+ *
+ * @note The callback is not running and is not called again once this returns.
+ *
+ * @param cb        Callback passed to esp_video_isp_stats_subscribe
+ * @param user_data User data passed to esp_video_isp_stats_subscribe
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the ISP pipeline is not initialized
+ *      - ESP_ERR_NOT_FOUND if there is no such subscription
+ */
+esp_err_t esp_video_isp_stats_unsubscribe(esp_video_isp_stats_cb_t cb, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
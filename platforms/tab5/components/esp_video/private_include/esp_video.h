@@ -556,6 +556,18 @@ esp_err_t esp_video_set_sensor_format(struct esp_video *video, const esp_cam_sen
  */
 esp_err_t esp_video_get_sensor_format(struct esp_video *video, esp_cam_sensor_format_t *format);
 
+/**
+ * @brief Query all formats supported by sensor
+ *
+ * @param video        Video object
+ * @param format_array Sensor format array pointer
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - Others if failed
+ */
+esp_err_t esp_video_query_sensor_format(struct esp_video *video, esp_cam_sensor_format_array_t *format_array);
+
 /**
  * @brief Query menu value
  *
@@ -270,6 +270,10 @@ struct esp_video_ops {
 
     esp_err_t (*get_sensor_format)(struct esp_video *video, esp_cam_sensor_format_t *format);
 
+    /*!< Query all formats supported by sensor */
+
+    esp_err_t (*query_sensor_format)(struct esp_video *video, esp_cam_sensor_format_array_t *format_array);
+
     /*!< Query menu value */
 
     esp_err_t (*query_menu)(struct esp_video *video, struct v4l2_querymenu *qmenu);
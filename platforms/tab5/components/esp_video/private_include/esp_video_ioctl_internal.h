@@ -18,6 +18,7 @@ extern "C" {
  * @brief video device ioctl
  *
  * @param video video object
+ * @param nonblock true if VIDIOC_DQBUF returns ESP_ERR_TIMEOUT instead of waiting for a buffer
  * @param cmd ioctl cmd which is defined in include/linux/videodev2.h
  * @param args the args list of the ioctl cmd
  *
@@ -25,7 +26,7 @@ extern "C" {
  *      - ESP_OK on success
  *      - Others if failed
  */
-esp_err_t esp_video_ioctl(struct esp_video *video, int cmd, va_list args);
+esp_err_t esp_video_ioctl(struct esp_video *video, bool nonblock, int cmd, va_list args);
 
 #ifdef __cplusplus
 }
@@ -46,6 +46,15 @@ esp_err_t esp_video_vfs_dev_register(const char *name, struct esp_video *video);
  */
 esp_err_t esp_video_vfs_dev_unregister(const char *name);
 
+/**
+ * @brief Wake up a select() waiting on the video device, called after a buffer element is put on a done list.
+ *
+ * @note This function can be called in ISR context.
+ *
+ * @param video Video object
+ */
+void esp_video_vfs_notify_done(struct esp_video *video);
+
 #ifdef __cplusplus
 }
 #endif
@@ -327,6 +327,13 @@ static esp_err_t dvp_video_get_sensor_format(struct esp_video *video, esp_cam_se
     return esp_cam_sensor_get_format(dvp_video->cam_dev, format);
 }
 
+static esp_err_t dvp_video_query_sensor_format(struct esp_video *video, esp_cam_sensor_format_array_t *format_array)
+{
+    struct dvp_video *dvp_video = VIDEO_PRIV_DATA(struct dvp_video *, video);
+
+    return esp_cam_sensor_query_format(dvp_video->cam_dev, format_array);
+}
+
 static esp_err_t dvp_video_query_menu(struct esp_video *video, struct v4l2_querymenu *qmenu)
 {
     struct dvp_video *dvp_video = VIDEO_PRIV_DATA(struct dvp_video *, video);
@@ -335,19 +342,20 @@ static esp_err_t dvp_video_query_menu(struct esp_video *video, struct v4l2_query
 }
 
 static const struct esp_video_ops s_dvp_video_ops = {
-    .init              = dvp_video_init,
-    .deinit            = dvp_video_deinit,
-    .start             = dvp_video_start,
-    .stop              = dvp_video_stop,
-    .enum_format       = dvp_video_enum_format,
-    .set_format        = dvp_video_set_format,
-    .notify            = dvp_video_notify,
-    .set_ext_ctrl      = dvp_video_set_ext_ctrl,
-    .get_ext_ctrl      = dvp_video_get_ext_ctrl,
-    .query_ext_ctrl    = dvp_video_query_ext_ctrl,
-    .set_sensor_format = dvp_video_set_sensor_format,
-    .get_sensor_format = dvp_video_get_sensor_format,
-    .query_menu        = dvp_video_query_menu,
+    .init                = dvp_video_init,
+    .deinit              = dvp_video_deinit,
+    .start               = dvp_video_start,
+    .stop                = dvp_video_stop,
+    .enum_format         = dvp_video_enum_format,
+    .set_format          = dvp_video_set_format,
+    .notify              = dvp_video_notify,
+    .set_ext_ctrl        = dvp_video_set_ext_ctrl,
+    .get_ext_ctrl        = dvp_video_get_ext_ctrl,
+    .query_ext_ctrl      = dvp_video_query_ext_ctrl,
+    .set_sensor_format   = dvp_video_set_sensor_format,
+    .get_sensor_format   = dvp_video_get_sensor_format,
+    .query_sensor_format = dvp_video_query_sensor_format,
+    .query_menu          = dvp_video_query_menu,
 };
 
 /**
@@ -955,6 +955,7 @@ esp_err_t IRAM_ATTR esp_video_done_element(struct esp_video *video, uint32_t typ
     } else {
         xSemaphoreGive(stream->ready_sem);
     }
+    esp_video_vfs_notify_done(video);
 
     return ESP_OK;
 }
@@ -1295,6 +1296,7 @@ esp_err_t esp_video_done_m2m_elements(struct esp_video *video, uint32_t src_type
             xSemaphoreGive(stream[0]->ready_sem);
             xSemaphoreGive(stream[1]->ready_sem);
         }
+        esp_video_vfs_notify_done(video);
     }
 
     return ret;
@@ -1610,6 +1612,36 @@ esp_err_t esp_video_get_sensor_format(struct esp_video *video, esp_cam_sensor_fo
     return ESP_OK;
 }
 
+/**
+ * @brief Query all formats supported by sensor
+ *
+ * @param video        Video object
+ * @param format_array Sensor format array pointer
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - Others if failed
+ */
+esp_err_t esp_video_query_sensor_format(struct esp_video *video, esp_cam_sensor_format_array_t *format_array)
+{
+    esp_err_t ret;
+
+    CHECK_VIDEO_OBJ(video);
+
+    if (video->ops->query_sensor_format) {
+        ret = video->ops->query_sensor_format(video, format_array);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "video->ops->query_sensor_format=%x", ret);
+            return ret;
+        }
+    } else {
+        ESP_LOGD(TAG, "video->ops->query_sensor_format=NULL");
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    return ESP_OK;
+}
+
 /**
  * @brief Query menu value
  *
@@ -11,6 +11,7 @@
 #include "esp_log.h"
 
 #include "esp_sccb_i2c.h"
+#include "esp_sccb_intf.h"
 #include "esp_cam_sensor_detect.h"
 
 #include "esp_video_init.h"
@@ -34,6 +35,11 @@ typedef struct sccb_mark {
 
 static const char *TAG = "esp_video_init";
 
+#if CONFIG_ESP_VIDEO_ENABLE_MIPI_CSI_VIDEO_DEVICE
+static esp_video_init_sensor_hint_t s_csi_sensor_hint;
+static bool s_csi_sensor_found;
+#endif
+
 #if CONFIG_ESP_VIDEO_ENABLE_ISP_PIPELINE_CONTROLLER
 static const char *s_default_ipa_names[] = {
 #if CONFIG_ESP_IPA_AWB_GRAY_WORLD
@@ -171,6 +177,109 @@ static esp_sccb_io_handle_t create_sccb_device(esp_video_init_sccb_mark_t *mark,
 }
 #endif
 
+#if CONFIG_ESP_VIDEO_ENABLE_MIPI_CSI_VIDEO_DEVICE
+/**
+ * @brief Run one MIPI CSI sensor detect function
+ *
+ * @param mark SCCB initialization make array
+ * @param csi MIPI CSI initialization configuration
+ * @param p Sensor detect function
+ *
+ * @return
+ *      - Camera sensor device on success
+ *      - NULL if the sensor does not answer
+ */
+static esp_cam_sensor_device_t *detect_csi_sensor(esp_video_init_sccb_mark_t *mark,
+                                                  const esp_video_init_csi_config_t *csi,
+                                                  const esp_cam_sensor_detect_fn_t *p)
+{
+    esp_cam_sensor_config_t cfg = {0};
+    esp_cam_sensor_device_t *cam_dev;
+
+    cfg.sccb_handle = create_sccb_device(mark, ESP_CAM_SENSOR_MIPI_CSI, &csi->sccb_config, p->sccb_addr);
+    if (!cfg.sccb_handle) {
+        return NULL;
+    }
+
+    cfg.reset_pin   = csi->reset_pin;
+    cfg.pwdn_pin    = csi->pwdn_pin;
+    cfg.xclk_pin    = -1;
+    cfg.sensor_port = ESP_CAM_SENSOR_MIPI_CSI;
+    cam_dev         = (*(p->detect))((void *)&cfg);
+    if (!cam_dev) {
+        esp_sccb_del_i2c_io(cfg.sccb_handle);
+    }
+
+    return cam_dev;
+}
+
+/**
+ * @brief Detect the MIPI CSI camera sensor and create its video device
+ *
+ * The driver in the sensor hint is tried first, the other drivers are only probed over SCCB when it does not
+ * answer. The first sensor found is used, MIPI CSI has one video device.
+ *
+ * @param mark SCCB initialization make array
+ * @param csi MIPI CSI initialization configuration
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - Others if failed
+ */
+static esp_err_t init_csi_sensor(esp_video_init_sccb_mark_t *mark, const esp_video_init_csi_config_t *csi)
+{
+    esp_err_t ret;
+    esp_cam_sensor_detect_fn_t *start = &__esp_cam_sensor_detect_fn_array_start;
+    size_t count                      = &__esp_cam_sensor_detect_fn_array_end - start;
+    esp_cam_sensor_device_t *cam_dev  = NULL;
+    size_t found_index                = count;
+    size_t hint_index                 = count;
+
+    if (csi->sensor_hint && csi->sensor_hint->detect_index < count &&
+        start[csi->sensor_hint->detect_index].port == ESP_CAM_SENSOR_MIPI_CSI &&
+        start[csi->sensor_hint->detect_index].sccb_addr == csi->sensor_hint->sccb_addr) {
+        hint_index = csi->sensor_hint->detect_index;
+        cam_dev    = detect_csi_sensor(mark, csi, &start[hint_index]);
+        if (cam_dev) {
+            // The driver checked the chip ID, a different PID is another variant the driver supports
+            if (cam_dev->id.pid != csi->sensor_hint->pid) {
+                ESP_LOGW(TAG, "sensor PID 0x%x, hint was 0x%x", cam_dev->id.pid, csi->sensor_hint->pid);
+            }
+            found_index = hint_index;
+        } else {
+            ESP_LOGW(TAG, "hinted sensor at 0x%x not found, probing all", csi->sensor_hint->sccb_addr);
+        }
+    }
+
+    for (size_t i = 0; !cam_dev && i < count; i++) {
+        if (start[i].port != ESP_CAM_SENSOR_MIPI_CSI || i == hint_index) {
+            continue;
+        }
+
+        cam_dev     = detect_csi_sensor(mark, csi, &start[i]);
+        found_index = i;
+    }
+
+    if (!cam_dev) {
+        ESP_LOGE(TAG, "failed to detect MIPI-CSI camera");
+        return ESP_FAIL;
+    }
+
+    ret = esp_video_create_csi_video_device(cam_dev);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "failed to create MIPI-CSI video device");
+        return ret;
+    }
+
+    s_csi_sensor_hint.detect_index = found_index;
+    s_csi_sensor_hint.sccb_addr    = start[found_index].sccb_addr;
+    s_csi_sensor_hint.pid          = cam_dev->id.pid;
+    s_csi_sensor_found             = true;
+    ESP_LOGI(TAG, "MIPI-CSI sensor %s at 0x%x", cam_dev->name, s_csi_sensor_hint.sccb_addr);
+    return ESP_OK;
+}
+#endif
+
 /**
  * @brief Initialize video hardware and software, including I2C, MIPI CSI and so on.
  *
@@ -201,34 +310,17 @@ esp_err_t esp_video_init(const esp_video_init_config_t *config)
     }
 #endif
 
-    for (esp_cam_sensor_detect_fn_t *p = &__esp_cam_sensor_detect_fn_array_start;
-         p < &__esp_cam_sensor_detect_fn_array_end; ++p) {
 #if CONFIG_ESP_VIDEO_ENABLE_MIPI_CSI_VIDEO_DEVICE
-        if (p->port == ESP_CAM_SENSOR_MIPI_CSI && config->csi != NULL) {
-            esp_cam_sensor_config_t cfg;
-            esp_cam_sensor_device_t *cam_dev;
-
-            cfg.sccb_handle =
-                create_sccb_device(sccb_mark, ESP_CAM_SENSOR_MIPI_CSI, &config->csi->sccb_config, p->sccb_addr);
-            if (!cfg.sccb_handle) {
-                return ESP_FAIL;
-            }
-
-            cfg.reset_pin = config->csi->reset_pin, cfg.pwdn_pin = config->csi->pwdn_pin,
-            cam_dev = (*(p->detect))((void *)&cfg);
-            if (!cam_dev) {
-                ESP_LOGE(TAG, "failed to detect MIPI-CSI camera");
-                return ESP_FAIL;
-            }
-
-            ret = esp_video_create_csi_video_device(cam_dev);
-            if (ret != ESP_OK) {
-                ESP_LOGE(TAG, "failed to create MIPI-CSI video device");
-                return ret;
-            }
+    if (config->csi != NULL) {
+        ret = init_csi_sensor(sccb_mark, config->csi);
+        if (ret != ESP_OK) {
+            return ret;
         }
+    }
 #endif
 
+    for (esp_cam_sensor_detect_fn_t *p = &__esp_cam_sensor_detect_fn_array_start;
+         p < &__esp_cam_sensor_detect_fn_array_end; ++p) {
 #if CONFIG_ESP_VIDEO_ENABLE_DVP_VIDEO_DEVICE
         if (p->port == ESP_CAM_SENSOR_DVP && config->dvp != NULL) {
             int dvp_ctlr_id = 0;
@@ -316,3 +408,19 @@ esp_err_t esp_video_init(const esp_video_init_config_t *config)
 
     return ESP_OK;
 }
+
+esp_err_t esp_video_init_get_sensor_hint(esp_video_init_sensor_hint_t *hint)
+{
+    if (hint == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+#if CONFIG_ESP_VIDEO_ENABLE_MIPI_CSI_VIDEO_DEVICE
+    if (s_csi_sensor_found) {
+        *hint = s_csi_sensor_hint;
+        return ESP_OK;
+    }
+#endif
+
+    return ESP_ERR_NOT_FOUND;
+}
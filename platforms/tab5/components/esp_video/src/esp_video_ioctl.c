@@ -170,10 +170,10 @@ static esp_err_t esp_video_ioctl_qbuf(struct esp_video *video, struct v4l2_buffe
     return ret;
 }
 
-static esp_err_t esp_video_ioctl_dqbuf(struct esp_video *video, struct v4l2_buffer *vbuf)
+static esp_err_t esp_video_ioctl_dqbuf(struct esp_video *video, bool nonblock, struct v4l2_buffer *vbuf)
 {
     esp_err_t ret;
-    uint32_t ticks = portMAX_DELAY;
+    uint32_t ticks = nonblock ? 0 : portMAX_DELAY;
     struct esp_video_buffer_info info;
     struct esp_video_buffer_element *element;
 
@@ -188,7 +188,7 @@ static esp_err_t esp_video_ioctl_dqbuf(struct esp_video *video, struct v4l2_buff
 
     element = esp_video_recv_element(video, vbuf->type, ticks);
     if (!element) {
-        return ESP_FAIL;
+        return nonblock ? ESP_ERR_TIMEOUT : ESP_FAIL;
     }
 
     vbuf->flags     = 0;
@@ -233,12 +233,18 @@ static inline esp_err_t esp_video_ioctl_get_sensor_format(struct esp_video *vide
     return esp_video_get_sensor_format(video, format);
 }
 
+static inline esp_err_t esp_video_ioctl_query_sensor_format(struct esp_video *video,
+                                                            esp_cam_sensor_format_array_t *format_array)
+{
+    return esp_video_query_sensor_format(video, format_array);
+}
+
 static inline esp_err_t esp_video_ioctl_query_menu(struct esp_video *video, struct v4l2_querymenu *qmenu)
 {
     return esp_video_query_menu(video, qmenu);
 }
 
-esp_err_t esp_video_ioctl(struct esp_video *video, int cmd, va_list args)
+esp_err_t esp_video_ioctl(struct esp_video *video, bool nonblock, int cmd, va_list args)
 {
     esp_err_t ret = ESP_OK;
     void *arg_ptr;
@@ -255,7 +261,7 @@ esp_err_t esp_video_ioctl(struct esp_video *video, int cmd, va_list args)
             ret = esp_video_ioctl_qbuf(video, (struct v4l2_buffer *)arg_ptr);
             break;
         case VIDIOC_DQBUF:
-            ret = esp_video_ioctl_dqbuf(video, (struct v4l2_buffer *)arg_ptr);
+            ret = esp_video_ioctl_dqbuf(video, nonblock, (struct v4l2_buffer *)arg_ptr);
             break;
         case VIDIOC_QUERYCAP:
             ret = esp_video_ioctl_querycap(video, (struct v4l2_capability *)arg_ptr);
@@ -299,6 +305,9 @@ esp_err_t esp_video_ioctl(struct esp_video *video, int cmd, va_list args)
         case VIDIOC_G_SENSOR_FMT:
             ret = esp_video_ioctl_get_sensor_format(video, (esp_cam_sensor_format_t *)arg_ptr);
             break;
+        case VIDIOC_QUERY_SENSOR_FMT:
+            ret = esp_video_ioctl_query_sensor_format(video, (esp_cam_sensor_format_array_t *)arg_ptr);
+            break;
         case VIDIOC_QUERYMENU:
             ret = esp_video_ioctl_query_menu(video, (struct v4l2_querymenu *)arg_ptr);
             break;
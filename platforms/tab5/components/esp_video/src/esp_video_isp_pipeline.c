@@ -18,12 +18,16 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
 #include "esp_check.h"
 
 #include "linux/videodev2.h"
 #include "esp_video_pipeline_isp.h"
 #include "esp_video_isp_ioctl.h"
+#include "esp_video_ioctl.h"
+#include "esp_video_isp_stats.h"
+#include "esp_video_isp_control.h"
 #include "esp_ipa.h"
 
 #define ISP_METADATA_BUFFER_COUNT 2
@@ -32,6 +36,31 @@
 
 #define UNUSED(x) (void)(x)
 
+#ifndef CONFIG_ESP_VIDEO_ISP_PIPELINE_IPA_DIVISOR
+#define CONFIG_ESP_VIDEO_ISP_PIPELINE_IPA_DIVISOR 1
+#endif
+#ifndef CONFIG_ESP_VIDEO_ISP_PIPELINE_STATS_LOG_INTERVAL
+#define CONFIG_ESP_VIDEO_ISP_PIPELINE_STATS_LOG_INTERVAL 1
+#endif
+#ifndef CONFIG_ESP_VIDEO_ISP_PIPELINE_MODE_CACHE_SIZE
+#define CONFIG_ESP_VIDEO_ISP_PIPELINE_MODE_CACHE_SIZE 0
+#endif
+#ifndef CONFIG_ESP_VIDEO_ISP_PIPELINE_STATS_SUBSCRIBERS
+#define CONFIG_ESP_VIDEO_ISP_PIPELINE_STATS_SUBSCRIBERS 2
+#endif
+
+#define ISP_MODE_CACHE_SIZE       CONFIG_ESP_VIDEO_ISP_PIPELINE_MODE_CACHE_SIZE
+#define ISP_STATS_SUBSCRIBER_NUMS CONFIG_ESP_VIDEO_ISP_PIPELINE_STATS_SUBSCRIBERS
+
+/**
+ * @brief Settings last written in one sensor mode, restored when the sensor comes back to that mode
+ */
+typedef struct esp_video_isp_mode {
+    const void *regs; /*!< Register table of the sensor format, it identifies the mode */
+    uint32_t flags;   /*!< Valid settings, IPA_METADATA_FLAGS_ */
+    esp_ipa_metadata_t settings;
+} esp_video_isp_mode_t;
+
 typedef struct esp_video_isp {
     int isp_fd;
     esp_video_isp_stats_t *isp_stats[ISP_METADATA_BUFFER_COUNT];
@@ -40,10 +69,42 @@ typedef struct esp_video_isp {
 
     esp_ipa_pipeline_handle_t ipa_pipeline;
     esp_ipa_sensor_t sensor;
+
+    uint32_t frame_count;
+    bool converged;        /*!< The last IPA run wrote nothing, IPA runs on every Nth frame only */
+    uint32_t applied_flags; /*!< Settings written at least once, their last values are in applied */
+    esp_ipa_metadata_t applied;
+
+    const void *mode_regs;         /*!< Register table of the sensor format the applied settings belong to */
+    esp_video_isp_manual_t manual; /*!< Settings held by the application, owned by the ISP task */
+#if ISP_MODE_CACHE_SIZE
+    esp_video_isp_mode_t modes[ISP_MODE_CACHE_SIZE];
+    uint32_t mode_next; /*!< Slot replaced when a new mode does not fit */
+#endif
 } esp_video_isp_t;
 
+/**
+ * @brief Application subscribed to the ISP statistics
+ */
+typedef struct esp_video_isp_stats_subscriber {
+    esp_video_isp_stats_cb_t cb; /*!< NULL for a free slot */
+    void *user_data;
+} esp_video_isp_stats_subscriber_t;
+
 static const char *TAG = "ISP";
 
+/* Held while the callbacks run, so an unsubscribe returns only once its callback is done */
+static SemaphoreHandle_t s_stats_mutex;
+static StaticSemaphore_t s_stats_mutex_buffer;
+static esp_video_isp_stats_subscriber_t s_stats_subscribers[ISP_STATS_SUBSCRIBER_NUMS];
+static volatile int s_stats_subscriber_count;
+
+/* Manual settings from the application, the ISP task takes them at its next frame */
+static esp_video_isp_t *s_isp;
+static portMUX_TYPE s_manual_lock = portMUX_INITIALIZER_UNLOCKED;
+static esp_video_isp_manual_t s_manual;
+static volatile bool s_manual_pending;
+
 /**
  * @brief Print ISP statistics data
  *
@@ -481,8 +542,145 @@ static void config_color(esp_video_isp_t *isp, esp_ipa_metadata_t *metadata)
     }
 }
 
+#if CONFIG_ESP_VIDEO_ISP_PIPELINE_SKIP_SMALL_CHANGES
+static bool is_small_change(float value, float applied, int threshold)
+{
+    return fabsf(value - applied) * 1000 <= fabsf(applied) * threshold;
+}
+
+static bool is_small_ccm_change(const esp_ipa_ccm_t *ccm, const esp_ipa_ccm_t *applied)
+{
+    for (int i = 0; i < ISP_CCM_DIMENSION; i++) {
+        for (int j = 0; j < ISP_CCM_DIMENSION; j++) {
+            if (fabsf(ccm->matrix[i][j] - applied->matrix[i][j]) * 1000 > CONFIG_ESP_VIDEO_ISP_PIPELINE_CCM_THRESHOLD) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+#endif
+
+/**
+ * @brief Clear the flags of the settings that would not change what was written last, and remember the others as
+ *        written. Each skipped exposure or gain write saves an SCCB transaction, the gain one also its menu queries.
+ *
+ * @param isp      ISP pipeline
+ * @param metadata IPA output, flags are cleared in place
+ *
+ * @return None
+ */
+static void filter_metadata(esp_video_isp_t *isp, esp_ipa_metadata_t *metadata)
+{
+    esp_ipa_metadata_t *applied = &isp->applied;
+    uint32_t skip               = 0;
+
+#define IS_APPLIED(f) ((metadata->flags & (f)) && (isp->applied_flags & (f)))
+#define IS_SAME(field) (memcmp(&metadata->field, &applied->field, sizeof(metadata->field)) == 0)
+
+#if CONFIG_ESP_VIDEO_ISP_PIPELINE_SKIP_SMALL_CHANGES
+    /* Both gains go in one write, so they are skipped together */
+    uint32_t wb = metadata->flags & (IPA_METADATA_FLAGS_RG | IPA_METADATA_FLAGS_BG);
+    if (wb && (isp->applied_flags & wb) == wb &&
+        (!(wb & IPA_METADATA_FLAGS_RG) ||
+         is_small_change(metadata->red_gain, applied->red_gain, CONFIG_ESP_VIDEO_ISP_PIPELINE_WB_THRESHOLD)) &&
+        (!(wb & IPA_METADATA_FLAGS_BG) ||
+         is_small_change(metadata->blue_gain, applied->blue_gain, CONFIG_ESP_VIDEO_ISP_PIPELINE_WB_THRESHOLD))) {
+        skip |= wb;
+    }
+    if (IS_APPLIED(IPA_METADATA_FLAGS_ET) &&
+        is_small_change(metadata->exposure, applied->exposure, CONFIG_ESP_VIDEO_ISP_PIPELINE_EXPOSURE_THRESHOLD)) {
+        skip |= IPA_METADATA_FLAGS_ET;
+    }
+    if (IS_APPLIED(IPA_METADATA_FLAGS_GN) &&
+        is_small_change(metadata->gain, applied->gain, CONFIG_ESP_VIDEO_ISP_PIPELINE_GAIN_THRESHOLD)) {
+        skip |= IPA_METADATA_FLAGS_GN;
+    }
+    if (IS_APPLIED(IPA_METADATA_FLAGS_CCM) && is_small_ccm_change(&metadata->ccm, &applied->ccm)) {
+        skip |= IPA_METADATA_FLAGS_CCM;
+    }
+    if (IS_APPLIED(IPA_METADATA_FLAGS_BF) && IS_SAME(bf)) {
+        skip |= IPA_METADATA_FLAGS_BF;
+    }
+    if (IS_APPLIED(IPA_METADATA_FLAGS_DM) && IS_SAME(demosaic)) {
+        skip |= IPA_METADATA_FLAGS_DM;
+    }
+    if (IS_APPLIED(IPA_METADATA_FLAGS_SH) && IS_SAME(sharpen)) {
+        skip |= IPA_METADATA_FLAGS_SH;
+    }
+    if (IS_APPLIED(IPA_METADATA_FLAGS_GAMMA) && IS_SAME(gamma)) {
+        skip |= IPA_METADATA_FLAGS_GAMMA;
+    }
+    if (IS_APPLIED(IPA_METADATA_FLAGS_BR) && metadata->brightness == applied->brightness) {
+        skip |= IPA_METADATA_FLAGS_BR;
+    }
+    if (IS_APPLIED(IPA_METADATA_FLAGS_CN) && metadata->contrast == applied->contrast) {
+        skip |= IPA_METADATA_FLAGS_CN;
+    }
+    if (IS_APPLIED(IPA_METADATA_FLAGS_ST) && metadata->saturation == applied->saturation) {
+        skip |= IPA_METADATA_FLAGS_ST;
+    }
+    if (IS_APPLIED(IPA_METADATA_FLAGS_HUE) && metadata->hue == applied->hue) {
+        skip |= IPA_METADATA_FLAGS_HUE;
+    }
+#endif
+
+#undef IS_APPLIED
+#undef IS_SAME
+
+    /* Color temperature is informational, it is never written */
+    metadata->flags &= ~(skip | IPA_METADATA_FLAGS_CT);
+
+    uint32_t flags = metadata->flags;
+    if (flags & IPA_METADATA_FLAGS_RG) {
+        applied->red_gain = metadata->red_gain;
+    }
+    if (flags & IPA_METADATA_FLAGS_BG) {
+        applied->blue_gain = metadata->blue_gain;
+    }
+    if (flags & IPA_METADATA_FLAGS_ET) {
+        applied->exposure = metadata->exposure;
+    }
+    if (flags & IPA_METADATA_FLAGS_GN) {
+        applied->gain = metadata->gain;
+    }
+    if (flags & IPA_METADATA_FLAGS_BF) {
+        applied->bf = metadata->bf;
+    }
+    if (flags & IPA_METADATA_FLAGS_DM) {
+        applied->demosaic = metadata->demosaic;
+    }
+    if (flags & IPA_METADATA_FLAGS_SH) {
+        applied->sharpen = metadata->sharpen;
+    }
+    if (flags & IPA_METADATA_FLAGS_GAMMA) {
+        applied->gamma = metadata->gamma;
+    }
+    if (flags & IPA_METADATA_FLAGS_CCM) {
+        applied->ccm = metadata->ccm;
+    }
+    if (flags & IPA_METADATA_FLAGS_BR) {
+        applied->brightness = metadata->brightness;
+    }
+    if (flags & IPA_METADATA_FLAGS_CN) {
+        applied->contrast = metadata->contrast;
+    }
+    if (flags & IPA_METADATA_FLAGS_ST) {
+        applied->saturation = metadata->saturation;
+    }
+    if (flags & IPA_METADATA_FLAGS_HUE) {
+        applied->hue = metadata->hue;
+    }
+    isp->applied_flags |= flags;
+}
+
 static void config_isp_and_camera(esp_video_isp_t *isp, esp_ipa_metadata_t *metadata)
 {
+    filter_metadata(isp, metadata);
+    if (!metadata->flags) {
+        return;
+    }
+
     config_white_balance(isp, metadata);
     config_exposure_time(isp, metadata);
     config_pixel_gain(isp, metadata);
@@ -494,6 +692,88 @@ static void config_isp_and_camera(esp_video_isp_t *isp, esp_ipa_metadata_t *meta
     config_color(isp, metadata);
 }
 
+/**
+ * @brief IPA output flags of the settings held by the application.
+ *
+ * @param manual ESP_VIDEO_ISP_MANUAL_x
+ *
+ * @return IPA_METADATA_FLAGS_x
+ */
+static uint32_t manual_ipa_flags(uint32_t manual)
+{
+    uint32_t flags = 0;
+
+    if (manual & ESP_VIDEO_ISP_MANUAL_EXPOSURE) {
+        flags |= IPA_METADATA_FLAGS_ET | IPA_METADATA_FLAGS_GN;
+    }
+    if (manual & ESP_VIDEO_ISP_MANUAL_WB) {
+        flags |= IPA_METADATA_FLAGS_RG | IPA_METADATA_FLAGS_BG;
+    }
+    if (manual & ESP_VIDEO_ISP_MANUAL_CCM) {
+        flags |= IPA_METADATA_FLAGS_CCM;
+    }
+    return flags;
+}
+
+/**
+ * @brief Write the held values through the same path as the IPA output, so the applied settings stay in step.
+ *
+ * @param isp ISP pipeline data
+ *
+ * @return None
+ */
+static void config_manual(esp_video_isp_t *isp)
+{
+    const esp_video_isp_manual_t *manual = &isp->manual;
+    esp_ipa_metadata_t metadata;
+
+    metadata.flags = 0;
+    if (manual->flags & ESP_VIDEO_ISP_MANUAL_EXPOSURE) {
+        if (manual->exposure_us) {
+            metadata.exposure = MIN(MAX(manual->exposure_us, isp->sensor.min_exposure), isp->sensor.max_exposure);
+            metadata.flags |= IPA_METADATA_FLAGS_ET;
+        }
+        if (manual->gain > 0) {
+            metadata.gain = MIN(MAX(manual->gain, isp->sensor.min_gain), isp->sensor.max_gain);
+            metadata.flags |= IPA_METADATA_FLAGS_GN;
+        }
+    }
+    if ((manual->flags & ESP_VIDEO_ISP_MANUAL_WB) && manual->red_gain > 0 && manual->blue_gain > 0) {
+        metadata.red_gain  = manual->red_gain;
+        metadata.blue_gain = manual->blue_gain;
+        metadata.flags |= IPA_METADATA_FLAGS_RG | IPA_METADATA_FLAGS_BG;
+    }
+    if ((manual->flags & ESP_VIDEO_ISP_MANUAL_CCM) && manual->has_ccm) {
+        memcpy(metadata.ccm.matrix, manual->ccm, sizeof(metadata.ccm.matrix));
+        metadata.flags |= IPA_METADATA_FLAGS_CCM;
+    }
+
+    config_isp_and_camera(isp, &metadata);
+}
+
+/**
+ * @brief Take the manual settings the application set since the last frame. Settings handed back are picked up
+ *        again by the IPA, it runs on every frame until it has converged.
+ *
+ * @param isp ISP pipeline data
+ *
+ * @return None
+ */
+static void take_manual(esp_video_isp_t *isp)
+{
+    if (!s_manual_pending) {
+        return;
+    }
+
+    portENTER_CRITICAL(&s_manual_lock);
+    isp->manual      = s_manual;
+    s_manual_pending = false;
+    portEXIT_CRITICAL(&s_manual_lock);
+
+    isp->converged = false;
+    config_manual(isp);
+}
+
 static void isp_stats_to_ipa_stats(esp_video_isp_stats_t *isp_stat, esp_ipa_stats_t *ipa_stats)
 {
     ipa_stats->flags = 0;
@@ -541,6 +821,94 @@ static void isp_stats_to_ipa_stats(esp_video_isp_stats_t *isp_stat, esp_ipa_stat
     }
 }
 
+/**
+ * @brief Hand the statistics of one frame to the subscribed applications, they read the buffer in place.
+ *
+ * @param stats ISP statistics buffer, still owned by the pipeline
+ *
+ * @return None
+ */
+static void notify_stats_subscribers(const esp_video_isp_stats_t *stats)
+{
+    if (!s_stats_subscriber_count) {
+        return;
+    }
+
+    xSemaphoreTake(s_stats_mutex, portMAX_DELAY);
+    for (int i = 0; i < ISP_STATS_SUBSCRIBER_NUMS; i++) {
+        if (s_stats_subscribers[i].cb) {
+            s_stats_subscribers[i].cb(stats, s_stats_subscribers[i].user_data);
+        }
+    }
+    xSemaphoreGive(s_stats_mutex);
+}
+
+static esp_err_t reset_sensor_controls(esp_video_isp_t *isp, int fd);
+
+/**
+ * @brief Notice a sensor format switch. The settings of the old mode are kept, the sensor gets its default gain
+ *        and exposure time for the new one and the IPA converges again, starting from the settings last used in
+ *        the new mode when they are cached.
+ *
+ * @param isp ISP pipeline data
+ *
+ * @return None
+ */
+static void check_sensor_mode(esp_video_isp_t *isp)
+{
+    esp_cam_sensor_format_t format;
+
+    if (ioctl(isp->cam_fd, VIDIOC_G_SENSOR_FMT, &format) != 0 || format.regs == isp->mode_regs) {
+        return;
+    }
+    ESP_LOGD(TAG, "sensor mode: %s", format.name);
+
+#if ISP_MODE_CACHE_SIZE
+    esp_video_isp_mode_t *old_mode = NULL;
+    esp_video_isp_mode_t *new_mode = NULL;
+    for (int i = 0; i < ISP_MODE_CACHE_SIZE; i++) {
+        if (isp->mode_regs && isp->modes[i].regs == isp->mode_regs) {
+            old_mode = &isp->modes[i];
+        }
+        if (isp->modes[i].regs == format.regs) {
+            new_mode = &isp->modes[i];
+        }
+    }
+    if (isp->mode_regs && isp->applied_flags) {
+        if (!old_mode) {
+            /* Round robin, the slot of the new mode is kept when there is another one */
+            if (&isp->modes[isp->mode_next] == new_mode && ISP_MODE_CACHE_SIZE > 1) {
+                isp->mode_next = (isp->mode_next + 1) % ISP_MODE_CACHE_SIZE;
+            }
+            old_mode       = &isp->modes[isp->mode_next];
+            isp->mode_next = (isp->mode_next + 1) % ISP_MODE_CACHE_SIZE;
+        }
+        old_mode->regs     = isp->mode_regs;
+        old_mode->flags    = isp->applied_flags;
+        old_mode->settings = isp->applied;
+    }
+#endif
+
+    /* The format switch reloaded the sensor defaults, and the exposure time range follows the frame length */
+    isp->mode_regs     = format.regs;
+    isp->applied_flags = 0;
+    isp->converged     = false;
+    if (reset_sensor_controls(isp, isp->cam_fd) != ESP_OK) {
+        ESP_LOGE(TAG, "failed to reset sensor controls");
+        return;
+    }
+
+#if ISP_MODE_CACHE_SIZE
+    if (new_mode && new_mode->regs == format.regs) {
+        esp_ipa_metadata_t metadata = new_mode->settings;
+
+        metadata.flags = new_mode->flags & ~manual_ipa_flags(isp->manual.flags);
+        config_isp_and_camera(isp, &metadata);
+    }
+#endif
+    config_manual(isp);
+}
+
 static void isp_task(void *p)
 {
     esp_err_t ret;
@@ -557,12 +925,32 @@ static void isp_task(void *p)
             ESP_LOGE(TAG, "failed to receive video frame");
             continue;
         }
-
-        isp_stats_to_ipa_stats(isp->isp_stats[buf.index], &ipa_stats);
+        notify_stats_subscribers(isp->isp_stats[buf.index]);
+        take_manual(isp);
+
+        /* Once converged IPA runs on every Nth frame, the other statistics buffers go straight back to the driver */
+        isp->frame_count++;
+        bool is_ipa_frame = !isp->converged || (isp->frame_count % CONFIG_ESP_VIDEO_ISP_PIPELINE_IPA_DIVISOR) == 0;
+        if (is_ipa_frame) {
+            check_sensor_mode(isp);
+            isp_stats_to_ipa_stats(isp->isp_stats[buf.index], &ipa_stats);
+        }
         if (ioctl(isp->isp_fd, VIDIOC_QBUF, &buf) != 0) {
             ESP_LOGE(TAG, "failed to queue video frame");
         }
-        print_stats_info(&ipa_stats);
+        if (!is_ipa_frame) {
+            continue;
+        }
+        if (isp->manual.flags & ESP_VIDEO_ISP_MANUAL_IPA_OFF) {
+            isp->converged = true;
+            continue;
+        }
+#if LOG_LOCAL_LEVEL >= ESP_LOG_DEBUG
+        if (CONFIG_ESP_VIDEO_ISP_PIPELINE_STATS_LOG_INTERVAL &&
+            (isp->frame_count % CONFIG_ESP_VIDEO_ISP_PIPELINE_STATS_LOG_INTERVAL) == 0) {
+            print_stats_info(&ipa_stats);
+        }
+#endif
 
         metadata.flags = 0;
         ret            = esp_ipa_pipeline_process(isp->ipa_pipeline, &ipa_stats, &isp->sensor, &metadata);
@@ -571,27 +959,34 @@ static void isp_task(void *p)
             continue;
         }
 
+        metadata.flags &= ~manual_ipa_flags(isp->manual.flags);
         config_isp_and_camera(isp, &metadata);
+        isp->converged = metadata.flags == 0;
     }
 
     vTaskDelete(NULL);
 }
 
-static esp_err_t init_cam_dev(const esp_video_isp_config_t *config, esp_video_isp_t *isp)
+/**
+ * @brief Write the default gain and exposure time of the current sensor format and read back their ranges.
+ *
+ * @param isp ISP pipeline data
+ * @param fd  Camera device
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - Others if failed
+ */
+static esp_err_t reset_sensor_controls(esp_video_isp_t *isp, int fd)
 {
-    int fd;
     esp_err_t ret;
     struct v4l2_query_ext_ctrl qctrl;
     struct v4l2_ext_controls controls;
     struct v4l2_ext_control control[1];
 
-    fd = open(config->cam_dev, O_RDWR);
-    ESP_RETURN_ON_FALSE(fd > 0, ESP_ERR_INVALID_ARG, TAG, "failed to open %s", config->cam_dev);
-    print_dev_info(fd);
-
     qctrl.id = V4L2_CID_GAIN;
     ret      = ioctl(fd, VIDIOC_QUERY_EXT_CTRL, &qctrl);
-    ESP_GOTO_ON_FALSE(ret == 0, ESP_ERR_NOT_SUPPORTED, fail_0, TAG, "failed to query gain description");
+    ESP_RETURN_ON_FALSE(ret == 0, ESP_ERR_NOT_SUPPORTED, TAG, "failed to query gain description");
 
     controls.ctrl_class = V4L2_CID_USER_CLASS;
     controls.count      = 1;
@@ -599,7 +994,7 @@ static esp_err_t init_cam_dev(const esp_video_isp_config_t *config, esp_video_is
     control[0].id       = V4L2_CID_GAIN;
     control[0].value    = qctrl.default_value;
     ret                 = ioctl(fd, VIDIOC_S_EXT_CTRLS, &controls);
-    ESP_GOTO_ON_FALSE(ret == 0, ESP_ERR_NOT_SUPPORTED, fail_0, TAG, "failed to set gain");
+    ESP_RETURN_ON_FALSE(ret == 0, ESP_ERR_NOT_SUPPORTED, TAG, "failed to set gain");
 
     isp->sensor.min_gain = 1.0;
     if (qctrl.type == V4L2_CTRL_TYPE_INTEGER) {
@@ -613,17 +1008,17 @@ static esp_err_t init_cam_dev(const esp_video_isp_config_t *config, esp_video_is
         qmenu.id    = V4L2_CID_GAIN;
         qmenu.index = qctrl.minimum;
         ret         = ioctl(fd, VIDIOC_QUERYMENU, &qmenu);
-        ESP_GOTO_ON_FALSE(ret == 0, ESP_ERR_NOT_SUPPORTED, fail_0, TAG, "failed to query gain min menu");
+        ESP_RETURN_ON_FALSE(ret == 0, ESP_ERR_NOT_SUPPORTED, TAG, "failed to query gain min menu");
         min = qmenu.value;
 
         qmenu.index = qctrl.maximum;
         ret         = ioctl(fd, VIDIOC_QUERYMENU, &qmenu);
-        ESP_GOTO_ON_FALSE(ret == 0, ESP_ERR_NOT_SUPPORTED, fail_0, TAG, "failed to query gain max menu");
+        ESP_RETURN_ON_FALSE(ret == 0, ESP_ERR_NOT_SUPPORTED, TAG, "failed to query gain max menu");
         isp->sensor.max_gain = (float)qmenu.value / min;
 
         qmenu.index = control[0].value;
         ret         = ioctl(fd, VIDIOC_QUERYMENU, &qmenu);
-        ESP_GOTO_ON_FALSE(ret == 0, ESP_ERR_NOT_SUPPORTED, fail_0, TAG, "failed to query gain current menu");
+        ESP_RETURN_ON_FALSE(ret == 0, ESP_ERR_NOT_SUPPORTED, TAG, "failed to query gain current menu");
         isp->sensor.cur_gain = (float)qmenu.value / min;
 
         isp->sensor.step_gain = 0.0;
@@ -637,7 +1032,7 @@ static esp_err_t init_cam_dev(const esp_video_isp_config_t *config, esp_video_is
 
     qctrl.id = V4L2_CID_EXPOSURE_ABSOLUTE;
     ret      = ioctl(fd, VIDIOC_QUERY_EXT_CTRL, &qctrl);
-    ESP_GOTO_ON_FALSE(ret == 0, ESP_ERR_NOT_SUPPORTED, fail_0, TAG, "failed to query exposure time description");
+    ESP_RETURN_ON_FALSE(ret == 0, ESP_ERR_NOT_SUPPORTED, TAG, "failed to query exposure time description");
 
     controls.ctrl_class = V4L2_CID_CAMERA_CLASS;
     controls.count      = 1;
@@ -645,7 +1040,7 @@ static esp_err_t init_cam_dev(const esp_video_isp_config_t *config, esp_video_is
     control[0].id       = V4L2_CID_EXPOSURE_ABSOLUTE;
     control[0].value    = qctrl.default_value;
     ret                 = ioctl(fd, VIDIOC_S_EXT_CTRLS, &controls);
-    ESP_GOTO_ON_FALSE(ret == 0, ESP_ERR_NOT_SUPPORTED, fail_0, TAG, "failed to set exposure time");
+    ESP_RETURN_ON_FALSE(ret == 0, ESP_ERR_NOT_SUPPORTED, TAG, "failed to set exposure time");
 
     isp->sensor.min_exposure  = qctrl.minimum * 100;
     isp->sensor.max_exposure  = qctrl.maximum * 100;
@@ -658,6 +1053,24 @@ static esp_err_t init_cam_dev(const esp_video_isp_config_t *config, esp_video_is
     ESP_LOGD(TAG, "  step:    %" PRIu64, qctrl.step);
     ESP_LOGD(TAG, "  current: %" PRIi32, control[0].value);
 
+    return ESP_OK;
+}
+
+static esp_err_t init_cam_dev(const esp_video_isp_config_t *config, esp_video_isp_t *isp)
+{
+    int fd;
+    esp_err_t ret;
+    esp_cam_sensor_format_t format;
+
+    fd = open(config->cam_dev, O_RDWR);
+    ESP_RETURN_ON_FALSE(fd > 0, ESP_ERR_INVALID_ARG, TAG, "failed to open %s", config->cam_dev);
+    print_dev_info(fd);
+
+    ESP_GOTO_ON_ERROR(reset_sensor_controls(isp, fd), fail_0, TAG, "failed to reset sensor controls");
+    if (ioctl(fd, VIDIOC_G_SENSOR_FMT, &format) == 0) {
+        isp->mode_regs = format.regs;
+    }
+
     isp->cam_fd = fd;
 
     return ESP_OK;
@@ -740,9 +1153,13 @@ esp_err_t esp_video_isp_pipeline_init(const esp_video_isp_config_t *config)
         return ESP_ERR_INVALID_ARG;
     }
 
-    isp = malloc(sizeof(esp_video_isp_t));
+    isp = calloc(1, sizeof(esp_video_isp_t));
     ESP_RETURN_ON_FALSE(isp, ESP_ERR_NO_MEM, TAG, "failed to malloc isp");
 
+    if (!s_stats_mutex) {
+        s_stats_mutex = xSemaphoreCreateMutexStatic(&s_stats_mutex_buffer);
+    }
+
     ESP_GOTO_ON_ERROR(esp_ipa_pipeline_create(config->ipa_nums, config->ipa_names, &isp->ipa_pipeline), fail_0, TAG,
                       "failed to create IPA pipeline");
 
@@ -756,6 +1173,7 @@ esp_err_t esp_video_isp_pipeline_init(const esp_video_isp_config_t *config)
 
     ESP_GOTO_ON_FALSE(xTaskCreate(isp_task, "isp_task", ISP_TASK_STACK_SIZE, isp, ISP_TASK_PRIORITY, NULL) == pdPASS,
                       ESP_ERR_NO_MEM, fail_3, TAG, "failed to create ISP task");
+    s_isp = isp;
 
     return ESP_OK;
 
@@ -769,3 +1187,79 @@ fail_0:
     free(isp);
     return ret;
 }
+
+esp_err_t esp_video_isp_stats_subscribe(esp_video_isp_stats_cb_t cb, void *user_data)
+{
+    esp_err_t ret = ESP_ERR_NO_MEM;
+
+    ESP_RETURN_ON_FALSE(cb, ESP_ERR_INVALID_ARG, TAG, "callback is NULL");
+    ESP_RETURN_ON_FALSE(s_stats_mutex, ESP_ERR_INVALID_STATE, TAG, "ISP pipeline is not initialized");
+
+    xSemaphoreTake(s_stats_mutex, portMAX_DELAY);
+    for (int i = 0; i < ISP_STATS_SUBSCRIBER_NUMS; i++) {
+        if (!s_stats_subscribers[i].cb) {
+            s_stats_subscribers[i].cb        = cb;
+            s_stats_subscribers[i].user_data = user_data;
+            s_stats_subscriber_count++;
+            ret = ESP_OK;
+            break;
+        }
+    }
+    xSemaphoreGive(s_stats_mutex);
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "no free statistics subscriber slot");
+    }
+    return ret;
+}
+
+esp_err_t esp_video_isp_stats_unsubscribe(esp_video_isp_stats_cb_t cb, void *user_data)
+{
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    ESP_RETURN_ON_FALSE(s_stats_mutex, ESP_ERR_INVALID_STATE, TAG, "ISP pipeline is not initialized");
+
+    xSemaphoreTake(s_stats_mutex, portMAX_DELAY);
+    for (int i = 0; i < ISP_STATS_SUBSCRIBER_NUMS; i++) {
+        if (s_stats_subscribers[i].cb == cb && s_stats_subscribers[i].user_data == user_data) {
+            s_stats_subscribers[i].cb        = NULL;
+            s_stats_subscribers[i].user_data = NULL;
+            s_stats_subscriber_count--;
+            ret = ESP_OK;
+            break;
+        }
+    }
+    xSemaphoreGive(s_stats_mutex);
+
+    return ret;
+}
+
+esp_err_t esp_video_isp_pipeline_set_manual(const esp_video_isp_manual_t *manual)
+{
+    ESP_RETURN_ON_FALSE(manual, ESP_ERR_INVALID_ARG, TAG, "manual settings are NULL");
+    ESP_RETURN_ON_FALSE(s_isp, ESP_ERR_INVALID_STATE, TAG, "ISP pipeline is not initialized");
+
+    portENTER_CRITICAL(&s_manual_lock);
+    s_manual         = *manual;
+    s_manual_pending = true;
+    portEXIT_CRITICAL(&s_manual_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_video_isp_pipeline_get_state(esp_video_isp_state_t *state)
+{
+    ESP_RETURN_ON_FALSE(state, ESP_ERR_INVALID_ARG, TAG, "state is NULL");
+    ESP_RETURN_ON_FALSE(s_isp, ESP_ERR_INVALID_STATE, TAG, "ISP pipeline is not initialized");
+
+    /* Plain reads of what the ISP task wrote, a field may be one frame newer than another */
+    state->exposure_us     = s_isp->sensor.cur_exposure;
+    state->min_exposure_us = s_isp->sensor.min_exposure;
+    state->max_exposure_us = s_isp->sensor.max_exposure;
+    state->gain            = s_isp->sensor.cur_gain;
+    state->max_gain        = s_isp->sensor.max_gain;
+    state->red_gain        = s_isp->applied.red_gain;
+    state->blue_gain       = s_isp->applied.blue_gain;
+
+    return ESP_OK;
+}
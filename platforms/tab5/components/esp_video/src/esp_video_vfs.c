@@ -51,8 +51,47 @@ static int esp_err_to_errno(esp_err_t err)
     }
 }
 
+/**
+ * Open files of all video devices, the local fd is the index. Each open has its own flags, the device behind it is
+ * shared and counts its opens itself.
+ */
+#define ESP_VIDEO_VFS_FD_MAX 8
+
+struct esp_video_vfs_file {
+    struct esp_video *video; /*!< NULL while the slot is free */
+    bool nonblock;           /*!< Opened with O_NONBLOCK, VIDIOC_DQBUF fails with EAGAIN instead of waiting */
+};
+
+#ifdef CONFIG_VFS_SUPPORT_SELECT
+/**
+ * A select() in progress, one per start_select() call. An fd is only waited on by one select() at a time.
+ */
+struct esp_video_vfs_select {
+    fd_set *readfds; /*!< NULL while the slot is free */
+    fd_set readfds_orig;
+    esp_vfs_select_sem_t sem;
+};
+
+static struct esp_video_vfs_select s_selects[ESP_VIDEO_VFS_FD_MAX];
+#endif
+
+/* Taken from the done paths too, which run in the CSI ISR */
+static portMUX_TYPE s_vfs_lock = portMUX_INITIALIZER_UNLOCKED;
+static struct esp_video_vfs_file s_files[ESP_VIDEO_VFS_FD_MAX];
+
+static struct esp_video_vfs_file *esp_video_vfs_get_file(int fd)
+{
+    if (fd < 0 || fd >= ESP_VIDEO_VFS_FD_MAX || !s_files[fd].video) {
+        errno = EBADF;
+        return NULL;
+    }
+
+    return &s_files[fd];
+}
+
 static int esp_video_vfs_open(void *ctx, const char *path, int flags, int mode)
 {
+    int fd = -1;
     struct esp_video *video = (struct esp_video *)ctx;
 
     /* Open video here to initialize software resource and hardware */
@@ -63,7 +102,24 @@ static int esp_video_vfs_open(void *ctx, const char *path, int flags, int mode)
         return -1;
     }
 
-    return video->id;
+    portENTER_CRITICAL(&s_vfs_lock);
+    for (int i = 0; i < ESP_VIDEO_VFS_FD_MAX; i++) {
+        if (!s_files[i].video) {
+            s_files[i].video    = video;
+            s_files[i].nonblock = (flags & O_NONBLOCK) != 0;
+            fd                  = i;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_vfs_lock);
+
+    if (fd < 0) {
+        esp_video_close(video);
+        errno = ENFILE;
+        return -1;
+    }
+
+    return fd;
 }
 
 static ssize_t esp_video_vfs_write(void *ctx, int fd, const void *data, size_t size)
@@ -106,9 +162,16 @@ static int esp_video_vfs_close(void *ctx, int fd)
 {
     esp_err_t ret;
     struct esp_video *video = (struct esp_video *)ctx;
+    struct esp_video_vfs_file *file = esp_video_vfs_get_file(fd);
 
-    assert(fd >= 0);
     assert(video);
+    if (!file) {
+        return -1;
+    }
+
+    portENTER_CRITICAL(&s_vfs_lock);
+    file->video = NULL;
+    portEXIT_CRITICAL(&s_vfs_lock);
 
     ret = esp_video_close(video);
 
@@ -119,13 +182,20 @@ static int esp_video_vfs_fcntl(void *ctx, int fd, int cmd, int arg)
 {
     int ret;
     struct esp_video *video = (struct esp_video *)ctx;
+    struct esp_video_vfs_file *file = esp_video_vfs_get_file(fd);
 
-    assert(fd >= 0);
     assert(video);
+    if (!file) {
+        return -1;
+    }
 
     switch (cmd) {
         case F_GETFL:
-            ret = O_RDONLY;
+            ret = O_RDONLY | (file->nonblock ? O_NONBLOCK : 0);
+            break;
+        case F_SETFL:
+            file->nonblock = (arg & O_NONBLOCK) != 0;
+            ret            = 0;
             break;
         default:
             ret   = -1;
@@ -150,15 +220,167 @@ static int esp_video_vfs_ioctl(void *ctx, int fd, int cmd, va_list args)
 {
     esp_err_t ret;
     struct esp_video *video = (struct esp_video *)ctx;
+    struct esp_video_vfs_file *file = esp_video_vfs_get_file(fd);
 
-    assert(fd >= 0);
     assert(video);
+    if (!file) {
+        return -1;
+    }
 
-    ret = esp_video_ioctl(video, cmd, args);
+    ret = esp_video_ioctl(video, file->nonblock, cmd, args);
+    if (ret == ESP_ERR_TIMEOUT && cmd == VIDIOC_DQBUF && file->nonblock) {
+        errno = EAGAIN;
+        return -1;
+    }
 
     return esp_err_to_errno(ret);
 }
 
+#ifdef CONFIG_VFS_SUPPORT_SELECT
+/**
+ * The devices are readable while a buffer element is done and not dequeued yet. Each select() gets its own slot,
+ * a select() on an fd that another one already waits on fails.
+ */
+static bool esp_video_vfs_is_readable(struct esp_video *video)
+{
+    struct esp_video_stream *stream = esp_video_get_stream(video, V4L2_BUF_TYPE_VIDEO_CAPTURE);
+
+    return stream && stream->ready_sem && uxSemaphoreGetCount(stream->ready_sem) > 0;
+}
+
+/* Lock s_vfs_lock before calling */
+static bool esp_video_vfs_is_selected(int fd)
+{
+    for (int i = 0; i < ESP_VIDEO_VFS_FD_MAX; i++) {
+        if (s_selects[i].readfds && FD_ISSET(fd, &s_selects[i].readfds_orig)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static esp_err_t esp_video_vfs_start_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds,
+                                            esp_vfs_select_sem_t select_sem, void **end_select_args)
+{
+    bool ready = false;
+    esp_err_t ret = ESP_OK;
+    struct esp_video_vfs_select *slot = NULL;
+
+    nfds = MIN(nfds, ESP_VIDEO_VFS_FD_MAX);
+
+    portENTER_CRITICAL(&s_vfs_lock);
+    for (int fd = 0; fd < nfds; fd++) {
+        if (FD_ISSET(fd, readfds) && esp_video_vfs_is_selected(fd)) {
+            ret = ESP_ERR_INVALID_STATE;
+            break;
+        }
+    }
+    for (int i = 0; ret == ESP_OK && i < ESP_VIDEO_VFS_FD_MAX; i++) {
+        if (!s_selects[i].readfds) {
+            slot = &s_selects[i];
+            break;
+        }
+    }
+    if (ret == ESP_OK && !slot) {
+        ret = ESP_ERR_NO_MEM;
+    }
+    if (ret == ESP_OK) {
+        slot->readfds_orig = *readfds;
+        slot->readfds      = readfds;
+        slot->sem          = select_sem;
+        FD_ZERO(readfds);
+        FD_ZERO(writefds);
+        FD_ZERO(exceptfds);
+    }
+    portEXIT_CRITICAL(&s_vfs_lock);
+
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    /* Buffers done before the call are reported right away */
+
+    for (int fd = 0; fd < nfds; fd++) {
+        if (!FD_ISSET(fd, &slot->readfds_orig)) {
+            continue;
+        }
+
+        struct esp_video *video = s_files[fd].video;
+        if (video && esp_video_vfs_is_readable(video)) {
+            portENTER_CRITICAL(&s_vfs_lock);
+            FD_SET(fd, readfds);
+            portEXIT_CRITICAL(&s_vfs_lock);
+            ready = true;
+        }
+    }
+
+    if (ready) {
+        esp_vfs_select_triggered(select_sem);
+    }
+
+    *end_select_args = slot;
+
+    return ESP_OK;
+}
+
+static esp_err_t esp_video_vfs_end_select(void *end_select_args)
+{
+    struct esp_video_vfs_select *slot = (struct esp_video_vfs_select *)end_select_args;
+
+    portENTER_CRITICAL(&s_vfs_lock);
+    slot->readfds = NULL;
+    FD_ZERO(&slot->readfds_orig);
+    portEXIT_CRITICAL(&s_vfs_lock);
+
+    return ESP_OK;
+}
+
+void IRAM_ATTR esp_video_vfs_notify_done(struct esp_video *video)
+{
+    bool trigger[ESP_VIDEO_VFS_FD_MAX] = {0};
+    esp_vfs_select_sem_t select_sem[ESP_VIDEO_VFS_FD_MAX];
+
+    portENTER_CRITICAL_SAFE(&s_vfs_lock);
+    for (int i = 0; i < ESP_VIDEO_VFS_FD_MAX; i++) {
+        struct esp_video_vfs_select *slot = &s_selects[i];
+
+        if (!slot->readfds) {
+            continue;
+        }
+        for (int fd = 0; fd < ESP_VIDEO_VFS_FD_MAX; fd++) {
+            if (s_files[fd].video == video && FD_ISSET(fd, &slot->readfds_orig)) {
+                FD_SET(fd, slot->readfds);
+                select_sem[i] = slot->sem;
+                trigger[i]    = true;
+            }
+        }
+    }
+    portEXIT_CRITICAL_SAFE(&s_vfs_lock);
+
+    for (int i = 0; i < ESP_VIDEO_VFS_FD_MAX; i++) {
+        if (!trigger[i]) {
+            continue;
+        }
+
+        if (xPortInIsrContext()) {
+            BaseType_t wakeup = pdFALSE;
+
+            esp_vfs_select_triggered_isr(select_sem[i], &wakeup);
+            if (wakeup == pdTRUE) {
+                portYIELD_FROM_ISR();
+            }
+        } else {
+            esp_vfs_select_triggered(select_sem[i]);
+        }
+    }
+}
+#else
+void IRAM_ATTR esp_video_vfs_notify_done(struct esp_video *video)
+{
+}
+#endif
+
 static const esp_vfs_t s_esp_video_vfs = {.flags   = ESP_VFS_FLAG_CONTEXT_PTR,
                                           .open_p  = esp_video_vfs_open,
                                           .close_p = esp_video_vfs_close,
@@ -167,7 +389,12 @@ static const esp_vfs_t s_esp_video_vfs = {.flags   = ESP_VFS_FLAG_CONTEXT_PTR,
                                           .fcntl_p = esp_video_vfs_fcntl,
                                           .fsync_p = esp_video_vfs_fsync,
                                           .fstat_p = esp_video_vfs_fstat,
-                                          .ioctl_p = esp_video_vfs_ioctl};
+                                          .ioctl_p = esp_video_vfs_ioctl,
+#ifdef CONFIG_VFS_SUPPORT_SELECT
+                                          .start_select = esp_video_vfs_start_select,
+                                          .end_select   = esp_video_vfs_end_select,
+#endif
+};
 
 /**
  * @brief Register video device into VFS system.
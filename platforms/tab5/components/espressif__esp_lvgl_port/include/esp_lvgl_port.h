@@ -148,6 +148,22 @@ esp_err_t lvgl_port_resume(void);
  */
 esp_err_t lvgl_port_task_wake(lvgl_port_event_type_t event, void *param);
 
+/**
+ * @brief Callback called by the LVGL task right before and right after lv_timer_handler()
+ *
+ * @param is_begin  true before the handler runs, false after it returned
+ */
+typedef void (*lvgl_port_timer_hook_cb_t)(bool is_begin);
+
+/**
+ * @brief Set the callback around lv_timer_handler(), NULL removes it
+ *
+ * @note The callback runs in the LVGL task with the LVGL mutex taken, keep it short
+ *
+ * @param cb        callback
+ */
+void lvgl_port_set_timer_hook(lvgl_port_timer_hook_cb_t cb);
+
 #ifdef __cplusplus
 }
 #endif
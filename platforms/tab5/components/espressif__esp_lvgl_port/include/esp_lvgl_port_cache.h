@@ -0,0 +1,59 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port glyph cache and LVGL cache statistics
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief LVGL cache statistics structure
+ */
+typedef struct {
+    uint32_t img_hits;      /*!< Image decoder lookups served by the LVGL image cache */
+    uint32_t img_misses;    /*!< Image decoder lookups that had to decode the image */
+    uint32_t glyph_hits;    /*!< Glyph bitmaps served by the glyph cache */
+    uint32_t glyph_misses;  /*!< Glyph bitmaps rendered (and decompressed) by the font driver */
+    uint32_t glyph_used;    /*!< Bytes of PSRAM held by cached glyph bitmaps */
+    uint32_t glyph_entries; /*!< Glyph bitmaps currently cached */
+} lvgl_port_cache_stats_t;
+
+/**
+ * @brief Allocate the glyph cache
+ *
+ * Bitmaps returned by the LVGL built-in font driver (including compressed fonts) are kept in PSRAM, keyed by font
+ * and glyph index, so redrawing the same text does not decompress the same glyphs again.
+ *
+ * @note This function must be called with the LVGL lock held, before any text is drawn.
+ *
+ * @param size PSRAM budget in bytes for glyph bitmaps (0 = glyph cache disabled)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NOT_SUPPORTED     when the LVGL version has no draw buffer glyph interface
+ *      - ESP_ERR_NO_MEM            when the cache table could not be allocated
+ */
+esp_err_t lvgl_port_glyph_cache_init(size_t size);
+
+/**
+ * @brief Read the image cache and glyph cache counters
+ *
+ * @param stats Filled with the counters since boot
+ */
+void lvgl_port_cache_get_stats(lvgl_port_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -87,9 +87,32 @@ typedef struct {
         unsigned int
             avoid_tearing : 1; /*!< 1: Use internal MIPI-DSI buffers as a LVGL draw buffers to avoid tearing effect,
                                   enabling this option requires over two LCD buffers and may reduce the frame rate */
+        unsigned int vsync_swap : 1; /*!< 1: With PPA rotation in direct mode, copy each frame into the back MIPI-DSI
+                                        buffer and swap it in on vsync, requires two LCD buffers */
     } flags;
 } lvgl_port_display_dsi_cfg_t;
 
+/**
+ * @brief Vsync statistics of a display presenting frames on vsync
+ */
+typedef struct {
+    uint32_t vsync_count;  /*!< Panel refreshes since the display was added */
+    uint32_t frame_count;  /*!< Frames swapped in */
+    uint32_t missed_count; /*!< Vsyncs passed while a frame was still rendering, each repeats the previous frame */
+} lvgl_port_vsync_stats_t;
+
+/**
+ * @brief Called with every flushed area before it is rotated or sent to the panel
+ *
+ * @param disp     LVGL display
+ * @param area     Flushed area in LVGL coordinates
+ * @param px_map   First pixel of the area, in the display color format
+ * @param stride   Bytes between two rows of px_map
+ * @param user_ctx User context given to lvgl_port_set_flush_tap()
+ */
+typedef void (*lvgl_port_flush_tap_cb_t)(lv_display_t *disp, const lv_area_t *area, const uint8_t *px_map,
+                                         uint32_t stride, void *user_ctx);
+
 /**
  * @brief Add I2C/SPI/I8080 display handling to LVGL
  *
@@ -137,6 +160,177 @@ lv_display_t *lvgl_port_add_disp_rgb(const lvgl_port_display_cfg_t *disp_cfg,
  */
 esp_err_t lvgl_port_remove_disp(lv_display_t *disp);
 
+/**
+ * @brief Get the vsync statistics of a MIPI-DSI display
+ *
+ * @param disp  LVGL display
+ * @param stats Filled with the counters, zeroed when not supported
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NOT_SUPPORTED     when the display presents neither with avoid_tearing nor vsync_swap
+ */
+esp_err_t lvgl_port_get_vsync_stats(lv_display_t *disp, lvgl_port_vsync_stats_t *stats);
+
+/**
+ * @brief Set a callback that sees every flushed area, e.g. to mirror the screen
+ *
+ * @note The callback runs in the LVGL task inside the flush and delays it, keep it short.
+ *       Take the LVGL port lock around this call.
+ *
+ * @param disp     LVGL display
+ * @param cb       Callback, NULL removes it
+ * @param user_ctx Passed to the callback
+ * @return
+ *      - ESP_OK                    on success
+ */
+esp_err_t lvgl_port_set_flush_tap(lv_display_t *disp, lvgl_port_flush_tap_cb_t cb, void *user_ctx);
+
+/**
+ * @brief Set a video plane, a frame the PPA rotates straight into the DPI frame buffer under the LVGL frame
+ *
+ * Every frame first gets the plane copied into its area, then the areas LVGL rendered on top. LVGL does not have to
+ * compose the plane itself: invalidating only what is drawn over it is enough when a new frame is set. The flush tap
+ * sees the plane at the start of every frame.
+ *
+ * @note Only for vsync swap with PPA rotation in direct mode. Call from the LVGL task or with the LVGL port lock
+ *       taken, the buffer must stay valid until it is replaced or removed.
+ *
+ * @param disp   LVGL display
+ * @param buffer Frame in the display color format, as wide and high as area with no padding. NULL removes the plane
+ * @param area   Area of the plane in LVGL coordinates, inside the screen
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       when the area is not on the screen
+ *      - ESP_ERR_NOT_SUPPORTED     when the display does not present with vsync swap
+ */
+esp_err_t lvgl_port_set_video_plane(lv_display_t *disp, const void *buffer, const lv_area_t *area);
+
+/**
+ * @brief Set the image of the cursor overlay, a pointer the PPA blends into the DPI frame buffer on top of the frame
+ *
+ * The cursor is not an LVGL object, so moving it invalidates nothing and renders nothing. A move recomposes only the
+ * area the cursor leaves, copied again from the last rendered frame, and blends the cursor at its new place. The
+ * flush tap does not see the cursor.
+ *
+ * @note Only for vsync swap with PPA rotation in direct mode, without byte swapping. The image is converted and
+ *       rotated once, set it again after a rotation change. Call from the LVGL task or with the LVGL port lock taken.
+ *
+ * @param disp LVGL display
+ * @param img  RGB565A8 or ARGB8888 image, NULL removes the cursor
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       when the image format is not supported
+ *      - ESP_ERR_NO_MEM            when the converted image could not be allocated
+ *      - ESP_ERR_NOT_SUPPORTED     when the display does not present with vsync swap
+ */
+esp_err_t lvgl_port_set_cursor(lv_display_t *disp, const lv_image_dsc_t *img);
+
+/**
+ * @brief Move the cursor overlay, its top left corner goes to x, y in LVGL coordinates
+ *
+ * @note A move is shown with the next vsync. Moves while a frame waits for its vsync are merged into one. Call from
+ *       the LVGL task or with the LVGL port lock taken.
+ *
+ * @param disp    LVGL display
+ * @param x       Left edge, the cursor may reach past the screen edges
+ * @param y       Top edge
+ * @param visible false hides the cursor
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     when no cursor image is set
+ */
+esp_err_t lvgl_port_move_cursor(lv_display_t *disp, int32_t x, int32_t y, bool visible);
+
+/**
+ * @brief Blend one color by an alpha mask straight into the frame buffers, without LVGL rendering anything
+ *
+ * For ink and other strokes that must show before a render could. The mask goes into LVGL's draw buffer and into
+ * both DPI frame buffers, the one being scanned out included, so it is on the panel from the next lines scanned and
+ * stays through the following swaps. LVGL does not know about it: whatever it renders over the area later replaces
+ * it, so the app draws the same pixels into its own objects and invalidates them once it is done. Blocks of at least
+ * 1024 pixels are blended by the PPA, smaller ones on the CPU.
+ *
+ * @note Only for vsync swap with PPA rotation in direct mode, RGB565 without byte swapping. Call from the LVGL task,
+ *       e.g. an input device read callback, or with the LVGL port lock taken, never while a frame is rendered.
+ *
+ * @param disp  LVGL display
+ * @param area  Area of the mask in LVGL coordinates, the part outside the screen is skipped
+ * @param mask  Alpha per pixel, as wide and high as area with no padding
+ * @param color Color blended in
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NO_MEM            when the rotated mask could not be allocated
+ *      - ESP_ERR_NOT_SUPPORTED     when the display does not present with vsync swap
+ */
+esp_err_t lvgl_port_blend_front(lv_display_t *disp, const lv_area_t *area, const lv_opa_t *mask, lv_color_t color);
+
+/**
+ * @brief Blend one color by an alpha mask into an RGB565 block on the CPU, the way lvgl_port_blend_front() does
+ *
+ * @param dst         Top left pixel of the block
+ * @param dst_stride  Block row length in pixels
+ * @param mask        Alpha of the top left pixel
+ * @param mask_stride Mask row length in bytes
+ * @param w           Block width
+ * @param h           Block height
+ * @param color       RGB565 color blended in
+ */
+void lvgl_port_blend_mask_rgb565(uint16_t *dst, uint32_t dst_stride, const lv_opa_t *mask, uint32_t mask_stride,
+                                 uint32_t w, uint32_t h, uint16_t color);
+
+/**
+ * @brief Get the DPI frame buffer holding the last presented frame, in panel orientation and the display color format
+ *
+ * With vsync swap it is the newest complete frame, on screen already or from the next vsync, with the video plane and
+ * the cursor in it. With a single frame buffer the PPA may still be writing the areas of a frame being flushed.
+ *
+ * @note Only for PPA rotation into the DPI frame buffer. Call with the LVGL port lock taken and keep it while reading,
+ *       a later frame writes the buffer again.
+ *
+ * @param disp   LVGL display
+ * @param buffer Set to the frame buffer, at the physical resolution of the display
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NOT_SUPPORTED     when the frames are not rotated into a DPI frame buffer
+ */
+esp_err_t lvgl_port_get_front_buffer(lv_display_t *disp, const void **buffer);
+
+/**
+ * @brief Rotate small frames on the CPU instead of the PPA, for while the camera keeps the PPA busy
+ *
+ * A frame whose areas, with the video plane, add up to at most max_pixels is rotated into the DPI frame buffer by the
+ * CPU. A frame the PPA takes no transaction of falls back to the CPU as well. The whole frame goes one way, a CPU
+ * write must not be overtaken by a PPA transaction still queued under it.
+ *
+ * @note Only for PPA rotation into the DPI frame buffer, RGB565 without byte swapping. Call from the LVGL task or with
+ *       the LVGL port lock taken.
+ *
+ * @param disp       LVGL display
+ * @param max_pixels Largest frame rotated on the CPU, 0 leaves every frame to the PPA
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NOT_SUPPORTED     when the frames are not rotated into a DPI frame buffer
+ */
+esp_err_t lvgl_port_set_cpu_rotate(lv_display_t *disp, uint32_t max_pixels);
+
+/**
+ * @brief Rotate an RGB565 block on the CPU, the way the screen is rotated onto the panel
+ *
+ * The block is walked in 32x32 pixel tiles, so the column-wise side of the copy stays in a few cache lines instead of
+ * touching a new PSRAM line for every pixel. With 4 byte aligned buffers and even sizes and strides, 2x2 pixel blocks
+ * are moved as two 32-bit words.
+ *
+ * @param src        Top left pixel of the block
+ * @param src_stride Source row length in pixels
+ * @param dst        Top left pixel of the rotated block
+ * @param dst_stride Destination row length in pixels
+ * @param w          Block width before the rotation
+ * @param h          Block height before the rotation
+ * @param rotation   Display rotation, the pixels land where lv_display_rotate_area puts them
+ */
+void lvgl_port_rotate_rgb565(const uint16_t *src, uint32_t src_stride, uint16_t *dst, uint32_t dst_stride, uint32_t w,
+                             uint32_t h, lv_display_rotation_t rotation);
+
 #ifdef __cplusplus
 }
 #endif
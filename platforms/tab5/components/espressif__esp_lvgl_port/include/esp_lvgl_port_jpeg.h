@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port hardware JPEG image decoder
+ */
+
+#pragma once
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Register the hardware JPEG decoder as an LVGL image decoder
+ *
+ * Image sources that are file paths ending in .jpg or .jpeg (e.g. "S:/sd/photo.jpg" with the LVGL stdio file system)
+ * are read in large chunks into a DMA buffer and decoded by the JPEG codec straight into an RGB565 draw buffer. The
+ * decoded image goes to the LVGL image cache like the built-in decoders. Progressive JPEGs are left to the other
+ * decoders.
+ *
+ * @note This function must be called after lvgl_port_init(), with the LVGL lock held.
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NOT_SUPPORTED     when the target has no JPEG codec or LVGL is older than v9.2
+ *      - ESP_ERR_NO_MEM            when the decoder could not be created
+ */
+esp_err_t lvgl_port_jpeg_decoder_init(void);
+
+#ifdef __cplusplus
+}
+#endif
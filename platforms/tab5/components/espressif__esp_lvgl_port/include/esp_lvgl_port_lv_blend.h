@@ -38,10 +38,47 @@ extern "C" {
 #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565(dsc) _lv_rgb565_blend_normal_to_rgb565_esp(dsc)
 #endif
 
+#if CONFIG_IDF_TARGET_ESP32P4
+/* Opacity and mask kernels, only the ESP32P4 has them */
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc) _lv_color_blend_to_rgb565_with_opa_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc) _lv_color_blend_to_rgb565_with_mask_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc) _lv_rgb565_blend_normal_to_rgb565_with_opa_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc) _lv_rgb565_blend_normal_to_rgb565_with_mask_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565(dsc) _lv_argb8888_blend_normal_to_rgb565_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc) _lv_argb8888_blend_normal_to_rgb565_with_opa_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc) _lv_argb8888_blend_normal_to_rgb565_with_mask_esp(dsc)
+#endif
+#endif  // CONFIG_IDF_TARGET_ESP32P4
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR >= 2
+/* LVGL v9.2 dropped the leading underscore of the blend descriptors */
+typedef lv_draw_sw_blend_fill_dsc_t _lv_draw_sw_blend_fill_dsc_t;
+typedef lv_draw_sw_blend_image_dsc_t _lv_draw_sw_blend_image_dsc_t;
+#endif
+
 typedef struct {
     uint32_t opa;
     void *dst_buf;
@@ -120,6 +157,139 @@ static inline lv_result_t _lv_rgb565_blend_normal_to_rgb565_esp(_lv_draw_sw_blen
     return lv_rgb565_blend_normal_to_rgb565_esp(&asm_dsc);
 }
 
+#if CONFIG_IDF_TARGET_ESP32P4
+
+/* The mix kernels read and write whole pixels, buffers off the pixel alignment stay on LVGL's C path */
+static inline bool _lv_esp_is_aligned(const void *buf, uint32_t stride, uint32_t align)
+{
+    return (((uintptr_t)buf | stride) & (align - 1)) == 0;
+}
+
+extern int lv_color_blend_to_rgb565_with_opa_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_color_blend_to_rgb565_with_opa_esp(_lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    if (!_lv_esp_is_aligned(dsc->dest_buf, dsc->dest_stride, 2)) {
+        return LV_RESULT_INVALID;
+    }
+    asm_dsc_t asm_dsc = {
+        .opa        = dsc->opa,
+        .dst_buf    = dsc->dest_buf,
+        .dst_w      = dsc->dest_w,
+        .dst_h      = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf    = &dsc->color,
+    };
+
+    return lv_color_blend_to_rgb565_with_opa_esp(&asm_dsc);
+}
+
+extern int lv_color_blend_to_rgb565_with_mask_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_color_blend_to_rgb565_with_mask_esp(_lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    if (!_lv_esp_is_aligned(dsc->dest_buf, dsc->dest_stride, 2)) {
+        return LV_RESULT_INVALID;
+    }
+    asm_dsc_t asm_dsc = {
+        .dst_buf     = dsc->dest_buf,
+        .dst_w       = dsc->dest_w,
+        .dst_h       = dsc->dest_h,
+        .dst_stride  = dsc->dest_stride,
+        .src_buf     = &dsc->color,
+        .mask_buf    = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+    };
+
+    return lv_color_blend_to_rgb565_with_mask_esp(&asm_dsc);
+}
+
+extern int lv_rgb565_blend_normal_to_rgb565_with_opa_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_rgb565_blend_normal_to_rgb565_with_opa_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    if (!_lv_esp_is_aligned(dsc->dest_buf, dsc->dest_stride, 2) ||
+            !_lv_esp_is_aligned(dsc->src_buf, dsc->src_stride, 2)) {
+        return LV_RESULT_INVALID;
+    }
+    asm_dsc_t asm_dsc = {
+        .opa        = dsc->opa,
+        .dst_buf    = dsc->dest_buf,
+        .dst_w      = dsc->dest_w,
+        .dst_h      = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf    = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+    };
+
+    return lv_rgb565_blend_normal_to_rgb565_with_opa_esp(&asm_dsc);
+}
+
+extern int lv_rgb565_blend_normal_to_rgb565_with_mask_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_rgb565_blend_normal_to_rgb565_with_mask_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    if (!_lv_esp_is_aligned(dsc->dest_buf, dsc->dest_stride, 2) ||
+            !_lv_esp_is_aligned(dsc->src_buf, dsc->src_stride, 2)) {
+        return LV_RESULT_INVALID;
+    }
+    asm_dsc_t asm_dsc = {
+        .dst_buf     = dsc->dest_buf,
+        .dst_w       = dsc->dest_w,
+        .dst_h       = dsc->dest_h,
+        .dst_stride  = dsc->dest_stride,
+        .src_buf     = dsc->src_buf,
+        .src_stride  = dsc->src_stride,
+        .mask_buf    = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+    };
+
+    return lv_rgb565_blend_normal_to_rgb565_with_mask_esp(&asm_dsc);
+}
+
+extern int lv_argb8888_blend_normal_to_rgb565_esp(asm_dsc_t *asm_dsc);
+extern int lv_argb8888_blend_normal_to_rgb565_with_opa_esp(asm_dsc_t *asm_dsc);
+extern int lv_argb8888_blend_normal_to_rgb565_with_mask_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_argb8888_blend_normal_to_rgb565_call(_lv_draw_sw_blend_image_dsc_t *dsc,
+                                                                   int (*kernel)(asm_dsc_t *))
+{
+    if (!_lv_esp_is_aligned(dsc->dest_buf, dsc->dest_stride, 2) ||
+            !_lv_esp_is_aligned(dsc->src_buf, dsc->src_stride, 4)) {
+        return LV_RESULT_INVALID;
+    }
+    asm_dsc_t asm_dsc = {
+        .opa         = dsc->opa,
+        .dst_buf     = dsc->dest_buf,
+        .dst_w       = dsc->dest_w,
+        .dst_h       = dsc->dest_h,
+        .dst_stride  = dsc->dest_stride,
+        .src_buf     = dsc->src_buf,
+        .src_stride  = dsc->src_stride,
+        .mask_buf    = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+    };
+
+    return kernel(&asm_dsc);
+}
+
+static inline lv_result_t _lv_argb8888_blend_normal_to_rgb565_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    return _lv_argb8888_blend_normal_to_rgb565_call(dsc, lv_argb8888_blend_normal_to_rgb565_esp);
+}
+
+static inline lv_result_t _lv_argb8888_blend_normal_to_rgb565_with_opa_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    return _lv_argb8888_blend_normal_to_rgb565_call(dsc, lv_argb8888_blend_normal_to_rgb565_with_opa_esp);
+}
+
+static inline lv_result_t _lv_argb8888_blend_normal_to_rgb565_with_mask_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    return _lv_argb8888_blend_normal_to_rgb565_call(dsc, lv_argb8888_blend_normal_to_rgb565_with_mask_esp);
+}
+
+#endif  // CONFIG_IDF_TARGET_ESP32P4
+
 #endif  // CONFIG_LV_DRAW_SW_ASM_CUSTOM
 
 #ifdef __cplusplus
@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port memory allocator and layer buffer pool
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief LVGL allocator statistics structure
+ */
+typedef struct {
+    uint32_t internal_used;  /*!< Bytes of internal SRAM held by LVGL */
+    uint32_t internal_peak;  /*!< Highest internal_used since boot */
+    uint32_t internal_cnt;   /*!< LVGL allocations in internal SRAM */
+    uint32_t psram_used;     /*!< Bytes of PSRAM held by LVGL */
+    uint32_t psram_peak;     /*!< Highest psram_used since boot */
+    uint32_t psram_cnt;      /*!< LVGL allocations in PSRAM */
+    uint32_t fallbacks;      /*!< Small allocations sent to PSRAM because the internal budget was used up */
+    uint32_t failures;       /*!< Allocations that failed in both memories */
+    uint32_t layer_bufs;     /*!< Layer pool buffers in internal SRAM */
+    uint32_t layer_hits;     /*!< Layer buffers served by the pool */
+    uint32_t layer_misses;   /*!< Layer buffers that fit a slot but found the pool in use */
+} lvgl_port_mem_stats_t;
+
+/**
+ * @brief Keep a few layer buffers in internal SRAM
+ *
+ * Simple layers (opa_layered, blend modes, masks) are rendered in strips of LV_DRAW_LAYER_SIMPLE_BUF_SIZE, each strip
+ * allocating and freeing its buffer. Strips that fit a slot are served from the pool instead of the heap, and are
+ * read back from internal SRAM instead of PSRAM when blended.
+ *
+ * @note This function must be called with the LVGL lock held, before anything is drawn.
+ *
+ * @param buf_size Size of each buffer in bytes (0 = layer pool disabled)
+ * @param buf_cnt Number of buffers, one per draw unit is enough. As many as fit are allocated
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NOT_SUPPORTED     when the LVGL version has no draw buffer handlers
+ *      - ESP_ERR_NO_MEM            when not a single buffer could be allocated
+ */
+esp_err_t lvgl_port_layer_pool_init(size_t buf_size, uint32_t buf_cnt);
+
+/**
+ * @brief Read the LVGL allocator counters
+ *
+ * Allocations of up to BSP_DISPLAY_LVGL_MEM_INTERNAL_MAX_SIZE bytes (objects, styles, event lists) go to internal
+ * SRAM while the internal budget lasts, everything larger (draw buffers, layers, decoded images) goes to PSRAM.
+ *
+ * @note The allocator is only built with CONFIG_LV_USE_CUSTOM_MALLOC, only the layer pool counters are kept otherwise.
+ *
+ * @param stats Filled with the current counters
+ * @return true if the port allocator is in use
+ */
+bool lvgl_port_mem_get_stats(lvgl_port_mem_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,47 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port PPA draw unit
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Configuration PPA draw unit structure
+ */
+typedef struct {
+    uint32_t min_area;       /*!< Smallest draw area in pixels worth a PPA transaction, smaller tasks stay on SW */
+    uint32_t img_cache_size; /*!< PSRAM budget in bytes for copies of flash resident images (0 = flash images on SW) */
+} lvgl_port_ppa_draw_cfg_t;
+
+/**
+ * @brief Register the PPA as an LVGL draw unit next to the SW renderer
+ *
+ * Opaque rectangle fills, image blits (with opacity, ARGB8888 alpha and A8 recolor) and scaled opaque images are
+ * rendered by the PPA fill, blend and SRM engines. Everything else is left to the SW renderer.
+ *
+ * @note This function must be called after lvgl_port_init(), with the LVGL lock held.
+ *
+ * @param cfg Draw unit configuration
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NOT_SUPPORTED     when LVGL or the target can not support the draw unit
+ *      - ESP_ERR_NO_MEM            when PPA clients could not be registered
+ */
+esp_err_t lvgl_port_ppa_draw_init(const lvgl_port_ppa_draw_cfg_t *cfg);
+
+#ifdef __cplusplus
+}
+#endif
@@ -29,6 +29,7 @@ typedef enum {
  */
 typedef struct {
     unsigned int avoid_tearing : 1; /*!< Use internal RGB buffers as a LVGL draw buffers to avoid tearing effect */
+    unsigned int ppa_rotate : 1;    /*!< Rotate with the PPA straight into the DPI frame buffer, no rotation buffer */
 } lvgl_port_disp_priv_cfg_t;
 
 /**
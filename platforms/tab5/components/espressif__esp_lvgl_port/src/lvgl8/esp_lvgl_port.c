@@ -33,6 +33,7 @@ typedef struct lvgl_port_ctx_s {
     bool running;
     int task_max_sleep_ms;
     int timer_period_ms;
+    lvgl_port_timer_hook_cb_t timer_hook;
 } lvgl_port_ctx_t;
 
 /*******************************************************************************
@@ -159,6 +160,11 @@ void lvgl_port_unlock(void)
     xSemaphoreGiveRecursive(lvgl_port_ctx.lvgl_mux);
 }
 
+void lvgl_port_set_timer_hook(lvgl_port_timer_hook_cb_t cb)
+{
+    lvgl_port_ctx.timer_hook = cb;
+}
+
 esp_err_t lvgl_port_task_wake(lvgl_port_event_type_t event, void *param)
 {
     ESP_LOGE(TAG, "Task wake is not supported, when used LVGL8!");
@@ -198,7 +204,14 @@ static void lvgl_port_task(void *arg)
     lvgl_port_ctx.running = true;
     while (lvgl_port_ctx.running) {
         if (lvgl_port_lock(0)) {
+            lvgl_port_timer_hook_cb_t timer_hook = lvgl_port_ctx.timer_hook;
+            if (timer_hook) {
+                timer_hook(true);
+            }
             task_delay_ms = lv_timer_handler();
+            if (timer_hook) {
+                timer_hook(false);
+            }
             lvgl_port_unlock();
         }
         if (task_delay_ms > lvgl_port_ctx.task_max_sleep_ms) {
@@ -0,0 +1,223 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <assert.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_lvgl_port_cache.h"
+#include "lvgl.h"
+
+#if LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR >= 2
+#define LVGL_PORT_GLYPH_CACHE_SUPPORTED 1
+#include "lvgl_private.h"
+#else
+#define LVGL_PORT_GLYPH_CACHE_SUPPORTED 0
+#endif
+
+static const char *TAG = "LVGL";
+
+#if LVGL_PORT_GLYPH_CACHE_SUPPORTED
+
+#define GLYPH_CACHE_SLOT_BYTES 256 /* Average A8 glyph bitmap of the 16..44 px fonts, sizes the slot table */
+#define GLYPH_CACHE_SLOTS_MIN  64
+
+/*******************************************************************************
+ * Types definitions
+ *******************************************************************************/
+
+typedef struct {
+    const lv_font_t *font; /* Fonts are compiled in, the pointer is a stable key */
+    uint32_t gid;
+    uint32_t stride;
+    uint32_t size;
+    uint8_t *data;
+} glyph_cache_entry_t;
+
+typedef struct {
+    glyph_cache_entry_t *slots;
+    uint32_t slot_mask;
+    size_t budget;
+    size_t used;
+    uint32_t entries;
+    SemaphoreHandle_t mutex; /* Both SW draw units render text */
+} glyph_cache_t;
+
+/*******************************************************************************
+ * Local variables
+ *******************************************************************************/
+
+static glyph_cache_t glyph_cache;
+static uint32_t img_hits;
+static uint32_t img_misses;
+static uint32_t glyph_hits;
+static uint32_t glyph_misses;
+
+/*******************************************************************************
+ * Function definitions
+ *******************************************************************************/
+
+/* Linked with -Wl,--wrap, see CMakeLists.txt */
+const void *__real_lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t *g_dsc, lv_draw_buf_t *draw_buf);
+const void *__wrap_lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t *g_dsc, lv_draw_buf_t *draw_buf);
+lv_cache_entry_t *__real_lv_cache_acquire(lv_cache_t *cache, const void *key, void *user_data);
+lv_cache_entry_t *__wrap_lv_cache_acquire(lv_cache_t *cache, const void *key, void *user_data);
+
+static inline uint32_t glyph_cache_slot(const lv_font_t *font, uint32_t gid)
+{
+    uint32_t h = ((uint32_t)(uintptr_t)font >> 2) * 2654435761u;
+    h ^= gid * 40503u;
+    return (h ^ (h >> 15)) & glyph_cache.slot_mask;
+}
+
+static void glyph_cache_entry_free(glyph_cache_entry_t *entry)
+{
+    if (entry->data) {
+        free(entry->data);
+        glyph_cache.used -= entry->size;
+        glyph_cache.entries--;
+    }
+    memset(entry, 0, sizeof(glyph_cache_entry_t));
+}
+
+/*******************************************************************************
+ * Public API functions
+ *******************************************************************************/
+
+esp_err_t lvgl_port_glyph_cache_init(size_t size)
+{
+    if (size == 0 || glyph_cache.slots) {
+        return ESP_OK;
+    }
+
+    uint32_t slots = GLYPH_CACHE_SLOTS_MIN;
+    while (slots < size / GLYPH_CACHE_SLOT_BYTES) {
+        slots <<= 1;
+    }
+
+    glyph_cache.mutex = xSemaphoreCreateMutex();
+    ESP_RETURN_ON_FALSE(glyph_cache.mutex, ESP_ERR_NO_MEM, TAG, "Not enough memory for glyph cache mutex!");
+    glyph_cache.slots = heap_caps_calloc(slots, sizeof(glyph_cache_entry_t), MALLOC_CAP_SPIRAM);
+    if (glyph_cache.slots == NULL) {
+        vSemaphoreDelete(glyph_cache.mutex);
+        glyph_cache.mutex = NULL;
+        ESP_LOGE(TAG, "Not enough memory for glyph cache table!");
+        return ESP_ERR_NO_MEM;
+    }
+    glyph_cache.slot_mask = slots - 1;
+    glyph_cache.budget    = size;
+
+    ESP_LOGI(TAG, "Glyph cache: %u slots, %u KB", (unsigned)slots, (unsigned)(size / 1024));
+    return ESP_OK;
+}
+
+void lvgl_port_cache_get_stats(lvgl_port_cache_stats_t *stats)
+{
+    assert(stats);
+    stats->img_hits     = __atomic_load_n(&img_hits, __ATOMIC_RELAXED);
+    stats->img_misses   = __atomic_load_n(&img_misses, __ATOMIC_RELAXED);
+    stats->glyph_hits   = __atomic_load_n(&glyph_hits, __ATOMIC_RELAXED);
+    stats->glyph_misses = __atomic_load_n(&glyph_misses, __ATOMIC_RELAXED);
+
+    stats->glyph_used    = 0;
+    stats->glyph_entries = 0;
+    if (glyph_cache.mutex) {
+        xSemaphoreTake(glyph_cache.mutex, portMAX_DELAY);
+        stats->glyph_used    = glyph_cache.used;
+        stats->glyph_entries = glyph_cache.entries;
+        xSemaphoreGive(glyph_cache.mutex);
+    }
+}
+
+/*******************************************************************************
+ * Wrapped LVGL functions
+ *******************************************************************************/
+
+const void *__wrap_lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t *g_dsc, lv_draw_buf_t *draw_buf)
+{
+    if (glyph_cache.slots == NULL || draw_buf == NULL || g_dsc->resolved_font == NULL) {
+        return __real_lv_font_get_bitmap_fmt_txt(g_dsc, draw_buf);
+    }
+
+    const lv_font_t *font = g_dsc->resolved_font;
+    const uint32_t gid    = g_dsc->gid.index;
+    const uint32_t stride = draw_buf->header.stride;
+    const uint32_t size   = stride * g_dsc->box_h;
+    glyph_cache_entry_t *entry = &glyph_cache.slots[glyph_cache_slot(font, gid)];
+
+    xSemaphoreTake(glyph_cache.mutex, portMAX_DELAY);
+    if (entry->data && entry->font == font && entry->gid == gid && entry->stride == stride && entry->size == size) {
+        memcpy(draw_buf->data, entry->data, size);
+        xSemaphoreGive(glyph_cache.mutex);
+        __atomic_add_fetch(&glyph_hits, 1, __ATOMIC_RELAXED);
+        return draw_buf;
+    }
+    xSemaphoreGive(glyph_cache.mutex);
+
+    const void *bitmap = __real_lv_font_get_bitmap_fmt_txt(g_dsc, draw_buf);
+    __atomic_add_fetch(&glyph_misses, 1, __ATOMIC_RELAXED);
+
+    /* Only bitmaps rendered into the draw buffer are worth caching, anything else points to font data already */
+    if (bitmap != draw_buf || size == 0 || size > glyph_cache.budget) {
+        return bitmap;
+    }
+
+    uint8_t *copy = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+    if (copy == NULL) {
+        return bitmap;
+    }
+    memcpy(copy, draw_buf->data, size);
+
+    xSemaphoreTake(glyph_cache.mutex, portMAX_DELAY);
+    /* Direct mapped, the new glyph evicts whatever shares its slot */
+    glyph_cache_entry_free(entry);
+    if (glyph_cache.used + size <= glyph_cache.budget) {
+        entry->font   = font;
+        entry->gid    = gid;
+        entry->stride = stride;
+        entry->size   = size;
+        entry->data   = copy;
+        glyph_cache.used += size;
+        glyph_cache.entries++;
+        copy = NULL;
+    }
+    xSemaphoreGive(glyph_cache.mutex);
+
+    free(copy);
+    return bitmap;
+}
+
+lv_cache_entry_t *__wrap_lv_cache_acquire(lv_cache_t *cache, const void *key, void *user_data)
+{
+    lv_cache_entry_t *entry = __real_lv_cache_acquire(cache, key, user_data);
+    if (cache != NULL && cache == img_cache_p) {
+        __atomic_add_fetch(entry ? &img_hits : &img_misses, 1, __ATOMIC_RELAXED);
+    }
+    return entry;
+}
+
+#else
+
+esp_err_t lvgl_port_glyph_cache_init(size_t size)
+{
+    if (size == 0) {
+        return ESP_OK;
+    }
+    ESP_LOGW(TAG, "Glyph cache requires LVGL v9.2 or newer");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+void lvgl_port_cache_get_stats(lvgl_port_cache_stats_t *stats)
+{
+    assert(stats);
+    memset(stats, 0, sizeof(lvgl_port_cache_stats_t));
+}
+
+#endif /* LVGL_PORT_GLYPH_CACHE_SUPPORTED */
@@ -20,13 +20,23 @@
 #include "esp_lvgl_port_priv.h"
 #include "driver/ppa.h"
 #include "esp_heap_caps.h"
+#include "dma_buffer.h"
 #include "esp_private/esp_cache_private.h"
+#include "esp_cache.h"
 
 #define ALIGN_UP_BY(num, align) (((num) + ((align)-1)) & ~((align)-1))
 #define BLOCK_SIZE_SMALL        (32)
 #define BLOCK_SIZE_LARGE        (256)
-static ppa_client_handle_t ppa_srm_handle = NULL;
-static size_t data_cache_line_size        = 0;
+#define DIRTY_RECT_MAX          (8) /* Rectangles copied to the panel per frame in direct mode */
+#define SWAP_PENDING_FRAME      (1) /* The swap presents an LVGL frame, its flush is ready on the vsync */
+#define SWAP_PENDING_CURSOR     (2) /* The swap presents a cursor move, LVGL is not flushing */
+#define CURSOR_RETRY_MS         (4) /* A cursor move that found a swap pending is tried again this much later */
+#define ROTATE_TILE             (32) /* Tile edge of the CPU rotation, 64 bytes of RGB565 per tile row */
+#define FRONT_BLEND_PPA_MIN     (1024) /* Smaller front buffer blends stay on the CPU, the PPA set up costs more */
+static ppa_client_handle_t ppa_srm_handle       = NULL;
+static ppa_client_handle_t ppa_srm_async_handle = NULL; /* Non-blocking rotation into the DPI frame buffer */
+static ppa_client_handle_t ppa_blend_handle     = NULL; /* Cursor overlay and front buffer blends, blocking */
+static size_t data_cache_line_size              = 0;
 
 #if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
 #include "esp_lcd_panel_rgb.h"
@@ -62,13 +72,43 @@ typedef struct {
     uint8_t* oled_buffer;
     lv_display_t* disp_drv; /* LVGL display driver */
     lv_display_rotation_t current_rotation;
-    SemaphoreHandle_t trans_sem; /* Idle transfer mutex */
+    SemaphoreHandle_t trans_sem;           /* Idle transfer mutex */
+    void* ppa_fb;                          /* DPI frame buffer the PPA rotates into */
+    lv_area_t dirty_rects[DIRTY_RECT_MAX]; /* Coalesced areas of the frame being flushed (direct mode) */
+    uint8_t dirty_rect_count;
+    uint8_t ppa_pending; /* PPA transactions left before flush ready */
+    void* ppa_fbs[2];    /* Front and back DPI frame buffers (vsync swap) */
+    uint8_t ppa_back;    /* Index of the frame buffer the PPA writes (vsync swap) */
+    SemaphoreHandle_t ppa_done_sem;             /* Last PPA transaction of the frame finished (vsync swap) */
+    lv_area_t prev_dirty_rects[DIRTY_RECT_MAX]; /* Previous frame's rectangles, not yet in the back buffer */
+    uint8_t prev_dirty_rect_count;
+    uint8_t swap_pending;                  /* A frame buffer swap waits for the next vsync */
+    uint8_t frame_busy;                    /* A frame is being rendered, set from render start to swap request */
+    lvgl_port_vsync_stats_t vsync_stats;   /* Updated from the vsync callback */
+    lvgl_port_flush_tap_cb_t flush_tap;    /* Sees every flushed area */
+    void* flush_tap_ctx;
+    const void* plane_buf;                 /* Video plane, copied into the back frame buffer under every frame */
+    lv_area_t plane_area;
+    void* cursor_buf;           /* Cursor overlay as ARGB8888, rotated to the panel */
+    int32_t cursor_w;           /* Cursor size in LVGL coordinates */
+    int32_t cursor_h;
+    lv_area_t cursor_area;      /* Cursor position in LVGL coordinates, may reach past the screen */
+    lv_area_t cursor_drawn[2];  /* Screen area the cursor is blended into, per DPI frame buffer, empty for none */
+    uint8_t cursor_visible;
+    uint8_t cursor_dirty;       /* Moved since it was last composed */
+    lv_timer_t* cursor_timer;   /* Retries a cursor move that found a swap pending */
+    const uint8_t* last_frame;  /* Draw buffer of the last flushed frame, the whole frame in direct mode */
+    uint32_t cpu_rotate_max_px; /* Frames up to this many pixels are rotated on the CPU, 0 for none */
+    uint8_t* front_mask;        /* Mask of the last front buffer blend, rotated to the panel */
+    size_t front_mask_size;
     struct {
         unsigned int monochrome : 1;   /* True, if display is monochrome and using 1bit for 1px */
         unsigned int swap_bytes : 1;   /* Swap bytes in RGB656 (16-bit) before send to LCD driver */
         unsigned int full_refresh : 1; /* Always make the whole screen redrawn */
         unsigned int direct_mode : 1;  /* Use screen-sized buffers and draw to absolute coordinates */
         unsigned int sw_rotate : 1;    /* Use software rotation (slower) or PPA if available */
+        unsigned int ppa_rotate : 1;   /* Rotate with a non-blocking PPA transaction straight into ppa_fb */
+        unsigned int vsync_swap : 1;   /* PPA into the back frame buffer, swapped in on vsync */
     } flags;
 } lvgl_port_display_ctx_t;
 
@@ -89,12 +129,24 @@ static bool lvgl_port_flush_dpi_panel_ready_callback(esp_lcd_panel_handle_t pane
                                                      esp_lcd_dpi_panel_event_data_t* edata, void* user_ctx);
 static bool lvgl_port_flush_dpi_vsync_ready_callback(esp_lcd_panel_handle_t panel_io,
                                                      esp_lcd_dpi_panel_event_data_t* edata, void* user_ctx);
+static bool lvgl_port_flush_dpi_vsync_swap_callback(esp_lcd_panel_handle_t panel_io,
+                                                    esp_lcd_dpi_panel_event_data_t* edata, void* user_ctx);
+static bool lvgl_port_flush_ppa_ready_callback(ppa_client_handle_t ppa_client, ppa_event_data_t* event_data,
+                                               void* user_data);
+static void lvgl_port_disp_frame_callback(lv_event_t* e);
 #endif
 #endif
 static void lvgl_port_flush_callback(lv_display_t* drv, const lv_area_t* area, uint8_t* color_map);
 static void lvgl_port_disp_size_update_callback(lv_event_t* e);
 static void lvgl_port_disp_rotation_update(lvgl_port_display_ctx_t* disp_ctx);
 static void lvgl_port_display_invalidate_callback(lv_event_t* e);
+static void lvgl_port_rotate_area_in(lv_display_rotation_t rotation, int32_t frame_w, int32_t frame_h,
+                                     lv_area_t* area);
+static void lvgl_port_cursor_blend(lv_display_t* drv, lvgl_port_display_ctx_t* disp_ctx);
+static bool lvgl_port_cursor_frame(lv_display_t* drv, lvgl_port_display_ctx_t* disp_ctx);
+static void lvgl_port_cursor_timer_callback(lv_timer_t* timer);
+static esp_err_t lvgl_port_blend_client(void);
+static void lvgl_port_front_blend_block(lv_display_t* drv, void* fb, const lv_area_t* fb_area, lv_color_t color);
 
 /*******************************************************************************
  * Public API functions
@@ -141,6 +193,10 @@ lv_display_t* lvgl_port_add_disp_dsi(const lvgl_port_display_cfg_t* disp_cfg,
     assert(dsi_cfg != NULL);
     const lvgl_port_disp_priv_cfg_t priv_cfg = {
         .avoid_tearing = dsi_cfg->flags.avoid_tearing,
+#if (CONFIG_IDF_TARGET_ESP32P4 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)) && LVGL_PORT_HANDLE_FLUSH_READY
+        /* With its own frame buffer the panel can take rotated pixels directly */
+        .ppa_rotate = disp_cfg->flags.sw_rotate && !dsi_cfg->flags.avoid_tearing,
+#endif
     };
     lvgl_port_lock(0);
     lv_disp_t* disp = lvgl_port_add_disp_priv(disp_cfg, &priv_cfg);
@@ -151,8 +207,29 @@ lv_display_t* lvgl_port_add_disp_dsi(const lvgl_port_display_cfg_t* disp_cfg,
         disp_ctx->disp_type = LVGL_PORT_DISP_TYPE_DSI;
 
 #if (CONFIG_IDF_TARGET_ESP32P4 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0))
+#if LVGL_PORT_HANDLE_FLUSH_READY
+        /* The back buffer is synced from the direct mode draw buffer, which always holds the whole frame */
+        if (dsi_cfg->flags.vsync_swap && disp_ctx->flags.ppa_rotate && disp_ctx->flags.direct_mode) {
+            if (esp_lcd_dpi_panel_get_frame_buffer(disp_ctx->panel_handle, 2, &disp_ctx->ppa_fbs[0],
+                                                   &disp_ctx->ppa_fbs[1]) == ESP_OK) {
+                disp_ctx->ppa_done_sem = xSemaphoreCreateBinary();
+                /* The panel starts scanning out the first frame buffer */
+                disp_ctx->ppa_back         = 1;
+                disp_ctx->flags.vsync_swap = disp_ctx->ppa_done_sem != NULL;
+                if (disp_ctx->ppa_done_sem == NULL) {
+                    ESP_LOGE(TAG, "Failed to create PPA done Semaphore, vsync swap disabled");
+                }
+            } else {
+                ESP_LOGW(TAG, "Vsync swap needs two DPI frame buffers, falling back to a single one");
+            }
+        }
+#endif
+
         esp_lcd_dpi_panel_event_callbacks_t cbs = {0};
-        if (dsi_cfg->flags.avoid_tearing) {
+        if (disp_ctx->flags.vsync_swap) {
+            /* Swapping to a frame buffer also reports color trans done, flush ready waits for the vsync instead */
+            cbs.on_refresh_done = lvgl_port_flush_dpi_vsync_swap_callback;
+        } else if (dsi_cfg->flags.avoid_tearing) {
             cbs.on_refresh_done = lvgl_port_flush_dpi_vsync_ready_callback;
         } else {
             cbs.on_color_trans_done = lvgl_port_flush_dpi_panel_ready_callback;
@@ -160,6 +237,34 @@ lv_display_t* lvgl_port_add_disp_dsi(const lvgl_port_display_cfg_t* disp_cfg,
         /* Register done callback */
         esp_lcd_dpi_panel_register_event_callbacks(disp_ctx->panel_handle, &cbs, disp);
 
+        if (disp_ctx->flags.vsync_swap || dsi_cfg->flags.avoid_tearing) {
+            /* Tracks rendering for the missed vsync count */
+            lv_display_add_event_cb(disp, lvgl_port_disp_frame_callback, LV_EVENT_RENDER_START, disp_ctx);
+            lv_display_add_event_cb(disp, lvgl_port_disp_frame_callback, LV_EVENT_REFR_READY, disp_ctx);
+        }
+
+#if LVGL_PORT_HANDLE_FLUSH_READY
+        if (disp_ctx->flags.ppa_rotate) {
+            if (disp_ctx->flags.vsync_swap) {
+                disp_ctx->ppa_fb = disp_ctx->ppa_fbs[disp_ctx->ppa_back];
+            } else {
+                ESP_ERROR_CHECK(esp_lcd_dpi_panel_get_frame_buffer(disp_ctx->panel_handle, 1, &disp_ctx->ppa_fb));
+            }
+
+            /* LVGL waits for flush ready before the next flush, so at most one frame of rectangles is pending,
+             * plus the video plane under them */
+            ppa_client_config_t ppa_srm_async_config = {
+                .oper_type             = PPA_OPERATION_SRM,
+                .max_pending_trans_num = DIRTY_RECT_MAX + 1,
+            };
+            ESP_ERROR_CHECK(ppa_register_client(&ppa_srm_async_config, &ppa_srm_async_handle));
+            ppa_event_callbacks_t ppa_cbs = {
+                .on_trans_done = lvgl_port_flush_ppa_ready_callback,
+            };
+            ESP_ERROR_CHECK(ppa_client_register_event_callbacks(ppa_srm_async_handle, &ppa_cbs));
+        }
+#endif
+
         /* Apply rotation from initial display configuration */
         lvgl_port_disp_rotation_update(disp_ctx);
 #else
@@ -227,11 +332,11 @@ esp_err_t lvgl_port_remove_disp(lv_display_t* disp)
     lvgl_port_unlock();
 
     if (disp_ctx->draw_buffs[0]) {
-        free(disp_ctx->draw_buffs[0]);
+        dma_buffer_free(disp_ctx->draw_buffs[0]);
     }
 
     if (disp_ctx->draw_buffs[1]) {
-        free(disp_ctx->draw_buffs[1]);
+        dma_buffer_free(disp_ctx->draw_buffs[1]);
     }
 
     if (disp_ctx->draw_buffs[2]) {
@@ -246,6 +351,20 @@ esp_err_t lvgl_port_remove_disp(lv_display_t* disp)
         vSemaphoreDelete(disp_ctx->trans_sem);
     }
 
+    if (disp_ctx->ppa_done_sem) {
+        vSemaphoreDelete(disp_ctx->ppa_done_sem);
+    }
+
+    if (disp_ctx->cursor_timer) {
+        lv_timer_delete(disp_ctx->cursor_timer);
+    }
+
+    if (disp_ctx->cursor_buf) {
+        dma_buffer_free(disp_ctx->cursor_buf);
+    }
+
+    dma_buffer_free(disp_ctx->front_mask);
+
     free(disp_ctx);
 
     return ESP_OK;
@@ -257,6 +376,239 @@ void lvgl_port_flush_ready(lv_display_t* disp)
     lv_disp_flush_ready(disp);
 }
 
+esp_err_t lvgl_port_get_vsync_stats(lv_display_t* disp, lvgl_port_vsync_stats_t* stats)
+{
+    assert(disp);
+    assert(stats);
+    lvgl_port_display_ctx_t* disp_ctx = (lvgl_port_display_ctx_t*)lv_display_get_driver_data(disp);
+    assert(disp_ctx != NULL);
+
+    if (!disp_ctx->flags.vsync_swap && disp_ctx->trans_sem == NULL) {
+        memset(stats, 0, sizeof(lvgl_port_vsync_stats_t));
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    stats->vsync_count  = __atomic_load_n(&disp_ctx->vsync_stats.vsync_count, __ATOMIC_RELAXED);
+    stats->frame_count  = __atomic_load_n(&disp_ctx->vsync_stats.frame_count, __ATOMIC_RELAXED);
+    stats->missed_count = __atomic_load_n(&disp_ctx->vsync_stats.missed_count, __ATOMIC_RELAXED);
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_set_flush_tap(lv_display_t* disp, lvgl_port_flush_tap_cb_t cb, void* user_ctx)
+{
+    assert(disp);
+    lvgl_port_display_ctx_t* disp_ctx = (lvgl_port_display_ctx_t*)lv_display_get_driver_data(disp);
+    assert(disp_ctx != NULL);
+
+    disp_ctx->flush_tap     = cb;
+    disp_ctx->flush_tap_ctx = user_ctx;
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_get_front_buffer(lv_display_t* disp, const void** buffer)
+{
+    assert(disp);
+    assert(buffer);
+    lvgl_port_display_ctx_t* disp_ctx = (lvgl_port_display_ctx_t*)lv_display_get_driver_data(disp);
+    assert(disp_ctx != NULL);
+
+    if (!disp_ctx->flags.ppa_rotate || disp_ctx->ppa_fb == NULL) {
+        *buffer = NULL;
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    /* The back index moves on when a frame is handed to the panel, the other buffer has the frame just handed over */
+    *buffer = disp_ctx->flags.vsync_swap ? disp_ctx->ppa_fbs[disp_ctx->ppa_back ^ 1] : disp_ctx->ppa_fb;
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_set_cpu_rotate(lv_display_t* disp, uint32_t max_pixels)
+{
+    assert(disp);
+    lvgl_port_display_ctx_t* disp_ctx = (lvgl_port_display_ctx_t*)lv_display_get_driver_data(disp);
+    assert(disp_ctx != NULL);
+
+    ESP_RETURN_ON_FALSE(disp_ctx->flags.ppa_rotate, ESP_ERR_NOT_SUPPORTED, TAG, "CPU rotation needs PPA rotation");
+    disp_ctx->cpu_rotate_max_px = max_pixels;
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_set_video_plane(lv_display_t* disp, const void* buffer, const lv_area_t* area)
+{
+    assert(disp);
+    lvgl_port_display_ctx_t* disp_ctx = (lvgl_port_display_ctx_t*)lv_display_get_driver_data(disp);
+    assert(disp_ctx != NULL);
+
+    ESP_RETURN_ON_FALSE(disp_ctx->flags.vsync_swap, ESP_ERR_NOT_SUPPORTED, TAG, "Video plane needs vsync swap");
+    if (buffer == NULL) {
+        disp_ctx->plane_buf = NULL;
+        return ESP_OK;
+    }
+
+    assert(area);
+    ESP_RETURN_ON_FALSE(area->x1 >= 0 && area->y1 >= 0 && area->x2 < lv_display_get_horizontal_resolution(disp) &&
+                            area->y2 < lv_display_get_vertical_resolution(disp) && area->x1 <= area->x2 &&
+                            area->y1 <= area->y2,
+                        ESP_ERR_INVALID_ARG, TAG, "Video plane outside the screen");
+    disp_ctx->plane_area = *area;
+    disp_ctx->plane_buf  = buffer;
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_set_cursor(lv_display_t* disp, const lv_image_dsc_t* img)
+{
+    assert(disp);
+    lvgl_port_display_ctx_t* disp_ctx = (lvgl_port_display_ctx_t*)lv_display_get_driver_data(disp);
+    assert(disp_ctx != NULL);
+
+    ESP_RETURN_ON_FALSE(disp_ctx->flags.vsync_swap && disp_ctx->flags.direct_mode && !disp_ctx->flags.swap_bytes &&
+                            lv_display_get_color_format(disp) == LV_COLOR_FORMAT_RGB565,
+                        ESP_ERR_NOT_SUPPORTED, TAG, "Cursor overlay needs vsync swap in direct mode");
+    if (img == NULL) {
+        /* The buffer is only read while blending, the areas it covered are restored from the frame without it */
+        dma_buffer_free(disp_ctx->cursor_buf);
+        disp_ctx->cursor_buf     = NULL;
+        disp_ctx->cursor_visible = 0;
+        disp_ctx->cursor_dirty   = 1;
+        if (!lvgl_port_cursor_frame(disp, disp_ctx) && disp_ctx->cursor_timer) {
+            lv_timer_resume(disp_ctx->cursor_timer);
+        }
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_FALSE(img->header.cf == LV_COLOR_FORMAT_RGB565A8 || img->header.cf == LV_COLOR_FORMAT_ARGB8888,
+                        ESP_ERR_INVALID_ARG, TAG, "Cursor must be RGB565A8 or ARGB8888");
+
+    ESP_RETURN_ON_ERROR(lvgl_port_blend_client(), TAG, "Register PPA blend failed");
+    if (disp_ctx->cursor_timer == NULL) {
+        disp_ctx->cursor_timer = lv_timer_create(lvgl_port_cursor_timer_callback, CURSOR_RETRY_MS, disp);
+        ESP_RETURN_ON_FALSE(disp_ctx->cursor_timer, ESP_ERR_NO_MEM, TAG, "No memory for the cursor timer");
+        lv_timer_pause(disp_ctx->cursor_timer);
+        lv_area_set(&disp_ctx->cursor_drawn[0], 0, 0, -1, -1);
+        lv_area_set(&disp_ctx->cursor_drawn[1], 0, 0, -1, -1);
+    }
+
+    /* Converted and rotated once, the blend then takes it as it is. Read by the PPA, so whole cache lines */
+    int32_t w    = img->header.w;
+    int32_t h    = img->header.h;
+    uint8_t* buf = dma_buffer_calloc(w * h * 4, MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA);
+    ESP_RETURN_ON_FALSE(buf, ESP_ERR_NO_MEM, TAG, "No memory for the cursor");
+
+    lv_display_rotation_t rotation = disp_ctx->current_rotation;
+    bool is_swapped                = rotation == LV_DISPLAY_ROTATION_90 || rotation == LV_DISPLAY_ROTATION_270;
+    int32_t out_w                  = is_swapped ? h : w;
+    const uint8_t* alpha           = img->data + w * h * 2;
+    for (int32_t y = 0; y < h; y++) {
+        for (int32_t x = 0; x < w; x++) {
+            uint8_t argb[4];
+            if (img->header.cf == LV_COLOR_FORMAT_ARGB8888) {
+                memcpy(argb, img->data + (y * w + x) * 4, 4);
+            } else {
+                uint16_t c = ((const uint16_t*)img->data)[y * w + x];
+                argb[0]    = ((c & 0x1F) * 527 + 23) >> 6;
+                argb[1]    = (((c >> 5) & 0x3F) * 259 + 33) >> 6;
+                argb[2]    = (((c >> 11) & 0x1F) * 527 + 23) >> 6;
+                argb[3]    = alpha[y * w + x];
+            }
+            lv_area_t px = {x, y, x, y};
+            lvgl_port_rotate_area_in(rotation, w, h, &px);
+            memcpy(buf + (px.y1 * out_w + px.x1) * 4, argb, 4);
+        }
+    }
+
+    /* Blends run on the LVGL task as well, none is using the old image */
+    dma_buffer_free(disp_ctx->cursor_buf);
+    disp_ctx->cursor_buf = buf;
+    disp_ctx->cursor_w   = w;
+    disp_ctx->cursor_h   = h;
+    lv_area_set(&disp_ctx->cursor_area, disp_ctx->cursor_area.x1, disp_ctx->cursor_area.y1,
+                disp_ctx->cursor_area.x1 + w - 1, disp_ctx->cursor_area.y1 + h - 1);
+    disp_ctx->cursor_dirty = 1;
+    if (!lvgl_port_cursor_frame(disp, disp_ctx)) {
+        lv_timer_resume(disp_ctx->cursor_timer);
+    }
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_move_cursor(lv_display_t* disp, int32_t x, int32_t y, bool visible)
+{
+    assert(disp);
+    lvgl_port_display_ctx_t* disp_ctx = (lvgl_port_display_ctx_t*)lv_display_get_driver_data(disp);
+    assert(disp_ctx != NULL);
+
+    ESP_RETURN_ON_FALSE(disp_ctx->cursor_buf, ESP_ERR_INVALID_STATE, TAG, "No cursor image set");
+    if (disp_ctx->cursor_area.x1 == x && disp_ctx->cursor_area.y1 == y && disp_ctx->cursor_visible == visible) {
+        return ESP_OK;
+    }
+    lv_area_set(&disp_ctx->cursor_area, x, y, x + disp_ctx->cursor_w - 1, y + disp_ctx->cursor_h - 1);
+    disp_ctx->cursor_visible = visible;
+    disp_ctx->cursor_dirty   = 1;
+    if (!lvgl_port_cursor_frame(disp, disp_ctx)) {
+        lv_timer_resume(disp_ctx->cursor_timer);
+    }
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_blend_front(lv_display_t* disp, const lv_area_t* area, const lv_opa_t* mask, lv_color_t color)
+{
+    assert(disp);
+    assert(area);
+    assert(mask);
+    lvgl_port_display_ctx_t* disp_ctx = (lvgl_port_display_ctx_t*)lv_display_get_driver_data(disp);
+    assert(disp_ctx != NULL);
+
+    ESP_RETURN_ON_FALSE(disp_ctx->flags.vsync_swap && disp_ctx->flags.direct_mode && !disp_ctx->flags.swap_bytes &&
+                            lv_display_get_color_format(disp) == LV_COLOR_FORMAT_RGB565,
+                        ESP_ERR_NOT_SUPPORTED, TAG, "Front buffer blending needs vsync swap in direct mode");
+    int32_t hor_res  = lv_display_get_horizontal_resolution(disp);
+    lv_area_t screen = {0, 0, hor_res - 1, lv_display_get_vertical_resolution(disp) - 1};
+    lv_area_t clip;
+    if (!lv_area_intersect(&clip, area, &screen)) {
+        return ESP_OK;
+    }
+
+    uint32_t mask_stride      = lv_area_get_width(area);
+    const lv_opa_t* clip_mask = mask + (clip.y1 - area->y1) * mask_stride + (clip.x1 - area->x1);
+    int32_t w                 = lv_area_get_width(&clip);
+    int32_t h                 = lv_area_get_height(&clip);
+    uint16_t fg               = lv_color_to_u16(color);
+
+    /* The frame LVGL rendered first, the swaps copy the back buffer from it and would take the blend out again */
+    uint32_t stride = lv_draw_buf_width_to_stride(hor_res, LV_COLOR_FORMAT_RGB565) / sizeof(uint16_t);
+    for (int i = 0; i < 2; i++) {
+        if (disp_ctx->draw_buffs[i]) {
+            lvgl_port_blend_mask_rgb565((uint16_t*)disp_ctx->draw_buffs[i] + clip.y1 * stride + clip.x1, stride,
+                                        clip_mask, mask_stride, w, h, fg);
+        }
+    }
+
+    /* Rotated once, read by the PPA, so whole cache lines */
+    size_t size = ALIGN_UP_BY((size_t)w * h, data_cache_line_size);
+    if (disp_ctx->front_mask_size < size) {
+        dma_buffer_free(disp_ctx->front_mask);
+        disp_ctx->front_mask      = dma_buffer_calloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA);
+        disp_ctx->front_mask_size = disp_ctx->front_mask ? size : 0;
+        ESP_RETURN_ON_FALSE(disp_ctx->front_mask, ESP_ERR_NO_MEM, TAG, "No memory for the front buffer mask");
+    }
+    lv_display_rotation_t rotation = disp_ctx->current_rotation;
+    bool is_swapped                = rotation == LV_DISPLAY_ROTATION_90 || rotation == LV_DISPLAY_ROTATION_270;
+    int32_t out_w                  = is_swapped ? h : w;
+    for (int32_t y = 0; y < h; y++) {
+        for (int32_t x = 0; x < w; x++) {
+            lv_area_t px = {x, y, x, y};
+            lvgl_port_rotate_area_in(rotation, w, h, &px);
+            disp_ctx->front_mask[px.y1 * out_w + px.x1] = clip_mask[y * mask_stride + x];
+        }
+    }
+
+    /* Straight into both DPI frame buffers, the one on screen shows it with this scanout and the other one keeps it
+     * through the next swap, LVGL never waits on a render for it */
+    lv_area_t fb_area = clip;
+    lvgl_port_rotate_area(disp, &fb_area);
+    for (int i = 0; i < 2; i++) {
+        lvgl_port_front_blend_block(disp, disp_ctx->ppa_fbs[i], &fb_area, color);
+    }
+    return ESP_OK;
+}
+
 /*******************************************************************************
  * Private functions
  *******************************************************************************/
@@ -312,6 +664,7 @@ static lv_display_t* lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t* disp
     disp_ctx->rotation.mirror_y = disp_cfg->rotation.mirror_y;
     disp_ctx->flags.swap_bytes  = disp_cfg->flags.swap_bytes;
     disp_ctx->flags.sw_rotate   = disp_cfg->flags.sw_rotate;
+    disp_ctx->flags.ppa_rotate  = priv_cfg && priv_cfg->ppa_rotate;
     disp_ctx->current_rotation  = LV_DISPLAY_ROTATION_0;
 
     uint32_t buff_caps = 0;
@@ -349,10 +702,11 @@ static lv_display_t* lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t* disp
     } else {
         /* alloc draw buffers used by LVGL */
         /* it's recommended to choose the size of the draw buffer(s) to be at least 1/10 screen sized */
-        buf1 = heap_caps_aligned_alloc(CONFIG_LV_DRAW_BUF_ALIGN, buffer_size * color_bytes, buff_caps);
+        /* whole cache lines, the PPA writes the buffers and the flush reads them by DMA */
+        buf1 = dma_buffer_aligned_alloc(CONFIG_LV_DRAW_BUF_ALIGN, buffer_size * color_bytes, buff_caps);
         ESP_GOTO_ON_FALSE(buf1, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (buf1) allocation!");
         if (disp_cfg->double_buffer) {
-            buf2 = heap_caps_aligned_alloc(CONFIG_LV_DRAW_BUF_ALIGN, buffer_size * color_bytes, buff_caps);
+            buf2 = dma_buffer_aligned_alloc(CONFIG_LV_DRAW_BUF_ALIGN, buffer_size * color_bytes, buff_caps);
             ESP_GOTO_ON_FALSE(buf2, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (buf2) allocation!");
         }
 
@@ -418,8 +772,8 @@ static lv_display_t* lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t* disp
     lv_display_set_driver_data(disp, disp_ctx);
     disp_ctx->disp_drv = disp;
 
-    /* Use SW rotation */
-    if (disp_cfg->flags.sw_rotate) {
+    /* Use SW rotation, the PPA path writes into the panel frame buffer and needs no rotation buffer */
+    if (disp_cfg->flags.sw_rotate && !disp_ctx->flags.ppa_rotate) {
         disp_ctx->draw_buffs[2] = heap_caps_malloc(buffer_size * color_bytes, buff_caps);
         ESP_GOTO_ON_FALSE(disp_ctx->draw_buffs[2], ESP_ERR_NO_MEM, err, TAG,
                           "Not enough memory for LVGL buffer (rotation buffer) allocation!");
@@ -428,10 +782,10 @@ static lv_display_t* lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t* disp
 err:
     if (ret != ESP_OK) {
         if (disp_ctx->draw_buffs[0]) {
-            free(disp_ctx->draw_buffs[0]);
+            dma_buffer_free(disp_ctx->draw_buffs[0]);
         }
         if (disp_ctx->draw_buffs[1]) {
-            free(disp_ctx->draw_buffs[1]);
+            dma_buffer_free(disp_ctx->draw_buffs[1]);
         }
         if (disp_ctx->draw_buffs[2]) {
             free(disp_ctx->draw_buffs[2]);
@@ -480,12 +834,80 @@ static bool lvgl_port_flush_dpi_vsync_ready_callback(esp_lcd_panel_handle_t pane
     lvgl_port_display_ctx_t* disp_ctx = (lvgl_port_display_ctx_t*)lv_display_get_driver_data(disp_drv);
     assert(disp_ctx != NULL);
 
+    disp_ctx->vsync_stats.vsync_count++;
+    if (disp_ctx->frame_busy) {
+        disp_ctx->vsync_stats.missed_count++;
+    }
+
     if (disp_ctx->trans_sem) {
         xSemaphoreGiveFromISR(disp_ctx->trans_sem, &need_yield);
     }
 
     return (need_yield == pdTRUE);
 }
+
+/**
+ * Vsync of the swap mode. The DPI driver moves to the requested frame buffer right before this callback, so the old
+ * front buffer is free for the next frame from here on.
+ */
+static bool lvgl_port_flush_dpi_vsync_swap_callback(esp_lcd_panel_handle_t panel_io,
+                                                    esp_lcd_dpi_panel_event_data_t* edata, void* user_ctx)
+{
+    lv_display_t* disp_drv = (lv_display_t*)user_ctx;
+    assert(disp_drv != NULL);
+    lvgl_port_display_ctx_t* disp_ctx = (lvgl_port_display_ctx_t*)lv_display_get_driver_data(disp_drv);
+    assert(disp_ctx != NULL);
+
+    disp_ctx->vsync_stats.vsync_count++;
+    uint8_t swap_pending = __atomic_exchange_n(&disp_ctx->swap_pending, 0, __ATOMIC_ACQ_REL);
+    if (swap_pending == SWAP_PENDING_FRAME) {
+        lv_disp_flush_ready(disp_drv);
+    } else if (swap_pending == SWAP_PENDING_CURSOR) {
+        /* Only the cursor moved, no flush to report */
+    } else if (disp_ctx->frame_busy) {
+        /* The frame was not ready in time, the panel shows the previous one again */
+        disp_ctx->vsync_stats.missed_count++;
+    }
+    return false;
+}
+
+static bool lvgl_port_flush_ppa_ready_callback(ppa_client_handle_t ppa_client, ppa_event_data_t* event_data,
+                                               void* user_data)
+{
+    BaseType_t need_yield = pdFALSE;
+
+    lv_display_t* disp_drv = (lv_display_t*)user_data;
+    assert(disp_drv != NULL);
+    lvgl_port_display_ctx_t* disp_ctx = (lvgl_port_display_ctx_t*)lv_display_get_driver_data(disp_drv);
+    assert(disp_ctx != NULL);
+
+    if (__atomic_sub_fetch(&disp_ctx->ppa_pending, 1, __ATOMIC_ACQ_REL) == 0) {
+        if (disp_ctx->flags.vsync_swap) {
+            xSemaphoreGiveFromISR(disp_ctx->ppa_done_sem, &need_yield);
+        } else {
+            lv_disp_flush_ready(disp_drv);
+        }
+    }
+    return (need_yield == pdTRUE);
+}
+
+static void lvgl_port_disp_frame_callback(lv_event_t* e)
+{
+    lvgl_port_display_ctx_t* disp_ctx = (lvgl_port_display_ctx_t*)lv_event_get_user_data(e);
+    assert(disp_ctx != NULL);
+
+    /* Rendering starts only once the previous frame is swapped in, so every vsync until the next swap is a miss */
+    bool is_start = lv_event_get_code(e) == LV_EVENT_RENDER_START;
+    __atomic_store_n(&disp_ctx->frame_busy, is_start, __ATOMIC_RELEASE);
+
+    /* The tap gets the plane before the areas LVGL renders over it */
+    if (is_start && disp_ctx->plane_buf && disp_ctx->flush_tap) {
+        lv_color_format_t cf = lv_display_get_color_format(disp_ctx->disp_drv);
+        uint32_t stride      = lv_area_get_width(&disp_ctx->plane_area) * lv_color_format_get_size(cf);
+        disp_ctx->flush_tap(disp_ctx->disp_drv, &disp_ctx->plane_area, disp_ctx->plane_buf, stride,
+                            disp_ctx->flush_tap_ctx);
+    }
+}
 #endif
 
 #if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
@@ -571,35 +993,34 @@ static void _lvgl_port_transform_monochrome(lv_display_t* display, const lv_area
 
 void lvgl_port_rotate_area(lv_display_t* disp, lv_area_t* area)
 {
-    lv_display_rotation_t rotation = lv_display_get_rotation(disp);
+    lvgl_port_rotate_area_in(lv_display_get_rotation(disp), lv_display_get_horizontal_resolution(disp),
+                             lv_display_get_vertical_resolution(disp), area);
+}
 
+/* Rotate an area of a frame_w x frame_h frame, given unrotated, the way the screen is rotated onto the panel */
+static void lvgl_port_rotate_area_in(lv_display_rotation_t rotation, int32_t frame_w, int32_t frame_h,
+                                     lv_area_t* area)
+{
     int32_t w = lv_area_get_width(area);
     int32_t h = lv_area_get_height(area);
 
-    int32_t hres = lv_display_get_horizontal_resolution(disp);
-    int32_t vres = lv_display_get_vertical_resolution(disp);
-    if (rotation == LV_DISPLAY_ROTATION_90 || rotation == LV_DISPLAY_ROTATION_270) {
-        vres = lv_display_get_horizontal_resolution(disp);
-        hres = lv_display_get_vertical_resolution(disp);
-    }
-
     switch (rotation) {
         case LV_DISPLAY_ROTATION_0:
             return;
         case LV_DISPLAY_ROTATION_90:
-            area->y2 = vres - area->x1 - 1;
+            area->y2 = frame_w - area->x1 - 1;
             area->x1 = area->y1;
             area->x2 = area->x1 + h - 1;
             area->y1 = area->y2 - w + 1;
             break;
         case LV_DISPLAY_ROTATION_180:
-            area->y2 = vres - area->y1 - 1;
+            area->y2 = frame_h - area->y1 - 1;
             area->y1 = area->y2 - h + 1;
-            area->x2 = hres - area->x1 - 1;
+            area->x2 = frame_w - area->x1 - 1;
             area->x1 = area->x2 - w + 1;
             break;
         case LV_DISPLAY_ROTATION_270:
-            area->x1 = hres - area->y2 - 1;
+            area->x1 = frame_h - area->y2 - 1;
             area->y2 = area->x2;
             area->x2 = area->x1 + h - 1;
             area->y1 = area->y2 - w + 1;
@@ -607,6 +1028,96 @@ void lvgl_port_rotate_area(lv_display_t* disp, lv_area_t* area)
     }
 }
 
+/* Two RGB565 pixels, the left one in the low half */
+typedef uint32_t __attribute__((may_alias)) rgb565_pair_t;
+
+/* Where the rotation puts the first pixel of source row y of a tile starting at x0, and the step to the next pixel */
+static uint16_t* rotate_row_start(uint16_t* dst, uint32_t dst_stride, uint32_t w, uint32_t h, uint32_t x0,
+                                  uint32_t y, lv_display_rotation_t rotation, int32_t* step)
+{
+    switch (rotation) {
+        case LV_DISPLAY_ROTATION_90:
+            *step = -(int32_t)dst_stride;
+            return dst + (w - 1 - x0) * dst_stride + y;
+        case LV_DISPLAY_ROTATION_180:
+            *step = -1;
+            return dst + (h - 1 - y) * dst_stride + (w - 1 - x0);
+        default:
+            *step = dst_stride;
+            return dst + x0 * dst_stride + (h - 1 - y);
+    }
+}
+
+static void rotate_tile_pixel(const uint16_t* src, uint32_t src_stride, uint16_t* dst, uint32_t dst_stride,
+                              uint32_t w, uint32_t h, uint32_t x0, uint32_t y0, uint32_t tw, uint32_t th,
+                              lv_display_rotation_t rotation)
+{
+    for (uint32_t y = y0; y < y0 + th; y++) {
+        const uint16_t* s = src + y * src_stride + x0;
+        int32_t step;
+        uint16_t* d = rotate_row_start(dst, dst_stride, w, h, x0, y, rotation, &step);
+        for (uint32_t x = 0; x < tw; x++) {
+            *d = s[x];
+            d += step;
+        }
+    }
+}
+
+/* Even tile origin and size, two source rows at a time, each 2x2 block read and written as two words */
+static void rotate_tile_pair(const uint16_t* src, uint32_t src_stride, uint16_t* dst, uint32_t dst_stride, uint32_t w,
+                             uint32_t h, uint32_t x0, uint32_t y0, uint32_t tw, uint32_t th,
+                             lv_display_rotation_t rotation)
+{
+    for (uint32_t y = y0; y < y0 + th; y += 2) {
+        const rgb565_pair_t* s0 = (const rgb565_pair_t*)(src + y * src_stride + x0);
+        const rgb565_pair_t* s1 = (const rgb565_pair_t*)(src + (y + 1) * src_stride + x0);
+        for (uint32_t i = 0; i < tw / 2; i++) {
+            uint32_t a = s0[i]; /* (x, y) and (x + 1, y) */
+            uint32_t b = s1[i]; /* (x, y + 1) and (x + 1, y + 1) */
+            uint32_t x = x0 + i * 2;
+            switch (rotation) {
+                case LV_DISPLAY_ROTATION_90:
+                    *(rgb565_pair_t*)(dst + (w - 1 - x) * dst_stride + y) = (a & 0xFFFF) | (b << 16);
+                    *(rgb565_pair_t*)(dst + (w - 2 - x) * dst_stride + y) = (a >> 16) | (b & 0xFFFF0000);
+                    break;
+                case LV_DISPLAY_ROTATION_180:
+                    *(rgb565_pair_t*)(dst + (h - 1 - y) * dst_stride + (w - 2 - x)) = (a >> 16) | (a << 16);
+                    *(rgb565_pair_t*)(dst + (h - 2 - y) * dst_stride + (w - 2 - x)) = (b >> 16) | (b << 16);
+                    break;
+                default:
+                    *(rgb565_pair_t*)(dst + x * dst_stride + (h - 2 - y))       = (b & 0xFFFF) | (a << 16);
+                    *(rgb565_pair_t*)(dst + (x + 1) * dst_stride + (h - 2 - y)) = (b >> 16) | (a & 0xFFFF0000);
+                    break;
+            }
+        }
+    }
+}
+
+void lvgl_port_rotate_rgb565(const uint16_t* src, uint32_t src_stride, uint16_t* dst, uint32_t dst_stride, uint32_t w,
+                             uint32_t h, lv_display_rotation_t rotation)
+{
+    if (rotation == LV_DISPLAY_ROTATION_0) {
+        for (uint32_t y = 0; y < h; y++) {
+            memcpy(dst + y * dst_stride, src + y * src_stride, w * sizeof(uint16_t));
+        }
+        return;
+    }
+
+    bool is_paired = ((uintptr_t)src & 3) == 0 && ((uintptr_t)dst & 3) == 0 && (src_stride & 1) == 0 &&
+                     (dst_stride & 1) == 0 && (w & 1) == 0 && (h & 1) == 0;
+    for (uint32_t y0 = 0; y0 < h; y0 += ROTATE_TILE) {
+        uint32_t th = LV_MIN(ROTATE_TILE, h - y0);
+        for (uint32_t x0 = 0; x0 < w; x0 += ROTATE_TILE) {
+            uint32_t tw = LV_MIN(ROTATE_TILE, w - x0);
+            if (is_paired) {
+                rotate_tile_pair(src, src_stride, dst, dst_stride, w, h, x0, y0, tw, th, rotation);
+            } else {
+                rotate_tile_pixel(src, src_stride, dst, dst_stride, w, h, x0, y0, tw, th, rotation);
+            }
+        }
+    }
+}
+
 IRAM_ATTR static void rotate_copy_pixel(const uint16_t* from, uint16_t* to, uint16_t x_start, uint16_t y_start,
                                         uint16_t x_end, uint16_t y_end, uint16_t w, uint16_t h, uint16_t rotation)
 {
@@ -662,7 +1173,516 @@ IRAM_ATTR static void rotate_copy_pixel(const uint16_t* from, uint16_t* to, uint
         .mode           = PPA_TRANS_MODE_BLOCKING,
     };
 
-    ESP_ERROR_CHECK(ppa_do_scale_rotate_mirror(ppa_srm_handle, &oper_config));
+    if (ppa_do_scale_rotate_mirror(ppa_srm_handle, &oper_config) == ESP_OK) {
+        return;
+    }
+#if LV_COLOR_DEPTH == 16
+    /* The flush asks for 270 on LV_DISPLAY_ROTATION_90 and 90 on LV_DISPLAY_ROTATION_270 */
+    lv_display_rotation_t lv_rotation = rotation == 270   ? LV_DISPLAY_ROTATION_90
+                                        : rotation == 180 ? LV_DISPLAY_ROTATION_180
+                                        : rotation == 90  ? LV_DISPLAY_ROTATION_270
+                                                          : LV_DISPLAY_ROTATION_0;
+    ESP_LOGW(TAG, "PPA rotation failed, rotating on the CPU");
+    lvgl_port_rotate_rgb565(from + y_start * w + x_start, w, to + y_offset * oper_config.out.pic_w + x_offset,
+                            oper_config.out.pic_w, oper_config.in.block_w, oper_config.in.block_h, lv_rotation);
+#else
+    ESP_ERROR_CHECK(ESP_FAIL);
+#endif
+}
+
+/**
+ * Rotate a block of src with the PPA straight into the DPI frame buffer, at the place of area on the screen. The
+ * transaction is non-blocking, the done callback reports flush ready once the last pending one is finished.
+ */
+static esp_err_t lvgl_port_ppa_rotate_block(lv_display_t* drv, lvgl_port_display_ctx_t* disp_ctx,
+                                            const lv_area_t* area, const void* src, uint32_t src_w, uint32_t src_h,
+                                            uint32_t src_x, uint32_t src_y)
+{
+    ppa_srm_rotation_angle_t ppa_rotation;
+    switch (disp_ctx->current_rotation) {
+        case LV_DISPLAY_ROTATION_90:
+            ppa_rotation = PPA_SRM_ROTATION_ANGLE_270;
+            break;
+        case LV_DISPLAY_ROTATION_180:
+            ppa_rotation = PPA_SRM_ROTATION_ANGLE_180;
+            break;
+        case LV_DISPLAY_ROTATION_270:
+            ppa_rotation = PPA_SRM_ROTATION_ANGLE_90;
+            break;
+        default:
+            ppa_rotation = PPA_SRM_ROTATION_ANGLE_0;
+            break;
+    }
+
+    lv_area_t fb_area  = *area;
+    uint32_t fb_w      = lv_display_get_physical_horizontal_resolution(drv);
+    uint32_t fb_h      = lv_display_get_physical_vertical_resolution(drv);
+    uint8_t color_size = lv_color_format_get_size(lv_display_get_color_format(drv));
+    lvgl_port_rotate_area(drv, &fb_area);
+
+    ppa_srm_oper_config_t oper_config = {
+        .in.buffer         = src,
+        .in.pic_w          = src_w,
+        .in.pic_h          = src_h,
+        .in.block_w        = lv_area_get_width(area),
+        .in.block_h        = lv_area_get_height(area),
+        .in.block_offset_x = src_x,
+        .in.block_offset_y = src_y,
+        .in.srm_cm         = (LV_COLOR_DEPTH == 24) ? PPA_SRM_COLOR_MODE_RGB888 : PPA_SRM_COLOR_MODE_RGB565,
+
+        .out.buffer         = disp_ctx->ppa_fb,
+        .out.buffer_size    = ALIGN_UP_BY(color_size * fb_w * fb_h, data_cache_line_size),
+        .out.pic_w          = fb_w,
+        .out.pic_h          = fb_h,
+        .out.block_offset_x = fb_area.x1,
+        .out.block_offset_y = fb_area.y1,
+        .out.srm_cm         = (LV_COLOR_DEPTH == 24) ? PPA_SRM_COLOR_MODE_RGB888 : PPA_SRM_COLOR_MODE_RGB565,
+
+        .rotation_angle = ppa_rotation,
+        .scale_x        = 1.0,
+        .scale_y        = 1.0,
+        .rgb_swap       = 0,
+        .byte_swap      = disp_ctx->flags.swap_bytes,
+        .mode           = PPA_TRANS_MODE_NON_BLOCKING,
+        .user_data      = drv,
+    };
+
+    return ppa_do_scale_rotate_mirror(ppa_srm_async_handle, &oper_config);
+}
+
+/* One block of the frame is in the DPI frame buffer, the last one makes the flush ready */
+static void lvgl_port_ppa_trans_done(lv_display_t* drv, lvgl_port_display_ctx_t* disp_ctx)
+{
+    if (__atomic_sub_fetch(&disp_ctx->ppa_pending, 1, __ATOMIC_ACQ_REL) == 0) {
+        if (disp_ctx->flags.vsync_swap) {
+            xSemaphoreGive(disp_ctx->ppa_done_sem);
+        } else {
+            lv_disp_flush_ready(drv);
+        }
+    }
+}
+
+/* A transaction that could not be submitted still counts as done */
+static void lvgl_port_ppa_trans_failed(lv_display_t* drv, lvgl_port_display_ctx_t* disp_ctx)
+{
+    ESP_LOGE(TAG, "PPA rotation failed");
+    lvgl_port_ppa_trans_done(drv, disp_ctx);
+}
+
+#if LV_COLOR_DEPTH == 16
+/* lvgl_port_ppa_rotate_block on the CPU, done when it returns */
+static void lvgl_port_cpu_rotate_block(lv_display_t* drv, lvgl_port_display_ctx_t* disp_ctx, const lv_area_t* area,
+                                       const void* src, uint32_t src_w, uint32_t src_x, uint32_t src_y)
+{
+    lv_area_t fb_area = *area;
+    uint32_t fb_w     = lv_display_get_physical_horizontal_resolution(drv);
+    lvgl_port_rotate_area(drv, &fb_area);
+
+    uint16_t* dst = (uint16_t*)disp_ctx->ppa_fb + fb_area.y1 * fb_w + fb_area.x1;
+    lvgl_port_rotate_rgb565((const uint16_t*)src + src_y * src_w + src_x, src_w, dst, fb_w, lv_area_get_width(area),
+                            lv_area_get_height(area), disp_ctx->current_rotation);
+    /* The panel reads the frame buffer by DMA */
+    esp_cache_msync(dst, (lv_area_get_height(&fb_area) - 1) * fb_w * sizeof(uint16_t) +
+                             lv_area_get_width(&fb_area) * sizeof(uint16_t),
+                    ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+    lvgl_port_ppa_trans_done(drv, disp_ctx);
+}
+#endif
+
+typedef enum {
+    ROTATE_PATH_PPA_FIRST, /* Nothing of the frame went to the PPA yet, a failed submit can still go to the CPU */
+    ROTATE_PATH_PPA,
+    ROTATE_PATH_CPU,
+} lvgl_port_rotate_path_t;
+
+/* Rotate one block of the frame into the DPI frame buffer, on the path the frame takes */
+static void lvgl_port_rotate_block(lv_display_t* drv, lvgl_port_display_ctx_t* disp_ctx, const lv_area_t* area,
+                                   const void* src, uint32_t src_w, uint32_t src_h, uint32_t src_x, uint32_t src_y,
+                                   lvgl_port_rotate_path_t* path)
+{
+    if (*path != ROTATE_PATH_CPU) {
+        if (lvgl_port_ppa_rotate_block(drv, disp_ctx, area, src, src_w, src_h, src_x, src_y) == ESP_OK) {
+            *path = ROTATE_PATH_PPA;
+            return;
+        }
+        if (*path == ROTATE_PATH_PPA) {
+            lvgl_port_ppa_trans_failed(drv, disp_ctx);
+            return;
+        }
+#if LV_COLOR_DEPTH == 16
+        if (!disp_ctx->flags.swap_bytes) {
+            ESP_LOGW(TAG, "PPA busy, rotating the frame on the CPU");
+            *path = ROTATE_PATH_CPU;
+        }
+#endif
+        if (*path != ROTATE_PATH_CPU) {
+            lvgl_port_ppa_trans_failed(drv, disp_ctx);
+            return;
+        }
+    }
+#if LV_COLOR_DEPTH == 16
+    lvgl_port_cpu_rotate_block(drv, disp_ctx, area, src, src_w, src_x, src_y);
+#endif
+}
+
+/* Small frames skip the PPA queue when asked to, the whole frame goes one way so the blocks land in order */
+static lvgl_port_rotate_path_t lvgl_port_rotate_path(lvgl_port_display_ctx_t* disp_ctx, const lv_area_t* areas,
+                                                     uint8_t count, const void* plane)
+{
+#if LV_COLOR_DEPTH == 16
+    if (disp_ctx->cpu_rotate_max_px == 0 || disp_ctx->flags.swap_bytes) {
+        return ROTATE_PATH_PPA_FIRST;
+    }
+    uint32_t pixels = plane ? lv_area_get_size(&disp_ctx->plane_area) : 0;
+    for (uint8_t i = 0; i < count; i++) {
+        pixels += lv_area_get_size(&areas[i]);
+    }
+    return pixels <= disp_ctx->cpu_rotate_max_px ? ROTATE_PATH_CPU : ROTATE_PATH_PPA_FIRST;
+#else
+    return ROTATE_PATH_PPA_FIRST;
+#endif
+}
+
+static void lvgl_port_flush_ppa_areas(lv_display_t* drv, lvgl_port_display_ctx_t* disp_ctx, const lv_area_t* areas,
+                                      uint8_t count, uint8_t* color_map)
+{
+    /* The plane only goes into the vsync swap back buffer */
+    const void* plane = disp_ctx->flags.vsync_swap ? disp_ctx->plane_buf : NULL;
+    if (count == 0 && plane == NULL) {
+        lv_disp_flush_ready(drv);
+        return;
+    }
+
+    /* Counted up front, the first transaction may finish before the last one is submitted */
+    __atomic_store_n(&disp_ctx->ppa_pending, count + (plane ? 1 : 0), __ATOMIC_RELEASE);
+    lvgl_port_rotate_path_t path = lvgl_port_rotate_path(disp_ctx, areas, count, plane);
+    if (plane) {
+        /* Submitted first, the PPA runs the transactions of a client in order so the rendered areas land on top */
+        const lv_area_t* area = &disp_ctx->plane_area;
+        lvgl_port_rotate_block(drv, disp_ctx, area, plane, lv_area_get_width(area), lv_area_get_height(area), 0, 0,
+                               &path);
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        const lv_area_t* area = &areas[i];
+        /* Direct mode and full refresh render into screen sized buffers, partial mode into area sized ones */
+        if (disp_ctx->flags.direct_mode || disp_ctx->flags.full_refresh) {
+            lvgl_port_rotate_block(drv, disp_ctx, area, color_map, lv_display_get_horizontal_resolution(drv),
+                                   lv_display_get_vertical_resolution(drv), area->x1, area->y1, &path);
+        } else {
+            lvgl_port_rotate_block(drv, disp_ctx, area, color_map, lv_area_get_width(area), lv_area_get_height(area),
+                                   0, 0, &path);
+        }
+    }
+}
+
+/**
+ * Add a flushed area to the frame's dirty rectangles. It is merged into the rectangle whose union grows the least,
+ * if that union costs no more pixels than keeping both, or if there is no room for another rectangle.
+ */
+static void lvgl_port_dirty_rect_add(lvgl_port_display_ctx_t* disp_ctx, const lv_area_t* area)
+{
+    lv_area_t* rects    = disp_ctx->dirty_rects;
+    int best            = -1;
+    int64_t best_growth = INT64_MAX;
+    lv_area_t best_union;
+
+    for (int i = 0; i < disp_ctx->dirty_rect_count; i++) {
+        lv_area_t u = {
+            .x1 = LV_MIN(rects[i].x1, area->x1),
+            .y1 = LV_MIN(rects[i].y1, area->y1),
+            .x2 = LV_MAX(rects[i].x2, area->x2),
+            .y2 = LV_MAX(rects[i].y2, area->y2),
+        };
+        int64_t growth =
+            (int64_t)lv_area_get_size(&u) - (int64_t)lv_area_get_size(&rects[i]) - (int64_t)lv_area_get_size(area);
+        if (growth < best_growth) {
+            best        = i;
+            best_growth = growth;
+            best_union  = u;
+        }
+    }
+
+    if (best >= 0 && (best_growth <= 0 || disp_ctx->dirty_rect_count == DIRTY_RECT_MAX)) {
+        rects[best] = best_union;
+    } else {
+        rects[disp_ctx->dirty_rect_count++] = *area;
+    }
+}
+
+/**
+ * Copy the frame into the back DPI frame buffer and swap it in on the next vsync, flush ready comes from the vsync
+ * callback. The back buffer last received the frame before the previous one, so the previous frame's rectangles are
+ * copied again together with this frame's ones.
+ */
+static void lvgl_port_flush_vsync_swap(lv_display_t* drv, lvgl_port_display_ctx_t* disp_ctx, uint8_t* color_map)
+{
+    /* A cursor frame may still wait for its vsync, the back buffer is the one on screen until then */
+    while (__atomic_load_n(&disp_ctx->swap_pending, __ATOMIC_ACQUIRE)) {
+        vTaskDelay(1);
+    }
+    disp_ctx->last_frame = color_map;
+
+    lv_area_t frame_rects[DIRTY_RECT_MAX];
+    uint8_t frame_rect_count = disp_ctx->dirty_rect_count;
+    memcpy(frame_rects, disp_ctx->dirty_rects, sizeof(lv_area_t) * frame_rect_count);
+    for (uint8_t i = 0; i < disp_ctx->prev_dirty_rect_count; i++) {
+        lvgl_port_dirty_rect_add(disp_ctx, &disp_ctx->prev_dirty_rects[i]);
+    }
+    memcpy(disp_ctx->prev_dirty_rects, frame_rects, sizeof(lv_area_t) * frame_rect_count);
+    disp_ctx->prev_dirty_rect_count = frame_rect_count;
+    /* Where the cursor was blended into the back buffer goes back to the frame */
+    const lv_area_t* cursor_drawn = &disp_ctx->cursor_drawn[disp_ctx->ppa_back];
+    if (lv_area_get_width(cursor_drawn) > 0) {
+        lvgl_port_dirty_rect_add(disp_ctx, cursor_drawn);
+    }
+
+    uint8_t count              = disp_ctx->dirty_rect_count;
+    disp_ctx->dirty_rect_count = 0;
+    if (count == 0 && disp_ctx->plane_buf == NULL && !disp_ctx->cursor_dirty) {
+        __atomic_store_n(&disp_ctx->frame_busy, 0, __ATOMIC_RELEASE);
+        lv_disp_flush_ready(drv);
+        return;
+    }
+
+    disp_ctx->ppa_fb = disp_ctx->ppa_fbs[disp_ctx->ppa_back];
+    if (count > 0 || disp_ctx->plane_buf) {
+        lvgl_port_flush_ppa_areas(drv, disp_ctx, disp_ctx->dirty_rects, count, color_map);
+        xSemaphoreTake(disp_ctx->ppa_done_sem, portMAX_DELAY);
+    }
+    lvgl_port_cursor_blend(drv, disp_ctx);
+
+    /* The DPI driver only switches to the frame buffer when the current frame ends */
+    esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, 0, 0, lv_display_get_physical_horizontal_resolution(drv),
+                              lv_display_get_physical_vertical_resolution(drv), disp_ctx->ppa_fb);
+    disp_ctx->ppa_back ^= 1;
+    __atomic_add_fetch(&disp_ctx->vsync_stats.frame_count, 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&disp_ctx->frame_busy, 0, __ATOMIC_RELEASE);
+    /* Set after the switch request, a vsync seen before it keeps showing the old buffer and releases nothing */
+    __atomic_store_n(&disp_ctx->swap_pending, SWAP_PENDING_FRAME, __ATOMIC_RELEASE);
+}
+
+/* Blend the cursor into the back DPI frame buffer, after the frame's areas are in */
+static void lvgl_port_cursor_blend(lv_display_t* drv, lvgl_port_display_ctx_t* disp_ctx)
+{
+    lv_area_t* drawn = &disp_ctx->cursor_drawn[disp_ctx->ppa_back];
+    lv_area_set(drawn, 0, 0, -1, -1);
+    disp_ctx->cursor_dirty = 0;
+    if (!disp_ctx->cursor_visible || disp_ctx->cursor_buf == NULL) {
+        return;
+    }
+
+    const lv_area_t* cursor = &disp_ctx->cursor_area;
+    lv_area_t clip = {
+        .x1 = LV_MAX(cursor->x1, 0),
+        .y1 = LV_MAX(cursor->y1, 0),
+        .x2 = LV_MIN(cursor->x2, lv_display_get_horizontal_resolution(drv) - 1),
+        .y2 = LV_MIN(cursor->y2, lv_display_get_vertical_resolution(drv) - 1),
+    };
+    if (clip.x1 > clip.x2 || clip.y1 > clip.y2) {
+        return;
+    }
+
+    /* Both rotated the same way, the screen area into the frame buffer and the visible part into the image */
+    lv_display_rotation_t rotation = disp_ctx->current_rotation;
+    bool is_swapped                = rotation == LV_DISPLAY_ROTATION_90 || rotation == LV_DISPLAY_ROTATION_270;
+    lv_area_t fg_area              = clip;
+    lv_area_move(&fg_area, -cursor->x1, -cursor->y1);
+    lvgl_port_rotate_area_in(rotation, disp_ctx->cursor_w, disp_ctx->cursor_h, &fg_area);
+    lv_area_t fb_area = clip;
+    lvgl_port_rotate_area(drv, &fb_area);
+
+    uint32_t fb_w = lv_display_get_physical_horizontal_resolution(drv);
+    uint32_t fb_h = lv_display_get_physical_vertical_resolution(drv);
+    ppa_blend_oper_config_t oper_config = {
+        .in_bg.buffer         = disp_ctx->ppa_fb,
+        .in_bg.pic_w          = fb_w,
+        .in_bg.pic_h          = fb_h,
+        .in_bg.block_w        = lv_area_get_width(&fb_area),
+        .in_bg.block_h        = lv_area_get_height(&fb_area),
+        .in_bg.block_offset_x = fb_area.x1,
+        .in_bg.block_offset_y = fb_area.y1,
+        .in_bg.blend_cm       = PPA_BLEND_COLOR_MODE_RGB565,
+
+        .in_fg.buffer         = disp_ctx->cursor_buf,
+        .in_fg.pic_w          = is_swapped ? disp_ctx->cursor_h : disp_ctx->cursor_w,
+        .in_fg.pic_h          = is_swapped ? disp_ctx->cursor_w : disp_ctx->cursor_h,
+        .in_fg.block_w        = lv_area_get_width(&fg_area),
+        .in_fg.block_h        = lv_area_get_height(&fg_area),
+        .in_fg.block_offset_x = fg_area.x1,
+        .in_fg.block_offset_y = fg_area.y1,
+        .in_fg.blend_cm       = PPA_BLEND_COLOR_MODE_ARGB8888,
+
+        .out.buffer         = disp_ctx->ppa_fb,
+        .out.buffer_size    = ALIGN_UP_BY(sizeof(uint16_t) * fb_w * fb_h, data_cache_line_size),
+        .out.pic_w          = fb_w,
+        .out.pic_h          = fb_h,
+        .out.block_offset_x = fb_area.x1,
+        .out.block_offset_y = fb_area.y1,
+        .out.blend_cm       = PPA_BLEND_COLOR_MODE_RGB565,
+
+        .bg_alpha_update_mode = PPA_ALPHA_NO_CHANGE,
+        .fg_alpha_update_mode = PPA_ALPHA_NO_CHANGE,
+        .mode                 = PPA_TRANS_MODE_BLOCKING,
+    };
+    if (ppa_do_blend(ppa_blend_handle, &oper_config) != ESP_OK) {
+        ESP_LOGE(TAG, "PPA cursor blend failed");
+        return;
+    }
+    *drawn = clip;
+}
+
+/**
+ * Compose a frame for a cursor move alone: the back buffer gets the areas it is behind on from the last frame, the
+ * area it had the cursor in, and the cursor at its new place. Returns false if a swap is pending, try again later.
+ */
+static bool lvgl_port_cursor_frame(lv_display_t* drv, lvgl_port_display_ctx_t* disp_ctx)
+{
+    if (!disp_ctx->cursor_dirty || disp_ctx->last_frame == NULL) {
+        /* Composed by the next frame */
+        return true;
+    }
+    if (__atomic_load_n(&disp_ctx->swap_pending, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < disp_ctx->prev_dirty_rect_count; i++) {
+        lvgl_port_dirty_rect_add(disp_ctx, &disp_ctx->prev_dirty_rects[i]);
+    }
+    /* Both buffers hold the last frame after this one */
+    disp_ctx->prev_dirty_rect_count = 0;
+    const lv_area_t* cursor_drawn   = &disp_ctx->cursor_drawn[disp_ctx->ppa_back];
+    if (lv_area_get_width(cursor_drawn) > 0) {
+        lvgl_port_dirty_rect_add(disp_ctx, cursor_drawn);
+    }
+
+    uint8_t count              = disp_ctx->dirty_rect_count;
+    disp_ctx->dirty_rect_count = 0;
+    disp_ctx->ppa_fb           = disp_ctx->ppa_fbs[disp_ctx->ppa_back];
+    if (count > 0 || disp_ctx->plane_buf) {
+        lvgl_port_flush_ppa_areas(drv, disp_ctx, disp_ctx->dirty_rects, count, (uint8_t*)disp_ctx->last_frame);
+        xSemaphoreTake(disp_ctx->ppa_done_sem, portMAX_DELAY);
+    }
+    lvgl_port_cursor_blend(drv, disp_ctx);
+
+    esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, 0, 0, lv_display_get_physical_horizontal_resolution(drv),
+                              lv_display_get_physical_vertical_resolution(drv), disp_ctx->ppa_fb);
+    disp_ctx->ppa_back ^= 1;
+    __atomic_add_fetch(&disp_ctx->vsync_stats.frame_count, 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&disp_ctx->swap_pending, SWAP_PENDING_CURSOR, __ATOMIC_RELEASE);
+    return true;
+}
+
+static void lvgl_port_cursor_timer_callback(lv_timer_t* timer)
+{
+    lv_display_t* disp                = (lv_display_t*)lv_timer_get_user_data(timer);
+    lvgl_port_display_ctx_t* disp_ctx = (lvgl_port_display_ctx_t*)lv_display_get_driver_data(disp);
+    if (lvgl_port_cursor_frame(disp, disp_ctx)) {
+        lv_timer_pause(timer);
+    }
+}
+
+/* Registered on first use, shared by the cursor and the front buffer blends */
+static esp_err_t lvgl_port_blend_client(void)
+{
+    if (ppa_blend_handle) {
+        return ESP_OK;
+    }
+    ppa_client_config_t blend_config = {
+        .oper_type             = PPA_OPERATION_BLEND,
+        .max_pending_trans_num = 1,
+    };
+    return ppa_register_client(&blend_config, &ppa_blend_handle);
+}
+
+/* The alpha is cut to 5 bits, so all three channels blend in one 32-bit multiply */
+void lvgl_port_blend_mask_rgb565(uint16_t* dst, uint32_t dst_stride, const lv_opa_t* mask, uint32_t mask_stride,
+                                 uint32_t w, uint32_t h, uint16_t color)
+{
+    uint32_t fg = (color | ((uint32_t)color << 16)) & 0x07E0F81F;
+    for (uint32_t y = 0; y < h; y++) {
+        uint16_t* row       = dst + y * dst_stride;
+        const lv_opa_t* opa = mask + y * mask_stride;
+        for (uint32_t x = 0; x < w; x++) {
+            uint32_t a = (opa[x] + 4) >> 3;
+            if (a == 0) {
+                continue;
+            }
+            uint32_t bg = (row[x] | ((uint32_t)row[x] << 16)) & 0x07E0F81F;
+            uint32_t c  = ((((fg - bg) * a) >> 5) + bg) & 0x07E0F81F;
+            row[x]      = (uint16_t)(c | (c >> 16));
+        }
+    }
+}
+
+/* Blend the rotated front mask into one DPI frame buffer, the PPA for the larger blocks, the CPU otherwise */
+static void lvgl_port_front_blend_block(lv_display_t* drv, void* fb, const lv_area_t* fb_area, lv_color_t color)
+{
+    lvgl_port_display_ctx_t* disp_ctx = (lvgl_port_display_ctx_t*)lv_display_get_driver_data(drv);
+    uint32_t fb_w                     = lv_display_get_physical_horizontal_resolution(drv);
+    uint32_t fb_h                     = lv_display_get_physical_vertical_resolution(drv);
+    uint32_t w                        = lv_area_get_width(fb_area);
+    uint32_t h                        = lv_area_get_height(fb_area);
+
+    if (w * h >= FRONT_BLEND_PPA_MIN && lvgl_port_blend_client() == ESP_OK) {
+        esp_cache_msync(disp_ctx->front_mask, ALIGN_UP_BY(w * h, data_cache_line_size), ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+        ppa_blend_oper_config_t oper_config = {
+            .in_bg.buffer         = fb,
+            .in_bg.pic_w          = fb_w,
+            .in_bg.pic_h          = fb_h,
+            .in_bg.block_w        = w,
+            .in_bg.block_h        = h,
+            .in_bg.block_offset_x = fb_area->x1,
+            .in_bg.block_offset_y = fb_area->y1,
+            .in_bg.blend_cm       = PPA_BLEND_COLOR_MODE_RGB565,
+
+            .in_fg.buffer   = disp_ctx->front_mask,
+            .in_fg.pic_w    = w,
+            .in_fg.pic_h    = h,
+            .in_fg.block_w  = w,
+            .in_fg.block_h  = h,
+            .in_fg.blend_cm = PPA_BLEND_COLOR_MODE_A8,
+
+            .out.buffer         = fb,
+            .out.buffer_size    = ALIGN_UP_BY(sizeof(uint16_t) * fb_w * fb_h, data_cache_line_size),
+            .out.pic_w          = fb_w,
+            .out.pic_h          = fb_h,
+            .out.block_offset_x = fb_area->x1,
+            .out.block_offset_y = fb_area->y1,
+            .out.blend_cm       = PPA_BLEND_COLOR_MODE_RGB565,
+
+            .bg_alpha_update_mode = PPA_ALPHA_NO_CHANGE,
+            .fg_alpha_update_mode = PPA_ALPHA_NO_CHANGE,
+            /* A8 carries only the alpha, the color is fixed */
+            .fg_fix_rgb_val = {.b = color.blue, .g = color.green, .r = color.red},
+            .mode           = PPA_TRANS_MODE_BLOCKING,
+        };
+        if (ppa_do_blend(ppa_blend_handle, &oper_config) == ESP_OK) {
+            return;
+        }
+        ESP_LOGW(TAG, "PPA front buffer blend failed, blending on the CPU");
+    }
+
+    uint16_t* dst = (uint16_t*)fb + fb_area->y1 * fb_w + fb_area->x1;
+    lvgl_port_blend_mask_rgb565(dst, fb_w, disp_ctx->front_mask, w, w, h, lv_color_to_u16(color));
+    /* The panel reads the frame buffer by DMA */
+    esp_cache_msync(dst, (h - 1) * fb_w * sizeof(uint16_t) + w * sizeof(uint16_t),
+                    ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+}
+
+/* Direct mode and full refresh render into a screen sized buffer, otherwise the buffer only holds the area */
+static void lvgl_port_flush_tap(lv_display_t* drv, lvgl_port_display_ctx_t* disp_ctx, const lv_area_t* area,
+                                const uint8_t* color_map)
+{
+    lv_color_format_t cf = lv_display_get_color_format(drv);
+    uint32_t px_size     = lv_color_format_get_size(cf);
+    if (disp_ctx->flags.direct_mode || disp_ctx->flags.full_refresh) {
+        uint32_t stride = lv_draw_buf_width_to_stride(lv_display_get_horizontal_resolution(drv), cf);
+        disp_ctx->flush_tap(drv, area, color_map + area->y1 * stride + area->x1 * px_size, stride,
+                            disp_ctx->flush_tap_ctx);
+    } else {
+        uint32_t stride = lv_draw_buf_width_to_stride(lv_area_get_width(area), cf);
+        disp_ctx->flush_tap(drv, area, color_map, stride, disp_ctx->flush_tap_ctx);
+    }
 }
 
 static void lvgl_port_flush_callback(lv_display_t* drv, const lv_area_t* area, uint8_t* color_map)
@@ -673,6 +1693,35 @@ static void lvgl_port_flush_callback(lv_display_t* drv, const lv_area_t* area, u
     lvgl_port_display_ctx_t* disp_ctx = (lvgl_port_display_ctx_t*)lv_display_get_driver_data(drv);
     assert(disp_ctx != NULL);
 
+    /* Before rotation and byte swapping, the tap sees the pixels as LVGL rendered them */
+    if (disp_ctx->flush_tap) {
+        lvgl_port_flush_tap(drv, disp_ctx, area, color_map);
+    }
+
+    /* PPA rotation into the DPI frame buffer, flush ready comes from the PPA done callback */
+    if (disp_ctx->flags.ppa_rotate) {
+        /* Direct mode keeps the whole frame in the draw buffer, so only the coalesced dirty rectangles are copied */
+        if (disp_ctx->flags.direct_mode) {
+            lvgl_port_dirty_rect_add(disp_ctx, area);
+            if (!lv_disp_flush_is_last(drv)) {
+                lv_disp_flush_ready(drv);
+                return;
+            }
+            if (disp_ctx->flags.vsync_swap) {
+                lvgl_port_flush_vsync_swap(drv, disp_ctx, color_map);
+                return;
+            }
+            uint8_t count              = disp_ctx->dirty_rect_count;
+            disp_ctx->dirty_rect_count = 0;
+            lvgl_port_flush_ppa_areas(drv, disp_ctx, disp_ctx->dirty_rects, count, color_map);
+            return;
+        }
+        if (disp_ctx->current_rotation > LV_DISPLAY_ROTATION_0) {
+            lvgl_port_flush_ppa_areas(drv, disp_ctx, area, 1, color_map);
+            return;
+        }
+    }
+
     int offsetx1 = area->x1;
     int offsetx2 = area->x2;
     int offsety1 = area->y1;
@@ -684,26 +1733,17 @@ static void lvgl_port_flush_callback(lv_display_t* drv, const lv_area_t* area, u
     if (disp_ctx->flags.sw_rotate && (disp_ctx->current_rotation > LV_DISPLAY_ROTATION_0)) {
         /* SW rotation */
         if (disp_ctx->draw_buffs[2]) {
-            int32_t ww           = lv_area_get_width(area);
-            int32_t hh           = lv_area_get_height(area);
-            lv_color_format_t cf = lv_display_get_color_format(drv);
-            uint32_t w_stride    = lv_draw_buf_width_to_stride(ww, cf);
-            uint32_t h_stride    = lv_draw_buf_width_to_stride(hh, cf);
+            // Every rotation goes through the PPA, the portrait ones cost the same as the landscape ones
+            uint16_t angle = 0;
             if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_180) {
-                lv_draw_sw_rotate(color_map, disp_ctx->draw_buffs[2], hh, ww, h_stride, h_stride,
-                                  LV_DISPLAY_ROTATION_180, cf);
+                angle = 180;
             } else if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_90) {
-                // printf("%ld %ld\n", w_stride, h_stride);
-                // lv_draw_sw_rotate(color_map, disp_ctx->draw_buffs[2], ww, hh, w_stride, h_stride,
-                //                   LV_DISPLAY_ROTATION_90, cf);
-                // rotate_copy_pixel((uint16_t*)color_map, (uint16_t*)disp_ctx->draw_buffs[2], offsetx1, offsety1,
-                //                   offsetx2, offsety2, LV_HOR_RES, LV_VER_RES, 270);
-                rotate_copy_pixel((uint16_t*)color_map, (uint16_t*)disp_ctx->draw_buffs[2], 0, 0, offsetx2 - offsetx1,
-                                  offsety2 - offsety1, offsetx2 - offsetx1 + 1, offsety2 - offsety1 + 1, 270);
+                angle = 270;
             } else if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_270) {
-                lv_draw_sw_rotate(color_map, disp_ctx->draw_buffs[2], ww, hh, w_stride, h_stride,
-                                  LV_DISPLAY_ROTATION_270, cf);
+                angle = 90;
             }
+            rotate_copy_pixel((uint16_t*)color_map, (uint16_t*)disp_ctx->draw_buffs[2], 0, 0, offsetx2 - offsetx1,
+                              offsety2 - offsety1, offsetx2 - offsetx1 + 1, offsety2 - offsety1 + 1, angle);
             color_map = (uint8_t*)disp_ctx->draw_buffs[2];
             lvgl_port_rotate_area(drv, (lv_area_t*)area);
             offsetx1 = area->x1;
@@ -729,9 +1769,14 @@ static void lvgl_port_flush_callback(lv_display_t* drv, const lv_area_t* area, u
             /* If the interface is I80 or SPI, this step cannot be used for drawing. */
             esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, 0, 0, lv_disp_get_hor_res(drv), lv_disp_get_ver_res(drv),
                                       color_map);
-            /* Waiting for the last frame buffer to complete transmission */
-            // xSemaphoreTake(disp_ctx->trans_sem, 0);
-            // xSemaphoreTake(disp_ctx->trans_sem, portMAX_DELAY);
+            /* With the panel frame buffers as draw buffers, wait for the vsync that swaps this one in, LVGL must not
+             * render into the buffer still being scanned out. Cleared first, a vsync before the swap does not count */
+            if (disp_ctx->trans_sem) {
+                __atomic_store_n(&disp_ctx->frame_busy, 0, __ATOMIC_RELEASE);
+                __atomic_add_fetch(&disp_ctx->vsync_stats.frame_count, 1, __ATOMIC_RELAXED);
+                xSemaphoreTake(disp_ctx->trans_sem, 0);
+                xSemaphoreTake(disp_ctx->trans_sem, portMAX_DELAY);
+            }
         }
     } else {
         esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, color_map);
@@ -0,0 +1,304 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "soc/soc_caps.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_idf_version.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_lvgl_port_jpeg.h"
+#include "lvgl.h"
+
+#if SOC_JPEG_CODEC_SUPPORTED && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0) && \
+    (LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR >= 2)
+#define LVGL_PORT_JPEG_SUPPORTED 1
+#include "driver/jpeg_decode.h"
+#include "lvgl_private.h"
+#else
+#define LVGL_PORT_JPEG_SUPPORTED 0
+#endif
+
+static const char *TAG = "LVGL";
+
+#if LVGL_PORT_JPEG_SUPPORTED
+
+#define JPEG_READ_CHUNK_SIZE (64 * 1024) /* SD reads below this size are dominated by the per command overhead */
+#define JPEG_DECODE_TIMEOUT  1000        /* ms, a photo of a few megapixels takes well under this */
+
+/*******************************************************************************
+ * Types definitions
+ *******************************************************************************/
+
+typedef struct {
+    lv_image_decoder_t *decoder;
+    jpeg_decoder_handle_t handle;
+    SemaphoreHandle_t mutex; /* Both SW draw units may open images */
+} lvgl_port_jpeg_ctx_t;
+
+/*******************************************************************************
+ * Local variables
+ *******************************************************************************/
+
+static lvgl_port_jpeg_ctx_t jpeg_ctx;
+
+/*******************************************************************************
+ * Function definitions
+ *******************************************************************************/
+
+static bool lvgl_port_jpeg_read(lv_fs_file_t *file, uint8_t *buf, uint32_t len)
+{
+    uint32_t br = 0;
+    return lv_fs_read(file, buf, len, &br) == LV_FS_RES_OK && br == len;
+}
+
+/* Walk the markers up to the frame header. The codec decodes baseline frames only */
+static lv_result_t lvgl_port_jpeg_read_frame_header(lv_fs_file_t *file, uint32_t *w, uint32_t *h)
+{
+    uint8_t buf[5];
+    if (lv_fs_seek(file, 0, LV_FS_SEEK_SET) != LV_FS_RES_OK || !lvgl_port_jpeg_read(file, buf, 2) ||
+            buf[0] != 0xFF || buf[1] != 0xD8) {
+        return LV_RESULT_INVALID;
+    }
+
+    while (true) {
+        if (!lvgl_port_jpeg_read(file, buf, 1) || buf[0] != 0xFF) {
+            return LV_RESULT_INVALID;
+        }
+        /* Any number of 0xFF may pad a marker */
+        uint8_t marker = 0xFF;
+        while (marker == 0xFF) {
+            if (!lvgl_port_jpeg_read(file, &marker, 1)) {
+                return LV_RESULT_INVALID;
+            }
+        }
+        if ((marker >= 0xD0 && marker <= 0xD7) || marker == 0x01) {
+            continue; /* No length field */
+        }
+        if (marker == 0xD9 || marker == 0xDA) {
+            return LV_RESULT_INVALID; /* Image data reached without a frame header */
+        }
+
+        if (!lvgl_port_jpeg_read(file, buf, 2)) {
+            return LV_RESULT_INVALID;
+        }
+        uint32_t len = (buf[0] << 8) | buf[1];
+        if (len < 2) {
+            return LV_RESULT_INVALID;
+        }
+
+        if (marker == 0xC0 || marker == 0xC1) {
+            if (len < 7 || !lvgl_port_jpeg_read(file, buf, 5)) {
+                return LV_RESULT_INVALID;
+            }
+            *h = (buf[1] << 8) | buf[2];
+            *w = (buf[3] << 8) | buf[4];
+            return (*w > 0 && *h > 0) ? LV_RESULT_OK : LV_RESULT_INVALID;
+        }
+        /* Progressive, lossless and arithmetic coded frames, DHT, JPG and DAC share the range */
+        if (marker >= 0xC2 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+            return LV_RESULT_INVALID;
+        }
+        if (lv_fs_seek(file, len - 2, LV_FS_SEEK_CUR) != LV_FS_RES_OK) {
+            return LV_RESULT_INVALID;
+        }
+    }
+}
+
+static bool lvgl_port_jpeg_is_jpeg_file(const lv_image_decoder_dsc_t *dsc)
+{
+    if (dsc->src_type != LV_IMAGE_SRC_FILE) {
+        return false;
+    }
+    const char *ext = lv_fs_get_ext(dsc->src);
+    return lv_strcmp(ext, "jpg") == 0 || lv_strcmp(ext, "JPG") == 0 || lv_strcmp(ext, "jpeg") == 0 ||
+           lv_strcmp(ext, "JPEG") == 0;
+}
+
+static lv_result_t lvgl_port_jpeg_info(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc,
+                                       lv_image_header_t *header)
+{
+    LV_UNUSED(decoder);
+
+    uint32_t w = 0;
+    uint32_t h = 0;
+    if (!lvgl_port_jpeg_is_jpeg_file(dsc) || lvgl_port_jpeg_read_frame_header(&dsc->file, &w, &h) != LV_RESULT_OK) {
+        return LV_RESULT_INVALID;
+    }
+
+    header->cf     = LV_COLOR_FORMAT_RGB565;
+    header->w      = w;
+    header->h      = h;
+    header->stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+    return LV_RESULT_OK;
+}
+
+/* The whole bitstream has to be in memory for the codec, it is read into a DMA buffer in large chunks */
+static uint8_t *lvgl_port_jpeg_load(lv_fs_file_t *file, uint32_t *size)
+{
+    if (lv_fs_seek(file, 0, LV_FS_SEEK_END) != LV_FS_RES_OK || lv_fs_tell(file, size) != LV_FS_RES_OK ||
+            *size == 0 || lv_fs_seek(file, 0, LV_FS_SEEK_SET) != LV_FS_RES_OK) {
+        return NULL;
+    }
+
+    const jpeg_decode_memory_alloc_cfg_t mem_cfg = {
+        .buffer_direction = JPEG_DEC_ALLOC_INPUT_BUFFER,
+    };
+    size_t allocated = 0;
+    uint8_t *buf     = jpeg_alloc_decoder_mem(*size, &mem_cfg, &allocated);
+    if (buf == NULL) {
+        ESP_LOGE(TAG, "No memory for a %" PRIu32 " byte JPEG", *size);
+        return NULL;
+    }
+
+    for (uint32_t offset = 0; offset < *size;) {
+        uint32_t len = LV_MIN(*size - offset, JPEG_READ_CHUNK_SIZE);
+        if (!lvgl_port_jpeg_read(file, buf + offset, len)) {
+            free(buf);
+            return NULL;
+        }
+        offset += len;
+    }
+    return buf;
+}
+
+/* The codec writes whole MCUs, rows are as wide as the width rounded up to the MCU */
+static void lvgl_port_jpeg_mcu_size(jpeg_down_sampling_type_t sampling, uint32_t *mcu_w, uint32_t *mcu_h)
+{
+    *mcu_w = (sampling == JPEG_DOWN_SAMPLING_YUV420 || sampling == JPEG_DOWN_SAMPLING_YUV422) ? 16 : 8;
+    *mcu_h = (sampling == JPEG_DOWN_SAMPLING_YUV420) ? 16 : 8;
+}
+
+static lv_draw_buf_t *lvgl_port_jpeg_decode(const uint8_t *data, uint32_t size)
+{
+    jpeg_decode_picture_info_t info;
+    if (jpeg_decoder_get_info(data, size, &info) != ESP_OK || info.width == 0 || info.height == 0) {
+        return NULL;
+    }
+
+    uint32_t mcu_w = 0;
+    uint32_t mcu_h = 0;
+    lvgl_port_jpeg_mcu_size(info.sample_method, &mcu_w, &mcu_h);
+    uint32_t out_w = (info.width + mcu_w - 1) / mcu_w * mcu_w;
+    uint32_t out_h = (info.height + mcu_h - 1) / mcu_h * mcu_h;
+
+    /* LV_DRAW_BUF_ALIGN covers the cache line the codec DMA wants, the draw buffer is written directly */
+    lv_draw_buf_t *decoded = lv_draw_buf_create_ex(lv_draw_buf_get_image_handlers(), out_w, out_h,
+                             LV_COLOR_FORMAT_RGB565, out_w * 2);
+    if (decoded == NULL) {
+        ESP_LOGE(TAG, "No memory for a %" PRIu32 "x%" PRIu32 " JPEG", info.width, info.height);
+        return NULL;
+    }
+
+    const jpeg_decode_cfg_t decode_cfg = {
+        .output_format = JPEG_DECODE_OUT_FORMAT_RGB565,
+        .rgb_order     = JPEG_DEC_RGB_ELEMENT_ORDER_BGR,
+        .conv_std      = JPEG_YUV_RGB_CONV_STD_BT601,
+    };
+    uint32_t out_size = 0;
+    xSemaphoreTake(jpeg_ctx.mutex, portMAX_DELAY);
+    esp_err_t ret = jpeg_decoder_process(jpeg_ctx.handle, &decode_cfg, data, size, decoded->data, decoded->data_size,
+                                         &out_size);
+    xSemaphoreGive(jpeg_ctx.mutex);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "JPEG decode failed: %s", esp_err_to_name(ret));
+        lv_draw_buf_destroy(decoded);
+        return NULL;
+    }
+
+    /* The padding stays out of view, only the visible part is drawn */
+    decoded->header.w = info.width;
+    decoded->header.h = info.height;
+    return decoded;
+}
+
+static lv_result_t lvgl_port_jpeg_open(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc)
+{
+    uint32_t size = 0;
+    uint8_t *data = lvgl_port_jpeg_load(&dsc->file, &size);
+    if (data == NULL) {
+        return LV_RESULT_INVALID;
+    }
+    lv_draw_buf_t *decoded = lvgl_port_jpeg_decode(data, size);
+    free(data);
+    if (decoded == NULL) {
+        return LV_RESULT_INVALID;
+    }
+    dsc->decoded = decoded;
+
+    if (dsc->args.no_cache || !lv_image_cache_is_enabled()) {
+        return LV_RESULT_OK;
+    }
+
+    /* Same as the built-in decoders, the cache owns the buffer from here */
+    lv_image_cache_data_t search_key;
+    search_key.src_type  = dsc->src_type;
+    search_key.src       = dsc->src;
+    search_key.slot.size = decoded->data_size;
+    lv_cache_entry_t *entry = lv_image_decoder_add_to_cache(decoder, &search_key, decoded, NULL);
+    if (entry == NULL) {
+        lv_draw_buf_destroy(decoded);
+        dsc->decoded = NULL;
+        return LV_RESULT_INVALID;
+    }
+    dsc->cache_entry = entry;
+    return LV_RESULT_OK;
+}
+
+static void lvgl_port_jpeg_close(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc)
+{
+    LV_UNUSED(decoder);
+
+    if (dsc->args.no_cache || !lv_image_cache_is_enabled()) {
+        lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
+    }
+}
+
+#endif
+
+esp_err_t lvgl_port_jpeg_decoder_init(void)
+{
+#if LVGL_PORT_JPEG_SUPPORTED
+    esp_err_t ret = ESP_OK;
+    if (jpeg_ctx.decoder != NULL) {
+        return ESP_OK;
+    }
+
+    const jpeg_decode_engine_cfg_t engine_cfg = {
+        .intr_priority = 0,
+        .timeout_ms    = JPEG_DECODE_TIMEOUT,
+    };
+    ESP_RETURN_ON_ERROR(jpeg_new_decoder_engine(&engine_cfg, &jpeg_ctx.handle), TAG, "JPEG decoder engine failed");
+
+    jpeg_ctx.mutex = xSemaphoreCreateMutex();
+    ESP_GOTO_ON_FALSE(jpeg_ctx.mutex, ESP_ERR_NO_MEM, err, TAG, "No memory for the JPEG decoder mutex");
+
+    /* New decoders go to the head of the list, ahead of the bin decoder */
+    jpeg_ctx.decoder = lv_image_decoder_create();
+    ESP_GOTO_ON_FALSE(jpeg_ctx.decoder, ESP_ERR_NO_MEM, err, TAG, "No memory for the JPEG image decoder");
+    lv_image_decoder_set_info_cb(jpeg_ctx.decoder, lvgl_port_jpeg_info);
+    lv_image_decoder_set_open_cb(jpeg_ctx.decoder, lvgl_port_jpeg_open);
+    lv_image_decoder_set_close_cb(jpeg_ctx.decoder, lvgl_port_jpeg_close);
+    return ESP_OK;
+
+err:
+    if (jpeg_ctx.mutex) {
+        vSemaphoreDelete(jpeg_ctx.mutex);
+        jpeg_ctx.mutex = NULL;
+    }
+    jpeg_del_decoder_engine(jpeg_ctx.handle);
+    jpeg_ctx.handle = NULL;
+    return ret;
+#else
+    ESP_LOGW(TAG, "Hardware JPEG decoder not supported");
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
@@ -0,0 +1,344 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <assert.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_lvgl_port_mem.h"
+#include "lvgl.h"
+
+#if LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR >= 2
+#define LVGL_PORT_LAYER_POOL_SUPPORTED 1
+#include "lvgl_private.h"
+#else
+#define LVGL_PORT_LAYER_POOL_SUPPORTED 0
+#endif
+
+#define LVGL_PORT_LAYER_POOL_MAX_CNT 8
+#define LVGL_PORT_LAYER_POOL_ALIGN   128 /* L2 cache line, the PPA may write into a layer */
+
+static const char *TAG = "LVGL";
+
+/* Both SW draw units allocate, the counters and the pool are kept under a spinlock */
+static portMUX_TYPE mem_lock = portMUX_INITIALIZER_UNLOCKED;
+static lvgl_port_mem_stats_t mem_stats;
+
+/*******************************************************************************
+ * Layer buffer pool
+ *******************************************************************************/
+
+#if LVGL_PORT_LAYER_POOL_SUPPORTED
+
+typedef struct {
+    uint8_t *bufs[LVGL_PORT_LAYER_POOL_MAX_CNT];
+    bool used[LVGL_PORT_LAYER_POOL_MAX_CNT];
+    uint32_t cnt;
+    size_t buf_size;
+    lv_draw_buf_malloc_cb next_malloc_cb;
+    lv_draw_buf_free_cb next_free_cb;
+} layer_pool_t;
+
+static layer_pool_t layer_pool;
+
+/*
+ * Layer strips are allocated and freed for every layer of every refresh. Draw buffers asked for while a display
+ * refreshes that fit a slot come from the pool, anything else (snapshots, canvases, images) takes the usual path.
+ */
+static void *layer_pool_malloc(size_t size, lv_color_format_t color_format)
+{
+    if (size <= layer_pool.buf_size && lv_refr_get_disp_refreshing() != NULL) {
+        portENTER_CRITICAL(&mem_lock);
+        for (uint32_t i = 0; i < layer_pool.cnt; i++) {
+            if (!layer_pool.used[i]) {
+                layer_pool.used[i] = true;
+                mem_stats.layer_hits++;
+                portEXIT_CRITICAL(&mem_lock);
+                return layer_pool.bufs[i];
+            }
+        }
+        mem_stats.layer_misses++;
+        portEXIT_CRITICAL(&mem_lock);
+    }
+    return layer_pool.next_malloc_cb(size, color_format);
+}
+
+static void layer_pool_free(void *buf)
+{
+    portENTER_CRITICAL(&mem_lock);
+    for (uint32_t i = 0; i < layer_pool.cnt; i++) {
+        if (layer_pool.bufs[i] == buf) {
+            layer_pool.used[i] = false;
+            portEXIT_CRITICAL(&mem_lock);
+            return;
+        }
+    }
+    portEXIT_CRITICAL(&mem_lock);
+    layer_pool.next_free_cb(buf);
+}
+
+esp_err_t lvgl_port_layer_pool_init(size_t buf_size, uint32_t buf_cnt)
+{
+    if (buf_size == 0 || buf_cnt == 0 || layer_pool.cnt) {
+        return ESP_OK;
+    }
+    if (buf_cnt > LVGL_PORT_LAYER_POOL_MAX_CNT) {
+        buf_cnt = LVGL_PORT_LAYER_POOL_MAX_CNT;
+    }
+
+    /* Internal SRAM when there is room, a partial pool still takes what it got */
+    uint32_t cnt = 0;
+    while (cnt < buf_cnt) {
+        layer_pool.bufs[cnt] = heap_caps_aligned_alloc(LVGL_PORT_LAYER_POOL_ALIGN, buf_size,
+                                                       MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+        if (layer_pool.bufs[cnt] == NULL) {
+            break;
+        }
+        cnt++;
+    }
+    if (cnt == 0) {
+        ESP_LOGW(TAG, "No internal memory for the layer pool, layers stay on the heap");
+        return ESP_ERR_NO_MEM;
+    }
+
+    lv_draw_buf_handlers_t *handlers = lv_draw_buf_get_handlers();
+    layer_pool.next_malloc_cb        = handlers->buf_malloc_cb;
+    layer_pool.next_free_cb          = handlers->buf_free_cb;
+    layer_pool.buf_size              = buf_size;
+    layer_pool.cnt                   = cnt;
+    handlers->buf_malloc_cb          = layer_pool_malloc;
+    handlers->buf_free_cb            = layer_pool_free;
+
+    portENTER_CRITICAL(&mem_lock);
+    mem_stats.layer_bufs = cnt;
+    portEXIT_CRITICAL(&mem_lock);
+
+    ESP_LOGI(TAG, "Layer pool: %u x %u KB in internal SRAM", (unsigned)cnt, (unsigned)(buf_size / 1024));
+    return ESP_OK;
+}
+
+#else
+
+esp_err_t lvgl_port_layer_pool_init(size_t buf_size, uint32_t buf_cnt)
+{
+    if (buf_size == 0 || buf_cnt == 0) {
+        return ESP_OK;
+    }
+    ESP_LOGW(TAG, "Layer pool requires LVGL v9.2 or newer");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif /* LVGL_PORT_LAYER_POOL_SUPPORTED */
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+
+/* lv_init() allocates before any BSP code runs, so the policy is fixed at build time */
+#ifdef CONFIG_BSP_DISPLAY_LVGL_MEM_INTERNAL_MAX_SIZE
+#define LVGL_PORT_MEM_INTERNAL_MAX_SIZE CONFIG_BSP_DISPLAY_LVGL_MEM_INTERNAL_MAX_SIZE
+#else
+#define LVGL_PORT_MEM_INTERNAL_MAX_SIZE 256
+#endif
+
+#ifdef CONFIG_BSP_DISPLAY_LVGL_MEM_INTERNAL_KB
+#define LVGL_PORT_MEM_INTERNAL_BUDGET (CONFIG_BSP_DISPLAY_LVGL_MEM_INTERNAL_KB * 1024)
+#else
+#define LVGL_PORT_MEM_INTERNAL_BUDGET (128 * 1024)
+#endif
+
+#define LVGL_PORT_MEM_CAPS_INTERNAL (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#define LVGL_PORT_MEM_CAPS_PSRAM    (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+
+/*******************************************************************************
+ * Function definitions
+ *******************************************************************************/
+
+/* Block sizes come from the heap, so a free or realloc never needs a header of its own */
+static void mem_account(void *p, bool add)
+{
+    const uint32_t size = heap_caps_get_allocated_size(p);
+
+    portENTER_CRITICAL(&mem_lock);
+    if (esp_ptr_external_ram(p)) {
+        if (add) {
+            mem_stats.psram_used += size;
+            mem_stats.psram_cnt++;
+            if (mem_stats.psram_used > mem_stats.psram_peak) {
+                mem_stats.psram_peak = mem_stats.psram_used;
+            }
+        } else {
+            mem_stats.psram_used -= size;
+            mem_stats.psram_cnt--;
+        }
+    } else {
+        if (add) {
+            mem_stats.internal_used += size;
+            mem_stats.internal_cnt++;
+            if (mem_stats.internal_used > mem_stats.internal_peak) {
+                mem_stats.internal_peak = mem_stats.internal_used;
+            }
+        } else {
+            mem_stats.internal_used -= size;
+            mem_stats.internal_cnt--;
+        }
+    }
+    portEXIT_CRITICAL(&mem_lock);
+}
+
+/* Small, short lived and often touched objects go to internal SRAM while the budget lasts */
+static uint32_t mem_caps_for(size_t size)
+{
+    if (size > LVGL_PORT_MEM_INTERNAL_MAX_SIZE) {
+        return LVGL_PORT_MEM_CAPS_PSRAM;
+    }
+
+    bool fits;
+    portENTER_CRITICAL(&mem_lock);
+    fits = mem_stats.internal_used + size <= LVGL_PORT_MEM_INTERNAL_BUDGET;
+    if (!fits) {
+        mem_stats.fallbacks++;
+    }
+    portEXIT_CRITICAL(&mem_lock);
+    return fits ? LVGL_PORT_MEM_CAPS_INTERNAL : LVGL_PORT_MEM_CAPS_PSRAM;
+}
+
+static inline uint32_t mem_caps_other(uint32_t caps)
+{
+    return caps == LVGL_PORT_MEM_CAPS_INTERNAL ? LVGL_PORT_MEM_CAPS_PSRAM : LVGL_PORT_MEM_CAPS_INTERNAL;
+}
+
+static void mem_count_failure(void)
+{
+    portENTER_CRITICAL(&mem_lock);
+    mem_stats.failures++;
+    portEXIT_CRITICAL(&mem_lock);
+}
+
+/*******************************************************************************
+ * Public API functions
+ *******************************************************************************/
+
+bool lvgl_port_mem_get_stats(lvgl_port_mem_stats_t *stats)
+{
+    assert(stats);
+    portENTER_CRITICAL(&mem_lock);
+    *stats = mem_stats;
+    portEXIT_CRITICAL(&mem_lock);
+    return true;
+}
+
+/*******************************************************************************
+ * LVGL custom allocator, LV_STDLIB_CUSTOM
+ *******************************************************************************/
+
+void lv_mem_init(void)
+{
+    /* The heaps are up before LVGL */
+}
+
+void lv_mem_deinit(void)
+{
+}
+
+lv_mem_pool_t lv_mem_add_pool(void *mem, size_t bytes)
+{
+    LV_UNUSED(mem);
+    LV_UNUSED(bytes);
+    return NULL;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool)
+{
+    LV_UNUSED(pool);
+}
+
+void *lv_malloc_core(size_t size)
+{
+    const uint32_t caps = mem_caps_for(size);
+    void *p = heap_caps_malloc(size, caps);
+    if (p == NULL) {
+        p = heap_caps_malloc(size, mem_caps_other(caps));
+    }
+    if (p == NULL) {
+        mem_count_failure();
+        return NULL;
+    }
+    mem_account(p, true);
+    return p;
+}
+
+void *lv_realloc_core(void *p, size_t new_size)
+{
+    if (p == NULL) {
+        return lv_malloc_core(new_size);
+    }
+
+    /* A block that grows past the internal limit moves to PSRAM, heap_caps_realloc copies it */
+    mem_account(p, false);
+    const uint32_t caps = mem_caps_for(new_size);
+    void *new_p = heap_caps_realloc(p, new_size, caps);
+    if (new_p == NULL) {
+        new_p = heap_caps_realloc(p, new_size, mem_caps_other(caps));
+    }
+    if (new_p == NULL) {
+        /* The old block is still valid */
+        mem_account(p, true);
+        mem_count_failure();
+        return NULL;
+    }
+    mem_account(new_p, true);
+    return new_p;
+}
+
+void lv_free_core(void *p)
+{
+    if (p == NULL) {
+        return;
+    }
+    mem_account(p, false);
+    heap_caps_free(p);
+}
+
+void lv_mem_monitor_core(lv_mem_monitor_t *mon_p)
+{
+    lvgl_port_mem_stats_t stats;
+    lvgl_port_mem_get_stats(&stats);
+
+    /* The PSRAM heap is shared with the app, its free numbers are what LVGL can still get */
+    const size_t psram_free = heap_caps_get_free_size(LVGL_PORT_MEM_CAPS_PSRAM);
+    const size_t biggest    = heap_caps_get_largest_free_block(LVGL_PORT_MEM_CAPS_PSRAM);
+    const size_t used       = stats.internal_used + stats.psram_used;
+
+    memset(mon_p, 0, sizeof(lv_mem_monitor_t));
+    mon_p->total_size        = used + psram_free;
+    mon_p->free_size         = psram_free;
+    mon_p->free_biggest_size = biggest;
+    mon_p->used_cnt          = stats.internal_cnt + stats.psram_cnt;
+    mon_p->max_used          = stats.internal_peak + stats.psram_peak;
+    mon_p->used_pct          = mon_p->total_size ? used * 100 / mon_p->total_size : 0;
+    mon_p->frag_pct          = psram_free ? 100 - biggest * 100 / psram_free : 0;
+}
+
+lv_result_t lv_mem_test_core(void)
+{
+    return heap_caps_check_integrity_all(true) ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+#else
+
+bool lvgl_port_mem_get_stats(lvgl_port_mem_stats_t *stats)
+{
+    assert(stats);
+    /* Only the layer pool counters are kept */
+    portENTER_CRITICAL(&mem_lock);
+    *stats = mem_stats;
+    portEXIT_CRITICAL(&mem_lock);
+    return false;
+}
+
+#endif /* LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM */
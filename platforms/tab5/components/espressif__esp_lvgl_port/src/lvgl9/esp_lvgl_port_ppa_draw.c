@@ -0,0 +1,534 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_idf_version.h"
+#include "esp_memory_utils.h"
+#include "esp_lvgl_port_ppa_draw.h"
+#include "dma_buffer.h"
+#include "lvgl.h"
+
+#if CONFIG_IDF_TARGET_ESP32P4 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0) && \
+    (LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR >= 2)
+#define LVGL_PORT_PPA_DRAW_SUPPORTED 1
+#include "driver/ppa.h"
+#include "esp_private/esp_cache_private.h"
+#include "lvgl_private.h"
+#else
+#define LVGL_PORT_PPA_DRAW_SUPPORTED 0
+#endif
+
+static const char *TAG = "LVGL";
+
+#if LVGL_PORT_PPA_DRAW_SUPPORTED
+
+#define DRAW_UNIT_ID_PPA       80  /* Any id not taken by the LVGL draw units */
+#define DRAW_PPA_SCORE         70  /* Lower than the SW renderer's 100, so the PPA wins supported tasks */
+#define DRAW_PPA_IMG_CACHE_MAX 8   /* Flash images copied to PSRAM */
+#define DRAW_PPA_SCALE_FRAG    16  /* The SRM scales in 1/16 steps */
+
+/*******************************************************************************
+ * Types definitions
+ *******************************************************************************/
+
+typedef struct {
+    const void *src; /* Image data in flash */
+    void *copy;      /* Its PSRAM copy, readable by the PPA */
+} lvgl_port_ppa_img_copy_t;
+
+typedef struct {
+    lv_draw_unit_t base_unit;
+    ppa_client_handle_t srm_handle;
+    ppa_client_handle_t blend_handle;
+    ppa_client_handle_t fill_handle;
+    size_t cache_line_size;
+    lvgl_port_ppa_draw_cfg_t cfg;
+    lvgl_port_ppa_img_copy_t img_copies[DRAW_PPA_IMG_CACHE_MAX];
+    uint32_t img_cache_used; /* Bytes taken by img_copies */
+} lvgl_port_ppa_draw_unit_t;
+
+/*******************************************************************************
+ * Function definitions
+ *******************************************************************************/
+
+static int32_t lvgl_port_ppa_draw_evaluate(lv_draw_unit_t *draw_unit, lv_draw_task_t *task);
+static int32_t lvgl_port_ppa_draw_dispatch(lv_draw_unit_t *draw_unit, lv_layer_t *layer);
+static int32_t lvgl_port_ppa_draw_delete(lv_draw_unit_t *draw_unit);
+
+#endif
+
+/*******************************************************************************
+ * Public API functions
+ *******************************************************************************/
+
+esp_err_t lvgl_port_ppa_draw_init(const lvgl_port_ppa_draw_cfg_t *cfg)
+{
+#if LVGL_PORT_PPA_DRAW_SUPPORTED
+    esp_err_t ret = ESP_OK;
+    assert(cfg != NULL);
+
+    lvgl_port_ppa_draw_unit_t *unit = lv_draw_create_unit(sizeof(lvgl_port_ppa_draw_unit_t));
+    ESP_RETURN_ON_FALSE(unit, ESP_ERR_NO_MEM, TAG, "Not enough memory for PPA draw unit allocation!");
+    unit->cfg                   = *cfg;
+    unit->base_unit.evaluate_cb = lvgl_port_ppa_draw_evaluate;
+    unit->base_unit.dispatch_cb = lvgl_port_ppa_draw_dispatch;
+    unit->base_unit.delete_cb   = lvgl_port_ppa_draw_delete;
+
+    ESP_GOTO_ON_ERROR(esp_cache_get_alignment(MALLOC_CAP_SPIRAM, &unit->cache_line_size), err, TAG,
+                      "Get cache alignment failed");
+
+    ppa_client_config_t srm_config = {
+        .oper_type             = PPA_OPERATION_SRM,
+        .max_pending_trans_num = 1,
+    };
+    ESP_GOTO_ON_ERROR(ppa_register_client(&srm_config, &unit->srm_handle), err, TAG, "Register PPA SRM failed");
+    ppa_client_config_t blend_config = {
+        .oper_type             = PPA_OPERATION_BLEND,
+        .max_pending_trans_num = 1,
+    };
+    ESP_GOTO_ON_ERROR(ppa_register_client(&blend_config, &unit->blend_handle), err, TAG, "Register PPA blend failed");
+    ppa_client_config_t fill_config = {
+        .oper_type             = PPA_OPERATION_FILL,
+        .max_pending_trans_num = 1,
+    };
+    ESP_GOTO_ON_ERROR(ppa_register_client(&fill_config, &unit->fill_handle), err, TAG, "Register PPA fill failed");
+
+    ESP_LOGI(TAG, "PPA draw unit registered (min area %" PRIu32 " px)", cfg->min_area);
+    return ESP_OK;
+
+err:
+    /* The unit is already linked into LVGL, leave it there with nothing to evaluate */
+    unit->base_unit.evaluate_cb = NULL;
+    lvgl_port_ppa_draw_delete(&unit->base_unit);
+    return ret;
+#else
+    (void)cfg;
+    ESP_LOGW(TAG, "PPA draw unit needs ESP32-P4 and LVGL v9.2 or newer");
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+#if LVGL_PORT_PPA_DRAW_SUPPORTED
+
+/*******************************************************************************
+ * Private functions
+ *******************************************************************************/
+
+static int32_t lvgl_port_ppa_draw_delete(lv_draw_unit_t *draw_unit)
+{
+    lvgl_port_ppa_draw_unit_t *unit = (lvgl_port_ppa_draw_unit_t *)draw_unit;
+
+    if (unit->srm_handle) {
+        ppa_unregister_client(unit->srm_handle);
+        unit->srm_handle = NULL;
+    }
+    if (unit->blend_handle) {
+        ppa_unregister_client(unit->blend_handle);
+        unit->blend_handle = NULL;
+    }
+    if (unit->fill_handle) {
+        ppa_unregister_client(unit->fill_handle);
+        unit->fill_handle = NULL;
+    }
+    for (int i = 0; i < DRAW_PPA_IMG_CACHE_MAX; i++) {
+        dma_buffer_free(unit->img_copies[i].copy);
+        unit->img_copies[i].copy = NULL;
+        unit->img_copies[i].src  = NULL;
+    }
+    unit->img_cache_used = 0;
+    return 0;
+}
+
+static bool lvgl_port_ppa_draw_is_scaled(const lv_draw_image_dsc_t *dsc)
+{
+    return dsc->scale_x != LV_SCALE_NONE || dsc->scale_y != LV_SCALE_NONE;
+}
+
+/* Destination of a scaled image, it is scaled around its pivot */
+static void lvgl_port_ppa_draw_scaled_area(const lv_draw_task_t *t, lv_area_t *area)
+{
+    const lv_draw_image_dsc_t *dsc = t->draw_dsc;
+    int32_t w                      = lv_area_get_width(&t->area);
+    int32_t h                      = lv_area_get_height(&t->area);
+
+    area->x1 = t->area.x1 + dsc->pivot.x - (dsc->pivot.x * dsc->scale_x) / LV_SCALE_NONE;
+    area->y1 = t->area.y1 + dsc->pivot.y - (dsc->pivot.y * dsc->scale_y) / LV_SCALE_NONE;
+    area->x2 = area->x1 + (w * dsc->scale_x) / LV_SCALE_NONE - 1;
+    area->y2 = area->y1 + (h * dsc->scale_y) / LV_SCALE_NONE - 1;
+}
+
+/**
+ * Return the image of an image task, if the PPA can draw it. Rotation, skew, tiling, masks, rounded clipping and
+ * other blend modes are left to SW, as are scaled images that are not opaque or do not scale in SRM steps.
+ */
+static const lv_image_dsc_t *lvgl_port_ppa_draw_image_src(const lv_draw_task_t *t)
+{
+    const lv_draw_image_dsc_t *dsc = t->draw_dsc;
+
+    if (lv_image_src_get_type(dsc->src) != LV_IMAGE_SRC_VARIABLE) {
+        return NULL;
+    }
+    if (dsc->rotation != 0 || dsc->skew_x != 0 || dsc->skew_y != 0 || dsc->clip_radius != 0 || dsc->tile ||
+        dsc->bitmap_mask_src != NULL || dsc->blend_mode != LV_BLEND_MODE_NORMAL) {
+        return NULL;
+    }
+
+    const lv_image_dsc_t *img = dsc->src;
+    if (img->data == NULL || (img->header.flags & (LV_IMAGE_FLAGS_COMPRESSED | LV_IMAGE_FLAGS_PREMULTIPLIED))) {
+        return NULL;
+    }
+    if (lv_area_get_width(&t->area) != img->header.w || lv_area_get_height(&t->area) != img->header.h) {
+        return NULL;
+    }
+
+    /* The PPA takes rows of pic_w pixels, the image must not be padded */
+    uint32_t px_size = lv_color_format_get_size(img->header.cf);
+    uint32_t stride  = img->header.stride ? img->header.stride : img->header.w * px_size;
+    if (stride != img->header.w * px_size) {
+        return NULL;
+    }
+
+    bool scaled = lvgl_port_ppa_draw_is_scaled(dsc);
+    switch (img->header.cf) {
+        case LV_COLOR_FORMAT_RGB565:
+        case LV_COLOR_FORMAT_RGB888:
+            if (dsc->recolor_opa > LV_OPA_MIN) {
+                return NULL;
+            }
+            if (scaled && (dsc->opa < LV_OPA_MAX || dsc->scale_x <= 0 || dsc->scale_y <= 0 ||
+                           dsc->scale_x % DRAW_PPA_SCALE_FRAG != 0 || dsc->scale_y % DRAW_PPA_SCALE_FRAG != 0)) {
+                return NULL;
+            }
+            break;
+        case LV_COLOR_FORMAT_ARGB8888:
+            if (scaled || dsc->recolor_opa > LV_OPA_MIN) {
+                return NULL;
+            }
+            break;
+        case LV_COLOR_FORMAT_A8: /* Drawn with the recolor color */
+            if (scaled) {
+                return NULL;
+            }
+            break;
+        default:
+            return NULL;
+    }
+    return img;
+}
+
+/* Area of the task the PPA would draw, before clipping to the layer */
+static bool lvgl_port_ppa_draw_task_area(const lv_draw_task_t *t, lv_area_t *area)
+{
+    if (t->type == LV_DRAW_TASK_TYPE_IMAGE && lvgl_port_ppa_draw_is_scaled(t->draw_dsc)) {
+        lvgl_port_ppa_draw_scaled_area(t, area);
+        /* A clipped scaled image would start at a fractional source pixel */
+        return lv_area_is_in(area, &t->clip_area, 0);
+    }
+    return lv_area_intersect(area, &t->area, &t->clip_area);
+}
+
+static int32_t lvgl_port_ppa_draw_evaluate(lv_draw_unit_t *draw_unit, lv_draw_task_t *task)
+{
+    lvgl_port_ppa_draw_unit_t *unit = (lvgl_port_ppa_draw_unit_t *)draw_unit;
+    bool supported                  = false;
+
+    switch (task->type) {
+        case LV_DRAW_TASK_TYPE_FILL: {
+            const lv_draw_fill_dsc_t *dsc = task->draw_dsc;
+            supported = dsc->radius == 0 && dsc->grad.dir == LV_GRAD_DIR_NONE && dsc->opa >= LV_OPA_MAX;
+            break;
+        }
+        case LV_DRAW_TASK_TYPE_IMAGE:
+            supported = lvgl_port_ppa_draw_image_src(task) != NULL;
+            break;
+        default:
+            break;
+    }
+
+    lv_area_t area;
+    if (!supported || !lvgl_port_ppa_draw_task_area(task, &area) || lv_area_get_size(&area) < unit->cfg.min_area) {
+        return 0;
+    }
+    if (task->preference_score > DRAW_PPA_SCORE) {
+        task->preference_score       = DRAW_PPA_SCORE;
+        task->preferred_draw_unit_id = DRAW_UNIT_ID_PPA;
+    }
+    return 0;
+}
+
+/**
+ * The PPA writes the layer through DMA. A cache line shared with pixels outside the drawn area could be written back
+ * over the result, so the layer buffer must start and end on cache lines. It must also be unpadded.
+ */
+static bool lvgl_port_ppa_draw_layer_supported(lvgl_port_ppa_draw_unit_t *unit, const lv_layer_t *layer)
+{
+    const lv_draw_buf_t *buf = layer->draw_buf;
+    if (buf == NULL || buf->data == NULL) {
+        return false;
+    }
+    if (buf->header.cf != LV_COLOR_FORMAT_RGB565 && buf->header.cf != LV_COLOR_FORMAT_RGB888) {
+        return false;
+    }
+    if (buf->header.stride != buf->header.w * lv_color_format_get_size(buf->header.cf)) {
+        return false;
+    }
+    return ((uintptr_t)buf->data % unit->cache_line_size) == 0 && (buf->data_size % unit->cache_line_size) == 0;
+}
+
+/* Image data the PPA can read. Flash resident images are copied to PSRAM once and kept. */
+static const void *lvgl_port_ppa_draw_image_data(lvgl_port_ppa_draw_unit_t *unit, const lv_image_dsc_t *img)
+{
+    if (esp_ptr_external_ram(img->data) || esp_ptr_internal(img->data)) {
+        return img->data;
+    }
+
+    int free_slot = -1;
+    for (int i = 0; i < DRAW_PPA_IMG_CACHE_MAX; i++) {
+        if (unit->img_copies[i].src == img->data) {
+            return unit->img_copies[i].copy;
+        }
+        if (free_slot < 0 && unit->img_copies[i].src == NULL) {
+            free_slot = i;
+        }
+    }
+
+    uint32_t size = img->header.w * img->header.h * lv_color_format_get_size(img->header.cf);
+    if (free_slot < 0 || unit->img_cache_used + size > unit->cfg.img_cache_size) {
+        return NULL;
+    }
+    void *copy = dma_buffer_alloc(size, MALLOC_CAP_SPIRAM);
+    if (copy == NULL) {
+        return NULL;
+    }
+    memcpy(copy, img->data, size);
+    unit->img_copies[free_slot].src  = img->data;
+    unit->img_copies[free_slot].copy = copy;
+    unit->img_cache_used += size;
+    ESP_LOGD(TAG, "PPA image copy %p (%" PRIu32 " bytes)", img->data, size);
+    return copy;
+}
+
+static void lvgl_port_ppa_draw_out_config(const lv_layer_t *layer, const lv_area_t *area,
+                                          ppa_out_pic_blk_config_t *out)
+{
+    const lv_draw_buf_t *buf = layer->draw_buf;
+
+    out->buffer         = buf->data;
+    out->buffer_size    = buf->data_size;
+    out->pic_w          = buf->header.w;
+    out->pic_h          = buf->header.h;
+    out->block_offset_x = area->x1 - layer->buf_area.x1;
+    out->block_offset_y = area->y1 - layer->buf_area.y1;
+}
+
+static esp_err_t lvgl_port_ppa_draw_fill(lvgl_port_ppa_draw_unit_t *unit, const lv_draw_task_t *t,
+                                         const lv_layer_t *layer, const lv_area_t *area)
+{
+    const lv_draw_fill_dsc_t *dsc = t->draw_dsc;
+
+    ppa_fill_oper_config_t oper_config = {
+        .out.fill_cm     = (layer->draw_buf->header.cf == LV_COLOR_FORMAT_RGB888) ? PPA_FILL_COLOR_MODE_RGB888
+                                                                                    : PPA_FILL_COLOR_MODE_RGB565,
+        .fill_block_w    = lv_area_get_width(area),
+        .fill_block_h    = lv_area_get_height(area),
+        .fill_argb_color = {.val = lv_color_to_u32(dsc->color)},
+        .mode            = PPA_TRANS_MODE_BLOCKING,
+    };
+    lvgl_port_ppa_draw_out_config(layer, area, &oper_config.out);
+
+    return ppa_do_fill(unit->fill_handle, &oper_config);
+}
+
+/* Opaque RGB images are copied, or scaled, with the SRM */
+static esp_err_t lvgl_port_ppa_draw_image_srm(lvgl_port_ppa_draw_unit_t *unit, const lv_draw_task_t *t,
+                                              const lv_layer_t *layer, const lv_area_t *area,
+                                              const lv_image_dsc_t *img, const void *data)
+{
+    const lv_draw_image_dsc_t *dsc = t->draw_dsc;
+    bool scaled                    = lvgl_port_ppa_draw_is_scaled(dsc);
+
+    ppa_srm_oper_config_t oper_config = {
+        .in.buffer         = data,
+        .in.pic_w          = img->header.w,
+        .in.pic_h          = img->header.h,
+        .in.block_w        = scaled ? img->header.w : lv_area_get_width(area),
+        .in.block_h        = scaled ? img->header.h : lv_area_get_height(area),
+        .in.block_offset_x = scaled ? 0 : area->x1 - t->area.x1,
+        .in.block_offset_y = scaled ? 0 : area->y1 - t->area.y1,
+        .in.srm_cm =
+            (img->header.cf == LV_COLOR_FORMAT_RGB888) ? PPA_SRM_COLOR_MODE_RGB888 : PPA_SRM_COLOR_MODE_RGB565,
+
+        .out.srm_cm = (layer->draw_buf->header.cf == LV_COLOR_FORMAT_RGB888) ? PPA_SRM_COLOR_MODE_RGB888
+                                                                               : PPA_SRM_COLOR_MODE_RGB565,
+
+        .rotation_angle = PPA_SRM_ROTATION_ANGLE_0,
+        .scale_x        = (float)dsc->scale_x / LV_SCALE_NONE,
+        .scale_y        = (float)dsc->scale_y / LV_SCALE_NONE,
+        .rgb_swap       = 0,
+        .byte_swap      = 0,
+        .mode           = PPA_TRANS_MODE_BLOCKING,
+    };
+    lvgl_port_ppa_draw_out_config(layer, area, &oper_config.out);
+
+    return ppa_do_scale_rotate_mirror(unit->srm_handle, &oper_config);
+}
+
+/* Images with opacity, alpha or an A8 mask are blended over the layer in place */
+static esp_err_t lvgl_port_ppa_draw_image_blend(lvgl_port_ppa_draw_unit_t *unit, const lv_draw_task_t *t,
+                                                const lv_layer_t *layer, const lv_area_t *area,
+                                                const lv_image_dsc_t *img, const void *data)
+{
+    const lv_draw_image_dsc_t *dsc = t->draw_dsc;
+    const lv_draw_buf_t *buf       = layer->draw_buf;
+    ppa_blend_color_mode_t bg_cm =
+        (buf->header.cf == LV_COLOR_FORMAT_RGB888) ? PPA_BLEND_COLOR_MODE_RGB888 : PPA_BLEND_COLOR_MODE_RGB565;
+
+    ppa_blend_color_mode_t fg_cm;
+    switch (img->header.cf) {
+        case LV_COLOR_FORMAT_RGB888:
+            fg_cm = PPA_BLEND_COLOR_MODE_RGB888;
+            break;
+        case LV_COLOR_FORMAT_ARGB8888:
+            fg_cm = PPA_BLEND_COLOR_MODE_ARGB8888;
+            break;
+        case LV_COLOR_FORMAT_A8:
+            fg_cm = PPA_BLEND_COLOR_MODE_A8;
+            break;
+        default:
+            fg_cm = PPA_BLEND_COLOR_MODE_RGB565;
+            break;
+    }
+
+    ppa_blend_oper_config_t oper_config = {
+        .in_bg.buffer         = buf->data,
+        .in_bg.pic_w          = buf->header.w,
+        .in_bg.pic_h          = buf->header.h,
+        .in_bg.block_w        = lv_area_get_width(area),
+        .in_bg.block_h        = lv_area_get_height(area),
+        .in_bg.block_offset_x = area->x1 - layer->buf_area.x1,
+        .in_bg.block_offset_y = area->y1 - layer->buf_area.y1,
+        .in_bg.blend_cm       = bg_cm,
+
+        .in_fg.buffer         = data,
+        .in_fg.pic_w          = img->header.w,
+        .in_fg.pic_h          = img->header.h,
+        .in_fg.block_w        = lv_area_get_width(area),
+        .in_fg.block_h        = lv_area_get_height(area),
+        .in_fg.block_offset_x = area->x1 - t->area.x1,
+        .in_fg.block_offset_y = area->y1 - t->area.y1,
+        .in_fg.blend_cm       = fg_cm,
+
+        .out.blend_cm = bg_cm,
+
+        .bg_alpha_update_mode = PPA_ALPHA_NO_CHANGE,
+        .fg_fix_rgb_val       = {.b = dsc->recolor.blue, .g = dsc->recolor.green, .r = dsc->recolor.red},
+        .mode                 = PPA_TRANS_MODE_BLOCKING,
+    };
+    lvgl_port_ppa_draw_out_config(layer, area, &oper_config.out);
+
+    if (fg_cm == PPA_BLEND_COLOR_MODE_RGB565 || fg_cm == PPA_BLEND_COLOR_MODE_RGB888) {
+        /* No alpha channel, the opacity is the alpha of every pixel */
+        oper_config.fg_alpha_update_mode = PPA_ALPHA_FIX_VALUE;
+        oper_config.fg_alpha_fix_val     = dsc->opa;
+    } else if (dsc->opa < LV_OPA_MAX) {
+        oper_config.fg_alpha_update_mode = PPA_ALPHA_SCALE;
+        oper_config.fg_alpha_scale_ratio = (float)dsc->opa / LV_OPA_COVER;
+    } else {
+        oper_config.fg_alpha_update_mode = PPA_ALPHA_NO_CHANGE;
+    }
+
+    return ppa_do_blend(unit->blend_handle, &oper_config);
+}
+
+static esp_err_t lvgl_port_ppa_draw_image(lvgl_port_ppa_draw_unit_t *unit, const lv_draw_task_t *t,
+                                          const lv_layer_t *layer, const lv_area_t *area)
+{
+    const lv_draw_image_dsc_t *dsc = t->draw_dsc;
+    const lv_image_dsc_t *img      = lvgl_port_ppa_draw_image_src(t);
+    const void *data               = img ? lvgl_port_ppa_draw_image_data(unit, img) : NULL;
+    if (data == NULL) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    bool opaque = (img->header.cf == LV_COLOR_FORMAT_RGB565 || img->header.cf == LV_COLOR_FORMAT_RGB888) &&
+                  dsc->opa >= LV_OPA_MAX;
+    if (opaque) {
+        return lvgl_port_ppa_draw_image_srm(unit, t, layer, area, img, data);
+    }
+    return lvgl_port_ppa_draw_image_blend(unit, t, layer, area, img, data);
+}
+
+/* Give a task the PPA can not draw on this layer back to the other draw units */
+static void lvgl_port_ppa_draw_reject(lv_draw_task_t *t)
+{
+    t->preferred_draw_unit_id = LV_DRAW_UNIT_NONE;
+    t->preference_score       = 100;
+    lv_draw_dispatch_request();
+}
+
+static int32_t lvgl_port_ppa_draw_dispatch(lv_draw_unit_t *draw_unit, lv_layer_t *layer)
+{
+    lvgl_port_ppa_draw_unit_t *unit = (lvgl_port_ppa_draw_unit_t *)draw_unit;
+
+    /* Tasks without a preference are offered to every unit, only take the ones evaluated for the PPA */
+    lv_draw_task_t *t = NULL;
+    do {
+        t = lv_draw_get_next_available_task(layer, t, DRAW_UNIT_ID_PPA);
+    } while (t != NULL && t->preferred_draw_unit_id != DRAW_UNIT_ID_PPA);
+    if (t == NULL) {
+        return LV_DRAW_UNIT_IDLE;
+    }
+
+    /* SW units drawing the same layer may hold cache lines the PPA is about to write, let them finish first */
+    for (lv_draw_task_t *other = layer->draw_task_head; other != NULL; other = other->next) {
+        if (other->state == LV_DRAW_TASK_STATE_IN_PROGRESS) {
+            return 0;
+        }
+    }
+
+    if (lv_draw_layer_alloc_buf(layer) == NULL) {
+        return LV_DRAW_UNIT_IDLE;
+    }
+    if (!lvgl_port_ppa_draw_layer_supported(unit, layer)) {
+        lvgl_port_ppa_draw_reject(t);
+        return LV_DRAW_UNIT_IDLE;
+    }
+
+    lv_area_t area;
+    bool visible = lvgl_port_ppa_draw_task_area(t, &area);
+    if (visible && t->type == LV_DRAW_TASK_TYPE_IMAGE && lvgl_port_ppa_draw_is_scaled(t->draw_dsc)) {
+        if (!lv_area_is_in(&area, &layer->buf_area, 0)) {
+            lvgl_port_ppa_draw_reject(t);
+            return LV_DRAW_UNIT_IDLE;
+        }
+    } else if (visible) {
+        visible = lv_area_intersect(&area, &area, &layer->buf_area);
+    }
+
+    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    if (visible) {
+        esp_err_t ret = (t->type == LV_DRAW_TASK_TYPE_FILL) ? lvgl_port_ppa_draw_fill(unit, t, layer, &area)
+                                                            : lvgl_port_ppa_draw_image(unit, t, layer, &area);
+        if (ret != ESP_OK) {
+            t->state = LV_DRAW_TASK_STATE_QUEUED;
+            lvgl_port_ppa_draw_reject(t);
+            return LV_DRAW_UNIT_IDLE;
+        }
+    }
+    t->state = LV_DRAW_TASK_STATE_READY;
+
+    /* Let the dispatcher hand out the tasks that depended on this one */
+    lv_draw_dispatch_request();
+    return 1;
+}
+
+#endif
@@ -17,6 +17,15 @@ extern "C" {
 
 // ------------------------------------------------- Macros and Types --------------------------------------------------
 
+/**
+ * @brief Fill variant under test
+ */
+typedef enum {
+    FILL_MODE_SIMPLE = 0,  // Full opacity, no mask
+    FILL_MODE_WITH_OPA,    // Opacity below LV_OPA_MAX, no mask
+    FILL_MODE_WITH_MASK,   // Full opacity, through a mask
+} fill_mode_t;
+
 /**
  * @brief Functionality test combinations
  */
@@ -41,6 +50,7 @@ typedef struct {
         void *p_ansi;        // pointer to the working ANSI test buf
         void *p_asm_alloc;   // pointer to the beginning of the memory allocated for ASM test buf, used in free()
         void *p_ansi_alloc;  // pointer to the beginning of the memory allocated for ANSI test buf, used in free()
+        uint8_t *p_mask;     // pointer to the mask, common for both the ASM and ANSI, NULL without a mask
     } buf;
     void (*blend_api_func)(_lv_draw_sw_blend_fill_dsc_t *);  // pointer to LVGL API function
     void (*blend_api_px_func)(_lv_draw_sw_blend_fill_dsc_t *,
@@ -53,6 +63,8 @@ typedef struct {
     unsigned int dest_h;        // Destination buffer height
     unsigned int dest_stride;   // Destination buffer stride
     unsigned int unalign_byte;  // Destination buffer memory unalignment
+    fill_mode_t mode;           // Fill variant, FILL_MODE_SIMPLE by default
+    lv_opa_t opa;               // Opacity for FILL_MODE_WITH_OPA
 } func_test_case_params_t;
 
 /**
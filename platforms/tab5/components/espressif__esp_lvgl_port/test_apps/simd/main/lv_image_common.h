@@ -23,6 +23,7 @@ extern "C" {
 typedef enum {
     OPERATION_FILL,
     OPERATION_FILL_WITH_OPA,
+    OPERATION_FILL_WITH_MASK,
 } blend_operation_t;
 
 /**
@@ -72,6 +73,7 @@ typedef struct {
                                     used in free() */
         void *p_dest_ansi_alloc; /*!< pointer to the beginning of the memory allocated for the destination ANSI test
                                     buf, used in free() */
+        uint8_t *p_mask;         /*!< pointer to the mask (common for both the ANSI and ASM), NULL without a mask */
     } buf;
     void (*blend_api_func)(_lv_draw_sw_blend_image_dsc_t *); /*!< pointer to LVGL API function */
     lv_color_format_t color_format;                          /*!< LV color format */
@@ -92,6 +94,7 @@ typedef struct {
     unsigned int src_unalign_byte;    /*!< Source buffer memory unalignment */
     unsigned int dest_unalign_byte;   /*!< Destination buffer memory unalignment */
     blend_operation_t operation_type; /*!< Type of fundamental blend operation */
+    lv_opa_t opa;                     /*!< Opacity for OPERATION_FILL_WITH_OPA */
 } func_test_case_lv_image_params_t;
 
 /**
@@ -10,7 +10,7 @@
 
 #include "unity.h"
 #include "esp_log.h"
-#include "freertos/FreeRTOS.h"  // for xthal_get_ccount()
+#include "esp_cpu.h"  // for esp_cpu_get_cycle_count()
 #include "lv_fill_common.h"
 #include "lv_draw_sw_blend.h"
 #include "lv_draw_sw_blend_to_argb8888.h"
@@ -201,7 +201,7 @@ static float lv_fill_benchmark_run(bench_test_case_params_t *test_params, _lv_dr
         test_params->blend_api_px_func(dsc, 3);
     }
 
-    const unsigned int start_b = xthal_get_ccount();
+    const unsigned int start_b = esp_cpu_get_cycle_count();
     if (test_params->blend_api_func != NULL) {
         for (int i = 0; i < test_params->benchmark_cycles; i++) {
             test_params->blend_api_func(dsc);
@@ -211,7 +211,7 @@ static float lv_fill_benchmark_run(bench_test_case_params_t *test_params, _lv_dr
             test_params->blend_api_px_func(dsc, 3);
         }
     }
-    const unsigned int end_b = xthal_get_ccount();
+    const unsigned int end_b = esp_cpu_get_cycle_count();
 
     const float total_b = end_b - start_b;
     const float cycles  = total_b / (test_params->benchmark_cycles);
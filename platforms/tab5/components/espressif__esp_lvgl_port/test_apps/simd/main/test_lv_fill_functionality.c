@@ -41,6 +41,9 @@ static lv_color_t test_color = {
     .red   = 0x12,
 };
 
+// Opacities for the WITH_OPA variants, from barely visible to just below LV_OPA_MAX
+static const lv_opa_t test_opa[] = {1, 4, 64, 127, 128, 200, 252};
+
 // ------------------------------------------------ Static function headers --------------------------------------------
 
 /**
@@ -157,6 +160,59 @@ TEST_CASE("Test fill functionality RGB565", "[fill][functionality][RGB565]")
     functionality_test_matrix(&test_matrix, &test_case);
 }
 
+TEST_CASE("Test fill functionality RGB565 with opa", "[fill][functionality][RGB565][opa]")
+{
+    test_matrix_params_t test_matrix = {
+        .min_w                   = 1,
+        .min_h                   = 1,
+        .max_w                   = 24,
+        .max_h                   = 3,
+        .min_unalign_byte        = 0,
+        .max_unalign_byte        = 16,
+        .unalign_step            = 1,
+        .dest_stride_step        = 1,
+        .test_combinations_count = 0,
+    };
+
+    func_test_case_params_t test_case = {
+        .blend_api_func = &lv_draw_sw_blend_color_to_rgb565,
+        .color_format   = LV_COLOR_FORMAT_RGB565,
+        .data_type_size = sizeof(uint16_t),
+        .mode           = FILL_MODE_WITH_OPA,
+    };
+
+    for (int i = 0; i < sizeof(test_opa) / sizeof(test_opa[0]); i++) {
+        test_case.opa = test_opa[i];
+        ESP_LOGI(TAG_LV_FILL_FUNC, "running test for RGB565 color format, opa = %d", test_case.opa);
+        functionality_test_matrix(&test_matrix, &test_case);
+    }
+}
+
+TEST_CASE("Test fill functionality RGB565 with mask", "[fill][functionality][RGB565][mask]")
+{
+    test_matrix_params_t test_matrix = {
+        .min_w                   = 1,
+        .min_h                   = 1,
+        .max_w                   = 24,
+        .max_h                   = 3,
+        .min_unalign_byte        = 0,
+        .max_unalign_byte        = 16,
+        .unalign_step            = 1,
+        .dest_stride_step        = 1,
+        .test_combinations_count = 0,
+    };
+
+    func_test_case_params_t test_case = {
+        .blend_api_func = &lv_draw_sw_blend_color_to_rgb565,
+        .color_format   = LV_COLOR_FORMAT_RGB565,
+        .data_type_size = sizeof(uint16_t),
+        .mode           = FILL_MODE_WITH_MASK,
+    };
+
+    ESP_LOGI(TAG_LV_FILL_FUNC, "running test for RGB565 color format with mask");
+    functionality_test_matrix(&test_matrix, &test_case);
+}
+
 TEST_CASE("Test fill functionality RGB888", "[fill][functionality][RGB888]")
 {
     test_matrix_params_t test_matrix = {
@@ -214,9 +270,10 @@ static void lv_fill_functionality(func_test_case_params_t *test_case)
         .dest_w      = test_case->dest_w,
         .dest_h      = test_case->dest_h,
         .dest_stride = test_case->dest_stride * test_case->data_type_size,  // stride * sizeof()
-        .mask_buf    = NULL,
+        .mask_buf    = test_case->buf.p_mask,
+        .mask_stride = test_case->dest_w,
         .color       = test_color,
-        .opa         = LV_OPA_MAX,
+        .opa         = (test_case->mode == FILL_MODE_WITH_OPA) ? test_case->opa : LV_OPA_MAX,
         .use_asm     = true,
     };
 
@@ -238,8 +295,10 @@ static void lv_fill_functionality(func_test_case_params_t *test_case)
     test_case->buf.p_ansi -= CANARY_BYTES * test_case->data_type_size;
 
     // Evaluate the results
-    sprintf(test_msg_buf, "Test case: dest_w = %d, dest_h = %d, dest_stride = %d, unalign_byte = %d\n",
-            test_case->dest_w, test_case->dest_h, test_case->dest_stride, test_case->unalign_byte);
+    sprintf(test_msg_buf,
+            "Test case: dest_w = %d, dest_h = %d, dest_stride = %d, unalign_byte = %d, mode = %d, opa = %d\n",
+            test_case->dest_w, test_case->dest_h, test_case->dest_stride, test_case->unalign_byte, test_case->mode,
+            test_case->opa);
 
     switch (test_case->color_format) {
         case LV_COLOR_FORMAT_ARGB8888: {
@@ -263,6 +322,7 @@ static void lv_fill_functionality(func_test_case_params_t *test_case)
 
     free(test_case->buf.p_asm_alloc);
     free(test_case->buf.p_ansi_alloc);
+    free(test_case->buf.p_mask);
 }
 
 static void fill_test_bufs(func_test_case_params_t *test_case)
@@ -298,6 +358,28 @@ static void fill_test_bufs(func_test_case_params_t *test_case)
         dest_buf_ansi[i * data_type_size] = (uint8_t)(i % 255);
     }
 
+    // The mix variants need whole pixels of varied colors, with runs of equal ones
+    if (test_case->mode != FILL_MODE_SIMPLE && test_case->color_format == LV_COLOR_FORMAT_RGB565) {
+        for (int i = CANARY_BYTES; i < active_buf_len + CANARY_BYTES; i++) {
+            uint16_t pixel = (i % 7 < 2) ? 0x9966 : (uint16_t)(i * 0x1F3D + 0x55AA);
+            memcpy(&dest_buf_asm[i * data_type_size], &pixel, sizeof(pixel));
+            memcpy(&dest_buf_ansi[i * data_type_size], &pixel, sizeof(pixel));
+        }
+    }
+
+    // The mask covers dest_w x dest_h, with fully transparent and fully opaque values among the partial ones
+    test_case->buf.p_mask = NULL;
+    if (test_case->mode == FILL_MODE_WITH_MASK) {
+        const size_t mask_len = test_case->dest_w * test_case->dest_h;
+        test_case->buf.p_mask = malloc(mask_len);
+        TEST_ASSERT_NOT_NULL_MESSAGE(test_case->buf.p_mask, "Lack of memory");
+        for (int i = 0; i < mask_len; i++) {
+            test_case->buf.p_mask[i] = (i % 5 == 0)   ? LV_OPA_TRANSP
+                                       : (i % 5 == 1) ? LV_OPA_COVER
+                                                      : (uint8_t)(i * 37 + 11);
+        }
+    }
+
     // Shift array pointers by Canary Bytes amount
     dest_buf_asm += CANARY_BYTES * data_type_size;
     dest_buf_ansi += CANARY_BYTES * data_type_size;
@@ -10,7 +10,7 @@
 
 #include "unity.h"
 #include "esp_log.h"
-#include "freertos/FreeRTOS.h"  // for xthal_get_ccount()
+#include "esp_cpu.h"  // for esp_cpu_get_cycle_count()
 #include "lv_image_common.h"
 #include "lv_draw_sw_blend.h"
 #include "lv_draw_sw_blend_to_rgb565.h"
@@ -170,11 +170,11 @@ static float lv_image_benchmark_run(bench_test_case_lv_image_params_t *test_para
     // Call the DUT function for the first time to init the benchmark test
     test_params->blend_api_func(dsc);
 
-    const unsigned int start_b = xthal_get_ccount();
+    const unsigned int start_b = esp_cpu_get_cycle_count();
     for (int i = 0; i < test_params->benchmark_cycles; i++) {
         test_params->blend_api_func(dsc);
     }
-    const unsigned int end_b = xthal_get_ccount();
+    const unsigned int end_b = esp_cpu_get_cycle_count();
 
     const float total_b = end_b - start_b;
     const float cycles  = total_b / (test_params->benchmark_cycles);
@@ -67,6 +67,27 @@ static const test_matrix_lv_image_params_t default_test_matrix_image_rgb565_blen
     .test_combinations_count = 0,
 };
 
+// The opacity and mask variants mix every pixel, a lighter matrix keeps the run short. Source unalignment steps
+// through word aligned and halfword aligned buffers, the destination one through odd buffers too
+static const test_matrix_lv_image_params_t default_test_matrix_image_blend_mix = {
+    .min_w                   = 1,
+    .min_h                   = 1,
+    .max_w                   = 16,
+    .max_h                   = 2,
+    .src_min_unalign_byte    = 0,
+    .dest_min_unalign_byte   = 0,
+    .src_max_unalign_byte    = 4,
+    .dest_max_unalign_byte   = 4,
+    .src_unalign_step        = 2,
+    .dest_unalign_step       = 1,
+    .src_stride_step         = 2,
+    .dest_stride_step        = 2,
+    .test_combinations_count = 0,
+};
+
+// Opacities for the WITH_OPA variants, from barely visible to just below LV_OPA_MAX
+static const lv_opa_t test_opa[] = {1, 4, 64, 127, 128, 200, 252};
+
 // ------------------------------------------------ Static function headers --------------------------------------------
 
 /**
@@ -139,6 +160,95 @@ TEST_CASE("LV Image functionality RGB565 blend to RGB565", "[image][functionalit
     functionality_test_matrix(&test_matrix, &test_case);
 }
 
+TEST_CASE("LV Image functionality RGB565 blend to RGB565 with opa", "[image][functionality][RGB565][opa]")
+{
+    func_test_case_lv_image_params_t test_case = {
+        .blend_api_func      = &lv_draw_sw_blend_image_to_rgb565,
+        .color_format        = LV_COLOR_FORMAT_RGB565,
+        .canary_pixels       = CANARY_PIXELS_RGB565,
+        .src_data_type_size  = sizeof(uint16_t),
+        .dest_data_type_size = sizeof(uint16_t),
+        .operation_type      = OPERATION_FILL_WITH_OPA,
+    };
+
+    for (int i = 0; i < sizeof(test_opa) / sizeof(test_opa[0]); i++) {
+        test_matrix_lv_image_params_t test_matrix = default_test_matrix_image_blend_mix;
+        test_case.opa                             = test_opa[i];
+        ESP_LOGI(TAG_LV_IMAGE_FUNC, "running test for RGB565 color format, opa = %d", test_case.opa);
+        functionality_test_matrix(&test_matrix, &test_case);
+    }
+}
+
+TEST_CASE("LV Image functionality RGB565 blend to RGB565 with mask", "[image][functionality][RGB565][mask]")
+{
+    test_matrix_lv_image_params_t test_matrix = default_test_matrix_image_blend_mix;
+
+    func_test_case_lv_image_params_t test_case = {
+        .blend_api_func      = &lv_draw_sw_blend_image_to_rgb565,
+        .color_format        = LV_COLOR_FORMAT_RGB565,
+        .canary_pixels       = CANARY_PIXELS_RGB565,
+        .src_data_type_size  = sizeof(uint16_t),
+        .dest_data_type_size = sizeof(uint16_t),
+        .operation_type      = OPERATION_FILL_WITH_MASK,
+    };
+
+    ESP_LOGI(TAG_LV_IMAGE_FUNC, "running test for RGB565 color format with mask");
+    functionality_test_matrix(&test_matrix, &test_case);
+}
+
+TEST_CASE("LV Image functionality ARGB8888 blend to RGB565", "[image][functionality][ARGB8888]")
+{
+    test_matrix_lv_image_params_t test_matrix = default_test_matrix_image_blend_mix;
+
+    func_test_case_lv_image_params_t test_case = {
+        .blend_api_func      = &lv_draw_sw_blend_image_to_rgb565,
+        .color_format        = LV_COLOR_FORMAT_ARGB8888,
+        .canary_pixels       = CANARY_PIXELS_RGB565,
+        .src_data_type_size  = sizeof(uint32_t),
+        .dest_data_type_size = sizeof(uint16_t),
+        .operation_type      = OPERATION_FILL,
+    };
+
+    ESP_LOGI(TAG_LV_IMAGE_FUNC, "running test for ARGB8888 color format");
+    functionality_test_matrix(&test_matrix, &test_case);
+}
+
+TEST_CASE("LV Image functionality ARGB8888 blend to RGB565 with opa", "[image][functionality][ARGB8888][opa]")
+{
+    func_test_case_lv_image_params_t test_case = {
+        .blend_api_func      = &lv_draw_sw_blend_image_to_rgb565,
+        .color_format        = LV_COLOR_FORMAT_ARGB8888,
+        .canary_pixels       = CANARY_PIXELS_RGB565,
+        .src_data_type_size  = sizeof(uint32_t),
+        .dest_data_type_size = sizeof(uint16_t),
+        .operation_type      = OPERATION_FILL_WITH_OPA,
+    };
+
+    for (int i = 0; i < sizeof(test_opa) / sizeof(test_opa[0]); i++) {
+        test_matrix_lv_image_params_t test_matrix = default_test_matrix_image_blend_mix;
+        test_case.opa                             = test_opa[i];
+        ESP_LOGI(TAG_LV_IMAGE_FUNC, "running test for ARGB8888 color format, opa = %d", test_case.opa);
+        functionality_test_matrix(&test_matrix, &test_case);
+    }
+}
+
+TEST_CASE("LV Image functionality ARGB8888 blend to RGB565 with mask", "[image][functionality][ARGB8888][mask]")
+{
+    test_matrix_lv_image_params_t test_matrix = default_test_matrix_image_blend_mix;
+
+    func_test_case_lv_image_params_t test_case = {
+        .blend_api_func      = &lv_draw_sw_blend_image_to_rgb565,
+        .color_format        = LV_COLOR_FORMAT_ARGB8888,
+        .canary_pixels       = CANARY_PIXELS_RGB565,
+        .src_data_type_size  = sizeof(uint32_t),
+        .dest_data_type_size = sizeof(uint16_t),
+        .operation_type      = OPERATION_FILL_WITH_MASK,
+    };
+
+    ESP_LOGI(TAG_LV_IMAGE_FUNC, "running test for ARGB8888 color format with mask");
+    functionality_test_matrix(&test_matrix, &test_case);
+}
+
 // ------------------------------------------------ Static test functions ----------------------------------------------
 
 static void functionality_test_matrix(test_matrix_lv_image_params_t *test_matrix,
@@ -184,12 +294,12 @@ static void lv_image_functionality(func_test_case_lv_image_params_t *test_case)
         .dest_w           = test_case->dest_w,
         .dest_h           = test_case->dest_h,
         .dest_stride      = test_case->dest_stride * test_case->dest_data_type_size,  // dest_stride * sizeof(data_type)
-        .mask_buf         = NULL,
-        .mask_stride      = 0,
+        .mask_buf         = test_case->buf.p_mask,
+        .mask_stride      = test_case->dest_w,
         .src_buf          = test_case->buf.p_src,
         .src_stride       = test_case->src_stride * test_case->src_data_type_size,  // src_stride * sizeof(data_type)
         .src_color_format = test_case->color_format,
-        .opa              = LV_OPA_MAX,
+        .opa              = (test_case->operation_type == OPERATION_FILL_WITH_OPA) ? test_case->opa : LV_OPA_MAX,
         .blend_mode       = LV_BLEND_MODE_NORMAL,
         .use_asm          = true,
     };
@@ -209,14 +319,15 @@ static void lv_image_functionality(func_test_case_lv_image_params_t *test_case)
     // Evaluate the results
     sprintf(test_msg_buf,
             "Test case: dest_w = %d, dest_h = %d, dest_stride = %d, src_stride = %d, dest_unalign_byte = %d, "
-            "src_unalign_byte = %d\n",
+            "src_unalign_byte = %d, operation = %d, opa = %d\n",
             test_case->dest_w, test_case->dest_h, test_case->dest_stride, test_case->src_stride,
-            test_case->dest_unalign_byte, test_case->src_unalign_byte);
+            test_case->dest_unalign_byte, test_case->src_unalign_byte, test_case->operation_type, test_case->opa);
 #if DBG_PRINT_OUTPUT
     printf("%s\n", test_msg_buf);
 #endif
     switch (test_case->color_format) {
         case LV_COLOR_FORMAT_RGB565:
+        case LV_COLOR_FORMAT_ARGB8888:
             test_eval_image_16bit_data(test_case);
             break;
         default:
@@ -228,6 +339,7 @@ static void lv_image_functionality(func_test_case_lv_image_params_t *test_case)
     free(test_case->buf.p_dest_asm_alloc);
     free(test_case->buf.p_dest_ansi_alloc);
     free(test_case->buf.p_src_alloc);
+    free(test_case->buf.p_mask);
 }
 
 static void fill_test_bufs(func_test_case_lv_image_params_t *test_case)
@@ -267,29 +379,43 @@ static void fill_test_bufs(func_test_case_lv_image_params_t *test_case)
 
     // Set the whole buffer to 0, including the Canary pixels part
     memset(src_buf_common, 0, src_buf_len * src_data_type_size);
-    memset(dest_buf_asm, 0, total_dest_buf_len * src_data_type_size);
-    memset(dest_buf_ansi, 0, total_dest_buf_len * src_data_type_size);
+    memset(dest_buf_asm, 0, total_dest_buf_len * dest_data_type_size);
+    memset(dest_buf_ansi, 0, total_dest_buf_len * dest_data_type_size);
 
     switch (test_case->operation_type) {
         case OPERATION_FILL:
+        case OPERATION_FILL_WITH_OPA:
+        case OPERATION_FILL_WITH_MASK:
             // Fill the actual part of the destination buffers with known values,
             // Values must be same, because of the stride
 
-            if (test_case->color_format == LV_COLOR_FORMAT_RGB565) {
+            if (dest_data_type_size == sizeof(uint16_t)) {
                 uint16_t *dest_buf_asm_uint16  = (uint16_t *)dest_buf_asm;
                 uint16_t *dest_buf_ansi_uint16 = (uint16_t *)dest_buf_ansi;
-                uint16_t *src_buf_uint16       = (uint16_t *)src_buf_common;
 
                 // Fill destination buffers
                 for (int i = 0; i < active_dest_buf_len; i++) {
                     dest_buf_asm_uint16[canary_pixels + i]  = i + ((i & 1) ? 0x6699 : 0x9966);
                     dest_buf_ansi_uint16[canary_pixels + i] = dest_buf_asm_uint16[canary_pixels + i];
                 }
+            }
 
-                // Fill source buffer
+            // Fill source buffer
+            if (test_case->color_format == LV_COLOR_FORMAT_RGB565) {
+                uint16_t *src_buf_uint16 = (uint16_t *)src_buf_common;
                 for (int i = 0; i < src_buf_len; i++) {
                     src_buf_uint16[i] = i + ((i & 1) ? 0x55AA : 0xAA55);
                 }
+            } else if (test_case->color_format == LV_COLOR_FORMAT_ARGB8888) {
+                // Fully transparent and fully opaque pixels among the partial ones, the buffer may be unaligned
+                uint32_t *src_buf_uint32 = (uint32_t *)src_buf_common;
+                for (int i = 0; i < src_buf_len; i++) {
+                    uint32_t alpha = (i % 5 == 0)   ? LV_OPA_TRANSP
+                                     : (i % 5 == 1) ? LV_OPA_COVER
+                                                    : (uint32_t)(i * 53 + 7) & 0xFF;
+                    uint32_t pixel = (alpha << 24) | ((i * 0x9E3779u) & 0xFFFFFF);
+                    memcpy(&src_buf_uint32[i], &pixel, sizeof(pixel));
+                }
             }
 
             break;
@@ -298,6 +424,19 @@ static void fill_test_bufs(func_test_case_lv_image_params_t *test_case)
             break;
     }
 
+    // The mask covers dest_w x dest_h, with fully transparent and fully opaque values among the partial ones
+    test_case->buf.p_mask = NULL;
+    if (test_case->operation_type == OPERATION_FILL_WITH_MASK) {
+        const size_t mask_len = test_case->dest_w * test_case->dest_h;
+        test_case->buf.p_mask = malloc(mask_len);
+        TEST_ASSERT_NOT_NULL_MESSAGE(test_case->buf.p_mask, "Lack of memory");
+        for (int i = 0; i < mask_len; i++) {
+            test_case->buf.p_mask[i] = (i % 7 == 0)   ? LV_OPA_TRANSP
+                                       : (i % 7 == 1) ? LV_OPA_COVER
+                                                      : (uint8_t)(i * 37 + 11);
+        }
+    }
+
     // Shift array pointers by (Canary pixels amount * data type length) forward
     dest_buf_asm += canary_pixels * dest_data_type_size;
     dest_buf_ansi += canary_pixels * dest_data_type_size;
@@ -356,13 +495,16 @@ static void test_eval_image_16bit_data(func_test_case_lv_image_params_t *test_ca
                                            (uint16_t *)test_case->buf.p_dest_asm + canary_pixels,
                                            test_case->active_dest_buf_len, test_msg_buf);
 
-    // Data part of the destination buffer and source buffer (not considering matrix padding) must be equal
-    uint16_t *dest_row_begin = (uint16_t *)test_case->buf.p_dest_asm + canary_pixels;
-    uint16_t *src_row_begin  = (uint16_t *)test_case->buf.p_src;
-    for (int row = 0; row < test_case->dest_h; row++) {
-        TEST_ASSERT_EQUAL_UINT16_ARRAY_MESSAGE(dest_row_begin, src_row_begin, test_case->dest_w, test_msg_buf);
-        dest_row_begin += test_case->dest_stride;  // Move pointer of the destination buffer to the next row
-        src_row_begin += test_case->src_stride;    // Move pointer of the source buffer to the next row
+    // Data part of the destination buffer and source buffer (not considering matrix padding) must be equal, for a
+    // plain RGB565 copy
+    if (test_case->operation_type == OPERATION_FILL && test_case->color_format == LV_COLOR_FORMAT_RGB565) {
+        uint16_t *dest_row_begin = (uint16_t *)test_case->buf.p_dest_asm + canary_pixels;
+        uint16_t *src_row_begin  = (uint16_t *)test_case->buf.p_src;
+        for (int row = 0; row < test_case->dest_h; row++) {
+            TEST_ASSERT_EQUAL_UINT16_ARRAY_MESSAGE(dest_row_begin, src_row_begin, test_case->dest_w, test_msg_buf);
+            dest_row_begin += test_case->dest_stride;  // Move pointer of the destination buffer to the next row
+            src_row_begin += test_case->src_stride;    // Move pointer of the source buffer to the next row
+        }
     }
 
     // Canary pixels area must stay 0
@@ -19,6 +19,13 @@ float fast_log2(float x);
 float fast_powf(float a, float b);
 void fast_get_min_max(float *data, size_t data_len, float *p_min, float *p_max);
 
+// 批量版本，结果与逐个调用标量版本相同，in 和 out 可以是同一个缓冲区
+void fast_expf_batch(const float *in, float *out, size_t len);
+void fast_log2_batch(const float *in, float *out, size_t len);
+void fast_atan2f_batch(const float *y, const float *x, float *out, size_t len);
+// int16 数组的最小值和最大值，ESP32-P4 上用 PIE 向量指令，data_len 为 0 时返回 INT16_MAX 和 INT16_MIN
+void fast_get_min_max_s16(const int16_t *data, size_t data_len, int16_t *p_min, int16_t *p_max);
+
 // 快速平方根函数
 static inline float fast_sqrtf(float x)
 {
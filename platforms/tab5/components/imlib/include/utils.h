@@ -13,6 +13,8 @@ extern "C" {
 
 int image_jpg_read(image_t** img_out, char* path);
 
+void image_jpg_free(image_t* img);
+
 int utf8_to_unicode(const char* utf8_in, uint64_t* unicode_out);
 
 #ifdef __cplusplus
@@ -296,41 +296,130 @@ void imlib_draw_arrow(image_t *img, int x0, int y0, int x1, int y1, int c, int t
     imlib_draw_line(img, x1, y1, a1x, a1y, c, th);
 }
 
+typedef uint32_t __attribute__((may_alias)) uint32_alias_t;
+
+/**
+ * 填充 RGB565 水平线段，两个像素一个 32 位字写入，循环展开
+ */
+static void fill_rgb565_span(uint16_t *dst, int n, uint16_t c)
+{
+    if (((uintptr_t)dst & 2) && (n > 0)) {
+        *dst++ = c;
+        n--;
+    }
+
+    uint32_t c2        = c | ((uint32_t)c << 16);
+    uint32_alias_t *dw = (uint32_alias_t *)dst;
+    for (; n >= 8; n -= 8) {
+        dw[0] = c2;
+        dw[1] = c2;
+        dw[2] = c2;
+        dw[3] = c2;
+        dw += 4;
+    }
+    for (; n >= 2; n -= 2) {
+        *dw++ = c2;
+    }
+    if (n > 0) {
+        *(uint16_t *)dw = c;
+    }
+}
+
+/**
+ * 填充水平线段 [x1, x2]，先裁剪，像素格式只判断一次
+ */
 static void xLine(image_t *img, int x1, int x2, int y, int c)
 {
-    while (x1 <= x2) {
-        imlib_set_pixel(img, x1++, y, c);
+    if ((y < 0) || (y >= img->h)) {
+        return;
+    }
+    x1 = IM_MAX(x1, 0);
+    x2 = IM_MIN(x2, img->w - 1);
+    if (x1 > x2) {
+        return;
+    }
+
+    switch (img->pixfmt) {
+        case PIXFORMAT_BINARY: {
+            uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
+            for (int x = x1; x <= x2; x++) {
+                IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, x, c);
+            }
+            break;
+        }
+        case PIXFORMAT_GRAYSCALE: {
+            memset(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y) + x1, c, x2 - x1 + 1);
+            break;
+        }
+        case PIXFORMAT_RGB565: {
+            fill_rgb565_span(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y) + x1, x2 - x1 + 1, c);
+            break;
+        }
+        default: {
+            break;
+        }
     }
 }
 
+/**
+ * 填充垂直线段 [y1, y2]，先裁剪，按行跨度步进
+ */
 static void yLine(image_t *img, int x, int y1, int y2, int c)
 {
-    while (y1 <= y2) {
-        imlib_set_pixel(img, x, y1++, c);
+    if ((x < 0) || (x >= img->w)) {
+        return;
+    }
+    y1 = IM_MAX(y1, 0);
+    y2 = IM_MIN(y2, img->h - 1);
+    if (y1 > y2) {
+        return;
+    }
+
+    switch (img->pixfmt) {
+        case PIXFORMAT_GRAYSCALE: {
+            uint8_t *ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y1) + x;
+            for (int y = y1; y <= y2; y++, ptr += img->w) {
+                *ptr = c;
+            }
+            break;
+        }
+        case PIXFORMAT_RGB565: {
+            uint16_t *ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y1) + x;
+            for (int y = y1; y <= y2; y++, ptr += img->w) {
+                *ptr = c;
+            }
+            break;
+        }
+        default: {
+            for (int y = y1; y <= y2; y++) {
+                imlib_set_pixel(img, x, y, c);
+            }
+            break;
+        }
     }
 }
 
 /**
- * 画矩形
+ * 画矩形，填充和边框都按水平线段绘制
  */
 void imlib_draw_rectangle(image_t *img, int rx, int ry, int rw, int rh, int c, int thickness, bool fill)
 {
     if (fill) {
         for (int y = ry, yy = ry + rh; y < yy; y++) {
-            for (int x = rx, xx = rx + rw; x < xx; x++) {
-                imlib_set_pixel(img, x, y, c);
-            }
+            xLine(img, rx, rx + rw - 1, y, c);
         }
 
     } else if (thickness > 0) {
         int thickness0 = (thickness - 0) / 2;
         int thickness1 = (thickness - 1) / 2;
 
-        for (int i = rx - thickness0, j = rx + rw + thickness1, k = ry + rh - 1; i < j; i++) {
-            yLine(img, i, ry - thickness0, ry + thickness1, c);
-            yLine(img, i, k - thickness0, k + thickness1, c);
+        // 上下两条边
+        for (int i = ry - thickness0, j = ry + thickness1, k = ry + rh - 1; i <= j; i++) {
+            xLine(img, rx - thickness0, rx + rw + thickness1 - 1, i, c);
+            xLine(img, rx - thickness0, rx + rw + thickness1 - 1, k - ry + i, c);
         }
 
+        // 左右两条边
         for (int i = ry - thickness0, j = ry + rh + thickness1, k = rx + rw - 1; i < j; i++) {
             xLine(img, rx - thickness0, rx + thickness1, i, c);
             xLine(img, k - thickness0, k + thickness1, i, c);
@@ -624,6 +713,47 @@ typedef struct {
 
 font_t gfont;
 
+/**
+ * 读取字形中的一个点，8x16 为每行一个字节，16x16 分左右两部分各 16 字节
+ * @param xx：缩放后的字符宽度，16x16 字形按它分左右两半
+ */
+static inline bool glyph_pixel(const uint8_t *data, int w, int xx, int x, int sy, float scale)
+{
+    int sx = fast_floorf(x / scale);
+    if ((w == 8) || (x < (int)(xx / 2.0))) {
+        return data[sy] & (1 << (7 - sx));
+    }
+    return data[sy + 16] & (1 << (15 - sx));
+}
+
+/**
+ * 无旋转时逐行绘制字形，连续的点合并成一条水平线段，与逐点绘制的结果一致
+ */
+static void draw_glyph_rows(image_t *img, int x_off, int y_off, const uint8_t *data, int w, int h, int c, float scale,
+                            bool char_hmirror, bool char_vflip)
+{
+    int xx = fast_floorf(w * scale);
+    int yy = fast_floorf(h * scale);
+    for (int y = 0; y < yy; y++) {
+        int sy     = fast_floorf(y / scale);
+        int16_t ty = y_off + (char_vflip ? (yy - y - 1) : y);
+        int run    = -1;
+        for (int x = 0; x <= xx; x++) {
+            bool set = (x < xx) && glyph_pixel(data, w, xx, x, sy, scale);
+            if (set && (run < 0)) {
+                run = x;
+            } else if (!set && (run >= 0)) {
+                if (char_hmirror) {
+                    xLine(img, x_off + xx - x, x_off + xx - 1 - run, ty, c);
+                } else {
+                    xLine(img, x_off + run, x_off + x - 1, ty, c);
+                }
+                run = -1;
+            }
+        }
+    }
+}
+
 // 8x16
 // 16x16 分两部分显示
 void imlib_draw_string(image_t *img, int x_off, int y_off, const char *str, int c, float scale, int x_spacing,
@@ -668,7 +798,10 @@ void imlib_draw_string(image_t *img, int x_off, int y_off, const char *str, int
     uint64_t unicode = 0;
     uint8_t bytes    = 0;
     char ch          = 0;
-    glyph_t *g       = (glyph_t *)malloc(sizeof(glyph_t));
+    glyph_t glyph;
+    glyph_t *g = &glyph;
+    // 不旋转时坐标不变，跳过逐点的 point_rotate
+    bool is_upright = (char_rotation == 0) && (string_rotation == 0);
     while (*str) {
         bytes = utf8_to_unicode(str, &unicode);
 
@@ -740,7 +873,9 @@ void imlib_draw_string(image_t *img, int x_off, int y_off, const char *str, int
         //     }
         // }
 
-        if (bytes == 1) {
+        if (is_upright && ((bytes == 1) || (bytes == 3))) {
+            draw_glyph_rows(img, x_off, y_off, g->data, g->w, g->h, c, scale, char_hmirror, char_vflip);
+        } else if (bytes == 1) {
             for (int y = 0, yy = fast_floorf(g->h * scale); y < yy; y++) {
                 for (int x = 0, xx = fast_floorf(g->w * scale); x < xx; x++) {
                     if (g->data[fast_floorf(y / scale)] & (1 << (g->w - 1 - fast_floorf(x / scale)))) {
@@ -1,5 +1,6 @@
 #include "fmath.h"
 #include <string.h>
+#include "sdkconfig.h"
 
 const float __atanf_lut[4] = {
     -0.0443265554792128f,  // p7
@@ -121,7 +122,7 @@ float fast_atan2f(float y, float x)
     return (y == 0) ? 0 : ((y > 0) ? M_PI : -M_PI);
 }
 
-float fast_log2(float x)
+static inline float log2_kernel(float x)
 {
     union {
         float f;
@@ -137,6 +138,11 @@ float fast_log2(float x)
     return y - 124.22551499f - 1.498030302f * mx.f - 1.72587999f / (0.3520887068f + mx.f);
 }
 
+float fast_log2(float x)
+{
+    return log2_kernel(x);
+}
+
 float fast_log(float x)
 {
     return 0.69314718f * fast_log2(x);
@@ -154,20 +160,148 @@ float fast_powf(float a, float b)
 
 void fast_get_min_max(float *data, size_t data_len, float *p_min, float *p_max)
 {
-    float min = FLT_MAX, max = -FLT_MAX;
+    // 4 路独立比较，FPU 的比较不用等上一次的结果
+    float min[4] = {FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX};
+    float max[4] = {-FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX};
+    size_t i     = 0;
+
+    for (; i + 4 <= data_len; i += 4) {
+        for (int k = 0; k < 4; k++) {
+            float temp = data[i + k];
+
+            if (temp < min[k]) {
+                min[k] = temp;
+            }
 
-    for (size_t i = 0; i < data_len; i++) {
+            if (temp > max[k]) {
+                max[k] = temp;
+            }
+        }
+    }
+
+    for (; i < data_len; i++) {
         float temp = data[i];
 
-        if (temp < min) {
-            min = temp;
+        if (temp < min[0]) {
+            min[0] = temp;
+        }
+
+        if (temp > max[0]) {
+            max[0] = temp;
+        }
+    }
+
+    for (int k = 1; k < 4; k++) {
+        if (min[k] < min[0]) {
+            min[0] = min[k];
         }
 
-        if (temp > max) {
-            max = temp;
+        if (max[k] > max[0]) {
+            max[0] = max[k];
         }
     }
 
+    *p_min = min[0];
+    *p_max = max[0];
+}
+
+/*
+ * ESP32-P4 的 FPU 没有浮点向量指令，浮点批量版本靠内联和 4 路展开，
+ * 让相互独立的乘加和除法在流水线里重叠，省掉每个元素一次的函数调用。
+ */
+
+// 与 fast_expf() 相同的运算，用移位代替位域
+static inline float expf_kernel(float x)
+{
+    uint32_t l      = (uint32_t)(1512775 * x + 1072632447);
+    uint32_t e      = (((l >> 20) & 0x7FF) - 1023 + 127) & 0xFF;
+    uint32_t packed = (l & 0x80000000) | (e << 23) | ((l & 0xFFFFF) << 3);
+
+    float result;
+    memcpy(&result, &packed, sizeof(result));
+    return result;
+}
+
+void fast_expf_batch(const float *in, float *out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4) {
+        float x0 = in[i], x1 = in[i + 1], x2 = in[i + 2], x3 = in[i + 3];
+        out[i]     = expf_kernel(x0);
+        out[i + 1] = expf_kernel(x1);
+        out[i + 2] = expf_kernel(x2);
+        out[i + 3] = expf_kernel(x3);
+    }
+    for (; i < len; i++) {
+        out[i] = expf_kernel(in[i]);
+    }
+}
+
+void fast_log2_batch(const float *in, float *out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4) {
+        float x0 = in[i], x1 = in[i + 1], x2 = in[i + 2], x3 = in[i + 3];
+        out[i]     = log2_kernel(x0);
+        out[i + 1] = log2_kernel(x1);
+        out[i + 2] = log2_kernel(x2);
+        out[i + 3] = log2_kernel(x3);
+    }
+    for (; i < len; i++) {
+        out[i] = log2_kernel(in[i]);
+    }
+}
+
+void fast_atan2f_batch(const float *y, const float *x, float *out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4) {
+        float y0 = y[i], y1 = y[i + 1], y2 = y[i + 2], y3 = y[i + 3];
+        float x0 = x[i], x1 = x[i + 1], x2 = x[i + 2], x3 = x[i + 3];
+        out[i]     = fast_atan2f(y0, x0);
+        out[i + 1] = fast_atan2f(y1, x1);
+        out[i + 2] = fast_atan2f(y2, x2);
+        out[i + 3] = fast_atan2f(y3, x3);
+    }
+    for (; i < len; i++) {
+        out[i] = fast_atan2f(y[i], x[i]);
+    }
+}
+
+#if CONFIG_IDF_TARGET_ESP32P4
+// fmath_esp32p4.S，data 16 字节对齐，blocks 个 8 元素的块 (blocks > 0)，min8 和 max8 为 16 字节对齐的 8 个通道结果
+void fmath_min_max_s16_esp(const int16_t *data, size_t blocks, int16_t *min8, int16_t *max8);
+#endif
+
+void fast_get_min_max_s16(const int16_t *data, size_t data_len, int16_t *p_min, int16_t *p_max)
+{
+    int16_t min = INT16_MAX, max = INT16_MIN;
+    size_t i    = 0;
+
+#if CONFIG_IDF_TARGET_ESP32P4
+    // 先逐个处理到 16 字节对齐，中间整块交给 PIE，每条指令比较 8 个元素
+    for (; i < data_len && ((uintptr_t)&data[i] & 0xF); i++) {
+        min = (data[i] < min) ? data[i] : min;
+        max = (data[i] > max) ? data[i] : max;
+    }
+    size_t blocks = (data_len - i) / 8;
+    if (blocks > 0) {
+        int16_t min8[8] __attribute__((aligned(16)));
+        int16_t max8[8] __attribute__((aligned(16)));
+        fmath_min_max_s16_esp(&data[i], blocks, min8, max8);
+        for (int k = 0; k < 8; k++) {
+            min = (min8[k] < min) ? min8[k] : min;
+            max = (max8[k] > max) ? max8[k] : max;
+        }
+        i += blocks * 8;
+    }
+#endif
+
+    for (; i < data_len; i++) {
+        min = (data[i] < min) ? data[i] : min;
+        max = (data[i] > max) ? data[i] : max;
+    }
+
     *p_min = min;
     *p_max = max;
 }
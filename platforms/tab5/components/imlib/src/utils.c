@@ -1,11 +1,13 @@
 #include "utils.h"
+#include <assert.h>
+#include <inttypes.h>
 #include <stdint.h>
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
-#include "driver/ppa.h"
+#include <sys/lock.h>
+#include "esp_log.h"
 #include "driver/jpeg_decode.h"
-#include "driver/jpeg_encode.h"
 
 /**
  * 获取 utf-8 字符的字节长度
@@ -86,36 +88,159 @@ int utf8_to_unicode(const char* utf8_input, uint64_t* unicode_output)
     return utf_bytes;
 }
 
+#define JPG_READ_CHUNK_SIZE (64 * 1024) /* SD 卡按大块读取，小块读取的开销主要在每条命令上 */
+#define JPG_DECODE_TIMEOUT  1000        /* ms */
+
+static const char* TAG = "imlib";
+
+static jpeg_decoder_handle_t jpg_decoder = NULL;
+static _lock_t jpg_decoder_lock;
+
 /**
- *
+ * 读取整个 jpg 文件到解码器可用的 DMA 缓冲区
+ * @param path: 文件路径
+ * @param size: 输出文件大小
+ * @return: 缓冲区，失败返回 NULL，用 free() 释放
  */
-int image_jpg_read(image_t** img_out, char* path)
+static uint8_t* jpg_file_load(const char* path, uint32_t* size)
 {
-    // uint32_t last_time = esp_timer_get_time();
     FILE* fp = fopen(path, "rb");
     if (fp == NULL) {
-        printf("open %s to read fail\n", path);
-        return -1;
+        ESP_LOGE(TAG, "open %s to read fail", path);
+        return NULL;
     }
-
-    image_t* img_jpg = (image_t*)malloc(sizeof(image_t));
     fseek(fp, 0, SEEK_END);
-    img_jpg->size = ftell(fp);
+    long file_size = ftell(fp);
     fseek(fp, 0, SEEK_SET);
-    img_jpg->pixfmt = PIXFORMAT_JPEG;
-    img_jpg->data   = (uint8_t*)heap_caps_malloc(img_jpg->size, MALLOC_CAP_8BIT | MALLOC_CAP_SPIRAM);
-    if (img_jpg->data == NULL) {
-        ESP_LOGE(TAG, "alloc memory for img_jpg->data failed");
+    if (file_size <= 0) {
+        fclose(fp);
+        return NULL;
+    }
+
+    jpeg_decode_memory_alloc_cfg_t mem_cfg = {
+        .buffer_direction = JPEG_DEC_ALLOC_INPUT_BUFFER,
+    };
+    size_t allocated = 0;
+    uint8_t* buf     = (uint8_t*)jpeg_alloc_decoder_mem(file_size, &mem_cfg, &allocated);
+    if (buf == NULL) {
+        ESP_LOGE(TAG, "alloc %ld bytes for %s failed", file_size, path);
+        fclose(fp);
+        return NULL;
+    }
+
+    for (long offset = 0; offset < file_size;) {
+        size_t len = (file_size - offset) < JPG_READ_CHUNK_SIZE ? (file_size - offset) : JPG_READ_CHUNK_SIZE;
+        if (fread(buf + offset, 1, len, fp) != len) {
+            ESP_LOGE(TAG, "read %s failed", path);
+            free(buf);
+            fclose(fp);
+            return NULL;
+        }
+        offset += len;
     }
-    fread(img_jpg->data, 1, img_jpg->size, fp);
     fclose(fp);
 
-    // ESP_LOGI(TAG, "jpeg read spend time %lld ms.", (esp_timer_get_time() - last_time) / 1000);
-    // last_time = esp_timer_get_time();
-    *img_out = app_jpeg_decode(img_jpg, img_jpg->size);  // img 内存由 app_jpeg_decode() 内部分配
-    // ESP_LOGI(TAG, "jpeg decode spend time %lld ms.", (esp_timer_get_time() - last_time) / 1000);
+    *size = file_size;
+    return buf;
+}
+
+/**
+ * 用硬件 JPEG 解码器读取 jpg 文件，解码为 RGB565
+ * @param img_out: 输出图像，图像和像素内存在内部分配，用 image_jpg_free() 释放
+ * @param path: 文件路径
+ * @return: 0 成功，-1 失败
+ */
+int image_jpg_read(image_t** img_out, char* path)
+{
+    *img_out = NULL;
+
+    uint32_t size = 0;
+    uint8_t* data = jpg_file_load(path, &size);
+    if (data == NULL) {
+        return -1;
+    }
+
+    jpeg_decode_picture_info_t info;
+    if (jpeg_decoder_get_info(data, size, &info) != ESP_OK || info.width == 0 || info.height == 0) {
+        ESP_LOGE(TAG, "%s is not a baseline jpg", path);
+        free(data);
+        return -1;
+    }
 
-    heap_caps_free(img_jpg->data);
+    /* 解码器按整个 MCU 输出，宽高向上对齐到 MCU */
+    bool is_16_wide = (info.sample_method == JPEG_DOWN_SAMPLING_YUV420) ||
+                      (info.sample_method == JPEG_DOWN_SAMPLING_YUV422);
+    uint32_t mcu_w  = is_16_wide ? 16 : 8;
+    uint32_t mcu_h  = (info.sample_method == JPEG_DOWN_SAMPLING_YUV420) ? 16 : 8;
+    uint32_t out_w  = (info.width + mcu_w - 1) / mcu_w * mcu_w;
+    uint32_t out_h  = (info.height + mcu_h - 1) / mcu_h * mcu_h;
+
+    /* 直接解码到 DMA 可用的图像缓冲区，不再经过中间拷贝 */
+    jpeg_decode_memory_alloc_cfg_t mem_cfg = {
+        .buffer_direction = JPEG_DEC_ALLOC_OUTPUT_BUFFER,
+    };
+    size_t allocated = 0;
+    uint8_t* pixels  = (uint8_t*)jpeg_alloc_decoder_mem(out_w * out_h * 2, &mem_cfg, &allocated);
+    image_t* img     = (image_t*)malloc(sizeof(image_t));
+    if (pixels == NULL || img == NULL) {
+        ESP_LOGE(TAG, "alloc memory for %" PRIu32 "x%" PRIu32 " image failed", info.width, info.height);
+        free(pixels);
+        free(img);
+        free(data);
+        return -1;
+    }
 
+    jpeg_decode_cfg_t decode_cfg = {
+        .output_format = JPEG_DECODE_OUT_FORMAT_RGB565,
+        .rgb_order     = JPEG_DEC_RGB_ELEMENT_ORDER_BGR,
+        .conv_std      = JPEG_YUV_RGB_CONV_STD_BT601,
+    };
+    uint32_t out_size = 0;
+    esp_err_t ret     = ESP_OK;
+    _lock_acquire(&jpg_decoder_lock);
+    if (jpg_decoder == NULL) {
+        jpeg_decode_engine_cfg_t engine_cfg = {
+            .intr_priority = 0,
+            .timeout_ms    = JPG_DECODE_TIMEOUT,
+        };
+        ret = jpeg_new_decoder_engine(&engine_cfg, &jpg_decoder);
+    }
+    if (ret == ESP_OK) {
+        ret = jpeg_decoder_process(jpg_decoder, &decode_cfg, data, size, pixels, allocated, &out_size);
+    }
+    _lock_release(&jpg_decoder_lock);
+    free(data);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "decode %s failed: %s", path, esp_err_to_name(ret));
+        free(pixels);
+        free(img);
+        return -1;
+    }
+
+    /* 宽度有填充时逐行前移，image_t 的行是紧密排列的 */
+    if (out_w != info.width) {
+        for (uint32_t y = 1; y < info.height; y++) {
+            memmove(pixels + y * info.width * 2, pixels + y * out_w * 2, info.width * 2);
+        }
+    }
+
+    img->w      = info.width;
+    img->h      = info.height;
+    img->pixfmt = PIXFORMAT_RGB565;
+    img->data   = pixels;
+    *img_out    = img;
     return 0;
 }
+
+/**
+ * 释放 image_jpg_read() 得到的图像
+ * @param img: 图像
+ */
+void image_jpg_free(image_t* img)
+{
+    if (img == NULL) {
+        return;
+    }
+    free(img->data);
+    free(img);
+}
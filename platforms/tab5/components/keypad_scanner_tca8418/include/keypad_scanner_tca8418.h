@@ -15,6 +15,7 @@ extern "C" {
 void app_keypad_scanner_test(void *pvParam);
 
 esp_err_t keypad_scanner_tca8418_init(i2c_master_bus_handle_t bus_handle);
+esp_err_t keypad_scanner_tca8418_deinit(void);
 bool keypad_scanner_tca8418_matrix(uint8_t rows, uint8_t columns);
 uint8_t keypad_scanner_tca8418_flush();
 uint8_t keypad_scanner_tca8418_available();
@@ -25,6 +26,8 @@ esp_err_t keypad_scanner_tca8418_irq_init(int int_pin);
 void keypad_scanner_tca8418_enable_int();
 void keypad_scanner_tca8418_disable_int();
 void keypad_scanner_tca8418_clear_irq();
+uint8_t keypad_scanner_tca8418_get_int_stat();
+void keypad_scanner_tca8418_clear_int_stat(uint8_t flags);
 
 extern const char key_value_map[];
 extern const char key_value_map_str[][10];
@@ -124,6 +124,16 @@ esp_err_t keypad_scanner_tca8418_init(i2c_master_bus_handle_t bus_handle)
     return ESP_OK;
 }
 
+esp_err_t keypad_scanner_tca8418_deinit(void)
+{
+    if (i2c_dev_handle_tca8418 == NULL) {
+        return ESP_OK;
+    }
+    esp_err_t ret          = i2c_master_bus_rm_device(i2c_dev_handle_tca8418);
+    i2c_dev_handle_tca8418 = NULL;
+    return ret;
+}
+
 static void IRAM_ATTR tca8418_isr_handler(void* arg)
 {
     uint32_t gpio_num = (uint32_t)arg;
@@ -274,6 +284,22 @@ void keypad_scanner_tca8418_clear_irq()
     write_reg(TCA8418_REG_INT_STAT, 2);
 }
 
+/**
+ * @brief reads the interrupt status, bit 0 key events, bit 1 GPI
+ */
+uint8_t keypad_scanner_tca8418_get_int_stat()
+{
+    return read_reg(TCA8418_REG_INT_STAT);
+}
+
+/**
+ * @brief clears the given interrupt status bits, the INT line is released once none are left
+ */
+void keypad_scanner_tca8418_clear_int_stat(uint8_t flags)
+{
+    write_reg(TCA8418_REG_INT_STAT, flags);
+}
+
 static void write_reg(uint8_t reg, uint8_t val)
 {
     uint8_t write_buf[2] = {reg, val};
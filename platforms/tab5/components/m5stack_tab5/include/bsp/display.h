@@ -63,7 +63,8 @@ extern "C" {
  *
  */
 typedef struct {
-    int dummy;
+    bool splash;           /*!< Fill the frame buffer before the panel starts scanning, it shows until the first flush */
+    uint16_t splash_color; /*!< RGB565 color of the splash */
 } bsp_display_config_t;
 
 /**
@@ -152,6 +153,21 @@ esp_err_t bsp_display_brightness_init(void);
  */
 esp_err_t bsp_display_brightness_set(int brightness_percent);
 
+/**
+ * @brief Fade display's brightness in hardware
+ *
+ * The LEDC fade engine ramps the duty from the current level, the call returns right away and no CPU time is spent on
+ * the transition. A fade still running is stopped where it is and the new one starts from there.
+ * Brightness must be already initialized by calling bsp_display_brightness_init() or bsp_display_new()
+ *
+ * @param[in] brightness_percent Brightness in [%]
+ * @param[in] fade_ms Duration of the transition, 0 sets the level at once
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   Parameter error
+ */
+esp_err_t bsp_display_brightness_fade(int brightness_percent, int fade_ms);
+
 /**
  * @brief Turn on display backlight
  *
@@ -52,6 +52,9 @@
 #define BSP_EXT_I2C_SCL (GPIO_NUM_54)
 #define BSP_EXT_I2C_SDA (GPIO_NUM_53)
 
+/* IO expander interrupt, GPIO_NUM_NC when not wired */
+#define BSP_IO_EXPANDER_INT (CONFIG_BSP_IO_EXPANDER_INT_GPIO)
+
 // /* Ext Keyboard */
 // #define TAB5_TCA8418_INT_PIN 50 // 中断输入
 
@@ -81,8 +84,16 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Start the 24 MHz camera clock on GPIO 36, it runs on LEDC timer 1 so the backlight keeps timer 0
+ */
 esp_err_t bsp_cam_osc_init(void);
 
+/**
+ * @brief Stop the camera clock and release its LEDC timer
+ */
+esp_err_t bsp_cam_osc_deinit(void);
+
 /**************************************************************************************************
  *
  * I2C interface
@@ -167,6 +178,43 @@ i2c_master_bus_handle_t bsp_grove_i2c_get_handle(void);
  */
 esp_err_t bsp_audio_init(const i2s_std_config_t *i2s_config);
 
+/**
+ * @brief DMA buffering of the I2S channels, shared by TX and RX
+ *
+ * Latency is dma_desc_num * dma_frame_num frames. Fewer, shorter buffers react faster, more of them ride out longer
+ * stalls of the task feeding or draining the channel.
+ */
+typedef struct {
+    uint32_t dma_desc_num;
+    uint32_t dma_frame_num;
+} bsp_audio_dma_config_t;
+
+/**
+ * @brief Set the DMA buffering used by bsp_audio_init()
+ *
+ * @note The channels are created once, so this only has an effect before the first bsp_audio_init()
+ * @param[in]  config Buffer count and frames per buffer, NULL restores the driver defaults
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_STATE Audio is already initialized
+ */
+esp_err_t bsp_audio_set_dma_config(const bsp_audio_dma_config_t *config);
+void bsp_audio_get_dma_config(bsp_audio_dma_config_t *config);
+
+/**
+ * @brief DMA queue overflow counts since init, from the driver ISR
+ *
+ * A TX overflow means every buffer was sent before a new one was written, the auto clear filled the gap with
+ * silence. An RX overflow drops the oldest received buffer because nothing read it. Both channels run from init on,
+ * so the counts also grow while nothing plays or records, callers compare them across their own activity.
+ */
+typedef struct {
+    uint32_t tx_underruns;
+    uint32_t rx_overruns;
+} bsp_audio_dma_stats_t;
+
+void bsp_audio_get_dma_stats(bsp_audio_dma_stats_t *stats);
+
 /**
  * @brief Initialize speaker codec device
  *
@@ -278,6 +326,36 @@ esp_err_t bsp_sdcard_init(char *mount_point, size_t max_files);
  */
 esp_err_t bsp_sdcard_deinit(char *mount_point);
 
+/**
+ * @brief Check that the mounted SD card still answers, the slot has no card detect signal
+ *
+ * @return
+ *    - ESP_OK                  Success
+ *    - ESP_ERR_INVALID_STATE   If no card is mounted
+ *    - Others                  The card stopped responding, e.g. it was removed
+ */
+esp_err_t bsp_sdcard_get_status(void);
+
+/**
+ * @brief Bus settings the mounted SD card runs with
+ */
+typedef struct {
+    uint32_t freq_khz;       /*!< Bus clock agreed with the card */
+    bool is_ddr;             /*!< Double data rate (DDR50) */
+    uint8_t bus_width;       /*!< Data lines */
+    uint64_t capacity_bytes; /*!< Card capacity */
+} bsp_sdcard_info_t;
+
+/**
+ * @brief Get the bus settings of the mounted SD card
+ *
+ * @param info Filled on success
+ * @return
+ *    - ESP_OK                  Success
+ *    - ESP_ERR_INVALID_STATE   If no card is mounted
+ */
+esp_err_t bsp_sdcard_get_info(bsp_sdcard_info_t *info);
+
 /**************************************************************************************************
  *
  * LCD interface
@@ -312,6 +390,7 @@ typedef struct {
         unsigned int
             sw_rotate : 1; /*!< Use software rotation (slower), The feature is unavailable under avoid-tear mode */
     } flags;
+    bsp_display_config_t panel; /*!< Panel configuration, e.g. the splash shown before LVGL draws */
 } bsp_display_cfg_t;
 
 /**
@@ -345,6 +424,34 @@ lv_display_t *bsp_display_start_with_config(const bsp_display_cfg_t *cfg);
  */
 lv_indev_t *bsp_display_get_input_dev(void);
 
+/**
+ * @brief Turn the LCD panel output off or back on, the frame buffers and the LVGL state are kept
+ *
+ * @note Call with the LVGL mutex taken, so no flush is in flight
+ *
+ * @param on true to turn the panel output on
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE when the display is not started
+ */
+esp_err_t bsp_display_panel_on_off(bool on);
+
+/**
+ * @brief Change the frame rate the panel is scanned out at, by stretching the vertical front porch. The pixel clock
+ * and the line timing stay, so a frame costs the same and the link idles in LP for the extra blanking lines
+ *
+ * @note Safe from any task
+ *
+ * @param hz frames per second, clamped to the longest porch the DSI host takes. 0 or above the full rate restores it
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE when the display is not started
+ */
+esp_err_t bsp_display_set_refresh_rate(int hz);
+
+/**
+ * @brief Frame rate the panel is scanned out at
+ *
+ * @return frames per second, 0 when the display is not started
+ */
+int bsp_display_get_refresh_rate(void);
+
 /**
  * @brief Take LVGL mutex
  *
@@ -395,6 +502,41 @@ bool bsp_usb_c_detect();
 
 bool bsp_usb_a_detect();
 
+/**
+ * @brief Unmask the expander interrupts of the headphone (expander 1 P7) and USB-C (expander 2 P6) detect inputs
+ */
+void bsp_io_expander_enable_detect_irq(void);
+
+/**
+ * @brief Read both detect inputs in one go, this also clears a pending expander interrupt
+ *
+ * @param[out] headphone
+ * @param[out] usb_c
+ * @return ESP_OK on success
+ */
+esp_err_t bsp_io_expander_read_detect(bool *headphone, bool *usb_c);
+
+/**
+ * @brief Switch the bsp_set_* output setters between writing at once and only updating the shadow register
+ *
+ * In deferred mode the caller has to call bsp_io_expander_flush(), leaving it writes out anything pending
+ *
+ * @param[in] deferred
+ */
+void bsp_io_expander_set_deferred(bool deferred);
+
+/**
+ * @brief Whether any expander output change is waiting for bsp_io_expander_flush()
+ */
+bool bsp_io_expander_has_pending(void);
+
+/**
+ * @brief Write the output register of every expander with pending changes, one transaction per chip
+ *
+ * @return ESP_OK on success, failed chips stay pending
+ */
+esp_err_t bsp_io_expander_flush(void);
+
 /**************************************************************************************************
  *
  * USB
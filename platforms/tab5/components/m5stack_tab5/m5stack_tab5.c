@@ -13,11 +13,15 @@
 #include "esp_spiffs.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_lcd_mipi_dsi.h"
+#include "esp_cache.h"
+#include "esp_timer.h"
+#include "hal/mipi_dsi_ll.h"
 #include "esp_ldo_regulator.h"
 #include "esp_vfs_fat.h"
 #include "usb/usb_host.h"
 #include "sd_pwr_ctrl_by_on_chip_ldo.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "sdmmc_cmd.h"
 #include "esp_lcd_st7703.h"
 #include "esp_lcd_ili9881c.h"
@@ -27,6 +31,12 @@
 #include "esp_lcd_touch_gt911.h"
 #include "bsp_err_check.h"
 #include "esp_codec_dev_defaults.h"
+#if CONFIG_BSP_DISPLAY_LVGL_PPA_DRAW
+#include "esp_lvgl_port_ppa_draw.h"
+#endif
+#include "esp_lvgl_port_cache.h"
+#include "esp_lvgl_port_jpeg.h"
+#include "esp_lvgl_port_mem.h"
 
 static const char* TAG = "M5STACK_TAB5";
 
@@ -58,6 +68,10 @@ static const audio_codec_data_if_t* i2s_data_if = NULL; /* Codec data interface
 // camera 设置输出时钟
 //==================================================================================
 
+/* 背光 PWM 使用 timer 0, 摄像头时钟单独用一个 timer, 两者初始化顺序互不影响 */
+#define BSP_CAM_OSC_TIMER   LEDC_TIMER_1
+#define BSP_CAM_OSC_CHANNEL LEDC_CHANNEL_0
+
 esp_err_t bsp_cam_osc_init(void)
 {
     ledc_timer_config_t timer_conf;
@@ -66,7 +80,7 @@ esp_err_t bsp_cam_osc_init(void)
     timer_conf.speed_mode      = LEDC_LOW_SPEED_MODE;
     timer_conf.deconfigure     = false;
     timer_conf.clk_cfg         = LEDC_AUTO_CLK;
-    timer_conf.timer_num       = LEDC_TIMER_0;
+    timer_conf.timer_num       = BSP_CAM_OSC_TIMER;
     esp_err_t err              = ledc_timer_config(&timer_conf);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "ledc_timer_config failed for freq %d, rc=%x", 24000000, err);
@@ -75,9 +89,9 @@ esp_err_t bsp_cam_osc_init(void)
     ledc_channel_config_t ch_conf;
     ch_conf.gpio_num   = 36;  // 摄像头时钟输入
     ch_conf.speed_mode = LEDC_LOW_SPEED_MODE;
-    ch_conf.channel    = LEDC_CHANNEL_0;
+    ch_conf.channel    = BSP_CAM_OSC_CHANNEL;
     ch_conf.intr_type  = LEDC_INTR_DISABLE;
-    ch_conf.timer_sel  = LEDC_TIMER_0;
+    ch_conf.timer_sel  = BSP_CAM_OSC_TIMER;
     ch_conf.duty       = 1;
     ch_conf.hpoint     = 0;
     ch_conf.sleep_mode = LEDC_SLEEP_MODE_KEEP_ALIVE;
@@ -89,6 +103,19 @@ esp_err_t bsp_cam_osc_init(void)
     return ESP_OK;
 }
 
+esp_err_t bsp_cam_osc_deinit(void)
+{
+    ledc_stop(LEDC_LOW_SPEED_MODE, BSP_CAM_OSC_CHANNEL, 0);
+    /* 定时器要先暂停才能释放 */
+    ledc_timer_pause(LEDC_LOW_SPEED_MODE, BSP_CAM_OSC_TIMER);
+    ledc_timer_config_t timer_conf = {
+        .speed_mode  = LEDC_LOW_SPEED_MODE,
+        .timer_num   = BSP_CAM_OSC_TIMER,
+        .deconfigure = true,
+    };
+    return ledc_timer_config(&timer_conf);
+}
+
 //==================================================================================
 // i2c
 //==================================================================================
@@ -147,8 +174,14 @@ esp_err_t bsp_ext_i2c_init(void)
 
 esp_err_t bsp_ext_i2c_deinit(void)
 {
+    if (!ext_i2c_initialized) {
+        return ESP_OK;
+    }
+
     ext_i2c_initialized = false;
-    return i2c_del_master_bus(ext_i2c_bus_handle);
+    esp_err_t ret       = i2c_del_master_bus(ext_i2c_bus_handle);
+    ext_i2c_bus_handle  = NULL;
+    return ret;
 }
 
 i2c_master_bus_handle_t bsp_ext_i2c_get_handle(void)
@@ -240,11 +273,97 @@ static i2c_master_dev_handle_t i2c_dev_handle_pi4ioe2;
 #define setbit(x, y) x |= (0x01 << y)
 #define clrbit(x, y) x &= ~(0x01 << y)
 
+/* 输出寄存器的影子, 写入前先在这里改位, 有变化的芯片在 flush 时只写一次 OUT_SET */
+enum {
+    PI4IOE1 = 0,
+    PI4IOE2,
+    PI4IOE_NUM,
+};
+static uint8_t pi4ioe_out[PI4IOE_NUM]    = {0};
+static bool pi4ioe_out_dirty[PI4IOE_NUM] = {false};
+static bool pi4ioe_deferred              = false;
+static SemaphoreHandle_t pi4ioe_mutex    = NULL;
+/* 输入寄存器快照, 由 bsp_io_expander_read_detect() 刷新 */
+static uint8_t pi4ioe_in[PI4IOE_NUM] = {0};
+static bool pi4ioe_in_valid          = false;
+
+static i2c_master_dev_handle_t pi4ioe_dev(int chip)
+{
+    return chip == PI4IOE1 ? i2c_dev_handle_pi4ioe1 : i2c_dev_handle_pi4ioe2;
+}
+
+/* 调用前需持有 pi4ioe_mutex */
+static esp_err_t pi4ioe_write_out(int chip)
+{
+    uint8_t write_buf[2] = {PI4IO_REG_OUT_SET, pi4ioe_out[chip]};
+    esp_err_t ret        = i2c_master_transmit(pi4ioe_dev(chip), write_buf, 2, I2C_MASTER_TIMEOUT_MS);
+    /* 写失败的保留 dirty, 下次 flush 重试 */
+    pi4ioe_out_dirty[chip] = ret != ESP_OK;
+    return ret;
+}
+
+static void pi4ioe_update_out(int chip, uint8_t bit, bool level)
+{
+    xSemaphoreTake(pi4ioe_mutex, portMAX_DELAY);
+    uint8_t value = pi4ioe_out[chip];
+    if (level) {
+        setbit(value, bit);
+    } else {
+        clrbit(value, bit);
+    }
+    if (value != pi4ioe_out[chip]) {
+        pi4ioe_out[chip]       = value;
+        pi4ioe_out_dirty[chip] = true;
+    }
+    bool deferred = pi4ioe_deferred;
+    xSemaphoreGive(pi4ioe_mutex);
+
+    if (!deferred) {
+        bsp_io_expander_flush();
+    }
+}
+
+void bsp_io_expander_set_deferred(bool deferred)
+{
+    xSemaphoreTake(pi4ioe_mutex, portMAX_DELAY);
+    pi4ioe_deferred = deferred;
+    xSemaphoreGive(pi4ioe_mutex);
+
+    if (!deferred) {
+        bsp_io_expander_flush();
+    }
+}
+
+bool bsp_io_expander_has_pending(void)
+{
+    xSemaphoreTake(pi4ioe_mutex, portMAX_DELAY);
+    bool pending = pi4ioe_out_dirty[PI4IOE1] || pi4ioe_out_dirty[PI4IOE2];
+    xSemaphoreGive(pi4ioe_mutex);
+    return pending;
+}
+
+esp_err_t bsp_io_expander_flush(void)
+{
+    esp_err_t ret = ESP_OK;
+
+    xSemaphoreTake(pi4ioe_mutex, portMAX_DELAY);
+    for (int chip = 0; chip < PI4IOE_NUM; chip++) {
+        if (pi4ioe_out_dirty[chip]) {
+            ret |= pi4ioe_write_out(chip);
+        }
+    }
+    xSemaphoreGive(pi4ioe_mutex);
+
+    return ret == ESP_OK ? ESP_OK : ESP_FAIL;
+}
+
 void bsp_io_expander_pi4ioe_init(i2c_master_bus_handle_t bus_handle)
 {
     uint8_t write_buf[2] = {0};
     uint8_t read_buf[1]  = {0};
 
+    pi4ioe_mutex = xSemaphoreCreateMutex();
+
     /* */
     i2c_device_config_t dev_cfg1 = {
         .dev_addr_length = I2C_ADDR_BIT_LEN_7,
@@ -278,6 +397,7 @@ void bsp_io_expander_pi4ioe_init(i2c_master_bus_handle_t bus_handle)
     write_buf[0] = PI4IO_REG_OUT_SET;
     write_buf[1] = 0b01110110;
     i2c_master_transmit(i2c_dev_handle_pi4ioe1, write_buf, 2, I2C_MASTER_TIMEOUT_MS);
+    pi4ioe_out[PI4IOE1] = write_buf[1];
 
     /* */
     i2c_device_config_t dev_cfg2 = {
@@ -319,187 +439,126 @@ void bsp_io_expander_pi4ioe_init(i2c_master_bus_handle_t bus_handle)
     // write_buf[1] = 0b10001001;
     write_buf[1] = 0b00001001;
     i2c_master_transmit(i2c_dev_handle_pi4ioe2, write_buf, 2, I2C_MASTER_TIMEOUT_MS);
+    pi4ioe_out[PI4IOE2] = write_buf[1];
 }
 
 void bsp_set_charge_qc_en(bool en)
 {
-    uint8_t write_buf[2] = {0};
-    uint8_t read_buf[1]  = {0};
-
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    i2c_master_transmit_receive(i2c_dev_handle_pi4ioe2, write_buf, 1, read_buf, 1, I2C_MASTER_TIMEOUT_MS);
-
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    write_buf[1] = read_buf[0];
-    if (en) {
-        clrbit(write_buf[1], 5);
-    } else {
-        setbit(write_buf[1], 5);
-    }
-
-    i2c_master_transmit(i2c_dev_handle_pi4ioe2, write_buf, 2, I2C_MASTER_TIMEOUT_MS);
+    /* P5 低电平使能 */
+    pi4ioe_update_out(PI4IOE2, 5, !en);
 }
 
 void bsp_set_charge_en(bool en)
 {
-    uint8_t write_buf[2] = {0};
-    uint8_t read_buf[1]  = {0};
-
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    i2c_master_transmit_receive(i2c_dev_handle_pi4ioe2, write_buf, 1, read_buf, 1, I2C_MASTER_TIMEOUT_MS);
-
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    write_buf[1] = read_buf[0];
-    if (en) {
-        setbit(write_buf[1], 7);
-    } else {
-        clrbit(write_buf[1], 7);
-    }
-
-    i2c_master_transmit(i2c_dev_handle_pi4ioe2, write_buf, 2, I2C_MASTER_TIMEOUT_MS);
+    pi4ioe_update_out(PI4IOE2, 7, en);
 }
 
 void bsp_set_usb_5v_en(bool en)
 {
-    uint8_t write_buf[2] = {0};
-    uint8_t read_buf[1]  = {0};
-
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    i2c_master_transmit_receive(i2c_dev_handle_pi4ioe2, write_buf, 1, read_buf, 1, I2C_MASTER_TIMEOUT_MS);
-
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    write_buf[1] = read_buf[0];
-    if (en) {
-        setbit(write_buf[1], 3);
-    } else {
-        clrbit(write_buf[1], 3);
-    }
-
-    i2c_master_transmit(i2c_dev_handle_pi4ioe2, write_buf, 2, I2C_MASTER_TIMEOUT_MS);
+    pi4ioe_update_out(PI4IOE2, 3, en);
 }
 
 void bsp_set_ext_5v_en(bool en)
 {
-    uint8_t write_buf[2] = {0};
-    uint8_t read_buf[1]  = {0};
-
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    i2c_master_transmit_receive(i2c_dev_handle_pi4ioe1, write_buf, 1, read_buf, 1, I2C_MASTER_TIMEOUT_MS);
-
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    write_buf[1] = read_buf[0];
-    if (en) {
-        setbit(write_buf[1], 2);
-    } else {
-        clrbit(write_buf[1], 2);
-    }
-
-    i2c_master_transmit(i2c_dev_handle_pi4ioe1, write_buf, 2, I2C_MASTER_TIMEOUT_MS);
+    pi4ioe_update_out(PI4IOE1, 2, en);
 }
 
 void bsp_generate_poweroff_signal()
 {
     ESP_LOGW(TAG, "Generate poweroff signal!");
-    uint8_t write_buf[2] = {0};
-    uint8_t read_buf[1]  = {0};
 
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    i2c_master_transmit_receive(i2c_dev_handle_pi4ioe2, write_buf, 1, read_buf, 1, I2C_MASTER_TIMEOUT_MS);
-
-    write_buf[1] = read_buf[0];
+    /* 脉冲有时序要求, 不走延迟写入, 直接写芯片 */
+    xSemaphoreTake(pi4ioe_mutex, portMAX_DELAY);
 
     // Try to generate poweroff signal 3 times to make sure it works :)
     for (int i = 0; i < 3; i++) {
-        setbit(write_buf[1], 4);
-        i2c_master_transmit(i2c_dev_handle_pi4ioe2, write_buf, 2, I2C_MASTER_TIMEOUT_MS);
+        setbit(pi4ioe_out[PI4IOE2], 4);
+        pi4ioe_write_out(PI4IOE2);
         vTaskDelay(100 / portTICK_PERIOD_MS);
 
-        clrbit(write_buf[1], 4);
-        i2c_master_transmit(i2c_dev_handle_pi4ioe2, write_buf, 2, I2C_MASTER_TIMEOUT_MS);
+        clrbit(pi4ioe_out[PI4IOE2], 4);
+        pi4ioe_write_out(PI4IOE2);
         vTaskDelay(100 / portTICK_PERIOD_MS);
     }
+
+    xSemaphoreGive(pi4ioe_mutex);
 }
 
-bool bsp_headphone_detect()
+static uint8_t pi4ioe_read_in(int chip)
 {
-    uint8_t write_buf[2] = {0};
-    uint8_t read_buf[1]  = {0};
-
-    write_buf[0] = PI4IO_REG_IN_STA;
-    i2c_master_transmit_receive(i2c_dev_handle_pi4ioe1, write_buf, 1, read_buf, 1, I2C_MASTER_TIMEOUT_MS);
+    if (pi4ioe_in_valid) {
+        return pi4ioe_in[chip];
+    }
 
-    // printf("get %02x\n", read_buf[0]);
+    uint8_t write_buf[1] = {PI4IO_REG_IN_STA};
+    uint8_t read_buf[1]  = {0};
+    i2c_master_transmit_receive(pi4ioe_dev(chip), write_buf, 1, read_buf, 1, I2C_MASTER_TIMEOUT_MS);
+    return read_buf[0];
+}
 
+bool bsp_headphone_detect()
+{
     // Get bit 8
-    bool ret = false;
-    if (read_buf[0] & 0b10000000) {
-        ret = true;
-    }
-
-    return ret;
+    return pi4ioe_read_in(PI4IOE1) & 0b10000000;
 }
 
 bool bsp_usb_c_detect()
 {
-    uint8_t write_buf[2] = {0};
-    uint8_t read_buf[1]  = {0};
-
-    write_buf[0] = PI4IO_REG_IN_STA;
-    i2c_master_transmit_receive(i2c_dev_handle_pi4ioe2, write_buf, 1, read_buf, 1, I2C_MASTER_TIMEOUT_MS);
-
-    // printf("get %02x\n", read_buf[0]);
-
     // Get bit 6
-    bool ret = false;
-    if (read_buf[0] & 0b01000000) {
-        ret = true;
-    }
-
-    return ret;
+    return pi4ioe_read_in(PI4IOE2) & 0b01000000;
 }
 
-void bsp_set_ext_antenna_enable(bool en)
+void bsp_io_expander_enable_detect_irq(void)
 {
     uint8_t write_buf[2] = {0};
-    uint8_t read_buf[1]  = {0};
 
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    i2c_master_transmit_receive(i2c_dev_handle_pi4ioe1, write_buf, 1, read_buf, 1, I2C_MASTER_TIMEOUT_MS);
+    write_buf[0] = PI4IO_REG_INT_MASK;
+    write_buf[1] = 0b01111111;
+    i2c_master_transmit(i2c_dev_handle_pi4ioe1, write_buf, 2,
+                        I2C_MASTER_TIMEOUT_MS);  // P7 中断使能 0 enable, 1 disable
+    write_buf[0] = PI4IO_REG_INT_MASK;
+    write_buf[1] = 0b10111111;
+    i2c_master_transmit(i2c_dev_handle_pi4ioe2, write_buf, 2,
+                        I2C_MASTER_TIMEOUT_MS);  // P6 中断使能 0 enable, 1 disable
+}
 
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    write_buf[1] = read_buf[0];
-    if (en) {
-        setbit(write_buf[1], 0);
-    } else {
-        clrbit(write_buf[1], 0);
+esp_err_t bsp_io_expander_read_detect(bool *headphone, bool *usb_c)
+{
+    uint8_t write_buf[1] = {0};
+    uint8_t irq_sta[2]   = {0};
+    uint8_t in_sta[2]    = {0};
+
+    /* Reading the interrupt status releases INT */
+    write_buf[0]  = PI4IO_REG_IRQ_STA;
+    esp_err_t ret = i2c_master_transmit_receive(i2c_dev_handle_pi4ioe1, write_buf, 1, &irq_sta[0], 1,
+                                                I2C_MASTER_TIMEOUT_MS);
+    ret |= i2c_master_transmit_receive(i2c_dev_handle_pi4ioe2, write_buf, 1, &irq_sta[1], 1, I2C_MASTER_TIMEOUT_MS);
+    write_buf[0] = PI4IO_REG_IN_STA;
+    ret |= i2c_master_transmit_receive(i2c_dev_handle_pi4ioe1, write_buf, 1, &in_sta[0], 1, I2C_MASTER_TIMEOUT_MS);
+    ret |= i2c_master_transmit_receive(i2c_dev_handle_pi4ioe2, write_buf, 1, &in_sta[1], 1, I2C_MASTER_TIMEOUT_MS);
+    if (ret != ESP_OK) {
+        return ESP_FAIL;
     }
 
-    i2c_master_transmit(i2c_dev_handle_pi4ioe1, write_buf, 2, I2C_MASTER_TIMEOUT_MS);
+    pi4ioe_in[PI4IOE1] = in_sta[0];
+    pi4ioe_in[PI4IOE2] = in_sta[1];
+    pi4ioe_in_valid    = true;
+
+    *headphone = in_sta[0] & 0b10000000;
+    *usb_c     = in_sta[1] & 0b01000000;
+    return ESP_OK;
 }
 
-void bsp_set_wifi_power_enable(bool en)
+void bsp_set_ext_antenna_enable(bool en)
 {
-    uint8_t write_buf[2] = {0};
-    uint8_t read_buf[1]  = {0};
+    pi4ioe_update_out(PI4IOE1, 0, en);
+}
 
+void bsp_set_wifi_power_enable(bool en)
+{
     ESP_LOGI(TAG, "set_wifi_power_enable: %d", en);
 
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    i2c_master_transmit_receive(i2c_dev_handle_pi4ioe2, write_buf, 1, read_buf, 1, I2C_MASTER_TIMEOUT_MS);
-
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    write_buf[1] = read_buf[0];
-    if (en) {
-        setbit(write_buf[1], 0);
-    } else {
-        clrbit(write_buf[1], 0);
-    }
-
-    i2c_master_transmit(i2c_dev_handle_pi4ioe2, write_buf, 2, I2C_MASTER_TIMEOUT_MS);
-
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    i2c_master_transmit_receive(i2c_dev_handle_pi4ioe2, write_buf, 1, read_buf, 1, I2C_MASTER_TIMEOUT_MS);
-    printf("0x%02X: %02x\n", PI4IO_REG_OUT_SET, read_buf[0]);
+    pi4ioe_update_out(PI4IOE2, 0, en);
 }
 
 void bsp_reset_tp()
@@ -509,24 +568,19 @@ void bsp_reset_tp()
     ESP_LOGI(TAG, "reset gpio %d", GPIO_NUM_23);
     gpio_reset_pin(GPIO_NUM_23);
 
-    uint8_t write_buf[2] = {0};
-    uint8_t read_buf[1]  = {0};
+    /* 复位脉冲直接写芯片, 其他待写的位一起带上 */
+    xSemaphoreTake(pi4ioe_mutex, portMAX_DELAY);
 
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    i2c_master_transmit_receive(i2c_dev_handle_pi4ioe1, write_buf, 1, read_buf, 1, I2C_MASTER_TIMEOUT_MS);
-
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    write_buf[1] = read_buf[0];
-    clrbit(write_buf[1], 4);
-    clrbit(write_buf[1], 5);
-    i2c_master_transmit(i2c_dev_handle_pi4ioe1, write_buf, 2, I2C_MASTER_TIMEOUT_MS);
+    clrbit(pi4ioe_out[PI4IOE1], 4);
+    clrbit(pi4ioe_out[PI4IOE1], 5);
+    pi4ioe_write_out(PI4IOE1);
     vTaskDelay(100 / portTICK_PERIOD_MS);
 
-    write_buf[0] = PI4IO_REG_OUT_SET;
-    write_buf[1] = read_buf[0];
-    setbit(write_buf[1], 4);
-    setbit(write_buf[1], 5);
-    i2c_master_transmit(i2c_dev_handle_pi4ioe1, write_buf, 2, I2C_MASTER_TIMEOUT_MS);
+    setbit(pi4ioe_out[PI4IOE1], 4);
+    setbit(pi4ioe_out[PI4IOE1], 5);
+    pi4ioe_write_out(PI4IOE1);
+
+    xSemaphoreGive(pi4ioe_mutex);
     vTaskDelay(100 / portTICK_PERIOD_MS);
 }
 
@@ -538,6 +592,20 @@ void bsp_reset_tp()
 
 #define SDMMC_BUS_WIDTH (4)            // SDIO 4 线模式
 #define GPIO_SDMMC_DET  (GPIO_NUM_NC)  // SDIO 卡检测
+
+#if CONFIG_BSP_SD_SPEED_UHS_I_SDR50
+#define BSP_SD_FREQ_KHZ (SDMMC_FREQ_SDR50)
+#define BSP_SD_UHS_I    (1)
+#elif CONFIG_BSP_SD_SPEED_UHS_I_DDR50
+#define BSP_SD_FREQ_KHZ (SDMMC_FREQ_DDR50)
+#define BSP_SD_UHS_I    (1)
+#elif CONFIG_BSP_SD_SPEED_DEFAULT
+#define BSP_SD_FREQ_KHZ (SDMMC_FREQ_DEFAULT)
+#define BSP_SD_UHS_I    (0)
+#else
+#define BSP_SD_FREQ_KHZ (SDMMC_FREQ_HIGHSPEED)
+#define BSP_SD_UHS_I    (0)
+#endif
 // M5Stack-Tab5-P4
 #define GPIO_SDMMC_CLK (GPIO_NUM_43)  // SDIO 时钟
 #define GPIO_SDMMC_CMD (GPIO_NUM_44)  // SDIO 命令
@@ -566,7 +634,7 @@ esp_err_t bsp_sdcard_init(char* mount_point, size_t max_files)
     sdmmc_host_t host = SDMMC_HOST_DEFAULT();
     host.slot         = SDMMC_HOST_SLOT_0;  //
     // host.slot = SDMMC_HOST_SLOT_1; //
-    host.max_freq_khz                   = SDMMC_FREQ_HIGHSPEED;
+    host.max_freq_khz                   = BSP_SD_FREQ_KHZ;
     sd_pwr_ctrl_ldo_config_t ldo_config = {
         .ldo_chan_id = BSP_LDO_PROBE_SD_CHAN,  // `LDO_VO4` is used as the SDMMC IO power
     };
@@ -596,6 +664,13 @@ esp_err_t bsp_sdcard_init(char* mount_point, size_t max_files)
     slot_config.d3                  = GPIO_SDMMC_D3;
     // slot_config.cd = GPIO_SDMMC_DET;
     // slot_config.flags |= SDMMC_SLOT_FLAG_INTERNAL_PULLUP;
+#if BSP_SD_UHS_I
+    /* UHS-I switches the IO to 1.8 V through the on-chip LDO, only slot 0 can */
+    slot_config.flags |= SDMMC_SLOT_FLAG_UHS1;
+#endif
+#if !CONFIG_BSP_SD_SPEED_UHS_I_DDR50
+    host.flags &= ~SDMMC_HOST_FLAG_DDR;
+#endif
 
     /**
      * @brief Options for mounting the filesystem.
@@ -603,9 +678,19 @@ esp_err_t bsp_sdcard_init(char* mount_point, size_t max_files)
      *   formatted in case when mounting fails.
      */
     esp_vfs_fat_sdmmc_mount_config_t mount_config = {
-        .format_if_mount_failed = false, .max_files = max_files, .allocation_unit_size = 16 * 1024};
+        .format_if_mount_failed = false, .max_files = max_files, .allocation_unit_size = 64 * 1024};
 
     ret_val = esp_vfs_fat_sdmmc_mount(mount_point, &host, &slot_config, &mount_config, &card);
+#if BSP_SD_UHS_I
+    /* Cards without UHS-I fail the voltage switch, ESP_FAIL is the file system and is not retried */
+    if (ret_val != ESP_OK && ret_val != ESP_FAIL) {
+        ESP_LOGW(TAG, "UHS-I init failed (%s), retry in high speed mode", esp_err_to_name(ret_val));
+        host.max_freq_khz = SDMMC_FREQ_HIGHSPEED;
+        host.flags &= ~SDMMC_HOST_FLAG_DDR;
+        slot_config.flags &= ~SDMMC_SLOT_FLAG_UHS1;
+        ret_val = esp_vfs_fat_sdmmc_mount(mount_point, &host, &slot_config, &mount_config, &card);
+    }
+#endif
 
     /* Check for SDMMC mount result. */
     if (ret_val != ESP_OK) {
@@ -648,6 +733,26 @@ esp_err_t bsp_sdcard_deinit(char* mount_point)
     return ret_val;
 }
 
+esp_err_t bsp_sdcard_get_status(void)
+{
+    if (card == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return sdmmc_get_status(card);
+}
+
+esp_err_t bsp_sdcard_get_info(bsp_sdcard_info_t* info)
+{
+    if (card == NULL || info == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    info->freq_khz       = card->real_freq_khz;
+    info->is_ddr         = card->is_ddr;
+    info->bus_width      = 1 << card->log_bus_width;
+    info->capacity_bytes = (uint64_t)card->csd.capacity * card->csd.sector_size;
+    return ESP_OK;
+}
+
 //==================================================================================
 // spiffs
 //==================================================================================
@@ -711,6 +816,49 @@ static int volume;
         .gpio_cfg = BSP_I2S_GPIO_CFG,                                                                 \
     }
 
+/* Zero keeps the driver default */
+static bsp_audio_dma_config_t audio_dma_config;
+static volatile uint32_t audio_tx_underruns;
+static volatile uint32_t audio_rx_overruns;
+
+esp_err_t bsp_audio_set_dma_config(const bsp_audio_dma_config_t* config)
+{
+    if (i2s_tx_chan || i2s_rx_chan) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (config == NULL) {
+        audio_dma_config = (bsp_audio_dma_config_t){0};
+    } else {
+        audio_dma_config = *config;
+    }
+    return ESP_OK;
+}
+
+void bsp_audio_get_dma_config(bsp_audio_dma_config_t* config)
+{
+    i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(CONFIG_BSP_I2S_NUM, I2S_ROLE_MASTER);
+    config->dma_desc_num       = audio_dma_config.dma_desc_num ? audio_dma_config.dma_desc_num : chan_cfg.dma_desc_num;
+    config->dma_frame_num = audio_dma_config.dma_frame_num ? audio_dma_config.dma_frame_num : chan_cfg.dma_frame_num;
+}
+
+void bsp_audio_get_dma_stats(bsp_audio_dma_stats_t* stats)
+{
+    stats->tx_underruns = audio_tx_underruns;
+    stats->rx_overruns  = audio_rx_overruns;
+}
+
+static bool IRAM_ATTR bsp_audio_on_send_q_ovf(i2s_chan_handle_t handle, i2s_event_data_t* event, void* user_ctx)
+{
+    audio_tx_underruns++;
+    return false;
+}
+
+static bool IRAM_ATTR bsp_audio_on_recv_q_ovf(i2s_chan_handle_t handle, i2s_event_data_t* event, void* user_ctx)
+{
+    audio_rx_overruns++;
+    return false;
+}
+
 esp_err_t bsp_audio_init(const i2s_std_config_t* i2s_config)
 {
     if (i2s_tx_chan && i2s_rx_chan) {
@@ -721,7 +869,18 @@ esp_err_t bsp_audio_init(const i2s_std_config_t* i2s_config)
     /* Setup I2S peripheral */
     i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(CONFIG_BSP_I2S_NUM, I2S_ROLE_MASTER);
     chan_cfg.auto_clear        = true;  // Auto clear the legacy data in the DMA buffer
+    bsp_audio_dma_config_t dma_cfg;
+    bsp_audio_get_dma_config(&dma_cfg);
+    chan_cfg.dma_desc_num  = dma_cfg.dma_desc_num;
+    chan_cfg.dma_frame_num = dma_cfg.dma_frame_num;
     ESP_ERROR_CHECK(i2s_new_channel(&chan_cfg, &i2s_tx_chan, &i2s_rx_chan));
+    ESP_LOGI(TAG, "I2S DMA %d x %d frames", (int)dma_cfg.dma_desc_num, (int)dma_cfg.dma_frame_num);
+
+    /* Queue overflows are the underrun and overrun counts, callbacks go in before the channels are enabled */
+    i2s_event_callbacks_t tx_cbs = {.on_send_q_ovf = bsp_audio_on_send_q_ovf};
+    i2s_event_callbacks_t rx_cbs = {.on_recv_q_ovf = bsp_audio_on_recv_q_ovf};
+    ESP_ERROR_CHECK(i2s_channel_register_event_callback(i2s_tx_chan, &tx_cbs, NULL));
+    ESP_ERROR_CHECK(i2s_channel_register_event_callback(i2s_rx_chan, &rx_cbs, NULL));
 
     /* Setup I2S channels */
     // const i2s_std_config_t std_cfg_default = BSP_I2S_DUPLEX_MONO_CFG(16000);
@@ -1030,6 +1189,11 @@ esp_err_t bsp_display_brightness_init(void)
                                                          .hpoint     = 0};
 
     ESP_ERROR_CHECK(ledc_channel_config(&lcd_backlight_channel));
+    // Fades run on the LEDC fade interrupt, the driver is shared with the camera oscillator channel
+    esp_err_t ret = ledc_fade_func_install(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "ledc_fade_func_install failed, rc=%x", ret);
+    }
 
     return ESP_OK;
 }
@@ -1046,11 +1210,32 @@ esp_err_t bsp_display_brightness_set(int brightness_percent)
     ESP_LOGI(TAG, "Setting LCD backlight: %d%%", brightness_percent);
     // uint32_t duty_cycle = (1023 * brightness_percent) / 100; // LEDC resolution set to 10bits, thus: 100% = 1023
     uint32_t duty_cycle = (4095 * brightness_percent) / 100;  // LEDC resolution set to 12bits, thus: 100% = 4095
+    // A running fade would overwrite the duty on its next step
+    ledc_fade_stop(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH);
     BSP_ERROR_CHECK_RETURN_ERR(ledc_set_duty(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH, duty_cycle));
     BSP_ERROR_CHECK_RETURN_ERR(ledc_update_duty(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH));
     return ESP_OK;
 }
 
+esp_err_t bsp_display_brightness_fade(int brightness_percent, int fade_ms)
+{
+    if (fade_ms <= 0) {
+        return bsp_display_brightness_set(brightness_percent);
+    }
+    if (brightness_percent > 100) {
+        brightness_percent = 100;
+    }
+    if (brightness_percent < 0) {
+        brightness_percent = 0;
+    }
+
+    uint32_t duty_cycle = (4095 * brightness_percent) / 100;
+    ledc_fade_stop(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH);
+    BSP_ERROR_CHECK_RETURN_ERR(
+        ledc_set_fade_time_and_start(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH, duty_cycle, fade_ms, LEDC_FADE_NO_WAIT));
+    return ESP_OK;
+}
+
 esp_err_t bsp_display_backlight_off(void)
 {
     return bsp_display_brightness_set(0);
@@ -1094,6 +1279,56 @@ esp_err_t bsp_display_new(const bsp_display_config_t* config, esp_lcd_panel_hand
 
 #if defined(LCD_MIPI_DSI_USE_ILI9881C) && !defined(LCD_MIPI_DSI_USE_ST7703)
 #include "ili9881_init_data.c"
+
+// Panel timing, about 48 Hz at 720*1280 RGB565. bsp_display_set_refresh_rate() stretches the front porch from here
+#define LCD_DPI_CLOCK_MHZ         (60)
+#define LCD_HSYNC_BACK_PORCH      (140)
+#define LCD_HSYNC_PULSE_WIDTH     (40)
+#define LCD_HSYNC_FRONT_PORCH     (40)
+#define LCD_VSYNC_BACK_PORCH      (20)
+#define LCD_VSYNC_PULSE_WIDTH     (4)
+#define LCD_VSYNC_FRONT_PORCH     (20)
+#define LCD_VSYNC_FRONT_PORCH_MAX (1023)  // Width of the VFP field of the DSI host
+
+// Handed to the driver in place of the vendor table, which is sent by bsp_display_send_init_cmds() once the driver
+// has woken the panel, the same point the driver would have sent it at
+static const ili9881c_lcd_init_cmd_t tab5_lcd_ili9881c_driver_init_code[] = {
+    {0xFF, (uint8_t[]){0x98, 0x81, 0x00}, 3, 0},
+};
+
+// The driver yields after every command, even with no delay. With the boot stages running in parallel each yield can
+// cost the rest of a tick, so the ~200 commands are sent back to back and only the real delays sleep
+static esp_err_t bsp_display_send_init_cmds(esp_lcd_panel_io_handle_t io, const ili9881c_lcd_init_cmd_t* cmds,
+                                            size_t count)
+{
+    int64_t start = esp_timer_get_time();
+    for (size_t i = 0; i < count; i++) {
+        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, cmds[i].cmd, cmds[i].data, cmds[i].data_bytes), TAG,
+                            "Send init cmd 0x%02x failed", cmds[i].cmd);
+        if (cmds[i].delay_ms > 0) {
+            vTaskDelay(pdMS_TO_TICKS(cmds[i].delay_ms));
+        }
+    }
+    ESP_LOGI(TAG, "Panel init sequence, %d cmds in %d us", (int)count, (int)(esp_timer_get_time() - start));
+    return ESP_OK;
+}
+
+// Written before the panel starts scanning, so its first frame is the splash instead of an empty buffer. It stays up
+// until LVGL flushes, which is after the rest of the HAL is up
+static void bsp_display_fill_splash(esp_lcd_panel_handle_t panel, uint16_t color)
+{
+    void* fb = NULL;
+    if (esp_lcd_dpi_panel_get_frame_buffer(panel, 1, &fb) != ESP_OK || fb == NULL) {
+        ESP_LOGW(TAG, "No frame buffer for the splash");
+        return;
+    }
+    uint16_t* pixels = (uint16_t*)fb;
+    size_t count     = BSP_LCD_H_RES * BSP_LCD_V_RES;
+    for (size_t i = 0; i < count; i++) {
+        pixels[i] = color;
+    }
+    esp_cache_msync(fb, count * sizeof(uint16_t), ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+}
 #endif
 
 esp_err_t bsp_display_new_with_handles(const bsp_display_config_t* config, bsp_lcd_handles_t* ret_handles)
@@ -1129,27 +1364,26 @@ esp_err_t bsp_display_new_with_handles(const bsp_display_config_t* config, bsp_l
     esp_lcd_dpi_panel_config_t dpi_config = {
         .virtual_channel    = 0,
         .dpi_clk_src        = MIPI_DSI_DPI_CLK_SRC_DEFAULT,
-        .dpi_clock_freq_mhz = 60,  // 720*1280 RGB24 60Hz RGB24 // 80,
+        .dpi_clock_freq_mhz = LCD_DPI_CLOCK_MHZ,
         .pixel_format       = LCD_COLOR_PIXEL_FORMAT_RGB565,
-        .num_fbs            = 1,
+        .num_fbs            = CONFIG_BSP_LCD_DPI_BUFFER_NUMS,
         .video_timing =
             {
                 .h_size            = BSP_LCD_H_RES,
                 .v_size            = BSP_LCD_V_RES,
-                .hsync_back_porch  = 140,
-                .hsync_pulse_width = 40,
-                .hsync_front_porch = 40,
-                .vsync_back_porch  = 20,
-                .vsync_pulse_width = 4,
-                .vsync_front_porch = 20,
+                .hsync_back_porch  = LCD_HSYNC_BACK_PORCH,
+                .hsync_pulse_width = LCD_HSYNC_PULSE_WIDTH,
+                .hsync_front_porch = LCD_HSYNC_FRONT_PORCH,
+                .vsync_back_porch  = LCD_VSYNC_BACK_PORCH,
+                .vsync_pulse_width = LCD_VSYNC_PULSE_WIDTH,
+                .vsync_front_porch = LCD_VSYNC_FRONT_PORCH,
             },
         .flags.use_dma2d = true,
     };
 
     ili9881c_vendor_config_t vendor_config = {
-        .init_cmds      = tab5_lcd_ili9881c_specific_init_code_default,
-        .init_cmds_size = sizeof(tab5_lcd_ili9881c_specific_init_code_default) /
-                          sizeof(tab5_lcd_ili9881c_specific_init_code_default[0]),
+        .init_cmds      = tab5_lcd_ili9881c_driver_init_code,
+        .init_cmds_size = sizeof(tab5_lcd_ili9881c_driver_init_code) / sizeof(tab5_lcd_ili9881c_driver_init_code[0]),
         .mipi_config =
             {
                 .dsi_bus    = mipi_dsi_bus,
@@ -1165,8 +1399,15 @@ esp_err_t bsp_display_new_with_handles(const bsp_display_config_t* config, bsp_l
         .vendor_config  = &vendor_config,
     };
     ESP_ERROR_CHECK(esp_lcd_new_panel_ili9881c(io, &lcd_dev_config, &disp_panel));
+    if (config != NULL && config->splash) {
+        bsp_display_fill_splash(disp_panel, config->splash_color);
+    }
     ESP_ERROR_CHECK(esp_lcd_panel_reset(disp_panel));
     ESP_ERROR_CHECK(esp_lcd_panel_init(disp_panel));
+    ESP_GOTO_ON_ERROR(bsp_display_send_init_cmds(io, tab5_lcd_ili9881c_specific_init_code_default,
+                                                 sizeof(tab5_lcd_ili9881c_specific_init_code_default) /
+                                                     sizeof(tab5_lcd_ili9881c_specific_init_code_default[0])),
+                      err, TAG, "LCD panel init sequence failed");
     //  ESP_ERROR_CHECK(esp_lcd_panel_mirror(disp_panel, false, true));
     ESP_ERROR_CHECK(esp_lcd_panel_disp_on_off(disp_panel, true));
 
@@ -1177,7 +1418,7 @@ esp_err_t bsp_display_new_with_handles(const bsp_display_config_t* config, bsp_l
         .dpi_clk_src = MIPI_DSI_DPI_CLK_SRC_DEFAULT,
         .dpi_clock_freq_mhz = 60,                       // LCD_MIPI_DSI_DPI_CLK_MHZ_ST7703,
         .pixel_format = LCD_COLOR_PIXEL_FORMAT_RGB565,  // LCD_COLOR_PIXEL_FORMAT_RGB888,
-        .num_fbs = 1,
+        .num_fbs = CONFIG_BSP_LCD_DPI_BUFFER_NUMS,
         .video_timing =
             {
                 .h_size = BSP_LCD_H_RES,  // lcd_param.width,
@@ -1266,11 +1507,14 @@ esp_err_t bsp_touch_new(const bsp_touch_config_t* config, esp_lcd_touch_handle_t
 }
 
 #if (BSP_CONFIG_NO_GRAPHIC_LIB == 0)
+static esp_lcd_panel_handle_t _lcd_panel;
+
 static lv_display_t* bsp_display_lcd_init(const bsp_display_cfg_t* cfg)
 {
     assert(cfg != NULL);
     bsp_lcd_handles_t lcd_panels;
-    BSP_ERROR_CHECK_RETURN_NULL(bsp_display_new_with_handles(NULL, &lcd_panels));
+    BSP_ERROR_CHECK_RETURN_NULL(bsp_display_new_with_handles(&cfg->panel, &lcd_panels));
+    _lcd_panel = lcd_panels.panel;
 
     /* Add LCD screen */
     ESP_LOGD(TAG, "Add LCD screen");
@@ -1312,6 +1556,8 @@ static lv_display_t* bsp_display_lcd_init(const bsp_display_cfg_t* cfg)
          .full_refresh = true,
 #elif CONFIG_BSP_DISPLAY_LVGL_DIRECT_MODE
          .direct_mode = true,
+#elif CONFIG_BSP_DISPLAY_LVGL_DIRTY_RECTS
+         .direct_mode = (cfg->buffer_size == BSP_LCD_H_RES * BSP_LCD_V_RES), /* Direct mode needs full buffers */
 #endif
      } };
 
@@ -1320,6 +1566,9 @@ static lv_display_t* bsp_display_lcd_init(const bsp_display_cfg_t* cfg)
                                                      .avoid_tearing = true,
 #else
                                                      .avoid_tearing = false,
+#endif
+#if CONFIG_BSP_DISPLAY_LVGL_VSYNC_SWAP
+                                                     .vsync_swap = true,
 #endif
                                                  }};
 
@@ -1380,6 +1629,35 @@ lv_display_t* bsp_display_start_with_config(const bsp_display_cfg_t* cfg)
 
     BSP_NULL_CHECK(disp = bsp_display_lcd_init(cfg), NULL);
     BSP_NULL_CHECK(disp_indev = bsp_display_indev_init(disp), NULL);
+
+#if CONFIG_BSP_DISPLAY_LVGL_PPA_DRAW
+    const lvgl_port_ppa_draw_cfg_t ppa_draw_cfg = {
+        .min_area       = CONFIG_BSP_DISPLAY_LVGL_PPA_DRAW_MIN_AREA,
+        .img_cache_size = CONFIG_BSP_DISPLAY_LVGL_PPA_DRAW_IMG_CACHE_KB * 1024,
+    };
+    bsp_display_lock(0);
+    if (lvgl_port_ppa_draw_init(&ppa_draw_cfg) != ESP_OK) {
+        ESP_LOGW(TAG, "PPA draw unit not available, rendering in software");
+    }
+    bsp_display_unlock();
+#endif
+
+    bsp_display_lock(0);
+    if (lvgl_port_glyph_cache_init(CONFIG_BSP_DISPLAY_LVGL_GLYPH_CACHE_KB * 1024) != ESP_OK) {
+        ESP_LOGW(TAG, "Glyph cache not available");
+    }
+#if CONFIG_BSP_DISPLAY_LVGL_JPEG_DECODER
+    if (lvgl_port_jpeg_decoder_init() != ESP_OK) {
+        ESP_LOGW(TAG, "JPEG files will not be decoded");
+    }
+#endif
+#if CONFIG_BSP_DISPLAY_LVGL_LAYER_POOL_CNT > 0
+    if (lvgl_port_layer_pool_init(CONFIG_BSP_DISPLAY_LVGL_LAYER_POOL_BUF_KB * 1024,
+                                  CONFIG_BSP_DISPLAY_LVGL_LAYER_POOL_CNT) != ESP_OK) {
+        ESP_LOGW(TAG, "Layer pool not available");
+    }
+#endif
+    bsp_display_unlock();
     return disp;
 }
 
@@ -1388,6 +1666,79 @@ lv_indev_t* bsp_display_get_input_dev(void)
     return disp_indev;
 }
 
+esp_err_t bsp_display_panel_on_off(bool on)
+{
+    if (_lcd_panel == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return esp_lcd_panel_disp_on_off(_lcd_panel, on);
+}
+
+#if defined(LCD_MIPI_DSI_USE_ILI9881C) && !defined(LCD_MIPI_DSI_USE_ST7703)
+static portMUX_TYPE _refresh_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t _refresh_vfp      = LCD_VSYNC_FRONT_PORCH;
+
+static uint32_t bsp_display_h_total(void)
+{
+    return BSP_LCD_H_RES + LCD_HSYNC_PULSE_WIDTH + LCD_HSYNC_BACK_PORCH + LCD_HSYNC_FRONT_PORCH;
+}
+
+static uint32_t bsp_display_v_lines(void)
+{
+    return BSP_LCD_V_RES + LCD_VSYNC_PULSE_WIDTH + LCD_VSYNC_BACK_PORCH;
+}
+
+esp_err_t bsp_display_set_refresh_rate(int hz)
+{
+    if (_lcd_panel == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    uint32_t vfp = LCD_VSYNC_FRONT_PORCH;
+    if (hz > 0) {
+        uint32_t lines = LCD_DPI_CLOCK_MHZ * 1000000 / (bsp_display_h_total() * hz);
+        if (lines > bsp_display_v_lines() + LCD_VSYNC_FRONT_PORCH) {
+            vfp = lines - bsp_display_v_lines();
+        }
+        if (vfp > LCD_VSYNC_FRONT_PORCH_MAX) {
+            vfp = LCD_VSYNC_FRONT_PORCH_MAX;
+        }
+    }
+
+    // The host and the bridge both count the lines, they have to agree or the panel loses sync
+    dsi_host_dev_t* host = MIPI_DSI_LL_GET_HOST(0);
+    dsi_brg_dev_t* brg   = MIPI_DSI_LL_GET_BRG(0);
+    portENTER_CRITICAL(&_refresh_lock);
+    if (vfp != _refresh_vfp) {
+        mipi_dsi_host_ll_dpi_set_vertical_timing(host, LCD_VSYNC_PULSE_WIDTH, LCD_VSYNC_BACK_PORCH, BSP_LCD_V_RES,
+                                                 vfp);
+        mipi_dsi_brg_ll_set_vertical_timing(brg, LCD_VSYNC_PULSE_WIDTH, LCD_VSYNC_BACK_PORCH, BSP_LCD_V_RES, vfp);
+        mipi_dsi_brg_ll_update_dpi_config(brg);
+        _refresh_vfp = vfp;
+    }
+    portEXIT_CRITICAL(&_refresh_lock);
+    return ESP_OK;
+}
+
+int bsp_display_get_refresh_rate(void)
+{
+    if (_lcd_panel == NULL) {
+        return 0;
+    }
+    return LCD_DPI_CLOCK_MHZ * 1000000 / (bsp_display_h_total() * (bsp_display_v_lines() + _refresh_vfp));
+}
+#else
+esp_err_t bsp_display_set_refresh_rate(int hz)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+int bsp_display_get_refresh_rate(void)
+{
+    return 0;
+}
+#endif
+
 void bsp_display_rotate(lv_display_t* disp, lv_disp_rotation_t rotation)
 {
     lv_disp_set_rotation(disp, rotation);
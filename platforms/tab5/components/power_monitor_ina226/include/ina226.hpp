@@ -130,12 +130,15 @@ public:
 
     bool isMathOverflow(void);
     bool isAlert(void);
+    // Reading the flag clears it, set again at the end of the next conversion
+    bool isConversionReady(void);
 
     float readShuntCurrent(void);
     float readShuntVoltage(void);
     float readBusPower(void);
     float readBusVoltage(void);
     int16_t readRawShuntCurrent(void);
+    uint32_t getConversionTimeUs(void);
 
     float getMaxPossibleCurrent(void);
     float getMaxCurrent(void);
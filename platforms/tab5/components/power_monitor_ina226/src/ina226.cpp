@@ -155,6 +155,25 @@ float INA226::readBusVoltage(void)
     return (voltage * 0.00125);
 }
 
+uint32_t INA226::getConversionTimeUs(void)
+{
+    static const uint16_t convTimeUs[] = {140, 204, 332, 588, 1100, 2116, 4156, 8244};
+    static const uint16_t averages[]   = {1, 4, 16, 64, 128, 256, 512, 1024};
+
+    uint16_t value = readRegister16(INA226_REG_CONFIG);
+    uint32_t time  = 0;
+
+    // Continuous and triggered modes convert whichever of shunt and bus is enabled
+    if (value & 0b001) {
+        time += convTimeUs[(value >> 3) & 0b111];
+    }
+    if (value & 0b010) {
+        time += convTimeUs[(value >> 6) & 0b111];
+    }
+
+    return time * averages[(value >> 9) & 0b111];
+}
+
 ina226_averages_t INA226::getAverages(void)
 {
     uint16_t value;
@@ -297,6 +316,11 @@ bool INA226::isAlert(void)
     return ((getMaskEnable() & INA226_BIT_AFF) == INA226_BIT_AFF);
 }
 
+bool INA226::isConversionReady(void)
+{
+    return ((getMaskEnable() & INA226_BIT_CVRF) == INA226_BIT_CVRF);
+}
+
 int16_t INA226::readRegister16(uint8_t reg)
 {
     uint8_t r_buffer[2] = {0};
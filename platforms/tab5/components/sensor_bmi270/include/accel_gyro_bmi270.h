@@ -6,6 +6,7 @@ extern "C" {
 
 #include "driver/i2c_master.h"
 #include "bmi270.h"
+#include "bmi270_legacy.h"
 
 esp_err_t accel_gyro_bmi270_init(i2c_master_bus_handle_t bus_handle);
 void accel_gyro_bmi270_enable_sensor(void);
@@ -17,6 +18,51 @@ bool accel_gyro_bmi270_check_irq(void);
 void accel_gyro_bmi270_clear_irq_int(void);
 bool accel_gyro_bmi270_motion_irq(void);
 
+/**
+ * @brief Stream accel and gyro frames through the FIFO, in headerless mode at the same ODR
+ *
+ * @param rate_hz 100, 200, 400, 800 or 1600
+ * @param watermark_frames FIFO watermark, in accel + gyro frames
+ */
+bool accel_gyro_bmi270_fifo_enable(uint16_t rate_hz, uint16_t watermark_frames);
+void accel_gyro_bmi270_fifo_disable(void);
+
+/**
+ * @brief Drain the FIFO in one burst read
+ *
+ * @param accel out, max_frames entries
+ * @param gyro out, max_frames entries
+ * @param max_frames
+ * @return frames read, oldest first
+ */
+uint16_t accel_gyro_bmi270_fifo_read(struct bmi2_sens_axes_data *accel, struct bmi2_sens_axes_data *gyro,
+                                     uint16_t max_frames);
+
+/* Feature engine gestures */
+#define ACCEL_GYRO_BMI270_GESTURE_SINGLE_TAP  (1 << 0)
+#define ACCEL_GYRO_BMI270_GESTURE_DOUBLE_TAP  (1 << 1)
+#define ACCEL_GYRO_BMI270_GESTURE_ORIENTATION (1 << 2)
+#define ACCEL_GYRO_BMI270_GESTURE_NO_MOTION   (1 << 3)
+
+/**
+ * @brief Load the legacy feature config and enable the selected gestures, detection runs on the chip
+ *
+ * The features are mapped to INT2, which only latches the status, the pin output is left off.
+ * The legacy config replaces the one loaded by accel_gyro_bmi270_init(), call that again to use the motion wakeup.
+ *
+ * @param gestures ACCEL_GYRO_BMI270_GESTURE_* mask
+ */
+bool accel_gyro_bmi270_gesture_enable(uint8_t gestures);
+
+/**
+ * @brief Read and clear the latched feature status
+ *
+ * @param portrait_landscape out, orientation when ACCEL_GYRO_BMI270_GESTURE_ORIENTATION is set
+ * @param face_down out
+ * @return ACCEL_GYRO_BMI270_GESTURE_* mask of the gestures seen since the last call
+ */
+uint8_t accel_gyro_bmi270_gesture_poll(uint8_t *portrait_landscape, uint8_t *face_down);
+
 #ifdef __cplusplus
 }
 #endif
@@ -244,6 +244,236 @@ bool accel_gyro_bmi270_motion_irq(void)
     return true;
 }
 
+// The BMI270 FIFO holds 2KB, enough for 170 accel + gyro frames
+#define FIFO_BUFFER_SIZE 2048
+
+static uint8_t fifo_buffer[FIFO_BUFFER_SIZE + 4];
+
+bool accel_gyro_bmi270_fifo_enable(uint16_t rate_hz, uint16_t watermark_frames)
+{
+    int8_t rslt;
+
+    if (i2c_dev_handle_bmi270 == NULL) {
+        ESP_LOGE(TAG, "i2c_dev_handle_bmi270 is NULL");
+        return false;
+    }
+
+    uint8_t acc_odr = BMI2_ACC_ODR_400HZ;
+    uint8_t gyr_odr = BMI2_GYR_ODR_400HZ;
+    switch (rate_hz) {
+        case 100:
+            acc_odr = BMI2_ACC_ODR_100HZ;
+            gyr_odr = BMI2_GYR_ODR_100HZ;
+            break;
+        case 200:
+            acc_odr = BMI2_ACC_ODR_200HZ;
+            gyr_odr = BMI2_GYR_ODR_200HZ;
+            break;
+        case 400:
+            break;
+        case 800:
+            acc_odr = BMI2_ACC_ODR_800HZ;
+            gyr_odr = BMI2_GYR_ODR_800HZ;
+            break;
+        case 1600:
+            acc_odr = BMI2_ACC_ODR_1600HZ;
+            gyr_odr = BMI2_GYR_ODR_1600HZ;
+            break;
+        default:
+            ESP_LOGE(TAG, "unsupported fifo rate: %d", rate_hz);
+            return false;
+    }
+
+    uint8_t sens_list[2] = {BMI2_ACCEL, BMI2_GYRO};
+    struct bmi2_sens_config config[2];
+    config[ACCEL].type = BMI2_ACCEL;
+    config[GYRO].type  = BMI2_GYRO;
+
+    rslt = bmi2_get_sensor_config(config, 2, &bmi270);
+    bmi2_error_codes_print_result(rslt);
+    if (rslt != BMI2_OK) return false;
+
+    // Same ranges as accel_gyro_bmi270_enable_sensor(), so the scale factors stay valid
+    config[ACCEL].cfg.acc.odr   = acc_odr;
+    config[ACCEL].cfg.acc.range = BMI2_ACC_RANGE_4G;
+    config[GYRO].cfg.gyr.odr    = gyr_odr;
+    config[GYRO].cfg.gyr.range  = BMI2_GYR_RANGE_1000;
+    rslt                        = bmi270_set_sensor_config(config, 2, &bmi270);
+    bmi2_error_codes_print_result(rslt);
+    if (rslt != BMI2_OK) return false;
+
+    rslt = bmi270_sensor_enable(sens_list, 2, &bmi270);
+    bmi2_error_codes_print_result(rslt);
+    if (rslt != BMI2_OK) return false;
+
+    /* Headerless frames, accel and gyro only */
+    rslt = bmi2_set_fifo_config(BMI2_FIFO_ALL_EN | BMI2_FIFO_HEADER_EN, BMI2_DISABLE, &bmi270);
+    if (rslt == BMI2_OK) {
+        rslt = bmi2_set_fifo_config(BMI2_FIFO_ACC_EN | BMI2_FIFO_GYR_EN, BMI2_ENABLE, &bmi270);
+    }
+    if (rslt == BMI2_OK) {
+        rslt = bmi2_set_fifo_wm(watermark_frames * BMI2_FIFO_ACC_GYR_LENGTH, &bmi270);
+    }
+    if (rslt == BMI2_OK) {
+        rslt = bmi2_set_command_register(BMI2_FIFO_FLUSH_CMD, &bmi270);
+    }
+    bmi2_error_codes_print_result(rslt);
+
+    return rslt == BMI2_OK;
+}
+
+void accel_gyro_bmi270_fifo_disable(void)
+{
+    if (i2c_dev_handle_bmi270 == NULL) {
+        ESP_LOGE(TAG, "i2c_dev_handle_bmi270 is NULL");
+        return;
+    }
+    int8_t rslt = bmi2_set_fifo_config(BMI2_FIFO_ALL_EN, BMI2_DISABLE, &bmi270);
+    bmi2_error_codes_print_result(rslt);
+}
+
+uint16_t accel_gyro_bmi270_fifo_read(struct bmi2_sens_axes_data *accel, struct bmi2_sens_axes_data *gyro,
+                                     uint16_t max_frames)
+{
+    if (i2c_dev_handle_bmi270 == NULL) {
+        ESP_LOGE(TAG, "i2c_dev_handle_bmi270 is NULL");
+        return 0;
+    }
+
+    uint16_t fifo_length = 0;
+    if (bmi2_get_fifo_length(&fifo_length, &bmi270) != BMI2_OK || fifo_length == 0) {
+        return 0;
+    }
+
+    /* Whole frames only, the rest stays in the FIFO for the next read */
+    uint16_t frames = fifo_length / BMI2_FIFO_ACC_GYR_LENGTH;
+    if (frames > max_frames) {
+        frames = max_frames;
+    }
+    if (frames > FIFO_BUFFER_SIZE / BMI2_FIFO_ACC_GYR_LENGTH) {
+        frames = FIFO_BUFFER_SIZE / BMI2_FIFO_ACC_GYR_LENGTH;
+    }
+    if (frames == 0) {
+        return 0;
+    }
+
+    struct bmi2_fifo_frame fifo = {0};
+    fifo.data                   = fifo_buffer;
+    fifo.length                 = frames * BMI2_FIFO_ACC_GYR_LENGTH + bmi270.dummy_byte;
+    if (bmi2_read_fifo_data(&fifo, &bmi270) != BMI2_OK) {
+        return 0;
+    }
+
+    uint16_t accel_frames = frames;
+    uint16_t gyro_frames  = frames;
+    bmi2_extract_accel(accel, &accel_frames, &fifo, &bmi270);
+    bmi2_extract_gyro(gyro, &gyro_frames, &fifo, &bmi270);
+    return accel_frames < gyro_frames ? accel_frames : gyro_frames;
+}
+
+bool accel_gyro_bmi270_gesture_enable(uint8_t gestures)
+{
+    int8_t rslt;
+
+    if (i2c_dev_handle_bmi270 == NULL) {
+        ESP_LOGE(TAG, "i2c_dev_handle_bmi270 is NULL");
+        return false;
+    }
+
+    /* Tap and orientation only exist in the legacy config */
+    rslt = bmi270_legacy_init(&bmi270);
+    bmi2_error_codes_print_result(rslt);
+    if (rslt != BMI2_OK) return false;
+
+    uint8_t sens_list[5];
+    uint8_t n_sens = 0;
+    struct bmi2_sens_int_config sens_int[3];
+    uint8_t n_int       = 0;
+    sens_list[n_sens++] = BMI2_ACCEL;
+    if (gestures & ACCEL_GYRO_BMI270_GESTURE_SINGLE_TAP) {
+        sens_list[n_sens++] = BMI2_SINGLE_TAP;
+    }
+    if (gestures & ACCEL_GYRO_BMI270_GESTURE_DOUBLE_TAP) {
+        sens_list[n_sens++] = BMI2_DOUBLE_TAP;
+    }
+    if (gestures & (ACCEL_GYRO_BMI270_GESTURE_SINGLE_TAP | ACCEL_GYRO_BMI270_GESTURE_DOUBLE_TAP)) {
+        sens_int[n_int].type       = BMI2_TAP;
+        sens_int[n_int].hw_int_pin = BMI2_INT2;
+        n_int++;
+    }
+    if (gestures & ACCEL_GYRO_BMI270_GESTURE_ORIENTATION) {
+        sens_list[n_sens++]        = BMI2_ORIENTATION;
+        sens_int[n_int].type       = BMI2_ORIENTATION;
+        sens_int[n_int].hw_int_pin = BMI2_INT2;
+        n_int++;
+    }
+    if (gestures & ACCEL_GYRO_BMI270_GESTURE_NO_MOTION) {
+        sens_list[n_sens++]        = BMI2_NO_MOTION;
+        sens_int[n_int].type       = BMI2_NO_MOTION;
+        sens_int[n_int].hw_int_pin = BMI2_INT2;
+        n_int++;
+    }
+
+    /* The tap detector is tuned for 200Hz */
+    struct bmi2_sens_config config;
+    config.type = BMI2_ACCEL;
+    rslt        = bmi270_legacy_get_sensor_config(&config, 1, &bmi270);
+    if (rslt == BMI2_OK) {
+        config.cfg.acc.odr   = BMI2_ACC_ODR_200HZ;
+        config.cfg.acc.range = BMI2_ACC_RANGE_4G;
+        rslt                 = bmi270_legacy_set_sensor_config(&config, 1, &bmi270);
+    }
+    if (rslt == BMI2_OK) {
+        rslt = bmi270_legacy_sensor_enable(sens_list, n_sens, &bmi270);
+    }
+    if (rslt == BMI2_OK && n_int > 0) {
+        rslt = bmi270_legacy_map_feat_int(sens_int, n_int, &bmi270);
+    }
+    bmi2_error_codes_print_result(rslt);
+
+    return rslt == BMI2_OK;
+}
+
+uint8_t accel_gyro_bmi270_gesture_poll(uint8_t *portrait_landscape, uint8_t *face_down)
+{
+    if (i2c_dev_handle_bmi270 == NULL) {
+        ESP_LOGE(TAG, "i2c_dev_handle_bmi270 is NULL");
+        return 0;
+    }
+
+    /* Reading the status clears it */
+    uint16_t int_status = 0;
+    if (bmi2_get_int_status(&int_status, &bmi270) != BMI2_OK) {
+        return 0;
+    }
+
+    uint8_t gestures = 0;
+    if (int_status & BMI270_LEGACY_TAP_STATUS_MASK) {
+        uint8_t tap_status = 0;
+        if (bmi2_get_regs(BMI270_LEGACY_TAP_STATUS_REG, &tap_status, 1, &bmi270) == BMI2_OK) {
+            if (tap_status & BMI270_LEGACY_SINGLE_TAP_MASK) {
+                gestures |= ACCEL_GYRO_BMI270_GESTURE_SINGLE_TAP;
+            }
+            if (tap_status & BMI270_LEGACY_DOUBLE_TAP_MASK) {
+                gestures |= ACCEL_GYRO_BMI270_GESTURE_DOUBLE_TAP;
+            }
+        }
+    }
+    if (int_status & BMI270_LEGACY_NO_MOT_STATUS_MASK) {
+        gestures |= ACCEL_GYRO_BMI270_GESTURE_NO_MOTION;
+    }
+    if (int_status & BMI270_LEGACY_ORIENT_STATUS_MASK) {
+        struct bmi2_feat_sensor_data sens_data = {.type = BMI2_ORIENTATION};
+        if (bmi270_legacy_get_feature_data(&sens_data, 1, &bmi270) == BMI2_OK) {
+            *portrait_landscape = sens_data.sens_data.orient_output.portrait_landscape;
+            *face_down          = sens_data.sens_data.orient_output.faceup_down;
+            gestures |= ACCEL_GYRO_BMI270_GESTURE_ORIENTATION;
+        }
+    }
+
+    return gestures;
+}
+
 void accel_gyro_bmi270_get_data(struct bmi2_sens_data *data)
 {
     if (i2c_dev_handle_bmi270 == NULL) {
@@ -299,7 +529,8 @@ void accel_gyro_bmi270_clear_irq_int(void)
 
 static int8_t bmi270_i2c_read(uint8_t reg_addr, uint8_t *reg_data, uint32_t len, void *intf_ptr)
 {
-    if ((reg_data == NULL) || (len == 0) || (len > 32)) {
+    // FIFO bursts read up to the whole FIFO at once
+    if ((reg_data == NULL) || (len == 0) || (len > FIFO_BUFFER_SIZE + 4)) {
         return -1;
     }
 
@@ -22,6 +22,29 @@ esp_err_t accel_gyro_sensor_icm20602_read_accel(float *x, float *y, float *z);
  */
 esp_err_t accel_gyro_sensor_icm20602_read_gyro(float *x, float *y, float *z);
 
+/**
+ * 一次突发读取加速度和角速度原始值, 量程 +-4g / +-1000dps
+ */
+esp_err_t accel_gyro_sensor_icm20602_read_raw(int16_t accel[3], int16_t gyro[3]);
+
+/**
+ * 开启 FIFO, 加速度 + 温度 + 角速度同一采样率写入
+ *
+ * @param rate_hz 采样率, 按 1kHz 分频取最接近的值
+ * @return 实际采样率, 失败返回 0
+ */
+uint16_t accel_gyro_sensor_icm20602_fifo_enable(uint16_t rate_hz);
+void accel_gyro_sensor_icm20602_fifo_disable(void);
+
+/**
+ * 一次突发读取 FIFO 中的完整帧
+ *
+ * @param frames 输出, 每帧 6 个值: 加速度 xyz, 角速度 xyz, 旧帧在前
+ * @param max_frames
+ * @return 读取的帧数
+ */
+uint16_t accel_gyro_sensor_icm20602_fifo_read(int16_t *frames, uint16_t max_frames);
+
 #ifdef __cplusplus
 }
 #endif
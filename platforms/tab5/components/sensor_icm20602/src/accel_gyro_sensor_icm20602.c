@@ -15,8 +15,25 @@
 #define I2C_DEV_ADDR_ICM20602 0x68
 #define ICM_REG_ACCEL_XOUT_H  0x3B
 #define ICM_REG_GYRO_XOUT_H   0x43
+#define ICM_REG_SMPLRT_DIV    0x19
+#define ICM_REG_FIFO_EN       0x23
+#define ICM_REG_USER_CTRL     0x6A
+#define ICM_REG_FIFO_COUNTH   0x72
+#define ICM_REG_FIFO_R_W      0x74
+
+#define ICM_SMPLRT_DIV_DEFAULT 0x07
+#define ICM_FIFO_SIZE          1008
+// 加速度 6 + 温度 2 + 角速度 6
+#define ICM_FIFO_FRAME_LENGTH 14
 
 static i2c_master_dev_handle_t i2c_dev_handle_icm20602;
+static uint8_t fifo_buffer[ICM_FIFO_SIZE];
+
+static esp_err_t icm20602_write_reg(uint8_t reg, uint8_t value)
+{
+    uint8_t write_buf[2] = {reg, value};
+    return i2c_master_transmit(i2c_dev_handle_icm20602, write_buf, 2, I2C_MASTER_TIMEOUT_MS);
+}
 
 /**
  * 初始化
@@ -30,7 +47,10 @@ esp_err_t accel_gyro_sensor_icm20602_init(i2c_master_bus_handle_t bus_handle)
         .device_address  = I2C_DEV_ADDR_ICM20602,
         .scl_speed_hz    = 400000,
     };
-    ESP_ERROR_CHECK(i2c_master_bus_add_device(bus_handle, &dev_cfg, &i2c_dev_handle_icm20602));
+    /* 重复初始化时沿用已添加的设备 */
+    if (i2c_dev_handle_icm20602 == NULL) {
+        ESP_ERROR_CHECK(i2c_master_bus_add_device(bus_handle, &dev_cfg, &i2c_dev_handle_icm20602));
+    }
 
     write_buf[0] = 0x6B;
     write_buf[1] = 0x00;
@@ -42,7 +62,7 @@ esp_err_t accel_gyro_sensor_icm20602_init(i2c_master_bus_handle_t bus_handle)
     write_buf[1] = 0x00;
     i2c_master_transmit(i2c_dev_handle_icm20602, write_buf, 2, I2C_MASTER_TIMEOUT_MS);  // interrupt off
     write_buf[0] = 0x19;
-    write_buf[1] = 0x07;
+    write_buf[1] = ICM_SMPLRT_DIV_DEFAULT;
     i2c_master_transmit(i2c_dev_handle_icm20602, write_buf, 2, I2C_MASTER_TIMEOUT_MS);  // 1KHz
     write_buf[0] = 0x1A;
     write_buf[1] = 0x03;
@@ -111,6 +131,120 @@ esp_err_t accel_gyro_sensor_icm20602_read_gyro(float *x, float *y, float *z)
     return ESP_OK;
 }
 
+/**
+ * 一次突发读取加速度和角速度原始值
+ */
+esp_err_t accel_gyro_sensor_icm20602_read_raw(int16_t accel[3], int16_t gyro[3])
+{
+    uint8_t write_buf[1] = {ICM_REG_ACCEL_XOUT_H};
+    uint8_t read_buf[ICM_FIFO_FRAME_LENGTH];
+
+    /* 加速度, 温度, 角速度寄存器连续排列 */
+    esp_err_t ret = i2c_master_transmit_receive(i2c_dev_handle_icm20602, write_buf, 1, read_buf, sizeof(read_buf),
+                                                I2C_MASTER_TIMEOUT_MS);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    for (int i = 0; i < 3; i++) {
+        accel[i] = (int16_t)((read_buf[i * 2] << 8) | read_buf[i * 2 + 1]);
+        gyro[i]  = (int16_t)((read_buf[8 + i * 2] << 8) | read_buf[8 + i * 2 + 1]);
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * 开启 FIFO
+ */
+uint16_t accel_gyro_sensor_icm20602_fifo_enable(uint16_t rate_hz)
+{
+    if (i2c_dev_handle_icm20602 == NULL || rate_hz == 0) {
+        return 0;
+    }
+
+    /* 开启低通滤波时内部采样率为 1kHz */
+    uint32_t div = (1000 + rate_hz / 2) / rate_hz;
+    div          = div < 1 ? 1 : (div > 256 ? 256 : div);
+
+    esp_err_t ret = icm20602_write_reg(ICM_REG_SMPLRT_DIV, div - 1);
+    if (ret == ESP_OK) {
+        ret = icm20602_write_reg(ICM_REG_FIFO_EN, 0x00);
+    }
+    if (ret == ESP_OK) {
+        ret = icm20602_write_reg(ICM_REG_USER_CTRL, 0x04);  // fifo_rst
+    }
+    if (ret == ESP_OK) {
+        ret = icm20602_write_reg(ICM_REG_FIFO_EN, 0x18);  // gyro_fifo_en, accel_fifo_en
+    }
+    if (ret == ESP_OK) {
+        ret = icm20602_write_reg(ICM_REG_USER_CTRL, 0x40);  // fifo_en
+    }
+    if (ret != ESP_OK) {
+        return 0;
+    }
+
+    return 1000 / div;
+}
+
+void accel_gyro_sensor_icm20602_fifo_disable(void)
+{
+    if (i2c_dev_handle_icm20602 == NULL) {
+        return;
+    }
+    icm20602_write_reg(ICM_REG_FIFO_EN, 0x00);
+    icm20602_write_reg(ICM_REG_USER_CTRL, 0x04);  // fifo_rst
+    icm20602_write_reg(ICM_REG_SMPLRT_DIV, ICM_SMPLRT_DIV_DEFAULT);
+}
+
+/**
+ * 一次突发读取 FIFO
+ */
+uint16_t accel_gyro_sensor_icm20602_fifo_read(int16_t *frames, uint16_t max_frames)
+{
+    if (i2c_dev_handle_icm20602 == NULL) {
+        return 0;
+    }
+
+    uint8_t write_buf[1] = {ICM_REG_FIFO_COUNTH};
+    uint8_t count_buf[2];
+    if (i2c_master_transmit_receive(i2c_dev_handle_icm20602, write_buf, 1, count_buf, 2, I2C_MASTER_TIMEOUT_MS) !=
+        ESP_OK) {
+        return 0;
+    }
+    uint16_t fifo_count = ((count_buf[0] << 8) | count_buf[1]) & 0x1FFF;
+
+    /* 写满后最旧的数据被覆盖, 帧边界不再可靠, 清空重来 */
+    if (fifo_count >= ICM_FIFO_SIZE) {
+        icm20602_write_reg(ICM_REG_USER_CTRL, 0x44);  // fifo_en, fifo_rst
+        return 0;
+    }
+
+    /* 只读完整帧, 剩余的留到下次 */
+    uint16_t count = fifo_count / ICM_FIFO_FRAME_LENGTH;
+    if (count > max_frames) {
+        count = max_frames;
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    write_buf[0] = ICM_REG_FIFO_R_W;
+    if (i2c_master_transmit_receive(i2c_dev_handle_icm20602, write_buf, 1, fifo_buffer, count * ICM_FIFO_FRAME_LENGTH,
+                                    I2C_MASTER_TIMEOUT_MS) != ESP_OK) {
+        return 0;
+    }
+    for (uint16_t n = 0; n < count; n++) {
+        const uint8_t *src = fifo_buffer + n * ICM_FIFO_FRAME_LENGTH;
+        int16_t *dst       = frames + n * 6;
+        for (int i = 0; i < 3; i++) {
+            dst[i]     = (int16_t)((src[i * 2] << 8) | src[i * 2 + 1]);
+            dst[3 + i] = (int16_t)((src[8 + i * 2] << 8) | src[8 + i * 2 + 1]);
+        }
+    }
+
+    return count;
+}
+
 // void MahonyAHRSupdateIMU(float gx, float gy, float gz, float ax, float ay, float az)
 // {
 //     float recipNorm;
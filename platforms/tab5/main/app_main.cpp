@@ -58,13 +58,10 @@ extern "C" void app_main(void)
     while (!app::IsDone()) {
         // アプリケーションフレームワークの更新処理 (app::Update()) を呼び出します。
         // この中で、UIの更新、イベント処理、その他の周期的タスクが実行されます。
+        // app::Update() の最後で次の更新まで待機します。
+        // UIのアニメーション中は1ティックだけ他のタスクにCPUを譲り、UIが静止している間は
+        // タッチ入力やHALのイベントで起こされるまで (最大でアイドル時のポーリング間隔まで) スリープします。
         app::Update();
-
-        // FreeRTOSのvTaskDelay関数を使用して、現在のタスクを1ミリ秒間遅延させます。
-        // これにより、他のタスクにCPUの実行機会を与え、システム全体の応答性を保ちます。
-        // 引数の1はティック数ではなく、pdMS_TO_TICKSマクロ(FreeRTOSの便宜的マクロだがここでは直接1を指定)により適切に変換されるか、
-        // もしくは1ティックを指定していることを意味します。ESP-IDFではデフォルトで1ティック1msが多いです。
-        vTaskDelay(1);
     }
 
     // アプリケーションのメインループが終了した後、アプリケーションフレームワークの終了処理 (app::Destroy()) を呼び出します。
@@ -0,0 +1,123 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <atomic>
+#include <string>
+#include <string.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+
+static const std::string _tag = "asset-pack";
+
+/*
+ * Pack layout, little endian, structs are packed, built by platforms/tab5/tools/build_asset_pack.py:
+ * header : "M5AP", u16 version, u16 entry count, u32 total size, u32 CRC-32 of the index
+ * index  : per entry, name (32 bytes, NUL padded), u32 offset from the pack start, u32 size, u32 format, u32 CRC-32
+ * data   : each entry 16 byte aligned
+ * Only the index is checked at boot, the entry CRCs are there for tools. CRC-32 is the zlib one
+ */
+static constexpr uint16_t _format_version   = 1;
+static const char* _partition_label         = "assets";
+static constexpr uint8_t _partition_subtype = 0x40;
+static constexpr size_t _name_size          = 32;
+
+struct __attribute__((packed)) PackHeader_t {
+    char magic[4]      = {'M', '5', 'A', 'P'};
+    uint16_t version   = _format_version;
+    uint16_t count     = 0;
+    uint32_t totalSize = 0;
+    uint32_t indexCrc  = 0;
+};
+
+struct __attribute__((packed)) PackEntry_t {
+    char name[_name_size];
+    uint32_t offset;
+    uint32_t size;
+    uint32_t format;
+    uint32_t crc;
+};
+
+struct AssetPackData_t {
+    const uint8_t* base        = nullptr;
+    const PackEntry_t* entries = nullptr;
+    uint16_t count             = 0;
+    esp_partition_mmap_handle_t handle;
+    // Set once the mapping is complete, the readers never lock
+    std::atomic<bool> isReady = false;
+};
+static AssetPackData_t _asset_pack_data;
+
+void HalEsp32::asset_pack_init()
+{
+    const esp_partition_t* partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, static_cast<esp_partition_subtype_t>(_partition_subtype), _partition_label);
+    if (partition == nullptr) {
+        mclog::tagError(_tag, "no {} partition", _partition_label);
+        return;
+    }
+
+    // The header is read first, only the used part of the partition gets mapped
+    PackHeader_t header;
+    if (esp_partition_read(partition, 0, &header, sizeof(header)) != ESP_OK) {
+        mclog::tagError(_tag, "read header failed");
+        return;
+    }
+    if (memcmp(header.magic, "M5AP", 4) != 0 || header.version != _format_version ||
+        header.totalSize > partition->size ||
+        sizeof(PackHeader_t) + header.count * sizeof(PackEntry_t) > header.totalSize) {
+        mclog::tagError(_tag, "no valid pack, flash it with idf.py flash");
+        return;
+    }
+
+    const void* mapped = nullptr;
+    if (esp_partition_mmap(partition, 0, header.totalSize, ESP_PARTITION_MMAP_DATA, &mapped,
+                           &_asset_pack_data.handle) != ESP_OK) {
+        mclog::tagError(_tag, "mmap failed");
+        return;
+    }
+
+    auto base    = static_cast<const uint8_t*>(mapped);
+    auto entries = reinterpret_cast<const PackEntry_t*>(base + sizeof(PackHeader_t));
+    if (esp_rom_crc32_le(0, (const uint8_t*)entries, header.count * sizeof(PackEntry_t)) != header.indexCrc) {
+        mclog::tagError(_tag, "index crc mismatch");
+        esp_partition_munmap(_asset_pack_data.handle);
+        return;
+    }
+    for (uint16_t i = 0; i < header.count; i++) {
+        if ((uint64_t)entries[i].offset + entries[i].size > header.totalSize) {
+            mclog::tagError(_tag, "entry {} out of range", i);
+            esp_partition_munmap(_asset_pack_data.handle);
+            return;
+        }
+    }
+
+    _asset_pack_data.base    = base;
+    _asset_pack_data.entries = entries;
+    _asset_pack_data.count   = header.count;
+    _asset_pack_data.isReady = true;
+    mclog::tagInfo(_tag, "{} assets, {} KB mapped", _asset_pack_data.count, header.totalSize / 1024);
+}
+
+bool HalEsp32::getAsset(const std::string& name, Asset_t& asset)
+{
+    if (!_asset_pack_data.isReady || name.size() >= _name_size) {
+        return false;
+    }
+
+    // A handful of entries, a linear scan over the mapped index is enough
+    for (uint16_t i = 0; i < _asset_pack_data.count; i++) {
+        const PackEntry_t& entry = _asset_pack_data.entries[i];
+        if (strncmp(entry.name, name.c_str(), _name_size) != 0) {
+            continue;
+        }
+        asset.data   = _asset_pack_data.base + entry.offset;
+        asset.size   = entry.size;
+        asset.format = static_cast<AssetFormat_t>(entry.format);
+        return true;
+    }
+    return false;
+}
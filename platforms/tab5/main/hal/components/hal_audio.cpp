@@ -6,23 +6,38 @@
 #include "hal/hal_esp32.h"
 #include <mooncake_log.h>
 #include <vector>
+#include <deque>
 #include <memory>
 #include <string.h>
 #include <bsp/m5stack_tab5.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <freertos/event_groups.h>
+#include <esp_timer.h>
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include <audio_player.h>
+#include "../utils/audio_mixer/audio_mixer.h"
+#include "../utils/speaker_dsp/speaker_dsp.h"
+#include "../utils/tdm_router/tdm_router.h"
+#include "../utils/event_trace/event_trace.h"
+#include "../utils/read_ahead_file/read_ahead_file.h"
+#include "../utils/deferred_log/deferred_log.h"
 
 static const char* TAG = "audio";
 
+// Codec control addresses, for the internal bus stats
+static constexpr uint8_t _es8388_addr = 0x10;
+static constexpr uint8_t _es7210_addr = 0x40;
+
 static uint8_t _current_speaker_volume = 80;
 
 void HalEsp32::setSpeakerVolume(uint8_t volume)
 {
     _current_speaker_volume = std::clamp((int)volume, 0, 100);
-    mclog::tagInfo(TAG, "set speaker volume: {}%", _current_speaker_volume);
+    DeferredLog::debug(TAG, "set speaker volume: {}%", _current_speaker_volume);
+    HalEsp32::settingsStore().set("volume", _current_speaker_volume);
 }
 
 uint8_t HalEsp32::getSpeakerVolume()
@@ -36,77 +51,249 @@ void HalEsp32::audioRecord(std::vector<int16_t>& data, uint16_t durationMs, floa
 
     // ESP_LOGI(TAG, "start record");
     bsp_codec_config_t* codec_handle = bsp_get_codec_handle();
-    codec_handle->set_in_gain(gain);
+    HalEsp32::i2cScheduler().run(I2cBusScheduler::PRIORITY_CODEC, _es7210_addr, [&]() {
+        codec_handle->set_in_gain(gain);
+        return true;
+    });
     size_t bytes_read = 0;
     codec_handle->i2s_read((char*)data.data(), (48000 * 4 * durationMs / 1000) * sizeof(uint16_t), &bytes_read,
                            portMAX_DELAY);
     // ESP_LOGI(TAG, "record done, %d bytes", bytes_read);
 }
 
-struct AudioTaskData_t {
-    std::mutex mutex;
-    bool is_task_running  = false;
-    bool is_audio_ready   = false;
-    bool is_audio_playing = false;
-    std::vector<int16_t> audio_data;
-};
-static AudioTaskData_t _audio_task_data;
+/* -------------------------------------------------------------------------- */
+/*                                 DMA profile                                */
+/* -------------------------------------------------------------------------- */
+// Requested from the BSP before the I2S channels exist, frames are at 48kHz
+static bsp_audio_dma_config_t audio_dma_config(hal::HalBase::AudioDmaProfile_t profile)
+{
+    switch (profile) {
+        case hal::HalBase::AUDIO_DMA_LOW_LATENCY:
+            return {4, 120};
+        case hal::HalBase::AUDIO_DMA_RECORDING:
+            return {8, 480};
+        default:
+            return {6, 240};
+    }
+}
+
+// Profile the channels were created with
+static hal::HalBase::AudioDmaProfile_t _running_dma_profile = hal::HalBase::AUDIO_DMA_MUSIC;
+// TX underruns while the mixer plays, the DMA also overflows its queue all the time the output idles
+static uint32_t _tx_underruns = 0;
+
+// RX overruns while a capture runs (hal_audio_capture.cpp で実装)
+uint32_t audio_capture_rx_overruns();
 
-void _audio_play_task(void* param)
+void HalEsp32::apply_audio_dma_profile()
 {
-    size_t bytes_written = 0;
+    _running_dma_profile          = (AudioDmaProfile_t)_audio_dma_profile;
+    bsp_audio_dma_config_t config = audio_dma_config(_running_dma_profile);
+    if (bsp_audio_set_dma_config(&config) != ESP_OK) {
+        mclog::tagWarn(TAG, "i2s already up, dma profile {} applies after a restart", _audio_dma_profile);
+    }
+}
 
-    while (true) {
-        _audio_task_data.mutex.lock();
+bool HalEsp32::setAudioDmaProfile(AudioDmaProfile_t profile)
+{
+    if (profile > AUDIO_DMA_RECORDING) {
+        return false;
+    }
+    _audio_dma_profile = profile;
+    settingsStore().set<uint8_t>("audio_dma", profile);
+    mclog::tagInfo(TAG, "dma profile {} saved, running {}", (int)profile, (int)_running_dma_profile);
+    return true;
+}
 
-        if (_audio_task_data.is_audio_ready) {
-            _audio_task_data.is_audio_playing = true;
-            _audio_task_data.mutex.unlock();
+hal::HalBase::AudioDmaProfile_t HalEsp32::getAudioDmaProfile()
+{
+    return (AudioDmaProfile_t)_audio_dma_profile;
+}
 
-            bsp_codec_config_t* codec_handle = bsp_get_codec_handle();
-            codec_handle->set_volume(_current_speaker_volume);
-            codec_handle->i2s_reconfig_clk_fn(48000, 16, I2S_SLOT_MODE_STEREO);
-            codec_handle->i2s_write(_audio_task_data.audio_data.data(),
-                                    _audio_task_data.audio_data.size() * sizeof(uint16_t), &bytes_written,
-                                    portMAX_DELAY);
+hal::HalBase::AudioDmaStats_t HalEsp32::getAudioDmaStats()
+{
+    AudioDmaStats_t stats;
+    bsp_audio_dma_config_t config;
+    bsp_audio_get_dma_config(&config);
+
+    stats.supported   = true;
+    stats.profile     = _running_dma_profile;
+    stats.descNum     = config.dma_desc_num;
+    stats.frameNum    = config.dma_frame_num;
+    stats.latencyMs   = config.dma_desc_num * config.dma_frame_num * 1000.0f / AudioMixer::SampleRate;
+    stats.txUnderruns = _tx_underruns;
+    stats.rxOverruns  = audio_capture_rx_overruns();
+    return stats;
+}
 
-            _audio_task_data.mutex.lock();
-            _audio_task_data.is_audio_playing = false;
-            _audio_task_data.is_audio_ready   = false;
-            _audio_task_data.mutex.unlock();
+/* -------------------------------------------------------------------------- */
+/*                                    Mixer                                   */
+/* -------------------------------------------------------------------------- */
+static AudioMixer _mixer;
+static TaskHandle_t _mixer_task_handle = nullptr;
+static std::once_flag _mixer_task_once;
+
+// Codec output state, every codec write is an I2C transaction and a clock change also resets the I2S clock,
+// so they are only pushed when the requested state differs from what the codec already has
+class AudioOutputSession_t {
+public:
+    void apply(uint32_t sampleRate, uint32_t bits, i2s_slot_mode_t channels, uint8_t volume)
+    {
+        bsp_codec_config_t* codec_handle = bsp_get_codec_handle();
 
-            continue;
+        if (!_is_opened || sampleRate != _sample_rate || bits != _bits || channels != _channels) {
+            mclog::tagInfo(TAG, "output session: {}Hz {}bit {}ch", sampleRate, bits, (int)channels);
+            codec_handle->i2s_reconfig_clk_fn(sampleRate, bits, channels);
+            _is_opened   = true;
+            _sample_rate = sampleRate;
+            _bits        = bits;
+            _channels    = channels;
+            // Reopening the codec resets its output stage, volume must follow
+            _is_volume_valid = false;
+        }
+
+        if (!_is_volume_valid || volume != _volume) {
+            HalEsp32::i2cScheduler().run(I2cBusScheduler::PRIORITY_CODEC, _es8388_addr, [&]() {
+                codec_handle->set_volume(volume);
+                return true;
+            });
+            _is_volume_valid = true;
+            _volume          = volume;
         }
+    }
+
+private:
+    bool _is_opened           = false;
+    bool _is_volume_valid     = false;
+    uint32_t _sample_rate     = 0;
+    uint32_t _bits            = 0;
+    i2s_slot_mode_t _channels = I2S_SLOT_MODE_STEREO;
+    uint8_t _volume           = 0;
+};
+static AudioOutputSession_t _output_session;
+
+// EQ, limiter and soft clip for the speaker, bypassed on headphones
+static SpeakerDsp _speaker_dsp;
+// Share of a block period the chain may take, blocks over it in a row shed EQ bands
+static constexpr uint32_t _speaker_dsp_budget_us = AudioMixer::BlockFrames * 1000000 / AudioMixer::SampleRate / 8;
+static constexpr int _speaker_dsp_overrun_limit  = 8;
 
-        _audio_task_data.mutex.unlock();
-        vTaskDelay(10 / portTICK_PERIOD_MS);
+static void speaker_dsp_process(int16_t* block)
+{
+    static int overruns = 0;
+
+    _speaker_dsp.setBypass(GetHAL()->headPhoneDetect());
+    _speaker_dsp.setOutputVolume(_current_speaker_volume);
+    if (_speaker_dsp.isBypassed()) {
+        return;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+    _speaker_dsp.process(block, AudioMixer::BlockFrames);
+    uint32_t cost_us = esp_timer_get_time() - start_us;
+
+    // Preempted blocks run long once in a while, only a steady overrun sheds a band
+    overruns = cost_us > _speaker_dsp_budget_us ? overruns + 1 : 0;
+    if (overruns >= _speaker_dsp_overrun_limit && _speaker_dsp.dropBand()) {
+        mclog::tagWarn(TAG, "speaker dsp over {}us budget ({}us), {} eq bands left", _speaker_dsp_budget_us, cost_us,
+                       _speaker_dsp.activeBands());
+        overruns = 0;
     }
 }
 
-void HalEsp32::audioPlay(std::vector<int16_t>& data, bool async)
+static void _audio_mixer_task(void* param)
 {
-    if (async) {
-        std::lock_guard<std::mutex> lock(_audio_task_data.mutex);
+    std::vector<int16_t> block(AudioMixer::BlockFrames * 2);
+    bsp_codec_config_t* codec_handle = bsp_get_codec_handle();
+    size_t bytes_written             = 0;
+    bool is_playing                  = false;
+    uint32_t underrun_base           = 0;
+    bsp_audio_dma_stats_t dma_stats;
 
-        if (_audio_task_data.is_audio_playing) {
-            mclog::tagWarn(TAG, "audio is playing");
-            return;
+    if (!_speaker_dsp.init(SpeakerDsp::speakerConfig())) {
+        mclog::tagError(TAG, "speaker dsp init failed");
+    }
+
+    while (true) {
+        if (!_mixer.mix(block.data())) {
+            // Nothing to play, the DMA auto clear keeps the output silent until the next voice. The look ahead tail
+            // is dropped with the state, it is below a block of the sound that just ended
+            _speaker_dsp.reset();
+            is_playing = false;
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
         }
 
-        if (!_audio_task_data.is_task_running) {
-            _audio_task_data.is_task_running = true;
-            xTaskCreate(_audio_play_task, "audio", 4096, nullptr, 5, nullptr);
+        TRACE_BEGIN("speaker dsp");
+        speaker_dsp_process(block.data());
+        TRACE_END("speaker dsp");
+
+        // The mixer always outputs the same format, so after the first block this only follows volume changes
+        _output_session.apply(AudioMixer::SampleRate, 16, I2S_SLOT_MODE_STEREO, _current_speaker_volume);
+
+        // Blocks on the DMA queue, which paces the loop to one block per buffer period
+        TRACE_BEGIN("i2s write");
+        codec_handle->i2s_write(block.data(), block.size() * sizeof(int16_t), &bytes_written, portMAX_DELAY);
+        TRACE_END("i2s write");
+
+        // From the first block of a sound on, each overflow is a buffer that went out before the next block
+        bsp_audio_get_dma_stats(&dma_stats);
+        if (is_playing) {
+            _tx_underruns += dma_stats.tx_underruns - underrun_base;
         }
+        underrun_base = dma_stats.tx_underruns;
+        is_playing    = true;
+    }
+}
+
+static void kick_audio_mixer()
+{
+    std::call_once(_mixer_task_once,
+                   []() { xTaskCreate(_audio_mixer_task, "mixer", 4096, nullptr, 8, &_mixer_task_handle); });
+    xTaskNotifyGive(_mixer_task_handle);
+}
 
-        _audio_task_data.audio_data     = data;
-        _audio_task_data.is_audio_ready = true;
+static void wait_audio_voice(uint32_t voiceId)
+{
+    while (_mixer.isPlaying(voiceId)) {
+        vTaskDelay(pdMS_TO_TICKS(AudioMixer::BlockTimeMs));
+    }
+}
+
+void HalEsp32::audioPlay(std::vector<int16_t>& data, bool async, uint8_t volume)
+{
+    if (async) {
+        // The mixer keeps its own copy alive until the voice ends
+        auto samples = std::make_shared<std::vector<int16_t>>(data);
+        _mixer.play(samples->data(), samples->size(), volume, samples);
+        kick_audio_mixer();
     } else {
-        bsp_codec_config_t* codec_handle = bsp_get_codec_handle();
-        codec_handle->set_volume(_current_speaker_volume);
-        size_t bytes_written = 0;
-        codec_handle->i2s_reconfig_clk_fn(48000, 16, I2S_SLOT_MODE_STEREO);
-        codec_handle->i2s_write(data.data(), data.size() * sizeof(uint16_t), &bytes_written, portMAX_DELAY);
+        uint32_t voice_id = _mixer.play(data.data(), data.size(), volume);
+        kick_audio_mixer();
+        wait_audio_voice(voice_id);
+    }
+}
+
+void HalEsp32::audioPlayBuffer(const int16_t* data, size_t size, uint8_t volume)
+{
+    _mixer.play(data, size, volume);
+    kick_audio_mixer();
+}
+
+void HalEsp32::audioPlayNotes(const AudioNote_t* notes, size_t count)
+{
+    // One synth voice per note, the mixer sums them, so chords need no buffer
+    for (size_t i = 0; i < count; i++) {
+        SynthVoice::Config_t config;
+        config.frequency  = notes[i].frequency;
+        config.delayMs    = notes[i].delayMs;
+        config.durationMs = notes[i].durationMs;
+        config.attackMs   = notes[i].attackMs;
+        config.releaseMs  = notes[i].releaseMs;
+        config.level      = notes[i].level;
+        _mixer.playNote(config);
     }
+    kick_audio_mixer();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -121,9 +308,9 @@ struct RecTestData_t {
 };
 static RecTestData_t _rec_test_data;
 
-static void _rec_test_task(void* param)
+static void _rec_test_job()
 {
-    mclog::tagInfo(TAG, "start record test");
+    DeferredLog::info(TAG, "start record test");
 
     const size_t read_buffer_size  = 48000 * 4 * 3;
     const size_t audio_buffer_size = 48000 * 2 * 3;
@@ -145,12 +332,15 @@ static void _rec_test_task(void* param)
     size_t total_read_bytes   = 0;
 
     bsp_codec_config_t* codec_handle = bsp_get_codec_handle();
-    codec_handle->set_in_gain(240);
+    HalEsp32::i2cScheduler().run(I2cBusScheduler::PRIORITY_CODEC, _es7210_addr, [&]() {
+        codec_handle->set_in_gain(240);
+        return true;
+    });
 
     int16_t* read_buf = _rec_test_data.read_buffer;
     memset(read_buf, 0, total_samples * sizeof(int16_t));  // 清零
 
-    mclog::tagInfo(TAG, "start record");
+    DeferredLog::info(TAG, "start record");
 
     while (total_read_samples < total_samples) {
         size_t bytes_to_read = chunk_bytes;
@@ -159,7 +349,9 @@ static void _rec_test_task(void* param)
         }
 
         size_t bytes_read = 0;
+        TRACE_BEGIN("i2s read");
         codec_handle->i2s_read((char*)(read_buf + total_read_samples), bytes_to_read, &bytes_read, portMAX_DELAY);
+        TRACE_END("i2s read");
 
         total_read_samples += bytes_read / sizeof(int16_t);
         total_read_bytes += bytes_read;
@@ -167,41 +359,31 @@ static void _rec_test_task(void* param)
         vTaskDelay(pdMS_TO_TICKS(5));
     }
 
-    mclog::tagInfo(TAG, "record done");
+    DeferredLog::info(TAG, "record done");
 
     // Create audio data  [MIC-L, AEC, MIC-R, MIC-HP]
-    int num_frames = audio_buffer_size / 2;  // 每帧一组 stereo 输出
-    for (int i = 0; i < num_frames; ++i) {
-        int16_t* in  = _rec_test_data.read_buffer;
-        int16_t* out = _rec_test_data.audio_buffer;
-
-        if (_rec_test_data.isDualMic) {
-            out[i * 2 + 0] = in[i * 4 + 0];  // MIC-L
-            out[i * 2 + 1] = in[i * 4 + 2];  // MIC-R
-        } else {
-            out[i * 2 + 0] = in[i * 4 + 3];  // MIC-HP
-            out[i * 2 + 1] = in[i * 4 + 3];  // MIC-HP (duplicate for stereo)
-        }
-    }
+    static const uint8_t dual_mic_slots[]  = {0, 2};  // MIC-L, MIC-R
+    static const uint8_t headphone_slots[] = {3, 3};  // MIC-HP (duplicate for stereo)
+    TdmRouter router;
+    router.setRoute(4, _rec_test_data.isDualMic ? dual_mic_slots : headphone_slots, 2);
+    router.process(_rec_test_data.read_buffer, audio_buffer_size / 2, _rec_test_data.audio_buffer);
 
     _rec_test_data.mutex.lock();
     _rec_test_data.state = hal::HalBase::MIC_TEST_PLAYING;
     _rec_test_data.mutex.unlock();
+    // Let the UI show the new state without waiting for its idle poll
+    GetHAL()->wakeAppLoop();
 
-    size_t bytes_written = 0;
-    codec_handle->set_volume(_current_speaker_volume);
-    codec_handle->i2s_reconfig_clk_fn(48000, 16, I2S_SLOT_MODE_STEREO);
-
-    mclog::tagInfo(TAG, "start playback");
-    codec_handle->i2s_write(_rec_test_data.audio_buffer, (48000 * 2 * 3) * sizeof(uint16_t), &bytes_written,
-                            portMAX_DELAY);
-    mclog::tagInfo(TAG, "playback done");
+    DeferredLog::info(TAG, "start playback");
+    uint32_t voice_id = _mixer.play(_rec_test_data.audio_buffer, audio_buffer_size);
+    kick_audio_mixer();
+    wait_audio_voice(voice_id);
+    DeferredLog::info(TAG, "playback done");
 
     _rec_test_data.mutex.lock();
     _rec_test_data.state = hal::HalBase::MIC_TEST_IDLE;
     _rec_test_data.mutex.unlock();
-
-    vTaskDelete(NULL);
+    GetHAL()->wakeAppLoop();
 }
 
 static void try_create_rec_test_task(bool isDualMic)
@@ -215,7 +397,9 @@ static void try_create_rec_test_task(bool isDualMic)
         if (_rec_test_data.state == hal::HalBase::MIC_TEST_IDLE) {
             _rec_test_data.isDualMic = isDualMic;
             _rec_test_data.state     = hal::HalBase::MIC_TEST_RECORDING;
-            xTaskCreate(_rec_test_task, "rec", 4096, nullptr, 5, nullptr);
+            if (!GetHAL()->submitJob(_rec_test_job)) {
+                _rec_test_data.state = hal::HalBase::MIC_TEST_IDLE;
+            }
             _rec_test_data.mutex.unlock();
             return;
         }
@@ -250,123 +434,260 @@ hal::HalBase::MicTestState_t HalEsp32::getHeadphoneMicRecordTestState()
 /* -------------------------------------------------------------------------- */
 /*                               Music play test                              */
 /* -------------------------------------------------------------------------- */
-extern const uint8_t canon_in_d_mp3_start[] asm("_binary_canon_in_d_mp3_start");
-extern const uint8_t canon_in_d_mp3_end[] asm("_binary_canon_in_d_mp3_end");
-extern const uint8_t startup_sfx_mp3_start[] asm("_binary_startup_sfx_mp3_start");
-extern const uint8_t startup_sfx_mp3_end[] asm("_binary_startup_sfx_mp3_end");
-extern const uint8_t shutdown_sfx_mp3_start[] asm("_binary_shutdown_sfx_mp3_start");
-extern const uint8_t shutdown_sfx_mp3_end[] asm("_binary_shutdown_sfx_mp3_end");
-
 enum Mp3PlayTarget_t {
     MP3_PLAY_TARGET_CANON_IN_D,
     MP3_PLAY_TARGET_STARTUP_SFX,
     MP3_PLAY_TARGET_SHUTDOWN_SFX,
+    MP3_PLAY_TARGET_SD_FILE,
+};
+
+struct MusicTrack_t {
+    Mp3PlayTarget_t target = MP3_PLAY_TARGET_CANON_IN_D;
+    // Relative to the SD card root, for MP3_PLAY_TARGET_SD_FILE
+    std::string path;
+};
+
+// Notification bits of the music task
+enum MusicNotify_t : uint32_t {
+    MUSIC_NOTIFY_TRACK_DONE = 1 << 0,
+    MUSIC_NOTIFY_SKIP       = 1 << 1,
+    MUSIC_NOTIFY_KILL       = 1 << 2,
+    MUSIC_NOTIFY_QUEUED     = 1 << 3,
+};
+
+// Event group bit, set while the music service has nothing to play
+static constexpr EventBits_t MUSIC_EVENT_IDLE = 1 << 0;
+
+// The mixer has one stream, the music queue and the video player take turns on it
+enum StreamOwner_t {
+    STREAM_OWNER_NONE = 0,
+    STREAM_OWNER_MUSIC,
+    STREAM_OWNER_VIDEO,
 };
 
 struct MusicTestData_t {
     std::mutex mutex;
-    bool killSignal                      = false;
+    StreamOwner_t streamOwner            = STREAM_OWNER_NONE;
     hal::HalBase::MusicPlayState_t state = hal::HalBase::MUSIC_PLAY_IDLE;
-    Mp3PlayTarget_t target               = MP3_PLAY_TARGET_CANON_IN_D;
+    std::deque<MusicTrack_t> queue;
+    MusicTrack_t current;
+    TaskHandle_t taskHandle       = nullptr;
+    EventGroupHandle_t eventGroup = nullptr;
 };
 static MusicTestData_t _music_test_data;
 
+// Lock _music_test_data.mutex before calling
+static void notify_music_task(uint32_t bits)
+{
+    if (_music_test_data.taskHandle != nullptr) {
+        xTaskNotify(_music_test_data.taskHandle, bits, eSetBits);
+    }
+}
+
+static uint8_t _music_stream_channels = 2;
+
+// The player decodes into the mixer stream, so UI sounds keep mixing over the music
 static esp_err_t audio_mute_function(AUDIO_PLAYER_MUTE_SETTING setting)
 {
-    bsp_codec_config_t* codec_handle = bsp_get_codec_handle();
-    codec_handle->set_mute(setting == AUDIO_PLAYER_MUTE ? true : false);
+    _mixer.setStreamMuted(setting == AUDIO_PLAYER_MUTE ? true : false);
     return ESP_OK;
 }
 
-static void audio_player_callback(audio_player_cb_ctx_t* ctx)
+static esp_err_t audio_clk_set_function(uint32_t rate, uint32_t bits_cfg, i2s_slot_mode_t ch)
 {
-    mclog::tagInfo(TAG, "audio event: {}", (int)ctx->audio_event);
+    if (bits_cfg != 16) {
+        mclog::tagError(TAG, "unsupported music bits: {}", bits_cfg);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    _music_stream_channels = ch == I2S_SLOT_MODE_MONO ? 1 : 2;
+    _mixer.streamBegin(rate, _music_stream_channels);
+    kick_audio_mixer();
+    return ESP_OK;
+}
 
+static esp_err_t audio_write_function(void* audio_buffer, size_t len, size_t* bytes_written, uint32_t timeout_ms)
+{
+    const int16_t* data = (const int16_t*)audio_buffer;
+    size_t frames       = len / sizeof(int16_t) / _music_stream_channels;
+    size_t written      = 0;
+    while (written < frames) {
+        size_t count = _mixer.streamWrite(data + written * _music_stream_channels, frames - written);
+        written += count;
+        if (count == 0 && !_mixer.isStreamOpened()) {
+            // Closed under the decoder, the rest of the buffer is dropped
+            break;
+        }
+        if (written < frames) {
+            // Ring is full, wait for the mixer to drain a block
+            vTaskDelay(pdMS_TO_TICKS(AudioMixer::BlockTimeMs));
+        }
+    }
+    *bytes_written = len;
+    return ESP_OK;
+}
+
+static void audio_player_callback(audio_player_cb_ctx_t* ctx)
+{
+    // Runs on the player task for every event, it only queues the line
     audio_player_state_t state = audio_player_get_state();
-    mclog::tagInfo(TAG, "audio state: {}", (int)state);
+    DeferredLog::debug(TAG, "audio event: {}, state: {}", (int)ctx->audio_event, (int)state);
 
     if (state == AUDIO_PLAYER_STATE_IDLE) {
-        GetHAL()->stopPlayMusicTest();
+        std::lock_guard<std::mutex> lock(_music_test_data.mutex);
+        notify_music_task(MUSIC_NOTIFY_TRACK_DONE);
     }
 }
 
-static void _music_play_task(void* param)
+// Built in tracks are read straight from the memory mapped asset partition
+static FILE* open_asset_track(const char* name)
 {
-    bsp_codec_config_t* codec_handle = bsp_get_codec_handle();
-    codec_handle->set_volume(_current_speaker_volume);
-    codec_handle->i2s_reconfig_clk_fn(48000, 16, I2S_SLOT_MODE_STEREO);
+    hal::HalBase::Asset_t asset;
+    if (!GetHAL()->getAsset(name, asset) || asset.format != hal::HalBase::ASSET_FORMAT_MP3) {
+        mclog::tagError(TAG, "no mp3 asset {}", name);
+        return nullptr;
+    }
+    return fmemopen((void*)asset.data, asset.size, "rb");
+}
+
+static FILE* open_music_track(const MusicTrack_t& track)
+{
+    switch (track.target) {
+        case MP3_PLAY_TARGET_CANON_IN_D:
+            return open_asset_track("canon_in_d.mp3");
+        case MP3_PLAY_TARGET_STARTUP_SFX:
+            return open_asset_track("startup_sfx.mp3");
+        case MP3_PLAY_TARGET_SHUTDOWN_SFX:
+            return open_asset_track("shutdown_sfx.mp3");
+        case MP3_PLAY_TARGET_SD_FILE:
+            // The decoder reads small pieces, the read ahead task turns them into large sequential SD reads
+            return read_ahead_fopen(("/sd/" + track.path).c_str());
+    }
+    return nullptr;
+}
+
+// Block until the current track ends
+static void wait_music_track()
+{
+    uint32_t bits = 0;
+    while (!(bits & MUSIC_NOTIFY_TRACK_DONE)) {
+        uint32_t notified = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &notified, portMAX_DELAY);
+
+        // Stop once, then keep waiting for the player to report idle
+        if ((notified & (MUSIC_NOTIFY_SKIP | MUSIC_NOTIFY_KILL)) && !(bits & (MUSIC_NOTIFY_SKIP | MUSIC_NOTIFY_KILL))) {
+            audio_player_stop();
+        }
+        bits |= notified;
+    }
+}
+
+// Take the next queued track, returns false when the queue is empty
+static bool pop_music_track(MusicTrack_t& track)
+{
+    std::lock_guard<std::mutex> lock(_music_test_data.mutex);
+
+    if (_music_test_data.queue.empty()) {
+        // Let the mixer go quiet, closed before the stream is handed back so it never closes a video's stream
+        _mixer.streamEnd();
+        _music_test_data.streamOwner = STREAM_OWNER_NONE;
+        _music_test_data.state       = hal::HalBase::MUSIC_PLAY_IDLE;
+        _music_test_data.current = MusicTrack_t();
+        xEventGroupSetBits(_music_test_data.eventGroup, MUSIC_EVENT_IDLE);
+        return false;
+    }
 
+    track = _music_test_data.queue.front();
+    _music_test_data.queue.pop_front();
+    _music_test_data.current = track;
+    // Drop the leftovers of the previous track, a stop from now on applies to this one
+    ulTaskNotifyValueClear(NULL, MUSIC_NOTIFY_TRACK_DONE | MUSIC_NOTIFY_SKIP | MUSIC_NOTIFY_KILL);
+    return true;
+}
+
+// Resident service, the decoder stays created so a queued sound starts without setup costs
+static void _music_play_task(void* param)
+{
     audio_player_config_t config = {
         .mute_fn    = audio_mute_function,
-        .clk_set_fn = codec_handle->i2s_reconfig_clk_fn,
-        .write_fn   = codec_handle->i2s_write,
+        .clk_set_fn = audio_clk_set_function,
+        .write_fn   = audio_write_function,
         .priority   = 8,
         .coreID     = 1,
     };
     ESP_ERROR_CHECK(audio_player_new(config));
     audio_player_callback_register(audio_player_callback, NULL);
 
-    size_t mp3_size = 0;
-    FILE* fp        = nullptr;
-    switch (_music_test_data.target) {
-        case MP3_PLAY_TARGET_CANON_IN_D:
-            mp3_size = (canon_in_d_mp3_end - canon_in_d_mp3_start) - 1;
-            fp       = fmemopen((void*)canon_in_d_mp3_start, mp3_size, "rb");
-            break;
-        case MP3_PLAY_TARGET_STARTUP_SFX:
-            mp3_size = (startup_sfx_mp3_end - startup_sfx_mp3_start) - 1;
-            fp       = fmemopen((void*)startup_sfx_mp3_start, mp3_size, "rb");
-            break;
-        case MP3_PLAY_TARGET_SHUTDOWN_SFX:
-            mp3_size = (shutdown_sfx_mp3_end - shutdown_sfx_mp3_start) - 1;
-            fp       = fmemopen((void*)shutdown_sfx_mp3_start, mp3_size, "rb");
-            break;
-    }
+    while (1) {
+        MusicTrack_t track;
+        if (!pop_music_track(track)) {
+            // The next clock set reopens the stream
+            GetHAL()->releasePerfLevel("music");
+            GetHAL()->wakeAppLoop();
 
-    esp_err_t ret = audio_player_play(fp);
-    if (ret != ESP_OK) {
-        mclog::tagError(TAG, "audio play failed");
-        vTaskDelete(NULL);
-        return;
-    }
+            xTaskNotifyWait(0, MUSIC_NOTIFY_QUEUED, nullptr, portMAX_DELAY);
+            continue;
+        }
+        // The decoder has to keep the I2S DMA fed
+        GetHAL()->claimPerfLevel("music", hal::HalBase::PERF_LEVEL_MAX);
+        GetHAL()->wakeAppLoop();
 
-    while (1) {
-        vTaskDelay(pdMS_TO_TICKS(100));
+        FILE* fp = open_music_track(track);
+        if (fp == nullptr) {
+            mclog::tagError(TAG, "open track failed: {}", track.path);
+            continue;
+        }
 
-        std::lock_guard<std::mutex> lock(_music_test_data.mutex);
-        if (_music_test_data.killSignal) {
-            break;
+        esp_err_t ret = audio_player_play(fp);
+        if (ret != ESP_OK) {
+            mclog::tagError(TAG, "audio play failed");
+            continue;
         }
+
+        wait_music_track();
     }
+}
 
-    ret = audio_player_delete();
-    if (ret != ESP_OK) {
-        mclog::tagError(TAG, "audio player delete failed");
+// Lock _music_test_data.mutex before calling, returns false while a video plays its sound
+static bool queue_music_track(const MusicTrack_t& track)
+{
+    if (_music_test_data.streamOwner == STREAM_OWNER_VIDEO) {
+        mclog::tagWarn(TAG, "mixer stream is busy with a video, track dropped");
+        return false;
+    }
+    if (_music_test_data.taskHandle == nullptr) {
+        _music_test_data.eventGroup = xEventGroupCreate();
+        xTaskCreate(_music_play_task, "music", 4096, nullptr, 5, &_music_test_data.taskHandle);
     }
 
-    _music_test_data.mutex.lock();
-    _music_test_data.state      = hal::HalBase::MUSIC_PLAY_IDLE;
-    _music_test_data.killSignal = false;
-    _music_test_data.mutex.unlock();
+    _music_test_data.queue.push_back(track);
+    _music_test_data.state = hal::HalBase::MUSIC_PLAY_PLAYING;
+    xEventGroupClearBits(_music_test_data.eventGroup, MUSIC_EVENT_IDLE);
+    notify_music_task(MUSIC_NOTIFY_QUEUED);
+    _music_test_data.streamOwner = STREAM_OWNER_MUSIC;
+    return true;
+}
 
-    vTaskDelete(NULL);
+// Lock _music_test_data.mutex before calling
+static void stop_music_queue()
+{
+    _music_test_data.queue.clear();
+    notify_music_task(MUSIC_NOTIFY_KILL);
 }
 
 void try_create_music_play_task(Mp3PlayTarget_t target)
 {
-    if (_music_test_data.state == hal::HalBase::MUSIC_PLAY_IDLE) {
-        _music_test_data.state      = hal::HalBase::MUSIC_PLAY_PLAYING;
-        _music_test_data.target     = target;
-        _music_test_data.killSignal = false;
-        xTaskCreate(_music_play_task, "music", 3000, nullptr, 5, nullptr);
-    } else {
-        mclog::tagWarn(TAG, "music play is running");
-    }
+    MusicTrack_t track;
+    track.target = target;
+    queue_music_track(track);
 }
 
 void HalEsp32::startPlayMusicTest()
 {
     std::lock_guard<std::mutex> lock(_music_test_data.mutex);
+    if (_music_test_data.state != hal::HalBase::MUSIC_PLAY_IDLE) {
+        mclog::tagWarn(TAG, "music play is running");
+        return;
+    }
     try_create_music_play_task(MP3_PLAY_TARGET_CANON_IN_D);
 }
 
@@ -379,7 +700,119 @@ hal::HalBase::MusicPlayState_t HalEsp32::getMusicPlayTestState()
 void HalEsp32::stopPlayMusicTest()
 {
     std::lock_guard<std::mutex> lock(_music_test_data.mutex);
-    _music_test_data.killSignal = true;
+    stop_music_queue();
+}
+
+void HalEsp32::wait_music_idle()
+{
+    EventGroupHandle_t event_group = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_music_test_data.mutex);
+        event_group = _music_test_data.eventGroup;
+    }
+    if (event_group == nullptr) {
+        return;
+    }
+    xEventGroupWaitBits(event_group, MUSIC_EVENT_IDLE, pdFALSE, pdTRUE, portMAX_DELAY);
+}
+
+bool HalEsp32::queueMusic(const std::string& path)
+{
+    if (!mount_sd_card()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_music_test_data.mutex);
+    MusicTrack_t track;
+    track.target = MP3_PLAY_TARGET_SD_FILE;
+    track.path   = path;
+    return queue_music_track(track);
+}
+
+void HalEsp32::skipMusic()
+{
+    std::lock_guard<std::mutex> lock(_music_test_data.mutex);
+    notify_music_task(MUSIC_NOTIFY_SKIP);
+}
+
+void HalEsp32::clearMusicQueue()
+{
+    std::lock_guard<std::mutex> lock(_music_test_data.mutex);
+    _music_test_data.queue.clear();
+}
+
+std::vector<std::string> HalEsp32::getMusicQueue()
+{
+    std::lock_guard<std::mutex> lock(_music_test_data.mutex);
+    std::vector<std::string> paths;
+    for (const auto& track : _music_test_data.queue) {
+        paths.push_back(track.target == MP3_PLAY_TARGET_SD_FILE ? track.path : "");
+    }
+    return paths;
+}
+
+std::string HalEsp32::getPlayingMusic()
+{
+    std::lock_guard<std::mutex> lock(_music_test_data.mutex);
+    if (_music_test_data.state == hal::HalBase::MUSIC_PLAY_IDLE ||
+        _music_test_data.current.target != MP3_PLAY_TARGET_SD_FILE) {
+        return "";
+    }
+    return _music_test_data.current.path;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                 Video audio                                */
+/* -------------------------------------------------------------------------- */
+// Read by the player's tasks
+static std::atomic<uint32_t> _video_audio_rate{0};
+
+// The video player's sound track, the playback clock is the stream position as heard
+bool HalEsp32::videoAudioBegin(uint32_t sampleRate, uint8_t channels, uint8_t volume)
+{
+    {
+        // The stream has a single owner, a video started over the music plays muted
+        std::lock_guard<std::mutex> lock(_music_test_data.mutex);
+        if (_music_test_data.streamOwner != STREAM_OWNER_NONE) {
+            mclog::tagWarn(TAG, "mixer stream is busy, video without sound");
+            return false;
+        }
+        _music_test_data.streamOwner = STREAM_OWNER_VIDEO;
+        _video_audio_rate            = sampleRate;
+        _mixer.streamBegin(sampleRate, channels, volume);
+    }
+    kick_audio_mixer();
+    return true;
+}
+
+size_t HalEsp32::videoAudioWrite(const int16_t* data, size_t frames)
+{
+    return _mixer.streamWrite(data, frames);
+}
+
+void HalEsp32::videoAudioEnd()
+{
+    std::lock_guard<std::mutex> lock(_music_test_data.mutex);
+    if (_music_test_data.streamOwner != STREAM_OWNER_VIDEO) {
+        return;
+    }
+    _mixer.streamEnd();
+    _music_test_data.streamOwner = STREAM_OWNER_NONE;
+    _video_audio_rate            = 0;
+}
+
+int64_t HalEsp32::videoAudioClockUs()
+{
+    uint32_t rate = _video_audio_rate;
+    if (rate == 0) {
+        return 0;
+    }
+    // The mixer position runs ahead of the speaker by the block waiting on the DMA queue and the DMA buffers
+    bsp_audio_dma_config_t config;
+    bsp_audio_get_dma_config(&config);
+    int64_t mixed_us       = _mixer.getStreamPosition() * 1000000 / rate;
+    int64_t latency_frames = config.dma_desc_num * config.dma_frame_num + AudioMixer::BlockFrames;
+    return mixed_us - latency_frames * 1000000 / AudioMixer::SampleRate;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -393,6 +826,8 @@ void HalEsp32::playStartupSfx()
 
 void HalEsp32::playShutdownSfx()
 {
+    // Cut whatever is playing, so waiting for idle only takes the clip length
     std::lock_guard<std::mutex> lock(_music_test_data.mutex);
+    stop_music_queue();
     try_create_music_play_task(MP3_PLAY_TARGET_SHUTDOWN_SFX);
 }
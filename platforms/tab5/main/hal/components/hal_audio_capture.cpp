@@ -0,0 +1,328 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <hal/spsc_ring.h>
+#include "../utils/tdm_router/tdm_router.h"
+#include "../utils/voice_processor/voice_processor.h"
+#include "../utils/voice_activity_detector/voice_activity_detector.h"
+#include "../utils/task_controller/task_controller.h"
+#include <mooncake_log.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <bsp/m5stack_tab5.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static const std::string _tag = "audio-capture";
+
+static constexpr int _tdm_channels = 4;
+// 48kHz down to the 16kHz voice rate
+static constexpr uint8_t _voice_decimation = 3;
+// Mic ADC control address, for the internal bus stats
+static constexpr uint8_t _es7210_addr = 0x40;
+// Listening reads 20ms blocks, one detector frame each, so the task wakes 50 times a second
+static constexpr uint16_t _listen_block_ms = 20;
+
+struct AudioCaptureData_t {
+    std::mutex mutex;
+    TaskController_t task;
+    hal::HalBase::AudioCaptureConfig_t config;
+    hal::HalBase::AudioCaptureCallback_t onBlock;
+    uint8_t channels = 0;
+    TdmRouter router;
+    // Voice capture runs the routed block through the processor, which drops the reference channel
+    bool isVoice = false;
+    VoiceProcessor voiceProcessor;
+    SpscRing<int16_t> ring;
+    uint32_t droppedFrames = 0;
+    // Since boot, DMA buffers lost while a capture was reading
+    uint32_t rxOverruns = 0;
+};
+static AudioCaptureData_t _capture_data;
+
+struct AudioListenData_t {
+    hal::HalBase::AudioListenCallback_t onVoice;
+    VoiceActivityDetector detector;
+    uint32_t rate = 0;
+    // Mono history of the first routed mic, handed over on detection
+    std::vector<int16_t> preRoll;
+    size_t preRollPos  = 0;
+    bool isPreRollFull = false;
+    bool isListening   = false;
+};
+static AudioListenData_t _listen_data;
+
+static void _audio_capture_loop(TaskController_t& task)
+{
+    const auto& config       = _capture_data.config;
+    const size_t in_samples  = config.blockFrames * _tdm_channels;
+    const size_t out_samples = config.blockFrames / config.decimation * _capture_data.router.outChannels();
+
+    std::vector<int16_t> read_buffer(in_samples);
+    std::vector<int16_t> routed_buffer(out_samples);
+    std::vector<int16_t> voice_buffer(_capture_data.isVoice ? out_samples : 0);
+
+    bsp_codec_config_t* codec_handle = bsp_get_codec_handle();
+    HalEsp32::i2cScheduler().run(I2cBusScheduler::PRIORITY_CODEC, _es7210_addr, [&]() {
+        codec_handle->set_in_gain(config.gain);
+        return true;
+    });
+
+    mclog::tagInfo(_tag, "start, {} ch, 1/{} rate, {} frames per block", _capture_data.channels, config.decimation,
+                   config.blockFrames);
+
+    // The RX DMA runs from boot on, overflows only count from the first read of this capture
+    bsp_audio_dma_stats_t dma_stats;
+    uint32_t overrun_base = 0;
+    bool is_first_read    = true;
+
+    while (!task.isStopRequested()) {
+        size_t bytes_read = 0;
+        codec_handle->i2s_read((char*)read_buffer.data(), in_samples * sizeof(int16_t), &bytes_read, portMAX_DELAY);
+
+        bsp_audio_get_dma_stats(&dma_stats);
+        if (!is_first_read) {
+            _capture_data.rxOverruns += dma_stats.rx_overruns - overrun_base;
+        }
+        overrun_base  = dma_stats.rx_overruns;
+        is_first_read = false;
+
+        size_t in_frames = bytes_read / sizeof(int16_t) / _tdm_channels;
+        size_t frames    = _capture_data.router.process(read_buffer.data(), in_frames, routed_buffer.data());
+        if (frames == 0) {
+            continue;
+        }
+
+        int16_t* out_buffer = routed_buffer.data();
+        if (_capture_data.isVoice) {
+            _capture_data.voiceProcessor.process(routed_buffer.data(), frames, voice_buffer.data());
+            out_buffer = voice_buffer.data();
+        }
+
+        if (_capture_data.onBlock) {
+            _capture_data.onBlock(out_buffer, frames, _capture_data.channels);
+        }
+
+        // Whole frames only, so the consumer never reads half a frame
+        size_t space_frames = _capture_data.ring.space() / _capture_data.channels;
+        size_t write_frames = std::min(frames, space_frames);
+        _capture_data.ring.write(out_buffer, write_frames * _capture_data.channels);
+        _capture_data.droppedFrames += frames - write_frames;
+    }
+
+    mclog::tagInfo(_tag, "stop, {} frames dropped", _capture_data.droppedFrames);
+}
+
+static bool start_capture(const hal::HalBase::AudioCaptureConfig_t& config,
+                          hal::HalBase::AudioCaptureCallback_t onBlock,
+                          const hal::HalBase::AudioVoiceConfig_t* voiceConfig,
+                          hal::HalBase::PerfLevel_t perfLevel = hal::HalBase::PERF_LEVEL_MAX)
+{
+    std::lock_guard<std::mutex> lock(_capture_data.mutex);
+
+    if (_capture_data.task.isRunning()) {
+        mclog::tagWarn(_tag, "already capturing");
+        return false;
+    }
+
+    uint8_t slots[_tdm_channels];
+    uint8_t channels = 0;
+    for (int slot = 0; slot < _tdm_channels; slot++) {
+        if (config.channelMask & (1 << slot)) {
+            slots[channels++] = slot;
+        }
+    }
+    if (channels == 0 || config.blockFrames < config.decimation ||
+        !_capture_data.router.setRoute(_tdm_channels, slots, channels, 1.0f, config.decimation)) {
+        mclog::tagError(_tag, "invalid config");
+        return false;
+    }
+
+    _capture_data.isVoice = voiceConfig != nullptr;
+    if (_capture_data.isVoice) {
+        VoiceProcessor::Config_t voice_config;
+        voice_config.sampleRate    = 48000 / config.decimation;
+        voice_config.echoCancel    = voiceConfig->echoCancel;
+        voice_config.noiseSuppress = voiceConfig->noiseSuppress;
+
+        // The reference position is the count of routed slots before the AEC slot
+        uint8_t ref_channel = 0;
+        while (ref_channel < channels && slots[ref_channel] != 1) {
+            ref_channel++;
+        }
+        if (!_capture_data.voiceProcessor.init(voice_config, channels, ref_channel)) {
+            mclog::tagError(_tag, "invalid voice config");
+            return false;
+        }
+        channels = _capture_data.voiceProcessor.outChannels();
+    }
+
+    _capture_data.config        = config;
+    _capture_data.onBlock       = onBlock;
+    _capture_data.channels      = channels;
+    _capture_data.droppedFrames = 0;
+    _capture_data.ring.init((size_t)config.ringFrames * channels);
+    if (!_capture_data.task.start("capture", 4096, 6, -1, _audio_capture_loop)) {
+        mclog::tagError(_tag, "create task failed");
+        return false;
+    }
+    // Block processing has a deadline every block, the clock is not scaled down under it unless the caller says so
+    GetHAL()->claimPerfLevel("audio_capture", perfLevel);
+    return true;
+}
+
+bool HalEsp32::startAudioCapture(const AudioCaptureConfig_t& config, AudioCaptureCallback_t onBlock)
+{
+    return start_capture(config, onBlock, nullptr);
+}
+
+bool HalEsp32::startVoiceCapture(const AudioVoiceConfig_t& config, AudioCaptureCallback_t onBlock)
+{
+    // The selected mics plus the AEC slot, which carries the playback reference
+    AudioCaptureConfig_t capture_config;
+    capture_config.channelMask = config.micMask | AUDIO_CAPTURE_AEC;
+    capture_config.decimation  = _voice_decimation;
+    capture_config.gain        = config.gain;
+    capture_config.ringFrames  = 16000;
+    return start_capture(capture_config, onBlock, &config);
+}
+
+// Runs on the capture task, keeps the pre-roll and feeds the detector with the first routed channel
+static void listen_on_block(const int16_t* data, size_t frames, uint8_t channels)
+{
+    auto& listen = _listen_data;
+    int16_t mono[160];
+
+    while (frames > 0) {
+        size_t chunk = std::min(frames, sizeof(mono) / sizeof(mono[0]));
+        for (size_t i = 0; i < chunk; i++) {
+            mono[i]                           = data[i * channels];
+            listen.preRoll[listen.preRollPos] = mono[i];
+            if (++listen.preRollPos == listen.preRoll.size()) {
+                listen.preRollPos    = 0;
+                listen.isPreRollFull = true;
+            }
+        }
+        data += chunk * channels;
+        frames -= chunk;
+
+        if (!listen.detector.process(mono, chunk)) {
+            continue;
+        }
+
+        // Oldest sample first. The callback goes to the job pool, it may stop listening or start the voice
+        // capture, neither can run on the capture task
+        auto audio = std::make_shared<std::vector<int16_t>>();
+        if (listen.isPreRollFull) {
+            audio->assign(listen.preRoll.begin() + listen.preRollPos, listen.preRoll.end());
+        }
+        audio->insert(audio->end(), listen.preRoll.begin(), listen.preRoll.begin() + listen.preRollPos);
+        mclog::tagInfo(_tag, "voice, floor {}, {} frames of pre-roll", listen.detector.noiseFloor(), audio->size());
+
+        auto on_voice = listen.onVoice;
+        uint32_t rate = listen.rate;
+        GetHAL()->submitJob([on_voice, audio, rate]() { on_voice(audio->data(), audio->size(), rate); });
+        GetHAL()->wakeAppLoop();
+    }
+}
+
+bool HalEsp32::startAudioListening(const AudioListenConfig_t& config, AudioListenCallback_t onVoice)
+{
+    if (!onVoice || config.micMask == 0 || (config.micMask & AUDIO_CAPTURE_AEC) || config.decimation == 0) {
+        mclog::tagError(_tag, "invalid listen config");
+        return false;
+    }
+    if (isAudioCapturing()) {
+        mclog::tagWarn(_tag, "already capturing");
+        return false;
+    }
+
+    auto& listen = _listen_data;
+    listen.rate  = 48000 / config.decimation;
+
+    VoiceActivityDetector::Config_t detector_config;
+    detector_config.sampleRate  = listen.rate;
+    detector_config.frameMs     = _listen_block_ms;
+    detector_config.thresholdDb = config.thresholdDb;
+    detector_config.minSpeechMs = config.minSpeechMs;
+    if (!listen.detector.init(detector_config)) {
+        mclog::tagError(_tag, "invalid listen config");
+        return false;
+    }
+    listen.preRoll.assign(std::max<size_t>(1, (size_t)listen.rate * config.preRollMs / 1000), 0);
+    listen.preRollPos    = 0;
+    listen.isPreRollFull = false;
+    listen.onVoice       = onVoice;
+
+    // Nothing pulls the ring while listening, it only needs to hold a block
+    AudioCaptureConfig_t capture_config;
+    capture_config.channelMask = config.micMask;
+    capture_config.decimation  = config.decimation;
+    capture_config.blockFrames = 48 * _listen_block_ms;
+    capture_config.gain        = config.gain;
+    capture_config.ringFrames  = capture_config.blockFrames / config.decimation;
+
+    // The I2S DMA stops in light sleep, so the chip stays awake, the clock still drops with the light load
+    listen.isListening = true;
+    if (!start_capture(capture_config, listen_on_block, nullptr, PERF_LEVEL_AWAKE)) {
+        listen.isListening = false;
+        return false;
+    }
+    mclog::tagInfo(_tag, "listening at {}Hz", listen.rate);
+    return true;
+}
+
+void HalEsp32::stopAudioListening()
+{
+    stopAudioCapture();
+}
+
+bool HalEsp32::isAudioListening()
+{
+    return _listen_data.isListening && isAudioCapturing();
+}
+
+void HalEsp32::stopAudioCapture()
+{
+    std::lock_guard<std::mutex> lock(_capture_data.mutex);
+
+    if (!_capture_data.task.isRunning()) {
+        return;
+    }
+
+    // The task finishes its current block read, at most one block period
+    _capture_data.task.stop();
+    _capture_data.onBlock    = nullptr;
+    _listen_data.isListening = false;
+    _listen_data.onVoice     = nullptr;
+    GetHAL()->releasePerfLevel("audio_capture");
+}
+
+bool HalEsp32::isAudioCapturing()
+{
+    return _capture_data.task.isRunning();
+}
+
+// For the recorder's status (hal_audio_recorder.cpp)
+uint32_t audio_capture_dropped_frames()
+{
+    return _capture_data.droppedFrames;
+}
+
+// For the DMA stats (hal_audio.cpp)
+uint32_t audio_capture_rx_overruns()
+{
+    return _capture_data.rxOverruns;
+}
+
+size_t HalEsp32::readAudioCapture(int16_t* data, size_t maxFrames)
+{
+    if (_capture_data.channels == 0) {
+        return 0;
+    }
+    return _capture_data.ring.read(data, maxFrames * _capture_data.channels) / _capture_data.channels;
+}
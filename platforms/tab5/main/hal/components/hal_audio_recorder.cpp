@@ -0,0 +1,306 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include "../utils/aligned_file_writer/aligned_file_writer.h"
+#include "../utils/ima_adpcm/ima_adpcm.h"
+#include "../utils/task_controller/task_controller.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <mutex>
+#include <vector>
+#include <string.h>
+#include <sys/stat.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static const std::string _tag = "audio-recorder";
+
+// RIFF, fmt and the data chunk header, ADPCM adds the fmt extension and the fact chunk. Rewritten on stop
+static constexpr size_t _wav_pcm_header_size   = 12 + 8 + 16 + 8;
+static constexpr size_t _wav_adpcm_header_size = 12 + 8 + 20 + 8 + 4 + 8;
+// ADPCM block per channel, 1017 frames, about 21ms at 48kHz
+static constexpr uint16_t _adpcm_block_per_channel = 512;
+static constexpr size_t _pcm_block_frames          = 1024;
+// Capture ring, covers the longest card stalls seen on a cluster allocation
+static constexpr uint32_t _ring_frames = 16384;
+static constexpr size_t _write_block   = 64 * 1024;
+static constexpr uint32_t _poll_ms     = 10;
+
+struct AudioRecorderData_t {
+    std::mutex mutex;
+    TaskController_t task;
+    hal::HalBase::AudioRecorderConfig_t config;
+    FILE* file       = nullptr;
+    uint8_t channels = 0;
+    uint32_t rate    = 0;
+    ImaAdpcmEncoder encoder;
+    // Status, read by getAudioRecorderStatus()
+    std::mutex statusMutex;
+    uint64_t frames    = 0;
+    uint64_t dataBytes = 0;
+    std::string error;
+};
+static AudioRecorderData_t _recorder_data;
+
+// Frames the capture found its ring full for (hal_audio_capture.cpp で実装)
+uint32_t audio_capture_dropped_frames();
+
+static void put_u16(uint8_t*& p, uint16_t value)
+{
+    *p++ = value & 0xFF;
+    *p++ = value >> 8;
+}
+
+static void put_u32(uint8_t*& p, uint32_t value)
+{
+    put_u16(p, value & 0xFFFF);
+    put_u16(p, value >> 16);
+}
+
+static void put_fourcc(uint8_t*& p, const char* fourcc)
+{
+    memcpy(p, fourcc, 4);
+    p += 4;
+}
+
+static bool is_adpcm_recording()
+{
+    return _recorder_data.config.codec == hal::HalBase::AUDIO_RECORDER_IMA_ADPCM;
+}
+
+static size_t wav_header_size()
+{
+    return is_adpcm_recording() ? _wav_adpcm_header_size : _wav_pcm_header_size;
+}
+
+static void write_wav_header(FILE* file, uint64_t frames, uint64_t dataBytes)
+{
+    const auto& data     = _recorder_data;
+    bool is_adpcm        = is_adpcm_recording();
+    size_t header_size   = wav_header_size();
+    uint16_t block_align = is_adpcm ? data.encoder.blockAlign() : data.channels * 2;
+    uint32_t byte_rate   = is_adpcm ? (uint64_t)data.rate * block_align / data.encoder.samplesPerBlock()
+                                    : data.rate * block_align;
+    // Past 4GB the sizes saturate, players still read to the end of the file
+    uint32_t data_size = std::min<uint64_t>(dataBytes, UINT32_MAX - header_size);
+
+    uint8_t header[_wav_adpcm_header_size];
+    uint8_t* p = header;
+    put_fourcc(p, "RIFF");
+    put_u32(p, header_size - 8 + data_size);
+    put_fourcc(p, "WAVE");
+
+    put_fourcc(p, "fmt ");
+    put_u32(p, is_adpcm ? 20 : 16);
+    put_u16(p, is_adpcm ? 0x11 : 0x01);
+    put_u16(p, data.channels);
+    put_u32(p, data.rate);
+    put_u32(p, byte_rate);
+    put_u16(p, block_align);
+    put_u16(p, is_adpcm ? 4 : 16);
+    if (is_adpcm) {
+        put_u16(p, 2);
+        put_u16(p, data.encoder.samplesPerBlock());
+
+        // Compressed formats need the frame count, the last block is padded
+        put_fourcc(p, "fact");
+        put_u32(p, 4);
+        put_u32(p, std::min<uint64_t>(frames, UINT32_MAX));
+    }
+
+    put_fourcc(p, "data");
+    put_u32(p, data_size);
+
+    fseek(file, 0, SEEK_SET);
+    fwrite(header, 1, header_size, file);
+}
+
+static void set_recorder_error(const std::string& error)
+{
+    std::lock_guard<std::mutex> lock(_recorder_data.statusMutex);
+    _recorder_data.error = error;
+}
+
+// Write one encoded block, false once the card takes no more
+static bool write_block(const uint8_t* block, size_t size, size_t frames)
+{
+    auto& data = _recorder_data;
+    if (fwrite(block, 1, size, data.file) != size) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(data.statusMutex);
+    data.frames += frames;
+    data.dataBytes += size;
+    return true;
+}
+
+static void _audio_recorder_loop(TaskController_t& task)
+{
+    auto& data          = _recorder_data;
+    bool is_adpcm       = is_adpcm_recording();
+    size_t block_frames = is_adpcm ? data.encoder.samplesPerBlock() : _pcm_block_frames;
+
+    // The only buffers, a block of frames and its encoding, next to the capture ring and the file block
+    std::vector<int16_t> pcm(block_frames * data.channels);
+    std::vector<uint8_t> encoded(is_adpcm ? data.encoder.blockAlign() : 0);
+    size_t filled  = 0;
+    bool is_failed = false;
+    mclog::tagInfo(_tag, "start {}, {} ch, {}Hz, {}", data.config.path, data.channels, data.rate,
+                   is_adpcm ? "ima adpcm" : "pcm");
+
+    // Stop drains what is left in the ring, then the partial block is padded with silence
+    bool is_draining = false;
+    while (!is_failed) {
+        if (!is_draining && task.isStopRequested()) {
+            GetHAL()->stopAudioCapture();
+            is_draining = true;
+        }
+        size_t read = GetHAL()->readAudioCapture(pcm.data() + filled * data.channels, block_frames - filled);
+        filled += read;
+        if (filled < block_frames) {
+            if (is_draining && read == 0) {
+                break;
+            }
+            if (read == 0) {
+                task.sleep(pdMS_TO_TICKS(_poll_ms));
+            }
+            continue;
+        }
+
+        if (is_adpcm) {
+            data.encoder.encodeBlock(pcm.data(), encoded.data());
+            is_failed = !write_block(encoded.data(), encoded.size(), block_frames);
+        } else {
+            is_failed = !write_block((const uint8_t*)pcm.data(), pcm.size() * sizeof(int16_t), block_frames);
+        }
+        filled = 0;
+    }
+
+    if (!is_failed && filled > 0) {
+        // The fact chunk tells players where the real frames end
+        memset(pcm.data() + filled * data.channels, 0, (block_frames - filled) * data.channels * sizeof(int16_t));
+        if (is_adpcm) {
+            data.encoder.encodeBlock(pcm.data(), encoded.data());
+            is_failed = !write_block(encoded.data(), encoded.size(), filled);
+        } else {
+            is_failed = !write_block((const uint8_t*)pcm.data(), filled * data.channels * sizeof(int16_t), filled);
+        }
+    }
+    if (is_failed) {
+        mclog::tagError(_tag, "write failed, card full or removed");
+        set_recorder_error("write failed");
+        GetHAL()->stopAudioCapture();
+    }
+
+    uint64_t frames     = 0;
+    uint64_t data_bytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(data.statusMutex);
+        frames     = data.frames;
+        data_bytes = data.dataBytes;
+    }
+    write_wav_header(data.file, frames, data_bytes);
+    fclose(data.file);
+    data.file = nullptr;
+    GetHAL()->releasePerfLevel("audio_recorder");
+    mclog::tagInfo(_tag, "stop, {} frames, {} bytes", frames, data_bytes);
+}
+
+bool HalEsp32::startAudioRecorder(const AudioRecorderConfig_t& config)
+{
+    auto& data = _recorder_data;
+    std::lock_guard<std::mutex> lock(data.mutex);
+
+    if (data.task.isRunning()) {
+        mclog::tagWarn(_tag, "already recording");
+        return false;
+    }
+    if (!isSdCardMounted()) {
+        mclog::tagError(_tag, "no sd card");
+        return false;
+    }
+
+    uint8_t channels = 0;
+    for (int slot = 0; slot < 4; slot++) {
+        channels += (config.channelMask >> slot) & 1;
+    }
+    if (channels == 0 || config.decimation == 0 ||
+        (config.codec == AUDIO_RECORDER_IMA_ADPCM &&
+         !data.encoder.init(channels, _adpcm_block_per_channel * channels))) {
+        mclog::tagError(_tag, "invalid config");
+        return false;
+    }
+
+    std::string path = "/sd/" + config.path;
+    size_t slash     = path.find_last_of('/');
+    if (slash > 3) {
+        mkdir(path.substr(0, slash).c_str(), 0777);
+    }
+    data.file = aligned_file_fopen(path.c_str(), _write_block);
+    if (data.file == nullptr) {
+        mclog::tagError(_tag, "open {} failed", path);
+        return false;
+    }
+
+    data.config   = config;
+    data.channels = channels;
+    data.rate     = 48000 / config.decimation;
+    {
+        std::lock_guard<std::mutex> status_lock(data.statusMutex);
+        data.frames    = 0;
+        data.dataBytes = 0;
+        data.error.clear();
+    }
+    // Placeholder, rewritten with the sizes on stop
+    write_wav_header(data.file, 0, 0);
+
+    AudioCaptureConfig_t capture_config;
+    capture_config.channelMask = config.channelMask;
+    capture_config.decimation  = config.decimation;
+    capture_config.gain        = config.gain;
+    capture_config.ringFrames  = _ring_frames;
+    if (!startAudioCapture(capture_config)) {
+        mclog::tagError(_tag, "capture start failed");
+        fclose(data.file);
+        data.file = nullptr;
+        return false;
+    }
+
+    // The encoder is cheap, the card writes cost the time, below the capture task
+    claimPerfLevel("audio_recorder", PERF_LEVEL_MAX);
+    if (!data.task.start("recorder", 4096, 5, -1, _audio_recorder_loop)) {
+        mclog::tagError(_tag, "create task failed");
+        stopAudioCapture();
+        fclose(data.file);
+        data.file = nullptr;
+        releasePerfLevel("audio_recorder");
+        return false;
+    }
+    return true;
+}
+
+void HalEsp32::stopAudioRecorder()
+{
+    std::lock_guard<std::mutex> lock(_recorder_data.mutex);
+    // Joins once the ring is written out and the header is final
+    _recorder_data.task.stop();
+}
+
+hal::HalBase::AudioRecorderStatus_t HalEsp32::getAudioRecorderStatus()
+{
+    auto& data = _recorder_data;
+    AudioRecorderStatus_t status;
+    status.recording = data.task.isRunning();
+    if (status.recording) {
+        status.droppedFrames = audio_capture_dropped_frames();
+    }
+
+    std::lock_guard<std::mutex> lock(data.statusMutex);
+    status.durationMs = data.rate ? data.frames * 1000 / data.rate : 0;
+    status.bytes      = data.dataBytes + (data.rate ? wav_header_size() : 0);
+    status.error      = data.error;
+    return status;
+}
@@ -0,0 +1,195 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include "../utils/task_controller/task_controller.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <mutex>
+#include <string>
+
+static const std::string _tag = "auto-rotate";
+
+static constexpr uint32_t _poll_interval_ms = 100;
+// An accel reading older than this is read again, the sensor service may be polling slower or not at all
+static constexpr uint32_t _stale_ms = 500;
+// Smoothing of the accel only gravity, the fused one is already steady
+static constexpr float _accel_smoothing = 0.3f;
+
+struct AutoRotateData_t {
+    std::mutex mutex;
+    TaskController_t task;
+    hal::HalBase::AutoRotateConfig_t config;
+};
+static AutoRotateData_t _auto_rotate_data;
+
+// Up direction in the IMUData_t axes, +1 on the axis pointing up. From the fusion while the IMU stream runs, from the
+// accelerometer otherwise
+static bool read_gravity(float gravity[3])
+{
+    hal::HalBase::ImuOrientation_t orientation;
+    if (GetHAL()->getImuOrientation(orientation)) {
+        gravity[0] = orientation.gravityX;
+        gravity[1] = orientation.gravityY;
+        gravity[2] = orientation.gravityZ;
+        return true;
+    }
+
+    IMUData_t imu;
+    uint32_t time_ms = 0;
+    if (!GetHAL()->imuSnapshot.read(imu, nullptr, &time_ms) || GetHAL()->millis() - time_ms > _stale_ms) {
+        GetHAL()->updateImuData();
+        if (!GetHAL()->imuSnapshot.read(imu)) {
+            return false;
+        }
+    }
+    gravity[0] += (imu.accelX - gravity[0]) * _accel_smoothing;
+    gravity[1] += (imu.accelY - gravity[1]) * _accel_smoothing;
+    gravity[2] += (imu.accelZ - gravity[2]) * _accel_smoothing;
+    return true;
+}
+
+// The IMU X and Y line up with the screen at LV_DISPLAY_ROTATION_90, x to the right and y down, the same mapping the
+// launcher's IMU panel draws its dot with. Each score is the cosine between up and the top edge of the screen at that
+// rotation
+static lv_display_rotation_t pick_rotation(const float gravity[3], lv_display_rotation_t current,
+                                           const hal::HalBase::AutoRotateConfig_t& config, float enterCos)
+{
+    float magnitude = std::sqrt(gravity[0] * gravity[0] + gravity[1] * gravity[1] + gravity[2] * gravity[2]);
+    float plane     = std::hypot(gravity[0], gravity[1]);
+    // Free fall or lying flat, nothing to tell the orientation from
+    if (magnitude < 0.5f || plane / magnitude < config.minPlaneGravity) {
+        return current;
+    }
+
+    float up_x      = gravity[0] / plane;
+    float up_y      = gravity[1] / plane;
+    float scores[4] = {up_x, -up_y, -up_x, up_y};
+
+    int best = -1;
+    for (int rotation = LV_DISPLAY_ROTATION_0; rotation <= LV_DISPLAY_ROTATION_270; rotation++) {
+        if (!(config.rotationMask & (1 << rotation))) {
+            continue;
+        }
+        if (best < 0 || scores[rotation] > scores[best]) {
+            best = rotation;
+        }
+    }
+    if (best < 0 || best == current || scores[best] < enterCos) {
+        return current;
+    }
+    return (lv_display_rotation_t)best;
+}
+
+static void auto_rotate_loop(TaskController_t& task, std::function<void(lv_display_rotation_t)> apply)
+{
+    const auto config     = _auto_rotate_data.config;
+    const float enter_cos = std::cos((45.0f - std::clamp(config.hysteresisDeg, 0.0f, 40.0f)) * (float)M_PI / 180.0f);
+
+    float gravity[3]                = {0.0f, 0.0f, 0.0f};
+    lv_display_rotation_t candidate = GetHAL()->getDisplayRotation();
+    uint32_t candidate_since        = 0;
+
+    while (task.sleep(pdMS_TO_TICKS(_poll_interval_ms))) {
+        if (!read_gravity(gravity)) {
+            continue;
+        }
+
+        // The camera preview is placed for the rotation it started with
+        lv_display_rotation_t current = GetHAL()->getDisplayRotation();
+        if (GetHAL()->isCameraCapturing()) {
+            candidate = current;
+            continue;
+        }
+
+        lv_display_rotation_t target = pick_rotation(gravity, current, config, enter_cos);
+        if (target == current) {
+            candidate = current;
+            continue;
+        }
+        if (target != candidate) {
+            candidate       = target;
+            candidate_since = GetHAL()->millis();
+            continue;
+        }
+        if (GetHAL()->millis() - candidate_since >= config.settleMs) {
+            mclog::tagInfo(_tag, "rotation {} -> {}", (int)current, (int)target);
+            apply(target);
+        }
+    }
+}
+
+void HalEsp32::apply_display_rotation(lv_display_rotation_t rotation)
+{
+    _display_rotation = rotation;
+    settingsStore().set<uint8_t>("rotation", rotation);
+
+    // LVGL invalidates the screen and lays the widget trees out again for the new resolution, touch follows the
+    // rotation of the display
+    postUiCommand([this, rotation]() {
+        if (lvDisp != nullptr && lv_display_get_rotation(lvDisp) != rotation) {
+            lv_display_set_rotation(lvDisp, rotation);
+        }
+    });
+}
+
+void HalEsp32::setDisplayRotation(lv_display_rotation_t rotation)
+{
+    stopAutoRotate();
+    apply_display_rotation(rotation);
+}
+
+lv_display_rotation_t HalEsp32::getDisplayRotation()
+{
+    return (lv_display_rotation_t)_display_rotation;
+}
+
+bool HalEsp32::startAutoRotate(const AutoRotateConfig_t& config)
+{
+    auto& data = _auto_rotate_data;
+    std::lock_guard<std::mutex> lock(data.mutex);
+    if (data.task.isRunning()) {
+        data.task.stop();
+    }
+    if ((config.rotationMask & 0x0F) == 0) {
+        mclog::tagError(_tag, "no rotation in mask {:#x}", config.rotationMask);
+        return false;
+    }
+
+    data.config = config;
+    if (!data.task.start("auto_rotate", 4096, 2, -1, [this](TaskController_t& task) {
+            auto_rotate_loop(task, [this](lv_display_rotation_t rotation) { apply_display_rotation(rotation); });
+        })) {
+        mclog::tagError(_tag, "create task failed");
+        return false;
+    }
+
+    _auto_rotate      = true;
+    _auto_rotate_mask = config.rotationMask & 0x0F;
+    settingsStore().set("auto_rotate", true);
+    settingsStore().set<uint8_t>("rotate_mask", _auto_rotate_mask);
+    mclog::tagInfo(_tag, "started, mask {:#x}, hysteresis {} deg, settle {} ms", _auto_rotate_mask,
+                   config.hysteresisDeg, config.settleMs);
+    return true;
+}
+
+void HalEsp32::stopAutoRotate()
+{
+    auto& data = _auto_rotate_data;
+    std::lock_guard<std::mutex> lock(data.mutex);
+    if (data.task.isRunning()) {
+        data.task.stop();
+        mclog::tagInfo(_tag, "stopped");
+    }
+    _auto_rotate = false;
+    settingsStore().set("auto_rotate", false);
+}
+
+bool HalEsp32::isAutoRotating()
+{
+    return _auto_rotate_data.task.isRunning();
+}
@@ -0,0 +1,171 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <bsp/m5stack_tab5.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+static const std::string _tag = "backlight";
+
+// Input is checked this often, a touch on a dimmed screen brings it back within a poll
+static constexpr uint32_t _poll_interval_ms = 100;
+// Ambient changes smaller than this are sensor noise, the level is left alone
+static constexpr float _ambient_step = 0.02f;
+
+struct BacklightData_t {
+    // Taken around every write to the PWM, the policy task and the setters race otherwise
+    std::mutex mutex;
+    std::mutex serviceMutex;
+    std::atomic<bool> isRunning{false};
+    // Given on stop, so the task does not sleep out its poll
+    SemaphoreHandle_t wakeSem = nullptr;
+    SemaphoreHandle_t exitSem = nullptr;
+    hal::HalBase::BacklightPolicyConfig_t config;
+    bool isDimmed      = false;
+    float ambientScale = 1.0f;
+    // Last level sent to the PWM, -1 before the first
+    int level = -1;
+};
+static BacklightData_t _backlight_data;
+
+void HalEsp32::backlight_apply(uint16_t fadeMs)
+{
+    std::lock_guard<std::mutex> lock(_backlight_data.mutex);
+
+    int target = _current_lcd_brightness;
+    if (_backlight_data.isRunning && target > 0) {
+        const auto& config = _backlight_data.config;
+        if (config.ambientAdaptive) {
+            target = std::max<int>(std::lround(target * _backlight_data.ambientScale), 1);
+        }
+        if (_backlight_data.isDimmed) {
+            target = std::min<int>(target, config.dimBrightness);
+        }
+    }
+    if (target == _backlight_data.level) {
+        return;
+    }
+    _backlight_data.level = target;
+    bsp_display_brightness_fade(target, fadeMs);
+}
+
+void HalEsp32::fadeDisplayBrightness(uint8_t brightness, uint16_t durationMs)
+{
+    _current_lcd_brightness = std::clamp((int)brightness, 0, 100);
+    backlight_apply(durationMs);
+    // Light sleep is held off while the screen shows anything, so a fade to 0 also runs to its end awake
+    if (_current_lcd_brightness > 0) {
+        claimPerfLevel("display", PERF_LEVEL_AWAKE);
+    } else {
+        releasePerfLevel("display");
+    }
+}
+
+void HalEsp32::backlight_policy_task(void* param)
+{
+    static_cast<HalEsp32*>(param)->backlight_policy_loop();
+
+    xSemaphoreGive(_backlight_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+void HalEsp32::backlight_policy_loop()
+{
+    const auto config = _backlight_data.config;
+
+    while (_backlight_data.isRunning) {
+        // A plain read of the last input time, every input device updates it from the LVGL task
+        uint32_t inactive_ms = lvDisp ? lv_display_get_inactive_time(lvDisp) : 0;
+        bool is_idle         = config.dimTimeoutSec && inactive_ms >= config.dimTimeoutSec * 1000;
+        if (is_idle != _backlight_data.isDimmed) {
+            {
+                std::lock_guard<std::mutex> lock(_backlight_data.mutex);
+                _backlight_data.isDimmed = is_idle;
+            }
+            backlight_apply(is_idle ? config.dimFadeMs : config.wakeFadeMs);
+        }
+
+        xSemaphoreTake(_backlight_data.wakeSem, pdMS_TO_TICKS(_poll_interval_ms));
+    }
+}
+
+bool HalEsp32::startBacklightPolicy(const BacklightPolicyConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_backlight_data.serviceMutex);
+
+    if (_backlight_data.isRunning) {
+        return true;
+    }
+    if (config.ambientAdaptive && config.fullScaleLux <= 0) {
+        mclog::tagError(_tag, "invalid full scale lux");
+        return false;
+    }
+
+    _backlight_data.config = config;
+    if (_backlight_data.exitSem == nullptr) {
+        _backlight_data.exitSem = xSemaphoreCreateBinary();
+        _backlight_data.wakeSem = xSemaphoreCreateBinary();
+    }
+    xSemaphoreTake(_backlight_data.wakeSem, 0);
+
+    _backlight_data.isRunning = true;
+    if (xTaskCreate(backlight_policy_task, "backlight", 3072, this, 2, nullptr) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _backlight_data.isRunning = false;
+        return false;
+    }
+
+    mclog::tagInfo(_tag, "start, dim to {}% after {} s, ambient {}", config.dimBrightness, config.dimTimeoutSec,
+                   config.ambientAdaptive ? "on" : "off");
+    return true;
+}
+
+void HalEsp32::stopBacklightPolicy()
+{
+    std::lock_guard<std::mutex> lock(_backlight_data.serviceMutex);
+
+    if (!_backlight_data.isRunning) {
+        return;
+    }
+
+    _backlight_data.isRunning = false;
+    xSemaphoreGive(_backlight_data.wakeSem);
+    xSemaphoreTake(_backlight_data.exitSem, portMAX_DELAY);
+    {
+        std::lock_guard<std::mutex> data_lock(_backlight_data.mutex);
+        _backlight_data.isDimmed     = false;
+        _backlight_data.ambientScale = 1.0f;
+    }
+    // Back to the brightness as set
+    backlight_apply(_backlight_data.config.wakeFadeMs);
+    mclog::tagInfo(_tag, "stop");
+}
+
+void HalEsp32::setBacklightAmbient(float lux)
+{
+    if (!_backlight_data.isRunning || !_backlight_data.config.ambientAdaptive) {
+        return;
+    }
+
+    // Perceived brightness follows the log of the light level, the scale reaches 1 at fullScaleLux
+    const auto& config = _backlight_data.config;
+    float scale        = std::log10(1.0f + std::max(lux, 0.0f)) / std::log10(1.0f + config.fullScaleLux);
+    scale              = std::clamp(scale, config.minAmbientScale, 1.0f);
+    {
+        std::lock_guard<std::mutex> lock(_backlight_data.mutex);
+        if (std::fabs(scale - _backlight_data.ambientScale) < _ambient_step) {
+            return;
+        }
+        _backlight_data.ambientScale = scale;
+    }
+    backlight_apply(config.dimFadeMs);
+}
@@ -0,0 +1,488 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <hal/spsc_ring.h>
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+#include <esp_random.h>
+#include <esp_rom_crc.h>
+#include <esp_timer.h>
+
+static const std::string _tag = "binary-log";
+
+// Mirrors a written segment to the USB export while it runs, in hal_usb_export.cpp
+void usb_export_log_segment(const uint8_t* segment, size_t size);
+
+/*
+ * File layout, little endian, structs are packed:
+ * header  : "T5LG", u16 version, u16 segment header size, u32 session id (random per boot)
+ * segment : "LSEG", u32 sequence (runs on across the files of a session), u32 unix time, u32 ms since boot,
+ *           u32 payload size, u32 payload CRC-32, u32 header CRC-32 (over the fields before it), then the payload
+ * payload : whole records, u32 ms since boot, u8 source, u8 level (in the numbering of the source), u16 length, text
+ * Each segment goes out with one write() and fsync(), so after a power loss a file ends with at most one segment that
+ * fails its CRC. Readers stop at the first bad segment of a file. CRC-32 is the zlib one
+ */
+static constexpr uint16_t _format_version = 1;
+static const char* _log_dir               = "/sd/logs";
+// Longer lines are cut, the record is built on the caller's stack
+static constexpr size_t _max_text = 192;
+// The writer polls the ring, producers never wake it
+static constexpr uint32_t _poll_interval_ms = 200;
+// After a failed write, the card gets a rest before the next file is opened
+static constexpr uint32_t _retry_interval_ms = 5000;
+// Cache line of the ESP32-P4, the SDMMC DMA reads from it without a bounce copy
+static constexpr size_t _buffer_align = 64;
+
+enum RecordSource_t : uint8_t {
+    SOURCE_MCLOG   = 0,
+    SOURCE_ESP_LOG = 1,
+};
+
+struct __attribute__((packed)) FileHeader_t {
+    char magic[4]              = {'T', '5', 'L', 'G'};
+    uint16_t version           = _format_version;
+    uint16_t segmentHeaderSize = 0;
+    uint32_t sessionId         = 0;
+};
+
+struct __attribute__((packed)) SegmentHeader_t {
+    char magic[4]        = {'L', 'S', 'E', 'G'};
+    uint32_t sequence    = 0;
+    uint32_t unixTime    = 0;
+    uint32_t timeMs      = 0;
+    uint32_t payloadSize = 0;
+    uint32_t payloadCrc  = 0;
+    uint32_t headerCrc   = 0;
+};
+
+struct __attribute__((packed)) RecordHeader_t {
+    uint32_t timeMs = 0;
+    uint8_t source  = 0;
+    uint8_t level   = 0;
+    uint16_t length = 0;
+};
+
+struct BinaryLogData_t {
+    std::mutex mutex;
+    TaskHandle_t task           = nullptr;
+    SemaphoreHandle_t exitSem   = nullptr;
+    std::atomic<bool> isRunning = false;
+    hal::HalBase::BinaryLogConfig_t config;
+    // Log calls come from any task, the spinlock makes them a single producer for the ring
+    portMUX_TYPE ringLock = portMUX_INITIALIZER_UNLOCKED;
+    SpscRing<uint8_t> ring;
+    std::atomic<bool> isCapturing = false;
+    uint32_t records              = 0;
+    uint32_t dropped              = 0;
+    bool isMclogHooked            = false;
+    vprintf_like_t espVprintf     = nullptr;
+    // Writer side, the segment buffer is allocated in startBinaryLog() so the task has nothing to fail on
+    uint8_t* segment       = nullptr;
+    size_t segmentCapacity = 0;
+    // Writer side stats
+    std::mutex statsMutex;
+    hal::HalBase::BinaryLogStats_t stats;
+};
+static BinaryLogData_t _log_data;
+
+/* -------------------------------------------------------------------------- */
+/*                                  Producers                                 */
+/* -------------------------------------------------------------------------- */
+static void push_record(RecordSource_t source, uint8_t level, const char* text, size_t length)
+{
+    if (!_log_data.isCapturing) {
+        return;
+    }
+    while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == '\r')) {
+        length--;
+    }
+    length = std::min(length, _max_text);
+
+    uint8_t record[sizeof(RecordHeader_t) + _max_text];
+    RecordHeader_t header;
+    header.timeMs = esp_timer_get_time() / 1000;
+    header.source = source;
+    header.level  = level;
+    header.length = length;
+    memcpy(record, &header, sizeof(header));
+    memcpy(record + sizeof(header), text, length);
+    size_t size = sizeof(header) + length;
+
+    // One write per record, the writer never sees a header without its text
+    portENTER_CRITICAL_SAFE(&_log_data.ringLock);
+    if (_log_data.isCapturing) {
+        if (_log_data.ring.space() >= size) {
+            _log_data.ring.write(record, size);
+            _log_data.records++;
+        } else {
+            _log_data.dropped++;
+        }
+    }
+    portEXIT_CRITICAL_SAFE(&_log_data.ringLock);
+}
+
+// ESP_LOGx lines start with an optional color sequence and the level letter
+static uint8_t esp_log_line_level(const char* line)
+{
+    if (*line == '\033') {
+        const char* end = strchr(line, 'm');
+        line            = end ? end + 1 : line;
+    }
+    switch (*line) {
+        case 'E':
+            return ESP_LOG_ERROR;
+        case 'W':
+            return ESP_LOG_WARN;
+        case 'I':
+            return ESP_LOG_INFO;
+        case 'D':
+            return ESP_LOG_DEBUG;
+        case 'V':
+            return ESP_LOG_VERBOSE;
+        default:
+            return ESP_LOG_NONE;
+    }
+}
+
+static int esp_log_vprintf(const char* format, va_list args)
+{
+    char line[_max_text + 1];
+    va_list copy;
+    va_copy(copy, args);
+    int length = vsnprintf(line, sizeof(line), format, copy);
+    va_end(copy);
+    if (length > 0) {
+        push_record(SOURCE_ESP_LOG, esp_log_line_level(line), line, std::min<size_t>(length, _max_text));
+    }
+    vprintf_like_t next = _log_data.espVprintf;
+    return next ? next(format, args) : vprintf(format, args);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                   Writer                                   */
+/* -------------------------------------------------------------------------- */
+struct LogFile_t {
+    int fd        = -1;
+    uint32_t size = 0;
+    std::string path;
+};
+
+struct WriterState_t {
+    uint32_t sessionId = 0;
+    uint32_t sequence  = 0;
+    // A record header taken from the ring whose text did not fit the previous segment
+    RecordHeader_t carry;
+    bool hasCarry = false;
+};
+
+static void set_stats_file(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(_log_data.statsMutex);
+    _log_data.stats.file = path;
+}
+
+static void close_log_file(LogFile_t& file)
+{
+    if (file.fd < 0) {
+        return;
+    }
+    close(file.fd);
+    file = LogFile_t();
+    set_stats_file("");
+}
+
+// Files are numbered, the next one follows the highest present and the lowest go past maxFiles
+static std::string next_log_file_path(uint32_t maxFiles)
+{
+    std::vector<uint32_t> indices;
+    DIR* dir = opendir(_log_dir);
+    if (dir != nullptr) {
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != nullptr) {
+            unsigned index = 0;
+            char ext[4]    = {0};
+            if (sscanf(entry->d_name, "%8u.%3s", &index, ext) == 2 && strcasecmp(ext, "blg") == 0) {
+                indices.push_back(index);
+            }
+        }
+        closedir(dir);
+    }
+    std::sort(indices.begin(), indices.end());
+
+    size_t keep = maxFiles > 0 ? maxFiles - 1 : 0;
+    for (size_t i = 0; i + keep < indices.size(); i++) {
+        unlink(fmt::format("{}/{:08d}.blg", _log_dir, indices[i]).c_str());
+    }
+    return fmt::format("{}/{:08d}.blg", _log_dir, indices.empty() ? 1 : indices.back() + 1);
+}
+
+static bool open_log_file(LogFile_t& file, const WriterState_t& state, const hal::HalBase::BinaryLogConfig_t& config)
+{
+    if (file.fd >= 0 && file.size < config.fileSizeKb * 1024) {
+        return true;
+    }
+    close_log_file(file);
+    if (!GetHAL()->isSdCardMounted()) {
+        return false;
+    }
+
+    mkdir(_log_dir, 0777);
+    std::string path = next_log_file_path(config.maxFiles);
+    int fd           = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd < 0) {
+        return false;
+    }
+
+    FileHeader_t header;
+    header.segmentHeaderSize = sizeof(SegmentHeader_t);
+    header.sessionId         = state.sessionId;
+    if (write(fd, &header, sizeof(header)) != sizeof(header) || fsync(fd) != 0) {
+        close(fd);
+        return false;
+    }
+
+    file.fd   = fd;
+    file.size = sizeof(header);
+    file.path = path;
+    set_stats_file(path);
+    mclog::tagInfo(_tag, "writing to {}", path);
+    return true;
+}
+
+// Moves whole records from the ring into the payload, returns the payload size
+static size_t fill_payload(WriterState_t& state, uint8_t* payload, size_t capacity)
+{
+    size_t size = 0;
+    while (true) {
+        if (!state.hasCarry) {
+            if (_log_data.ring.available() < sizeof(RecordHeader_t)) {
+                break;
+            }
+            _log_data.ring.read((uint8_t*)&state.carry, sizeof(RecordHeader_t));
+            state.hasCarry = true;
+        }
+        size_t record_size = sizeof(RecordHeader_t) + state.carry.length;
+        if (size + record_size > capacity) {
+            break;
+        }
+        memcpy(payload + size, &state.carry, sizeof(RecordHeader_t));
+        _log_data.ring.read(payload + size + sizeof(RecordHeader_t), state.carry.length);
+        size += record_size;
+        state.hasCarry = false;
+    }
+    return size;
+}
+
+static bool write_segment(LogFile_t& file, WriterState_t& state, uint8_t* segment, size_t capacity)
+{
+    uint8_t* payload = segment + sizeof(SegmentHeader_t);
+    size_t size      = fill_payload(state, payload, capacity - sizeof(SegmentHeader_t));
+    if (size == 0) {
+        return true;
+    }
+
+    SegmentHeader_t header;
+    header.sequence    = state.sequence++;
+    header.unixTime    = time(nullptr);
+    header.timeMs      = esp_timer_get_time() / 1000;
+    header.payloadSize = size;
+    header.payloadCrc  = esp_rom_crc32_le(0, payload, size);
+    header.headerCrc   = esp_rom_crc32_le(0, (const uint8_t*)&header, offsetof(SegmentHeader_t, headerCrc));
+    memcpy(segment, &header, sizeof(header));
+
+    size_t total = sizeof(header) + size;
+    if (write(file.fd, segment, total) != (ssize_t)total || fsync(file.fd) != 0) {
+        return false;
+    }
+    file.size += total;
+    usb_export_log_segment(segment, total);
+
+    std::lock_guard<std::mutex> lock(_log_data.statsMutex);
+    _log_data.stats.segments++;
+    _log_data.stats.bytesWritten += total;
+    return true;
+}
+
+void HalEsp32::binary_log_task(void* param)
+{
+    static_cast<HalEsp32*>(param)->binary_log_loop();
+
+    xSemaphoreGive(_log_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+void HalEsp32::binary_log_loop()
+{
+    const auto config       = _log_data.config;
+    uint8_t* segment        = _log_data.segment;
+    size_t capacity         = _log_data.segmentCapacity;
+    size_t payload_capacity = capacity - sizeof(SegmentHeader_t);
+
+    LogFile_t file;
+    WriterState_t state;
+    state.sessionId          = esp_random();
+    int64_t pending_since_us = 0;
+    int64_t retry_after_us   = 0;
+
+    while (true) {
+        // Take the flag first, what was logged before stopBinaryLog() still goes out
+        bool is_stopping = !_log_data.isRunning;
+        size_t pending   = _log_data.ring.available() + (state.hasCarry ? sizeof(RecordHeader_t) : 0);
+        int64_t now      = esp_timer_get_time();
+        if (pending == 0) {
+            pending_since_us = 0;
+        } else if (pending_since_us == 0) {
+            pending_since_us = now;
+        }
+
+        bool is_due = pending > 0 && (is_stopping || pending >= payload_capacity ||
+                                      now - pending_since_us >= (int64_t)config.flushIntervalMs * 1000);
+        // Full segments go out back to back, a partial one waits for the flush interval
+        while (is_due && now >= retry_after_us && open_log_file(file, state, config)) {
+            if (!write_segment(file, state, segment, capacity)) {
+                // Most likely the card was pulled, the segment is lost and the next one goes to a new file
+                mclog::tagWarn(_tag, "write to {} failed", file.path);
+                close_log_file(file);
+                retry_after_us = now + _retry_interval_ms * 1000;
+                std::lock_guard<std::mutex> lock(_log_data.statsMutex);
+                _log_data.stats.writeErrors++;
+                break;
+            }
+            pending          = _log_data.ring.available() + (state.hasCarry ? sizeof(RecordHeader_t) : 0);
+            pending_since_us = pending > 0 ? now : 0;
+            is_due           = pending > 0 && (is_stopping || pending >= payload_capacity);
+        }
+
+        if (is_stopping) {
+            break;
+        }
+        // stopBinaryLog() cuts the wait short
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(_poll_interval_ms));
+    }
+
+    close_log_file(file);
+}
+
+bool HalEsp32::startBinaryLog(const BinaryLogConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_log_data.mutex);
+
+    if (_log_data.isRunning) {
+        return true;
+    }
+
+    // Nothing pushes while capturing is off, so the ring can be set up outside the spinlock
+    _log_data.config = config;
+    _log_data.ring.init(config.ringSizeKb * 1024);
+    _log_data.records = 0;
+    _log_data.dropped = 0;
+    {
+        std::lock_guard<std::mutex> stats_lock(_log_data.statsMutex);
+        _log_data.stats = BinaryLogStats_t();
+    }
+    if (_log_data.exitSem == nullptr) {
+        _log_data.exitSem = xSemaphoreCreateBinary();
+    }
+
+    size_t capacity =
+        std::max<size_t>(config.segmentSizeKb * 1024, sizeof(SegmentHeader_t) + sizeof(RecordHeader_t) + _max_text);
+    _log_data.segment =
+        (uint8_t*)heap_caps_aligned_alloc(_buffer_align, capacity, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    if (_log_data.segment == nullptr) {
+        _log_data.segment =
+            (uint8_t*)heap_caps_aligned_alloc(_buffer_align, capacity, MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA);
+    }
+    if (_log_data.segment == nullptr) {
+        mclog::tagError(_tag, "malloc segment buffer failed");
+        return false;
+    }
+    _log_data.segmentCapacity = capacity;
+
+    _log_data.isRunning = true;
+    if (xTaskCreate(binary_log_task, "binary_log", 4096, this, 1, &_log_data.task) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _log_data.isRunning = false;
+        _log_data.task      = nullptr;
+        heap_caps_free(_log_data.segment);
+        _log_data.segment = nullptr;
+        return false;
+    }
+
+    _log_data.isCapturing = true;
+    // mooncake_log has no way to remove a single callback, it stays and checks isCapturing
+    if (!_log_data.isMclogHooked) {
+        mclog::on_log([](const mclog::LogLevel_t& level, const std::string& msg) {
+            push_record(SOURCE_MCLOG, static_cast<uint8_t>(level), msg.data(), msg.size());
+        });
+        _log_data.isMclogHooked = true;
+    }
+    if (config.captureEspLog) {
+        _log_data.espVprintf = esp_log_set_vprintf(esp_log_vprintf);
+    }
+
+    mclog::tagInfo(_tag, "start, {} KB ring, {} KB segments", config.ringSizeKb, config.segmentSizeKb);
+    return true;
+}
+
+void HalEsp32::stopBinaryLog()
+{
+    std::lock_guard<std::mutex> lock(_log_data.mutex);
+
+    if (!_log_data.isRunning) {
+        return;
+    }
+
+    // espVprintf is kept, a log call may still be inside the hook
+    if (_log_data.config.captureEspLog) {
+        esp_log_set_vprintf(_log_data.espVprintf);
+    }
+    portENTER_CRITICAL(&_log_data.ringLock);
+    _log_data.isCapturing = false;
+    portEXIT_CRITICAL(&_log_data.ringLock);
+
+    // The task writes out what is left before it exits
+    _log_data.isRunning = false;
+    xTaskNotifyGive(_log_data.task);
+    xSemaphoreTake(_log_data.exitSem, portMAX_DELAY);
+    _log_data.task = nullptr;
+    heap_caps_free(_log_data.segment);
+    _log_data.segment = nullptr;
+    mclog::tagInfo(_tag, "stop");
+}
+
+hal::HalBase::BinaryLogStats_t HalEsp32::getBinaryLogStats()
+{
+    BinaryLogStats_t stats;
+    {
+        std::lock_guard<std::mutex> lock(_log_data.statsMutex);
+        stats = _log_data.stats;
+    }
+    portENTER_CRITICAL(&_log_data.ringLock);
+    stats.records = _log_data.records;
+    stats.dropped = _log_data.dropped;
+    portEXIT_CRITICAL(&_log_data.ringLock);
+    stats.isRunning = _log_data.isRunning;
+    return stats;
+}
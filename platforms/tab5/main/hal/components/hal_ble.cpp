@@ -0,0 +1,557 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_mac.h>
+#include <nimble/nimble_port.h>
+#include <nimble/nimble_port_freertos.h>
+#include <host/ble_hs.h>
+#include <host/util/util.h>
+#include <services/gap/ble_svc_gap.h>
+#include <services/gatt/ble_svc_gatt.h>
+
+static const std::string _tag = "ble";
+
+// A notification is a header and the records after it, little endian:
+//   header  u16 sequence, u32 millis() of the first record
+//   record  u16 ms after the first, u16 bus mV, i16 mA, u16 accel mg, i16 CPU temp in 0.1 C
+// A field the sensor had no new reading for is 0x7FFF, or 0xFFFF for the unsigned ones
+static constexpr size_t _header_size = 6;
+static constexpr size_t _record_size = 10;
+// Records of one notification at most, an MTU of 247 takes 23
+static constexpr size_t _max_records = 48;
+// The record offsets are 16 bit milliseconds
+static constexpr uint32_t _max_latency_ms = 60000;
+static constexpr size_t _history_batch    = 32;
+
+// 7e0a0001-5c2d-4b7a-9e31-4d35546142xx, the service and its characteristics
+static const ble_uuid128_t _service_uuid =
+    BLE_UUID128_INIT(0x00, 0x42, 0x61, 0x54, 0x35, 0x4d, 0x31, 0x9e, 0x7a, 0x4b, 0x2d, 0x5c, 0x01, 0x00, 0x0a, 0x7e);
+// Readings, notified in batches, a read returns the last batch
+static const ble_uuid128_t _readings_uuid =
+    BLE_UUID128_INIT(0x01, 0x42, 0x61, 0x54, 0x35, 0x4d, 0x31, 0x9e, 0x7a, 0x4b, 0x2d, 0x5c, 0x01, 0x00, 0x0a, 0x7e);
+// Device state, a JSON document built on each read
+static const ble_uuid128_t _state_uuid =
+    BLE_UUID128_INIT(0x02, 0x42, 0x61, 0x54, 0x35, 0x4d, 0x31, 0x9e, 0x7a, 0x4b, 0x2d, 0x5c, 0x01, 0x00, 0x0a, 0x7e);
+
+struct BleData_t {
+    std::mutex mutex;
+    TaskHandle_t task           = nullptr;
+    SemaphoreHandle_t exitSem   = nullptr;
+    std::atomic<bool> isRunning = false;
+    hal::HalBase::BleTelemetryConfig_t config;
+    uint8_t ownAddrType = 0;
+    // Shared with the host task
+    std::mutex statsMutex;
+    hal::HalBase::BleTelemetryStats_t stats;
+    uint16_t connHandle = BLE_HS_CONN_HANDLE_NONE;
+    // Set when the MTU or the subscription changes, the task asks for new connection parameters
+    bool isParamsDirty = false;
+    std::string lastBatch;
+    uint16_t readingsHandle = 0;
+};
+static BleData_t _ble_data;
+
+static ble_gatt_chr_def _characteristics[3];
+static ble_gatt_svc_def _services[2];
+
+static void ble_advertise();
+
+static void put_u16(uint8_t* out, uint16_t value)
+{
+    out[0] = value & 0xFF;
+    out[1] = value >> 8;
+}
+
+static void put_u32(uint8_t* out, uint32_t value)
+{
+    put_u16(out, value & 0xFFFF);
+    put_u16(out + 2, value >> 16);
+}
+
+// Scaled and clamped, NAN becomes the no reading marker
+static int16_t to_i16(float value, float scale)
+{
+    if (std::isnan(value)) {
+        return INT16_MAX;
+    }
+    return (int16_t)std::clamp(std::lround(value * scale), (long)INT16_MIN, (long)INT16_MAX - 1);
+}
+
+static uint16_t to_u16(float value, float scale)
+{
+    if (std::isnan(value)) {
+        return UINT16_MAX;
+    }
+    return (uint16_t)std::clamp(std::lround(value * scale), 0L, (long)UINT16_MAX - 1);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    GATT                                    */
+/* -------------------------------------------------------------------------- */
+static std::string state_to_json()
+{
+    auto hal = GetHAL();
+    std::string json;
+    json.reserve(160);
+    json += fmt::format("{{\"uptimeMs\":{},\"perfLevel\":{},\"sdMounted\":{}", hal->millis(), (int)hal->getPerfLevel(),
+                        hal->isSdCardMounted());
+
+    hal::HalBase::ThermalStatus_t thermal;
+    if (hal->thermalSnapshot.read(thermal)) {
+        json += fmt::format(",\"cpuTemp\":{:.1f},\"thermalLevel\":{}", thermal.tempC, (int)thermal.level);
+    }
+    hal::HalBase::PMData_t pm;
+    if (hal->powerMonitorSnapshot.read(pm)) {
+        json += fmt::format(",\"busVoltage\":{:.3f},\"shuntCurrent\":{:.4f}", pm.busVoltage, pm.shuntCurrent);
+    }
+    auto wifi = hal->getWifiStatus();
+    json += fmt::format(",\"wifiState\":{},\"rssi\":{}}}", (int)wifi.state, wifi.rssi);
+    return json;
+}
+
+static int on_gatt_access(uint16_t connHandle, uint16_t attrHandle, ble_gatt_access_ctxt* ctxt, void* arg)
+{
+    if (ctxt->op != BLE_GATT_ACCESS_OP_READ_CHR) {
+        return BLE_ATT_ERR_UNLIKELY;
+    }
+
+    std::string value;
+    if (ble_uuid_cmp(ctxt->chr->uuid, &_state_uuid.u) == 0) {
+        value = state_to_json();
+    } else {
+        std::lock_guard<std::mutex> lock(_ble_data.statsMutex);
+        value = _ble_data.lastBatch;
+    }
+    return os_mbuf_append(ctxt->om, value.data(), value.size()) == 0 ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
+}
+
+// The tables are handed to the host by pointer, so they are static and filled once
+static void gatt_init()
+{
+    memset(_characteristics, 0, sizeof(_characteristics));
+    memset(_services, 0, sizeof(_services));
+
+    _characteristics[0].uuid       = &_readings_uuid.u;
+    _characteristics[0].access_cb  = on_gatt_access;
+    _characteristics[0].flags      = BLE_GATT_CHR_F_READ | BLE_GATT_CHR_F_NOTIFY;
+    _characteristics[0].val_handle = &_ble_data.readingsHandle;
+    _characteristics[1].uuid       = &_state_uuid.u;
+    _characteristics[1].access_cb  = on_gatt_access;
+    _characteristics[1].flags      = BLE_GATT_CHR_F_READ;
+
+    _services[0].type            = BLE_GATT_SVC_TYPE_PRIMARY;
+    _services[0].uuid            = &_service_uuid.u;
+    _services[0].characteristics = _characteristics;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                     GAP                                    */
+/* -------------------------------------------------------------------------- */
+static void update_conn_interval(uint16_t connHandle)
+{
+    ble_gap_conn_desc desc;
+    if (ble_gap_conn_find(connHandle, &desc) != 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_ble_data.statsMutex);
+    // In 1.25 ms units
+    _ble_data.stats.connIntervalUs = desc.conn_itvl * 1250;
+}
+
+static int on_gap_event(ble_gap_event* event, void* arg)
+{
+    switch (event->type) {
+        case BLE_GAP_EVENT_CONNECT: {
+            if (event->connect.status != 0) {
+                ble_advertise();
+                break;
+            }
+            {
+                std::lock_guard<std::mutex> lock(_ble_data.statsMutex);
+                _ble_data.connHandle        = event->connect.conn_handle;
+                _ble_data.stats.isConnected = true;
+                _ble_data.stats.mtu         = ble_att_mtu(event->connect.conn_handle);
+            }
+            update_conn_interval(event->connect.conn_handle);
+            // The default 23 fits one record, most phones take 247
+            ble_gattc_exchange_mtu(event->connect.conn_handle, nullptr, nullptr);
+            mclog::tagInfo(_tag, "connected");
+            break;
+        }
+        case BLE_GAP_EVENT_DISCONNECT: {
+            {
+                std::lock_guard<std::mutex> lock(_ble_data.statsMutex);
+                _ble_data.connHandle            = BLE_HS_CONN_HANDLE_NONE;
+                _ble_data.stats.isConnected     = false;
+                _ble_data.stats.isSubscribed    = false;
+                _ble_data.stats.mtu             = 0;
+                _ble_data.stats.connIntervalUs  = 0;
+            }
+            mclog::tagInfo(_tag, "disconnected, reason {}", event->disconnect.reason);
+            ble_advertise();
+            break;
+        }
+        case BLE_GAP_EVENT_CONN_UPDATE: {
+            update_conn_interval(event->conn_update.conn_handle);
+            break;
+        }
+        case BLE_GAP_EVENT_MTU: {
+            std::lock_guard<std::mutex> lock(_ble_data.statsMutex);
+            _ble_data.stats.mtu     = event->mtu.value;
+            _ble_data.isParamsDirty = true;
+            break;
+        }
+        case BLE_GAP_EVENT_SUBSCRIBE: {
+            if (event->subscribe.attr_handle != _ble_data.readingsHandle) {
+                break;
+            }
+            std::lock_guard<std::mutex> lock(_ble_data.statsMutex);
+            _ble_data.stats.isSubscribed = event->subscribe.cur_notify;
+            _ble_data.isParamsDirty      = true;
+            break;
+        }
+        case BLE_GAP_EVENT_ADV_COMPLETE: {
+            ble_advertise();
+            break;
+        }
+        default:
+            break;
+    }
+    return 0;
+}
+
+// Slow advertising, a phone scanning in the field still finds it within a second or two
+static void ble_advertise()
+{
+    if (!_ble_data.isRunning) {
+        return;
+    }
+
+    ble_hs_adv_fields fields    = {};
+    fields.flags                = BLE_HS_ADV_F_DISC_GEN | BLE_HS_ADV_F_BREDR_UNSUP;
+    fields.uuids128             = &_service_uuid;
+    fields.num_uuids128         = 1;
+    fields.uuids128_is_complete = 1;
+    int ret                     = ble_gap_adv_set_fields(&fields);
+    if (ret != 0) {
+        mclog::tagError(_tag, "set adv fields failed: {}", ret);
+        return;
+    }
+
+    // The name does not fit next to a 128 bit UUID, it goes in the scan response
+    const auto& name      = _ble_data.config.name;
+    ble_hs_adv_fields rsp = {};
+    rsp.name              = reinterpret_cast<const uint8_t*>(name.c_str());
+    rsp.name_len          = std::min<size_t>(name.size(), 29);
+    rsp.name_is_complete  = name.size() <= 29;
+    ret                   = ble_gap_adv_rsp_set_fields(&rsp);
+    if (ret != 0) {
+        mclog::tagError(_tag, "set scan response failed: {}", ret);
+        return;
+    }
+
+    ble_gap_adv_params params = {};
+    params.conn_mode          = BLE_GAP_CONN_MODE_UND;
+    params.disc_mode          = BLE_GAP_DISC_MODE_GEN;
+    params.itvl_min           = BLE_GAP_ADV_ITVL_MS(500);
+    params.itvl_max           = BLE_GAP_ADV_ITVL_MS(700);
+
+    ret = ble_gap_adv_start(_ble_data.ownAddrType, nullptr, BLE_HS_FOREVER, &params, on_gap_event, nullptr);
+    if (ret != 0 && ret != BLE_HS_EALREADY) {
+        mclog::tagError(_tag, "start adv failed: {}", ret);
+    }
+}
+
+static void on_ble_sync()
+{
+    ble_hs_util_ensure_addr(0);
+    ble_hs_id_infer_auto(0, &_ble_data.ownAddrType);
+    ble_advertise();
+}
+
+static void on_ble_reset(int reason)
+{
+    mclog::tagWarn(_tag, "host reset, reason {}", reason);
+}
+
+static void ble_host_task(void* param)
+{
+    // Returns once nimble_port_stop() is called
+    nimble_port_run();
+    nimble_port_freertos_deinit();
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Task                                    */
+/* -------------------------------------------------------------------------- */
+// Records per notification for the MTU, 3 bytes of it are the ATT header
+static size_t records_per_notify(uint16_t mtu)
+{
+    if (mtu < 3 + _header_size + _record_size) {
+        return 1;
+    }
+    return std::min((mtu - 3 - _header_size) / _record_size, _max_records);
+}
+
+// A notification goes out at the first connection event after it is made. A short interval keeps that delay small
+// and the peripheral latency lets the radio skip the events in between batches, so it wakes about once per batch
+static void request_conn_params(uint16_t connHandle, uint32_t batchPeriodMs)
+{
+    uint32_t interval_ms = std::clamp<uint32_t>(batchPeriodMs / 4, 15, 500);
+    uint32_t latency     = std::min<uint32_t>(batchPeriodMs / interval_ms, 30);
+    latency              = latency > 0 ? latency - 1 : 0;
+    // The spec wants more than (1 + latency) * interval * 2
+    uint32_t timeout_ms = std::clamp<uint32_t>((1 + latency) * interval_ms * 4, 2000, 32000);
+
+    ble_gap_upd_params params  = {};
+    params.itvl_min            = BLE_GAP_CONN_ITVL_MS(interval_ms * 3 / 4);
+    params.itvl_max            = BLE_GAP_CONN_ITVL_MS(interval_ms);
+    params.latency             = latency;
+    params.supervision_timeout = BLE_GAP_SUPERVISION_TIMEOUT_MS(timeout_ms);
+    int ret                    = ble_gap_update_params(connHandle, &params);
+    if (ret != 0) {
+        mclog::tagWarn(_tag, "update params failed: {}", ret);
+        return;
+    }
+    mclog::tagInfo(_tag, "batch every {} ms, asking for {} ms interval, latency {}", batchPeriodMs, interval_ms,
+                   latency);
+}
+
+void HalEsp32::ble_telemetry_task(void* param)
+{
+    static_cast<HalEsp32*>(param)->ble_telemetry_loop();
+
+    xSemaphoreGive(_ble_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+void HalEsp32::ble_telemetry_loop()
+{
+    const auto& config    = _ble_data.config;
+    uint32_t sample_ms    = std::max<uint32_t>(config.sampleIntervalMs, 20);
+    uint32_t latency_ms   = std::clamp<uint32_t>(config.maxLatencyMs, sample_ms, _max_latency_ms);
+    uint32_t next_sample  = millis() + sample_ms;
+    uint32_t power_cursor = powerMonitorHistory.count();
+    uint32_t imu_cursor   = imuHistory.count();
+    uint16_t sequence     = 0;
+    uint32_t first_ms     = 0;
+    size_t count          = 0;
+    uint8_t packet[_header_size + _record_size * _max_records];
+
+    while (_ble_data.isRunning) {
+        int32_t wait_ms = std::max<int32_t>((int32_t)(next_sample - millis()), 0);
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait_ms));
+        if (!_ble_data.isRunning) {
+            break;
+        }
+
+        uint32_t now = millis();
+        if ((int32_t)(now - next_sample) < 0) {
+            continue;
+        }
+        // A stall skips samples rather than taking several in a row
+        bool is_behind = (int32_t)(now - next_sample) >= (int32_t)sample_ms;
+        next_sample    = is_behind ? now + sample_ms : next_sample + sample_ms;
+
+        uint16_t conn_handle;
+        uint16_t mtu;
+        bool is_subscribed;
+        bool is_params_dirty;
+        {
+            std::lock_guard<std::mutex> lock(_ble_data.statsMutex);
+            conn_handle             = _ble_data.connHandle;
+            mtu                     = _ble_data.stats.mtu;
+            is_subscribed           = _ble_data.stats.isSubscribed;
+            is_params_dirty         = _ble_data.isParamsDirty;
+            _ble_data.isParamsDirty = false;
+        }
+        size_t batch_records = records_per_notify(mtu);
+        if (is_params_dirty && is_subscribed) {
+            uint32_t period_ms = std::min<uint32_t>(batch_records * sample_ms, latency_ms);
+            request_conn_params(conn_handle, period_ms);
+        }
+
+        // The histories are read either way, so a new subscriber starts from now
+        float pm_sums[2]   = {0};
+        uint32_t pm_count  = 0;
+        float accel_sum    = 0;
+        uint32_t imu_count = 0;
+        PMData_t pm[_history_batch];
+        size_t size;
+        while ((size = powerMonitorHistory.read(power_cursor, pm, _history_batch)) > 0) {
+            for (size_t i = 0; i < size; i++) {
+                pm_sums[0] += pm[i].busVoltage;
+                pm_sums[1] += pm[i].shuntCurrent;
+            }
+            pm_count += size;
+        }
+        IMUData_t imu[_history_batch];
+        while ((size = imuHistory.read(imu_cursor, imu, _history_batch)) > 0) {
+            for (size_t i = 0; i < size; i++) {
+                accel_sum += std::sqrt(imu[i].accelX * imu[i].accelX + imu[i].accelY * imu[i].accelY +
+                                       imu[i].accelZ * imu[i].accelZ);
+            }
+            imu_count += size;
+        }
+        if (!is_subscribed) {
+            count = 0;
+            continue;
+        }
+
+        if (count == 0) {
+            first_ms = now;
+        }
+        ThermalStatus_t thermal;
+        bool has_thermal = thermalSnapshot.read(thermal);
+        uint8_t* record  = packet + _header_size + count * _record_size;
+        put_u16(record, now - first_ms);
+        put_u16(record + 2, to_u16(pm_count > 0 ? pm_sums[0] / pm_count : NAN, 1000.0f));
+        put_u16(record + 4, to_i16(pm_count > 0 ? pm_sums[1] / pm_count : NAN, 1000.0f));
+        put_u16(record + 6, to_u16(imu_count > 0 ? accel_sum / imu_count : NAN, 1000.0f));
+        put_u16(record + 8, to_i16(has_thermal ? thermal.tempC : NAN, 10.0f));
+        count++;
+        {
+            std::lock_guard<std::mutex> lock(_ble_data.statsMutex);
+            _ble_data.stats.samples++;
+        }
+
+        if (count < batch_records && now - first_ms + sample_ms <= latency_ms) {
+            continue;
+        }
+
+        put_u16(packet, sequence++);
+        put_u32(packet + 2, first_ms);
+        size_t length = _header_size + count * _record_size;
+        count         = 0;
+
+        // The host frees the buffer, sent or not
+        os_mbuf* om = ble_hs_mbuf_from_flat(packet, length);
+        int ret     = BLE_HS_ENOMEM;
+        if (om != nullptr) {
+            ret = ble_gatts_notify_custom(conn_handle, _ble_data.readingsHandle, om);
+        }
+        std::lock_guard<std::mutex> lock(_ble_data.statsMutex);
+        if (ret == 0) {
+            _ble_data.stats.notifications++;
+        } else {
+            _ble_data.stats.dropped++;
+        }
+        _ble_data.lastBatch.assign(reinterpret_cast<const char*>(packet), length);
+    }
+}
+
+bool HalEsp32::startBleTelemetry(const BleTelemetryConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_ble_data.mutex);
+
+    if (_ble_data.isRunning) {
+        return true;
+    }
+
+    _ble_data.config = config;
+    if (_ble_data.config.name.empty()) {
+        uint8_t mac[6] = {0};
+        esp_efuse_mac_get_default(mac);
+        _ble_data.config.name = fmt::format("M5Tab5-{:02X}{:02X}", mac[4], mac[5]);
+    }
+
+    // Samples are averaged from its histories
+    startSensorService(SensorServiceConfig_t());
+
+    // The HCI transport to the C6 is ESP-Hosted, the controller runs there
+    esp_err_t err = nimble_port_init();
+    if (err != ESP_OK) {
+        mclog::tagError(_tag, "nimble init failed: {}", esp_err_to_name(err));
+        return false;
+    }
+    ble_hs_cfg.sync_cb  = on_ble_sync;
+    ble_hs_cfg.reset_cb = on_ble_reset;
+
+    gatt_init();
+    ble_svc_gap_init();
+    ble_svc_gatt_init();
+    int ret = ble_gatts_count_cfg(_services);
+    if (ret == 0) {
+        ret = ble_gatts_add_svcs(_services);
+    }
+    if (ret != 0) {
+        mclog::tagError(_tag, "add services failed: {}", ret);
+        nimble_port_deinit();
+        return false;
+    }
+    ble_svc_gap_device_name_set(_ble_data.config.name.c_str());
+
+    if (_ble_data.exitSem == nullptr) {
+        _ble_data.exitSem = xSemaphoreCreateBinary();
+    }
+    {
+        std::lock_guard<std::mutex> stats_lock(_ble_data.statsMutex);
+        _ble_data.stats           = BleTelemetryStats_t();
+        _ble_data.stats.isRunning = true;
+        _ble_data.connHandle      = BLE_HS_CONN_HANDLE_NONE;
+        _ble_data.isParamsDirty   = false;
+        _ble_data.lastBatch.clear();
+    }
+
+    // Set before the host syncs, the sync callback starts advertising only while running
+    _ble_data.isRunning = true;
+    if (xTaskCreate(ble_telemetry_task, "ble_telemetry", 4096, this, 2, &_ble_data.task) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _ble_data.isRunning = false;
+        _ble_data.task      = nullptr;
+        nimble_port_deinit();
+        return false;
+    }
+    nimble_port_freertos_init(ble_host_task);
+
+    mclog::tagInfo(_tag, "start as {}, sample every {} ms, batch within {} ms", _ble_data.config.name,
+                   config.sampleIntervalMs, config.maxLatencyMs);
+    return true;
+}
+
+void HalEsp32::stopBleTelemetry()
+{
+    std::lock_guard<std::mutex> lock(_ble_data.mutex);
+
+    if (!_ble_data.isRunning) {
+        return;
+    }
+
+    _ble_data.isRunning = false;
+    xTaskNotifyGive(_ble_data.task);
+    xSemaphoreTake(_ble_data.exitSem, portMAX_DELAY);
+    _ble_data.task = nullptr;
+
+    // Drops the connection, the host task leaves nimble_port_run()
+    if (nimble_port_stop() == 0) {
+        nimble_port_deinit();
+    }
+    {
+        std::lock_guard<std::mutex> stats_lock(_ble_data.statsMutex);
+        _ble_data.stats.isRunning      = false;
+        _ble_data.stats.isConnected    = false;
+        _ble_data.stats.isSubscribed   = false;
+        _ble_data.stats.connIntervalUs = 0;
+        _ble_data.connHandle           = BLE_HS_CONN_HANDLE_NONE;
+    }
+    mclog::tagInfo(_tag, "stop");
+}
+
+hal::HalBase::BleTelemetryStats_t HalEsp32::getBleTelemetryStats()
+{
+    std::lock_guard<std::mutex> lock(_ble_data.statsMutex);
+    return _ble_data.stats;
+}
@@ -5,10 +5,15 @@
  */
 #include "hal/hal_esp32.h"
 #include "../utils/task_controller/task_controller.h"
+#include "../utils/aligned_file_writer/aligned_file_writer.h"
+#include "../utils/motion_detector/motion_detector.h"
+#include "../utils/video_plane/video_plane.h"
 #include <mooncake_log.h>
 #include <vector>
 #include <driver/gpio.h>
 #include <memory>
+#include <algorithm>
+#include <cmath>
 #include "bsp/esp-bsp.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -21,34 +26,50 @@
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/param.h>
+#include <sys/select.h>
+#include <sys/stat.h>
 #include <sys/errno.h>
 #include "linux/videodev2.h"
 #include "esp_video_init.h"
 #include "esp_video_device.h"
+#include "esp_video_ioctl.h"
+#include "esp_video_isp_stats.h"
+#include "esp_video_isp_control.h"
 #include "driver/i2c_master.h"
 #include "driver/ppa.h"
+#include "driver/jpeg_encode.h"
+#include "esp_async_memcpy.h"
+#include "esp_cache.h"
+#include "dma_buffer.h"
+#include "esp_h264_enc_single_hw.h"
+#include "usb_device_uvc.h"
+#include <esp_http_server.h>
 #include "imlib.h"
 #include "freertos/queue.h"
-
-#define CAMERA_WIDTH  1280
-#define CAMERA_HEIGHT 720
+#include "freertos/semphr.h"
+#include <atomic>
+#include <shared/shared.h>
+#include "../utils/deferred_log/deferred_log.h"
+#include "../utils/event_trace/event_trace.h"
+#if __has_include("esp_code_scanner.h")
+#include "esp_code_scanner.h"
+#define CAMERA_HAS_CODE_SCANNER 1
+#else
+#define CAMERA_HAS_CODE_SCANNER 0
+#endif
 
 static lv_obj_t* camera_canvas;
 // extern uint8_t* frame_buf;
-static QueueHandle_t queue_camera_ctrl = NULL;
-// 定义任务控制标志
-#define TASK_CONTROL_PAUSE  0
-#define TASK_CONTROL_RESUME 1
-#define TASK_CONTROL_EXIT   2
+static TaskController_t camera_task;
 
 static bool is_camera_capturing = false;
 static std::mutex camera_mutex;
 
 static const char* TAG = "camera";
 
-#define EXAMPLE_VIDEO_BUFFER_COUNT 2
-#define MEMORY_TYPE                V4L2_MEMORY_MMAP
-#define CAM_DEV_PATH               ESP_VIDEO_MIPI_CSI_DEVICE_NAME
+#define CAMERA_MAX_BUFFER_COUNT 4
+#define MEMORY_TYPE             V4L2_MEMORY_MMAP
+#define CAM_DEV_PATH            ESP_VIDEO_MIPI_CSI_DEVICE_NAME
 #ifndef ARRAY_SIZE
 #define ARRAY_SIZE(arr) (sizeof(arr) / sizeof(arr[0]))
 #endif
@@ -58,7 +79,11 @@ typedef struct cam {
     uint32_t width;
     uint32_t height;
     uint32_t pixel_format;
-    uint8_t* buffer[EXAMPLE_VIDEO_BUFFER_COUNT];
+    uint32_t buffer_count;
+    uint32_t mapped_count;  // Buffers requested and mapped for the current format, 0 after a format change
+    bool streaming;
+    uint8_t* buffer[CAMERA_MAX_BUFFER_COUNT];
+    uint32_t buffer_length[CAMERA_MAX_BUFFER_COUNT];
 } cam_t;
 
 /*
@@ -91,7 +116,8 @@ int app_video_open(char* dev, example_fmt_t init_fmt)
     struct v4l2_capability capability;
     const int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
 
-    int fd = open(dev, O_RDONLY);
+    // Non-blocking, the capture loops wait for frames in select() so they can still be stopped when the sensor stalls
+    int fd = open(dev, O_RDONLY | O_NONBLOCK);
     if (fd < 0) {
         ESP_LOGE(TAG, "Open video failed");
         return -1;
@@ -137,259 +163,3784 @@ exit_0:
 
 static esp_err_t new_cam(int cam_fd, cam_t** ret_wc)
 {
-    int ret;
-    struct v4l2_format format;
+    cam_t* wc = (cam_t*)calloc(1, sizeof(cam_t));
+    if (!wc) {
+        return ESP_ERR_NO_MEM;
+    }
+    wc->fd = cam_fd;
+
+    *ret_wc = wc;
+    return ESP_OK;
+}
+
+/* ------------------------------ Capture config ------------------------------ */
+static hal::HalBase::CameraConfig_t camera_config;
+// Thermal cap on the preview FPS, 0 for none
+static std::atomic<uint8_t> camera_fps_cap{0};
+
+// Preview frame spacing, the config FPS under the thermal cap, 0 takes every frame
+static int64_t camera_frame_interval_us()
+{
+    uint8_t fps = camera_config.fps;
+    uint8_t cap = camera_fps_cap.load(std::memory_order_relaxed);
+    if (cap && (fps == 0 || fps > cap)) {
+        fps = cap;
+    }
+    return fps ? 1000000 / fps : 0;
+}
+
+// Source window inside the sensor frame and the preview output, resolved from camera_config
+typedef struct {
+    uint32_t base_x;  // Window from the config, the zoom picks a block inside it
+    uint32_t base_y;
+    uint32_t base_w;
+    uint32_t base_h;
+    uint32_t block_x;
+    uint32_t block_y;
+    uint32_t block_w;
+    uint32_t block_h;
+    uint32_t rest_x;  // Block position before the stabilization offset
+    uint32_t rest_y;
+    uint32_t max_w;  // Output size from the config, the present slots are sized for it
+    uint32_t max_h;
+    uint32_t out_w;  // Current preview size, at most max_w x max_h
+    uint32_t out_h;
+    uint32_t pic_x;  // Scaled block inside the preview, centered. The scaler rounds down, so it can be a little smaller
+    uint32_t pic_y;
+    uint32_t pic_w;
+    uint32_t pic_h;
+    uint32_t out_bpp;
+    float scale_x;
+    float scale_y;
+} camera_transform_t;
+
+static camera_transform_t camera_transform;
+
+// Digital zoom and preview size, set from any task and picked up by the capture task at the next frame
+#define CAMERA_ZOOM_MAX      8.0f
+#define CAMERA_SCALE_FRAG    16  // PPA scale factors have 1/16 precision
+#define CAMERA_PREVIEW_MIN_W 16
+#define CAMERA_PREVIEW_MIN_H 16
+
+typedef struct {
+    float zoom;
+    float center_x;
+    float center_y;
+    uint16_t preview_w;  // 0 means the config size
+    uint16_t preview_h;
+} camera_view_t;
+
+static std::mutex camera_view_mutex;
+static camera_view_t camera_view = {1.0f, 0.5f, 0.5f, 0, 0};
+static std::atomic<bool> camera_view_dirty{false};
+
+// Stabilization, the capture task moves the block against the camera motion the gyro saw during each frame
+#define CAMERA_EIS_SMOOTH_SEC 0.5f  // Motion slower than this is intended, e.g. a vehicle turning, and is followed
+// Board gyro axes that pan and tilt the rear camera, the signs make the block follow the scene
+#define CAMERA_EIS_PAN_AXIS  1
+#define CAMERA_EIS_PAN_SIGN  1.0f
+#define CAMERA_EIS_TILT_AXIS 0
+#define CAMERA_EIS_TILT_SIGN 1.0f
+
+typedef struct {
+    bool active;
+    bool has_smooth;
+    float px_per_rad;    // Focal length in capture pixels
+    int64_t readout_us;  // Half a sensor frame, the dequeue time minus this is the middle of the exposure
+    int64_t last_us;
+    float smooth_pan;  // Low passed angles, the motion that is left in
+    float smooth_tilt;
+} camera_eis_t;
+
+static camera_eis_t camera_eis;
+
+static uint32_t camera_v4l2_pixel_format(hal::HalBase::CameraPixelFormat_t format)
+{
+    switch (format) {
+        case hal::HalBase::CAMERA_PIXEL_FORMAT_YUV420:
+            return EXAMPLE_VIDEO_FMT_YUV420;
+        case hal::HalBase::CAMERA_PIXEL_FORMAT_RAW8:
+            return EXAMPLE_VIDEO_FMT_RAW8;
+        default:
+            return EXAMPLE_VIDEO_FMT_RGB565;
+    }
+}
+
+/**
+ * @brief Pick the sensor mode with the lowest pixel rate that still covers the requested window and FPS.
+ *        Falls back to the fastest mode that covers the window, then to the largest mode.
+ */
+static const esp_cam_sensor_format_t* camera_select_sensor_format(int fd, const hal::HalBase::CameraConfig_t& config)
+{
+    esp_cam_sensor_format_array_t format_array = {};
+    if (ioctl(fd, VIDIOC_QUERY_SENSOR_FMT, &format_array) != 0 || format_array.count == 0) {
+        ESP_LOGW(TAG, "failed to query sensor formats, keep current");
+        return NULL;
+    }
+
+    uint32_t need_w = config.cropW ? config.cropX + config.cropW : config.width;
+    uint32_t need_h = config.cropH ? config.cropY + config.cropH : config.height;
+    if (config.stabilize && !config.cropW) {
+        // Over-scan, a mode with room for the margin keeps the block at full resolution
+        need_w *= 1.0f + 2.0f * config.stabilizeMargin;
+        need_h *= 1.0f + 2.0f * config.stabilizeMargin;
+    }
+
+    const esp_cam_sensor_format_t* best    = NULL;
+    const esp_cam_sensor_format_t* fastest = NULL;
+    const esp_cam_sensor_format_t* largest = NULL;
+    uint64_t best_cost                     = UINT64_MAX;
+    for (uint32_t i = 0; i < format_array.count; i++) {
+        const esp_cam_sensor_format_t* f = &format_array.format_array[i];
+        if (!largest || f->width * f->height > largest->width * largest->height) {
+            largest = f;
+        }
+        if (f->width < need_w || f->height < need_h) {
+            continue;
+        }
+        if (!fastest || f->fps > fastest->fps) {
+            fastest = f;
+        }
+        if (f->fps < config.fps) {
+            continue;
+        }
+        uint64_t cost = (uint64_t)f->width * f->height * f->fps;
+        if (cost < best_cost) {
+            best_cost = cost;
+            best      = f;
+        }
+    }
+
+    if (!best) {
+        best = fastest ? fastest : largest;
+    }
+    return best;
+}
+
+static void camera_resolve_transform(const hal::HalBase::CameraConfig_t& config, uint32_t src_w, uint32_t src_h)
+{
+    camera_transform_t& t = camera_transform;
+
+    t.max_w   = config.width > src_w ? src_w : config.width;
+    t.max_h   = config.height > src_h ? src_h : config.height;
+    t.out_bpp = config.pixelFormat == hal::HalBase::CAMERA_PIXEL_FORMAT_RAW8 ? 1 : 2;
+
+    if (config.cropW && config.cropH && config.cropX + config.cropW <= src_w && config.cropY + config.cropH <= src_h) {
+        t.base_x = config.cropX;
+        t.base_y = config.cropY;
+        t.base_w = config.cropW;
+        t.base_h = config.cropH;
+    } else {
+        // Largest centered window with the output aspect
+        float k  = std::min((float)src_w / t.max_w, (float)src_h / t.max_h);
+        t.base_w = std::min<uint32_t>(src_w, t.max_w * k);
+        t.base_h = std::min<uint32_t>(src_h, t.max_h * k);
+        t.base_x = (src_w - t.base_w) / 2;
+        t.base_y = (src_h - t.base_h) / 2;
+    }
+}
+
+/**
+ * @brief Resolve the preview size and the PPA block inside the base window for the current view.
+ *        The block keeps the preview aspect and the scale is rounded up to the PPA's 1/16 steps, so the scaled
+ *        block always fits the preview.
+ */
+static void camera_apply_view()
+{
+    camera_transform_t& t = camera_transform;
+
+    camera_view_mutex.lock();
+    camera_view_t view = camera_view;
+    camera_view_dirty.store(false, std::memory_order_relaxed);
+    camera_view_mutex.unlock();
+
+    t.out_w = view.preview_w ? std::clamp<uint32_t>(view.preview_w, CAMERA_PREVIEW_MIN_W, t.max_w) : t.max_w;
+    t.out_h = view.preview_h ? std::clamp<uint32_t>(view.preview_h, CAMERA_PREVIEW_MIN_H, t.max_h) : t.max_h;
+    t.out_w &= ~1u;
+    t.out_h &= ~1u;
+
+    // Stabilization frames the view in a centered window inside the base one, the margin left around it is where
+    // the block slides to
+    float inset    = camera_eis.active ? 1.0f / (1.0f + 2.0f * camera_config.stabilizeMargin) : 1.0f;
+    uint32_t win_w = t.base_w * inset;
+    uint32_t win_h = t.base_h * inset;
+    uint32_t win_x = t.base_x + (t.base_w - win_w) / 2;
+    uint32_t win_y = t.base_y + (t.base_h - win_h) / 2;
+
+    float scale = std::max((float)t.out_w / win_w, (float)t.out_h / win_h) * view.zoom;
+    scale       = std::ceil(scale * CAMERA_SCALE_FRAG) / CAMERA_SCALE_FRAG;
+    t.block_w   = std::clamp<uint32_t>(t.out_w / scale, 2, win_w);
+    t.block_h   = std::clamp<uint32_t>(t.out_h / scale, 2, win_h);
+    float x     = view.center_x * win_w - t.block_w / 2.0f;
+    float y     = view.center_y * win_h - t.block_h / 2.0f;
+    t.block_x   = win_x + std::clamp<float>(x, 0, win_w - t.block_w);
+    t.block_y   = win_y + std::clamp<float>(y, 0, win_h - t.block_h);
+
+    // PPA YUV420 input wants even geometry
+    t.block_x &= ~1u;
+    t.block_y &= ~1u;
+    t.block_w &= ~1u;
+    t.block_h &= ~1u;
+    t.rest_x = t.block_x;
+    t.rest_y = t.block_y;
+
+    t.scale_x = scale;
+    t.scale_y = scale;
+
+    t.pic_w = std::min<uint32_t>(t.block_w * scale, t.out_w);
+    t.pic_h = std::min<uint32_t>(t.block_h * scale, t.out_h);
+    t.pic_x = (t.out_w - t.pic_w) / 2;
+    t.pic_y = (t.out_h - t.pic_h) / 2;
+}
+
+/**
+ * @brief Move the block against the camera motion at this frame. The angle from the gyro minus its low passed value
+ *        is the shake, which becomes a pixel offset through the focal length. An offset past the margin is clamped
+ *        and the low pass is pulled along, so the view recovers instead of sticking to the edge.
+ */
+static void camera_eis_update(int64_t frame_us)
+{
+    camera_transform_t& t = camera_transform;
+    camera_eis_t& e       = camera_eis;
+
+    float angle[3];
+    if (!e.active || !GetHAL()->getImuGyroAngle(frame_us - e.readout_us, angle)) {
+        t.block_x = t.rest_x;
+        t.block_y = t.rest_y;
+        return;
+    }
+    float pan  = angle[CAMERA_EIS_PAN_AXIS] * CAMERA_EIS_PAN_SIGN;
+    float tilt = angle[CAMERA_EIS_TILT_AXIS] * CAMERA_EIS_TILT_SIGN;
+    if (!e.has_smooth) {
+        e.has_smooth  = true;
+        e.last_us     = frame_us;
+        e.smooth_pan  = pan;
+        e.smooth_tilt = tilt;
+    }
+    float dt_sec  = (frame_us - e.last_us) / 1000000.0f;
+    float alpha   = dt_sec / (CAMERA_EIS_SMOOTH_SEC + dt_sec);
+    e.last_us     = frame_us;
+    e.smooth_pan  = e.smooth_pan + alpha * (pan - e.smooth_pan);
+    e.smooth_tilt = e.smooth_tilt + alpha * (tilt - e.smooth_tilt);
+
+    float min_x = (float)t.base_x - t.rest_x;
+    float max_x = (float)(t.base_x + t.base_w - t.block_w) - t.rest_x;
+    float min_y = (float)t.base_y - t.rest_y;
+    float max_y = (float)(t.base_y + t.base_h - t.block_h) - t.rest_y;
+    float dx    = (pan - e.smooth_pan) * e.px_per_rad;
+    float dy    = (tilt - e.smooth_tilt) * e.px_per_rad;
+    if (dx < min_x || dx > max_x) {
+        dx           = std::clamp(dx, min_x, max_x);
+        e.smooth_pan = pan - dx / e.px_per_rad;
+    }
+    if (dy < min_y || dy > max_y) {
+        dy            = std::clamp(dy, min_y, max_y);
+        e.smooth_tilt = tilt - dy / e.px_per_rad;
+    }
+    t.block_x = (uint32_t)std::lround(t.rest_x + dx) & ~1u;
+    t.block_y = (uint32_t)std::lround(t.rest_y + dy) & ~1u;
+}
+
+// Before the buffers are requested again and before the device is closed
+static void camera_unmap_buffers(cam_t* wc)
+{
+    for (int i = 0; i < CAMERA_MAX_BUFFER_COUNT; i++) {
+        if (wc->buffer[i]) {
+            munmap(wc->buffer[i], wc->buffer_length[i]);
+            wc->buffer[i]        = NULL;
+            wc->buffer_length[i] = 0;
+        }
+    }
+}
+
+/**
+ * @brief Apply camera_config to the opened device: sensor mode, ISP output format and V4L2 buffers, then start
+ *        streaming.
+ */
+static esp_err_t camera_start_stream(cam_t* wc)
+{
     int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    struct v4l2_requestbuffers req;
-    cam_t* wc;
 
+    if (wc->streaming) {
+        ioctl(wc->fd, VIDIOC_STREAMOFF, &type);
+        wc->streaming = false;
+    }
+
+    const esp_cam_sensor_format_t* sensor_format = camera_select_sensor_format(wc->fd, camera_config);
+    if (sensor_format) {
+        esp_cam_sensor_format_t current_format = {};
+        ioctl(wc->fd, VIDIOC_G_SENSOR_FMT, &current_format);
+        if (current_format.regs != sensor_format->regs) {
+            ESP_LOGI(TAG, "sensor mode: %s", sensor_format->name);
+            if (ioctl(wc->fd, VIDIOC_S_SENSOR_FMT, sensor_format) != 0) {
+                ESP_LOGE(TAG, "failed to set sensor format");
+                return ESP_FAIL;
+            }
+            wc->mapped_count = 0;
+        }
+    }
+
+    struct v4l2_format format;
     memset(&format, 0, sizeof(struct v4l2_format));
     format.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    if (ioctl(cam_fd, VIDIOC_G_FMT, &format) != 0) {
+    if (ioctl(wc->fd, VIDIOC_G_FMT, &format) != 0) {
         ESP_LOGE(TAG, "Failed get fmt");
         return ESP_FAIL;
     }
 
-    wc = (cam_t*)malloc(sizeof(cam_t));
-    if (!wc) {
-        return ESP_ERR_NO_MEM;
+    uint32_t pixel_format = camera_v4l2_pixel_format(camera_config.pixelFormat);
+    if (format.fmt.pix.pixelformat != pixel_format) {
+        format.fmt.pix.pixelformat = pixel_format;
+        if (ioctl(wc->fd, VIDIOC_S_FMT, &format) != 0) {
+            ESP_LOGE(TAG, "failed to set format");
+            return ESP_FAIL;
+        }
+        wc->mapped_count = 0;
     }
 
-    wc->fd           = cam_fd;
     wc->width        = format.fmt.pix.width;
     wc->height       = format.fmt.pix.height;
     wc->pixel_format = format.fmt.pix.pixelformat;
+    wc->buffer_count = std::clamp<uint32_t>(camera_config.bufferCount, 1, CAMERA_MAX_BUFFER_COUNT);
+
+    // STREAMOFF hands every buffer back to the driver, so a restart with the same format only needs to queue them
+    bool is_mapped = wc->mapped_count == wc->buffer_count;
+    if (!is_mapped) {
+        camera_unmap_buffers(wc);
 
-    memset(&req, 0, sizeof(req));
-    req.count  = ARRAY_SIZE(wc->buffer);
-    req.type   = type;
-    req.memory = MEMORY_TYPE;
-    if (ioctl(wc->fd, VIDIOC_REQBUFS, &req) != 0) {
-        ESP_LOGE(TAG, "failed to req buffers");
-        ret = ESP_FAIL;
-        goto errout;
+        struct v4l2_requestbuffers req;
+        memset(&req, 0, sizeof(req));
+        req.count  = wc->buffer_count;
+        req.type   = type;
+        req.memory = MEMORY_TYPE;
+        if (ioctl(wc->fd, VIDIOC_REQBUFS, &req) != 0) {
+            ESP_LOGE(TAG, "failed to req buffers");
+            wc->mapped_count = 0;
+            return ESP_FAIL;
+        }
     }
 
-    for (int i = 0; i < ARRAY_SIZE(wc->buffer); i++) {
+    for (int i = 0; i < wc->buffer_count; i++) {
         struct v4l2_buffer buf;
 
         memset(&buf, 0, sizeof(buf));
         buf.type   = type;
         buf.memory = MEMORY_TYPE;
         buf.index  = i;
-        if (ioctl(wc->fd, VIDIOC_QUERYBUF, &buf) != 0) {
-            ESP_LOGE(TAG, "failed to query buffer");
-            ret = ESP_FAIL;
-            goto errout;
-        }
+        if (!is_mapped) {
+            if (ioctl(wc->fd, VIDIOC_QUERYBUF, &buf) != 0) {
+                ESP_LOGE(TAG, "failed to query buffer");
+                return ESP_FAIL;
+            }
 
-        wc->buffer[i] = (uint8_t*)mmap(NULL, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, wc->fd, buf.m.offset);
-        if (!wc->buffer[i]) {
-            ESP_LOGE(TAG, "failed to map buffer");
-            ret = ESP_FAIL;
-            goto errout;
+            wc->buffer[i] =
+                (uint8_t*)mmap(NULL, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, wc->fd, buf.m.offset);
+            if (!wc->buffer[i]) {
+                ESP_LOGE(TAG, "failed to map buffer");
+                return ESP_FAIL;
+            }
+            wc->buffer_length[i] = buf.length;
         }
 
         if (ioctl(wc->fd, VIDIOC_QBUF, &buf) != 0) {
             ESP_LOGE(TAG, "failed to queue frame buffer");
-            ret = ESP_FAIL;
-            goto errout;
+            return ESP_FAIL;
         }
     }
 
+    // Frames are stamped at dequeue with esp_timer, the same clock as the IMU samples
+    camera_eis.active     = camera_config.stabilize && camera_config.stabilizeMargin > 0;
+    camera_eis.has_smooth = false;
+    camera_eis.px_per_rad = wc->width / 2.0f / std::tan(camera_config.horizontalFovDeg * (float)M_PI / 360.0f);
+    if (sensor_format && sensor_format->fps) {
+        camera_eis.readout_us = 500000 / sensor_format->fps;
+    }
+    if (camera_eis.active && !GetHAL()->isImuStreaming()) {
+        ESP_LOGW(TAG, "stabilization waits for the IMU stream");
+    }
+
+    camera_resolve_transform(camera_config, wc->width, wc->height);
+    camera_apply_view();
+    ESP_LOGI(TAG, "capture %" PRIu32 "x%" PRIu32 " -> window %" PRIu32 "x%" PRIu32 "+%" PRIu32 "+%" PRIu32
+                  " -> preview %" PRIu32 "x%" PRIu32,
+             wc->width, wc->height, camera_transform.block_w, camera_transform.block_h, camera_transform.block_x,
+             camera_transform.block_y, camera_transform.out_w, camera_transform.out_h);
+
+    wc->mapped_count = wc->buffer_count;
+
     if (ioctl(wc->fd, VIDIOC_STREAMON, &type)) {
         ESP_LOGE(TAG, "failed to start stream");
-        ret = ESP_FAIL;
-        goto errout;
+        return ESP_FAIL;
     }
+    wc->streaming = true;
 
-    *ret_wc = wc;
     return ESP_OK;
-
-errout:
-    free(wc);
-    return ret;
 }
 
-// static HumanFaceDetect* human_face_detector;
-static bool cam_is_initial = false;
-static cam_t* camera       = NULL;
-
-void app_camera_display(void* arg)
+static void camera_stop_stream(cam_t* wc)
 {
-    /* camera config */
-    static esp_video_init_csi_config_t csi_config = {
-        .sccb_config =
-            {
-                .init_sccb  = false,
-                .i2c_handle = NULL,
-                .freq       = 400000,  // TAB5_MIPI_CSI_SCCB_I2C_FREQ,
-            },
-        .reset_pin = -1,  // TAB5_MIPI_CSI_CAM_SENSOR_RESET_PIN,
-        .pwdn_pin  = -1,  // TAB5_MIPI_CSI_CAM_SENSOR_PWDN_PIN,
-    };
-    csi_config.sccb_config.i2c_handle = bsp_i2c_get_handle();
-
-    esp_video_init_config_t cam_config = {
-        .csi  = &csi_config,  // Point to CSI config
-        .dvp  = NULL,         // No DVP configuration
-        .jpeg = NULL,         // No JPEG configuration
-    };
-
-    if (!cam_is_initial) {
-        camera = (cam_t*)malloc(sizeof(cam_t));
-        printf("\n============= video init ==============\n");
-        cam_is_initial = true;
-        ESP_ERROR_CHECK(esp_video_init(&cam_config));
-        printf("\n============= video open ==============\n");
-        int video_cam_fd = app_video_open(CAM_DEV_PATH, EXAMPLE_VIDEO_FMT_RGB565);
-        if (video_cam_fd < 0) {
-            ESP_LOGE(TAG, "video cam open failed");
-            return;
-        }
-        ESP_ERROR_CHECK(new_cam(video_cam_fd, &camera));
+    int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (wc->streaming) {
+        ioctl(wc->fd, VIDIOC_STREAMOFF, &type);
+        wc->streaming = false;
     }
+}
 
-    struct v4l2_buffer buf;
+static cam_t* camera = NULL;
 
-    /* */
-    uint16_t screen_width  = 1280;  // 640;//lcd_height();
-    uint16_t screen_height = 720;   // 480;//lcd_width();
-    uint8_t* img_show_data = NULL;
-    uint32_t img_show_size = screen_width * screen_height * 2;
-    // uint32_t img_offset = 280 * 720 * 2;
-    uint32_t img_offset = 0;
-    static image_t* img_show;  // 初始化静态变量时不能使用非常量表达式
-    if (img_show == NULL) {
-        img_show    = (image_t*)malloc(sizeof(image_t));
-        img_show->w = 720,            // screen_width;
-                                      // img_show->h = 720, // screen_height;
-            img_show->h      = 1280,  // screen_height;
-            img_show->pixfmt = PIXFORMAT_RGB565;
-        img_show->size       = img_show->w * img_show->h * img_show->bpp;
-        img_show_data        = (uint8_t*)heap_caps_calloc(img_show_size, 1, MALLOC_CAP_DMA | MALLOC_CAP_SPIRAM);
-        img_show->data       = img_show_data + img_offset;
-        if (img_show->data == NULL) {
-            ESP_LOGE(TAG, "malloc for img_show->data failed");
-        }
-    }
-
-    ppa_client_handle_t ppa_srm_handle = NULL;
-    ppa_client_config_t ppa_srm_config = {
-        .oper_type             = PPA_OPERATION_SRM,
-        .max_pending_trans_num = 1,
-    };
-    ESP_ERROR_CHECK(ppa_register_client(&ppa_srm_config, &ppa_srm_handle));
+// A stop request is seen within this while the sensor sends no frames
+#define CAMERA_DQBUF_POLL_MS  100
+#define CAMERA_DQBUF_WARN_SEC 1
 
-    int task_control = 0;
+/**
+ * @brief Dequeue the next frame, waiting in select() so a stop request ends the wait even when frames stop arriving.
+ *
+ * @return false on a stop request or a device error
+ */
+static bool camera_dqbuf(TaskController_t& task, struct v4l2_buffer& buf)
+{
+    int64_t start_us = esp_timer_get_time();
+    bool is_warned   = false;
     while (1) {
-        memset(&buf, 0, sizeof(buf));
-        buf.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-        buf.memory = MEMORY_TYPE;
-        if (ioctl(camera->fd, VIDIOC_DQBUF, &buf) != 0) {
+        if (ioctl(camera->fd, VIDIOC_DQBUF, &buf) == 0) {
+            return true;
+        }
+        if (errno != EAGAIN) {
             ESP_LOGE(TAG, "failed to receive video frame");
-            break;
+            return false;
+        }
+        if (task.isStopRequested()) {
+            return false;
         }
 
-        ppa_srm_oper_config_t srm_config = {.in             = {.buffer         = camera->buffer[buf.index],
-                                                               .pic_w          = 1280,
-                                                               .pic_h          = 720,
-                                                               .block_w        = 1280,
-                                                               .block_h        = 720,
-                                                               .block_offset_x = 0,
-                                                               .block_offset_y = 0,
-                                                               .srm_cm         = PPA_SRM_COLOR_MODE_RGB565},
-                                            .out            = {.buffer         = img_show_data,
-                                                               .buffer_size    = img_show_size,
-                                                               .pic_w          = 1280,
-                                                               .pic_h          = 720,
-                                                               .block_offset_x = 0,
-                                                               .block_offset_y = 0,
-                                                               .srm_cm         = PPA_SRM_COLOR_MODE_RGB565},
-                                            .rotation_angle = PPA_SRM_ROTATION_ANGLE_0,
-                                            .scale_x        = 1,
-                                            .scale_y        = 1,
-                                            .mirror_x       = true,
-                                            .mirror_y       = false,
-                                            .rgb_swap       = false,
-                                            .byte_swap      = false,
-                                            .mode           = PPA_TRANS_MODE_BLOCKING};
-        ppa_do_scale_rotate_mirror(ppa_srm_handle, &srm_config);
-
-        // auto detect_results = human_face_detector->run(dl_img); // format: hwc
-
-        bsp_display_lock(0);
-        lv_canvas_set_buffer(camera_canvas, img_show->data, CAMERA_WIDTH, CAMERA_HEIGHT, LV_COLOR_FORMAT_RGB565);
-        bsp_display_unlock();
-
-        if (ioctl(camera->fd, VIDIOC_QBUF, &buf) != 0) {
-            ESP_LOGE(TAG, "failed to free video frame");
-        }
-
-        if (xQueueReceive(queue_camera_ctrl, &task_control, 0) == pdPASS) {
-            if (task_control == TASK_CONTROL_PAUSE) {
-                ESP_LOGI(TAG, "task pause");
-                if (xQueueReceive(queue_camera_ctrl, &task_control, portMAX_DELAY) == pdPASS) {
-                    if (task_control == TASK_CONTROL_EXIT) {
-                        break;
-                    } else {
-                        ESP_LOGI(TAG, "task resume");
-                    }
-                }
-            }
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        FD_SET(camera->fd, &readfds);
+        struct timeval timeout = {.tv_sec = 0, .tv_usec = CAMERA_DQBUF_POLL_MS * 1000};
+        int ret                = select(camera->fd + 1, &readfds, NULL, NULL, &timeout);
+        if (ret < 0) {
+            ESP_LOGE(TAG, "failed to wait for video frame, errno %d", errno);
+            return false;
         }
+        if (ret == 0 && !is_warned && esp_timer_get_time() - start_us > CAMERA_DQBUF_WARN_SEC * 1000000LL) {
+            ESP_LOGW(TAG, "no frame from the sensor for %d s", CAMERA_DQBUF_WARN_SEC);
+            is_warned = true;
+        }
+    }
+}
+
+/* ---------------------------------- Stats ---------------------------------- */
+/*
+ * Frame-timing instrumentation.
+ * Each stage has its own ring with a single writer (capture task, requeue task or LVGL), so samples are pushed with
+ * a relaxed store and a release on the head, and readers just copy whatever is there.
+ */
+#define CAMERA_STATS_RING_SIZE 128
+
+typedef struct {
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> samples[CAMERA_STATS_RING_SIZE];
+} camera_stats_ring_t;
+
+typedef enum {
+    CAMERA_STAGE_DQBUF = 0,
+    CAMERA_STAGE_PPA,
+    CAMERA_STAGE_PRESENT,
+    CAMERA_STAGE_QBUF,
+    CAMERA_STAGE_FRAME,  // Interval between presented frames, gives the FPS
+    CAMERA_STAGE_NUM,
+} camera_stage_t;
+
+static camera_stats_ring_t camera_stats[CAMERA_STAGE_NUM];
+static std::atomic<uint32_t> camera_frames_dropped{0};
+static std::atomic<int64_t> camera_published_us{0};
+static int64_t camera_presented_us = 0;
+
+static void camera_stats_push(camera_stage_t stage, int64_t us)
+{
+    camera_stats_ring_t& ring = camera_stats[stage];
+    uint32_t head             = ring.head.load(std::memory_order_relaxed);
+    ring.samples[head % CAMERA_STATS_RING_SIZE].store((uint32_t)us, std::memory_order_relaxed);
+    ring.head.store(head + 1, std::memory_order_release);
+}
 
-        vTaskDelay(pdMS_TO_TICKS(10));
+static void camera_stats_reset()
+{
+    for (auto& ring : camera_stats) {
+        ring.head.store(0, std::memory_order_release);
     }
+    camera_frames_dropped.store(0, std::memory_order_relaxed);
+    camera_published_us.store(0, std::memory_order_relaxed);
+    camera_presented_us = 0;
+}
 
-    ESP_LOGI(TAG, "task exit");
-    ppa_unregister_client(ppa_srm_handle);
-    // delete human_face_detector;
-    if (img_show_data) {
-        heap_caps_free(img_show_data);
-        img_show_data = NULL;
+// Copies the valid samples of a ring and sorts them, returns the sample count
+static uint32_t camera_stats_collect(camera_stage_t stage, uint32_t* out)
+{
+    camera_stats_ring_t& ring = camera_stats[stage];
+    uint32_t count            = std::min<uint32_t>(ring.head.load(std::memory_order_acquire), CAMERA_STATS_RING_SIZE);
+    for (uint32_t i = 0; i < count; i++) {
+        out[i] = ring.samples[i].load(std::memory_order_relaxed);
     }
-    if (img_show) {
-        heap_caps_free(img_show);
-        img_show = NULL;
+    std::sort(out, out + count);
+    return count;
+}
+
+static hal::HalBase::CameraStageStats_t camera_stats_stage(camera_stage_t stage)
+{
+    uint32_t sorted[CAMERA_STATS_RING_SIZE];
+    hal::HalBase::CameraStageStats_t stats;
+    uint32_t count = camera_stats_collect(stage, sorted);
+    if (count) {
+        stats.p50 = sorted[count / 2];
+        stats.p99 = sorted[(count * 99) / 100];
     }
-    // close(camera->fd);
+    return stats;
+}
 
-    camera_mutex.lock();
-    is_camera_capturing = false;
-    camera_mutex.unlock();
+/*
+ * Presentation ring between the camera task and LVGL.
+ * LVGL owns `front`, `middle` holds the latest completed frame, and the rest are back slots that PPA writes into,
+ * one per in-flight transaction. Both sides only ever swap a slot with `middle`, so the slot on screen is never
+ * overwritten.
+ */
+#define CAMERA_PRESENT_SLOT_MAX   (2 + CAMERA_MAX_BUFFER_COUNT)
+#define CAMERA_PRESENT_SLOT_MASK  0x07
+#define CAMERA_PRESENT_SLOT_FRESH 0x08
+// UI frames up to this size are rotated by the CPU while the preview runs, instead of queueing behind the camera on
+// the PPA. About a millisecond of tiled rotation
+#define CAMERA_UI_CPU_ROTATE_PX (32 * 1024)
 
-    vTaskDelete(NULL);
+static uint8_t* present_slots[CAMERA_PRESENT_SLOT_MAX] = {NULL};
+static uint16_t present_slot_w[CAMERA_PRESENT_SLOT_MAX];  // Frame size in each slot, the preview can resize
+static uint16_t present_slot_h[CAMERA_PRESENT_SLOT_MAX];
+// Preview and scaled block size the margins of each slot were cleared for, 0 before the first frame
+static uint64_t present_slot_picture[CAMERA_PRESENT_SLOT_MAX];
+static int present_slot_count = 0;
+static std::atomic<uint8_t> present_middle{1};
+static uint8_t present_front     = 0;
+static lv_timer_t* present_timer = NULL;  // LVGL context only
+
+// The capture task hands its LVGL changes to the LVGL task instead of waiting on the lock through a render. Runs
+// them under the lock right away only if the queue is full
+static void camera_run_on_ui(std::function<void()> command)
+{
+    if (!GetHAL()->postUiCommand(command)) {
+        LvglLockGuard lock("camera");
+        command();
+    }
 }
 
-void HalEsp32::startCameraCapture(lv_obj_t* imgCanvas)
+/*
+ * Video plane.
+ * A canvas drawn as a plain opaque rectangle, e.g. the maximized preview, does not go through LVGL composition. The
+ * front slot is handed to the display port, which rotates it straight into the DPI frame buffer under every frame.
+ * The canvas keeps pointing at the same slot without being invalidated, so LVGL only renders the widgets drawn over
+ * it, and those with the new frame under them for correct alpha.
+ */
+static bool present_plane_active = false;
+
+// Runs in LVGL context, the plane falls back to the canvas path before the slots change
+static void camera_video_plane_clear()
 {
-    mclog::tagInfo(TAG, "start camera capture");
+    if (present_plane_active) {
+        lvgl_port_set_video_plane(lv_obj_get_display(camera_canvas), NULL, NULL);
+        present_plane_active = false;
+        // Only the overlays are up to date in the draw buffer
+        lv_obj_invalidate(camera_canvas);
+    }
+}
 
-    camera_canvas = imgCanvas;
+// The slot as drawn by the canvas is exactly the rectangle of its coordinates
+static bool camera_video_plane_fits(uint16_t slot_w, uint16_t slot_h, lv_area_t& area)
+{
+    return camera_config.videoPlane && camera_transform.out_bpp == 2 &&
+           video_plane::fits(camera_canvas, slot_w, slot_h, area);
+}
 
-    queue_camera_ctrl = xQueueCreate(10, sizeof(int));
-    if (queue_camera_ctrl == NULL) {
-        ESP_LOGD(TAG, "Failed to create semaphore\n");
+// Swaps the canvas onto the slot without invalidating it, false if the plane does not apply to this frame
+static bool camera_video_plane_present(uint8_t* slot, uint16_t slot_w, uint16_t slot_h)
+{
+    lv_area_t area;
+    lv_draw_buf_t* draw_buf = lv_canvas_get_draw_buf(camera_canvas);
+    // The first frame at a new size still goes the canvas way, so the canvas is set up to match the slot
+    if (draw_buf == NULL || draw_buf->header.w != slot_w || draw_buf->header.h != slot_h ||
+        draw_buf->header.cf != LV_COLOR_FORMAT_RGB565 || !camera_video_plane_fits(slot_w, slot_h, area)) {
+        return false;
+    }
+    if (lvgl_port_set_video_plane(lv_obj_get_display(camera_canvas), slot, &area) != ESP_OK) {
+        // There is no vsync swap to put it under, the canvas path stays in use
+        camera_config.videoPlane = false;
+        return false;
+    }
+    if (!present_plane_active) {
+        DeferredLog::info(TAG, "video plane on at {}x{}", slot_w, slot_h);
+        present_plane_active = true;
     }
 
-    is_camera_capturing = true;
-    xTaskCreatePinnedToCore(app_camera_display, "cam", 8 * 1024, NULL, 5, NULL, 1);
+    draw_buf->data = slot;
+    lv_image_cache_drop(draw_buf);
+    video_plane::invalidate_overlays(camera_canvas, area);
+    video_plane::invalidate_dot(camera_canvas, area);
+    return true;
 }
 
-void HalEsp32::stopCameraCapture()
+// Runs in LVGL context, picks up the newest frame if there is one
+static void camera_present_timer_cb(lv_timer_t* timer)
 {
-    mclog::tagInfo(TAG, "stop camera capture");
+    if (!(present_middle.load(std::memory_order_acquire) & CAMERA_PRESENT_SLOT_FRESH)) {
+        return;
+    }
+    present_front = present_middle.exchange(present_front, std::memory_order_acq_rel) & CAMERA_PRESENT_SLOT_MASK;
+    if (!camera_video_plane_present(present_slots[present_front], present_slot_w[present_front],
+                                    present_slot_h[present_front])) {
+        if (present_plane_active) {
+            DeferredLog::info(TAG, "video plane off");
+        }
+        camera_video_plane_clear();
+        lv_canvas_set_buffer(camera_canvas, present_slots[present_front], present_slot_w[present_front],
+                             present_slot_h[present_front],
+                             camera_transform.out_bpp == 1 ? LV_COLOR_FORMAT_L8 : LV_COLOR_FORMAT_RGB565);
+    }
+
+    int64_t now_us = esp_timer_get_time();
+    camera_stats_push(CAMERA_STAGE_PRESENT, now_us - camera_published_us.load(std::memory_order_relaxed));
+    if (camera_presented_us) {
+        camera_stats_push(CAMERA_STAGE_FRAME, now_us - camera_presented_us);
+    }
+    camera_presented_us = now_us;
+}
+
+/*
+ * Non-blocking PPA transactions.
+ * The done callback runs in ISR context and only posts the transaction, the `cam_rq` task then publishes the slot,
+ * hands the recycled slot back to the capture task and offers the V4L2 buffer to the other consumers.
+ */
+#define CAMERA_REQUEUE_FLUSH (-1)  // Acknowledged on sem_requeue_done once everything before it is requeued
+#define CAMERA_REQUEUE_EXIT  (-2)  // Acknowledged on sem_requeue_done, then the task exits
 
-    int control_state = 0;  // pause
-    xQueueSend(queue_camera_ctrl, &control_state, portMAX_DELAY);
+typedef struct {
+    int v4l2_index;  // Or one of the CAMERA_REQUEUE_ sentinels
+    uint8_t slot;
+    int64_t submit_us;
+} camera_ppa_trans_t;
 
-    control_state = 2;  // exit
-    xQueueSend(queue_camera_ctrl, &control_state, portMAX_DELAY);
+static camera_ppa_trans_t ppa_trans[CAMERA_MAX_BUFFER_COUNT];
+static QueueHandle_t queue_ppa_done       = NULL;
+static QueueHandle_t queue_present_free   = NULL;
+static SemaphoreHandle_t sem_requeue_done = NULL;
+
+static bool camera_ppa_trans_done_cb(ppa_client_handle_t ppa_client, ppa_event_data_t* event_data, void* user_data)
+{
+    BaseType_t high_task_wakeup = pdFALSE;
+    camera_ppa_trans_t* trans   = (camera_ppa_trans_t*)user_data;
+    TRACE_INSTANT("camera ppa done");
+    xQueueSendFromISR(queue_ppa_done, &trans, &high_task_wakeup);
+    return high_task_wakeup == pdTRUE;
 }
 
-bool HalEsp32::isCameraCapturing()
+/* -------------------------------- Frame broker -------------------------------- */
+/*
+ * A dequeued V4L2 buffer is shared in place by everything that reads it. The preview's PPA transform holds the first
+ * reference, the requeue task then offers the buffer to the RAW capture, the JPEG and H.264 encoders and the frame
+ * subscribers, and each one that takes it holds a reference of its own. The buffer goes back to the driver when the
+ * last reference is released, on whichever task that happens. Each consumer decides alone whether it takes a frame,
+ * one that is still busy drops it without holding back the others.
+ */
+typedef struct {
+    int id;
+    hal::HalBase::CameraFrameSubscriberConfig_t config;
+    hal::HalBase::CameraFrameCallback_t callback;
+    // Handles out, shared with their deleters so a handle released after the unsubscribe still finds it
+    std::shared_ptr<std::atomic<uint8_t>> held;
+    int64_t last_us;
+    hal::HalBase::CameraFrameSubscriberStats_t stats;
+} camera_subscriber_t;
+
+static std::atomic<uint8_t> frame_refs[CAMERA_MAX_BUFFER_COUNT];
+static hal::HalBase::CameraFrame_t frame_descs[CAMERA_MAX_BUFFER_COUNT];  // Written at DQBUF, before any reference
+static uint32_t frame_sequence = 0;                                       // Owned by the capture task
+
+static std::mutex camera_subscribers_mutex;
+static std::vector<camera_subscriber_t> camera_subscribers;
+static int camera_subscriber_next_id = 1;
+
+static hal::HalBase::CameraPixelFormat_t camera_hal_pixel_format(uint32_t pixel_format)
 {
-    std::lock_guard<std::mutex> lock(camera_mutex);
-    return is_camera_capturing;
+    switch (pixel_format) {
+        case EXAMPLE_VIDEO_FMT_RGB565:
+            return hal::HalBase::CAMERA_PIXEL_FORMAT_RGB565;
+        case EXAMPLE_VIDEO_FMT_RAW8:
+            return hal::HalBase::CAMERA_PIXEL_FORMAT_RAW8;
+        default:
+            return hal::HalBase::CAMERA_PIXEL_FORMAT_YUV420;
+    }
+}
+
+// Capture task, right after DQBUF. The capture holds the first reference
+static void camera_frame_hold(int v4l2_index, int64_t timestamp_us)
+{
+    hal::HalBase::CameraFrame_t& desc = frame_descs[v4l2_index];
+
+    desc.data        = camera->buffer[v4l2_index];
+    desc.width       = camera->width;
+    desc.height      = camera->height;
+    desc.pixelFormat = camera_hal_pixel_format(camera->pixel_format);
+    desc.size        = desc.pixelFormat == hal::HalBase::CAMERA_PIXEL_FORMAT_RAW8     ? desc.width * desc.height
+                       : desc.pixelFormat == hal::HalBase::CAMERA_PIXEL_FORMAT_YUV420 ? desc.width * desc.height * 3 / 2
+                                                                                      : desc.width * desc.height * 2;
+    desc.sequence    = frame_sequence++;
+    desc.timestampUs = timestamp_us;
+    frame_refs[v4l2_index].store(1, std::memory_order_release);
+}
+
+// Only by a holder, for a consumer it hands the buffer to
+static void camera_frame_ref(int v4l2_index)
+{
+    frame_refs[v4l2_index].fetch_add(1, std::memory_order_relaxed);
+}
+
+static void camera_frame_release(int v4l2_index)
+{
+    if (frame_refs[v4l2_index].fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    struct v4l2_buffer buf;
+    memset(&buf, 0, sizeof(buf));
+    buf.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = MEMORY_TYPE;
+    buf.index  = v4l2_index;
+    TRACE_BEGIN("camera qbuf");
+    if (ioctl(camera->fd, VIDIOC_QBUF, &buf) != 0) {
+        ESP_LOGE(TAG, "failed to free video frame");
+    }
+    TRACE_END("camera qbuf");
+}
+
+// Waits for every consumer to release its buffers, before STREAMOFF. A subscriber keeping a handle keeps the stream up
+static void camera_frames_drain()
+{
+    int64_t start_us = esp_timer_get_time();
+    bool is_warned   = false;
+    for (int i = 0; i < CAMERA_MAX_BUFFER_COUNT; i++) {
+        while (frame_refs[i].load(std::memory_order_acquire) != 0) {
+            if (!is_warned && esp_timer_get_time() - start_us > 1000 * 1000) {
+                ESP_LOGW(TAG, "waiting for frame subscribers to release buffer %d", i);
+                is_warned = true;
+            }
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+    }
+}
+
+// Called by a holder of the buffer. The callbacks run after the lock is dropped, so they may unsubscribe
+static void camera_subscribers_offer(int v4l2_index, bool is_skipped)
+{
+    struct delivery_t {
+        hal::HalBase::CameraFrameCallback_t callback;
+        hal::HalBase::CameraFrameHandle_t frame;
+    };
+    std::vector<delivery_t> deliveries;
+    {
+        std::lock_guard<std::mutex> lock(camera_subscribers_mutex);
+        if (camera_subscribers.empty()) {
+            return;
+        }
+
+        const hal::HalBase::CameraFrame_t* desc = &frame_descs[v4l2_index];
+        for (auto& subscriber : camera_subscribers) {
+            const auto& config = subscriber.config;
+            if (is_skipped && !config.takeSkippedFrames) {
+                continue;
+            }
+            int64_t interval_us = config.maxFps ? 1000000 / config.maxFps : 0;
+            if (interval_us && desc->timestampUs - subscriber.last_us < interval_us - interval_us / 4) {
+                continue;
+            }
+            if (subscriber.held->load(std::memory_order_acquire) >= std::max<uint8_t>(config.maxHeld, 1)) {
+                subscriber.stats.dropped++;
+                continue;
+            }
+
+            subscriber.held->fetch_add(1, std::memory_order_acq_rel);
+            camera_frame_ref(v4l2_index);
+            auto held = subscriber.held;
+            hal::HalBase::CameraFrameHandle_t frame(desc, [held, v4l2_index](const hal::HalBase::CameraFrame_t*) {
+                held->fetch_sub(1, std::memory_order_acq_rel);
+                camera_frame_release(v4l2_index);
+            });
+            subscriber.last_us = desc->timestampUs;
+            subscriber.stats.delivered++;
+            deliveries.push_back({subscriber.callback, std::move(frame)});
+        }
+    }
+
+    for (auto& delivery : deliveries) {
+        delivery.callback(std::move(delivery.frame));
+    }
+}
+
+/* --------------------------------- Recorder --------------------------------- */
+/*
+ * Snapshots and MJPEG recording.
+ * The requeue task lends finished V4L2 buffers to the `cam_jpeg` task, but only when the encoder is idle and an
+ * output buffer is free, so the preview never waits for the encoder or the SD card. Encoded
+ * frames go to the `cam_wr` task, which owns every file handle.
+ */
+#define RECORDER_OUT_BUF_COUNT  3
+#define RECORDER_OUT_BUF_SIZE   (512 * 1024)
+#define RECORDER_WRITE_BUF_SIZE (64 * 1024)
+#define RECORDER_JPEG_QUALITY   80
+#define RECORDER_PATH_MAX       96
+
+typedef enum {
+    RECORDER_JOB_SNAPSHOT = 0,
+    RECORDER_JOB_VIDEO_OPEN,
+    RECORDER_JOB_VIDEO_FRAME,
+    RECORDER_JOB_VIDEO_CLOSE,
+    RECORDER_JOB_UVC_FRAME,
+} recorder_job_type_t;
+
+typedef struct {
+    recorder_job_type_t type;
+    int v4l2_index;
+    uint32_t width;
+    uint32_t height;
+    uint32_t pixel_format;
+    uint8_t* out;
+    uint32_t out_size;
+    int64_t timestamp_us;
+    uint8_t fps;
+    char path[RECORDER_PATH_MAX];
+} recorder_job_t;
+
+static std::mutex recorder_mutex;
+static bool recorder_is_initial = false;
+static bool snapshot_pending    = false;
+static char snapshot_path[RECORDER_PATH_MAX];
+static bool is_recording          = false;
+static int64_t record_interval_us = 0;
+static int64_t record_last_us     = 0;
+static uint32_t record_dropped    = 0;
+static std::atomic<bool> jpeg_busy{false};
+
+static jpeg_encoder_handle_t jpeg_encoder  = NULL;
+static QueueHandle_t queue_jpeg_job        = NULL;
+static QueueHandle_t queue_jpeg_out_free   = NULL;
+static QueueHandle_t queue_recorder_writer = NULL;
+
+// UVC frames borrow the encoder and its output buffers, see the UVC webcam section
+static std::atomic<bool> uvc_is_enabled{false};
+static std::atomic<bool> uvc_is_streaming{false};
+static int64_t uvc_interval_us       = 0;
+static int64_t uvc_last_us           = 0;
+static QueueHandle_t queue_uvc_frame = NULL;
+
+/* AVI (RIFF) MJPEG container: fixed 224 byte header, '00dc' chunks, idx1 at the end */
+#define AVI_HEADER_SIZE    224
+#define AVI_MOVI_FOURCC_AT (AVI_HEADER_SIZE - 4)
+
+typedef struct {
+    FILE* file;
+    uint32_t width;
+    uint32_t height;
+    uint8_t fps;
+    uint32_t frames;
+    uint32_t movi_size;
+    uint32_t max_frame_size;
+    int64_t first_us;
+    int64_t last_us;
+    std::vector<uint32_t> index;  // offset, size pairs
+} avi_writer_t;
+
+static inline void avi_put_u32(uint8_t*& p, uint32_t v)
+{
+    memcpy(p, &v, 4);
+    p += 4;
+}
+
+static inline void avi_put_u16(uint8_t*& p, uint16_t v)
+{
+    memcpy(p, &v, 2);
+    p += 2;
+}
+
+static inline void avi_put_fourcc(uint8_t*& p, const char* fourcc)
+{
+    memcpy(p, fourcc, 4);
+    p += 4;
+}
+
+static void avi_build_header(uint8_t* hdr, const avi_writer_t& avi, uint32_t riff_size)
+{
+    uint32_t fps = avi.fps;
+    if (avi.frames > 1 && avi.last_us > avi.first_us) {
+        fps = (uint32_t)(((uint64_t)(avi.frames - 1) * 1000000 + (avi.last_us - avi.first_us) / 2) /
+                         (avi.last_us - avi.first_us));
+    }
+    fps = std::max<uint32_t>(fps, 1);
+
+    uint8_t* p = hdr;
+    avi_put_fourcc(p, "RIFF");
+    avi_put_u32(p, riff_size);
+    avi_put_fourcc(p, "AVI ");
+
+    avi_put_fourcc(p, "LIST");
+    avi_put_u32(p, 192);
+    avi_put_fourcc(p, "hdrl");
+
+    avi_put_fourcc(p, "avih");
+    avi_put_u32(p, 56);
+    avi_put_u32(p, 1000000 / fps);             // dwMicroSecPerFrame
+    avi_put_u32(p, avi.max_frame_size * fps);  // dwMaxBytesPerSec
+    avi_put_u32(p, 0);                         // dwPaddingGranularity
+    avi_put_u32(p, 0x10);                      // dwFlags: AVIF_HASINDEX
+    avi_put_u32(p, avi.frames);                // dwTotalFrames
+    avi_put_u32(p, 0);                         // dwInitialFrames
+    avi_put_u32(p, 1);                         // dwStreams
+    avi_put_u32(p, avi.max_frame_size);        // dwSuggestedBufferSize
+    avi_put_u32(p, avi.width);
+    avi_put_u32(p, avi.height);
+    for (int i = 0; i < 4; i++) {
+        avi_put_u32(p, 0);
+    }
+
+    avi_put_fourcc(p, "LIST");
+    avi_put_u32(p, 116);
+    avi_put_fourcc(p, "strl");
+
+    avi_put_fourcc(p, "strh");
+    avi_put_u32(p, 56);
+    avi_put_fourcc(p, "vids");
+    avi_put_fourcc(p, "MJPG");
+    avi_put_u32(p, 0);                   // dwFlags
+    avi_put_u16(p, 0);                   // wPriority
+    avi_put_u16(p, 0);                   // wLanguage
+    avi_put_u32(p, 0);                   // dwInitialFrames
+    avi_put_u32(p, 1);                   // dwScale
+    avi_put_u32(p, fps);                 // dwRate
+    avi_put_u32(p, 0);                   // dwStart
+    avi_put_u32(p, avi.frames);          // dwLength
+    avi_put_u32(p, avi.max_frame_size);  // dwSuggestedBufferSize
+    avi_put_u32(p, UINT32_MAX);          // dwQuality
+    avi_put_u32(p, 0);                   // dwSampleSize
+    avi_put_u16(p, 0);
+    avi_put_u16(p, 0);
+    avi_put_u16(p, avi.width);
+    avi_put_u16(p, avi.height);
+
+    avi_put_fourcc(p, "strf");
+    avi_put_u32(p, 40);
+    avi_put_u32(p, 40);  // biSize
+    avi_put_u32(p, avi.width);
+    avi_put_u32(p, avi.height);
+    avi_put_u16(p, 1);   // biPlanes
+    avi_put_u16(p, 24);  // biBitCount
+    avi_put_fourcc(p, "MJPG");
+    avi_put_u32(p, avi.width * avi.height * 3);
+    for (int i = 0; i < 4; i++) {
+        avi_put_u32(p, 0);
+    }
+
+    avi_put_fourcc(p, "LIST");
+    avi_put_u32(p, 4 + avi.movi_size);
+    avi_put_fourcc(p, "movi");
+}
+
+static bool avi_open(avi_writer_t& avi, const char* path, uint8_t fps)
+{
+    avi.file = aligned_file_fopen(path, RECORDER_WRITE_BUF_SIZE);
+    if (!avi.file) {
+        ESP_LOGE(TAG, "failed to open %s", path);
+        return false;
+    }
+
+    avi.width          = 0;
+    avi.height         = 0;
+    avi.fps            = fps;
+    avi.frames         = 0;
+    avi.movi_size      = 0;
+    avi.max_frame_size = 0;
+    avi.first_us       = 0;
+    avi.last_us        = 0;
+    avi.index.clear();
+
+    // Placeholder, rewritten with the final numbers on close
+    uint8_t hdr[AVI_HEADER_SIZE] = {0};
+    fwrite(hdr, 1, sizeof(hdr), avi.file);
+    return true;
+}
+
+static void avi_write_frame(avi_writer_t& avi, const recorder_job_t& job)
+{
+    if (!avi.file) {
+        return;
+    }
+    if (avi.frames == 0) {
+        avi.width    = job.width;
+        avi.height   = job.height;
+        avi.first_us = job.timestamp_us;
+    }
+
+    uint32_t padded = (job.out_size + 1) & ~1u;
+    uint8_t chunk_hdr[8];
+    uint8_t* p = chunk_hdr;
+    avi_put_fourcc(p, "00dc");
+    avi_put_u32(p, job.out_size);
+
+    avi.index.push_back(4 + avi.movi_size);
+    avi.index.push_back(job.out_size);
+
+    fwrite(chunk_hdr, 1, sizeof(chunk_hdr), avi.file);
+    fwrite(job.out, 1, padded, avi.file);
+
+    avi.movi_size += sizeof(chunk_hdr) + padded;
+    avi.max_frame_size = std::max(avi.max_frame_size, job.out_size);
+    avi.last_us        = job.timestamp_us;
+    avi.frames++;
+}
+
+static void avi_close(avi_writer_t& avi)
+{
+    if (!avi.file) {
+        return;
+    }
+
+    uint8_t entry[16];
+    uint8_t* p = entry;
+    avi_put_fourcc(p, "idx1");
+    avi_put_u32(p, avi.index.size() / 2 * 16);
+    fwrite(entry, 1, 8, avi.file);
+    for (size_t i = 0; i < avi.index.size(); i += 2) {
+        p = entry;
+        avi_put_fourcc(p, "00dc");
+        avi_put_u32(p, 0x10);  // AVIIF_KEYFRAME
+        avi_put_u32(p, avi.index[i]);
+        avi_put_u32(p, avi.index[i + 1]);
+        fwrite(entry, 1, sizeof(entry), avi.file);
+    }
+
+    uint32_t file_size = ftell(avi.file);
+    uint8_t hdr[AVI_HEADER_SIZE];
+    avi_build_header(hdr, avi, file_size - 8);
+    fseek(avi.file, 0, SEEK_SET);
+    fwrite(hdr, 1, sizeof(hdr), avi.file);
+    fclose(avi.file);
+    avi.file = NULL;
+
+    ESP_LOGI(TAG, "record closed: %" PRIu32 " frames, %" PRIu32 " bytes", avi.frames, file_size);
+    avi.index.clear();
+    avi.index.shrink_to_fit();
+}
+
+// Only the newest frame waits for the UVC task, one it did not take yet goes back to the pool
+static void camera_uvc_publish(const recorder_job_t& job)
+{
+    recorder_job_t stale;
+    if (xQueueReceive(queue_uvc_frame, &stale, 0) == pdPASS) {
+        xQueueSend(queue_jpeg_out_free, &stale.out, portMAX_DELAY);
+    }
+    if (!uvc_is_streaming.load(std::memory_order_acquire) || xQueueSend(queue_uvc_frame, &job, 0) != pdPASS) {
+        xQueueSend(queue_jpeg_out_free, &job.out, portMAX_DELAY);
+    }
+}
+
+static void camera_jpeg_task(void* arg)
+{
+    recorder_job_t job;
+    while (1) {
+        xQueueReceive(queue_jpeg_job, &job, portMAX_DELAY);
+
+        // A YUV420 capture goes in as the ISP wrote it, the encoder skips its own color conversion
+        bool is_raw               = job.pixel_format == EXAMPLE_VIDEO_FMT_RAW8;
+        bool is_yuv               = job.pixel_format == EXAMPLE_VIDEO_FMT_YUV420;
+        jpeg_encode_cfg_t enc_cfg = {
+            .height        = job.height,
+            .width         = job.width,
+            .src_type      = is_raw   ? JPEG_ENCODE_IN_FORMAT_GRAY
+                             : is_yuv ? JPEG_ENCODE_IN_FORMAT_YUV420
+                                      : JPEG_ENCODE_IN_FORMAT_RGB565,
+            .sub_sample    = is_raw ? JPEG_DOWN_SAMPLING_GRAY : JPEG_DOWN_SAMPLING_YUV420,
+            .image_quality = RECORDER_JPEG_QUALITY,
+        };
+        uint32_t in_size = is_raw ? job.width * job.height
+                           : is_yuv ? job.width * job.height * 3 / 2
+                                    : job.width * job.height * 2;
+        if (jpeg_encoder_process(jpeg_encoder, &enc_cfg, camera->buffer[job.v4l2_index], in_size, job.out,
+                                 RECORDER_OUT_BUF_SIZE, &job.out_size) != ESP_OK) {
+            ESP_LOGE(TAG, "jpeg encode failed");
+            job.out_size = 0;
+        }
+
+        camera_frame_release(job.v4l2_index);
+        jpeg_busy.store(false, std::memory_order_release);
+
+        if (job.out_size && job.type == RECORDER_JOB_UVC_FRAME) {
+            camera_uvc_publish(job);
+        } else if (job.out_size) {
+            xQueueSend(queue_recorder_writer, &job, portMAX_DELAY);
+        } else {
+            xQueueSend(queue_jpeg_out_free, &job.out, portMAX_DELAY);
+        }
+    }
+}
+
+static void camera_writer_task(void* arg)
+{
+    avi_writer_t avi;
+    avi.file = NULL;
+
+    recorder_job_t job;
+    while (1) {
+        xQueueReceive(queue_recorder_writer, &job, portMAX_DELAY);
+
+        switch (job.type) {
+            case RECORDER_JOB_SNAPSHOT: {
+                FILE* file = fopen(job.path, "wb");
+                if (file) {
+                    fwrite(job.out, 1, job.out_size, file);
+                    fclose(file);
+                    ESP_LOGI(TAG, "snapshot saved: %s (%" PRIu32 " bytes)", job.path, job.out_size);
+                } else {
+                    ESP_LOGE(TAG, "failed to open %s", job.path);
+                }
+                break;
+            }
+            case RECORDER_JOB_VIDEO_OPEN:
+                avi_close(avi);
+                avi_open(avi, job.path, job.fps);
+                break;
+            case RECORDER_JOB_VIDEO_FRAME:
+                avi_write_frame(avi, job);
+                break;
+            case RECORDER_JOB_VIDEO_CLOSE:
+                avi_close(avi);
+                break;
+            case RECORDER_JOB_UVC_FRAME:
+                // Goes to the UVC task, never to the writer
+                break;
+        }
+
+        if (job.out) {
+            xQueueSend(queue_jpeg_out_free, &job.out, portMAX_DELAY);
+        }
+    }
+}
+
+static bool camera_recorder_init()
+{
+    if (recorder_is_initial) {
+        return true;
+    }
+
+    jpeg_encode_engine_cfg_t engine_cfg = {
+        .intr_priority = 0,
+        .timeout_ms    = 100,
+    };
+    if (jpeg_new_encoder_engine(&engine_cfg, &jpeg_encoder) != ESP_OK) {
+        ESP_LOGE(TAG, "failed to create jpeg encoder");
+        return false;
+    }
+
+    queue_jpeg_job        = xQueueCreate(1, sizeof(recorder_job_t));
+    queue_jpeg_out_free   = xQueueCreate(RECORDER_OUT_BUF_COUNT, sizeof(uint8_t*));
+    queue_recorder_writer = xQueueCreate(RECORDER_OUT_BUF_COUNT + 2, sizeof(recorder_job_t));
+
+    jpeg_encode_memory_alloc_cfg_t mem_cfg = {
+        .buffer_direction = JPEG_ENC_ALLOC_OUTPUT_BUFFER,
+    };
+    for (int i = 0; i < RECORDER_OUT_BUF_COUNT; i++) {
+        size_t allocated = 0;
+        uint8_t* out     = (uint8_t*)jpeg_alloc_encoder_mem(RECORDER_OUT_BUF_SIZE, &mem_cfg, &allocated);
+        if (out == NULL) {
+            ESP_LOGE(TAG, "malloc for jpeg output %d failed", i);
+            continue;
+        }
+        xQueueSend(queue_jpeg_out_free, &out, 0);
+    }
+
+    xTaskCreatePinnedToCore(camera_jpeg_task, "cam_jpeg", 4 * 1024, NULL, 5, NULL, 0);
+    xTaskCreatePinnedToCore(camera_writer_task, "cam_wr", 6 * 1024, NULL, 3, NULL, 0);
+
+    recorder_is_initial = true;
+    return true;
+}
+
+// Called by a holder of the buffer; returns true if the recorder took a reference on it
+static bool camera_recorder_offer(int v4l2_index)
+{
+    if (!recorder_is_initial || jpeg_busy.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    recorder_job_t job = {};
+    int64_t now_us     = esp_timer_get_time();
+    {
+        std::lock_guard<std::mutex> lock(recorder_mutex);
+        if (snapshot_pending) {
+            job.type = RECORDER_JOB_SNAPSHOT;
+            strlcpy(job.path, snapshot_path, sizeof(job.path));
+        } else if (is_recording && now_us - record_last_us >= record_interval_us) {
+            job.type = RECORDER_JOB_VIDEO_FRAME;
+        } else if (uvc_is_enabled.load(std::memory_order_acquire) &&
+                   uvc_is_streaming.load(std::memory_order_acquire) && now_us - uvc_last_us >= uvc_interval_us) {
+            job.type = RECORDER_JOB_UVC_FRAME;
+        } else {
+            return false;
+        }
+
+        if (xQueueReceive(queue_jpeg_out_free, &job.out, 0) != pdPASS) {
+            if (job.type != RECORDER_JOB_UVC_FRAME) {
+                record_dropped++;
+            }
+            return false;
+        }
+
+        if (job.type == RECORDER_JOB_SNAPSHOT) {
+            snapshot_pending = false;
+        } else if (job.type == RECORDER_JOB_UVC_FRAME) {
+            uvc_last_us = now_us;
+        } else {
+            record_last_us = now_us;
+        }
+    }
+
+    job.v4l2_index   = v4l2_index;
+    job.width        = camera->width;
+    job.height       = camera->height;
+    job.pixel_format = camera->pixel_format;
+    job.timestamp_us = now_us;
+
+    camera_frame_ref(v4l2_index);
+    jpeg_busy.store(true, std::memory_order_release);
+    xQueueSend(queue_jpeg_job, &job, portMAX_DELAY);
+    return true;
+}
+
+static void camera_recorder_post(recorder_job_type_t type, const std::string& path, uint8_t fps)
+{
+    recorder_job_t job = {};
+    job.type           = type;
+    job.fps            = fps;
+    strlcpy(job.path, path.c_str(), sizeof(job.path));
+    xQueueSend(queue_recorder_writer, &job, portMAX_DELAY);
+}
+
+// Stop feeding the recorder and wait until it hands back any V4L2 buffer it still holds
+static void camera_recorder_detach()
+{
+    {
+        std::lock_guard<std::mutex> lock(recorder_mutex);
+        snapshot_pending = false;
+        if (is_recording) {
+            is_recording = false;
+            camera_recorder_post(RECORDER_JOB_VIDEO_CLOSE, "", 0);
+        }
+    }
+    while (jpeg_busy.load(std::memory_order_acquire)) {
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+}
+
+/* --------------------------------- RAW capture -------------------------------- */
+/*
+ * Bayer frames of a RAW8 capture, unprocessed, to DNG files.
+ * The requeue task, and the capture loop for the frames the preview drops, offer V4L2 buffers to the `cam_raw` task
+ * while it is idle and a ring slot is free. It copies the frame into a ring in PSRAM with the AXI GDMA and releases the
+ * buffer right away, so the sensor keeps its rate however slow the card is. The `cam_raw_wr` task writes the ring out
+ * behind it, frames that find the ring full are dropped. Developing reads the DNG back from the card on a task below
+ * everything else, so it only runs in idle time.
+ */
+#define RAW_RING_MAX          16
+#define RAW_DEVELOP_QUEUE_LEN 32
+#define RAW_DEVELOP_IDLE_MS   1000  // The develop task exits once the capture is stopped and nothing is queued
+
+/* DNG: little endian TIFF, one IFD, the raw strip right after a fixed 512 byte header */
+#define DNG_HEADER_SIZE  512
+#define DNG_ENTRY_COUNT  21
+#define DNG_MODEL        "M5Stack Tab5"
+#define DNG_MODEL_AT     (8 + 2 + DNG_ENTRY_COUNT * 12 + 4)
+#define DNG_MATRIX_AT    (DNG_MODEL_AT + 14)
+#define DNG_NEUTRAL_AT   (DNG_MATRIX_AT + 9 * 8)
+#define DNG_NEUTRAL_UNIT 1000000
+static_assert(sizeof(DNG_MODEL) <= DNG_MATRIX_AT - DNG_MODEL_AT, "DNG model does not fit");
+static_assert(DNG_NEUTRAL_AT + 3 * 8 <= DNG_HEADER_SIZE, "DNG header does not fit");
+
+typedef struct {
+    int v4l2_index;
+    uint8_t slot;
+    uint32_t sequence;
+    uint32_t width;
+    uint32_t height;
+    float red_gain;
+    float blue_gain;
+} raw_frame_t;
+
+static std::mutex raw_mutex;  // Guards start and stop
+static bool raw_is_initial         = false;
+static bool raw_is_started         = false;
+static bool raw_develop_is_running = false;
+static std::atomic<bool> raw_is_active{false};
+static std::atomic<bool> raw_busy{false};
+static hal::HalBase::CameraRawCaptureConfig_t raw_config;
+static char raw_directory[RECORDER_PATH_MAX];
+static uint8_t* raw_slots[RAW_RING_MAX] = {NULL};
+static uint8_t raw_slot_count           = 0;
+static uint32_t raw_slot_size           = 0;
+static uint32_t raw_sequence            = 0;  // Owned by whoever holds raw_busy
+static std::atomic<uint32_t> raw_captured{0};
+static std::atomic<uint32_t> raw_written{0};
+static std::atomic<uint32_t> raw_dropped{0};
+static std::atomic<uint32_t> raw_developed{0};
+
+static async_memcpy_handle_t raw_mcp   = NULL;
+static SemaphoreHandle_t sem_raw_copy  = NULL;
+static QueueHandle_t queue_raw_job     = NULL;
+static QueueHandle_t queue_raw_free    = NULL;
+static QueueHandle_t queue_raw_write   = NULL;
+static QueueHandle_t queue_raw_develop = NULL;
+
+static inline void dng_put_entry(uint8_t*& p, uint16_t tag, uint16_t type, uint32_t count, uint32_t value)
+{
+    avi_put_u16(p, tag);
+    avi_put_u16(p, type);
+    avi_put_u32(p, count);
+    avi_put_u32(p, value);
+}
+
+static void dng_build_header(uint8_t* hdr, const raw_frame_t& frame)
+{
+    enum { BYTE = 1, ASCII = 2, SHORT = 3, LONG = 4, RATIONAL = 5, SRATIONAL = 10 };
+
+    memset(hdr, 0, DNG_HEADER_SIZE);
+    uint8_t* p = hdr;
+    avi_put_fourcc(p, "II*");
+    avi_put_u32(p, 8);
+    avi_put_u16(p, DNG_ENTRY_COUNT);
+
+    // Entries in tag order, values of 4 bytes or less are stored in place
+    dng_put_entry(p, 254, LONG, 1, 0);                                // NewSubFileType, main image
+    dng_put_entry(p, 256, LONG, 1, frame.width);                      // ImageWidth
+    dng_put_entry(p, 257, LONG, 1, frame.height);                     // ImageLength
+    dng_put_entry(p, 258, SHORT, 1, 8);                               // BitsPerSample
+    dng_put_entry(p, 259, SHORT, 1, 1);                               // Compression, none
+    dng_put_entry(p, 262, SHORT, 1, 32803);                           // PhotometricInterpretation, CFA
+    dng_put_entry(p, 273, LONG, 1, DNG_HEADER_SIZE);                  // StripOffsets
+    dng_put_entry(p, 277, SHORT, 1, 1);                               // SamplesPerPixel
+    dng_put_entry(p, 278, LONG, 1, frame.height);                     // RowsPerStrip
+    dng_put_entry(p, 279, LONG, 1, frame.width * frame.height);       // StripByteCounts
+    dng_put_entry(p, 284, SHORT, 1, 1);                               // PlanarConfiguration
+    dng_put_entry(p, 33421, SHORT, 2, 2 | (2 << 16));                 // CFARepeatPatternDim, 2x2
+    dng_put_entry(p, 33422, BYTE, 4, 2 | (1 << 8) | (1 << 16));       // CFAPattern, B G G R
+    dng_put_entry(p, 50706, BYTE, 4, 1 | (4 << 8));                   // DNGVersion, 1.4
+    dng_put_entry(p, 50707, BYTE, 4, 1 | (1 << 8));                   // DNGBackwardVersion, 1.1
+    dng_put_entry(p, 50708, ASCII, sizeof(DNG_MODEL), DNG_MODEL_AT);  // UniqueCameraModel
+    dng_put_entry(p, 50714, LONG, 1, 0);                              // BlackLevel
+    dng_put_entry(p, 50717, LONG, 1, 255);                            // WhiteLevel
+    dng_put_entry(p, 50721, SRATIONAL, 9, DNG_MATRIX_AT);             // ColorMatrix1
+    dng_put_entry(p, 50728, RATIONAL, 3, DNG_NEUTRAL_AT);             // AsShotNeutral
+    dng_put_entry(p, 50778, SHORT, 1, 21);                            // CalibrationIlluminant1, D65
+    avi_put_u32(p, 0);
+
+    memcpy(hdr + DNG_MODEL_AT, DNG_MODEL, sizeof(DNG_MODEL));
+
+    // The sensor has no calibration, an identity matrix keeps readers working and the color comes from the neutral
+    p = hdr + DNG_MATRIX_AT;
+    for (int i = 0; i < 9; i++) {
+        avi_put_u32(p, i % 4 == 0 ? 1 : 0);
+        avi_put_u32(p, 1);
+    }
+
+    // The white balance the IPA had at the frame, as the camera neutral
+    p              = hdr + DNG_NEUTRAL_AT;
+    float gains[3] = {frame.red_gain, 1.0f, frame.blue_gain};
+    for (float gain : gains) {
+        avi_put_u32(p, gain > 0.0f ? std::lround(DNG_NEUTRAL_UNIT / gain) : DNG_NEUTRAL_UNIT);
+        avi_put_u32(p, DNG_NEUTRAL_UNIT);
+    }
+}
+
+// Only reads back what dng_build_header() writes
+static bool dng_parse_header(const uint8_t* hdr, uint32_t* width, uint32_t* height, uint32_t* offset, float gains[3])
+{
+    uint32_t ifd;
+    uint16_t count;
+    if (memcmp(hdr, "II*\0", 4) != 0) {
+        return false;
+    }
+    memcpy(&ifd, hdr + 4, 4);
+    if (ifd + 2 > DNG_HEADER_SIZE) {
+        return false;
+    }
+    memcpy(&count, hdr + ifd, 2);
+
+    *width = *height = *offset = 0;
+    gains[0] = gains[1] = gains[2] = 1.0f;
+    for (uint16_t i = 0; i < count && ifd + 2 + (i + 1) * 12 <= DNG_HEADER_SIZE; i++) {
+        const uint8_t* entry = hdr + ifd + 2 + i * 12;
+        uint16_t tag;
+        uint32_t value;
+        memcpy(&tag, entry, 2);
+        memcpy(&value, entry + 8, 4);
+        if (tag == 256) {
+            *width = value;
+        } else if (tag == 257) {
+            *height = value;
+        } else if (tag == 273) {
+            *offset = value;
+        } else if (tag == 50728 && value + 3 * 8 <= DNG_HEADER_SIZE) {
+            for (int c = 0; c < 3; c++) {
+                uint32_t num, den;
+                memcpy(&num, hdr + value + c * 8, 4);
+                memcpy(&den, hdr + value + c * 8 + 4, 4);
+                gains[c] = num ? (float)den / num : 1.0f;
+            }
+        }
+    }
+    return *width >= 2 && *height >= 2 && *offset;
+}
+
+// Bilinear demosaic of a BGGR frame to RGB565, the LUTs carry the white balance and the gamma of each channel
+static void raw_demosaic_bggr(const uint8_t* raw, uint32_t w, uint32_t h, uint16_t* dst, const uint16_t lut[3][256])
+{
+    for (uint32_t y = 0; y < h; y++) {
+        // Edges mirror across the border, which keeps the Bayer phase of the neighbours
+        const uint8_t* up  = raw + (y ? y - 1 : 1) * w;
+        const uint8_t* row = raw + y * w;
+        const uint8_t* dn  = raw + (y + 1 < h ? y + 1 : y - 1) * w;
+        bool is_blue_row   = (y & 1) == 0;
+        for (uint32_t x = 0; x < w; x++) {
+            uint32_t l     = x ? x - 1 : 1;
+            uint32_t r     = x + 1 < w ? x + 1 : x - 1;
+            uint32_t c     = row[x];
+            uint32_t cross = (up[x] + dn[x] + row[l] + row[r] + 2) >> 2;
+            uint32_t diag  = (up[l] + up[r] + dn[l] + dn[r] + 2) >> 2;
+            uint32_t horiz = (row[l] + row[r] + 1) >> 1;
+            uint32_t vert  = (up[x] + dn[x] + 1) >> 1;
+            uint32_t red, green, blue;
+            if (is_blue_row && (x & 1) == 0) {
+                red   = diag;
+                green = cross;
+                blue  = c;
+            } else if (is_blue_row) {
+                red   = vert;
+                green = c;
+                blue  = horiz;
+            } else if ((x & 1) == 0) {
+                red   = horiz;
+                green = c;
+                blue  = vert;
+            } else {
+                red   = c;
+                green = cross;
+                blue  = diag;
+            }
+            dst[y * w + x] = lut[0][red] | lut[1][green] | lut[2][blue];
+        }
+    }
+}
+
+// DNG to a JPEG next to it, with the hardware encoder the recorder set up
+static bool camera_raw_develop(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        ESP_LOGE(TAG, "failed to open %s", path);
+        return false;
+    }
+
+    uint8_t hdr[DNG_HEADER_SIZE];
+    uint32_t width, height, offset;
+    float gains[3];
+    if (fread(hdr, 1, sizeof(hdr), file) != sizeof(hdr) || !dng_parse_header(hdr, &width, &height, &offset, gains)) {
+        ESP_LOGE(TAG, "%s is not a raw capture", path);
+        fclose(file);
+        return false;
+    }
+
+    jpeg_encode_memory_alloc_cfg_t in_cfg  = {.buffer_direction = JPEG_ENC_ALLOC_INPUT_BUFFER};
+    jpeg_encode_memory_alloc_cfg_t out_cfg = {.buffer_direction = JPEG_ENC_ALLOC_OUTPUT_BUFFER};
+    size_t allocated                       = 0;
+
+    uint32_t size     = width * height;
+    uint8_t* raw      = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+    uint16_t* rgb     = (uint16_t*)jpeg_alloc_encoder_mem(size * 2, &in_cfg, &allocated);
+    uint8_t* out      = (uint8_t*)jpeg_alloc_encoder_mem(RECORDER_OUT_BUF_SIZE, &out_cfg, &allocated);
+    uint32_t out_size = 0;
+    bool is_ok = raw && rgb && out && fseek(file, offset, SEEK_SET) == 0 && fread(raw, 1, size, file) == size;
+    fclose(file);
+
+    if (is_ok) {
+        // Linear sensor values, white balanced, to sRGB-ish gamma 2.2 in the 5-6-5 layout
+        static uint16_t lut[3][256];
+        const int shift[3] = {11, 5, 0};
+        const int max[3]   = {31, 63, 31};
+        for (int c = 0; c < 3; c++) {
+            for (int v = 0; v < 256; v++) {
+                float linear = std::min(v / 255.0f * gains[c], 1.0f);
+                lut[c][v]    = std::lround(std::pow(linear, 1.0f / 2.2f) * max[c]) << shift[c];
+            }
+        }
+        raw_demosaic_bggr(raw, width, height, rgb, lut);
+
+        jpeg_encode_cfg_t enc_cfg = {
+            .height        = height,
+            .width         = width,
+            .src_type      = JPEG_ENCODE_IN_FORMAT_RGB565,
+            .sub_sample    = JPEG_DOWN_SAMPLING_YUV420,
+            .image_quality = RECORDER_JPEG_QUALITY,
+        };
+        is_ok = jpeg_encoder_process(jpeg_encoder, &enc_cfg, (uint8_t*)rgb, size * 2, out, RECORDER_OUT_BUF_SIZE,
+                                     &out_size) == ESP_OK;
+    }
+
+    if (is_ok) {
+        std::string jpg_path = path;
+        jpg_path.replace(jpg_path.size() - 4, 4, ".jpg");
+        file  = fopen(jpg_path.c_str(), "wb");
+        is_ok = file && fwrite(out, 1, out_size, file) == out_size;
+        if (file) {
+            is_ok = fclose(file) == 0 && is_ok;
+        }
+    }
+    if (!is_ok) {
+        ESP_LOGE(TAG, "failed to develop %s", path);
+    }
+
+    heap_caps_free(raw);
+    heap_caps_free(rgb);
+    heap_caps_free(out);
+    return is_ok;
+}
+
+static void camera_raw_develop_task(void* arg)
+{
+    char path[RECORDER_PATH_MAX];
+    while (1) {
+        if (xQueueReceive(queue_raw_develop, path, pdMS_TO_TICKS(RAW_DEVELOP_IDLE_MS)) != pdPASS) {
+            std::lock_guard<std::mutex> lock(raw_mutex);
+            if (!raw_is_started && uxQueueMessagesWaiting(queue_raw_develop) == 0) {
+                raw_develop_is_running = false;
+                break;
+            }
+            continue;
+        }
+        if (camera_raw_develop(path)) {
+            raw_developed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    vTaskDelete(NULL);
+}
+
+static bool camera_raw_copy_done_cb(async_memcpy_handle_t mcp, async_memcpy_event_t* event, void* cb_args)
+{
+    BaseType_t high_task_wakeup = pdFALSE;
+    xSemaphoreGiveFromISR(sem_raw_copy, &high_task_wakeup);
+    return high_task_wakeup == pdTRUE;
+}
+
+static void camera_raw_task(void* arg)
+{
+    raw_frame_t frame;
+    while (1) {
+        xQueueReceive(queue_raw_job, &frame, portMAX_DELAY);
+
+        // The CPU copies when the GDMA does not take the buffers, e.g. a frame size off its burst alignment
+        uint8_t* src  = camera->buffer[frame.v4l2_index];
+        uint8_t* dst  = raw_slots[frame.slot];
+        uint32_t size = frame.width * frame.height;
+        bool is_copied = false;
+        if (raw_mcp) {
+            // Only the lines of the frame are synced, not the whole slot
+            dma_buffer_begin_device(dst, 0, size, DMA_BUFFER_DIR_FROM_DEVICE);
+            is_copied = esp_async_memcpy(raw_mcp, dst, src, size, camera_raw_copy_done_cb, NULL) == ESP_OK;
+            if (is_copied) {
+                xSemaphoreTake(sem_raw_copy, portMAX_DELAY);
+            }
+            dma_buffer_end_device(dst);
+        }
+        if (!is_copied) {
+            memcpy(dst, src, size);
+        }
+
+        camera_frame_release(frame.v4l2_index);
+        raw_busy.store(false, std::memory_order_release);
+
+        esp_video_isp_state_t state;
+        if (esp_video_isp_pipeline_get_state(&state) == ESP_OK) {
+            frame.red_gain  = state.red_gain;
+            frame.blue_gain = state.blue_gain;
+        }
+        raw_captured.fetch_add(1, std::memory_order_relaxed);
+        xQueueSend(queue_raw_write, &frame, portMAX_DELAY);
+    }
+}
+
+static void camera_raw_writer_task(void* arg)
+{
+    uint8_t hdr[DNG_HEADER_SIZE];
+    char path[RECORDER_PATH_MAX];
+    raw_frame_t frame;
+    while (1) {
+        xQueueReceive(queue_raw_write, &frame, portMAX_DELAY);
+
+        snprintf(path, sizeof(path), "%s/RAW_%05" PRIu32 ".dng", raw_directory, frame.sequence);
+        uint32_t size = frame.width * frame.height;
+        FILE* file    = aligned_file_fopen(path);
+        bool is_ok    = file != NULL;
+        if (is_ok) {
+            dng_build_header(hdr, frame);
+            is_ok = fwrite(hdr, 1, sizeof(hdr), file) == sizeof(hdr) &&
+                    fwrite(raw_slots[frame.slot], 1, size, file) == size;
+            is_ok = fclose(file) == 0 && is_ok;
+        }
+
+        if (is_ok) {
+            raw_written.fetch_add(1, std::memory_order_relaxed);
+            if (raw_config.develop && xQueueSend(queue_raw_develop, path, 0) != pdPASS) {
+                ESP_LOGW(TAG, "develop queue full, %s left raw", path);
+            }
+        } else {
+            ESP_LOGE(TAG, "failed to write %s", path);
+        }
+        xQueueSend(queue_raw_free, &frame.slot, portMAX_DELAY);
+    }
+}
+
+static bool camera_raw_init()
+{
+    if (raw_is_initial) {
+        return true;
+    }
+
+    // Without the GDMA the frames are copied by the CPU, slower but still off the capture path
+    async_memcpy_config_t mcp_cfg = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    mcp_cfg.backlog               = 1;
+    mcp_cfg.dma_burst_size        = 64;
+    if (esp_async_memcpy_install_gdma_axi(&mcp_cfg, &raw_mcp) != ESP_OK) {
+        ESP_LOGW(TAG, "no async memcpy, raw frames are copied by the CPU");
+        raw_mcp = NULL;
+    }
+
+    sem_raw_copy      = xSemaphoreCreateBinary();
+    queue_raw_job     = xQueueCreate(1, sizeof(raw_frame_t));
+    queue_raw_free    = xQueueCreate(RAW_RING_MAX, sizeof(uint8_t));
+    queue_raw_write   = xQueueCreate(RAW_RING_MAX, sizeof(raw_frame_t));
+    queue_raw_develop = xQueueCreate(RAW_DEVELOP_QUEUE_LEN, RECORDER_PATH_MAX);
+
+    xTaskCreatePinnedToCore(camera_raw_task, "cam_raw", 3 * 1024, NULL, 5, NULL, 0);
+    xTaskCreatePinnedToCore(camera_raw_writer_task, "cam_raw_wr", 4 * 1024, NULL, 3, NULL, 0);
+
+    raw_is_initial = true;
+    return true;
+}
+
+// Called from the requeue task and the capture loop; returns true if the RAW capture took a reference on the buffer
+static bool camera_raw_offer(int v4l2_index)
+{
+    bool expected = false;
+    if (!raw_is_active.load(std::memory_order_acquire) ||
+        !raw_busy.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        return false;
+    }
+
+    raw_frame_t frame = {};
+    if (camera->pixel_format != EXAMPLE_VIDEO_FMT_RAW8 || camera->width * camera->height > raw_slot_size ||
+        xQueueReceive(queue_raw_free, &frame.slot, 0) != pdPASS) {
+        raw_dropped.fetch_add(1, std::memory_order_relaxed);
+        raw_busy.store(false, std::memory_order_release);
+        return false;
+    }
+
+    frame.v4l2_index = v4l2_index;
+    frame.sequence   = raw_sequence++;
+    frame.width      = camera->width;
+    frame.height     = camera->height;
+    frame.red_gain   = 1.0f;
+    frame.blue_gain  = 1.0f;
+    if (raw_config.maxFrames && raw_sequence >= raw_config.maxFrames) {
+        raw_is_active.store(false, std::memory_order_release);
+    }
+    camera_frame_ref(v4l2_index);
+    xQueueSend(queue_raw_job, &frame, portMAX_DELAY);
+    return true;
+}
+
+// Wait until the RAW capture hands back any V4L2 buffer it still holds
+static void camera_raw_detach()
+{
+    while (raw_busy.load(std::memory_order_acquire)) {
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+}
+
+/* -------------------------------- H.264 stream -------------------------------- */
+/*
+ * H.264 over chunked HTTP.
+ * Works like the recorder: the `cam_h264` task borrows a V4L2 buffer while the encoder is idle and a client is
+ * connected, encodes it with the hardware encoder and releases it. The encoder output buffer itself is handed to the
+ * HTTP handler, which sends it straight from that buffer and returns it to the pool.
+ * The hardware encoder only takes the ISP's YUV420 layout, so streaming needs a YUV420 capture.
+ */
+#define H264_OUT_BUF_COUNT 2
+#define H264_OUT_BUF_SIZE  (256 * 1024)
+#define H264_BITRATE       (2 * 1024 * 1024)
+#define H264_GOP           30
+
+typedef struct {
+    uint8_t* data;
+    uint32_t size;
+} h264_frame_t;
+
+static bool h264_is_initial = false;
+static std::atomic<bool> h264_busy{false};
+static std::atomic<bool> h264_client_active{false};
+static std::atomic<uint32_t> h264_session{0};
+static QueueHandle_t queue_h264_job      = NULL;
+static QueueHandle_t queue_h264_out_free = NULL;
+static QueueHandle_t queue_h264_out      = NULL;
+
+static void camera_h264_task(void* arg)
+{
+    esp_h264_enc_handle_t encoder = NULL;
+    uint32_t encoder_session      = 0;
+    uint32_t encoder_width        = 0;
+    uint32_t encoder_height       = 0;
+
+    int v4l2_index = 0;
+    while (1) {
+        xQueueReceive(queue_h264_job, &v4l2_index, portMAX_DELAY);
+
+        // A new client or a new capture size gets a fresh encoder, so the stream starts on an IDR frame
+        uint32_t session = h264_session.load(std::memory_order_acquire);
+        if (encoder &&
+            (session != encoder_session || encoder_width != camera->width || encoder_height != camera->height)) {
+            esp_h264_enc_close(encoder);
+            esp_h264_enc_del(encoder);
+            encoder = NULL;
+        }
+        if (!encoder) {
+            esp_h264_enc_cfg_hw_t config = {.pic_type = ESP_H264_RAW_FMT_O_UYY_E_VYY,
+                                            .gop      = H264_GOP,
+                                            .fps      = camera_config.fps,
+                                            .res      = {.width = (uint16_t)camera->width,
+                                                         .height = (uint16_t)camera->height},
+                                            .rc       = {.bitrate = H264_BITRATE, .qp_min = 25, .qp_max = 35}};
+            if (esp_h264_enc_hw_new(&config, &encoder) != ESP_H264_ERR_OK ||
+                esp_h264_enc_open(encoder) != ESP_H264_ERR_OK) {
+                ESP_LOGE(TAG, "failed to create h264 encoder");
+                if (encoder) {
+                    esp_h264_enc_del(encoder);
+                    encoder = NULL;
+                }
+            }
+            encoder_session = session;
+            encoder_width   = camera->width;
+            encoder_height  = camera->height;
+        }
+
+        h264_frame_t frame = {};
+        xQueueReceive(queue_h264_out_free, &frame.data, 0);
+        if (encoder && frame.data) {
+            esp_h264_enc_in_frame_t in_frame   = {.raw_data = {
+                                                    .buffer = camera->buffer[v4l2_index],
+                                                    .len    = camera->width * camera->height * 3 / 2,
+                                                }};
+            esp_h264_enc_out_frame_t out_frame = {.raw_data = {
+                                                      .buffer = frame.data,
+                                                      .len    = H264_OUT_BUF_SIZE,
+                                                  }};
+            if (esp_h264_enc_process(encoder, &in_frame, &out_frame) == ESP_H264_ERR_OK) {
+                frame.size = out_frame.length;
+            }
+        }
+
+        camera_frame_release(v4l2_index);
+        h264_busy.store(false, std::memory_order_release);
+
+        if (frame.data) {
+            if (frame.size && h264_client_active.load(std::memory_order_acquire)) {
+                xQueueSend(queue_h264_out, &frame, portMAX_DELAY);
+            } else {
+                xQueueSend(queue_h264_out_free, &frame.data, portMAX_DELAY);
+            }
+        }
+    }
+}
+
+static bool camera_h264_init()
+{
+    if (h264_is_initial) {
+        return true;
+    }
+
+    queue_h264_job      = xQueueCreate(1, sizeof(int));
+    queue_h264_out_free = xQueueCreate(H264_OUT_BUF_COUNT, sizeof(uint8_t*));
+    queue_h264_out      = xQueueCreate(H264_OUT_BUF_COUNT, sizeof(h264_frame_t));
+    for (int i = 0; i < H264_OUT_BUF_COUNT; i++) {
+        uint8_t* out = (uint8_t*)dma_buffer_calloc(H264_OUT_BUF_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA);
+        if (out == NULL) {
+            ESP_LOGE(TAG, "malloc for h264 output %d failed", i);
+            continue;
+        }
+        xQueueSend(queue_h264_out_free, &out, 0);
+    }
+
+    xTaskCreatePinnedToCore(camera_h264_task, "cam_h264", 4 * 1024, NULL, 5, NULL, 0);
+
+    h264_is_initial = true;
+    return true;
+}
+
+// Called by a holder of the buffer; returns true if the encoder took a reference on it
+static bool camera_h264_offer(int v4l2_index)
+{
+    if (!h264_is_initial || !h264_client_active.load(std::memory_order_acquire) ||
+        camera->pixel_format != EXAMPLE_VIDEO_FMT_YUV420 || h264_busy.load(std::memory_order_acquire) ||
+        uxQueueMessagesWaiting(queue_h264_out_free) == 0) {
+        return false;
+    }
+
+    camera_frame_ref(v4l2_index);
+    h264_busy.store(true, std::memory_order_release);
+    xQueueSend(queue_h264_job, &v4l2_index, portMAX_DELAY);
+    return true;
+}
+
+static void camera_h264_detach()
+{
+    while (h264_busy.load(std::memory_order_acquire)) {
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+}
+
+static bool camera_is_capturing_locked()
+{
+    std::lock_guard<std::mutex> lock(camera_mutex);
+    return is_camera_capturing;
+}
+
+/* --------------------------------- UVC webcam --------------------------------- */
+/*
+ * USB webcam through the UVC class of TinyUSB.
+ * While the host has the stream open, the requeue task offers V4L2 buffers to the `cam_jpeg` task as UVC jobs, paced
+ * to the frame interval the host asked for. The encoder output buffer is handed to the UVC task as the frame itself
+ * and goes back to the pool from fb_return_cb, so no frame is copied between the JPEG engine and the USB stack.
+ * TinyUSB cannot be uninstalled, once started the camera stays enumerated and stopping only withholds frames.
+ */
+#define UVC_XFER_BUF_SIZE    RECORDER_OUT_BUF_SIZE
+#define UVC_FRAME_TIMEOUT_MS 200
+
+static bool uvc_is_initial = false;
+static uvc_fb_t uvc_fb;
+// Frame held by the UVC task between fb_get_cb and fb_return_cb
+static recorder_job_t uvc_job;
+
+static esp_err_t camera_uvc_start_cb(uvc_format_t format, int width, int height, int rate, void* cb_ctx)
+{
+    mclog::tagInfo(TAG, "uvc stream on, {}x{} @ {}fps", width, height, rate);
+    if (format != UVC_FORMAT_JPEG) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    if (camera_is_capturing_locked() && camera &&
+        (camera->width != (uint32_t)width || camera->height != (uint32_t)height)) {
+        mclog::tagWarn(TAG, "capture is {}x{}, not the size the host asked for", camera->width, camera->height);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(recorder_mutex);
+        uvc_interval_us = 1000000 / std::max(rate, 1);
+        uvc_last_us     = 0;
+    }
+    uvc_is_streaming.store(true, std::memory_order_release);
+    return ESP_OK;
+}
+
+static uvc_fb_t* camera_uvc_fb_get_cb(void* cb_ctx)
+{
+    // The UVC task paces itself on this call, so it waits here for the next encoded frame
+    if (xQueueReceive(queue_uvc_frame, &uvc_job, pdMS_TO_TICKS(UVC_FRAME_TIMEOUT_MS)) != pdPASS) {
+        return NULL;
+    }
+    uvc_fb.buf               = uvc_job.out;
+    uvc_fb.len               = uvc_job.out_size;
+    uvc_fb.width             = uvc_job.width;
+    uvc_fb.height            = uvc_job.height;
+    uvc_fb.format            = UVC_FORMAT_JPEG;
+    uvc_fb.timestamp.tv_sec  = uvc_job.timestamp_us / 1000000;
+    uvc_fb.timestamp.tv_usec = uvc_job.timestamp_us % 1000000;
+    return &uvc_fb;
+}
+
+static void camera_uvc_fb_return_cb(uvc_fb_t* fb, void* cb_ctx)
+{
+    xQueueSend(queue_jpeg_out_free, &uvc_job.out, portMAX_DELAY);
+}
+
+static void camera_uvc_stop_cb(void* cb_ctx)
+{
+    mclog::tagInfo(TAG, "uvc stream off");
+    uvc_is_streaming.store(false, std::memory_order_release);
+    recorder_job_t job;
+    while (xQueueReceive(queue_uvc_frame, &job, 0) == pdPASS) {
+        xQueueSend(queue_jpeg_out_free, &job.out, portMAX_DELAY);
+    }
+}
+
+static bool camera_uvc_init()
+{
+    if (uvc_is_initial) {
+        return true;
+    }
+    if (!camera_recorder_init()) {
+        return false;
+    }
+
+    // TinyUSB sends each frame from this buffer, it has to hold the largest JPEG the encoder can write
+    uint8_t* xfer_buf = (uint8_t*)dma_buffer_calloc(UVC_XFER_BUF_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA);
+    if (xfer_buf == NULL) {
+        ESP_LOGE(TAG, "malloc for uvc transfer buffer failed");
+        return false;
+    }
+    queue_uvc_frame = xQueueCreate(1, sizeof(recorder_job_t));
+
+    uvc_device_config_t config = {};
+    config.uvc_buffer          = xfer_buf;
+    config.uvc_buffer_size     = UVC_XFER_BUF_SIZE;
+    config.start_cb            = camera_uvc_start_cb;
+    config.fb_get_cb           = camera_uvc_fb_get_cb;
+    config.fb_return_cb        = camera_uvc_fb_return_cb;
+    config.stop_cb             = camera_uvc_stop_cb;
+    config.cb_ctx              = NULL;
+    if (uvc_device_config(0, &config) != ESP_OK || uvc_device_init() != ESP_OK) {
+        ESP_LOGE(TAG, "failed to init uvc device");
+        vQueueDelete(queue_uvc_frame);
+        queue_uvc_frame = NULL;
+        dma_buffer_free(xfer_buf);
+        return false;
+    }
+
+    uvc_is_initial = true;
+    return true;
+}
+
+// GET /stream.h264, registered on the streaming server in hal_wifi.cpp
+esp_err_t camera_h264_stream_handler(httpd_req_t* req)
+{
+    if (!camera_is_capturing_locked() || camera_config.pixelFormat != hal::HalBase::CAMERA_PIXEL_FORMAT_YUV420) {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "camera is not capturing YUV420");
+        return ESP_FAIL;
+    }
+    if (!camera_h264_init()) {
+        httpd_resp_send_500(req);
+        return ESP_FAIL;
+    }
+    bool expected = false;
+    if (!h264_client_active.compare_exchange_strong(expected, true)) {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "stream is busy");
+        return ESP_FAIL;
+    }
+
+    mclog::tagInfo(TAG, "h264 client connected");
+    h264_session.fetch_add(1, std::memory_order_acq_rel);
+    httpd_resp_set_type(req, "video/h264");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+
+    h264_frame_t frame;
+    while (1) {
+        if (xQueueReceive(queue_h264_out, &frame, pdMS_TO_TICKS(1000)) != pdPASS) {
+            if (!camera_is_capturing_locked()) {
+                break;
+            }
+            continue;
+        }
+        esp_err_t ret = httpd_resp_send_chunk(req, (const char*)frame.data, frame.size);
+        xQueueSend(queue_h264_out_free, &frame.data, portMAX_DELAY);
+        if (ret != ESP_OK) {
+            break;
+        }
+    }
+
+    h264_client_active.store(false, std::memory_order_release);
+    while (xQueueReceive(queue_h264_out, &frame, 0) == pdPASS) {
+        xQueueSend(queue_h264_out_free, &frame.data, portMAX_DELAY);
+    }
+    httpd_resp_send_chunk(req, NULL, 0);
+    mclog::tagInfo(TAG, "h264 client disconnected");
+    return ESP_OK;
+}
+
+/* -------------------------------- Inference -------------------------------- */
+/*
+ * Detector frames.
+ * The capture task scales the shown block once more into a small back slot with a blocking pass on its own PPA client,
+ * then swaps it with `infer_middle` like the presentation ring, so the `cam_ai` task always picks up the newest frame
+ * and a slow detector only skips frames. Results stay in inference frame pixels and the requeue task draws them on
+ * every preview frame until the next run replaces them.
+ */
+#define CAMERA_INFER_SLOT_NUM   3
+#define CAMERA_INFER_SLOT_MASK  0x03
+#define CAMERA_INFER_SLOT_FRESH 0x04
+
+static std::mutex camera_infer_mutex;  // Guards the PPA client and the slots against start and stop
+static std::atomic<bool> camera_infer_is_active{false};
+static hal::HalBase::CameraInferenceConfig_t camera_infer_config;
+static hal::HalBase::CameraDetector_t camera_infer_detector;
+static hal::HalBase::CameraDetectionCallback_t camera_infer_callback;
+static TaskController_t camera_infer_task;
+static SemaphoreHandle_t sem_infer_frame            = NULL;
+static ppa_client_handle_t camera_infer_ppa         = NULL;
+static uint32_t infer_slot_size                     = 0;
+static uint16_t* infer_slots[CAMERA_INFER_SLOT_NUM] = {NULL};
+static uint16_t infer_slot_w[CAMERA_INFER_SLOT_NUM];
+static uint16_t infer_slot_h[CAMERA_INFER_SLOT_NUM];
+static std::atomic<uint8_t> infer_middle{1};
+static uint8_t infer_front      = 0;  // Owned by the inference task
+static uint8_t infer_back       = 2;  // Owned by the capture task
+static int64_t infer_offered_us = 0;
+static std::atomic<float> camera_infer_fps{0.0f};
+
+static std::mutex camera_detections_mutex;
+static std::vector<hal::HalBase::CameraDetection_t> camera_detections;
+static uint16_t camera_detections_w = 0;  // Inference frame the detections are in
+static uint16_t camera_detections_h = 0;
+
+/**
+ * @brief Capture task side, scale the block of a sensor frame into the back slot and publish it.
+ *        Blocking, so it is done before the preview transaction is submitted and the buffer can be requeued.
+ */
+static void camera_infer_offer(const uint8_t* src, ppa_srm_color_mode_t in_cm, int64_t now_us)
+{
+    if (!camera_infer_is_active.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(camera_infer_mutex, std::try_to_lock);
+    if (!lock.owns_lock() || !camera_infer_ppa) {
+        return;
+    }
+    if (camera_infer_config.maxFps && now_us - infer_offered_us < 1000000 / camera_infer_config.maxFps) {
+        return;
+    }
+
+    // Largest 1/16 step that fits the block in the inference size
+    const camera_transform_t& t = camera_transform;
+    float scale                 = std::min((float)camera_infer_config.maxWidth / t.block_w,
+                                           (float)camera_infer_config.maxHeight / t.block_h);
+    scale                       = std::min(std::floor(scale * CAMERA_SCALE_FRAG) / CAMERA_SCALE_FRAG, 1.0f);
+    if (scale < 1.0f / CAMERA_SCALE_FRAG) {
+        return;
+    }
+    uint16_t out_w              = t.block_w * scale;
+    uint16_t out_h              = t.block_h * scale;
+
+    ppa_srm_oper_config_t srm_config = {.in             = {.buffer         = src,
+                                                           .pic_w          = camera->width,
+                                                           .pic_h          = camera->height,
+                                                           .block_w        = t.block_w,
+                                                           .block_h        = t.block_h,
+                                                           .block_offset_x = t.block_x,
+                                                           .block_offset_y = t.block_y,
+                                                           .srm_cm         = in_cm},
+                                        .out            = {.buffer         = infer_slots[infer_back],
+                                                           .buffer_size    = infer_slot_size,
+                                                           .pic_w          = out_w,
+                                                           .pic_h          = out_h,
+                                                           .block_offset_x = 0,
+                                                           .block_offset_y = 0,
+                                                           .srm_cm         = PPA_SRM_COLOR_MODE_RGB565},
+                                        .rotation_angle = PPA_SRM_ROTATION_ANGLE_0,
+                                        .scale_x        = scale,
+                                        .scale_y        = scale,
+                                        .mirror_x       = true,
+                                        .mirror_y       = false,
+                                        .rgb_swap       = false,
+                                        .byte_swap      = false,
+                                        .mode           = PPA_TRANS_MODE_BLOCKING,
+                                        .user_data      = NULL};
+    if (ppa_do_scale_rotate_mirror(camera_infer_ppa, &srm_config) != ESP_OK) {
+        ESP_LOGE(TAG, "failed to scale inference frame");
+        return;
+    }
+    infer_offered_us         = now_us;
+    infer_slot_w[infer_back] = out_w;
+    infer_slot_h[infer_back] = out_h;
+    infer_back = infer_middle.exchange(infer_back | CAMERA_INFER_SLOT_FRESH, std::memory_order_acq_rel) &
+                 CAMERA_INFER_SLOT_MASK;
+    xSemaphoreGive(sem_infer_frame);
+}
+
+static void camera_infer_loop(TaskController_t& task)
+{
+    int64_t last_run_us = 0;
+    float fps           = 0.0f;
+    while (task.checkPoint()) {
+        // Timed out now and then to see a stop request
+        if (xSemaphoreTake(sem_infer_frame, pdMS_TO_TICKS(100)) != pdTRUE ||
+            !(infer_middle.load(std::memory_order_acquire) & CAMERA_INFER_SLOT_FRESH)) {
+            continue;
+        }
+        infer_front = infer_middle.exchange(infer_front, std::memory_order_acq_rel) & CAMERA_INFER_SLOT_MASK;
+        uint16_t w      = infer_slot_w[infer_front];
+        uint16_t h      = infer_slot_h[infer_front];
+        auto detections = camera_infer_detector(infer_slots[infer_front], w, h);
+
+        camera_detections_mutex.lock();
+        camera_detections   = detections;
+        camera_detections_w = w;
+        camera_detections_h = h;
+        camera_detections_mutex.unlock();
+
+        int64_t now_us = esp_timer_get_time();
+        if (last_run_us) {
+            float run_fps = 1000000.0f / (now_us - last_run_us);
+            fps           = fps ? fps * 0.8f + run_fps * 0.2f : run_fps;
+            camera_infer_fps.store(fps, std::memory_order_relaxed);
+        }
+        last_run_us = now_us;
+
+        if (camera_infer_callback) {
+            camera_infer_callback(detections);
+        }
+        GetHAL()->wakeAppLoop();
+    }
+    camera_infer_fps.store(0.0f, std::memory_order_relaxed);
+}
+
+// Requeue task side, boxes and labels of the last run scaled onto a finished RGB565 preview frame
+static void camera_infer_draw(uint8_t* slot, uint16_t slot_w, uint16_t slot_h)
+{
+    if (!camera_infer_is_active.load(std::memory_order_relaxed) || !camera_infer_config.drawOverlay) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(camera_detections_mutex);
+    if (camera_detections.empty() || !camera_detections_w || !camera_detections_h) {
+        return;
+    }
+
+    image_t img   = {};
+    img.w         = slot_w;
+    img.h         = slot_h;
+    img.pixfmt    = PIXFORMAT_RGB565;
+    img.data      = slot;
+    float kx      = (float)slot_w / camera_detections_w;
+    float ky      = (float)slot_h / camera_detections_h;
+    int color     = camera_infer_config.overlayColor;
+    int thickness = std::max(1, slot_w / 320);
+    for (const auto& d : camera_detections) {
+        int x = d.x * kx;
+        int y = d.y * ky;
+        imlib_draw_rectangle(&img, x, y, d.w * kx, d.h * ky, color, thickness, false);
+        if (d.label.empty()) {
+            continue;
+        }
+        char text[48];
+        snprintf(text, sizeof(text), "%s %d%%", d.label.c_str(), (int)(d.score * 100.0f + 0.5f));
+        imlib_draw_string(&img, x + thickness + 1, std::max(0, y - 10), text, color, 1.0f, 0, 0, false, 0, false,
+                          false, 0, false, false);
+    }
+}
+
+static void camera_requeue_task(void* arg)
+{
+    camera_ppa_trans_t* trans = NULL;
+    while (1) {
+        xQueueReceive(queue_ppa_done, &trans, portMAX_DELAY);
+        if (trans->v4l2_index == CAMERA_REQUEUE_EXIT) {
+            break;
+        }
+        if (trans->v4l2_index == CAMERA_REQUEUE_FLUSH) {
+            xSemaphoreGive(sem_requeue_done);
+            continue;
+        }
+
+        int64_t done_us = esp_timer_get_time();
+        camera_stats_push(CAMERA_STAGE_PPA, done_us - trans->submit_us);
+
+        if (camera_canvas && camera_transform.out_bpp == 2) {
+            camera_infer_draw(present_slots[trans->slot], present_slot_w[trans->slot], present_slot_h[trans->slot]);
+        }
+
+        // Publish the finished slot and take back whichever slot LVGL is not holding
+        camera_published_us.store(done_us, std::memory_order_relaxed);
+        uint8_t recycled =
+            present_middle.exchange(trans->slot | CAMERA_PRESENT_SLOT_FRESH, std::memory_order_acq_rel) &
+            CAMERA_PRESENT_SLOT_MASK;
+        xQueueSend(queue_present_free, &recycled, portMAX_DELAY);
+
+        // Every consumer that takes the frame holds its own reference, the PPA one goes last and requeues the buffer
+        // right here when nobody took it
+        camera_raw_offer(trans->v4l2_index);
+        camera_recorder_offer(trans->v4l2_index);
+        camera_h264_offer(trans->v4l2_index);
+        camera_subscribers_offer(trans->v4l2_index, false);
+        camera_frame_release(trans->v4l2_index);
+        camera_stats_push(CAMERA_STAGE_QBUF, esp_timer_get_time() - done_us);
+    }
+
+    xSemaphoreGive(sem_requeue_done);
+    vTaskDelete(NULL);
+}
+
+// PPA has no RAW input, so RAW8 previews are a nearest-neighbour grey copy done on the CPU
+static void camera_copy_raw8(const uint8_t* src, uint32_t src_w, uint8_t* dst)
+{
+    const camera_transform_t& t = camera_transform;
+    for (uint32_t y = 0; y < t.out_h; y++) {
+        const uint8_t* src_row = src + (t.block_y + y * t.block_h / t.out_h) * src_w + t.block_x;
+        uint8_t* dst_row       = dst + y * t.out_w;
+        if (t.block_w == t.out_w) {
+            memcpy(dst_row, src_row, t.out_w);
+            continue;
+        }
+        for (uint32_t x = 0; x < t.out_w; x++) {
+            dst_row[x] = src_row[x * t.block_w / t.out_w];
+        }
+    }
+}
+
+/* --------------------------------- Barcode --------------------------------- */
+/*
+ * QR and barcode scanning on RAW8 captures.
+ * The capture task bins the shown block straight from the Bayer plane into a grey back slot, one RGGB quad per output
+ * pixel, and swaps it with `barcode_middle` like the inference frames. The `cam_qr` task compares each frame with the
+ * previous one and only decodes while the picture changes and for a few frames after it settles.
+ */
+#define CAMERA_BARCODE_SLOT_NUM   3
+#define CAMERA_BARCODE_SLOT_MASK  0x03
+#define CAMERA_BARCODE_SLOT_FRESH 0x04
+
+static std::mutex camera_barcode_mutex;  // Guards the slots against start and stop
+static std::atomic<bool> camera_barcode_is_active{false};
+static hal::HalBase::CameraBarcodeConfig_t camera_barcode_config;
+static TaskController_t camera_barcode_task;
+static SemaphoreHandle_t sem_barcode_frame = NULL;
+static uint8_t* barcode_slots[CAMERA_BARCODE_SLOT_NUM] = {NULL};
+static uint16_t barcode_slot_w[CAMERA_BARCODE_SLOT_NUM];
+static uint16_t barcode_slot_h[CAMERA_BARCODE_SLOT_NUM];
+static std::atomic<uint8_t> barcode_middle{1};
+static uint8_t barcode_front = 0;  // Owned by the barcode task
+static uint8_t barcode_back  = 2;  // Owned by the capture task
+
+static std::mutex camera_barcode_result_mutex;
+static hal::HalBase::CameraBarcode_t camera_barcode_result;
+
+// Capture task side, bin the block of a RAW8 frame into the back slot and publish it
+static void camera_barcode_offer(const uint8_t* src, uint32_t src_w)
+{
+    if (!camera_barcode_is_active.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(camera_barcode_mutex, std::try_to_lock);
+    if (!lock.owns_lock() || !barcode_slots[0]) {
+        return;
+    }
+
+    // Even steps keep every sample on a whole quad, the block offset is even already
+    const camera_transform_t& t = camera_transform;
+    uint32_t step               = 2;
+    while (t.block_w / step > camera_barcode_config.maxWidth || t.block_h / step > camera_barcode_config.maxHeight) {
+        step += 2;
+    }
+    uint16_t out_w = t.block_w / step;
+    uint16_t out_h = t.block_h / step;
+
+    uint8_t* dst = barcode_slots[barcode_back];
+    for (uint32_t y = 0; y < out_h; y++) {
+        const uint8_t* row0 = src + (t.block_y + y * step) * src_w + t.block_x;
+        const uint8_t* row1 = row0 + src_w;
+        for (uint32_t x = 0; x < out_w; x++) {
+            uint32_t sx = x * step;
+            dst[x]      = (row0[sx] + row0[sx + 1] + row1[sx] + row1[sx + 1] + 2) >> 2;
+        }
+        dst += out_w;
+    }
+
+    barcode_slot_w[barcode_back] = out_w;
+    barcode_slot_h[barcode_back] = out_h;
+    barcode_back = barcode_middle.exchange(barcode_back | CAMERA_BARCODE_SLOT_FRESH, std::memory_order_acq_rel) &
+                   CAMERA_BARCODE_SLOT_MASK;
+    xSemaphoreGive(sem_barcode_frame);
+}
+
+#if CAMERA_HAS_CODE_SCANNER
+static void camera_barcode_loop(TaskController_t& task)
+{
+    esp_image_scanner_t* scanner = esp_code_scanner_create();
+    const auto& config           = camera_barcode_config;
+
+    MotionDetector::Config_t change_config;
+    change_config.blockSize    = config.blockSize;
+    change_config.threshold    = config.threshold;
+    change_config.warmupFrames = 1;
+    MotionDetector change_detector;
+    change_detector.init(change_config);
+
+    uint16_t scanner_w = 0;
+    uint16_t scanner_h = 0;
+    // The first frames are decoded as if the picture just changed
+    uint8_t pending      = config.settleFrames + 1;
+    int64_t published_us = 0;
+    std::string published_text;
+    while (task.checkPoint()) {
+        // Timed out now and then to see a stop request
+        if (xSemaphoreTake(sem_barcode_frame, pdMS_TO_TICKS(100)) != pdTRUE ||
+            !(barcode_middle.load(std::memory_order_acquire) & CAMERA_BARCODE_SLOT_FRESH)) {
+            continue;
+        }
+        barcode_front =
+            barcode_middle.exchange(barcode_front, std::memory_order_acq_rel) & CAMERA_BARCODE_SLOT_MASK;
+        const uint8_t* frame = barcode_slots[barcode_front];
+        uint16_t w           = barcode_slot_w[barcode_front];
+        uint16_t h           = barcode_slot_h[barcode_front];
+
+        if (change_detector.update(frame, w, h).changedBlocks) {
+            pending = config.settleFrames + 1;
+        }
+        if (!pending) {
+            continue;
+        }
+        pending--;
+
+        if (w != scanner_w || h != scanner_h) {
+            esp_code_scanner_config_t scanner_config = {ESP_CODE_SCANNER_MODE_FAST, ESP_CODE_SCANNER_IMAGE_GRAY, w, h};
+            esp_code_scanner_set_config(scanner, scanner_config);
+            scanner_w = w;
+            scanner_h = h;
+        }
+        if (esp_code_scanner_scan_image(scanner, frame) <= 0) {
+            continue;
+        }
+        esp_code_scanner_symbol_t symbol = esp_code_scanner_result(scanner);
+        std::string text                 = symbol.data ? symbol.data : "";
+
+        // Found, the same picture is not decoded again
+        pending        = 0;
+        int64_t now_us = esp_timer_get_time();
+        if (text == published_text && now_us - published_us < config.repeatMs * 1000LL) {
+            continue;
+        }
+        published_text = text;
+        published_us   = now_us;
+
+        uint32_t sequence = 0;
+        {
+            std::lock_guard<std::mutex> lock(camera_barcode_result_mutex);
+            camera_barcode_result.type = symbol.type_name ? symbol.type_name : "";
+            camera_barcode_result.text = text;
+            sequence                   = ++camera_barcode_result.sequence;
+        }
+        mclog::tagInfo(TAG, "barcode {}: {}", symbol.type_name ? symbol.type_name : "?", text);
+        GetEventBus().publish({shared_data::EVENT_TOPIC_BARCODE, 0, (int32_t)sequence});
+        GetHAL()->wakeAppLoop();
+    }
+    esp_code_scanner_destroy(scanner);
+}
+#endif
+
+/* --------------------------------- Session --------------------------------- */
+/*
+ * Camera session: CLOSED -> OPENED -> STREAMING.
+ * Opening brings up the V4L2 device, the PPA client, the queues and the requeue task once, and they stay up across
+ * window opens. Streaming on only queues the V4L2 buffers (REQBUFS/mmap again only after a format change), resets
+ * the presentation ring and grows its slots if the new output needs more, so a restart is just STREAMON.
+ */
+typedef enum {
+    CAMERA_SESSION_CLOSED = 0,
+    CAMERA_SESSION_OPENED,
+    CAMERA_SESSION_STREAMING,
+} camera_session_state_t;
+
+typedef struct {
+    camera_session_state_t state;
+    ppa_client_handle_t ppa_srm_handle;
+    uint32_t slot_size;  // Capacity of every present slot
+    int slot_allocated;
+} camera_session_t;
+
+static bool video_is_initial            = false;
+static camera_session_t camera_session  = {};
+static camera_ppa_trans_t requeue_flush = {.v4l2_index = CAMERA_REQUEUE_FLUSH, .slot = 0, .submit_us = 0};
+static camera_ppa_trans_t requeue_exit  = {.v4l2_index = CAMERA_REQUEUE_EXIT, .slot = 0, .submit_us = 0};
+
+// Posts a sentinel behind every pending transaction and waits for the requeue task to reach it
+static void camera_requeue_sync(camera_ppa_trans_t* sentinel)
+{
+    xQueueSend(queue_ppa_done, &sentinel, portMAX_DELAY);
+    xSemaphoreTake(sem_requeue_done, portMAX_DELAY);
+}
+
+// ISP statistics, the pipeline comes up with esp_video_init, a callback set before the first open is subscribed there
+static std::mutex isp_stats_mutex;
+static hal::HalBase::CameraIspStatsCallback_t isp_stats_callback;
+static bool isp_stats_is_subscribed = false;
+
+#if CONFIG_ESP_VIDEO_ENABLE_ISP_PIPELINE_CONTROLLER
+// Runs on the ISP task, the fields point into its statistics buffer
+static void camera_isp_stats_cb(const esp_video_isp_stats_t* stats, void* user_data)
+{
+    hal::HalBase::CameraIspStats_t isp_stats;
+    isp_stats.sequence = stats->seq;
+    if (stats->flags & ESP_VIDEO_ISP_STATS_FLAG_HIST) {
+        isp_stats.histogram     = stats->hist.hist_result.hist_value;
+        isp_stats.histogramBins = ISP_HIST_SEGMENT_NUMS;
+    }
+    if (stats->flags & ESP_VIDEO_ISP_STATS_FLAG_AE) {
+        isp_stats.aeLuminance = &stats->ae.ae_result.luminance[0][0];
+        isp_stats.aeBlocksX   = ISP_AE_BLOCK_X_NUM;
+        isp_stats.aeBlocksY   = ISP_AE_BLOCK_Y_NUM;
+    }
+    if (stats->flags & ESP_VIDEO_ISP_STATS_FLAG_AWB) {
+        isp_stats.hasAwb     = true;
+        isp_stats.awbCounted = stats->awb.awb_result.white_patch_num;
+        isp_stats.awbSumR    = stats->awb.awb_result.sum_r;
+        isp_stats.awbSumG    = stats->awb.awb_result.sum_g;
+        isp_stats.awbSumB    = stats->awb.awb_result.sum_b;
+    }
+    if (stats->flags & ESP_VIDEO_ISP_STATS_FLAG_SHARPEN) {
+        isp_stats.hasSharpness = true;
+        isp_stats.sharpness    = stats->sharpen.high_freq_pixel_max;
+    }
+
+    // Unsubscribing waits for a running callback, so the function is only swapped while it is not called
+    isp_stats_callback(isp_stats);
+}
+#endif
+
+// With isp_stats_mutex held
+static void camera_isp_stats_subscribe()
+{
+#if CONFIG_ESP_VIDEO_ENABLE_ISP_PIPELINE_CONTROLLER
+    if (isp_stats_is_subscribed || !isp_stats_callback || !video_is_initial) {
+        return;
+    }
+    isp_stats_is_subscribed = esp_video_isp_stats_subscribe(camera_isp_stats_cb, NULL) == ESP_OK;
+#endif
+}
+
+static void camera_isp_stats_unsubscribe()
+{
+#if CONFIG_ESP_VIDEO_ENABLE_ISP_PIPELINE_CONTROLLER
+    if (isp_stats_is_subscribed) {
+        esp_video_isp_stats_unsubscribe(camera_isp_stats_cb, NULL);
+        isp_stats_is_subscribed = false;
+    }
+#endif
+}
+
+// Image controls are kept while the video stack is down, they go to the ISP pipeline once it is up
+static std::mutex image_control_mutex;
+static hal::HalBase::CameraImageControl_t image_control;
+static bool image_control_is_set = false;
+
+// With image_control_mutex held
+static bool camera_image_control_apply()
+{
+#if CONFIG_ESP_VIDEO_ENABLE_ISP_PIPELINE_CONTROLLER
+    if (!image_control_is_set || !video_is_initial) {
+        return true;
+    }
+
+    const auto& c                 = image_control;
+    esp_video_isp_manual_t manual = {};
+    manual.flags |= c.aeLock ? ESP_VIDEO_ISP_MANUAL_EXPOSURE : 0;
+    manual.flags |= c.awbLock ? ESP_VIDEO_ISP_MANUAL_WB : 0;
+    manual.flags |= c.ccmLock ? ESP_VIDEO_ISP_MANUAL_CCM : 0;
+    manual.flags |= c.ipaOff ? ESP_VIDEO_ISP_MANUAL_IPA_OFF : 0;
+    manual.exposure_us = c.exposureUs;
+    manual.gain        = c.analogGain;
+    manual.red_gain    = c.redGain;
+    manual.blue_gain   = c.blueGain;
+    manual.has_ccm     = c.hasCcm;
+    for (int i = 0; i < 9; i++) {
+        manual.ccm[i / 3][i % 3] = c.ccm[i];
+    }
+    return esp_video_isp_pipeline_set_manual(&manual) == ESP_OK;
+#else
+    return false;
+#endif
+}
+
+static void camera_session_close();
+
+// The sensor esp_video_init found, packed as pid << 16 | SCCB address << 8 | detect index. Saved so the next boot
+// tries that driver first instead of probing every one over SCCB, 0 for none
+static bool camera_load_sensor_hint(esp_video_init_sensor_hint_t& hint)
+{
+    uint32_t packed = HalEsp32::settingsStore().get<uint32_t>("cam_sensor", 0);
+    if (packed == 0) {
+        return false;
+    }
+    hint.pid          = packed >> 16;
+    hint.sccb_addr    = (packed >> 8) & 0x7F;
+    hint.detect_index = packed & 0xFF;
+    return true;
+}
+
+static void camera_save_sensor_hint()
+{
+    esp_video_init_sensor_hint_t hint;
+    if (esp_video_init_get_sensor_hint(&hint) != ESP_OK) {
+        return;
+    }
+    uint32_t packed = (uint32_t)hint.pid << 16 | (hint.sccb_addr & 0x7F) << 8 | hint.detect_index;
+    if (HalEsp32::settingsStore().set<uint32_t>("cam_sensor", packed)) {
+        ESP_LOGI(TAG, "sensor hint saved: pid 0x%x at 0x%x", hint.pid, hint.sccb_addr);
+    }
+}
+
+static esp_err_t camera_session_open()
+{
+    if (camera_session.state != CAMERA_SESSION_CLOSED) {
+        return ESP_OK;
+    }
+
+    /* camera config */
+    static esp_video_init_csi_config_t csi_config = {
+        .sccb_config =
+            {
+                .init_sccb  = false,
+                .i2c_handle = NULL,
+                .freq       = 400000,  // TAB5_MIPI_CSI_SCCB_I2C_FREQ,
+            },
+        .reset_pin = -1,  // TAB5_MIPI_CSI_CAM_SENSOR_RESET_PIN,
+        .pwdn_pin  = -1,  // TAB5_MIPI_CSI_CAM_SENSOR_PWDN_PIN,
+    };
+    csi_config.sccb_config.i2c_handle = bsp_i2c_get_handle();
+    static esp_video_init_sensor_hint_t sensor_hint;
+    csi_config.sensor_hint = camera_load_sensor_hint(sensor_hint) ? &sensor_hint : NULL;
+
+    // The sensor needs its clock before it is probed, the clock is stopped again when the session closes
+    if (!GetHAL()->claimPeripheral(hal::HalBase::PERIPHERAL_CAMERA_OSC, "camera")) {
+        return ESP_FAIL;
+    }
+
+    esp_video_init_config_t cam_config = {
+        .csi  = &csi_config,  // Point to CSI config
+        .dvp  = NULL,         // No DVP configuration
+        .jpeg = NULL,         // No JPEG configuration
+    };
+
+    // esp_video_init registers the devices and can only run once
+    if (!video_is_initial) {
+        printf("\n============= video init ==============\n");
+        ESP_ERROR_CHECK(esp_video_init(&cam_config));
+        video_is_initial = true;
+        camera_save_sensor_hint();
+
+        {
+            std::lock_guard<std::mutex> lock(isp_stats_mutex);
+            camera_isp_stats_subscribe();
+        }
+        std::lock_guard<std::mutex> lock(image_control_mutex);
+        camera_image_control_apply();
+    }
+
+    printf("\n============= video open ==============\n");
+    int video_cam_fd = app_video_open(CAM_DEV_PATH, EXAMPLE_VIDEO_FMT_RGB565);
+    if (video_cam_fd < 0) {
+        ESP_LOGE(TAG, "video cam open failed");
+        GetHAL()->releasePeripheral(hal::HalBase::PERIPHERAL_CAMERA_OSC, "camera");
+        return ESP_FAIL;
+    }
+    ESP_ERROR_CHECK(new_cam(video_cam_fd, &camera));
+
+    // Sized for the largest config, the back slots already cap what is in flight
+    ppa_client_config_t ppa_srm_config = {
+        .oper_type             = PPA_OPERATION_SRM,
+        .max_pending_trans_num = CAMERA_MAX_BUFFER_COUNT,
+    };
+    ESP_ERROR_CHECK(ppa_register_client(&ppa_srm_config, &camera_session.ppa_srm_handle));
+    ppa_event_callbacks_t ppa_cbs = {
+        .on_trans_done = camera_ppa_trans_done_cb,
+    };
+    ESP_ERROR_CHECK(ppa_client_register_event_callbacks(camera_session.ppa_srm_handle, &ppa_cbs));
+
+    queue_ppa_done     = xQueueCreate(CAMERA_MAX_BUFFER_COUNT + 1, sizeof(camera_ppa_trans_t*));
+    queue_present_free = xQueueCreate(CAMERA_PRESENT_SLOT_MAX, sizeof(uint8_t));
+    sem_requeue_done   = xSemaphoreCreateBinary();
+    xTaskCreatePinnedToCore(camera_requeue_task, "cam_rq", 4 * 1024, NULL, 6, NULL, 1);
+
+    camera_session.state = CAMERA_SESSION_OPENED;
+    return ESP_OK;
+}
+
+// Makes sure there are `count` slots of at least `size` bytes, existing slots are kept when they are big enough
+static bool camera_session_reserve_slots(int count, uint32_t size)
+{
+    if (size > camera_session.slot_size) {
+        for (int i = 0; i < camera_session.slot_allocated; i++) {
+            dma_buffer_free(present_slots[i]);
+            present_slots[i] = NULL;
+        }
+        camera_session.slot_allocated = 0;
+        camera_session.slot_size      = size;
+    }
+
+    for (int i = camera_session.slot_allocated; i < count; i++) {
+        present_slots[i] = (uint8_t*)dma_buffer_calloc(camera_session.slot_size, MALLOC_CAP_DMA | MALLOC_CAP_SPIRAM);
+        if (present_slots[i] == NULL) {
+            ESP_LOGE(TAG, "malloc for present slot %d failed", i);
+            return false;
+        }
+        // Padded to whole cache lines, the PPA writes up to the buffer size
+        camera_session.slot_size = dma_buffer_get_size(present_slots[i]);
+        camera_session.slot_allocated = i + 1;
+    }
+    return true;
+}
+
+static esp_err_t camera_session_stream_on()
+{
+    if (camera_session.state == CAMERA_SESSION_STREAMING) {
+        return ESP_OK;
+    }
+    if (camera_session_open() != ESP_OK) {
+        return ESP_FAIL;
+    }
+
+    if (camera_start_stream(camera) != ESP_OK) {
+        camera_session_close();
+        return ESP_FAIL;
+    }
+
+    const camera_transform_t& t = camera_transform;
+    present_slot_count          = 2 + camera->buffer_count;
+    if (!camera_session_reserve_slots(present_slot_count, t.max_w * t.max_h * t.out_bpp)) {
+        camera_session_close();
+        return ESP_FAIL;
+    }
+    present_front = 0;
+    present_middle.store(1, std::memory_order_relaxed);
+    memset(present_slot_picture, 0, sizeof(present_slot_picture));
+    xQueueReset(queue_present_free);
+    for (uint8_t i = 2; i < present_slot_count; i++) {
+        xQueueSend(queue_present_free, &i, 0);
+    }
+
+    camera_session.state = CAMERA_SESSION_STREAMING;
+    return ESP_OK;
+}
+
+static void camera_session_stream_off()
+{
+    if (camera_session.state != CAMERA_SESSION_STREAMING) {
+        return;
+    }
+
+    // Every back slot coming home means every transaction in flight is done
+    uint8_t back_slot = 0;
+    for (int i = 2; i < present_slot_count; i++) {
+        xQueueReceive(queue_present_free, &back_slot, portMAX_DELAY);
+    }
+    camera_requeue_sync(&requeue_flush);
+    camera_recorder_detach();
+    camera_h264_detach();
+    camera_raw_detach();
+    camera_frames_drain();
+    camera_stop_stream(camera);
+
+    camera_session.state = CAMERA_SESSION_OPENED;
+}
+
+static void camera_session_close()
+{
+    camera_session_stream_off();
+    if (camera_session.state != CAMERA_SESSION_OPENED) {
+        return;
+    }
+    // stream_on can fail after STREAMON was issued
+    camera_stop_stream(camera);
+
+    camera_requeue_sync(&requeue_exit);
+    ppa_unregister_client(camera_session.ppa_srm_handle);
+    camera_session.ppa_srm_handle = NULL;
+    vQueueDelete(queue_ppa_done);
+    vQueueDelete(queue_present_free);
+    vSemaphoreDelete(sem_requeue_done);
+    queue_ppa_done     = NULL;
+    queue_present_free = NULL;
+    sem_requeue_done   = NULL;
+
+    for (int i = 0; i < camera_session.slot_allocated; i++) {
+        dma_buffer_free(present_slots[i]);
+        present_slots[i] = NULL;
+    }
+    camera_session.slot_allocated = 0;
+    camera_session.slot_size      = 0;
+
+    camera_unmap_buffers(camera);
+    close(camera->fd);
+    free(camera);
+    camera = NULL;
+    GetHAL()->releasePeripheral(hal::HalBase::PERIPHERAL_CAMERA_OSC, "camera");
+
+    camera_session.state = CAMERA_SESSION_CLOSED;
+}
+
+// A config switch asked for while streaming, the capture task applies it at the next frame boundary
+static std::mutex camera_switch_mutex;
+static hal::HalBase::CameraConfig_t camera_switch_config;
+static std::atomic<bool> camera_switch_pending{false};
+
+// Restarts the stream on the open device with the pending config, the sensor driver only writes the registers that
+// differ and the ISP picks up its cached settings for a mode it has seen before
+static esp_err_t camera_session_switch()
+{
+    hal::HalBase::CameraConfig_t config;
+    {
+        std::lock_guard<std::mutex> lock(camera_switch_mutex);
+        config = camera_switch_config;
+        camera_switch_pending.store(false, std::memory_order_relaxed);
+    }
+
+    int64_t start_us = esp_timer_get_time();
+    camera_session_stream_off();
+
+    // The slots may be reallocated, LVGL must not draw the front one in between. The one place the capture task still
+    // waits on the lock, a config switch is rare and asked for by the UI
+    GetHAL()->lvglLock("camera switch");
+    camera_video_plane_clear();
+    camera_config = config;
+    esp_err_t ret = camera_session_stream_on();
+    if (ret == ESP_OK) {
+        lv_canvas_set_buffer(camera_canvas, present_slots[present_front], present_slot_w[present_front],
+                             present_slot_h[present_front],
+                             camera_transform.out_bpp == 1 ? LV_COLOR_FORMAT_L8 : LV_COLOR_FORMAT_RGB565);
+    } else {
+        lv_obj_add_flag(camera_canvas, LV_OBJ_FLAG_HIDDEN);
+    }
+    GetHAL()->lvglUnlock();
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "failed to switch camera config");
+        return ret;
+    }
+    ESP_LOGI(TAG, "switched to %ux%u in %" PRId64 " us", config.width, config.height, esp_timer_get_time() - start_us);
+    camera_stats_reset();
+    return ESP_OK;
+}
+
+// Motion detection runs the capture loop without a canvas, the task takes the published frames itself
+static bool camera_motion_is_active = false;
+static hal::HalBase::CameraMotionConfig_t camera_motion_config;
+static hal::HalBase::CameraMotionCallback_t camera_motion_callback;
+static MotionDetector camera_motion_detector;
+static int64_t camera_motion_event_us = 0;
+
+static void camera_motion_poll()
+{
+    if (!(present_middle.load(std::memory_order_acquire) & CAMERA_PRESENT_SLOT_FRESH)) {
+        return;
+    }
+    present_front = present_middle.exchange(present_front, std::memory_order_acq_rel) & CAMERA_PRESENT_SLOT_MASK;
+    auto result   = camera_motion_detector.update((const uint16_t*)present_slots[present_front],
+                                                  present_slot_w[present_front], present_slot_h[present_front]);
+
+    int64_t now_us = esp_timer_get_time();
+    if (result.changedBlocks < camera_motion_config.minBlocks ||
+        (camera_motion_event_us && now_us - camera_motion_event_us < camera_motion_config.holdOffMs * 1000LL)) {
+        return;
+    }
+    camera_motion_event_us = now_us;
+
+    hal::HalBase::CameraMotionEvent_t event;
+    event.changedBlocks = result.changedBlocks;
+    event.totalBlocks   = result.totalBlocks;
+    event.maxDiff       = result.maxDiff;
+    mclog::tagInfo(TAG, "motion: {}/{} blocks, max diff {}", event.changedBlocks, event.totalBlocks, event.maxDiff);
+    if (camera_motion_callback) {
+        camera_motion_callback(event);
+    }
+    GetHAL()->wakeAppLoop();
+}
+
+/**
+ * @brief The PPA only writes the scaled block, the margins around it would keep whatever an earlier frame left in the
+ *        slot. Cleared to black when the geometry of the slot changes, and written back before the PPA fills the block
+ *        so no dirty cache line lands on top of it later.
+ */
+static void camera_clear_slot_margins(uint8_t slot)
+{
+    const camera_transform_t& t = camera_transform;
+    uint64_t picture            = (uint64_t)t.out_w << 48 | (uint64_t)t.out_h << 32 | t.pic_w << 16 | t.pic_h;
+    if (present_slot_picture[slot] == picture) {
+        return;
+    }
+    present_slot_picture[slot] = picture;
+    if (t.pic_w == t.out_w && t.pic_h == t.out_h) {
+        return;
+    }
+    memset(present_slots[slot], 0, t.out_w * t.out_h * t.out_bpp);
+    esp_cache_msync(present_slots[slot], camera_session.slot_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+}
+
+static void app_camera_display(TaskController_t& task)
+{
+    if (camera_session_stream_on() != ESP_OK) {
+        ESP_LOGE(TAG, "failed to start camera stream");
+        camera_mutex.lock();
+        is_camera_capturing     = false;
+        camera_motion_is_active = false;
+        camera_mutex.unlock();
+        return;
+    }
+    // Frame conversion and presenting keep the CPU busy, hold the max clock for the whole stream. The small motion
+    // frames only need the chip kept out of light sleep while the sensor streams
+    GetHAL()->claimPerfLevel("camera", camera_canvas ? hal::HalBase::PERF_LEVEL_MAX : hal::HalBase::PERF_LEVEL_AWAKE);
+
+    struct v4l2_buffer buf;
+    const camera_transform_t& t = camera_transform;
+    bool is_raw                 = camera->pixel_format == EXAMPLE_VIDEO_FMT_RAW8;
+
+    if (camera_canvas) {
+        camera_run_on_ui([]() {
+            present_timer = lv_timer_create(camera_present_timer_cb, 5, NULL);
+            lvgl_port_set_cpu_rotate(lv_obj_get_display(camera_canvas), CAMERA_UI_CPU_ROTATE_PX);
+        });
+    }
+
+    // Frames arriving faster than the target FPS are handed straight back to the driver
+    int64_t last_frame_us = 0;
+    camera_stats_reset();
+
+    while (1) {
+        // Wait for a back slot, i.e. fewer than buffer_count transactions in flight
+        uint8_t back_slot = 0;
+        bool is_stopped   = false;
+        while (xQueueReceive(queue_present_free, &back_slot, pdMS_TO_TICKS(CAMERA_DQBUF_POLL_MS)) != pdPASS) {
+            if (task.isStopRequested()) {
+                is_stopped = true;
+                break;
+            }
+        }
+        if (is_stopped) {
+            break;
+        }
+
+        memset(&buf, 0, sizeof(buf));
+        buf.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = MEMORY_TYPE;
+
+        int64_t dqbuf_us = esp_timer_get_time();
+        TRACE_BEGIN("camera dqbuf");
+        bool is_dequeued = camera_dqbuf(task, buf);
+        TRACE_END("camera dqbuf");
+        if (!is_dequeued) {
+            xQueueSend(queue_present_free, &back_slot, 0);
+            break;
+        }
+        int64_t now_us = esp_timer_get_time();
+        camera_stats_push(CAMERA_STAGE_DQBUF, now_us - dqbuf_us);
+        camera_frame_hold(buf.index, now_us);
+
+        if (camera_view_dirty.load(std::memory_order_relaxed)) {
+            camera_apply_view();
+        }
+        camera_eis_update(now_us);
+
+        ppa_trans[buf.index].v4l2_index = buf.index;
+        ppa_trans[buf.index].slot       = back_slot;
+        ppa_trans[buf.index].submit_us  = now_us;
+        present_slot_w[back_slot]       = t.out_w;
+        present_slot_h[back_slot]       = t.out_h;
+
+        // Governor: drop frames while LVGL has not picked up the last one, and frames above the target FPS
+        int64_t frame_interval_us = camera_frame_interval_us();
+        bool is_unconsumed = camera_config.dropUnconsumedFrames &&
+                             (present_middle.load(std::memory_order_acquire) & CAMERA_PRESENT_SLOT_FRESH);
+        if (is_unconsumed ||
+            (frame_interval_us && now_us - last_frame_us < frame_interval_us - frame_interval_us / 4)) {
+            // A RAW capture and the subscribers that ask for them still take the frames the preview skips
+            if (is_raw) {
+                camera_raw_offer(buf.index);
+            }
+            camera_subscribers_offer(buf.index, true);
+            camera_frame_release(buf.index);
+            xQueueSend(queue_present_free, &back_slot, 0);
+            camera_frames_dropped.fetch_add(1, std::memory_order_relaxed);
+        } else if (is_raw) {
+            last_frame_us = now_us;
+            camera_copy_raw8(camera->buffer[buf.index], camera->width, present_slots[back_slot]);
+            camera_barcode_offer(camera->buffer[buf.index], camera->width);
+            camera_ppa_trans_t* trans = &ppa_trans[buf.index];
+            xQueueSend(queue_ppa_done, &trans, portMAX_DELAY);
+        } else {
+            last_frame_us = now_us;
+            ppa_srm_color_mode_t in_cm =
+                camera->pixel_format == EXAMPLE_VIDEO_FMT_YUV420 ? PPA_SRM_COLOR_MODE_YUV420 : PPA_SRM_COLOR_MODE_RGB565;
+            camera_infer_offer(camera->buffer[buf.index], in_cm, now_us);
+            camera_clear_slot_margins(back_slot);
+            ppa_srm_oper_config_t srm_config = {.in             = {.buffer         = camera->buffer[buf.index],
+                                                                   .pic_w          = camera->width,
+                                                                   .pic_h          = camera->height,
+                                                                   .block_w        = t.block_w,
+                                                                   .block_h        = t.block_h,
+                                                                   .block_offset_x = t.block_x,
+                                                                   .block_offset_y = t.block_y,
+                                                                   .srm_cm         = in_cm},
+                                                .out            = {.buffer         = present_slots[back_slot],
+                                                                   .buffer_size    = camera_session.slot_size,
+                                                                   .pic_w          = t.out_w,
+                                                                   .pic_h          = t.out_h,
+                                                                   .block_offset_x = t.pic_x,
+                                                                   .block_offset_y = t.pic_y,
+                                                                   .srm_cm         = PPA_SRM_COLOR_MODE_RGB565},
+                                                .rotation_angle = PPA_SRM_ROTATION_ANGLE_0,
+                                                .scale_x        = t.scale_x,
+                                                .scale_y        = t.scale_y,
+                                                .mirror_x       = true,
+                                                .mirror_y       = false,
+                                                .rgb_swap       = false,
+                                                .byte_swap      = false,
+                                                .mode           = PPA_TRANS_MODE_NON_BLOCKING,
+                                                .user_data      = &ppa_trans[buf.index]};
+            // Non-blocking, the transfer itself ends at the "camera ppa done" instant of the interrupt
+            TRACE_INSTANT("camera ppa submit");
+            if (ppa_do_scale_rotate_mirror(camera_session.ppa_srm_handle, &srm_config) != ESP_OK) {
+                ESP_LOGE(TAG, "failed to submit ppa transaction");
+                camera_frame_release(buf.index);
+                xQueueSend(queue_present_free, &back_slot, 0);
+            }
+        }
+
+        if (!camera_canvas) {
+            camera_motion_poll();
+        }
+
+        if (camera_switch_pending.load(std::memory_order_relaxed)) {
+            if (camera_session_switch() != ESP_OK) {
+                break;
+            }
+            is_raw        = camera->pixel_format == EXAMPLE_VIDEO_FMT_RAW8;
+            last_frame_us = 0;
+        }
+
+        // The loop is paced by DQBUF, control requests are picked up at the frame boundary without sleeping. A stop
+        // also ends the waits above, the sensor may have stopped sending
+        if (!task.checkPoint()) {
+            break;
+        }
+    }
+
+    ESP_LOGI(TAG, "task exit");
+
+    camera_session_stream_off();
+
+    GetHAL()->releasePerfLevel("camera");
+
+    auto set_stopped = []() {
+        camera_mutex.lock();
+        is_camera_capturing     = false;
+        camera_motion_is_active = false;
+        camera_mutex.unlock();
+    };
+    if (!camera_canvas) {
+        set_stopped();
+        return;
+    }
+    // Stop the LVGL side, the slots stay allocated for the next start. Reported stopped from there, the app deletes
+    // the canvas once it sees that
+    camera_run_on_ui([set_stopped]() {
+        if (present_timer) {
+            lv_timer_delete(present_timer);
+            present_timer = NULL;
+        }
+        camera_video_plane_clear();
+        lvgl_port_set_cpu_rotate(lv_obj_get_display(camera_canvas), 0);
+        set_stopped();
+    });
+}
+
+/* -------------------------------- Time-lapse -------------------------------- */
+/*
+ * A shot streams without a preview: frames go straight back to the driver while the ISP task settles the exposure,
+ * then the first settled frame is taken by the recorder as a snapshot. STREAMOFF puts the sensor in standby, long
+ * intervals also close the session, which stops the sensor clock.
+ */
+#define CAMERA_TIMELAPSE_STABLE_FRAMES 3  // Exposure and gain unchanged over this many frames counts as settled
+#define CAMERA_TIMELAPSE_CLOSE_SEC     5  // Reopening takes well under a second, shorter intervals keep it open
+#define CAMERA_TIMELAPSE_FADE_MS       300
+
+static bool camera_timelapse_is_active = false;
+static hal::HalBase::CameraTimelapseConfig_t camera_timelapse_config;
+static std::atomic<uint32_t> camera_timelapse_shots{0};
+
+// False if the stream failed before a frame was taken
+static bool camera_timelapse_shot(TaskController_t& task, const std::string& path)
+{
+    if (camera_session_stream_on() != ESP_OK) {
+        return false;
+    }
+
+    hal::HalBase::CameraImageState_t last_state;
+    int stable_frames = 0;
+    bool is_taken     = false;
+    for (int frame = 0; !is_taken && task.checkPoint(); frame++) {
+        struct v4l2_buffer buf;
+        memset(&buf, 0, sizeof(buf));
+        buf.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = MEMORY_TYPE;
+        if (!camera_dqbuf(task, buf)) {
+            break;
+        }
+        camera_frame_hold(buf.index, esp_timer_get_time());
+
+        // Without the ISP controller there is no state to watch, the warmup runs its full length
+        hal::HalBase::CameraImageState_t state;
+        if (GetHAL()->getCameraImageState(state) && state.exposureUs == last_state.exposureUs &&
+            state.analogGain == last_state.analogGain) {
+            stable_frames++;
+        } else {
+            stable_frames = 0;
+        }
+        last_state = state;
+
+        if (stable_frames >= CAMERA_TIMELAPSE_STABLE_FRAMES || frame + 1 >= camera_timelapse_config.maxWarmupFrames) {
+            {
+                std::lock_guard<std::mutex> lock(recorder_mutex);
+                strlcpy(snapshot_path, path.c_str(), sizeof(snapshot_path));
+                snapshot_pending = true;
+            }
+            // The encoder keeps the buffer until it is done, with no output buffer free the next frame is tried
+            is_taken = camera_recorder_offer(buf.index);
+        }
+        camera_frame_release(buf.index);
+    }
+
+    // Waits for the encoder to hand the buffer back, the writer saves the file on its own
+    camera_session_stream_off();
+    return is_taken || task.isStopRequested();
+}
+
+static void camera_timelapse_loop(TaskController_t& task)
+{
+    const auto config   = camera_timelapse_config;
+    auto hal            = GetHAL();
+    uint8_t brightness  = hal->getDisplayBrightness();
+    bool is_kept_open   = config.intervalSec < CAMERA_TIMELAPSE_CLOSE_SEC;
+    int64_t interval_us = config.intervalSec * 1000000LL;
+    std::string dir     = "/sd/" + config.directory;
+
+    if (config.displayOff) {
+        hal->fadeDisplayBrightness(0, CAMERA_TIMELAPSE_FADE_MS);
+    }
+    mkdir(dir.c_str(), 0777);
+
+    int64_t next_us = esp_timer_get_time();
+    for (uint32_t sequence = 0; config.maxShots == 0 || sequence < config.maxShots; sequence++) {
+        char name[24];
+        snprintf(name, sizeof(name), "/TL_%05" PRIu32 ".jpg", sequence);
+
+        // Light sleep is only held off while the sensor streams
+        hal->claimPerfLevel("camera", hal::HalBase::PERF_LEVEL_AWAKE);
+        int64_t start_us = esp_timer_get_time();
+        bool is_ok       = camera_timelapse_shot(task, dir + name);
+        if (!is_kept_open) {
+            camera_session_close();
+        }
+        hal->releasePerfLevel("camera");
+        if (!is_ok) {
+            ESP_LOGE(TAG, "time-lapse shot %" PRIu32 " failed", sequence);
+            break;
+        }
+        if (task.isStopRequested()) {
+            break;
+        }
+        camera_timelapse_shots.fetch_add(1, std::memory_order_relaxed);
+        DeferredLog::info(TAG, "time-lapse shot {} in {} ms", sequence, (esp_timer_get_time() - start_us) / 1000);
+
+        // A shot that overran the interval moves the schedule instead of firing the next one at once
+        next_us += interval_us;
+        int64_t now_us = esp_timer_get_time();
+        if (next_us < now_us) {
+            next_us = now_us;
+        }
+        if (!task.sleep(pdMS_TO_TICKS((next_us - now_us) / 1000))) {
+            break;
+        }
+    }
+
+    camera_session_close();
+    if (config.displayOff) {
+        hal->fadeDisplayBrightness(brightness, CAMERA_TIMELAPSE_FADE_MS);
+    }
+    mclog::tagInfo(TAG, "time-lapse done, {} shots", camera_timelapse_shots.load(std::memory_order_relaxed));
+
+    camera_mutex.lock();
+    is_camera_capturing        = false;
+    camera_timelapse_is_active = false;
+    camera_mutex.unlock();
+}
+
+void HalEsp32::startCameraCapture(lv_obj_t* imgCanvas, const CameraConfig_t& config)
+{
+    DeferredLog::info(TAG, "start camera capture {}x{} fmt {} {}fps", config.width, config.height,
+                      (int)config.pixelFormat, config.fps);
+
+    std::lock_guard<std::mutex> lock(camera_mutex);
+    // A stopped task may still be on its way out, it returns within a frame
+    if (camera_task.isRunning()) {
+        mclog::tagError(TAG, "camera task still running");
+        return;
+    }
+    camera_canvas = imgCanvas;
+    camera_config = config;
+    if (!camera_task.start("cam", 8 * 1024, 5, 1, app_camera_display)) {
+        mclog::tagError(TAG, "camera task still running or create failed");
+        return;
+    }
+    is_camera_capturing = true;
+}
+
+bool HalEsp32::switchCameraConfig(const CameraConfig_t& config)
+{
+    if (!isCameraCapturing()) {
+        return false;
+    }
+    DeferredLog::info(TAG, "switch camera config {}x{} fmt {} {}fps", config.width, config.height,
+                      (int)config.pixelFormat, config.fps);
+
+    std::lock_guard<std::mutex> lock(camera_switch_mutex);
+    camera_switch_config = config;
+    camera_switch_pending.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+// Picked up by the capture loop on the next frame, the sensor keeps its mode
+void HalEsp32::camera_set_fps_cap(uint8_t fps)
+{
+    if (camera_fps_cap.exchange(fps, std::memory_order_relaxed) != fps) {
+        mclog::tagInfo(TAG, "preview fps cap {}", fps);
+    }
+}
+
+void HalEsp32::stopCameraCapture()
+{
+    mclog::tagInfo(TAG, "stop camera capture");
+
+    // Not joined, the task reports the stop from a UI command that runs under the LVGL lock callers may hold
+    camera_task.stop(0);
+}
+
+bool HalEsp32::isCameraCapturing()
+{
+    std::lock_guard<std::mutex> lock(camera_mutex);
+    return is_camera_capturing && !camera_motion_is_active && !camera_timelapse_is_active;
+}
+
+bool HalEsp32::startCameraMotionDetect(const CameraMotionConfig_t& config, CameraMotionCallback_t onMotion)
+{
+    std::lock_guard<std::mutex> lock(camera_mutex);
+    if (camera_task.isRunning()) {
+        mclog::tagWarn(TAG, "camera busy, motion detection not started");
+        return false;
+    }
+    mclog::tagInfo(TAG, "start motion detection {}x{} {}fps", config.width, config.height, config.fps);
+
+    // RGB565 goes through the PPA, which scales the sensor frame straight down to the small size
+    CameraConfig_t capture;
+    capture.width                = config.width;
+    capture.height               = config.height;
+    capture.pixelFormat          = CAMERA_PIXEL_FORMAT_RGB565;
+    capture.fps                  = std::max<uint8_t>(config.fps, 1);
+    capture.bufferCount          = 2;
+    capture.dropUnconsumedFrames = true;
+
+    MotionDetector::Config_t detector_config;
+    detector_config.blockSize = config.blockSize;
+    detector_config.threshold = config.threshold;
+    camera_motion_detector.init(detector_config);
+
+    camera_canvas          = NULL;
+    camera_config          = capture;
+    camera_motion_config   = config;
+    camera_motion_callback = std::move(onMotion);
+    camera_motion_event_us = 0;
+    if (!camera_task.start("cam", 8 * 1024, 5, 1, app_camera_display)) {
+        mclog::tagError(TAG, "camera task create failed");
+        return false;
+    }
+    is_camera_capturing     = true;
+    camera_motion_is_active = true;
+    return true;
+}
+
+void HalEsp32::stopCameraMotionDetect()
+{
+    if (!isCameraMotionDetecting()) {
+        return;
+    }
+    mclog::tagInfo(TAG, "stop motion detection");
+
+    // Without a canvas the task never takes the display lock, so it is joined
+    camera_task.stop();
+}
+
+bool HalEsp32::isCameraMotionDetecting()
+{
+    std::lock_guard<std::mutex> lock(camera_mutex);
+    return camera_motion_is_active;
+}
+
+bool HalEsp32::startCameraTimelapse(const CameraTimelapseConfig_t& config)
+{
+    if (config.intervalSec == 0 || config.directory.empty()) {
+        mclog::tagError(TAG, "invalid time-lapse config");
+        return false;
+    }
+    if (!mount_sd_card() || !camera_recorder_init()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(camera_mutex);
+    if (camera_task.isRunning()) {
+        mclog::tagWarn(TAG, "camera busy, time-lapse not started");
+        return false;
+    }
+    mclog::tagInfo(TAG, "start time-lapse every {} s to {}", config.intervalSec, config.directory);
+
+    CameraConfig_t capture;
+    capture.width       = config.width;
+    capture.height      = config.height;
+    capture.bufferCount = 2;
+    capture.videoPlane  = false;
+
+    camera_canvas           = NULL;
+    camera_config           = capture;
+    camera_timelapse_config = config;
+    camera_timelapse_shots.store(0, std::memory_order_relaxed);
+    if (!camera_task.start("cam", 8 * 1024, 5, 1, camera_timelapse_loop)) {
+        mclog::tagError(TAG, "camera task create failed");
+        return false;
+    }
+    is_camera_capturing        = true;
+    camera_timelapse_is_active = true;
+    return true;
+}
+
+void HalEsp32::stopCameraTimelapse()
+{
+    if (!isCameraTimelapseRunning()) {
+        return;
+    }
+    mclog::tagInfo(TAG, "stop time-lapse");
+
+    // Without a canvas the task never takes the display lock, so it is joined
+    camera_task.stop();
+}
+
+bool HalEsp32::isCameraTimelapseRunning()
+{
+    std::lock_guard<std::mutex> lock(camera_mutex);
+    return camera_timelapse_is_active;
+}
+
+uint32_t HalEsp32::getCameraTimelapseShots()
+{
+    return camera_timelapse_shots.load(std::memory_order_relaxed);
+}
+
+bool HalEsp32::startCameraInference(const CameraInferenceConfig_t& config, CameraDetector_t detector,
+                                    CameraDetectionCallback_t onDetections)
+{
+    if (!detector || !config.maxWidth || !config.maxHeight) {
+        return false;
+    }
+    stopCameraInference();
+    mclog::tagInfo(TAG, "start camera inference, frames up to {}x{}", config.maxWidth, config.maxHeight);
+
+    std::lock_guard<std::mutex> lock(camera_infer_mutex);
+    // Blocking transactions, no callbacks
+    ppa_client_config_t ppa_srm_config = {
+        .oper_type = PPA_OPERATION_SRM,
+    };
+    if (ppa_register_client(&ppa_srm_config, &camera_infer_ppa) != ESP_OK) {
+        mclog::tagError(TAG, "failed to register inference ppa client");
+        camera_infer_ppa = NULL;
+        return false;
+    }
+    // PPA output wants cache line aligned buffers, padded to whole lines
+    infer_slot_size = config.maxWidth * config.maxHeight * 2;
+    for (int i = 0; i < CAMERA_INFER_SLOT_NUM; i++) {
+        infer_slots[i] = (uint16_t*)dma_buffer_calloc(infer_slot_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA);
+        if (infer_slots[i] == NULL) {
+            mclog::tagError(TAG, "failed to allocate inference frames");
+            for (int j = 0; j <= i; j++) {
+                dma_buffer_free(infer_slots[j]);
+                infer_slots[j] = NULL;
+            }
+            ppa_unregister_client(camera_infer_ppa);
+            camera_infer_ppa = NULL;
+            return false;
+        }
+    }
+    infer_slot_size = dma_buffer_get_size(infer_slots[0]);
+    if (sem_infer_frame == NULL) {
+        sem_infer_frame = xSemaphoreCreateBinary();
+    }
+    xSemaphoreTake(sem_infer_frame, 0);
+    infer_front      = 0;
+    infer_back       = 2;
+    infer_offered_us = 0;
+    infer_middle.store(1, std::memory_order_relaxed);
+
+    camera_infer_config   = config;
+    camera_infer_detector = std::move(detector);
+    camera_infer_callback = std::move(onDetections);
+    // The capture task is on core 1, the detector gets the other core
+    if (!camera_infer_task.start("cam_ai", 16 * 1024, 4, 0, camera_infer_loop)) {
+        mclog::tagError(TAG, "inference task create failed");
+        for (int i = 0; i < CAMERA_INFER_SLOT_NUM; i++) {
+            dma_buffer_free(infer_slots[i]);
+            infer_slots[i] = NULL;
+        }
+        ppa_unregister_client(camera_infer_ppa);
+        camera_infer_ppa = NULL;
+        return false;
+    }
+    camera_infer_is_active.store(true, std::memory_order_release);
+    return true;
+}
+
+void HalEsp32::stopCameraInference()
+{
+    if (!camera_infer_task.isRunning() && !camera_infer_is_active.load(std::memory_order_acquire)) {
+        return;
+    }
+    mclog::tagInfo(TAG, "stop camera inference");
+
+    // The capture task skips the slots once it sees the flag, the mutex waits out a pass in progress
+    camera_infer_is_active.store(false, std::memory_order_release);
+    camera_infer_task.stop();
+
+    std::lock_guard<std::mutex> lock(camera_infer_mutex);
+    if (camera_infer_ppa) {
+        ppa_unregister_client(camera_infer_ppa);
+        camera_infer_ppa = NULL;
+    }
+    for (int i = 0; i < CAMERA_INFER_SLOT_NUM; i++) {
+        dma_buffer_free(infer_slots[i]);
+        infer_slots[i] = NULL;
+    }
+    camera_infer_detector = nullptr;
+    camera_infer_callback = nullptr;
+
+    camera_detections_mutex.lock();
+    camera_detections.clear();
+    camera_detections_mutex.unlock();
+}
+
+float HalEsp32::getCameraInferenceFps()
+{
+    return camera_infer_fps.load(std::memory_order_relaxed);
+}
+
+bool HalEsp32::startCameraBarcodeScan(const CameraBarcodeConfig_t& config)
+{
+#if CAMERA_HAS_CODE_SCANNER
+    if (config.maxWidth < 16 || config.maxHeight < 16) {
+        return false;
+    }
+    stopCameraBarcodeScan();
+    mclog::tagInfo(TAG, "start barcode scan, frames up to {}x{}", config.maxWidth, config.maxHeight);
+
+    std::lock_guard<std::mutex> lock(camera_barcode_mutex);
+    for (int i = 0; i < CAMERA_BARCODE_SLOT_NUM; i++) {
+        barcode_slots[i] = (uint8_t*)heap_caps_malloc(config.maxWidth * config.maxHeight, MALLOC_CAP_SPIRAM);
+        if (barcode_slots[i] == NULL) {
+            mclog::tagError(TAG, "failed to allocate barcode frames");
+            for (int j = 0; j <= i; j++) {
+                heap_caps_free(barcode_slots[j]);
+                barcode_slots[j] = NULL;
+            }
+            return false;
+        }
+    }
+    if (sem_barcode_frame == NULL) {
+        sem_barcode_frame = xSemaphoreCreateBinary();
+    }
+    xSemaphoreTake(sem_barcode_frame, 0);
+    barcode_front = 0;
+    barcode_back  = 2;
+    barcode_middle.store(1, std::memory_order_relaxed);
+
+    camera_barcode_config = config;
+    if (!camera_barcode_task.start("cam_qr", 16 * 1024, 4, 0, camera_barcode_loop)) {
+        mclog::tagError(TAG, "barcode task create failed");
+        for (int i = 0; i < CAMERA_BARCODE_SLOT_NUM; i++) {
+            heap_caps_free(barcode_slots[i]);
+            barcode_slots[i] = NULL;
+        }
+        return false;
+    }
+    camera_barcode_is_active.store(true, std::memory_order_release);
+    return true;
+#else
+    mclog::tagError(TAG, "barcode scan needs the esp-code-scanner component");
+    return false;
+#endif
+}
+
+void HalEsp32::stopCameraBarcodeScan()
+{
+    if (!camera_barcode_task.isRunning() && !camera_barcode_is_active.load(std::memory_order_acquire)) {
+        return;
+    }
+    mclog::tagInfo(TAG, "stop barcode scan");
+
+    // The capture task skips the slots once it sees the flag, the mutex waits out a frame in progress
+    camera_barcode_is_active.store(false, std::memory_order_release);
+    camera_barcode_task.stop();
+
+    std::lock_guard<std::mutex> lock(camera_barcode_mutex);
+    for (int i = 0; i < CAMERA_BARCODE_SLOT_NUM; i++) {
+        heap_caps_free(barcode_slots[i]);
+        barcode_slots[i] = NULL;
+    }
+}
+
+bool HalEsp32::isCameraBarcodeScanning()
+{
+    return camera_barcode_is_active.load(std::memory_order_acquire);
+}
+
+hal::HalBase::CameraBarcode_t HalEsp32::getCameraBarcode()
+{
+    std::lock_guard<std::mutex> lock(camera_barcode_result_mutex);
+    return camera_barcode_result;
+}
+
+int HalEsp32::subscribeCameraFrames(const CameraFrameSubscriberConfig_t& config, CameraFrameCallback_t onFrame)
+{
+    if (!onFrame) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(camera_subscribers_mutex);
+    camera_subscriber_t subscriber;
+    subscriber.id       = camera_subscriber_next_id++;
+    subscriber.config   = config;
+    subscriber.callback = std::move(onFrame);
+    subscriber.held     = std::make_shared<std::atomic<uint8_t>>(0);
+    subscriber.last_us  = 0;
+    camera_subscribers.push_back(std::move(subscriber));
+    ESP_LOGI(TAG, "frame subscriber %d, max held %d, max fps %d", camera_subscribers.back().id, config.maxHeld,
+             config.maxFps);
+    return camera_subscribers.back().id;
+}
+
+void HalEsp32::unsubscribeCameraFrames(int id)
+{
+    std::lock_guard<std::mutex> lock(camera_subscribers_mutex);
+    auto it = std::find_if(camera_subscribers.begin(), camera_subscribers.end(),
+                           [id](const camera_subscriber_t& subscriber) { return subscriber.id == id; });
+    if (it == camera_subscribers.end()) {
+        return;
+    }
+    ESP_LOGI(TAG, "frame subscriber %d gone, %" PRIu32 " delivered, %" PRIu32 " dropped", id, it->stats.delivered,
+             it->stats.dropped);
+    camera_subscribers.erase(it);
+}
+
+hal::HalBase::CameraFrameSubscriberStats_t HalEsp32::getCameraFrameSubscriberStats(int id)
+{
+    std::lock_guard<std::mutex> lock(camera_subscribers_mutex);
+    for (const auto& subscriber : camera_subscribers) {
+        if (subscriber.id == id) {
+            return subscriber.stats;
+        }
+    }
+    return {};
+}
+
+bool HalEsp32::cameraSnapshot(const std::string& path)
+{
+    if (!isCameraCapturing()) {
+        mclog::tagError(TAG, "snapshot needs a capture running");
+        return false;
+    }
+    if (!mount_sd_card() || !camera_recorder_init()) {
+        return false;
+    }
+
+    mclog::tagInfo(TAG, "snapshot: {}", path);
+    std::lock_guard<std::mutex> lock(recorder_mutex);
+    strlcpy(snapshot_path, ("/sd/" + path).c_str(), sizeof(snapshot_path));
+    snapshot_pending = true;
+    return true;
+}
+
+bool HalEsp32::startCameraRecording(const std::string& path, uint8_t fps)
+{
+    if (!isCameraCapturing()) {
+        mclog::tagError(TAG, "recording needs a capture running");
+        return false;
+    }
+    if (!mount_sd_card() || !camera_recorder_init()) {
+        return false;
+    }
+
+    mclog::tagInfo(TAG, "start recording: {} @ {}fps", path, fps);
+    std::lock_guard<std::mutex> lock(recorder_mutex);
+    if (is_recording) {
+        camera_recorder_post(RECORDER_JOB_VIDEO_CLOSE, "", 0);
+    }
+    fps = std::max<uint8_t>(fps, 1);
+    camera_recorder_post(RECORDER_JOB_VIDEO_OPEN, "/sd/" + path, fps);
+    record_interval_us = 1000000 / fps;
+    record_last_us     = 0;
+    record_dropped     = 0;
+    is_recording       = true;
+    return true;
+}
+
+void HalEsp32::stopCameraRecording()
+{
+    std::lock_guard<std::mutex> lock(recorder_mutex);
+    if (!is_recording) {
+        return;
+    }
+    mclog::tagInfo(TAG, "stop recording, {} frames dropped by the encoder", record_dropped);
+    is_recording = false;
+    camera_recorder_post(RECORDER_JOB_VIDEO_CLOSE, "", 0);
+}
+
+bool HalEsp32::isCameraRecording()
+{
+    std::lock_guard<std::mutex> lock(recorder_mutex);
+    return is_recording;
+}
+
+bool HalEsp32::startCameraRawCapture(const CameraRawCaptureConfig_t& config)
+{
+    if (config.directory.empty() || config.ringFrames == 0) {
+        mclog::tagError(TAG, "invalid raw capture config");
+        return false;
+    }
+    if (!isCameraCapturing() || camera_config.pixelFormat != CAMERA_PIXEL_FORMAT_RAW8) {
+        mclog::tagError(TAG, "raw capture needs a RAW8 capture running");
+        return false;
+    }
+    if (!mount_sd_card() || !camera_raw_init() || (config.develop && !camera_recorder_init())) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(raw_mutex);
+    if (raw_is_started) {
+        mclog::tagWarn(TAG, "raw capture already running");
+        return false;
+    }
+
+    // One slot per frame, owning its cache lines for the GDMA and the cache sync after it
+    raw_slot_size  = camera_config.width * camera_config.height;
+    raw_slot_count = 0;
+    for (uint8_t i = 0; i < std::min<int>(config.ringFrames, RAW_RING_MAX); i++) {
+        raw_slots[i] = (uint8_t*)dma_buffer_calloc(raw_slot_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA);
+        if (raw_slots[i] == NULL) {
+            break;
+        }
+        xQueueSend(queue_raw_free, &i, 0);
+        raw_slot_count++;
+    }
+    if (raw_slot_count == 0) {
+        mclog::tagError(TAG, "malloc for raw ring failed");
+        return false;
+    }
+    if (raw_slot_count < config.ringFrames) {
+        mclog::tagWarn(TAG, "raw ring holds {} frames", raw_slot_count);
+    }
+
+    std::string directory = "/sd/" + config.directory;
+    mkdir(directory.c_str(), 0777);
+    strlcpy(raw_directory, directory.c_str(), sizeof(raw_directory));
+    raw_config   = config;
+    raw_sequence = 0;
+    raw_captured.store(0, std::memory_order_relaxed);
+    raw_written.store(0, std::memory_order_relaxed);
+    raw_dropped.store(0, std::memory_order_relaxed);
+    raw_developed.store(0, std::memory_order_relaxed);
+
+    if (config.develop && !raw_develop_is_running) {
+        if (xTaskCreatePinnedToCore(camera_raw_develop_task, "cam_raw_dev", 4 * 1024, NULL, 1, NULL, 1) == pdPASS) {
+            raw_develop_is_running = true;
+        } else {
+            mclog::tagWarn(TAG, "develop task create failed, frames stay raw");
+        }
+    }
+
+    mclog::tagInfo(TAG, "start raw capture to {}, {} frame ring", config.directory, raw_slot_count);
+    raw_is_started = true;
+    raw_is_active.store(true, std::memory_order_release);
+    return true;
+}
+
+void HalEsp32::stopCameraRawCapture()
+{
+    std::lock_guard<std::mutex> lock(raw_mutex);
+    if (!raw_is_started) {
+        return;
+    }
+
+    raw_is_active.store(false, std::memory_order_release);
+    camera_raw_detach();
+    // Every slot coming home means the frames still in the ring are on the card
+    uint8_t slot = 0;
+    for (int i = 0; i < raw_slot_count; i++) {
+        xQueueReceive(queue_raw_free, &slot, portMAX_DELAY);
+    }
+    for (int i = 0; i < raw_slot_count; i++) {
+        dma_buffer_free(raw_slots[i]);
+        raw_slots[i] = NULL;
+    }
+    raw_slot_count = 0;
+    raw_is_started = false;
+
+    mclog::tagInfo(TAG, "stop raw capture, {} written, {} dropped", raw_written.load(std::memory_order_relaxed),
+                   raw_dropped.load(std::memory_order_relaxed));
+}
+
+bool HalEsp32::isCameraRawCapturing()
+{
+    return raw_is_active.load(std::memory_order_acquire);
+}
+
+hal::HalBase::CameraRawStats_t HalEsp32::getCameraRawStats()
+{
+    CameraRawStats_t stats;
+    stats.captured  = raw_captured.load(std::memory_order_relaxed);
+    stats.written   = raw_written.load(std::memory_order_relaxed);
+    stats.dropped   = raw_dropped.load(std::memory_order_relaxed);
+    stats.developed = raw_developed.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool HalEsp32::isCameraStreaming()
+{
+    return h264_client_active.load(std::memory_order_acquire);
+}
+
+bool HalEsp32::startUvcCamera()
+{
+    if (!camera_uvc_init()) {
+        return false;
+    }
+    mclog::tagInfo(TAG, "uvc camera enabled");
+    uvc_is_enabled.store(true, std::memory_order_release);
+    return true;
+}
+
+void HalEsp32::stopUvcCamera()
+{
+    mclog::tagInfo(TAG, "uvc camera disabled");
+    uvc_is_enabled.store(false, std::memory_order_release);
+}
+
+bool HalEsp32::isUvcCameraStreaming()
+{
+    return uvc_is_enabled.load(std::memory_order_acquire) && uvc_is_streaming.load(std::memory_order_acquire);
+}
+
+hal::HalBase::CameraStats_t HalEsp32::getCameraStats()
+{
+    CameraStats_t stats;
+    stats.framesDropped = camera_frames_dropped.load(std::memory_order_relaxed);
+    stats.dqbuf         = camera_stats_stage(CAMERA_STAGE_DQBUF);
+    stats.ppa           = camera_stats_stage(CAMERA_STAGE_PPA);
+    stats.present       = camera_stats_stage(CAMERA_STAGE_PRESENT);
+    stats.qbuf          = camera_stats_stage(CAMERA_STAGE_QBUF);
+
+    uint32_t intervals[CAMERA_STATS_RING_SIZE];
+    uint32_t count = camera_stats_collect(CAMERA_STAGE_FRAME, intervals);
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        total += intervals[i];
+    }
+    if (total) {
+        stats.fps = count * 1000000.0f / total;
+    }
+    return stats;
+}
+
+bool HalEsp32::startCameraIspStats(CameraIspStatsCallback_t onStats)
+{
+#if CONFIG_ESP_VIDEO_ENABLE_ISP_PIPELINE_CONTROLLER
+    if (!onStats) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(isp_stats_mutex);
+    camera_isp_stats_unsubscribe();
+    isp_stats_callback = std::move(onStats);
+    camera_isp_stats_subscribe();
+    return true;
+#else
+    mclog::tagError(TAG, "ISP statistics need the ISP pipeline controller");
+    return false;
+#endif
+}
+
+void HalEsp32::stopCameraIspStats()
+{
+    std::lock_guard<std::mutex> lock(isp_stats_mutex);
+    camera_isp_stats_unsubscribe();
+    isp_stats_callback = nullptr;
+}
+
+bool HalEsp32::setCameraImageControl(const CameraImageControl_t& control)
+{
+#if CONFIG_ESP_VIDEO_ENABLE_ISP_PIPELINE_CONTROLLER
+    std::lock_guard<std::mutex> lock(image_control_mutex);
+    image_control        = control;
+    image_control_is_set = true;
+    mclog::tagInfo(TAG, "image control: ae {} awb {} ccm {} ipa {}, {} us x{:.2f}", control.aeLock ? "lock" : "auto",
+                   control.awbLock ? "lock" : "auto", control.ccmLock ? "lock" : "auto",
+                   control.ipaOff ? "off" : "on", control.exposureUs, control.analogGain);
+    return camera_image_control_apply();
+#else
+    mclog::tagError(TAG, "image control needs the ISP pipeline controller");
+    return false;
+#endif
+}
+
+bool HalEsp32::getCameraImageState(CameraImageState_t& state)
+{
+#if CONFIG_ESP_VIDEO_ENABLE_ISP_PIPELINE_CONTROLLER
+    esp_video_isp_state_t isp_state;
+    if (!video_is_initial || esp_video_isp_pipeline_get_state(&isp_state) != ESP_OK) {
+        return false;
+    }
+    state.exposureUs    = isp_state.exposure_us;
+    state.minExposureUs = isp_state.min_exposure_us;
+    state.maxExposureUs = isp_state.max_exposure_us;
+    state.analogGain    = isp_state.gain;
+    state.maxAnalogGain = isp_state.max_gain;
+    state.redGain       = isp_state.red_gain;
+    state.blueGain      = isp_state.blue_gain;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void HalEsp32::setCameraZoom(float zoom, float centerX, float centerY)
+{
+    std::lock_guard<std::mutex> lock(camera_view_mutex);
+    camera_view.zoom     = std::clamp(zoom, 1.0f, CAMERA_ZOOM_MAX);
+    camera_view.center_x = std::clamp(centerX, 0.0f, 1.0f);
+    camera_view.center_y = std::clamp(centerY, 0.0f, 1.0f);
+    camera_view_dirty.store(true, std::memory_order_relaxed);
+}
+
+float HalEsp32::getCameraZoom()
+{
+    std::lock_guard<std::mutex> lock(camera_view_mutex);
+    return camera_view.zoom;
+}
+
+void HalEsp32::setCameraPreviewSize(uint16_t width, uint16_t height)
+{
+    std::lock_guard<std::mutex> lock(camera_view_mutex);
+    camera_view.preview_w = width;
+    camera_view.preview_h = height;
+    camera_view_dirty.store(true, std::memory_order_relaxed);
 }
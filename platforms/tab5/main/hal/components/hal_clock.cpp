@@ -0,0 +1,236 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <shared/shared.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <ctime>
+#include <mutex>
+#include <sys/time.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+static const std::string _tag = "clock";
+
+static constexpr uint8_t _rx8130_addr = 0x32;
+// The RTC only counts whole seconds, around a resync it is polled this often to catch the edge
+static constexpr uint32_t _edge_poll_ms = 5;
+// Larger offsets are stepped, smaller ones slewed with adjtime() so the time never runs backwards
+static constexpr int64_t _step_threshold_us = 500000;
+// The drift estimate is slewed out in steps this long
+static constexpr int64_t _drift_step_us = 60 * 1000000LL;
+// A crystal is well within this, anything beyond is a bad measurement
+static constexpr float _drift_max_ppm = 500.0f;
+
+struct ClockServiceData_t {
+    std::mutex mutex;
+    std::atomic<bool> isRunning{false};
+    std::atomic<bool> isResyncRequested{false};
+    // Given on stop and on a resync request, so the task does not sleep out its second
+    SemaphoreHandle_t wakeSem = nullptr;
+    SemaphoreHandle_t exitSem = nullptr;
+    hal::HalBase::ClockServiceConfig_t config;
+    std::mutex statsMutex;
+    hal::HalBase::ClockStats_t stats;
+};
+static ClockServiceData_t _clock_data;
+
+static int64_t system_time_us()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static void slew_system_time(int64_t deltaUs)
+{
+    struct timeval delta;
+    delta.tv_sec  = deltaUs / 1000000;
+    delta.tv_usec = deltaUs % 1000000;
+    adjtime(&delta, NULL);
+}
+
+void HalEsp32::clock_service_task(void* param)
+{
+    static_cast<HalEsp32*>(param)->clock_service_loop();
+
+    xSemaphoreGive(_clock_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Measure the RTC against the system time on the edge of an RTC second and correct the system time
+ *
+ * @param lastSyncUs esp_timer time of the previous resync, 0 for none
+ * @param driftPpm estimate, refined by the offset left since the previous resync
+ * @return false if the RTC could not be read
+ */
+bool HalEsp32::clock_resync(int64_t lastSyncUs, float& driftPpm)
+{
+    struct tm rtc_time = {};
+    int last_sec       = -1;
+    int64_t sys_us     = 0;
+    int64_t deadline   = esp_timer_get_time() + 1500000;
+    while (true) {
+        struct tm sample = {};
+        bool ok          = i2cScheduler().run(I2cBusScheduler::PRIORITY_SENSOR, _rx8130_addr, [&]() {
+            rx8130.getTime(&sample);
+            return true;
+        });
+        sys_us = system_time_us();
+        if (!ok || esp_timer_get_time() > deadline) {
+            mclog::tagWarn(_tag, "no rtc second edge");
+            return false;
+        }
+        if (last_sec >= 0 && sample.tm_sec != last_sec) {
+            rtc_time = sample;
+            break;
+        }
+        last_sec = sample.tm_sec;
+        vTaskDelay(pdMS_TO_TICKS(_edge_poll_ms));
+    }
+
+    // The edge was on average half a poll before it was seen
+    int64_t rtc_us    = (int64_t)mktime(&rtc_time) * 1000000 + _edge_poll_ms * 500;
+    int64_t offset_us = rtc_us - sys_us;
+    int64_t now_us    = esp_timer_get_time();
+
+    if (lastSyncUs == 0 || std::abs(offset_us) > _step_threshold_us) {
+        // First sync or the time was set, stepped and the drift measurement starts over
+        struct timeval tv;
+        int64_t target = system_time_us() + offset_us;
+        tv.tv_sec      = target / 1000000;
+        tv.tv_usec     = target % 1000000;
+        settimeofday(&tv, NULL);
+        driftPpm = lastSyncUs == 0 ? driftPpm : 0.0f;
+    } else {
+        // What is left after the drift slews is the error of the estimate
+        float residual_ppm = offset_us * 1000000.0f / (now_us - lastSyncUs);
+        driftPpm           = std::clamp(driftPpm + residual_ppm, -_drift_max_ppm, _drift_max_ppm);
+        slew_system_time(offset_us);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_clock_data.statsMutex);
+        _clock_data.stats.resyncs++;
+        _clock_data.stats.lastOffsetUs = (int32_t)std::clamp<int64_t>(offset_us, INT32_MIN, INT32_MAX);
+        _clock_data.stats.driftPpm     = driftPpm;
+    }
+    mclog::tagInfo(_tag, "resync, offset {} us, drift {:.1f} ppm", offset_us, driftPpm);
+    return true;
+}
+
+void HalEsp32::clock_service_loop()
+{
+    const auto& config   = _clock_data.config;
+    int64_t interval_us  = std::max<int64_t>(config.resyncIntervalMin, 1) * 60 * 1000000LL;
+    int64_t last_sync_us = 0;
+    int64_t last_slew_us = 0;
+    float drift_ppm      = 0.0f;
+    int last_minute      = -1;
+
+    while (_clock_data.isRunning) {
+        int64_t mono_us = esp_timer_get_time();
+        bool is_resync  = _clock_data.isResyncRequested.exchange(false);
+        if (is_resync) {
+            last_sync_us = 0;
+        }
+        if (last_sync_us == 0 || mono_us - last_sync_us >= interval_us) {
+            if (clock_resync(last_sync_us, drift_ppm) || last_sync_us == 0) {
+                last_sync_us = esp_timer_get_time();
+                last_slew_us = last_sync_us;
+            }
+        } else if (drift_ppm != 0.0f && mono_us - last_slew_us >= _drift_step_us) {
+            slew_system_time((int64_t)(drift_ppm * (mono_us - last_slew_us) / 1000000.0f));
+            last_slew_us = mono_us;
+        }
+
+        // Slept to just past the next second of the system time, early on a stop or a resync request
+        int64_t now_us   = system_time_us();
+        uint32_t wait_ms = (1000000 - now_us % 1000000) / 1000 + 1;
+        if (xSemaphoreTake(_clock_data.wakeSem, pdMS_TO_TICKS(wait_ms)) == pdTRUE) {
+            continue;
+        }
+
+        time_t now = system_time_us() / 1000000;
+        struct tm local;
+        localtime_r(&now, &local);
+        bool is_minute = local.tm_min != last_minute;
+        last_minute    = local.tm_min;
+        if (!is_minute && !config.secondTicks) {
+            continue;
+        }
+        GetEventBus().publish({shared_data::EVENT_TOPIC_CLOCK,
+                               is_minute ? shared_data::EVENT_CLOCK_MINUTE : shared_data::EVENT_CLOCK_SECOND,
+                               (int32_t)now});
+        wakeAppLoop();
+    }
+}
+
+void HalEsp32::clock_service_request_resync()
+{
+    if (!_clock_data.isRunning) {
+        return;
+    }
+    _clock_data.isResyncRequested = true;
+    xSemaphoreGive(_clock_data.wakeSem);
+}
+
+bool HalEsp32::startClockService(const ClockServiceConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_clock_data.mutex);
+
+    if (_clock_data.isRunning) {
+        return true;
+    }
+
+    _clock_data.config            = config;
+    _clock_data.isResyncRequested = false;
+    if (_clock_data.exitSem == nullptr) {
+        _clock_data.exitSem = xSemaphoreCreateBinary();
+        _clock_data.wakeSem = xSemaphoreCreateBinary();
+    }
+    xSemaphoreTake(_clock_data.wakeSem, 0);
+
+    _clock_data.isRunning = true;
+    if (xTaskCreate(clock_service_task, "clock", 4096, this, 3, nullptr) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _clock_data.isRunning = false;
+        return false;
+    }
+
+    mclog::tagInfo(_tag, "start, resync every {} min", config.resyncIntervalMin);
+    return true;
+}
+
+void HalEsp32::stopClockService()
+{
+    std::lock_guard<std::mutex> lock(_clock_data.mutex);
+
+    if (!_clock_data.isRunning) {
+        return;
+    }
+
+    _clock_data.isRunning = false;
+    xSemaphoreGive(_clock_data.wakeSem);
+    xSemaphoreTake(_clock_data.exitSem, portMAX_DELAY);
+    mclog::tagInfo(_tag, "stop");
+}
+
+bool HalEsp32::isClockServiceRunning()
+{
+    return _clock_data.isRunning;
+}
+
+hal::HalBase::ClockStats_t HalEsp32::getClockStats()
+{
+    std::lock_guard<std::mutex> lock(_clock_data.statsMutex);
+    return _clock_data.stats;
+}
@@ -0,0 +1,293 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <shared/shared.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <time.h>
+#include <bsp/m5stack_tab5.h>
+#include <esp_err.h>
+#include <esp_timer.h>
+#include <nvs_flash.h>
+#include <nvs.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static const std::string _tag = "duty_cycle";
+
+static const char* _nvs_namespace = "duty_cycle";
+
+static constexpr uint8_t _rx8130_addr = 0x32;
+static constexpr uint8_t _ina226_addr = 0x41;
+// RX8130 flag register and its timer flag, set when the countdown that powered the board on ran out
+static constexpr uint8_t _rtc_reg_flag = 0x1D;
+static constexpr uint8_t _rtc_flag_tf  = 1 << 4;
+// Two output periods of the IMU at its default rate, the first reading after enable is not valid before
+static constexpr uint32_t _imu_settle_ms = 20;
+// Four averages of both conversions take 8.8 ms
+static constexpr uint32_t _ina226_timeout_ms = 50;
+// On top of the response timeout, for the request on the line and the port coming up
+static constexpr uint32_t _modbus_margin_ms = 50;
+
+// The config as saved to NVS, the log path is stored next to it as a string
+struct DutyCycleRecord_t {
+    uint16_t intervalSec     = 0;
+    bool withPowerMonitor    = false;
+    bool withImu             = false;
+    bool withModbus          = false;
+    uint16_t modbusTimeoutMs = 0;
+    hal::HalBase::Rs485Config_t modbusPort;
+    hal::HalBase::ModbusPoll_t modbusPoll;
+};
+
+struct DutyCycleMeasurement_t {
+    bool hasPower = false;
+    hal::HalBase::PMData_t power;
+    bool hasImu = false;
+    hal::HalBase::IMUData_t imu;
+    bool hasModbus = false;
+    std::vector<uint16_t> modbus;
+};
+
+static void nvs_init()
+{
+    esp_err_t ret = nvs_flash_init();
+    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        ESP_ERROR_CHECK(nvs_flash_erase());
+        ret = nvs_flash_init();
+    }
+    ESP_ERROR_CHECK(ret);
+}
+
+static bool load_record(DutyCycleRecord_t& record, std::string& logPath)
+{
+    nvs_handle_t handle;
+    if (nvs_open(_nvs_namespace, NVS_READONLY, &handle) != ESP_OK) {
+        return false;
+    }
+
+    // A record from a firmware with another layout is dropped like a missing one
+    char path[128]     = {};
+    size_t record_size = sizeof(record);
+    size_t path_size   = sizeof(path);
+    bool is_ok = nvs_get_blob(handle, "config", &record, &record_size) == ESP_OK && record_size == sizeof(record) &&
+                 nvs_get_str(handle, "log", path, &path_size) == ESP_OK;
+    nvs_close(handle);
+    logPath = path;
+    return is_ok;
+}
+
+static bool save_record(const DutyCycleRecord_t& record, const std::string& logPath)
+{
+    nvs_handle_t handle;
+    if (nvs_open(_nvs_namespace, NVS_READWRITE, &handle) != ESP_OK) {
+        return false;
+    }
+    bool is_ok = nvs_set_blob(handle, "config", &record, sizeof(record)) == ESP_OK &&
+                 nvs_set_str(handle, "log", logPath.c_str()) == ESP_OK && nvs_commit(handle) == ESP_OK;
+    nvs_close(handle);
+    return is_ok;
+}
+
+static void erase_record()
+{
+    nvs_handle_t handle;
+    if (nvs_open(_nvs_namespace, NVS_READWRITE, &handle) != ESP_OK) {
+        return;
+    }
+    nvs_erase_all(handle);
+    nvs_commit(handle);
+    nvs_close(handle);
+}
+
+// Through a device of its own, the rx8130 driver is only set up by the boot stage
+static bool read_rtc_flags(uint8_t& flags)
+{
+    i2c_device_config_t dev_cfg = {};
+    dev_cfg.dev_addr_length     = I2C_ADDR_BIT_LEN_7;
+    dev_cfg.device_address      = _rx8130_addr;
+    dev_cfg.scl_speed_hz        = 400000;
+    i2c_master_dev_handle_t dev = nullptr;
+    if (i2c_master_bus_add_device(bsp_i2c_get_handle(), &dev_cfg, &dev) != ESP_OK) {
+        return false;
+    }
+    uint8_t reg   = _rtc_reg_flag;
+    esp_err_t ret = i2c_master_transmit_receive(dev, &reg, 1, &flags, 1, 50);
+    i2c_master_bus_rm_device(dev);
+    return ret == ESP_OK;
+}
+
+// One request through the Modbus master, its schedule sends the poll as soon as it starts
+static bool poll_modbus(HalEsp32& hal, const DutyCycleRecord_t& record, std::vector<uint16_t>& values)
+{
+    hal::HalBase::ModbusConfig_t config;
+    config.port                = record.modbusPort;
+    config.responseTimeoutMs   = record.modbusTimeoutMs;
+    config.polls               = {record.modbusPoll};
+    config.polls[0].intervalMs = UINT16_MAX;
+    if (!hal.startModbus(config)) {
+        return false;
+    }
+
+    bool is_ok       = false;
+    int64_t deadline = esp_timer_get_time() + (record.modbusTimeoutMs + _modbus_margin_ms) * 1000;
+    while (esp_timer_get_time() < deadline) {
+        {
+            auto& modbus = GetModbusData();
+            std::lock_guard<std::mutex> lock(modbus.mutex);
+            const auto& result = modbus.polls[0];
+            if (result.updateTime != 0) {
+                values = result.values;
+                is_ok  = true;
+                break;
+            }
+            if (result.errorCount != 0) {
+                break;
+            }
+        }
+        vTaskDelay(1);
+    }
+    hal.stopModbus();
+    return is_ok;
+}
+
+static bool append_log(const std::string& logPath, const struct tm& rtcTime, uint32_t bootMs, uint32_t measureMs,
+                       const DutyCycleMeasurement_t& m)
+{
+    FILE* file = fopen(logPath.c_str(), "a");
+    if (file == nullptr) {
+        return false;
+    }
+    if (ftell(file) == 0) {
+        fputs("time,boot_ms,measure_ms,bus_voltage,shunt_current,accel_x,accel_y,accel_z,gyro_x,gyro_y,gyro_z,modbus\n",
+              file);
+    }
+
+    char time_str[24];
+    strftime(time_str, sizeof(time_str), "%Y-%m-%dT%H:%M:%S", &rtcTime);
+    fprintf(file, "%s,%lu,%lu,", time_str, (unsigned long)bootMs, (unsigned long)measureMs);
+    if (m.hasPower) {
+        fprintf(file, "%.3f,%.4f,", m.power.busVoltage, m.power.shuntCurrent);
+    } else {
+        fputs(",,", file);
+    }
+    if (m.hasImu) {
+        fprintf(file, "%.4f,%.4f,%.4f,%.3f,%.3f,%.3f,", m.imu.accelX, m.imu.accelY, m.imu.accelZ, m.imu.gyroX,
+                m.imu.gyroY, m.imu.gyroZ);
+    } else {
+        fputs(",,,,,,", file);
+    }
+    // Registers space separated in the one column
+    for (size_t i = 0; m.hasModbus && i < m.modbus.size(); i++) {
+        fprintf(file, i == 0 ? "%u" : " %u", m.modbus[i]);
+    }
+    fputc('\n', file);
+    return fclose(file) == 0;
+}
+
+bool HalEsp32::startDutyCycle(const DutyCycleConfig_t& config)
+{
+    if (config.intervalSec == 0) {
+        mclog::tagError(_tag, "interval must be at least 1 s");
+        return false;
+    }
+
+    DutyCycleRecord_t record;
+    record.intervalSec      = config.intervalSec;
+    record.withPowerMonitor = config.withPowerMonitor;
+    record.withImu          = config.withImu;
+    record.withModbus       = config.withModbus;
+    record.modbusTimeoutMs  = config.modbusTimeoutMs;
+    record.modbusPort       = config.modbusPort;
+    record.modbusPoll       = config.modbusPoll;
+    nvs_init();
+    if (!save_record(record, config.logPath)) {
+        mclog::tagError(_tag, "save config failed");
+        return false;
+    }
+
+    mclog::tagInfo(_tag, "start, wake every {} s, log to {}", config.intervalSec, config.logPath);
+    clearRtcIrq();
+    clearImuIrq();
+    rx8130.setTimerIrq(config.intervalSec);
+
+    powerOff();
+    while (1) {
+        delay(100);
+    }
+}
+
+void HalEsp32::duty_cycle_wake()
+{
+    DutyCycleRecord_t record;
+    std::string log_path;
+    nvs_init();
+    if (!load_record(record, log_path)) {
+        return;
+    }
+
+    // The timer keeps counting while the board is on, only its flag tells a timer wake from the power button
+    bsp_i2c_init();
+    uint8_t rtc_flags = 0;
+    if (!read_rtc_flags(rtc_flags) || !(rtc_flags & _rtc_flag_tf)) {
+        // The rtc boot stage turns the timer interrupt off
+        mclog::tagInfo(_tag, "not a timer wake, cycle ended");
+        erase_record();
+        return;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+    rx8130.begin(bsp_i2c_get_handle(), _rx8130_addr);
+    struct tm rtc_time = {};
+    rx8130.getTime(&rtc_time);
+    // The IRQ line held low would power the board straight back on, the countdown itself reloads
+    rx8130.clearIrqFlags();
+
+    DutyCycleMeasurement_t m;
+    if (record.withPowerMonitor) {
+        ina226.begin(bsp_i2c_get_handle(), _ina226_addr);
+        ina226.configure(INA226_AVERAGES_4, INA226_BUS_CONV_TIME_1100US, INA226_SHUNT_CONV_TIME_1100US,
+                         INA226_MODE_SHUNT_BUS_CONT);
+        ina226.calibrate(0.005, 8.192);
+        int64_t deadline = esp_timer_get_time() + _ina226_timeout_ms * 1000;
+        while (!ina226.isConversionReady() && esp_timer_get_time() < deadline) {
+            vTaskDelay(1);
+        }
+        m.power.busVoltage   = ina226.readBusVoltage();
+        m.power.shuntCurrent = ina226.readShuntCurrent();
+        m.power.busPower     = m.power.busVoltage * m.power.shuntCurrent;
+        m.hasPower           = true;
+    }
+    if (record.withImu) {
+        imu_init();
+        delay(_imu_settle_ms);
+        read_imu_data(m.imu);
+        m.hasImu = true;
+    }
+    if (record.withModbus) {
+        m.hasModbus = poll_modbus(*this, record, m.modbus);
+        if (!m.hasModbus) {
+            mclog::tagWarn(_tag, "no modbus response");
+        }
+    }
+    int64_t measured_us = esp_timer_get_time();
+
+    // The boot time is up to this function, the ROM and the bootloader come before the timer starts
+    uint32_t boot_ms    = start_us / 1000;
+    uint32_t measure_ms = (measured_us - start_us) / 1000;
+    if (!mount_sd_card() || !append_log(log_path, rtc_time, boot_ms, measure_ms, m)) {
+        mclog::tagError(_tag, "append to {} failed", log_path);
+    }
+
+    mclog::tagInfo(_tag, "cycle done in {} ms: boot {} ms, measure {} ms, log {} ms",
+                   esp_timer_get_time() / 1000, boot_ms, measure_ms, (esp_timer_get_time() - measured_us) / 1000);
+    bsp_generate_poweroff_signal();
+    while (1) {
+        delay(100);
+    }
+}
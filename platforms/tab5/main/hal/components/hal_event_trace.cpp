@@ -0,0 +1,134 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include "../utils/event_trace/event_trace.h"
+#include <mooncake_log.h>
+#include <mutex>
+#include <stdio.h>
+#include <esp_http_server.h>
+#include <esp_lvgl_port.h>
+
+static const std::string _tag = "event-trace";
+
+struct EventTraceData_t {
+    std::mutex mutex;
+    // The display hook stays in once installed, it costs one load while not recording. The lv_timer_handler() hook is
+    // installed with the display in hal_esp32.cpp
+    bool isHooked = false;
+};
+static EventTraceData_t _event_trace_data;
+
+static void on_lvgl_display_event(lv_event_t* e)
+{
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_REFR_START:
+            TRACE_BEGIN("lvgl refresh");
+            break;
+        case LV_EVENT_REFR_READY:
+            TRACE_END("lvgl refresh");
+            break;
+        case LV_EVENT_FLUSH_START:
+            TRACE_BEGIN("lvgl flush");
+            break;
+        case LV_EVENT_FLUSH_FINISH:
+            TRACE_END("lvgl flush");
+            break;
+        case LV_EVENT_FLUSH_WAIT_START:
+            TRACE_BEGIN("lvgl flush wait");
+            break;
+        case LV_EVENT_FLUSH_WAIT_FINISH:
+            TRACE_END("lvgl flush wait");
+            break;
+        default:
+            break;
+    }
+}
+
+static bool write_file(const char* data, size_t size, void* ctx)
+{
+    return fwrite(data, 1, size, static_cast<FILE*>(ctx)) == size;
+}
+
+static esp_err_t trace_get_handler(httpd_req_t* req)
+{
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=\"m5tab5-trace.json\"");
+    auto write = [](const char* data, size_t size, void* ctx) {
+        return httpd_resp_send_chunk(static_cast<httpd_req_t*>(ctx), data, size) == ESP_OK;
+    };
+    if (!EventTrace::write(write, req)) {
+        // Nothing was sent yet when there is nothing recorded
+        if (EventTrace::getStats().events == 0) {
+            httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "no events recorded");
+            return ESP_OK;
+        }
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, nullptr, 0);
+}
+
+// Called by start_webserver() in hal_wifi.cpp
+void event_trace_register_handlers(httpd_handle_t server)
+{
+    static httpd_uri_t get_uri = {};
+    get_uri.uri                = "/api/trace";
+    get_uri.method             = HTTP_GET;
+    get_uri.handler            = trace_get_handler;
+    httpd_register_uri_handler(server, &get_uri);
+}
+
+bool HalEsp32::startEventTrace(const EventTraceConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_event_trace_data.mutex);
+
+    if (!EventTrace::start(config.bufferKb * 1024)) {
+        return false;
+    }
+
+    if (!_event_trace_data.isHooked && lvDisp != nullptr) {
+        lvglLock();
+        lv_display_add_event_cb(lvDisp, on_lvgl_display_event, LV_EVENT_ALL, nullptr);
+        lvglUnlock();
+        _event_trace_data.isHooked = true;
+    }
+    return true;
+}
+
+void HalEsp32::stopEventTrace()
+{
+    std::lock_guard<std::mutex> lock(_event_trace_data.mutex);
+    EventTrace::stop();
+    mclog::tagInfo(_tag, "stop, {} events", EventTrace::getStats().events);
+}
+
+hal::HalBase::EventTraceStats_t HalEsp32::getEventTraceStats()
+{
+    auto trace_stats = EventTrace::getStats();
+
+    EventTraceStats_t stats;
+    stats.isRecording = trace_stats.isRecording;
+    stats.capacity    = trace_stats.capacity;
+    stats.events      = trace_stats.events;
+    return stats;
+}
+
+bool HalEsp32::exportEventTrace(const std::string& path)
+{
+    if (path.empty()) {
+        return EventTrace::write(write_file, stdout);
+    }
+
+    FILE* file = fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        mclog::tagError(_tag, "open {} failed", path);
+        return false;
+    }
+    bool is_ok = EventTrace::write(write_file, file);
+    is_ok      = fclose(file) == 0 && is_ok;
+    mclog::tagInfo(_tag, "export to {} {}", path, is_ok ? "done" : "failed");
+    return is_ok;
+}
@@ -0,0 +1,238 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <hal/snapshot.h>
+#include "../utils/ext_sensor/ext_sensor.h"
+#include "../utils/task_controller/task_controller.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <bsp/m5stack_tab5.h>
+#include <driver/i2c_master.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static const std::string _tag = "ext-sensor";
+
+// Tick of the poll schedule, the unit intervals are rounded up to it
+static constexpr uint32_t _tick_ms      = 10;
+static constexpr int _probe_timeout_ms  = 5;
+static constexpr int _xfer_timeout_ms   = 20;
+static constexpr uint32_t _scl_speed_hz = 100000;
+
+static_assert(ExtSensorDriver::MaxValues <= sizeof(hal::HalBase::ExtSensorReading_t::values) / sizeof(float),
+              "reading holds every value of a driver");
+
+struct ExtSensorUnit_t {
+    std::unique_ptr<ExtSensorDriver> driver;
+    i2c_master_dev_handle_t device = nullptr;
+    // millis() of the last trigger or read, 0 before the first
+    uint32_t lastTime = 0;
+    std::atomic<uint32_t> reads{0};
+    std::atomic<uint32_t> errors{0};
+    Snapshot<hal::HalBase::ExtSensorReading_t> snapshot;
+};
+
+struct ExtSensorData_t {
+    std::mutex mutex;
+    TaskController_t task;
+    // Only changed by start and stop, while the task is not running
+    std::vector<std::unique_ptr<ExtSensorUnit_t>> units;
+};
+static ExtSensorData_t _ext_sensor_data;
+
+static bool is_due(uint32_t now, uint32_t lastTime, uint16_t intervalMs)
+{
+    return lastTime == 0 || now - lastTime >= intervalMs;
+}
+
+static bool write_command(ExtSensorUnit_t& unit, const std::vector<uint8_t>& command)
+{
+    return i2c_master_transmit(unit.device, command.data(), command.size(), _xfer_timeout_ms) == ESP_OK;
+}
+
+static void read_unit(ExtSensorUnit_t& unit)
+{
+    const auto& layout = unit.driver->layout();
+    uint8_t raw[ExtSensorDriver::MaxReadSize];
+    esp_err_t ret;
+    if (layout.reg >= 0) {
+        uint8_t reg = layout.reg;
+        ret         = i2c_master_transmit_receive(unit.device, &reg, 1, raw, layout.readSize, _xfer_timeout_ms);
+    } else {
+        ret = i2c_master_receive(unit.device, raw, layout.readSize, _xfer_timeout_ms);
+    }
+
+    hal::HalBase::ExtSensorReading_t reading;
+    reading.count = layout.valueNames.size();
+    if (ret != ESP_OK || !unit.driver->decode(raw, reading.values)) {
+        unit.errors++;
+        return;
+    }
+    unit.reads++;
+    unit.snapshot.publish(reading, GetHAL()->millis());
+}
+
+static void _ext_sensor_loop(TaskController_t& task)
+{
+    auto& units = _ext_sensor_data.units;
+    std::vector<ExtSensorUnit_t*> due;
+
+    while (task.sleep(pdMS_TO_TICKS(_tick_ms))) {
+        // Every due unit is triggered first, so their conversions overlap and the tick waits once for the slowest
+        uint32_t now       = GetHAL()->millis();
+        uint16_t max_delay = 0;
+        due.clear();
+        for (auto& unit : units) {
+            const auto& layout = unit->driver->layout();
+            if (!is_due(now, unit->lastTime, layout.intervalMs)) {
+                continue;
+            }
+            unit->lastTime = now;
+            if (!layout.trigger.empty() && !write_command(*unit, layout.trigger)) {
+                unit->errors++;
+                continue;
+            }
+            due.push_back(unit.get());
+            max_delay = std::max(max_delay, layout.triggerDelayMs);
+        }
+        if (due.empty()) {
+            continue;
+        }
+
+        if (max_delay > 0 && !task.sleep(pdMS_TO_TICKS(max_delay) + 1)) {
+            break;
+        }
+        for (auto unit : due) {
+            read_unit(*unit);
+        }
+    }
+}
+
+// Lock _ext_sensor_data.mutex before calling, the task is not running
+static void remove_units()
+{
+    for (auto& unit : _ext_sensor_data.units) {
+        i2c_master_bus_rm_device(unit->device);
+    }
+    _ext_sensor_data.units.clear();
+}
+
+bool HalEsp32::startExtSensors()
+{
+    auto& data = _ext_sensor_data;
+    std::lock_guard<std::mutex> lock(data.mutex);
+
+    if (data.task.isRunning()) {
+        return true;
+    }
+
+    initPortAI2c();
+    i2c_master_bus_handle_t bus = bsp_ext_i2c_get_handle();
+    if (bus == nullptr) {
+        mclog::tagError(_tag, "port a not initialized");
+        return false;
+    }
+
+    // Only the addresses some driver is registered for
+    auto& registry = ExtSensorRegistry::instance();
+    std::vector<uint8_t> found;
+    for (uint8_t address : registry.addresses()) {
+        if (i2c_master_probe(bus, address, _probe_timeout_ms) == ESP_OK) {
+            found.push_back(address);
+        }
+    }
+
+    for (auto& driver : registry.bind(found)) {
+        auto unit = std::make_unique<ExtSensorUnit_t>();
+
+        i2c_device_config_t device_config = {};
+        device_config.dev_addr_length     = I2C_ADDR_BIT_LEN_7;
+        device_config.device_address      = driver->layout().address;
+        device_config.scl_speed_hz        = _scl_speed_hz;
+        if (i2c_master_bus_add_device(bus, &device_config, &unit->device) != ESP_OK) {
+            mclog::tagError(_tag, "add {} failed", driver->name());
+            continue;
+        }
+        unit->driver = std::move(driver);
+        if (!unit->driver->layout().initCommand.empty() && !write_command(*unit, unit->driver->layout().initCommand)) {
+            mclog::tagWarn(_tag, "{} at 0x{:02X} did not take its init command", unit->driver->name(),
+                           unit->driver->layout().address);
+            i2c_master_bus_rm_device(unit->device);
+            continue;
+        }
+        mclog::tagInfo(_tag, "bound {} at 0x{:02X}, every {} ms", unit->driver->name(), unit->driver->layout().address,
+                       unit->driver->layout().intervalMs);
+        data.units.push_back(std::move(unit));
+    }
+
+    if (data.units.empty()) {
+        mclog::tagInfo(_tag, "no known unit on port a");
+        deinitPortAI2c();
+        return false;
+    }
+
+    if (!data.task.start("ext_sensor", 4096, 4, -1, _ext_sensor_loop)) {
+        mclog::tagError(_tag, "create task failed");
+        remove_units();
+        deinitPortAI2c();
+        return false;
+    }
+    return true;
+}
+
+void HalEsp32::stopExtSensors()
+{
+    auto& data = _ext_sensor_data;
+    std::lock_guard<std::mutex> lock(data.mutex);
+
+    if (!data.task.isRunning()) {
+        return;
+    }
+
+    // The task finishes the reads of its current tick
+    data.task.stop();
+    remove_units();
+    deinitPortAI2c();
+    mclog::tagInfo(_tag, "stop");
+}
+
+bool HalEsp32::isExtSensorsRunning()
+{
+    return _ext_sensor_data.task.isRunning();
+}
+
+std::vector<hal::HalBase::ExtSensorInfo_t> HalEsp32::getExtSensors()
+{
+    std::lock_guard<std::mutex> lock(_ext_sensor_data.mutex);
+
+    std::vector<ExtSensorInfo_t> result;
+    for (const auto& unit : _ext_sensor_data.units) {
+        const auto& layout = unit->driver->layout();
+        ExtSensorInfo_t info;
+        info.name       = unit->driver->name();
+        info.address    = layout.address;
+        info.intervalMs = layout.intervalMs;
+        info.valueNames.assign(layout.valueNames.begin(), layout.valueNames.end());
+        info.reads  = unit->reads;
+        info.errors = unit->errors;
+        result.push_back(info);
+    }
+    return result;
+}
+
+bool HalEsp32::readExtSensor(size_t index, ExtSensorReading_t& reading, uint32_t* timeMs)
+{
+    std::lock_guard<std::mutex> lock(_ext_sensor_data.mutex);
+
+    if (index >= _ext_sensor_data.units.size()) {
+        return false;
+    }
+    return _ext_sensor_data.units[index]->snapshot.read(reading, nullptr, timeMs);
+}
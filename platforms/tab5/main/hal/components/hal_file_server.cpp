@@ -0,0 +1,406 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <string>
+#include <ctype.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <esp_heap_caps.h>
+#include <esp_http_server.h>
+#include <esp_timer.h>
+
+static const std::string _tag = "file-server";
+
+static const char* _uri_prefix = "/sd";
+// A multiple of the cluster size, FATFS reads whole clusters straight into it without the sector buffer
+static constexpr size_t _buffer_size = 32 * 1024;
+// Cache line of the ESP32-P4, the SDMMC DMA reads into it without a bounce copy
+static constexpr size_t _buffer_align = 64;
+// Requests waiting for the transfer task, later ones are refused
+static constexpr int _queue_size       = 4;
+static constexpr size_t _scan_page_size = 32;
+// A listing that gets no page for this long is given up
+static constexpr uint32_t _scan_timeout_ms = 5000;
+
+struct FileServerData_t {
+    QueueHandle_t queue = nullptr;
+    TaskHandle_t task   = nullptr;
+};
+static FileServerData_t _file_server_data;
+
+struct ByteRange_t {
+    int64_t start = 0;
+    int64_t end   = 0;
+};
+
+// %XX decoded, the query dropped, false for anything that could leave the mount point
+static bool decode_uri_path(const char* uri, std::string& path)
+{
+    path.clear();
+    for (const char* p = uri; *p && *p != '?' && *p != '#'; p++) {
+        if (*p == '%' && isxdigit((unsigned char)p[1]) && isxdigit((unsigned char)p[2])) {
+            char hex[3] = {p[1], p[2], 0};
+            path += (char)strtol(hex, nullptr, 16);
+            p += 2;
+        } else {
+            path += *p;
+        }
+    }
+    if (path.find('\0') != std::string::npos || path.find("/../") != std::string::npos ||
+        (path.size() >= 3 && path.compare(path.size() - 3, 3, "/..") == 0)) {
+        return false;
+    }
+    while (path.size() > strlen(_uri_prefix) && path.back() == '/') {
+        path.pop_back();
+    }
+    return true;
+}
+
+static std::string url_encode(const std::string& text)
+{
+    static const char* digits = "0123456789ABCDEF";
+    std::string encoded;
+    for (unsigned char c : text) {
+        if (isalnum(c) || strchr("-_.~/", c)) {
+            encoded += c;
+        } else {
+            encoded += '%';
+            encoded += digits[c >> 4];
+            encoded += digits[c & 0x0F];
+        }
+    }
+    return encoded;
+}
+
+static std::string html_escape(const std::string& text)
+{
+    std::string escaped;
+    for (char c : text) {
+        switch (c) {
+            case '&':
+                escaped += "&amp;";
+                break;
+            case '<':
+                escaped += "&lt;";
+                break;
+            case '>':
+                escaped += "&gt;";
+                break;
+            case '"':
+                escaped += "&quot;";
+                break;
+            default:
+                escaped += c;
+        }
+    }
+    return escaped;
+}
+
+static const char* content_type_of(const std::string& path)
+{
+    static const struct {
+        const char* ext;
+        const char* type;
+    } types[] = {
+        {".html", "text/html"},
+        {".txt", "text/plain"},
+        {".log", "text/plain"},
+        {".csv", "text/csv"},
+        {".json", "application/json"},
+        {".jpg", "image/jpeg"},
+        {".jpeg", "image/jpeg"},
+        {".png", "image/png"},
+        {".bmp", "image/bmp"},
+        {".mp4", "video/mp4"},
+        {".avi", "video/x-msvideo"},
+        {".h264", "video/h264"},
+        {".wav", "audio/wav"},
+        {".mp3", "audio/mpeg"},
+    };
+    size_t dot = path.find_last_of('.');
+    if (dot != std::string::npos) {
+        for (const auto& item : types) {
+            if (strcasecmp(path.c_str() + dot, item.ext) == 0) {
+                return item.type;
+            }
+        }
+    }
+    return "application/octet-stream";
+}
+
+// One range of "bytes=a-b", "bytes=a-" or "bytes=-n". 1 for a range, 0 to send the whole file (no header or a form
+// not handled, which HTTP allows to ignore) and -1 when it lies past the end
+static int parse_range(const char* header, int64_t size, ByteRange_t& range)
+{
+    if (strncmp(header, "bytes=", 6) != 0 || strchr(header, ',') != nullptr) {
+        return 0;
+    }
+    const char* spec = header + 6;
+    char* end        = nullptr;
+    if (*spec == '-') {
+        int64_t suffix = strtoll(spec + 1, &end, 10);
+        if (end == spec + 1 || *end != '\0') {
+            return 0;
+        }
+        if (suffix <= 0 || size == 0) {
+            return -1;
+        }
+        range.start = std::max<int64_t>(size - suffix, 0);
+        range.end   = size - 1;
+        return 1;
+    }
+
+    range.start = strtoll(spec, &end, 10);
+    if (end == spec || *end != '-') {
+        return 0;
+    }
+    const char* last = end + 1;
+    if (*last == '\0') {
+        range.end = size - 1;
+    } else {
+        range.end = strtoll(last, &end, 10);
+        if (*end != '\0' || range.end < range.start) {
+            return 0;
+        }
+        range.end = std::min(range.end, size - 1);
+    }
+    return range.start < size ? 1 : -1;
+}
+
+// Internal RAM first, PSRAM when there is not that much of it left
+static uint8_t* alloc_buffer()
+{
+    auto buffer = (uint8_t*)heap_caps_aligned_alloc(_buffer_align, _buffer_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    if (buffer == nullptr) {
+        buffer = (uint8_t*)heap_caps_aligned_alloc(_buffer_align, _buffer_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA);
+    }
+    return buffer;
+}
+
+static esp_err_t send_file(httpd_req_t* req, const std::string& path, int64_t size)
+{
+    ByteRange_t range = {0, size - 1};
+    int has_range     = 0;
+    char header[64];
+    if (httpd_req_get_hdr_value_str(req, "Range", header, sizeof(header)) == ESP_OK) {
+        has_range = parse_range(header, size, range);
+    }
+
+    // Header values are pointers, they have to live until the first chunk is out
+    char content_range[64];
+    httpd_resp_set_hdr(req, "Accept-Ranges", "bytes");
+    if (has_range < 0) {
+        snprintf(content_range, sizeof(content_range), "bytes */%lld", size);
+        httpd_resp_set_status(req, "416 Range Not Satisfiable");
+        httpd_resp_set_hdr(req, "Content-Range", content_range);
+        return httpd_resp_send(req, nullptr, 0);
+    }
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "file not found");
+        return ESP_FAIL;
+    }
+    uint8_t* buffer = alloc_buffer();
+    if (buffer == nullptr) {
+        close(fd);
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "out of memory");
+        return ESP_FAIL;
+    }
+    if (has_range > 0) {
+        snprintf(content_range, sizeof(content_range), "bytes %lld-%lld/%lld", range.start, range.end, size);
+        httpd_resp_set_status(req, "206 Partial Content");
+        httpd_resp_set_hdr(req, "Content-Range", content_range);
+    }
+    httpd_resp_set_type(req, content_type_of(path));
+
+    int64_t offset   = range.start;
+    int64_t end      = range.end + 1;
+    esp_err_t ret    = ESP_OK;
+    bool is_complete = size == 0;
+    if (size > 0 && lseek(fd, offset, SEEK_SET) != offset) {
+        ret = ESP_FAIL;
+    }
+    while (ret == ESP_OK && offset < end) {
+        // Up to the next buffer boundary first, every read after that starts on a cluster
+        size_t wanted = std::min<int64_t>(_buffer_size - offset % _buffer_size, end - offset);
+        ssize_t got   = read(fd, buffer, wanted);
+        if (got <= 0) {
+            mclog::tagError(_tag, "read failed at {} of {}", offset, path);
+            ret = ESP_FAIL;
+            break;
+        }
+        ret = httpd_resp_send_chunk(req, (const char*)buffer, got);
+        if (ret == ESP_OK) {
+            offset += got;
+            is_complete = offset == end;
+        }
+    }
+    close(fd);
+    heap_caps_free(buffer);
+
+    if (!is_complete) {
+        // No final chunk, the client sees a cut transfer rather than a short file
+        mclog::tagWarn(_tag, "{} stopped at {} of {} bytes", path, offset - range.start, end - range.start);
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, nullptr, 0);
+}
+
+// Pages of the background scan go out as they come, a large directory is never held in RAM
+static esp_err_t send_listing(httpd_req_t* req, const std::string& path)
+{
+    std::string dir_path = path.substr(strlen(_uri_prefix));
+    uint32_t scan_id     = GetHAL()->startSdCardScan(dir_path, _scan_page_size);
+    if (scan_id == 0) {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "sd card not mounted");
+        return ESP_FAIL;
+    }
+
+    httpd_resp_set_type(req, "text/html");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    std::string base = url_encode(path) + "/";
+    std::string html = "<!DOCTYPE html><html><head><meta charset=\"utf-8\"><title>" + html_escape(path) +
+                       "</title></head><body><h1>" + html_escape(path) + "</h1><ul>";
+    if (path != _uri_prefix) {
+        html += "<li><a href=\"" + url_encode(path.substr(0, path.find_last_of('/'))) + "\">..</a></li>";
+    }
+
+    uint32_t waited_ms = 0;
+    bool is_done       = false;
+    while (!is_done) {
+        hal::HalBase::SdCardScanPage_t page;
+        if (!GetHAL()->getSdCardScanPage(page)) {
+            if (waited_ms >= _scan_timeout_ms) {
+                break;
+            }
+            vTaskDelay(pdMS_TO_TICKS(10));
+            waited_ms += 10;
+            continue;
+        }
+        // Another scan took over, the launcher shares the one scanner
+        if (page.scanId != scan_id) {
+            break;
+        }
+        waited_ms = 0;
+        for (const auto& entry : page.entries) {
+            std::string name = entry.isDir ? entry.name + "/" : entry.name;
+            html += "<li><a href=\"" + base + url_encode(name) + "\">" + html_escape(name) + "</a></li>";
+        }
+        is_done = page.isLast;
+        if (page.isFailed) {
+            html += "<li>read failed</li>";
+        }
+        if (httpd_resp_send_chunk(req, html.data(), html.size()) != ESP_OK) {
+            GetHAL()->cancelSdCardScan();
+            return ESP_FAIL;
+        }
+        html.clear();
+    }
+    if (!is_done) {
+        GetHAL()->cancelSdCardScan();
+        html += "<li>listing interrupted</li>";
+    }
+    html += "</ul></body></html>";
+    httpd_resp_send_chunk(req, html.data(), html.size());
+    return httpd_resp_send_chunk(req, nullptr, 0);
+}
+
+static esp_err_t serve(httpd_req_t* req)
+{
+    std::string path;
+    if (!decode_uri_path(req->uri, path)) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "invalid path");
+        return ESP_FAIL;
+    }
+    if (!GetHAL()->isSdCardMounted()) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        return httpd_resp_sendstr(req, "sd card not mounted\n");
+    }
+
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "file not found");
+        return ESP_FAIL;
+    }
+    if (S_ISDIR(st.st_mode)) {
+        return send_listing(req, path);
+    }
+    return send_file(req, path, st.st_size);
+}
+
+// Transfers run here so a long download never holds up the server task, telemetry and the mirror keep being served
+static void file_server_task(void* param)
+{
+    httpd_req_t* req = nullptr;
+    while (xQueueReceive(_file_server_data.queue, &req, portMAX_DELAY) == pdTRUE) {
+        // Light sleep would stall the socket
+        GetHAL()->claimPerfLevel("file_server", hal::HalBase::PERF_LEVEL_AWAKE);
+        GetHAL()->claimRadioLevel("file_server", hal::HalBase::RADIO_LEVEL_AWAKE);
+        int64_t start_us = esp_timer_get_time();
+        esp_err_t ret    = serve(req);
+        GetHAL()->releaseRadioLevel("file_server");
+        GetHAL()->releasePerfLevel("file_server");
+        mclog::tagInfo(_tag, "{} {} in {} ms", req->uri, ret == ESP_OK ? "sent" : "failed",
+                       (esp_timer_get_time() - start_us) / 1000);
+        httpd_req_async_handler_complete(req);
+    }
+}
+
+// Implemented in hal_wifi.cpp
+bool web_request_on_ap(httpd_req_t* req);
+
+// The card is only served over the station, the soft AP is open
+static esp_err_t file_server_handler(httpd_req_t* req)
+{
+    if (web_request_on_ap(req)) {
+        httpd_resp_send_err(req, HTTPD_403_FORBIDDEN, "files are refused on the open access point");
+        return ESP_FAIL;
+    }
+    httpd_req_t* async_req = nullptr;
+    if (httpd_req_async_handler_begin(req, &async_req) != ESP_OK) {
+        httpd_resp_send_500(req);
+        return ESP_FAIL;
+    }
+    if (xQueueSend(_file_server_data.queue, &async_req, 0) != pdTRUE) {
+        httpd_resp_set_status(async_req, "503 Service Unavailable");
+        httpd_resp_sendstr(async_req, "too many transfers\n");
+        httpd_req_async_handler_complete(async_req);
+    }
+    return ESP_OK;
+}
+
+// Called by start_webserver() in hal_wifi.cpp, which turns on wildcard matching
+void file_server_register_handlers(httpd_handle_t server)
+{
+    if (_file_server_data.queue == nullptr) {
+        _file_server_data.queue = xQueueCreate(_queue_size, sizeof(httpd_req_t*));
+        if (xTaskCreate(file_server_task, "file_server", 6144, nullptr, 5, &_file_server_data.task) != pdPASS) {
+            mclog::tagError(_tag, "create task failed");
+            return;
+        }
+    }
+
+    static httpd_uri_t root_uri = {};
+    root_uri.uri                = "/sd";
+    root_uri.method             = HTTP_GET;
+    root_uri.handler            = file_server_handler;
+    httpd_register_uri_handler(server, &root_uri);
+
+    static httpd_uri_t file_uri = {};
+    file_uri.uri                = "/sd/*";
+    file_uri.method             = HTTP_GET;
+    file_uri.handler            = file_server_handler;
+    httpd_register_uri_handler(server, &file_uri);
+}
@@ -0,0 +1,802 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_cache.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <driver/jpeg_decode.h>
+#include <driver/ppa.h>
+#include "../utils/pixel_convert/pixel_convert.h"
+
+static const std::string _tag = "gallery";
+
+static const char* _thumb_cache_path                = "/sd/.gallery_thumbs";
+static constexpr uint32_t _thumb_cache_magic        = 0x4D485447;  // "GTHM"
+static constexpr uint32_t _thumb_cache_version      = 1;
+static constexpr uint32_t _thumb_queue_max          = 64;
+static constexpr uint32_t _read_chunk_size          = 64 * 1024;
+static constexpr uint32_t _decode_timeout_ms        = 1000;
+static constexpr uint32_t _idle_check_interval_ms   = 200;
+static constexpr uint32_t _default_cache_line_align = 128;
+
+/*
+ * Thumbnail cache file, read with one index load when the gallery opens:
+ * [header][index, one record per slot][slots of thumbSize * thumbSize pixels]
+ * Slots are reused round robin once the file is full
+ */
+struct ThumbCacheHeader_t {
+    uint32_t magic;
+    uint32_t version;
+    uint16_t thumbSize;
+    uint16_t entries;
+    uint32_t nextSlot;
+};
+struct ThumbRecord_t {
+    // 0 for an empty slot
+    uint32_t key;
+    uint32_t fileSize;
+    uint32_t mtime;
+    uint16_t width;
+    uint16_t height;
+};
+
+// A JPEG as decoded, rows padded to the MCU width
+struct DecodedJpeg_t {
+    const uint8_t* pixels = nullptr;
+    uint32_t stride       = 0;
+    uint32_t width        = 0;
+    uint32_t height       = 0;
+};
+
+struct GalleryData_t {
+    std::mutex mutex;
+    std::atomic<bool> isRunning{false};
+    TaskHandle_t task         = nullptr;
+    SemaphoreHandle_t exitSem = nullptr;
+    hal::HalBase::GalleryConfig_t config;
+    std::vector<std::string> paths;
+
+    // Shared between the UI and the gallery task
+    std::mutex stateMutex;
+    int32_t current = -1;
+    std::map<size_t, hal::HalBase::GalleryPicture_t> pictures;
+    std::set<size_t> failedPictures;
+    std::map<size_t, hal::HalBase::GalleryPicture_t> thumbs;
+    // Thumbnails in memory, most recently asked for first
+    std::list<size_t> thumbOrder;
+    std::set<size_t> failedThumbs;
+    // Newest request first
+    std::deque<size_t> thumbQueue;
+    hal::HalBase::GalleryStats_t stats;
+
+    // Gallery task only
+    jpeg_decoder_handle_t decoder = nullptr;
+    ppa_client_handle_t ppa       = nullptr;
+    size_t cacheAlign             = 0;
+    uint8_t* jpegBuf              = nullptr;
+    size_t jpegBufSize            = 0;
+    uint8_t* decodeBuf            = nullptr;
+    size_t decodeBufSize          = 0;
+    FILE* cacheFile               = nullptr;
+    ThumbCacheHeader_t cacheHeader;
+    std::vector<ThumbRecord_t> cacheIndex;
+    std::unordered_map<uint32_t, uint32_t> cacheSlots;
+};
+static GalleryData_t _gallery_data;
+
+/* -------------------------------------------------------------------------- */
+/*                                   Buffers                                  */
+/* -------------------------------------------------------------------------- */
+static size_t align_to_cache_line(size_t size)
+{
+    return (size + _gallery_data.cacheAlign - 1) / _gallery_data.cacheAlign * _gallery_data.cacheAlign;
+}
+
+// DMA capable and whole cache lines, the PPA writes it
+static std::shared_ptr<uint8_t> alloc_pixels(size_t size)
+{
+    auto pixels = (uint8_t*)heap_caps_aligned_alloc(_gallery_data.cacheAlign, align_to_cache_line(size),
+                                                    MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA);
+    if (pixels == nullptr) {
+        return nullptr;
+    }
+    return std::shared_ptr<uint8_t>(pixels, heap_caps_free);
+}
+
+// Kept from one picture to the next, only grows
+static bool ensure_decoder_mem(uint8_t*& buf, size_t& bufSize, size_t size, jpeg_dec_buffer_alloc_direction_t dir)
+{
+    if (buf != nullptr && bufSize >= size) {
+        return true;
+    }
+    free(buf);
+    bufSize                                = 0;
+    jpeg_decode_memory_alloc_cfg_t mem_cfg = {.buffer_direction = dir};
+    buf                                    = (uint8_t*)jpeg_alloc_decoder_mem(size, &mem_cfg, &bufSize);
+    if (buf == nullptr) {
+        mclog::tagError(_tag, "no memory for a {} KB decoder buffer", size / 1024);
+        return false;
+    }
+    return true;
+}
+
+static void free_task_buffers()
+{
+    free(_gallery_data.jpegBuf);
+    free(_gallery_data.decodeBuf);
+    _gallery_data.jpegBuf       = nullptr;
+    _gallery_data.jpegBufSize   = 0;
+    _gallery_data.decodeBuf     = nullptr;
+    _gallery_data.decodeBufSize = 0;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                   Decode                                   */
+/* -------------------------------------------------------------------------- */
+static bool load_jpeg(const std::string& path, size_t& size)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        mclog::tagError(_tag, "open {} failed", path);
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (file_size <= 0 || !ensure_decoder_mem(_gallery_data.jpegBuf, _gallery_data.jpegBufSize, file_size,
+                                              JPEG_DEC_ALLOC_INPUT_BUFFER)) {
+        fclose(file);
+        return false;
+    }
+
+    // Large reads, a slow card spends most of a small one on command overhead
+    size = 0;
+    while (size < (size_t)file_size) {
+        size_t len = std::min<size_t>(file_size - size, _read_chunk_size);
+        if (fread(_gallery_data.jpegBuf + size, 1, len, file) != len) {
+            mclog::tagError(_tag, "read {} failed", path);
+            fclose(file);
+            return false;
+        }
+        size += len;
+    }
+    fclose(file);
+    return true;
+}
+
+static bool decode_jpeg(const std::string& path, DecodedJpeg_t& decoded)
+{
+    size_t size = 0;
+    if (!load_jpeg(path, size)) {
+        return false;
+    }
+
+    jpeg_decode_picture_info_t info;
+    if (jpeg_decoder_get_info(_gallery_data.jpegBuf, size, &info) != ESP_OK || info.width == 0 || info.height == 0) {
+        mclog::tagWarn(_tag, "{} is not a baseline JPEG", path);
+        return false;
+    }
+    if ((uint64_t)info.width * info.height > _gallery_data.config.maxPixels) {
+        mclog::tagWarn(_tag, "{} is {}x{}, larger than the decode buffer", path, info.width, info.height);
+        return false;
+    }
+
+    // The codec writes whole MCUs
+    bool is_h_subsampled = info.sample_method == JPEG_DOWN_SAMPLING_YUV420 ||
+                           info.sample_method == JPEG_DOWN_SAMPLING_YUV422;
+    uint32_t mcu_w       = is_h_subsampled ? 16 : 8;
+    uint32_t mcu_h       = info.sample_method == JPEG_DOWN_SAMPLING_YUV420 ? 16 : 8;
+    uint32_t out_w       = (info.width + mcu_w - 1) / mcu_w * mcu_w;
+    uint32_t out_h       = (info.height + mcu_h - 1) / mcu_h * mcu_h;
+    if (!ensure_decoder_mem(_gallery_data.decodeBuf, _gallery_data.decodeBufSize, out_w * out_h * 2,
+                            JPEG_DEC_ALLOC_OUTPUT_BUFFER)) {
+        return false;
+    }
+
+    jpeg_decode_cfg_t decode_cfg = {
+        .output_format = JPEG_DECODE_OUT_FORMAT_RGB565,
+        .rgb_order     = JPEG_DEC_RGB_ELEMENT_ORDER_BGR,
+        .conv_std      = JPEG_YUV_RGB_CONV_STD_BT601,
+    };
+    uint32_t out_size = 0;
+    esp_err_t ret     = jpeg_decoder_process(_gallery_data.decoder, &decode_cfg, _gallery_data.jpegBuf, size,
+                                             _gallery_data.decodeBuf, _gallery_data.decodeBufSize, &out_size);
+    if (ret != ESP_OK) {
+        mclog::tagError(_tag, "decode {} failed: {}", path, esp_err_to_name(ret));
+        return false;
+    }
+
+    decoded.pixels = _gallery_data.decodeBuf;
+    decoded.stride = out_w;
+    decoded.width  = info.width;
+    decoded.height = info.height;
+    return true;
+}
+
+// Fits src into the box, scaled down only
+static bool fit_picture(const DecodedJpeg_t& src, uint32_t boxW, uint32_t boxH, hal::HalBase::GalleryPicture_t& out)
+{
+    float scale = std::min({1.0f, (float)boxW / src.width, (float)boxH / src.height});
+    // The PPA scales in steps of 1/16
+    float ppa_scale = std::floor(scale * 16.0f) / 16.0f;
+    bool is_ppa     = _gallery_data.ppa != nullptr && ppa_scale > 0.0f;
+    if (is_ppa) {
+        scale = ppa_scale;
+    }
+    uint32_t w = std::max<uint32_t>(1, src.width * scale);
+    uint32_t h = std::max<uint32_t>(1, src.height * scale);
+
+    size_t size = w * h * 2;
+    auto pixels = alloc_pixels(size);
+    if (pixels == nullptr) {
+        mclog::tagError(_tag, "no memory for a {}x{} picture", w, h);
+        return false;
+    }
+
+    if (is_ppa) {
+        ppa_srm_oper_config_t oper = {};
+        oper.in.buffer             = src.pixels;
+        oper.in.pic_w              = src.stride;
+        oper.in.pic_h              = src.height;
+        oper.in.block_w            = src.width;
+        oper.in.block_h            = src.height;
+        oper.in.srm_cm             = PPA_SRM_COLOR_MODE_RGB565;
+        oper.out.buffer            = pixels.get();
+        oper.out.buffer_size       = align_to_cache_line(size);
+        oper.out.pic_w             = w;
+        oper.out.pic_h             = h;
+        oper.out.srm_cm            = PPA_SRM_COLOR_MODE_RGB565;
+        oper.rotation_angle        = PPA_SRM_ROTATION_ANGLE_0;
+        oper.scale_x               = scale;
+        oper.scale_y               = scale;
+        oper.mode                  = PPA_TRANS_MODE_BLOCKING;
+        is_ppa                     = ppa_do_scale_rotate_mirror(_gallery_data.ppa, &oper) == ESP_OK;
+    }
+    if (!is_ppa) {
+        pixel_convert::scale_rgb565(src.pixels, src.stride * 2, src.width, src.height, pixels.get(), w * 2, w, h);
+    }
+
+    out.width  = w;
+    out.height = h;
+    out.data   = pixels;
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                               Thumbnail cache                              */
+/* -------------------------------------------------------------------------- */
+static size_t thumb_slot_size()
+{
+    return (size_t)_gallery_data.cacheHeader.thumbSize * _gallery_data.cacheHeader.thumbSize * 2;
+}
+
+static long thumb_index_offset(uint32_t slot)
+{
+    return sizeof(ThumbCacheHeader_t) + slot * sizeof(ThumbRecord_t);
+}
+
+static long thumb_slot_offset(uint32_t slot)
+{
+    return thumb_index_offset(_gallery_data.cacheHeader.entries) + (long)slot * thumb_slot_size();
+}
+
+// FNV-1a of the path, never 0 so 0 marks a free slot
+static uint32_t thumb_key(const std::string& path)
+{
+    uint32_t hash = 2166136261u;
+    for (char c : path) {
+        hash = (hash ^ (uint8_t)c) * 16777619u;
+    }
+    return hash ? hash : 1;
+}
+
+static bool reset_thumb_cache()
+{
+    if (_gallery_data.cacheFile) {
+        fclose(_gallery_data.cacheFile);
+    }
+    _gallery_data.cacheFile = fopen(_thumb_cache_path, "w+b");
+    if (_gallery_data.cacheFile == nullptr) {
+        mclog::tagError(_tag, "create {} failed", _thumb_cache_path);
+        return false;
+    }
+
+    auto& header     = _gallery_data.cacheHeader;
+    header.magic     = _thumb_cache_magic;
+    header.version   = _thumb_cache_version;
+    header.thumbSize = _gallery_data.config.thumbSize;
+    header.entries   = _gallery_data.config.thumbCacheEntries;
+    header.nextSlot  = 0;
+    _gallery_data.cacheIndex.assign(header.entries, ThumbRecord_t());
+    _gallery_data.cacheSlots.clear();
+    bool is_ok = fwrite(&header, sizeof(header), 1, _gallery_data.cacheFile) == 1 &&
+                 fwrite(_gallery_data.cacheIndex.data(), sizeof(ThumbRecord_t), header.entries,
+                        _gallery_data.cacheFile) == header.entries;
+    fflush(_gallery_data.cacheFile);
+    return is_ok;
+}
+
+static void open_thumb_cache()
+{
+    _gallery_data.cacheFile = fopen(_thumb_cache_path, "r+b");
+    if (_gallery_data.cacheFile == nullptr) {
+        reset_thumb_cache();
+        return;
+    }
+
+    // A cache made with other settings is started over
+    auto& header = _gallery_data.cacheHeader;
+    if (fread(&header, sizeof(header), 1, _gallery_data.cacheFile) != 1 || header.magic != _thumb_cache_magic ||
+        header.version != _thumb_cache_version || header.thumbSize != _gallery_data.config.thumbSize ||
+        header.entries != _gallery_data.config.thumbCacheEntries) {
+        mclog::tagInfo(_tag, "new thumbnail cache");
+        reset_thumb_cache();
+        return;
+    }
+    _gallery_data.cacheIndex.resize(header.entries);
+    if (fread(_gallery_data.cacheIndex.data(), sizeof(ThumbRecord_t), header.entries, _gallery_data.cacheFile) !=
+        header.entries) {
+        reset_thumb_cache();
+        return;
+    }
+    for (uint32_t slot = 0; slot < header.entries; slot++) {
+        if (_gallery_data.cacheIndex[slot].key != 0) {
+            _gallery_data.cacheSlots[_gallery_data.cacheIndex[slot].key] = slot;
+        }
+    }
+    mclog::tagInfo(_tag, "{} cached thumbnails", _gallery_data.cacheSlots.size());
+}
+
+static void close_thumb_cache()
+{
+    if (_gallery_data.cacheFile) {
+        fclose(_gallery_data.cacheFile);
+        _gallery_data.cacheFile = nullptr;
+    }
+    _gallery_data.cacheIndex.clear();
+    _gallery_data.cacheSlots.clear();
+}
+
+// False when the picture has no thumbnail in the file or was changed since
+static bool find_cached_thumb(const ThumbRecord_t& key, uint32_t& slot)
+{
+    auto it = _gallery_data.cacheSlots.find(key.key);
+    if (it == _gallery_data.cacheSlots.end()) {
+        return false;
+    }
+    const auto& record = _gallery_data.cacheIndex[it->second];
+    slot               = it->second;
+    return record.fileSize == key.fileSize && record.mtime == key.mtime;
+}
+
+static bool read_cached_thumb(const ThumbRecord_t& key, hal::HalBase::GalleryPicture_t& thumb)
+{
+    uint32_t slot = 0;
+    if (!find_cached_thumb(key, slot)) {
+        return false;
+    }
+
+    const auto& record = _gallery_data.cacheIndex[slot];
+    size_t size        = (size_t)record.width * record.height * 2;
+    auto pixels        = alloc_pixels(size);
+    if (pixels == nullptr || fseek(_gallery_data.cacheFile, thumb_slot_offset(slot), SEEK_SET) != 0 ||
+        fread(pixels.get(), 1, size, _gallery_data.cacheFile) != size) {
+        return false;
+    }
+    thumb.width  = record.width;
+    thumb.height = record.height;
+    thumb.data   = pixels;
+    return true;
+}
+
+static void write_cached_thumb(ThumbRecord_t record, const hal::HalBase::GalleryPicture_t& thumb)
+{
+    if (_gallery_data.cacheFile == nullptr) {
+        return;
+    }
+
+    auto& header = _gallery_data.cacheHeader;
+    uint32_t slot;
+    auto it = _gallery_data.cacheSlots.find(record.key);
+    if (it != _gallery_data.cacheSlots.end()) {
+        slot = it->second;
+    } else {
+        slot            = header.nextSlot;
+        header.nextSlot = (header.nextSlot + 1) % header.entries;
+        if (_gallery_data.cacheIndex[slot].key != 0) {
+            _gallery_data.cacheSlots.erase(_gallery_data.cacheIndex[slot].key);
+        }
+    }
+    record.width  = thumb.width;
+    record.height = thumb.height;
+
+    // Pixels first, a record never points at a slot that is not written yet
+    FILE* file  = _gallery_data.cacheFile;
+    size_t size = (size_t)thumb.width * thumb.height * 2;
+    bool is_ok  = fseek(file, thumb_slot_offset(slot), SEEK_SET) == 0 &&
+                 fwrite(thumb.data.get(), 1, size, file) == size &&
+                 fseek(file, thumb_index_offset(slot), SEEK_SET) == 0 &&
+                 fwrite(&record, sizeof(record), 1, file) == 1 && fseek(file, 0, SEEK_SET) == 0 &&
+                 fwrite(&header, sizeof(header), 1, file) == 1;
+    fflush(file);
+    if (!is_ok) {
+        mclog::tagError(_tag, "write thumbnail cache failed");
+        return;
+    }
+    _gallery_data.cacheIndex[slot]       = record;
+    _gallery_data.cacheSlots[record.key] = slot;
+}
+
+static bool get_thumb_record(const std::string& path, ThumbRecord_t& record)
+{
+    struct stat st;
+    if (stat(("/sd/" + path).c_str(), &st) != 0) {
+        return false;
+    }
+    record          = ThumbRecord_t();
+    record.key      = thumb_key(path);
+    record.fileSize = st.st_size;
+    record.mtime    = st.st_mtime;
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Jobs                                    */
+/* -------------------------------------------------------------------------- */
+static void store_thumb(size_t index, const hal::HalBase::GalleryPicture_t& thumb)
+{
+    std::lock_guard<std::mutex> lock(_gallery_data.stateMutex);
+    _gallery_data.thumbs[index] = thumb;
+    _gallery_data.thumbOrder.remove(index);
+    _gallery_data.thumbOrder.push_front(index);
+    while (_gallery_data.thumbOrder.size() > _gallery_data.config.thumbsInMemory) {
+        _gallery_data.thumbs.erase(_gallery_data.thumbOrder.back());
+        _gallery_data.thumbOrder.pop_back();
+    }
+}
+
+// Decodes a picture, its thumbnail comes from the fitted picture for free then
+static bool make_picture(size_t index, hal::HalBase::GalleryPicture_t& picture, hal::HalBase::GalleryPicture_t& thumb)
+{
+    const auto& config = _gallery_data.config;
+    uint32_t start_ms  = esp_timer_get_time() / 1000;
+    DecodedJpeg_t decoded;
+    bool is_ok = decode_jpeg("/sd/" + _gallery_data.paths[index], decoded) &&
+                 fit_picture(decoded, config.fitWidth, config.fitHeight, picture);
+    if (is_ok) {
+        DecodedJpeg_t fitted = {picture.data.get(), picture.width, picture.width, picture.height};
+        is_ok                = fit_picture(fitted, config.thumbSize, config.thumbSize, thumb);
+    }
+
+    std::lock_guard<std::mutex> lock(_gallery_data.stateMutex);
+    if (is_ok) {
+        _gallery_data.stats.decodes++;
+        _gallery_data.stats.lastDecodeMs = esp_timer_get_time() / 1000 - start_ms;
+    } else {
+        _gallery_data.stats.failures++;
+    }
+    return is_ok;
+}
+
+static bool is_near_current(size_t index)
+{
+    int32_t current = _gallery_data.current;
+    return current >= 0 && std::abs((int32_t)index - current) <= _gallery_data.config.prefetch;
+}
+
+static void run_picture_job(size_t index)
+{
+    hal::HalBase::GalleryPicture_t picture;
+    hal::HalBase::GalleryPicture_t thumb;
+    bool is_ok = make_picture(index, picture, thumb);
+
+    if (is_ok) {
+        ThumbRecord_t record;
+        uint32_t slot = 0;
+        if (get_thumb_record(_gallery_data.paths[index], record) && !find_cached_thumb(record, slot)) {
+            write_cached_thumb(record, thumb);
+        }
+        store_thumb(index, thumb);
+    }
+
+    std::lock_guard<std::mutex> lock(_gallery_data.stateMutex);
+    if (!is_ok) {
+        _gallery_data.failedPictures.insert(index);
+    } else if (is_near_current(index)) {
+        // A swipe may have moved on while it was decoded
+        _gallery_data.pictures[index] = picture;
+    }
+}
+
+static void run_thumb_job(size_t index)
+{
+    const std::string& path = _gallery_data.paths[index];
+    ThumbRecord_t record;
+    hal::HalBase::GalleryPicture_t thumb;
+    bool has_record = get_thumb_record(path, record);
+    if (has_record && read_cached_thumb(record, thumb)) {
+        {
+            std::lock_guard<std::mutex> lock(_gallery_data.stateMutex);
+            _gallery_data.stats.thumbHits++;
+        }
+        store_thumb(index, thumb);
+        return;
+    }
+
+    hal::HalBase::GalleryPicture_t picture;
+    if (!has_record || !make_picture(index, picture, thumb)) {
+        std::lock_guard<std::mutex> lock(_gallery_data.stateMutex);
+        _gallery_data.failedThumbs.insert(index);
+        return;
+    }
+    write_cached_thumb(record, thumb);
+    store_thumb(index, thumb);
+    std::lock_guard<std::mutex> lock(_gallery_data.stateMutex);
+    _gallery_data.stats.thumbDecodes++;
+}
+
+// The current picture, then its neighbours nearest and next one first, then the thumbnails asked for last
+static bool pick_job(size_t& index, bool& isPicture)
+{
+    std::lock_guard<std::mutex> lock(_gallery_data.stateMutex);
+
+    int32_t current = _gallery_data.current;
+    int32_t count   = _gallery_data.paths.size();
+    if (current >= 0) {
+        for (int32_t i = 0; i <= _gallery_data.config.prefetch * 2; i++) {
+            int32_t candidate = current + ((i % 2) ? (i + 1) / 2 : -(i / 2));
+            if (candidate < 0 || candidate >= count || _gallery_data.pictures.count(candidate) ||
+                _gallery_data.failedPictures.count(candidate)) {
+                continue;
+            }
+            index     = candidate;
+            isPicture = true;
+            return true;
+        }
+    }
+
+    while (!_gallery_data.thumbQueue.empty()) {
+        size_t candidate = _gallery_data.thumbQueue.front();
+        _gallery_data.thumbQueue.pop_front();
+        if (_gallery_data.thumbs.count(candidate) || _gallery_data.failedThumbs.count(candidate)) {
+            continue;
+        }
+        index     = candidate;
+        isPicture = false;
+        return true;
+    }
+    return false;
+}
+
+static void _gallery_task(void* param)
+{
+    open_thumb_cache();
+
+    while (_gallery_data.isRunning) {
+        size_t index    = 0;
+        bool is_picture = false;
+        if (!pick_job(index, is_picture)) {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(_idle_check_interval_ms));
+            continue;
+        }
+        if (is_picture) {
+            run_picture_job(index);
+        } else {
+            run_thumb_job(index);
+        }
+    }
+
+    close_thumb_cache();
+    free_task_buffers();
+    xSemaphoreGive(_gallery_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                     API                                    */
+/* -------------------------------------------------------------------------- */
+static void release_engines()
+{
+    if (_gallery_data.decoder) {
+        jpeg_del_decoder_engine(_gallery_data.decoder);
+        _gallery_data.decoder = nullptr;
+    }
+    if (_gallery_data.ppa) {
+        ppa_unregister_client(_gallery_data.ppa);
+        _gallery_data.ppa = nullptr;
+    }
+}
+
+bool HalEsp32::openGallery(const std::vector<std::string>& paths, const GalleryConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_gallery_data.mutex);
+
+    if (_gallery_data.isRunning) {
+        mclog::tagWarn(_tag, "already open");
+        return false;
+    }
+    if (!isSdCardMounted()) {
+        mclog::tagError(_tag, "no sd card");
+        return false;
+    }
+    if (config.thumbSize == 0 || config.thumbCacheEntries == 0 || config.fitWidth == 0 || config.fitHeight == 0) {
+        mclog::tagError(_tag, "bad config");
+        return false;
+    }
+
+    jpeg_decode_engine_cfg_t engine_cfg = {
+        .intr_priority = 0,
+        .timeout_ms    = _decode_timeout_ms,
+    };
+    if (jpeg_new_decoder_engine(&engine_cfg, &_gallery_data.decoder) != ESP_OK) {
+        mclog::tagError(_tag, "failed to create the jpeg decoder");
+        return false;
+    }
+    // Without the PPA pictures are scaled on the CPU
+    ppa_client_config_t ppa_config = {
+        .oper_type             = PPA_OPERATION_SRM,
+        .max_pending_trans_num = 1,
+    };
+    if (ppa_register_client(&ppa_config, &_gallery_data.ppa) != ESP_OK) {
+        mclog::tagWarn(_tag, "no ppa client, scaling on the cpu");
+        _gallery_data.ppa = nullptr;
+    }
+    if (esp_cache_get_alignment(MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA, &_gallery_data.cacheAlign) != ESP_OK ||
+        _gallery_data.cacheAlign == 0) {
+        _gallery_data.cacheAlign = _default_cache_line_align;
+    }
+
+    {
+        std::lock_guard<std::mutex> state_lock(_gallery_data.stateMutex);
+        _gallery_data.config  = config;
+        _gallery_data.paths   = paths;
+        _gallery_data.current = -1;
+        _gallery_data.stats   = GalleryStats_t();
+    }
+    if (_gallery_data.exitSem == nullptr) {
+        _gallery_data.exitSem = xSemaphoreCreateBinary();
+    }
+
+    _gallery_data.isRunning = true;
+    if (xTaskCreate(_gallery_task, "gallery", 6144, nullptr, 5, &_gallery_data.task) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _gallery_data.isRunning = false;
+        release_engines();
+        return false;
+    }
+
+    mclog::tagInfo(_tag, "open with {} pictures, fit {}x{}, prefetch {}", paths.size(), config.fitWidth,
+                   config.fitHeight, config.prefetch);
+    return true;
+}
+
+void HalEsp32::closeGallery()
+{
+    std::lock_guard<std::mutex> lock(_gallery_data.mutex);
+
+    if (!_gallery_data.isRunning) {
+        return;
+    }
+
+    // A decode in flight is finished first
+    _gallery_data.isRunning = false;
+    xTaskNotifyGive(_gallery_data.task);
+    xSemaphoreTake(_gallery_data.exitSem, portMAX_DELAY);
+    _gallery_data.task = nullptr;
+    release_engines();
+
+    // Pictures still on screen keep their own reference
+    std::lock_guard<std::mutex> state_lock(_gallery_data.stateMutex);
+    auto& stats = _gallery_data.stats;
+    mclog::tagInfo(_tag, "close, {} decodes, {} failed, {}/{} pictures ready, {} thumbnails from cache",
+                   stats.decodes, stats.failures, stats.pictureHits, stats.pictureHits + stats.pictureMisses,
+                   stats.thumbHits);
+    _gallery_data.paths.clear();
+    _gallery_data.pictures.clear();
+    _gallery_data.failedPictures.clear();
+    _gallery_data.thumbs.clear();
+    _gallery_data.thumbOrder.clear();
+    _gallery_data.failedThumbs.clear();
+    _gallery_data.thumbQueue.clear();
+}
+
+void HalEsp32::setGalleryIndex(int32_t index)
+{
+    if (!_gallery_data.isRunning) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_gallery_data.stateMutex);
+        if (index >= (int32_t)_gallery_data.paths.size()) {
+            index = -1;
+        }
+        if (index == _gallery_data.current) {
+            return;
+        }
+        _gallery_data.current = index;
+        if (index >= 0) {
+            if (_gallery_data.pictures.count(index)) {
+                _gallery_data.stats.pictureHits++;
+            } else {
+                _gallery_data.stats.pictureMisses++;
+            }
+        }
+        // Only the pictures around the current one stay decoded
+        for (auto it = _gallery_data.pictures.begin(); it != _gallery_data.pictures.end();) {
+            it = is_near_current(it->first) ? std::next(it) : _gallery_data.pictures.erase(it);
+        }
+    }
+    xTaskNotifyGive(_gallery_data.task);
+}
+
+hal::HalBase::GalleryItemState_t HalEsp32::getGalleryPicture(size_t index, GalleryPicture_t& picture)
+{
+    std::lock_guard<std::mutex> lock(_gallery_data.stateMutex);
+
+    auto it = _gallery_data.pictures.find(index);
+    if (it != _gallery_data.pictures.end()) {
+        picture = it->second;
+        return GALLERY_READY;
+    }
+    if (!_gallery_data.isRunning || index >= _gallery_data.paths.size() || _gallery_data.failedPictures.count(index)) {
+        return GALLERY_FAILED;
+    }
+    return GALLERY_PENDING;
+}
+
+hal::HalBase::GalleryItemState_t HalEsp32::getGalleryThumbnail(size_t index, GalleryPicture_t& thumbnail)
+{
+    {
+        std::lock_guard<std::mutex> lock(_gallery_data.stateMutex);
+
+        auto it = _gallery_data.thumbs.find(index);
+        if (it != _gallery_data.thumbs.end()) {
+            thumbnail = it->second;
+            return GALLERY_READY;
+        }
+        if (!_gallery_data.isRunning || index >= _gallery_data.paths.size() ||
+            _gallery_data.failedThumbs.count(index)) {
+            return GALLERY_FAILED;
+        }
+
+        // Asked for again while still queued, it moves to the front
+        auto& queue = _gallery_data.thumbQueue;
+        if (!queue.empty() && queue.front() == index) {
+            return GALLERY_PENDING;
+        }
+        queue.erase(std::remove(queue.begin(), queue.end(), index), queue.end());
+        queue.push_front(index);
+        if (queue.size() > _thumb_queue_max) {
+            queue.pop_back();
+        }
+    }
+    xTaskNotifyGive(_gallery_data.task);
+    return GALLERY_PENDING;
+}
+
+hal::HalBase::GalleryStats_t HalEsp32::getGalleryStats()
+{
+    std::lock_guard<std::mutex> lock(_gallery_data.stateMutex);
+    return _gallery_data.stats;
+}
@@ -0,0 +1,259 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <driver/gpio.h>
+#include <driver/rmt_tx.h>
+#include <soc/soc_caps.h>
+#include <esp_attr.h>
+
+static const std::string _tag = "gpio-wave";
+
+// RMT_CLK_SRC_DEFAULT on the P4, the resolution is this divided by an integer up to 255
+static constexpr uint32_t _rmt_clock_hz = 80000000;
+// Longest half of a symbol in ticks
+static constexpr uint32_t _max_half_ticks = 32767;
+// A looped pattern has to sit in the channel memory, one word is taken by the end marker
+static constexpr size_t _max_loop_symbols = SOC_RMT_MEM_WORDS_PER_CHANNEL - 1;
+// Ping-pong buffer of a DMA channel, the pattern itself may be any length
+static constexpr size_t _dma_block_symbols = 1024;
+
+struct GpioWaveformChannel_t {
+    rmt_channel_handle_t channel = nullptr;
+    rmt_encoder_handle_t encoder = nullptr;
+    // Read by the encoder while sending, kept until the channel is deleted
+    std::vector<rmt_symbol_word_t> symbols;
+    std::atomic<bool> isDone{false};
+    bool idleLevel = false;
+    hal::HalBase::GpioWaveformStatus_t status;
+};
+static std::mutex _waveform_mutex;
+static std::map<uint8_t, std::unique_ptr<GpioWaveformChannel_t>> _waveform_channels;
+
+static bool IRAM_ATTR on_waveform_done(rmt_channel_handle_t channel, const rmt_tx_done_event_data_t* data, void* ctx)
+{
+    static_cast<GpioWaveformChannel_t*>(ctx)->isDone = true;
+    return false;
+}
+
+/**
+ * @brief Pack level/ticks halves into symbols, an odd count is evened out by splitting the longest half
+ *
+ * @return false if there is nothing to send or no half long enough to split
+ */
+static bool pack_symbols(std::vector<std::pair<bool, uint32_t>>& halves, std::vector<rmt_symbol_word_t>& symbols)
+{
+    if (halves.empty()) {
+        return false;
+    }
+    if (halves.size() % 2) {
+        auto longest = std::max_element(
+            halves.begin(), halves.end(), [](const auto& a, const auto& b) { return a.second < b.second; });
+        if (longest->second < 2) {
+            return false;
+        }
+        uint32_t first  = longest->second / 2;
+        longest->second = longest->second - first;
+        halves.insert(longest, {longest->first, first});
+    }
+
+    symbols.resize(halves.size() / 2);
+    for (size_t i = 0; i < symbols.size(); i++) {
+        symbols[i].level0    = halves[i * 2].first;
+        symbols[i].duration0 = halves[i * 2].second;
+        symbols[i].level1    = halves[i * 2 + 1].first;
+        symbols[i].duration1 = halves[i * 2 + 1].second;
+    }
+    return true;
+}
+
+static void release_waveform(uint8_t pin)
+{
+    auto it = _waveform_channels.find(pin);
+    if (it == _waveform_channels.end()) {
+        return;
+    }
+
+    auto& wave = it->second;
+    rmt_disable(wave->channel);
+    rmt_del_encoder(wave->encoder);
+    rmt_del_channel(wave->channel);
+    // Routed back to the GPIO matrix so gpioSetLevel() works on it again
+    gpio_set_direction((gpio_num_t)pin, GPIO_MODE_OUTPUT);
+    gpio_set_level((gpio_num_t)pin, wave->idleLevel);
+    _waveform_channels.erase(it);
+}
+
+/**
+ * @brief Set up an RMT TX channel on the pin and start sending the symbols
+ *
+ * @param loopCount -1 repeats until stopped, 0 sends once
+ */
+static bool start_waveform(uint8_t pin,
+                           uint32_t resolutionHz,
+                           std::vector<rmt_symbol_word_t> symbols,
+                           int loopCount,
+                           bool idleLevel)
+{
+    bool with_dma = symbols.size() > _max_loop_symbols;
+    if (with_dma && loopCount != 0) {
+        mclog::tagError(_tag, "pattern of {} symbols is too long to repeat, {} max", symbols.size(), _max_loop_symbols);
+        return false;
+    }
+
+    release_waveform(pin);
+
+    auto wave       = std::make_unique<GpioWaveformChannel_t>();
+    wave->symbols   = std::move(symbols);
+    wave->idleLevel = idleLevel;
+
+    rmt_tx_channel_config_t channel_config = {};
+    channel_config.gpio_num                = (gpio_num_t)pin;
+    channel_config.clk_src                 = RMT_CLK_SRC_DEFAULT;
+    channel_config.resolution_hz           = resolutionHz;
+    channel_config.mem_block_symbols       = with_dma ? _dma_block_symbols : SOC_RMT_MEM_WORDS_PER_CHANNEL;
+    channel_config.trans_queue_depth       = 1;
+    channel_config.flags.with_dma          = with_dma;
+    esp_err_t ret                          = rmt_new_tx_channel(&channel_config, &wave->channel);
+    if (ret != ESP_OK) {
+        // The P4 has four TX channels and only some of them can take DMA
+        mclog::tagError(_tag, "no {}rmt channel for G{}: {}", with_dma ? "dma " : "", pin, esp_err_to_name(ret));
+        return false;
+    }
+
+    rmt_copy_encoder_config_t encoder_config = {};
+    rmt_tx_event_callbacks_t callbacks       = {};
+    callbacks.on_trans_done                  = on_waveform_done;
+    if (rmt_new_copy_encoder(&encoder_config, &wave->encoder) != ESP_OK) {
+        rmt_del_channel(wave->channel);
+        return false;
+    }
+    rmt_tx_register_event_callbacks(wave->channel, &callbacks, wave.get());
+    rmt_enable(wave->channel);
+
+    rmt_transmit_config_t transmit_config = {};
+    transmit_config.loop_count            = loopCount;
+    transmit_config.flags.eot_level       = idleLevel;
+
+    size_t size = wave->symbols.size() * sizeof(rmt_symbol_word_t);
+    ret         = rmt_transmit(wave->channel, wave->encoder, wave->symbols.data(), size, &transmit_config);
+    if (ret != ESP_OK) {
+        mclog::tagError(_tag, "transmit on G{} failed: {}", pin, esp_err_to_name(ret));
+        rmt_disable(wave->channel);
+        rmt_del_encoder(wave->encoder);
+        rmt_del_channel(wave->channel);
+        return false;
+    }
+
+    wave->status.running    = true;
+    wave->status.looping    = loopCount < 0;
+    wave->status.dma        = with_dma;
+    wave->status.steps      = wave->symbols.size() * 2;
+    wave->status.tickNs     = 1e9f / resolutionHz;
+    _waveform_channels[pin] = std::move(wave);
+    return true;
+}
+
+bool HalEsp32::startGpioPattern(const GpioWaveformConfig_t& config, const std::vector<GpioWaveformStep_t>& steps)
+{
+    if (config.resolutionHz < _rmt_clock_hz / 255 || config.resolutionHz > _rmt_clock_hz) {
+        mclog::tagError(_tag, "resolution {} Hz out of range", config.resolutionHz);
+        return false;
+    }
+
+    // Steps rounded to ticks, a step too long for one half is spread over several
+    std::vector<std::pair<bool, uint32_t>> halves;
+    for (const auto& step : steps) {
+        uint64_t ticks = ((uint64_t)step.durationNs * config.resolutionHz + 500000000) / 1000000000;
+        if (step.durationNs > 0) {
+            ticks = std::max<uint64_t>(ticks, 1);
+        }
+        while (ticks > 0) {
+            uint32_t half = std::min<uint64_t>(ticks, _max_half_ticks);
+            halves.push_back({step.level, half});
+            ticks -= half;
+        }
+    }
+
+    std::vector<rmt_symbol_word_t> symbols;
+    if (!pack_symbols(halves, symbols)) {
+        mclog::tagError(_tag, "pattern for G{} is empty or cannot be evened out", config.pin);
+        return false;
+    }
+
+    // The loop counter sends the pattern repeat times back to back, -1 to run until stopped
+    int loop_count = config.repeat == 0 ? -1 : (config.repeat == 1 ? 0 : (int)config.repeat);
+
+    std::lock_guard<std::mutex> lock(_waveform_mutex);
+    if (!start_waveform(config.pin, config.resolutionHz, std::move(symbols), loop_count, config.idleLevel)) {
+        return false;
+    }
+    mclog::tagInfo(_tag, "G{}: pattern of {} steps, repeat {}", config.pin, steps.size(), config.repeat);
+    return true;
+}
+
+bool HalEsp32::startGpioPwm(uint8_t pin, uint32_t frequencyHz, float duty)
+{
+    if (frequencyHz == 0) {
+        return false;
+    }
+
+    // Fastest tick that still fits a period in one half, so any duty fits a single symbol
+    uint64_t min_clock = (uint64_t)frequencyHz * _max_half_ticks;
+    uint32_t prescale  = std::max<uint64_t>((_rmt_clock_hz + min_clock - 1) / min_clock, 1);
+    uint32_t res_hz    = _rmt_clock_hz / prescale;
+    uint32_t period    = (res_hz + frequencyHz / 2) / frequencyHz;
+    if (prescale > 255 || period < 2) {
+        mclog::tagError(_tag, "pwm of {} Hz out of range", frequencyHz);
+        return false;
+    }
+
+    duty          = std::clamp(duty, 0.0f, 1.0f);
+    uint32_t high = std::lround(period * duty);
+    std::vector<std::pair<bool, uint32_t>> halves;
+    if (high == 0 || high == period) {
+        // A symbol half cannot be empty, a flat line is two halves of the same level
+        halves = {{high != 0, period / 2}, {high != 0, period - period / 2}};
+    } else {
+        halves = {{true, high}, {false, period - high}};
+    }
+
+    std::vector<rmt_symbol_word_t> symbols;
+    pack_symbols(halves, symbols);
+
+    std::lock_guard<std::mutex> lock(_waveform_mutex);
+    if (!start_waveform(pin, res_hz, std::move(symbols), -1, false)) {
+        return false;
+    }
+    mclog::tagInfo(_tag, "G{}: pwm {} Hz, duty {}/{}", pin, (float)res_hz / period, high, period);
+    return true;
+}
+
+void HalEsp32::stopGpioWaveform(uint8_t pin)
+{
+    std::lock_guard<std::mutex> lock(_waveform_mutex);
+    release_waveform(pin);
+}
+
+hal::HalBase::GpioWaveformStatus_t HalEsp32::getGpioWaveformStatus(uint8_t pin)
+{
+    std::lock_guard<std::mutex> lock(_waveform_mutex);
+
+    auto it = _waveform_channels.find(pin);
+    if (it == _waveform_channels.end()) {
+        return {};
+    }
+    auto status    = it->second->status;
+    status.running = !it->second->isDone;
+    return status;
+}
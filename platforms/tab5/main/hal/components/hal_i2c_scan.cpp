@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <atomic>
+#include <mutex>
+#include <bsp/m5stack_tab5.h>
+#include <driver/i2c_master.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+static const std::string _tag = "i2c-scan";
+
+// Same range as the device charts, the reserved addresses at both ends are left out
+static constexpr uint8_t _first_address = 0x10;
+static constexpr uint8_t _last_address  = 0x77;
+// An absent device NAKs within microseconds, the timeout only matters on a bus held low
+static constexpr int _probe_timeout_ms = 5;
+// Timeouts in a row before the bus is given up on
+static constexpr uint8_t _max_timeouts = 3;
+
+struct I2cScanData_t {
+    std::mutex mutex;
+    bool isRunning                = false;
+    SemaphoreHandle_t exitSem     = nullptr;
+    std::atomic<bool> isCancelled = false;
+    i2c_master_bus_handle_t bus   = nullptr;
+    uint32_t nextScanId           = 1;
+    // Read by the UI while the job adds to it
+    std::mutex progressMutex;
+    hal::HalBase::I2cScanProgress_t progress;
+};
+static I2cScanData_t _i2c_scan_data;
+
+void HalEsp32::i2c_scan_loop()
+{
+    bool is_internal = _i2c_scan_data.progress.isInternal;
+    uint8_t timeouts = 0;
+
+    for (uint8_t address = _first_address; address <= _last_address; address++) {
+        if (_i2c_scan_data.isCancelled) {
+            return;
+        }
+
+        // On the internal bus every probe takes a diagnostic turn, touch and codec reads still go first
+        esp_err_t ret = ESP_FAIL;
+        if (is_internal) {
+            i2cScheduler().run(I2cBusScheduler::PRIORITY_DIAGNOSTIC, address, [&]() {
+                ret = i2c_master_probe(_i2c_scan_data.bus, address, _probe_timeout_ms);
+                return true;
+            });
+        } else {
+            ret = i2c_master_probe(_i2c_scan_data.bus, address, _probe_timeout_ms);
+        }
+        timeouts = ret == ESP_ERR_TIMEOUT ? timeouts + 1 : 0;
+
+        std::lock_guard<std::mutex> lock(_i2c_scan_data.progressMutex);
+        auto& progress       = _i2c_scan_data.progress;
+        progress.nextAddress = address + 1;
+        if (ret == ESP_OK) {
+            progress.addresses.push_back(address);
+        }
+        if (timeouts >= _max_timeouts) {
+            mclog::tagWarn(_tag, "bus timed out at 0x{:02X}, scan stopped", address);
+            progress.isFailed = true;
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_i2c_scan_data.progressMutex);
+    _i2c_scan_data.progress.isDone = true;
+}
+
+// Lock _i2c_scan_data.mutex before calling, every job submitted gives exitSem once and is joined once here
+static void join_i2c_scan_job()
+{
+    if (!_i2c_scan_data.isRunning) {
+        return;
+    }
+    _i2c_scan_data.isCancelled = true;
+    xSemaphoreTake(_i2c_scan_data.exitSem, portMAX_DELAY);
+    _i2c_scan_data.isRunning = false;
+}
+
+uint32_t HalEsp32::startI2cScan(bool isInternal)
+{
+    std::lock_guard<std::mutex> lock(_i2c_scan_data.mutex);
+
+    join_i2c_scan_job();
+
+    if (!isInternal) {
+        // Same as initPortAI2c() without its log line, the bus is left up and deinitPortAI2c() takes it down
+        bsp_ext_i2c_init();
+    }
+    i2c_master_bus_handle_t bus = isInternal ? bsp_i2c_get_handle() : bsp_ext_i2c_get_handle();
+    if (bus == nullptr) {
+        mclog::tagError(_tag, "bus not initialized");
+        return 0;
+    }
+    if (_i2c_scan_data.exitSem == nullptr) {
+        _i2c_scan_data.exitSem = xSemaphoreCreateBinary();
+    }
+
+    uint32_t scan_id = _i2c_scan_data.nextScanId++;
+    if (_i2c_scan_data.nextScanId == 0) {
+        _i2c_scan_data.nextScanId = 1;
+    }
+    {
+        std::lock_guard<std::mutex> progress_lock(_i2c_scan_data.progressMutex);
+        _i2c_scan_data.progress             = I2cScanProgress_t();
+        _i2c_scan_data.progress.scanId      = scan_id;
+        _i2c_scan_data.progress.isInternal  = isInternal;
+        _i2c_scan_data.progress.nextAddress = _first_address;
+    }
+    _i2c_scan_data.bus         = bus;
+    _i2c_scan_data.isCancelled = false;
+
+    // On the shared pool, the scan is mostly waiting on NAKs
+    _i2c_scan_data.isRunning = submitJob([this]() {
+        i2c_scan_loop();
+        xSemaphoreGive(_i2c_scan_data.exitSem);
+    });
+    if (!_i2c_scan_data.isRunning) {
+        mclog::tagError(_tag, "submit job failed");
+        return 0;
+    }
+    return scan_id;
+}
+
+bool HalEsp32::getI2cScanProgress(I2cScanProgress_t& progress)
+{
+    std::lock_guard<std::mutex> lock(_i2c_scan_data.progressMutex);
+    if (_i2c_scan_data.progress.scanId == 0) {
+        return false;
+    }
+    progress = _i2c_scan_data.progress;
+    return true;
+}
+
+void HalEsp32::cancelI2cScan()
+{
+    std::lock_guard<std::mutex> lock(_i2c_scan_data.mutex);
+    join_i2c_scan_job();
+
+    std::lock_guard<std::mutex> progress_lock(_i2c_scan_data.progressMutex);
+    _i2c_scan_data.progress.isDone = true;
+}
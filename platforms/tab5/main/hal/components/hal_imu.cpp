@@ -4,7 +4,13 @@
  * SPDX-License-Identifier: MIT
  */
 #include "hal/hal_esp32.h"
+#include <hal/spsc_ring.h>
+#include "../utils/imu_fusion/imu_fusion.h"
+#include "../utils/imu_driver/imu_driver.h"
 #include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <vector>
 #include <driver/gpio.h>
 #include <memory>
@@ -15,45 +21,448 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "esp_timer.h"
-#include "accel_gyro_bmi270.h"
 
 static const std::string _tag = "imu";
 
+// Bursts of this long, the INT pins are not wired to the P4, so the task wakes on the watermark period instead
+static constexpr uint32_t _stream_burst_ms = 20;
+// Integrated gyro angle per sample, 320 ms at 400 Hz
+static constexpr size_t _angle_history_size = 128;
+// Samples come in tenths of dps
+static constexpr float _gyro_to_rad = 0.1f * 3.14159265f / 180.0f;
+
+struct ImuAngle_t {
+    uint64_t timestampUs = 0;
+    float angle[3]       = {0.0f, 0.0f, 0.0f};
+};
+
+struct ImuStreamData_t {
+    std::mutex mutex;
+    std::atomic<bool> isRunning{false};
+    SemaphoreHandle_t exitSem = nullptr;
+    uint16_t rateHz           = 400;
+    SpscRing<hal::HalBase::ImuSample_t> ring;
+    uint32_t droppedSamples = 0;
+    ImuFusion fusion;
+    // Latest sample for updateImuData() and the fused estimate
+    std::mutex latestMutex;
+    hal::HalBase::ImuSample_t latest;
+    hal::HalBase::ImuOrientation_t orientation;
+    bool hasOrientation = false;
+    // Under latestMutex too, the head is the newest entry
+    ImuAngle_t angleHistory[_angle_history_size];
+    size_t angleHead  = 0;
+    size_t angleCount = 0;
+};
+static ImuStreamData_t _imu_stream_data;
+
+// Whichever chip the board has, probed once at init
+static std::unique_ptr<ImuDriver> _imu_driver;
+// The chip driver state is shared, the stream and gesture tasks take turns on it
+static std::mutex _imu_driver_mutex;
+
+// Latched status is picked up this often, one two byte register read
+static constexpr uint32_t _gesture_poll_ms = 50;
+
+struct ImuGestureData_t {
+    std::mutex mutex;
+    std::atomic<bool> isRunning{false};
+    SemaphoreHandle_t exitSem = nullptr;
+    uint8_t gestureMask       = 0;
+    hal::HalBase::ImuGestureCallback_t onGesture;
+};
+static ImuGestureData_t _imu_gesture_data;
+
+static void to_imu_sample(const ImuDriver::RawFrame_t& frame, const ImuDriver::Conversion_t& conv,
+                          hal::HalBase::ImuSample_t& sample)
+{
+    /* 根据设置量程转换 */
+    sample.accelX = frame.accel[conv.accelAxis[0]] * conv.accelScale[0];
+    sample.accelY = frame.accel[conv.accelAxis[1]] * conv.accelScale[1];
+    sample.accelZ = frame.accel[conv.accelAxis[2]] * conv.accelScale[2];
+    sample.gyroX  = frame.gyro[conv.gyroAxis[0]] * conv.gyroScale[0];
+    sample.gyroY  = frame.gyro[conv.gyroAxis[1]] * conv.gyroScale[1];
+    sample.gyroZ  = frame.gyro[conv.gyroAxis[2]] * conv.gyroScale[2];
+}
+
+static void to_imu_data(const hal::HalBase::ImuSample_t& sample, hal::HalBase::IMUData_t& data)
+{
+    data.accelX = sample.accelX;
+    data.accelY = sample.accelY;
+    data.accelZ = sample.accelZ;
+    data.gyroX  = sample.gyroX;
+    data.gyroY  = sample.gyroY;
+    data.gyroZ  = sample.gyroZ;
+}
+
+// Fusion runs on the raw chip axes, which are right handed, the published gravity takes the IMUData_t axes
+static void update_fusion(const ImuDriver::RawFrame_t& frame, const ImuDriver::Conversion_t& conv,
+                          uint64_t timestampUs, hal::HalBase::ImuOrientation_t& orientation)
+{
+    auto& fusion = _imu_stream_data.fusion;
+    fusion.update(frame.gyro[0] * conv.gyroRadScale, frame.gyro[1] * conv.gyroRadScale,
+                  frame.gyro[2] * conv.gyroRadScale, frame.accel[0], frame.accel[1], frame.accel[2]);
+
+    float gravity[3];
+    float board_gravity[3];
+    fusion.getGravity(gravity);
+    conv.remapAccel(gravity, board_gravity);
+    fusion.getQuaternion(orientation.quaternion);
+    orientation.timestampUs = timestampUs;
+    orientation.gravityX    = board_gravity[0];
+    orientation.gravityY    = board_gravity[1];
+    orientation.gravityZ    = board_gravity[2];
+}
+
+// Rectangle rule over the sample period, called with latestMutex held
+static void push_gyro_angles(const hal::HalBase::ImuSample_t* samples, uint16_t count, uint32_t samplePeriodUs)
+{
+    auto& data = _imu_stream_data;
+    float dt   = samplePeriodUs / 1000000.0f * _gyro_to_rad;
+    for (uint16_t i = 0; i < count; i++) {
+        const ImuAngle_t& last = data.angleHistory[data.angleHead];
+        size_t head            = (data.angleHead + 1) % _angle_history_size;
+        ImuAngle_t& next       = data.angleHistory[head];
+        next.timestampUs       = samples[i].timestampUs;
+        next.angle[0]          = last.angle[0] + samples[i].gyroX * dt;
+        next.angle[1]          = last.angle[1] + samples[i].gyroY * dt;
+        next.angle[2]          = last.angle[2] + samples[i].gyroZ * dt;
+        data.angleHead         = head;
+        data.angleCount        = std::min(data.angleCount + 1, _angle_history_size);
+    }
+}
+
+static void _imu_stream_task(void* param)
+{
+    // At most one FIFO worth per read
+    const uint16_t max_frames = _imu_driver->fifoCapacity();
+    const auto& conversion    = _imu_driver->conversion();
+    std::vector<ImuDriver::RawFrame_t> raw(max_frames);
+    std::vector<hal::HalBase::ImuSample_t> samples(max_frames);
+
+    const uint32_t sample_period_us = 1000000 / _imu_stream_data.rateHz;
+    TickType_t last_wake            = xTaskGetTickCount();
+
+    while (_imu_stream_data.isRunning) {
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(_stream_burst_ms));
+
+        uint16_t frames = 0;
+        {
+            std::lock_guard<std::mutex> lock(_imu_driver_mutex);
+            HalEsp32::i2cScheduler().run(I2cBusScheduler::PRIORITY_SENSOR, _imu_driver->address(), [&]() {
+                frames = _imu_driver->fifoRead(raw.data(), max_frames);
+                return true;
+            });
+        }
+        if (frames == 0) {
+            continue;
+        }
+
+        // The newest frame was sampled about now, the rest are spaced back by the ODR
+        uint64_t now = esp_timer_get_time();
+        hal::HalBase::ImuOrientation_t orientation;
+        for (uint16_t i = 0; i < frames; i++) {
+            to_imu_sample(raw[i], conversion, samples[i]);
+            samples[i].timestampUs = now - (uint64_t)(frames - 1 - i) * sample_period_us;
+            update_fusion(raw[i], conversion, samples[i].timestampUs, orientation);
+        }
+
+        size_t written = _imu_stream_data.ring.write(samples.data(), frames);
+        _imu_stream_data.droppedSamples += frames - written;
+
+        {
+            std::lock_guard<std::mutex> lock(_imu_stream_data.latestMutex);
+            _imu_stream_data.latest         = samples[frames - 1];
+            _imu_stream_data.orientation    = orientation;
+            _imu_stream_data.hasOrientation = true;
+            push_gyro_angles(samples.data(), frames, sample_period_us);
+        }
+        hal::HalBase::IMUData_t data;
+        to_imu_data(samples[frames - 1], data);
+        GetHAL()->imuSnapshot.publish(data, now / 1000);
+    }
+
+    _imu_driver_mutex.lock();
+    _imu_driver->fifoDisable();
+    _imu_driver_mutex.unlock();
+    mclog::tagInfo(_tag, "stream stop, {} samples dropped", _imu_stream_data.droppedSamples);
+    xSemaphoreGive(_imu_stream_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+bool HalEsp32::startImuStream(uint16_t rateHz)
+{
+    std::lock_guard<std::mutex> lock(_imu_stream_data.mutex);
+
+    if (_imu_stream_data.isRunning) {
+        return true;
+    }
+    if (!_imu_driver) {
+        return false;
+    }
+
+    // Watermark at one burst, so a read normally drains what the FIFO flagged
+    uint16_t watermark = std::max<uint32_t>(rateHz * _stream_burst_ms / 1000, 1);
+    _imu_driver_mutex.lock();
+    // The chip may round the rate to one of its own, the timestamps and the fusion take what it runs at
+    rateHz = _imu_driver->fifoEnable(rateHz, watermark);
+    _imu_driver_mutex.unlock();
+    if (rateHz == 0) {
+        mclog::tagError(_tag, "enable fifo failed");
+        return false;
+    }
+
+    _imu_stream_data.rateHz         = rateHz;
+    _imu_stream_data.droppedSamples = 0;
+    {
+        std::lock_guard<std::mutex> latest_lock(_imu_stream_data.latestMutex);
+        _imu_stream_data.hasOrientation                           = false;
+        _imu_stream_data.angleHistory[_imu_stream_data.angleHead] = ImuAngle_t();
+        _imu_stream_data.angleCount                               = 0;
+    }
+    ImuFusion::Config_t fusion_config;
+    fusion_config.sampleRate = rateHz;
+    _imu_stream_data.fusion.init(fusion_config);
+    // Half a second of samples
+    _imu_stream_data.ring.init(rateHz / 2);
+    if (_imu_stream_data.exitSem == nullptr) {
+        _imu_stream_data.exitSem = xSemaphoreCreateBinary();
+    }
+
+    _imu_stream_data.isRunning = true;
+    if (xTaskCreate(_imu_stream_task, "imu", 4096, nullptr, 5, nullptr) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _imu_stream_data.isRunning = false;
+        _imu_driver->fifoDisable();
+        return false;
+    }
+
+    mclog::tagInfo(_tag, "stream start, {} Hz", rateHz);
+    return true;
+}
+
+void HalEsp32::stopImuStream()
+{
+    std::lock_guard<std::mutex> lock(_imu_stream_data.mutex);
+
+    if (!_imu_stream_data.isRunning) {
+        return;
+    }
+    _imu_stream_data.isRunning = false;
+    xSemaphoreTake(_imu_stream_data.exitSem, portMAX_DELAY);
+}
+
+bool HalEsp32::isImuStreaming()
+{
+    return _imu_stream_data.isRunning;
+}
+
+size_t HalEsp32::readImuSamples(ImuSample_t* samples, size_t maxCount)
+{
+    return _imu_stream_data.ring.read(samples, maxCount);
+}
+
+bool HalEsp32::getImuGyroAngle(uint64_t timestampUs, float angle[3])
+{
+    std::lock_guard<std::mutex> lock(_imu_stream_data.latestMutex);
+    const auto& data = _imu_stream_data;
+    if (!data.isRunning || data.angleCount < 2) {
+        return false;
+    }
+
+    // Walk back from the newest to the entry at or before the time, the oldest one bounds it
+    size_t i_new = data.angleHead;
+    size_t i_old = (i_new + _angle_history_size - 1) % _angle_history_size;
+    for (size_t n = 2; n < data.angleCount && data.angleHistory[i_old].timestampUs > timestampUs; n++) {
+        i_new = i_old;
+        i_old = (i_old + _angle_history_size - 1) % _angle_history_size;
+    }
+    const ImuAngle_t& a = data.angleHistory[i_old];
+    const ImuAngle_t& b = data.angleHistory[i_new];
+
+    // Linear between the two, past the newest the last rate carries on for at most two bursts
+    float span = (float)(b.timestampUs - a.timestampUs);
+    float k    = span > 0 ? (int64_t)(timestampUs - a.timestampUs) / span : 1.0f;
+    k          = std::clamp(k, 0.0f, 1.0f + _stream_burst_ms * 2000.0f / std::max(span, 1.0f));
+    for (int i = 0; i < 3; i++) {
+        angle[i] = a.angle[i] + (b.angle[i] - a.angle[i]) * k;
+    }
+    return true;
+}
+
+bool HalEsp32::getImuOrientation(ImuOrientation_t& orientation)
+{
+    std::lock_guard<std::mutex> lock(_imu_stream_data.latestMutex);
+    if (!_imu_stream_data.isRunning || !_imu_stream_data.hasOrientation) {
+        return false;
+    }
+    orientation = _imu_stream_data.orientation;
+    return true;
+}
+
+static void _imu_gesture_task(void* param)
+{
+    const hal::HalBase::ImuGesture_t gesture_list[] = {
+        hal::HalBase::IMU_GESTURE_SINGLE_TAP,
+        hal::HalBase::IMU_GESTURE_DOUBLE_TAP,
+        hal::HalBase::IMU_GESTURE_ORIENTATION,
+        hal::HalBase::IMU_GESTURE_NO_MOTION,
+    };
+
+    while (_imu_gesture_data.isRunning) {
+        vTaskDelay(pdMS_TO_TICKS(_gesture_poll_ms));
+
+        uint8_t gestures           = 0;
+        uint8_t portrait_landscape = 0;
+        uint8_t face_down          = 0;
+        {
+            std::lock_guard<std::mutex> lock(_imu_driver_mutex);
+            HalEsp32::i2cScheduler().run(I2cBusScheduler::PRIORITY_SENSOR, _imu_driver->address(), [&]() {
+                gestures = _imu_driver->gesturePoll(&portrait_landscape, &face_down);
+                return true;
+            });
+        }
+        // The driver masks match the hal ones
+        gestures &= _imu_gesture_data.gestureMask;
+        if (gestures == 0) {
+            continue;
+        }
+
+        for (auto gesture : gesture_list) {
+            if (!(gestures & gesture)) {
+                continue;
+            }
+            hal::HalBase::ImuGestureEvent_t event;
+            event.gesture     = gesture;
+            event.orientation = (hal::HalBase::ImuOrientationState_t)(portrait_landscape & 0x03);
+            event.faceDown    = face_down != 0;
+            mclog::tagInfo(_tag, "gesture: {}", (int)gesture);
+            if (_imu_gesture_data.onGesture) {
+                _imu_gesture_data.onGesture(event);
+            }
+        }
+        GetHAL()->wakeAppLoop();
+    }
+
+    xSemaphoreGive(_imu_gesture_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+bool HalEsp32::startImuGestures(uint8_t gestureMask, ImuGestureCallback_t onGesture)
+{
+    std::lock_guard<std::mutex> lock(_imu_gesture_data.mutex);
+
+    if (_imu_gesture_data.isRunning) {
+        mclog::tagWarn(_tag, "gestures already running");
+        return false;
+    }
+    if (!_imu_driver || !_imu_driver->hasGestures()) {
+        mclog::tagWarn(_tag, "no gesture engine on this imu");
+        return false;
+    }
+
+    // Loading the feature config resets the sensor, so the stream is restarted around it
+    bool is_streaming = isImuStreaming();
+    uint16_t rate_hz  = _imu_stream_data.rateHz;
+    stopImuStream();
+
+    bool ok = false;
+    {
+        std::lock_guard<std::mutex> driver_lock(_imu_driver_mutex);
+        ok = _imu_driver->gestureEnable(gestureMask & IMU_GESTURE_ALL);
+    }
+    if (is_streaming) {
+        startImuStream(rate_hz);
+    }
+    if (!ok) {
+        mclog::tagError(_tag, "enable gestures failed");
+        return false;
+    }
+
+    _imu_gesture_data.gestureMask = gestureMask;
+    _imu_gesture_data.onGesture   = onGesture;
+    if (_imu_gesture_data.exitSem == nullptr) {
+        _imu_gesture_data.exitSem = xSemaphoreCreateBinary();
+    }
+
+    _imu_gesture_data.isRunning = true;
+    if (xTaskCreate(_imu_gesture_task, "imu_gesture", 4096, nullptr, 4, nullptr) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _imu_gesture_data.isRunning = false;
+        return false;
+    }
+    return true;
+}
+
+void HalEsp32::stopImuGestures()
+{
+    std::lock_guard<std::mutex> lock(_imu_gesture_data.mutex);
+
+    if (!_imu_gesture_data.isRunning) {
+        return;
+    }
+    _imu_gesture_data.isRunning = false;
+    xSemaphoreTake(_imu_gesture_data.exitSem, portMAX_DELAY);
+    _imu_gesture_data.onGesture = nullptr;
+}
+
 void HalEsp32::clearImuIrq()
 {
-    mclog::tagInfo(_tag, "clear imu irq");
-    accel_gyro_bmi270_init(bsp_i2c_get_handle());
-    if (accel_gyro_bmi270_check_irq()) {
-        accel_gyro_bmi270_clear_irq_int();
-        mclog::tagInfo(_tag, "imu irq detected! clear it!");
+    // Reinitializes the sensor, the stream would read a half configured FIFO
+    stopImuStream();
+    stopImuGestures();
+
+    if (!_imu_driver) {
+        return;
     }
+    mclog::tagInfo(_tag, "clear imu irq");
+    std::lock_guard<std::mutex> lock(_imu_driver_mutex);
+    _imu_driver->init(bsp_i2c_get_handle());
 }
 
 void HalEsp32::imu_init()
 {
     mclog::tagInfo(_tag, "imu init");
 
-    accel_gyro_bmi270_init(bsp_i2c_get_handle());
-    if (accel_gyro_bmi270_check_irq()) {
-        accel_gyro_bmi270_clear_irq_int();
-        mclog::tagInfo(_tag, "imu irq detected! clear it!");
+    _imu_driver = ImuDriver::probe(bsp_i2c_get_handle());
+    if (!_imu_driver) {
+        mclog::tagError(_tag, "no imu found");
+        return;
+    }
+    mclog::tagInfo(_tag, "found {}", _imu_driver->name());
+    if (!_imu_driver->init(bsp_i2c_get_handle())) {
+        mclog::tagError(_tag, "{} init failed", _imu_driver->name());
+        _imu_driver.reset();
+        return;
     }
-    accel_gyro_bmi270_enable_sensor();
+    _imu_driver->enable();
 }
 
 void HalEsp32::updateImuData()
 {
-    static struct bmi2_sens_data bmi_sensor_data;
-    accel_gyro_bmi270_get_data(&bmi_sensor_data);
+    IMUData_t data;
+    read_imu_data(data);
+    imuSnapshot.publish(data, millis());
+}
 
-    /* 根据设置量程转换 */
-    imuData.accelX = bmi_sensor_data.acc.y / 835.92 / 10.0f;  // m/s^2
-    imuData.accelY = -bmi_sensor_data.acc.x / 835.92 / 10.0f;
-    imuData.accelZ = -bmi_sensor_data.acc.z / 835.92 / 10.0f;
-    imuData.gyroX  = bmi_sensor_data.gyr.y / 32.768 / 10.0f;  // °/s   gyro_raw*2*1000/2^16 --> 0.0305
-    imuData.gyroY  = bmi_sensor_data.gyr.x / 32.768 / 10.0f;
-    imuData.gyroZ  = -bmi_sensor_data.gyr.z / 32.768 / 10.0f;
+void HalEsp32::read_imu_data(IMUData_t& data)
+{
+    hal::HalBase::ImuSample_t sample;
+    if (_imu_stream_data.isRunning) {
+        // Latest streamed sample, no bus transaction on the caller's thread
+        std::lock_guard<std::mutex> lock(_imu_stream_data.latestMutex);
+        sample = _imu_stream_data.latest;
+    } else if (_imu_driver) {
+        ImuDriver::RawFrame_t frame = {};
+        std::lock_guard<std::mutex> lock(_imu_driver_mutex);
+        i2cScheduler().run(I2cBusScheduler::PRIORITY_SENSOR, _imu_driver->address(),
+                           [&]() { return _imu_driver->readFrame(frame); });
+        to_imu_sample(frame, _imu_driver->conversion(), sample);
+    }
+
+    to_imu_data(sample, data);
 }
 
 void HalEsp32::sleepAndShakeWakeup()
@@ -66,7 +475,9 @@ void HalEsp32::sleepAndShakeWakeup()
     delay(200);
 
     mclog::tagInfo(_tag, "set motion irq");
-    accel_gyro_bmi270_motion_irq();
+    if (!_imu_driver || !_imu_driver->motionWakeup()) {
+        mclog::tagWarn(_tag, "no motion wakeup on this imu");
+    }
 
     // delay(800);
     powerOff();
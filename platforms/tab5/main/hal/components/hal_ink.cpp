@@ -0,0 +1,248 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+#include <esp_lvgl_port.h>
+
+static const std::string _tag = "ink";
+
+// Everything but isInking is used under the LVGL lock, the touch read callback runs with it taken
+struct InkData_t {
+    std::atomic<bool> isInking{false};
+    hal::HalBase::InkConfig_t config;
+    lv_display_t* display = nullptr;
+    // Canvas pixels on screen, as placed when inking started
+    lv_area_t canvasArea;
+    // Stroke coverage per canvas pixel. A segment only adds what a pixel gains over it, so the overlapping ends of
+    // two segments are not blended twice and the joints come out as even as the rest of the line
+    std::vector<uint8_t> coverage;
+    // Alpha of the segment being drawn, over its bounding box
+    std::vector<lv_opa_t> mask;
+    bool isDown = false;
+    lv_point_t last;
+    bool isDirty = false;
+    lv_area_t dirty;
+    uint32_t lastSyncMs = 0;
+    bool isFrontWarned  = false;
+};
+static InkData_t _ink_data;
+
+// Panel to LVGL coordinates, the way the indev maps them for the current rotation
+static lv_point_t to_screen(lv_display_t* disp, int32_t x, int32_t y)
+{
+    int32_t hor_res           = lv_display_get_physical_horizontal_resolution(disp);
+    int32_t ver_res           = lv_display_get_physical_vertical_resolution(disp);
+    lv_display_rotation_t rot = lv_display_get_rotation(disp);
+    if (rot == LV_DISPLAY_ROTATION_180 || rot == LV_DISPLAY_ROTATION_270) {
+        x = hor_res - x - 1;
+        y = ver_res - y - 1;
+    }
+    if (rot == LV_DISPLAY_ROTATION_90 || rot == LV_DISPLAY_ROTATION_270) {
+        int32_t tmp = y;
+        y           = x;
+        x           = ver_res - tmp - 1;
+    }
+    return {x, y};
+}
+
+// LVGL brings the canvas on screen in line with what the front buffer shows already
+static void sync_canvas()
+{
+    if (_ink_data.isDirty) {
+        lv_obj_invalidate_area(_ink_data.config.canvas, &_ink_data.dirty);
+        _ink_data.isDirty = false;
+    }
+    _ink_data.lastSyncMs = lv_tick_get();
+}
+
+// Fills the mask over area for the round capped line p0 - p1, false when it adds nothing
+static bool rasterize_segment(const lv_point_t& p0, const lv_point_t& p1, const lv_area_t& area)
+{
+    int32_t w        = lv_area_get_width(&area);
+    int32_t h        = lv_area_get_height(&area);
+    int32_t canvas_w = lv_area_get_width(&_ink_data.canvasArea);
+    float radius     = _ink_data.config.width / 2.0f;
+    float dx         = p1.x - p0.x;
+    float dy         = p1.y - p0.y;
+    float len2       = dx * dx + dy * dy;
+    bool is_drawn    = false;
+    _ink_data.mask.resize(w * h);
+
+    for (int32_t y = 0; y < h; y++) {
+        uint8_t* coverage = _ink_data.coverage.data() + (area.y1 - _ink_data.canvasArea.y1 + y) * canvas_w +
+                            (area.x1 - _ink_data.canvasArea.x1);
+        lv_opa_t* mask = _ink_data.mask.data() + y * w;
+        float py       = area.y1 + y - p0.y;
+        for (int32_t x = 0; x < w; x++) {
+            float px = area.x1 + x - p0.x;
+            float t  = len2 > 0.0f ? std::clamp((px * dx + py * dy) / len2, 0.0f, 1.0f) : 0.0f;
+            float ex = px - t * dx;
+            float ey = py - t * dy;
+            // One pixel wide ramp across the edge
+            float cov      = std::clamp(radius + 0.5f - std::sqrt(ex * ex + ey * ey), 0.0f, 1.0f);
+            uint8_t target = (uint8_t)(cov * 255.0f + 0.5f);
+            uint8_t old    = coverage[x];
+            if (target <= old) {
+                mask[x] = 0;
+                continue;
+            }
+            // Blending a over old coverage c gives c + a * (255 - c), solved for the target
+            mask[x]     = (lv_opa_t)((target - old) * 255 / (255 - old));
+            coverage[x] = target;
+            is_drawn    = true;
+        }
+    }
+    return is_drawn;
+}
+
+static void draw_segment(const lv_point_t& p0, const lv_point_t& p1)
+{
+    int32_t reach = (int32_t)std::ceil(_ink_data.config.width / 2.0f) + 1;
+    lv_area_t area;
+    area.x1 = std::min(p0.x, p1.x) - reach;
+    area.y1 = std::min(p0.y, p1.y) - reach;
+    area.x2 = std::max(p0.x, p1.x) + reach;
+    area.y2 = std::max(p0.y, p1.y) + reach;
+    if (!lv_area_intersect(&area, &area, &_ink_data.canvasArea) || !rasterize_segment(p0, p1, area)) {
+        return;
+    }
+
+    int32_t w = lv_area_get_width(&area);
+    if (lvgl_port_blend_front(_ink_data.display, &area, _ink_data.mask.data(), _ink_data.config.color) != ESP_OK) {
+        // Not a vsync swap display, LVGL renders the segment as any other change
+        if (!_ink_data.isFrontWarned) {
+            mclog::tagWarn(_tag, "no front buffer blend, strokes wait for the LVGL render");
+            _ink_data.isFrontWarned = true;
+        }
+        lv_obj_invalidate_area(_ink_data.config.canvas, &area);
+    }
+
+    lv_draw_buf_t* buf = lv_canvas_get_draw_buf(_ink_data.config.canvas);
+    uint32_t stride    = buf->header.stride / sizeof(uint16_t);
+    uint16_t* dst =
+        (uint16_t*)buf->data + (area.y1 - _ink_data.canvasArea.y1) * stride + (area.x1 - _ink_data.canvasArea.x1);
+    lvgl_port_blend_mask_rgb565(dst, stride, _ink_data.mask.data(), w, w, lv_area_get_height(&area),
+                                lv_color_to_u16(_ink_data.config.color));
+
+    if (_ink_data.isDirty) {
+        lv_area_join(&_ink_data.dirty, &_ink_data.dirty, &area);
+    } else {
+        _ink_data.dirty   = area;
+        _ink_data.isDirty = true;
+    }
+}
+
+void HalEsp32::inkProcessTouch(bool isPressed, int32_t x, int32_t y)
+{
+    if (!_ink_data.isInking) {
+        return;
+    }
+
+    if (!isPressed) {
+        if (_ink_data.isDown) {
+            _ink_data.isDown = false;
+            sync_canvas();
+        }
+        return;
+    }
+
+    lv_point_t point = to_screen(_ink_data.display, x, y);
+    if (!_ink_data.isDown) {
+        // Strokes start on the canvas, once started they are clipped to it
+        if (!lv_area_is_point_on(&_ink_data.canvasArea, &point, 0)) {
+            return;
+        }
+        _ink_data.isDown = true;
+        _ink_data.last   = point;
+    }
+    draw_segment(_ink_data.last, point);
+    _ink_data.last = point;
+
+    if (lv_tick_elaps(_ink_data.lastSyncMs) >= _ink_data.config.syncMs) {
+        sync_canvas();
+    }
+}
+
+bool HalEsp32::startInk(const InkConfig_t& config)
+{
+    LvglLockGuard lock;
+
+    if (_ink_data.isInking) {
+        mclog::tagWarn(_tag, "already inking");
+        return false;
+    }
+    if (config.canvas == nullptr || !lv_obj_check_type(config.canvas, &lv_canvas_class)) {
+        mclog::tagError(_tag, "not a canvas");
+        return false;
+    }
+    lv_draw_buf_t* buf = lv_canvas_get_draw_buf(config.canvas);
+    if (buf == nullptr || buf->header.cf != LV_COLOR_FORMAT_RGB565) {
+        mclog::tagError(_tag, "canvas needs an RGB565 buffer");
+        return false;
+    }
+
+    // The buffer's pixels as the canvas shows them, a canvas bigger than its buffer shows nothing past it
+    lv_obj_update_layout(config.canvas);
+    lv_area_t area;
+    lv_obj_get_coords(config.canvas, &area);
+    area.x2 = std::min<int32_t>(area.x2, area.x1 + buf->header.w - 1);
+    area.y2 = std::min<int32_t>(area.y2, area.y1 + buf->header.h - 1);
+    if (lv_area_get_width(&area) <= 0 || lv_area_get_height(&area) <= 0) {
+        mclog::tagError(_tag, "canvas is empty");
+        return false;
+    }
+
+    _ink_data.config     = config;
+    _ink_data.display    = lv_obj_get_display(config.canvas);
+    _ink_data.canvasArea = area;
+    _ink_data.coverage.assign(lv_area_get_size(&area), 0);
+    _ink_data.isDown     = false;
+    _ink_data.isDirty    = false;
+    _ink_data.lastSyncMs = lv_tick_get();
+    _ink_data.isInking   = true;
+
+    mclog::tagInfo(_tag, "start on {}x{} at ({}, {}), width {:.1f}, sync {} ms", lv_area_get_width(&area),
+                   lv_area_get_height(&area), area.x1, area.y1, config.width, config.syncMs);
+    return true;
+}
+
+void HalEsp32::stopInk()
+{
+    LvglLockGuard lock;
+
+    if (!_ink_data.isInking) {
+        return;
+    }
+    sync_canvas();
+    _ink_data.isInking = false;
+    _ink_data.isDown   = false;
+    std::vector<uint8_t>().swap(_ink_data.coverage);
+    std::vector<lv_opa_t>().swap(_ink_data.mask);
+    mclog::tagInfo(_tag, "stop");
+}
+
+bool HalEsp32::isInking()
+{
+    return _ink_data.isInking;
+}
+
+void HalEsp32::clearInk(lv_color_t bg)
+{
+    LvglLockGuard lock;
+
+    if (!_ink_data.isInking) {
+        return;
+    }
+    // Filling the canvas invalidates all of it, the front buffer is rendered over as usual
+    lv_canvas_fill_bg(_ink_data.config.canvas, bg, LV_OPA_COVER);
+    std::fill(_ink_data.coverage.begin(), _ink_data.coverage.end(), 0);
+    _ink_data.isDown  = false;
+    _ink_data.isDirty = false;
+}
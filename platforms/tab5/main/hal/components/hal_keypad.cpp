@@ -0,0 +1,339 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <hal/spsc_ring.h>
+#include <mooncake_log.h>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <bsp/m5stack_tab5.h>
+#include <driver/gpio.h>
+#include <esp_lvgl_port.h>
+#include <esp_timer.h>
+#include <keypad_scanner_tca8418.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+static const std::string _tag = "keypad";
+
+static constexpr uint8_t _tca8418_addr = 0x34;
+// Scanner interrupt, open drain and active low, on the Ext.Port header
+static constexpr gpio_num_t _int_pin = GPIO_NUM_50;
+// 8 x 9 matrix, event codes 1 to 80 are row * 10 + column + 1
+static constexpr uint8_t _rows            = 8;
+static constexpr uint8_t _columns         = 9;
+static constexpr uint8_t _max_matrix_code = 80;
+// INT_STAT bits, key events and GPI changes
+static constexpr uint8_t _int_stat_mask = 0x03;
+
+struct KeypadEvent_t {
+    uint32_t key   = 0;
+    bool isPressed = false;
+};
+
+struct KeypadData_t {
+    std::mutex mutex;
+    std::atomic<bool> isRunning{false};
+    TaskHandle_t task         = nullptr;
+    SemaphoreHandle_t exitSem = nullptr;
+    std::atomic<uint16_t> repeatDelayMs{0};
+    std::atomic<uint16_t> repeatIntervalMs{0};
+    // Keypad task to the LVGL read callback, input never waits on the LVGL lock
+    SpscRing<KeypadEvent_t> ring;
+    std::atomic<uint32_t> events{0};
+    std::atomic<uint32_t> repeats{0};
+    std::atomic<uint32_t> dropped{0};
+    // LVGL task only
+    KeypadEvent_t lastEvent;
+};
+static KeypadData_t _keypad_data;
+
+static void IRAM_ATTR keypad_isr(void* arg)
+{
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(_keypad_data.task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+static void push_event(uint32_t key, bool isPressed)
+{
+    KeypadEvent_t event;
+    event.key       = key;
+    event.isPressed = isPressed;
+    // A full ring means LVGL is stalled, the newest events are the ones to lose
+    if (_keypad_data.ring.write(&event, 1) == 0) {
+        _keypad_data.dropped++;
+    }
+}
+
+// The key caps as printed, modifiers come back as 0
+static uint32_t map_key(uint8_t code, bool isShift, bool isCaps)
+{
+    std::string label = key_value_map_str[code - 1];
+    label.erase(0, label.find_first_not_of(' '));
+    label.erase(label.find_last_not_of(' ') + 1);
+
+    if (label.size() == 1) {
+        char c = label[0];
+        if (std::isalpha((unsigned char)c)) {
+            return (isShift != isCaps) ? std::toupper(c) : std::tolower(c);
+        }
+        return c;
+    }
+    if (label == "RET" || label == "SEL") {
+        return LV_KEY_ENTER;
+    }
+    if (label == "BS") {
+        return LV_KEY_BACKSPACE;
+    }
+    if (label == "ESC" || label == "STOP") {
+        return LV_KEY_ESC;
+    }
+    if (label == "TAB") {
+        return isShift ? LV_KEY_PREV : LV_KEY_NEXT;
+    }
+    if (label == "UP") {
+        return LV_KEY_UP;
+    }
+    if (label == "DOWN") {
+        return LV_KEY_DOWN;
+    }
+    if (label == "<-") {
+        return LV_KEY_LEFT;
+    }
+    if (label == "->") {
+        return LV_KEY_RIGHT;
+    }
+    return 0;
+}
+
+static bool is_label(uint8_t code, const char* name)
+{
+    return std::strstr(key_value_map_str[code - 1], name) != nullptr;
+}
+
+static void keypad_task(void* param)
+{
+    bool is_shift       = false;
+    bool is_caps        = false;
+    uint8_t held_code   = 0;
+    uint32_t held_key   = 0;
+    int64_t next_repeat = 0;
+
+    while (_keypad_data.isRunning) {
+        // Asleep on the interrupt line, or up to the next repeat of a held key
+        TickType_t wait = portMAX_DELAY;
+        if (held_key != 0 && _keypad_data.repeatIntervalMs > 0) {
+            int64_t left_us = next_repeat - esp_timer_get_time();
+            wait            = left_us > 0 ? pdMS_TO_TICKS(left_us / 1000) + 1 : 0;
+        }
+        ulTaskNotifyTake(pdTRUE, wait);
+        if (!_keypad_data.isRunning) {
+            break;
+        }
+
+        bool is_changed = false;
+        do {
+            uint8_t int_stat = keypad_scanner_tca8418_get_int_stat();
+            uint8_t event;
+            while ((event = keypad_scanner_tca8418_get_event()) != 0) {
+                bool is_pressed = event & 0x80;
+                uint8_t code    = event & 0x7F;
+                _keypad_data.events++;
+                // The GPI column (Fn) has no LVGL key
+                if (code == 0 || code > _max_matrix_code) {
+                    continue;
+                }
+
+                if (is_label(code, "SHIFT")) {
+                    is_shift = is_pressed;
+                    continue;
+                }
+                if (is_label(code, "CAPS")) {
+                    is_caps ^= is_pressed;
+                    continue;
+                }
+
+                uint32_t key = map_key(code, is_shift, is_caps);
+                if (key == 0) {
+                    continue;
+                }
+                if (is_pressed) {
+                    held_code   = code;
+                    held_key    = key;
+                    next_repeat = esp_timer_get_time() + _keypad_data.repeatDelayMs * 1000;
+                } else if (code == held_code) {
+                    // Released with the key it was pressed as, even if shift changed in between
+                    key      = held_key;
+                    held_key = 0;
+                }
+                push_event(key, is_pressed);
+                is_changed = true;
+            }
+            // The line is released once the status is clear, events that came in meanwhile go around again
+            keypad_scanner_tca8418_clear_int_stat(int_stat | _int_stat_mask);
+        } while (keypad_scanner_tca8418_available() > 0);
+
+        // A repeat is a release and a new press, LVGL only sends a key event on the press edge
+        int64_t now = esp_timer_get_time();
+        if (held_key != 0 && _keypad_data.repeatIntervalMs > 0 && now >= next_repeat) {
+            push_event(held_key, false);
+            push_event(held_key, true);
+            next_repeat = now + _keypad_data.repeatIntervalMs * 1000;
+            _keypad_data.repeats++;
+            is_changed = true;
+        }
+
+        // The indev is event driven, the LVGL task reads every input device on this event
+        if (is_changed) {
+            lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, nullptr);
+        }
+    }
+
+    xSemaphoreGive(_keypad_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+static void lvgl_keypad_read_cb(lv_indev_t* indev, lv_indev_data_t* data)
+{
+    // One event per read, so LVGL sees every press and release in order
+    KeypadEvent_t event;
+    if (_keypad_data.ring.read(&event, 1) == 1) {
+        _keypad_data.lastEvent = event;
+    }
+    data->continue_reading = _keypad_data.ring.available() > 0;
+
+    data->key   = _keypad_data.lastEvent.key;
+    data->state = _keypad_data.lastEvent.isPressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+bool HalEsp32::startKeypad(const KeypadConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_keypad_data.mutex);
+
+    if (_keypad_data.isRunning) {
+        return true;
+    }
+
+    initPortAI2c();
+    i2c_master_bus_handle_t bus = bsp_ext_i2c_get_handle();
+    if (bus == nullptr || i2c_master_probe(bus, _tca8418_addr, 50) != ESP_OK) {
+        mclog::tagInfo(_tag, "no keypad scanner on port a");
+        deinitPortAI2c();
+        return false;
+    }
+
+    keypad_scanner_tca8418_init(bus);
+    keypad_scanner_tca8418_matrix(_rows, _columns);
+    keypad_scanner_tca8418_flush();
+
+    _keypad_data.repeatDelayMs    = config.repeatDelayMs;
+    _keypad_data.repeatIntervalMs = config.repeatIntervalMs;
+    _keypad_data.lastEvent        = KeypadEvent_t();
+    _keypad_data.ring.init(64);
+    if (_keypad_data.exitSem == nullptr) {
+        _keypad_data.exitSem = xSemaphoreCreateBinary();
+    }
+
+    _keypad_data.isRunning = true;
+    if (xTaskCreate(keypad_task, "keypad", 4096, nullptr, 9, &_keypad_data.task) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _keypad_data.isRunning = false;
+        keypad_scanner_tca8418_deinit();
+        deinitPortAI2c();
+        return false;
+    }
+
+    gpio_config_t io_conf = {
+        .pin_bit_mask = 1ULL << _int_pin,
+        .mode         = GPIO_MODE_INPUT,
+        .pull_up_en   = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type    = GPIO_INTR_NEGEDGE,
+    };
+    gpio_config(&io_conf);
+    // Other drivers may have installed the service already
+    esp_err_t ret = gpio_install_isr_service(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        mclog::tagError(_tag, "install isr service failed");
+    }
+    gpio_isr_handler_add(_int_pin, keypad_isr, nullptr);
+    keypad_scanner_tca8418_enable_int();
+    // Anything pressed before the handler was in place is picked up now
+    xTaskNotifyGive(_keypad_data.task);
+
+    {
+        LvglLockGuard lvgl_lock;
+        lvKeypad = lv_indev_create();
+        lv_indev_set_type(lvKeypad, LV_INDEV_TYPE_KEYPAD);
+        lv_indev_set_read_cb(lvKeypad, lvgl_keypad_read_cb);
+        lv_indev_set_display(lvKeypad, lvDisp);
+        lv_indev_set_mode(lvKeypad, LV_INDEV_MODE_EVENT);
+
+        // Shares the default group with a USB keyboard
+        lv_group_t* group = lv_group_get_default();
+        if (group == nullptr) {
+            group = lv_group_create();
+            lv_group_set_default(group);
+        }
+        lv_indev_set_group(lvKeypad, group);
+    }
+
+    mclog::tagInfo(_tag, "start, repeat after {} ms every {} ms", config.repeatDelayMs, config.repeatIntervalMs);
+    return true;
+}
+
+void HalEsp32::stopKeypad()
+{
+    std::lock_guard<std::mutex> lock(_keypad_data.mutex);
+
+    if (!_keypad_data.isRunning) {
+        return;
+    }
+
+    gpio_isr_handler_remove(_int_pin);
+    _keypad_data.isRunning = false;
+    xTaskNotifyGive(_keypad_data.task);
+    xSemaphoreTake(_keypad_data.exitSem, portMAX_DELAY);
+    _keypad_data.task = nullptr;
+
+    {
+        LvglLockGuard lvgl_lock;
+        lv_indev_delete(lvKeypad);
+        lvKeypad = nullptr;
+    }
+
+    keypad_scanner_tca8418_disable_int();
+    keypad_scanner_tca8418_deinit();
+    deinitPortAI2c();
+    mclog::tagInfo(_tag, "stop");
+}
+
+bool HalEsp32::isKeypadRunning()
+{
+    return _keypad_data.isRunning;
+}
+
+void HalEsp32::setKeypadRepeat(uint16_t delayMs, uint16_t intervalMs)
+{
+    _keypad_data.repeatDelayMs    = delayMs;
+    _keypad_data.repeatIntervalMs = intervalMs;
+    if (_keypad_data.isRunning) {
+        xTaskNotifyGive(_keypad_data.task);
+    }
+}
+
+hal::HalBase::KeypadStats_t HalEsp32::getKeypadStats()
+{
+    KeypadStats_t stats;
+    stats.events  = _keypad_data.events;
+    stats.repeats = _keypad_data.repeats;
+    stats.dropped = _keypad_data.dropped;
+    return stats;
+}
@@ -0,0 +1,240 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <driver/gpio.h>
+#include <driver/parlio_rx.h>
+#include <esp_attr.h>
+#include <esp_cache.h>
+#include <esp_clk_tree.h>
+#include <esp_heap_caps.h>
+
+static const std::string _tag = "logic";
+
+// One byte per sample whatever the pin count, a lane per bit
+static constexpr size_t _data_width = 8;
+// The DMA writes the ring behind the cache, reads are invalidated in whole PSRAM cache lines
+static constexpr size_t _cache_line = 128;
+static constexpr uint32_t _min_sample_rate = 10000;
+static constexpr uint32_t _max_sample_rate = 20000000;
+
+struct LogicCaptureData_t {
+    std::mutex mutex;
+    parlio_rx_unit_handle_t unit           = nullptr;
+    parlio_rx_delimiter_handle_t delimiter = nullptr;
+    uint8_t* ring                          = nullptr;
+    size_t ringSize                        = 0;
+    // End of the latest DMA segment and wraps of the ring, written by the receive interrupt
+    std::atomic<uint32_t> head{0};
+    std::atomic<uint32_t> laps{0};
+    hal::HalBase::LogicCaptureStatus_t status;
+};
+static LogicCaptureData_t _logic_data;
+
+static bool IRAM_ATTR on_logic_partial_receive(parlio_rx_unit_handle_t unit,
+                                               const parlio_rx_event_data_t* data,
+                                               void* ctx)
+{
+    uint32_t head = (uint8_t*)data->data - _logic_data.ring + data->recv_bytes;
+    if (head >= _logic_data.ringSize) {
+        head = 0;
+    }
+    if (head < _logic_data.head.load(std::memory_order_relaxed)) {
+        _logic_data.laps.fetch_add(1, std::memory_order_relaxed);
+    }
+    _logic_data.head.store(head, std::memory_order_release);
+    return false;
+}
+
+static void release_logic_capture()
+{
+    if (_logic_data.unit) {
+        if (_logic_data.delimiter) {
+            parlio_rx_soft_delimiter_start_stop(_logic_data.unit, _logic_data.delimiter, false);
+        }
+        parlio_rx_unit_disable(_logic_data.unit);
+        parlio_del_rx_unit(_logic_data.unit);
+        _logic_data.unit = nullptr;
+    }
+    if (_logic_data.delimiter) {
+        parlio_del_rx_delimiter(_logic_data.delimiter);
+        _logic_data.delimiter = nullptr;
+    }
+    if (_logic_data.ring) {
+        heap_caps_free(_logic_data.ring);
+        _logic_data.ring = nullptr;
+    }
+    _logic_data.status = {};
+}
+
+bool HalEsp32::startLogicCapture(const LogicCaptureConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_logic_data.mutex);
+
+    if (config.pins.empty() || config.pins.size() > _data_width) {
+        mclog::tagError(_tag, "{} pins, 1 to {} supported", config.pins.size(), _data_width);
+        return false;
+    }
+    if (config.sampleRateHz < _min_sample_rate || config.sampleRateHz > _max_sample_rate) {
+        mclog::tagError(_tag, "sample rate {} Hz out of range", config.sampleRateHz);
+        return false;
+    }
+
+    release_logic_capture();
+
+    // Sampled pins never drive, a left over output would fight the signal under test
+    for (auto pin : config.pins) {
+        stopGpioWaveform(pin);
+        gpio_set_direction((gpio_num_t)pin, GPIO_MODE_INPUT);
+    }
+
+    _logic_data.ringSize = (std::max<size_t>(config.bufferSamples, _cache_line) + _cache_line - 1) / _cache_line *
+                           _cache_line;
+    _logic_data.ring =
+        (uint8_t*)heap_caps_aligned_calloc(_cache_line, 1, _logic_data.ringSize, MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA);
+    if (_logic_data.ring == nullptr) {
+        mclog::tagError(_tag, "alloc {} bytes failed", _logic_data.ringSize);
+        return false;
+    }
+    _logic_data.head = 0;
+    _logic_data.laps = 0;
+
+    parlio_rx_unit_config_t unit_config = {};
+    unit_config.trans_queue_depth       = 1;
+    unit_config.max_recv_size           = _logic_data.ringSize;
+    unit_config.data_width              = _data_width;
+    unit_config.clk_src                 = PARLIO_CLK_SRC_DEFAULT;
+    unit_config.exp_clk_freq_hz         = config.sampleRateHz;
+    unit_config.clk_in_gpio_num         = GPIO_NUM_NC;
+    unit_config.clk_out_gpio_num        = GPIO_NUM_NC;
+    unit_config.valid_gpio_num          = GPIO_NUM_NC;
+    for (size_t i = 0; i < _data_width; i++) {
+        unit_config.data_gpio_nums[i] = i < config.pins.size() ? (gpio_num_t)config.pins[i] : GPIO_NUM_NC;
+    }
+    esp_err_t ret = parlio_new_rx_unit(&unit_config, &_logic_data.unit);
+    if (ret != ESP_OK) {
+        mclog::tagError(_tag, "new rx unit failed: {}", esp_err_to_name(ret));
+        release_logic_capture();
+        return false;
+    }
+
+    // Started and stopped by software. The end of frame counter is only 16 bits, within an infinite transaction
+    // reaching it raises an event and the DMA keeps going around the ring
+    parlio_rx_soft_delimiter_config_t delimiter_config = {};
+    delimiter_config.sample_edge                       = PARLIO_SAMPLE_EDGE_POS;
+    delimiter_config.bit_pack_order                    = PARLIO_BIT_PACK_ORDER_LSB;
+    delimiter_config.eof_data_len                      = 0xFFFF;
+    delimiter_config.timeout_ticks                     = 0;
+    parlio_rx_event_callbacks_t callbacks              = {};
+    callbacks.on_partial_receive                       = on_logic_partial_receive;
+    if (parlio_new_rx_soft_delimiter(&delimiter_config, &_logic_data.delimiter) != ESP_OK ||
+        parlio_rx_unit_register_event_callbacks(_logic_data.unit, &callbacks, nullptr) != ESP_OK ||
+        parlio_rx_unit_enable(_logic_data.unit, true) != ESP_OK) {
+        mclog::tagError(_tag, "rx unit setup failed");
+        release_logic_capture();
+        return false;
+    }
+
+    // An infinite transaction, the DMA descriptors are linked into a circle over the ring
+    parlio_receive_config_t receive_config = {};
+    receive_config.delimiter               = _logic_data.delimiter;
+    receive_config.flags.partial_rx_en     = true;
+    ret = parlio_rx_unit_receive(_logic_data.unit, _logic_data.ring, _logic_data.ringSize, &receive_config);
+    if (ret != ESP_OK || parlio_rx_soft_delimiter_start_stop(_logic_data.unit, _logic_data.delimiter, true) != ESP_OK) {
+        mclog::tagError(_tag, "start receive failed: {}", esp_err_to_name(ret));
+        release_logic_capture();
+        return false;
+    }
+
+    uint32_t clock_hz = 0;
+    esp_clk_tree_src_get_freq_hz((soc_module_clk_t)PARLIO_CLK_SRC_DEFAULT, ESP_CLK_TREE_SRC_FREQ_PRECISION_CACHED,
+                                 &clock_hz);
+    uint32_t divider                = std::max<uint32_t>((clock_hz + config.sampleRateHz / 2) / config.sampleRateHz, 1);
+    _logic_data.status.running      = true;
+    _logic_data.status.lanes        = config.pins.size();
+    _logic_data.status.sampleRateHz = clock_hz / divider;
+    mclog::tagInfo(_tag, "start, {} lanes at {} Hz, {} KB ring", config.pins.size(), _logic_data.status.sampleRateHz,
+                   _logic_data.ringSize / 1024);
+    return true;
+}
+
+void HalEsp32::stopLogicCapture()
+{
+    std::lock_guard<std::mutex> lock(_logic_data.mutex);
+
+    if (_logic_data.unit) {
+        release_logic_capture();
+        mclog::tagInfo(_tag, "stop");
+    }
+}
+
+hal::HalBase::LogicCaptureStatus_t HalEsp32::getLogicCaptureStatus()
+{
+    std::lock_guard<std::mutex> lock(_logic_data.mutex);
+
+    auto status = _logic_data.status;
+    if (status.running) {
+        status.samples = (uint64_t)_logic_data.laps * _logic_data.ringSize + _logic_data.head;
+    }
+    return status;
+}
+
+uint32_t HalEsp32::getLogicEnvelope(uint32_t windowSamples, std::vector<uint8_t>& min, std::vector<uint8_t>& max)
+{
+    std::lock_guard<std::mutex> lock(_logic_data.mutex);
+
+    size_t buckets = min.size();
+    max.resize(buckets);
+    if (_logic_data.unit == nullptr || buckets == 0) {
+        return 0;
+    }
+
+    // Only up to the start of the ring before the first lap, and one cache line short of it after, the DMA may be
+    // writing the line after the head
+    uint32_t head    = _logic_data.head.load(std::memory_order_acquire);
+    size_t available = _logic_data.laps ? _logic_data.ringSize - _cache_line : head;
+    size_t window    = std::max(std::min<size_t>(windowSamples, available) / buckets, (size_t)1) * buckets;
+    if (window > available) {
+        std::fill(min.begin(), min.end(), 0);
+        std::fill(max.begin(), max.end(), 0);
+        return 0;
+    }
+    size_t start       = (head + _logic_data.ringSize - window) % _logic_data.ringSize;
+    size_t bucket_size = window / buckets;
+
+    // Drop the stale cache lines over the window, in up to two pieces around the wrap
+    size_t first_end = std::min(start + window, _logic_data.ringSize);
+    size_t sync_from = start / _cache_line * _cache_line;
+    size_t sync_to   = (first_end + _cache_line - 1) / _cache_line * _cache_line;
+    esp_cache_msync(_logic_data.ring + sync_from, sync_to - sync_from, ESP_CACHE_MSYNC_FLAG_DIR_M2C);
+    if (start + window > _logic_data.ringSize) {
+        size_t wrap_to = (start + window - _logic_data.ringSize + _cache_line - 1) / _cache_line * _cache_line;
+        esp_cache_msync(_logic_data.ring, wrap_to, ESP_CACHE_MSYNC_FLAG_DIR_M2C);
+    }
+
+    size_t pos = start;
+    for (size_t b = 0; b < buckets; b++) {
+        uint8_t and_bits = 0xFF;
+        uint8_t or_bits  = 0x00;
+        for (size_t left = bucket_size; left > 0;) {
+            size_t run         = std::min(left, _logic_data.ringSize - pos);
+            const uint8_t* src = _logic_data.ring + pos;
+            for (size_t i = 0; i < run; i++) {
+                and_bits &= src[i];
+                or_bits |= src[i];
+            }
+            left -= run;
+            pos = (pos + run) % _logic_data.ringSize;
+        }
+        min[b] = and_bits;
+        max[b] = or_bits;
+    }
+    return window;
+}
@@ -0,0 +1,191 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include "../utils/event_trace/event_trace.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <string.h>
+#include <vector>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_lvgl_port.h>
+#include <esp_timer.h>
+
+static const std::string _tag = "lvgl-lock";
+
+// Sites past this are counted on the last one
+static constexpr size_t _max_sites = 32;
+// Commands posted over this before the LVGL task runs them are dropped
+static constexpr size_t _ui_command_queue_size = 32;
+
+struct LvglLockSite_t {
+    const char* site     = nullptr;
+    uint32_t count       = 0;
+    uint64_t waitTotalUs = 0;
+    uint32_t waitMaxUs   = 0;
+    uint32_t waitCount   = 0;
+    uint64_t holdTotalUs = 0;
+    uint32_t holdMaxUs   = 0;
+    uint32_t holdCount   = 0;
+};
+
+struct LvglLockData_t {
+    // Only changed by the task holding the LVGL lock, the lock is recursive
+    int depth = 0;
+    // The rest is also read by getLvglLockStats()
+    std::mutex statsMutex;
+    LvglLockSite_t* holder  = nullptr;
+    TaskHandle_t holderTask = nullptr;
+    int64_t holdStartUs     = 0;
+    LvglLockSite_t sites[_max_sites];
+    size_t siteNum = 0;
+    // UI commands, run on the LVGL task
+    std::mutex queueMutex;
+    std::vector<std::function<void()>> commands;
+    std::vector<std::function<void()>> runningCommands;
+    uint32_t droppedCommands = 0;
+};
+static LvglLockData_t _lvgl_lock_data;
+
+// Sites are string literals, the same one from another file may have another address
+static LvglLockSite_t* find_site(const char* site)
+{
+    auto& data = _lvgl_lock_data;
+    for (size_t i = 0; i < data.siteNum; i++) {
+        if (data.sites[i].site == site || strcmp(data.sites[i].site, site) == 0) {
+            return &data.sites[i];
+        }
+    }
+    if (data.siteNum == _max_sites) {
+        return &data.sites[_max_sites - 1];
+    }
+    auto entry  = &data.sites[data.siteNum++];
+    entry->site = site;
+    return entry;
+}
+
+// Called with the LVGL lock just taken, waitUs < 0 when the wait was not seen
+void lvgl_lock_on_acquire(const char* site, int64_t waitUs)
+{
+    auto& data = _lvgl_lock_data;
+    std::lock_guard<std::mutex> lock(data.statsMutex);
+
+    auto entry = find_site(site != nullptr ? site : "?");
+    entry->count++;
+    if (waitUs >= 0) {
+        entry->waitTotalUs += waitUs;
+        entry->waitMaxUs = std::max<uint32_t>(entry->waitMaxUs, waitUs);
+        entry->waitCount++;
+    }
+
+    // A nested lock is part of the outer one's hold
+    if (data.depth++ == 0) {
+        data.holder      = entry;
+        data.holderTask  = xTaskGetCurrentTaskHandle();
+        data.holdStartUs = esp_timer_get_time();
+    }
+}
+
+// Called with the LVGL lock still held
+void lvgl_lock_on_release()
+{
+    auto& data = _lvgl_lock_data;
+    std::lock_guard<std::mutex> lock(data.statsMutex);
+
+    if (data.depth == 0 || --data.depth > 0) {
+        return;
+    }
+    uint32_t hold_us = esp_timer_get_time() - data.holdStartUs;
+    auto entry       = data.holder;
+    entry->holdTotalUs += hold_us;
+    entry->holdMaxUs = std::max(entry->holdMaxUs, hold_us);
+    entry->holdCount++;
+    data.holder     = nullptr;
+    data.holderTask = nullptr;
+}
+
+// LVGL task, with the LVGL lock held before lv_timer_handler()
+void lvgl_ui_commands_run()
+{
+    auto& data = _lvgl_lock_data;
+    {
+        std::lock_guard<std::mutex> lock(data.queueMutex);
+        if (data.commands.empty()) {
+            return;
+        }
+        data.runningCommands.swap(data.commands);
+    }
+
+    // Outside the queue mutex, a command may post again
+    TRACE_SCOPE("ui commands");
+    for (auto& command : data.runningCommands) {
+        command();
+    }
+    data.runningCommands.clear();
+}
+
+bool HalEsp32::postUiCommand(std::function<void()> command)
+{
+    auto& data       = _lvgl_lock_data;
+    uint32_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(data.queueMutex);
+        if (data.commands.size() < _ui_command_queue_size) {
+            data.commands.push_back(std::move(command));
+        } else {
+            dropped = ++data.droppedCommands;
+        }
+    }
+    if (dropped > 0) {
+        // Once, then each hundredth, a stalled LVGL task drops every post
+        if (dropped % 100 == 1) {
+            mclog::tagWarn(_tag, "ui command queue full, {} dropped", dropped);
+        }
+        return false;
+    }
+    // The LVGL task may be sleeping until its next timer
+    lvgl_port_task_wake(LVGL_PORT_EVENT_USER, nullptr);
+    return true;
+}
+
+hal::HalBase::LvglLockStats_t HalEsp32::getLvglLockStats()
+{
+    auto& data = _lvgl_lock_data;
+    LvglLockStats_t stats;
+    stats.supported = true;
+    {
+        std::lock_guard<std::mutex> lock(data.queueMutex);
+        stats.droppedCommands = data.droppedCommands;
+    }
+
+    std::lock_guard<std::mutex> lock(data.statsMutex);
+    if (data.holder != nullptr) {
+        stats.holder     = data.holder->site;
+        stats.holderTask = pcTaskGetName(data.holderTask);
+        stats.heldUs     = esp_timer_get_time() - data.holdStartUs;
+    }
+    std::vector<const LvglLockSite_t*> sites;
+    for (size_t i = 0; i < data.siteNum; i++) {
+        sites.push_back(&data.sites[i]);
+    }
+    // Longest total hold first, the sites that keep everyone else waiting
+    std::sort(sites.begin(), sites.end(),
+              [](const LvglLockSite_t* a, const LvglLockSite_t* b) { return a->holdTotalUs > b->holdTotalUs; });
+    const LvglLockSite_t* other = data.siteNum == _max_sites ? &data.sites[_max_sites - 1] : nullptr;
+    for (auto entry : sites) {
+        LvglLockSiteStats_t site;
+        site.site      = entry == other ? "(other)" : entry->site;
+        site.count     = entry->count;
+        site.avgWaitUs = entry->waitCount ? entry->waitTotalUs / entry->waitCount : 0;
+        site.maxWaitUs = entry->waitMaxUs;
+        site.avgHoldUs = entry->holdCount ? entry->holdTotalUs / entry->holdCount : 0;
+        site.maxHoldUs = entry->holdMaxUs;
+        stats.sites.push_back(site);
+    }
+    return stats;
+}
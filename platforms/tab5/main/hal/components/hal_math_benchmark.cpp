@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <esp_timer.h>
+#include "fmath.h"
+
+static const std::string _tag = "math-bench";
+
+// 16 KB per float buffer, within the limit malloc keeps in internal SRAM, so the timing is the kernel and not PSRAM
+static constexpr size_t _element_count = 4096;
+static constexpr int _rounds           = 8;
+
+template <typename F>
+static float time_per_element(F&& run)
+{
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < _rounds; i++) {
+        run();
+    }
+    return (esp_timer_get_time() - start) * 1000.0f / (_rounds * _element_count);
+}
+
+// Keeps the reference loops from being optimized away
+static volatile float _float_sink;
+static volatile int16_t _int16_sink;
+
+std::vector<hal::HalBase::MathBenchmarkResult_t> HalEsp32::runMathBenchmark()
+{
+    std::vector<MathBenchmarkResult_t> results;
+    std::vector<float> a(_element_count);
+    std::vector<float> b(_element_count);
+    std::vector<float> out(_element_count);
+    std::vector<int16_t> s16(_element_count);
+
+    srand(1);
+    auto uniform = [](float lo, float hi) {
+        return lo + (hi - lo) * (rand() / (float)RAND_MAX);
+    };
+
+    {
+        MathBenchmarkResult_t r;
+        r.name = "expf";
+        std::generate(a.begin(), a.end(), [&]() { return uniform(-10.0f, 10.0f); });
+        r.scalarNsPerElement = time_per_element([&]() {
+            for (size_t i = 0; i < _element_count; i++) {
+                out[i] = fast_expf(a[i]);
+            }
+        });
+        r.batchNsPerElement = time_per_element([&]() { fast_expf_batch(a.data(), out.data(), _element_count); });
+        for (size_t i = 0; i < _element_count; i++) {
+            float ref  = expf(a[i]);
+            r.maxError = std::max(r.maxError, fabsf(out[i] - ref) / ref);
+        }
+        results.push_back(r);
+    }
+
+    {
+        MathBenchmarkResult_t r;
+        r.name = "log2";
+        std::generate(a.begin(), a.end(), [&]() { return exp2f(uniform(-10.0f, 10.0f)); });
+        r.scalarNsPerElement = time_per_element([&]() {
+            for (size_t i = 0; i < _element_count; i++) {
+                out[i] = fast_log2(a[i]);
+            }
+        });
+        r.batchNsPerElement = time_per_element([&]() { fast_log2_batch(a.data(), out.data(), _element_count); });
+        for (size_t i = 0; i < _element_count; i++) {
+            r.maxError = std::max(r.maxError, fabsf(out[i] - log2f(a[i])));
+        }
+        results.push_back(r);
+    }
+
+    {
+        MathBenchmarkResult_t r;
+        r.name = "atan2";
+        std::generate(a.begin(), a.end(), [&]() { return uniform(-1.0f, 1.0f); });
+        std::generate(b.begin(), b.end(), [&]() { return uniform(-1.0f, 1.0f); });
+        r.scalarNsPerElement = time_per_element([&]() {
+            for (size_t i = 0; i < _element_count; i++) {
+                out[i] = fast_atan2f(a[i], b[i]);
+            }
+        });
+        r.batchNsPerElement =
+            time_per_element([&]() { fast_atan2f_batch(a.data(), b.data(), out.data(), _element_count); });
+        // fast_atan2f() returns 0 ~ 2pi, the difference is taken around the circle
+        for (size_t i = 0; i < _element_count; i++) {
+            float diff = fmodf(fabsf(out[i] - atan2f(a[i], b[i])), 2.0f * (float)M_PI);
+            r.maxError = std::max(r.maxError, std::min(diff, 2.0f * (float)M_PI - diff));
+        }
+        results.push_back(r);
+    }
+
+    {
+        MathBenchmarkResult_t r;
+        r.name = "min_max_f32";
+        float ref_min        = 0.0f;
+        float ref_max        = 0.0f;
+        r.scalarNsPerElement = time_per_element([&]() {
+            ref_min = a[0];
+            ref_max = a[0];
+            for (size_t i = 1; i < _element_count; i++) {
+                ref_min = a[i] < ref_min ? a[i] : ref_min;
+                ref_max = a[i] > ref_max ? a[i] : ref_max;
+            }
+            _float_sink = ref_min + ref_max;
+        });
+        float min = 0.0f;
+        float max = 0.0f;
+        r.batchNsPerElement = time_per_element([&]() { fast_get_min_max(a.data(), _element_count, &min, &max); });
+        r.maxError          = std::max(fabsf(min - ref_min), fabsf(max - ref_max));
+        results.push_back(r);
+    }
+
+    {
+        MathBenchmarkResult_t r;
+        r.name = "min_max_s16";
+        std::generate(s16.begin(), s16.end(), []() { return (int16_t)(rand() - RAND_MAX / 2); });
+        int16_t ref_min      = 0;
+        int16_t ref_max      = 0;
+        r.scalarNsPerElement = time_per_element([&]() {
+            ref_min = s16[0];
+            ref_max = s16[0];
+            for (size_t i = 1; i < _element_count; i++) {
+                ref_min = s16[i] < ref_min ? s16[i] : ref_min;
+                ref_max = s16[i] > ref_max ? s16[i] : ref_max;
+            }
+            _int16_sink = ref_min ^ ref_max;
+        });
+        int16_t min = 0;
+        int16_t max = 0;
+        r.batchNsPerElement =
+            time_per_element([&]() { fast_get_min_max_s16(s16.data(), _element_count, &min, &max); });
+        r.maxError = std::max(abs(min - ref_min), abs(max - ref_max));
+        results.push_back(r);
+    }
+
+    for (const auto& r : results) {
+        mclog::tagInfo(_tag, "{}: scalar {:.2f} ns, batch {:.2f} ns, max error {:.3g}", r.name, r.scalarNsPerElement,
+                       r.batchNsPerElement, r.maxError);
+    }
+    return results;
+}
@@ -0,0 +1,538 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+#include <bsp/m5stack_tab5.h>
+#include <driver/i2c_master.h>
+#include <driver/ppa.h>
+#include <driver/jpeg_encode.h>
+#include <driver/jpeg_decode.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <esp_lvgl_port.h>
+
+static const std::string _tag = "hal-bench";
+
+// Same range as the I2C scan
+static constexpr uint8_t _i2c_first_address = 0x10;
+static constexpr uint8_t _i2c_last_address  = 0x77;
+static constexpr int _i2c_reads             = 64;
+static constexpr int _i2c_timeout_ms        = 10;
+
+// The SRAM buffers stay in internal memory, the PSRAM ones are well past the 256 KB L2 cache
+static constexpr size_t _sram_size  = 64 * 1024;
+static constexpr size_t _psram_size = 4 * 1024 * 1024;
+static constexpr size_t _copy_total = 32 * 1024 * 1024;
+
+// Full screen RGB565 frames for the PPA and the JPEG codec
+static constexpr uint32_t _frame_w    = 1280;
+static constexpr uint32_t _frame_h    = 720;
+static constexpr size_t _frame_size   = _frame_w * _frame_h * 2;
+static constexpr int _ppa_rounds      = 10;
+static constexpr int _jpeg_rounds     = 10;
+static constexpr size_t _buffer_align = 128;
+// Quarter frame block for the rotations
+static constexpr uint32_t _rotate_w = _frame_w / 2;
+static constexpr uint32_t _rotate_h = _frame_h / 2;
+
+// A 1 kHz burst played through the mixer, the AEC slot of the ES7210 hears the DAC output
+static constexpr int _i2s_trials          = 5;
+static constexpr uint16_t _i2s_block      = 48;
+static constexpr size_t _i2s_burst_frames = 480;
+static constexpr int _i2s_timeout_ms      = 500;
+static constexpr int _i2s_min_level       = 512;
+
+struct HalBenchmarkData_t {
+    std::mutex mutex;
+    hal::HalBase::HalBenchmarkResult_t result;
+};
+static HalBenchmarkData_t _hal_bench_data;
+
+static void push_record(const char* group, const std::string& name, const char* unit, float value, float maxValue = 0)
+{
+    hal::HalBase::HalBenchmarkRecord_t record;
+    record.group    = group;
+    record.name     = name;
+    record.unit     = unit;
+    record.value    = value;
+    record.maxValue = maxValue;
+    mclog::tagInfo(_tag, "{} {}: {:.2f} {} (max {:.2f})", group, name, value, unit, maxValue);
+
+    std::lock_guard<std::mutex> lock(_hal_bench_data.mutex);
+    _hal_bench_data.result.records.push_back(record);
+}
+
+/* ----------------------------------- I2C ---------------------------------- */
+// One register byte written and one read back, only the bus time of each turn counts
+static void run_i2c_benchmark()
+{
+    i2c_master_bus_handle_t bus = bsp_i2c_get_handle();
+    if (bus == nullptr) {
+        return;
+    }
+
+    for (uint8_t address = _i2c_first_address; address <= _i2c_last_address; address++) {
+        esp_err_t ret = ESP_FAIL;
+        HalEsp32::i2cScheduler().run(I2cBusScheduler::PRIORITY_DIAGNOSTIC, address, [&]() {
+            ret = i2c_master_probe(bus, address, _i2c_timeout_ms);
+            return true;
+        });
+        if (ret != ESP_OK) {
+            continue;
+        }
+
+        i2c_device_config_t dev_cfg = {};
+        dev_cfg.dev_addr_length     = I2C_ADDR_BIT_LEN_7;
+        dev_cfg.device_address      = address;
+        dev_cfg.scl_speed_hz        = 400000;
+        i2c_master_dev_handle_t dev = nullptr;
+        if (i2c_master_bus_add_device(bus, &dev_cfg, &dev) != ESP_OK) {
+            continue;
+        }
+
+        int64_t total_us = 0;
+        int64_t max_us   = 0;
+        int reads        = 0;
+        for (int i = 0; i < _i2c_reads; i++) {
+            uint8_t reg    = 0x00;
+            uint8_t value  = 0;
+            int64_t bus_us = 0;
+            bool is_ok     = HalEsp32::i2cScheduler().run(I2cBusScheduler::PRIORITY_DIAGNOSTIC, address, [&]() {
+                int64_t start = esp_timer_get_time();
+                bool ok       = i2c_master_transmit_receive(dev, &reg, 1, &value, 1, _i2c_timeout_ms) == ESP_OK;
+                bus_us        = esp_timer_get_time() - start;
+                return ok;
+            });
+            if (is_ok) {
+                total_us += bus_us;
+                max_us = std::max(max_us, bus_us);
+                reads++;
+            }
+        }
+        i2c_master_bus_rm_device(dev);
+
+        if (reads > 0) {
+            push_record("i2c", fmt::format("0x{:02x}", address), "us", (float)total_us / reads, max_us);
+        }
+    }
+}
+
+/* --------------------------------- memcpy --------------------------------- */
+static void time_copy(const char* name, uint8_t* dst, size_t dstSize, const uint8_t* src, size_t srcSize,
+                      size_t chunk)
+{
+    // Walk through both buffers so the PSRAM side misses the cache like a frame copy does
+    size_t dst_offset = 0;
+    size_t src_offset = 0;
+    int64_t start     = esp_timer_get_time();
+    for (size_t copied = 0; copied < _copy_total; copied += chunk) {
+        memcpy(dst + dst_offset, src + src_offset, chunk);
+        dst_offset = (dst_offset + chunk) % dstSize;
+        src_offset = (src_offset + chunk) % srcSize;
+    }
+    int64_t us = esp_timer_get_time() - start;
+    // Bytes per microsecond is MB/s
+    push_record("memcpy", name, "MB/s", us > 0 ? (float)_copy_total / us : 0.0f);
+}
+
+static void run_memcpy_benchmark()
+{
+    auto sram_a  = (uint8_t*)heap_caps_malloc(_sram_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    auto sram_b  = (uint8_t*)heap_caps_malloc(_sram_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    auto psram_a = (uint8_t*)heap_caps_malloc(_psram_size, MALLOC_CAP_SPIRAM);
+    auto psram_b = (uint8_t*)heap_caps_malloc(_psram_size, MALLOC_CAP_SPIRAM);
+    if (sram_a && sram_b && psram_a && psram_b) {
+        memset(sram_a, 0x5a, _sram_size);
+        memset(psram_a, 0xa5, _psram_size);
+        time_copy("sram_to_sram", sram_b, _sram_size, sram_a, _sram_size, _sram_size);
+        time_copy("sram_to_psram", psram_b, _psram_size, sram_a, _sram_size, _sram_size);
+        time_copy("psram_to_sram", sram_b, _sram_size, psram_a, _psram_size, _sram_size);
+        time_copy("psram_to_psram", psram_b, _psram_size, psram_a, _psram_size, _sram_size);
+    } else {
+        mclog::tagError(_tag, "no memory for the memcpy buffers");
+    }
+    heap_caps_free(sram_a);
+    heap_caps_free(sram_b);
+    heap_caps_free(psram_a);
+    heap_caps_free(psram_b);
+}
+
+/* ----------------------------------- PPA ---------------------------------- */
+static void fill_test_frame(uint16_t* frame)
+{
+    for (uint32_t y = 0; y < _frame_h; y++) {
+        for (uint32_t x = 0; x < _frame_w; x++) {
+            // Gradients with some texture, so the JPEG codec has real work to do
+            uint32_t noise          = (x * 2654435761u) ^ (y * 40503u);
+            frame[y * _frame_w + x] = ((x >> 5) << 11) | ((y >> 4) << 5) | ((noise >> 27) & 0x1f);
+        }
+    }
+}
+
+template <typename F>
+static void time_ppa(const char* name, uint32_t pixels, F&& run)
+{
+    int64_t start = esp_timer_get_time();
+    int done      = 0;
+    for (int i = 0; i < _ppa_rounds; i++) {
+        done += run() ? 1 : 0;
+    }
+    int64_t us = esp_timer_get_time() - start;
+    if (done != _ppa_rounds) {
+        mclog::tagError(_tag, "ppa {} failed", name);
+        return;
+    }
+    // Pixels per microsecond is Mpx/s
+    push_record("ppa", name, "Mpx/s", us > 0 ? (float)pixels * _ppa_rounds / us : 0.0f);
+}
+
+static void run_ppa_benchmark(uint16_t* src, uint16_t* dst)
+{
+    ppa_client_handle_t srm          = nullptr;
+    ppa_client_handle_t blend        = nullptr;
+    ppa_client_handle_t fill         = nullptr;
+    ppa_client_config_t srm_config   = {.oper_type = PPA_OPERATION_SRM};
+    ppa_client_config_t blend_config = {.oper_type = PPA_OPERATION_BLEND};
+    ppa_client_config_t fill_config  = {.oper_type = PPA_OPERATION_FILL};
+    if (ppa_register_client(&srm_config, &srm) != ESP_OK || ppa_register_client(&blend_config, &blend) != ESP_OK ||
+        ppa_register_client(&fill_config, &fill) != ESP_OK) {
+        mclog::tagError(_tag, "failed to register ppa clients");
+    } else {
+        // Blocking transfers from PSRAM to PSRAM, like the camera preview and the draw unit
+        for (float scale : {1.0f, 0.5f}) {
+            ppa_srm_oper_config_t srm_oper = {};
+            srm_oper.in.buffer             = src;
+            srm_oper.in.pic_w              = _frame_w;
+            srm_oper.in.pic_h              = _frame_h;
+            srm_oper.in.block_w            = _frame_w;
+            srm_oper.in.block_h            = _frame_h;
+            srm_oper.in.srm_cm             = PPA_SRM_COLOR_MODE_RGB565;
+            srm_oper.out.buffer            = dst;
+            srm_oper.out.buffer_size       = _frame_size;
+            srm_oper.out.pic_w             = _frame_w * scale;
+            srm_oper.out.pic_h             = _frame_h * scale;
+            srm_oper.out.srm_cm            = PPA_SRM_COLOR_MODE_RGB565;
+            srm_oper.rotation_angle        = PPA_SRM_ROTATION_ANGLE_0;
+            srm_oper.scale_x               = scale;
+            srm_oper.scale_y               = scale;
+            srm_oper.mirror_x              = true;
+            srm_oper.mode                  = PPA_TRANS_MODE_BLOCKING;
+            time_ppa(scale == 1.0f ? "srm_mirror_1x" : "srm_scale_0.5x", _frame_w * _frame_h,
+                     [&]() { return ppa_do_scale_rotate_mirror(srm, &srm_oper) == ESP_OK; });
+        }
+
+        // Two halves of the source frame blended into the output at half alpha
+        uint32_t half_h                    = _frame_h / 2;
+        ppa_blend_oper_config_t blend_oper = {};
+        blend_oper.in_bg.buffer            = src;
+        blend_oper.in_bg.pic_w             = _frame_w;
+        blend_oper.in_bg.pic_h             = _frame_h;
+        blend_oper.in_bg.block_w           = _frame_w;
+        blend_oper.in_bg.block_h           = half_h;
+        blend_oper.in_bg.blend_cm          = PPA_BLEND_COLOR_MODE_RGB565;
+        blend_oper.in_fg                   = blend_oper.in_bg;
+        blend_oper.in_fg.block_offset_y    = half_h;
+        blend_oper.out.buffer              = dst;
+        blend_oper.out.buffer_size         = _frame_size;
+        blend_oper.out.pic_w               = _frame_w;
+        blend_oper.out.pic_h               = _frame_h;
+        blend_oper.out.blend_cm            = PPA_BLEND_COLOR_MODE_RGB565;
+        blend_oper.bg_alpha_update_mode    = PPA_ALPHA_FIX_VALUE;
+        blend_oper.bg_alpha_fix_val        = 0xff;
+        blend_oper.fg_alpha_update_mode    = PPA_ALPHA_FIX_VALUE;
+        blend_oper.fg_alpha_fix_val        = 0x80;
+        blend_oper.mode                    = PPA_TRANS_MODE_BLOCKING;
+        time_ppa("blend", _frame_w * half_h, [&]() { return ppa_do_blend(blend, &blend_oper) == ESP_OK; });
+
+        // A quarter frame rotated into the panel orientation, against the CPU fallback of the display port below
+        ppa_srm_oper_config_t rotate_oper = {};
+        rotate_oper.in.buffer             = src;
+        rotate_oper.in.pic_w              = _frame_w;
+        rotate_oper.in.pic_h              = _frame_h;
+        rotate_oper.in.block_w            = _rotate_w;
+        rotate_oper.in.block_h            = _rotate_h;
+        rotate_oper.in.srm_cm             = PPA_SRM_COLOR_MODE_RGB565;
+        rotate_oper.out.buffer            = dst;
+        rotate_oper.out.buffer_size       = _frame_size;
+        rotate_oper.out.pic_w             = _frame_h;
+        rotate_oper.out.pic_h             = _frame_w;
+        rotate_oper.out.srm_cm            = PPA_SRM_COLOR_MODE_RGB565;
+        rotate_oper.rotation_angle        = PPA_SRM_ROTATION_ANGLE_90;
+        rotate_oper.scale_x               = 1.0f;
+        rotate_oper.scale_y               = 1.0f;
+        rotate_oper.mode                  = PPA_TRANS_MODE_BLOCKING;
+        time_ppa("srm_rotate_90", _rotate_w * _rotate_h,
+                 [&]() { return ppa_do_scale_rotate_mirror(srm, &rotate_oper) == ESP_OK; });
+
+        ppa_fill_oper_config_t fill_oper = {};
+        fill_oper.out.buffer             = dst;
+        fill_oper.out.buffer_size        = _frame_size;
+        fill_oper.out.pic_w              = _frame_w;
+        fill_oper.out.pic_h              = _frame_h;
+        fill_oper.out.fill_cm            = PPA_FILL_COLOR_MODE_RGB565;
+        fill_oper.fill_block_w           = _frame_w;
+        fill_oper.fill_block_h           = _frame_h;
+        fill_oper.fill_argb_color.val    = 0xff336699;
+        fill_oper.mode                   = PPA_TRANS_MODE_BLOCKING;
+        time_ppa("fill", _frame_w * _frame_h, [&]() { return ppa_do_fill(fill, &fill_oper) == ESP_OK; });
+    }
+    if (srm) {
+        ppa_unregister_client(srm);
+    }
+    if (blend) {
+        ppa_unregister_client(blend);
+    }
+    if (fill) {
+        ppa_unregister_client(fill);
+    }
+}
+
+/* --------------------------------- Rotation -------------------------------- */
+// The same block as srm_rotate_90, PSRAM to PSRAM. The column-wise loop is the scalar rotation the tiles replace
+static void run_rotate_benchmark(const uint16_t* src, uint16_t* dst)
+{
+    auto time_rotate = [](const char* name, auto&& run) {
+        int64_t start = esp_timer_get_time();
+        for (int i = 0; i < _ppa_rounds; i++) {
+            run();
+        }
+        int64_t us = esp_timer_get_time() - start;
+        push_record("rotate", name, "Mpx/s", us > 0 ? (float)_rotate_w * _rotate_h * _ppa_rounds / us : 0.0f);
+    };
+
+    time_rotate("cpu_tiled_90", [&]() {
+        lvgl_port_rotate_rgb565(src, _frame_w, dst, _frame_h, _rotate_w, _rotate_h, LV_DISPLAY_ROTATION_90);
+    });
+    time_rotate("cpu_tiled_180", [&]() {
+        lvgl_port_rotate_rgb565(src, _frame_w, dst, _frame_w, _rotate_w, _rotate_h, LV_DISPLAY_ROTATION_180);
+    });
+    time_rotate("cpu_column_90", [&]() {
+        for (uint32_t y = 0; y < _rotate_h; y++) {
+            for (uint32_t x = 0; x < _rotate_w; x++) {
+                dst[(_rotate_w - 1 - x) * _frame_h + y] = src[y * _frame_w + x];
+            }
+        }
+    });
+}
+
+/* ---------------------------------- JPEG ---------------------------------- */
+static void run_jpeg_benchmark(const uint16_t* frame)
+{
+    jpeg_encoder_handle_t encoder    = nullptr;
+    jpeg_decoder_handle_t decoder    = nullptr;
+    jpeg_encode_engine_cfg_t enc_eng = {.intr_priority = 0, .timeout_ms = 200};
+    jpeg_decode_engine_cfg_t dec_eng = {.intr_priority = 0, .timeout_ms = 200};
+
+    // The JPEG of the test frame is far below a byte per pixel
+    size_t encode_in_size                  = 0;
+    size_t encode_out_size                 = 0;
+    size_t decode_in_size                  = 0;
+    size_t decode_out_size                 = 0;
+    jpeg_encode_memory_alloc_cfg_t enc_in  = {.buffer_direction = JPEG_ENC_ALLOC_INPUT_BUFFER};
+    jpeg_encode_memory_alloc_cfg_t enc_out = {.buffer_direction = JPEG_ENC_ALLOC_OUTPUT_BUFFER};
+    jpeg_decode_memory_alloc_cfg_t dec_in  = {.buffer_direction = JPEG_DEC_ALLOC_INPUT_BUFFER};
+    jpeg_decode_memory_alloc_cfg_t dec_out = {.buffer_direction = JPEG_DEC_ALLOC_OUTPUT_BUFFER};
+    auto encode_in  = (uint8_t*)jpeg_alloc_encoder_mem(_frame_size, &enc_in, &encode_in_size);
+    auto encode_out = (uint8_t*)jpeg_alloc_encoder_mem(_frame_size / 2, &enc_out, &encode_out_size);
+    auto decode_in  = (uint8_t*)jpeg_alloc_decoder_mem(_frame_size / 2, &dec_in, &decode_in_size);
+    auto decode_out = (uint8_t*)jpeg_alloc_decoder_mem(_frame_size, &dec_out, &decode_out_size);
+
+    auto time_rounds = [](const char* name, auto&& run) {
+        int64_t total_us = 0;
+        int64_t max_us   = 0;
+        for (int i = 0; i < _jpeg_rounds; i++) {
+            int64_t start = esp_timer_get_time();
+            if (!run()) {
+                mclog::tagError(_tag, "jpeg {} failed", name);
+                return false;
+            }
+            int64_t us = esp_timer_get_time() - start;
+            total_us += us;
+            max_us = std::max(max_us, us);
+        }
+        push_record("jpeg", name, "ms", total_us / 1000.0f / _jpeg_rounds, max_us / 1000.0f);
+        return true;
+    };
+
+    if (encode_in == nullptr || encode_out == nullptr || decode_in == nullptr || decode_out == nullptr) {
+        mclog::tagError(_tag, "no memory for the jpeg buffers");
+    } else if (jpeg_new_encoder_engine(&enc_eng, &encoder) != ESP_OK ||
+               jpeg_new_decoder_engine(&dec_eng, &decoder) != ESP_OK) {
+        mclog::tagError(_tag, "failed to create the jpeg engines");
+    } else {
+        memcpy(encode_in, frame, _frame_size);
+        jpeg_encode_cfg_t enc_cfg = {
+            .height        = _frame_h,
+            .width         = _frame_w,
+            .src_type      = JPEG_ENCODE_IN_FORMAT_RGB565,
+            .sub_sample    = JPEG_DOWN_SAMPLING_YUV420,
+            .image_quality = 80,
+        };
+        jpeg_decode_cfg_t dec_cfg = {
+            .output_format = JPEG_DECODE_OUT_FORMAT_RGB565,
+            .rgb_order     = JPEG_DEC_RGB_ELEMENT_ORDER_BGR,
+            .conv_std      = JPEG_YUV_RGB_CONV_STD_BT601,
+        };
+
+        uint32_t jpeg_size = 0;
+        bool is_encoded    = time_rounds("encode_720p", [&]() {
+            return jpeg_encoder_process(encoder, &enc_cfg, encode_in, _frame_size, encode_out, encode_out_size,
+                                        &jpeg_size) == ESP_OK;
+        });
+        if (is_encoded && jpeg_size <= decode_in_size) {
+            memcpy(decode_in, encode_out, jpeg_size);
+            time_rounds("decode_720p", [&]() {
+                uint32_t out_size = 0;
+                return jpeg_decoder_process(decoder, &dec_cfg, decode_in, jpeg_size, decode_out, decode_out_size,
+                                            &out_size) == ESP_OK;
+            });
+        }
+    }
+
+    if (encoder) {
+        jpeg_del_encoder_engine(encoder);
+    }
+    if (decoder) {
+        jpeg_del_decoder_engine(decoder);
+    }
+    heap_caps_free(encode_in);
+    heap_caps_free(encode_out);
+    heap_caps_free(decode_in);
+    heap_caps_free(decode_out);
+}
+
+/* ----------------------------------- I2S ---------------------------------- */
+// From handing a burst to the mixer until the capture task reads it back, through the DMA out, the DAC, the ES7210
+// AEC slot and the DMA in
+static void run_i2s_benchmark()
+{
+    static std::vector<int16_t> burst;
+    if (burst.empty()) {
+        burst.resize(_i2s_burst_frames * 2);
+        for (size_t i = 0; i < _i2s_burst_frames; i++) {
+            int16_t sample   = 12000.0f * sinf(2.0f * (float)M_PI * 1000.0f * i / 48000.0f);
+            burst[i * 2]     = sample;
+            burst[i * 2 + 1] = sample;
+        }
+    }
+
+    static std::atomic<int64_t> played_us{0};
+    static std::atomic<int64_t> heard_us{0};
+    static std::atomic<int> noise_peak{0};
+    played_us  = 0;
+    heard_us   = 0;
+    noise_peak = 0;
+
+    hal::HalBase::AudioCaptureConfig_t config;
+    config.channelMask = hal::HalBase::AUDIO_CAPTURE_AEC;
+    config.blockFrames = _i2s_block;
+    config.ringFrames  = _i2s_block * 4;
+    bool is_started    = GetHAL()->startAudioCapture(config, [](const int16_t* data, size_t frames, uint8_t channels) {
+        int peak = 0;
+        for (size_t i = 0; i < frames * channels; i++) {
+            peak = std::max(peak, std::abs((int)data[i]));
+        }
+        if (played_us == 0) {
+            noise_peak = std::max(noise_peak.load(), peak);
+        } else if (heard_us == 0 && peak >= std::max(_i2s_min_level, noise_peak * 4)) {
+            heard_us = esp_timer_get_time();
+        }
+    });
+    if (!is_started) {
+        mclog::tagWarn(_tag, "audio capture not available, skip i2s");
+        return;
+    }
+
+    // The first blocks give the noise floor of the slot
+    vTaskDelay(pdMS_TO_TICKS(200));
+    int64_t total_us = 0;
+    int64_t max_us   = 0;
+    int trials       = 0;
+    for (int i = 0; i < _i2s_trials; i++) {
+        heard_us  = 0;
+        played_us = esp_timer_get_time();
+        GetHAL()->audioPlayBuffer(burst.data(), burst.size());
+        for (int waited = 0; heard_us == 0 && waited < _i2s_timeout_ms; waited++) {
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+        if (heard_us != 0) {
+            int64_t us = heard_us - played_us;
+            total_us += us;
+            max_us = std::max(max_us, us);
+            trials++;
+        }
+        // Let the burst and its tail pass before the next one
+        vTaskDelay(pdMS_TO_TICKS(100));
+    }
+    GetHAL()->stopAudioCapture();
+
+    if (trials > 0) {
+        push_record("i2s", "play_to_capture", "ms", total_us / 1000.0f / trials, max_us / 1000.0f);
+    } else {
+        mclog::tagWarn(_tag, "i2s burst never heard, speaker volume at 0?");
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+static void hal_benchmark_job()
+{
+    GetHAL()->claimPerfLevel("hal_bench", hal::HalBase::PERF_LEVEL_MAX);
+
+    run_i2c_benchmark();
+    run_memcpy_benchmark();
+
+    auto src = (uint16_t*)heap_caps_aligned_calloc(_buffer_align, 1, _frame_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA);
+    auto dst = (uint16_t*)heap_caps_aligned_calloc(_buffer_align, 1, _frame_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA);
+    if (src && dst) {
+        fill_test_frame(src);
+        run_ppa_benchmark(src, dst);
+        run_rotate_benchmark(src, dst);
+        run_jpeg_benchmark(src);
+    } else {
+        mclog::tagError(_tag, "no memory for the test frames");
+    }
+    heap_caps_free(src);
+    heap_caps_free(dst);
+
+    run_i2s_benchmark();
+
+    GetHAL()->releasePerfLevel("hal_bench");
+
+    std::lock_guard<std::mutex> lock(_hal_bench_data.mutex);
+    _hal_bench_data.result.state = hal::HalBase::HAL_BENCHMARK_DONE;
+    mclog::tagInfo(_tag, "done, {} records", _hal_bench_data.result.records.size());
+}
+
+bool HalEsp32::startHalBenchmark()
+{
+    std::lock_guard<std::mutex> lock(_hal_bench_data.mutex);
+    if (_hal_bench_data.result.state == HAL_BENCHMARK_RUNNING) {
+        return false;
+    }
+    _hal_bench_data.result       = HalBenchmarkResult_t();
+    _hal_bench_data.result.state = HAL_BENCHMARK_RUNNING;
+    if (!submitJob(hal_benchmark_job)) {
+        mclog::tagError(_tag, "submit job failed");
+        _hal_bench_data.result.state = HAL_BENCHMARK_IDLE;
+        return false;
+    }
+    return true;
+}
+
+hal::HalBase::HalBenchmarkResult_t HalEsp32::getHalBenchmarkResult()
+{
+    std::lock_guard<std::mutex> lock(_hal_bench_data.mutex);
+    return _hal_bench_data.result;
+}
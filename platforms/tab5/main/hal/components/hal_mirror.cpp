@@ -0,0 +1,567 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include "../utils/pixel_convert/pixel_convert.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <bsp/m5stack_tab5.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_heap_caps.h>
+#include <esp_http_server.h>
+#include <driver/jpeg_encode.h>
+
+static const std::string _tag = "mirror";
+
+// The YUV420 encoder works on 16x16 blocks
+static constexpr int32_t _block_size = 16;
+static constexpr int _region_max     = 8;
+// x, y, w, h, screen width, screen height as little endian uint16, then the JPEG
+static constexpr size_t _header_size = 12;
+
+// Shared by every client the region is sent to
+using Packet_t = std::shared_ptr<std::vector<uint8_t>>;
+
+struct MirrorClient_t {
+    int fd           = -1;
+    uint8_t inFlight = 0;
+};
+
+struct MirrorSend_t {
+    Packet_t packet;
+};
+
+struct ScreenMirrorData_t {
+    std::mutex mutex;
+    TaskHandle_t task                = nullptr;
+    SemaphoreHandle_t exitSem        = nullptr;
+    std::atomic<bool> isRunning      = false;
+    std::atomic<bool> hasClients     = false;
+    std::atomic<bool> needsFullFrame = false;
+    hal::HalBase::ScreenMirrorConfig_t config;
+    lv_display_t* display         = nullptr;
+    int32_t width                 = 0;
+    int32_t height                = 0;
+    jpeg_encoder_handle_t encoder = nullptr;
+    uint8_t* encodeIn             = nullptr;
+    uint8_t* encodeOut            = nullptr;
+    size_t encodeOutSize          = 0;
+    // Packs a region of the shadow for the encoder, on the PPA for the large ones
+    PixelConverter converter;
+    // Screen copy and the regions waiting to be sent, written by the flush tap
+    std::mutex frameMutex;
+    uint8_t* shadow = nullptr;
+    lv_area_t regions[_region_max];
+    int regionCount      = 0;
+    uint32_t mergedAreas = 0;
+    // The clients and stats
+    std::mutex clientMutex;
+    httpd_handle_t server = nullptr;
+    std::vector<MirrorClient_t> clients;
+    hal::HalBase::ScreenMirrorStats_t stats;
+};
+static ScreenMirrorData_t _mirror_data;
+
+/* -------------------------------------------------------------------------- */
+/*                                 Flush tap                                  */
+/* -------------------------------------------------------------------------- */
+// Lock _mirror_data.frameMutex before calling, same merge rule as the LVGL port's dirty rectangles
+static void add_region(const lv_area_t& area)
+{
+    auto& data          = _mirror_data;
+    int best            = -1;
+    int64_t best_growth = INT64_MAX;
+    lv_area_t best_union;
+
+    for (int i = 0; i < data.regionCount; i++) {
+        lv_area_t u;
+        u.x1           = std::min(data.regions[i].x1, area.x1);
+        u.y1           = std::min(data.regions[i].y1, area.y1);
+        u.x2           = std::max(data.regions[i].x2, area.x2);
+        u.y2           = std::max(data.regions[i].y2, area.y2);
+        int64_t growth = (int64_t)lv_area_get_size(&u) - (int64_t)lv_area_get_size(&data.regions[i]) -
+                         (int64_t)lv_area_get_size(&area);
+        if (growth < best_growth) {
+            best        = i;
+            best_growth = growth;
+            best_union  = u;
+        }
+    }
+
+    if (best >= 0 && (best_growth <= 0 || data.regionCount == _region_max)) {
+        data.regions[best] = best_union;
+        data.mergedAreas++;
+    } else {
+        data.regions[data.regionCount++] = area;
+    }
+}
+
+// Runs in the LVGL task, only copies the area into the shadow frame
+static void mirror_flush_tap(lv_display_t* disp, const lv_area_t* area, const uint8_t* px_map, uint32_t stride,
+                             void* user_ctx)
+{
+    auto& data = _mirror_data;
+    if (!data.hasClients) {
+        return;
+    }
+
+    lv_area_t clip;
+    clip.x1 = std::max<int32_t>(area->x1, 0);
+    clip.y1 = std::max<int32_t>(area->y1, 0);
+    clip.x2 = std::min<int32_t>(area->x2, data.width - 1);
+    clip.y2 = std::min<int32_t>(area->y2, data.height - 1);
+    if (clip.x1 > clip.x2 || clip.y1 > clip.y2) {
+        return;
+    }
+    px_map += (clip.y1 - area->y1) * stride + (clip.x1 - area->x1) * 2;
+
+    {
+        std::lock_guard<std::mutex> lock(data.frameMutex);
+        size_t row_size = lv_area_get_width(&clip) * 2;
+        uint8_t* dst    = data.shadow + (clip.y1 * data.width + clip.x1) * 2;
+        for (int32_t y = clip.y1; y <= clip.y2; y++) {
+            memcpy(dst, px_map, row_size);
+            dst += data.width * 2;
+            px_map += stride;
+        }
+        add_region(clip);
+    }
+    xTaskNotifyGive(data.task);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                  WebSocket                                 */
+/* -------------------------------------------------------------------------- */
+// Lock _mirror_data.clientMutex before calling
+static void remove_mirror_client(int fd)
+{
+    auto& clients = _mirror_data.clients;
+    clients.erase(std::remove_if(clients.begin(), clients.end(), [fd](const MirrorClient_t& c) { return c.fd == fd; }),
+                  clients.end());
+    _mirror_data.stats.clients = clients.size();
+    _mirror_data.hasClients    = !clients.empty();
+}
+
+static void on_mirror_sent(esp_err_t err, int socket, void* arg)
+{
+    auto send = static_cast<MirrorSend_t*>(arg);
+    {
+        std::lock_guard<std::mutex> lock(_mirror_data.clientMutex);
+        auto& clients = _mirror_data.clients;
+        auto client =
+            std::find_if(clients.begin(), clients.end(), [socket](const MirrorClient_t& c) { return c.fd == socket; });
+        if (err != ESP_OK) {
+            remove_mirror_client(socket);
+        } else if (client != clients.end()) {
+            client->inFlight--;
+            _mirror_data.stats.bytesSent += send->packet->size();
+        }
+    }
+    delete send;
+
+    // The task may be waiting for the last frame to leave
+    if (_mirror_data.task) {
+        xTaskNotifyGive(_mirror_data.task);
+    }
+}
+
+// Drops closed sockets, returns true while any client still has a region in flight
+static bool update_mirror_clients()
+{
+    std::lock_guard<std::mutex> lock(_mirror_data.clientMutex);
+    auto& clients = _mirror_data.clients;
+    bool is_busy  = false;
+    for (size_t i = 0; i < clients.size();) {
+        if (httpd_ws_get_fd_info(_mirror_data.server, clients[i].fd) != HTTPD_WS_CLIENT_WEBSOCKET) {
+            clients.erase(clients.begin() + i);
+            continue;
+        }
+        is_busy |= clients[i].inFlight > 0;
+        i++;
+    }
+    _mirror_data.stats.clients = clients.size();
+    _mirror_data.hasClients    = !clients.empty();
+    return is_busy;
+}
+
+static void send_packet(const Packet_t& packet)
+{
+    std::lock_guard<std::mutex> lock(_mirror_data.clientMutex);
+    for (size_t i = 0; i < _mirror_data.clients.size();) {
+        auto& client           = _mirror_data.clients[i];
+        auto send              = new MirrorSend_t{packet};
+        httpd_ws_frame_t frame = {};
+        frame.final            = true;
+        frame.type             = HTTPD_WS_TYPE_BINARY;
+        frame.payload          = packet->data();
+        frame.len              = packet->size();
+        if (httpd_ws_send_data_async(_mirror_data.server, client.fd, &frame, on_mirror_sent, send) != ESP_OK) {
+            delete send;
+            remove_mirror_client(client.fd);
+            continue;
+        }
+        client.inFlight++;
+        i++;
+    }
+}
+
+// Implemented in hal_wifi.cpp
+esp_err_t web_ws_drain_frame(httpd_req_t* req);
+bool web_request_on_ap(httpd_req_t* req);
+
+// The screen is only shown over the station, the soft AP is open
+static esp_err_t mirror_ws_handler(httpd_req_t* req)
+{
+    if (req->method == HTTP_GET) {
+        if (web_request_on_ap(req)) {
+            return ESP_FAIL;
+        }
+        int fd = httpd_req_to_sockfd(req);
+        {
+            std::lock_guard<std::mutex> lock(_mirror_data.clientMutex);
+            if (!_mirror_data.isRunning || _mirror_data.clients.size() >= _mirror_data.config.maxClients) {
+                return ESP_FAIL;
+            }
+            MirrorClient_t client;
+            client.fd = fd;
+            _mirror_data.clients.push_back(client);
+            _mirror_data.stats.clients = _mirror_data.clients.size();
+            _mirror_data.hasClients    = true;
+        }
+        // A new client starts from a whole screen
+        _mirror_data.needsFullFrame = true;
+        xTaskNotifyGive(_mirror_data.task);
+        mclog::tagInfo(_tag, "client {} connected", fd);
+        return ESP_OK;
+    }
+
+    // Viewers have nothing to say
+    return web_ws_drain_frame(req);
+}
+
+// Draws the regions in arrival order, a region decoded late must not cover a newer one
+static const char* _viewer_html = R"(<!DOCTYPE html>
+<html><head><meta name="viewport" content="width=device-width"><title>Tab5 Mirror</title></head>
+<body style="margin:0;background:#202020"><canvas id="screen" style="max-width:100%"></canvas><script>
+const canvas = document.getElementById('screen'), ctx = canvas.getContext('2d');
+function connect() {
+  const ws = new WebSocket('ws://' + location.host + '/ws/mirror');
+  let queue = Promise.resolve();
+  ws.binaryType = 'arraybuffer';
+  ws.onmessage = e => {
+    const h = new DataView(e.data);
+    const x = h.getUint16(0, true), y = h.getUint16(2, true), w = h.getUint16(8, true), v = h.getUint16(10, true);
+    const jpeg = createImageBitmap(new Blob([new Uint8Array(e.data, 12)], {type: 'image/jpeg'}));
+    queue = queue.then(() => jpeg).then(img => {
+      if (canvas.width != w || canvas.height != v) { canvas.width = w; canvas.height = v; }
+      ctx.drawImage(img, x, y);
+      img.close();
+    }).catch(() => {});
+  };
+  ws.onclose = () => setTimeout(connect, 1000);
+}
+connect();
+</script></body></html>)";
+
+static esp_err_t mirror_page_handler(httpd_req_t* req)
+{
+    if (web_request_on_ap(req)) {
+        httpd_resp_send_err(req, HTTPD_403_FORBIDDEN, "the mirror is refused on the open access point");
+        return ESP_FAIL;
+    }
+    httpd_resp_set_type(req, "text/html");
+    return httpd_resp_send(req, _viewer_html, HTTPD_RESP_USE_STRLEN);
+}
+
+// Called by start_webserver() in hal_wifi.cpp
+void screen_mirror_register_handlers(httpd_handle_t server)
+{
+    static httpd_uri_t page_uri = {};
+    page_uri.uri                = "/mirror";
+    page_uri.method             = HTTP_GET;
+    page_uri.handler            = mirror_page_handler;
+    httpd_register_uri_handler(server, &page_uri);
+
+    static httpd_uri_t ws_uri = {};
+    ws_uri.uri                = "/ws/mirror";
+    ws_uri.method             = HTTP_GET;
+    ws_uri.handler            = mirror_ws_handler;
+    ws_uri.is_websocket       = true;
+    httpd_register_uri_handler(server, &ws_uri);
+
+    std::lock_guard<std::mutex> lock(_mirror_data.clientMutex);
+    _mirror_data.server = server;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Task                                    */
+/* -------------------------------------------------------------------------- */
+// Grows the region to whole encoder blocks, kept inside the screen
+static void align_region(lv_area_t& area, int32_t width, int32_t height)
+{
+    int32_t w = (lv_area_get_width(&area) + (area.x1 % _block_size) + _block_size - 1) / _block_size * _block_size;
+    int32_t h = (lv_area_get_height(&area) + (area.y1 % _block_size) + _block_size - 1) / _block_size * _block_size;
+    w         = std::min(w, width / _block_size * _block_size);
+    h         = std::min(h, height / _block_size * _block_size);
+    area.x1   = std::min(area.x1 / _block_size * _block_size, width - w);
+    area.y1   = std::min(area.y1 / _block_size * _block_size, height - h);
+    area.x2   = area.x1 + w - 1;
+    area.y2   = area.y1 + h - 1;
+}
+
+static void put_u16(uint8_t* dst, int32_t value)
+{
+    dst[0] = value & 0xFF;
+    dst[1] = (value >> 8) & 0xFF;
+}
+
+static bool encode_region(const lv_area_t& area)
+{
+    auto& data       = _mirror_data;
+    int32_t w        = lv_area_get_width(&area);
+    int32_t h        = lv_area_get_height(&area);
+    size_t row_size  = w * 2;
+    uint32_t in_size = w * h * 2;
+    {
+        std::lock_guard<std::mutex> lock(data.frameMutex);
+        PixelConverter::Image_t src;
+        src.data   = data.shadow + (area.y1 * data.width + area.x1) * 2;
+        src.format = pixel_convert::FORMAT_RGB565;
+        src.width  = w;
+        src.height = h;
+        src.stride = data.width * 2;
+        data.converter.convert(src, data.encodeIn, pixel_convert::FORMAT_RGB565, row_size);
+    }
+
+    jpeg_encode_cfg_t enc_cfg = {
+        .height        = (uint32_t)h,
+        .width         = (uint32_t)w,
+        .src_type      = JPEG_ENCODE_IN_FORMAT_RGB565,
+        .sub_sample    = JPEG_DOWN_SAMPLING_YUV420,
+        .image_quality = data.config.quality,
+    };
+    uint32_t jpeg_size = 0;
+    if (jpeg_encoder_process(data.encoder, &enc_cfg, data.encodeIn, in_size, data.encodeOut, data.encodeOutSize,
+                             &jpeg_size) != ESP_OK) {
+        std::lock_guard<std::mutex> lock(data.clientMutex);
+        data.stats.encodeFails++;
+        return false;
+    }
+
+    auto packet     = std::make_shared<std::vector<uint8_t>>(_header_size + jpeg_size);
+    uint8_t* header = packet->data();
+    put_u16(header + 0, area.x1);
+    put_u16(header + 2, area.y1);
+    put_u16(header + 4, w);
+    put_u16(header + 6, h);
+    put_u16(header + 8, data.width);
+    put_u16(header + 10, data.height);
+    memcpy(header + _header_size, data.encodeOut, jpeg_size);
+    send_packet(packet);
+    return true;
+}
+
+// UI command, renders everything again through the tap for a new client
+static void invalidate_mirror_display()
+{
+    lv_obj_invalidate(lv_display_get_screen_active(_mirror_data.display));
+    lv_obj_invalidate(lv_display_get_layer_top(_mirror_data.display));
+}
+
+void HalEsp32::screen_mirror_task(void* param)
+{
+    static_cast<HalEsp32*>(param)->screen_mirror_loop();
+
+    xSemaphoreGive(_mirror_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+void HalEsp32::screen_mirror_loop()
+{
+    auto& data         = _mirror_data;
+    uint32_t last_push = 0;
+
+    while (data.isRunning) {
+        // Woken by flushes, sent frames and new clients, the timeout only notices closed sockets
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(200));
+        if (!data.isRunning) {
+            break;
+        }
+
+        // Regions keep merging while any client is still taking the previous push, so the slowest link sets the rate
+        if (update_mirror_clients() || !data.hasClients) {
+            continue;
+        }
+
+        // Rendered again through the tap, posted so the mirror never waits on a frame being rendered
+        if (data.needsFullFrame.exchange(false)) {
+            if (!postUiCommand(invalidate_mirror_display)) {
+                data.needsFullFrame = true;
+            }
+            continue;
+        }
+
+        uint32_t elapsed = millis() - last_push;
+        if (elapsed < data.config.minIntervalMs) {
+            vTaskDelay(pdMS_TO_TICKS(data.config.minIntervalMs - elapsed));
+        }
+
+        lv_area_t regions[_region_max];
+        int region_count = 0;
+        {
+            std::lock_guard<std::mutex> lock(data.frameMutex);
+            region_count = data.regionCount;
+            std::copy(data.regions, data.regions + region_count, regions);
+            data.regionCount = 0;
+        }
+        if (region_count == 0) {
+            continue;
+        }
+
+        uint32_t sent = 0;
+        for (int i = 0; i < region_count; i++) {
+            align_region(regions[i], data.width, data.height);
+            sent += encode_region(regions[i]) ? 1 : 0;
+        }
+        last_push = millis();
+
+        std::lock_guard<std::mutex> lock(data.clientMutex);
+        data.stats.frames++;
+        data.stats.regions += sent;
+    }
+}
+
+static void free_mirror_buffers()
+{
+    auto& data = _mirror_data;
+    if (data.encoder) {
+        jpeg_del_encoder_engine(data.encoder);
+        data.encoder = nullptr;
+    }
+    // Packets in flight own a copy, the buffers can go right away
+    free(data.encodeIn);
+    free(data.encodeOut);
+    heap_caps_free(data.shadow);
+    data.encodeIn  = nullptr;
+    data.encodeOut = nullptr;
+    data.shadow    = nullptr;
+}
+
+bool HalEsp32::startScreenMirror(const ScreenMirrorConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_mirror_data.mutex);
+    auto& data = _mirror_data;
+
+    if (data.isRunning) {
+        return true;
+    }
+    if (lvDisp == nullptr || lv_display_get_color_format(lvDisp) != LV_COLOR_FORMAT_RGB565) {
+        mclog::tagError(_tag, "needs an rgb565 display");
+        return false;
+    }
+
+    data.config  = config;
+    data.display = lvDisp;
+    data.width   = lv_display_get_horizontal_resolution(lvDisp);
+    data.height  = lv_display_get_vertical_resolution(lvDisp);
+
+    jpeg_encode_engine_cfg_t engine_cfg = {
+        .intr_priority = 0,
+        .timeout_ms    = 100,
+    };
+    if (jpeg_new_encoder_engine(&engine_cfg, &data.encoder) != ESP_OK) {
+        mclog::tagError(_tag, "failed to create jpeg encoder");
+        return false;
+    }
+
+    // A whole screen fits in one region, and its JPEG is far below a byte per pixel
+    size_t frame_size                      = data.width * data.height * 2;
+    size_t allocated                       = 0;
+    jpeg_encode_memory_alloc_cfg_t in_cfg  = {.buffer_direction = JPEG_ENC_ALLOC_INPUT_BUFFER};
+    jpeg_encode_memory_alloc_cfg_t out_cfg = {.buffer_direction = JPEG_ENC_ALLOC_OUTPUT_BUFFER};
+    data.encodeIn                          = (uint8_t*)jpeg_alloc_encoder_mem(frame_size, &in_cfg, &allocated);
+    data.encodeOut                         = (uint8_t*)jpeg_alloc_encoder_mem(frame_size / 2, &out_cfg, &allocated);
+    data.encodeOutSize                     = allocated;
+    data.shadow                            = (uint8_t*)heap_caps_malloc(frame_size, MALLOC_CAP_SPIRAM);
+    if (data.encodeIn == nullptr || data.encodeOut == nullptr || data.shadow == nullptr) {
+        mclog::tagError(_tag, "malloc for {}x{} frames failed", data.width, data.height);
+        free_mirror_buffers();
+        return false;
+    }
+    data.regionCount = 0;
+    data.mergedAreas = 0;
+    {
+        std::lock_guard<std::mutex> client_lock(data.clientMutex);
+        data.stats = ScreenMirrorStats_t();
+    }
+    if (data.exitSem == nullptr) {
+        data.exitSem = xSemaphoreCreateBinary();
+    }
+
+    data.isRunning = true;
+    if (xTaskCreate(screen_mirror_task, "mirror", 4096, this, 2, &data.task) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        data.isRunning = false;
+        free_mirror_buffers();
+        return false;
+    }
+
+    lvglLock();
+    lvgl_port_set_flush_tap(lvDisp, mirror_flush_tap, nullptr);
+    lvglUnlock();
+
+    mclog::tagInfo(_tag, "start, {}x{} quality {}", data.width, data.height, config.quality);
+    return true;
+}
+
+void HalEsp32::stopScreenMirror()
+{
+    std::lock_guard<std::mutex> lock(_mirror_data.mutex);
+    auto& data = _mirror_data;
+
+    if (!data.isRunning) {
+        return;
+    }
+
+    lvglLock();
+    lvgl_port_set_flush_tap(data.display, nullptr, nullptr);
+    lvglUnlock();
+
+    data.isRunning = false;
+    xTaskNotifyGive(data.task);
+    xSemaphoreTake(data.exitSem, portMAX_DELAY);
+    data.task = nullptr;
+
+    {
+        std::lock_guard<std::mutex> client_lock(data.clientMutex);
+        for (const auto& client : data.clients) {
+            httpd_sess_trigger_close(data.server, client.fd);
+        }
+        data.clients.clear();
+        data.stats.clients = 0;
+        data.hasClients    = false;
+    }
+    free_mirror_buffers();
+    mclog::tagInfo(_tag, "stop");
+}
+
+hal::HalBase::ScreenMirrorStats_t HalEsp32::getScreenMirrorStats()
+{
+    ScreenMirrorStats_t stats;
+    {
+        std::lock_guard<std::mutex> lock(_mirror_data.clientMutex);
+        stats = _mirror_data.stats;
+    }
+    std::lock_guard<std::mutex> lock(_mirror_data.frameMutex);
+    stats.mergedAreas = _mirror_data.mergedAreas;
+    return stats;
+}
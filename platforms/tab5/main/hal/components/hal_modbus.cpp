@@ -0,0 +1,645 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <shared/shared.h>
+#include <mooncake_log.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+static const std::string _tag = "modbus";
+
+// RTU frames are at most 256 bytes, CRC included
+static constexpr size_t _max_frame_size = 256;
+// Above this rate the spec fixes the inter-frame gap at 1.75 ms instead of 3.5 characters
+static constexpr uint32_t _fixed_gap_baud = 19200;
+static constexpr uint32_t _fixed_gap_us   = 1750;
+// Start, 8 data, parity or second stop, stop
+static constexpr uint32_t _bits_per_char = 11;
+// Longest idle timeout the UART takes at 11 bit symbols
+static constexpr uint32_t _max_timeout_symbols = 90;
+// Broadcasts get no response, the slaves get this long to act on them
+static constexpr uint32_t _broadcast_turnaround_ms = 100;
+static constexpr size_t _max_pending_writes        = 16;
+
+static constexpr uint16_t _max_read_registers  = 125;
+static constexpr uint16_t _max_read_bits       = 2000;
+static constexpr uint16_t _max_write_registers = 123;
+
+enum ModbusException_t : uint8_t {
+    EXCEPTION_ILLEGAL_FUNCTION = 0x01,
+    EXCEPTION_ILLEGAL_ADDRESS  = 0x02,
+    EXCEPTION_ILLEGAL_VALUE    = 0x03,
+};
+
+// Modbus CRC-16, reflected polynomial 0xA001, one table lookup per byte
+static constexpr std::array<uint16_t, 256> make_crc_table()
+{
+    std::array<uint16_t, 256> table = {};
+    for (uint32_t i = 0; i < 256; i++) {
+        uint16_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+static constexpr std::array<uint16_t, 256> _crc_table = make_crc_table();
+
+static uint16_t crc16(const uint8_t* data, size_t size)
+{
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < size; i++) {
+        crc = (crc >> 8) ^ _crc_table[(crc ^ data[i]) & 0xFF];
+    }
+    return crc;
+}
+
+static void append_crc(std::vector<uint8_t>& frame)
+{
+    uint16_t crc = crc16(frame.data(), frame.size());
+    frame.push_back(crc & 0xFF);
+    frame.push_back(crc >> 8);
+}
+
+static bool check_crc(const uint8_t* frame, size_t size)
+{
+    if (size < 4) {
+        return false;
+    }
+    uint16_t crc = crc16(frame, size - 2);
+    return frame[size - 2] == (crc & 0xFF) && frame[size - 1] == (crc >> 8);
+}
+
+static uint16_t get_u16(const uint8_t* data)
+{
+    return (data[0] << 8) | data[1];
+}
+
+static void push_u16(std::vector<uint8_t>& frame, uint16_t value)
+{
+    frame.push_back(value >> 8);
+    frame.push_back(value & 0xFF);
+}
+
+struct ScheduledPoll_t {
+    hal::HalBase::ModbusPoll_t poll;
+    // Built once at start, CRC included
+    std::vector<uint8_t> request;
+    TickType_t nextDue = 0;
+};
+
+struct ModbusEngineData_t {
+    std::mutex mutex;
+    // Cleared under frameMutex, so no frame notifies the task once stop has begun
+    std::atomic<bool> isRunning{false};
+    SemaphoreHandle_t exitSem = nullptr;
+    TaskHandle_t taskHandle   = nullptr;
+    hal::HalBase::ModbusConfig_t config;
+    // RS485 task to the Modbus task, a newer frame replaces one not taken yet
+    std::mutex frameMutex;
+    uint8_t frame[_max_frame_size];
+    size_t frameSize = 0;
+    // Master mode writes, sent ahead of the schedule
+    std::mutex writeMutex;
+    std::deque<std::vector<uint8_t>> writes;
+    // Slave mode register map
+    std::mutex registerMutex;
+    std::vector<uint16_t> registers;
+    std::mutex statsMutex;
+    hal::HalBase::ModbusStats_t stats;
+};
+static ModbusEngineData_t _modbus_data;
+
+static void count_event(uint32_t& counter)
+{
+    std::lock_guard<std::mutex> lock(_modbus_data.statsMutex);
+    counter++;
+}
+
+// t3.5 as UART idle symbols, so the RS485 task hands over one frame per timeout
+static uint8_t frame_timeout_symbols(uint32_t baudRate)
+{
+    if (baudRate <= _fixed_gap_baud) {
+        return 4;
+    }
+    uint64_t symbols = ((uint64_t)_fixed_gap_us * baudRate + _bits_per_char * 1000000 - 1) / (_bits_per_char * 1000000);
+    return std::clamp<uint64_t>(symbols, 4, _max_timeout_symbols);
+}
+
+// Called on the RS485 task, which must not wait on the bus, so the frame is only copied
+static void on_frame(const uint8_t* data, size_t size)
+{
+    std::lock_guard<std::mutex> lock(_modbus_data.frameMutex);
+
+    if (!_modbus_data.isRunning) {
+        return;
+    }
+    if (size > _max_frame_size) {
+        // Longer than any RTU frame, noise or two frames run together
+        count_event(_modbus_data.stats.crcErrors);
+        return;
+    }
+    memcpy(_modbus_data.frame, data, size);
+    _modbus_data.frameSize = size;
+    xTaskNotifyGive(_modbus_data.taskHandle);
+}
+
+static void clear_frame()
+{
+    std::lock_guard<std::mutex> lock(_modbus_data.frameMutex);
+    _modbus_data.frameSize = 0;
+    ulTaskNotifyTake(pdTRUE, 0);
+}
+
+// Returns the size of the next frame, 0 on timeout or stop
+static size_t wait_frame(uint8_t* buffer, TickType_t timeout)
+{
+    TickType_t start = xTaskGetTickCount();
+    while (_modbus_data.isRunning) {
+        {
+            std::lock_guard<std::mutex> lock(_modbus_data.frameMutex);
+            if (_modbus_data.frameSize > 0) {
+                size_t size = _modbus_data.frameSize;
+                memcpy(buffer, _modbus_data.frame, size);
+                _modbus_data.frameSize = 0;
+                return size;
+            }
+        }
+
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (timeout != portMAX_DELAY && elapsed >= timeout) {
+            break;
+        }
+        ulTaskNotifyTake(pdTRUE, timeout == portMAX_DELAY ? portMAX_DELAY : timeout - elapsed);
+    }
+    return 0;
+}
+
+static std::vector<uint8_t> build_read_request(const hal::HalBase::ModbusPoll_t& poll)
+{
+    std::vector<uint8_t> request = {poll.slaveId, poll.function};
+    push_u16(request, poll.address);
+    push_u16(request, poll.count);
+    append_crc(request);
+    return request;
+}
+
+static std::vector<uint8_t> build_write_request(uint8_t slaveId, uint16_t address, const std::vector<uint16_t>& values)
+{
+    std::vector<uint8_t> request;
+    if (values.size() == 1) {
+        request = {slaveId, hal::HalBase::MODBUS_WRITE_SINGLE_REGISTER};
+        push_u16(request, address);
+        push_u16(request, values[0]);
+    } else {
+        request = {slaveId, hal::HalBase::MODBUS_WRITE_MULTIPLE_REGISTERS};
+        push_u16(request, address);
+        push_u16(request, values.size());
+        request.push_back(values.size() * 2);
+        for (auto value : values) {
+            push_u16(request, value);
+        }
+    }
+    append_crc(request);
+    return request;
+}
+
+static bool is_bit_function(hal::HalBase::ModbusFunction_t function)
+{
+    return function == hal::HalBase::MODBUS_READ_COILS || function == hal::HalBase::MODBUS_READ_DISCRETE_INPUTS;
+}
+
+static bool is_valid_poll(const hal::HalBase::ModbusPoll_t& poll)
+{
+    if (poll.slaveId < 1 || poll.slaveId > 247 || poll.count == 0) {
+        return false;
+    }
+    switch (poll.function) {
+        case hal::HalBase::MODBUS_READ_COILS:
+        case hal::HalBase::MODBUS_READ_DISCRETE_INPUTS:
+            return poll.count <= _max_read_bits;
+        case hal::HalBase::MODBUS_READ_HOLDING_REGISTERS:
+        case hal::HalBase::MODBUS_READ_INPUT_REGISTERS:
+            return poll.count <= _max_read_registers;
+        default:
+            return false;
+    }
+}
+
+// Send a request and wait for the matching response, returns its size, 0 for a broadcast, a timeout or a bad CRC
+static size_t transact(const std::vector<uint8_t>& request, uint8_t* response)
+{
+    const auto& config = _modbus_data.config;
+
+    clear_frame();
+    count_event(_modbus_data.stats.requests);
+    GetHAL()->rs485Write(request.data(), request.size());
+
+    uint8_t slave_id = request[0];
+    if (slave_id == 0) {
+        vTaskDelay(pdMS_TO_TICKS(_broadcast_turnaround_ms));
+        return 0;
+    }
+
+    // The write only queues the request, the response timeout starts once it is on the line
+    uint32_t tx_ms     = request.size() * _bits_per_char * 1000 / config.port.baudRate + 1;
+    TickType_t timeout = pdMS_TO_TICKS(tx_ms + config.responseTimeoutMs);
+    TickType_t start   = xTaskGetTickCount();
+    while (1) {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        size_t size        = elapsed < timeout ? wait_frame(response, timeout - elapsed) : 0;
+        if (size == 0) {
+            count_event(_modbus_data.stats.timeouts);
+            return 0;
+        }
+        if (!check_crc(response, size)) {
+            count_event(_modbus_data.stats.crcErrors);
+            return 0;
+        }
+        // A late reply to an earlier request that already timed out
+        if (response[0] != slave_id || (response[1] & 0x7F) != request[1]) {
+            continue;
+        }
+
+        count_event(_modbus_data.stats.responses);
+        if (response[1] & 0x80) {
+            count_event(_modbus_data.stats.exceptions);
+        }
+        return size;
+    }
+}
+
+// Unpack a read response, bits become one value each
+static bool parse_read_response(const hal::HalBase::ModbusPoll_t& poll, const uint8_t* response, size_t size,
+                                std::vector<uint16_t>& values, uint8_t& exception)
+{
+    exception = 0;
+    if (response[1] & 0x80) {
+        exception = size == 5 ? response[2] : 0;
+        return false;
+    }
+
+    bool is_bits      = is_bit_function(poll.function);
+    size_t byte_count = is_bits ? (poll.count + 7) / 8 : poll.count * 2;
+    if (size != 5 + byte_count || response[2] != byte_count) {
+        return false;
+    }
+
+    values.resize(poll.count);
+    const uint8_t* payload = response + 3;
+    for (uint16_t i = 0; i < poll.count; i++) {
+        values[i] = is_bits ? (payload[i / 8] >> (i % 8)) & 1 : get_u16(payload + i * 2);
+    }
+    return true;
+}
+
+static void publish_result(size_t index, bool ok, uint8_t exception, const std::vector<uint16_t>& values)
+{
+    auto& modbus = GetModbusData();
+    std::lock_guard<std::mutex> lock(modbus.mutex);
+
+    auto& result     = modbus.polls[index];
+    result.exception = exception;
+    if (ok) {
+        result.values     = values;
+        result.updateTime = GetHAL()->millis();
+    } else {
+        result.errorCount++;
+    }
+    modbus.sequence++;
+}
+
+static bool pop_write(std::vector<uint8_t>& request)
+{
+    std::lock_guard<std::mutex> lock(_modbus_data.writeMutex);
+    if (_modbus_data.writes.empty()) {
+        return false;
+    }
+    request = std::move(_modbus_data.writes.front());
+    _modbus_data.writes.pop_front();
+    return true;
+}
+
+static void run_master()
+{
+    std::vector<ScheduledPoll_t> schedule;
+    TickType_t now = xTaskGetTickCount();
+    for (const auto& poll : _modbus_data.config.polls) {
+        schedule.push_back({poll, build_read_request(poll), now});
+    }
+
+    uint8_t response[_max_frame_size];
+    std::vector<uint8_t> write_request;
+    std::vector<uint16_t> values;
+
+    while (_modbus_data.isRunning) {
+        // A setpoint from the UI goes out after at most the transaction on the line
+        if (pop_write(write_request)) {
+            transact(write_request, response);
+            continue;
+        }
+
+        // Earliest due poll first, ties go to the first in the table
+        ScheduledPoll_t* next = nullptr;
+        for (auto& entry : schedule) {
+            if (next == nullptr || (int32_t)(entry.nextDue - next->nextDue) < 0) {
+                next = &entry;
+            }
+        }
+        if (next == nullptr) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        // A queued write or stop notifies the task early
+        int32_t wait = next->nextDue - xTaskGetTickCount();
+        if (wait > 0) {
+            ulTaskNotifyTake(pdTRUE, wait);
+            continue;
+        }
+
+        uint8_t exception = 0;
+        size_t size       = transact(next->request, response);
+        bool ok           = size > 0 && parse_read_response(next->poll, response, size, values, exception);
+        publish_result(next - schedule.data(), ok, exception, values);
+
+        // Due times stay on a fixed grid, a poll still behind after a full interval is started over from now
+        next->nextDue += pdMS_TO_TICKS(next->poll.intervalMs);
+        now = xTaskGetTickCount();
+        if ((int32_t)(now - next->nextDue) > 0) {
+            if (next->poll.intervalMs > 0) {
+                count_event(_modbus_data.stats.overruns);
+            }
+            next->nextDue = now;
+        }
+    }
+}
+
+static void build_exception(std::vector<uint8_t>& response, const uint8_t* request, uint8_t exception)
+{
+    response = {request[0], (uint8_t)(request[1] | 0x80), exception};
+    count_event(_modbus_data.stats.exceptions);
+}
+
+// Size excludes the CRC
+static void handle_slave_request(const uint8_t* request, size_t size, std::vector<uint8_t>& response)
+{
+    std::lock_guard<std::mutex> lock(_modbus_data.registerMutex);
+    auto& registers = _modbus_data.registers;
+
+    response.clear();
+    uint8_t function = request[1];
+    uint16_t address = size >= 4 ? get_u16(request + 2) : 0;
+    uint16_t count   = size >= 6 ? get_u16(request + 4) : 0;
+
+    switch (function) {
+        case hal::HalBase::MODBUS_READ_HOLDING_REGISTERS:
+        case hal::HalBase::MODBUS_READ_INPUT_REGISTERS: {
+            if (size != 6 || count == 0 || count > _max_read_registers) {
+                build_exception(response, request, EXCEPTION_ILLEGAL_VALUE);
+                break;
+            }
+            if (address + count > registers.size()) {
+                build_exception(response, request, EXCEPTION_ILLEGAL_ADDRESS);
+                break;
+            }
+            response = {request[0], function, (uint8_t)(count * 2)};
+            for (uint16_t i = 0; i < count; i++) {
+                push_u16(response, registers[address + i]);
+            }
+            break;
+        }
+        case hal::HalBase::MODBUS_WRITE_SINGLE_REGISTER: {
+            if (size != 6) {
+                build_exception(response, request, EXCEPTION_ILLEGAL_VALUE);
+                break;
+            }
+            if (address >= registers.size()) {
+                build_exception(response, request, EXCEPTION_ILLEGAL_ADDRESS);
+                break;
+            }
+            registers[address] = count;
+            // The reply echoes the request
+            response.assign(request, request + 6);
+            break;
+        }
+        case hal::HalBase::MODBUS_WRITE_MULTIPLE_REGISTERS: {
+            if (size < 7 || count == 0 || count > _max_write_registers || request[6] != count * 2 ||
+                size != (size_t)(7 + count * 2)) {
+                build_exception(response, request, EXCEPTION_ILLEGAL_VALUE);
+                break;
+            }
+            if (address + count > registers.size()) {
+                build_exception(response, request, EXCEPTION_ILLEGAL_ADDRESS);
+                break;
+            }
+            for (uint16_t i = 0; i < count; i++) {
+                registers[address + i] = get_u16(request + 7 + i * 2);
+            }
+            response.assign(request, request + 6);
+            break;
+        }
+        default:
+            build_exception(response, request, EXCEPTION_ILLEGAL_FUNCTION);
+            break;
+    }
+}
+
+static void run_slave()
+{
+    const auto& config = _modbus_data.config;
+    uint8_t request[_max_frame_size];
+    std::vector<uint8_t> response;
+    response.reserve(_max_frame_size);
+
+    while (_modbus_data.isRunning) {
+        size_t size = wait_frame(request, portMAX_DELAY);
+        if (size == 0) {
+            continue;
+        }
+        if (!check_crc(request, size)) {
+            count_event(_modbus_data.stats.crcErrors);
+            continue;
+        }
+        uint8_t slave_id = request[0];
+        if (slave_id != config.slaveId && slave_id != 0) {
+            continue;
+        }
+
+        count_event(_modbus_data.stats.requests);
+        handle_slave_request(request, size - 2, response);
+        // Broadcasts are carried out without a reply
+        if (slave_id == 0 || response.empty()) {
+            continue;
+        }
+        append_crc(response);
+        GetHAL()->rs485Write(response.data(), response.size());
+        count_event(_modbus_data.stats.responses);
+    }
+}
+
+static void _modbus_task(void* param)
+{
+    if (_modbus_data.config.isSlave) {
+        run_slave();
+    } else {
+        run_master();
+    }
+
+    xSemaphoreGive(_modbus_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+bool HalEsp32::startModbus(const ModbusConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_modbus_data.mutex);
+
+    if (_modbus_data.isRunning) {
+        mclog::tagWarn(_tag, "already running");
+        return false;
+    }
+    if (isRs485GatewayRunning()) {
+        mclog::tagError(_tag, "port taken by the rs485 gateway");
+        return false;
+    }
+    if (!config.isSlave) {
+        for (size_t i = 0; i < config.polls.size(); i++) {
+            if (!is_valid_poll(config.polls[i])) {
+                mclog::tagError(_tag, "invalid poll {}", i);
+                return false;
+            }
+        }
+    } else if (config.slaveId < 1 || config.slaveId > 247) {
+        mclog::tagError(_tag, "invalid slave id {}", config.slaveId);
+        return false;
+    }
+
+    _modbus_data.config = config;
+    _modbus_data.registers.assign(config.isSlave ? config.slaveRegisterCount : 0, 0);
+    _modbus_data.writes.clear();
+    _modbus_data.frameSize = 0;
+    _modbus_data.stats     = ModbusStats_t();
+    {
+        auto& modbus = GetModbusData();
+        std::lock_guard<std::mutex> shared_lock(modbus.mutex);
+        modbus.polls.assign(config.isSlave ? 0 : config.polls.size(), shared_data::ModbusPollValues_t());
+        modbus.sequence++;
+    }
+    if (_modbus_data.exitSem == nullptr) {
+        _modbus_data.exitSem = xSemaphoreCreateBinary();
+    }
+
+    // Frames are cut by the UART idle timeout, no pattern detection
+    Rs485Config_t port       = config.port;
+    port.frameTimeoutSymbols = frame_timeout_symbols(port.baudRate);
+    port.patternChar         = -1;
+
+    if (!claimPeripheral(PERIPHERAL_RS485, "modbus")) {
+        return false;
+    }
+    if (!setRs485Config(port, on_frame)) {
+        releasePeripheral(PERIPHERAL_RS485, "modbus");
+        return false;
+    }
+
+    // Held across the create, so the callback never sees a running engine without its task handle
+    bool is_created = false;
+    {
+        std::lock_guard<std::mutex> frame_lock(_modbus_data.frameMutex);
+        _modbus_data.isRunning = true;
+        is_created = xTaskCreate(_modbus_task, "modbus", 4096, nullptr, 11, &_modbus_data.taskHandle) == pdPASS;
+        _modbus_data.isRunning = is_created;
+    }
+    if (!is_created) {
+        mclog::tagError(_tag, "create task failed");
+        setRs485Config(Rs485Config_t());
+        releasePeripheral(PERIPHERAL_RS485, "modbus");
+        return false;
+    }
+
+    mclog::tagInfo(_tag, "start as {}, {} polls, frame timeout {} symbols", config.isSlave ? "slave" : "master",
+                   config.isSlave ? 0 : config.polls.size(), port.frameTimeoutSymbols);
+    return true;
+}
+
+void HalEsp32::stopModbus()
+{
+    std::lock_guard<std::mutex> lock(_modbus_data.mutex);
+
+    if (!_modbus_data.isRunning) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> frame_lock(_modbus_data.frameMutex);
+        _modbus_data.isRunning = false;
+    }
+    // The task finishes the transaction on the line
+    xTaskNotifyGive(_modbus_data.taskHandle);
+    xSemaphoreTake(_modbus_data.exitSem, portMAX_DELAY);
+    _modbus_data.taskHandle = nullptr;
+
+    setRs485Config(Rs485Config_t());
+    releasePeripheral(PERIPHERAL_RS485, "modbus");
+    mclog::tagInfo(_tag, "stop");
+}
+
+bool HalEsp32::isModbusRunning()
+{
+    return _modbus_data.isRunning;
+}
+
+bool HalEsp32::modbusWriteRegisters(uint8_t slaveId, uint16_t address, const std::vector<uint16_t>& values)
+{
+    std::lock_guard<std::mutex> lock(_modbus_data.mutex);
+
+    if (!_modbus_data.isRunning || _modbus_data.config.isSlave) {
+        return false;
+    }
+    if (slaveId > 247 || values.empty() || values.size() > _max_write_registers) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> write_lock(_modbus_data.writeMutex);
+        if (_modbus_data.writes.size() >= _max_pending_writes) {
+            mclog::tagWarn(_tag, "write queue full");
+            return false;
+        }
+        _modbus_data.writes.push_back(build_write_request(slaveId, address, values));
+    }
+    xTaskNotifyGive(_modbus_data.taskHandle);
+    return true;
+}
+
+void HalEsp32::setModbusSlaveRegister(uint16_t address, uint16_t value)
+{
+    std::lock_guard<std::mutex> lock(_modbus_data.registerMutex);
+    if (address < _modbus_data.registers.size()) {
+        _modbus_data.registers[address] = value;
+    }
+}
+
+uint16_t HalEsp32::getModbusSlaveRegister(uint16_t address)
+{
+    std::lock_guard<std::mutex> lock(_modbus_data.registerMutex);
+    return address < _modbus_data.registers.size() ? _modbus_data.registers[address] : 0;
+}
+
+hal::HalBase::ModbusStats_t HalEsp32::getModbusStats()
+{
+    std::lock_guard<std::mutex> lock(_modbus_data.statsMutex);
+    return _modbus_data.stats;
+}
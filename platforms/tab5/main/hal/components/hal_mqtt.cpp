@@ -0,0 +1,645 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <esp_mac.h>
+#include <esp_rom_crc.h>
+#include <mqtt_client.h>
+
+static const std::string _tag = "mqtt";
+
+static const char* _queue_dir  = "/sd/mqtt";
+static const char* _queue_path = "/sd/mqtt/queue.dat";
+static const char* _head_path  = "/sd/mqtt/queue.pos";
+// "MQBQ", starts every record in the queue file
+static constexpr uint32_t _record_magic = 0x5142514D;
+// Batch length over the configured one at most, while the link stays congested
+static constexpr uint8_t _max_batch_scale = 8;
+// An acknowledge slower than this counts as congestion
+static constexpr uint32_t _congested_rtt_ms = 2000;
+// Not acknowledged after this, the batch is taken as lost and queued again
+static constexpr uint32_t _ack_timeout_ms = 60000;
+static constexpr size_t _event_queue_len  = 32;
+// Time the radio stays awake after the last send, a QoS 0 batch is still in the client outbox for a moment
+static constexpr uint32_t _radio_hold_ms = 1000;
+// Before 2020 the clock was never set
+static constexpr int64_t _min_unix_ms = 1577836800LL * 1000;
+// History samples copied per read
+static constexpr size_t _history_batch = 32;
+
+// Columns of a payload, one value per sample
+enum MqttColumn_t {
+    COLUMN_VOLTAGE = 0,
+    COLUMN_CURRENT,
+    COLUMN_POWER,
+    COLUMN_ACCEL,
+    COLUMN_TEMP,
+    COLUMN_NUM,
+};
+static const char* _column_names[COLUMN_NUM] = {"v", "i", "p", "a", "temp"};
+
+// From the client's event loop to the publisher task
+enum MqttEventType_t {
+    MQTT_EVT_CONNECTED = 0,
+    MQTT_EVT_DISCONNECTED,
+    MQTT_EVT_ACKED,
+    MQTT_EVT_DELETED,
+    // Only wakes the task, stopMqtt() sends it
+    MQTT_EVT_WAKE,
+};
+
+struct MqttEvent_t {
+    MqttEventType_t type;
+    int msgId;
+};
+
+struct RecordHeader_t {
+    uint32_t magic;
+    uint32_t size;
+    uint32_t crc;
+};
+
+struct InFlight_t {
+    int msgId       = 0;
+    uint32_t sentMs = 0;
+    bool isReplay   = false;
+    // Live batches keep the payload, a lost one goes to the queue. Replayed ones only need where their record ends
+    std::string payload;
+    uint32_t recordEnd = 0;
+};
+
+// Records in [head, tail) of the file are not acknowledged, replay is the next one to send. One replay is in flight at
+// a time, so head only moves forward
+struct OfflineQueue_t {
+    bool isOpen     = false;
+    uint32_t head   = 0;
+    uint32_t tail   = 0;
+    uint32_t replay = 0;
+    uint32_t count  = 0;
+};
+
+struct Batch_t {
+    int64_t startUnixMs    = 0;
+    uint32_t startUptimeMs = 0;
+    uint32_t count         = 0;
+    std::vector<float> columns[COLUMN_NUM];
+};
+
+struct MqttData_t {
+    std::mutex mutex;
+    TaskHandle_t task           = nullptr;
+    SemaphoreHandle_t exitSem   = nullptr;
+    std::atomic<bool> isRunning = false;
+    hal::HalBase::MqttConfig_t config;
+    esp_mqtt_client_handle_t client = nullptr;
+    QueueHandle_t events            = nullptr;
+    std::mutex statsMutex;
+    hal::HalBase::MqttStats_t stats;
+};
+static MqttData_t _mqtt_data;
+
+template <typename Update>
+static void update_stats(Update update)
+{
+    std::lock_guard<std::mutex> lock(_mqtt_data.statsMutex);
+    update(_mqtt_data.stats);
+}
+
+static int64_t unix_time_ms()
+{
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return (int64_t)tv.tv_sec * 1000 + tv.tv_usec / 1000;
+}
+
+static void on_mqtt_event(void* arg, esp_event_base_t base, int32_t eventId, void* eventData)
+{
+    auto event      = static_cast<esp_mqtt_event_handle_t>(eventData);
+    MqttEvent_t out = {MQTT_EVT_WAKE, event->msg_id};
+    switch (eventId) {
+        case MQTT_EVENT_CONNECTED:
+            out.type = MQTT_EVT_CONNECTED;
+            break;
+        case MQTT_EVENT_DISCONNECTED:
+            out.type = MQTT_EVT_DISCONNECTED;
+            break;
+        case MQTT_EVENT_PUBLISHED:
+            out.type = MQTT_EVT_ACKED;
+            break;
+        case MQTT_EVENT_DELETED:
+            out.type = MQTT_EVT_DELETED;
+            break;
+        default:
+            return;
+    }
+    // A lost ack is caught by the ack timeout
+    xQueueSend(_mqtt_data.events, &out, 0);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                Offline queue                               */
+/* -------------------------------------------------------------------------- */
+static void queue_reset(OfflineQueue_t& queue)
+{
+    remove(_queue_path);
+    remove(_head_path);
+    queue.head   = 0;
+    queue.tail   = 0;
+    queue.replay = 0;
+    queue.count  = 0;
+}
+
+// Reads the head and counts the records after it, a record torn by a power cut is cut off
+static bool queue_open(OfflineQueue_t& queue)
+{
+    if (queue.isOpen) {
+        return true;
+    }
+    if (!GetHAL()->isSdCardMounted()) {
+        return false;
+    }
+    mkdir(_queue_dir, 0777);
+
+    struct stat st;
+    uint32_t size = stat(_queue_path, &st) == 0 ? st.st_size : 0;
+    uint32_t head = 0;
+    FILE* file    = fopen(_head_path, "rb");
+    if (file != nullptr) {
+        if (fread(&head, sizeof(head), 1, file) != 1 || head > size) {
+            head = 0;
+        }
+        fclose(file);
+    }
+
+    uint32_t offset = head;
+    uint32_t count  = 0;
+    file            = fopen(_queue_path, "rb");
+    if (file != nullptr) {
+        RecordHeader_t header;
+        while (fseek(file, offset, SEEK_SET) == 0 && fread(&header, sizeof(header), 1, file) == 1 &&
+               header.magic == _record_magic && header.size <= size - offset - sizeof(header)) {
+            offset += sizeof(header) + header.size;
+            count++;
+        }
+        fclose(file);
+    }
+    if (offset < size) {
+        mclog::tagWarn(_tag, "queue cut at {} of {} bytes", offset, size);
+        truncate(_queue_path, offset);
+    }
+
+    queue.isOpen = true;
+    if (count == 0) {
+        queue_reset(queue);
+        return true;
+    }
+    queue.head   = head;
+    queue.tail   = offset;
+    queue.replay = head;
+    queue.count  = count;
+    mclog::tagInfo(_tag, "{} batches queued on the card", count);
+    return true;
+}
+
+// False if the card is gone or the file would grow past the limit, the batch is then lost
+static bool queue_append(OfflineQueue_t& queue, const std::string& payload, uint32_t limit)
+{
+    if (!queue_open(queue)) {
+        return false;
+    }
+    RecordHeader_t header = {_record_magic, (uint32_t)payload.size(), 0};
+    if (queue.tail + sizeof(header) + header.size > limit) {
+        return false;
+    }
+    header.crc = esp_rom_crc32_le(0, (const uint8_t*)payload.data(), payload.size());
+
+    FILE* file = fopen(_queue_path, "ab");
+    bool is_ok = file != nullptr && fwrite(&header, sizeof(header), 1, file) == 1 &&
+                 fwrite(payload.data(), payload.size(), 1, file) == 1 && fflush(file) == 0 && fsync(fileno(file)) == 0;
+    if (file != nullptr) {
+        fclose(file);
+    }
+    if (!is_ok) {
+        // Opened again from the file, so a half written record is cut off
+        queue.isOpen = false;
+        return false;
+    }
+    queue.tail += sizeof(header) + header.size;
+    queue.count++;
+    return true;
+}
+
+// The record at replay, a bad one drops it and everything after it
+static bool queue_read(OfflineQueue_t& queue, std::string& payload, uint32_t& recordEnd)
+{
+    FILE* file = fopen(_queue_path, "rb");
+    if (file == nullptr) {
+        queue.isOpen = false;
+        return false;
+    }
+    RecordHeader_t header;
+    bool is_ok = fseek(file, queue.replay, SEEK_SET) == 0 && fread(&header, sizeof(header), 1, file) == 1 &&
+                 header.magic == _record_magic && header.size <= queue.tail - queue.replay - sizeof(header);
+    if (is_ok) {
+        payload.resize(header.size);
+        is_ok = fread(payload.data(), header.size, 1, file) == 1 &&
+                esp_rom_crc32_le(0, (const uint8_t*)payload.data(), header.size) == header.crc;
+    }
+    fclose(file);
+
+    if (!is_ok) {
+        mclog::tagWarn(_tag, "bad record at {}, {} batches dropped", queue.replay, queue.count);
+        update_stats([&](hal::HalBase::MqttStats_t& stats) { stats.dropped += queue.count; });
+        queue_reset(queue);
+        return false;
+    }
+    recordEnd = queue.replay + sizeof(header) + header.size;
+    return true;
+}
+
+static void queue_ack(OfflineQueue_t& queue, uint32_t recordEnd)
+{
+    queue.head = recordEnd;
+    queue.count--;
+    if (queue.head >= queue.tail) {
+        queue_reset(queue);
+        return;
+    }
+    FILE* file = fopen(_head_path, "wb");
+    if (file != nullptr) {
+        fwrite(&queue.head, sizeof(queue.head), 1, file);
+        fclose(file);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Batch                                   */
+/* -------------------------------------------------------------------------- */
+static void batch_reset(Batch_t& batch)
+{
+    int64_t now_ms      = unix_time_ms();
+    batch.startUnixMs   = now_ms >= _min_unix_ms ? now_ms : 0;
+    batch.startUptimeMs = GetHAL()->millis();
+    batch.count         = 0;
+    for (auto& column : batch.columns) {
+        column.clear();
+    }
+}
+
+// One column per metric instead of one object per sample, the names go out once per batch
+static std::string batch_to_json(const Batch_t& batch, uint32_t sampleIntervalMs)
+{
+    std::string json = fmt::format("{{\"t\":{},\"up\":{},\"dt\":{},\"n\":{}", batch.startUnixMs, batch.startUptimeMs,
+                                   sampleIntervalMs, batch.count);
+    for (int i = 0; i < COLUMN_NUM; i++) {
+        json += fmt::format(",\"{}\":[", _column_names[i]);
+        for (size_t j = 0; j < batch.columns[i].size(); j++) {
+            float value = batch.columns[i][j];
+            if (j > 0) {
+                json += ',';
+            }
+            // A sample the sensor had no new reading for
+            json += std::isnan(value) ? "null" : fmt::format("{:.4g}", value);
+        }
+        json += ']';
+    }
+    json += '}';
+    return json;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Task                                    */
+/* -------------------------------------------------------------------------- */
+void HalEsp32::mqtt_task(void* param)
+{
+    static_cast<HalEsp32*>(param)->mqtt_loop();
+
+    xSemaphoreGive(_mqtt_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+void HalEsp32::mqtt_loop()
+{
+    const auto& config    = _mqtt_data.config;
+    auto client           = _mqtt_data.client;
+    uint32_t sample_ms    = std::max<uint32_t>(config.sampleIntervalMs, 100);
+    uint32_t limit        = config.offlineQueueKb * 1024;
+    size_t max_in_flight  = std::max<uint8_t>(config.maxInFlight, 1);
+    uint32_t next_sample  = millis() + sample_ms;
+    uint32_t power_cursor = powerMonitorHistory.count();
+    uint32_t imu_cursor   = imuHistory.count();
+    uint8_t scale         = 1;
+    uint32_t rtt_ms       = 0;
+    bool is_connected     = false;
+    bool is_radio_awake   = false;
+    uint32_t last_send_ms = 0;
+    std::vector<InFlight_t> in_flight;
+    OfflineQueue_t queue;
+    Batch_t batch;
+    batch_reset(batch);
+
+    // The radio stays awake from a send until the window is empty, in between the station sleeps
+    auto publish = [&](const std::string& payload) {
+        if (!is_radio_awake) {
+            claimRadioLevel("mqtt", RADIO_LEVEL_AWAKE);
+            is_radio_awake = true;
+        }
+        last_send_ms = millis();
+        return esp_mqtt_client_enqueue(client, config.topic.c_str(), payload.data(), payload.size(), config.qos, 0,
+                                       true);
+    };
+    auto to_queue = [&](const std::string& payload) {
+        if (queue_append(queue, payload, limit)) {
+            return;
+        }
+        update_stats([](MqttStats_t& stats) { stats.dropped++; });
+    };
+    // Straight out while the window has room and nothing older waits on the card, which keeps the order
+    auto submit = [&](const std::string& payload) {
+        int msg_id = -1;
+        if (is_connected && in_flight.size() < max_in_flight && queue.count == 0) {
+            msg_id = publish(payload);
+        }
+        if (msg_id < 0) {
+            to_queue(payload);
+        } else if (config.qos == 0) {
+            update_stats([](MqttStats_t& stats) { stats.acked++; });
+        } else {
+            InFlight_t entry;
+            entry.msgId   = msg_id;
+            entry.sentMs  = millis();
+            entry.payload = payload;
+            in_flight.push_back(std::move(entry));
+        }
+    };
+    auto on_lost = [&](const InFlight_t& entry) {
+        if (entry.isReplay) {
+            queue.replay = queue.head;
+        } else {
+            to_queue(entry.payload);
+        }
+    };
+
+    while (_mqtt_data.isRunning) {
+        int32_t wait_ms = std::max<int32_t>((int32_t)(next_sample - millis()), 0);
+        MqttEvent_t event;
+        if (xQueueReceive(_mqtt_data.events, &event, pdMS_TO_TICKS(wait_ms)) == pdTRUE) {
+            if (event.type == MQTT_EVT_CONNECTED || event.type == MQTT_EVT_DISCONNECTED) {
+                // The client keeps what is in flight and sends it again after a reconnect
+                is_connected = event.type == MQTT_EVT_CONNECTED;
+                mclog::tagInfo(_tag, "{}", is_connected ? "connected" : "disconnected");
+            } else if (event.type == MQTT_EVT_ACKED || event.type == MQTT_EVT_DELETED) {
+                auto it = std::find_if(in_flight.begin(), in_flight.end(),
+                                       [&](const InFlight_t& entry) { return entry.msgId == event.msgId; });
+                if (it != in_flight.end()) {
+                    if (event.type == MQTT_EVT_DELETED) {
+                        on_lost(*it);
+                    } else {
+                        uint32_t sample = millis() - it->sentMs;
+                        rtt_ms          = rtt_ms == 0 ? sample : (rtt_ms * 3 + sample) / 4;
+                        if (it->isReplay) {
+                            queue_ack(queue, it->recordEnd);
+                        }
+                        update_stats([](MqttStats_t& stats) { stats.acked++; });
+                    }
+                    in_flight.erase(it);
+                }
+            }
+        }
+        if (!_mqtt_data.isRunning) {
+            break;
+        }
+
+        uint32_t now = millis();
+        for (size_t i = 0; i < in_flight.size();) {
+            if (now - in_flight[i].sentMs >= _ack_timeout_ms) {
+                on_lost(in_flight[i]);
+                in_flight.erase(in_flight.begin() + i);
+                continue;
+            }
+            i++;
+        }
+
+        if ((int32_t)(now - next_sample) >= 0) {
+            // A stall skips samples rather than taking several in a row
+            bool is_behind = (int32_t)(now - next_sample) >= (int32_t)sample_ms;
+            next_sample    = is_behind ? now + sample_ms : next_sample + sample_ms;
+
+            float sums[COLUMN_NUM] = {0};
+            uint32_t pm_count      = 0;
+            uint32_t imu_count     = 0;
+            PMData_t pm[_history_batch];
+            size_t size;
+            while ((size = powerMonitorHistory.read(power_cursor, pm, _history_batch)) > 0) {
+                for (size_t i = 0; i < size; i++) {
+                    sums[COLUMN_VOLTAGE] += pm[i].busVoltage;
+                    sums[COLUMN_CURRENT] += pm[i].shuntCurrent;
+                    sums[COLUMN_POWER] += pm[i].busPower;
+                }
+                pm_count += size;
+            }
+            IMUData_t imu[_history_batch];
+            while ((size = imuHistory.read(imu_cursor, imu, _history_batch)) > 0) {
+                for (size_t i = 0; i < size; i++) {
+                    sums[COLUMN_ACCEL] +=
+                        std::sqrt(imu[i].accelX * imu[i].accelX + imu[i].accelY * imu[i].accelY +
+                                  imu[i].accelZ * imu[i].accelZ);
+                }
+                imu_count += size;
+            }
+            ThermalStatus_t thermal;
+            bool has_thermal = thermalSnapshot.read(thermal);
+
+            for (int i = COLUMN_VOLTAGE; i <= COLUMN_POWER; i++) {
+                batch.columns[i].push_back(pm_count > 0 ? sums[i] / pm_count : NAN);
+            }
+            batch.columns[COLUMN_ACCEL].push_back(imu_count > 0 ? sums[COLUMN_ACCEL] / imu_count : NAN);
+            batch.columns[COLUMN_TEMP].push_back(has_thermal ? thermal.tempC : NAN);
+            batch.count++;
+
+            if (batch.count * sample_ms >= config.batchIntervalMs * scale) {
+                // A full window or slow acks make the next batches longer, an idle link brings them back
+                if (is_connected) {
+                    bool is_congested = in_flight.size() >= max_in_flight || rtt_ms > _congested_rtt_ms;
+                    if (is_congested && scale < _max_batch_scale) {
+                        scale *= 2;
+                    } else if (!is_congested && in_flight.empty() && scale > 1) {
+                        scale /= 2;
+                    }
+                }
+                submit(batch_to_json(batch, sample_ms));
+                batch_reset(batch);
+                update_stats([&](MqttStats_t& stats) {
+                    stats.batches++;
+                    stats.batchIntervalMs = config.batchIntervalMs * scale;
+                });
+            }
+        }
+
+        // Queued batches go one at a time, behind the live ones in the window
+        bool is_replaying = std::any_of(in_flight.begin(), in_flight.end(),
+                                        [](const InFlight_t& entry) { return entry.isReplay; });
+        if (is_connected && !is_replaying && in_flight.size() < max_in_flight && queue.isOpen &&
+            queue.replay < queue.tail) {
+            InFlight_t entry;
+            if (queue_read(queue, entry.payload, entry.recordEnd)) {
+                int msg_id = publish(entry.payload);
+                if (msg_id >= 0) {
+                    entry.msgId    = msg_id;
+                    entry.sentMs   = millis();
+                    entry.isReplay = true;
+                    entry.payload.clear();
+                    queue.replay = entry.recordEnd;
+                    if (config.qos == 0) {
+                        queue_ack(queue, entry.recordEnd);
+                    } else {
+                        in_flight.push_back(std::move(entry));
+                    }
+                    update_stats([](MqttStats_t& stats) { stats.replayed++; });
+                }
+            }
+        }
+        // The queue is read again once a card is back
+        if (!queue.isOpen && queue_open(queue) && queue.count > 0) {
+            mclog::tagInfo(_tag, "replaying {} batches", queue.count);
+        }
+
+        if (is_radio_awake && in_flight.empty() && millis() - last_send_ms >= _radio_hold_ms) {
+            releaseRadioLevel("mqtt");
+            is_radio_awake = false;
+        }
+
+        update_stats([&](MqttStats_t& stats) {
+            stats.isConnected = is_connected;
+            stats.queued      = queue.count;
+            stats.ackRttMs    = rtt_ms;
+        });
+    }
+    releaseRadioLevel("mqtt");
+
+    // Nothing that was made is lost, the batch in progress and the unacknowledged ones wait on the card
+    if (batch.count > 0) {
+        to_queue(batch_to_json(batch, sample_ms));
+    }
+    for (const auto& entry : in_flight) {
+        if (!entry.isReplay) {
+            to_queue(entry.payload);
+        }
+    }
+    update_stats([&](MqttStats_t& stats) {
+        stats.isConnected = false;
+        stats.queued      = queue.count;
+    });
+}
+
+bool HalEsp32::startMqtt(const MqttConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_mqtt_data.mutex);
+
+    if (_mqtt_data.isRunning) {
+        return true;
+    }
+
+    _mqtt_data.config = config;
+    auto& mqtt_config = _mqtt_data.config;
+    if (mqtt_config.brokerUri.empty()) {
+        mqtt_config.brokerUri = CONFIG_HAL_MQTT_BROKER_URI;
+    }
+    if (mqtt_config.brokerUri.empty()) {
+        mclog::tagInfo(_tag, "no broker set, not started");
+        return false;
+    }
+    if (mqtt_config.clientId.empty()) {
+        uint8_t mac[6] = {0};
+        esp_efuse_mac_get_default(mac);
+        mqtt_config.clientId = fmt::format("m5tab5-{:02x}{:02x}{:02x}", mac[3], mac[4], mac[5]);
+    }
+    mqtt_config.qos = std::min<uint8_t>(mqtt_config.qos, 1);
+
+    // Batches are averaged from its histories
+    startSensorService(SensorServiceConfig_t());
+
+    // The client copies the strings
+    esp_mqtt_client_config_t client_config = {};
+
+    client_config.broker.address.uri                  = mqtt_config.brokerUri.c_str();
+    client_config.credentials.client_id               = mqtt_config.clientId.c_str();
+    client_config.credentials.username                = mqtt_config.username.c_str();
+    client_config.credentials.authentication.password = mqtt_config.password.c_str();
+    client_config.session.keepalive                   = 30;
+    _mqtt_data.client                                 = esp_mqtt_client_init(&client_config);
+    if (_mqtt_data.client == nullptr) {
+        mclog::tagError(_tag, "client init failed");
+        return false;
+    }
+
+    if (_mqtt_data.events == nullptr) {
+        _mqtt_data.events  = xQueueCreate(_event_queue_len, sizeof(MqttEvent_t));
+        _mqtt_data.exitSem = xSemaphoreCreateBinary();
+    }
+    xQueueReset(_mqtt_data.events);
+    {
+        std::lock_guard<std::mutex> stats_lock(_mqtt_data.statsMutex);
+        _mqtt_data.stats                 = MqttStats_t();
+        _mqtt_data.stats.batchIntervalMs = mqtt_config.batchIntervalMs;
+    }
+    esp_mqtt_client_register_event(_mqtt_data.client, MQTT_EVENT_ANY, on_mqtt_event, nullptr);
+
+    _mqtt_data.isRunning = true;
+    if (xTaskCreate(mqtt_task, "mqtt_pub", 6144, this, 2, &_mqtt_data.task) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _mqtt_data.isRunning = false;
+        esp_mqtt_client_destroy(_mqtt_data.client);
+        _mqtt_data.client = nullptr;
+        return false;
+    }
+    esp_mqtt_client_start(_mqtt_data.client);
+
+    mclog::tagInfo(_tag, "start, {} as {}, {} ms batches of {} ms samples, qos {}", mqtt_config.brokerUri,
+                   mqtt_config.clientId, mqtt_config.batchIntervalMs, mqtt_config.sampleIntervalMs, mqtt_config.qos);
+    return true;
+}
+
+void HalEsp32::stopMqtt()
+{
+    std::lock_guard<std::mutex> lock(_mqtt_data.mutex);
+
+    if (!_mqtt_data.isRunning) {
+        return;
+    }
+
+    // The task queues what is not acknowledged on its way out, then the client can go
+    _mqtt_data.isRunning = false;
+    MqttEvent_t wake     = {MQTT_EVT_WAKE, 0};
+    xQueueSend(_mqtt_data.events, &wake, portMAX_DELAY);
+    xSemaphoreTake(_mqtt_data.exitSem, portMAX_DELAY);
+    _mqtt_data.task = nullptr;
+    esp_mqtt_client_destroy(_mqtt_data.client);
+    _mqtt_data.client = nullptr;
+    mclog::tagInfo(_tag, "stop");
+}
+
+hal::HalBase::MqttStats_t HalEsp32::getMqttStats()
+{
+    std::lock_guard<std::mutex> lock(_mqtt_data.statsMutex);
+    auto stats      = _mqtt_data.stats;
+    stats.isRunning = _mqtt_data.isRunning;
+    return stats;
+}
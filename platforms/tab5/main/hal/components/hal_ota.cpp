@@ -0,0 +1,472 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <shared/shared.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <ctype.h>
+#include <string.h>
+#include <esp_app_desc.h>
+#include <esp_heap_caps.h>
+#include <esp_http_server.h>
+#include <esp_ota_ops.h>
+#include <esp_random.h>
+#include <esp_system.h>
+#include <mbedtls/sha256.h>
+#include <nvs.h>
+#include <sdkconfig.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+
+static const std::string _tag = "ota";
+
+// One buffer fills from the socket while the writer task puts the other into flash
+static constexpr size_t _buffer_size = 16 * 1024;
+static constexpr int _buffer_count   = 2;
+// Receive timeouts in a row before a stalled client ends the update
+static constexpr int _recv_retries = 10;
+// Time for the response to reach the client before the restart
+static constexpr uint32_t _restart_delay_ms = 500;
+// Per device, made on the first start and kept in NVS, an upload has to carry it in X-OTA-Token
+static constexpr size_t _token_size = 16;
+// Without signed apps esp_ota_end() takes any well formed image, so such a build refuses updates. Signing is opt in
+// with sdkconfig.defaults.signed, see the README
+#if CONFIG_SECURE_SIGNED_ON_UPDATE
+static constexpr bool _is_signed_update = true;
+#else
+static constexpr bool _is_signed_update = false;
+#endif
+
+// A zero size chunk ends the writer task
+struct OtaChunk_t {
+    uint8_t* data = nullptr;
+    size_t size   = 0;
+};
+
+struct OtaData_t {
+    std::mutex mutex;
+    hal::HalBase::OtaStatus_t status;
+    // Taken by the upload, a second one is refused while it runs
+    std::atomic<bool> isBusy{false};
+    // Owned by the upload in progress
+    uint8_t* buffers[_buffer_count] = {};
+    QueueHandle_t freeQueue         = nullptr;
+    QueueHandle_t fullQueue         = nullptr;
+    SemaphoreHandle_t doneSem       = nullptr;
+    esp_ota_handle_t handle         = 0;
+    mbedtls_sha256_context sha;
+    // Set by the writer task, read by the handler once doneSem is given
+    esp_err_t writeError = ESP_OK;
+    // Without one every upload is refused
+    uint8_t token[_token_size] = {};
+    bool hasToken              = false;
+};
+static OtaData_t _ota_data;
+
+static void set_state(hal::HalBase::OtaState_t state, const std::string& error = "")
+{
+    {
+        std::lock_guard<std::mutex> lock(_ota_data.mutex);
+        _ota_data.status.state = state;
+        if (state == hal::HalBase::OTA_STATE_RECEIVING) {
+            _ota_data.status.error.clear();
+        } else if (!error.empty()) {
+            _ota_data.status.error = error;
+        }
+    }
+    if (!error.empty()) {
+        mclog::tagError(_tag, "{}", error);
+    }
+    GetEventBus().publish({shared_data::EVENT_TOPIC_OTA, 0, state});
+}
+
+// Two hex digits per byte, either case, and nothing after them
+static bool parse_hex(const char* hex, uint8_t* data, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        char high = hex[i * 2];
+        char low  = high ? hex[i * 2 + 1] : 0;
+        if (!isxdigit((unsigned char)high) || !isxdigit((unsigned char)low)) {
+            return false;
+        }
+        auto value = [](char c) { return isdigit((unsigned char)c) ? c - '0' : tolower((unsigned char)c) - 'a' + 10; };
+        data[i]    = value(high) << 4 | value(low);
+    }
+    return hex[size * 2] == '\0';
+}
+
+static std::string to_hex(const uint8_t* data, size_t size)
+{
+    static const char* digits = "0123456789abcdef";
+    std::string hex;
+    for (size_t i = 0; i < size; i++) {
+        hex += digits[data[i] >> 4];
+        hex += digits[data[i] & 0x0F];
+    }
+    return hex;
+}
+
+// NVS is up once the web server starts. So is the Wi-Fi, which makes esp_fill_random() a true random source
+static bool load_token(uint8_t* token)
+{
+    nvs_handle_t handle;
+    esp_err_t ret = nvs_open("ota", NVS_READWRITE, &handle);
+    if (ret == ESP_OK) {
+        size_t size = _token_size;
+        ret         = nvs_get_blob(handle, "token", token, &size);
+        if (ret == ESP_ERR_NVS_NOT_FOUND) {
+            esp_fill_random(token, _token_size);
+            ret = nvs_set_blob(handle, "token", token, _token_size);
+            if (ret == ESP_OK) {
+                ret = nvs_commit(handle);
+            }
+        } else if (ret == ESP_OK && size != _token_size) {
+            ret = ESP_ERR_INVALID_SIZE;
+        }
+        nvs_close(handle);
+    }
+    if (ret != ESP_OK) {
+        mclog::tagError(_tag, "token unavailable, updates are refused: {}", esp_err_to_name(ret));
+        return false;
+    }
+    return true;
+}
+
+// The same time for every wrong byte, so the replies do not give the token away a byte at a time
+static bool check_token(httpd_req_t* req)
+{
+    char header[_token_size * 2 + 8];
+    uint8_t token[_token_size];
+    if (!_ota_data.hasToken || httpd_req_get_hdr_value_str(req, "X-OTA-Token", header, sizeof(header)) != ESP_OK ||
+        !parse_hex(header, token, sizeof(token))) {
+        return false;
+    }
+    uint8_t diff = 0;
+    for (size_t i = 0; i < _token_size; i++) {
+        diff |= token[i] ^ _ota_data.token[i];
+    }
+    return diff == 0;
+}
+
+// Implemented in hal_wifi.cpp
+bool web_request_on_ap(httpd_req_t* req);
+
+// Below the LVGL task, the flash writes only take the time the UI leaves. With XIP from PSRAM the caches stay on during
+// an erase, so the other tasks keep running while it waits on the flash
+static void ota_writer_task(void* param)
+{
+    OtaChunk_t chunk;
+    while (xQueueReceive(_ota_data.fullQueue, &chunk, portMAX_DELAY) == pdTRUE && chunk.size > 0) {
+        if (_ota_data.writeError == ESP_OK) {
+            mbedtls_sha256_update(&_ota_data.sha, chunk.data, chunk.size);
+            _ota_data.writeError = esp_ota_write(_ota_data.handle, chunk.data, chunk.size);
+        }
+        xQueueSend(_ota_data.freeQueue, &chunk.data, portMAX_DELAY);
+    }
+
+    xSemaphoreGive(_ota_data.doneSem);
+    vTaskDelete(NULL);
+}
+
+// Socket to buffers until the body is in or something fails, the writer task is done when this returns
+static bool ota_receive(httpd_req_t* req, std::string& error)
+{
+    size_t remaining = req->content_len;
+    int retries      = 0;
+    bool is_ok       = true;
+
+    while (remaining > 0 && is_ok) {
+        OtaChunk_t chunk;
+        xQueueReceive(_ota_data.freeQueue, &chunk.data, portMAX_DELAY);
+        // Checked once the buffer it wrote is back, a failed write stops the upload within one chunk
+        if (_ota_data.writeError != ESP_OK) {
+            error = fmt::format("flash write failed: {}", esp_err_to_name(_ota_data.writeError));
+            is_ok = false;
+            break;
+        }
+
+        // Full buffers only, esp_ota_write() is cheaper per call with fewer of them
+        size_t wanted = std::min(remaining, _buffer_size);
+        while (chunk.size < wanted) {
+            int ret = httpd_req_recv(req, (char*)chunk.data + chunk.size, wanted - chunk.size);
+            if (ret == HTTPD_SOCK_ERR_TIMEOUT && ++retries < _recv_retries) {
+                continue;
+            }
+            if (ret <= 0) {
+                error = "connection lost";
+                is_ok = false;
+                break;
+            }
+            chunk.size += ret;
+            retries = 0;
+        }
+        remaining -= chunk.size;
+
+        if (is_ok) {
+            xQueueSend(_ota_data.fullQueue, &chunk, portMAX_DELAY);
+        } else {
+            xQueueSend(_ota_data.freeQueue, &chunk.data, portMAX_DELAY);
+        }
+        std::lock_guard<std::mutex> lock(_ota_data.mutex);
+        _ota_data.status.received = req->content_len - remaining;
+    }
+
+    OtaChunk_t end;
+    xQueueSend(_ota_data.fullQueue, &end, portMAX_DELAY);
+    xSemaphoreTake(_ota_data.doneSem, portMAX_DELAY);
+    if (is_ok && _ota_data.writeError != ESP_OK) {
+        error = fmt::format("flash write failed: {}", esp_err_to_name(_ota_data.writeError));
+        is_ok = false;
+    }
+    return is_ok;
+}
+
+static bool ota_alloc()
+{
+    for (auto& buffer : _ota_data.buffers) {
+        buffer = (uint8_t*)heap_caps_malloc(_buffer_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (buffer == nullptr) {
+            return false;
+        }
+    }
+    if (_ota_data.freeQueue == nullptr) {
+        _ota_data.freeQueue = xQueueCreate(_buffer_count, sizeof(uint8_t*));
+        _ota_data.fullQueue = xQueueCreate(_buffer_count + 1, sizeof(OtaChunk_t));
+        _ota_data.doneSem   = xSemaphoreCreateBinary();
+    }
+    xQueueReset(_ota_data.freeQueue);
+    xQueueReset(_ota_data.fullQueue);
+    for (auto buffer : _ota_data.buffers) {
+        xQueueSend(_ota_data.freeQueue, &buffer, 0);
+    }
+    return true;
+}
+
+static void ota_free()
+{
+    for (auto& buffer : _ota_data.buffers) {
+        heap_caps_free(buffer);
+        buffer = nullptr;
+    }
+}
+
+// Begin, stream, end and switch, the error says which step failed
+static bool ota_update(httpd_req_t* req, const uint8_t* expectedSha, std::string& error)
+{
+    const esp_partition_t* partition = esp_ota_get_next_update_partition(nullptr);
+    if (partition == nullptr) {
+        error = "no ota partition";
+        return false;
+    }
+    if (req->content_len > partition->size) {
+        error = fmt::format("image of {} bytes does not fit {} bytes", req->content_len, partition->size);
+        return false;
+    }
+    if (!ota_alloc()) {
+        ota_free();
+        error = "out of memory";
+        return false;
+    }
+
+    // Sectors are erased as the writes reach them, an erase of the whole partition up front stalls for seconds
+    esp_err_t ret = esp_ota_begin(partition, OTA_WITH_SEQUENTIAL_WRITES, &_ota_data.handle);
+    if (ret != ESP_OK) {
+        ota_free();
+        error = fmt::format("begin failed: {}", esp_err_to_name(ret));
+        return false;
+    }
+    mclog::tagInfo(_tag, "receiving {} bytes into {}", req->content_len, partition->label);
+    {
+        std::lock_guard<std::mutex> lock(_ota_data.mutex);
+        _ota_data.status.received = 0;
+        _ota_data.status.total    = req->content_len;
+    }
+    set_state(hal::HalBase::OTA_STATE_RECEIVING);
+
+    mbedtls_sha256_init(&_ota_data.sha);
+    mbedtls_sha256_starts(&_ota_data.sha, 0);
+    _ota_data.writeError = ESP_OK;
+    bool is_ok           = xTaskCreate(ota_writer_task, "ota_writer", 4096, nullptr, 2, nullptr) == pdPASS;
+    if (!is_ok) {
+        error = "create task failed";
+    } else {
+        is_ok = ota_receive(req, error);
+    }
+    uint8_t digest[32];
+    mbedtls_sha256_finish(&_ota_data.sha, digest);
+    mbedtls_sha256_free(&_ota_data.sha);
+    ota_free();
+    if (!is_ok) {
+        esp_ota_abort(_ota_data.handle);
+        return false;
+    }
+
+    set_state(hal::HalBase::OTA_STATE_VERIFYING);
+    if (expectedSha && memcmp(digest, expectedSha, sizeof(digest)) != 0) {
+        esp_ota_abort(_ota_data.handle);
+        error = fmt::format("sha256 mismatch, received {}", to_hex(digest, sizeof(digest)));
+        return false;
+    }
+    // Checks the image header, the chip, the hash the build appends to the image and its signature against the key
+    // of the running image
+    ret = esp_ota_end(_ota_data.handle);
+    if (ret != ESP_OK) {
+        error = fmt::format("image invalid: {}", esp_err_to_name(ret));
+        return false;
+    }
+    ret = esp_ota_set_boot_partition(partition);
+    if (ret != ESP_OK) {
+        error = fmt::format("set boot partition failed: {}", esp_err_to_name(ret));
+        return false;
+    }
+    mclog::tagInfo(_tag, "{} written, sha256 {}", partition->label, to_hex(digest, sizeof(digest)));
+    return true;
+}
+
+static esp_err_t ota_post_handler(httpd_req_t* req)
+{
+    if (req->content_len == 0) {
+        httpd_resp_set_status(req, "411 Length Required");
+        return httpd_resp_sendstr(req, "content length required\n");
+    }
+    if (!_is_signed_update) {
+        httpd_resp_send_err(req, HTTPD_403_FORBIDDEN, "signed updates are off in this build");
+        return ESP_FAIL;
+    }
+    if (web_request_on_ap(req)) {
+        httpd_resp_send_err(req, HTTPD_403_FORBIDDEN, "updates are refused on the open access point");
+        return ESP_FAIL;
+    }
+    if (!check_token(req)) {
+        httpd_resp_send_err(req, HTTPD_401_UNAUTHORIZED, "X-OTA-Token missing or wrong");
+        return ESP_FAIL;
+    }
+    if (_ota_data.isBusy.exchange(true)) {
+        httpd_resp_set_status(req, "409 Conflict");
+        return httpd_resp_sendstr(req, "update in progress\n");
+    }
+
+    uint8_t expected_sha[32];
+    bool has_sha = false;
+    char header[72];
+    if (httpd_req_get_hdr_value_str(req, "X-Firmware-SHA256", header, sizeof(header)) == ESP_OK) {
+        if (!parse_hex(header, expected_sha, sizeof(expected_sha))) {
+            _ota_data.isBusy = false;
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "X-Firmware-SHA256 must be 64 hex digits");
+            return ESP_FAIL;
+        }
+        has_sha = true;
+    }
+
+    // Light sleep would stall the socket and the writes
+    GetHAL()->claimPerfLevel("ota", hal::HalBase::PERF_LEVEL_AWAKE);
+    GetHAL()->claimRadioLevel("ota", hal::HalBase::RADIO_LEVEL_AWAKE);
+    std::string error;
+    bool is_ok = ota_update(req, has_sha ? expected_sha : nullptr, error);
+    GetHAL()->releaseRadioLevel("ota");
+    GetHAL()->releasePerfLevel("ota");
+
+    if (!is_ok) {
+        set_state(hal::HalBase::OTA_STATE_FAILED, error);
+        _ota_data.isBusy = false;
+        httpd_resp_set_status(req, HTTPD_500);
+        httpd_resp_sendstr(req, (error + "\n").c_str());
+        return ESP_OK;
+    }
+
+    set_state(hal::HalBase::OTA_STATE_DONE);
+    httpd_resp_sendstr(req, "ok, restarting\n");
+    mclog::tagInfo(_tag, "restarting into the new image");
+    vTaskDelay(pdMS_TO_TICKS(_restart_delay_ms));
+    esp_restart();
+    return ESP_OK;
+}
+
+static esp_err_t ota_get_handler(httpd_req_t* req)
+{
+    auto status = GetHAL()->getOtaStatus();
+
+    static const char* state_names[] = {"idle", "receiving", "verifying", "done", "failed"};
+    std::string json = fmt::format(
+        "{{\"state\":\"{}\",\"received\":{},\"total\":{},\"error\":\"{}\",\"version\":\"{}\",\"partition\":\"{}\","
+        "\"canRollback\":{}}}",
+        state_names[status.state], status.received, status.total, status.error, status.runningVersion,
+        status.runningPartition, status.canRollback ? "true" : "false");
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    return httpd_resp_send(req, json.data(), json.size());
+}
+
+// Called by start_webserver() in hal_wifi.cpp
+void ota_register_handlers(httpd_handle_t server)
+{
+    _ota_data.hasToken = load_token(_ota_data.token);
+    if (_ota_data.hasToken) {
+        mclog::tagInfo(_tag, "token {}", to_hex(_ota_data.token, _token_size));
+    }
+
+    static httpd_uri_t post_uri = {};
+    post_uri.uri                = "/api/ota";
+    post_uri.method             = HTTP_POST;
+    post_uri.handler            = ota_post_handler;
+    httpd_register_uri_handler(server, &post_uri);
+
+    static httpd_uri_t get_uri = {};
+    get_uri.uri                = "/api/ota";
+    get_uri.method             = HTTP_GET;
+    get_uri.handler            = ota_get_handler;
+    httpd_register_uri_handler(server, &get_uri);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                     HAL                                    */
+/* -------------------------------------------------------------------------- */
+void HalEsp32::ota_confirm_boot()
+{
+    // With rollback on, a fresh image boots once as pending verify. Boot done is the self test, a reset before this
+    // leaves it unconfirmed and the bootloader goes back to the previous image
+    const esp_partition_t* running = esp_ota_get_running_partition();
+    esp_ota_img_states_t state;
+    if (esp_ota_get_state_partition(running, &state) != ESP_OK || state != ESP_OTA_IMG_PENDING_VERIFY) {
+        return;
+    }
+    esp_err_t ret = esp_ota_mark_app_valid_cancel_rollback();
+    if (ret != ESP_OK) {
+        mclog::tagError(_tag, "confirm {} failed: {}", running->label, esp_err_to_name(ret));
+        return;
+    }
+    mclog::tagInfo(_tag, "{} confirmed", running->label);
+}
+
+HalEsp32::OtaStatus_t HalEsp32::getOtaStatus()
+{
+    OtaStatus_t status;
+    {
+        std::lock_guard<std::mutex> lock(_ota_data.mutex);
+        status = _ota_data.status;
+    }
+    status.runningVersion   = esp_app_get_description()->version;
+    status.runningPartition = esp_ota_get_running_partition()->label;
+    status.canRollback      = esp_ota_check_rollback_is_possible();
+    return status;
+}
+
+bool HalEsp32::rollbackFirmware()
+{
+    if (_ota_data.isBusy || !esp_ota_check_rollback_is_possible()) {
+        return false;
+    }
+    mclog::tagInfo(_tag, "rolling back from {}", esp_ota_get_running_partition()->label);
+    // Only returns if it failed
+    esp_err_t ret = esp_ota_mark_app_invalid_rollback_and_reboot();
+    mclog::tagError(_tag, "rollback failed: {}", esp_err_to_name(ret));
+    return false;
+}
@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <mutex>
+#include <set>
+#include <string>
+#include <bsp/m5stack_tab5.h>
+#include <esp_timer.h>
+
+static const std::string _tag = "peripherals";
+
+static const char* _peripheral_names[hal::HalBase::PERIPHERAL_NUM] = {"rs485", "usb_host", "camera_osc"};
+
+struct PeripheralData_t {
+    std::mutex mutex;
+    std::set<std::string> owners[hal::HalBase::PERIPHERAL_NUM];
+    bool isUp[hal::HalBase::PERIPHERAL_NUM] = {false};
+};
+static PeripheralData_t _peripheral_data;
+
+bool HalEsp32::usb_host_power_up()
+{
+    // USBホスト機能を初期化します。電源モードと自動ファームウェアロードを設定します。
+    if (bsp_usb_host_start(BSP_USB_HOST_POWER_MODE_USB_DEV, true) != ESP_OK) {
+        return false;
+    }
+    // Each class driver has its own event queue and task, HID above the others
+    hid_init();
+    usb_msc_init();
+    usb_cdc_init();
+    return true;
+}
+
+// Lock _peripheral_data.mutex before calling
+bool HalEsp32::peripheral_power_up(Peripheral_t peripheral)
+{
+    switch (peripheral) {
+        case PERIPHERAL_RS485:
+            return rs485_power_up();
+        case PERIPHERAL_USB_HOST:
+            return usb_host_power_up();
+        case PERIPHERAL_CAMERA_OSC:
+            return bsp_cam_osc_init() == ESP_OK;
+        default:
+            return false;
+    }
+}
+
+// Lock _peripheral_data.mutex before calling, returns false for a peripheral that stays up
+bool HalEsp32::peripheral_power_down(Peripheral_t peripheral)
+{
+    switch (peripheral) {
+        case PERIPHERAL_RS485:
+            rs485_power_down();
+            return true;
+        case PERIPHERAL_CAMERA_OSC:
+            bsp_cam_osc_deinit();
+            return true;
+        default:
+            // The HID task has no way to stop, the host is left running
+            return false;
+    }
+}
+
+bool HalEsp32::claimPeripheral(Peripheral_t peripheral, const std::string& owner)
+{
+    if (peripheral >= PERIPHERAL_NUM) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_peripheral_data.mutex);
+    if (!_peripheral_data.isUp[peripheral]) {
+        int64_t start_us = esp_timer_get_time();
+        if (!peripheral_power_up(peripheral)) {
+            mclog::tagError(_tag, "{} failed to come up for {}", _peripheral_names[peripheral], owner);
+            return false;
+        }
+        _peripheral_data.isUp[peripheral] = true;
+        mclog::tagInfo(_tag, "{} up for {} in {} ms", _peripheral_names[peripheral], owner,
+                       (esp_timer_get_time() - start_us) / 1000);
+    }
+    _peripheral_data.owners[peripheral].insert(owner);
+    return true;
+}
+
+void HalEsp32::releasePeripheral(Peripheral_t peripheral, const std::string& owner)
+{
+    if (peripheral >= PERIPHERAL_NUM) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_peripheral_data.mutex);
+    auto& owners = _peripheral_data.owners[peripheral];
+    if (owners.erase(owner) == 0 || !owners.empty() || !_peripheral_data.isUp[peripheral]) {
+        return;
+    }
+    if (peripheral_power_down(peripheral)) {
+        _peripheral_data.isUp[peripheral] = false;
+        mclog::tagInfo(_tag, "{} down", _peripheral_names[peripheral]);
+    }
+}
+
+bool HalEsp32::isPeripheralUp(Peripheral_t peripheral)
+{
+    if (peripheral >= PERIPHERAL_NUM) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_peripheral_data.mutex);
+    return _peripheral_data.isUp[peripheral];
+}
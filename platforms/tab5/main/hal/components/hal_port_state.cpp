@@ -0,0 +1,198 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <shared/shared.h>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <bsp/m5stack_tab5.h>
+#include <driver/gpio.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_attr.h>
+#include <esp_timer.h>
+
+static const std::string _tag = "port-state";
+
+// Without the expander INT line the detect inputs are read at this rate
+static constexpr uint32_t _poll_interval_ms = 200;
+// With INT the service still looks now and then, USB-A has no interrupt and an edge can be missed
+static constexpr uint32_t _idle_interval_ms = 500;
+// A change has to read the same for this long before it is reported, jack contacts bounce on insertion
+static constexpr uint32_t _debounce_ms = 50;
+// Both expanders are read in one bus turn, the stats go under the first one
+static constexpr uint8_t _pi4ioe_addr = 0x43;
+
+// Same order as shared_data::EventPort_t, the index goes out as the event id
+enum Port_t {
+    PORT_USB_C = 0,
+    PORT_USB_A,
+    PORT_HEADPHONE,
+    PORT_NUM,
+};
+static const char* _port_names[PORT_NUM] = {"usb_c", "usb_a", "headphone"};
+
+struct PortStateData_t {
+    TaskHandle_t task        = nullptr;
+    std::atomic<bool> hasIrq = false;
+    // Reported states, debounced
+    std::atomic<bool> states[PORT_NUM];
+};
+static PortStateData_t _port_state_data;
+
+#if CONFIG_BSP_IO_EXPANDER_INT_GPIO >= 0
+static void IRAM_ATTR port_state_isr(void* arg)
+{
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(_port_state_data.task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+#endif
+
+static bool read_ports(bool (&ports)[PORT_NUM])
+{
+    bool headphone = false;
+    bool usb_c     = false;
+    bool is_ok     = HalEsp32::i2cScheduler().run(I2cBusScheduler::PRIORITY_SENSOR, _pi4ioe_addr, [&]() {
+        return bsp_io_expander_read_detect(&headphone, &usb_c) == ESP_OK;
+    });
+    if (!is_ok) {
+        return false;
+    }
+    ports[PORT_USB_C]     = usb_c;
+    ports[PORT_USB_A]     = GetHAL()->usbADetect();
+    ports[PORT_HEADPHONE] = headphone;
+    return true;
+}
+
+void HalEsp32::port_state_task(void* param)
+{
+    static_cast<HalEsp32*>(param)->port_state_loop();
+    vTaskDelete(NULL);
+}
+
+void HalEsp32::port_state_loop()
+{
+    // The boot state is taken as is, nothing is reported for it
+    bool ports[PORT_NUM] = {false};
+    if (read_ports(ports)) {
+        for (int i = 0; i < PORT_NUM; i++) {
+            _port_state_data.states[i] = ports[i];
+        }
+    }
+
+    bool pending[PORT_NUM]    = {false};
+    bool has_pending          = false;
+    uint32_t pending_since_ms = 0;
+
+    while (true) {
+        uint32_t wait_ms = _port_state_data.hasIrq ? _idle_interval_ms : _poll_interval_ms;
+        if (has_pending) {
+            wait_ms = _debounce_ms;
+        }
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait_ms));
+
+        if (bsp_io_expander_has_pending()) {
+            // Setters called back to back land in the same tick and go out as one write per chip
+            vTaskDelay(1);
+            i2cScheduler().run(I2cBusScheduler::PRIORITY_SENSOR, _pi4ioe_addr, []() {
+                return bsp_io_expander_flush() == ESP_OK;
+            });
+        }
+
+        if (!read_ports(ports)) {
+            continue;
+        }
+
+        bool is_changed = false;
+        bool is_same    = has_pending;
+        for (int i = 0; i < PORT_NUM; i++) {
+            is_changed |= ports[i] != _port_state_data.states[i];
+            is_same &= ports[i] == pending[i];
+        }
+        uint32_t now_ms = esp_timer_get_time() / 1000;
+        if (!is_changed) {
+            // Bounced back before it settled
+            has_pending = false;
+            continue;
+        }
+        if (!is_same) {
+            std::copy(ports, ports + PORT_NUM, pending);
+            has_pending      = true;
+            pending_since_ms = now_ms;
+            continue;
+        }
+        if (now_ms - pending_since_ms < _debounce_ms) {
+            continue;
+        }
+
+        has_pending = false;
+        for (int i = 0; i < PORT_NUM; i++) {
+            if (ports[i] == _port_state_data.states[i]) {
+                continue;
+            }
+            _port_state_data.states[i] = ports[i];
+            mclog::tagInfo(_tag, "{} {}", _port_names[i], ports[i] ? "connected" : "disconnected");
+            GetEventBus().publish({shared_data::EVENT_TOPIC_PORT, static_cast<uint8_t>(i), ports[i] ? 1 : 0});
+        }
+    }
+}
+
+void HalEsp32::port_state_init()
+{
+    // The task comes first, the ISR notifies it
+    if (xTaskCreate(port_state_task, "port_state", 4096, this, 3, &_port_state_data.task) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        return;
+    }
+    // From here output changes are coalesced by the task
+    bsp_io_expander_set_deferred(true);
+
+#if CONFIG_BSP_IO_EXPANDER_INT_GPIO >= 0
+    gpio_config_t io_conf = {
+        .pin_bit_mask = 1ULL << BSP_IO_EXPANDER_INT,
+        .mode         = GPIO_MODE_INPUT,
+        .pull_up_en   = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type    = GPIO_INTR_NEGEDGE,
+    };
+    gpio_config(&io_conf);
+    // Other drivers may have installed the service already
+    esp_err_t ret = gpio_install_isr_service(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        mclog::tagError(_tag, "install isr service failed, polling instead");
+        return;
+    }
+    gpio_isr_handler_add((gpio_num_t)BSP_IO_EXPANDER_INT, port_state_isr, nullptr);
+    i2cScheduler().run(I2cBusScheduler::PRIORITY_SENSOR, _pi4ioe_addr, []() {
+        bsp_io_expander_enable_detect_irq();
+        return true;
+    });
+    _port_state_data.hasIrq = true;
+    xTaskNotifyGive(_port_state_data.task);
+    mclog::tagInfo(_tag, "watching expander interrupt on gpio {}", BSP_IO_EXPANDER_INT);
+#else
+    mclog::tagInfo(_tag, "no expander interrupt line, polling every {} ms", _poll_interval_ms);
+#endif
+}
+
+void HalEsp32::io_expander_commit()
+{
+    if (_port_state_data.task != nullptr) {
+        xTaskNotifyGive(_port_state_data.task);
+    }
+}
+
+bool HalEsp32::usbCDetect()
+{
+    return _port_state_data.states[PORT_USB_C];
+}
+
+bool HalEsp32::headPhoneDetect()
+{
+    return _port_state_data.states[PORT_HEADPHONE];
+}
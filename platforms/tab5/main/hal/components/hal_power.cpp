@@ -4,24 +4,288 @@
  * SPDX-License-Identifier: MIT
  */
 #include "hal/hal_esp32.h"
+#include <hal/spsc_ring.h>
 #include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <math.h>
 #include <driver/gpio.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_timer.h>
 #include <bsp/m5stack_tab5.h>
+#include <esp_lvgl_port.h>
 #include <esp_sleep.h>
 #include <esp_check.h>
 #include <esp_pm.h>
 
 static const std::string _tag = "power";
 
+static constexpr uint8_t _ina226_addr = 0x41;
+// Same as the shunt passed to calibrate() in init()
+static constexpr float _shunt_ohms = 0.005f;
+// Restored when sampling stops
+static constexpr ina226_averages_t _default_averages = INA226_AVERAGES_16;
+// About a second at the fastest rate
+static constexpr size_t _sample_ring_size = 512;
+
+struct PowerWindowAccum_t {
+    uint32_t samples  = 0;
+    int64_t startUs   = 0;
+    float minVoltage  = 0.0f;
+    float maxVoltage  = 0.0f;
+    float minCurrent  = 0.0f;
+    float maxCurrent  = 0.0f;
+    double sumVoltage = 0.0;
+    double sumCurrent = 0.0;
+    double sumPower   = 0.0;
+    double energyMwh  = 0.0;
+};
+
+struct PowerSamplingData_t {
+    std::mutex mutex;
+    std::atomic<bool> isRunning{false};
+    SemaphoreHandle_t exitSem = nullptr;
+    uint32_t conversionUs     = 0;
+    SpscRing<hal::HalBase::PowerSample_t> ring;
+    uint32_t droppedSamples = 0;
+    // Guards latest, the window and the total, the task holds it only to fold a sample in
+    std::mutex statsMutex;
+    hal::HalBase::PowerSample_t latest;
+    bool hasLatest = false;
+    PowerWindowAccum_t window;
+    double totalEnergyMwh = 0.0;
+};
+static PowerSamplingData_t _sampling_data;
+
+static ina226_averages_t to_ina226_averages(uint16_t averages)
+{
+    static const uint16_t counts[] = {1, 4, 16, 64, 128, 256, 512, 1024};
+    int index                      = 0;
+    while (index < 7 && counts[index] < averages) {
+        index++;
+    }
+    return (ina226_averages_t)index;
+}
+
+static void fold_power_sample(const hal::HalBase::PowerSample_t& sample, float dtSeconds)
+{
+    auto& window = _sampling_data.window;
+    if (window.samples == 0) {
+        window.minVoltage = window.maxVoltage = sample.busVoltage;
+        window.minCurrent = window.maxCurrent = sample.shuntCurrent;
+    }
+    window.samples++;
+    window.minVoltage = std::min(window.minVoltage, sample.busVoltage);
+    window.maxVoltage = std::max(window.maxVoltage, sample.busVoltage);
+    window.minCurrent = std::min(window.minCurrent, sample.shuntCurrent);
+    window.maxCurrent = std::max(window.maxCurrent, sample.shuntCurrent);
+    window.sumVoltage += sample.busVoltage;
+    window.sumCurrent += sample.shuntCurrent;
+    window.sumPower += sample.busPower;
+
+    // W * s to mWh
+    double energy_mwh = sample.busPower * dtSeconds / 3.6;
+    window.energyMwh += energy_mwh;
+    _sampling_data.totalEnergyMwh += energy_mwh;
+}
+
+// One bus turn, false while the conversion is still running
+static bool read_ready_sample(INA226& ina226, hal::HalBase::PowerSample_t& sample)
+{
+    bool ready = false;
+    HalEsp32::i2cScheduler().run(I2cBusScheduler::PRIORITY_SENSOR, _ina226_addr, [&]() {
+        ready = ina226.isConversionReady();
+        if (ready) {
+            sample.busVoltage   = ina226.readBusVoltage();
+            sample.shuntCurrent = ina226.readShuntCurrent();
+        }
+        return true;
+    });
+    return ready;
+}
+
+static void _power_sampling_task(void* param)
+{
+    INA226& ina226          = static_cast<HalEsp32*>(param)->ina226;
+    const TickType_t period = std::max<TickType_t>(pdMS_TO_TICKS(_sampling_data.conversionUs / 1000), 1);
+    int64_t last_us         = 0;
+
+    while (_sampling_data.isRunning) {
+        // The alert pin is not routed to the P4, so sleep most of a conversion, then pick up the ready flag
+        vTaskDelay(period > 1 ? period - 1 : 1);
+
+        hal::HalBase::PowerSample_t sample;
+        bool ready = read_ready_sample(ina226, sample);
+        while (!ready && _sampling_data.isRunning) {
+            vTaskDelay(1);
+            ready = read_ready_sample(ina226, sample);
+        }
+        if (!ready) {
+            break;
+        }
+
+        int64_t now_us     = esp_timer_get_time();
+        sample.timestampUs = now_us;
+        sample.busPower    = sample.busVoltage * sample.shuntCurrent;
+
+        // The first sample has no interval to integrate over
+        float dt_seconds = last_us == 0 ? 0.0f : (now_us - last_us) / 1000000.0f;
+        last_us          = now_us;
+        {
+            std::lock_guard<std::mutex> lock(_sampling_data.statsMutex);
+            _sampling_data.latest    = sample;
+            _sampling_data.hasLatest = true;
+            fold_power_sample(sample, dt_seconds);
+        }
+
+        if (_sampling_data.ring.write(&sample, 1) == 0) {
+            _sampling_data.droppedSamples++;
+        }
+    }
+
+    mclog::tagInfo(_tag, "sampling stop, {} samples dropped", _sampling_data.droppedSamples);
+    xSemaphoreGive(_sampling_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+bool HalEsp32::startPowerSampling(uint16_t averages)
+{
+    std::lock_guard<std::mutex> lock(_sampling_data.mutex);
+
+    if (_sampling_data.isRunning) {
+        return true;
+    }
+
+    uint32_t conversion_us = 0;
+    i2cScheduler().run(I2cBusScheduler::PRIORITY_SENSOR, _ina226_addr, [&]() {
+        ina226.configure(to_ina226_averages(averages), INA226_BUS_CONV_TIME_1100US, INA226_SHUNT_CONV_TIME_1100US,
+                         INA226_MODE_SHUNT_BUS_CONT);
+        conversion_us = ina226.getConversionTimeUs();
+        // Reading the flags clears a conversion from the old config
+        ina226.isConversionReady();
+        return true;
+    });
+    if (conversion_us == 0) {
+        mclog::tagError(_tag, "read ina226 config failed");
+        return false;
+    }
+
+    _sampling_data.conversionUs   = conversion_us;
+    _sampling_data.droppedSamples = 0;
+    _sampling_data.ring.init(_sample_ring_size);
+    {
+        std::lock_guard<std::mutex> stats_lock(_sampling_data.statsMutex);
+        _sampling_data.hasLatest      = false;
+        _sampling_data.window         = PowerWindowAccum_t();
+        _sampling_data.window.startUs = esp_timer_get_time();
+        _sampling_data.totalEnergyMwh = 0.0;
+    }
+    if (_sampling_data.exitSem == nullptr) {
+        _sampling_data.exitSem = xSemaphoreCreateBinary();
+    }
+
+    _sampling_data.isRunning = true;
+    if (xTaskCreate(_power_sampling_task, "power_sample", 4096, this, 5, nullptr) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _sampling_data.isRunning = false;
+        return false;
+    }
+
+    mclog::tagInfo(_tag, "sampling start, {} us per sample", conversion_us);
+    return true;
+}
+
+void HalEsp32::stopPowerSampling()
+{
+    std::lock_guard<std::mutex> lock(_sampling_data.mutex);
+
+    if (!_sampling_data.isRunning) {
+        return;
+    }
+    _sampling_data.isRunning = false;
+    xSemaphoreTake(_sampling_data.exitSem, portMAX_DELAY);
+
+    i2cScheduler().run(I2cBusScheduler::PRIORITY_SENSOR, _ina226_addr, [&]() {
+        ina226.configure(_default_averages, INA226_BUS_CONV_TIME_1100US, INA226_SHUNT_CONV_TIME_1100US,
+                         INA226_MODE_SHUNT_BUS_CONT);
+        return true;
+    });
+}
+
+bool HalEsp32::isPowerSampling()
+{
+    return _sampling_data.isRunning;
+}
+
+size_t HalEsp32::readPowerSamples(PowerSample_t* samples, size_t maxCount)
+{
+    return _sampling_data.ring.read(samples, maxCount);
+}
+
+hal::HalBase::PowerWindowStats_t HalEsp32::takePowerWindowStats()
+{
+    PowerWindowStats_t stats;
+    int64_t now_us = esp_timer_get_time();
+
+    std::lock_guard<std::mutex> lock(_sampling_data.statsMutex);
+    const auto& window = _sampling_data.window;
+    stats.samples      = window.samples;
+    stats.durationMs   = (now_us - window.startUs) / 1000;
+    stats.energyMwh    = window.energyMwh;
+    if (window.samples > 0) {
+        stats.minVoltage = window.minVoltage;
+        stats.maxVoltage = window.maxVoltage;
+        stats.avgVoltage = window.sumVoltage / window.samples;
+        stats.minCurrent = window.minCurrent;
+        stats.maxCurrent = window.maxCurrent;
+        stats.avgCurrent = window.sumCurrent / window.samples;
+        stats.avgPower   = window.sumPower / window.samples;
+    }
+
+    _sampling_data.window         = PowerWindowAccum_t();
+    _sampling_data.window.startUs = now_us;
+    return stats;
+}
+
+float HalEsp32::getPowerEnergyMwh()
+{
+    std::lock_guard<std::mutex> lock(_sampling_data.statsMutex);
+    return _sampling_data.totalEnergyMwh;
+}
+
 void HalEsp32::updatePowerMonitorData()
 {
     // mclog::tagInfo(_tag, "update power monitor");
-    powerMonitorData.busVoltage   = ina226.readBusVoltage();
-    powerMonitorData.shuntVoltage = ina226.readShuntVoltage();
-    powerMonitorData.busPower     = ina226.readBusPower();
-    powerMonitorData.shuntCurrent = ina226.readShuntCurrent();
+    PMData_t data;
+    read_power_monitor_data(data);
+    powerMonitorSnapshot.publish(data, millis());
+}
+
+void HalEsp32::read_power_monitor_data(PMData_t& data)
+{
+    // Latest sampled conversion, no bus transaction on the caller's thread
+    if (_sampling_data.isRunning) {
+        std::lock_guard<std::mutex> lock(_sampling_data.statsMutex);
+        if (_sampling_data.hasLatest) {
+            data.busVoltage   = _sampling_data.latest.busVoltage;
+            data.shuntCurrent = _sampling_data.latest.shuntCurrent;
+            data.shuntVoltage = _sampling_data.latest.shuntCurrent * _shunt_ohms;
+            data.busPower     = fabsf(_sampling_data.latest.busPower);
+            return;
+        }
+    }
+
+    // The four register reads go as one bus turn
+    i2cScheduler().run(I2cBusScheduler::PRIORITY_SENSOR, _ina226_addr, [&]() {
+        data.busVoltage   = ina226.readBusVoltage();
+        data.shuntVoltage = ina226.readShuntVoltage();
+        data.busPower     = ina226.readBusPower();
+        data.shuntCurrent = ina226.readShuntCurrent();
+        return true;
+    });
 }
 
 void HalEsp32::setChargeQcEnable(bool enable)
@@ -29,6 +293,8 @@ void HalEsp32::setChargeQcEnable(bool enable)
     _charge_qc_enable = enable;
     mclog::tagInfo(_tag, "set charge qc enable: {}", _charge_qc_enable);
     bsp_set_charge_qc_en(_charge_qc_enable);
+    io_expander_commit();
+    settingsStore().set("charge_qc", _charge_qc_enable);
 }
 
 bool HalEsp32::getChargeQcEnable()
@@ -41,6 +307,7 @@ void HalEsp32::setChargeEnable(bool enable)
     _charge_enable = enable;
     mclog::tagInfo(_tag, "set charge enable: {}", _charge_enable);
     bsp_set_charge_en(_charge_enable);
+    io_expander_commit();
 }
 
 bool HalEsp32::getChargeEnable()
@@ -53,6 +320,7 @@ void HalEsp32::setUsb5vEnable(bool enable)
     _usba_5v_enable = enable;
     mclog::tagInfo(_tag, "set usb 5v enable: {}", _usba_5v_enable);
     bsp_set_usb_5v_en(_usba_5v_enable);
+    io_expander_commit();
 }
 
 bool HalEsp32::getUsb5vEnable()
@@ -65,6 +333,7 @@ void HalEsp32::setExt5vEnable(bool enable)
     _ext_5v_enable = enable;
     mclog::tagInfo(_tag, "set ext 5v enable: {}", _ext_5v_enable);
     bsp_set_ext_5v_en(_ext_5v_enable);
+    io_expander_commit();
 }
 
 bool HalEsp32::getExt5vEnable()
@@ -76,62 +345,76 @@ void HalEsp32::powerOff()
 {
     mclog::tagInfo(_tag, "power off");
 
+    // Changes still waiting out their quiet period would be lost with the power
+    flushSettings();
     playShutdownSfx();
     setDisplayBrightness(0);
 
-    delay(100);
-    while (1) {
-        if (getMusicPlayTestState() == hal::HalBase::MUSIC_PLAY_IDLE) {
-            break;
-        }
-        delay(100);
-    }
+    wait_music_idle();
 
     bsp_generate_poweroff_signal();
 }
 
-extern esp_lcd_touch_handle_t _lcd_touch_handle;
+// GT911 INT, idles high and pulls low on every report
+static constexpr gpio_num_t _touch_int_pin = GPIO_NUM_23;
+// Backlight ramps around a standby
+static constexpr uint16_t _sleep_fade_ms = 300;
+static constexpr uint16_t _wake_fade_ms  = 300;
 
 void HalEsp32::sleepAndTouchWakeup()
 {
     mclog::tagInfo(_tag, "sleep and touch wakeup");
 
-    lvglLock();
     auto brightness = getDisplayBrightness();
-    setDisplayBrightness(0);
+    // Faded out in hardware while the finger is still on the button, the panel goes off once it is dark
+    fadeDisplayBrightness(0, _sleep_fade_ms);
+    int64_t dark_at = esp_timer_get_time() + _sleep_fade_ms * 1000;
 
-    uint16_t touch_x[1];
-    uint16_t touch_y[1];
-    uint16_t touch_strength[1];
-    uint8_t touch_cnt = 0;
+    // Sleep once the finger on the sleep button is lifted
+    while (getTouchState().count > 0 || esp_timer_get_time() < dark_at) {
+        delay(20);
+    }
 
-    while (1) {
-        esp_lcd_touch_read_data(_lcd_touch_handle);
-        bool touchpad_pressed =
-            esp_lcd_touch_get_coordinates(_lcd_touch_handle, touch_x, touch_y, touch_strength, &touch_cnt, 1);
-        // mclog::tagInfo(_tag, "touchpad pressed: {}", touchpad_pressed);
-        if (!touchpad_pressed) {
-            break;
-        }
-        delay(100);
+    // LVGL is paused through the standby rather than kept locked, no flush runs while the panel is off and other tasks
+    // still get the lock. The touchpad is off too, the touch that wakes the chip never reaches a widget
+    {
+        LvglLockGuard lock("sleep");
+        lvgl_port_stop();
+        lv_indev_enable(lvTouchpad, false);
     }
+    bsp_display_panel_on_off(false);
 
-    while (1) {
-        esp_lcd_touch_read_data(_lcd_touch_handle);
-        bool touchpad_pressed =
-            esp_lcd_touch_get_coordinates(_lcd_touch_handle, touch_x, touch_y, touch_strength, &touch_cnt, 1);
-        // mclog::tagInfo(_tag, "touchpad pressed: {}", touchpad_pressed);
-        if (touchpad_pressed) {
-            break;
+    // The touch ISR is edge triggered, the pin is switched to a level wake source for the sleep and back after
+    gpio_intr_disable(_touch_int_pin);
+    gpio_wakeup_enable(_touch_int_pin, GPIO_INTR_LOW_LEVEL);
+    esp_sleep_enable_gpio_wakeup();
+
+    int64_t sleep_start = esp_timer_get_time();
+    esp_err_t ret       = esp_light_sleep_start();
+
+    esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
+    gpio_wakeup_disable(_touch_int_pin);
+    gpio_set_intr_type(_touch_int_pin, GPIO_INTR_NEGEDGE);
+    gpio_intr_enable(_touch_int_pin);
+
+    // A rejected sleep means the touch came in while entering it
+    if (ret != ESP_OK && ret != ESP_ERR_SLEEP_REJECT) {
+        mclog::tagWarn(_tag, "light sleep failed: {}, waiting for touch awake", esp_err_to_name(ret));
+        while (getTouchState().count == 0) {
+            delay(20);
         }
-        delay(100);
     }
 
-    // esp_restart();
-
-    lvglUnlock();
-    delay(500);
-    setDisplayBrightness(brightness);
+    bsp_display_panel_on_off(true);
+    {
+        LvglLockGuard lock("wakeup");
+        // The press that woke the chip is not passed on as a click
+        suppress_touch_until_release();
+        lv_indev_enable(lvTouchpad, true);
+        lvgl_port_resume();
+    }
+    fadeDisplayBrightness(brightness, _wake_fade_ms);
+    mclog::tagInfo(_tag, "woke up after {} ms", (esp_timer_get_time() - sleep_start) / 1000);
 }
 
 void HalEsp32::sleepAndRtcWakeup()
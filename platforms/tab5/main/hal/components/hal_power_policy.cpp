@@ -0,0 +1,195 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <sdkconfig.h>
+#include <esp_err.h>
+#include <esp_pm.h>
+
+static const std::string _tag = "power-policy";
+
+// The lowest DFS step is the XTAL clock
+static constexpr int _min_freq_mhz = 40;
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+static constexpr bool _light_sleep_enable = true;
+#else
+static constexpr bool _light_sleep_enable = false;
+#endif
+
+struct PowerPolicyData_t {
+    std::mutex mutex;
+    std::map<std::string, hal::HalBase::PerfLevel_t> claims;
+    hal::HalBase::PerfLevel_t level = hal::HalBase::PERF_LEVEL_NONE;
+    // Null when power management is not enabled in the build, the claims are still tracked
+    esp_pm_lock_handle_t awakeLock  = nullptr;
+    esp_pm_lock_handle_t cpuMaxLock = nullptr;
+    // Top of the DFS range, lowered by the thermal service
+    int maxFreqMhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ;
+    // Radio claims, the idle level applies with none
+    hal::HalBase::WifiPowerSaveConfig_t powerSave;
+    std::map<std::string, hal::HalBase::RadioLevel_t> radioClaims;
+    hal::HalBase::RadioLevel_t radioLevel = hal::HalBase::RADIO_LEVEL_DTIM;
+};
+static PowerPolicyData_t _policy_data;
+
+// Station power save, implemented in hal_wifi.cpp
+void wifi_set_power_save(hal::HalBase::RadioLevel_t level, uint8_t listenInterval);
+
+static void set_lock(esp_pm_lock_handle_t lock, bool wasHeld, bool hold)
+{
+    if (lock == nullptr || wasHeld == hold) {
+        return;
+    }
+    if (hold) {
+        esp_pm_lock_acquire(lock);
+    } else {
+        esp_pm_lock_release(lock);
+    }
+}
+
+static esp_err_t configure_pm(int maxFreqMhz)
+{
+    esp_pm_config_t config = {
+        .max_freq_mhz       = maxFreqMhz,
+        .min_freq_mhz       = _min_freq_mhz,
+        .light_sleep_enable = _light_sleep_enable,
+    };
+    return esp_pm_configure(&config);
+}
+
+// Lock _policy_data.mutex before calling
+static void apply_level()
+{
+    auto level = hal::HalBase::PERF_LEVEL_NONE;
+    for (const auto& claim : _policy_data.claims) {
+        level = std::max(level, claim.second);
+    }
+    if (level == _policy_data.level) {
+        return;
+    }
+
+    // Each lock is taken once by the policy, drivers hold their own locks on top
+    set_lock(_policy_data.awakeLock, _policy_data.level >= hal::HalBase::PERF_LEVEL_AWAKE,
+             level >= hal::HalBase::PERF_LEVEL_AWAKE);
+    set_lock(_policy_data.cpuMaxLock, _policy_data.level >= hal::HalBase::PERF_LEVEL_MAX,
+             level >= hal::HalBase::PERF_LEVEL_MAX);
+    _policy_data.level = level;
+}
+
+void HalEsp32::power_policy_init()
+{
+    std::lock_guard<std::mutex> lock(_policy_data.mutex);
+
+    // Boot runs at full speed, init() drops the claim once the drivers are up
+    _policy_data.claims["boot"] = PERF_LEVEL_MAX;
+
+    esp_err_t ret = configure_pm(_policy_data.maxFreqMhz);
+    if (ret != ESP_OK) {
+        mclog::tagWarn(_tag, "power management not available: {}", esp_err_to_name(ret));
+        _policy_data.level = PERF_LEVEL_MAX;
+        return;
+    }
+
+    if (esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "perf_awake", &_policy_data.awakeLock) != ESP_OK ||
+        esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "perf_max", &_policy_data.cpuMaxLock) != ESP_OK) {
+        mclog::tagError(_tag, "create pm locks failed");
+    }
+    apply_level();
+
+    mclog::tagInfo(_tag, "dfs {} ~ {} MHz, light sleep {}", _min_freq_mhz, CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+                   _light_sleep_enable ? "on" : "off");
+}
+
+void HalEsp32::claimPerfLevel(const std::string& owner, PerfLevel_t level)
+{
+    std::lock_guard<std::mutex> lock(_policy_data.mutex);
+
+    if (level == PERF_LEVEL_NONE) {
+        _policy_data.claims.erase(owner);
+    } else {
+        _policy_data.claims[owner] = level;
+    }
+    // Without power management the chip always runs at full speed
+    if (_policy_data.cpuMaxLock == nullptr) {
+        return;
+    }
+    apply_level();
+}
+
+void HalEsp32::power_policy_set_cpu_cap(uint16_t mhz)
+{
+    std::lock_guard<std::mutex> lock(_policy_data.mutex);
+
+    int max_freq = mhz ? std::clamp<int>(mhz, _min_freq_mhz, CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ)
+                       : CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ;
+    if (_policy_data.cpuMaxLock == nullptr || max_freq == _policy_data.maxFreqMhz) {
+        return;
+    }
+
+    // The max lock follows the new top, so claims of PERF_LEVEL_MAX run capped as well
+    esp_err_t ret = configure_pm(max_freq);
+    if (ret != ESP_OK) {
+        mclog::tagError(_tag, "cap cpu at {} MHz failed: {}", max_freq, esp_err_to_name(ret));
+        return;
+    }
+    _policy_data.maxFreqMhz = max_freq;
+    mclog::tagInfo(_tag, "dfs {} ~ {} MHz", _min_freq_mhz, max_freq);
+}
+
+hal::HalBase::PerfLevel_t HalEsp32::getPerfLevel()
+{
+    std::lock_guard<std::mutex> lock(_policy_data.mutex);
+    return _policy_data.level;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Radio                                   */
+/* -------------------------------------------------------------------------- */
+// Lock _policy_data.mutex before calling
+static void apply_radio_level(bool force)
+{
+    auto level = _policy_data.powerSave.idleLevel;
+    for (const auto& claim : _policy_data.radioClaims) {
+        level = std::max(level, claim.second);
+    }
+    if (level == _policy_data.radioLevel && !force) {
+        return;
+    }
+    _policy_data.radioLevel = level;
+    wifi_set_power_save(level, _policy_data.powerSave.listenInterval);
+}
+
+void HalEsp32::setWifiPowerSave(const WifiPowerSaveConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_policy_data.mutex);
+
+    _policy_data.powerSave                = config;
+    _policy_data.powerSave.listenInterval = std::max<uint8_t>(config.listenInterval, 1);
+    apply_radio_level(true);
+    mclog::tagInfo(_tag, "radio idle level {}, listen interval {}", (int)config.idleLevel,
+                   _policy_data.powerSave.listenInterval);
+}
+
+void HalEsp32::claimRadioLevel(const std::string& owner, RadioLevel_t level)
+{
+    std::lock_guard<std::mutex> lock(_policy_data.mutex);
+
+    if (level == RADIO_LEVEL_SLEEP) {
+        _policy_data.radioClaims.erase(owner);
+    } else {
+        _policy_data.radioClaims[owner] = level;
+    }
+    apply_radio_level(false);
+}
+
+hal::HalBase::RadioLevel_t HalEsp32::getRadioLevel()
+{
+    std::lock_guard<std::mutex> lock(_policy_data.mutex);
+    return _policy_data.radioLevel;
+}
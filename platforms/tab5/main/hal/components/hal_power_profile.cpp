@@ -0,0 +1,324 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_timer.h>
+#include <esp_wifi.h>
+
+static const std::string _tag = "power-profile";
+
+/*
+ * File layout, little endian, records are packed:
+ * header : "T5PP", u16 version, u16 sample record size
+ * string : u8 REC_STRING, u8 kind (0 app, 1 window), u8 id, u8 length, name bytes, sent before the first use of id
+ * sample : u8 REC_SAMPLE, u8 peripheral flags, u8 cpu load %, u8 app id, u8 window id, u8 brightness %,
+ *          u16 reserved, u32 ms since start, f32 bus voltage V, f32 current A (negative while discharging)
+ * Id 0 is no app or no window
+ */
+static constexpr uint16_t _format_version = 1;
+static constexpr uint32_t _drain_interval = 200;
+static constexpr uint32_t _cpu_interval   = 1000;
+// Written out in chunks, the card sees a few writes a second
+static constexpr size_t _flush_size = 4096;
+
+enum RecordType_t : uint8_t {
+    REC_STRING = 1,
+    REC_SAMPLE = 2,
+};
+
+enum StringKind_t : uint8_t {
+    STRING_APP    = 0,
+    STRING_WINDOW = 1,
+};
+
+enum PeripheralFlag_t : uint8_t {
+    FLAG_CAMERA           = 1 << 0,
+    FLAG_CAMERA_RECORDING = 1 << 1,
+    FLAG_CAMERA_STREAMING = 1 << 2,
+    FLAG_AUDIO_CAPTURE    = 1 << 3,
+    FLAG_MUSIC            = 1 << 4,
+    FLAG_WIFI             = 1 << 5,
+    FLAG_IMU_STREAM       = 1 << 6,
+    FLAG_CHARGE_ENABLED   = 1 << 7,
+};
+
+struct __attribute__((packed)) FileHeader_t {
+    char magic[4]       = {'T', '5', 'P', 'P'};
+    uint16_t version    = _format_version;
+    uint16_t sampleSize = 0;
+};
+
+struct __attribute__((packed)) SampleRecord_t {
+    uint8_t type       = REC_SAMPLE;
+    uint8_t flags      = 0;
+    uint8_t cpuLoad    = 0;
+    uint8_t appId      = 0;
+    uint8_t windowId   = 0;
+    uint8_t brightness = 0;
+    uint16_t reserved  = 0;
+    uint32_t timeMs    = 0;
+    float busVoltage   = 0.0f;
+    float current      = 0.0f;
+};
+
+struct PowerProfileData_t {
+    std::mutex mutex;
+    std::atomic<bool> isRunning{false};
+    SemaphoreHandle_t exitSem = nullptr;
+    FILE* file                = nullptr;
+    bool ownsSampling         = false;
+    // Set from the app loop, read by the task
+    std::mutex contextMutex;
+    std::string app;
+    std::string window;
+};
+static PowerProfileData_t _profile_data;
+
+// Recorder task state, names get their ids in order of first use
+struct RecorderState_t {
+    std::vector<uint8_t> buffer;
+    std::vector<std::string> names[2];
+    int64_t startUs                       = 0;
+    configRUN_TIME_COUNTER_TYPE lastTotal = 0;
+    uint64_t lastIdle                     = 0;
+    uint8_t cpuLoad                       = 0;
+    uint32_t records                      = 0;
+};
+
+static void append(RecorderState_t& state, const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    state.buffer.insert(state.buffer.end(), bytes, bytes + size);
+}
+
+static uint8_t name_to_id(RecorderState_t& state, StringKind_t kind, const std::string& name)
+{
+    if (name.empty()) {
+        return 0;
+    }
+    auto& names = state.names[kind];
+    for (size_t i = 0; i < names.size(); i++) {
+        if (names[i] == name) {
+            return i + 1;
+        }
+    }
+    if (names.size() >= 255) {
+        return 0;
+    }
+
+    names.push_back(name);
+    uint8_t length    = std::min<size_t>(name.size(), 255);
+    uint8_t header[4] = {REC_STRING, kind, (uint8_t)names.size(), length};
+    append(state, header, sizeof(header));
+    append(state, name.data(), length);
+    return names.size();
+}
+
+// Busy share of all cores since the previous call, from the idle task counters
+static void update_cpu_load(RecorderState_t& state)
+{
+    std::vector<TaskStatus_t> task_status(uxTaskGetNumberOfTasks() + 4);
+    configRUN_TIME_COUNTER_TYPE total = 0;
+    UBaseType_t task_num              = uxTaskGetSystemState(task_status.data(), task_status.size(), &total);
+    if (task_num == 0) {
+        return;
+    }
+
+    uint64_t idle = 0;
+    for (UBaseType_t i = 0; i < task_num; i++) {
+        if (strncmp(task_status[i].pcTaskName, "IDLE", 4) == 0) {
+            idle += task_status[i].ulRunTimeCounter;
+        }
+    }
+
+    uint64_t total_delta = (uint64_t)(total - state.lastTotal) * portNUM_PROCESSORS;
+    uint64_t idle_delta  = idle - state.lastIdle;
+    if (state.lastTotal != 0 && total_delta > 0) {
+        state.cpuLoad = 100 - std::min<uint64_t>(idle_delta * 100 / total_delta, 100);
+    }
+    state.lastTotal = total;
+    state.lastIdle  = idle;
+}
+
+static bool flush_records(RecorderState_t& state)
+{
+    if (state.buffer.empty()) {
+        return true;
+    }
+    size_t written = fwrite(state.buffer.data(), 1, state.buffer.size(), _profile_data.file);
+    bool ok        = written == state.buffer.size();
+    state.buffer.clear();
+    return ok;
+}
+
+void HalEsp32::power_profile_task(void* param)
+{
+    static_cast<HalEsp32*>(param)->power_profile_loop();
+
+    xSemaphoreGive(_profile_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+void HalEsp32::power_profile_loop()
+{
+    RecorderState_t state;
+    state.buffer.reserve(_flush_size * 2);
+    state.startUs = esp_timer_get_time();
+    update_cpu_load(state);
+
+    FileHeader_t header;
+    header.sampleSize = sizeof(SampleRecord_t);
+    append(state, &header, sizeof(header));
+
+    std::vector<PowerSample_t> samples(64);
+    TickType_t wake      = xTaskGetTickCount();
+    uint32_t cpu_time_ms = 0;
+    bool write_failed    = false;
+
+    while (_profile_data.isRunning) {
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(_drain_interval));
+
+        cpu_time_ms += _drain_interval;
+        if (cpu_time_ms >= _cpu_interval) {
+            update_cpu_load(state);
+            cpu_time_ms = 0;
+        }
+
+        // Context and peripheral state once per drain, the samples in between share it
+        SampleRecord_t record;
+        {
+            std::lock_guard<std::mutex> lock(_profile_data.contextMutex);
+            record.appId    = name_to_id(state, STRING_APP, _profile_data.app);
+            record.windowId = name_to_id(state, STRING_WINDOW, _profile_data.window);
+        }
+        wifi_mode_t wifi_mode = WIFI_MODE_NULL;
+        record.flags |= isCameraCapturing() ? FLAG_CAMERA : 0;
+        record.flags |= isCameraRecording() ? FLAG_CAMERA_RECORDING : 0;
+        record.flags |= isCameraStreaming() ? FLAG_CAMERA_STREAMING : 0;
+        record.flags |= isAudioCapturing() ? FLAG_AUDIO_CAPTURE : 0;
+        record.flags |= getMusicPlayTestState() == MUSIC_PLAY_PLAYING ? FLAG_MUSIC : 0;
+        record.flags |= esp_wifi_get_mode(&wifi_mode) == ESP_OK && wifi_mode != WIFI_MODE_NULL ? FLAG_WIFI : 0;
+        record.flags |= isImuStreaming() ? FLAG_IMU_STREAM : 0;
+        record.flags |= getChargeEnable() ? FLAG_CHARGE_ENABLED : 0;
+        record.cpuLoad    = state.cpuLoad;
+        record.brightness = getDisplayBrightness();
+
+        size_t count = 0;
+        while ((count = readPowerSamples(samples.data(), samples.size())) > 0) {
+            for (size_t i = 0; i < count; i++) {
+                record.timeMs     = (samples[i].timestampUs - state.startUs) / 1000;
+                record.busVoltage = samples[i].busVoltage;
+                record.current    = samples[i].shuntCurrent;
+                append(state, &record, sizeof(record));
+            }
+            state.records += count;
+        }
+
+        if (state.buffer.size() >= _flush_size && !flush_records(state)) {
+            write_failed = true;
+            break;
+        }
+    }
+
+    if (!write_failed && !flush_records(state)) {
+        write_failed = true;
+    }
+    if (write_failed) {
+        mclog::tagError(_tag, "write failed, recording stopped");
+        _profile_data.isRunning = false;
+    }
+    mclog::tagInfo(_tag, "stop, {} samples recorded", state.records);
+}
+
+bool HalEsp32::startPowerProfile(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(_profile_data.mutex);
+
+    if (_profile_data.isRunning) {
+        mclog::tagWarn(_tag, "already recording");
+        return false;
+    }
+    if (!mount_sd_card()) {
+        return false;
+    }
+
+    _profile_data.file = fopen(("/sd/" + path).c_str(), "wb");
+    if (_profile_data.file == nullptr) {
+        mclog::tagError(_tag, "open {} failed", path);
+        return false;
+    }
+
+    // The recorder drains the sample ring, a sampling session started elsewhere is reused as is
+    _profile_data.ownsSampling = !isPowerSampling();
+    if (_profile_data.ownsSampling && !startPowerSampling(16)) {
+        fclose(_profile_data.file);
+        _profile_data.file = nullptr;
+        return false;
+    }
+    if (_profile_data.exitSem == nullptr) {
+        _profile_data.exitSem = xSemaphoreCreateBinary();
+    }
+
+    _profile_data.isRunning = true;
+    if (xTaskCreate(power_profile_task, "power_profile", 4096, this, 3, nullptr) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _profile_data.isRunning = false;
+        if (_profile_data.ownsSampling) {
+            stopPowerSampling();
+        }
+        fclose(_profile_data.file);
+        _profile_data.file = nullptr;
+        return false;
+    }
+
+    mclog::tagInfo(_tag, "start: {}", path);
+    return true;
+}
+
+void HalEsp32::stopPowerProfile()
+{
+    std::lock_guard<std::mutex> lock(_profile_data.mutex);
+
+    if (_profile_data.file == nullptr) {
+        return;
+    }
+
+    // The task also ends on its own after a write error, its exit is still signalled once
+    _profile_data.isRunning = false;
+    xSemaphoreTake(_profile_data.exitSem, portMAX_DELAY);
+
+    if (_profile_data.ownsSampling) {
+        stopPowerSampling();
+    }
+    fclose(_profile_data.file);
+    _profile_data.file = nullptr;
+}
+
+bool HalEsp32::isPowerProfiling()
+{
+    return _profile_data.isRunning;
+}
+
+void HalEsp32::setPowerProfileApp(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(_profile_data.contextMutex);
+    _profile_data.app = name;
+}
+
+void HalEsp32::setPowerProfileWindow(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(_profile_data.contextMutex);
+    _profile_data.window = name;
+}
@@ -0,0 +1,376 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <driver/gptimer.h>
+#include <esp_cpu.h>
+#include <esp_heap_caps.h>
+#include <esp_app_desc.h>
+#include <esp_http_server.h>
+#include <riscv/csr.h>
+
+static const std::string _tag = "profiler";
+
+static constexpr uint32_t _timer_resolution_hz = 1000000;
+// Lines gathered before each write of the dump
+static constexpr size_t _write_chunk = 4096;
+
+struct ProfileSample_t {
+    uint32_t pc;
+    // TCB address
+    uint32_t task;
+};
+
+// One per core, only that core's interrupt writes it
+struct ProfileRing_t {
+    ProfileSample_t* samples    = nullptr;
+    uint32_t capacity           = 0;
+    volatile uint32_t count     = 0;
+    volatile uint32_t skipped   = 0;
+    volatile uint64_t isrCycles = 0;
+    gptimer_handle_t timer      = nullptr;
+    int core                    = 0;
+};
+
+struct ProfilerData_t {
+    std::mutex mutex;
+    bool isRunning = false;
+    hal::HalBase::ProfilerConfig_t config;
+    ProfileRing_t rings[portNUM_PROCESSORS];
+    // Set while a dump copies the rings
+    std::atomic<bool> isPaused = false;
+};
+static ProfilerData_t _profiler_data;
+
+struct ProfileEntry_t {
+    uint32_t task;
+    uint32_t pc;
+    uint32_t count;
+    uint8_t core;
+};
+
+/* -------------------------------------------------------------------------- */
+/*                                  Sampling                                  */
+/* -------------------------------------------------------------------------- */
+// The interrupt entry saved the interrupted PC in mepc, a nested interrupt puts it back on its way out
+static bool on_profile_timer(gptimer_handle_t timer, const gptimer_alarm_event_data_t* event, void* arg)
+{
+    uint32_t start = esp_cpu_get_cycle_count();
+    auto ring      = static_cast<ProfileRing_t*>(arg);
+    if (_profiler_data.isPaused) {
+        ring->skipped = ring->skipped + 1;
+        return false;
+    }
+
+    auto& sample    = ring->samples[ring->count % ring->capacity];
+    sample.pc       = RV_READ_CSR(mepc);
+    sample.task     = (uint32_t)xTaskGetCurrentTaskHandleForCore(ring->core);
+    ring->count     = ring->count + 1;
+    ring->isrCycles = ring->isrCycles + (esp_cpu_get_cycle_count() - start);
+    return false;
+}
+
+struct TimerSetup_t {
+    ProfileRing_t* ring;
+    uint32_t alarmCount;
+    SemaphoreHandle_t doneSem;
+    esp_err_t result;
+};
+
+// The timer interrupt lands on the core that installs it, so each core sets up its own
+static void timer_setup_task(void* param)
+{
+    auto setup    = static_cast<TimerSetup_t*>(param);
+    auto& ring    = *setup->ring;
+    ring.core     = xPortGetCoreID();
+    setup->result = ESP_OK;
+
+    // XTAL keeps the DFS range free, an APB clocked timer would hold the CPU at its top frequency
+    gptimer_config_t timer_config = {};
+    timer_config.clk_src          = GPTIMER_CLK_SRC_XTAL;
+    timer_config.direction        = GPTIMER_COUNT_UP;
+    timer_config.resolution_hz    = _timer_resolution_hz;
+    // Above the level 1 driver interrupts, so their time is seen too
+    timer_config.intr_priority = 2;
+
+    gptimer_event_callbacks_t callbacks = {};
+    callbacks.on_alarm                  = on_profile_timer;
+
+    gptimer_alarm_config_t alarm_config     = {};
+    alarm_config.alarm_count                = setup->alarmCount;
+    alarm_config.reload_count               = 0;
+    alarm_config.flags.auto_reload_on_alarm = true;
+
+    esp_err_t ret = gptimer_new_timer(&timer_config, &ring.timer);
+    if (ret == ESP_OK) {
+        ret = gptimer_register_event_callbacks(ring.timer, &callbacks, &ring);
+    }
+    if (ret == ESP_OK) {
+        ret = gptimer_set_alarm_action(ring.timer, &alarm_config);
+    }
+    if (ret == ESP_OK) {
+        ret = gptimer_enable(ring.timer);
+    }
+    if (ret == ESP_OK) {
+        ret = gptimer_start(ring.timer);
+    }
+    if (ret != ESP_OK && ring.timer != nullptr) {
+        gptimer_del_timer(ring.timer);
+        ring.timer = nullptr;
+    }
+    setup->result = ret;
+
+    xSemaphoreGive(setup->doneSem);
+    vTaskDelete(NULL);
+}
+
+static void timer_teardown(ProfileRing_t& ring)
+{
+    if (ring.timer == nullptr) {
+        return;
+    }
+    gptimer_stop(ring.timer);
+    gptimer_disable(ring.timer);
+    gptimer_del_timer(ring.timer);
+    ring.timer = nullptr;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Dump                                    */
+/* -------------------------------------------------------------------------- */
+// Counts the held samples per core, task and PC. Sampling only pauses for the copy
+static bool profile_collect(std::vector<ProfileEntry_t>& entries)
+{
+    entries.clear();
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        auto& ring = _profiler_data.rings[core];
+        auto held  = std::min(ring.count, ring.capacity);
+        if (held == 0) {
+            continue;
+        }
+        auto copy = static_cast<ProfileSample_t*>(heap_caps_malloc(held * sizeof(ProfileSample_t), MALLOC_CAP_SPIRAM));
+        if (copy == nullptr) {
+            mclog::tagError(_tag, "no memory for {} samples", held);
+            return false;
+        }
+
+        // A sample being written on the other core finishes well within the wait
+        _profiler_data.isPaused = true;
+        vTaskDelay(pdMS_TO_TICKS(2));
+        memcpy(copy, ring.samples, held * sizeof(ProfileSample_t));
+        _profiler_data.isPaused = false;
+
+        std::sort(copy, copy + held, [](const ProfileSample_t& a, const ProfileSample_t& b) {
+            return a.task != b.task ? a.task < b.task : a.pc < b.pc;
+        });
+        for (uint32_t i = 0; i < held; i++) {
+            if (!entries.empty() && entries.back().core == core && entries.back().task == copy[i].task &&
+                entries.back().pc == copy[i].pc) {
+                entries.back().count++;
+                continue;
+            }
+            entries.push_back({copy[i].task, copy[i].pc, 1, (uint8_t)core});
+        }
+        free(copy);
+    }
+    return true;
+}
+
+// Text, one line per core, task and PC, tools/profile_to_folded.py reads it
+template <typename Write>
+static bool profile_write(Write write)
+{
+    std::vector<ProfileEntry_t> entries;
+    if (!profile_collect(entries)) {
+        return false;
+    }
+
+    // Tasks that have ended since keep their TCB address as their name
+    std::map<uint32_t, std::string> names;
+    std::vector<TaskStatus_t> task_status(uxTaskGetNumberOfTasks() + 4);
+    UBaseType_t task_num = uxTaskGetSystemState(task_status.data(), task_status.size(), nullptr);
+    for (UBaseType_t i = 0; i < task_num; i++) {
+        names[(uint32_t)task_status[i].xHandle] = task_status[i].pcTaskName;
+    }
+
+    char elf_sha[65] = {0};
+    esp_app_get_elf_sha256(elf_sha, sizeof(elf_sha));
+    auto stats = GetHAL()->getProfilerStats();
+
+    std::string chunk = fmt::format("# m5tab5-profile 1\n# elf {}\n# rate {} samples {} skipped {} isr_cycles {}\n",
+                                    elf_sha, stats.rateHz, stats.samples, stats.skipped, stats.isrCycles);
+    for (const auto& entry : entries) {
+        auto name = names.find(entry.task);
+        if (name != names.end()) {
+            chunk += fmt::format("{}\t{}\t0x{:08x}\t{}\n", entry.core, name->second, entry.pc, entry.count);
+        } else {
+            chunk += fmt::format("{}\ttask@{:08x}\t0x{:08x}\t{}\n", entry.core, entry.task, entry.pc, entry.count);
+        }
+        if (chunk.size() >= _write_chunk) {
+            if (!write(chunk)) {
+                return false;
+            }
+            chunk.clear();
+        }
+    }
+    return chunk.empty() || write(chunk);
+}
+
+static esp_err_t profile_get_handler(httpd_req_t* req)
+{
+    if (GetHAL()->getProfilerStats().capacity == 0) {
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "profiler not started");
+        return ESP_OK;
+    }
+
+    httpd_resp_set_type(req, "text/plain");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    bool is_ok = profile_write(
+        [req](const std::string& chunk) { return httpd_resp_send_chunk(req, chunk.data(), chunk.size()) == ESP_OK; });
+    if (!is_ok) {
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, nullptr, 0);
+}
+
+// Called by start_webserver() in hal_wifi.cpp
+void profiler_register_handlers(httpd_handle_t server)
+{
+    static httpd_uri_t get_uri = {};
+    get_uri.uri                = "/api/profile";
+    get_uri.method             = HTTP_GET;
+    get_uri.handler            = profile_get_handler;
+    httpd_register_uri_handler(server, &get_uri);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                     HAL                                    */
+/* -------------------------------------------------------------------------- */
+bool HalEsp32::startProfiler(const ProfilerConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_profiler_data.mutex);
+
+    if (_profiler_data.isRunning) {
+        return true;
+    }
+
+    _profiler_data.config = config;
+    uint32_t rate_hz      = std::clamp<uint32_t>(config.rateHz, 10, 10000);
+    uint32_t capacity     = std::max<uint32_t>(config.bufferKb * 1024 / sizeof(ProfileSample_t) / portNUM_PROCESSORS,
+                                               rate_hz);
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        auto& ring = _profiler_data.rings[core];
+        // The rings stay after a stop so the last run can still be dumped, a new start begins over
+        if (ring.capacity != capacity) {
+            free(ring.samples);
+            ring.samples  = static_cast<ProfileSample_t*>(heap_caps_malloc(capacity * sizeof(ProfileSample_t),
+                                                                          MALLOC_CAP_SPIRAM));
+            ring.capacity = ring.samples != nullptr ? capacity : 0;
+        }
+        ring.count     = 0;
+        ring.skipped   = 0;
+        ring.isrCycles = 0;
+        if (ring.samples == nullptr) {
+            mclog::tagError(_tag, "no memory for {} samples", capacity);
+            return false;
+        }
+    }
+
+    TimerSetup_t setup = {};
+    setup.alarmCount   = _timer_resolution_hz / rate_hz;
+    setup.doneSem      = xSemaphoreCreateBinary();
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        setup.ring = &_profiler_data.rings[core];
+        if (xTaskCreatePinnedToCore(timer_setup_task, "profiler_setup", 3072, &setup, 5, nullptr, core) != pdPASS) {
+            setup.result = ESP_ERR_NO_MEM;
+        } else {
+            xSemaphoreTake(setup.doneSem, portMAX_DELAY);
+        }
+        if (setup.result != ESP_OK) {
+            mclog::tagError(_tag, "timer on core {} failed: {}", core, esp_err_to_name(setup.result));
+            for (auto& ring : _profiler_data.rings) {
+                timer_teardown(ring);
+            }
+            vSemaphoreDelete(setup.doneSem);
+            return false;
+        }
+    }
+    vSemaphoreDelete(setup.doneSem);
+
+    _profiler_data.config.rateHz = rate_hz;
+    _profiler_data.isRunning     = true;
+    mclog::tagInfo(_tag, "start, {} Hz per core, {} samples per core", rate_hz, capacity);
+    return true;
+}
+
+void HalEsp32::stopProfiler()
+{
+    std::lock_guard<std::mutex> lock(_profiler_data.mutex);
+
+    if (!_profiler_data.isRunning) {
+        return;
+    }
+
+    for (auto& ring : _profiler_data.rings) {
+        timer_teardown(ring);
+    }
+    _profiler_data.isRunning = false;
+    mclog::tagInfo(_tag, "stop");
+}
+
+hal::HalBase::ProfilerStats_t HalEsp32::getProfilerStats()
+{
+    ProfilerStats_t stats;
+    stats.isRunning = _profiler_data.isRunning;
+    stats.rateHz    = _profiler_data.config.rateHz;
+
+    uint64_t cycles = 0;
+    for (const auto& ring : _profiler_data.rings) {
+        stats.capacity += ring.capacity;
+        stats.samples += ring.count;
+        stats.skipped += ring.skipped;
+        cycles += ring.isrCycles;
+    }
+    stats.isrCycles = stats.samples > 0 ? cycles / stats.samples : 0;
+    return stats;
+}
+
+bool HalEsp32::exportProfile(const std::string& path)
+{
+    if (getProfilerStats().capacity == 0) {
+        return false;
+    }
+
+    if (path.empty()) {
+        return profile_write([](const std::string& chunk) {
+            fwrite(chunk.data(), 1, chunk.size(), stdout);
+            return true;
+        });
+    }
+
+    FILE* file = fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        mclog::tagError(_tag, "open {} failed", path);
+        return false;
+    }
+    bool is_ok = profile_write(
+        [file](const std::string& chunk) { return fwrite(chunk.data(), 1, chunk.size(), file) == chunk.size(); });
+    is_ok = fclose(file) == 0 && is_ok;
+    mclog::tagInfo(_tag, "dump to {} {}", path, is_ok ? "done" : "failed");
+    return is_ok;
+}
@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include "../utils/task_controller/task_controller.h"
+#include <mooncake_log.h>
+#include <atomic>
+#include <mutex>
+#include <bsp/m5stack_tab5.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static const std::string _tag = "refresh-governor";
+
+// Only lowering waits for the poll, raising happens on the invalidation itself
+static constexpr uint32_t _poll_interval_ms = 100;
+
+struct RefreshGovernorData_t {
+    // Serializes start and stop
+    std::mutex serviceMutex;
+    // Taken around every rate change, the governor task and the LVGL invalidations race otherwise
+    std::mutex mutex;
+    TaskController_t task;
+    hal::HalBase::RefreshGovernorConfig_t config;
+    std::atomic<uint32_t> lastInvalidateTime{0};
+    std::atomic<bool> isLowered{false};
+    std::atomic<bool> isUiAnimating{false};
+};
+static RefreshGovernorData_t _refresh_data;
+
+static void restore_full_rate()
+{
+    std::lock_guard<std::mutex> lock(_refresh_data.mutex);
+    if (_refresh_data.isLowered) {
+        bsp_display_set_refresh_rate(0);
+        _refresh_data.isLowered = false;
+    }
+}
+
+// On the LVGL task or the app loop, for every invalidated area, so the frame being rendered already goes out at the
+// full rate
+static void on_invalidate_area(lv_event_t* e)
+{
+    _refresh_data.lastInvalidateTime = GetHAL()->millis();
+    if (_refresh_data.isLowered) {
+        restore_full_rate();
+    }
+}
+
+static void _refresh_governor_loop(TaskController_t& task)
+{
+    const auto config = _refresh_data.config;
+
+    while (task.sleep(pdMS_TO_TICKS(_poll_interval_ms))) {
+        // The camera preview is a video plane under LVGL, its frames never invalidate anything
+        uint32_t inactive_ms = lv_display_get_inactive_time(GetHAL()->lvDisp);
+        bool is_busy         = _refresh_data.isUiAnimating || GetHAL()->isCameraCapturing() ||
+                       inactive_ms < config.idleTimeoutMs;
+        if (is_busy) {
+            if (_refresh_data.isLowered) {
+                restore_full_rate();
+            }
+            continue;
+        }
+        if (_refresh_data.isLowered) {
+            continue;
+        }
+
+        // Checked under the lock, an invalidation either lands before and is seen here, or after and raises the rate
+        std::lock_guard<std::mutex> lock(_refresh_data.mutex);
+        if (GetHAL()->millis() - _refresh_data.lastInvalidateTime >= config.idleTimeoutMs) {
+            _refresh_data.isLowered = true;
+            bsp_display_set_refresh_rate(config.idleRefreshHz);
+        }
+    }
+}
+
+bool HalEsp32::startRefreshGovernor(const RefreshGovernorConfig_t& config)
+{
+    auto& data = _refresh_data;
+    std::lock_guard<std::mutex> lock(data.serviceMutex);
+
+    if (data.task.isRunning()) {
+        return true;
+    }
+    if (lvDisp == nullptr || config.idleRefreshHz == 0) {
+        mclog::tagError(_tag, "invalid config");
+        return false;
+    }
+
+    data.config             = config;
+    data.lastInvalidateTime = millis();
+    {
+        LvglLockGuard lvgl_lock("refresh governor");
+        lv_display_add_event_cb(lvDisp, on_invalidate_area, LV_EVENT_INVALIDATE_AREA, nullptr);
+    }
+
+    if (!data.task.start("refresh_gov", 3072, 2, -1, _refresh_governor_loop)) {
+        mclog::tagError(_tag, "create task failed");
+        LvglLockGuard lvgl_lock("refresh governor");
+        lv_display_remove_event_cb_with_user_data(lvDisp, on_invalidate_area, nullptr);
+        return false;
+    }
+
+    mclog::tagInfo(_tag, "start, {} Hz, {} Hz after {} ms static", bsp_display_get_refresh_rate(),
+                   config.idleRefreshHz, config.idleTimeoutMs);
+    return true;
+}
+
+void HalEsp32::stopRefreshGovernor()
+{
+    auto& data = _refresh_data;
+    std::lock_guard<std::mutex> lock(data.serviceMutex);
+
+    if (!data.task.isRunning()) {
+        return;
+    }
+
+    data.task.stop();
+    {
+        LvglLockGuard lvgl_lock("refresh governor");
+        lv_display_remove_event_cb_with_user_data(lvDisp, on_invalidate_area, nullptr);
+    }
+    restore_full_rate();
+    mclog::tagInfo(_tag, "stop");
+}
+
+void HalEsp32::setUiAnimating(bool animating)
+{
+    _refresh_data.isUiAnimating = animating;
+    if (animating && _refresh_data.isLowered) {
+        restore_full_rate();
+    }
+}
+
+uint8_t HalEsp32::getDisplayRefreshRate()
+{
+    return bsp_display_get_refresh_rate();
+}
@@ -5,105 +5,312 @@
  */
 #include "hal/hal_esp32.h"
 #include <mooncake_log.h>
+#include <algorithm>
 #include <vector>
 #include <driver/gpio.h>
 #include <memory>
+#include <mutex>
 #include "driver/uart.h"
 #include "esp_log.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
 
 #define TAG "hal_rs485"
 
-// RS485
-#define TAB5_RS485_BUF_SIZE (127)
-// Timeout threshold for UART = number of symbols (~10 tics) with unchanged state on receive pin
-#define TAB5_RS485_READ_TOUT        (3)  // 3.5T * 8 = 28 ticks, TOUT=3 -> ~24..33 ticks
-#define TAB5_RS485_PACKET_READ_TICS (100 / portTICK_PERIOD_MS)
 static uart_port_t tab5_rs485_uart_num = UART_NUM_1;
 
 #define TAB5_SYS_RS485_TX_PIN 20
 #define TAB5_SYS_RS485_RX_PIN 21
 #define TAB5_SYS_RS485_DE_PIN 34
 
-static void tab5_rs485_echo_send(const int port, uint8_t* str, uint8_t length)
+// The UART clock divided by 16
+static constexpr uint32_t _max_baud_rate = 5000000;
+// Driver events queued between task wakeups, enough for a burst of short frames
+static constexpr int _event_queue_size = 32;
+// Pattern positions kept by the driver until the task pops them
+static constexpr int _pattern_queue_size = 16;
+// Sent to the event queue to end the task, not a driver event
+static constexpr uart_event_type_t _event_stop = UART_EVENT_MAX;
+
+struct Rs485Data_t {
+    std::mutex mutex;
+    QueueHandle_t eventQueue  = nullptr;
+    SemaphoreHandle_t exitSem = nullptr;
+    bool isInstalled          = false;
+    // Claimed through claimPeripheral(), a config set before that is kept for the power up
+    bool isPoweredUp = false;
+    hal::HalBase::Rs485Config_t config;
+    hal::HalBase::Rs485FrameCallback_t onFrame;
+    std::mutex statsMutex;
+    hal::HalBase::Rs485Stats_t stats;
+};
+static Rs485Data_t _rs485_data;
+
+static void dispatch_frame(std::vector<uint8_t>& frame)
+{
+    if (frame.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_rs485_data.statsMutex);
+        _rs485_data.stats.rxBytes += frame.size();
+        _rs485_data.stats.frames++;
+    }
+
+    if (_rs485_data.onFrame) {
+        _rs485_data.onFrame(frame.data(), frame.size());
+    } else {
+        auto& monitor  = GetHAL()->uartMonitorData;
+        size_t written = monitor.rxRing.write(frame.data(), frame.size());
+        monitor.rxDropped += frame.size() - written;
+    }
+    frame.clear();
+}
+
+// Append up to size buffered bytes to the frame, a frame that would outgrow the rx ring is passed on as it is
+static void read_into_frame(std::vector<uint8_t>& frame, size_t size)
 {
-    if (uart_write_bytes((uart_port_t)port, str, length) != length) {
-        ESP_LOGE(TAG, "Send data critical failure.");
-        // add your code to handle sending failure here
-        abort();
+    size_t max_frame = _rs485_data.config.rxRingSize;
+    while (size > 0) {
+        if (frame.size() >= max_frame) {
+            dispatch_frame(frame);
+        }
+        size_t chunk  = std::min(size, max_frame - frame.size());
+        size_t offset = frame.size();
+        frame.resize(offset + chunk);
+        int len = uart_read_bytes(tab5_rs485_uart_num, frame.data() + offset, chunk, 0);
+        frame.resize(offset + std::max(len, 0));
+        if (len <= 0) {
+            return;
+        }
+        size -= len;
     }
 }
 
-static void _rs485_test_task(void* param)
+static void count_event(uint32_t& counter)
 {
-    // Allocate buffers for UART
-    uint8_t* data  = (uint8_t*)malloc(TAB5_RS485_BUF_SIZE);
-    uint8_t* wdata = (uint8_t*)malloc(TAB5_RS485_BUF_SIZE);
+    std::lock_guard<std::mutex> lock(_rs485_data.statsMutex);
+    counter++;
+}
+
+static void _rs485_task(void* param)
+{
+    const auto& config = _rs485_data.config;
+    std::vector<uint8_t> frame;
+    frame.reserve(std::min<uint32_t>(config.rxRingSize, 2048));
 
-    int count               = 0;
-    uint64_t last_send_time = 0;
+    uart_event_t event;
     while (1) {
-        // Read data from UART
-        memset(data, 0, TAB5_RS485_BUF_SIZE);
-        int len = uart_read_bytes(tab5_rs485_uart_num, data, TAB5_RS485_BUF_SIZE, TAB5_RS485_PACKET_READ_TICS);
-
-        // Write data back to UART
-        if (len > 0) {
-            // printf("Received [%u] : %s\n", len, data);
-            // tab5_rs485_echo_send(tab5_rs485_uart_num, data, len);
-
-            std::lock_guard<std::mutex> lock(GetHAL()->uartMonitorData.mutex);
-            for (int i = 0; i < len; i++) {
-                GetHAL()->uartMonitorData.rxQueue.push(data[i]);
-            }
-            while (GetHAL()->uartMonitorData.rxQueue.size() > 4096) {
-                GetHAL()->uartMonitorData.rxQueue.pop();
-            }
+        if (xQueueReceive(_rs485_data.eventQueue, &event, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        if (event.type == _event_stop) {
+            break;
         }
 
-        {
-            std::lock_guard<std::mutex> lock(GetHAL()->uartMonitorData.mutex);
-            while (!GetHAL()->uartMonitorData.txQueue.empty()) {
-                uint8_t txData = GetHAL()->uartMonitorData.txQueue.front();
-                GetHAL()->uartMonitorData.txQueue.pop();
-                uart_write_bytes(tab5_rs485_uart_num, &txData, 1);
+        switch (event.type) {
+            case UART_DATA: {
+                size_t buffered = 0;
+                uart_get_buffered_data_len(tab5_rs485_uart_num, &buffered);
+                if (config.patternChar < 0) {
+                    // FIFO threshold events carry part of a frame, the idle timeout one ends it
+                    read_into_frame(frame, buffered);
+                    if (event.timeout_flag) {
+                        dispatch_frame(frame);
+                    }
+                } else if (buffered > config.rxRingSize / 2) {
+                    // The pattern events read the data, a line this long is taken early so the ring never fills
+                    read_into_frame(frame, buffered);
+                }
+                break;
             }
+            case UART_PATTERN_DET: {
+                // The driver moves the queued positions back as data is read
+                int pos = uart_pattern_pop_pos(tab5_rs485_uart_num);
+                if (pos < 0) {
+                    // Lost position or the pattern was already read with an early take, the frame ends here
+                    size_t buffered = 0;
+                    uart_get_buffered_data_len(tab5_rs485_uart_num, &buffered);
+                    read_into_frame(frame, buffered);
+                } else {
+                    read_into_frame(frame, pos + config.patternCount);
+                }
+                dispatch_frame(frame);
+                break;
+            }
+            case UART_FIFO_OVF:
+                // Data is already lost, start over from a clean state
+                count_event(_rs485_data.stats.fifoOverflows);
+                uart_flush_input(tab5_rs485_uart_num);
+                uart_pattern_queue_reset(tab5_rs485_uart_num, _pattern_queue_size);
+                frame.clear();
+                break;
+            case UART_BUFFER_FULL:
+                count_event(_rs485_data.stats.ringOverflows);
+                uart_flush_input(tab5_rs485_uart_num);
+                uart_pattern_queue_reset(tab5_rs485_uart_num, _pattern_queue_size);
+                frame.clear();
+                break;
+            case UART_BREAK:
+            case UART_PARITY_ERR:
+            case UART_FRAME_ERR:
+                count_event(_rs485_data.stats.lineErrors);
+                break;
+            default:
+                break;
         }
+    }
 
-        vTaskDelay(10 / portTICK_PERIOD_MS);
+    xSemaphoreGive(_rs485_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+// Lock _rs485_data.mutex before calling
+static void uninstall_rs485()
+{
+    if (!_rs485_data.isInstalled) {
+        return;
     }
+
+    uart_event_t stop_event = {};
+    stop_event.type         = _event_stop;
+    xQueueSend(_rs485_data.eventQueue, &stop_event, portMAX_DELAY);
+    xSemaphoreTake(_rs485_data.exitSem, portMAX_DELAY);
+
+    uart_driver_delete(tab5_rs485_uart_num);
+    _rs485_data.eventQueue  = nullptr;
+    _rs485_data.isInstalled = false;
 }
 
-void HalEsp32::rs485_init()
+// Lock _rs485_data.mutex before calling
+static bool install_rs485(const hal::HalBase::Rs485Config_t& config)
 {
-    mclog::tagInfo(TAG, "rs485 init");
+    uart_parity_t parity = UART_PARITY_DISABLE;
+    if (config.parity == hal::HalBase::RS485_PARITY_EVEN) {
+        parity = UART_PARITY_EVEN;
+    } else if (config.parity == hal::HalBase::RS485_PARITY_ODD) {
+        parity = UART_PARITY_ODD;
+    }
 
-    uart_config_t uart_config;
-    uart_config.baud_rate           = 115200;
+    uart_config_t uart_config       = {};
+    uart_config.baud_rate           = std::min(config.baudRate, _max_baud_rate);
     uart_config.data_bits           = UART_DATA_8_BITS;
-    uart_config.parity              = UART_PARITY_DISABLE;
+    uart_config.parity              = parity;
     uart_config.stop_bits           = UART_STOP_BITS_1;
     uart_config.flow_ctrl           = UART_HW_FLOWCTRL_DISABLE;
     uart_config.rx_flow_ctrl_thresh = 122;
     uart_config.source_clk          = UART_SCLK_DEFAULT;
 
-    // Install UART driver (we don't need an event queue here)
-    // In this example we don't even use a buffer for sending data.
-    ESP_ERROR_CHECK(uart_driver_install(tab5_rs485_uart_num, TAB5_RS485_BUF_SIZE * 2, 0, 0, NULL, 0));
+    // The rx ring has to be larger than the hardware FIFO
+    int rx_size = std::max<int>(config.rxRingSize, UART_HW_FIFO_LEN(tab5_rs485_uart_num) * 2);
+    int tx_size = config.txRingSize > 0 ? std::max<int>(config.txRingSize, UART_HW_FIFO_LEN(tab5_rs485_uart_num) * 2)
+                                        : 0;
+    esp_err_t ret = uart_driver_install(tab5_rs485_uart_num, rx_size, tx_size, _event_queue_size,
+                                        &_rs485_data.eventQueue, 0);
+    if (ret != ESP_OK) {
+        mclog::tagError(TAG, "install uart driver failed: {}", esp_err_to_name(ret));
+        return false;
+    }
 
-    // Configure UART parameters
     ESP_ERROR_CHECK(uart_param_config(tab5_rs485_uart_num, &uart_config));
-
-    ESP_LOGI(TAG, "UART set pins, mode and install driver.");
-
-    // Set UART pins as per KConfig settings
     ESP_ERROR_CHECK(uart_set_pin(tab5_rs485_uart_num, TAB5_SYS_RS485_TX_PIN, TAB5_SYS_RS485_RX_PIN,
                                  TAB5_SYS_RS485_DE_PIN, UART_PIN_NO_CHANGE));
 
-    // Set RS485 half duplex mode
+    // Set RS485 half duplex mode, the driver switches DE around each transmission
     ESP_ERROR_CHECK(uart_set_mode(tab5_rs485_uart_num, UART_MODE_RS485_HALF_DUPLEX));
 
-    // Set read timeout of UART TOUT feature
-    ESP_ERROR_CHECK(uart_set_rx_timeout(tab5_rs485_uart_num, TAB5_RS485_READ_TOUT));
+    // At high rates an earlier FIFO interrupt leaves room for the latency of the task switch
+    ESP_ERROR_CHECK(uart_set_rx_full_threshold(tab5_rs485_uart_num, config.baudRate > 1000000 ? 64 : 100));
+    ESP_ERROR_CHECK(uart_set_rx_timeout(tab5_rs485_uart_num, config.frameTimeoutSymbols));
+    if (config.patternChar >= 0) {
+        uart_enable_pattern_det_baud_intr(tab5_rs485_uart_num, (char)config.patternChar, config.patternCount, 9, 0, 0);
+        uart_pattern_queue_reset(tab5_rs485_uart_num, _pattern_queue_size);
+    }
+
+    _rs485_data.config = config;
+    if (_rs485_data.exitSem == nullptr) {
+        _rs485_data.exitSem = xSemaphoreCreateBinary();
+    }
+    if (xTaskCreate(_rs485_task, "rs485", 4096, NULL, 12, NULL) != pdPASS) {
+        mclog::tagError(TAG, "create task failed");
+        uart_driver_delete(tab5_rs485_uart_num);
+        _rs485_data.eventQueue = nullptr;
+        return false;
+    }
+    _rs485_data.isInstalled = true;
+
+    mclog::tagInfo(TAG, "baud {}, rx ring {}, tx ring {}, frame timeout {} symbols", uart_config.baud_rate, rx_size,
+                   tx_size, config.frameTimeoutSymbols);
+    return true;
+}
+
+bool HalEsp32::rs485_power_up()
+{
+    std::lock_guard<std::mutex> lock(_rs485_data.mutex);
+
+    mclog::tagInfo(TAG, "power up");
+    _rs485_data.isPoweredUp = install_rs485(_rs485_data.config);
+    return _rs485_data.isPoweredUp;
+}
 
-    xTaskCreate(_rs485_test_task, "rs485", 2000, NULL, 5, NULL);
+void HalEsp32::rs485_power_down()
+{
+    std::lock_guard<std::mutex> lock(_rs485_data.mutex);
+
+    // The task exits and the driver buffers are freed, the config stays for the next power up
+    mclog::tagInfo(TAG, "power down");
+    uninstall_rs485();
+    _rs485_data.isPoweredUp = false;
+}
+
+bool HalEsp32::setRs485Config(const Rs485Config_t& config, Rs485FrameCallback_t onFrame)
+{
+    std::lock_guard<std::mutex> lock(_rs485_data.mutex);
+
+    uninstall_rs485();
+    _rs485_data.config  = config;
+    _rs485_data.onFrame = onFrame;
+    {
+        std::lock_guard<std::mutex> stats_lock(_rs485_data.statsMutex);
+        _rs485_data.stats = Rs485Stats_t();
+    }
+    if (!_rs485_data.isPoweredUp) {
+        return true;
+    }
+    return install_rs485(config);
+}
+
+size_t HalEsp32::rs485Write(const uint8_t* data, size_t size)
+{
+    std::lock_guard<std::mutex> lock(_rs485_data.mutex);
+
+    if (!_rs485_data.isInstalled) {
+        return 0;
+    }
+
+    // Blocks only while the tx ring is full
+    int written = uart_write_bytes(tab5_rs485_uart_num, data, size);
+    if (written <= 0) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> stats_lock(_rs485_data.statsMutex);
+    _rs485_data.stats.txBytes += written;
+    return written;
+}
+
+hal::HalBase::Rs485Stats_t HalEsp32::getRs485Stats()
+{
+    std::lock_guard<std::mutex> lock(_rs485_data.statsMutex);
+    return _rs485_data.stats;
+}
+
+void HalEsp32::uartMonitorSend(std::string msg, bool newLine)
+{
+    if (newLine) {
+        msg += '\n';
+    }
+    rs485Write((const uint8_t*)msg.data(), msg.size());
 }
@@ -0,0 +1,298 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <errno.h>
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <lwip/sockets.h>
+
+static const std::string _tag = "rs485-gw";
+
+// One TCP segment, received straight into the block the UART tx ring takes it from
+static constexpr size_t _recv_block_size = 1460;
+// How often the task looks at the stop flag while the sockets are quiet
+static constexpr uint32_t _select_timeout_ms = 200;
+// A powered off or out of range client is dropped after idle + interval * count seconds
+static constexpr int _keepalive_idle_sec     = 10;
+static constexpr int _keepalive_interval_sec = 5;
+static constexpr int _keepalive_count        = 3;
+
+struct Rs485GatewayData_t {
+    std::mutex mutex;
+    std::atomic<bool> isRunning{false};
+    SemaphoreHandle_t exitSem = nullptr;
+    hal::HalBase::Rs485GatewayConfig_t config;
+    int listenSock = -1;
+    // Opened and closed by the gateway task, sent to by the RS485 task
+    std::mutex clientMutex;
+    int clientSock = -1;
+    uint8_t block[_recv_block_size];
+    std::mutex statsMutex;
+    hal::HalBase::Rs485GatewayStats_t stats;
+};
+static Rs485GatewayData_t _gateway_data;
+
+static void count_dropped_frame()
+{
+    std::lock_guard<std::mutex> lock(_gateway_data.statsMutex);
+    _gateway_data.stats.droppedFrames++;
+}
+
+// Called on the RS485 task with its own frame buffer, which goes to send() as it is. While the client is slow the
+// task waits here and the line backs up in the UART rx ring
+static void on_frame(const uint8_t* data, size_t size)
+{
+    std::lock_guard<std::mutex> lock(_gateway_data.clientMutex);
+
+    int sock = _gateway_data.clientSock;
+    if (sock < 0) {
+        count_dropped_frame();
+        return;
+    }
+
+    size_t sent = 0;
+    while (sent < size) {
+        int ret = send(sock, data + sent, size - sent, 0);
+        if (ret < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                // The gateway task sees the closed socket and drops the client
+                shutdown(sock, SHUT_RDWR);
+            }
+            break;
+        }
+        sent += ret;
+    }
+
+    std::lock_guard<std::mutex> stats_lock(_gateway_data.statsMutex);
+    _gateway_data.stats.toTcpBytes += sent;
+    if (sent < size) {
+        _gateway_data.stats.droppedFrames++;
+    } else {
+        _gateway_data.stats.frames++;
+    }
+}
+
+static int listen_on(uint16_t port)
+{
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0) {
+        mclog::tagError(_tag, "socket failed: {}", strerror(errno));
+        return -1;
+    }
+    int reuse = 1;
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    struct sockaddr_in addr = {};
+    addr.sin_family         = AF_INET;
+    addr.sin_port           = htons(port);
+    addr.sin_addr.s_addr    = htonl(INADDR_ANY);
+    if (bind(sock, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(sock, 1) != 0) {
+        mclog::tagError(_tag, "listen on port {} failed: {}", port, strerror(errno));
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+static void setup_client(int sock)
+{
+    // Frames are already batched by the idle timeout, Nagle would only hold them back
+    int enable = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    setsockopt(sock, SOL_SOCKET, SO_KEEPALIVE, &enable, sizeof(enable));
+    int idle     = _keepalive_idle_sec;
+    int interval = _keepalive_interval_sec;
+    int count    = _keepalive_count;
+    setsockopt(sock, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle));
+    setsockopt(sock, IPPROTO_TCP, TCP_KEEPINTVL, &interval, sizeof(interval));
+    setsockopt(sock, IPPROTO_TCP, TCP_KEEPCNT, &count, sizeof(count));
+
+    uint32_t ms       = _gateway_data.config.sendTimeoutMs;
+    struct timeval tv = {(time_t)(ms / 1000), (suseconds_t)(ms % 1000 * 1000)};
+    setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+// Run on the gateway task only
+static void set_client(int sock, const std::string& peer)
+{
+    {
+        std::lock_guard<std::mutex> lock(_gateway_data.clientMutex);
+        if (_gateway_data.clientSock >= 0) {
+            close(_gateway_data.clientSock);
+        }
+        _gateway_data.clientSock = sock;
+    }
+
+    std::lock_guard<std::mutex> lock(_gateway_data.statsMutex);
+    _gateway_data.stats.client = peer;
+    if (sock >= 0) {
+        _gateway_data.stats.clients++;
+    }
+}
+
+static void accept_client()
+{
+    struct sockaddr_in addr = {};
+    socklen_t addr_len      = sizeof(addr);
+    int sock                = accept(_gateway_data.listenSock, (struct sockaddr*)&addr, &addr_len);
+    if (sock < 0) {
+        return;
+    }
+    setup_client(sock);
+
+    char ip[INET_ADDRSTRLEN] = {};
+    inet_ntoa_r(addr.sin_addr, ip, sizeof(ip));
+    std::string peer = fmt::format("{}:{}", ip, ntohs(addr.sin_port));
+    mclog::tagInfo(_tag, "client {}{}", peer, _gateway_data.clientSock >= 0 ? ", replacing the last one" : "");
+    set_client(sock, peer);
+}
+
+// The tx ring takes the block, a full ring holds the task here and the TCP window closes behind it
+static void forward_to_rs485(int sock)
+{
+    int len = recv(sock, _gateway_data.block, sizeof(_gateway_data.block), 0);
+    if (len <= 0) {
+        mclog::tagInfo(_tag, "client closed");
+        set_client(-1, "");
+        return;
+    }
+
+    size_t written = 0;
+    while (written < (size_t)len && _gateway_data.isRunning) {
+        size_t ret = GetHAL()->rs485Write(_gateway_data.block + written, len - written);
+        if (ret == 0) {
+            break;
+        }
+        written += ret;
+    }
+
+    std::lock_guard<std::mutex> lock(_gateway_data.statsMutex);
+    _gateway_data.stats.toRs485Bytes += written;
+}
+
+static void _gateway_task(void* param)
+{
+    while (_gateway_data.isRunning) {
+        // Only this task changes the client, no lock to read it
+        int client = _gateway_data.clientSock;
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(_gateway_data.listenSock, &fds);
+        if (client >= 0) {
+            FD_SET(client, &fds);
+        }
+        struct timeval tv = {0, (suseconds_t)(_select_timeout_ms * 1000)};
+        int max_sock      = std::max(_gateway_data.listenSock, client);
+        if (select(max_sock + 1, &fds, nullptr, nullptr, &tv) <= 0) {
+            continue;
+        }
+
+        if (FD_ISSET(_gateway_data.listenSock, &fds)) {
+            accept_client();
+            continue;
+        }
+        if (client >= 0 && FD_ISSET(client, &fds)) {
+            forward_to_rs485(client);
+        }
+    }
+
+    set_client(-1, "");
+    xSemaphoreGive(_gateway_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+bool HalEsp32::startRs485Gateway(const Rs485GatewayConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_gateway_data.mutex);
+
+    if (_gateway_data.isRunning) {
+        mclog::tagWarn(_tag, "already running");
+        return false;
+    }
+    if (isModbusRunning()) {
+        mclog::tagError(_tag, "port taken by modbus");
+        return false;
+    }
+
+    _gateway_data.config = config;
+    _gateway_data.stats  = Rs485GatewayStats_t();
+    if (_gateway_data.exitSem == nullptr) {
+        _gateway_data.exitSem = xSemaphoreCreateBinary();
+    }
+
+    _gateway_data.listenSock = listen_on(config.tcpPort);
+    if (_gateway_data.listenSock < 0) {
+        return false;
+    }
+
+    // Frames are cut by the UART idle timeout, a pattern would split a binary protocol at random
+    Rs485Config_t port = config.port;
+    port.patternChar   = -1;
+
+    if (!claimPeripheral(PERIPHERAL_RS485, "rs485-gateway")) {
+        close(_gateway_data.listenSock);
+        _gateway_data.listenSock = -1;
+        return false;
+    }
+    if (!setRs485Config(port, on_frame)) {
+        releasePeripheral(PERIPHERAL_RS485, "rs485-gateway");
+        close(_gateway_data.listenSock);
+        _gateway_data.listenSock = -1;
+        return false;
+    }
+
+    _gateway_data.isRunning = true;
+    if (xTaskCreate(_gateway_task, "rs485_gw", 4096, nullptr, 11, nullptr) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _gateway_data.isRunning = false;
+        setRs485Config(Rs485Config_t());
+        releasePeripheral(PERIPHERAL_RS485, "rs485-gateway");
+        close(_gateway_data.listenSock);
+        _gateway_data.listenSock = -1;
+        return false;
+    }
+
+    auto wifi = getWifiStatus();
+    mclog::tagInfo(_tag, "start on {}:{}, baud {}, frame timeout {} symbols",
+                   wifi.ip.empty() ? "0.0.0.0" : wifi.ip, config.tcpPort, port.baudRate, port.frameTimeoutSymbols);
+    return true;
+}
+
+void HalEsp32::stopRs485Gateway()
+{
+    std::lock_guard<std::mutex> lock(_gateway_data.mutex);
+
+    if (!_gateway_data.isRunning) {
+        return;
+    }
+
+    // The task closes the client on its way out, the RS485 task then drops what it receives
+    _gateway_data.isRunning = false;
+    xSemaphoreTake(_gateway_data.exitSem, portMAX_DELAY);
+    close(_gateway_data.listenSock);
+    _gateway_data.listenSock = -1;
+
+    setRs485Config(Rs485Config_t());
+    releasePeripheral(PERIPHERAL_RS485, "rs485-gateway");
+    mclog::tagInfo(_tag, "stop");
+}
+
+bool HalEsp32::isRs485GatewayRunning()
+{
+    return _gateway_data.isRunning;
+}
+
+hal::HalBase::Rs485GatewayStats_t HalEsp32::getRs485GatewayStats()
+{
+    std::lock_guard<std::mutex> lock(_gateway_data.statsMutex);
+    return _gateway_data.stats;
+}
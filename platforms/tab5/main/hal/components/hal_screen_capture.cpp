@@ -0,0 +1,611 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include "../utils/task_controller/task_controller.h"
+#include "../utils/aligned_file_writer/aligned_file_writer.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <bsp/m5stack_tab5.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <esp_timer.h>
+#include <esp_http_server.h>
+#include <esp_lvgl_port.h>
+#include <driver/jpeg_encode.h>
+#include <driver/ppa.h>
+
+static const std::string _tag = "screen-capture";
+
+static const char* _capture_dir = "/sd/captures";
+// One frame is encoded while the next one is copied, a recording tick that finds both busy drops its frame
+static constexpr int _frame_count = 2;
+// The writer task and the frame buffers go away after this long without a capture
+static constexpr uint32_t _idle_close_ms   = 5000;
+static constexpr uint8_t _max_record_fps   = 10;
+static constexpr uint8_t _http_quality     = 80;
+static constexpr uint32_t _http_timeout_ms = 3000;
+
+enum CaptureTarget_t {
+    CAPTURE_SCREENSHOT = 0,
+    CAPTURE_RECORDING,
+    CAPTURE_HTTP,
+};
+
+struct CaptureFrame_t {
+    // In LVGL orientation, the encoder input
+    uint8_t* pixels        = nullptr;
+    int32_t width          = 0;
+    int32_t height         = 0;
+    CaptureTarget_t target = CAPTURE_SCREENSHOT;
+    uint8_t quality        = 0;
+    // Recording session or HTTP request number
+    uint32_t request = 0;
+};
+
+// Writer only
+struct RecordFile_t {
+    FILE* file       = nullptr;
+    uint32_t session = 0;
+    std::string path;
+};
+
+struct ScreenCaptureData_t {
+    // Everything except the frame the writer is encoding, also taken by the LVGL task for the copy
+    std::mutex mutex;
+    TaskController_t writerTask;
+    bool isOpen               = false;
+    QueueHandle_t freeQueue   = nullptr;
+    QueueHandle_t filledQueue = nullptr;
+    CaptureFrame_t frames[_frame_count];
+    size_t frameSize              = 0;
+    ppa_client_handle_t ppa       = nullptr;
+    jpeg_encoder_handle_t encoder = nullptr;
+    uint8_t* jpeg                 = nullptr;
+    size_t jpegSize               = 0;
+    // UI commands posted and not run yet
+    uint32_t pendingCaptures = 0;
+    uint32_t lastActivity    = 0;
+    // Writer only, numbering carries on from the last file found on the card
+    uint32_t nextFileIndex = 0;
+    bool isRecording       = false;
+    hal::HalBase::ScreenRecordConfig_t recordConfig;
+    uint32_t recordSession = 0;
+    uint32_t recordStart   = 0;
+    uint32_t nextTick      = 0;
+    // The HTTP handler waits for the result of its own request number
+    SemaphoreHandle_t httpDone = nullptr;
+    uint32_t httpRequest       = 0;
+    uint32_t httpResult        = 0;
+    std::vector<uint8_t> httpJpeg;
+    hal::HalBase::ScreenCaptureStats_t stats;
+};
+static ScreenCaptureData_t _capture_data;
+
+static void screen_capture_writer_loop(TaskController_t& task);
+
+/* -------------------------------------------------------------------------- */
+/*                                  Buffers                                   */
+/* -------------------------------------------------------------------------- */
+// Lock _capture_data.mutex before calling
+static void free_capture_buffers()
+{
+    auto& data = _capture_data;
+    if (data.encoder) {
+        jpeg_del_encoder_engine(data.encoder);
+        data.encoder = nullptr;
+    }
+    if (data.ppa) {
+        ppa_unregister_client(data.ppa);
+        data.ppa = nullptr;
+    }
+    for (auto& frame : data.frames) {
+        free(frame.pixels);
+        frame.pixels = nullptr;
+    }
+    free(data.jpeg);
+    data.jpeg = nullptr;
+    if (data.freeQueue) {
+        xQueueReset(data.freeQueue);
+        xQueueReset(data.filledQueue);
+    }
+}
+
+// Lock _capture_data.mutex before calling
+static bool open_capture()
+{
+    auto& data = _capture_data;
+    if (data.isOpen) {
+        return true;
+    }
+    // The previous writer may still be on its way out
+    if (data.writerTask.isRunning()) {
+        data.writerTask.stop();
+    }
+
+    lv_display_t* disp = GetHAL()->lvDisp;
+    if (disp == nullptr || lv_display_get_color_format(disp) != LV_COLOR_FORMAT_RGB565) {
+        mclog::tagError(_tag, "needs an rgb565 display");
+        return false;
+    }
+    if (data.freeQueue == nullptr) {
+        data.freeQueue   = xQueueCreate(_frame_count, sizeof(CaptureFrame_t*));
+        data.filledQueue = xQueueCreate(_frame_count, sizeof(CaptureFrame_t*));
+        data.httpDone    = xSemaphoreCreateBinary();
+    }
+
+    ppa_client_config_t ppa_config = {
+        .oper_type             = PPA_OPERATION_SRM,
+        .max_pending_trans_num = 1,
+    };
+    jpeg_encode_engine_cfg_t engine_cfg = {
+        .intr_priority = 0,
+        .timeout_ms    = 200,
+    };
+    if (ppa_register_client(&ppa_config, &data.ppa) != ESP_OK ||
+        jpeg_new_encoder_engine(&engine_cfg, &data.encoder) != ESP_OK) {
+        mclog::tagError(_tag, "failed to create ppa client or jpeg encoder");
+        free_capture_buffers();
+        return false;
+    }
+
+    // Both orientations have the same size, the JPEG of a screen is far below a byte per pixel
+    size_t allocated = 0;
+    data.frameSize   = lv_display_get_physical_horizontal_resolution(disp) *
+                     lv_display_get_physical_vertical_resolution(disp) * 2;
+    jpeg_encode_memory_alloc_cfg_t in_cfg  = {.buffer_direction = JPEG_ENC_ALLOC_INPUT_BUFFER};
+    jpeg_encode_memory_alloc_cfg_t out_cfg = {.buffer_direction = JPEG_ENC_ALLOC_OUTPUT_BUFFER};
+    bool is_ok                             = true;
+    for (auto& frame : data.frames) {
+        frame.pixels = (uint8_t*)jpeg_alloc_encoder_mem(data.frameSize, &in_cfg, &allocated);
+        is_ok &= frame.pixels != nullptr;
+    }
+    data.jpeg = (uint8_t*)jpeg_alloc_encoder_mem(data.frameSize / 2, &out_cfg, &data.jpegSize);
+    if (!is_ok || data.jpeg == nullptr) {
+        mclog::tagError(_tag, "malloc for {} frames of {} KB failed", _frame_count, data.frameSize / 1024);
+        free_capture_buffers();
+        return false;
+    }
+    for (auto& frame : data.frames) {
+        CaptureFrame_t* free_frame = &frame;
+        xQueueSend(data.freeQueue, &free_frame, 0);
+    }
+
+    data.isOpen       = true;
+    data.lastActivity = GetHAL()->millis();
+    if (!data.writerTask.start("screen_cap", 6144, 2, -1, screen_capture_writer_loop)) {
+        mclog::tagError(_tag, "create task failed");
+        data.isOpen = false;
+        free_capture_buffers();
+        return false;
+    }
+    mclog::tagInfo(_tag, "open, {} KB of frame buffers", (_frame_count * data.frameSize + data.jpegSize) / 1024);
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                   Capture                                  */
+/* -------------------------------------------------------------------------- */
+// Lock _capture_data.mutex before calling, an empty JPEG reports a failed request
+static void finish_http(uint32_t request, const uint8_t* jpeg, size_t size)
+{
+    auto& data      = _capture_data;
+    data.httpResult = request;
+    data.httpJpeg.assign(jpeg, jpeg + size);
+    xSemaphoreGive(data.httpDone);
+}
+
+// The PPA undoes the rotation the LVGL port applies on the way to the panel
+static ppa_srm_rotation_angle_t get_capture_rotation(lv_display_t* disp)
+{
+    switch (lv_display_get_rotation(disp)) {
+        case LV_DISPLAY_ROTATION_90:
+            return PPA_SRM_ROTATION_ANGLE_90;
+        case LV_DISPLAY_ROTATION_180:
+            return PPA_SRM_ROTATION_ANGLE_180;
+        case LV_DISPLAY_ROTATION_270:
+            return PPA_SRM_ROTATION_ANGLE_270;
+        default:
+            return PPA_SRM_ROTATION_ANGLE_0;
+    }
+}
+
+// UI command, runs between two LVGL frames, so the front buffer holds a finished frame nothing writes meanwhile
+static void capture_frame(CaptureTarget_t target, uint8_t quality, uint32_t request)
+{
+    auto& data = _capture_data;
+    std::lock_guard<std::mutex> lock(data.mutex);
+    data.pendingCaptures--;
+
+    CaptureFrame_t* frame = nullptr;
+    if (!data.isOpen || xQueueReceive(data.freeQueue, &frame, 0) != pdTRUE) {
+        if (target == CAPTURE_RECORDING) {
+            data.stats.droppedFrames++;
+        } else {
+            mclog::tagWarn(_tag, "no free frame, capture dropped");
+        }
+        if (target == CAPTURE_HTTP) {
+            finish_http(request, nullptr, 0);
+        }
+        return;
+    }
+
+    lv_display_t* disp = GetHAL()->lvDisp;
+    const void* front  = nullptr;
+    frame->width       = lv_display_get_horizontal_resolution(disp);
+    frame->height      = lv_display_get_vertical_resolution(disp);
+    int32_t panel_w    = lv_display_get_physical_horizontal_resolution(disp);
+    int32_t panel_h    = lv_display_get_physical_vertical_resolution(disp);
+
+    int64_t start = esp_timer_get_time();
+    esp_err_t ret = lvgl_port_get_front_buffer(disp, &front);
+    if (ret == ESP_OK) {
+        ppa_srm_oper_config_t srm_config = {.in             = {.buffer         = front,
+                                                               .pic_w          = (uint32_t)panel_w,
+                                                               .pic_h          = (uint32_t)panel_h,
+                                                               .block_w        = (uint32_t)panel_w,
+                                                               .block_h        = (uint32_t)panel_h,
+                                                               .block_offset_x = 0,
+                                                               .block_offset_y = 0,
+                                                               .srm_cm         = PPA_SRM_COLOR_MODE_RGB565},
+                                            .out            = {.buffer         = frame->pixels,
+                                                               .buffer_size    = (uint32_t)data.frameSize,
+                                                               .pic_w          = (uint32_t)frame->width,
+                                                               .pic_h          = (uint32_t)frame->height,
+                                                               .block_offset_x = 0,
+                                                               .block_offset_y = 0,
+                                                               .srm_cm         = PPA_SRM_COLOR_MODE_RGB565},
+                                            .rotation_angle = get_capture_rotation(disp),
+                                            .scale_x        = 1.0f,
+                                            .scale_y        = 1.0f,
+                                            .mirror_x       = false,
+                                            .mirror_y       = false,
+                                            .rgb_swap       = false,
+                                            .byte_swap      = false,
+                                            .mode           = PPA_TRANS_MODE_BLOCKING,
+                                            .user_data      = nullptr};
+        ret = ppa_do_scale_rotate_mirror(data.ppa, &srm_config);
+    }
+    if (ret != ESP_OK) {
+        mclog::tagError(_tag, "copy from the panel frame buffer failed: {}", esp_err_to_name(ret));
+        xQueueSend(data.freeQueue, &frame, 0);
+        if (target == CAPTURE_HTTP) {
+            finish_http(request, nullptr, 0);
+        }
+        return;
+    }
+    data.stats.lastCopyUs = esp_timer_get_time() - start;
+
+    frame->target  = target;
+    frame->quality = quality;
+    frame->request = request;
+    xQueueSend(data.filledQueue, &frame, 0);
+}
+
+// Lock _capture_data.mutex before calling
+static bool request_capture(CaptureTarget_t target, uint8_t quality, uint32_t request)
+{
+    auto& data = _capture_data;
+    if (!open_capture()) {
+        return false;
+    }
+    data.pendingCaptures++;
+    data.lastActivity = GetHAL()->millis();
+    if (!GetHAL()->postUiCommand([target, quality, request]() { capture_frame(target, quality, request); })) {
+        data.pendingCaptures--;
+        return false;
+    }
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                   Writer                                   */
+/* -------------------------------------------------------------------------- */
+// The first free name from the last one used
+static std::string next_capture_path(const char* prefix, const char* ext)
+{
+    struct stat st;
+    std::string path;
+    mkdir(_capture_dir, 0777);
+    do {
+        path = fmt::format("{}/{}_{:04d}.{}", _capture_dir, prefix, _capture_data.nextFileIndex++, ext);
+    } while (stat(path.c_str(), &st) == 0);
+    return path;
+}
+
+static void save_screenshot(const uint8_t* jpeg, size_t size)
+{
+    auto& data       = _capture_data;
+    std::string path = next_capture_path("shot", "jpg");
+    FILE* file       = fopen(path.c_str(), "wb");
+    bool is_ok       = file != nullptr && fwrite(jpeg, 1, size, file) == size;
+    if (file != nullptr) {
+        is_ok &= fclose(file) == 0;
+    }
+
+    std::lock_guard<std::mutex> lock(data.mutex);
+    if (!is_ok) {
+        mclog::tagError(_tag, "write {} failed", path);
+        return;
+    }
+    data.stats.screenshots++;
+    data.stats.bytesWritten += size;
+    data.stats.lastFile = path;
+    mclog::tagInfo(_tag, "screenshot {}, {} KB", path, size / 1024);
+}
+
+static void close_record(RecordFile_t& record)
+{
+    if (record.file == nullptr) {
+        return;
+    }
+    // The last block of the aligned writer goes out here
+    fclose(record.file);
+    record.file = nullptr;
+
+    std::lock_guard<std::mutex> lock(_capture_data.mutex);
+    _capture_data.stats.lastFile = record.path;
+    mclog::tagInfo(_tag, "recording {} closed, {} frames", record.path, _capture_data.stats.frames);
+}
+
+static void write_record_frame(const CaptureFrame_t& frame, const uint8_t* jpeg, size_t size, RecordFile_t& record)
+{
+    auto& data = _capture_data;
+    // A frame captured for a recording that is already closed
+    if (frame.request < record.session || (frame.request == record.session && record.file == nullptr)) {
+        return;
+    }
+    if (frame.request > record.session) {
+        close_record(record);
+        record.session = frame.request;
+        record.path    = next_capture_path("rec", "mjpeg");
+        record.file    = aligned_file_fopen(record.path.c_str());
+        if (record.file == nullptr) {
+            mclog::tagError(_tag, "open {} failed", record.path);
+            std::lock_guard<std::mutex> lock(data.mutex);
+            if (data.recordSession == record.session) {
+                data.isRecording = false;
+            }
+            return;
+        }
+    }
+
+    bool is_ok = fwrite(jpeg, 1, size, record.file) == size;
+    std::lock_guard<std::mutex> lock(data.mutex);
+    if (!is_ok) {
+        mclog::tagError(_tag, "write {} failed, recording stopped", record.path);
+        if (data.recordSession == record.session) {
+            data.isRecording = false;
+        }
+        return;
+    }
+    data.stats.frames++;
+    data.stats.bytesWritten += size;
+}
+
+static void write_frame(const CaptureFrame_t& frame, RecordFile_t& record)
+{
+    auto& data = _capture_data;
+
+    // The recording frames keep the chroma at half resolution, stills keep it whole for sharp text
+    jpeg_encode_cfg_t enc_cfg = {
+        .height        = (uint32_t)frame.height,
+        .width         = (uint32_t)frame.width,
+        .src_type      = JPEG_ENCODE_IN_FORMAT_RGB565,
+        .sub_sample    = frame.target == CAPTURE_RECORDING ? JPEG_DOWN_SAMPLING_YUV420 : JPEG_DOWN_SAMPLING_YUV444,
+        .image_quality = frame.quality,
+    };
+    uint32_t jpeg_size = 0;
+    int64_t start      = esp_timer_get_time();
+    esp_err_t ret      = jpeg_encoder_process(data.encoder, &enc_cfg, frame.pixels, data.frameSize, data.jpeg,
+                                              data.jpegSize, &jpeg_size);
+    uint32_t encode_us = esp_timer_get_time() - start;
+    if (ret != ESP_OK) {
+        std::lock_guard<std::mutex> lock(data.mutex);
+        data.stats.encodeFails++;
+        if (frame.target == CAPTURE_HTTP) {
+            finish_http(frame.request, nullptr, 0);
+        }
+        return;
+    }
+
+    switch (frame.target) {
+        case CAPTURE_SCREENSHOT:
+            save_screenshot(data.jpeg, jpeg_size);
+            break;
+        case CAPTURE_RECORDING:
+            write_record_frame(frame, data.jpeg, jpeg_size, record);
+            break;
+        case CAPTURE_HTTP: {
+            std::lock_guard<std::mutex> lock(data.mutex);
+            finish_http(frame.request, data.jpeg, jpeg_size);
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(data.mutex);
+    data.stats.lastEncodeUs = encode_us;
+    data.lastActivity       = GetHAL()->millis();
+}
+
+// Lock _capture_data.mutex before calling, returns how long the writer may wait for a frame
+static TickType_t update_recording()
+{
+    auto& data   = _capture_data;
+    uint32_t now = GetHAL()->millis();
+    if (!data.isRecording) {
+        return pdMS_TO_TICKS(100);
+    }
+
+    const auto& config = data.recordConfig;
+    if (config.maxDurationSec > 0 && now - data.recordStart >= config.maxDurationSec * 1000) {
+        data.isRecording = false;
+        mclog::tagInfo(_tag, "recording reached {} s", config.maxDurationSec);
+        return pdMS_TO_TICKS(100);
+    }
+
+    uint32_t interval_ms = 1000 / config.fps;
+    if ((int32_t)(now - data.nextTick) >= 0) {
+        // A late tick is not made up for, the frame rate only drops
+        data.nextTick = std::max(data.nextTick + interval_ms, now + 1);
+        request_capture(CAPTURE_RECORDING, config.quality, data.recordSession);
+    }
+    return pdMS_TO_TICKS(std::min<uint32_t>(data.nextTick - now, 100));
+}
+
+static void screen_capture_writer_loop(TaskController_t& task)
+{
+    auto& data = _capture_data;
+    RecordFile_t record;
+
+    while (!task.isStopRequested()) {
+        TickType_t wait = 0;
+        {
+            std::lock_guard<std::mutex> lock(data.mutex);
+            wait = update_recording();
+        }
+
+        // Encoded and written without the lock, the LVGL task copies the next frame meanwhile
+        CaptureFrame_t* frame = nullptr;
+        if (xQueueReceive(data.filledQueue, &frame, std::max<TickType_t>(wait, 1)) == pdTRUE) {
+            write_frame(*frame, record);
+            xQueueSend(data.freeQueue, &frame, 0);
+        }
+
+        bool is_record_over = false;
+        {
+            std::lock_guard<std::mutex> lock(data.mutex);
+            bool is_drained = data.pendingCaptures == 0 && uxQueueMessagesWaiting(data.filledQueue) == 0;
+            is_record_over  = record.file != nullptr && is_drained &&
+                             (!data.isRecording || data.recordSession != record.session);
+            // Every frame is back in the free queue once drained, nothing else holds one
+            if (record.file == nullptr && is_drained && !data.isRecording &&
+                GetHAL()->millis() - data.lastActivity >= _idle_close_ms) {
+                free_capture_buffers();
+                data.isOpen = false;
+                mclog::tagInfo(_tag, "close");
+                return;
+            }
+        }
+        if (is_record_over) {
+            close_record(record);
+        }
+    }
+    close_record(record);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    HTTP                                    */
+/* -------------------------------------------------------------------------- */
+static esp_err_t screenshot_get_handler(httpd_req_t* req)
+{
+    auto& data = _capture_data;
+    uint32_t request;
+    {
+        std::lock_guard<std::mutex> lock(data.mutex);
+        request = ++data.httpRequest;
+        if (!request_capture(CAPTURE_HTTP, _http_quality, request)) {
+            httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "capture failed");
+            return ESP_OK;
+        }
+    }
+
+    // A result left over from a request that timed out is skipped
+    std::vector<uint8_t> jpeg;
+    while (xSemaphoreTake(data.httpDone, pdMS_TO_TICKS(_http_timeout_ms)) == pdTRUE) {
+        std::lock_guard<std::mutex> lock(data.mutex);
+        if (data.httpResult == request) {
+            jpeg.swap(data.httpJpeg);
+            break;
+        }
+    }
+    if (jpeg.empty()) {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "capture failed");
+        return ESP_OK;
+    }
+
+    httpd_resp_set_type(req, "image/jpeg");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    return httpd_resp_send(req, (const char*)jpeg.data(), jpeg.size());
+}
+
+// Called by start_webserver() in hal_wifi.cpp
+void screen_capture_register_handlers(httpd_handle_t server)
+{
+    static httpd_uri_t get_uri = {};
+    get_uri.uri                = "/screenshot.jpg";
+    get_uri.method             = HTTP_GET;
+    get_uri.handler            = screenshot_get_handler;
+    httpd_register_uri_handler(server, &get_uri);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                     HAL                                    */
+/* -------------------------------------------------------------------------- */
+bool HalEsp32::takeScreenshot(uint8_t quality)
+{
+    if (!isSdCardMounted()) {
+        mclog::tagWarn(_tag, "no sd card for the screenshot");
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(_capture_data.mutex);
+    return request_capture(CAPTURE_SCREENSHOT, quality, 0);
+}
+
+bool HalEsp32::startScreenRecording(const ScreenRecordConfig_t& config)
+{
+    auto& data = _capture_data;
+    if (!isSdCardMounted()) {
+        mclog::tagWarn(_tag, "no sd card for the recording");
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(data.mutex);
+
+    if (data.isRecording) {
+        return true;
+    }
+    if (config.fps == 0) {
+        mclog::tagError(_tag, "invalid config");
+        return false;
+    }
+    if (!open_capture()) {
+        return false;
+    }
+
+    data.recordConfig     = config;
+    data.recordConfig.fps = std::min(config.fps, _max_record_fps);
+    data.recordSession++;
+    data.recordStart         = millis();
+    data.nextTick            = data.recordStart;
+    data.stats.frames        = 0;
+    data.stats.droppedFrames = 0;
+    data.isRecording         = true;
+    mclog::tagInfo(_tag, "recording start, {} fps quality {}", data.recordConfig.fps, config.quality);
+    return true;
+}
+
+void HalEsp32::stopScreenRecording()
+{
+    std::lock_guard<std::mutex> lock(_capture_data.mutex);
+    if (!_capture_data.isRecording) {
+        return;
+    }
+    // The writer closes the file once the frames still in flight are written
+    _capture_data.isRecording = false;
+    mclog::tagInfo(_tag, "recording stop");
+}
+
+hal::HalBase::ScreenCaptureStats_t HalEsp32::getScreenCaptureStats()
+{
+    std::lock_guard<std::mutex> lock(_capture_data.mutex);
+    ScreenCaptureStats_t stats = _capture_data.stats;
+    stats.isRecording          = _capture_data.isRecording;
+    return stats;
+}
@@ -0,0 +1,475 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <shared/shared.h>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <bsp/m5stack_tab5.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+
+static const std::string _tag = "sd_card";
+
+static char _mount_point[]         = "/sd";
+static constexpr size_t _max_files = 25;
+// The slot has no card detect line, a mounted card is asked for its status instead
+static constexpr uint32_t _check_interval_ms = 1000;
+// Probing an empty slot is a full init attempt, so it backs off
+static constexpr uint32_t _probe_interval_min_ms = 1000;
+static constexpr uint32_t _probe_interval_max_ms = 8000;
+// Pages waiting for the UI, the scan pauses once it is this far ahead
+static constexpr size_t _page_queue_max = 4;
+// A scan nobody reads any more is dropped
+static constexpr uint32_t _page_timeout_ms = 5000;
+
+struct SdCardData_t {
+    std::mutex mutex;
+    std::atomic<bool> isMounted = false;
+    TaskHandle_t task           = nullptr;
+    // Scan request and the pages not yet taken
+    std::mutex scanMutex;
+    uint32_t scanId     = 0;
+    uint32_t nextScanId = 1;
+    bool isScanPending  = false;
+    std::string scanPath;
+    size_t scanPageSize = 32;
+    std::deque<hal::HalBase::SdCardScanPage_t> pages;
+};
+static SdCardData_t _sd_card_data;
+
+static std::string to_sd_path(const std::string& dirPath)
+{
+    return std::string(_mount_point) + "/" + dirPath;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Mount                                   */
+/* -------------------------------------------------------------------------- */
+bool HalEsp32::mount_sd_card()
+{
+    if (_sd_card_data.isMounted) {
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_sd_card_data.mutex);
+        if (_sd_card_data.isMounted) {
+            return true;
+        }
+        if (bsp_sdcard_init(_mount_point, _max_files) != ESP_OK) {
+            return false;
+        }
+        _sd_card_data.isMounted = true;
+    }
+
+    mclog::tagInfo(_tag, "mounted at {}", _mount_point);
+    GetEventBus().publish({shared_data::EVENT_TOPIC_SD_CARD, 0, 1});
+    return true;
+}
+
+// Returns false when the card is gone, it is unmounted so the next probe can pick up a new one
+static bool check_sd_card()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sd_card_data.mutex);
+        if (!_sd_card_data.isMounted || bsp_sdcard_get_status() == ESP_OK) {
+            return true;
+        }
+        bsp_sdcard_deinit(_mount_point);
+        _sd_card_data.isMounted = false;
+    }
+
+    mclog::tagWarn(_tag, "card removed");
+    GetEventBus().publish({shared_data::EVENT_TOPIC_SD_CARD, 0, 0});
+    return false;
+}
+
+bool HalEsp32::isSdCardMounted()
+{
+    return _sd_card_data.isMounted;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Scan                                    */
+/* -------------------------------------------------------------------------- */
+std::vector<hal::HalBase::FileEntry_t> HalEsp32::scanSdCard(const std::string& dirPath)
+{
+    std::vector<FileEntry_t> file_entries;
+    if (!mount_sd_card()) {
+        return file_entries;
+    }
+
+    std::string target_path = to_sd_path(dirPath);
+    DIR* dir                = opendir(target_path.c_str());
+    if (dir == nullptr) {
+        mclog::tagError(_tag, "failed to open directory: {}", target_path);
+        return file_entries;
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (std::string(entry->d_name) == "." || std::string(entry->d_name) == "..") {
+            continue;
+        }
+        file_entries.push_back({entry->d_name, entry->d_type == DT_DIR});
+    }
+    closedir(dir);
+    return file_entries;
+}
+
+// Waits while the UI is behind, false once the scan was cancelled, replaced or left unread
+static bool push_scan_page(hal::HalBase::SdCardScanPage_t& page)
+{
+    uint32_t waited_ms = 0;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(_sd_card_data.scanMutex);
+            if (_sd_card_data.scanId != page.scanId || _sd_card_data.isScanPending) {
+                return false;
+            }
+            if (_sd_card_data.pages.size() < _page_queue_max) {
+                _sd_card_data.pages.push_back(std::move(page));
+                return true;
+            }
+        }
+        if (waited_ms >= _page_timeout_ms) {
+            mclog::tagWarn(_tag, "scan {} not read, dropped", page.scanId);
+            std::lock_guard<std::mutex> lock(_sd_card_data.scanMutex);
+            if (_sd_card_data.scanId == page.scanId) {
+                _sd_card_data.scanId = 0;
+                _sd_card_data.pages.clear();
+            }
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+        waited_ms += 10;
+    }
+}
+
+static void run_sd_card_scan()
+{
+    hal::HalBase::SdCardScanPage_t page;
+    std::string path;
+    size_t page_size = 0;
+    {
+        std::lock_guard<std::mutex> lock(_sd_card_data.scanMutex);
+        if (!_sd_card_data.isScanPending) {
+            return;
+        }
+        _sd_card_data.isScanPending = false;
+        page.scanId                 = _sd_card_data.scanId;
+        path                        = _sd_card_data.scanPath;
+        page_size                   = _sd_card_data.scanPageSize;
+    }
+
+    std::string target_path = to_sd_path(path);
+    DIR* dir                = opendir(target_path.c_str());
+    if (dir == nullptr) {
+        mclog::tagError(_tag, "failed to open directory: {}", target_path);
+        page.isLast   = true;
+        page.isFailed = true;
+        push_scan_page(page);
+        return;
+    }
+
+    uint32_t count = 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (std::string(entry->d_name) == "." || std::string(entry->d_name) == "..") {
+            continue;
+        }
+        page.entries.push_back({entry->d_name, entry->d_type == DT_DIR});
+        count++;
+        if (page.entries.size() >= page_size) {
+            if (!push_scan_page(page)) {
+                closedir(dir);
+                return;
+            }
+            page.entries.clear();
+        }
+    }
+    closedir(dir);
+
+    page.isLast = true;
+    push_scan_page(page);
+    mclog::tagInfo(_tag, "scan {} done, {} entries in {}", page.scanId, count, target_path);
+}
+
+uint32_t HalEsp32::startSdCardScan(const std::string& dirPath, size_t pageSize)
+{
+    if (!_sd_card_data.isMounted) {
+        return 0;
+    }
+
+    uint32_t scan_id = 0;
+    {
+        std::lock_guard<std::mutex> lock(_sd_card_data.scanMutex);
+        scan_id = _sd_card_data.nextScanId++;
+        if (_sd_card_data.nextScanId == 0) {
+            _sd_card_data.nextScanId = 1;
+        }
+        _sd_card_data.scanId        = scan_id;
+        _sd_card_data.scanPath      = dirPath;
+        _sd_card_data.scanPageSize  = std::max<size_t>(pageSize, 1);
+        _sd_card_data.isScanPending = true;
+        _sd_card_data.pages.clear();
+    }
+    xTaskNotifyGive(_sd_card_data.task);
+    return scan_id;
+}
+
+bool HalEsp32::getSdCardScanPage(SdCardScanPage_t& page)
+{
+    std::lock_guard<std::mutex> lock(_sd_card_data.scanMutex);
+    if (_sd_card_data.pages.empty()) {
+        return false;
+    }
+    page = std::move(_sd_card_data.pages.front());
+    _sd_card_data.pages.pop_front();
+    return true;
+}
+
+void HalEsp32::cancelSdCardScan()
+{
+    std::lock_guard<std::mutex> lock(_sd_card_data.scanMutex);
+    _sd_card_data.scanId        = 0;
+    _sd_card_data.isScanPending = false;
+    _sd_card_data.pages.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                  Benchmark                                 */
+/* -------------------------------------------------------------------------- */
+static const char* _bench_path = "/sd/.sd_bench.tmp";
+// Cache line of the ESP32-P4, the SDMMC DMA reads from it without a bounce copy
+static constexpr size_t _buffer_align = 64;
+
+struct SdBenchmarkData_t {
+    std::mutex mutex;
+    hal::HalBase::SdCardBenchmarkConfig_t config;
+    hal::HalBase::SdCardBenchmarkResult_t result;
+};
+static SdBenchmarkData_t _sd_bench_data;
+
+// Bytes per microsecond is MB/s
+static float to_mb_per_second(uint64_t bytes, int64_t us)
+{
+    return us > 0 ? (float)bytes / us : 0.0f;
+}
+
+static float to_iops(uint32_t ops, int64_t us)
+{
+    return us > 0 ? ops * 1000000.0f / us : 0.0f;
+}
+
+static bool transfer_all(int fd, uint8_t* buffer, size_t size, bool isWrite)
+{
+    ssize_t ret = isWrite ? write(fd, buffer, size) : read(fd, buffer, size);
+    return ret == (ssize_t)size;
+}
+
+static bool run_sd_card_benchmark(const hal::HalBase::SdCardBenchmarkConfig_t& config,
+                                  hal::HalBase::SdCardBenchmarkResult_t& result)
+{
+    size_t block_size  = config.blockSizeKb * 1024;
+    size_t random_size = config.randomBlockSize;
+    uint64_t file_size = block_size > 0 ? (uint64_t)config.fileSizeKb * 1024 / block_size * block_size : 0;
+    if (file_size == 0 || random_size == 0 || random_size > block_size) {
+        result.error = "invalid config";
+        return false;
+    }
+
+    uint8_t* buffer =
+        (uint8_t*)heap_caps_aligned_alloc(_buffer_align, block_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    if (buffer == nullptr) {
+        buffer = (uint8_t*)heap_caps_aligned_alloc(_buffer_align, block_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA);
+    }
+    int fd = open(_bench_path, O_RDWR | O_CREAT | O_TRUNC, 0666);
+    if (buffer == nullptr || fd < 0) {
+        result.error = buffer == nullptr ? "out of memory" : "open failed";
+        if (fd >= 0) {
+            close(fd);
+        }
+        heap_caps_free(buffer);
+        return false;
+    }
+    for (size_t i = 0; i < block_size; i++) {
+        buffer[i] = i * 31 + 7;
+    }
+
+    auto fail = [&](const char* error) {
+        result.error = error;
+        close(fd);
+        unlink(_bench_path);
+        heap_caps_free(buffer);
+        return false;
+    };
+
+    // fsync is part of the timing, the card has to take the data for real
+    int64_t start = esp_timer_get_time();
+    for (uint64_t offset = 0; offset < file_size; offset += block_size) {
+        if (!transfer_all(fd, buffer, block_size, true)) {
+            return fail("sequential write failed");
+        }
+    }
+    fsync(fd);
+    result.seqWriteMBps = to_mb_per_second(file_size, esp_timer_get_time() - start);
+
+    lseek(fd, 0, SEEK_SET);
+    start = esp_timer_get_time();
+    for (uint64_t offset = 0; offset < file_size; offset += block_size) {
+        if (!transfer_all(fd, buffer, block_size, false)) {
+            return fail("sequential read failed");
+        }
+    }
+    result.seqReadMBps = to_mb_per_second(file_size, esp_timer_get_time() - start);
+
+    // Same offsets for writes and reads, aligned to the transfer size
+    uint32_t slots   = file_size / random_size;
+    uint32_t seed    = 0x12345678;
+    auto next_offset = [&]() {
+        seed = seed * 1664525 + 1013904223;
+        return (off_t)((seed >> 8) % slots) * random_size;
+    };
+
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < config.randomOps; i++) {
+        lseek(fd, next_offset(), SEEK_SET);
+        if (!transfer_all(fd, buffer, random_size, true)) {
+            return fail("random write failed");
+        }
+    }
+    fsync(fd);
+    result.randWriteIops = to_iops(config.randomOps, esp_timer_get_time() - start);
+
+    seed  = 0x12345678;
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < config.randomOps; i++) {
+        lseek(fd, next_offset(), SEEK_SET);
+        if (!transfer_all(fd, buffer, random_size, false)) {
+            return fail("random read failed");
+        }
+    }
+    result.randReadIops = to_iops(config.randomOps, esp_timer_get_time() - start);
+
+    close(fd);
+    unlink(_bench_path);
+    heap_caps_free(buffer);
+    return true;
+}
+
+static void sd_card_benchmark_job()
+{
+    hal::HalBase::SdCardBenchmarkConfig_t config;
+    {
+        std::lock_guard<std::mutex> lock(_sd_bench_data.mutex);
+        config = _sd_bench_data.config;
+    }
+
+    hal::HalBase::SdCardBenchmarkResult_t result;
+    bsp_sdcard_info_t info;
+    if (bsp_sdcard_get_info(&info) == ESP_OK) {
+        result.busFreqKhz = info.freq_khz;
+        result.isDdr      = info.is_ddr;
+    }
+
+    GetHAL()->claimPerfLevel("sd_bench", hal::HalBase::PERF_LEVEL_MAX);
+    bool is_ok = run_sd_card_benchmark(config, result);
+    GetHAL()->releasePerfLevel("sd_bench");
+
+    if (is_ok) {
+        result.state = hal::HalBase::SD_BENCHMARK_DONE;
+        mclog::tagInfo(_tag, "benchmark at {} kHz{}: write {:.2f} MB/s, read {:.2f} MB/s, {:.0f}/{:.0f} IOPS",
+                       result.busFreqKhz, result.isDdr ? " ddr" : "", result.seqWriteMBps, result.seqReadMBps,
+                       result.randWriteIops, result.randReadIops);
+    } else {
+        result.state = hal::HalBase::SD_BENCHMARK_FAILED;
+        mclog::tagError(_tag, "benchmark failed: {}", result.error);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_sd_bench_data.mutex);
+        _sd_bench_data.result = result;
+    }
+}
+
+bool HalEsp32::startSdCardBenchmark(const SdCardBenchmarkConfig_t& config)
+{
+    if (!_sd_card_data.isMounted) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_sd_bench_data.mutex);
+    if (_sd_bench_data.result.state == SD_BENCHMARK_RUNNING) {
+        return false;
+    }
+    _sd_bench_data.config       = config;
+    _sd_bench_data.result       = SdCardBenchmarkResult_t();
+    _sd_bench_data.result.state = SD_BENCHMARK_RUNNING;
+    if (!submitJob(sd_card_benchmark_job)) {
+        mclog::tagError(_tag, "submit job failed");
+        _sd_bench_data.result.state = SD_BENCHMARK_FAILED;
+        _sd_bench_data.result.error = "submit job failed";
+        return false;
+    }
+    return true;
+}
+
+hal::HalBase::SdCardBenchmarkResult_t HalEsp32::getSdCardBenchmarkResult()
+{
+    std::lock_guard<std::mutex> lock(_sd_bench_data.mutex);
+    return _sd_bench_data.result;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Task                                    */
+/* -------------------------------------------------------------------------- */
+void HalEsp32::sd_card_task(void* param)
+{
+    static_cast<HalEsp32*>(param)->sd_card_loop();
+    vTaskDelete(NULL);
+}
+
+void HalEsp32::sd_card_loop()
+{
+    uint32_t probe_interval = _probe_interval_min_ms;
+    uint32_t next_check     = millis();
+
+    while (true) {
+        // Mounting and card checks only run when due, a scan request wakes the task early
+        uint32_t now = millis();
+        if ((int32_t)(now - next_check) >= 0) {
+            if (_sd_card_data.isMounted) {
+                check_sd_card();
+            } else if (mount_sd_card()) {
+                probe_interval = _probe_interval_min_ms;
+            } else {
+                probe_interval = std::min(probe_interval * 2, _probe_interval_max_ms);
+            }
+            next_check = millis() + (_sd_card_data.isMounted ? _check_interval_ms : probe_interval);
+        }
+
+        run_sd_card_scan();
+
+        int32_t wait = next_check - millis();
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(std::max<int32_t>(wait, 1)));
+    }
+}
+
+void HalEsp32::sd_card_init()
+{
+    xTaskCreate(sd_card_task, "sd_card", 4096, this, 2, &_sd_card_data.task);
+}
@@ -0,0 +1,153 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <atomic>
+#include <mutex>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+static const std::string _tag = "sensor-service";
+
+// Tick of the schedule, the sensor intervals are rounded up to it
+static constexpr uint32_t _tick_ms = 10;
+
+static constexpr uint8_t _rx8130_addr = 0x32;
+
+struct SensorServiceData_t {
+    std::mutex mutex;
+    std::atomic<bool> isRunning{false};
+    SemaphoreHandle_t exitSem = nullptr;
+    hal::HalBase::SensorServiceConfig_t config;
+    // The task fills the back buffer without the lock, then flips, readers copy the front one
+    std::mutex snapshotMutex;
+    hal::HalBase::SensorSnapshot_t snapshots[2];
+    uint8_t front = 0;
+};
+static SensorServiceData_t _service_data;
+
+static bool is_due(uint32_t now, uint32_t lastTime, uint16_t intervalMs)
+{
+    if (intervalMs == 0) {
+        return false;
+    }
+    return lastTime == 0 || now - lastTime >= intervalMs;
+}
+
+void HalEsp32::sensor_service_task(void* param)
+{
+    static_cast<HalEsp32*>(param)->sensor_service_loop();
+
+    xSemaphoreGive(_service_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+void HalEsp32::sensor_service_loop()
+{
+    const auto& config = _service_data.config;
+    TickType_t wake    = xTaskGetTickCount();
+
+    while (_service_data.isRunning) {
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(_tick_ms));
+
+        // Start from the latest published values, only the due sensors are read this tick
+        hal::HalBase::SensorSnapshot_t snapshot;
+        {
+            std::lock_guard<std::mutex> lock(_service_data.snapshotMutex);
+            snapshot = _service_data.snapshots[_service_data.front];
+        }
+
+        bool updated = false;
+        if (is_due(millis(), snapshot.powerMonitorTime, config.powerMonitorIntervalMs)) {
+            read_power_monitor_data(snapshot.powerMonitor);
+            snapshot.powerMonitorTime = millis();
+            updated                   = true;
+            powerMonitorSnapshot.publish(snapshot.powerMonitor, snapshot.powerMonitorTime);
+            powerMonitorHistory.push(snapshot.powerMonitor);
+        }
+        if (is_due(millis(), snapshot.imuTime, config.imuIntervalMs)) {
+            read_imu_data(snapshot.imu);
+            snapshot.imuTime = millis();
+            updated          = true;
+            imuSnapshot.publish(snapshot.imu, snapshot.imuTime);
+            imuHistory.push(snapshot.imu);
+        }
+        if (is_due(millis(), snapshot.rtcTime, config.rtcIntervalMs)) {
+            i2cScheduler().run(I2cBusScheduler::PRIORITY_SENSOR, _rx8130_addr, [&]() {
+                rx8130.getTime(&snapshot.rtc);
+                return true;
+            });
+            snapshot.rtcTime = millis();
+            updated          = true;
+        }
+        if (!updated) {
+            continue;
+        }
+
+        // Only this task flips front, so the back buffer is never being copied by a reader
+        snapshot.sequence++;
+        uint8_t back                  = _service_data.front ^ 1;
+        _service_data.snapshots[back] = snapshot;
+        {
+            std::lock_guard<std::mutex> lock(_service_data.snapshotMutex);
+            _service_data.front = back;
+        }
+    }
+}
+
+bool HalEsp32::startSensorService(const SensorServiceConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_service_data.mutex);
+
+    if (_service_data.isRunning) {
+        return true;
+    }
+
+    _service_data.config       = config;
+    _service_data.snapshots[0] = SensorSnapshot_t();
+    _service_data.snapshots[1] = SensorSnapshot_t();
+    _service_data.front        = 0;
+    if (_service_data.exitSem == nullptr) {
+        _service_data.exitSem = xSemaphoreCreateBinary();
+    }
+
+    _service_data.isRunning = true;
+    if (xTaskCreate(sensor_service_task, "sensor", 4096, this, 4, nullptr) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _service_data.isRunning = false;
+        return false;
+    }
+
+    mclog::tagInfo(_tag, "start, pm {} ms, imu {} ms, rtc {} ms", config.powerMonitorIntervalMs, config.imuIntervalMs,
+                   config.rtcIntervalMs);
+    return true;
+}
+
+void HalEsp32::stopSensorService()
+{
+    std::lock_guard<std::mutex> lock(_service_data.mutex);
+
+    if (!_service_data.isRunning) {
+        return;
+    }
+
+    // The task finishes the reads of its current tick
+    _service_data.isRunning = false;
+    xSemaphoreTake(_service_data.exitSem, portMAX_DELAY);
+    mclog::tagInfo(_tag, "stop");
+}
+
+bool HalEsp32::getSensorSnapshot(SensorSnapshot_t& snapshot)
+{
+    if (!_service_data.isRunning) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_service_data.snapshotMutex);
+    snapshot = _service_data.snapshots[_service_data.front];
+    return true;
+}
@@ -0,0 +1,54 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+
+static const std::string _tag = "settings";
+
+static const char* _nvs_namespace = "settings";
+// Written once nothing changed for this long, a slider drag ends up as one flash write
+static constexpr uint32_t _quiet_ms = 3000;
+// A saved level this low would look like a dead screen at boot
+static constexpr uint8_t _min_boot_brightness = 10;
+
+// NVS is shared with the Wi-Fi driver, see hal_wifi.cpp
+void wifi_nvs_init();
+
+SettingsStore& HalEsp32::settingsStore()
+{
+    static SettingsStore store;
+    return store;
+}
+
+void HalEsp32::settings_init()
+{
+    wifi_nvs_init();
+
+    auto& store  = settingsStore();
+    size_t count = store.load(_nvs_namespace);
+
+    // Members only, the boot stages that bring up the hardware apply them
+    _current_lcd_brightness = std::max(store.get<uint8_t>("brightness", _current_lcd_brightness), _min_boot_brightness);
+    _charge_qc_enable       = store.get<bool>("charge_qc", true);
+    _ext_antenna_enable     = store.get<bool>("ext_antenna", _ext_antenna_enable);
+    _wifi_link_drive        = std::min<uint8_t>(store.get<uint8_t>("link_drive", _wifi_link_drive), 3);
+    _audio_dma_profile =
+        std::min<uint8_t>(store.get<uint8_t>("audio_dma", _audio_dma_profile), AUDIO_DMA_RECORDING);
+    _display_rotation = std::min<uint8_t>(store.get<uint8_t>("rotation", _display_rotation), LV_DISPLAY_ROTATION_270);
+    _auto_rotate      = store.get<bool>("auto_rotate", _auto_rotate);
+    _auto_rotate_mask = store.get<uint8_t>("rotate_mask", _auto_rotate_mask) & 0x0F;
+    setSpeakerVolume(store.get<uint8_t>("volume", getSpeakerVolume()));
+
+    store.start(_quiet_ms);
+    mclog::tagInfo(_tag, "{} loaded, brightness {}, volume {}, qc {}, ext antenna {}", count, _current_lcd_brightness,
+                   getSpeakerVolume(), _charge_qc_enable, _ext_antenna_enable);
+}
+
+void HalEsp32::flushSettings()
+{
+    settingsStore().flush();
+}
@@ -0,0 +1,315 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include "../utils/event_trace/event_trace.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_private/freertos_debug.h>
+#include <esp_memory_utils.h>
+#include <esp_app_desc.h>
+#include <esp_timer.h>
+#include <riscv/rvruntime-frames.h>
+
+static const std::string _tag = "stall";
+
+static const char* _report_dir = "/sd/stalls";
+// Saved PC, return address and the stack words that point into code
+static constexpr size_t _max_frames    = 32;
+static constexpr uint32_t _min_poll_ms = 10;
+
+static const char* const _section_names[] = {"app_update", "lvgl_timer"};
+
+// Written by the task running the section, read by the monitor task
+struct StallSection_t {
+    std::atomic<int64_t> beginUs{0};
+    std::atomic<TaskHandle_t> task{nullptr};
+    std::atomic<uint32_t> maxUs{0};
+    // The last run over the threshold, handed to the monitor task when it ends
+    std::atomic<int64_t> stalledBeginUs{0};
+    std::atomic<uint32_t> stalledUs{0};
+    // Monitor task only, the run the open report belongs to
+    int64_t reportBeginUs = 0;
+    bool isReportOpen     = false;
+    hal::HalBase::StallReport_t report;
+};
+
+struct StallMonitorData_t {
+    std::mutex mutex;
+    std::atomic<bool> isRunning = false;
+    hal::HalBase::StallMonitorConfig_t config;
+    int64_t thresholdUs       = 0;
+    TaskHandle_t task         = nullptr;
+    SemaphoreHandle_t exitSem = nullptr;
+    uint32_t nextId           = 1;
+    StallSection_t sections[hal::HalBase::UI_SECTION_NUM];
+    // Read by getStallMonitorStats()
+    std::mutex statsMutex;
+    uint32_t stalls = 0;
+    hal::HalBase::StallReport_t last;
+};
+static StallMonitorData_t _stall_data;
+
+// Only a task that is switched out has its registers saved on its stack, a running one is looked at again later
+static bool capture_backtrace(TaskHandle_t task, std::vector<uint32_t>& backtrace)
+{
+    if (task == nullptr || eTaskGetState(task) == eRunning) {
+        return false;
+    }
+    TaskSnapshot_t snapshot;
+    if (vTaskGetSnapshot(task, &snapshot) != pdTRUE) {
+        return false;
+    }
+
+    // The context switch saved a full exception frame at the top of the stack
+    auto frame = reinterpret_cast<const RvExcFrame*>(snapshot.pxTopOfStack);
+    backtrace.clear();
+    backtrace.push_back(frame->mepc);
+    backtrace.push_back(frame->ra);
+
+    // No frame pointers, so the words on the stack that point into code stand in for the return addresses. Some are
+    // stale or function pointers, the newest ones come first
+    auto word = reinterpret_cast<const uint32_t*>(frame->sp);
+    auto end  = reinterpret_cast<const uint32_t*>(snapshot.pxEndOfStack);
+    if (word < reinterpret_cast<const uint32_t*>(snapshot.pxTopOfStack) || word >= end) {
+        return true;
+    }
+    for (; word < end && backtrace.size() < _max_frames; word++) {
+        if (esp_ptr_executable(reinterpret_cast<void*>(*word))) {
+            backtrace.push_back(*word);
+        }
+    }
+    return true;
+}
+
+static std::string format_backtrace(const std::vector<uint32_t>& backtrace)
+{
+    std::string text;
+    for (auto pc : backtrace) {
+        text += fmt::format(" 0x{:08x}", pc);
+    }
+    return text.empty() ? " (task kept running)" : text;
+}
+
+static void write_report(StallSection_t& section)
+{
+    auto& report = section.report;
+    if (!GetHAL()->isSdCardMounted()) {
+        return;
+    }
+    mkdir(_report_dir, 0777);
+
+    std::string path = fmt::format("{}/stall_{}.txt", _report_dir, report.id);
+    FILE* file       = fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        mclog::tagError(_tag, "open {} failed", path);
+        return;
+    }
+    // Symbolize with: addr2line -pfiaC -e build/m5stack_tab5.elf <the address lines>
+    char elf_sha[65] = {0};
+    esp_app_get_elf_sha256(elf_sha, sizeof(elf_sha));
+    fprintf(file, "# m5tab5-stall 1\n# elf %s\nsection %s\ntask %s\nduration_ms %u\n", elf_sha,
+            _section_names[report.section], report.task.c_str(), (unsigned)report.durationMs);
+    for (auto pc : report.backtrace) {
+        fprintf(file, "0x%08x\n", (unsigned)pc);
+    }
+    bool is_ok  = fclose(file) == 0;
+    report.path = is_ok ? path : "";
+
+    // The rings keep the latest events, the stall is still in them right after it ends
+    if (_stall_data.config.saveTrace && GetHAL()->getEventTraceStats().isRecording) {
+        GetHAL()->exportEventTrace(fmt::format("{}/stall_{}.json", _report_dir, report.id));
+    }
+}
+
+// Open a report for a run over the threshold, or take the backtrace a running task did not have at the first look
+static void check_section(StallSection_t& section, hal::HalBase::UiSection_t id, int64_t nowUs)
+{
+    int64_t begin_us = section.beginUs.load();
+    if (begin_us == 0 || nowUs - begin_us < _stall_data.thresholdUs) {
+        return;
+    }
+
+    auto& report = section.report;
+    if (!section.isReportOpen || section.reportBeginUs != begin_us) {
+        TaskHandle_t task     = section.task.load();
+        section.isReportOpen  = true;
+        section.reportBeginUs = begin_us;
+        report                = hal::HalBase::StallReport_t();
+        report.id             = _stall_data.nextId++;
+        report.section        = id;
+        report.task           = task != nullptr ? pcTaskGetName(task) : "?";
+        capture_backtrace(task, report.backtrace);
+        // Marks the moment in the trace that goes with the report
+        TRACE_INSTANT("ui stall");
+        // Logged while it is still stalled, in case it never ends
+        mclog::tagWarn(_tag, "#{} {} in {} over {} ms:{}", report.id, _section_names[id], report.task,
+                       (nowUs - begin_us) / 1000, format_backtrace(report.backtrace));
+    } else if (report.backtrace.empty() && capture_backtrace(section.task.load(), report.backtrace)) {
+        mclog::tagWarn(_tag, "#{} still stalled after {} ms:{}", report.id, (nowUs - begin_us) / 1000,
+                       format_backtrace(report.backtrace));
+    }
+}
+
+// A run over the threshold has ended, the monitor may not have seen it while it lasted
+static void finish_section(StallSection_t& section, hal::HalBase::UiSection_t id)
+{
+    int64_t begin_us = section.stalledBeginUs.exchange(0);
+    if (begin_us == 0) {
+        return;
+    }
+
+    auto& report = section.report;
+    if (!section.isReportOpen || section.reportBeginUs != begin_us) {
+        report         = hal::HalBase::StallReport_t();
+        report.id      = _stall_data.nextId++;
+        report.section = id;
+        report.task    = "?";
+    }
+    section.isReportOpen = false;
+    report.durationMs    = section.stalledUs / 1000;
+    write_report(section);
+    mclog::tagWarn(_tag, "#{} {} in {} took {} ms{}", report.id, _section_names[id], report.task, report.durationMs,
+                   report.path.empty() ? "" : ", report " + report.path);
+
+    std::lock_guard<std::mutex> lock(_stall_data.statsMutex);
+    _stall_data.stalls++;
+    _stall_data.last = report;
+}
+
+void HalEsp32::stall_monitor_task(void* param)
+{
+    static_cast<HalEsp32*>(param)->stall_monitor_loop();
+
+    xSemaphoreGive(_stall_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+void HalEsp32::stall_monitor_loop()
+{
+    uint32_t poll_ms = std::max(_stall_data.config.thresholdMs / 4, _min_poll_ms);
+
+    while (_stall_data.isRunning) {
+        // Woken early when a stalled run ends
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(poll_ms));
+        if (!_stall_data.isRunning) {
+            break;
+        }
+
+        int64_t now_us = esp_timer_get_time();
+        for (int i = 0; i < UI_SECTION_NUM; i++) {
+            auto id = static_cast<UiSection_t>(i);
+            finish_section(_stall_data.sections[i], id);
+            check_section(_stall_data.sections[i], id, now_us);
+        }
+    }
+}
+
+void HalEsp32::markUiSection(UiSection_t section, bool isBegin)
+{
+    if (!_stall_data.isRunning || section >= UI_SECTION_NUM) {
+        return;
+    }
+
+    auto& s = _stall_data.sections[section];
+    if (isBegin) {
+        s.task    = xTaskGetCurrentTaskHandle();
+        s.beginUs = esp_timer_get_time();
+        return;
+    }
+
+    int64_t begin_us = s.beginUs.exchange(0);
+    if (begin_us == 0) {
+        return;
+    }
+    uint32_t us = esp_timer_get_time() - begin_us;
+    if (us > s.maxUs) {
+        s.maxUs = us;
+    }
+    if (us >= _stall_data.thresholdUs) {
+        s.stalledUs       = us;
+        s.stalledBeginUs  = begin_us;
+        TaskHandle_t task = _stall_data.task;
+        if (task != nullptr) {
+            xTaskNotifyGive(task);
+        }
+    }
+}
+
+bool HalEsp32::startStallMonitor(const StallMonitorConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_stall_data.mutex);
+
+    if (_stall_data.isRunning) {
+        return true;
+    }
+
+    _stall_data.config      = config;
+    _stall_data.thresholdUs = (int64_t)std::max<uint32_t>(config.thresholdMs, 1) * 1000;
+    for (auto& section : _stall_data.sections) {
+        section.beginUs        = 0;
+        section.maxUs          = 0;
+        section.stalledBeginUs = 0;
+        section.isReportOpen   = false;
+    }
+    {
+        std::lock_guard<std::mutex> stats_lock(_stall_data.statsMutex);
+        _stall_data.stalls = 0;
+        _stall_data.last   = StallReport_t();
+    }
+    if (_stall_data.exitSem == nullptr) {
+        _stall_data.exitSem = xSemaphoreCreateBinary();
+    }
+
+    // Above the UI and LVGL tasks, so it gets to look while they hog a core. The report and trace writes take 6 KB
+    _stall_data.isRunning = true;
+    if (xTaskCreate(stall_monitor_task, "stall_monitor", 6144, this, 10, &_stall_data.task) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _stall_data.isRunning = false;
+        _stall_data.task      = nullptr;
+        return false;
+    }
+
+    mclog::tagInfo(_tag, "start, threshold {} ms", config.thresholdMs);
+    return true;
+}
+
+void HalEsp32::stopStallMonitor()
+{
+    std::lock_guard<std::mutex> lock(_stall_data.mutex);
+
+    if (!_stall_data.isRunning) {
+        return;
+    }
+
+    _stall_data.isRunning = false;
+    xTaskNotifyGive(_stall_data.task);
+    xSemaphoreTake(_stall_data.exitSem, portMAX_DELAY);
+    _stall_data.task = nullptr;
+    mclog::tagInfo(_tag, "stop");
+}
+
+hal::HalBase::StallMonitorStats_t HalEsp32::getStallMonitorStats()
+{
+    StallMonitorStats_t stats;
+    stats.isRunning = _stall_data.isRunning;
+    for (int i = 0; i < UI_SECTION_NUM; i++) {
+        stats.maxSectionMs[i] = _stall_data.sections[i].maxUs / 1000;
+    }
+
+    std::lock_guard<std::mutex> lock(_stall_data.statsMutex);
+    stats.stalls = _stall_data.stalls;
+    stats.last   = _stall_data.last;
+    return stats;
+}
@@ -0,0 +1,239 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include "../utils/task_pool/task_pool.h"
+#include "../utils/task_controller/task_controller.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_heap_caps.h>
+
+static const std::string _tag = "system";
+
+// Run time counters of the previous sample, keyed by task number. Each caller measures its own window
+struct TaskLoadWindow_t {
+    std::map<UBaseType_t, configRUN_TIME_COUNTER_TYPE> lastTaskRunTime;
+    configRUN_TIME_COUNTER_TYPE lastTotalRunTime = 0;
+};
+static TaskLoadWindow_t _task_load_windows[HalEsp32::SYSTEM_STATS_WINDOW_NUM];
+static std::mutex _task_load_mutex;
+// Keyed by name, so the record of a task outlives it and a task started again adds to its old record
+static std::map<std::string, hal::HalBase::StackWatermark_t> _stack_watermarks;
+
+hal::HalBase::SystemStats_t HalEsp32::getSystemStats()
+{
+    return sample_system_stats(SYSTEM_STATS_WINDOW_APP, true);
+}
+
+hal::HalBase::SystemStats_t HalEsp32::sample_system_stats(SystemStatsWindow_t window, bool withTasks)
+{
+    SystemStats_t stats;
+    stats.internalFree    = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    stats.internalMinFree = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
+    stats.psramFree       = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    stats.psramMinFree    = heap_caps_get_minimum_free_size(MALLOC_CAP_SPIRAM);
+    // LVGL allocates from these same heaps on this target, the numbers include it
+    stats.internalLargestFree = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL);
+    stats.psramLargestFree    = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
+    if (!withTasks) {
+        return stats;
+    }
+
+    // A few spare slots in case tasks are created between the two calls
+    std::vector<TaskStatus_t> task_status(uxTaskGetNumberOfTasks() + 4);
+    configRUN_TIME_COUNTER_TYPE total_run_time = 0;
+    UBaseType_t task_num = uxTaskGetSystemState(task_status.data(), task_status.size(), &total_run_time);
+    if (task_num == 0) {
+        mclog::tagWarn(_tag, "task list changed while sampling");
+        return stats;
+    }
+
+    std::lock_guard<std::mutex> lock(_task_load_mutex);
+    auto& last_window = _task_load_windows[window];
+
+    // The total run time is the time base, each task counter accumulates per core
+    configRUN_TIME_COUNTER_TYPE total_delta = total_run_time - last_window.lastTotalRunTime;
+    std::map<UBaseType_t, configRUN_TIME_COUNTER_TYPE> task_run_time;
+    uint32_t now = millis();
+    for (auto& watermark : _stack_watermarks) {
+        watermark.second.isAlive = false;
+    }
+    for (UBaseType_t i = 0; i < task_num; i++) {
+        const TaskStatus_t& status = task_status[i];
+        task_run_time[status.xTaskNumber] = status.ulRunTimeCounter;
+
+        configRUN_TIME_COUNTER_TYPE task_delta = status.ulRunTimeCounter;
+        auto last                              = last_window.lastTaskRunTime.find(status.xTaskNumber);
+        if (last != last_window.lastTaskRunTime.end()) {
+            task_delta -= last->second;
+        }
+
+        TaskLoad_t load;
+        load.name      = status.pcTaskName;
+        load.cpuLoad   = total_delta ? task_delta * 100.0f / total_delta : 0.0f;
+        load.stackFree = status.usStackHighWaterMark;
+        stats.tasks.push_back(load);
+
+        // The stack is in bytes on this port, so is the high watermark
+        auto result = _stack_watermarks.try_emplace(load.name);
+        auto& mark  = result.first->second;
+        if (result.second || load.stackFree < mark.minFree) {
+            mark.name    = load.name;
+            mark.minFree = load.stackFree;
+        }
+        mark.lastSeenMs = now;
+        mark.isAlive    = true;
+    }
+    last_window.lastTaskRunTime.swap(task_run_time);
+    last_window.lastTotalRunTime = total_run_time;
+
+    std::sort(stats.tasks.begin(), stats.tasks.end(),
+              [](const TaskLoad_t& a, const TaskLoad_t& b) { return a.cpuLoad > b.cpuLoad; });
+    return stats;
+}
+
+std::vector<hal::HalBase::StackWatermark_t> HalEsp32::getStackWatermarks()
+{
+    std::vector<StackWatermark_t> watermarks;
+    {
+        std::lock_guard<std::mutex> lock(_task_load_mutex);
+        for (const auto& watermark : _stack_watermarks) {
+            watermarks.push_back(watermark.second);
+        }
+    }
+    std::sort(watermarks.begin(), watermarks.end(),
+              [](const StackWatermark_t& a, const StackWatermark_t& b) { return a.minFree < b.minFree; });
+    return watermarks;
+}
+
+// Below this a task is one deeper call away from an overflow
+static constexpr uint32_t _low_stack_warn_size = 512;
+// Steps of the heap minimum worth a log line
+static constexpr uint32_t _heap_drop_log_size = 1024;
+
+static TaskController_t _diagnostics_task;
+
+bool HalEsp32::startDiagnostics(uint16_t intervalMs)
+{
+    if (intervalMs == 0) {
+        return false;
+    }
+
+    auto loop = [this, intervalMs](TaskController_t& task) {
+        uint32_t logged_internal_min = 0;
+        uint32_t logged_psram_min    = 0;
+        std::map<std::string, bool> warned;
+        while (task.checkPoint()) {
+            auto stats = sample_system_stats(SYSTEM_STATS_WINDOW_DIAGNOSTICS, true);
+
+            // A minimum that keeps going down while nothing new is opened is a leak
+            if (logged_internal_min == 0 || stats.internalMinFree + _heap_drop_log_size <= logged_internal_min ||
+                stats.psramMinFree + _heap_drop_log_size <= logged_psram_min) {
+                logged_internal_min = stats.internalMinFree;
+                logged_psram_min    = stats.psramMinFree;
+                mclog::tagInfo(_tag, "heap min free sram {} KB (largest {} KB), psram {} KB (largest {} KB)",
+                               stats.internalMinFree / 1024, stats.internalLargestFree / 1024,
+                               stats.psramMinFree / 1024, stats.psramLargestFree / 1024);
+            }
+            for (const auto& load : stats.tasks) {
+                if (load.stackFree < _low_stack_warn_size && !warned[load.name]) {
+                    warned[load.name] = true;
+                    mclog::tagWarn(_tag, "task {} stack headroom {} bytes", load.name, load.stackFree);
+                }
+            }
+
+            if (!task.sleep(pdMS_TO_TICKS(intervalMs))) {
+                break;
+            }
+        }
+    };
+    if (!_diagnostics_task.start("diag", 4096, 2, -1, loop)) {
+        mclog::tagError(_tag, "start diagnostics failed");
+        return false;
+    }
+    return true;
+}
+
+void HalEsp32::stopDiagnostics()
+{
+    _diagnostics_task.stop();
+}
+
+// Wakes the app main loop, created on first use
+static SemaphoreHandle_t get_app_loop_wakeup()
+{
+    static SemaphoreHandle_t sem = xSemaphoreCreateBinary();
+    return sem;
+}
+
+void HalEsp32::waitAppLoopWakeup(uint32_t timeoutMs)
+{
+    // Always block for at least a tick so lower priority tasks get the CPU
+    TickType_t ticks = pdMS_TO_TICKS(timeoutMs);
+    xSemaphoreTake(get_app_loop_wakeup(), ticks > 0 ? ticks : 1);
+}
+
+void HalEsp32::wakeAppLoop()
+{
+    xSemaphoreGive(get_app_loop_wakeup());
+}
+
+// The function lives on the heap until the task returns from it
+static void app_task(void* param)
+{
+    auto task = static_cast<std::function<void()>*>(param);
+    (*task)();
+    delete task;
+    vTaskDelete(NULL);
+}
+
+bool HalEsp32::startAppTask(const AppTaskConfig_t& config, std::function<void()> task)
+{
+    auto param         = new std::function<void()>(std::move(task));
+    BaseType_t core_id = config.core < 0 ? tskNO_AFFINITY : config.core;
+    if (xTaskCreatePinnedToCore(app_task, config.name.c_str(), config.stackSize, param, config.priority, NULL,
+                                core_id) != pdPASS) {
+        mclog::tagError(_tag, "create task {} failed", config.name);
+        delete param;
+        return false;
+    }
+    mclog::tagInfo(_tag, "task {} started, core {} priority {}", config.name, config.core, config.priority);
+    return true;
+}
+
+// Workers come up on the first job
+static TaskPool& get_task_pool()
+{
+    static TaskPool pool;
+    static std::once_flag init_flag;
+    std::call_once(init_flag, []() { pool.init(TaskPool::Config_t()); });
+    return pool;
+}
+
+bool HalEsp32::submitJob(std::function<void()> job, int core)
+{
+    return get_task_pool().submit(std::move(job), core);
+}
+
+void* HalEsp32::allocMemory(size_t size, MemoryPlacement_t placement)
+{
+    uint32_t caps = placement == MEMORY_INTERNAL ? MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT : MALLOC_CAP_SPIRAM;
+    void* ptr     = heap_caps_malloc(size, caps);
+    if (ptr == nullptr) {
+        mclog::tagError(_tag, "alloc {} bytes in {} failed", size, placement == MEMORY_INTERNAL ? "sram" : "psram");
+    }
+    return ptr;
+}
+
+void HalEsp32::freeMemory(void* ptr)
+{
+    heap_caps_free(ptr);
+}
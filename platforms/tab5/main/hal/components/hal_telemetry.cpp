@@ -0,0 +1,360 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_http_server.h>
+
+static const std::string _tag = "telemetry";
+
+// Shared by the cache, REST responses and WebSocket frames still in flight
+using Document_t = std::shared_ptr<const std::string>;
+
+struct WsClient_t {
+    int fd         = -1;
+    bool isSending = false;
+};
+
+struct WsSend_t {
+    Document_t document;
+    int fd = -1;
+};
+
+struct TelemetryData_t {
+    std::mutex mutex;
+    TaskHandle_t task           = nullptr;
+    SemaphoreHandle_t exitSem   = nullptr;
+    std::atomic<bool> isRunning = false;
+    hal::HalBase::TelemetryConfig_t config;
+    // The document, clients and stats
+    std::mutex documentMutex;
+    httpd_handle_t server = nullptr;
+    Document_t document;
+    std::vector<WsClient_t> wsClients;
+    hal::HalBase::TelemetryStats_t stats;
+};
+static TelemetryData_t _telemetry_data;
+
+static void append_escaped(std::string& out, const char* text)
+{
+    for (; *text; text++) {
+        if (*text == '"' || *text == '\\') {
+            out += '\\';
+        }
+        out += *text;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                  WebSocket                                 */
+/* -------------------------------------------------------------------------- */
+// Lock _telemetry_data.documentMutex before calling
+static WsClient_t* find_ws_client(int fd)
+{
+    auto& clients = _telemetry_data.wsClients;
+    auto client   = std::find_if(clients.begin(), clients.end(), [fd](const WsClient_t& c) { return c.fd == fd; });
+    return client == clients.end() ? nullptr : &(*client);
+}
+
+// Lock _telemetry_data.documentMutex before calling
+static void remove_ws_client(int fd)
+{
+    auto& clients = _telemetry_data.wsClients;
+    clients.erase(std::remove_if(clients.begin(), clients.end(), [fd](const WsClient_t& c) { return c.fd == fd; }),
+                  clients.end());
+    _telemetry_data.stats.wsClients = clients.size();
+}
+
+static void on_ws_sent(esp_err_t err, int socket, void* arg)
+{
+    auto send = static_cast<WsSend_t*>(arg);
+    {
+        std::lock_guard<std::mutex> lock(_telemetry_data.documentMutex);
+        if (err != ESP_OK) {
+            remove_ws_client(socket);
+        } else if (auto client = find_ws_client(socket)) {
+            client->isSending = false;
+            _telemetry_data.stats.wsFramesSent++;
+        }
+    }
+    delete send;
+}
+
+// A client still receiving the previous document skips this one, so a slow link never queues up frames. Returns the
+// clients it went to
+static size_t publish_document(const Document_t& document)
+{
+    std::vector<int> targets;
+    httpd_handle_t server = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_telemetry_data.documentMutex);
+        _telemetry_data.document = document;
+        _telemetry_data.stats.documents++;
+        server = _telemetry_data.server;
+
+        auto& clients = _telemetry_data.wsClients;
+        for (size_t i = 0; i < clients.size();) {
+            if (httpd_ws_get_fd_info(server, clients[i].fd) != HTTPD_WS_CLIENT_WEBSOCKET) {
+                clients.erase(clients.begin() + i);
+                continue;
+            }
+            if (clients[i].isSending) {
+                _telemetry_data.stats.wsFramesDropped++;
+            } else {
+                clients[i].isSending = true;
+                targets.push_back(clients[i].fd);
+            }
+            i++;
+        }
+        _telemetry_data.stats.wsClients = clients.size();
+    }
+
+    for (int fd : targets) {
+        auto send              = new WsSend_t{document, fd};
+        httpd_ws_frame_t frame = {};
+        frame.final            = true;
+        frame.type             = HTTPD_WS_TYPE_TEXT;
+        frame.payload          = (uint8_t*)send->document->data();
+        frame.len              = send->document->size();
+        if (httpd_ws_send_data_async(server, fd, &frame, on_ws_sent, send) != ESP_OK) {
+            std::lock_guard<std::mutex> lock(_telemetry_data.documentMutex);
+            remove_ws_client(fd);
+            delete send;
+        }
+    }
+    return targets.size();
+}
+
+// Implemented in hal_wifi.cpp
+esp_err_t web_ws_drain_frame(httpd_req_t* req);
+
+static esp_err_t telemetry_ws_handler(httpd_req_t* req)
+{
+    if (req->method == HTTP_GET) {
+        // Handshake done, the client gets documents from the next push on
+        int fd = httpd_req_to_sockfd(req);
+        std::lock_guard<std::mutex> lock(_telemetry_data.documentMutex);
+        if (!_telemetry_data.isRunning || _telemetry_data.wsClients.size() >= _telemetry_data.config.maxWsClients) {
+            return ESP_FAIL;
+        }
+        WsClient_t client;
+        client.fd = fd;
+        _telemetry_data.wsClients.push_back(client);
+        _telemetry_data.stats.wsClients = _telemetry_data.wsClients.size();
+        mclog::tagInfo(_tag, "ws client {} connected", fd);
+        return ESP_OK;
+    }
+
+    // Clients have nothing to say
+    return web_ws_drain_frame(req);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    REST                                    */
+/* -------------------------------------------------------------------------- */
+static esp_err_t telemetry_get_handler(httpd_req_t* req)
+{
+    Document_t document;
+    {
+        std::lock_guard<std::mutex> lock(_telemetry_data.documentMutex);
+        document = _telemetry_data.document;
+        _telemetry_data.stats.restRequests++;
+    }
+
+    // Dashboards are usually served from somewhere else
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    if (!document) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        return httpd_resp_send(req, "telemetry is not running", HTTPD_RESP_USE_STRLEN);
+    }
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    return httpd_resp_send(req, document->data(), document->size());
+}
+
+// Called by start_webserver() in hal_wifi.cpp
+void telemetry_register_handlers(httpd_handle_t server)
+{
+    static httpd_uri_t rest_uri = {};
+    rest_uri.uri                = "/api/telemetry";
+    rest_uri.method             = HTTP_GET;
+    rest_uri.handler            = telemetry_get_handler;
+    httpd_register_uri_handler(server, &rest_uri);
+
+    static httpd_uri_t ws_uri = {};
+    ws_uri.uri                = "/ws/telemetry";
+    ws_uri.method             = HTTP_GET;
+    ws_uri.handler            = telemetry_ws_handler;
+    ws_uri.is_websocket       = true;
+    httpd_register_uri_handler(server, &ws_uri);
+
+    std::lock_guard<std::mutex> lock(_telemetry_data.documentMutex);
+    _telemetry_data.server = server;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Task                                    */
+/* -------------------------------------------------------------------------- */
+void HalEsp32::telemetry_task(void* param)
+{
+    static_cast<HalEsp32*>(param)->telemetry_loop();
+
+    xSemaphoreGive(_telemetry_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+void HalEsp32::telemetry_loop()
+{
+    const auto& config       = _telemetry_data.config;
+    uint32_t task_stats_time = 0;
+    std::string tasks_json   = "[]";
+    std::string stacks_json  = "[]";
+
+    while (_telemetry_data.isRunning) {
+        uint32_t now    = millis();
+        bool with_tasks = config.taskStatsIntervalMs > 0 &&
+                          (task_stats_time == 0 || now - task_stats_time >= config.taskStatsIntervalMs);
+        auto system = sample_system_stats(SYSTEM_STATS_WINDOW_TELEMETRY, with_tasks);
+        if (with_tasks) {
+            task_stats_time = now;
+            tasks_json      = "[";
+            for (const auto& task : system.tasks) {
+                tasks_json += tasks_json.size() > 1 ? ",{\"name\":\"" : "{\"name\":\"";
+                append_escaped(tasks_json, task.name.c_str());
+                tasks_json += fmt::format("\",\"cpuLoad\":{:.1f},\"stackFree\":{}}}", task.cpuLoad, task.stackFree);
+            }
+            tasks_json += "]";
+
+            // Lowest headroom per task since boot, the tasks list only has the current one
+            stacks_json = "[";
+            for (const auto& mark : getStackWatermarks()) {
+                stacks_json += stacks_json.size() > 1 ? ",{\"name\":\"" : "{\"name\":\"";
+                append_escaped(stacks_json, mark.name.c_str());
+                stacks_json += fmt::format("\",\"minFree\":{},\"alive\":{}}}", mark.minFree, mark.isAlive);
+            }
+            stacks_json += "]";
+        }
+
+        std::string json;
+        json.reserve(512 + tasks_json.size() + stacks_json.size());
+        json += fmt::format("{{\"uptimeMs\":{},\"cpuTemp\":{}", now, getCpuTemp());
+
+        // Sensors the service has not read yet are left out
+        SensorSnapshot_t snapshot;
+        if (getSensorSnapshot(snapshot)) {
+            if (snapshot.powerMonitorTime) {
+                const auto& pm = snapshot.powerMonitor;
+                json += fmt::format(
+                    ",\"power\":{{\"busVoltage\":{:.3f},\"busPower\":{:.3f},\"shuntCurrent\":{:.4f},\"ageMs\":{}}}",
+                    pm.busVoltage, pm.busPower, pm.shuntCurrent, now - snapshot.powerMonitorTime);
+            }
+            if (snapshot.imuTime) {
+                const auto& imu = snapshot.imu;
+                json += fmt::format(
+                    ",\"imu\":{{\"accel\":[{:.3f},{:.3f},{:.3f}],\"gyro\":[{:.2f},{:.2f},{:.2f}],\"ageMs\":{}}}",
+                    imu.accelX, imu.accelY, imu.accelZ, imu.gyroX, imu.gyroY, imu.gyroZ, now - snapshot.imuTime);
+            }
+            if (snapshot.rtcTime) {
+                const auto& rtc = snapshot.rtc;
+                json += fmt::format(",\"rtc\":\"{:04d}-{:02d}-{:02d}T{:02d}:{:02d}:{:02d}\"", rtc.tm_year + 1900,
+                                    rtc.tm_mon + 1, rtc.tm_mday, rtc.tm_hour, rtc.tm_min, rtc.tm_sec);
+            }
+        }
+
+        json += fmt::format(
+            ",\"heap\":{{\"internalFree\":{},\"internalMinFree\":{},\"internalLargestFree\":{},\"psramFree\":{},"
+            "\"psramMinFree\":{},\"psramLargestFree\":{}}}",
+            system.internalFree, system.internalMinFree, system.internalLargestFree, system.psramFree,
+            system.psramMinFree, system.psramLargestFree);
+        if (config.taskStatsIntervalMs > 0) {
+            json += ",\"tasks\":";
+            json += tasks_json;
+            json += ",\"stacks\":";
+            json += stacks_json;
+        }
+        json += "}";
+
+        // A stream keeps the radio awake, polled REST clients get the station at its idle power save
+        if (publish_document(std::make_shared<const std::string>(std::move(json))) > 0) {
+            claimRadioLevel("telemetry", RADIO_LEVEL_AWAKE);
+        } else {
+            releaseRadioLevel("telemetry");
+        }
+
+        // stopTelemetry() cuts the wait short
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(std::max<uint16_t>(config.intervalMs, 50)));
+    }
+    releaseRadioLevel("telemetry");
+}
+
+bool HalEsp32::startTelemetry(const TelemetryConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_telemetry_data.mutex);
+
+    if (_telemetry_data.isRunning) {
+        return true;
+    }
+
+    // The document is built from its snapshots, starting it again is a no-op while it runs
+    startSensorService(SensorServiceConfig_t());
+
+    _telemetry_data.config = config;
+    {
+        std::lock_guard<std::mutex> document_lock(_telemetry_data.documentMutex);
+        _telemetry_data.stats = TelemetryStats_t();
+    }
+    if (_telemetry_data.exitSem == nullptr) {
+        _telemetry_data.exitSem = xSemaphoreCreateBinary();
+    }
+
+    _telemetry_data.isRunning = true;
+    if (xTaskCreate(telemetry_task, "telemetry", 6144, this, 3, &_telemetry_data.task) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _telemetry_data.isRunning = false;
+        return false;
+    }
+
+    mclog::tagInfo(_tag, "start, every {} ms, tasks every {} ms", config.intervalMs, config.taskStatsIntervalMs);
+    return true;
+}
+
+void HalEsp32::stopTelemetry()
+{
+    std::lock_guard<std::mutex> lock(_telemetry_data.mutex);
+
+    if (!_telemetry_data.isRunning) {
+        return;
+    }
+
+    _telemetry_data.isRunning = false;
+    xTaskNotifyGive(_telemetry_data.task);
+    xSemaphoreTake(_telemetry_data.exitSem, portMAX_DELAY);
+    _telemetry_data.task = nullptr;
+
+    // Frames in flight still hold their own reference to the document
+    std::lock_guard<std::mutex> document_lock(_telemetry_data.documentMutex);
+    _telemetry_data.document.reset();
+    for (const auto& client : _telemetry_data.wsClients) {
+        httpd_sess_trigger_close(_telemetry_data.server, client.fd);
+    }
+    _telemetry_data.wsClients.clear();
+    _telemetry_data.stats.wsClients = 0;
+    mclog::tagInfo(_tag, "stop");
+}
+
+hal::HalBase::TelemetryStats_t HalEsp32::getTelemetryStats()
+{
+    std::lock_guard<std::mutex> lock(_telemetry_data.documentMutex);
+    return _telemetry_data.stats;
+}
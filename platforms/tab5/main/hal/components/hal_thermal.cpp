@@ -0,0 +1,202 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <shared/shared.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <driver/temperature_sensor.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+static const std::string _tag = "thermal";
+
+static const char* _level_names[] = {"normal", "warm", "hot"};
+
+struct ThermalData_t {
+    std::mutex mutex;
+    std::atomic<bool> isRunning{false};
+    // Given on stop, so the task does not sleep out its interval
+    SemaphoreHandle_t wakeSem = nullptr;
+    SemaphoreHandle_t exitSem = nullptr;
+    hal::HalBase::ThermalConfig_t config;
+};
+static ThermalData_t _thermal_data;
+
+// Installed on the first read, shared by getCpuTemp() and the service task
+static std::mutex _sensor_mutex;
+static temperature_sensor_handle_t _temp_sensor = nullptr;
+
+static bool read_sensor(float& tempC)
+{
+    std::lock_guard<std::mutex> lock(_sensor_mutex);
+
+    if (_temp_sensor == nullptr) {
+        temperature_sensor_config_t config = {
+            .range_min = 20,
+            .range_max = 100,
+        };
+        if (temperature_sensor_install(&config, &_temp_sensor) != ESP_OK) {
+            _temp_sensor = nullptr;
+            return false;
+        }
+        temperature_sensor_enable(_temp_sensor);
+    }
+    return temperature_sensor_get_celsius(_temp_sensor, &tempC) == ESP_OK;
+}
+
+// A level is entered at its threshold and held until the temperature is the hysteresis below it
+static hal::HalBase::ThermalLevel_t next_level(hal::HalBase::ThermalLevel_t level, float tempC,
+                                               const hal::HalBase::ThermalConfig_t& config)
+{
+    if (tempC >= config.hotC ||
+        (level == hal::HalBase::THERMAL_LEVEL_HOT && tempC > config.hotC - config.hysteresisC)) {
+        return hal::HalBase::THERMAL_LEVEL_HOT;
+    }
+    if (tempC >= config.warmC ||
+        (level >= hal::HalBase::THERMAL_LEVEL_WARM && tempC > config.warmC - config.hysteresisC)) {
+        return hal::HalBase::THERMAL_LEVEL_WARM;
+    }
+    return hal::HalBase::THERMAL_LEVEL_NORMAL;
+}
+
+int HalEsp32::getCpuTemp()
+{
+    ThermalStatus_t status;
+    if (_thermal_data.isRunning && thermalSnapshot.read(status)) {
+        return std::lround(status.tempC);
+    }
+
+    float temp = 0;
+    read_sensor(temp);
+    return temp;
+}
+
+void HalEsp32::thermal_apply_level(ThermalLevel_t level)
+{
+    const auto& config = _thermal_data.config;
+    bool is_warm       = level >= THERMAL_LEVEL_WARM;
+
+    camera_set_fps_cap(is_warm ? config.warmCameraFps : 0);
+    if (lvDisp && config.warmRefreshPeriodMs) {
+        uint32_t period = is_warm ? config.warmRefreshPeriodMs : LV_DEF_REFR_PERIOD;
+        auto set_period = [this, period]() { lv_timer_set_period(lv_display_get_refr_timer(lvDisp), period); };
+        // Posted, the service task does not wait out a render. Under the lock right away if the queue is full
+        if (!postUiCommand(set_period)) {
+            LvglLockGuard lvgl_lock("thermal");
+            set_period();
+        }
+    }
+    power_policy_set_cpu_cap(level >= THERMAL_LEVEL_HOT ? config.hotCpuFreqMhz : 0);
+}
+
+void HalEsp32::thermal_service_task(void* param)
+{
+    static_cast<HalEsp32*>(param)->thermal_service_loop();
+
+    xSemaphoreGive(_thermal_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+void HalEsp32::thermal_service_loop()
+{
+    const auto config = _thermal_data.config;
+    ThermalStatus_t status;
+    int64_t last_us = 0;
+
+    while (_thermal_data.isRunning) {
+        float raw_c = 0;
+        if (read_sensor(raw_c)) {
+            int64_t now_us = esp_timer_get_time();
+            if (last_us == 0) {
+                status.tempC = raw_c;
+                status.peakC = raw_c;
+            } else {
+                // First order low pass, the slope between two samples is noisy and goes through the same filter
+                float dt_sec        = (now_us - last_us) / 1000000.0f;
+                float alpha         = dt_sec / (config.filterTimeSec + dt_sec);
+                float last_c        = status.tempC;
+                status.tempC        = last_c + alpha * (raw_c - last_c);
+                float slope         = (status.tempC - last_c) / dt_sec * 60.0f;
+                status.trendCPerMin = status.trendCPerMin + alpha * (slope - status.trendCPerMin);
+            }
+            last_us      = now_us;
+            status.rawC  = raw_c;
+            status.peakC = std::max(status.peakC, status.tempC);
+
+            auto level = next_level(status.level, status.tempC, config);
+            if (level != status.level) {
+                mclog::tagInfo(_tag, "{} -> {} at {:.1f} C, {:+.2f} C/min", _level_names[status.level],
+                               _level_names[level], status.tempC, status.trendCPerMin);
+                thermal_apply_level(level);
+                status.level = level;
+                GetEventBus().publish({shared_data::EVENT_TOPIC_THERMAL, 0, level});
+            }
+            thermalSnapshot.publish(status, millis());
+        }
+
+        xSemaphoreTake(_thermal_data.wakeSem, pdMS_TO_TICKS(config.sampleIntervalMs));
+    }
+
+    if (status.level != THERMAL_LEVEL_NORMAL) {
+        thermal_apply_level(THERMAL_LEVEL_NORMAL);
+        GetEventBus().publish({shared_data::EVENT_TOPIC_THERMAL, 0, THERMAL_LEVEL_NORMAL});
+    }
+}
+
+bool HalEsp32::startThermalService(const ThermalConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_thermal_data.mutex);
+
+    if (_thermal_data.isRunning) {
+        return true;
+    }
+    if (config.sampleIntervalMs == 0 || config.hotC < config.warmC || config.hysteresisC < 0) {
+        mclog::tagError(_tag, "invalid config");
+        return false;
+    }
+
+    _thermal_data.config = config;
+    if (_thermal_data.exitSem == nullptr) {
+        _thermal_data.exitSem = xSemaphoreCreateBinary();
+        _thermal_data.wakeSem = xSemaphoreCreateBinary();
+    }
+    xSemaphoreTake(_thermal_data.wakeSem, 0);
+
+    _thermal_data.isRunning = true;
+    if (xTaskCreate(thermal_service_task, "thermal", 4096, this, 2, nullptr) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _thermal_data.isRunning = false;
+        return false;
+    }
+
+    mclog::tagInfo(_tag, "start, every {} ms, warm {:.0f} C, hot {:.0f} C", config.sampleIntervalMs, config.warmC,
+                   config.hotC);
+    return true;
+}
+
+void HalEsp32::stopThermalService()
+{
+    std::lock_guard<std::mutex> lock(_thermal_data.mutex);
+
+    if (!_thermal_data.isRunning) {
+        return;
+    }
+
+    _thermal_data.isRunning = false;
+    xSemaphoreGive(_thermal_data.wakeSem);
+    xSemaphoreTake(_thermal_data.exitSem, portMAX_DELAY);
+    mclog::tagInfo(_tag, "stop");
+}
+
+bool HalEsp32::isThermalServiceRunning()
+{
+    return _thermal_data.isRunning;
+}
@@ -0,0 +1,234 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include "../utils/time_series_store/time_series_store.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <sys/time.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_timer.h>
+
+static const std::string _tag = "time-series";
+
+static const char* _root = "/sd/tsdb";
+// Samples a series keeps in RAM while no card is mounted, at the default interval that is over an hour
+static constexpr size_t _max_pending = 4096;
+// Before 2020 the clock was never set, samples would land decades back
+static constexpr int64_t _min_unix_ms = 1577836800LL * 1000;
+// History samples copied per read
+static constexpr size_t _history_batch = 32;
+
+struct TimeSeriesData_t {
+    std::mutex mutex;
+    TaskHandle_t task           = nullptr;
+    SemaphoreHandle_t exitSem   = nullptr;
+    std::atomic<bool> isRunning = false;
+    hal::HalBase::TimeSeriesConfig_t config;
+    TimeSeriesStore store;
+};
+static TimeSeriesData_t _ts_data;
+
+static int64_t unix_time_ms()
+{
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return (int64_t)tv.tv_sec * 1000 + tv.tv_usec / 1000;
+}
+
+// Mean of every field over what came after the cursor, false if nothing did
+template <typename T, size_t N, typename Fields>
+static bool history_mean(const History<T, N>& history, uint32_t& cursor, Fields fields, float* means, size_t count)
+{
+    std::fill(means, means + count, 0.0f);
+    T samples[_history_batch];
+    size_t total = 0;
+    size_t size;
+    while ((size = history.read(cursor, samples, _history_batch)) > 0) {
+        for (size_t i = 0; i < size; i++) {
+            fields(samples[i], means);
+        }
+        total += size;
+    }
+    if (total == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        means[i] /= total;
+    }
+    return true;
+}
+
+void HalEsp32::time_series_task(void* param)
+{
+    static_cast<HalEsp32*>(param)->time_series_loop();
+
+    xSemaphoreGive(_ts_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+void HalEsp32::time_series_loop()
+{
+    const auto config = _ts_data.config;
+    auto& store       = _ts_data.store;
+
+    // Only what is sampled from here on goes in
+    uint32_t power_cursor   = powerMonitorHistory.count();
+    uint32_t imu_cursor     = imuHistory.count();
+    uint32_t interval_ms    = config.sensorIntervalMs > 0 ? config.sensorIntervalMs : 1000;
+    int64_t flush_period_us = (int64_t)config.flushIntervalSec * 1000000;
+    int64_t last_flush_us   = esp_timer_get_time();
+    bool was_mounted        = false;
+
+    while (_ts_data.isRunning) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(interval_ms));
+        if (!_ts_data.isRunning) {
+            break;
+        }
+
+        int64_t now_ms = unix_time_ms();
+        if (config.sensorIntervalMs > 0 && now_ms >= _min_unix_ms) {
+            float pm[3];
+            auto pm_fields = [](const PMData_t& data, float* sums) {
+                sums[0] += data.busVoltage;
+                sums[1] += data.shuntCurrent;
+                sums[2] += data.busPower;
+            };
+            if (history_mean(powerMonitorHistory, power_cursor, pm_fields, pm, 3)) {
+                store.append("pm_voltage", now_ms, pm[0]);
+                store.append("pm_current", now_ms, pm[1]);
+                store.append("pm_power", now_ms, pm[2]);
+            }
+
+            float accel;
+            auto imu_fields = [](const IMUData_t& data, float* sums) {
+                sums[0] += std::sqrt(data.accelX * data.accelX + data.accelY * data.accelY + data.accelZ * data.accelZ);
+            };
+            if (history_mean(imuHistory, imu_cursor, imu_fields, &accel, 1)) {
+                store.append("imu_accel", now_ms, accel);
+            }
+
+            // Already filtered by the thermal service
+            ThermalStatus_t thermal;
+            if (thermalSnapshot.read(thermal)) {
+                store.append("cpu_temp", now_ms, thermal.tempC);
+            }
+        }
+
+        // Samples wait in RAM while there is no card, a removed card is read again once it is back
+        if (!isSdCardMounted()) {
+            if (was_mounted) {
+                store.invalidate();
+            }
+            was_mounted = false;
+            continue;
+        }
+        was_mounted = true;
+
+        bool is_due = esp_timer_get_time() - last_flush_us >= flush_period_us;
+        store.flush(is_due);
+        if (is_due) {
+            last_flush_us = esp_timer_get_time();
+        }
+    }
+
+    if (isSdCardMounted()) {
+        store.flush(true);
+    }
+}
+
+bool HalEsp32::startTimeSeries(const TimeSeriesConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_ts_data.mutex);
+
+    if (_ts_data.isRunning) {
+        return true;
+    }
+
+    _ts_data.config = config;
+    _ts_data.store.init(_root, config.blockSamples, _max_pending);
+    if (_ts_data.exitSem == nullptr) {
+        _ts_data.exitSem = xSemaphoreCreateBinary();
+    }
+
+    _ts_data.isRunning = true;
+    if (xTaskCreate(time_series_task, "time_series", 6144, this, 2, &_ts_data.task) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _ts_data.isRunning = false;
+        _ts_data.task      = nullptr;
+        return false;
+    }
+
+    mclog::tagInfo(_tag, "start, {} samples per block, flush every {} s, sensors every {} ms", config.blockSamples,
+                   config.flushIntervalSec, config.sensorIntervalMs);
+    return true;
+}
+
+void HalEsp32::stopTimeSeries()
+{
+    std::lock_guard<std::mutex> lock(_ts_data.mutex);
+
+    if (!_ts_data.isRunning) {
+        return;
+    }
+
+    // The task writes what is pending on its way out
+    _ts_data.isRunning = false;
+    xTaskNotifyGive(_ts_data.task);
+    xSemaphoreTake(_ts_data.exitSem, portMAX_DELAY);
+    _ts_data.task = nullptr;
+    mclog::tagInfo(_tag, "stop");
+}
+
+hal::HalBase::TimeSeriesStats_t HalEsp32::getTimeSeriesStats()
+{
+    auto store_stats = _ts_data.store.getStats();
+
+    TimeSeriesStats_t stats;
+    stats.isRunning    = _ts_data.isRunning;
+    stats.series       = _ts_data.store.getSeriesCount();
+    stats.samples      = store_stats.samples;
+    stats.dropped      = store_stats.dropped;
+    stats.blocks       = store_stats.blocks;
+    stats.bytesWritten = store_stats.bytesWritten;
+    stats.writeErrors  = store_stats.writeErrors;
+    return stats;
+}
+
+bool HalEsp32::timeSeriesAppend(const std::string& series, int64_t timeMs, float value)
+{
+    if (!_ts_data.isRunning) {
+        return false;
+    }
+    return _ts_data.store.append(series.c_str(), timeMs, value);
+}
+
+bool HalEsp32::timeSeriesQuery(const std::string& series, int64_t startMs, int64_t endMs, TimeSeriesResult_t& result)
+{
+    if (!_ts_data.isRunning || !isSdCardMounted()) {
+        return false;
+    }
+
+    TimeSeriesStore::Aggregate_t aggregate;
+    TimeSeriesStore::QueryStats_t query_stats;
+    if (!_ts_data.store.query(series.c_str(), startMs, endMs, aggregate, &query_stats)) {
+        return false;
+    }
+
+    result               = TimeSeriesResult_t();
+    result.count         = aggregate.count;
+    result.min           = aggregate.min;
+    result.max           = aggregate.max;
+    result.mean          = aggregate.count > 0 ? aggregate.sum / aggregate.count : 0.0f;
+    result.rollupsRead   = query_stats.rollupsRead;
+    result.indexRead     = query_stats.indexRead;
+    result.blocksDecoded = query_stats.blocksDecoded;
+    return true;
+}
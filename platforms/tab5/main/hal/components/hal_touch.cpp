@@ -0,0 +1,268 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include "../utils/input_trace/input_trace.h"
+#include <hal/spsc_ring.h>
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <bsp/m5stack_tab5.h>
+#include <esp_lcd_touch.h>
+#include <esp_lvgl_port.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static const std::string _tag = "touch";
+
+// GT911 on its backup address, as set up by the BSP
+static constexpr uint8_t _touch_i2c_addr = 0x14;
+// The controller reports at about 100 Hz while touched, a missed release report is caught by a read after this
+static constexpr uint32_t _release_timeout = 50;
+// Samples further apart are a new drag, no extrapolation across them
+static constexpr int64_t _max_predict_gap_us = 40000;
+
+extern esp_lcd_touch_handle_t _lcd_touch_handle;
+
+struct TouchData_t {
+    TaskHandle_t taskHandle = nullptr;
+    // Touch task to the LVGL read callback
+    SpscRing<hal::HalBase::TouchState_t> ring;
+    std::atomic<uint16_t> predictionMs{0};
+    // Reports are held back as released until the finger lifts
+    std::atomic<bool> isSuppressed{false};
+    std::mutex latestMutex;
+    hal::HalBase::TouchState_t latest;
+    // LVGL task only
+    hal::HalBase::TouchState_t current;
+    hal::HalBase::TouchState_t previous;
+    InputTrace inputTrace;
+    // Set with the timer read mode, so the end of a replay can switch the events back
+    bool isReplayMode = false;
+};
+static TouchData_t _touch_data;
+
+static void IRAM_ATTR touch_isr(esp_lcd_touch_handle_t tp)
+{
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(_touch_data.taskHandle, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+static void read_touch_state(hal::HalBase::TouchState_t& state)
+{
+    uint16_t x[5]        = {0};
+    uint16_t y[5]        = {0};
+    uint16_t strength[5] = {0};
+    uint8_t count        = 0;
+
+    // Top class on the internal bus, so a report never waits behind sensor reads or a diagnostic scan
+    bool ok = HalEsp32::i2cScheduler().run(I2cBusScheduler::PRIORITY_TOUCH, _touch_i2c_addr, [&]() {
+        if (esp_lcd_touch_read_data(_lcd_touch_handle) != ESP_OK) {
+            return false;
+        }
+        esp_lcd_touch_get_coordinates(_lcd_touch_handle, x, y, strength, &count, 5);
+        return true;
+    });
+
+    state.timestampUs = esp_timer_get_time();
+    state.count       = ok ? std::min<uint8_t>(count, 5) : 0;
+    for (uint8_t i = 0; i < state.count; i++) {
+        state.points[i].x        = x[i];
+        state.points[i].y        = y[i];
+        state.points[i].strength = strength[i];
+    }
+}
+
+static void _touch_task(void* param)
+{
+    bool is_pressed = false;
+
+    while (1) {
+        uint32_t notified = ulTaskNotifyTake(pdTRUE, is_pressed ? pdMS_TO_TICKS(_release_timeout) : portMAX_DELAY);
+        if (notified == 0 && !is_pressed) {
+            continue;
+        }
+
+        hal::HalBase::TouchState_t state;
+        read_touch_state(state);
+        is_pressed = state.count > 0;
+
+        // Latest first, so it is never older than the ring. A full ring means LVGL is stalled, the newest reports are
+        // the ones to lose, and the read callback falls back to latest once the ring is drained
+        {
+            std::lock_guard<std::mutex> lock(_touch_data.latestMutex);
+            _touch_data.latest = state;
+        }
+        _touch_data.ring.write(&state, 1);
+
+        // The LVGL task reads every input device on this event
+        lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, nullptr);
+    }
+}
+
+// Move the point ahead along the velocity of the last two reports
+static void predict_point(const hal::HalBase::TouchState_t& current, const hal::HalBase::TouchState_t& previous,
+                          int32_t& x, int32_t& y)
+{
+    uint16_t lead_ms = _touch_data.predictionMs;
+    int64_t dt_us    = current.timestampUs - previous.timestampUs;
+    if (lead_ms == 0 || previous.count == 0 || dt_us <= 0 || dt_us > _max_predict_gap_us) {
+        return;
+    }
+
+    // No further ahead than one report interval, past that the guess overshoots on every direction change
+    int64_t lead_us = std::min<int64_t>(lead_ms * 1000, dt_us);
+    x += (int64_t)(current.points[0].x - previous.points[0].x) * lead_us / dt_us;
+    y += (int64_t)(current.points[0].y - previous.points[0].y) * lead_us / dt_us;
+    x = std::clamp<int32_t>(x, 0, _lcd_touch_handle->config.x_max - 1);
+    y = std::clamp<int32_t>(y, 0, _lcd_touch_handle->config.y_max - 1);
+}
+
+static void lvgl_read_cb(lv_indev_t* indev, lv_indev_data_t* data)
+{
+    // One report per call, so quick taps and the whole drag path reach LVGL in order
+    hal::HalBase::TouchState_t state;
+    bool is_new = _touch_data.ring.read(&state, 1) == 1;
+    // Already taken from latest before it reached the ring
+    if (is_new && state.timestampUs <= _touch_data.current.timestampUs) {
+        is_new = false;
+    }
+    if (!is_new && _touch_data.ring.available() == 0) {
+        // A report the full ring dropped is still the latest one, a lost release would leave the touch pressed
+        std::lock_guard<std::mutex> lock(_touch_data.latestMutex);
+        if (_touch_data.latest.timestampUs != _touch_data.current.timestampUs) {
+            state  = _touch_data.latest;
+            is_new = true;
+        }
+    }
+    if (is_new) {
+        _touch_data.previous = _touch_data.current;
+        _touch_data.current  = state;
+    }
+    data->continue_reading = _touch_data.ring.available() > 0;
+    if (!data->continue_reading) {
+        std::lock_guard<std::mutex> lock(_touch_data.latestMutex);
+        data->continue_reading = _touch_data.latest.timestampUs != _touch_data.current.timestampUs;
+    }
+
+    const auto& current = _touch_data.current;
+    if (current.count == 0) {
+        _touch_data.isSuppressed = false;
+    }
+    bool is_pressed = current.count > 0 && !_touch_data.isSuppressed;
+    int32_t x       = current.points[0].x;
+    int32_t y       = current.points[0].y;
+    // Ink follows the real reports, a predicted point would leave a stroke where the pen never was
+    if (is_new) {
+        HalEsp32::inkProcessTouch(is_pressed, x, y);
+    }
+    if (is_pressed && !data->continue_reading) {
+        predict_point(current, _touch_data.previous, x, y);
+    }
+
+    // Recorded as LVGL sees it, after the prediction, a replay then needs no touch controller
+    uint32_t now_ms = lv_tick_get();
+    if (_touch_data.inputTrace.process(now_ms, is_pressed, x, y)) {
+        data->continue_reading = true;
+    }
+    if (_touch_data.isReplayMode && _touch_data.inputTrace.getState() != InputTrace::Replaying) {
+        _touch_data.isReplayMode = false;
+        lv_indev_set_mode(indev, LV_INDEV_MODE_EVENT);
+    }
+
+    data->state   = is_pressed ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+    data->point.x = x;
+    data->point.y = y;
+}
+
+void HalEsp32::touch_init()
+{
+    // The BSP indev reads the controller on every interrupt as well, this one replaces it
+    lvgl_port_remove_touch(bsp_display_get_input_dev());
+
+    _touch_data.ring.init(32);
+    xTaskCreate(_touch_task, "touch", 4096, nullptr, 10, &_touch_data.taskHandle);
+    if (esp_lcd_touch_register_interrupt_callback(_lcd_touch_handle, touch_isr) != ESP_OK) {
+        mclog::tagError(_tag, "register touch interrupt failed");
+    }
+
+    lvTouchpad = lv_indev_create();
+    lv_indev_set_type(lvTouchpad, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(lvTouchpad, lvgl_read_cb);
+    lv_indev_set_display(lvTouchpad, lvDisp);
+    // Read on the touch task's wakeups only, no periodic polling
+    lv_indev_set_mode(lvTouchpad, LV_INDEV_MODE_EVENT);
+}
+
+void HalEsp32::suppress_touch_until_release()
+{
+    _touch_data.isSuppressed = true;
+}
+
+hal::HalBase::TouchState_t HalEsp32::getTouchState()
+{
+    std::lock_guard<std::mutex> lock(_touch_data.latestMutex);
+    return _touch_data.latest;
+}
+
+void HalEsp32::setTouchPrediction(uint16_t leadMs)
+{
+    _touch_data.predictionMs = leadMs;
+    mclog::tagInfo(_tag, "prediction lead {} ms", leadMs);
+}
+
+bool HalEsp32::startInputRecord(const std::string& path)
+{
+    if (!mount_sd_card()) {
+        return false;
+    }
+    if (!_touch_data.inputTrace.startRecord("/sd/" + path, lv_tick_get())) {
+        mclog::tagError(_tag, "start input record {} failed", path);
+        return false;
+    }
+    mclog::tagInfo(_tag, "input record to {}", path);
+    return true;
+}
+
+bool HalEsp32::startInputReplay(const std::string& path)
+{
+    if (!mount_sd_card()) {
+        return false;
+    }
+
+    // The replay has no touch interrupts to wake the read, it is polled for its length
+    LvglLockGuard lock;
+    if (!_touch_data.inputTrace.startReplay("/sd/" + path, lv_tick_get())) {
+        mclog::tagError(_tag, "start input replay {} failed", path);
+        return false;
+    }
+    _touch_data.isReplayMode = true;
+    lv_indev_set_mode(lvTouchpad, LV_INDEV_MODE_TIMER);
+    mclog::tagInfo(_tag, "input replay from {}, {} ms", path, _touch_data.inputTrace.getDurationMs());
+    return true;
+}
+
+void HalEsp32::stopInputTrace(bool dropLastTap)
+{
+    LvglLockGuard lock;
+    _touch_data.inputTrace.stop(dropLastTap);
+    if (_touch_data.isReplayMode) {
+        _touch_data.isReplayMode = false;
+        lv_indev_set_mode(lvTouchpad, LV_INDEV_MODE_EVENT);
+    }
+}
+
+hal::HalBase::InputTraceStatus_t HalEsp32::getInputTraceStatus()
+{
+    InputTraceStatus_t status;
+    status.state      = static_cast<InputTraceState_t>(_touch_data.inputTrace.getState());
+    status.events     = _touch_data.inputTrace.getEventCount();
+    status.elapsedMs  = _touch_data.inputTrace.getElapsedMs(lv_tick_get());
+    status.durationMs = _touch_data.inputTrace.getDurationMs();
+    return status;
+}
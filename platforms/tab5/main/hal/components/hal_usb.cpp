@@ -9,7 +9,13 @@
 #include <driver/gpio.h>
 #include <memory>
 #include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <string.h>
 #include <lvgl.h>
+#include <esp_lvgl_port.h>
+#include <hal/spsc_ring.h>
 #include <usb/usb_host.h>
 #include <usb/hid_host.h>
 #include <usb/hid_usage_keyboard.h>
@@ -19,89 +25,496 @@
 
 #define TAG "usba"
 
-static std::mutex _usba_detect_mutex;
-static bool _is_usba_connected = false;
+// The panel's native portrait resolution, the display rotates it to landscape
+static constexpr int32_t _native_width  = 720;
+static constexpr int32_t _native_height = 1280;
+// Absolute pointers are scaled to this range before they are queued
+static constexpr int32_t _absolute_range = 65535;
+// Relative motion not yet read is held to this many counts per axis, well past the screen
+static constexpr int32_t _motion_limit = 2047;
+// A read after a longer pause measures the speed over this much time, the first motion after a stop is not sped up
+static constexpr uint32_t _accel_max_interval_ms = 16;
+
+static constexpr uint32_t _usage_desktop_x   = 0x00010030;
+static constexpr uint32_t _usage_desktop_y   = 0x00010031;
+static constexpr uint32_t _usage_tip_switch  = 0x000D0042;
+static constexpr uint16_t _usage_page_button = 0x0009;
+
+// Not named in hid_usage_keyboard.h, keypad usages from the HID usage tables
+static constexpr uint8_t _usage_keypad_slash = 0x54;
+static constexpr uint8_t _usage_keypad_dot   = 0x63;
+
+// The cursor is a flush time overlay when the display supports it, moving it then renders nothing
 static lv_obj_t* _cursor_img;
+static bool _is_cursor_overlay = false;
 
-QueueHandle_t app_event_queue = NULL;
-typedef enum { APP_EVENT = 0, APP_EVENT_HID_HOST } app_event_group_t;
+// The HID driver runs its reports above the mass storage and serial drivers, so their transfers never delay input
+static constexpr UBaseType_t _hid_driver_priority = 6;
+// Every interface of a keyboard and mouse pair behind a hub can connect at once
+static constexpr UBaseType_t _hid_event_queue_size = 16;
 
-typedef struct {
-    app_event_group_t event_group;
-    struct {
-        hid_host_device_handle_t handle;
-        hid_host_driver_event_t event;
-        void* arg;
-    } hid_host_device;
-} app_event_queue_t;
+// Device connections only, reports go from the driver task straight to the rings
+struct HidDeviceEvent_t {
+    hid_host_device_handle_t handle;
+    hid_host_driver_event_t event;
+    void* arg;
+};
+static QueueHandle_t _hid_event_queue = NULL;
 
 static const char* hid_proto_name_str[] = {"NONE", "KEYBOARD", "MOUSE"};
 
-typedef struct {
-    enum key_state { KEY_STATE_PRESSED = 0x00, KEY_STATE_RELEASED = 0x01 } state;
-    uint8_t modifier;
-    uint8_t key_code;
-} key_event_t;
+struct PointerReport_t {
+    bool isAbsolute = false;
+    // Counts moved, or the position in 0 to _absolute_range for absolute devices
+    int32_t x       = 0;
+    int32_t y       = 0;
+    uint8_t buttons = 0;
+};
+
+struct KeyEvent_t {
+    uint32_t key   = 0;
+    bool isPressed = false;
+};
+
+struct HidField_t {
+    uint16_t bitOffset = 0;
+    uint8_t bitSize    = 0;
+    int32_t logicalMin = 0;
+    int32_t logicalMax = 0;
+};
+
+// Where a report protocol pointer keeps its values, from the report descriptor
+struct PointerLayout_t {
+    // 0 when the device sends no report ids
+    uint8_t reportId = 0;
+    bool isAbsolute  = false;
+    HidField_t x;
+    HidField_t y;
+    HidField_t buttons[8];
+    uint8_t buttonCount = 0;
+    bool hasTip         = false;
+    HidField_t tip;
+};
+
+// Opened interface, passed to its callbacks as the arg
+struct HidDevice_t {
+    hid_protocol_t proto = HID_PROTOCOL_NONE;
+    bool isBoot          = false;
+    bool hasPointer      = false;
+    PointerLayout_t pointer;
+    // Last keyboard report, new reports are diffed against it
+    uint8_t keys[HID_KEYBOARD_KEY_MAX] = {0};
+    bool isCapsLock                    = false;
+};
+
+struct HidData_t {
+    std::atomic<int> deviceCount{0};
+    std::atomic<int> pointerCount{0};
+    // HID host task to the LVGL read callbacks, input never waits on the LVGL lock. Relative motion is summed into
+    // motion, dx and dy in 12 bits each and in the top 8 the count of button changes queued to pointerRing. Absolute
+    // reports and the button changes of relative ones go through the ring, each change carries the motion before it
+    std::atomic<uint32_t> motion{0};
+    SpscRing<PointerReport_t> pointerRing;
+    SpscRing<KeyEvent_t> keyRing;
+    // HID host task only
+    uint8_t relativeButtons = 0;
+    bool isWakeNeeded       = false;
+    // LVGL task only
+    int32_t pointerX        = _native_width / 2;
+    int32_t pointerY        = _native_height / 2;
+    uint8_t pointerButtons  = 0;
+    uint8_t readChanges     = 0;
+    uint32_t lastMotionTick = 0;
+    float motionRemainderX  = 0;
+    float motionRemainderY  = 0;
+    hal::HalBase::PointerAccelConfig_t accel;
+    KeyEvent_t lastKey;
+};
+static HidData_t _hid_data;
+
+static bool is_pointer(const HidDevice_t* device)
+{
+    return device->isBoot ? device->proto == HID_PROTOCOL_MOUSE : device->hasPointer;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              Report descriptor                             */
+/* -------------------------------------------------------------------------- */
+struct FoundField_t {
+    uint8_t reportId = 0;
+    uint32_t usage   = 0;
+    bool isRelative  = false;
+    HidField_t field;
+};
+
+// Just enough of the descriptor for a pointer, X and Y, buttons 1 to 8 and the digitizer tip switch
+static bool parse_pointer_layout(const uint8_t* desc, size_t length, PointerLayout_t& layout)
+{
+    uint16_t usage_page   = 0;
+    int32_t logical_min   = 0;
+    int32_t logical_max   = 0;
+    uint8_t report_size   = 0;
+    uint8_t report_id     = 0;
+    uint16_t report_count = 0;
+    std::vector<uint32_t> usages;
+    uint32_t usage_min = 0;
+    uint32_t usage_max = 0;
+    // Input bits so far, per report id
+    std::vector<uint16_t> offsets(256, 0);
+    std::vector<FoundField_t> found;
+
+    size_t pos = 0;
+    while (pos < length) {
+        uint8_t prefix = desc[pos++];
+        // Long items, none of them matter here
+        if (prefix == 0xFE) {
+            if (pos >= length) {
+                break;
+            }
+            pos += 2 + desc[pos];
+            continue;
+        }
+
+        uint8_t size = prefix & 0x03;
+        size         = size == 3 ? 4 : size;
+        if (pos + size > length) {
+            break;
+        }
+        uint32_t value = 0;
+        for (uint8_t i = 0; i < size; i++) {
+            value |= (uint32_t)desc[pos + i] << (i * 8);
+        }
+        int32_t signed_value = value;
+        if (size > 0 && size < 4 && (value >> (size * 8 - 1)) & 1) {
+            signed_value = value | (~0u << (size * 8));
+        }
+        pos += size;
+
+        uint8_t type = (prefix >> 2) & 0x03;
+        uint8_t tag  = prefix >> 4;
+        if (type == 0) {
+            // Input, other main items only end the local state
+            if (tag == 0x08) {
+                bool is_constant = value & 0x01;
+                bool is_relative = value & 0x04;
+                uint16_t& offset = offsets[report_id];
+                for (uint16_t i = 0; i < report_count && !is_constant; i++) {
+                    uint32_t usage = 0;
+                    if (!usages.empty()) {
+                        usage = usages[std::min<size_t>(i, usages.size() - 1)];
+                    } else if (usage_max >= usage_min) {
+                        usage = std::min(usage_min + i, usage_max);
+                    }
+                    HidField_t field = {(uint16_t)(offset + i * report_size), report_size, logical_min, logical_max};
+                    found.push_back({report_id, usage, is_relative, field});
+                }
+                offset += report_size * report_count;
+            }
+            usages.clear();
+            usage_min = 0;
+            usage_max = 0;
+        } else if (type == 1) {
+            switch (tag) {
+                case 0x00:
+                    usage_page = value;
+                    break;
+                case 0x01:
+                    logical_min = signed_value;
+                    break;
+                case 0x02:
+                    // A short maximum past the signed range, e.g. 0xFF for 255
+                    logical_max = signed_value < logical_min ? (int32_t)value : signed_value;
+                    break;
+                case 0x07:
+                    report_size = value;
+                    break;
+                case 0x08:
+                    report_id = value;
+                    break;
+                case 0x09:
+                    report_count = value;
+                    break;
+                default:
+                    break;
+            }
+        } else if (type == 2) {
+            // 4 byte usages carry their own page
+            uint32_t usage = size == 4 ? value : ((uint32_t)usage_page << 16) | value;
+            if (tag == 0x00) {
+                usages.push_back(usage);
+            } else if (tag == 0x01) {
+                usage_min = usage;
+            } else if (tag == 0x02) {
+                usage_max = usage;
+            }
+        }
+    }
+
+    // The first report carrying X decides, the other fields have to be in the same one
+    auto x =
+        std::find_if(found.begin(), found.end(), [](const FoundField_t& f) { return f.usage == _usage_desktop_x; });
+    if (x == found.end()) {
+        return false;
+    }
+    layout            = PointerLayout_t();
+    layout.reportId   = x->reportId;
+    layout.isAbsolute = !x->isRelative;
+    layout.x          = x->field;
+
+    bool has_y = false;
+    for (const auto& f : found) {
+        if (f.reportId != layout.reportId) {
+            continue;
+        }
+        if (f.usage == _usage_desktop_y) {
+            layout.y = f.field;
+            has_y    = true;
+        } else if (f.usage == _usage_tip_switch) {
+            layout.tip    = f.field;
+            layout.hasTip = true;
+        } else if ((f.usage >> 16) == _usage_page_button && (f.usage & 0xFFFF) >= 1 && (f.usage & 0xFFFF) <= 8) {
+            uint8_t index         = (f.usage & 0xFFFF) - 1;
+            layout.buttons[index] = f.field;
+            layout.buttonCount    = std::max<uint8_t>(layout.buttonCount, index + 1);
+        }
+    }
+    return has_y && layout.x.logicalMax > layout.x.logicalMin && layout.y.logicalMax > layout.y.logicalMin;
+}
+
+static int32_t get_field(const uint8_t* data, size_t length, const HidField_t& field)
+{
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < field.bitSize && i < 32; i++) {
+        uint32_t bit = field.bitOffset + i;
+        if (bit / 8 >= length) {
+            return 0;
+        }
+        value |= (uint32_t)((data[bit / 8] >> (bit % 8)) & 1) << i;
+    }
+    // Signed when the logical range goes below zero
+    if (field.logicalMin < 0 && field.bitSize > 0 && field.bitSize < 32 && (value >> (field.bitSize - 1)) & 1) {
+        value |= ~0u << field.bitSize;
+    }
+    return value;
+}
+
+static int32_t scale_absolute(int32_t value, const HidField_t& field)
+{
+    value = std::clamp(value, field.logicalMin, field.logicalMax);
+    return (int64_t)(value - field.logicalMin) * _absolute_range / (field.logicalMax - field.logicalMin);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                   Reports                                  */
+/* -------------------------------------------------------------------------- */
+static uint32_t pack_motion(int32_t dx, int32_t dy, uint8_t changes)
+{
+    return (dx & 0xFFF) | (dy & 0xFFF) << 12 | (uint32_t)changes << 24;
+}
+
+static int32_t motion_dx(uint32_t motion)
+{
+    return (int32_t)(motion << 20) >> 20;
+}
 
-#define KEYBOARD_ENTER_MAIN_CHAR '\r'
-#define KEYBOARD_ENTER_LF_EXTEND 1
+static int32_t motion_dy(uint32_t motion)
+{
+    return (int32_t)(motion << 8) >> 20;
+}
 
-static void hid_print_new_device_report_header(hid_protocol_t proto)
+static uint8_t motion_changes(uint32_t motion)
 {
-    static hid_protocol_t prev_proto_output;
-
-    if (prev_proto_output != proto) {
-        prev_proto_output = proto;
-        printf("\r\n");
-        if (proto == HID_PROTOCOL_MOUSE) {
-            printf("Mouse\r\n");
-        } else if (proto == HID_PROTOCOL_KEYBOARD) {
-            printf("Keyboard\r\n");
+    return motion >> 24;
+}
+
+static void push_pointer_report(const PointerReport_t& report)
+{
+    if (report.isAbsolute) {
+        // A full ring means LVGL is stalled, the newest reports are the ones to lose
+        _hid_data.isWakeNeeded = true;
+        _hid_data.pointerRing.write(&report, 1);
+        return;
+    }
+
+    // A button change takes the motion summed so far with it, the motion after it waits until LVGL has read it. With
+    // the ring full it is left for the next report, which still holds the buttons
+    bool is_change = report.buttons != _hid_data.relativeButtons && _hid_data.pointerRing.space() > 0;
+    uint32_t old   = _hid_data.motion.load(std::memory_order_relaxed);
+    uint32_t next;
+    do {
+        if (is_change) {
+            next = pack_motion(0, 0, motion_changes(old) + 1);
         } else {
-            printf("Generic\r\n");
+            next = pack_motion(std::clamp(motion_dx(old) + report.x, -_motion_limit, _motion_limit),
+                               std::clamp(motion_dy(old) + report.y, -_motion_limit, _motion_limit),
+                               motion_changes(old));
         }
-        fflush(stdout);
+    } while (!_hid_data.motion.compare_exchange_weak(old, next, std::memory_order_acq_rel));
+
+    if (is_change) {
+        PointerReport_t change = report;
+        change.x += motion_dx(old);
+        change.y += motion_dy(old);
+        _hid_data.pointerRing.write(&change, 1);
+        _hid_data.relativeButtons = report.buttons;
+        _hid_data.isWakeNeeded    = true;
+    } else if (motion_dx(old) == 0 && motion_dy(old) == 0 && next != old) {
+        // Motion already waiting has a read coming, at 1000 Hz most reports wake nothing
+        _hid_data.isWakeNeeded = true;
     }
 }
 
-static void hid_host_mouse_report_callback(const uint8_t* const data, const int length)
+static void push_key_event(uint32_t key, bool isPressed)
 {
-    hid_mouse_input_report_boot_t* mouse_report = (hid_mouse_input_report_boot_t*)data;
+    if (key == 0) {
+        return;
+    }
+    KeyEvent_t event;
+    event.key       = key;
+    event.isPressed = isPressed;
+    _hid_data.keyRing.write(&event, 1);
+    _hid_data.isWakeNeeded = true;
+}
 
+static void handle_boot_mouse_report(const uint8_t* data, size_t length)
+{
     if (length < sizeof(hid_mouse_input_report_boot_t)) {
         return;
     }
+    auto mouse_report = (const hid_mouse_input_report_boot_t*)data;
 
-    static int x_pos = 720 / 2;
-    static int y_pos = 1280 / 2;
+    PointerReport_t report;
+    report.x       = mouse_report->x_displacement;
+    report.y       = mouse_report->y_displacement;
+    report.buttons = data[0];
+    push_pointer_report(report);
+}
 
-    // Calculate absolute position from displacement
-    x_pos += mouse_report->y_displacement;
-    y_pos -= mouse_report->x_displacement;
+static void handle_generic_report(HidDevice_t* device, const uint8_t* data, size_t length)
+{
+    if (!device->hasPointer) {
+        return;
+    }
+    const auto& layout = device->pointer;
 
-    x_pos = std::clamp(x_pos, 0, 720);
-    y_pos = std::clamp(y_pos, 0, 1280);
+    // With report ids the first byte is the id, the field offsets start after it
+    if (layout.reportId != 0) {
+        if (length == 0 || data[0] != layout.reportId) {
+            return;
+        }
+        data++;
+        length--;
+    }
 
-    hid_print_new_device_report_header(HID_PROTOCOL_MOUSE);
+    PointerReport_t report;
+    report.isAbsolute = layout.isAbsolute;
+    report.x          = get_field(data, length, layout.x);
+    report.y          = get_field(data, length, layout.y);
+    if (layout.isAbsolute) {
+        report.x = scale_absolute(report.x, layout.x);
+        report.y = scale_absolute(report.y, layout.y);
+    }
+    for (uint8_t i = 0; i < layout.buttonCount; i++) {
+        report.buttons |= get_field(data, length, layout.buttons[i]) ? 1 << i : 0;
+    }
+    if (layout.hasTip && get_field(data, length, layout.tip)) {
+        report.buttons |= 0x01;
+    }
+    push_pointer_report(report);
+}
 
-    // printf("X: %06d\tY: %06d\t|%c|%c|\r", x_pos, y_pos, (mouse_report->buttons.button1 ? 'o' : ' '),
-    //        (mouse_report->buttons.button2 ? 'o' : ' '));
+static uint32_t to_lvgl_key(uint8_t usage, bool isShift, bool isCapsLock)
+{
+    switch (usage) {
+        case HID_KEY_ENTER:
+        case HID_KEY_KEYPAD_ENTER:
+            return LV_KEY_ENTER;
+        case HID_KEY_ESC:
+            return LV_KEY_ESC;
+        case HID_KEY_DEL:
+            return LV_KEY_BACKSPACE;
+        case HID_KEY_TAB:
+            return isShift ? LV_KEY_PREV : LV_KEY_NEXT;
+        case HID_KEY_SPACE:
+            return ' ';
+        case HID_KEY_DELETE:
+            return LV_KEY_DEL;
+        case HID_KEY_HOME:
+            return LV_KEY_HOME;
+        case HID_KEY_END:
+            return LV_KEY_END;
+        case HID_KEY_RIGHT:
+            return LV_KEY_RIGHT;
+        case HID_KEY_LEFT:
+            return LV_KEY_LEFT;
+        case HID_KEY_DOWN:
+            return LV_KEY_DOWN;
+        case HID_KEY_UP:
+            return LV_KEY_UP;
+        default:
+            break;
+    }
 
-    GetHAL()->hidMouseData.mutex.lock();
-    GetHAL()->hidMouseData.x        = x_pos;
-    GetHAL()->hidMouseData.y        = y_pos;
-    GetHAL()->hidMouseData.btnLeft  = mouse_report->buttons.button1;
-    GetHAL()->hidMouseData.btnRight = mouse_report->buttons.button2;
-    GetHAL()->hidMouseData.mutex.unlock();
+    if (usage >= HID_KEY_A && usage <= HID_KEY_Z) {
+        char c = 'a' + (usage - HID_KEY_A);
+        return isShift != isCapsLock ? c - 'a' + 'A' : c;
+    }
+    if (usage >= HID_KEY_1 && usage <= HID_KEY_0) {
+        return (isShift ? "!@#$%^&*()" : "1234567890")[usage - HID_KEY_1];
+    }
+    if (usage >= HID_KEY_MINUS && usage <= HID_KEY_SLASH) {
+        return (isShift ? "_+{}|~:\"~<>?" : "-=[]\\#;'`,./")[usage - HID_KEY_MINUS];
+    }
+    if (usage >= _usage_keypad_slash && usage <= _usage_keypad_dot && usage != HID_KEY_KEYPAD_ENTER) {
+        return "/*-+\n1234567890."[usage - _usage_keypad_slash];
+    }
+    return 0;
+}
 
-    fflush(stdout);
+static bool contains_key(const uint8_t* keys, uint8_t key)
+{
+    return std::find(keys, keys + HID_KEYBOARD_KEY_MAX, key) != keys + HID_KEYBOARD_KEY_MAX;
+}
+
+static void handle_boot_keyboard_report(HidDevice_t* device, const uint8_t* data, size_t length)
+{
+    if (length < sizeof(hid_keyboard_input_report_boot_t)) {
+        return;
+    }
+    auto keyboard_report = (const hid_keyboard_input_report_boot_t*)data;
+    const uint8_t* keys  = keyboard_report->key;
+    // More keys down than the report holds, the previous state stays
+    if (keys[0] == HID_KEY_ROLLOVER) {
+        return;
+    }
+    bool is_shift = keyboard_report->modifier.left_shift || keyboard_report->modifier.right_shift;
+
+    // Releases first, so a fast roll from one key to the next reaches LVGL in order
+    for (auto key : device->keys) {
+        if (key > HID_KEY_ERROR_UNDEFINED && !contains_key(keys, key)) {
+            push_key_event(to_lvgl_key(key, is_shift, device->isCapsLock), false);
+        }
+    }
+    for (uint8_t i = 0; i < HID_KEYBOARD_KEY_MAX; i++) {
+        uint8_t key = keys[i];
+        if (key <= HID_KEY_ERROR_UNDEFINED || contains_key(device->keys, key)) {
+            continue;
+        }
+        if (key == HID_KEY_CAPS_LOCK) {
+            device->isCapsLock = !device->isCapsLock;
+            continue;
+        }
+        push_key_event(to_lvgl_key(key, is_shift, device->isCapsLock), true);
+    }
+    memcpy(device->keys, keys, HID_KEYBOARD_KEY_MAX);
 }
 
 void hid_host_interface_callback(hid_host_device_handle_t hid_device_handle, const hid_host_interface_event_t event,
                                  void* arg)
 {
-    uint8_t data[64]   = {0};
-    size_t data_length = 0;
+    uint8_t data[64]    = {0};
+    size_t data_length  = 0;
+    HidDevice_t* device = static_cast<HidDevice_t*>(arg);
     hid_host_dev_params_t dev_params;
     ESP_ERROR_CHECK(hid_host_device_get_params(hid_device_handle, &dev_params));
 
@@ -109,24 +522,35 @@ void hid_host_interface_callback(hid_host_device_handle_t hid_device_handle, con
         case HID_HOST_INTERFACE_EVENT_INPUT_REPORT:
             ESP_ERROR_CHECK(hid_host_device_get_raw_input_report_data(hid_device_handle, data, 64, &data_length));
 
-            if (HID_SUBCLASS_BOOT_INTERFACE == dev_params.sub_class) {
-                if (HID_PROTOCOL_KEYBOARD == dev_params.proto) {
-                    // hid_host_keyboard_report_callback(data, data_length);
-                } else if (HID_PROTOCOL_MOUSE == dev_params.proto) {
-                    hid_host_mouse_report_callback(data, data_length);
+            if (device->isBoot) {
+                if (HID_PROTOCOL_KEYBOARD == device->proto) {
+                    handle_boot_keyboard_report(device, data, data_length);
+                } else if (HID_PROTOCOL_MOUSE == device->proto) {
+                    handle_boot_mouse_report(data, data_length);
                 }
             } else {
-                // hid_host_generic_report_callback(data, data_length);
+                handle_generic_report(device, data, data_length);
             }
 
+            // Both indevs are event driven, the LVGL task reads every input device on this event
+            if (_hid_data.isWakeNeeded) {
+                _hid_data.isWakeNeeded = false;
+                lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, nullptr);
+            }
             break;
         case HID_HOST_INTERFACE_EVENT_DISCONNECTED:
             ESP_LOGI(TAG, "HID Device, protocol '%s' DISCONNECTED", hid_proto_name_str[dev_params.proto]);
             ESP_ERROR_CHECK(hid_host_device_close(hid_device_handle));
 
-            _usba_detect_mutex.lock();
-            _is_usba_connected = false;
-            _usba_detect_mutex.unlock();
+            if (is_pointer(device)) {
+                _hid_data.pointerCount--;
+            }
+            delete device;
+            if (--_hid_data.deviceCount == 0) {
+                GetHAL()->releasePerfLevel("usb");
+            }
+            // Hides the cursor
+            lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, nullptr);
 
             break;
         case HID_HOST_INTERFACE_EVENT_TRANSFER_ERROR:
@@ -147,20 +571,40 @@ void hid_host_device_event(hid_host_device_handle_t hid_device_handle, const hid
         case HID_HOST_DRIVER_EVENT_CONNECTED: {
             ESP_LOGI(TAG, "HID Device, protocol '%s' CONNECTED", hid_proto_name_str[dev_params.proto]);
 
-            const hid_host_device_config_t dev_config = {.callback = hid_host_interface_callback, .callback_arg = NULL};
+            auto device    = new HidDevice_t();
+            device->proto  = (hid_protocol_t)dev_params.proto;
+            device->isBoot = HID_SUBCLASS_BOOT_INTERFACE == dev_params.sub_class;
+
+            const hid_host_device_config_t dev_config = {.callback     = hid_host_interface_callback,
+                                                         .callback_arg = device};
 
             ESP_ERROR_CHECK(hid_host_device_open(hid_device_handle, &dev_config));
-            if (HID_SUBCLASS_BOOT_INTERFACE == dev_params.sub_class) {
+            if (device->isBoot) {
                 ESP_ERROR_CHECK(hid_class_request_set_protocol(hid_device_handle, HID_REPORT_PROTOCOL_BOOT));
                 if (HID_PROTOCOL_KEYBOARD == dev_params.proto) {
                     ESP_ERROR_CHECK(hid_class_request_set_idle(hid_device_handle, 0, 0));
                 }
+            } else {
+                // Tablets, touch screens and other report protocol pointers
+                size_t desc_length  = 0;
+                const uint8_t* desc = hid_host_get_report_descriptor(hid_device_handle, &desc_length);
+                device->hasPointer  = desc != nullptr && parse_pointer_layout(desc, desc_length, device->pointer);
+                if (device->hasPointer) {
+                    ESP_LOGI(TAG, "generic pointer, report id %d, %s, %d buttons", device->pointer.reportId,
+                             device->pointer.isAbsolute ? "absolute" : "relative", device->pointer.buttonCount);
+                }
+            }
+            if (is_pointer(device)) {
+                _hid_data.pointerCount++;
             }
             ESP_ERROR_CHECK(hid_host_device_start(hid_device_handle));
 
-            _usba_detect_mutex.lock();
-            _is_usba_connected = true;
-            _usba_detect_mutex.unlock();
+            // The host keeps polling the device, no light sleep while one is attached
+            if (_hid_data.deviceCount++ == 0) {
+                GetHAL()->claimPerfLevel("usb", hal::HalBase::PERF_LEVEL_AWAKE);
+            }
+            // Shows the cursor
+            lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, nullptr);
 
             break;
         }
@@ -172,101 +616,185 @@ void hid_host_device_event(hid_host_device_handle_t hid_device_handle, const hid
 void hid_host_device_callback(hid_host_device_handle_t hid_device_handle, const hid_host_driver_event_t event,
                               void* arg)
 {
-    const app_event_queue_t evt_queue = {.event_group = APP_EVENT_HID_HOST,
-                                         // HID Host Device related info
-                                         .hid_host_device = {.handle = hid_device_handle, .event = event, .arg = arg}};
-
-    if (app_event_queue) {
-        xQueueSend(app_event_queue, &evt_queue, 0);
+    // Runs in the driver task, opening the device from here would wait on that same task
+    const HidDeviceEvent_t device_event = {.handle = hid_device_handle, .event = event, .arg = arg};
+    if (_hid_event_queue == NULL || xQueueSend(_hid_event_queue, &device_event, 0) != pdTRUE) {
+        ESP_LOGW(TAG, "HID device event dropped");
     }
 }
 
-static void tab5_usb_host_task(void* pvParameters)
+static void hid_event_task(void* param)
 {
-    // BaseType_t task_created;
-    app_event_queue_t evt_queue;
-    // ESP_LOGI(TAG, "HID Host example");
-    // task_created = xTaskCreatePinnedToCore(usb_lib_task, "usb_events", 4096, xTaskGetCurrentTaskHandle(), 2, NULL,
-    // 0); assert(task_created == pdTRUE);
-
     ulTaskNotifyTake(false, 1000);
     const hid_host_driver_config_t hid_host_driver_config = {.create_background_task = true,
-                                                             .task_priority          = 5,
+                                                             .task_priority          = _hid_driver_priority,
                                                              .stack_size             = 4096,
                                                              .core_id                = 0,
                                                              .callback               = hid_host_device_callback,
                                                              .callback_arg           = NULL};
 
+    _hid_event_queue = xQueueCreate(_hid_event_queue_size, sizeof(HidDeviceEvent_t));
     ESP_ERROR_CHECK(hid_host_install(&hid_host_driver_config));
-
-    // Create queue
-    app_event_queue = xQueueCreate(10, sizeof(app_event_queue_t));
-
     ESP_LOGI(TAG, "Waiting for HID Device to be connected");
 
+    HidDeviceEvent_t device_event;
     while (1) {
-        // Wait queue
-        if (xQueueReceive(app_event_queue, &evt_queue, portMAX_DELAY)) {
-            if (APP_EVENT == evt_queue.event_group) {
-                // User pressed button
-                usb_host_lib_info_t lib_info;
-                ESP_ERROR_CHECK(usb_host_lib_info(&lib_info));
-                if (lib_info.num_devices == 0) {
-                    // End while cycle
-                    break;
-                } else {
-                    ESP_LOGW(TAG, "To shutdown example, remove all USB devices and press button again.");
-                    // Keep polling
-                }
-            }
-
-            if (APP_EVENT_HID_HOST == evt_queue.event_group) {
-                hid_host_device_event(evt_queue.hid_host_device.handle, evt_queue.hid_host_device.event,
-                                      evt_queue.hid_host_device.arg);
-            }
+        if (xQueueReceive(_hid_event_queue, &device_event, portMAX_DELAY) == pdTRUE) {
+            hid_host_device_event(device_event.handle, device_event.event, device_event.arg);
         }
     }
 }
 
-static void lvgl_mouse_read_cb(lv_indev_t* indev, lv_indev_data_t* data)
+static void apply_relative_motion(int32_t dx, int32_t dy)
 {
-    _usba_detect_mutex.lock();
-    if (!_is_usba_connected) {
-        _usba_detect_mutex.unlock();
-        data->state = LV_INDEV_STATE_REL;
-        if (lv_obj_get_style_opa(_cursor_img, LV_PART_MAIN) == LV_OPA_COVER) {
-            lv_obj_set_style_opa(_cursor_img, LV_OPA_TRANSP, LV_PART_MAIN);
-        }
+    if (dx == 0 && dy == 0) {
         return;
     }
-    _usba_detect_mutex.unlock();
-    if (lv_obj_get_style_opa(_cursor_img, LV_PART_MAIN) == LV_OPA_TRANSP) {
-        lv_obj_set_style_opa(_cursor_img, LV_OPA_COVER, LV_PART_MAIN);
+
+    // The speed of what was summed since the last read picks the gain, fractions are carried to the next motion
+    const auto& accel = _hid_data.accel;
+    float gain        = accel.sensitivity;
+    if (accel.accel > 0) {
+        uint32_t now             = lv_tick_get();
+        uint32_t interval        = std::clamp<uint32_t>(now - _hid_data.lastMotionTick, 1, _accel_max_interval_ms);
+        _hid_data.lastMotionTick = now;
+        float speed              = std::hypot((float)dx, (float)dy) / interval;
+        float boost              = 1.0f + accel.accel * std::max(speed - accel.threshold, 0.0f);
+        gain *= std::min(accel.maxGain, boost);
+    }
+    float x                    = dx * gain + _hid_data.motionRemainderX;
+    float y                    = dy * gain + _hid_data.motionRemainderY;
+    _hid_data.motionRemainderX = x - (int32_t)x;
+    _hid_data.motionRemainderY = y - (int32_t)y;
+
+    // Screen x runs along the native y axis in reverse, screen y along the native x axis
+    _hid_data.pointerX = std::clamp<int32_t>(_hid_data.pointerX + (int32_t)y, 0, _native_width - 1);
+    _hid_data.pointerY = std::clamp<int32_t>(_hid_data.pointerY - (int32_t)x, 0, _native_height - 1);
+}
+
+static void apply_pointer_report(const PointerReport_t& report)
+{
+    if (report.isAbsolute) {
+        _hid_data.pointerX = report.y * (_native_width - 1) / _absolute_range;
+        _hid_data.pointerY = (_native_height - 1) - report.x * (_native_height - 1) / _absolute_range;
+    } else {
+        apply_relative_motion(report.x, report.y);
+        _hid_data.readChanges++;
+    }
+    _hid_data.pointerButtons = report.buttons;
+}
+
+// Takes the summed relative motion unless a button change queued before it is still to be read
+static void drain_relative_motion()
+{
+    uint32_t old = _hid_data.motion.load(std::memory_order_relaxed);
+    do {
+        if (motion_changes(old) != _hid_data.readChanges || (motion_dx(old) == 0 && motion_dy(old) == 0)) {
+            return;
+        }
+    } while (!_hid_data.motion.compare_exchange_weak(old, pack_motion(0, 0, motion_changes(old)),
+                                                     std::memory_order_acq_rel));
+    apply_relative_motion(motion_dx(old), motion_dy(old));
+}
+
+static void lvgl_mouse_read_cb(lv_indev_t* indev, lv_indev_data_t* data)
+{
+    bool is_connected = _hid_data.pointerCount > 0;
+    lv_opa_t opa      = is_connected ? LV_OPA_COVER : LV_OPA_TRANSP;
+    if (!_is_cursor_overlay && lv_obj_get_style_opa(_cursor_img, LV_PART_MAIN) != opa) {
+        lv_obj_set_style_opa(_cursor_img, opa, LV_PART_MAIN);
+    }
+
+    // Motion is merged up to the next button change, so each click lands where it happened
+    auto span             = _hid_data.pointerRing.readSpan();
+    size_t used           = 0;
+    bool is_button_change = false;
+    while (used < span.size && !is_button_change) {
+        const auto& report = span.data[used++];
+        is_button_change   = !report.isAbsolute || report.buttons != _hid_data.pointerButtons;
+        apply_pointer_report(report);
+    }
+    _hid_data.pointerRing.consume(used);
+    // The motion after a change is taken on the next read, LVGL sees the change where it happened first
+    if (!is_button_change) {
+        drain_relative_motion();
     }
+    data->continue_reading = is_button_change || _hid_data.pointerRing.available() > 0;
 
-    std::lock_guard<std::mutex> lock(GetHAL()->hidMouseData.mutex);
-    data->point.x = GetHAL()->hidMouseData.x;
-    data->point.y = GetHAL()->hidMouseData.y;
-    data->state   = GetHAL()->hidMouseData.btnLeft ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    bool is_pressed = is_connected && (_hid_data.pointerButtons & 0x01);
+    data->point.x   = _hid_data.pointerX;
+    data->point.y   = _hid_data.pointerY;
+    data->state     = is_pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+
+    if (_is_cursor_overlay) {
+        lvgl_port_move_cursor(lv_indev_get_display(indev), _hid_data.pointerX, _hid_data.pointerY, is_connected);
+    }
+}
+
+static void lvgl_keyboard_read_cb(lv_indev_t* indev, lv_indev_data_t* data)
+{
+    // One event per read, so LVGL sees every press and release in order
+    KeyEvent_t event;
+    if (_hid_data.keyRing.read(&event, 1) == 1) {
+        _hid_data.lastKey = event;
+    }
+    data->continue_reading = _hid_data.keyRing.available() > 0;
+
+    data->key   = _hid_data.lastKey.key;
+    data->state = _hid_data.lastKey.isPressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+void HalEsp32::setPointerAcceleration(const PointerAccelConfig_t& config)
+{
+    // Read by the mouse read callback, which runs under the LVGL lock
+    lvglLock();
+    _hid_data.accel            = config;
+    _hid_data.motionRemainderX = 0;
+    _hid_data.motionRemainderY = 0;
+    lvglUnlock();
+    mclog::tagInfo(TAG, "pointer sensitivity {:.2f}, accel {:.2f} over {:.1f} counts/ms, max gain {:.1f}",
+                   config.sensitivity, config.accel, config.threshold, config.maxGain);
 }
 
 void HalEsp32::hid_init()
 {
     mclog::tagInfo(TAG, "hid init");
-    xTaskCreatePinnedToCore(tab5_usb_host_task, "usba", 4096 * 2, NULL, 5, NULL, 0);
+    _hid_data.pointerRing.init(64);
+    _hid_data.keyRing.init(64);
+    xTaskCreatePinnedToCore(hid_event_task, "usb_hid", 4096 * 2, NULL, 5, NULL, 0);
 
     auto lvMouse = lv_indev_create();
     lv_indev_set_type(lvMouse, LV_INDEV_TYPE_POINTER);
     lv_indev_set_read_cb(lvMouse, lvgl_mouse_read_cb);
     lv_indev_set_display(lvMouse, lvDisp);
-
-    _cursor_img = lv_image_create(lv_screen_active()); /*Create an image object for the cursor */
-    lv_image_set_src(_cursor_img, &mouse_cursor);      /*Set the image source*/
-    lv_indev_set_cursor(lvMouse, _cursor_img);         /*Connect the image  object to the driver*/
+    lv_indev_set_mode(lvMouse, LV_INDEV_MODE_EVENT);
+
+    _is_cursor_overlay = lvgl_port_set_cursor(lvDisp, &mouse_cursor) == ESP_OK;
+    if (_is_cursor_overlay) {
+        lvgl_port_move_cursor(lvDisp, _hid_data.pointerX, _hid_data.pointerY, false);
+    } else {
+        // An image object on the screen, each move redraws both of its places
+        _cursor_img = lv_image_create(lv_screen_active()); /*Create an image object for the cursor */
+        lv_image_set_src(_cursor_img, &mouse_cursor);      /*Set the image source*/
+        lv_indev_set_cursor(lvMouse, _cursor_img);         /*Connect the image  object to the driver*/
+        lv_obj_set_style_opa(_cursor_img, LV_OPA_TRANSP, LV_PART_MAIN);
+    }
+    mclog::tagInfo(TAG, "mouse cursor: {}", _is_cursor_overlay ? "overlay" : "lvgl object");
+
+    // Boot keyboards only report changes, so there is nothing to poll between events
+    lvKeyboard = lv_indev_create();
+    lv_indev_set_type(lvKeyboard, LV_INDEV_TYPE_KEYPAD);
+    lv_indev_set_read_cb(lvKeyboard, lvgl_keyboard_read_cb);
+    lv_indev_set_display(lvKeyboard, lvDisp);
+    lv_indev_set_mode(lvKeyboard, LV_INDEV_MODE_EVENT);
+
+    // Focusable widgets created from here on join the group the keyboard drives
+    lv_group_t* group = lv_group_create();
+    lv_group_set_default(group);
+    lv_indev_set_group(lvKeyboard, group);
 }
 
 bool HalEsp32::usbADetect()
 {
-    std::lock_guard<std::mutex> lock(_usba_detect_mutex);
-    return _is_usba_connected;
+    return _hid_data.deviceCount > 0 || isUsbDriveMounted() || isUsbSerialConnected(0) || isUsbSerialConnected(1);
 }
@@ -0,0 +1,210 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <hal/spsc_ring.h>
+#include <usb/usb_host.h>
+#include <usb/cdc_acm_host.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+#define TAG "usb_cdc"
+
+static constexpr int _max_ports = 2;
+// Below the HID driver like mass storage, a serial flood never holds back input reports
+static constexpr UBaseType_t _cdc_task_priority = 4;
+static constexpr uint32_t _open_timeout_ms      = 1000;
+static constexpr uint32_t _write_timeout_ms     = 100;
+static constexpr size_t _rx_ring_size           = 4096;
+static constexpr uint32_t _default_baud_rate    = 115200;
+
+// Device classes that can carry an ACM interface, anything else is left to the HID and MSC drivers
+static constexpr uint8_t _class_comm = 0x02;
+static constexpr uint8_t _class_misc = 0xEF;
+
+struct CdcConnectEvent_t {
+    uint16_t vid = 0;
+    uint16_t pid = 0;
+};
+
+struct UsbSerialPort_t {
+    // Taken around the handle, a write from an app and the close on disconnect race otherwise
+    std::mutex mutex;
+    cdc_acm_dev_hdl_t handle = nullptr;
+    std::atomic<bool> isConnected{false};
+    // Driver task to the reading task, bytes read before a disconnect stay readable
+    SpscRing<uint8_t> rxRing;
+};
+
+struct UsbCdcData_t {
+    QueueHandle_t eventQueue = nullptr;
+    UsbSerialPort_t ports[_max_ports];
+};
+static UsbCdcData_t _usb_cdc_data;
+
+/* -------------------------------------------------------------------------- */
+/*                                   Driver                                   */
+/* -------------------------------------------------------------------------- */
+static void cdc_new_device_callback(usb_device_handle_t usb_dev)
+{
+    const usb_device_desc_t* desc = nullptr;
+    if (usb_host_get_device_descriptor(usb_dev, &desc) != ESP_OK || desc == nullptr) {
+        return;
+    }
+    if (desc->bDeviceClass != _class_comm && desc->bDeviceClass != _class_misc) {
+        return;
+    }
+
+    // Runs in the driver task, opening the device from here would wait on that same task
+    CdcConnectEvent_t event;
+    event.vid = desc->idVendor;
+    event.pid = desc->idProduct;
+    xQueueSend(_usb_cdc_data.eventQueue, &event, 0);
+}
+
+static bool cdc_data_callback(const uint8_t* data, size_t data_len, void* user_arg)
+{
+    // A full ring means nobody reads the port, the newest bytes are the ones to lose
+    auto port = static_cast<UsbSerialPort_t*>(user_arg);
+    port->rxRing.write(data, data_len);
+    return true;
+}
+
+static void cdc_device_event_callback(const cdc_acm_host_dev_event_data_t* event, void* user_ctx)
+{
+    auto port = static_cast<UsbSerialPort_t*>(user_ctx);
+    if (event->type == CDC_ACM_HOST_DEVICE_DISCONNECTED) {
+        port->isConnected = false;
+        {
+            std::lock_guard<std::mutex> lock(port->mutex);
+            cdc_acm_host_close(event->data.cdc_hdl);
+            port->handle = nullptr;
+        }
+        mclog::tagInfo(TAG, "serial port {} disconnected", port - _usb_cdc_data.ports);
+    } else if (event->type == CDC_ACM_HOST_ERROR) {
+        mclog::tagWarn(TAG, "serial port {} error {}", port - _usb_cdc_data.ports, event->data.error);
+    }
+}
+
+static void open_port(const CdcConnectEvent_t& event)
+{
+    UsbSerialPort_t* port = nullptr;
+    for (auto& p : _usb_cdc_data.ports) {
+        if (p.handle == nullptr) {
+            port = &p;
+            break;
+        }
+    }
+    if (port == nullptr) {
+        mclog::tagWarn(TAG, "{} serial ports open already, ignore {:04x}:{:04x}", _max_ports, event.vid, event.pid);
+        return;
+    }
+
+    cdc_acm_host_device_config_t dev_config = {};
+    dev_config.connection_timeout_ms        = _open_timeout_ms;
+    dev_config.out_buffer_size              = 512;
+    dev_config.in_buffer_size               = 512;
+    dev_config.event_cb                     = cdc_device_event_callback;
+    dev_config.data_cb                      = cdc_data_callback;
+    dev_config.user_arg                     = port;
+
+    std::lock_guard<std::mutex> lock(port->mutex);
+    esp_err_t ret = cdc_acm_host_open(event.vid, event.pid, 0, &dev_config, &port->handle);
+    if (ret != ESP_OK) {
+        mclog::tagInfo(TAG, "{:04x}:{:04x} has no ACM interface: {}", event.vid, event.pid, esp_err_to_name(ret));
+        port->handle = nullptr;
+        return;
+    }
+
+    cdc_acm_line_coding_t line_coding = {};
+    line_coding.dwDTERate             = _default_baud_rate;
+    line_coding.bDataBits             = 8;
+    cdc_acm_host_line_coding_set(port->handle, &line_coding);
+    cdc_acm_host_set_control_line_state(port->handle, true, false);
+    port->isConnected = true;
+    mclog::tagInfo(TAG, "serial port {} connected, {:04x}:{:04x}", port - _usb_cdc_data.ports, event.vid, event.pid);
+}
+
+static void usb_cdc_task(void* param)
+{
+    CdcConnectEvent_t event;
+    while (1) {
+        if (xQueueReceive(_usb_cdc_data.eventQueue, &event, portMAX_DELAY) == pdTRUE) {
+            open_port(event);
+        }
+    }
+}
+
+void HalEsp32::usb_cdc_init()
+{
+    mclog::tagInfo(TAG, "usb cdc init");
+
+    for (auto& port : _usb_cdc_data.ports) {
+        port.rxRing.init(_rx_ring_size);
+    }
+    _usb_cdc_data.eventQueue = xQueueCreate(_max_ports * 2, sizeof(CdcConnectEvent_t));
+
+    cdc_acm_host_driver_config_t driver_config = {};
+    driver_config.driver_task_stack_size       = 4096;
+    driver_config.driver_task_priority         = _cdc_task_priority;
+    driver_config.xCoreID                      = 0;
+    driver_config.new_dev_cb                   = cdc_new_device_callback;
+    esp_err_t ret                              = cdc_acm_host_install(&driver_config);
+    if (ret != ESP_OK) {
+        mclog::tagError(TAG, "install cdc acm host failed: {}", esp_err_to_name(ret));
+        return;
+    }
+
+    xTaskCreatePinnedToCore(usb_cdc_task, "usb_cdc", 4096, NULL, _cdc_task_priority, NULL, 0);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                     API                                    */
+/* -------------------------------------------------------------------------- */
+bool HalEsp32::isUsbSerialConnected(int port)
+{
+    return port >= 0 && port < _max_ports && _usb_cdc_data.ports[port].isConnected;
+}
+
+size_t HalEsp32::usbSerialWrite(int port, const void* data, size_t size)
+{
+    if (!isUsbSerialConnected(port)) {
+        return 0;
+    }
+
+    auto& p = _usb_cdc_data.ports[port];
+    std::lock_guard<std::mutex> lock(p.mutex);
+    if (p.handle == nullptr ||
+        cdc_acm_host_data_tx_blocking(p.handle, (const uint8_t*)data, size, _write_timeout_ms) != ESP_OK) {
+        return 0;
+    }
+    return size;
+}
+
+size_t HalEsp32::usbSerialRead(int port, void* data, size_t size)
+{
+    if (port < 0 || port >= _max_ports) {
+        return 0;
+    }
+    return _usb_cdc_data.ports[port].rxRing.read((uint8_t*)data, size);
+}
+
+bool HalEsp32::setUsbSerialBaudRate(int port, uint32_t baudRate)
+{
+    if (!isUsbSerialConnected(port)) {
+        return false;
+    }
+
+    auto& p = _usb_cdc_data.ports[port];
+    std::lock_guard<std::mutex> lock(p.mutex);
+    cdc_acm_line_coding_t line_coding = {};
+    line_coding.dwDTERate             = baudRate;
+    line_coding.bDataBits             = 8;
+    return p.handle != nullptr && cdc_acm_host_line_coding_set(p.handle, &line_coding) == ESP_OK;
+}
@@ -0,0 +1,301 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <hal/spsc_ring.h>
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stddef.h>
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <driver/usb_serial_jtag.h>
+#include <driver/usb_serial_jtag_vfs.h>
+#include <esp_heap_caps.h>
+#include <esp_rom_crc.h>
+#include <esp_timer.h>
+
+static const std::string _tag = "usb-export";
+
+/*
+ * Frames, little endian, structs are packed:
+ * header  : "T5XF", u8 channel, u8 flags, u16 header size, u32 sequence (per frame, gaps are drops), u32 ms since
+ *           boot, u32 payload size, u32 payload CRC-32, u32 header CRC-32 (over the fields before it), then the payload
+ * Console text goes out on the same port between frames, hosts scan for the magic and drop frames that fail a CRC.
+ * Payloads over 8 KB are split, every part but the last has flag 0x01 set. CRC-32 is the zlib one.
+ *
+ * The port is the USB Serial/JTAG of the console, full speed. The high speed OTG port is held by TinyUSB for the UVC
+ * webcam, whose descriptors have no room for another class.
+ */
+static constexpr uint8_t _frame_flag_more = 0x01;
+// Each frame goes to the driver in one write, so console lines never land inside one
+static constexpr size_t _max_payload        = 8 * 1024;
+static constexpr size_t _driver_tx_size     = 2 * _max_payload;
+static constexpr uint32_t _write_timeout_ms = 100;
+// The sender sleeps this long while the port has no host or the ring is empty, a producer wakes it earlier
+static constexpr uint32_t _idle_interval_ms = 20;
+// History samples per frame
+static constexpr size_t _history_batch = 64;
+
+struct __attribute__((packed)) FrameHeader_t {
+    char magic[4]        = {'T', '5', 'X', 'F'};
+    uint8_t channel      = 0;
+    uint8_t flags        = 0;
+    uint16_t headerSize  = sizeof(FrameHeader_t);
+    uint32_t sequence    = 0;
+    uint32_t timeMs      = 0;
+    uint32_t payloadSize = 0;
+    uint32_t payloadCrc  = 0;
+    uint32_t headerCrc   = 0;
+};
+
+struct UsbExportData_t {
+    std::mutex mutex;
+    TaskHandle_t task             = nullptr;
+    SemaphoreHandle_t exitSem     = nullptr;
+    std::atomic<bool> isRunning   = false;
+    std::atomic<bool> isAccepting = false;
+    bool isDriverInstalled        = false;
+    hal::HalBase::UsbExportConfig_t config;
+    // Producers take the mutex, which makes them a single producer for the ring
+    std::mutex ringMutex;
+    SpscRing<uint8_t> ring;
+    uint32_t sequence = 0;
+    // Sender side, one whole frame
+    uint8_t* staging = nullptr;
+    std::atomic<uint32_t> frames{0};
+    std::atomic<uint32_t> dropped{0};
+    std::atomic<uint64_t> bytesSent{0};
+};
+static UsbExportData_t _export_data;
+
+/* -------------------------------------------------------------------------- */
+/*                                  Producers                                 */
+/* -------------------------------------------------------------------------- */
+static bool push_frame(uint8_t channel, uint8_t flags, const uint8_t* payload, size_t size)
+{
+    FrameHeader_t header;
+    header.channel     = channel;
+    header.flags       = flags;
+    header.timeMs      = esp_timer_get_time() / 1000;
+    header.payloadSize = size;
+    header.payloadCrc  = esp_rom_crc32_le(0, payload, size);
+
+    bool was_empty = false;
+    {
+        std::lock_guard<std::mutex> lock(_export_data.ringMutex);
+        if (!_export_data.isAccepting || _export_data.ring.space() < sizeof(header) + size) {
+            _export_data.dropped++;
+            return false;
+        }
+        header.sequence  = _export_data.sequence++;
+        header.headerCrc = esp_rom_crc32_le(0, (const uint8_t*)&header, offsetof(FrameHeader_t, headerCrc));
+        was_empty        = _export_data.ring.available() == 0;
+        _export_data.ring.write((const uint8_t*)&header, sizeof(header));
+        _export_data.ring.write(payload, size);
+    }
+    if (was_empty) {
+        xTaskNotifyGive(_export_data.task);
+    }
+    return true;
+}
+
+bool HalEsp32::usbExportWrite(uint8_t channel, const void* data, size_t size)
+{
+    if (!_export_data.isAccepting) {
+        return false;
+    }
+
+    // Parts that went in stay in, the host sees the missing rest as a frame without its last part
+    auto bytes = (const uint8_t*)data;
+    do {
+        size_t part = std::min(size, _max_payload);
+        if (!push_frame(channel, part < size ? _frame_flag_more : 0, bytes, part)) {
+            return false;
+        }
+        bytes += part;
+        size -= part;
+    } while (size > 0);
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                   Sender                                   */
+/* -------------------------------------------------------------------------- */
+template <typename T, size_t N>
+static void export_history(HalEsp32* hal, uint8_t channel, const History<T, N>& history, uint32_t& cursor)
+{
+    static_assert(sizeof(T) * _history_batch <= _max_payload, "history batch does not fit a frame");
+
+    T samples[_history_batch];
+    size_t count;
+    while ((count = history.read(cursor, samples, _history_batch)) > 0) {
+        hal->usbExportWrite(channel, samples, count * sizeof(T));
+    }
+}
+
+// Takes the next frame off the ring into staging, returns its size
+static size_t take_frame()
+{
+    auto& ring = _export_data.ring;
+    if (ring.available() < sizeof(FrameHeader_t)) {
+        return 0;
+    }
+    FrameHeader_t header;
+    ring.read((uint8_t*)&header, sizeof(header));
+    memcpy(_export_data.staging, &header, sizeof(header));
+    // A producer commits header and payload under one lock, the payload is there
+    ring.read(_export_data.staging + sizeof(header), header.payloadSize);
+    return sizeof(header) + header.payloadSize;
+}
+
+void HalEsp32::usb_export_task(void* param)
+{
+    static_cast<HalEsp32*>(param)->usb_export_loop();
+
+    xSemaphoreGive(_export_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+void HalEsp32::usb_export_loop()
+{
+    const auto config = _export_data.config;
+
+    // Only what was sampled from here on goes out
+    uint32_t power_cursor    = powerMonitorHistory.count();
+    uint32_t imu_cursor      = imuHistory.count();
+    int64_t next_sensor_us   = 0;
+    int64_t sensor_period_us = (int64_t)config.sensorIntervalMs * 1000;
+
+    while (_export_data.isRunning) {
+        int64_t now = esp_timer_get_time();
+        if (sensor_period_us > 0 && now >= next_sensor_us) {
+            next_sensor_us = now + sensor_period_us;
+            export_history(this, EXPORT_CHANNEL_POWER, powerMonitorHistory, power_cursor);
+            export_history(this, EXPORT_CHANNEL_IMU, imuHistory, imu_cursor);
+        }
+
+        // Frames wait in the ring while no host has the port open, past its size they are dropped
+        size_t size = usb_serial_jtag_is_connected() ? take_frame() : 0;
+        if (size == 0) {
+            uint32_t wait_ms = _idle_interval_ms;
+            if (sensor_period_us > 0) {
+                wait_ms = std::min<uint32_t>(wait_ms, std::max<int64_t>(next_sensor_us - now, 0) / 1000 + 1);
+            }
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait_ms));
+            continue;
+        }
+
+        int sent = usb_serial_jtag_write_bytes(_export_data.staging, size, pdMS_TO_TICKS(_write_timeout_ms));
+        if (sent == (int)size) {
+            _export_data.frames++;
+            _export_data.bytesSent += size;
+        } else {
+            // The host went away mid frame
+            _export_data.dropped++;
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                   Control                                  */
+/* -------------------------------------------------------------------------- */
+bool HalEsp32::startUsbExport(const UsbExportConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_export_data.mutex);
+
+    if (_export_data.isRunning) {
+        return true;
+    }
+
+    // Stays installed after a stop, the console writes through the driver from here on
+    if (!_export_data.isDriverInstalled) {
+        usb_serial_jtag_driver_config_t driver_config = {};
+        driver_config.tx_buffer_size                  = _driver_tx_size;
+        driver_config.rx_buffer_size                  = 256;
+        esp_err_t ret                                 = usb_serial_jtag_driver_install(&driver_config);
+        if (ret != ESP_OK) {
+            mclog::tagError(_tag, "install usb serial jtag driver failed: {}", esp_err_to_name(ret));
+            return false;
+        }
+        usb_serial_jtag_vfs_use_driver();
+        _export_data.isDriverInstalled = true;
+    }
+
+    // Nothing pushes while accepting is off, so the ring can be set up outside the lock
+    _export_data.config = config;
+    _export_data.ring.init(config.ringSizeKb * 1024);
+    _export_data.staging =
+        (uint8_t*)heap_caps_malloc(sizeof(FrameHeader_t) + _max_payload, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (_export_data.staging == nullptr) {
+        mclog::tagError(_tag, "malloc staging buffer failed");
+        return false;
+    }
+    if (_export_data.exitSem == nullptr) {
+        _export_data.exitSem = xSemaphoreCreateBinary();
+    }
+    _export_data.sequence  = 0;
+    _export_data.frames    = 0;
+    _export_data.dropped   = 0;
+    _export_data.bytesSent = 0;
+
+    _export_data.isRunning = true;
+    if (xTaskCreate(usb_export_task, "usb_export", 4096, this, 3, &_export_data.task) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        _export_data.isRunning = false;
+        _export_data.task      = nullptr;
+        heap_caps_free(_export_data.staging);
+        _export_data.staging = nullptr;
+        return false;
+    }
+    _export_data.isAccepting = true;
+
+    mclog::tagInfo(_tag, "start, {} KB ring, log {}, sensors every {} ms", config.ringSizeKb,
+                   config.exportLog ? "on" : "off", config.sensorIntervalMs);
+    return true;
+}
+
+void HalEsp32::stopUsbExport()
+{
+    std::lock_guard<std::mutex> lock(_export_data.mutex);
+
+    if (!_export_data.isRunning) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> ring_lock(_export_data.ringMutex);
+        _export_data.isAccepting = false;
+    }
+    _export_data.isRunning = false;
+    xTaskNotifyGive(_export_data.task);
+    xSemaphoreTake(_export_data.exitSem, portMAX_DELAY);
+    _export_data.task = nullptr;
+    heap_caps_free(_export_data.staging);
+    _export_data.staging = nullptr;
+    mclog::tagInfo(_tag, "stop, {} frames, {} dropped", _export_data.frames.load(), _export_data.dropped.load());
+}
+
+hal::HalBase::UsbExportStats_t HalEsp32::getUsbExportStats()
+{
+    UsbExportStats_t stats;
+    stats.isRunning       = _export_data.isRunning;
+    stats.isHostConnected = _export_data.isDriverInstalled && usb_serial_jtag_is_connected();
+    stats.frames          = _export_data.frames;
+    stats.dropped         = _export_data.dropped;
+    stats.bytesSent       = _export_data.bytesSent;
+    return stats;
+}
+
+// Called by the binary log writer for every segment it wrote, see hal_binary_log.cpp
+void usb_export_log_segment(const uint8_t* segment, size_t size)
+{
+    if (_export_data.isAccepting && _export_data.config.exportLog) {
+        GetHAL()->usbExportWrite(hal::HalBase::EXPORT_CHANNEL_LOG, segment, size);
+    }
+}
@@ -0,0 +1,602 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <errno.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <esp_vfs_fat.h>
+#include <usb/msc_host.h>
+#include <usb/msc_host_vfs.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+
+#define TAG "usb_msc"
+
+// The first drive is mounted at /usb, drives behind a hub after it at /usb1 to /usb3
+static constexpr int _max_drives              = 4;
+static const char* _mount_points[_max_drives] = {"/usb", "/usb1", "/usb2", "/usb3"};
+// Below the HID driver, a busy transfer never holds back input reports
+static constexpr UBaseType_t _msc_task_priority = 4;
+
+// The drive fills one buffer while the other goes out to the card
+static constexpr int _copy_buffer_count       = 2;
+static constexpr size_t _copy_buffer_size     = 128 * 1024;
+static constexpr size_t _copy_buffer_min_size = 16 * 1024;
+// Cache line aligned, so FATFS hands whole sectors to the SD host and USB DMA without a bounce copy
+static constexpr size_t _copy_buffer_align = 64;
+// How long a disconnect waits for a running copy to give up on the drive
+static constexpr uint32_t _copy_stop_timeout_ms = 5000;
+
+struct UsbDrive_t {
+    msc_host_device_handle_t device = nullptr;
+    msc_host_vfs_handle_t vfs       = nullptr;
+    std::atomic<bool> isMounted     = false;
+};
+
+struct UsbMscData_t {
+    QueueHandle_t eventQueue = nullptr;
+    // Only the MSC task changes the slots
+    UsbDrive_t drives[_max_drives];
+    std::atomic<int> mountedCount = 0;
+};
+static UsbMscData_t _usb_msc_data;
+
+struct CopyItem_t {
+    std::string srcPath;
+    std::string dstPath;
+    bool isDir    = false;
+    uint64_t size = 0;
+};
+
+// fd -1 ends the writer, isLast closes the file after the write
+struct CopyChunk_t {
+    int fd         = -1;
+    uint8_t buffer = 0;
+    size_t size    = 0;
+    bool isLast    = false;
+};
+
+struct FileCopyData_t {
+    std::mutex mutex;
+    hal::HalBase::FileCopyProgress_t progress;
+    std::atomic<bool> isRunning     = false;
+    std::atomic<bool> isCancelled   = false;
+    std::atomic<bool> isWriteFailed = false;
+    int writeErrno                  = 0;
+    std::string srcPath;
+    std::string dstPath;
+    uint8_t* buffers[_copy_buffer_count] = {};
+    size_t bufferSize                    = 0;
+    // Buffer indexes owned by the reader, and chunks waiting for the writer
+    QueueHandle_t freeQueue         = nullptr;
+    QueueHandle_t dataQueue         = nullptr;
+    SemaphoreHandle_t writerExitSem = nullptr;
+    int64_t startTimeUs             = 0;
+};
+static FileCopyData_t _copy_data;
+
+/* -------------------------------------------------------------------------- */
+/*                                    Drive                                   */
+/* -------------------------------------------------------------------------- */
+static void msc_event_callback(const msc_host_event_t* event, void* arg)
+{
+    // Runs in the driver task, installing a device from here would wait on that same task
+    xQueueSend(_usb_msc_data.eventQueue, event, 0);
+}
+
+static void mount_drive(uint8_t address)
+{
+    auto& drives = _usb_msc_data.drives;
+    int slot     = 0;
+    while (slot < _max_drives && drives[slot].device != nullptr) {
+        slot++;
+    }
+    if (slot == _max_drives) {
+        mclog::tagWarn(TAG, "{} drives mounted already, ignore device {}", _max_drives, address);
+        return;
+    }
+    auto& drive = drives[slot];
+
+    esp_err_t ret = msc_host_install_device(address, &drive.device);
+    if (ret != ESP_OK) {
+        mclog::tagError(TAG, "install device failed: {}", esp_err_to_name(ret));
+        drive.device = nullptr;
+        return;
+    }
+
+    msc_host_device_info_t info;
+    if (msc_host_get_device_info(drive.device, &info) == ESP_OK) {
+        mclog::tagInfo(TAG, "drive connected, {} MB", (uint64_t)info.sector_count * info.sector_size / (1024 * 1024));
+    }
+
+    esp_vfs_fat_mount_config_t mount_config = {};
+    mount_config.format_if_mount_failed     = false;
+    mount_config.max_files                  = 8;
+    mount_config.allocation_unit_size       = 0;
+    ret = msc_host_vfs_register(drive.device, _mount_points[slot], &mount_config, &drive.vfs);
+    if (ret != ESP_OK) {
+        mclog::tagError(TAG, "mount failed: {}", esp_err_to_name(ret));
+        msc_host_uninstall_device(drive.device);
+        drive.device = nullptr;
+        drive.vfs    = nullptr;
+        return;
+    }
+
+    // The host keeps the bus active, no light sleep while a drive is attached
+    if (_usb_msc_data.mountedCount++ == 0) {
+        GetHAL()->claimPerfLevel("usb_msc", hal::HalBase::PERF_LEVEL_AWAKE);
+    }
+    drive.isMounted = true;
+    mclog::tagInfo(TAG, "mounted at {}", _mount_points[slot]);
+}
+
+static bool is_on_drive(const std::string& path, int slot)
+{
+    size_t length = strlen(_mount_points[slot]);
+    return path.compare(0, length, _mount_points[slot]) == 0 && (path.size() == length || path[length] == '/');
+}
+
+static void unmount_drive(msc_host_device_handle_t device)
+{
+    auto& drives = _usb_msc_data.drives;
+    int slot     = 0;
+    while (slot < _max_drives && (device == nullptr || drives[slot].device != device)) {
+        slot++;
+    }
+    if (slot == _max_drives) {
+        return;
+    }
+    auto& drive     = drives[slot];
+    drive.isMounted = false;
+
+    // Files of the drive must be closed before the FAT volume goes away, a copy between other drives goes on
+    if (_copy_data.isRunning && (is_on_drive(_copy_data.srcPath, slot) || is_on_drive(_copy_data.dstPath, slot))) {
+        _copy_data.isCancelled = true;
+        uint32_t waited        = 0;
+        while (_copy_data.isRunning && waited < _copy_stop_timeout_ms) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+            waited += 10;
+        }
+    }
+
+    msc_host_vfs_unregister(drive.vfs);
+    msc_host_uninstall_device(drive.device);
+    drive.vfs    = nullptr;
+    drive.device = nullptr;
+    if (--_usb_msc_data.mountedCount == 0) {
+        GetHAL()->releasePerfLevel("usb_msc");
+    }
+    mclog::tagInfo(TAG, "drive at {} disconnected", _mount_points[slot]);
+}
+
+static void usb_msc_task(void* param)
+{
+    msc_host_event_t event;
+    while (1) {
+        if (xQueueReceive(_usb_msc_data.eventQueue, &event, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        if (event.event == msc_host_event_t::MSC_DEVICE_CONNECTED) {
+            mount_drive(event.device.address);
+        } else if (event.event == msc_host_event_t::MSC_DEVICE_DISCONNECTED) {
+            unmount_drive(event.device.handle);
+        }
+    }
+}
+
+void HalEsp32::usb_msc_init()
+{
+    mclog::tagInfo(TAG, "usb msc init");
+
+    // Room for every drive behind a hub to come and go at once
+    _usb_msc_data.eventQueue = xQueueCreate(_max_drives * 2, sizeof(msc_host_event_t));
+
+    msc_host_driver_config_t msc_config = {};
+    msc_config.create_backround_task    = true;
+    msc_config.task_priority            = _msc_task_priority;
+    msc_config.stack_size               = 4096;
+    msc_config.core_id                  = 0;
+    msc_config.callback                 = msc_event_callback;
+    msc_config.callback_arg             = NULL;
+    esp_err_t ret                       = msc_host_install(&msc_config);
+    if (ret != ESP_OK) {
+        mclog::tagError(TAG, "install msc host failed: {}", esp_err_to_name(ret));
+        return;
+    }
+
+    xTaskCreatePinnedToCore(usb_msc_task, "usb_msc", 4096, NULL, _msc_task_priority, NULL, 0);
+}
+
+bool HalEsp32::isUsbDriveMounted()
+{
+    return _usb_msc_data.mountedCount > 0;
+}
+
+std::vector<std::string> HalEsp32::getUsbDriveMountPoints()
+{
+    std::vector<std::string> mount_points;
+    for (int i = 0; i < _max_drives; i++) {
+        if (_usb_msc_data.drives[i].isMounted) {
+            mount_points.push_back(_mount_points[i]);
+        }
+    }
+    return mount_points;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Copy                                    */
+/* -------------------------------------------------------------------------- */
+static void set_copy_error(const std::string& error)
+{
+    std::lock_guard<std::mutex> lock(_copy_data.mutex);
+    if (_copy_data.progress.error.empty()) {
+        _copy_data.progress.error = error;
+    }
+}
+
+// Directories come before their content, so they exist by the time their files are written
+static bool collect_copy_items(std::vector<CopyItem_t>& items)
+{
+    struct stat st;
+    if (stat(_copy_data.srcPath.c_str(), &st) != 0) {
+        set_copy_error("source not found: " + _copy_data.srcPath);
+        return false;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        items.push_back({_copy_data.srcPath, _copy_data.dstPath, false, (uint64_t)st.st_size});
+        return true;
+    }
+
+    items.push_back({_copy_data.srcPath, _copy_data.dstPath, true, 0});
+    for (size_t i = 0; i < items.size(); i++) {
+        if (!items[i].isDir) {
+            continue;
+        }
+        if (_copy_data.isCancelled) {
+            return false;
+        }
+
+        // Copies, items grows while the directory is read
+        std::string src_dir = items[i].srcPath;
+        std::string dst_dir = items[i].dstPath;
+        DIR* dir            = opendir(src_dir.c_str());
+        if (dir == nullptr) {
+            set_copy_error("failed to open directory: " + src_dir);
+            return false;
+        }
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != nullptr) {
+            if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+                continue;
+            }
+            CopyItem_t item;
+            item.srcPath = src_dir + "/" + entry->d_name;
+            item.dstPath = dst_dir + "/" + entry->d_name;
+            item.isDir   = entry->d_type == DT_DIR;
+            if (!item.isDir && stat(item.srcPath.c_str(), &st) == 0) {
+                item.size = st.st_size;
+            }
+            items.push_back(item);
+        }
+        closedir(dir);
+    }
+    return true;
+}
+
+static void file_copy_writer_task(void* param)
+{
+    CopyChunk_t chunk;
+    while (1) {
+        if (xQueueReceive(_copy_data.dataQueue, &chunk, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        if (chunk.fd < 0) {
+            break;
+        }
+
+        // After a failure the chunks are only handed back, the reader stops at its next buffer
+        const uint8_t* data = _copy_data.buffers[chunk.buffer];
+        size_t written      = 0;
+        while (!_copy_data.isWriteFailed && written < chunk.size) {
+            ssize_t len = write(chunk.fd, data + written, chunk.size - written);
+            if (len <= 0) {
+                _copy_data.writeErrno    = errno;
+                _copy_data.isWriteFailed = true;
+                break;
+            }
+            written += len;
+        }
+        if (chunk.isLast && close(chunk.fd) != 0 && !_copy_data.isWriteFailed) {
+            _copy_data.writeErrno    = errno;
+            _copy_data.isWriteFailed = true;
+        }
+
+        if (!_copy_data.isWriteFailed) {
+            std::lock_guard<std::mutex> lock(_copy_data.mutex);
+            _copy_data.progress.bytesDone += written;
+            if (chunk.isLast) {
+                _copy_data.progress.filesDone++;
+            }
+            int64_t elapsed_us = esp_timer_get_time() - _copy_data.startTimeUs;
+            if (elapsed_us > 0) {
+                _copy_data.progress.bytesPerSecond = _copy_data.progress.bytesDone * 1000000 / elapsed_us;
+            }
+        }
+        xQueueSend(_copy_data.freeQueue, &chunk.buffer, portMAX_DELAY);
+    }
+
+    xSemaphoreGive(_copy_data.writerExitSem);
+    vTaskDelete(NULL);
+}
+
+// Returns once the writer holds no buffer, so whatever it was writing is closed
+static void wait_writer_idle()
+{
+    uint8_t indexes[_copy_buffer_count];
+    for (int i = 0; i < _copy_buffer_count; i++) {
+        xQueueReceive(_copy_data.freeQueue, &indexes[i], portMAX_DELAY);
+    }
+    for (int i = 0; i < _copy_buffer_count; i++) {
+        xQueueSend(_copy_data.freeQueue, &indexes[i], portMAX_DELAY);
+    }
+}
+
+static bool copy_file(const CopyItem_t& item)
+{
+    {
+        std::lock_guard<std::mutex> lock(_copy_data.mutex);
+        _copy_data.progress.currentFile = item.srcPath;
+    }
+
+    int src_fd = open(item.srcPath.c_str(), O_RDONLY);
+    if (src_fd < 0) {
+        set_copy_error("failed to open " + item.srcPath + ": " + strerror(errno));
+        return false;
+    }
+    int dst_fd = open(item.dstPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (dst_fd < 0) {
+        set_copy_error("failed to create " + item.dstPath + ": " + strerror(errno));
+        close(src_fd);
+        return false;
+    }
+
+    bool is_ok    = true;
+    uint64_t left = item.size;
+    while (1) {
+        CopyChunk_t chunk;
+        chunk.fd = dst_fd;
+        xQueueReceive(_copy_data.freeQueue, &chunk.buffer, portMAX_DELAY);
+
+        ssize_t len = 0;
+        if (_copy_data.isCancelled || _copy_data.isWriteFailed) {
+            is_ok = false;
+        } else {
+            len = read(src_fd, _copy_data.buffers[chunk.buffer], _copy_data.bufferSize);
+            if (len < 0) {
+                set_copy_error("failed to read " + item.srcPath + ": " + strerror(errno));
+                is_ok = false;
+                len   = 0;
+            }
+        }
+
+        // The last chunk also closes the file, an empty one when the copy stops early
+        left         = len >= (ssize_t)left ? 0 : left - len;
+        chunk.size   = len;
+        chunk.isLast = !is_ok || len == 0 || left == 0;
+        xQueueSend(_copy_data.dataQueue, &chunk, portMAX_DELAY);
+        if (chunk.isLast) {
+            break;
+        }
+    }
+    close(src_fd);
+
+    if (!is_ok) {
+        // A partial file would pass for a good copy
+        wait_writer_idle();
+        unlink(item.dstPath.c_str());
+    }
+    return is_ok;
+}
+
+static bool alloc_copy_buffers()
+{
+    // PSRAM first, it keeps the large buffers out of the internal DMA heap
+    const uint32_t caps_list[] = {MALLOC_CAP_DMA | MALLOC_CAP_SPIRAM, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL};
+    for (size_t size = _copy_buffer_size; size >= _copy_buffer_min_size; size /= 2) {
+        for (auto caps : caps_list) {
+            int count = 0;
+            for (; count < _copy_buffer_count; count++) {
+                _copy_data.buffers[count] = (uint8_t*)heap_caps_aligned_alloc(_copy_buffer_align, size, caps);
+                if (_copy_data.buffers[count] == nullptr) {
+                    break;
+                }
+            }
+            if (count == _copy_buffer_count) {
+                _copy_data.bufferSize = size;
+                return true;
+            }
+            for (int i = 0; i < count; i++) {
+                heap_caps_free(_copy_data.buffers[i]);
+                _copy_data.buffers[i] = nullptr;
+            }
+        }
+    }
+    return false;
+}
+
+static void free_copy_buffers()
+{
+    for (int i = 0; i < _copy_buffer_count; i++) {
+        heap_caps_free(_copy_data.buffers[i]);
+        _copy_data.buffers[i] = nullptr;
+    }
+}
+
+static void set_copy_state(hal::HalBase::FileCopyState_t state)
+{
+    std::lock_guard<std::mutex> lock(_copy_data.mutex);
+    _copy_data.progress.state = state;
+}
+
+static void file_copy_task(void* param)
+{
+    GetHAL()->claimPerfLevel("usb_copy", hal::HalBase::PERF_LEVEL_MAX);
+
+    std::vector<CopyItem_t> items;
+    bool is_ok = collect_copy_items(items);
+    if (is_ok) {
+        std::lock_guard<std::mutex> lock(_copy_data.mutex);
+        for (const auto& item : items) {
+            if (!item.isDir) {
+                _copy_data.progress.filesTotal++;
+                _copy_data.progress.bytesTotal += item.size;
+            }
+        }
+        _copy_data.progress.state = hal::HalBase::FILE_COPY_COPYING;
+    }
+
+    if (is_ok) {
+        _copy_data.freeQueue     = xQueueCreate(_copy_buffer_count, sizeof(uint8_t));
+        _copy_data.dataQueue     = xQueueCreate(_copy_buffer_count, sizeof(CopyChunk_t));
+        _copy_data.writerExitSem = xSemaphoreCreateBinary();
+        for (uint8_t i = 0; i < _copy_buffer_count; i++) {
+            xQueueSend(_copy_data.freeQueue, &i, 0);
+        }
+        _copy_data.startTimeUs = esp_timer_get_time();
+        mclog::tagInfo(TAG, "copy {} -> {}, {} files, {} bytes, {} KB buffers", _copy_data.srcPath,
+                       _copy_data.dstPath, _copy_data.progress.filesTotal, _copy_data.progress.bytesTotal,
+                       _copy_data.bufferSize / 1024);
+
+        // Higher than the reader, so a filled buffer goes out as soon as the card is free
+        xTaskCreatePinnedToCore(file_copy_writer_task, "copy_wr", 4096, NULL, 6, NULL, 1);
+
+        for (const auto& item : items) {
+            if (_copy_data.isCancelled || _copy_data.isWriteFailed) {
+                is_ok = false;
+                break;
+            }
+            if (item.isDir) {
+                if (mkdir(item.dstPath.c_str(), 0755) != 0 && errno != EEXIST) {
+                    set_copy_error("failed to create " + item.dstPath + ": " + strerror(errno));
+                    is_ok = false;
+                    break;
+                }
+                continue;
+            }
+            if (!copy_file(item)) {
+                is_ok = false;
+                break;
+            }
+        }
+
+        CopyChunk_t stop_chunk;
+        xQueueSend(_copy_data.dataQueue, &stop_chunk, portMAX_DELAY);
+        xSemaphoreTake(_copy_data.writerExitSem, portMAX_DELAY);
+        vQueueDelete(_copy_data.freeQueue);
+        vQueueDelete(_copy_data.dataQueue);
+        vSemaphoreDelete(_copy_data.writerExitSem);
+        _copy_data.freeQueue     = nullptr;
+        _copy_data.dataQueue     = nullptr;
+        _copy_data.writerExitSem = nullptr;
+    }
+    free_copy_buffers();
+
+    if (_copy_data.isWriteFailed) {
+        set_copy_error(std::string("write failed: ") + strerror(_copy_data.writeErrno));
+    }
+    if (is_ok) {
+        set_copy_state(hal::HalBase::FILE_COPY_DONE);
+    } else if (_copy_data.isCancelled) {
+        set_copy_state(hal::HalBase::FILE_COPY_CANCELLED);
+    } else {
+        set_copy_state(hal::HalBase::FILE_COPY_FAILED);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_copy_data.mutex);
+        _copy_data.progress.currentFile.clear();
+        mclog::tagInfo(TAG, "copy ended, {} of {} files, {} bytes at {} KB/s {}", _copy_data.progress.filesDone,
+                       _copy_data.progress.filesTotal, _copy_data.progress.bytesDone,
+                       _copy_data.progress.bytesPerSecond / 1024, _copy_data.progress.error);
+    }
+
+    GetHAL()->releasePerfLevel("usb_copy");
+    _copy_data.isRunning = false;
+    vTaskDelete(NULL);
+}
+
+bool HalEsp32::startFileCopy(const std::string& srcPath, const std::string& dstPath)
+{
+    if (srcPath.empty() || dstPath.empty() || srcPath == dstPath) {
+        return false;
+    }
+    // A tree copied into itself never ends
+    if (dstPath.compare(0, srcPath.size() + 1, srcPath + "/") == 0) {
+        mclog::tagError(TAG, "destination is inside the source");
+        return false;
+    }
+    if (_copy_data.isRunning.exchange(true)) {
+        mclog::tagWarn(TAG, "a copy is already running");
+        return false;
+    }
+
+    // The card stays mounted afterwards, like for recordings
+    auto is_on_sd = [](const std::string& path) { return path == "/sd" || path.compare(0, 4, "/sd/") == 0; };
+    if ((is_on_sd(srcPath) || is_on_sd(dstPath)) && !mount_sd_card()) {
+        _copy_data.isRunning = false;
+        return false;
+    }
+
+    if (!alloc_copy_buffers()) {
+        mclog::tagError(TAG, "alloc copy buffers failed");
+        _copy_data.isRunning = false;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_copy_data.mutex);
+        _copy_data.progress       = FileCopyProgress_t();
+        _copy_data.progress.state = FILE_COPY_SCANNING;
+    }
+    _copy_data.srcPath       = srcPath;
+    _copy_data.dstPath       = dstPath;
+    _copy_data.isCancelled   = false;
+    _copy_data.isWriteFailed = false;
+    _copy_data.writeErrno    = 0;
+
+    if (xTaskCreatePinnedToCore(file_copy_task, "copy_rd", 4096, NULL, 5, NULL, 1) != pdPASS) {
+        mclog::tagError(TAG, "create copy task failed");
+        free_copy_buffers();
+        set_copy_state(FILE_COPY_IDLE);
+        _copy_data.isRunning = false;
+        return false;
+    }
+    return true;
+}
+
+void HalEsp32::cancelFileCopy()
+{
+    // The current chunk is finished first, the partial file is removed
+    _copy_data.isCancelled = true;
+}
+
+hal::HalBase::FileCopyProgress_t HalEsp32::getFileCopyProgress()
+{
+    std::lock_guard<std::mutex> lock(_copy_data.mutex);
+    return _copy_data.progress;
+}
@@ -0,0 +1,1156 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <esp_cache.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <esp_lvgl_port.h>
+#include <driver/jpeg_decode.h>
+#include <driver/ppa.h>
+#include "../utils/pixel_convert/pixel_convert.h"
+#include "../utils/read_ahead_file/read_ahead_file.h"
+#include "../utils/video_plane/video_plane.h"
+
+static const std::string _tag = "video";
+
+// 720p30 MJPEG is about 3 MB/s, the ring covers card stalls of a few hundred milliseconds
+static constexpr size_t _read_ahead_size            = 1024 * 1024;
+static constexpr size_t _scan_chunk_size            = 32 * 1024;
+static constexpr size_t _skip_read_max              = 64 * 1024;
+static constexpr uint32_t _bitstream_count          = 3;
+static constexpr size_t _bitstream_min_size         = 256 * 1024;
+static constexpr size_t _bitstream_max_size         = 4 * 1024 * 1024;
+static constexpr uint32_t _decode_timeout_ms        = 1000;
+static constexpr uint32_t _queue_poll_ms            = 100;
+static constexpr uint32_t _present_period_ms        = 5;
+static constexpr uint32_t _max_late_run             = 3;
+static constexpr uint8_t _max_frames_ahead          = 8;
+static constexpr int64_t _audio_stall_max_us        = 100 * 1000;
+static constexpr uint32_t _default_cache_line_align = 128;
+static constexpr uint8_t _frame_end                 = 0xFF;
+
+enum VideoContainer_t {
+    VIDEO_CONTAINER_AVI = 0,
+    // Concatenated JPEGs, split at their SOI and EOI markers
+    VIDEO_CONTAINER_MJPEG,
+};
+
+// JPEG of one frame in decoder input memory
+struct Bitstream_t {
+    uint8_t* data      = nullptr;
+    size_t capacity    = 0;
+    size_t size        = 0;
+    int64_t ptsUs      = 0;  // On the playback clock, loops included
+    uint32_t filePosMs = 0;
+};
+
+struct VideoFrame_t {
+    uint8_t slot;  // _frame_end after the last frame
+    int64_t ptsUs;
+    uint32_t filePosMs;
+};
+
+struct AviInfo_t {
+    uint32_t frameUs       = 0;
+    uint32_t totalFrames   = 0;
+    uint32_t suggestedSize = 0;
+    int videoStream        = -1;
+    int audioStream        = -1;
+    uint16_t audioFormat   = 0;
+    uint16_t audioChannels = 0;
+    uint32_t audioRate     = 0;
+    uint16_t audioBits     = 0;
+    uint64_t moviStart     = 0;
+    uint64_t moviEnd       = 0;
+};
+
+struct VideoPlayerData_t {
+    std::mutex mutex;
+    std::atomic<bool> isRunning{false};
+    TaskHandle_t readerTask      = nullptr;
+    TaskHandle_t decodeTask      = nullptr;
+    SemaphoreHandle_t readerExit = nullptr;
+    SemaphoreHandle_t decodeExit = nullptr;
+    hal::HalBase::VideoPlayerConfig_t config;
+
+    // Set up before the tasks start
+    VideoContainer_t container = VIDEO_CONTAINER_AVI;
+    AviInfo_t avi;
+    int64_t frameUs   = 0;
+    bool hasAudio     = false;
+    uint16_t planeW   = 0;
+    uint16_t planeH   = 0;
+    size_t cacheAlign = 0;
+    size_t frameSize  = 0;
+
+    // Reader task
+    FILE* file       = nullptr;
+    uint64_t filePos = 0;
+    std::vector<uint8_t> scratch;
+    std::atomic<bool> isReaderDone{false};
+
+    // Decode task
+    jpeg_decoder_handle_t decoder = nullptr;
+    ppa_client_handle_t ppa       = nullptr;
+    uint8_t* decodeBuf            = nullptr;
+    size_t decodeBufSize          = 0;
+    // Size of the picture in each frame slot, the bars around it are cleared when it changes
+    std::vector<uint32_t> slotPicture;
+
+    // Bitstream_t*, nullptr after the last one
+    std::vector<Bitstream_t> bitstreams;
+    QueueHandle_t bitstreamFree  = nullptr;
+    QueueHandle_t bitstreamReady = nullptr;
+    // Canvas sized RGB565 frames, slot indices on frameFree, VideoFrame_t on frameReady
+    std::vector<uint8_t*> frames;
+    QueueHandle_t frameFree  = nullptr;
+    QueueHandle_t frameReady = nullptr;
+
+    // Clock, read by the decode task and LVGL
+    std::mutex clockMutex;
+    std::atomic<bool> isClockStarted{false};
+    int64_t startUs       = 0;
+    int64_t lastAudioUs   = INT64_MIN;
+    int64_t lastAudioAtUs = 0;
+
+    // LVGL context only
+    lv_obj_t* canvas      = nullptr;
+    lv_display_t* display = nullptr;
+    void* canvasData      = nullptr;
+    lv_timer_t* timer     = nullptr;
+    int front             = -1;
+    bool isPlaneActive    = false;
+    bool isPlaneFailed    = false;
+
+    std::mutex statsMutex;
+    hal::HalBase::VideoPlayerStats_t stats;
+};
+static VideoPlayerData_t _video_data;
+
+/* -------------------------------------------------------------------------- */
+/*                                    Clock                                   */
+/* -------------------------------------------------------------------------- */
+// The timer runs from the first frame shown, the sound track from its first sample
+static void start_clock(int64_t ptsUs)
+{
+    std::lock_guard<std::mutex> lock(_video_data.clockMutex);
+    _video_data.startUs        = esp_timer_get_time() - ptsUs;
+    _video_data.isClockStarted = true;
+}
+
+// Playback position, of the samples heard with a sound track
+static int64_t playback_clock_us()
+{
+    std::lock_guard<std::mutex> lock(_video_data.clockMutex);
+    int64_t now_us = esp_timer_get_time();
+    if (!_video_data.hasAudio) {
+        return now_us - _video_data.startUs;
+    }
+
+    int64_t audio_us = HalEsp32::videoAudioClockUs();
+    if (audio_us != _video_data.lastAudioUs) {
+        _video_data.lastAudioUs   = audio_us;
+        _video_data.lastAudioAtUs = now_us;
+        return audio_us;
+    }
+    // The mixer moves a block at a time and the timer fills in between. An underrun holds the video, but only for a
+    // while: with the track far behind the video in the file the reader waits on frames that wait on the sound, so
+    // the timer carries on. Once the file is read through it does for good
+    int64_t held_us = now_us - _video_data.lastAudioAtUs;
+    if (!_video_data.isReaderDone) {
+        held_us = std::min(held_us, _audio_stall_max_us);
+    }
+    return _video_data.lastAudioUs + held_us;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                   Buffers                                  */
+/* -------------------------------------------------------------------------- */
+static size_t align_to_cache_line(size_t size)
+{
+    return (size + _video_data.cacheAlign - 1) / _video_data.cacheAlign * _video_data.cacheAlign;
+}
+
+// Kept from one frame to the next, only grows. keep bytes of the old content are copied over
+static bool ensure_decoder_mem(uint8_t*& buf, size_t& bufSize, size_t size, jpeg_dec_buffer_alloc_direction_t dir,
+                               size_t keep = 0)
+{
+    if (buf != nullptr && bufSize >= size) {
+        return true;
+    }
+    size_t new_size                        = 0;
+    jpeg_decode_memory_alloc_cfg_t mem_cfg = {.buffer_direction = dir};
+    auto new_buf                           = (uint8_t*)jpeg_alloc_decoder_mem(size, &mem_cfg, &new_size);
+    if (new_buf == nullptr) {
+        mclog::tagError(_tag, "no memory for a {} KB decoder buffer", size / 1024);
+        return false;
+    }
+    if (keep) {
+        memcpy(new_buf, buf, keep);
+    }
+    free(buf);
+    buf     = new_buf;
+    bufSize = new_size;
+    return true;
+}
+
+// The PPA and the display port read and write them by DMA, the cleared lines must not be written back over a frame
+static void clear_frame(uint8_t* frame)
+{
+    memset(frame, 0, _video_data.frameSize);
+    esp_cache_msync(frame, align_to_cache_line(_video_data.frameSize), ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+}
+
+static bool alloc_buffers()
+{
+    uint32_t slots = _video_data.config.framesAhead + 2;
+    for (uint32_t i = 0; i < slots; i++) {
+        auto frame = (uint8_t*)heap_caps_aligned_alloc(
+            _video_data.cacheAlign, align_to_cache_line(_video_data.frameSize), MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA);
+        if (frame == nullptr) {
+            mclog::tagError(_tag, "no memory for {} frames of {}x{}", slots, _video_data.planeW, _video_data.planeH);
+            return false;
+        }
+        clear_frame(frame);
+        _video_data.frames.push_back(frame);
+    }
+    _video_data.slotPicture.assign(slots, 0);
+
+    size_t bitstream_size = std::max<size_t>(_video_data.avi.suggestedSize, _bitstream_min_size);
+    _video_data.bitstreams.resize(_bitstream_count);
+    for (auto& bitstream : _video_data.bitstreams) {
+        if (!ensure_decoder_mem(bitstream.data, bitstream.capacity, bitstream_size, JPEG_DEC_ALLOC_INPUT_BUFFER)) {
+            return false;
+        }
+    }
+
+    _video_data.bitstreamFree  = xQueueCreate(_bitstream_count, sizeof(Bitstream_t*));
+    _video_data.bitstreamReady = xQueueCreate(_bitstream_count + 1, sizeof(Bitstream_t*));
+    _video_data.frameFree      = xQueueCreate(slots, sizeof(uint8_t));
+    _video_data.frameReady     = xQueueCreate(slots + 1, sizeof(VideoFrame_t));
+    if (!_video_data.bitstreamFree || !_video_data.bitstreamReady || !_video_data.frameFree ||
+        !_video_data.frameReady) {
+        return false;
+    }
+    for (auto& bitstream : _video_data.bitstreams) {
+        Bitstream_t* ptr = &bitstream;
+        xQueueSend(_video_data.bitstreamFree, &ptr, 0);
+    }
+    for (uint8_t i = 0; i < slots; i++) {
+        xQueueSend(_video_data.frameFree, &i, 0);
+    }
+    return true;
+}
+
+static void free_buffers()
+{
+    for (auto frame : _video_data.frames) {
+        heap_caps_free(frame);
+    }
+    for (auto& bitstream : _video_data.bitstreams) {
+        free(bitstream.data);
+    }
+    free(_video_data.decodeBuf);
+    _video_data.frames.clear();
+    _video_data.slotPicture.clear();
+    _video_data.bitstreams.clear();
+    _video_data.decodeBuf     = nullptr;
+    _video_data.decodeBufSize = 0;
+
+    for (QueueHandle_t* queue : {&_video_data.bitstreamFree, &_video_data.bitstreamReady, &_video_data.frameFree,
+                                 &_video_data.frameReady}) {
+        if (*queue) {
+            vQueueDelete(*queue);
+            *queue = nullptr;
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    File                                    */
+/* -------------------------------------------------------------------------- */
+static bool file_read(void* dst, size_t size)
+{
+    if (fread(dst, 1, size, _video_data.file) != size) {
+        return false;
+    }
+    _video_data.filePos += size;
+    return true;
+}
+
+// Short skips are read through, a seek restarts the read ahead
+static bool file_skip(uint64_t size)
+{
+    if (size > _skip_read_max) {
+        if (fseek(_video_data.file, _video_data.filePos + size, SEEK_SET) != 0) {
+            return false;
+        }
+        _video_data.filePos += size;
+        return true;
+    }
+    _video_data.scratch.resize(std::max<size_t>(_video_data.scratch.size(), size));
+    return file_read(_video_data.scratch.data(), size);
+}
+
+static bool file_seek(uint64_t pos)
+{
+    if (fseek(_video_data.file, pos, SEEK_SET) != 0) {
+        return false;
+    }
+    _video_data.filePos = pos;
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                     AVI                                    */
+/* -------------------------------------------------------------------------- */
+static inline uint32_t avi_get_u32(const uint8_t* p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static inline uint16_t avi_get_u16(const uint8_t* p)
+{
+    uint16_t v;
+    memcpy(&v, p, 2);
+    return v;
+}
+
+static inline bool avi_is_fourcc(const uint8_t* p, const char* fourcc)
+{
+    return memcmp(p, fourcc, 4) == 0;
+}
+
+// strh and strf of one stream
+static void avi_parse_strl(const uint8_t* data, size_t size, int stream, AviInfo_t& avi)
+{
+    bool is_video = false;
+    bool is_audio = false;
+    for (size_t pos = 0; pos + 8 <= size;) {
+        const uint8_t* chunk = data + pos;
+        uint32_t chunk_size  = avi_get_u32(chunk + 4);
+        const uint8_t* body  = chunk + 8;
+        if (pos + 8 + chunk_size > size) {
+            break;
+        }
+        if (avi_is_fourcc(chunk, "strh") && chunk_size >= 36) {
+            is_video       = avi_is_fourcc(body, "vids") && avi.videoStream < 0;
+            is_audio       = avi_is_fourcc(body, "auds") && avi.audioStream < 0;
+            uint32_t scale = avi_get_u32(body + 20);
+            uint32_t rate  = avi_get_u32(body + 24);
+            if (is_video) {
+                avi.videoStream = stream;
+                if (scale && rate) {
+                    avi.frameUs = (uint64_t)scale * 1000000 / rate;
+                }
+                avi.totalFrames   = std::max(avi.totalFrames, avi_get_u32(body + 32));
+                avi.suggestedSize = std::max(avi.suggestedSize, avi_get_u32(body + 36));
+            }
+        } else if (avi_is_fourcc(chunk, "strf") && is_audio && chunk_size >= 16) {
+            // WAVEFORMATEX
+            avi.audioStream   = stream;
+            avi.audioFormat   = avi_get_u16(body);
+            avi.audioChannels = avi_get_u16(body + 2);
+            avi.audioRate     = avi_get_u32(body + 4);
+            avi.audioBits     = avi_get_u16(body + 14);
+        }
+        pos += 8 + chunk_size + (chunk_size & 1);
+    }
+}
+
+static void avi_parse_hdrl(const uint8_t* data, size_t size, AviInfo_t& avi)
+{
+    int stream = 0;
+    for (size_t pos = 0; pos + 8 <= size;) {
+        const uint8_t* chunk = data + pos;
+        uint32_t chunk_size  = avi_get_u32(chunk + 4);
+        if (pos + 8 + chunk_size > size) {
+            break;
+        }
+        if (avi_is_fourcc(chunk, "avih") && chunk_size >= 32) {
+            // The video stream header's rate takes over when it has one
+            avi.frameUs       = avi.frameUs ? avi.frameUs : avi_get_u32(chunk + 8);
+            avi.totalFrames   = std::max(avi.totalFrames, avi_get_u32(chunk + 8 + 16));
+            avi.suggestedSize = std::max(avi.suggestedSize, avi_get_u32(chunk + 8 + 28));
+        } else if (avi_is_fourcc(chunk, "LIST") && chunk_size >= 4 && avi_is_fourcc(chunk + 8, "strl")) {
+            avi_parse_strl(chunk + 12, chunk_size - 4, stream++, avi);
+        }
+        pos += 8 + chunk_size + (chunk_size & 1);
+    }
+}
+
+// Reads up to the movi list, the file is left at its first chunk
+static bool avi_parse_header(AviInfo_t& avi)
+{
+    uint8_t riff[12];
+    if (!file_read(riff, sizeof(riff)) || !avi_is_fourcc(riff, "RIFF") || !avi_is_fourcc(riff + 8, "AVI ")) {
+        return false;
+    }
+    uint64_t riff_end = 8 + (uint64_t)avi_get_u32(riff + 4);
+
+    uint8_t header[12];
+    while (_video_data.filePos + 8 <= riff_end && file_read(header, 8)) {
+        uint32_t size   = avi_get_u32(header + 4);
+        uint64_t padded = size + (size & 1);
+        if (!avi_is_fourcc(header, "LIST") || size < 4) {
+            if (!file_skip(padded)) {
+                return false;
+            }
+            continue;
+        }
+        if (!file_read(header + 8, 4)) {
+            return false;
+        }
+        if (avi_is_fourcc(header + 8, "movi")) {
+            avi.moviStart = _video_data.filePos;
+            avi.moviEnd   = _video_data.filePos + size - 4;
+            return avi.videoStream >= 0;
+        }
+        if (avi_is_fourcc(header + 8, "hdrl")) {
+            std::vector<uint8_t> hdrl(padded - 4);
+            if (!file_read(hdrl.data(), hdrl.size())) {
+                return false;
+            }
+            avi_parse_hdrl(hdrl.data(), size - 4, avi);
+        } else if (!file_skip(padded - 4)) {
+            return false;
+        }
+    }
+    return false;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                   Reader                                   */
+/* -------------------------------------------------------------------------- */
+// Blocks until the decoder gives one back, nullptr once stopping
+static Bitstream_t* take_bitstream()
+{
+    Bitstream_t* bitstream = nullptr;
+    while (_video_data.isRunning) {
+        if (xQueueReceive(_video_data.bitstreamFree, &bitstream, pdMS_TO_TICKS(_queue_poll_ms)) == pdTRUE) {
+            bitstream->size = 0;
+            return bitstream;
+        }
+    }
+    return nullptr;
+}
+
+static void submit_bitstream(Bitstream_t* bitstream, int64_t ptsUs, uint32_t filePosMs)
+{
+    bitstream->ptsUs     = ptsUs;
+    bitstream->filePosMs = filePosMs;
+    xQueueSend(_video_data.bitstreamReady, &bitstream, portMAX_DELAY);
+}
+
+static bool grow_bitstream(Bitstream_t* bitstream, size_t size)
+{
+    if (size > _bitstream_max_size) {
+        mclog::tagWarn(_tag, "frame over {} KB skipped", _bitstream_max_size / 1024);
+        return false;
+    }
+    // Doubled, a raw stream grows it while scanning
+    size_t capacity = std::max(size, bitstream->capacity * 2);
+    return ensure_decoder_mem(bitstream->data, bitstream->capacity, std::min(capacity, _bitstream_max_size),
+                              JPEG_DEC_ALLOC_INPUT_BUFFER, bitstream->size);
+}
+
+// PCM into the mixer stream, paced by the mixer draining its ring
+static bool write_audio(size_t size)
+{
+    _video_data.scratch.resize(std::max<size_t>(_video_data.scratch.size(), size));
+    if (!file_read(_video_data.scratch.data(), size)) {
+        return false;
+    }
+    auto samples   = (const int16_t*)_video_data.scratch.data();
+    size_t frames  = size / sizeof(int16_t) / _video_data.avi.audioChannels;
+    size_t written = 0;
+    while (written < frames && _video_data.isRunning) {
+        written += HalEsp32::videoAudioWrite(samples + written * _video_data.avi.audioChannels, frames - written);
+        if (written < frames) {
+            vTaskDelay(pdMS_TO_TICKS(5));
+        }
+    }
+    return true;
+}
+
+// One pass over the movi list, false on a read error
+static bool read_avi(int64_t baseUs, uint32_t& frames)
+{
+    const AviInfo_t& avi = _video_data.avi;
+    uint8_t header[8];
+    while (_video_data.isRunning && _video_data.filePos + 8 <= avi.moviEnd) {
+        if (!file_read(header, sizeof(header))) {
+            return false;
+        }
+        uint32_t size = avi_get_u32(header + 4);
+        // 'rec ' and any other list, its chunks follow one after the other
+        if (avi_is_fourcc(header, "LIST")) {
+            if (!file_skip(4)) {
+                return false;
+            }
+            continue;
+        }
+
+        int stream     = (header[0] - '0') * 10 + (header[1] - '0');
+        bool is_video  = stream == avi.videoStream && (header[2] == 'd' && (header[3] == 'c' || header[3] == 'b'));
+        bool is_audio  = stream == avi.audioStream && header[2] == 'w' && header[3] == 'b';
+        bool is_padded = size & 1;
+        if (is_video) {
+            int64_t file_us = (int64_t)frames * _video_data.frameUs;
+            frames++;
+            // An empty chunk repeats the frame before
+            if (size == 0) {
+                continue;
+            }
+            Bitstream_t* bitstream = take_bitstream();
+            if (bitstream == nullptr) {
+                return true;
+            }
+            if (size > bitstream->capacity && !grow_bitstream(bitstream, size)) {
+                xQueueSend(_video_data.bitstreamFree, &bitstream, 0);
+                if (!file_skip(size)) {
+                    return false;
+                }
+            } else {
+                if (!file_read(bitstream->data, size)) {
+                    xQueueSend(_video_data.bitstreamFree, &bitstream, 0);
+                    return false;
+                }
+                bitstream->size = size;
+                submit_bitstream(bitstream, baseUs + file_us, file_us / 1000);
+            }
+        } else if (is_audio && _video_data.hasAudio) {
+            if (!write_audio(size)) {
+                return false;
+            }
+        } else if (!file_skip(size)) {
+            return false;
+        }
+        if (is_padded && !file_skip(1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Appends to the frame being collected, growing it past its capacity
+static bool append_bitstream(Bitstream_t* bitstream, const uint8_t* data, size_t size)
+{
+    if (bitstream->size + size > bitstream->capacity && !grow_bitstream(bitstream, bitstream->size + size)) {
+        return false;
+    }
+    memcpy(bitstream->data + bitstream->size, data, size);
+    bitstream->size += size;
+    return true;
+}
+
+// One pass over a raw stream. Entropy coded data has every 0xFF stuffed, so EOI only shows up at the end of a frame
+static bool read_mjpeg(int64_t baseUs, uint32_t& frames)
+{
+    _video_data.scratch.resize(std::max(_video_data.scratch.size(), _scan_chunk_size));
+    uint8_t* buf           = _video_data.scratch.data();
+    Bitstream_t* bitstream = nullptr;
+    bool is_prev_ff        = false;
+
+    while (_video_data.isRunning) {
+        size_t len = fread(buf, 1, _scan_chunk_size, _video_data.file);
+        if (len == 0) {
+            break;
+        }
+        _video_data.filePos += len;
+
+        for (size_t i = 0; i < len;) {
+            if (bitstream == nullptr || bitstream->size == 0) {
+                // Between frames, looking for SOI
+                uint8_t byte = buf[i++];
+                if (!is_prev_ff || byte != 0xD8) {
+                    is_prev_ff = byte == 0xFF;
+                    continue;
+                }
+                bitstream = bitstream ? bitstream : take_bitstream();
+                if (bitstream == nullptr) {
+                    return true;
+                }
+                static const uint8_t soi[2] = {0xFF, 0xD8};
+                append_bitstream(bitstream, soi, sizeof(soi));
+                is_prev_ff = false;
+                continue;
+            }
+            if (is_prev_ff && buf[i] == 0xD9) {
+                bool is_whole   = append_bitstream(bitstream, buf + i, 1);
+                int64_t file_us = (int64_t)frames * _video_data.frameUs;
+                i++;
+                is_prev_ff = false;
+                if (is_whole) {
+                    submit_bitstream(bitstream, baseUs + file_us, file_us / 1000);
+                    frames++;
+                    bitstream = nullptr;
+                } else {
+                    bitstream->size = 0;
+                }
+                continue;
+            }
+            auto ff    = (const uint8_t*)memchr(buf + i, 0xFF, len - i);
+            size_t end = ff ? ff - buf + 1 : len;
+            if (!append_bitstream(bitstream, buf + i, end - i)) {
+                // Too large, the rest of it is skipped up to the next SOI
+                bitstream->size = 0;
+            }
+            is_prev_ff = ff != nullptr;
+            i          = end;
+        }
+    }
+
+    if (bitstream) {
+        // A frame cut off at the end of the file
+        xQueueSend(_video_data.bitstreamFree, &bitstream, 0);
+    }
+    return !ferror(_video_data.file);
+}
+
+static void _video_reader_task(void* param)
+{
+    bool is_avi     = _video_data.container == VIDEO_CONTAINER_AVI;
+    uint64_t start  = is_avi ? _video_data.avi.moviStart : 0;
+    int64_t base_us = 0;
+    uint32_t passes = 0;
+
+    while (_video_data.isRunning) {
+        uint32_t frames = 0;
+        bool is_read    = is_avi ? read_avi(base_us, frames) : read_mjpeg(base_us, frames);
+        if (!is_read) {
+            mclog::tagError(_tag, "read failed at {}", _video_data.filePos);
+            break;
+        }
+        passes++;
+        if (!_video_data.config.loop || frames == 0 || !file_seek(start)) {
+            break;
+        }
+        // Timestamps run on over the loops, the sound track too
+        base_us += (int64_t)frames * _video_data.frameUs;
+    }
+
+    Bitstream_t* end = nullptr;
+    xQueueSend(_video_data.bitstreamReady, &end, portMAX_DELAY);
+    _video_data.isReaderDone = true;
+    mclog::tagInfo(_tag, "reader done after {} passes", passes);
+
+    xSemaphoreGive(_video_data.readerExit);
+    vTaskDelete(NULL);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                   Decode                                   */
+/* -------------------------------------------------------------------------- */
+// Decodes the frame and fits it into the slot, centered
+static bool decode_frame(const Bitstream_t& bitstream, uint8_t slot)
+{
+    jpeg_decode_picture_info_t info;
+    if (jpeg_decoder_get_info(bitstream.data, bitstream.size, &info) != ESP_OK || info.width == 0 ||
+        info.height == 0) {
+        return false;
+    }
+
+    // The codec writes whole MCUs
+    bool is_h_subsampled = info.sample_method == JPEG_DOWN_SAMPLING_YUV420 ||
+                           info.sample_method == JPEG_DOWN_SAMPLING_YUV422;
+    uint32_t mcu_w       = is_h_subsampled ? 16 : 8;
+    uint32_t mcu_h       = info.sample_method == JPEG_DOWN_SAMPLING_YUV420 ? 16 : 8;
+    uint32_t out_w       = (info.width + mcu_w - 1) / mcu_w * mcu_w;
+    uint32_t out_h       = (info.height + mcu_h - 1) / mcu_h * mcu_h;
+    if (!ensure_decoder_mem(_video_data.decodeBuf, _video_data.decodeBufSize, out_w * out_h * 2,
+                            JPEG_DEC_ALLOC_OUTPUT_BUFFER)) {
+        return false;
+    }
+
+    jpeg_decode_cfg_t decode_cfg = {
+        .output_format = JPEG_DECODE_OUT_FORMAT_RGB565,
+        .rgb_order     = JPEG_DEC_RGB_ELEMENT_ORDER_BGR,
+        .conv_std      = JPEG_YUV_RGB_CONV_STD_BT601,
+    };
+    uint32_t out_size = 0;
+    if (jpeg_decoder_process(_video_data.decoder, &decode_cfg, bitstream.data, bitstream.size, _video_data.decodeBuf,
+                             _video_data.decodeBufSize, &out_size) != ESP_OK) {
+        return false;
+    }
+
+    float scale = std::min((float)_video_data.planeW / info.width, (float)_video_data.planeH / info.height);
+    // The PPA scales in steps of 1/16
+    float ppa_scale = std::floor(scale * 16.0f) / 16.0f;
+    bool is_ppa     = _video_data.ppa != nullptr && ppa_scale > 0.0f;
+    if (is_ppa) {
+        scale = ppa_scale;
+    }
+    uint32_t w = std::clamp<uint32_t>(info.width * scale, 1, _video_data.planeW);
+    uint32_t h = std::clamp<uint32_t>(info.height * scale, 1, _video_data.planeH);
+    uint32_t x = (_video_data.planeW - w) / 2;
+    uint32_t y = (_video_data.planeH - h) / 2;
+
+    uint8_t* frame = _video_data.frames[slot];
+    if (_video_data.slotPicture[slot] != (w << 16 | h)) {
+        clear_frame(frame);
+        _video_data.slotPicture[slot] = w << 16 | h;
+    }
+
+    if (is_ppa) {
+        ppa_srm_oper_config_t oper = {};
+        oper.in.buffer             = _video_data.decodeBuf;
+        oper.in.pic_w              = out_w;
+        oper.in.pic_h              = out_h;
+        oper.in.block_w            = info.width;
+        oper.in.block_h            = info.height;
+        oper.in.srm_cm             = PPA_SRM_COLOR_MODE_RGB565;
+        oper.out.buffer            = frame;
+        oper.out.buffer_size       = align_to_cache_line(_video_data.frameSize);
+        oper.out.pic_w             = _video_data.planeW;
+        oper.out.pic_h             = _video_data.planeH;
+        oper.out.block_offset_x    = x;
+        oper.out.block_offset_y    = y;
+        oper.out.srm_cm            = PPA_SRM_COLOR_MODE_RGB565;
+        oper.rotation_angle        = PPA_SRM_ROTATION_ANGLE_0;
+        oper.scale_x               = scale;
+        oper.scale_y               = scale;
+        oper.mode                  = PPA_TRANS_MODE_BLOCKING;
+        is_ppa                     = ppa_do_scale_rotate_mirror(_video_data.ppa, &oper) == ESP_OK;
+    }
+    if (!is_ppa) {
+        uint32_t stride = _video_data.planeW * 2;
+        pixel_convert::scale_rgb565(_video_data.decodeBuf, out_w * 2, info.width, info.height,
+                                    frame + y * stride + x * 2, stride, w, h);
+        esp_cache_msync(frame, align_to_cache_line(_video_data.frameSize), ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+    }
+
+    std::lock_guard<std::mutex> lock(_video_data.statsMutex);
+    _video_data.stats.width  = info.width;
+    _video_data.stats.height = info.height;
+    return true;
+}
+
+static void _video_decode_task(void* param)
+{
+    uint32_t late_run = 0;
+
+    while (_video_data.isRunning) {
+        Bitstream_t* bitstream = nullptr;
+        if (xQueueReceive(_video_data.bitstreamReady, &bitstream, pdMS_TO_TICKS(_queue_poll_ms)) != pdTRUE) {
+            continue;
+        }
+        if (bitstream == nullptr) {
+            VideoFrame_t end = {_frame_end, 0, 0};
+            xQueueSend(_video_data.frameReady, &end, 0);
+            continue;
+        }
+
+        uint8_t slot = 0;
+        while (_video_data.isRunning &&
+               xQueueReceive(_video_data.frameFree, &slot, pdMS_TO_TICKS(_queue_poll_ms)) != pdTRUE) {
+        }
+        if (!_video_data.isRunning) {
+            break;
+        }
+
+        // Already a frame late, decoding it would only make the next one late too. A decoder that cannot keep up
+        // still gets a frame out every few
+        if (_video_data.isClockStarted && bitstream->ptsUs + _video_data.frameUs < playback_clock_us() &&
+            late_run < _max_late_run) {
+            late_run++;
+            xQueueSend(_video_data.bitstreamFree, &bitstream, 0);
+            xQueueSend(_video_data.frameFree, &slot, 0);
+            std::lock_guard<std::mutex> lock(_video_data.statsMutex);
+            _video_data.stats.framesDropped++;
+            continue;
+        }
+        late_run = 0;
+
+        int64_t start_us   = esp_timer_get_time();
+        bool is_decoded    = decode_frame(*bitstream, slot);
+        VideoFrame_t frame = {slot, bitstream->ptsUs, bitstream->filePosMs};
+        xQueueSend(_video_data.bitstreamFree, &bitstream, 0);
+        {
+            std::lock_guard<std::mutex> lock(_video_data.statsMutex);
+            if (is_decoded) {
+                _video_data.stats.lastDecodeUs = esp_timer_get_time() - start_us;
+            } else {
+                _video_data.stats.decodeFailures++;
+            }
+        }
+        if (!is_decoded) {
+            xQueueSend(_video_data.frameFree, &slot, 0);
+            continue;
+        }
+        xQueueSend(_video_data.frameReady, &frame, 0);
+    }
+
+    xSemaphoreGive(_video_data.decodeExit);
+    vTaskDelete(NULL);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                   Present                                  */
+/* -------------------------------------------------------------------------- */
+// Runs in LVGL context
+static void video_plane_clear()
+{
+    if (_video_data.isPlaneActive) {
+        lvgl_port_set_video_plane(_video_data.display, NULL, NULL);
+        _video_data.isPlaneActive = false;
+    }
+}
+
+// Points the canvas at the slot, as the video plane when it is drawn as a plain rectangle
+static void present_frame(const VideoFrame_t& frame)
+{
+    uint8_t* pixels         = _video_data.frames[frame.slot];
+    lv_draw_buf_t* draw_buf = lv_canvas_get_draw_buf(_video_data.canvas);
+    lv_area_t area;
+    bool is_plane = !_video_data.isPlaneFailed &&
+                    video_plane::fits(_video_data.canvas, _video_data.planeW, _video_data.planeH, area);
+    if (is_plane && lvgl_port_set_video_plane(_video_data.display, pixels, &area) != ESP_OK) {
+        // There is no vsync swap to put it under, the canvas path stays in use
+        mclog::tagInfo(_tag, "no video plane, frames are drawn by LVGL");
+        _video_data.isPlaneFailed = true;
+        is_plane                  = false;
+    }
+    if (!is_plane) {
+        video_plane_clear();
+    }
+
+    draw_buf->data = pixels;
+    lv_image_cache_drop(draw_buf);
+    if (is_plane) {
+        video_plane::invalidate_overlays(_video_data.canvas, area);
+        video_plane::invalidate_dot(_video_data.canvas, area);
+    } else {
+        lv_obj_invalidate(_video_data.canvas);
+    }
+    _video_data.isPlaneActive = is_plane;
+
+    if (_video_data.front >= 0) {
+        uint8_t old = _video_data.front;
+        xQueueSend(_video_data.frameFree, &old, 0);
+    }
+    _video_data.front = frame.slot;
+
+    std::lock_guard<std::mutex> lock(_video_data.statsMutex);
+    _video_data.stats.framesShown++;
+    _video_data.stats.positionMs   = frame.filePosMs;
+    _video_data.stats.isVideoPlane = is_plane;
+}
+
+// Shows the newest frame that is due, the ones before it are dropped
+static void video_present_timer_cb(lv_timer_t* timer)
+{
+    VideoFrame_t frame = {};
+    VideoFrame_t next  = {};
+    bool is_due        = false;
+    uint32_t dropped   = 0;
+    int64_t clock_us   = _video_data.hasAudio || _video_data.isClockStarted ? playback_clock_us() : 0;
+
+    while (xQueuePeek(_video_data.frameReady, &next, 0) == pdTRUE) {
+        if (next.slot == _frame_end) {
+            if (is_due) {
+                break;
+            }
+            xQueueReceive(_video_data.frameReady, &next, 0);
+            lv_timer_pause(timer);
+            std::lock_guard<std::mutex> lock(_video_data.statsMutex);
+            auto& stats = _video_data.stats;
+            stats.state = stats.framesShown ? hal::HalBase::VIDEO_PLAYER_ENDED : hal::HalBase::VIDEO_PLAYER_FAILED;
+            mclog::tagInfo(_tag, "ended, {} frames shown, {} dropped", stats.framesShown, stats.framesDropped);
+            return;
+        }
+        // Without a sound track the clock starts with the first frame
+        if (!_video_data.isClockStarted && !_video_data.hasAudio) {
+            start_clock(next.ptsUs);
+            clock_us = next.ptsUs;
+        }
+        if (next.ptsUs > clock_us) {
+            break;
+        }
+        xQueueReceive(_video_data.frameReady, &next, 0);
+        if (is_due) {
+            xQueueSend(_video_data.frameFree, &frame.slot, 0);
+            dropped++;
+        }
+        frame  = next;
+        is_due = true;
+    }
+    if (!is_due) {
+        return;
+    }
+
+    present_frame(frame);
+    _video_data.isClockStarted = true;
+    if (dropped) {
+        std::lock_guard<std::mutex> lock(_video_data.statsMutex);
+        _video_data.stats.framesDropped += dropped;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                     API                                    */
+/* -------------------------------------------------------------------------- */
+static bool is_avi_path(const std::string& path)
+{
+    auto dot = path.find_last_of('.');
+    if (dot == std::string::npos) {
+        return false;
+    }
+    std::string ext = path.substr(dot + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == "avi";
+}
+
+static bool open_file(const std::string& path, uint8_t fps)
+{
+    _video_data.file = read_ahead_fopen(("/sd/" + path).c_str(), _read_ahead_size);
+    if (_video_data.file == nullptr) {
+        return false;
+    }
+    _video_data.filePos = 0;
+    _video_data.avi     = AviInfo_t();
+
+    if (is_avi_path(path)) {
+        if (!avi_parse_header(_video_data.avi)) {
+            mclog::tagError(_tag, "{} is not an MJPEG AVI", path);
+            return false;
+        }
+        _video_data.container = VIDEO_CONTAINER_AVI;
+        _video_data.frameUs   = _video_data.avi.frameUs ? _video_data.avi.frameUs : 1000000 / std::max<uint8_t>(fps, 1);
+        return true;
+    }
+    _video_data.container = VIDEO_CONTAINER_MJPEG;
+    _video_data.frameUs   = 1000000 / std::max<uint8_t>(fps, 1);
+    return true;
+}
+
+static void close_file()
+{
+    if (_video_data.file) {
+        fclose(_video_data.file);
+        _video_data.file = nullptr;
+    }
+    std::vector<uint8_t>().swap(_video_data.scratch);
+}
+
+static void release_engines()
+{
+    if (_video_data.decoder) {
+        jpeg_del_decoder_engine(_video_data.decoder);
+        _video_data.decoder = nullptr;
+    }
+    if (_video_data.ppa) {
+        ppa_unregister_client(_video_data.ppa);
+        _video_data.ppa = nullptr;
+    }
+}
+
+// Everything start set up, the tasks have ended or never ran
+static void release_playback()
+{
+    if (_video_data.hasAudio) {
+        HalEsp32::videoAudioEnd();
+        _video_data.hasAudio = false;
+    }
+    close_file();
+    release_engines();
+    free_buffers();
+}
+
+// The canvas takes its own buffer back, with the frame on screen in it
+static void restore_canvas()
+{
+    LvglLockGuard lock;
+
+    if (_video_data.timer) {
+        lv_timer_delete(_video_data.timer);
+        _video_data.timer = nullptr;
+    }
+    video_plane_clear();
+    lv_draw_buf_t* draw_buf = lv_canvas_get_draw_buf(_video_data.canvas);
+    if (_video_data.front >= 0) {
+        memcpy(_video_data.canvasData, _video_data.frames[_video_data.front], _video_data.frameSize);
+    }
+    draw_buf->data = (uint8_t*)_video_data.canvasData;
+    lv_image_cache_drop(draw_buf);
+    lv_obj_invalidate(_video_data.canvas);
+    _video_data.front  = -1;
+    _video_data.canvas = nullptr;
+}
+
+bool HalEsp32::startVideoPlayback(const std::string& path, const VideoPlayerConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_video_data.mutex);
+
+    if (_video_data.isRunning) {
+        mclog::tagWarn(_tag, "already playing");
+        return false;
+    }
+    if (!isSdCardMounted()) {
+        mclog::tagError(_tag, "no sd card");
+        return false;
+    }
+    {
+        LvglLockGuard lvgl_lock;
+        if (config.canvas == nullptr || !lv_obj_check_type(config.canvas, &lv_canvas_class)) {
+            mclog::tagError(_tag, "not a canvas");
+            return false;
+        }
+        lv_draw_buf_t* buf = lv_canvas_get_draw_buf(config.canvas);
+        if (buf == nullptr || buf->header.cf != LV_COLOR_FORMAT_RGB565 || buf->header.stride != buf->header.w * 2) {
+            mclog::tagError(_tag, "canvas needs an RGB565 buffer without padding");
+            return false;
+        }
+        _video_data.planeW     = buf->header.w;
+        _video_data.planeH     = buf->header.h;
+        _video_data.canvasData = buf->data;
+        _video_data.display    = lv_obj_get_display(config.canvas);
+    }
+
+    _video_data.config             = config;
+    _video_data.config.framesAhead = std::clamp<uint8_t>(config.framesAhead, 1, _max_frames_ahead);
+    _video_data.frameSize          = _video_data.planeW * _video_data.planeH * 2;
+    if (esp_cache_get_alignment(MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA, &_video_data.cacheAlign) != ESP_OK ||
+        _video_data.cacheAlign == 0) {
+        _video_data.cacheAlign = _default_cache_line_align;
+    }
+
+    if (!open_file(path, config.fps)) {
+        close_file();
+        return false;
+    }
+
+    jpeg_decode_engine_cfg_t engine_cfg = {
+        .intr_priority = 0,
+        .timeout_ms    = _decode_timeout_ms,
+    };
+    if (jpeg_new_decoder_engine(&engine_cfg, &_video_data.decoder) != ESP_OK) {
+        mclog::tagError(_tag, "failed to create the jpeg decoder");
+        release_playback();
+        return false;
+    }
+    // Without the PPA frames are scaled on the CPU
+    ppa_client_config_t ppa_config = {
+        .oper_type             = PPA_OPERATION_SRM,
+        .max_pending_trans_num = 1,
+    };
+    if (ppa_register_client(&ppa_config, &_video_data.ppa) != ESP_OK) {
+        mclog::tagWarn(_tag, "no ppa client, scaling on the cpu");
+        _video_data.ppa = nullptr;
+    }
+    if (!alloc_buffers()) {
+        release_playback();
+        return false;
+    }
+
+    // 16 bit PCM plays along, anything else is skipped
+    const AviInfo_t& avi = _video_data.avi;
+    _video_data.hasAudio = false;
+    if (avi.audioStream >= 0) {
+        if (avi.audioFormat != 1 || avi.audioBits != 16 || avi.audioChannels < 1 || avi.audioChannels > 2 ||
+            avi.audioRate == 0) {
+            mclog::tagWarn(_tag, "audio format {} at {} bit not supported, playing without sound", avi.audioFormat,
+                           avi.audioBits);
+        } else {
+            _video_data.hasAudio = HalEsp32::videoAudioBegin(avi.audioRate, avi.audioChannels, config.volume);
+        }
+    }
+
+    _video_data.isClockStarted = false;
+    _video_data.isReaderDone   = false;
+    _video_data.lastAudioUs    = INT64_MIN;
+    _video_data.canvas         = config.canvas;
+    _video_data.front          = -1;
+    _video_data.isPlaneActive  = false;
+    _video_data.isPlaneFailed  = false;
+    {
+        std::lock_guard<std::mutex> stats_lock(_video_data.statsMutex);
+        _video_data.stats            = VideoPlayerStats_t();
+        _video_data.stats.state      = VIDEO_PLAYER_PLAYING;
+        _video_data.stats.fps        = 1000000.0f / _video_data.frameUs;
+        _video_data.stats.durationMs = (uint64_t)avi.totalFrames * _video_data.frameUs / 1000;
+        _video_data.stats.hasAudio   = _video_data.hasAudio;
+    }
+    if (_video_data.readerExit == nullptr) {
+        _video_data.readerExit = xSemaphoreCreateBinary();
+        _video_data.decodeExit = xSemaphoreCreateBinary();
+    }
+
+    _video_data.isRunning = true;
+    if (xTaskCreate(_video_reader_task, "video_rd", 4096, nullptr, 5, &_video_data.readerTask) != pdPASS) {
+        mclog::tagError(_tag, "create reader task failed");
+        _video_data.isRunning = false;
+        _video_data.canvas    = nullptr;
+        release_playback();
+        return false;
+    }
+    if (xTaskCreate(_video_decode_task, "video_dec", 4096, nullptr, 6, &_video_data.decodeTask) != pdPASS) {
+        mclog::tagError(_tag, "create decode task failed");
+        _video_data.isRunning = false;
+        xSemaphoreTake(_video_data.readerExit, portMAX_DELAY);
+        _video_data.canvas = nullptr;
+        release_playback();
+        return false;
+    }
+    {
+        LvglLockGuard lvgl_lock;
+        _video_data.timer = lv_timer_create(video_present_timer_cb, _present_period_ms, nullptr);
+    }
+
+    mclog::tagInfo(_tag, "play {}, {} at {:.1f} fps into {}x{}, {} frames ahead{}", path,
+                   _video_data.container == VIDEO_CONTAINER_AVI ? "avi" : "mjpeg", 1000000.0f / _video_data.frameUs,
+                   _video_data.planeW, _video_data.planeH, _video_data.config.framesAhead,
+                   _video_data.hasAudio ? fmt::format(", pcm {} Hz {} ch", avi.audioRate, avi.audioChannels) : "");
+    return true;
+}
+
+void HalEsp32::stopVideoPlayback()
+{
+    std::lock_guard<std::mutex> lock(_video_data.mutex);
+
+    if (!_video_data.isRunning) {
+        return;
+    }
+
+    // The tasks only wait on the queues for a poll interval at a time
+    _video_data.isRunning = false;
+    xSemaphoreTake(_video_data.readerExit, portMAX_DELAY);
+    xSemaphoreTake(_video_data.decodeExit, portMAX_DELAY);
+    _video_data.readerTask = nullptr;
+    _video_data.decodeTask = nullptr;
+    restore_canvas();
+    release_playback();
+
+    std::lock_guard<std::mutex> stats_lock(_video_data.statsMutex);
+    auto& stats = _video_data.stats;
+    if (stats.state == VIDEO_PLAYER_PLAYING) {
+        stats.state = VIDEO_PLAYER_IDLE;
+    }
+    mclog::tagInfo(_tag, "stop, {} frames shown, {} dropped, {} failed", stats.framesShown, stats.framesDropped,
+                   stats.decodeFailures);
+}
+
+hal::HalBase::VideoPlayerStats_t HalEsp32::getVideoPlayerStats()
+{
+    std::lock_guard<std::mutex> lock(_video_data.statsMutex);
+    return _video_data.stats;
+}
@@ -5,19 +5,27 @@
  */
 #include "hal/hal_esp32.h"
 #include <mooncake_log.h>
+#include <shared/shared.h>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <algorithm>
 #include <string.h>
 #include <bsp/m5stack_tab5.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/event_groups.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
 #include <esp_wifi.h>
 #include <nvs_flash.h>
+#include <nvs.h>
 #include <esp_event.h>
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <nvs_flash.h>
 #include <esp_netif.h>
 #include <esp_http_server.h>
+#include <lwip/sockets.h>
 
 #define TAG "wifi"
 
@@ -68,31 +76,246 @@ esp_err_t hello_get_handler(httpd_req_t* req)
     return ESP_OK;
 }
 
+// Longest client frame a stream endpoint reads, control frames fit
+static constexpr size_t _ws_drain_max = 128;
+
+// The stream endpoints only send, the frames of their clients are read and dropped. The length comes from the
+// client, a longer frame fails the handler and the server closes the session
+esp_err_t web_ws_drain_frame(httpd_req_t* req)
+{
+    httpd_ws_frame_t frame = {};
+    if (httpd_ws_recv_frame(req, &frame, 0) != ESP_OK || frame.len > _ws_drain_max) {
+        return ESP_FAIL;
+    }
+    if (frame.len == 0) {
+        return ESP_OK;
+    }
+    uint8_t payload[_ws_drain_max];
+    frame.payload = payload;
+    return httpd_ws_recv_frame(req, &frame, frame.len);
+}
+
+// The soft AP is open, anyone in range can reach the server through it. Endpoints that change the board or show
+// what is on it refuse requests from there. Decided by the local address of the connection, one that cannot be told
+// apart counts as the AP
+bool web_request_on_ap(httpd_req_t* req)
+{
+    esp_netif_t* ap = esp_netif_get_handle_from_ifkey("WIFI_AP_DEF");
+    esp_netif_ip_info_t ip_info;
+    if (ap == nullptr || esp_netif_get_ip_info(ap, &ip_info) != ESP_OK) {
+        return false;
+    }
+
+    struct sockaddr_storage addr;
+    socklen_t addr_len = sizeof(addr);
+    if (getsockname(httpd_req_to_sockfd(req), (struct sockaddr*)&addr, &addr_len) != 0) {
+        return true;
+    }
+    uint32_t local = 0;
+    if (addr.ss_family == AF_INET) {
+        local = ((struct sockaddr_in*)&addr)->sin_addr.s_addr;
+    } else if (addr.ss_family == AF_INET6) {
+        // The server listens on IPv6, IPv4 clients come in as mapped addresses
+        auto* addr6 = &((struct sockaddr_in6*)&addr)->sin6_addr;
+        if (addr6->un.u32_addr[0] != 0 || addr6->un.u32_addr[1] != 0 || addr6->un.u32_addr[2] != PP_HTONL(0xFFFF)) {
+            return true;
+        }
+        local = addr6->un.u32_addr[3];
+    } else {
+        return true;
+    }
+    return local == ip_info.ip.addr;
+}
+
+// Camera H.264 stream, implemented in hal_camera.cpp
+esp_err_t camera_h264_stream_handler(httpd_req_t* req);
+
+// Telemetry API, implemented in hal_telemetry.cpp
+void telemetry_register_handlers(httpd_handle_t server);
+
+// Screen mirror, implemented in hal_mirror.cpp
+void screen_mirror_register_handlers(httpd_handle_t server);
+
+// Screenshots and recordings, implemented in hal_screen_capture.cpp
+void screen_capture_register_handlers(httpd_handle_t server);
+
+// Firmware update, implemented in hal_ota.cpp
+void ota_register_handlers(httpd_handle_t server);
+
+// SD card files and listings, implemented in hal_file_server.cpp
+void file_server_register_handlers(httpd_handle_t server);
+
+// Sampling profiler dump, implemented in hal_profiler.cpp
+void profiler_register_handlers(httpd_handle_t server);
+
+// Event trace, implemented in hal_event_trace.cpp
+void event_trace_register_handlers(httpd_handle_t server);
+
 // URI 路由
-httpd_uri_t hello_uri = {.uri = "/", .method = HTTP_GET, .handler = hello_get_handler, .user_ctx = nullptr};
+httpd_uri_t hello_uri  = {.uri = "/", .method = HTTP_GET, .handler = hello_get_handler, .user_ctx = nullptr};
+httpd_uri_t stream_uri = {
+    .uri = "/stream.h264", .method = HTTP_GET, .handler = camera_h264_stream_handler, .user_ctx = nullptr};
 
 // 启动 Web Server
 httpd_handle_t start_webserver()
 {
     httpd_config_t config = HTTPD_DEFAULT_CONFIG();
     httpd_handle_t server = nullptr;
+    // The file server takes everything under /sd/
+    config.uri_match_fn     = httpd_uri_match_wildcard;
+    config.max_uri_handlers = 14;
 
     if (httpd_start(&server, &config) == ESP_OK) {
         httpd_register_uri_handler(server, &hello_uri);
+        telemetry_register_handlers(server);
+        GetHAL()->startTelemetry(hal::HalBase::TelemetryConfig_t());
+        ESP_LOGI(TAG, "telemetry at http://<ap ip>/api/telemetry and ws://<ap ip>/ws/telemetry");
+        screen_mirror_register_handlers(server);
+        GetHAL()->startScreenMirror(hal::HalBase::ScreenMirrorConfig_t());
+        ESP_LOGI(TAG, "screen mirror at http://<ap ip>/mirror");
+        screen_capture_register_handlers(server);
+        ESP_LOGI(TAG, "screenshot at http://<ap ip>/screenshot.jpg");
+        ota_register_handlers(server);
+        ESP_LOGI(TAG, "firmware update at http://<ap ip>/api/ota");
+        file_server_register_handlers(server);
+        ESP_LOGI(TAG, "sd card files at http://<ap ip>/sd/");
+        profiler_register_handlers(server);
+        ESP_LOGI(TAG, "profiler dump at http://<ap ip>/api/profile");
+        event_trace_register_handlers(server);
+        ESP_LOGI(TAG, "event trace at http://<ap ip>/api/trace");
+    }
+
+    // The stream handler never returns while a client is watching, so it gets its own server
+    httpd_handle_t stream_server = nullptr;
+    config.server_port += 1;
+    config.ctrl_port += 1;
+    if (httpd_start(&stream_server, &config) == ESP_OK) {
+        httpd_register_uri_handler(stream_server, &stream_uri);
+        ESP_LOGI(TAG, "camera stream at http://<ap ip>:%d/stream.h264", config.server_port);
     }
     return server;
 }
 
-// 初始化 Wi-Fi AP 模式
-void wifi_init_softap()
+// NVS, netif, the default event loop and the driver are shared by the AP and the station
+struct WifiStackData_t {
+    std::mutex mutex;
+    bool isNvsInitial = false;
+    bool isInitial    = false;
+    bool isStarted    = false;
+    bool isApEnabled  = false;
+    bool isStaEnabled = false;
+    // Station power save from the power policy, pushed to the driver on change
+    hal::HalBase::RadioLevel_t psLevel = hal::HalBase::RADIO_LEVEL_DTIM;
+    uint8_t listenInterval             = 10;
+    int appliedPs                      = -1;
+};
+static WifiStackData_t _wifi_stack_data;
+
+// Lock _wifi_stack_data.mutex before calling
+static void wifi_stack_nvs_init()
 {
+    if (_wifi_stack_data.isNvsInitial) {
+        return;
+    }
+
+    esp_err_t ret = nvs_flash_init();
+    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        ESP_ERROR_CHECK(nvs_flash_erase());
+        ret = nvs_flash_init();
+    }
+    ESP_ERROR_CHECK(ret);
+    _wifi_stack_data.isNvsInitial = true;
+}
+
+// Lock _wifi_stack_data.mutex before calling
+static void wifi_stack_init()
+{
+    if (_wifi_stack_data.isInitial) {
+        return;
+    }
+    wifi_stack_nvs_init();
+
     ESP_ERROR_CHECK(esp_netif_init());
     ESP_ERROR_CHECK(esp_event_loop_create_default());
 
-    esp_netif_create_default_wifi_ap();
-
     wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
     ESP_ERROR_CHECK(esp_wifi_init(&cfg));
+    _wifi_stack_data.isInitial = true;
+}
+
+// Lock _wifi_stack_data.mutex before calling, connected stations of the AP miss frames while the modem sleeps so
+// power save only applies to a station on its own
+static void wifi_stack_apply_power_save()
+{
+    if (!_wifi_stack_data.isStarted) {
+        _wifi_stack_data.appliedPs = -1;
+        return;
+    }
+
+    wifi_ps_type_t ps = WIFI_PS_NONE;
+    if (_wifi_stack_data.isStaEnabled && !_wifi_stack_data.isApEnabled) {
+        if (_wifi_stack_data.psLevel == hal::HalBase::RADIO_LEVEL_SLEEP) {
+            ps = WIFI_PS_MAX_MODEM;
+        } else if (_wifi_stack_data.psLevel == hal::HalBase::RADIO_LEVEL_DTIM) {
+            ps = WIFI_PS_MIN_MODEM;
+        }
+    }
+    if (ps == _wifi_stack_data.appliedPs) {
+        return;
+    }
+
+    esp_err_t ret = esp_wifi_set_ps(ps);
+    if (ret != ESP_OK) {
+        mclog::tagError(TAG, "set power save failed: {}", esp_err_to_name(ret));
+        return;
+    }
+    _wifi_stack_data.appliedPs = ps;
+    mclog::tagInfo(TAG, "power save {}", (int)ps);
+}
+
+// Lock _wifi_stack_data.mutex before calling, the driver runs in whichever modes are enabled
+static void wifi_stack_apply_mode()
+{
+    wifi_mode_t mode = WIFI_MODE_NULL;
+    if (_wifi_stack_data.isApEnabled && _wifi_stack_data.isStaEnabled) {
+        mode = WIFI_MODE_APSTA;
+    } else if (_wifi_stack_data.isApEnabled) {
+        mode = WIFI_MODE_AP;
+    } else if (_wifi_stack_data.isStaEnabled) {
+        mode = WIFI_MODE_STA;
+    }
+
+    if (mode == WIFI_MODE_NULL) {
+        if (_wifi_stack_data.isStarted) {
+            esp_wifi_stop();
+            _wifi_stack_data.isStarted = false;
+        }
+        return;
+    }
+    ESP_ERROR_CHECK(esp_wifi_set_mode(mode));
+    if (!_wifi_stack_data.isStarted) {
+        ESP_ERROR_CHECK(esp_wifi_start());
+        _wifi_stack_data.isStarted = true;
+    }
+    wifi_stack_apply_power_save();
+}
+
+// Power policy entry, the policy calls this with its own mutex held and this never calls back into the policy
+void wifi_set_power_save(hal::HalBase::RadioLevel_t level, uint8_t listenInterval)
+{
+    std::lock_guard<std::mutex> lock(_wifi_stack_data.mutex);
+    _wifi_stack_data.psLevel        = level;
+    _wifi_stack_data.listenInterval = listenInterval;
+    wifi_stack_apply_power_save();
+}
+
+// 初始化 Wi-Fi AP 模式
+void wifi_init_softap()
+{
+    std::lock_guard<std::mutex> lock(_wifi_stack_data.mutex);
+    wifi_stack_init();
+
+    esp_netif_create_default_wifi_ap();
 
     wifi_config_t wifi_config = {};
     std::strncpy(reinterpret_cast<char*>(wifi_config.ap.ssid), WIFI_SSID, sizeof(wifi_config.ap.ssid));
@@ -101,9 +324,11 @@ void wifi_init_softap()
     wifi_config.ap.max_connection = MAX_STA_CONN;
     wifi_config.ap.authmode       = WIFI_AUTH_OPEN;
 
-    ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_AP));
+    // The config is set before the AP interface starts
+    _wifi_stack_data.isApEnabled = true;
+    ESP_ERROR_CHECK(esp_wifi_set_mode(_wifi_stack_data.isStaEnabled ? WIFI_MODE_APSTA : WIFI_MODE_AP));
     ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_AP, &wifi_config));
-    ESP_ERROR_CHECK(esp_wifi_start());
+    wifi_stack_apply_mode();
 
     ESP_LOGI(TAG, "Wi-Fi AP started. SSID:%s password:%s", WIFI_SSID, WIFI_PASS);
 }
@@ -123,13 +348,6 @@ bool HalEsp32::wifi_init()
 {
     mclog::tagInfo(TAG, "wifi init");
 
-    esp_err_t ret = nvs_flash_init();
-    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
-        ESP_ERROR_CHECK(nvs_flash_erase());
-        ret = nvs_flash_init();
-    }
-    ESP_ERROR_CHECK(ret);
-
     xTaskCreate(wifi_ap_test_task, "ap", 4096, nullptr, 5, nullptr);
     return true;
 }
@@ -139,6 +357,8 @@ void HalEsp32::setExtAntennaEnable(bool enable)
     _ext_antenna_enable = enable;
     mclog::tagInfo(TAG, "set ext antenna enable: {}", _ext_antenna_enable);
     bsp_set_ext_antenna_enable(_ext_antenna_enable);
+    io_expander_commit();
+    settingsStore().set("ext_antenna", _ext_antenna_enable);
 }
 
 bool HalEsp32::getExtAntennaEnable()
@@ -150,3 +370,408 @@ void HalEsp32::startWifiAp()
 {
     wifi_init();
 }
+
+/* -------------------------------------------------------------------------- */
+/*                                   Station                                  */
+/* -------------------------------------------------------------------------- */
+static const char* _nvs_namespace = "wifi_sta";
+// Backoff between reconnects, the first one after a drop goes out at once
+static constexpr uint32_t _retry_delay_min_ms = 500;
+static constexpr uint32_t _retry_delay_max_ms = 30000;
+// Auth failures in a row before the state reads failed
+static constexpr uint32_t _auth_fail_limit = 3;
+
+enum WifiStaEventType_t {
+    WIFI_STA_EVENT_CONNECTED = 0,
+    WIFI_STA_EVENT_DISCONNECTED,
+    WIFI_STA_EVENT_GOT_IP,
+    WIFI_STA_EVENT_STOP,
+};
+
+struct WifiStaEvent_t {
+    WifiStaEventType_t type = WIFI_STA_EVENT_STOP;
+    uint8_t bssid[6]        = {};
+    uint8_t channel         = 0;
+    uint16_t reason         = 0;
+    esp_ip4_addr_t ip       = {};
+};
+
+struct WifiCredentials_t {
+    std::string ssid;
+    std::string password;
+    // The AP of the last connection, channel 0 means none is cached
+    uint8_t bssid[6] = {};
+    uint8_t channel  = 0;
+};
+
+struct WifiStaData_t {
+    std::mutex mutex;
+    QueueHandle_t eventQueue  = nullptr;
+    SemaphoreHandle_t exitSem = nullptr;
+    esp_netif_t* netif        = nullptr;
+    bool isRunning            = false;
+    std::mutex statusMutex;
+    hal::HalBase::WifiStatus_t status;
+};
+static WifiStaData_t _wifi_sta_data;
+
+static bool load_credentials(WifiCredentials_t& credentials)
+{
+    nvs_handle_t handle;
+    if (nvs_open(_nvs_namespace, NVS_READONLY, &handle) != ESP_OK) {
+        return false;
+    }
+
+    char ssid[33]        = {};
+    char password[65]    = {};
+    size_t ssid_size     = sizeof(ssid);
+    size_t password_size = sizeof(password);
+
+    bool is_ok = nvs_get_str(handle, "ssid", ssid, &ssid_size) == ESP_OK &&
+                 nvs_get_str(handle, "pass", password, &password_size) == ESP_OK;
+    if (is_ok) {
+        credentials.ssid     = ssid;
+        credentials.password = password;
+        size_t bssid_size    = sizeof(credentials.bssid);
+        if (nvs_get_blob(handle, "bssid", credentials.bssid, &bssid_size) != ESP_OK ||
+            nvs_get_u8(handle, "channel", &credentials.channel) != ESP_OK) {
+            credentials.channel = 0;
+        }
+    }
+    nvs_close(handle);
+    return is_ok;
+}
+
+// Channel 0 drops the cached AP
+static void save_ap_cache(const uint8_t* bssid, uint8_t channel)
+{
+    nvs_handle_t handle;
+    if (nvs_open(_nvs_namespace, NVS_READWRITE, &handle) != ESP_OK) {
+        return;
+    }
+    if (channel == 0) {
+        nvs_erase_key(handle, "bssid");
+        nvs_erase_key(handle, "channel");
+    } else {
+        nvs_set_blob(handle, "bssid", bssid, 6);
+        nvs_set_u8(handle, "channel", channel);
+    }
+    nvs_commit(handle);
+    nvs_close(handle);
+}
+
+// Joins the cached AP straight on its channel, otherwise scans every channel and takes the strongest AP
+static void sta_connect(const WifiCredentials_t& credentials, bool useCache)
+{
+    wifi_config_t config = {};
+    memcpy(config.sta.ssid, credentials.ssid.data(), std::min(credentials.ssid.size(), sizeof(config.sta.ssid)));
+    memcpy(config.sta.password, credentials.password.data(),
+           std::min(credentials.password.size(), sizeof(config.sta.password)));
+    config.sta.threshold.authmode = credentials.password.empty() ? WIFI_AUTH_OPEN : WIFI_AUTH_WPA2_PSK;
+    config.sta.pmf_cfg.capable    = true;
+    config.sta.sort_method        = WIFI_CONNECT_AP_BY_SIGNAL;
+    {
+        // Only used by WIFI_PS_MAX_MODEM, sent to the AP when associating
+        std::lock_guard<std::mutex> lock(_wifi_stack_data.mutex);
+        config.sta.listen_interval = _wifi_stack_data.listenInterval;
+    }
+    if (useCache && credentials.channel != 0) {
+        config.sta.scan_method = WIFI_FAST_SCAN;
+        config.sta.bssid_set   = true;
+        config.sta.channel     = credentials.channel;
+        memcpy(config.sta.bssid, credentials.bssid, sizeof(config.sta.bssid));
+    } else {
+        config.sta.scan_method = WIFI_ALL_CHANNEL_SCAN;
+    }
+
+    esp_wifi_set_config(WIFI_IF_STA, &config);
+    esp_err_t ret = esp_wifi_connect();
+    if (ret != ESP_OK) {
+        mclog::tagError(TAG, "connect failed: {}", esp_err_to_name(ret));
+    }
+}
+
+static void sta_event_handler(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+    WifiStaEvent_t event;
+    if (base == WIFI_EVENT && id == WIFI_EVENT_STA_CONNECTED) {
+        auto info     = static_cast<wifi_event_sta_connected_t*>(data);
+        event.type    = WIFI_STA_EVENT_CONNECTED;
+        event.channel = info->channel;
+        memcpy(event.bssid, info->bssid, sizeof(event.bssid));
+    } else if (base == WIFI_EVENT && id == WIFI_EVENT_STA_DISCONNECTED) {
+        auto info    = static_cast<wifi_event_sta_disconnected_t*>(data);
+        event.type   = WIFI_STA_EVENT_DISCONNECTED;
+        event.reason = info->reason;
+    } else if (base == IP_EVENT && id == IP_EVENT_STA_GOT_IP) {
+        auto info  = static_cast<ip_event_got_ip_t*>(data);
+        event.type = WIFI_STA_EVENT_GOT_IP;
+        event.ip   = info->ip_info.ip;
+    } else {
+        return;
+    }
+    xQueueSend(_wifi_sta_data.eventQueue, &event, 0);
+}
+
+static void set_sta_state(hal::HalBase::WifiState_t state)
+{
+    {
+        std::lock_guard<std::mutex> lock(_wifi_sta_data.statusMutex);
+        if (_wifi_sta_data.status.state == state) {
+            return;
+        }
+        _wifi_sta_data.status.state = state;
+    }
+
+    GetEventBus().publish({shared_data::EVENT_TOPIC_WIFI, 0, state});
+}
+
+static bool is_auth_failure(uint16_t reason)
+{
+    return reason == WIFI_REASON_AUTH_FAIL || reason == WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT ||
+           reason == WIFI_REASON_HANDSHAKE_TIMEOUT || reason == WIFI_REASON_MIC_FAILURE;
+}
+
+static void wifi_sta_task(void* param)
+{
+    WifiCredentials_t credentials;
+    load_credentials(credentials);
+    {
+        std::lock_guard<std::mutex> lock(_wifi_sta_data.statusMutex);
+        _wifi_sta_data.status.ssid = credentials.ssid;
+    }
+
+    // Whether the attempt in flight went to the cached AP, and when it started
+    bool is_cached_attempt = credentials.channel != 0;
+    int64_t attempt_us     = esp_timer_get_time();
+    uint32_t retries       = 0;
+    uint32_t auth_failures = 0;
+    set_sta_state(hal::HalBase::WIFI_STATE_CONNECTING);
+    sta_connect(credentials, is_cached_attempt);
+
+    TickType_t wait = portMAX_DELAY;
+    WifiStaEvent_t event;
+    while (1) {
+        if (xQueueReceive(_wifi_sta_data.eventQueue, &event, wait) != pdTRUE) {
+            // Backoff is over
+            wait              = portMAX_DELAY;
+            is_cached_attempt = credentials.channel != 0;
+            attempt_us        = esp_timer_get_time();
+            if (auth_failures < _auth_fail_limit) {
+                set_sta_state(hal::HalBase::WIFI_STATE_CONNECTING);
+            }
+            sta_connect(credentials, is_cached_attempt);
+            continue;
+        }
+        if (event.type == WIFI_STA_EVENT_STOP) {
+            break;
+        }
+
+        switch (event.type) {
+            case WIFI_STA_EVENT_CONNECTED: {
+                if (event.channel != credentials.channel ||
+                    memcmp(event.bssid, credentials.bssid, sizeof(credentials.bssid)) != 0) {
+                    credentials.channel = event.channel;
+                    memcpy(credentials.bssid, event.bssid, sizeof(credentials.bssid));
+                    save_ap_cache(credentials.bssid, credentials.channel);
+                }
+                std::lock_guard<std::mutex> lock(_wifi_sta_data.statusMutex);
+                _wifi_sta_data.status.channel = event.channel;
+                break;
+            }
+            case WIFI_STA_EVENT_GOT_IP: {
+                wifi_ap_record_t ap_info;
+                int8_t rssi = esp_wifi_sta_get_ap_info(&ap_info) == ESP_OK ? ap_info.rssi : 0;
+                char ip[16];
+                snprintf(ip, sizeof(ip), IPSTR, IP2STR(&event.ip));
+                uint32_t connect_time_ms = (esp_timer_get_time() - attempt_us) / 1000;
+                mclog::tagInfo(TAG, "connected to {}, ip {}, rssi {}, {} ms{}", credentials.ssid, ip, rssi,
+                               connect_time_ms, is_cached_attempt ? " from the cached ap" : "");
+                {
+                    std::lock_guard<std::mutex> lock(_wifi_sta_data.statusMutex);
+                    _wifi_sta_data.status.ip            = ip;
+                    _wifi_sta_data.status.rssi          = rssi;
+                    _wifi_sta_data.status.connectTimeMs = connect_time_ms;
+                    _wifi_sta_data.status.isFastConnect = is_cached_attempt;
+                    _wifi_sta_data.status.retries       = 0;
+                }
+                retries           = 0;
+                auth_failures     = 0;
+                is_cached_attempt = false;
+                set_sta_state(hal::HalBase::WIFI_STATE_CONNECTED);
+                break;
+            }
+            case WIFI_STA_EVENT_DISCONNECTED: {
+                {
+                    std::lock_guard<std::mutex> lock(_wifi_sta_data.statusMutex);
+                    _wifi_sta_data.status.ip.clear();
+                }
+                if (is_cached_attempt && !is_auth_failure(event.reason)) {
+                    // The AP moved or is gone, forget it and scan right away
+                    mclog::tagWarn(TAG, "cached ap not joined, reason {}, scanning", event.reason);
+                    credentials.channel = 0;
+                    save_ap_cache(nullptr, 0);
+                    is_cached_attempt = false;
+                    sta_connect(credentials, false);
+                    break;
+                }
+
+                retries++;
+                auth_failures     = is_auth_failure(event.reason) ? auth_failures + 1 : 0;
+                uint32_t delay_ms = 0;
+                if (auth_failures >= _auth_fail_limit) {
+                    delay_ms = _retry_delay_max_ms;
+                    set_sta_state(hal::HalBase::WIFI_STATE_FAILED);
+                } else {
+                    if (retries > 1) {
+                        delay_ms = std::min(_retry_delay_min_ms << std::min<uint32_t>(retries - 2, 6),
+                                            _retry_delay_max_ms);
+                    }
+                    set_sta_state(hal::HalBase::WIFI_STATE_DISCONNECTED);
+                }
+                {
+                    std::lock_guard<std::mutex> lock(_wifi_sta_data.statusMutex);
+                    _wifi_sta_data.status.retries = retries;
+                }
+                mclog::tagWarn(TAG, "disconnected, reason {}, retry in {} ms", event.reason, delay_ms);
+                wait = std::max<TickType_t>(pdMS_TO_TICKS(delay_ms), 1);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    xSemaphoreGive(_wifi_sta_data.exitSem);
+    vTaskDelete(NULL);
+}
+
+// NVS is shared with the driver, which may not be up yet, and with the settings store in hal_settings.cpp
+void wifi_nvs_init()
+{
+    std::lock_guard<std::mutex> lock(_wifi_stack_data.mutex);
+    wifi_stack_nvs_init();
+}
+
+bool HalEsp32::setWifiCredentials(const std::string& ssid, const std::string& password)
+{
+    if (ssid.empty() || ssid.size() > 32 || password.size() > 64) {
+        mclog::tagError(TAG, "invalid credentials");
+        return false;
+    }
+    wifi_nvs_init();
+
+    nvs_handle_t handle;
+    if (nvs_open(_nvs_namespace, NVS_READWRITE, &handle) != ESP_OK) {
+        return false;
+    }
+    bool is_ok = nvs_set_str(handle, "ssid", ssid.c_str()) == ESP_OK &&
+                 nvs_set_str(handle, "pass", password.c_str()) == ESP_OK;
+    // A new network never matches the cached AP
+    nvs_erase_key(handle, "bssid");
+    nvs_erase_key(handle, "channel");
+    is_ok = is_ok && nvs_commit(handle) == ESP_OK;
+    nvs_close(handle);
+
+    mclog::tagInfo(TAG, "credentials for {} {}", ssid, is_ok ? "saved" : "not saved");
+    return is_ok;
+}
+
+void HalEsp32::clearWifiCredentials()
+{
+    wifi_nvs_init();
+
+    nvs_handle_t handle;
+    if (nvs_open(_nvs_namespace, NVS_READWRITE, &handle) != ESP_OK) {
+        return;
+    }
+    nvs_erase_all(handle);
+    nvs_commit(handle);
+    nvs_close(handle);
+}
+
+bool HalEsp32::hasWifiCredentials()
+{
+    wifi_nvs_init();
+
+    WifiCredentials_t credentials;
+    return load_credentials(credentials);
+}
+
+bool HalEsp32::startWifiSta()
+{
+    std::lock_guard<std::mutex> lock(_wifi_sta_data.mutex);
+    if (_wifi_sta_data.isRunning) {
+        return true;
+    }
+    if (!hasWifiCredentials()) {
+        mclog::tagError(TAG, "no wifi credentials");
+        return false;
+    }
+
+    mclog::tagInfo(TAG, "start wifi sta");
+    if (_wifi_sta_data.eventQueue == nullptr) {
+        _wifi_sta_data.eventQueue = xQueueCreate(8, sizeof(WifiStaEvent_t));
+        _wifi_sta_data.exitSem    = xSemaphoreCreateBinary();
+    }
+    // Events left over from the previous session
+    xQueueReset(_wifi_sta_data.eventQueue);
+    {
+        std::lock_guard<std::mutex> status_lock(_wifi_sta_data.statusMutex);
+        _wifi_sta_data.status = WifiStatus_t();
+    }
+
+    {
+        std::lock_guard<std::mutex> stack_lock(_wifi_stack_data.mutex);
+        wifi_stack_init();
+        if (_wifi_sta_data.netif == nullptr) {
+            _wifi_sta_data.netif = esp_netif_create_default_wifi_sta();
+            ESP_ERROR_CHECK(
+                esp_event_handler_instance_register(WIFI_EVENT, ESP_EVENT_ANY_ID, sta_event_handler, NULL, NULL));
+            ESP_ERROR_CHECK(
+                esp_event_handler_instance_register(IP_EVENT, IP_EVENT_STA_GOT_IP, sta_event_handler, NULL, NULL));
+        }
+        _wifi_stack_data.isStaEnabled = true;
+        wifi_stack_apply_mode();
+    }
+
+    if (xTaskCreate(wifi_sta_task, "wifi_sta", 4096, nullptr, 5, nullptr) != pdPASS) {
+        mclog::tagError(TAG, "create task failed");
+        return false;
+    }
+    _wifi_sta_data.isRunning = true;
+    return true;
+}
+
+void HalEsp32::stopWifiSta()
+{
+    std::lock_guard<std::mutex> lock(_wifi_sta_data.mutex);
+    if (!_wifi_sta_data.isRunning) {
+        return;
+    }
+
+    mclog::tagInfo(TAG, "stop wifi sta");
+    WifiStaEvent_t stop_event;
+    stop_event.type = WIFI_STA_EVENT_STOP;
+    xQueueSend(_wifi_sta_data.eventQueue, &stop_event, portMAX_DELAY);
+    xSemaphoreTake(_wifi_sta_data.exitSem, portMAX_DELAY);
+    _wifi_sta_data.isRunning = false;
+
+    esp_wifi_disconnect();
+    {
+        std::lock_guard<std::mutex> stack_lock(_wifi_stack_data.mutex);
+        _wifi_stack_data.isStaEnabled = false;
+        wifi_stack_apply_mode();
+    }
+    {
+        std::lock_guard<std::mutex> status_lock(_wifi_sta_data.statusMutex);
+        _wifi_sta_data.status.ip.clear();
+    }
+    set_sta_state(WIFI_STATE_IDLE);
+}
+
+hal::HalBase::WifiStatus_t HalEsp32::getWifiStatus()
+{
+    std::lock_guard<std::mutex> lock(_wifi_sta_data.statusMutex);
+    return _wifi_sta_data.status;
+}
@@ -0,0 +1,446 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "hal/hal_esp32.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <errno.h>
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <driver/gpio.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <lwip/sockets.h>
+#include <lwip/netdb.h>
+
+static const std::string _tag = "wifi-bench";
+
+// SDIO pins to the ESP32-C6, as ESP-Hosted was built with
+static const gpio_num_t _link_gpios[] = {
+    (gpio_num_t)CONFIG_ESP_HOSTED_SDIO_PIN_CLK,
+    (gpio_num_t)CONFIG_ESP_HOSTED_SDIO_PIN_CMD,
+    (gpio_num_t)CONFIG_ESP_HOSTED_SDIO_PIN_D0,
+#if CONFIG_ESP_HOSTED_SDIO_4_BIT_BUS
+    (gpio_num_t)CONFIG_ESP_HOSTED_SDIO_PIN_D1,
+    (gpio_num_t)CONFIG_ESP_HOSTED_SDIO_PIN_D2,
+    (gpio_num_t)CONFIG_ESP_HOSTED_SDIO_PIN_D3,
+#endif
+    (gpio_num_t)CONFIG_ESP_HOSTED_SDIO_GPIO_RESET_SLAVE,
+};
+
+static constexpr uint16_t _tcp_block_size = 16 * 1024;
+// iperf 2 default, fits one frame with its header
+static constexpr uint16_t _udp_block_size = 1470;
+// RX modes wait this long for the peer to start
+static constexpr uint32_t _peer_timeout_ms = 30000;
+// Link settles after a drive change before the next run
+static constexpr uint32_t _drive_settle_ms = 500;
+// Datagrams with a negative id end an iperf UDP test, sent a few times in case some get lost
+static constexpr int _udp_fin_count = 10;
+
+// Start of every iperf 2 UDP datagram, network order
+struct IperfUdpHeader_t {
+    int32_t id;
+    uint32_t tvSec;
+    uint32_t tvUsec;
+};
+
+struct WifiBenchmarkData_t {
+    std::mutex mutex;
+    hal::HalBase::WifiBenchmarkConfig_t config;
+    hal::HalBase::WifiBenchmarkResult_t result;
+};
+static WifiBenchmarkData_t _wifi_bench_data;
+
+/* -------------------------------------------------------------------------- */
+/*                                 Link drive                                 */
+/* -------------------------------------------------------------------------- */
+void HalEsp32::apply_wifi_link_drive()
+{
+    for (auto gpio : _link_gpios) {
+        esp_err_t ret = gpio_set_drive_capability(gpio, (gpio_drive_cap_t)_wifi_link_drive);
+        if (ret != ESP_OK) {
+            mclog::tagError(_tag, "set gpio {} drive failed: {}", (int)gpio, esp_err_to_name(ret));
+        }
+    }
+    mclog::tagInfo(_tag, "link drive {}", _wifi_link_drive);
+}
+
+bool HalEsp32::setWifiLinkDrive(uint8_t level)
+{
+    if (level >= GPIO_DRIVE_CAP_MAX) {
+        return false;
+    }
+    _wifi_link_drive = level;
+    apply_wifi_link_drive();
+    settingsStore().set<uint8_t>("link_drive", level);
+    return true;
+}
+
+uint8_t HalEsp32::getWifiLinkDrive()
+{
+    return _wifi_link_drive;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                 Benchmark                                  */
+/* -------------------------------------------------------------------------- */
+// Megabits per second from bytes over microseconds
+static float to_mbps(uint64_t bytes, int64_t us)
+{
+    return us > 0 ? bytes * 8.0f / us : 0.0f;
+}
+
+static int connect_to(const std::string& host, uint16_t port, int type, std::string& error)
+{
+    struct addrinfo hints = {};
+    hints.ai_family       = AF_INET;
+    hints.ai_socktype     = type;
+    struct addrinfo* addr = nullptr;
+    std::string service   = std::to_string(port);
+    if (host.empty() || getaddrinfo(host.c_str(), service.c_str(), &hints, &addr) != 0 || addr == nullptr) {
+        error = "host not found: " + host;
+        return -1;
+    }
+
+    int sock = socket(addr->ai_family, addr->ai_socktype, 0);
+    if (sock < 0 || connect(sock, addr->ai_addr, addr->ai_addrlen) != 0) {
+        error = fmt::format("connect to {}:{} failed: {}", host, port, strerror(errno));
+        if (sock >= 0) {
+            close(sock);
+        }
+        sock = -1;
+    }
+    freeaddrinfo(addr);
+    return sock;
+}
+
+static int bind_to(uint16_t port, int type, std::string& error)
+{
+    int sock = socket(AF_INET, type, 0);
+    if (sock < 0) {
+        error = "socket failed";
+        return -1;
+    }
+    int reuse = 1;
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    struct sockaddr_in addr = {};
+    addr.sin_family         = AF_INET;
+    addr.sin_port           = htons(port);
+    addr.sin_addr.s_addr    = htonl(INADDR_ANY);
+    if (bind(sock, (struct sockaddr*)&addr, sizeof(addr)) != 0 || (type == SOCK_STREAM && listen(sock, 1) != 0)) {
+        error = fmt::format("bind to port {} failed: {}", port, strerror(errno));
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+static void set_timeout(int sock, int option, uint32_t ms)
+{
+    struct timeval tv = {(time_t)(ms / 1000), (suseconds_t)(ms % 1000 * 1000)};
+    setsockopt(sock, SOL_SOCKET, option, &tv, sizeof(tv));
+}
+
+static bool run_tcp_tx(const hal::HalBase::WifiBenchmarkConfig_t& config, uint8_t* buffer, size_t size,
+                       hal::HalBase::WifiBenchmarkRun_t& run, std::string& error)
+{
+    int sock = connect_to(config.host, config.port, SOCK_STREAM, error);
+    if (sock < 0) {
+        return false;
+    }
+    set_timeout(sock, SO_SNDTIMEO, 2000);
+
+    int64_t start_us    = esp_timer_get_time();
+    int64_t duration_us = (int64_t)config.durationSec * 1000000;
+    int64_t elapsed_us  = 0;
+    bool is_ok          = true;
+    while (elapsed_us < duration_us) {
+        int ret = send(sock, buffer, size, 0);
+        if (ret < 0) {
+            error = fmt::format("send failed: {}", strerror(errno));
+            is_ok = false;
+            break;
+        }
+        run.bytes += ret;
+        elapsed_us = esp_timer_get_time() - start_us;
+    }
+    close(sock);
+    run.mbps = to_mbps(run.bytes, elapsed_us);
+    return is_ok;
+}
+
+static bool run_tcp_rx(const hal::HalBase::WifiBenchmarkConfig_t& config, uint8_t* buffer, size_t size,
+                       hal::HalBase::WifiBenchmarkRun_t& run, std::string& error)
+{
+    int listen_sock = bind_to(config.port, SOCK_STREAM, error);
+    if (listen_sock < 0) {
+        return false;
+    }
+    mclog::tagInfo(_tag, "waiting for iperf -c on port {}", config.port);
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(listen_sock, &fds);
+    struct timeval tv = {(time_t)(_peer_timeout_ms / 1000), 0};
+    int sock          = -1;
+    if (select(listen_sock + 1, &fds, nullptr, nullptr, &tv) > 0) {
+        sock = accept(listen_sock, nullptr, nullptr);
+    }
+    close(listen_sock);
+    if (sock < 0) {
+        error = fmt::format("no client in {} s", _peer_timeout_ms / 1000);
+        return false;
+    }
+    set_timeout(sock, SO_RCVTIMEO, 1000);
+
+    // Until the client is done or the duration is up, whichever comes first
+    int64_t start_us    = esp_timer_get_time();
+    int64_t duration_us = (int64_t)config.durationSec * 1000000;
+    int64_t elapsed_us  = 0;
+    while (elapsed_us < duration_us) {
+        int ret = recv(sock, buffer, size, 0);
+        if (ret <= 0 && !(ret < 0 && errno == EAGAIN)) {
+            break;
+        }
+        if (ret > 0) {
+            run.bytes += ret;
+        }
+        elapsed_us = esp_timer_get_time() - start_us;
+    }
+    close(sock);
+    run.mbps = to_mbps(run.bytes, elapsed_us);
+    return true;
+}
+
+static bool run_udp_tx(const hal::HalBase::WifiBenchmarkConfig_t& config, uint8_t* buffer, size_t size,
+                       hal::HalBase::WifiBenchmarkRun_t& run, std::string& error)
+{
+    int sock = connect_to(config.host, config.port, SOCK_DGRAM, error);
+    if (sock < 0) {
+        return false;
+    }
+
+    // Time per datagram at the target rate, 0 sends back to back
+    int64_t interval_us = config.udpRateKbps > 0 ? (int64_t)size * 8 * 1000 / config.udpRateKbps : 0;
+    int64_t start_us    = esp_timer_get_time();
+    int64_t duration_us = (int64_t)config.durationSec * 1000000;
+    int64_t next_us     = start_us;
+    int64_t now_us      = start_us;
+    auto header         = (IperfUdpHeader_t*)buffer;
+    int32_t id          = 0;
+    while (now_us - start_us < duration_us) {
+        if (interval_us > 0 && next_us - now_us > 2000) {
+            vTaskDelay(1);
+            now_us = esp_timer_get_time();
+            continue;
+        }
+        header->id     = htonl(id);
+        header->tvSec  = htonl(now_us / 1000000);
+        header->tvUsec = htonl(now_us % 1000000);
+        if (send(sock, buffer, size, 0) == (int)size) {
+            run.bytes += size;
+            run.packets++;
+            id++;
+            next_us += interval_us;
+        } else if (errno == ENOMEM) {
+            // lwIP is out of buffers, the link is the limit
+            vTaskDelay(1);
+        } else {
+            error = fmt::format("send failed: {}", strerror(errno));
+            close(sock);
+            return false;
+        }
+        now_us = esp_timer_get_time();
+    }
+    run.mbps = to_mbps(run.bytes, now_us - start_us);
+
+    header->id = htonl(-id);
+    for (int i = 0; i < _udp_fin_count; i++) {
+        send(sock, buffer, size, 0);
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    close(sock);
+    return true;
+}
+
+static bool run_udp_rx(const hal::HalBase::WifiBenchmarkConfig_t& config, uint8_t* buffer, size_t size,
+                       hal::HalBase::WifiBenchmarkRun_t& run, std::string& error)
+{
+    int sock = bind_to(config.port, SOCK_DGRAM, error);
+    if (sock < 0) {
+        return false;
+    }
+    mclog::tagInfo(_tag, "waiting for iperf -c -u on port {}", config.port);
+    set_timeout(sock, SO_RCVTIMEO, 1000);
+
+    int64_t duration_us = (int64_t)config.durationSec * 1000000;
+    int64_t wait_us     = esp_timer_get_time();
+    int64_t start_us    = 0;
+    int64_t last_us     = 0;
+    int32_t max_id      = -1;
+    while (true) {
+        int ret        = recv(sock, buffer, size, 0);
+        int64_t now_us = esp_timer_get_time();
+        if (ret >= (int)sizeof(IperfUdpHeader_t)) {
+            int32_t id = ntohl(((IperfUdpHeader_t*)buffer)->id);
+            // The client is done
+            if (id < 0) {
+                break;
+            }
+            if (start_us == 0) {
+                start_us = now_us;
+            }
+            last_us = now_us;
+            run.bytes += ret;
+            run.packets++;
+            max_id = std::max(max_id, id);
+        }
+        if (start_us == 0 ? now_us - wait_us >= (int64_t)_peer_timeout_ms * 1000 : now_us - start_us >= duration_us) {
+            break;
+        }
+    }
+    close(sock);
+    if (start_us == 0) {
+        error = fmt::format("no datagrams in {} s", _peer_timeout_ms / 1000);
+        return false;
+    }
+    run.lost = max_id + 1 > (int32_t)run.packets ? max_id + 1 - run.packets : 0;
+    run.mbps = to_mbps(run.bytes, last_us - start_us);
+    return true;
+}
+
+static bool run_wifi_benchmark(const hal::HalBase::WifiBenchmarkConfig_t& config,
+                               hal::HalBase::WifiBenchmarkResult_t& result)
+{
+    using Mode  = hal::HalBase::WifiBenchmarkMode_t;
+    bool is_tcp = config.mode == Mode::WIFI_BENCHMARK_TCP_TX || config.mode == Mode::WIFI_BENCHMARK_TCP_RX;
+    bool is_tx  = config.mode == Mode::WIFI_BENCHMARK_TCP_TX || config.mode == Mode::WIFI_BENCHMARK_UDP_TX;
+    size_t size = config.blockSize > 0 ? config.blockSize : (is_tcp ? _tcp_block_size : _udp_block_size);
+    if (config.durationSec == 0 || (!is_tcp && size < sizeof(IperfUdpHeader_t))) {
+        result.error = "invalid config";
+        return false;
+    }
+    // The peer would have to start again for every run
+    if (config.isDriveSweep && !is_tx) {
+        result.error = "drive sweep needs a TX mode";
+        return false;
+    }
+
+    auto buffer = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (buffer == nullptr) {
+        result.error = "out of memory";
+        return false;
+    }
+    memset(buffer, 0x5A, size);
+
+    auto hal            = GetHAL();
+    uint8_t saved_drive = hal->getWifiLinkDrive();
+    uint8_t first       = config.isDriveSweep ? 0 : saved_drive;
+    uint8_t last        = config.isDriveSweep ? GPIO_DRIVE_CAP_MAX - 1 : saved_drive;
+    bool is_ok          = true;
+    for (uint8_t drive = first; drive <= last && is_ok; drive++) {
+        if (config.isDriveSweep) {
+            hal->setWifiLinkDrive(drive);
+            vTaskDelay(pdMS_TO_TICKS(_drive_settle_ms));
+        }
+
+        hal::HalBase::WifiBenchmarkRun_t run;
+        run.drive = drive;
+        switch (config.mode) {
+            case hal::HalBase::WIFI_BENCHMARK_TCP_TX:
+                is_ok = run_tcp_tx(config, buffer, size, run, result.error);
+                break;
+            case hal::HalBase::WIFI_BENCHMARK_TCP_RX:
+                is_ok = run_tcp_rx(config, buffer, size, run, result.error);
+                break;
+            case hal::HalBase::WIFI_BENCHMARK_UDP_TX:
+                is_ok = run_udp_tx(config, buffer, size, run, result.error);
+                break;
+            case hal::HalBase::WIFI_BENCHMARK_UDP_RX:
+                is_ok = run_udp_rx(config, buffer, size, run, result.error);
+                break;
+        }
+        if (is_ok) {
+            mclog::tagInfo(_tag, "drive {}: {:.2f} Mbit/s, {} bytes, {} of {} datagrams lost", run.drive, run.mbps,
+                           run.bytes, run.lost, run.packets);
+            result.runs.push_back(run);
+        }
+    }
+    heap_caps_free(buffer);
+
+    // A sweep leaves the fastest level set, a failed one goes back to the level before
+    if (config.isDriveSweep) {
+        auto best = std::max_element(
+            result.runs.begin(), result.runs.end(),
+            [](const hal::HalBase::WifiBenchmarkRun_t& a, const hal::HalBase::WifiBenchmarkRun_t& b) {
+                return a.mbps < b.mbps;
+            });
+        hal->setWifiLinkDrive(is_ok && best != result.runs.end() ? best->drive : saved_drive);
+    }
+    return is_ok;
+}
+
+static void wifi_benchmark_job()
+{
+    hal::HalBase::WifiBenchmarkConfig_t config;
+    {
+        std::lock_guard<std::mutex> lock(_wifi_bench_data.mutex);
+        config = _wifi_bench_data.config;
+    }
+
+    hal::HalBase::WifiBenchmarkResult_t result;
+    result.sdioClockKhz = CONFIG_ESP_HOSTED_SDIO_CLOCK_FREQ_KHZ;
+    result.sdioBusWidth = CONFIG_ESP_HOSTED_SDIO_BUS_WIDTH;
+    result.sdioTxQueue  = CONFIG_ESP_HOSTED_SDIO_TX_Q_SIZE;
+    result.sdioRxQueue  = CONFIG_ESP_HOSTED_SDIO_RX_Q_SIZE;
+    result.rssi         = GetHAL()->getWifiStatus().rssi;
+
+    GetHAL()->claimPerfLevel("wifi_bench", hal::HalBase::PERF_LEVEL_MAX);
+    GetHAL()->claimRadioLevel("wifi_bench", hal::HalBase::RADIO_LEVEL_AWAKE);
+    bool is_ok = run_wifi_benchmark(config, result);
+    GetHAL()->releaseRadioLevel("wifi_bench");
+    GetHAL()->releasePerfLevel("wifi_bench");
+
+    if (is_ok) {
+        result.state = hal::HalBase::WIFI_BENCHMARK_DONE;
+        mclog::tagInfo(_tag, "done, sdio {} kHz x{}, queues {}/{}, rssi {}", result.sdioClockKhz,
+                       result.sdioBusWidth, result.sdioTxQueue, result.sdioRxQueue, result.rssi);
+    } else {
+        result.state = hal::HalBase::WIFI_BENCHMARK_FAILED;
+        mclog::tagError(_tag, "failed: {}", result.error);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_wifi_bench_data.mutex);
+        _wifi_bench_data.result = result;
+    }
+}
+
+bool HalEsp32::startWifiBenchmark(const WifiBenchmarkConfig_t& config)
+{
+    std::lock_guard<std::mutex> lock(_wifi_bench_data.mutex);
+    if (_wifi_bench_data.result.state == WIFI_BENCHMARK_RUNNING) {
+        return false;
+    }
+    _wifi_bench_data.config       = config;
+    _wifi_bench_data.result       = WifiBenchmarkResult_t();
+    _wifi_bench_data.result.state = WIFI_BENCHMARK_RUNNING;
+    if (!submitJob(wifi_benchmark_job)) {
+        mclog::tagError(_tag, "submit job failed");
+        _wifi_bench_data.result.state = WIFI_BENCHMARK_FAILED;
+        _wifi_bench_data.result.error = "submit job failed";
+        return false;
+    }
+    return true;
+}
+
+hal::HalBase::WifiBenchmarkResult_t HalEsp32::getWifiBenchmarkResult()
+{
+    std::lock_guard<std::mutex> lock(_wifi_bench_data.mutex);
+    return _wifi_bench_data.result;
+}
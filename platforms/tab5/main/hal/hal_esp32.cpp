@@ -19,6 +19,9 @@ extern "C" {
 // ESP-IDFのタイマー機能 (高精度タイマー) を使用するためのヘッダーファイルをインクルードします。
 #include <esp_timer.h>
 
+// 起動完了フラグに使用します。
+#include <atomic>
+
 // FreeRTOSの基本機能とタスク管理機能を使用するためのヘッダーファイルをインクルードします。
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
@@ -31,47 +34,47 @@ extern "C" {
 // (このファイルでは直接使用されていませんが、プロジェクト全体で関連する可能性があります)
 #include <lv_demos.h>
 
-// BSP内部で定義されているLCDタッチハンドラへの外部参照です。
-// これを通じてタッチ入力データを取得します。
-extern esp_lcd_touch_handle_t _lcd_touch_handle;
+// LVGLポートの画像/グリフキャッシュ統計を取得するためのヘッダーです。
+#include <esp_lvgl_port_cache.h>
+// LVGLポートのメモリアロケータ統計を取得するためのヘッダーです。
+#include <esp_lvgl_port_mem.h>
+
+// 起動ステージを依存関係グラフとして並列に実行するユーティリティです。
+#include "utils/boot_graph/boot_graph.h"
+
+// ホットパス用に、書式化を低優先度タスクに後回しにするログです。
+#include "utils/deferred_log/deferred_log.h"
+
+// 各サブシステムの区間をコアごとのリングに記録するイベントトレースです。
+#include "utils/event_trace/event_trace.h"
 
 // このモジュール用のログ出力に使用するタグ文字列を定義します。
 static const std::string _tag = "hal";
 
-// LVGLの入力デバイス (タッチパッド) の読み取りコールバック関数です。
-// LVGLは定期的にこの関数を呼び出し、タッチの状態と座標を取得します。
-static void lvgl_read_cb(lv_indev_t* indev, lv_indev_data_t* data)
-{
-    // タッチハンドラが無効な場合は、リリース状態としてLVGLに通知します。
-    if (_lcd_touch_handle == NULL) {
-        data->state = LV_INDEV_STATE_REL;
-        return;
-    }
-
-    // タッチ座標、強度、タッチポイント数を格納する変数を宣言します。
-    uint16_t touch_x[1];
-    uint16_t touch_y[1];
-    uint16_t touch_strength[1];
-    uint8_t touch_cnt = 0;
+// 起動ステージのグラフです。init() から戻った後もステージのタスクが参照するため、静的に保持します。
+static BootGraph _boot_graph;
 
-    // LCDタッチコントローラから最新のタッチデータを読み取ります。
-    esp_lcd_touch_read_data(_lcd_touch_handle);
+// すべての起動ステージと最後の後処理が終わると true になります。
+static std::atomic<bool> _is_boot_done = false;
 
-    // 読み取ったデータから、タッチ座標、強度、タッチポイント数を取得します。
-    // touchpad_pressed はタッチされているかどうかを示します。
-    bool touchpad_pressed =
-        esp_lcd_touch_get_coordinates(_lcd_touch_handle, touch_x, touch_y, touch_strength, &touch_cnt, 1);
-    // mclog::tagInfo(_tag, "touchpad pressed: {}", touchpad_pressed); // デバッグ用のログ出力 (コメントアウトされています)
+// LVGLロックの統計とUIコマンドキューです。(hal_lvgl_lock.cpp で実装)
+void lvgl_lock_on_acquire(const char* site, int64_t waitUs);
+void lvgl_lock_on_release();
+void lvgl_ui_commands_run();
 
-    // タッチされていない場合は、LVGLにリリース状態 (LV_INDEV_STATE_REL) を通知します。
-    if (!touchpad_pressed) {
-        data->state = LV_INDEV_STATE_REL;
+// lv_timer_handler() の前後でLVGLタスクから呼ばれます。イベントトレースとストール監視に区間を渡します。
+// LVGLタスクはポートの中で直接ロックを取るため、ロック統計への記録と積まれたUIコマンドの実行もここで行います。
+static void on_lvgl_timer_handler(bool isBegin)
+{
+    if (isBegin) {
+        TRACE_BEGIN("lv_timer_handler");
+        GetHAL()->markUiSection(hal::HalBase::UI_SECTION_LVGL_TIMER, true);
+        lvgl_lock_on_acquire("lv_timer_handler", -1); // 待ち時間はポートの中なので計測できません
+        lvgl_ui_commands_run();
     } else {
-        // タッチされている場合は、LVGLにプレス状態 (LV_INDEV_STATE_PR) を通知し、
-        // 取得したタッチ座標 (touch_x[0], touch_y[0]) をLVGLに渡します。
-        data->state   = LV_INDEV_STATE_PR;
-        data->point.x = touch_x[0];
-        data->point.y = touch_y[0];
+        lvgl_lock_on_release();
+        GetHAL()->markUiSection(hal::HalBase::UI_SECTION_LVGL_TIMER, false);
+        TRACE_END("lv_timer_handler");
     }
 }
 
@@ -80,96 +83,219 @@ void HalEsp32::init()
 {
     mclog::tagInfo(_tag, "init"); // 初期化開始のログ出力
 
-    mclog::tagInfo(_tag, "camera init"); // カメラ初期化開始のログ出力
-    bsp_cam_osc_init(); // カメラモジュール用のオシレータを初期化します。
-
-    mclog::tagInfo(_tag, "i2c init"); // I2C初期化開始のログ出力
-    bsp_i2c_init(); // 内部I2Cバスを初期化します。
-
-    mclog::tagInfo(_tag, "io expander init"); // IOエキスパンダ初期化開始のログ出力
-    i2c_master_bus_handle_t i2c_bus_handle = bsp_i2c_get_handle(); // 初期化済みのI2Cバスハンドルを取得します。
-    bsp_io_expander_pi4ioe_init(i2c_bus_handle); // PI4IOE5V9539 IOエキスパンダを初期化します。
-
-    // 充電ICのQuick Charge機能を有効にし、少し遅延を入れます。
-    setChargeQcEnable(true);
-    delay(50);
-    // 充電機能を有効にします。(コメントアウトされている行は、開発中に充電を無効にするためのものかもしれません)
-    setChargeEnable(true);
-    // setChargeEnable(false);
-
-    mclog::tagInfo(_tag, "i2c scan"); // I2Cバススキャン開始のログ出力
-    bsp_i2c_scan(); // 接続されているI2Cデバイスをスキャンし、ログに出力します。
-
-    mclog::tagInfo(_tag, "codec init"); // オーディオコーデック初期化開始のログ出力
-    delay(200); // コーデックの安定化のために少し遅延を入れます。
-    bsp_codec_init(); // オーディオコーデック (ES8311) を初期化します。
-
-    mclog::tagInfo(_tag, "imu init"); // IMU初期化開始のログ出力
-    imu_init(); // IMU (慣性計測ユニット、例: BMI270) を初期化します。
-
-    mclog::tagInfo(_tag, "ina226 init"); // INA226電流センサー初期化開始のログ出力
-    // INA226をI2Cバスハンドルとアドレス(0x41)を指定して初期化します。
-    ina226.begin(i2c_bus_handle, 0x41);
-    // INA226の動作モードを設定します (平均化回数、バス電圧変換時間、シャント電圧変換時間、動作モード)。
-    ina226.configure(INA226_AVERAGES_16, INA226_BUS_CONV_TIME_1100US, INA226_SHUNT_CONV_TIME_1100US,
-                     INA226_MODE_SHUNT_BUS_CONT);
-    // INA226をキャリブレーションします (シャント抵抗値[Ohm], 最大期待電流[A])。
-    ina226.calibrate(0.005, 8.192);
-    mclog::tagInfo(_tag, "bus voltage: {}", ina226.readBusVoltage()); // バス電圧を読み取りログに出力します。
-
-    mclog::tagInfo(_tag, "rx8130 init"); // RX8130 RTC初期化開始のログ出力
-    // RX8130をI2Cバスハンドルとアドレス(0x32)を指定して初期化します。
-    rx8130.begin(i2c_bus_handle, 0x32);
-    rx8130.initBat(); // RTCのバックアップバッテリー関連の初期化を行います。
-    clearRtcIrq();    // RTCの割り込みフラグをクリアします。
-    update_system_time(); // システム時刻をRTCから読み出して更新します。
-
-    mclog::tagInfo(_tag, "display init"); // ディスプレイ初期化開始のログ出力
-    bsp_reset_tp(); // タッチパネルをリセットします。
-
-    // ディスプレイ設定構造体を準備します。
-    bsp_display_cfg_t cfg = {.lvgl_port_cfg = ESP_LVGL_PORT_INIT_CONFIG(), // LVGLポートのデフォルト設定を使用します。
-                             .buffer_size   = BSP_LCD_H_RES * BSP_LCD_V_RES, // フレームバッファサイズ (フルスクリーン)。
-                             .double_buffer = true, // ダブルバッファリングを有効にします。
-                             .flags         = {
+    // 計測サイクルのRTC起床なら、ディスプレイを立ち上げずに計測して電源を切ります。その場合はここから戻りません。
+    duty_cycle_wake();
+
+    mclog::tagInfo(_tag, "power policy init"); // 電源ポリシー初期化開始のログ出力
+    power_policy_init(); // DFSとライトスリープを設定します。以降の初期化は要求されたレベルで動作します。
+
+#if CONFIG_HAL_PROFILER_AT_BOOT
+    mclog::tagInfo(_tag, "profiler init"); // プロファイラ開始のログ出力
+    // 起動の段階から両コアのPCをサンプリングします。ダンプは /api/profile か exportProfile() で取り出します。
+    startProfiler(ProfilerConfig_t());
+#endif
+
+    mclog::tagInfo(_tag, "binary log init"); // バイナリログ開始のログ出力
+    // 起動直後からログをPSRAMのリングに貯めます。SDカードがマウントされると /sd/logs へ書き出されます。
+    startBinaryLog(BinaryLogConfig_t());
+    // ホットパスのログは引数のままリングに積み、低優先度のタスクで書式化してから上のログに渡します。
+    DeferredLog::start();
+
+    // 以降の初期化は依存関係グラフとして登録し、依存先が終わったステージから並列のタスクで実行します。
+    // ディスプレイの依存は最小限にし、最初のフレームまでの時間を短くします。
+    // 各ステージの開始時刻と所要時間は最後のステージが終わったときにログに出力されます。
+    BootGraph& boot = _boot_graph;
+
+    boot.addStage("i2c", {}, []() {
+        mclog::tagInfo(_tag, "i2c init"); // I2C初期化開始のログ出力
+        bsp_i2c_init(); // 内部I2Cバスを初期化します。
+    });
+
+    // 保存された輝度・音量・充電・アンテナの設定をNVSからまとめて読み出します。ハードウェアへの反映は各ステージで行います。
+    boot.addStage("settings", {}, [this]() {
+        mclog::tagInfo(_tag, "settings init"); // 設定読み出し開始のログ出力
+        settings_init();
+    });
+
+    boot.addStage("io_expander", {"i2c"}, []() {
+        mclog::tagInfo(_tag, "io expander init"); // IOエキスパンダ初期化開始のログ出力
+        // PI4IOE5V9539 IOエキスパンダを初期化します。LCD・タッチのリセット線やスピーカー、USB 5Vの出力もここで決まります。
+        bsp_io_expander_pi4ioe_init(bsp_i2c_get_handle());
+    });
+
+    // ディスプレイは最優先です。LCD・タッチのリセットはIOエキスパンダ経由なので、それだけを待ちます。
+    // カメラのオシレータはカメラを開くときに claimPeripheral() で立ち上げます。
+    boot.addStage(
+        "display", {"io_expander", "settings"},
+        [this]() {
+            mclog::tagInfo(_tag, "display init"); // ディスプレイ初期化開始のログ出力
+            bsp_reset_tp(); // タッチパネルをリセットします。
+
+            // ディスプレイ設定構造体を準備します。
+            bsp_display_cfg_t cfg = {
+                .lvgl_port_cfg = ESP_LVGL_PORT_INIT_CONFIG(),   // LVGLポートのデフォルト設定を使用します。
+                .buffer_size   = BSP_LCD_H_RES * BSP_LCD_V_RES, // フレームバッファサイズ (フルスクリーン)。
+                .double_buffer = true,                          // ダブルバッファリングを有効にします。
+                .flags         = {
 #if CONFIG_BSP_LCD_COLOR_FORMAT_RGB888 // RGB888カラーフォーマットの場合
-                                 .buff_dma = false, // DMA転送を無効 (RGB888ではCPUコピーが速い場合がある)
+                    .buff_dma = false, // DMA転送を無効 (RGB888ではCPUコピーが速い場合がある)
 #else // RGB565などの場合
-                                 .buff_dma = true,  // DMA転送を有効
+                    .buff_dma = true,  // DMA転送を有効
+#endif
+                    .buff_spiram = true, // フレームバッファをSPIRAMに配置します。
+                    .sw_rotate   = true, // ソフトウェアによる画面回転を有効にします。
+                },
+                // パネルの最初のフレームを白で埋めます。起動アニメーションの最初のフレームと同じ色なので、
+                // 残りのステージが終わってLVGLが描画を始めるまでの間も画面は点灯したまま切り替わりが見えません。
+                .panel = {
+                    .splash       = true,
+                    .splash_color = 0xFFFF,
+                }};
+            // 上記設定でディスプレイを開始し、LVGLディスプレイハンドルを取得します。
+            lvDisp = bsp_display_start_with_config(&cfg);
+            // 保存された回転を設定します。既定は90度 (横向き) です。回転はPPAがパネルへの転送で行います。
+            lv_display_set_rotation(lvDisp, (lv_display_rotation_t)_display_rotation);
+            // LVGLタスクの各周期の前後にフックを入れます。トレースも監視も止まっている間は何もしません。
+            lvgl_port_set_timer_hook(on_lvgl_timer_handler);
+            // ディスプレイのバックライトを保存された輝度でオンにします。
+            setDisplayBrightness(_current_lcd_brightness);
+            claimPerfLevel("display", PERF_LEVEL_AWAKE); // 表示中はライトスリープを禁止します
+        },
+        8192);
+
+    boot.addStage("charger", {"io_expander", "settings"}, [this]() {
+        // 充電ICのQuick Charge機能を保存された設定にし、少し遅延を入れます。
+        // 出力はシャドウレジスタ経由なので、初期値と同じ設定はバスに出ません。
+        setChargeQcEnable(_charge_qc_enable);
+        // 外部アンテナも同じIOエキスパンダの出力なので、ここで保存された設定に戻します。
+        setExtAntennaEnable(_ext_antenna_enable);
+        delay(50);
+        // 充電機能を有効にします。(コメントアウトされている行は、開発中に充電を無効にするためのものかもしれません)
+        setChargeEnable(true);
+        // setChargeEnable(false);
+    });
+
+    boot.addStage("codec", {"io_expander", "settings"}, [this]() {
+        mclog::tagInfo(_tag, "codec init"); // オーディオコーデック初期化開始のログ出力
+        delay(200); // コーデックの安定化のために少し遅延を入れます。この待ちは他のステージと重なります。
+        apply_audio_dma_profile(); // I2Sチャンネルの作成前に、保存されたDMAバッファ構成を渡します。
+        bsp_codec_init(); // オーディオコーデック (ES8311) を初期化します。
+    });
+
+    boot.addStage("imu", {"i2c"}, [this]() {
+        mclog::tagInfo(_tag, "imu init"); // IMU初期化開始のログ出力
+        imu_init(); // IMU (慣性計測ユニット、BMI270 または ICM20602) を検出して初期化します。
+    });
+
+    // 自動回転はIMUの重力方向で画面を回します。固定の回転が保存されている場合は開始しません。
+    boot.addStage("auto_rotate", {"display", "imu"}, [this]() {
+        if (!_auto_rotate) {
+            return;
+        }
+        mclog::tagInfo(_tag, "auto rotate init"); // 自動回転開始のログ出力
+        AutoRotateConfig_t config;
+        config.rotationMask = _auto_rotate_mask;
+        startAutoRotate(config);
+    });
+
+    boot.addStage("ina226", {"i2c"}, [this]() {
+        mclog::tagInfo(_tag, "ina226 init"); // INA226電流センサー初期化開始のログ出力
+        // INA226をI2Cバスハンドルとアドレス(0x41)を指定して初期化します。
+        ina226.begin(bsp_i2c_get_handle(), 0x41);
+        // INA226の動作モードを設定します (平均化回数、バス電圧変換時間、シャント電圧変換時間、動作モード)。
+        ina226.configure(INA226_AVERAGES_16, INA226_BUS_CONV_TIME_1100US, INA226_SHUNT_CONV_TIME_1100US,
+                         INA226_MODE_SHUNT_BUS_CONT);
+        // INA226をキャリブレーションします (シャント抵抗値[Ohm], 最大期待電流[A])。
+        ina226.calibrate(0.005, 8.192);
+        mclog::tagInfo(_tag, "bus voltage: {}", ina226.readBusVoltage()); // バス電圧を読み取りログに出力します。
+    });
+
+    boot.addStage("rtc", {"i2c"}, [this]() {
+        mclog::tagInfo(_tag, "rx8130 init"); // RX8130 RTC初期化開始のログ出力
+        // RX8130をI2Cバスハンドルとアドレス(0x32)を指定して初期化します。
+        rx8130.begin(bsp_i2c_get_handle(), 0x32);
+        rx8130.initBat(); // RTCのバックアップバッテリー関連の初期化を行います。
+        clearRtcIrq();    // RTCの割り込みフラグをクリアします。
+        update_system_time(); // システム時刻をRTCから読み出して更新します。
+    });
+
+    // I2Cバススキャンは診断用のログだけなので、最初のフレームの後に回します。
+    boot.addStage("i2c_scan", {"display"}, []() {
+        mclog::tagInfo(_tag, "i2c scan"); // I2Cバススキャン開始のログ出力
+        bsp_i2c_scan(); // 接続されているI2Cデバイスをスキャンし、ログに出力します。
+    });
+
+    boot.addStage("touch", {"display"}, [this]() {
+        // LVGL用のタッチパッド入力デバイスを作成します。
+        // タッチ割り込みで起床するタスクが最大5点を読み出し、リング経由でLVGLの入力デバイスに渡します。
+        mclog::tagInfo(_tag, "touch init");
+        touch_init();
+    });
+
+#if CONFIG_HAL_EVENT_TRACE_AT_BOOT
+    // LVGLのフックを入れるためディスプレイを待ってからイベントトレースを開始します。
+    // トレースは /api/trace か exportEventTrace() で取り出し、Perfettoで開きます。
+    boot.addStage("event_trace", {"display"}, [this]() {
+        mclog::tagInfo(_tag, "event trace init"); // イベントトレース開始のログ出力
+        startEventTrace(EventTraceConfig_t());
+    });
+#endif
+
+#if CONFIG_HAL_USB_HOST_AT_BOOT
+    // USBホストとHID・USBメモリのドライバーを立ち上げます。HIDはLVGLの入力デバイスを作るためディスプレイを待ちます。
+    // 無効にした構成では、最初に claimPeripheral(PERIPHERAL_USB_HOST) したときに立ち上がります。
+    boot.addStage("usb_host", {"io_expander", "display"}, [this]() {
+        mclog::tagInfo(_tag, "usb host init"); // USBホスト初期化開始のログ出力
+        claimPeripheral(PERIPHERAL_USB_HOST, "boot");
+    });
+#endif
+
+    // 効果音や音楽はアセットパーティションにあります。マップするだけなので依存はありません。
+    boot.addStage("asset_pack", {}, [this]() {
+        mclog::tagInfo(_tag, "asset pack init"); // アセットパック初期化開始のログ出力
+        asset_pack_init(); // インデックスを検証し、パックをメモリマップします。
+    });
+
+    boot.addStage("sd_card", {}, [this]() {
+        mclog::tagInfo(_tag, "sd card init"); // SDカード初期化開始のログ出力
+        sd_card_init(); // SDカードを常駐マウントし、挿抜を監視するタスクを開始します。
+    });
+
+    // USB-Aの検出はHIDとUSBメモリの状態から取るため、起動時に立ち上げる構成ではUSBホストを待ちます。
+#if CONFIG_HAL_USB_HOST_AT_BOOT
+    std::vector<std::string> port_state_deps = {"io_expander", "usb_host"};
+#else
+    std::vector<std::string> port_state_deps = {"io_expander"};
 #endif
-                                 .buff_spiram = true, // フレームバッファをSPIRAMに配置します。
-                                 .sw_rotate   = true,   // ソフトウェアによる画面回転を有効にします。
-                             }};
-    // 上記設定でディスプレイを開始し、LVGLディスプレイハンドルを取得します。
-    lvDisp = bsp_display_start_with_config(&cfg);
-    // ディスプレイの回転を90度に設定します (縦向き)。
-    lv_display_set_rotation(lvDisp, LV_DISPLAY_ROTATION_90);
-    // ディスプレイのバックライトをオンにします。
-    bsp_display_backlight_on();
-
-    // LVGL用のタッチパッド入力デバイスを作成します。
-    mclog::tagInfo(_tag, "create lvgl touchpad indev");
-    lvTouchpad = lv_indev_create(); // LVGL入力デバイスを作成
-    lv_indev_set_type(lvTouchpad, LV_INDEV_TYPE_POINTER); // タイプをポインティングデバイスに設定
-    lv_indev_set_read_cb(lvTouchpad, lvgl_read_cb); // 読み取りコールバック関数を登録
-    lv_indev_set_display(lvTouchpad, lvDisp); // 関連付けるディスプレイを設定
-
-    mclog::tagInfo(_tag, "usb host init"); // USBホスト初期化開始のログ出力
-    // USBホスト機能を初期化します。電源モードと自動ファームウェアロードを設定します。
-    bsp_usb_host_start(BSP_USB_HOST_POWER_MODE_USB_DEV, true);
-
-    mclog::tagInfo(_tag, "hid init"); // HID初期化開始のログ出力
-    hid_init(); // USB HID (キーボード、マウスなど) の処理を初期化します。
-
-    mclog::tagInfo(_tag, "rs485 init"); // RS485初期化開始のログ出力
-    rs485_init(); // RS485通信インターフェースを初期化します。
-
-    mclog::tagInfo(_tag, "set gpio output capability"); // GPIO出力能力設定開始のログ出力
-    set_gpio_output_capability(); // 特定GPIOピンの駆動能力を設定します。
+    boot.addStage("port_state", port_state_deps, [this]() {
+        mclog::tagInfo(_tag, "port state init"); // ポート状態サービス開始のログ出力
+        port_state_init(); // USB-C・USB-A・ヘッドフォンの接続状態を監視し、変化をイベントで通知します。
+    });
+
+    boot.start([this]() {
+        // 駆動能力の設定は各ペリフェラルがピンを設定し終えた後でないと上書きされるため、最後に行います。
+        mclog::tagInfo(_tag, "set gpio output capability"); // GPIO出力能力設定開始のログ出力
+        set_gpio_output_capability(); // 特定GPIOピンの駆動能力を設定します。
+        releasePerfLevel("boot"); // 起動中に保持していた最大性能の要求を解放します。
+        _is_boot_done = true;
+        mclog::tagInfo(_tag, "boot done");
+        ota_confirm_boot(); // 更新後の初回起動なら、起動完了をもって新しいイメージを確定します。
+        startDiagnostics(); // スタックとヒープの計測を開始します。
+    });
+
+    // 画面とタッチが使えるようになった時点で戻ります。残りのステージは起動アニメーションの裏で続きます。
+    // アプリ層は isBootDone() を見て、ハードウェアを使うアプリをすべて終わってから開きます。
+    boot.wait("touch");
 
     bsp_display_unlock(); // ディスプレイのロックを解除します (LVGLの準備ができたことを示す)。
 }
 
+// すべての起動ステージが終わったかどうかを返します。
+bool HalEsp32::isBootDone()
+{
+    return _is_boot_done;
+}
+
 // 駆動能力を調整するGPIOピンのリストです。
 // これらのピンは、特定のペリフェラルや外部コンポーネントを駆動するために、
 // 標準よりも低い駆動能力(GPIO_DRIVE_CAP_0)に設定されることがあります。
@@ -178,14 +304,7 @@ static const gpio_num_t _driver_gpios[] = {
     // 外部I2C (Port A)
     GPIO_NUM_0,
     GPIO_NUM_1,
-    // ESP-Hosted (ESP32C6 Wi-Fiコプロセッサとの通信用)
-    GPIO_NUM_8,
-    GPIO_NUM_9,
-    GPIO_NUM_10,
-    GPIO_NUM_11,
-    GPIO_NUM_12,
-    GPIO_NUM_13,
-    GPIO_NUM_15,
+    // ESP-Hosted (ESP32C6 Wi-Fiコプロセッサとの通信用) のピンは apply_wifi_link_drive() が設定します。
     // ディスプレイインターフェース
     GPIO_NUM_22,
     GPIO_NUM_23,
@@ -222,14 +341,13 @@ void HalEsp32::set_gpio_output_capability()
             printf("Failed to set GPIO %d drive capability: %s\n", gpio, esp_err_to_name(ret));
         }
     }
+    // SDIO接続ピンは設定ストアに保存された駆動能力にします。(既定は GPIO_DRIVE_CAP_0)
+    apply_wifi_link_drive();
 }
 
 /* -------------------------------------------------------------------------- */
 /*                                   System                                   */
 /* -------------------------------------------------------------------------- */
-#include <driver/temperature_sensor.h> // ESP32内蔵温度センサー用ドライバ
-static temperature_sensor_handle_t _temp_sensor = nullptr; // 温度センサーハンドラ
-
 // 指定されたミリ秒数だけ現在のタスクを遅延させます。
 void HalEsp32::delay(uint32_t ms)
 {
@@ -242,24 +360,7 @@ uint32_t HalEsp32::millis()
     return esp_timer_get_time() / 1000; // ESP-IDFの高精度タイマーの値 (マイクロ秒単位) を1000で割ってミリ秒に変換。
 }
 
-// CPUの内部温度を摂氏で返します。
-int HalEsp32::getCpuTemp()
-{
-    // 温度センサーがまだ初期化されていない場合、初期化を行います。
-    if (_temp_sensor == nullptr) {
-        temperature_sensor_config_t temp_sensor_config = {
-            .range_min = 20, // 測定範囲の最小値 (この値はESP32のバージョンによって異なる場合がある)
-            .range_max = 100, // 測定範囲の最大値
-        };
-        temperature_sensor_install(&temp_sensor_config, &_temp_sensor); // 温度センサーをインストール
-        temperature_sensor_enable(_temp_sensor); // 温度センサーを有効化
-    }
-
-    float temp = 0;
-    temperature_sensor_get_celsius(_temp_sensor, &temp); // 温度を摂氏で取得
-
-    return temp; // 整数にキャストして返す (必要に応じて丸め処理を検討)
-}
+// int HalEsp32::getCpuTemp() override; // (hal_thermal.cpp で実装されている可能性が高い)
 
 /* -------------------------------------------------------------------------- */
 /*                                   Display                                  */
@@ -267,10 +368,13 @@ int HalEsp32::getCpuTemp()
 // ディスプレイのバックライト輝度を設定します (0-100%)。
 void HalEsp32::setDisplayBrightness(uint8_t brightness)
 {
-    // 明るさの値を0から100の範囲にクランプします。
-    _current_lcd_brightness = std::clamp((int)brightness, 0, 100);
-    mclog::tagInfo("hal", "set display brightness: {}%", _current_lcd_brightness);
-    bsp_display_brightness_set(_current_lcd_brightness); // BSP関数を呼び出して実際の輝度を設定
+    DeferredLog::debug(_tag, "set display brightness: {}%", brightness); // 操作のたびに呼ばれるため、書式化は後回しにします
+    // フェードなしで設定します。0から100の範囲へのクランプと、表示中のライトスリープ禁止もこの中で行います。
+    fadeDisplayBrightness(brightness, 0);
+    // 0 は画面を消すためのもので、次の起動で戻す輝度ではないので記録しません。
+    if (_current_lcd_brightness > 0) {
+        settingsStore().set("brightness", _current_lcd_brightness);
+    }
 }
 
 // 現在のディスプレイバックライト輝度を取得します。
@@ -281,15 +385,75 @@ uint8_t HalEsp32::getDisplayBrightness()
 
 // LVGL操作のためのロックを取得します (ミューテックスなどによる排他制御)。
 // マルチスレッド環境でLVGLの内部状態を保護するために使用します。
-void HalEsp32::lvglLock()
+// 待ち時間と保持時間は呼び出し元 (site) ごとにロック統計に記録されます。
+void HalEsp32::lvglLock(const char* site)
 {
-    lvgl_port_lock(0); // LVGLポート提供のロック関数を呼び出し
+    int64_t wait_start = esp_timer_get_time();
+    TRACE_BEGIN("lvgl lock wait"); // ロック待ちの時間をトレースに記録します
+    lvgl_port_lock(0);             // LVGLポート提供のロック関数を呼び出し
+    TRACE_END("lvgl lock wait");
+    lvgl_lock_on_acquire(site, esp_timer_get_time() - wait_start);
 }
 
 // LVGL操作のためのロックを解放します。
 void HalEsp32::lvglUnlock()
 {
-    lvgl_port_unlock(); // LVGLポート提供のアンロック関数を呼び出し
+    lvgl_lock_on_release(); // 一番外側のロックなら保持時間を記録します
+    lvgl_port_unlock();     // LVGLポート提供のアンロック関数を呼び出し
+}
+
+// LVGLポートのキャッシュ統計をHALの構造体に詰め替えて返します。
+hal::HalBase::LvglCacheStats_t HalEsp32::getLvglCacheStats()
+{
+    lvgl_port_cache_stats_t port_stats;
+    lvgl_port_cache_get_stats(&port_stats);
+
+    LvglCacheStats_t stats;
+    stats.imageHits    = port_stats.img_hits;
+    stats.imageMisses  = port_stats.img_misses;
+    stats.glyphHits    = port_stats.glyph_hits;
+    stats.glyphMisses  = port_stats.glyph_misses;
+    stats.glyphBytes   = port_stats.glyph_used;
+    stats.glyphEntries = port_stats.glyph_entries;
+    return stats;
+}
+
+// LVGLポートのメモリアロケータ統計をHALの構造体に詰め替えて返します。
+hal::HalBase::LvglMemStats_t HalEsp32::getLvglMemStats()
+{
+    lvgl_port_mem_stats_t port_stats;
+
+    LvglMemStats_t stats;
+    stats.supported     = lvgl_port_mem_get_stats(&port_stats);
+    stats.internalUsed  = port_stats.internal_used;
+    stats.internalPeak  = port_stats.internal_peak;
+    stats.internalCount = port_stats.internal_cnt;
+    stats.psramUsed     = port_stats.psram_used;
+    stats.psramPeak     = port_stats.psram_peak;
+    stats.psramCount    = port_stats.psram_cnt;
+    stats.fallbacks     = port_stats.fallbacks;
+    stats.failures      = port_stats.failures;
+    stats.layerBuffers  = port_stats.layer_bufs;
+    stats.layerHits     = port_stats.layer_hits;
+    stats.layerMisses   = port_stats.layer_misses;
+    return stats;
+}
+
+// LVGLポートの垂直同期統計をHALの構造体に詰め替えて返します。
+// 垂直同期でのバッファ切り替えが無効な場合は supported = false のままです。
+hal::HalBase::VsyncStats_t HalEsp32::getVsyncStats()
+{
+    VsyncStats_t stats;
+    lvgl_port_vsync_stats_t port_stats;
+    if (lvDisp == nullptr || lvgl_port_get_vsync_stats(lvDisp, &port_stats) != ESP_OK) {
+        return stats;
+    }
+
+    stats.supported    = true;
+    stats.vsyncs       = port_stats.vsync_count;
+    stats.frames       = port_stats.frame_count;
+    stats.missedVsyncs = port_stats.missed_count;
+    return stats;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -313,6 +477,7 @@ void HalEsp32::setRtcTime(tm time)
     delay(50); // 設定が反映されるのを待つために少し遅延
 
     update_system_time(); // システム時刻もRTCに合わせて更新
+    clock_service_request_resync(); // 壁時計サービスは秒の切り替わりで合わせ直し、ドリフトの測定をやり直します
 }
 
 // システム時刻をRTCから読み出して更新します。
@@ -330,86 +495,11 @@ void HalEsp32::update_system_time()
     settimeofday(&now, NULL); // システム時刻を設定 (Linux標準関数、ESP-IDFでも利用可能)
 }
 
-/* -------------------------------------------------------------------------- */
-/*                                   SD Card                                  */
-/* -------------------------------------------------------------------------- */
-#include <dirent.h> // ディレクトリ操作関数 (opendir, readdir, closedir) 用
-#include <sys/types.h> // DT_DIRなどの型定義用
-
-// SDカードがマウントされているかどうかを返します。
-// この実装では常にtrueを返していますが、実際にはbsp_sdcard_is_mounted()のような関数で状態を確認すべきです。
-// M5Tab5のBSPでは、bsp_sdcard_init()の成否で判断することが多いです。
-bool HalEsp32::isSdCardMounted()
-{
-    // return _sd_card_mounted; // 本来はこちらのように状態変数を見るべき
-    return true; // 現状の実装は常にtrue
-}
-
-// SDカードの指定されたディレクトリパス内のファイルとディレクトリのリストをスキャンして返します。
-std::vector<hal::HalBase::FileEntry_t> HalEsp32::scanSdCard(const std::string& dirPath)
-{
-    std::vector<hal::HalBase::FileEntry_t> file_entries; // 返却用のファイルエントリリスト
-
-    mclog::tagInfo(_tag, "init sd card");
-    // SDカードをマウントします。マウントポイントは "/sd"、CSピンは25 (これはハードウェアに依存)。
-    // M5Tab5のデフォルトのCSピンとは異なる可能性があるため、BSPの定義を確認することが重要です。
-    // この関数は呼び出しごとに初期化とデアロケーションを行うため、効率は良くありません。
-    // アプリケーション側で一度だけ初期化し、マウント状態を保持する方が望ましいです。
-    if (bsp_sdcard_init("/sd", 25) != ESP_OK) { // BSPのSDカード初期化関数
-        mclog::error("failed to mount sd card");
-        return file_entries; // マウント失敗時は空のリストを返す
-    }
-    _sd_card_mounted = true; // 状態変数を更新 (この関数内でのみ有効)
-
-    // スキャン対象のフルパスを作成します (例: "/sd/my_directory")。
-    std::string target_path = "/sd/" + dirPath;
-
-    DIR* dir = opendir(target_path.c_str()); // ディレクトリを開く
-    if (dir == nullptr) {
-        mclog::error("failed to open directory: {}", target_path);
-        bsp_sdcard_deinit("/sd"); // エラー時はSDカードをデアロケート
-        _sd_card_mounted = false;
-        return file_entries; // ディレクトリを開けなければ空のリストを返す
-    }
-
-    struct dirent* entry; // ディレクトリエントリ構造体へのポインタ
-    // readdir() でディレクトリ内のエントリを順に読み取ります。
-    while ((entry = readdir(dir)) != nullptr) {
-        // カレントディレクトリ (".") と親ディレクトリ ("..") はスキップします。
-        if (std::string(entry->d_name) == "." || std::string(entry->d_name) == "..") {
-            continue;
-        }
-
-        hal::HalBase::FileEntry_t file_entry; // HALで定義されたファイルエントリ構造体
-        file_entry.name  = entry->d_name; // ファイル名またはディレクトリ名
-        file_entry.isDir = (entry->d_type == DT_DIR); // エントリがディレクトリかどうかを判定
-        file_entries.push_back(file_entry); // リストに追加
-    }
-
-    closedir(dir); // 開いたディレクトリを閉じる
-
-    mclog::tagInfo(_tag, "deinit sd card");
-    bsp_sdcard_deinit("/sd"); // SDカードをデアロケート
-    _sd_card_mounted = false;
-
-    return file_entries; // スキャン結果のリストを返す
-}
-
 /* -------------------------------------------------------------------------- */
 /*                                  Interface                                 */
 /* -------------------------------------------------------------------------- */
-// USB Type-Cポートの接続状態を検出します。
-bool HalEsp32::usbCDetect()
-{
-    return bsp_usb_c_detect(); // BSPのUSB Type-C検出関数を呼び出し
-    // return false; // テスト用の固定値 (コメントアウト)
-}
-
-// ヘッドフォンジャックの接続状態を検出します。
-bool HalEsp32::headPhoneDetect()
-{
-    return bsp_headphone_detect(); // BSPのヘッドフォン検出関数を呼び出し
-}
+// bool HalEsp32::usbCDetect() override; // (hal_port_state.cpp で実装されている可能性が高い)
+// bool HalEsp32::headPhoneDetect() override; // (hal_port_state.cpp で実装されている可能性が高い)
 
 // I2Cバスをスキャンし、応答があったデバイスのアドレスリストを返します。
 // isInternalがtrueなら内部I2Cバス、falseなら外部I2Cバス (Port A) をスキャンします。
@@ -432,12 +522,19 @@ std::vector<uint8_t> HalEsp32::i2cScan(bool isInternal)
     // (ただし、一般的なスキャンは0x08から0x77まで行うことが多いです)
     for (int i = 16; i < 128; i += 16) { // 16アドレスごとにまとめて処理 (表示のためか？)
         for (int j = 0; j < 16; j++) {
-            fflush(stdout); // 標準出力をフラッシュ (printfなどの出力を即座に行うため)
             address = i + j;
             if (address >= 0x78) continue; // 0x78以上のアドレスはスキップ
             // 指定したアドレスのデバイスにプローブ (短い通信試行) を行います。
             // タイムアウトは50msに設定。
-            ret     = i2c_master_probe(i2c_bus_handle, address, 50);
+            // 内部バスでは1アドレスごとに診断クラスの順番を取り、スキャン中もタッチなどの読み出しを先に通します。
+            if (isInternal) {
+                i2cScheduler().run(I2cBusScheduler::PRIORITY_DIAGNOSTIC, address, [&]() {
+                    ret = i2c_master_probe(i2c_bus_handle, address, 50);
+                    return true;
+                });
+            } else {
+                ret = i2c_master_probe(i2c_bus_handle, address, 50);
+            }
             if (ret == ESP_OK) { // プローブ成功 (デバイスが応答した)
                 addrs.push_back(address); // アドレスをリストに追加
             }
@@ -446,6 +543,35 @@ std::vector<uint8_t> HalEsp32::i2cScan(bool isInternal)
     return addrs; // 発見したアドレスのリストを返す
 }
 
+// uint32_t HalEsp32::startI2cScan(bool isInternal) override; // (hal_i2c_scan.cpp で実装されている可能性が高い)
+// bool HalEsp32::getI2cScanProgress(I2cScanProgress_t& progress) override; // (hal_i2c_scan.cpp で実装されている可能性が高い)
+// void HalEsp32::cancelI2cScan() override; // (hal_i2c_scan.cpp で実装されている可能性が高い)
+
+// 内部I2Cバスのスケジューラを返します。初回呼び出し時に生成されます。
+I2cBusScheduler& HalEsp32::i2cScheduler()
+{
+    static I2cBusScheduler scheduler;
+    return scheduler;
+}
+
+// スケジューラが集計したデバイスごとの統計を、平均値を計算してHAL共通の形式に変換します。
+std::vector<hal::HalBase::I2cDeviceStats_t> HalEsp32::getI2cStats()
+{
+    std::vector<I2cDeviceStats_t> result;
+    for (const auto& stats : i2cScheduler().getStats()) {
+        I2cDeviceStats_t device;
+        device.address   = stats.address;
+        device.batches   = stats.batches;
+        device.errors    = stats.errors;
+        device.avgWaitUs = stats.batches ? stats.totalWaitUs / stats.batches : 0;
+        device.maxWaitUs = stats.maxWaitUs;
+        device.avgBusUs  = stats.batches ? stats.totalBusUs / stats.batches : 0;
+        device.maxBusUs  = stats.maxBusUs;
+        result.push_back(device);
+    }
+    return result;
+}
+
 // Port A (外部I2C) を初期化します。
 void HalEsp32::initPortAI2c()
 {
@@ -456,7 +582,11 @@ void HalEsp32::initPortAI2c()
 // Port A (外部I2C) を終了処理 (デアロケート) します。
 void HalEsp32::deinitPortAI2c()
 {
+    if (isKeypadRunning() || isExtSensorsRunning()) {
+        return; // キーパッドサービスか外部センサーのポーリングがバスを使用中なので、停止されるまで残します。
+    }
     mclog::tagInfo(_tag, "deinit port a i2c");
+    cancelI2cScan(); // スキャン中のタスクが削除後のバスハンドルを使わないように先に止めます。
     bsp_ext_i2c_deinit(); // BSPの外部I2C終了関数を呼び出し
 }
 
@@ -483,9 +613,105 @@ void HalEsp32::gpioReset(uint8_t pin)
 // これらは、アプリケーションの要求に応じて、または将来の拡張のために宣言されている可能性があります。
 // もしくは、他のファイル (例: hal_audio.cpp, hal_power.cpp など) で実装されているかもしれません。
 
+// bool HalEsp32::startGpioPattern(const GpioWaveformConfig_t& config, const std::vector<GpioWaveformStep_t>& steps) override; // (hal_gpio_waveform.cpp で実装されている可能性が高い)
+// bool HalEsp32::startGpioPwm(uint8_t pin, uint32_t frequencyHz, float duty) override; // (hal_gpio_waveform.cpp で実装されている可能性が高い)
+// void HalEsp32::stopGpioWaveform(uint8_t pin) override; // (hal_gpio_waveform.cpp で実装されている可能性が高い)
+// GpioWaveformStatus_t HalEsp32::getGpioWaveformStatus(uint8_t pin) override; // (hal_gpio_waveform.cpp で実装されている可能性が高い)
+// bool HalEsp32::startLogicCapture(const LogicCaptureConfig_t& config) override; // (hal_logic_capture.cpp で実装されている可能性が高い)
+// void HalEsp32::stopLogicCapture() override; // (hal_logic_capture.cpp で実装されている可能性が高い)
+// LogicCaptureStatus_t HalEsp32::getLogicCaptureStatus() override; // (hal_logic_capture.cpp で実装されている可能性が高い)
+// uint32_t HalEsp32::getLogicEnvelope(uint32_t windowSamples, std::vector<uint8_t>& min, std::vector<uint8_t>& max) override; // (hal_logic_capture.cpp で実装されている可能性が高い)
+// bool HalEsp32::startKeypad(const KeypadConfig_t& config) override; // (hal_keypad.cpp で実装されている可能性が高い)
+// void HalEsp32::stopKeypad() override; // (hal_keypad.cpp で実装されている可能性が高い)
+// bool HalEsp32::isKeypadRunning() override; // (hal_keypad.cpp で実装されている可能性が高い)
+// void HalEsp32::setKeypadRepeat(uint16_t delayMs, uint16_t intervalMs) override; // (hal_keypad.cpp で実装されている可能性が高い)
+// KeypadStats_t HalEsp32::getKeypadStats() override; // (hal_keypad.cpp で実装されている可能性が高い)
+// bool HalEsp32::startExtSensors() override; // (hal_ext_sensor.cpp で実装されている可能性が高い)
+// void HalEsp32::stopExtSensors() override; // (hal_ext_sensor.cpp で実装されている可能性が高い)
+// bool HalEsp32::isExtSensorsRunning() override; // (hal_ext_sensor.cpp で実装されている可能性が高い)
+// std::vector<ExtSensorInfo_t> HalEsp32::getExtSensors() override; // (hal_ext_sensor.cpp で実装されている可能性が高い)
+// bool HalEsp32::readExtSensor(size_t index, ExtSensorReading_t& reading, uint32_t* timeMs) override; // (hal_ext_sensor.cpp で実装されている可能性が高い)
+
 // void HalEsp32::updatePowerMonitorData() override; // (hal_power.cpp で実装されている可能性が高い)
+// bool HalEsp32::startPowerSampling(uint16_t averages) override; // (hal_power.cpp で実装されている可能性が高い)
+// void HalEsp32::stopPowerSampling() override; // (hal_power.cpp で実装されている可能性が高い)
+// bool HalEsp32::isPowerSampling() override; // (hal_power.cpp で実装されている可能性が高い)
+// size_t HalEsp32::readPowerSamples(PowerSample_t* samples, size_t maxCount) override; // (hal_power.cpp で実装されている可能性が高い)
+// PowerWindowStats_t HalEsp32::takePowerWindowStats() override; // (hal_power.cpp で実装されている可能性が高い)
+// float HalEsp32::getPowerEnergyMwh() override; // (hal_power.cpp で実装されている可能性が高い)
+// bool HalEsp32::startPowerProfile(const std::string& path) override; // (hal_power_profile.cpp で実装されている可能性が高い)
+// void HalEsp32::stopPowerProfile() override; // (hal_power_profile.cpp で実装されている可能性が高い)
+// bool HalEsp32::isPowerProfiling() override; // (hal_power_profile.cpp で実装されている可能性が高い)
+// void HalEsp32::setPowerProfileApp(const std::string& name) override; // (hal_power_profile.cpp で実装されている可能性が高い)
+// void HalEsp32::setPowerProfileWindow(const std::string& name) override; // (hal_power_profile.cpp で実装されている可能性が高い)
+// TouchState_t HalEsp32::getTouchState() override; // (hal_touch.cpp で実装されている可能性が高い)
+// void HalEsp32::setTouchPrediction(uint16_t leadMs) override; // (hal_touch.cpp で実装されている可能性が高い)
+// bool HalEsp32::startInk(const InkConfig_t& config) override; // (hal_ink.cpp で実装されている可能性が高い)
+// void HalEsp32::stopInk() override; // (hal_ink.cpp で実装されている可能性が高い)
+// bool HalEsp32::isInking() override; // (hal_ink.cpp で実装されている可能性が高い)
+// void HalEsp32::clearInk(lv_color_t bg) override; // (hal_ink.cpp で実装されている可能性が高い)
+// void HalEsp32::setPointerAcceleration(const PointerAccelConfig_t& config) override; // (hal_usb.cpp で実装されている可能性が高い)
+// bool HalEsp32::startInputRecord(const std::string& path) override; // (hal_touch.cpp で実装されている可能性が高い)
+// bool HalEsp32::startInputReplay(const std::string& path) override; // (hal_touch.cpp で実装されている可能性が高い)
+// void HalEsp32::stopInputTrace(bool dropLastTap) override; // (hal_touch.cpp で実装されている可能性が高い)
+// InputTraceStatus_t HalEsp32::getInputTraceStatus() override; // (hal_touch.cpp で実装されている可能性が高い)
+// void HalEsp32::claimPerfLevel(const std::string& owner, PerfLevel_t level) override; // (hal_power_policy.cpp で実装されている可能性が高い)
+// PerfLevel_t HalEsp32::getPerfLevel() override; // (hal_power_policy.cpp で実装されている可能性が高い)
+// void HalEsp32::setWifiPowerSave(const WifiPowerSaveConfig_t& config) override; // (hal_power_policy.cpp で実装されている可能性が高い)
+// void HalEsp32::claimRadioLevel(const std::string& owner, RadioLevel_t level) override; // (hal_power_policy.cpp で実装されている可能性が高い)
+// RadioLevel_t HalEsp32::getRadioLevel() override; // (hal_power_policy.cpp で実装されている可能性が高い)
 // void HalEsp32::updateImuData() override; // (hal_imu.cpp で実装されている可能性が高い)
 // void HalEsp32::clearImuIrq() override; // (hal_imu.cpp で実装されている可能性が高い)
+// bool HalEsp32::startImuStream(uint16_t rateHz) override; // (hal_imu.cpp で実装されている可能性が高い)
+// void HalEsp32::stopImuStream() override; // (hal_imu.cpp で実装されている可能性が高い)
+// bool HalEsp32::isImuStreaming() override; // (hal_imu.cpp で実装されている可能性が高い)
+// size_t HalEsp32::readImuSamples(ImuSample_t* samples, size_t maxCount) override; // (hal_imu.cpp で実装されている可能性が高い)
+// bool HalEsp32::getImuOrientation(ImuOrientation_t& orientation) override; // (hal_imu.cpp で実装されている可能性が高い)
+// bool HalEsp32::getImuGyroAngle(uint64_t timestampUs, float angle[3]) override; // (hal_imu.cpp で実装されている可能性が高い)
+// bool HalEsp32::startImuGestures(uint8_t gestureMask, ImuGestureCallback_t onGesture) override; // (hal_imu.cpp で実装されている可能性が高い)
+// void HalEsp32::stopImuGestures() override; // (hal_imu.cpp で実装されている可能性が高い)
+
+// bool HalEsp32::startSensorService(const SensorServiceConfig_t& config) override; // (hal_sensor_service.cpp で実装されている可能性が高い)
+// void HalEsp32::stopSensorService() override; // (hal_sensor_service.cpp で実装されている可能性が高い)
+// bool HalEsp32::getSensorSnapshot(SensorSnapshot_t& snapshot) override; // (hal_sensor_service.cpp で実装されている可能性が高い)
+// bool HalEsp32::startClockService(const ClockServiceConfig_t& config) override; // (hal_clock.cpp で実装されている可能性が高い)
+// void HalEsp32::stopClockService() override; // (hal_clock.cpp で実装されている可能性が高い)
+// bool HalEsp32::isClockServiceRunning() override; // (hal_clock.cpp で実装されている可能性が高い)
+// ClockStats_t HalEsp32::getClockStats() override; // (hal_clock.cpp で実装されている可能性が高い)
+
+// bool HalEsp32::startTelemetry(const TelemetryConfig_t& config) override; // (hal_telemetry.cpp で実装されている可能性が高い)
+// void HalEsp32::stopTelemetry() override; // (hal_telemetry.cpp で実装されている可能性が高い)
+// TelemetryStats_t HalEsp32::getTelemetryStats() override; // (hal_telemetry.cpp で実装されている可能性が高い)
+// bool HalEsp32::startMqtt(const MqttConfig_t& config) override; // (hal_mqtt.cpp で実装されている可能性が高い)
+// void HalEsp32::stopMqtt() override; // (hal_mqtt.cpp で実装されている可能性が高い)
+// MqttStats_t HalEsp32::getMqttStats() override; // (hal_mqtt.cpp で実装されている可能性が高い)
+// bool HalEsp32::startBleTelemetry(const BleTelemetryConfig_t& config) override; // (hal_ble.cpp で実装されている可能性が高い)
+// void HalEsp32::stopBleTelemetry() override; // (hal_ble.cpp で実装されている可能性が高い)
+// BleTelemetryStats_t HalEsp32::getBleTelemetryStats() override; // (hal_ble.cpp で実装されている可能性が高い)
+// bool HalEsp32::startScreenMirror(const ScreenMirrorConfig_t& config) override; // (hal_mirror.cpp で実装されている可能性が高い)
+// void HalEsp32::stopScreenMirror() override; // (hal_mirror.cpp で実装されている可能性が高い)
+// ScreenMirrorStats_t HalEsp32::getScreenMirrorStats() override; // (hal_mirror.cpp で実装されている可能性が高い)
+// bool HalEsp32::takeScreenshot(uint8_t quality) override; // (hal_screen_capture.cpp で実装されている可能性が高い)
+// bool HalEsp32::startScreenRecording(const ScreenRecordConfig_t& config) override; // (hal_screen_capture.cpp で実装されている可能性が高い)
+// void HalEsp32::stopScreenRecording() override; // (hal_screen_capture.cpp で実装されている可能性が高い)
+// ScreenCaptureStats_t HalEsp32::getScreenCaptureStats() override; // (hal_screen_capture.cpp で実装されている可能性が高い)
+// void HalEsp32::setDisplayRotation(lv_display_rotation_t rotation) override; // (hal_auto_rotate.cpp で実装されている可能性が高い)
+// lv_display_rotation_t HalEsp32::getDisplayRotation() override; // (hal_auto_rotate.cpp で実装されている可能性が高い)
+// bool HalEsp32::startAutoRotate(const AutoRotateConfig_t& config) override; // (hal_auto_rotate.cpp で実装されている可能性が高い)
+// void HalEsp32::stopAutoRotate() override; // (hal_auto_rotate.cpp で実装されている可能性が高い)
+// bool HalEsp32::isAutoRotating() override; // (hal_auto_rotate.cpp で実装されている可能性が高い)
+// bool HalEsp32::startBinaryLog(const BinaryLogConfig_t& config) override; // (hal_binary_log.cpp で実装されている可能性が高い)
+// void HalEsp32::stopBinaryLog() override; // (hal_binary_log.cpp で実装されている可能性が高い)
+// BinaryLogStats_t HalEsp32::getBinaryLogStats() override; // (hal_binary_log.cpp で実装されている可能性が高い)
+// bool HalEsp32::startTimeSeries(const TimeSeriesConfig_t& config) override; // (hal_time_series.cpp で実装されている可能性が高い)
+// void HalEsp32::stopTimeSeries() override; // (hal_time_series.cpp で実装されている可能性が高い)
+// TimeSeriesStats_t HalEsp32::getTimeSeriesStats() override; // (hal_time_series.cpp で実装されている可能性が高い)
+// bool HalEsp32::timeSeriesAppend(const std::string& series, int64_t timeMs, float value) override; // (hal_time_series.cpp で実装されている可能性が高い)
+// bool HalEsp32::timeSeriesQuery(const std::string& series, int64_t startMs, int64_t endMs, TimeSeriesResult_t& result) override; // (hal_time_series.cpp で実装されている可能性が高い)
+// bool HalEsp32::startUsbExport(const UsbExportConfig_t& config) override; // (hal_usb_export.cpp で実装されている可能性が高い)
+// void HalEsp32::stopUsbExport() override; // (hal_usb_export.cpp で実装されている可能性が高い)
+// UsbExportStats_t HalEsp32::getUsbExportStats() override; // (hal_usb_export.cpp で実装されている可能性が高い)
+// bool HalEsp32::usbExportWrite(uint8_t channel, const void* data, size_t size) override; // (hal_usb_export.cpp で実装されている可能性が高い)
 
 // void HalEsp32::setChargeQcEnable(bool enable) override; // (hal_power.cpp で実装されている可能性が高い)
 // bool HalEsp32::getChargeQcEnable() override; // (hal_power.cpp で実装されている可能性が高い)
@@ -500,14 +726,57 @@ void HalEsp32::gpioReset(uint8_t pin)
 // void HalEsp32::sleepAndShakeWakeup() override; // (hal_power.cpp で実装されている可能性が高い)
 // void HalEsp32::sleepAndRtcWakeup() override; // (hal_power.cpp で実装されている可能性が高い)
 
+// bool HalEsp32::getAsset(const std::string& name, Asset_t& asset) override; // (hal_asset_pack.cpp で実装されている可能性が高い)
+
+// std::vector<StackWatermark_t> HalEsp32::getStackWatermarks() override; // (hal_system.cpp で実装されている可能性が高い)
+// bool HalEsp32::startDiagnostics(uint16_t intervalMs) override; // (hal_system.cpp で実装されている可能性が高い)
+// void HalEsp32::stopDiagnostics() override; // (hal_system.cpp で実装されている可能性が高い)
+// bool HalEsp32::startAppTask(const AppTaskConfig_t& config, std::function<void()> task) override; // (hal_system.cpp で実装されている可能性が高い)
+// bool HalEsp32::submitJob(std::function<void()> job, int core) override; // (hal_system.cpp で実装されている可能性が高い)
+// std::vector<MathBenchmarkResult_t> HalEsp32::runMathBenchmark() override; // (hal_math_benchmark.cpp で実装されている可能性が高い)
+// bool HalEsp32::startHalBenchmark() override; // (hal_micro_benchmark.cpp で実装されている可能性が高い)
+// HalBenchmarkResult_t HalEsp32::getHalBenchmarkResult() override; // (hal_micro_benchmark.cpp で実装されている可能性が高い)
+// void* HalEsp32::allocMemory(size_t size, MemoryPlacement_t placement) override; // (hal_system.cpp で実装されている可能性が高い)
+// void HalEsp32::freeMemory(void* ptr) override; // (hal_system.cpp で実装されている可能性が高い)
+// void HalEsp32::flushSettings() override; // (hal_settings.cpp で実装されている可能性が高い)
+
 // void HalEsp32::startCameraCapture(lv_obj_t* imgCanvas) override; // (hal_camera.cpp で実装されている可能性が高い)
+// bool HalEsp32::switchCameraConfig(const CameraConfig_t& config) override; // (hal_camera.cpp で実装されている可能性が高い)
 // void HalEsp32::stopCameraCapture() override; // (hal_camera.cpp で実装されている可能性が高い)
 // bool HalEsp32::isCameraCapturing() override; // (hal_camera.cpp で実装されている可能性が高い)
+// bool HalEsp32::startCameraIspStats(CameraIspStatsCallback_t onStats) override; // (hal_camera.cpp で実装されている可能性が高い)
+// void HalEsp32::stopCameraIspStats() override; // (hal_camera.cpp で実装されている可能性が高い)
+// bool HalEsp32::setCameraImageControl(const CameraImageControl_t& control) override; // (hal_camera.cpp で実装されている可能性が高い)
+// bool HalEsp32::getCameraImageState(CameraImageState_t& state) override; // (hal_camera.cpp で実装されている可能性が高い)
+// bool HalEsp32::startCameraMotionDetect(const CameraMotionConfig_t& config, CameraMotionCallback_t onMotion) override; // (hal_camera.cpp で実装されている可能性が高い)
+// void HalEsp32::stopCameraMotionDetect() override; // (hal_camera.cpp で実装されている可能性が高い)
+// bool HalEsp32::isCameraMotionDetecting() override; // (hal_camera.cpp で実装されている可能性が高い)
+// bool HalEsp32::startCameraTimelapse(const CameraTimelapseConfig_t& config) override; // (hal_camera.cpp で実装されている可能性が高い)
+// void HalEsp32::stopCameraTimelapse() override; // (hal_camera.cpp で実装されている可能性が高い)
+// bool HalEsp32::isCameraTimelapseRunning() override; // (hal_camera.cpp で実装されている可能性が高い)
+// uint32_t HalEsp32::getCameraTimelapseShots() override; // (hal_camera.cpp で実装されている可能性が高い)
+// bool HalEsp32::startCameraRawCapture(const CameraRawCaptureConfig_t& config) override; // (hal_camera.cpp で実装されている可能性が高い)
+// void HalEsp32::stopCameraRawCapture() override; // (hal_camera.cpp で実装されている可能性が高い)
+// bool HalEsp32::isCameraRawCapturing() override; // (hal_camera.cpp で実装されている可能性が高い)
+// CameraRawStats_t HalEsp32::getCameraRawStats() override; // (hal_camera.cpp で実装されている可能性が高い)
+// bool HalEsp32::startCameraInference(const CameraInferenceConfig_t& config, CameraDetector_t detector, CameraDetectionCallback_t onDetections) override; // (hal_camera.cpp で実装されている可能性が高い)
+// void HalEsp32::stopCameraInference() override; // (hal_camera.cpp で実装されている可能性が高い)
+// float HalEsp32::getCameraInferenceFps() override; // (hal_camera.cpp で実装されている可能性が高い)
+// bool HalEsp32::startCameraBarcodeScan(const CameraBarcodeConfig_t& config) override; // (hal_camera.cpp で実装されている可能性が高い)
+// void HalEsp32::stopCameraBarcodeScan() override; // (hal_camera.cpp で実装されている可能性が高い)
+// bool HalEsp32::isCameraBarcodeScanning() override; // (hal_camera.cpp で実装されている可能性が高い)
+// CameraBarcode_t HalEsp32::getCameraBarcode() override; // (hal_camera.cpp で実装されている可能性が高い)
+// int HalEsp32::subscribeCameraFrames(const CameraFrameSubscriberConfig_t& config, CameraFrameCallback_t onFrame) override; // (hal_camera.cpp で実装されている可能性が高い)
+// void HalEsp32::unsubscribeCameraFrames(int id) override; // (hal_camera.cpp で実装されている可能性が高い)
+// CameraFrameSubscriberStats_t HalEsp32::getCameraFrameSubscriberStats(int id) override; // (hal_camera.cpp で実装されている可能性が高い)
+// bool HalEsp32::startUvcCamera() override; // (hal_camera.cpp で実装されている可能性が高い)
+// void HalEsp32::stopUvcCamera() override; // (hal_camera.cpp で実装されている可能性が高い)
+// bool HalEsp32::isUvcCameraStreaming() override; // (hal_camera.cpp で実装されている可能性が高い)
 
 // void HalEsp32::setSpeakerVolume(uint8_t volume) override; // (hal_audio.cpp で実装されている可能性が高い)
 // uint8_t HalEsp32::getSpeakerVolume() override; // (hal_audio.cpp で実装されている可能性が高い)
 // void HalEsp32::audioRecord(std::vector<int16_t>& data, uint16_t durationMs, float gain) override; // (hal_audio.cpp で実装されている可能性が高い)
-// void HalEsp32::audioPlay(std::vector<int16_t>& data, bool async) override; // (hal_audio.cpp で実装されている可能性が高い)
+// void HalEsp32::audioPlay(std::vector<int16_t>& data, bool async, uint8_t volume) override; // (hal_audio.cpp で実装されている可能性が高い)
 // void HalEsp32::startDualMicRecordTest() override; // (hal_audio.cpp で実装されている可能性が高い)
 // MicTestState_t HalEsp32::getDualMicRecordTestState() override; // (hal_audio.cpp で実装されている可能性が高い)
 // void HalEsp32::startHeadphoneMicRecordTest() override; // (hal_audio.cpp で実装されている可能性が高い)
@@ -515,19 +784,120 @@ void HalEsp32::gpioReset(uint8_t pin)
 // void HalEsp32::startPlayMusicTest() override; // (hal_audio.cpp で実装されている可能性が高い)
 // MusicPlayState_t HalEsp32::getMusicPlayTestState() override; // (hal_audio.cpp で実装されている可能性が高い)
 // void HalEsp32::stopPlayMusicTest() override; // (hal_audio.cpp で実装されている可能性が高い)
+// bool HalEsp32::queueMusic(const std::string& path) override; // (hal_audio.cpp で実装されている可能性が高い)
+// void HalEsp32::skipMusic() override; // (hal_audio.cpp で実装されている可能性が高い)
+// void HalEsp32::clearMusicQueue() override; // (hal_audio.cpp で実装されている可能性が高い)
+// std::vector<std::string> HalEsp32::getMusicQueue() override; // (hal_audio.cpp で実装されている可能性が高い)
+// std::string HalEsp32::getPlayingMusic() override; // (hal_audio.cpp で実装されている可能性が高い)
 // void HalEsp32::playStartupSfx() override; // (hal_audio.cpp で実装されている可能性が高い)
 // void HalEsp32::playShutdownSfx() override; // (hal_audio.cpp で実装されている可能性が高い)
 
 // void HalEsp32::setExtAntennaEnable(bool enable) override; // (hal_wifi.cpp で実装されている可能性が高い)
 // bool HalEsp32::getExtAntennaEnable() override; // (hal_wifi.cpp で実装されている可能性が高い)
 // void HalEsp32::startWifiAp() override; // (hal_wifi.cpp で実装されている可能性が高い)
+// bool HalEsp32::setWifiCredentials(const std::string& ssid, const std::string& password) override; // (hal_wifi.cpp で実装されている可能性が高い)
+// void HalEsp32::clearWifiCredentials() override; // (hal_wifi.cpp で実装されている可能性が高い)
+// bool HalEsp32::hasWifiCredentials() override; // (hal_wifi.cpp で実装されている可能性が高い)
+// bool HalEsp32::startWifiSta() override; // (hal_wifi.cpp で実装されている可能性が高い)
+// void HalEsp32::stopWifiSta() override; // (hal_wifi.cpp で実装されている可能性が高い)
+// WifiStatus_t HalEsp32::getWifiStatus() override; // (hal_wifi.cpp で実装されている可能性が高い)
+// bool HalEsp32::setWifiLinkDrive(uint8_t level) override; // (hal_wifi_benchmark.cpp で実装されている可能性が高い)
+// uint8_t HalEsp32::getWifiLinkDrive() override; // (hal_wifi_benchmark.cpp で実装されている可能性が高い)
+// bool HalEsp32::startWifiBenchmark(const WifiBenchmarkConfig_t& config) override; // (hal_wifi_benchmark.cpp で実装されている可能性が高い)
+// WifiBenchmarkResult_t HalEsp32::getWifiBenchmarkResult() override; // (hal_wifi_benchmark.cpp で実装されている可能性が高い)
+
+// bool HalEsp32::isSdCardMounted() override; // (hal_sd_card.cpp で実装されている可能性が高い)
+// std::vector<FileEntry_t> HalEsp32::scanSdCard(const std::string& dirPath) override; // (hal_sd_card.cpp で実装されている可能性が高い)
+// uint32_t HalEsp32::startSdCardScan(const std::string& dirPath, size_t pageSize) override; // (hal_sd_card.cpp で実装されている可能性が高い)
+// bool HalEsp32::getSdCardScanPage(SdCardScanPage_t& page) override; // (hal_sd_card.cpp で実装されている可能性が高い)
+// void HalEsp32::cancelSdCardScan() override; // (hal_sd_card.cpp で実装されている可能性が高い)
+// bool HalEsp32::startSdCardBenchmark(const SdCardBenchmarkConfig_t& config) override; // (hal_sd_card.cpp で実装されている可能性が高い)
+// SdCardBenchmarkResult_t HalEsp32::getSdCardBenchmarkResult() override; // (hal_sd_card.cpp で実装されている可能性が高い)
+// bool HalEsp32::openGallery(const std::vector<std::string>& paths, const GalleryConfig_t& config) override; // (hal_gallery.cpp で実装されている可能性が高い)
+// void HalEsp32::closeGallery() override; // (hal_gallery.cpp で実装されている可能性が高い)
+// void HalEsp32::setGalleryIndex(int32_t index) override; // (hal_gallery.cpp で実装されている可能性が高い)
+// GalleryItemState_t HalEsp32::getGalleryPicture(size_t index, GalleryPicture_t& picture) override; // (hal_gallery.cpp で実装されている可能性が高い)
+// GalleryItemState_t HalEsp32::getGalleryThumbnail(size_t index, GalleryPicture_t& thumbnail) override; // (hal_gallery.cpp で実装されている可能性が高い)
+// GalleryStats_t HalEsp32::getGalleryStats() override; // (hal_gallery.cpp で実装されている可能性が高い)
+// bool HalEsp32::startVideoPlayback(const std::string& path, const VideoPlayerConfig_t& config) override; // (hal_video_player.cpp で実装されている可能性が高い)
+// void HalEsp32::stopVideoPlayback() override; // (hal_video_player.cpp で実装されている可能性が高い)
+// VideoPlayerStats_t HalEsp32::getVideoPlayerStats() override; // (hal_video_player.cpp で実装されている可能性が高い)
 
 // bool HalEsp32::usbADetect() override; // (hal_usb.cpp で実装されている可能性が高い)
+// bool HalEsp32::isUsbDriveMounted() override; // (hal_usb_msc.cpp で実装されている可能性が高い)
+// bool HalEsp32::startFileCopy(const std::string& srcPath, const std::string& dstPath) override; // (hal_usb_msc.cpp で実装されている可能性が高い)
+// void HalEsp32::cancelFileCopy() override; // (hal_usb_msc.cpp で実装されている可能性が高い)
+// FileCopyProgress_t HalEsp32::getFileCopyProgress() override; // (hal_usb_msc.cpp で実装されている可能性が高い)
 
 // プライベートヘルパー関数の実装
 // void HalEsp32::hid_init() {} // (hal_usb.cpp や bsp で実装されている可能性が高い)
-// void HalEsp32::rs485_init() {} // (hal_rs485.cpp で実装されている可能性が高い)
+// void HalEsp32::usb_msc_init() {} // (hal_usb_msc.cpp で実装されている可能性が高い)
+// void HalEsp32::usb_cdc_init() {} // (hal_usb_cdc.cpp で実装されている可能性が高い)
+// bool HalEsp32::mount_sd_card() {} // (hal_sd_card.cpp で実装されている可能性が高い)
+// void HalEsp32::asset_pack_init() {} // (hal_asset_pack.cpp で実装されている可能性が高い)
+// void HalEsp32::settings_init() {} // (hal_settings.cpp で実装されている可能性が高い)
+// void HalEsp32::sd_card_init() {} // (hal_sd_card.cpp で実装されている可能性が高い)
+// void HalEsp32::port_state_init() {} // (hal_port_state.cpp で実装されている可能性が高い)
+// bool HalEsp32::rs485_power_up() {} // (hal_rs485.cpp で実装されている可能性が高い)
+// void HalEsp32::uartMonitorSend(std::string msg, bool newLine) override; // (hal_rs485.cpp で実装されている可能性が高い)
+// bool HalEsp32::setRs485Config(const Rs485Config_t& config, Rs485FrameCallback_t onFrame) override; // (hal_rs485.cpp で実装されている可能性が高い)
+// size_t HalEsp32::rs485Write(const uint8_t* data, size_t size) override; // (hal_rs485.cpp で実装されている可能性が高い)
+// Rs485Stats_t HalEsp32::getRs485Stats() override; // (hal_rs485.cpp で実装されている可能性が高い)
+// bool HalEsp32::startModbus(const ModbusConfig_t& config) override; // (hal_modbus.cpp で実装されている可能性が高い)
+// void HalEsp32::stopModbus() override; // (hal_modbus.cpp で実装されている可能性が高い)
+// bool HalEsp32::isModbusRunning() override; // (hal_modbus.cpp で実装されている可能性が高い)
+// bool HalEsp32::modbusWriteRegisters(uint8_t slaveId, uint16_t address, const std::vector<uint16_t>& values) override; // (hal_modbus.cpp で実装されている可能性が高い)
+// void HalEsp32::setModbusSlaveRegister(uint16_t address, uint16_t value) override; // (hal_modbus.cpp で実装されている可能性が高い)
+// uint16_t HalEsp32::getModbusSlaveRegister(uint16_t address) override; // (hal_modbus.cpp で実装されている可能性が高い)
+// ModbusStats_t HalEsp32::getModbusStats() override; // (hal_modbus.cpp で実装されている可能性が高い)
+// bool HalEsp32::startRs485Gateway(const Rs485GatewayConfig_t& config) override; // (hal_rs485_gateway.cpp で実装されている可能性が高い)
+// void HalEsp32::stopRs485Gateway() override; // (hal_rs485_gateway.cpp で実装されている可能性が高い)
+// bool HalEsp32::isRs485GatewayRunning() override; // (hal_rs485_gateway.cpp で実装されている可能性が高い)
+// Rs485GatewayStats_t HalEsp32::getRs485GatewayStats() override; // (hal_rs485_gateway.cpp で実装されている可能性が高い)
+// bool HalEsp32::startDutyCycle(const DutyCycleConfig_t& config) override; // (hal_duty_cycle.cpp で実装されている可能性が高い)
+// void HalEsp32::duty_cycle_wake() {} // (hal_duty_cycle.cpp で実装されている可能性が高い)
+// void HalEsp32::fadeDisplayBrightness(uint8_t brightness, uint16_t durationMs) override; // (hal_backlight.cpp で実装されている可能性が高い)
+// bool HalEsp32::startBacklightPolicy(const BacklightPolicyConfig_t& config) override; // (hal_backlight.cpp で実装されている可能性が高い)
+// void HalEsp32::stopBacklightPolicy() override; // (hal_backlight.cpp で実装されている可能性が高い)
+// void HalEsp32::setBacklightAmbient(float lux) override; // (hal_backlight.cpp で実装されている可能性が高い)
+// void HalEsp32::backlight_apply(uint16_t fadeMs) {} // (hal_backlight.cpp で実装されている可能性が高い)
+// bool HalEsp32::startRefreshGovernor(const RefreshGovernorConfig_t& config) override; // (hal_refresh_governor.cpp で実装されている可能性が高い)
+// void HalEsp32::stopRefreshGovernor() override; // (hal_refresh_governor.cpp で実装されている可能性が高い)
+// void HalEsp32::setUiAnimating(bool animating) override; // (hal_refresh_governor.cpp で実装されている可能性が高い)
+// uint8_t HalEsp32::getDisplayRefreshRate() override; // (hal_refresh_governor.cpp で実装されている可能性が高い)
+// bool HalEsp32::startThermalService(const ThermalConfig_t& config) override; // (hal_thermal.cpp で実装されている可能性が高い)
+// void HalEsp32::stopThermalService() override; // (hal_thermal.cpp で実装されている可能性が高い)
+// bool HalEsp32::isThermalServiceRunning() override; // (hal_thermal.cpp で実装されている可能性が高い)
+// void HalEsp32::power_policy_set_cpu_cap(uint16_t mhz) {} // (hal_power_policy.cpp で実装されている可能性が高い)
+// void HalEsp32::camera_set_fps_cap(uint8_t fps) {} // (hal_camera.cpp で実装されている可能性が高い)
+// OtaStatus_t HalEsp32::getOtaStatus() override; // (hal_ota.cpp で実装されている可能性が高い)
+// bool HalEsp32::rollbackFirmware() override; // (hal_ota.cpp で実装されている可能性が高い)
+// bool HalEsp32::startProfiler(const ProfilerConfig_t& config) override; // (hal_profiler.cpp で実装されている可能性が高い)
+// void HalEsp32::stopProfiler() override; // (hal_profiler.cpp で実装されている可能性が高い)
+// ProfilerStats_t HalEsp32::getProfilerStats() override; // (hal_profiler.cpp で実装されている可能性が高い)
+// bool HalEsp32::exportProfile(const std::string& path) override; // (hal_profiler.cpp で実装されている可能性が高い)
+// bool HalEsp32::startEventTrace(const EventTraceConfig_t& config) override; // (hal_event_trace.cpp で実装されている可能性が高い)
+// void HalEsp32::stopEventTrace() override; // (hal_event_trace.cpp で実装されている可能性が高い)
+// EventTraceStats_t HalEsp32::getEventTraceStats() override; // (hal_event_trace.cpp で実装されている可能性が高い)
+// bool HalEsp32::exportEventTrace(const std::string& path) override; // (hal_event_trace.cpp で実装されている可能性が高い)
+// bool HalEsp32::startStallMonitor(const StallMonitorConfig_t& config) override; // (hal_stall_monitor.cpp で実装されている可能性が高い)
+// void HalEsp32::stopStallMonitor() override; // (hal_stall_monitor.cpp で実装されている可能性が高い)
+// StallMonitorStats_t HalEsp32::getStallMonitorStats() override; // (hal_stall_monitor.cpp で実装されている可能性が高い)
+// void HalEsp32::markUiSection(UiSection_t section, bool isBegin) override; // (hal_stall_monitor.cpp で実装されている可能性が高い)
+// LvglLockStats_t HalEsp32::getLvglLockStats() override; // (hal_lvgl_lock.cpp で実装されている可能性が高い)
+// bool HalEsp32::postUiCommand(std::function<void()> command) override; // (hal_lvgl_lock.cpp で実装されている可能性が高い)
+// bool HalEsp32::startAudioRecorder(const AudioRecorderConfig_t& config) override; // (hal_audio_recorder.cpp で実装されている可能性が高い)
+// void HalEsp32::stopAudioRecorder() override; // (hal_audio_recorder.cpp で実装されている可能性が高い)
+// AudioRecorderStatus_t HalEsp32::getAudioRecorderStatus() override; // (hal_audio_recorder.cpp で実装されている可能性が高い)
+// bool HalEsp32::startAudioListening(const AudioListenConfig_t& config, AudioListenCallback_t onVoice) override; // (hal_audio_capture.cpp で実装されている可能性が高い)
+// void HalEsp32::stopAudioListening() override; // (hal_audio_capture.cpp で実装されている可能性が高い)
+// bool HalEsp32::isAudioListening() override; // (hal_audio_capture.cpp で実装されている可能性が高い)
+// bool HalEsp32::setAudioDmaProfile(AudioDmaProfile_t profile) override; // (hal_audio.cpp で実装されている可能性が高い)
+// AudioDmaProfile_t HalEsp32::getAudioDmaProfile() override; // (hal_audio.cpp で実装されている可能性が高い)
+// AudioDmaStats_t HalEsp32::getAudioDmaStats() override; // (hal_audio.cpp で実装されている可能性が高い)
+// void HalEsp32::ota_confirm_boot() {} // (hal_ota.cpp で実装されている可能性が高い)
 // bool HalEsp32::wifi_init() {} // (hal_wifi.cpp で実装されている可能性が高い)
+// void HalEsp32::apply_wifi_link_drive() {} // (hal_wifi_benchmark.cpp で実装されている可能性が高い)
 // void HalEsp32::imu_init() {} // (hal_imu.cpp で実装されている可能性が高い)
 
 // 注意: 上記のコメントアウトされた関数群は、このファイル (hal_esp32.cpp) には実装がありません。
@@ -19,6 +19,12 @@
 // RX8130 リアルタイムクロック(RTC)ICを制御するためのライブラリをインクルードします。
 #include "utils/rx8130/rx8130.h"
 
+// 内部I2Cバスのトランザクションを優先度順に調停するスケジューラをインクルードします。
+#include "utils/i2c_bus_scheduler/i2c_bus_scheduler.h"
+
+// 設定をRAMに保持し、変更が止まってからNVSにまとめて書き込むストアをインクルードします。
+#include "utils/settings_store/settings_store.h"
+
 // HalEsp32クラスは、hal::HalBaseクラスをパブリック継承します。
 // これにより、ESP32プラットフォーム固有のハードウェア操作を抽象化し、
 // アプリケーションフレームワークに対して統一されたインターフェースを提供します。
@@ -33,17 +39,69 @@ public:
 
     // ハードウェアの初期化処理を行う純粋仮想関数のオーバーライドです。
     // この関数内で、ディスプレイ、センサー、ペリフェラルなどの初期設定が行われます。
+    // 画面とタッチの準備ができた時点で戻り、残りの初期化はバックグラウンドで続きます。
     void init() override;
 
+    // バックグラウンドの初期化がすべて終わったかどうかを返します。
+    bool isBootDone() override;
+
     // 指定されたミリ秒数だけ処理を遅延させる純粋仮想関数のオーバーライドです。
     void delay(uint32_t ms) override;
 
     // システム起動からの経過時間をミリ秒単位で返す純粋仮想関数のオーバーライドです。
     uint32_t millis() override;
 
-    // CPUの温度を取得する純粋仮想関数のオーバーライドです。
+    // CPUの温度を取得する純粋仮想関数のオーバーライドです。温度サービスの動作中はフィルター後の値を返します。
     int getCpuTemp() override;
 
+    // FreeRTOSのランタイム統計からタスクごとのCPU負荷と、ヒープの空き容量/最小空き容量を取得します。
+    SystemStats_t getSystemStats() override;
+
+    // タスクのCPU負荷を測る区間の持ち主です。呼び出し元ごとに区間を分け、互いの測定をリセットしないようにします。
+    enum SystemStatsWindow_t {
+        SYSTEM_STATS_WINDOW_APP = 0,
+        SYSTEM_STATS_WINDOW_TELEMETRY,
+        SYSTEM_STATS_WINDOW_DIAGNOSTICS,
+        SYSTEM_STATS_WINDOW_NUM,
+    };
+
+    // タスク名ごとに、これまでで最も少なかったスタックの空き容量を返します。終了したタスクも残ります。
+    std::vector<StackWatermark_t> getStackWatermarks() override;
+
+    // 一定周期でスタックとヒープを計測する診断タスクを開始します。ヒープの最小空き容量が減るとログに出力します。
+    bool startDiagnostics(uint16_t intervalMs = 1000) override;
+
+    // 診断タスクを停止し、終了を待ちます。
+    void stopDiagnostics() override;
+
+    // アプリのメインループを最大timeoutMsミリ秒 (最低1ティック) 待機させます。wakeAppLoop() で即座に再開します。
+    void waitAppLoopWakeup(uint32_t timeoutMs) override;
+
+    // 待機中のアプリのメインループを起こします。任意のタスクやLVGLのコールバックから呼び出せます。
+    void wakeAppLoop() override;
+
+    // アプリ層のタスクを作成します。core が負の場合はコアを固定しません。関数から戻るとタスクは削除されます。
+    bool startAppTask(const AppTaskConfig_t& config, std::function<void()> task) override;
+
+    // 共有ワーカープールにジョブを投入します。コアごとのキューに入り、空いたワーカーは他方のコアのジョブも取ります。
+    bool submitJob(std::function<void()> job, int core = -1) override;
+
+    // imlib の高速数学関数をスカラー呼び出しとバッチ版で計測し、libm との最大誤差を返します。数十ms ブロックします。
+    std::vector<MathBenchmarkResult_t> runMathBenchmark() override;
+    // I2C・memcpy・PPA・JPEG・I2S の基本操作をバックグラウンドで計測します。結果は項目ごとのレコードで返します。
+    bool startHalBenchmark() override;
+    // 計測の状態とここまでのレコードを返します。
+    HalBenchmarkResult_t getHalBenchmarkResult() override;
+
+    // 配置先を指定してメモリを確保します。内部SRAMは遅延に厳しい小さなバッファ用、PSRAMは大きなデータ用です。
+    void* allocMemory(size_t size, MemoryPlacement_t placement) override;
+
+    // allocMemory() で確保したメモリを解放します。
+    void freeMemory(void* ptr) override;
+
+    // 変更された設定をすぐにNVSへ書き込みます。通常は変更が止まってしばらくしてから、まとめて書き込まれます。
+    void flushSettings() override;
+
     // INA226 電流・電力モニターICのインスタンスです。
     // これを通じて、バッテリー電圧や消費電流などを監視できます。
     INA226 ina226;
@@ -57,9 +115,12 @@ public:
     lv_disp_t* lvDisp      = nullptr;
 
     // LVGLが使用する入力デバイス (キーボードやタッチパッドなど) へのポインタです。
-    // この例では主にタッチパッドからの入力を扱います。
+    // USBキーボードのキーパッド入力デバイスで、デフォルトグループのウィジェットを操作します。
     lv_indev_t* lvKeyboard = nullptr;
 
+    // Port A のTCA8418キーボードのキーパッド入力デバイスです。startKeypad() の間だけ存在します。
+    lv_indev_t* lvKeypad = nullptr;
+
     // ディスプレイの輝度を設定する純粋仮想関数のオーバーライドです。
     // brightness は 0 から 100 の範囲で指定します。
     void setDisplayBrightness(uint8_t brightness) override;
@@ -67,22 +128,178 @@ public:
     // 現在のディスプレイ輝度を取得する純粋仮想関数のオーバーライドです。
     uint8_t getDisplayBrightness() override;
 
+    // LEDCのフェード機能で、現在の輝度から指定の輝度までハードウェアで変化させます。CPU時間は使いません。
+    void fadeDisplayBrightness(uint8_t brightness, uint16_t durationMs) override;
+
+    // 無操作が続くとバックライトを暗くし、周囲の明るさに合わせて輝度を調整するポリシーのタスクを開始します。
+    bool startBacklightPolicy(const BacklightPolicyConfig_t& config) override;
+
+    // バックライトのポリシーを停止し、設定された輝度に戻します。
+    void stopBacklightPolicy() override;
+
+    // 周囲の明るさ (lux) を渡します。本体に照度センサーはないため、アプリが外部センサーの値を渡します。
+    void setBacklightAmbient(float lux) override;
+
+    // 静止した画面のフレームレートを、垂直フロントポーチを伸ばして下げるガバナーを開始します。(hal_refresh_governor.cpp で実装)
+    bool startRefreshGovernor(const RefreshGovernorConfig_t& config) override;
+
+    // ガバナーを停止し、フルレートに戻します。(hal_refresh_governor.cpp で実装)
+    void stopRefreshGovernor() override;
+
+    // アプリループがフルレートで動いている間、フルレートを保持します。(hal_refresh_governor.cpp で実装)
+    void setUiAnimating(bool animating) override;
+
+    // 現在のパネルのフレームレートを返します。(hal_refresh_governor.cpp で実装)
+    uint8_t getDisplayRefreshRate() override;
+
+    // 最新のタッチレポート (最大5点) を返します。
+    TouchState_t getTouchState() override;
+
+    // ドラッグ中の座標を最大leadMsミリ秒先まで外挿します。0で無効になります。
+    void setTouchPrediction(uint16_t leadMs) override;
+
+    // キャンバス上のタッチをLVGLの描画を待たずにフレームバッファへ直接描きます。(hal_ink.cpp で実装)
+    bool startInk(const InkConfig_t& config) override;
+
+    // 描きかけのストロークをキャンバスに反映してインクを終了します。(hal_ink.cpp で実装)
+    void stopInk() override;
+
+    // インク中かどうかを返します。(hal_ink.cpp で実装)
+    bool isInking() override;
+
+    // キャンバスを背景色で塗りつぶし、ストロークの記録を消去します。(hal_ink.cpp で実装)
+    void clearInk(lv_color_t bg) override;
+
+    // USBマウスの感度と加速カーブを設定します。レポートは受信タスク側でまとめられ、LVGLの読み出しごとに一度だけ反映されます。
+    void setPointerAcceleration(const PointerAccelConfig_t& config) override;
+
+    // lvTouchpad が受け取るポインタ入力をSDカードのファイルへ記録、またはファイルから再生します。
+    // 再生中は実際のタッチ入力の代わりに記録された入力が使われます。
+    bool startInputRecord(const std::string& path) override;
+    bool startInputReplay(const std::string& path) override;
+
+    // 記録または再生を終了します。記録はここでファイルに書き出されます。
+    // dropLastTap が true の場合、停止に使った最後のタップを記録から除きます。
+    void stopInputTrace(bool dropLastTap = false) override;
+    InputTraceStatus_t getInputTraceStatus() override;
+
     // LVGLの描画処理中に排他制御を行うためのロック関数のオーバーライドです。
-    // マルチタスク環境でLVGLのデータ構造を保護します。
-    void lvglLock() override;
+    // マルチタスク環境でLVGLのデータ構造を保護します。site は呼び出し元としてロック統計に記録されます。
+    void lvglLock(const char* site = __builtin_FUNCTION()) override;
 
     // LVGLの排他制御を解除するためのアンロック関数のオーバーライドです。
     void lvglUnlock() override;
 
+    // 呼び出し元ごとのLVGLロックの待ち時間と保持時間、現在の保持者を取得します。(hal_lvgl_lock.cpp で実装)
+    LvglLockStats_t getLvglLockStats() override;
+
+    // LVGLタスクで次の lv_timer_handler() の直前に実行するコマンドを積みます。(hal_lvgl_lock.cpp で実装)
+    bool postUiCommand(std::function<void()> command) override;
+
+    // LVGLの画像キャッシュとグリフキャッシュのヒット/ミス数を取得します。
+    LvglCacheStats_t getLvglCacheStats() override;
+
+    // LVGLのメモリアロケータが内部SRAMとPSRAMに確保している量を取得します。
+    LvglMemStats_t getLvglMemStats() override;
+
+    // 垂直同期でのフレーム切り替え回数と、描画が間に合わなかった垂直同期の回数を取得します。
+    VsyncStats_t getVsyncStats() override;
+
     // 電源モニター (INA226) のデータを更新する純粋仮想関数のオーバーライドです。
     void updatePowerMonitorData() override;
 
+    // INA226の変換完了ごとにサンプルを取得するタスクを開始します。averagesはチップ内の平均化回数です。
+    // サンプルはリングに蓄積され、エネルギー (mWh) の積算とウィンドウごとの最小/最大/平均を計算します。
+    bool startPowerSampling(uint16_t averages) override;
+
+    // 電源サンプリングタスクを停止し、INA226の設定を初期値に戻します。
+    void stopPowerSampling() override;
+
+    // 電源サンプリングタスクが動作中かどうかを返します。
+    bool isPowerSampling() override;
+
+    // リングに蓄積された電源サンプルを古い順に読み出します。
+    size_t readPowerSamples(PowerSample_t* samples, size_t maxCount) override;
+
+    // 前回の呼び出しからの統計を返し、新しいウィンドウを開始します。
+    PowerWindowStats_t takePowerWindowStats() override;
+
+    // サンプリング開始からの積算エネルギー (mWh) を返します。
+    float getPowerEnergyMwh() override;
+
+    // 電源プロファイルの記録を開始します。電源サンプルにアプリ・ウィンドウ・周辺機器の状態とCPU負荷を付加し、
+    // SDカードにバイナリレコードとして書き込みます。パスはSDカードのルートからの相対パスです。
+    bool startPowerProfile(const std::string& path) override;
+
+    // 電源プロファイルの記録を停止し、ファイルを閉じます。
+    void stopPowerProfile() override;
+
+    // 電源プロファイルを記録中かどうかを返します。
+    bool isPowerProfiling() override;
+
+    // 記録に付加する現在のアプリ名を設定します。
+    void setPowerProfileApp(const std::string& name) override;
+
+    // 記録に付加する現在開いているウィンドウ名を設定します。
+    void setPowerProfileWindow(const std::string& name) override;
+
+    // 所有者名で性能レベルを要求します。最も高い要求に応じてPMロック (ライトスリープ禁止、CPU最大周波数) を保持します。
+    void claimPerfLevel(const std::string& owner, PerfLevel_t level) override;
+
+    // 現在適用されている性能レベルを返します。
+    PerfLevel_t getPerfLevel() override;
+
+    // 無線を要求がないときに使う省電力レベルとリッスン間隔を設定します。
+    void setWifiPowerSave(const WifiPowerSaveConfig_t& config) override;
+
+    // 所有者名で無線レベルを要求します。最も高い要求に応じてステーションのモデムスリープを切り替えます。
+    void claimRadioLevel(const std::string& owner, RadioLevel_t level) override;
+
+    // 現在適用されている無線レベルを返します。
+    RadioLevel_t getRadioLevel() override;
+
+    // 所有者名で周辺機器を要求します。最初の要求で立ち上げ、最後の要求が解放されると電源を落とします。
+    bool claimPeripheral(Peripheral_t peripheral, const std::string& owner) override;
+
+    // 所有者の周辺機器の要求を解放します。
+    void releasePeripheral(Peripheral_t peripheral, const std::string& owner) override;
+
+    // 周辺機器が立ち上がっているかどうかを返します。
+    bool isPeripheralUp(Peripheral_t peripheral) override;
+
+    // アセットパーティションのインデックスから名前でアセットを探します。データはメモリマップされた領域を直接指します。
+    bool getAsset(const std::string& name, Asset_t& asset) override;
+
     // IMU (慣性計測ユニット) のデータを更新する純粋仮想関数のオーバーライドです。
     void updateImuData() override;
 
     // IMUの割り込みフラグをクリアする純粋仮想関数のオーバーライドです。
     void clearImuIrq() override;
 
+    // IMU の FIFO ストリーミングを開始します。
+    bool startImuStream(uint16_t rateHz = 400) override;
+
+    // IMU の FIFO ストリーミングを停止します。
+    void stopImuStream() override;
+
+    // IMU がストリーミング中かどうかを取得します。
+    bool isImuStreaming() override;
+
+    // ストリーミングされた IMU サンプルを読み出します。
+    size_t readImuSamples(ImuSample_t* samples, size_t maxCount) override;
+
+    // センサーフュージョンで推定した姿勢を取得します。
+    bool getImuOrientation(ImuOrientation_t& orientation) override;
+
+    // 指定時刻におけるジャイロの積分角度を取得します。カメラの手ブレ補正で使用します。
+    bool getImuGyroAngle(uint64_t timestampUs, float angle[3]) override;
+
+    // IMU 内蔵の特徴エンジンによるジェスチャー検出を開始します。
+    bool startImuGestures(uint8_t gestureMask, ImuGestureCallback_t onGesture) override;
+
+    // IMU のジェスチャー検出を停止します。
+    void stopImuGestures() override;
+
     // RTCの割り込みフラグをクリアする純粋仮想関数のオーバーライドです。
     void clearRtcIrq() override;
 
@@ -90,6 +307,139 @@ public:
     // tm構造体で指定された時刻を設定します。
     void setRtcTime(tm time) override;
 
+    // 壁時計サービスを開始します。時刻はシステム時刻から読み、RTCとは長い周期で秒の切り替わりに合わせて再同期し、
+    // 同期の間に測ったドリフトを adjtime() で少しずつ補正します。秒と分の区切りは EVENT_TOPIC_CLOCK として発行されます。
+    bool startClockService(const ClockServiceConfig_t& config) override;
+
+    // 壁時計サービスを停止し、タスクの終了を待ちます。
+    void stopClockService() override;
+
+    // 壁時計サービスが動作中かどうかを返します。
+    bool isClockServiceRunning() override;
+
+    // 再同期の回数、最後のオフセット、推定ドリフトを返します。
+    ClockStats_t getClockStats() override;
+
+    // センサーサービスタスクを開始します。電源モニター・IMU・RTCを設定された周期で読み出し、
+    // ダブルバッファのスナップショットとして公開します。UI側はI2C転送を待たずにキャッシュ値を参照できます。
+    bool startSensorService(const SensorServiceConfig_t& config) override;
+
+    // センサーサービスタスクを停止します。
+    void stopSensorService() override;
+
+    // 最新のセンサースナップショットをコピーします。サービス停止中はfalseを返します。
+    bool getSensorSnapshot(SensorSnapshot_t& snapshot) override;
+
+    // テレメトリのJSON文書を一定周期で作り直すタスクを開始します。Webサーバーの /api/telemetry と
+    // /ws/telemetry はキャッシュした文書を返すだけなので、リクエストごとに計測は行いません。
+    bool startTelemetry(const TelemetryConfig_t& config) override;
+
+    // テレメトリタスクを停止し、WebSocketクライアントを切り離します。
+    void stopTelemetry() override;
+
+    // テレメトリの配信統計を返します。
+    TelemetryStats_t getTelemetryStats() override;
+
+    // MQTTパブリッシャーを開始します。センサーの値をバッチにまとめてQoS 1で送り、ブローカーに届かない間は
+    // SDカードのキューに貯め、再接続後に順番に再送します。
+    bool startMqtt(const MqttConfig_t& config) override;
+
+    // MQTTパブリッシャーを停止します。未送信のバッチはキューに残ります。
+    void stopMqtt() override;
+
+    // MQTTの送信統計を返します。
+    MqttStats_t getMqttStats() override;
+
+    // BLEテレメトリを開始します。GATTペリフェラルとしてアドバタイズし、センサーの値をMTUに収まるだけまとめて
+    // 通知で送ります。接続間隔はバッチの周期に合わせて要求します。
+    bool startBleTelemetry(const BleTelemetryConfig_t& config) override;
+
+    // BLEテレメトリを停止し、NimBLEホストを解放します。
+    void stopBleTelemetry() override;
+
+    // BLEテレメトリの接続状態と送信統計を返します。
+    BleTelemetryStats_t getBleTelemetryStats() override;
+
+    // 画面ミラーリングを開始します。LVGLのフラッシュ領域を影フレームに写し、ハードウェアJPEGエンコーダで
+    // 圧縮して /ws/mirror のWebSocketクライアントへ送ります。クライアントがいない間は何もしません。
+    bool startScreenMirror(const ScreenMirrorConfig_t& config) override;
+
+    // 画面ミラーリングを停止し、フラッシュのフックとバッファを解放します。
+    void stopScreenMirror() override;
+
+    // 画面ミラーリングの配信統計を返します。
+    ScreenMirrorStats_t getScreenMirrorStats() override;
+
+    // スクリーンショットを /sd/captures に保存します。PPAがパネルのフレームバッファを横向きに回転コピーし、
+    // JPEGエンコードとSDカードへの書き込みはキャプチャタスクで非同期に行います。(hal_screen_capture.cpp で実装)
+    bool takeScreenshot(uint8_t quality) override;
+
+    // 低フレームレートの画面録画を開始します。フレームはJPEGを連結した .mjpeg ファイルになります。
+    // (hal_screen_capture.cpp で実装)
+    bool startScreenRecording(const ScreenRecordConfig_t& config) override;
+
+    // 画面録画を停止します。待ち中のフレームを書き終えてからファイルを閉じます。(hal_screen_capture.cpp で実装)
+    void stopScreenRecording() override;
+
+    // スクリーンショットと録画の統計を返します。(hal_screen_capture.cpp で実装)
+    ScreenCaptureStats_t getScreenCaptureStats() override;
+
+    // 画面の回転を固定して保存します。自動回転は停止します。(hal_auto_rotate.cpp で実装)
+    void setDisplayRotation(lv_display_rotation_t rotation) override;
+
+    // 現在の画面の回転を返します。(hal_auto_rotate.cpp で実装)
+    lv_display_rotation_t getDisplayRotation() override;
+
+    // IMUの重力方向から画面の回転を選ぶタスクを開始します。向きが一定時間続いたときだけ切り替え、
+    // 切り替えはLVGLタスクで lv_display_set_rotation() を呼ぶだけです。(hal_auto_rotate.cpp で実装)
+    bool startAutoRotate(const AutoRotateConfig_t& config) override;
+
+    // 自動回転を停止します。現在の回転はそのまま残ります。(hal_auto_rotate.cpp で実装)
+    void stopAutoRotate() override;
+
+    // 自動回転のタスクが動いているかを返します。(hal_auto_rotate.cpp で実装)
+    bool isAutoRotating() override;
+
+    // バイナリログを開始します。mooncake_log (と ESP_LOGx) の出力をPSRAMのリングへ写し、低優先度のタスクが
+    // CRC付きのセグメントとして /sd/logs に書き出します。ログ呼び出し側はSDカードの書き込みを待ちません。
+    bool startBinaryLog(const BinaryLogConfig_t& config) override;
+
+    // バイナリログを停止します。リングに残っている分は書き出してから終了します。
+    void stopBinaryLog() override;
+
+    // バイナリログの記録統計を返します。
+    BinaryLogStats_t getBinaryLogStats() override;
+
+    // 時系列ストアを開始します。センサーサービスの履歴を一定周期で平均してRAMに貯め、ブロック単位で圧縮して
+    // /sd/tsdb に書き出します。分・時間単位の集計も同時に書き、範囲の集計は必要なブロックだけを読みます。
+    bool startTimeSeries(const TimeSeriesConfig_t& config) override;
+
+    // 時系列ストアを停止します。RAMに残っているサンプルは書き出してから終了します。
+    void stopTimeSeries() override;
+
+    // 時系列ストアの記録統計を返します。
+    TimeSeriesStats_t getTimeSeriesStats() override;
+
+    // 系列にサンプルを1つ追加します。RAMにコピーするだけなので、どのタスクからでも呼べます。
+    bool timeSeriesAppend(const std::string& series, int64_t timeMs, float value) override;
+
+    // 範囲内のサンプルの件数・最小・最大・平均を返します。SDカードを読むため、LVGLタスクからは呼ばないでください。
+    bool timeSeriesQuery(const std::string& series, int64_t startMs, int64_t endMs,
+                         TimeSeriesResult_t& result) override;
+
+    // USB-Cのコンソールポート (USB Serial/JTAG) へのデータ出力を開始します。CRC付きのフレームをPSRAMのリングに積み、
+    // 送信タスクがホストの接続中に送り出します。ログのセグメントとセンサー履歴を流せます。
+    bool startUsbExport(const UsbExportConfig_t& config) override;
+
+    // データ出力を停止します。リングに残っている分は破棄されます。
+    void stopUsbExport() override;
+
+    // データ出力の統計を返します。
+    UsbExportStats_t getUsbExportStats() override;
+
+    // 1フレームをリングに積みます。任意のタスクから呼べます。リングに収まらない場合は false を返します。
+    bool usbExportWrite(uint8_t channel, const void* data, size_t size) override;
+
     // 充電ICのQuick Charge (QC)機能を有効/無効にする純粋仮想関数のオーバーライドです。
     void setChargeQcEnable(bool enable) override;
 
@@ -127,7 +477,13 @@ public:
     void sleepAndRtcWakeup() override;
 
     // カメラキャプチャを開始し、指定されたLVGLイメージキャンバスに映像を表示する純粋仮想関数のオーバーライドです。
-    void startCameraCapture(lv_obj_t* imgCanvas) override;
+    // config で解像度、ピクセルフォーマット、FPS、バッファ数、クロップ範囲を指定します。
+    // 設定を省略する HalBase のオーバーロードも派生型から呼べるように公開します。
+    using HalBase::startCameraCapture;
+    void startCameraCapture(lv_obj_t* imgCanvas, const CameraConfig_t& config) override;
+
+    // キャプチャ中のカメラを次のフレームで別の設定に切り替えます。センサーは再初期化せず、差分のレジスタのみ書き込みます。
+    bool switchCameraConfig(const CameraConfig_t& config) override;
 
     // カメラキャプチャを停止する純粋仮想関数のオーバーライドです。
     void stopCameraCapture() override;
@@ -135,6 +491,123 @@ public:
     // カメラが現在キャプチャ中かどうかを返す純粋仮想関数のオーバーライドです。
     bool isCameraCapturing() override;
 
+    // 次のフレームをハードウェアJPEGエンコーダで圧縮し、SDカードに静止画として保存します。
+    bool cameraSnapshot(const std::string& path) override;
+
+    // カメラ映像をMJPEG(AVI)としてSDカードに録画開始します。fps は録画フレームレートの上限です。
+    bool startCameraRecording(const std::string& path, uint8_t fps = 15) override;
+
+    // 録画を停止し、AVIファイルのインデックスとヘッダーを確定します。
+    void stopCameraRecording() override;
+
+    // 録画中かどうかを返します。
+    bool isCameraRecording() override;
+
+    // RAW8 キャプチャのベイヤーフレームを ISP の処理なしで DNG として SD カードに保存します。
+    // フレームは GDMA で PSRAM のリングにコピーされ、書き込みはその後ろで行われます。develop で JPEG への現像も行います。
+    bool startCameraRawCapture(const CameraRawCaptureConfig_t& config) override;
+
+    // RAW キャプチャを停止します。リングに残ったフレームが書き込まれるまで待ちます。
+    void stopCameraRawCapture() override;
+
+    // RAW キャプチャがフレームを受け取っているかどうかを返します。
+    bool isCameraRawCapturing() override;
+
+    // RAW キャプチャのフレーム数 (取得・書き込み・破棄・現像) を返します。
+    CameraRawStats_t getCameraRawStats() override;
+
+    // Wi-Fi AP経由でH.264ストリームを配信中かどうかを返します。(ポート81の /stream.h264)
+    bool isCameraStreaming() override;
+
+    // USB-CポートをUVCカメラとして有効にします。キャプチャ中のフレームをハードウェアJPEGエンコーダでMJPEGにして送ります。
+    bool startUvcCamera() override;
+
+    // UVCカメラへのフレーム供給を止めます。
+    void stopUvcCamera() override;
+
+    // ホストがUVCのビデオストリームを開いているかどうかを返します。
+    bool isUvcCameraStreaming() override;
+
+    // デジタルズームを設定します。PPAのスケーラーで毎フレーム適用されます。
+    // zoom は 1.0 から 8.0、centerX/centerY はキャプチャ窓内の正規化座標です。
+    void setCameraZoom(float zoom, float centerX = 0.5f, float centerY = 0.5f) override;
+
+    // 現在のズーム倍率を返します。
+    float getCameraZoom() override;
+
+    // プレビューの表示サイズを設定します。PPAがこのサイズへ直接縮小します。
+    void setCameraPreviewSize(uint16_t width, uint16_t height) override;
+
+    // カメラパイプラインの各ステージの処理時間 (p50/p99) とFPSを返します。
+    CameraStats_t getCameraStats() override;
+
+    // ISPがフレーム毎に計算するヒストグラム、AE輝度、AWB合計、シャープネスをコピーせずにコールバックへ渡します。
+    bool startCameraIspStats(CameraIspStatsCallback_t onStats) override;
+
+    // ISP統計のコールバックを解除します。戻った後はコールバックは呼ばれません。
+    void stopCameraIspStats() override;
+
+    // 露光時間・アナログゲイン・ホワイトバランス・CCM を手動で固定します。IPA を完全に止めることもできます。
+    bool setCameraImageControl(const CameraImageControl_t& control) override;
+
+    // センサーと ISP に最後に書き込まれた露光時間・ゲイン・ホワイトバランスを取得します。
+    bool getCameraImageState(CameraImageState_t& state) override;
+
+    // 縮小したキャプチャのブロック差分で動きを検出し、イベント毎にコールバックを呼びます。プレビューやディスプレイは不要です。
+    bool startCameraMotionDetect(const CameraMotionConfig_t& config, CameraMotionCallback_t onMotion) override;
+
+    // 動き検出を停止し、カメラタスクの終了を待ちます。
+    void stopCameraMotionDetect() override;
+
+    // 動き検出が動作中かどうかを返します。
+    bool isCameraMotionDetecting() override;
+
+    // タイムラプス撮影を開始します。撮影の合間はセンサーを停止し、AE が収束した 1 フレームを JPEG で SD に保存します。
+    bool startCameraTimelapse(const CameraTimelapseConfig_t& config) override;
+
+    // タイムラプス撮影を停止し、カメラタスクの終了を待ちます。
+    void stopCameraTimelapse() override;
+
+    // タイムラプス撮影が動作中かどうかを返します。
+    bool isCameraTimelapseRunning() override;
+
+    // タイムラプスで保存したフレーム数を返します。
+    uint32_t getCameraTimelapseShots() override;
+
+    // プレビューを縮小したフレームで検出器を別コアのタスクで実行し、結果をプレビューに描画します。
+    // 検出器には常に最新のフレームが渡され、プレビューのフレームレートは検出器の速度に影響されません。
+    bool startCameraInference(const CameraInferenceConfig_t& config, CameraDetector_t detector,
+                              CameraDetectionCallback_t onDetections) override;
+
+    // 推論を停止し、推論タスクの終了を待ちます。描画中の結果も消去されます。
+    void stopCameraInference() override;
+
+    // 検出器の実行レート（回/秒）を返します。停止中は 0 です。
+    float getCameraInferenceFps() override;
+
+    // RAW8 キャプチャの Bayer 面を 2x2 でビニングしたグレー画像で QR コードやバーコードを別コアのタスクで読み取ります。
+    // 画像が変化している間とその後の数フレームだけデコードし、結果は EVENT_TOPIC_BARCODE として発行されます。
+    bool startCameraBarcodeScan(const CameraBarcodeConfig_t& config) override;
+
+    // バーコードの読み取りを停止し、タスクの終了を待ちます。
+    void stopCameraBarcodeScan() override;
+
+    // バーコードの読み取りが動作中かどうかを返します。
+    bool isCameraBarcodeScanning() override;
+
+    // 最後に発行されたバーコードを返します。
+    CameraBarcode_t getCameraBarcode() override;
+
+    // キャプチャしたフレームを参照カウント付きのハンドルで受け取る購読者を登録します。V4L2バッファは最後の
+    // ハンドルが解放されたときにドライバーへ戻り、取りこぼしは購読者ごとの設定で決まります。(hal_camera.cpp で実装)
+    int subscribeCameraFrames(const CameraFrameSubscriberConfig_t& config, CameraFrameCallback_t onFrame) override;
+
+    // フレームの購読を解除します。渡し済みのハンドルは有効なままです。(hal_camera.cpp で実装)
+    void unsubscribeCameraFrames(int id) override;
+
+    // 購読者ごとの受け取ったフレーム数と取りこぼした数を返します。(hal_camera.cpp で実装)
+    CameraFrameSubscriberStats_t getCameraFrameSubscriberStats(int id) override;
+
     // スピーカーの音量を設定する純粋仮想関数のオーバーライドです。
     // volume は 0 から 100 の範囲で指定します。
     void setSpeakerVolume(uint8_t volume) override;
@@ -148,7 +621,59 @@ public:
 
     // 指定された音声データをスピーカーから再生する純粋仮想関数のオーバーライドです。
     // asyncがtrueの場合、非同期で再生します。
-    void audioPlay(std::vector<int16_t>& data, bool async = true) override;
+    // ミキサーのボイスとして再生されるため、再生中の音と重ねて鳴らせます。volumeはボイスごとの音量です。
+    void audioPlay(std::vector<int16_t>& data, bool async = true, uint8_t volume = 100) override;
+
+    // コピーせずに非同期で再生します。dataは再生が終わるまで有効である必要があります。
+    void audioPlayBuffer(const int16_t* data, size_t size, uint8_t volume = 100) override;
+
+    // ミキサーのウェーブテーブル音源で音符を鳴らします。音符ごとのヒープ確保はありません。
+    void audioPlayNotes(const AudioNote_t* notes, size_t count) override;
+
+    // I2S DMAのバッファ構成を設定に保存します。次回起動時に反映されます。(hal_audio.cpp で実装)
+    bool setAudioDmaProfile(AudioDmaProfile_t profile) override;
+
+    // 保存されているDMAプロファイルを返します。(hal_audio.cpp で実装)
+    AudioDmaProfile_t getAudioDmaProfile() override;
+
+    // 動作中のDMA構成と、アンダーラン・オーバーランの回数を取得します。(hal_audio.cpp で実装)
+    AudioDmaStats_t getAudioDmaStats() override;
+
+    // マイクの連続キャプチャを開始します。専用タスクがTDMブロックを読み続け、
+    // 選択したチャンネルを間引き後にコールバックとロックフリーのリングバッファへ渡します。
+    bool startAudioCapture(const AudioCaptureConfig_t& config, AudioCaptureCallback_t onBlock = nullptr) override;
+
+    // 連続キャプチャを停止し、キャプチャタスクの終了を待ちます。
+    void stopAudioCapture() override;
+
+    // 連続キャプチャ中かどうかを返します。
+    bool isAudioCapturing() override;
+
+    // リングバッファからフレームを取り出します。ブロックしません。
+    size_t readAudioCapture(int16_t* data, size_t maxFrames) override;
+
+    // 16kHzの全二重音声キャプチャを開始します。AECスロットを参照にエコーキャンセルとノイズ抑制を行います。
+    // 停止は stopAudioCapture() です。
+    bool startVoiceCapture(const AudioVoiceConfig_t& config, AudioCaptureCallback_t onBlock = nullptr) override;
+
+    // マイク入力をSDカードのWAVファイルへ録音します。キャプチャのリングから読み出し、ワーカータスクで
+    // IMA-ADPCMに圧縮して大きなブロック単位で書き込みます。(hal_audio_recorder.cpp で実装)
+    bool startAudioRecorder(const AudioRecorderConfig_t& config) override;
+
+    // リングに残ったフレームを書き出し、ヘッダを確定してから録音を停止します。(hal_audio_recorder.cpp で実装)
+    void stopAudioRecorder() override;
+
+    // 録音の状態を取得します。(hal_audio_recorder.cpp で実装)
+    AudioRecorderStatus_t getAudioRecorderStatus() override;
+
+    // 1つのマイクを低いレートで取り込み、音声を検出するとプリロール付きでコールバックを呼びます。(hal_audio_capture.cpp で実装)
+    bool startAudioListening(const AudioListenConfig_t& config, AudioListenCallback_t onVoice) override;
+
+    // 待ち受けを停止します。(hal_audio_capture.cpp で実装)
+    void stopAudioListening() override;
+
+    // 待ち受け中かどうかを返します。(hal_audio_capture.cpp で実装)
+    bool isAudioListening() override;
 
     // デュアルマイクの録音テストを開始する純粋仮想関数のオーバーライドです。
     void startDualMicRecordTest() override;
@@ -171,6 +696,21 @@ public:
     // 音楽再生テストを停止する純粋仮想関数のオーバーライドです。
     void stopPlayMusicTest() override;
 
+    // SD カードの音楽ファイルを再生キューに追加します。
+    bool queueMusic(const std::string& path) override;
+
+    // 再生中の曲をスキップして次の曲を再生します。
+    void skipMusic() override;
+
+    // 再生キューを空にします。
+    void clearMusicQueue() override;
+
+    // 再生キューの一覧を取得します。
+    std::vector<std::string> getMusicQueue() override;
+
+    // 再生中の曲のパスを取得します。
+    std::string getPlayingMusic() override;
+
     // 起動時の効果音を再生する純粋仮想関数のオーバーライドです。
     void playStartupSfx() override;
 
@@ -186,25 +726,152 @@ public:
     // Wi-Fiアクセスポイントモードを開始する純粋仮想関数のオーバーライドです。
     void startWifiAp() override;
 
-    // SDカードがマウントされているかどうかを返す純粋仮想関数のオーバーライドです。
+    // Wi-Fiステーションの認証情報をNVSに保存します。キャッシュしたBSSIDとチャンネルは破棄されます。
+    bool setWifiCredentials(const std::string& ssid, const std::string& password) override;
+
+    // NVSに保存された認証情報とAPのキャッシュを削除します。
+    void clearWifiCredentials() override;
+
+    // 認証情報がNVSに保存されているかどうかを返します。
+    bool hasWifiCredentials() override;
+
+    // 保存された認証情報でステーション接続を開始します。切断後はバックオフしながら再接続を続けます。
+    bool startWifiSta() override;
+
+    // ステーション接続を停止します。
+    void stopWifiSta() override;
+
+    // ステーションの接続状態、IP、RSSI、直近の接続時間を返します。
+    WifiStatus_t getWifiStatus() override;
+
+    // ESP32-C6とのSDIO接続ピンの駆動能力を設定し、設定ストアに保存します。(0-3)
+    bool setWifiLinkDrive(uint8_t level) override;
+
+    // SDIO接続ピンの現在の駆動能力を返します。
+    uint8_t getWifiLinkDrive() override;
+
+    // iperf互換のTCP/UDPスループット計測を共有ワーカープールで開始します。駆動能力を順に変えて計測することもできます。
+    bool startWifiBenchmark(const WifiBenchmarkConfig_t& config) override;
+
+    // 直近のスループット計測の結果を返します。
+    WifiBenchmarkResult_t getWifiBenchmarkResult() override;
+
+    // SDカードがマウントされているかどうかを返します。挿抜はSDカードタスクが監視しています。
     bool isSdCardMounted() override;
 
     // SDカードの指定されたディレクトリパス内のファイルとディレクトリのリストをスキャンして返す純粋仮想関数のオーバーライドです。
     std::vector<FileEntry_t> scanSdCard(const std::string& dirPath) override;
 
-    // USB Type-Cポートの接続状態を検出する純粋仮想関数のオーバーライドです。
+    // ディレクトリの読み出しをSDカードタスクで開始し、pageSize件ずつのページに分けて渡します。スキャンIDを返します。
+    uint32_t startSdCardScan(const std::string& dirPath, size_t pageSize) override;
+
+    // 現在のスキャンの次のページを取り出します。まだ無ければfalseを返し、ブロックしません。
+    bool getSdCardScanPage(SdCardScanPage_t& page) override;
+
+    // 実行中のスキャンを中止し、未読のページを破棄します。
+    void cancelSdCardScan() override;
+
+    // SDカードの逐次/ランダム読み書きベンチマークをバックグラウンドタスクで開始します。
+    // 一時ファイルに64バイト境界のDMAバッファから書き込み、MB/sとIOPSを測ります。
+    bool startSdCardBenchmark(const SdCardBenchmarkConfig_t& config) override;
+
+    // ベンチマークの状態と結果を返します。
+    SdCardBenchmarkResult_t getSdCardBenchmarkResult() override;
+
+    // SDカードのJPEGをハードウェアデコーダで開き、先読みとサムネイルキャッシュを始めます。(hal_gallery.cpp で実装)
+    bool openGallery(const std::vector<std::string>& paths, const GalleryConfig_t& config) override;
+
+    // ギャラリーのタスクを止め、デコード済みの画像を解放します。(hal_gallery.cpp で実装)
+    void closeGallery() override;
+
+    // 表示中の画像を設定します。前後の画像が続けて先読みされます。(hal_gallery.cpp で実装)
+    void setGalleryIndex(int32_t index) override;
+
+    // デコード済みの画像を取得します。(hal_gallery.cpp で実装)
+    GalleryItemState_t getGalleryPicture(size_t index, GalleryPicture_t& picture) override;
+
+    // サムネイルを取得します。未作成の場合は作成を依頼します。(hal_gallery.cpp で実装)
+    GalleryItemState_t getGalleryThumbnail(size_t index, GalleryPicture_t& thumbnail) override;
+
+    // ギャラリーのデコード回数とキャッシュのヒット数を返します。(hal_gallery.cpp で実装)
+    GalleryStats_t getGalleryStats() override;
+
+    // SDカードのMJPEG (AVI) 動画を再生します。読み出しタスクが先読みしながら分離し、ハードウェアデコーダと
+    // PPAでキャンバスの大きさのフレームにして、ビデオプレーンで表示します。PCM音声はミキサーで再生し、
+    // その再生位置に映像を合わせます。(hal_video_player.cpp で実装)
+    bool startVideoPlayback(const std::string& path, const VideoPlayerConfig_t& config) override;
+
+    // 再生のタスクを止め、表示中のフレームをキャンバスのバッファに戻します。(hal_video_player.cpp で実装)
+    void stopVideoPlayback() override;
+
+    // 再生の状態と表示・破棄したフレーム数を返します。(hal_video_player.cpp で実装)
+    VideoPlayerStats_t getVideoPlayerStats() override;
+
+    // USB-AポートのUSBメモリが /usb にマウントされているかどうかを返します。
+    bool isUsbDriveMounted() override;
+
+    // マウント中のUSBメモリのマウントポイントを返します。ハブ経由の2台目以降は /usb1 から順に使われます。
+    std::vector<std::string> getUsbDriveMountPoints() override;
+
+    // ファイルまたはディレクトリツリーをバックグラウンドでコピーします。2つのDMA対応バッファで読み出しと書き込みを重ねます。
+    bool startFileCopy(const std::string& srcPath, const std::string& dstPath) override;
+
+    // 実行中のコピーを中止します。書きかけのファイルは削除されます。
+    void cancelFileCopy() override;
+
+    // コピーの進捗を返します。
+    FileCopyProgress_t getFileCopyProgress() override;
+
+    // USB CDC-ACMシリアルデバイスの接続状態、送受信、ボーレート設定です。(hal_usb_cdc.cpp で実装)
+    bool isUsbSerialConnected(int port) override;
+    size_t usbSerialWrite(int port, const void* data, size_t size) override;
+    size_t usbSerialRead(int port, void* data, size_t size) override;
+    bool setUsbSerialBaudRate(int port, uint32_t baudRate) override;
+
+    // USB Type-Cポートの接続状態を返します。ポート状態サービスがキャッシュした値なのでI2C転送は行いません。
     bool usbCDetect() override;
 
     // USB Type-Aポートの接続状態を検出する純粋仮想関数のオーバーライドです。
     bool usbADetect() override;
 
-    // ヘッドフォンジャックの接続状態を検出する純粋仮想関数のオーバーライドです。
+    // ヘッドフォンジャックの接続状態を返します。ポート状態サービスがキャッシュした値なのでI2C転送は行いません。
     bool headPhoneDetect() override;
 
     // I2Cバスをスキャンし、接続されているデバイスのアドレスリストを返す純粋仮想関数のオーバーライドです。
     // isInternalがtrueの場合は内部I2Cバスを、falseの場合は外部I2Cバス (Port A) をスキャンします。
     std::vector<uint8_t> i2cScan(bool isInternal) override;
 
+    // I2Cバスのスキャンをバックグラウンドタスクで開始します。アドレスごとに短いタイムアウトでプローブし、
+    // 見つかったアドレスは getI2cScanProgress() で順次取得できます。Port A は必要なら初期化し、そのまま残します。
+    uint32_t startI2cScan(bool isInternal) override;
+
+    // 実行中または最後のスキャンの進捗をコピーします。スキャンを一度も開始していない場合はfalseを返します。
+    bool getI2cScanProgress(I2cScanProgress_t& progress) override;
+
+    // 実行中のスキャンを中断し、タスクの終了を待ちます。
+    void cancelI2cScan() override;
+
+    // 内部I2Cバスのデバイスごとの待ち時間・転送時間の統計を取得します。
+    std::vector<I2cDeviceStats_t> getI2cStats() override;
+
+    // 内部I2Cバスのスケジューラです。タッチ > コーデック > センサー > 診断 の優先度で順番を割り当てます。
+    // タスクからも参照できるように静的関数で提供します。
+    static I2cBusScheduler& i2cScheduler();
+
+    // タッチのレポートをインクへ渡します。LVGLのタッチ読み出しコールバックから呼ぶため、静的関数で提供します。
+    // 座標はパネル座標です。(hal_ink.cpp で実装)
+    static void inkProcessTouch(bool isPressed, int32_t x, int32_t y);
+
+    // 輝度や音量などの設定を保持するストアです。セッターから値を記録するため、静的関数で提供します。(hal_settings.cpp で実装)
+    static SettingsStore& settingsStore();
+
+    // 動画プレーヤーの音声トラックをミキサーのストリームへ流します。プレーヤーのタスクから呼ぶため、静的関数で提供します。
+    // videoAudioClockUs() は再生中の位置です。(hal_audio.cpp で実装)
+    static bool videoAudioBegin(uint32_t sampleRate, uint8_t channels, uint8_t volume);
+    static size_t videoAudioWrite(const int16_t* data, size_t frames);
+    static void videoAudioEnd();
+    static int64_t videoAudioClockUs();
+
     // Port A のI2Cインターフェースを初期化する純粋仮想関数のオーバーライドです。
     void initPortAI2c() override;
 
@@ -220,26 +887,335 @@ public:
     // 指定されたGPIOピンをリセット (通常はLowレベルに設定) する純粋仮想関数のオーバーライドです。
     void gpioReset(uint8_t pin) override;
 
+    // RMTのTXチャネルでピンにパターンを出力します。チャネルメモリに収まるものはループ、長いものはDMAで一回だけ送ります。(hal_gpio_waveform.cpp で実装)
+    bool startGpioPattern(const GpioWaveformConfig_t& config, const std::vector<GpioWaveformStep_t>& steps) override;
+
+    // 1周期を1シンボルに収めたPWMを停止するまでループ出力します。
+    bool startGpioPwm(uint8_t pin, uint32_t frequencyHz, float duty) override;
+
+    // RMTチャネルを解放し、ピンをアイドルレベルの通常出力に戻します。
+    void stopGpioWaveform(uint8_t pin) override;
+
+    // 波形出力の状態を取得します。
+    GpioWaveformStatus_t getGpioWaveformStatus(uint8_t pin) override;
+
+    // PARLIO RXで最大8本のピンを同時にサンプリングし、DMAでPSRAMのリングに書き込みます。(hal_logic_capture.cpp で実装)
+    bool startLogicCapture(const LogicCaptureConfig_t& config) override;
+
+    // サンプリングを停止し、リングを解放します。
+    void stopLogicCapture() override;
+
+    // サンプリングの状態 (実際のサンプルレート、累計サンプル数) を取得します。
+    LogicCaptureStatus_t getLogicCaptureStatus() override;
+
+    // 直近のサンプルをバケットごとのAND/OR (最小/最大) に間引きます。
+    uint32_t getLogicEnvelope(uint32_t windowSamples, std::vector<uint8_t>& min, std::vector<uint8_t>& max) override;
+
+    // TCA8418のイベントFIFOを割り込みで読み出し、ロックフリーのリング経由でキーパッド入力デバイスに渡します。(hal_keypad.cpp で実装)
+    bool startKeypad(const KeypadConfig_t& config) override;
+
+    // キーパッドサービスを停止し、入力デバイスとPort Aを解放します。
+    void stopKeypad() override;
+
+    // キーパッドサービスが動作中かどうかを返します。
+    bool isKeypadRunning() override;
+
+    // キーリピートの開始までの時間と間隔を変更します。
+    void setKeypadRepeat(uint16_t delayMs, uint16_t intervalMs) override;
+
+    // キーパッドのイベント数、リピート数、取りこぼし数を取得します。
+    KeypadStats_t getKeypadStats() override;
+
+    // Port Aのアドレスを調べて登録済みのドライバを割り当て、1つのタスクでまとめてポーリングします。(hal_ext_sensor.cpp で実装)
+    bool startExtSensors() override;
+
+    // ポーリングを停止し、デバイスとPort Aを解放します。(hal_ext_sensor.cpp で実装)
+    void stopExtSensors() override;
+
+    // 外部センサーのポーリングが動作中かどうかを返します。(hal_ext_sensor.cpp で実装)
+    bool isExtSensorsRunning() override;
+
+    // 割り当てられたユニットの一覧と読み出し回数を取得します。(hal_ext_sensor.cpp で実装)
+    std::vector<ExtSensorInfo_t> getExtSensors() override;
+
+    // ユニットの最新の読み値をスナップショットからコピーします。(hal_ext_sensor.cpp で実装)
+    bool readExtSensor(size_t index, ExtSensorReading_t& reading, uint32_t* timeMs = nullptr) override;
+
+    // UARTモニターの送信をRS485の送信リングに直接書き込みます。
+    void uartMonitorSend(std::string msg, bool newLine = true) override;
+
+    // RS485ポートをイベントキュー付きで再設定します。フレームはアイドル時間またはパターン文字で区切られます。
+    bool setRs485Config(const Rs485Config_t& config, Rs485FrameCallback_t onFrame = nullptr) override;
+
+    // RS485の送信リングに複数バイトを書き込みます。
+    size_t rs485Write(const uint8_t* data, size_t size) override;
+
+    // RS485の送受信統計を返します。
+    Rs485Stats_t getRs485Stats() override;
+
+    // RS485ポート上でModbus RTUのマスターまたはスレーブを開始します。フレーム間隔はUARTの受信タイムアウトで検出し、
+    // マスターはポーリング表を固定周期で実行して結果を共有データに書き込みます。
+    bool startModbus(const ModbusConfig_t& config) override;
+
+    // Modbusを停止し、RS485ポートをモニターモードに戻します。
+    void stopModbus() override;
+
+    // Modbusが動作中かどうかを返します。
+    bool isModbusRunning() override;
+
+    // マスターモードで、次のポーリングより先に送信するレジスタ書き込みをキューに追加します。
+    bool modbusWriteRegisters(uint8_t slaveId, uint16_t address, const std::vector<uint16_t>& values) override;
+
+    // スレーブモードのレジスタマップに値を設定します。
+    void setModbusSlaveRegister(uint16_t address, uint16_t value) override;
+
+    // スレーブモードのレジスタマップから値を取得します。
+    uint16_t getModbusSlaveRegister(uint16_t address) override;
+
+    // Modbusの送受信統計を返します。
+    ModbusStats_t getModbusStats() override;
+
+    // RS485ポートとTCPクライアント1台をつなぐ透過ゲートウェイを開始します。UARTの受信タイムアウトで区切ったフレームを
+    // RS485タスクのバッファからそのまま send() し、クライアントからの受信は送信リングへ直接書き込みます。(hal_rs485_gateway.cpp で実装)
+    bool startRs485Gateway(const Rs485GatewayConfig_t& config) override;
+
+    // ゲートウェイを停止し、RS485ポートをモニターモードに戻します。(hal_rs485_gateway.cpp で実装)
+    void stopRs485Gateway() override;
+
+    // ゲートウェイが動作中かどうかを返します。(hal_rs485_gateway.cpp で実装)
+    bool isRs485GatewayRunning() override;
+
+    // ゲートウェイの転送統計を返します。(hal_rs485_gateway.cpp で実装)
+    Rs485GatewayStats_t getRs485GatewayStats() override;
+
+    // 計測サイクルの設定をNVSに保存し、RTCタイマーを設定して電源を切ります。以降はタイマーで起床するたびに計測します。
+    bool startDutyCycle(const DutyCycleConfig_t& config) override;
+
+    // チップ温度センサーを定期的に読み、フィルターと傾向を thermalSnapshot に発行するタスクを開始します。
+    // しきい値を超えるとカメラのFPS・画面の更新周期・CPU周波数を段階的に制限し、EVENT_TOPIC_THERMAL を発行します。
+    bool startThermalService(const ThermalConfig_t& config) override;
+
+    // 温度サービスを停止し、制限をすべて解除します。
+    void stopThermalService() override;
+
+    // 温度サービスが動作中かどうかを返します。
+    bool isThermalServiceRunning() override;
+
+    // 固件更新の状態と、動作中のイメージのバージョン・パーティションを返します。
+    OtaStatus_t getOtaStatus() override;
+
+    // 動作中のイメージを無効にして、前のイメージで再起動します。前のイメージがなければ false を返します。
+    bool rollbackFirmware() override;
+
+    // サンプリングプロファイラを開始します。各コアのタイマー割り込みで割り込まれたPCとタスクをPSRAMの
+    // リングバッファに記録します。
+    bool startProfiler(const ProfilerConfig_t& config) override;
+
+    // サンプリングプロファイラを停止します。記録済みのサンプルは次の開始まで残ります。
+    void stopProfiler() override;
+
+    // プロファイラのサンプル数と割り込みの平均処理時間を返します。
+    ProfilerStats_t getProfilerStats() override;
+
+    // タスクとPCごとのサンプル数をファイルに書き出します。パスが空の場合はコンソールに出力します。
+    bool exportProfile(const std::string& path) override;
+
+    // イベントトレースの記録を開始します。LVGL・カメラ・I2S・I2Cのトレースポイントがコアごとのリングに記録されます。
+    bool startEventTrace(const EventTraceConfig_t& config) override;
+
+    // イベントトレースの記録を停止します。記録済みのイベントは次の開始まで残ります。
+    void stopEventTrace() override;
+
+    // イベントトレースの記録状態とイベント数を返します。
+    EventTraceStats_t getEventTraceStats() override;
+
+    // トレースをPerfettoで読めるJSONでファイルに書き出します。パスが空の場合はコンソールに出力します。
+    bool exportEventTrace(const std::string& path) override;
+
+    // app::Update() と lv_timer_handler() の実行時間を監視し、しきい値を超えたタスクのバックトレースを記録します。
+    bool startStallMonitor(const StallMonitorConfig_t& config) override;
+
+    // ストール監視を停止します。
+    void stopStallMonitor() override;
+
+    // 検出したストールの数、区間ごとの最長時間、最後のレポートを返します。
+    StallMonitorStats_t getStallMonitorStats() override;
+
+    // 監視対象の区間の開始と終了を記録します。区間を実行するタスクから呼ばれます。
+    void markUiSection(UiSection_t section, bool isBegin) override;
+
 private:
+    // 起動の最初に呼ばれます。計測サイクル中のRTCタイマーによる起床なら、必要なセンサーだけで計測し、
+    // SDカードに記録して電源を切ります (戻りません)。電源ボタンでの起動ならサイクルを終了して戻ります。
+    void duty_cycle_wake();
+
     // GPIOピンの出力駆動能力を設定するプライベートヘルパー関数です。
     void set_gpio_output_capability();
 
     // HID (Human Interface Device) 関連の初期化を行うプライベートヘルパー関数です。
-    // USBキーボードやマウスなどの接続を処理します。
+    // ブートキーボード・マウスとレポートプロトコルのポインターを、ロックフリーのキューでLVGLに渡します。
     void hid_init();
 
-    // RS485通信の初期化を行うプライベートヘルパー関数です。
-    void rs485_init();
+    // USBマスストレージのホストドライバーを登録するプライベートヘルパー関数です。接続されたUSBメモリを /usb にマウントします。
+    void usb_msc_init();
+
+    // USB CDC-ACMのホストドライバーを登録するプライベートヘルパー関数です。専用のタスクでデバイスを開きます。
+    void usb_cdc_init();
+
+    // RS485のUARTドライバーと受信タスクを保存済みの設定で立ち上げます。claimPeripheral() から呼ばれます。
+    bool rs485_power_up();
+
+    // RS485のUARTドライバーと受信タスクを解放します。設定は次の立ち上げのために残ります。
+    void rs485_power_down();
+
+    // USBホストとHID・USBメモリのドライバーを立ち上げます。HIDタスクは停止できないため、一度立ち上げたら残ります。
+    bool usb_host_power_up();
+
+    // 周辺機器ごとの立ち上げと電源断です。電源断できない周辺機器では false を返します。(hal_peripherals.cpp で実装)
+    bool peripheral_power_up(Peripheral_t peripheral);
+    bool peripheral_power_down(Peripheral_t peripheral);
+
+    // タッチ割り込みで起床する読み出しタスクとLVGLの入力デバイスを作成するプライベートヘルパー関数です。
+    void touch_init();
+
+    // 指が離れるまでタッチをLVGLに渡さないようにするプライベートヘルパー関数です。スリープからの復帰に使います。
+    void suppress_touch_until_release();
 
     // Wi-Fi関連の初期化を行うプライベートヘルパー関数です。
     bool wifi_init();
 
-    // IMU (慣性計測ユニット) の初期化を行うプライベートヘルパー関数です。
+    // SDIO接続ピンに _wifi_link_drive の駆動能力を設定します。(hal_wifi_benchmark.cpp で実装)
+    void apply_wifi_link_drive();
+
+    // _audio_dma_profile のバッファ構成をBSPに渡します。I2Sの初期化前に呼びます。(hal_audio.cpp で実装)
+    void apply_audio_dma_profile();
+
+    // 回転を保存し、LVGLタスクで画面に反映します。自動回転のタスクからも呼ばれます。(hal_auto_rotate.cpp で実装)
+    void apply_display_rotation(lv_display_rotation_t rotation);
+
+    // IMU (慣性計測ユニット) の初期化を行うプライベートヘルパー関数です。BMI270 と ICM20602 のどちらが載っているかを検出します。
     void imu_init();
 
     // システム時刻をRTCから読み出して更新するプライベートヘルパー関数です。
     void update_system_time();
 
+    // SDカードが未マウントであればマウントするプライベートヘルパー関数です。
+    bool mount_sd_card();
+
+    // アセットパーティションのヘッダーとインデックスを検証し、パック全体をメモリマップします。(hal_asset_pack.cpp で実装)
+    void asset_pack_init();
+
+    // NVSから設定をまとめて読み出してメンバーに反映し、書き込みタスクを開始します。(hal_settings.cpp で実装)
+    void settings_init();
+
+    // SDカードの常駐マウントと挿抜の監視、非同期スキャンを行うタスクを開始します。(hal_sd_card.cpp で実装)
+    void sd_card_init();
+
+    // SDカードタスクのエントリと本体です。(hal_sd_card.cpp で実装)
+    static void sd_card_task(void* param);
+    void sd_card_loop();
+
+    // IOエキスパンダの割り込み線 (未配線の場合はポーリング) でUSB-C・ヘッドフォンの検出入力を監視し、
+    // USB-Aと合わせてチャタリング除去した変化を GetEventBus() に発行するタスクを開始します。
+    // (hal_port_state.cpp で実装)
+    void port_state_init();
+
+    // ポート状態タスクのエントリと本体です。(hal_port_state.cpp で実装)
+    static void port_state_task(void* param);
+    void port_state_loop();
+
+    // IOエキスパンダ出力のシャドウレジスタの変更をポート状態タスクに知らせ、
+    // 次のティックでチップごとに1回の書き込みにまとめます。
+    // タスク開始前 (起動中) は bsp_set_* がその場で書き込むため何もしません。(hal_port_state.cpp で実装)
+    void io_expander_commit();
+
+    // 音楽再生タスクが終了するまでブロックするプライベートヘルパー関数です。
+    void wait_music_idle();
+
+    // INA226から電源モニターのデータを読み出すプライベートヘルパー関数です。
+    void read_power_monitor_data(PMData_t& data);
+
+    // IMUのデータを読み出すプライベートヘルパー関数です。ストリーム中はバス転送を行いません。
+    void read_imu_data(IMUData_t& data);
+
+    // DFSと自動ライトスリープを設定し、性能レベル用のPMロックを作成するプライベートヘルパー関数です。
+    void power_policy_init();
+
+    // 設定された輝度にポリシーの減光と周囲の明るさを反映して、PWMに書き込みます。(hal_backlight.cpp で実装)
+    void backlight_apply(uint16_t fadeMs);
+
+    // バックライトのポリシータスクのエントリと本体です。(hal_backlight.cpp で実装)
+    static void backlight_policy_task(void* param);
+    void backlight_policy_loop();
+
+    // DFSの上限周波数を制限します。0 で既定の上限に戻します。温度サービスから呼ばれます。(hal_power_policy.cpp で実装)
+    void power_policy_set_cpu_cap(uint16_t mhz);
+
+    // カメラのプレビューのFPSを制限します。0 で設定どおりに戻します。温度サービスから呼ばれます。(hal_camera.cpp で実装)
+    void camera_set_fps_cap(uint8_t fps);
+
+    // 更新直後の初回起動なら、起動完了をもってイメージを確定し、ロールバックを取り消します。(hal_ota.cpp で実装)
+    void ota_confirm_boot();
+
+    // 温度サービスタスクのエントリと本体、レベルに応じた制限の適用です。(hal_thermal.cpp で実装)
+    static void thermal_service_task(void* param);
+    void thermal_service_loop();
+    void thermal_apply_level(ThermalLevel_t level);
+
+    // 電源プロファイル記録タスクのエントリと本体です。(hal_power_profile.cpp で実装)
+    static void power_profile_task(void* param);
+    void power_profile_loop();
+
+    // センサーサービスタスクのエントリと本体です。(hal_sensor_service.cpp で実装)
+    static void sensor_service_task(void* param);
+    void sensor_service_loop();
+
+    // 壁時計サービスタスクのエントリと本体、RTCとの再同期です。(hal_clock.cpp で実装)
+    static void clock_service_task(void* param);
+    void clock_service_loop();
+    bool clock_resync(int64_t lastSyncUs, float& driftPpm);
+
+    // 時刻が設定されたときに、次のループで再同期させます。
+    void clock_service_request_resync();
+
+    // getSystemStats()の本体です。withTasks がfalseの場合はヒープのみを読みます。(hal_system.cpp で実装)
+    SystemStats_t sample_system_stats(SystemStatsWindow_t window, bool withTasks);
+
+    // テレメトリタスクのエントリと本体です。(hal_telemetry.cpp で実装)
+    static void telemetry_task(void* param);
+    void telemetry_loop();
+
+    // MQTTパブリッシャータスクのエントリと本体です。(hal_mqtt.cpp で実装)
+    static void mqtt_task(void* param);
+    void mqtt_loop();
+
+    // BLEテレメトリタスクのエントリと本体です。(hal_ble.cpp で実装)
+    static void ble_telemetry_task(void* param);
+    void ble_telemetry_loop();
+
+    // 画面ミラーリングタスクのエントリと本体です。(hal_mirror.cpp で実装)
+    static void screen_mirror_task(void* param);
+    void screen_mirror_loop();
+
+    // バイナリログ書き込みタスクのエントリと本体です。(hal_binary_log.cpp で実装)
+    static void binary_log_task(void* param);
+    void binary_log_loop();
+
+    // 時系列ストアの記録タスクのエントリと本体です。(hal_time_series.cpp で実装)
+    static void time_series_task(void* param);
+    void time_series_loop();
+
+    // USBデータ出力の送信タスクのエントリと本体です。(hal_usb_export.cpp で実装)
+    static void usb_export_task(void* param);
+    void usb_export_loop();
+
+    // ストール監視タスクのエントリと本体です。(hal_stall_monitor.cpp で実装)
+    static void stall_monitor_task(void* param);
+    void stall_monitor_loop();
+
+    // I2Cスキャンの本体です。共有ワーカープールのジョブとして実行されます。(hal_i2c_scan.cpp で実装)
+    void i2c_scan_loop();
+
     // 現在のLCDバックライト輝度を保持するメンバー変数です。(0-100)
     uint8_t _current_lcd_brightness = 100;
 
@@ -258,7 +1234,19 @@ private:
     // 外部アンテナの有効/無効状態を保持するメンバー変数です。
     bool _ext_antenna_enable        = false;
 
-    // SDカードがマウントされているかどうかの状態を保持するメンバー変数です。
-    bool _sd_card_mounted           = false;
+    // ESP32-C6とのSDIO接続ピンの駆動能力を保持するメンバー変数です。(0-3)
+    uint8_t _wifi_link_drive        = 0;
+
+    // 保存されているI2S DMAプロファイルを保持するメンバー変数です。
+    uint8_t _audio_dma_profile      = AUDIO_DMA_MUSIC;
+
+    // 保存されている画面の回転 (lv_display_rotation_t) を保持するメンバー変数です。
+    uint8_t _display_rotation       = LV_DISPLAY_ROTATION_90;
+
+    // 起動時に自動回転を開始するかを保持するメンバー変数です。
+    bool _auto_rotate               = true;
+
+    // 自動回転で選べる回転のビットマスクを保持するメンバー変数です。
+    uint8_t _auto_rotate_mask       = AutoRotateConfig_t().rotationMask;
 };
 
@@ -0,0 +1,137 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "aligned_file_writer.h"
+#include <algorithm>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <esp_log.h>
+#include <esp_heap_caps.h>
+
+static const char* TAG = "aligned-file";
+
+// Cache line of the ESP32-P4, the SDMMC DMA reads from it without a bounce copy
+static constexpr size_t _buffer_align = 64;
+
+struct AlignedFile_t {
+    int fd           = -1;
+    uint8_t* block   = nullptr;
+    size_t blockSize = 0;
+    // Bytes gathered in the block
+    size_t fill = 0;
+    // Position written by the caller, the file itself lags by fill
+    off_t pos = 0;
+};
+
+static void free_aligned_file(AlignedFile_t* ctx)
+{
+    if (ctx->fd >= 0) {
+        close(ctx->fd);
+    }
+    heap_caps_free(ctx->block);
+    delete ctx;
+}
+
+static bool flush_block(AlignedFile_t* ctx)
+{
+    size_t done = 0;
+    while (done < ctx->fill) {
+        ssize_t ret = write(ctx->fd, ctx->block + done, ctx->fill - done);
+        if (ret <= 0) {
+            ESP_LOGE(TAG, "write failed");
+            return false;
+        }
+        done += ret;
+    }
+    ctx->fill = 0;
+    return true;
+}
+
+static ssize_t aligned_file_write(void* cookie, const char* buf, size_t size)
+{
+    auto ctx    = (AlignedFile_t*)cookie;
+    size_t done = 0;
+    while (done < size) {
+        size_t bytes = std::min(size - done, ctx->blockSize - ctx->fill);
+        memcpy(ctx->block + ctx->fill, buf + done, bytes);
+        ctx->fill += bytes;
+        done += bytes;
+        if (ctx->fill == ctx->blockSize && !flush_block(ctx)) {
+            return -1;
+        }
+    }
+    ctx->pos += size;
+    return size;
+}
+
+// Writers only seek back to patch a header before closing, the blocks after that are no longer aligned
+static int aligned_file_seek(void* cookie, off_t* offset, int whence)
+{
+    auto ctx = (AlignedFile_t*)cookie;
+
+    // ftell
+    if (whence == SEEK_CUR && *offset == 0) {
+        *offset = ctx->pos;
+        return 0;
+    }
+
+    if (!flush_block(ctx)) {
+        return -1;
+    }
+    off_t target = whence == SEEK_CUR ? ctx->pos + *offset : *offset;
+    off_t ret    = lseek(ctx->fd, target, whence == SEEK_CUR ? SEEK_SET : whence);
+    if (ret < 0) {
+        return -1;
+    }
+    ctx->pos = ret;
+    *offset  = ret;
+    return 0;
+}
+
+static int aligned_file_close(void* cookie)
+{
+    auto ctx = (AlignedFile_t*)cookie;
+    int ret  = flush_block(ctx) ? 0 : -1;
+    if (fsync(ctx->fd) != 0) {
+        ret = -1;
+    }
+    free_aligned_file(ctx);
+    return ret;
+}
+
+FILE* aligned_file_fopen(const char* path, size_t blockSize)
+{
+    auto ctx       = new AlignedFile_t;
+    ctx->blockSize = (blockSize + _buffer_align - 1) / _buffer_align * _buffer_align;
+    ctx->fd        = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    ctx->block =
+        (uint8_t*)heap_caps_aligned_alloc(_buffer_align, ctx->blockSize, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    if (ctx->block == nullptr) {
+        ctx->block =
+            (uint8_t*)heap_caps_aligned_alloc(_buffer_align, ctx->blockSize, MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA);
+    }
+    if (ctx->fd < 0 || ctx->block == nullptr) {
+        ESP_LOGE(TAG, "open %s failed", path);
+        free_aligned_file(ctx);
+        return nullptr;
+    }
+
+    cookie_io_functions_t functions = {
+        .read  = nullptr,
+        .write = aligned_file_write,
+        .seek  = aligned_file_seek,
+        .close = aligned_file_close,
+    };
+    FILE* fp = fopencookie(ctx, "wb", functions);
+    if (fp == nullptr) {
+        ESP_LOGE(TAG, "fopencookie failed");
+        free_aligned_file(ctx);
+        return nullptr;
+    }
+    // The block is the buffer, stdio would only add a copy in front of it
+    setvbuf(fp, nullptr, _IONBF, 0);
+    return fp;
+}
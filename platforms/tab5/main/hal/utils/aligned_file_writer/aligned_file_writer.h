@@ -0,0 +1,22 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdio.h>
+#include <stddef.h>
+
+/**
+ * @brief Open a file for writing through a DMA capable block buffer
+ *
+ * Writes are gathered into blocks of blockSize and handed to the file system whole, so each one starts on a block
+ * boundary of the file and FATFS passes it to the SD card as one multi-sector transfer straight from the buffer,
+ * instead of going through its sector bounce buffer. Keep blockSize a multiple of the cluster size. The returned
+ * FILE only supports writing, seeking flushes the pending block first.
+ *
+ * @param path
+ * @param blockSize bytes per file system write, in internal DMA capable memory when it fits
+ * @return nullptr on failure
+ */
+FILE* aligned_file_fopen(const char* path, size_t blockSize = 64 * 1024);
@@ -0,0 +1,247 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "audio_mixer.h"
+#include <algorithm>
+#include <string.h>
+
+AudioMixer::AudioMixer()
+{
+    _stream.ring.resize(StreamFrames * 2);
+}
+
+int32_t AudioMixer::volume_to_gain(uint8_t volume)
+{
+    // Q15, 100% is unity
+    return std::min<int32_t>(volume, 100) * 32768 / 100;
+}
+
+uint32_t AudioMixer::play(const int16_t* data, size_t size, uint8_t volume, std::shared_ptr<const void> owner)
+{
+    if (data == nullptr || size == 0) {
+        return InvalidId;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Voice_t& voice = take_voice();
+    voice.data     = data;
+    voice.size     = size;
+    voice.gain     = volume_to_gain(volume);
+    voice.owner.swap(owner);
+    return voice.id;
+}
+
+uint32_t AudioMixer::playNote(const SynthVoice::Config_t& config)
+{
+    SynthVoice::Config_t synth_config = config;
+    synth_config.sampleRate           = SampleRate;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Voice_t& voice = take_voice();
+    voice.isSynth  = true;
+    voice.synth.start(synth_config);
+    return voice.id;
+}
+
+AudioMixer::Voice_t& AudioMixer::take_voice()
+{
+    // Take a free slot, or steal the oldest voice
+    Voice_t* slot = &_voices[0];
+    for (auto& voice : _voices) {
+        if (voice.id == InvalidId) {
+            slot = &voice;
+            break;
+        }
+        if (voice.id < slot->id) {
+            slot = &voice;
+        }
+    }
+    release_voice(*slot);
+
+    slot->id = _next_id++;
+    if (_next_id == InvalidId) {
+        _next_id = 1;
+    }
+    return *slot;
+}
+
+bool AudioMixer::isPlaying(uint32_t voiceId)
+{
+    if (voiceId == InvalidId) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& voice : _voices) {
+        if (voice.id == voiceId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AudioMixer::stop(uint32_t voiceId)
+{
+    if (voiceId == InvalidId) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& voice : _voices) {
+        if (voice.id == voiceId) {
+            release_voice(voice);
+        }
+    }
+}
+
+void AudioMixer::release_voice(Voice_t& voice)
+{
+    voice.id      = InvalidId;
+    voice.data    = nullptr;
+    voice.size    = 0;
+    voice.pos     = 0;
+    voice.isSynth = false;
+    voice.owner.reset();
+}
+
+void AudioMixer::streamBegin(uint32_t sampleRate, uint8_t channels, uint8_t volume)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stream.opened   = true;
+    _stream.channels = channels == 1 ? 1 : 2;
+    _stream.gain     = volume_to_gain(volume);
+    _stream.step     = (uint64_t)sampleRate * 0x10000 / SampleRate;
+    if (_stream.step == 0) {
+        _stream.step = 0x10000;
+    }
+    // A track at the rate of the last one keeps the filter history, so the change is gapless
+    _stream.resampler.configure(sampleRate, SampleRate);
+    _stream.position = -(int64_t)_stream.count;
+}
+
+size_t AudioMixer::streamWrite(const int16_t* data, size_t frames)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_stream.opened) {
+        return 0;
+    }
+
+    // The ring always holds stereo frames at the input rate
+    size_t ring_frames = _stream.ring.size() / 2;
+    frames             = std::min(frames, ring_frames - _stream.count);
+    size_t tail        = (_stream.head + _stream.count) % ring_frames;
+    for (size_t i = 0; i < frames; i++) {
+        int16_t* dst = &_stream.ring[tail * 2];
+        if (_stream.channels == 1) {
+            dst[0] = data[i];
+            dst[1] = data[i];
+        } else {
+            dst[0] = data[i * 2 + 0];
+            dst[1] = data[i * 2 + 1];
+        }
+        tail = (tail + 1) % ring_frames;
+    }
+    _stream.count += frames;
+    return frames;
+}
+
+void AudioMixer::streamEnd()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stream.opened = false;
+}
+
+void AudioMixer::setStreamMuted(bool muted)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stream.muted = muted;
+}
+
+bool AudioMixer::isStreamOpened()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stream.opened;
+}
+
+uint64_t AudioMixer::getStreamPosition()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return std::max<int64_t>(_stream.position, 0);
+}
+
+bool AudioMixer::mix(int16_t* out)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    bool active = _stream.opened || _stream.count > 0;
+    for (const auto& voice : _voices) {
+        active |= voice.id != InvalidId;
+    }
+    if (!active) {
+        return false;
+    }
+
+    memset(_accum, 0, sizeof(_accum));
+    for (auto& voice : _voices) {
+        if (voice.id != InvalidId) {
+            mix_voice(voice);
+        }
+    }
+    mix_stream();
+
+    for (size_t i = 0; i < BlockFrames * 2; i++) {
+        out[i] = std::clamp<int32_t>(_accum[i], INT16_MIN, INT16_MAX);
+    }
+    return true;
+}
+
+void AudioMixer::mix_voice(Voice_t& voice)
+{
+    if (voice.isSynth) {
+        if (!voice.synth.render(_accum, BlockFrames)) {
+            release_voice(voice);
+        }
+        return;
+    }
+
+    size_t samples     = std::min(BlockFrames * 2, voice.size - voice.pos);
+    const int16_t* src = voice.data + voice.pos;
+    for (size_t i = 0; i < samples; i++) {
+        _accum[i] += (src[i] * voice.gain) >> 15;
+    }
+
+    voice.pos += samples;
+    if (voice.pos >= voice.size) {
+        release_voice(voice);
+    }
+}
+
+void AudioMixer::mix_stream()
+{
+    size_t ring_frames = _stream.ring.size() / 2;
+    for (size_t i = 0; i < BlockFrames; i++) {
+        // Pull input frames until the output position is between the two middle frames of the filter
+        while (_stream.phase >= 0x10000) {
+            if (_stream.count == 0) {
+                // Underrun, the rest of the block stays silent
+                return;
+            }
+            _stream.resampler.push(&_stream.ring[_stream.head * 2]);
+            _stream.head = (_stream.head + 1) % ring_frames;
+            _stream.count--;
+            _stream.position++;
+            _stream.phase -= 0x10000;
+        }
+
+        if (!_stream.muted) {
+            int32_t sample[2];
+            _stream.resampler.render(_stream.phase, sample);
+            for (int ch = 0; ch < 2; ch++) {
+                _accum[i * 2 + ch] += (std::clamp<int32_t>(sample[ch], INT16_MIN, INT16_MAX) * _stream.gain) >> 15;
+            }
+        }
+        _stream.phase += _stream.step;
+    }
+}
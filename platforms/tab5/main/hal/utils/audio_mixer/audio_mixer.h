@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "synth_voice.h"
+#include "polyphase_resampler.h"
+
+/**
+ * @brief Mixes one shot PCM voices and a single decoder stream into interleaved 48kHz 16bit stereo blocks
+ *
+ * The output clock never changes, the stream is resampled from its own rate.
+ *
+ */
+class AudioMixer {
+public:
+    static constexpr uint32_t SampleRate  = 48000;
+    static constexpr size_t BlockFrames   = 256;
+    static constexpr size_t MaxVoices     = 8;
+    static constexpr size_t StreamFrames  = 4096;
+    static constexpr uint32_t InvalidId   = 0;
+    static constexpr uint32_t BlockTimeMs = BlockFrames * 1000 / SampleRate + 1;
+
+    AudioMixer();
+
+    /**
+     * @brief Start a voice on interleaved stereo samples at 48kHz, the oldest voice is stolen when all slots are busy
+     *
+     * @param data samples, must stay valid until the voice ends, owner can keep them alive
+     * @param size sample count, two per frame
+     * @param volume 0~100
+     * @param owner released by the mixer when the voice ends
+     * @return voice id
+     */
+    uint32_t play(const int16_t* data, size_t size, uint8_t volume = 100, std::shared_ptr<const void> owner = nullptr);
+
+    /**
+     * @brief Start a synthesized note voice, the sample rate of the config is overridden by the mixer's
+     *
+     * @return voice id
+     */
+    uint32_t playNote(const SynthVoice::Config_t& config);
+    bool isPlaying(uint32_t voiceId);
+    void stop(uint32_t voiceId);
+
+    /**
+     * @brief Open the decoder stream, samples written later are resampled to 48kHz stereo by a polyphase filter
+     *
+     * @param sampleRate
+     * @param channels 1 or 2
+     * @param volume 0~100
+     */
+    void streamBegin(uint32_t sampleRate, uint8_t channels, uint8_t volume = 100);
+
+    /**
+     * @brief Queue interleaved samples into the stream ring
+     *
+     * @return frames accepted, less than requested when the ring is full
+     */
+    size_t streamWrite(const int16_t* data, size_t frames);
+
+    /**
+     * @brief Close the stream, the queued frames are still played
+     *
+     */
+    void streamEnd();
+    void setStreamMuted(bool muted);
+    bool isStreamOpened();
+
+    /**
+     * @brief Stream frames taken out of the ring since streamBegin, at the stream's own rate
+     *
+     * Frames still queued from before the stream was opened are not counted. The position runs a mixed block and the
+     * output DMA ahead of what is heard, and stops on an underrun, so the stream can serve as a playback clock
+     *
+     */
+    uint64_t getStreamPosition();
+
+    /**
+     * @brief Mix the next block into out, BlockFrames stereo frames
+     *
+     * @return false when nothing is playing, out is left untouched
+     */
+    bool mix(int16_t* out);
+
+private:
+    struct Voice_t {
+        uint32_t id         = InvalidId;
+        const int16_t* data = nullptr;
+        size_t size         = 0;
+        size_t pos          = 0;
+        int32_t gain        = 0;
+        std::shared_ptr<const void> owner;
+        bool isSynth = false;
+        SynthVoice synth;
+    };
+
+    struct Stream_t {
+        bool opened      = false;
+        bool muted       = false;
+        uint8_t channels = 2;
+        int32_t gain     = 0;
+        // Q16 input frames per output frame
+        uint32_t step  = 0x10000;
+        uint32_t phase = 0x10000;
+        PolyphaseResampler resampler;
+        std::vector<int16_t> ring;
+        size_t head  = 0;
+        size_t count = 0;
+        // Negative while the frames queued before streamBegin drain
+        int64_t position = 0;
+    };
+
+    std::mutex _mutex;
+    Voice_t _voices[MaxVoices];
+    Stream_t _stream;
+    uint32_t _next_id = 1;
+    int32_t _accum[BlockFrames * 2];
+
+    static int32_t volume_to_gain(uint8_t volume);
+    Voice_t& take_voice();
+    void release_voice(Voice_t& voice);
+    void mix_voice(Voice_t& voice);
+    void mix_stream();
+};
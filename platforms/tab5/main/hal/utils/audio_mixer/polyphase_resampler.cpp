@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "polyphase_resampler.h"
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+// Kaiser window, about 70dB of stopband for the length
+static constexpr double _kaiser_beta = 7.0;
+// Cutoff against the lower Nyquist frequency, the rest is the transition band
+static constexpr double _cutoff = 0.92;
+
+// Zeroth order modified Bessel function, the series converges in a few dozen terms
+static double bessel_i0(double x)
+{
+    double sum  = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+void PolyphaseResampler::configure(uint32_t inRate, uint32_t outRate)
+{
+    if (inRate == _in_rate && outRate == _out_rate && !_bank.empty()) {
+        return;
+    }
+    _in_rate  = inRate;
+    _out_rate = outRate;
+    // Same rates only ever render on whole frames. The Q15 unity tap would clamp to 32767, so those are copied
+    _is_copy = inRate == outRate;
+    _bank.assign((Phases + 1) * Taps, 0);
+
+    double cutoff = _is_copy ? 1.0 : _cutoff * std::min(1.0, (double)outRate / inRate);
+    double half   = Taps / 2.0;
+    double norm   = bessel_i0(_kaiser_beta);
+    for (size_t p = 0; p <= Phases; p++) {
+        double t = half - 1.0 + (double)p / Phases;
+        double h[Taps];
+        double sum = 0.0;
+        for (size_t k = 0; k < Taps; k++) {
+            double d      = k - t;
+            double sinc   = fabs(d) < 1e-9 ? 1.0 : sin(M_PI * cutoff * d) / (M_PI * cutoff * d);
+            double w      = d / half;
+            double window = fabs(w) >= 1.0 ? 0.0 : bessel_i0(_kaiser_beta * sqrt(1.0 - w * w)) / norm;
+            h[k]          = sinc * window;
+            sum += h[k];
+        }
+        // Unity DC gain on every phase, else the phases show up as a tone at the step rate
+        for (size_t k = 0; k < Taps; k++) {
+            _bank[p * Taps + k] = (int16_t)std::clamp<long>(lround(h[k] / sum * 32768.0), INT16_MIN, INT16_MAX);
+        }
+    }
+    reset();
+}
+
+void PolyphaseResampler::reset()
+{
+    memset(_history, 0, sizeof(_history));
+    _pos = 0;
+}
+
+void PolyphaseResampler::render(uint32_t fraction, int32_t* out) const
+{
+    if (_bank.empty()) {
+        out[0] = 0;
+        out[1] = 0;
+        return;
+    }
+    const int16_t* left  = &_history[0][_pos];
+    const int16_t* right = &_history[1][_pos];
+    if (_is_copy) {
+        // The frame the impulse of phase 0 sits on, the same delay as the filter
+        out[0] = left[Taps / 2 - 1];
+        out[1] = right[Taps / 2 - 1];
+        return;
+    }
+    size_t phase         = ((fraction & 0xFFFF) * Phases + 0x8000) >> 16;
+    const int16_t* coeff = &_bank[phase * Taps];
+    int32_t l            = 0;
+    int32_t r            = 0;
+    for (size_t k = 0; k < Taps; k++) {
+        l += left[k] * coeff[k];
+        r += right[k] * coeff[k];
+    }
+    out[0] = (l + (1 << 14)) >> 15;
+    out[1] = (r + (1 << 14)) >> 15;
+}
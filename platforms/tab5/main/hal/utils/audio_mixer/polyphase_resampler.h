@@ -0,0 +1,57 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+/**
+ * @brief Windowed sinc polyphase resampler for interleaved 16bit stereo, any input rate to a fixed output rate
+ *
+ * The caller steps a Q16 phase, pushes an input frame each time it wraps and renders an output frame at the phase
+ * in between. The filter lags the newest input by Taps / 2 frames. Equal rates give a pure delay, bit exact.
+ *
+ */
+class PolyphaseResampler {
+public:
+    static constexpr size_t Taps   = 16;
+    static constexpr size_t Phases = 128;
+
+    /**
+     * @brief Build the filter bank for the rate pair, the history is only cleared when the rates change
+     *
+     */
+    void configure(uint32_t inRate, uint32_t outRate);
+    void reset();
+
+    void push(const int16_t* frame)
+    {
+        _history[0][_pos]        = frame[0];
+        _history[0][_pos + Taps] = frame[0];
+        _history[1][_pos]        = frame[1];
+        _history[1][_pos + Taps] = frame[1];
+        _pos                     = _pos + 1 == Taps ? 0 : _pos + 1;
+    }
+
+    /**
+     * @brief Output frame at a fraction between two input frames
+     *
+     * @param fraction Q16, 0 is on an input frame
+     * @param out stereo
+     */
+    void render(uint32_t fraction, int32_t* out) const;
+
+private:
+    uint32_t _in_rate  = 0;
+    uint32_t _out_rate = 0;
+    // Equal rates, render() copies the delayed frame and skips the bank
+    bool _is_copy = false;
+    // Phases + 1 rows of Taps Q15 coefficients, oldest tap first, the last row is a whole frame on
+    std::vector<int16_t> _bank;
+    // Written twice, so the window of the last Taps frames is contiguous from any position
+    int16_t _history[2][Taps * 2] = {};
+    size_t _pos                   = 0;
+};
@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "synth_voice.h"
+#include <algorithm>
+#include <math.h>
+
+static constexpr int _table_bits = 10;
+static constexpr int _table_size = 1 << _table_bits;
+
+// One sine period, with a guard entry so the interpolation never wraps
+struct SineTable_t {
+    int16_t data[_table_size + 1];
+
+    SineTable_t()
+    {
+        for (int i = 0; i <= _table_size; i++) {
+            data[i] = (int16_t)lrintf(sinf(2.0f * (float)M_PI * i / _table_size) * 32767.0f);
+        }
+    }
+};
+
+static const int16_t* get_sine_table()
+{
+    static SineTable_t table;
+    return table.data;
+}
+
+void SynthVoice::start(const Config_t& config)
+{
+    uint32_t rate          = config.sampleRate;
+    uint32_t delay_samples = (uint32_t)config.delayMs * rate / 1000;
+    uint32_t total_samples = (uint32_t)config.durationMs * rate / 1000;
+    _attack_samples        = std::min((uint32_t)config.attackMs * rate / 1000, total_samples);
+    _release_samples       = std::min((uint32_t)config.releaseMs * rate / 1000, total_samples - _attack_samples);
+    _hold_samples          = total_samples - _attack_samples - _release_samples;
+
+    // Q32 phase increment, the only floating point math of a note
+    _phase      = 0;
+    _phase_step = (uint32_t)((double)config.frequency * 4294967296.0 / rate);
+    _level      = std::min<int32_t>(config.level, 100) * 32768 / 100;
+
+    _stage      = STAGE_DELAY;
+    _stage_left = delay_samples;
+    _env        = 0;
+    _env_step   = 0;
+    get_sine_table();
+}
+
+void SynthVoice::next_stage()
+{
+    switch (_stage) {
+        case STAGE_DELAY:
+            _stage      = STAGE_ATTACK;
+            _stage_left = _attack_samples;
+            _env        = _attack_samples ? 0 : EnvUnity;
+            _env_step   = _attack_samples ? EnvUnity / (int32_t)_attack_samples : 0;
+            break;
+        case STAGE_ATTACK:
+            _stage      = STAGE_HOLD;
+            _stage_left = _hold_samples;
+            _env        = EnvUnity;
+            _env_step   = 0;
+            break;
+        case STAGE_HOLD:
+            _stage      = STAGE_RELEASE;
+            _stage_left = _release_samples;
+            _env_step   = _release_samples ? -(EnvUnity / (int32_t)_release_samples) : 0;
+            break;
+        default:
+            _stage = STAGE_DONE;
+            break;
+    }
+}
+
+bool SynthVoice::render(int32_t* accum, size_t frames)
+{
+    const int16_t* table = get_sine_table();
+
+    for (size_t i = 0; i < frames; i++) {
+        while (_stage != STAGE_DONE && _stage_left == 0) {
+            next_stage();
+        }
+        if (_stage == STAGE_DONE) {
+            return false;
+        }
+        _stage_left--;
+        if (_stage == STAGE_DELAY) {
+            continue;
+        }
+
+        // Top bits index the table, the next 15 bits interpolate between entries
+        uint32_t index = _phase >> (32 - _table_bits);
+        int32_t frac   = (_phase >> (32 - _table_bits - 15)) & 0x7FFF;
+        int32_t sample = table[index] + (((table[index + 1] - table[index]) * frac) >> 15);
+
+        int32_t env   = std::max<int32_t>(_env, 0) >> 8;
+        int32_t value = (((sample * env) >> 15) * _level) >> 15;
+        accum[i * 2 + 0] += value;
+        accum[i * 2 + 1] += value;
+
+        _phase += _phase_step;
+        _env += _env_step;
+    }
+
+    while (_stage != STAGE_DONE && _stage_left == 0) {
+        next_stage();
+    }
+    return _stage != STAGE_DONE;
+}
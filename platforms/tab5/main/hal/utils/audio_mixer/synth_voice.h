@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Sine wavetable oscillator with a linear attack/release envelope, all fixed point and allocation free
+ *
+ */
+class SynthVoice {
+public:
+    struct Config_t {
+        float frequency     = 440.0f;
+        uint32_t sampleRate = 48000;
+        uint16_t delayMs    = 0;
+        uint16_t durationMs = 100;
+        uint16_t attackMs   = 0;
+        uint16_t releaseMs  = 0;
+        // Peak level, 0~100 of full scale
+        uint8_t level = 20;
+    };
+
+    void start(const Config_t& config);
+
+    /**
+     * @brief Add the next frames into an interleaved stereo Q0 accumulator
+     *
+     * @return false once the note has ended
+     */
+    bool render(int32_t* accum, size_t frames);
+
+private:
+    enum Stage_t {
+        STAGE_DELAY,
+        STAGE_ATTACK,
+        STAGE_HOLD,
+        STAGE_RELEASE,
+        STAGE_DONE,
+    };
+
+    // Envelope is Q23, unity is 1 << 23
+    static constexpr int32_t EnvUnity = 1 << 23;
+
+    Stage_t _stage            = STAGE_DONE;
+    uint32_t _phase           = 0;
+    uint32_t _phase_step      = 0;
+    uint32_t _stage_left      = 0;
+    uint32_t _attack_samples  = 0;
+    uint32_t _hold_samples    = 0;
+    uint32_t _release_samples = 0;
+    int32_t _env              = 0;
+    int32_t _env_step         = 0;
+    int32_t _level            = 0;
+
+    void next_stage();
+};
@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "boot_graph.h"
+#include <algorithm>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static const char* TAG = "boot-graph";
+
+void BootGraph::addStage(const std::string& name, const std::vector<std::string>& deps, std::function<void()> stage,
+                         uint32_t stackSize)
+{
+    Stage_t new_stage;
+    new_stage.name      = name;
+    new_stage.stage     = std::move(stage);
+    new_stage.stackSize = stackSize;
+    for (const auto& dep : deps) {
+        auto it = std::find_if(_stages.begin(), _stages.end(), [&](const Stage_t& s) { return s.name == dep; });
+        if (it == _stages.end()) {
+            ESP_LOGE(TAG, "stage %s: unknown dependency %s, ignored", name.c_str(), dep.c_str());
+            continue;
+        }
+        new_stage.deps.push_back(it - _stages.begin());
+    }
+    _stages.push_back(std::move(new_stage));
+}
+
+void BootGraph::stage_task(void* param)
+{
+    auto* task_param = static_cast<StageTaskParam_t*>(param);
+    task_param->graph->run_stage(task_param->index);
+    delete task_param;
+    vTaskDelete(NULL);
+}
+
+void BootGraph::run_stage(int index)
+{
+    // Not touched by anyone else while the stage runs
+    Stage_t& stage   = _stages[index];
+    int64_t start_us = esp_timer_get_time();
+    stage.stage();
+    int64_t end_us = esp_timer_get_time();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    stage.startUs    = start_us - _run_start_us;
+    stage.durationUs = end_us - start_us;
+    stage.isDone     = true;
+    _cv.notify_all();
+
+    // The stage that finishes starts whatever it unblocked, so no task has to sit and watch the graph
+    start_ready_stages();
+    if (_is_done || !std::all_of(_stages.begin(), _stages.end(), [](const Stage_t& s) { return s.isDone; })) {
+        return;
+    }
+    _is_done = true;
+    log_stats();
+    auto on_done = std::move(_on_done);
+    lock.unlock();
+
+    if (on_done) {
+        on_done();
+    }
+}
+
+// Lock _mutex before calling
+void BootGraph::start_ready_stages()
+{
+    for (int i = 0; i < (int)_stages.size(); i++) {
+        auto& stage = _stages[i];
+        if (stage.isStarted) {
+            continue;
+        }
+        bool is_ready =
+            std::all_of(stage.deps.begin(), stage.deps.end(), [&](int dep) { return _stages[dep].isDone; });
+        if (!is_ready) {
+            continue;
+        }
+
+        stage.isStarted  = true;
+        auto* task_param = new StageTaskParam_t{this, i};
+        if (xTaskCreate(stage_task, stage.name.c_str(), stage.stackSize, task_param, _priority, nullptr) != pdPASS) {
+            // Out of memory this early is unlikely, the caller runs the stage itself rather than skip it
+            ESP_LOGW(TAG, "stage %s: create task failed, running inline", stage.name.c_str());
+            delete task_param;
+            _mutex.unlock();
+            run_stage(i);
+            _mutex.lock();
+        }
+    }
+}
+
+// Lock _mutex before calling
+void BootGraph::log_stats()
+{
+    int64_t total_us = esp_timer_get_time() - _run_start_us;
+    for (const auto& stage : _stages) {
+        ESP_LOGI(TAG, "%-12s start %5d ms, took %5d ms", stage.name.c_str(), (int)(stage.startUs / 1000),
+                 (int)(stage.durationUs / 1000));
+    }
+    ESP_LOGI(TAG, "%d stages in %d ms", (int)_stages.size(), (int)(total_us / 1000));
+}
+
+void BootGraph::start(std::function<void()> onDone)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _priority     = uxTaskPriorityGet(NULL);
+    _run_start_us = esp_timer_get_time();
+    _on_done      = std::move(onDone);
+    _is_done      = false;
+    for (auto& stage : _stages) {
+        stage.isStarted = false;
+        stage.isDone    = false;
+    }
+
+    if (_stages.empty()) {
+        _is_done     = true;
+        auto on_done = std::move(_on_done);
+        lock.unlock();
+        if (on_done) {
+            on_done();
+        }
+        return;
+    }
+    start_ready_stages();
+}
+
+void BootGraph::wait(const std::string& name)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto it = std::find_if(_stages.begin(), _stages.end(), [&](const Stage_t& s) { return s.name == name; });
+    if (it == _stages.end()) {
+        return;
+    }
+    _cv.wait(lock, [&]() { return it->isDone; });
+}
+
+void BootGraph::run()
+{
+    start();
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cv.wait(lock, [&]() { return _is_done; });
+}
+
+bool BootGraph::isDone()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _is_done;
+}
+
+std::vector<BootGraph::StageStats_t> BootGraph::getStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<StageStats_t> stats;
+    for (const auto& stage : _stages) {
+        stats.push_back({stage.name, stage.startUs, stage.durationUs});
+    }
+    return stats;
+}
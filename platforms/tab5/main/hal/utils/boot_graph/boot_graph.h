@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Runs init stages as a dependency graph, every stage starts on its own task once its dependencies are done
+ *
+ */
+class BootGraph {
+public:
+    struct StageStats_t {
+        std::string name;
+        // Relative to the start of run()
+        int64_t startUs    = 0;
+        int64_t durationUs = 0;
+    };
+
+    /**
+     * @brief Add a stage, dependencies are named and have to be added before it, so the graph can't have a cycle
+     *
+     * @param name
+     * @param deps stages that have to finish first
+     * @param stage
+     * @param stackSize of the task the stage runs on
+     */
+    void addStage(const std::string& name, const std::vector<std::string>& deps, std::function<void()> stage,
+                  uint32_t stackSize = 4096);
+
+    /**
+     * @brief Start the stages without a dependency and return, the rest start as their dependencies finish. The
+     * tasks run at the caller's priority, the graph has to outlive them
+     *
+     * @param onDone runs on the task of the last stage to finish
+     */
+    void start(std::function<void()> onDone = nullptr);
+
+    /**
+     * @brief Block until a stage has finished, returns right away for an unknown name
+     *
+     * @param name
+     */
+    void wait(const std::string& name);
+
+    /**
+     * @brief Run every stage and block until all have finished
+     *
+     */
+    void run();
+
+    bool isDone();
+
+    /**
+     * @brief Per stage timing of the last run, in the order the stages were added
+     *
+     * @return std::vector<StageStats_t>
+     */
+    std::vector<StageStats_t> getStats();
+
+private:
+    struct Stage_t {
+        std::string name;
+        std::vector<int> deps;
+        std::function<void()> stage;
+        uint32_t stackSize = 0;
+        bool isStarted     = false;
+        bool isDone        = false;
+        int64_t startUs    = 0;
+        int64_t durationUs = 0;
+    };
+
+    struct StageTaskParam_t {
+        BootGraph* graph = nullptr;
+        int index        = 0;
+    };
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::vector<Stage_t> _stages;
+    std::function<void()> _on_done;
+    int64_t _run_start_us = 0;
+    int _priority         = 0;
+    bool _is_done         = false;
+
+    static void stage_task(void* param);
+    void run_stage(int index);
+    void start_ready_stages();
+    void log_stats();
+};
@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "deferred_log.h"
+#include <hal/spsc_ring.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_timer.h>
+
+static const std::string _tag = "deferred-log";
+
+namespace {
+
+struct Record_t {
+    uint32_t timeMs = 0;
+    uint8_t level   = 0;
+    char tag[DeferredLog::MaxTag + 1];
+    uint16_t size = 0;
+    const char* format;
+    size_t formatSize;
+    std::string (*formatFn)(fmt::string_view format, const uint8_t* data);
+};
+
+struct DeferredLogData_t {
+    // Log calls come from any task, the spinlock makes them a single producer for the ring
+    portMUX_TYPE ringLock = portMUX_INITIALIZER_UNLOCKED;
+    SpscRing<uint8_t> ring;
+    std::atomic<bool> isRunning{false};
+    uint32_t pollIntervalMs = 0;
+    uint32_t records        = 0;
+    uint32_t dropped        = 0;
+};
+DeferredLogData_t _deferred_data;
+
+void formatter_task(void* param)
+{
+    Record_t record;
+    uint8_t data[DeferredLog::MaxArgs];
+
+    while (true) {
+        // Producers never wake the task, a busy ring is drained in one go
+        while (_deferred_data.ring.available() >= sizeof(Record_t)) {
+            _deferred_data.ring.read((uint8_t*)&record, sizeof(Record_t));
+            _deferred_data.ring.read(data, record.size);
+
+            std::string text = record.formatFn(fmt::string_view(record.format, record.formatSize), data);
+            switch (record.level) {
+                case DeferredLog::LEVEL_WARN:
+                    mclog::tagWarn(record.tag, "{} (at {} ms)", text, record.timeMs);
+                    break;
+                case DeferredLog::LEVEL_ERROR:
+                    mclog::tagError(record.tag, "{} (at {} ms)", text, record.timeMs);
+                    break;
+                default:
+                    mclog::tagInfo(record.tag, "{} (at {} ms)", text, record.timeMs);
+                    break;
+            }
+        }
+        vTaskDelay(pdMS_TO_TICKS(_deferred_data.pollIntervalMs));
+    }
+}
+
+}  // namespace
+
+bool DeferredLog::start(size_t ringSize, uint32_t pollIntervalMs)
+{
+    if (_deferred_data.isRunning) {
+        return true;
+    }
+
+    _deferred_data.ring.init(std::max(ringSize, sizeof(Record_t) + MaxArgs));
+    _deferred_data.pollIntervalMs = std::max<uint32_t>(pollIntervalMs, 1);
+    // Below every task that logs through it, so formatting only runs in idle time
+    if (xTaskCreate(formatter_task, "deferred_log", 4096, nullptr, 1, nullptr) != pdPASS) {
+        mclog::tagError(_tag, "create task failed");
+        return false;
+    }
+    _deferred_data.isRunning = true;
+
+    mclog::tagInfo(_tag, "start, {} bytes ring, level {} and up", _deferred_data.ring.capacity(),
+                   DEFERRED_LOG_MIN_LEVEL);
+    return true;
+}
+
+DeferredLog::Stats_t DeferredLog::getStats()
+{
+    Stats_t stats;
+    portENTER_CRITICAL(&_deferred_data.ringLock);
+    stats.records = _deferred_data.records;
+    stats.dropped = _deferred_data.dropped;
+    portEXIT_CRITICAL(&_deferred_data.ringLock);
+    return stats;
+}
+
+void DeferredLog::push(Level_t level, std::string_view tag, fmt::string_view format, FormatFn_t formatFn,
+                       const uint8_t* data, size_t size)
+{
+    if (!_deferred_data.isRunning) {
+        return;
+    }
+
+    // Header and arguments in one write, the task never sees a record without its arguments
+    uint8_t buffer[sizeof(Record_t) + MaxArgs];
+    Record_t record;
+    record.timeMs   = esp_timer_get_time() / 1000;
+    record.level    = level;
+    size_t tag_size = std::min(tag.size(), MaxTag);
+    memcpy(record.tag, tag.data(), tag_size);
+    record.tag[tag_size] = '\0';
+    record.size          = size;
+    record.format        = format.data();
+    record.formatSize    = format.size();
+    record.formatFn      = formatFn;
+    memcpy(buffer, &record, sizeof(record));
+    memcpy(buffer + sizeof(record), data, size);
+    size_t total = sizeof(record) + size;
+
+    portENTER_CRITICAL_SAFE(&_deferred_data.ringLock);
+    if (_deferred_data.ring.space() >= total) {
+        _deferred_data.ring.write(buffer, total);
+        _deferred_data.records++;
+    } else {
+        _deferred_data.dropped++;
+    }
+    portEXIT_CRITICAL_SAFE(&_deferred_data.ringLock);
+}
@@ -0,0 +1,161 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <mooncake_log.h>
+#include <sdkconfig.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Calls below this level compile to nothing, 0 debug, 1 info, 2 warn, 3 error
+#ifdef CONFIG_HAL_DEFERRED_LOG_LEVEL
+#define DEFERRED_LOG_MIN_LEVEL CONFIG_HAL_DEFERRED_LOG_LEVEL
+#else
+#define DEFERRED_LOG_MIN_LEVEL 1
+#endif
+
+/**
+ * @brief Logging for hot paths. A call copies the tag, the format string pointer and the raw arguments into a ring
+ * under a spinlock and returns, nothing is formatted and no task is woken. A low priority task polls the ring, formats
+ * the records and passes them on to mooncake_log with the time they were logged at
+ *
+ * Arguments are copied by value, strings up to MaxString bytes. Types mooncake_log formats directly work the same here,
+ * enums still need a cast. Records that do not fit the ring are counted as dropped
+ */
+class DeferredLog {
+public:
+    enum Level_t : uint8_t {
+        LEVEL_DEBUG = 0,
+        LEVEL_INFO,
+        LEVEL_WARN,
+        LEVEL_ERROR,
+    };
+
+    struct Stats_t {
+        uint32_t records = 0;
+        uint32_t dropped = 0;
+    };
+
+    static constexpr size_t MaxTag    = 15;
+    static constexpr size_t MaxString = 63;
+    // Raw arguments of one call
+    static constexpr size_t MaxArgs = 256;
+
+    /**
+     * @brief Allocate the ring and start the formatter task, calls before this are dropped
+     *
+     * @return false if the ring or the task could not be created
+     */
+    static bool start(size_t ringSize = 16384, uint32_t pollIntervalMs = 50);
+    static Stats_t getStats();
+
+    template <typename... Args>
+    static void debug(std::string_view tag, fmt::format_string<Args...> format, Args&&... args)
+    {
+        log<LEVEL_DEBUG>(tag, format, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    static void info(std::string_view tag, fmt::format_string<Args...> format, Args&&... args)
+    {
+        log<LEVEL_INFO>(tag, format, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    static void warn(std::string_view tag, fmt::format_string<Args...> format, Args&&... args)
+    {
+        log<LEVEL_WARN>(tag, format, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    static void error(std::string_view tag, fmt::format_string<Args...> format, Args&&... args)
+    {
+        log<LEVEL_ERROR>(tag, format, std::forward<Args>(args)...);
+    }
+
+    template <Level_t Level, typename... Args>
+    static void log(std::string_view tag, fmt::format_string<Args...> format, Args&&... args)
+    {
+        if constexpr (Level >= DEFERRED_LOG_MIN_LEVEL) {
+            static_assert((0 + ... + Arg<std::decay_t<Args>>::MaxSize) <= MaxArgs, "too many arguments to defer");
+            uint8_t data[(1 + ... + Arg<std::decay_t<Args>>::MaxSize)];
+            uint8_t* p = data;
+            (Arg<std::decay_t<Args>>::encode(p, args), ...);
+            push(Level, tag, fmt::string_view(format), format_record<std::decay_t<Args>...>, data, p - data);
+        }
+    }
+
+private:
+    using FormatFn_t = std::string (*)(fmt::string_view format, const uint8_t* data);
+
+    // Trivially copyable values go in as their bytes
+    template <typename T, typename Enable = void>
+    struct Arg {
+        static_assert(std::is_trivially_copyable_v<T>, "deferred log arguments are copied by value");
+        using Decoded_t                 = T;
+        static constexpr size_t MaxSize = sizeof(T);
+        static void encode(uint8_t*& p, const T& value)
+        {
+            memcpy(p, &value, sizeof(T));
+            p += sizeof(T);
+        }
+        static T decode(const uint8_t*& p)
+        {
+            T value;
+            memcpy(&value, p, sizeof(T));
+            p += sizeof(T);
+            return value;
+        }
+    };
+
+    // Strings are copied with a length byte in front, a pointer would dangle by the time it is formatted
+    struct StringArg {
+        using Decoded_t                 = std::string;
+        static constexpr size_t MaxSize = 1 + MaxString;
+        static void encode(uint8_t*& p, std::string_view value)
+        {
+            size_t size = std::min(value.size(), MaxString);
+            *p++        = size;
+            memcpy(p, value.data(), size);
+            p += size;
+        }
+        static void encode(uint8_t*& p, const char* value)
+        {
+            encode(p, std::string_view(value ? value : "(null)"));
+        }
+        static std::string decode(const uint8_t*& p)
+        {
+            size_t size = *p++;
+            std::string value((const char*)p, size);
+            p += size;
+            return value;
+        }
+    };
+
+    template <typename... Args>
+    static std::string format_record(fmt::string_view format, const uint8_t* data)
+    {
+        // Braced initializers run left to right, so the fields come out in the order they went in
+        std::tuple<typename Arg<Args>::Decoded_t...> values{Arg<Args>::decode(data)...};
+        return std::apply([format](const auto&... v) { return fmt::vformat(format, fmt::make_format_args(v...)); },
+                          values);
+    }
+
+    static void push(Level_t level, std::string_view tag, fmt::string_view format, FormatFn_t formatFn,
+                     const uint8_t* data, size_t size);
+};
+
+template <>
+struct DeferredLog::Arg<std::string> : DeferredLog::StringArg {};
+template <>
+struct DeferredLog::Arg<std::string_view> : DeferredLog::StringArg {};
+template <>
+struct DeferredLog::Arg<const char*> : DeferredLog::StringArg {};
+template <>
+struct DeferredLog::Arg<char*> : DeferredLog::StringArg {};
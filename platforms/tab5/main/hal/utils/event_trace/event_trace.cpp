@@ -0,0 +1,212 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "event_trace.h"
+#include <mooncake_log.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_cpu.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+static const std::string _tag = "event-trace";
+
+namespace {
+
+struct Event_t {
+    int64_t timeUs;
+    const char* name;
+    // TCB address, 0 in an interrupt
+    uint32_t task;
+    int32_t value;
+    uint8_t type;
+    uint8_t core;
+};
+
+struct Ring_t {
+    Event_t* events   = nullptr;
+    uint32_t capacity = 0;
+    std::atomic<uint32_t> head{0};
+};
+
+struct EventTraceData_t {
+    Ring_t rings[portNUM_PROCESSORS];
+};
+EventTraceData_t _trace_data;
+
+// Pieces handed to the writer
+constexpr size_t _write_chunk = 4096;
+// Interrupt events go on a track of their own per core, these cannot be TCB addresses
+constexpr uint32_t _isr_tid_base = 1;
+
+const char* const _phases[] = {"B", "E", "i", "C"};
+
+void append_escaped(std::string& out, const char* text)
+{
+    for (; *text != '\0'; text++) {
+        if (*text == '"' || *text == '\\') {
+            out += '\\';
+        }
+        out += (uint8_t)*text < 0x20 ? ' ' : *text;
+    }
+}
+
+}  // namespace
+
+void EventTrace::record(Type_t type, const char* name, int32_t value)
+{
+    uint8_t core  = esp_cpu_get_core_id();
+    auto& ring    = _trace_data.rings[core];
+    uint32_t slot = ring.head.fetch_add(1, std::memory_order_relaxed);
+
+    auto& event  = ring.events[slot % ring.capacity];
+    event.timeUs = esp_timer_get_time();
+    event.name   = name;
+    event.task   = xPortInIsrContext() ? 0 : (uint32_t)xTaskGetCurrentTaskHandle();
+    event.value  = value;
+    event.type   = type;
+    event.core   = core;
+}
+
+bool EventTrace::start(size_t bufferSize)
+{
+    _is_recording = false;
+
+    uint32_t capacity = std::max<size_t>(bufferSize / sizeof(Event_t) / portNUM_PROCESSORS, 64);
+    for (auto& ring : _trace_data.rings) {
+        if (ring.capacity != capacity) {
+            heap_caps_free(ring.events);
+            ring.events   = static_cast<Event_t*>(heap_caps_malloc(capacity * sizeof(Event_t), MALLOC_CAP_SPIRAM));
+            ring.capacity = ring.events != nullptr ? capacity : 0;
+        }
+        if (ring.events == nullptr) {
+            mclog::tagError(_tag, "no memory for {} events", capacity);
+            return false;
+        }
+        ring.head = 0;
+    }
+
+    _is_recording = true;
+    mclog::tagInfo(_tag, "start, {} events per core", capacity);
+    return true;
+}
+
+void EventTrace::stop()
+{
+    _is_recording = false;
+}
+
+EventTrace::Stats_t EventTrace::getStats()
+{
+    Stats_t stats;
+    stats.isRecording = _is_recording;
+    for (const auto& ring : _trace_data.rings) {
+        stats.capacity += ring.capacity;
+        stats.events += ring.head.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+bool EventTrace::write(Write_t write, void* ctx)
+{
+    size_t total = 0;
+    for (const auto& ring : _trace_data.rings) {
+        total += std::min(ring.head.load(), ring.capacity);
+    }
+    if (total == 0) {
+        return false;
+    }
+    auto events = static_cast<Event_t*>(heap_caps_malloc(total * sizeof(Event_t), MALLOC_CAP_SPIRAM));
+    if (events == nullptr) {
+        mclog::tagError(_tag, "no memory for {} events", total);
+        return false;
+    }
+
+    // A call that saw the flag just before it dropped has finished its slot by the end of the wait
+    bool was_recording = _is_recording.exchange(false);
+    vTaskDelay(pdMS_TO_TICKS(2));
+    size_t count = 0;
+    for (const auto& ring : _trace_data.rings) {
+        uint32_t head = ring.head.load();
+        uint32_t held = std::min(head, ring.capacity);
+        for (uint32_t i = head - held; i != head; i++) {
+            events[count++] = ring.events[i % ring.capacity];
+        }
+    }
+    _is_recording = was_recording;
+
+    std::stable_sort(events, events + count, [](const Event_t& a, const Event_t& b) { return a.timeUs < b.timeUs; });
+
+    // Track names, tasks that have ended since keep their TCB address
+    std::map<uint32_t, std::string> names;
+    std::vector<TaskStatus_t> task_status(uxTaskGetNumberOfTasks() + 4);
+    UBaseType_t task_num = uxTaskGetSystemState(task_status.data(), task_status.size(), nullptr);
+    for (UBaseType_t i = 0; i < task_num; i++) {
+        names[(uint32_t)task_status[i].xHandle] = task_status[i].pcTaskName;
+    }
+    std::map<uint32_t, std::string> tracks;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t tid = events[i].task != 0 ? events[i].task : _isr_tid_base + events[i].core;
+        if (tracks.count(tid) > 0) {
+            continue;
+        }
+        auto name = names.find(tid);
+        if (events[i].task == 0) {
+            tracks[tid] = fmt::format("isr core {}", events[i].core);
+        } else {
+            tracks[tid] = name != names.end() ? name->second : fmt::format("task@{:08x}", tid);
+        }
+    }
+
+    bool is_ok = true;
+    std::string chunk;
+    chunk.reserve(_write_chunk + 256);
+    auto flush = [&](bool force) {
+        if (is_ok && (force || chunk.size() >= _write_chunk)) {
+            is_ok = write(chunk.data(), chunk.size(), ctx);
+            chunk.clear();
+        }
+    };
+
+    // Microseconds from the first event, the same clock on both cores
+    int64_t origin = events[0].timeUs;
+    chunk += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool is_first = true;
+    for (const auto& track : tracks) {
+        chunk += is_first ? "" : ",";
+        chunk += fmt::format("{{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"",
+                             track.first);
+        append_escaped(chunk, track.second.c_str());
+        chunk += "\"}}";
+        is_first = false;
+    }
+    for (size_t i = 0; i < count && is_ok; i++) {
+        const auto& event = events[i];
+        uint32_t tid      = event.task != 0 ? event.task : _isr_tid_base + event.core;
+        chunk += is_first ? "{\"name\":\"" : ",{\"name\":\"";
+        append_escaped(chunk, event.name);
+        chunk += fmt::format("\",\"ph\":\"{}\",\"ts\":{},\"pid\":1,\"tid\":{}", _phases[event.type],
+                             event.timeUs - origin, tid);
+        if (event.type == TYPE_COUNTER) {
+            chunk += fmt::format(",\"args\":{{\"value\":{}}}}}", event.value);
+        } else if (event.type == TYPE_INSTANT) {
+            chunk += fmt::format(",\"s\":\"t\",\"args\":{{\"core\":{}}}}}", event.core);
+        } else {
+            chunk += fmt::format(",\"args\":{{\"core\":{}}}}}", event.core);
+        }
+        is_first = false;
+        flush(false);
+    }
+    chunk += "]}\n";
+    flush(true);
+
+    heap_caps_free(events);
+    return is_ok;
+}
@@ -0,0 +1,108 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+/**
+ * @brief Timeline of begin, end, instant and counter events from any task or interrupt. Each core has its own ring,
+ * a slot is claimed with one atomic add so a call never blocks and never takes a lock. The rings keep the latest
+ * events. Written out as Chrome trace event JSON, which Perfetto and chrome://tracing load
+ *
+ * Names are kept by pointer, pass string literals. Calls while not recording cost one load
+ */
+class EventTrace {
+public:
+    enum Type_t : uint8_t {
+        TYPE_BEGIN = 0,
+        TYPE_END,
+        TYPE_INSTANT,
+        TYPE_COUNTER,
+    };
+
+    struct Stats_t {
+        bool isRecording  = false;
+        uint32_t capacity = 0;
+        // Since the start, the rings hold the latest capacity of them
+        uint32_t events = 0;
+    };
+
+    // Receives the JSON in pieces, returns false to stop
+    using Write_t = bool (*)(const char* data, size_t size, void* ctx);
+
+    /**
+     * @brief Allocate the rings in PSRAM and start recording, a running trace starts over
+     *
+     * @param bufferSize bytes of all rings together
+     * @return false if the rings could not be allocated
+     */
+    static bool start(size_t bufferSize);
+    static void stop();
+    static Stats_t getStats();
+
+    /**
+     * @brief Write the held events, recording pauses while the rings are copied
+     *
+     * @return false if write failed or there is nothing recorded
+     */
+    static bool write(Write_t write, void* ctx);
+
+    static void begin(const char* name)
+    {
+        if (_is_recording.load(std::memory_order_relaxed)) {
+            record(TYPE_BEGIN, name, 0);
+        }
+    }
+    static void end(const char* name)
+    {
+        if (_is_recording.load(std::memory_order_relaxed)) {
+            record(TYPE_END, name, 0);
+        }
+    }
+    static void instant(const char* name)
+    {
+        if (_is_recording.load(std::memory_order_relaxed)) {
+            record(TYPE_INSTANT, name, 0);
+        }
+    }
+    static void counter(const char* name, int32_t value)
+    {
+        if (_is_recording.load(std::memory_order_relaxed)) {
+            record(TYPE_COUNTER, name, value);
+        }
+    }
+
+private:
+    static inline std::atomic<bool> _is_recording{false};
+
+    static void record(Type_t type, const char* name, int32_t value);
+};
+
+// Begin on construction, end when it goes out of scope
+class EventTraceScope {
+public:
+    explicit EventTraceScope(const char* name) : _name(name)
+    {
+        EventTrace::begin(name);
+    }
+    ~EventTraceScope()
+    {
+        EventTrace::end(_name);
+    }
+
+private:
+    const char* _name;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b)       TRACE_CONCAT_INNER(a, b)
+
+#define TRACE_BEGIN(name)          EventTrace::begin(name)
+#define TRACE_END(name)            EventTrace::end(name)
+#define TRACE_INSTANT(name)        EventTrace::instant(name)
+#define TRACE_COUNTER(name, value) EventTrace::counter(name, value)
+#define TRACE_SCOPE(name)          EventTraceScope TRACE_CONCAT(_trace_scope_, __LINE__)(name)
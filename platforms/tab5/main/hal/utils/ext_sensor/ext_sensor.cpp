@@ -0,0 +1,207 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "ext_sensor.h"
+#include <algorithm>
+
+// Sensirion word CRC, polynomial 0x31, init 0xFF
+static uint8_t sensirion_crc(const uint8_t* data)
+{
+    uint8_t crc = 0xFF;
+    for (int i = 0; i < 2; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = crc & 0x80 ? (crc << 1) ^ 0x31 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// Big endian words each followed by its CRC
+static bool read_sensirion_words(const uint8_t* raw, uint16_t* words, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t* word = raw + i * 3;
+        if (sensirion_crc(word) != word[2]) {
+            return false;
+        }
+        words[i] = (word[0] << 8) | word[1];
+    }
+    return true;
+}
+
+/**
+ * @brief SHT30 of the ENV III unit, single shot at high repeatability
+ *
+ */
+class Sht30Driver : public ExtSensorDriver {
+public:
+    Sht30Driver()
+    {
+        _layout.address        = 0x44;
+        _layout.intervalMs     = 1000;
+        _layout.trigger        = {0x24, 0x00};
+        _layout.triggerDelayMs = 16;
+        _layout.readSize       = 6;
+        _layout.valueNames     = {"temp C", "rh %"};
+    }
+
+    const char* name() const override
+    {
+        return "sht30";
+    }
+
+    const Layout_t& layout() const override
+    {
+        return _layout;
+    }
+
+    bool decode(const uint8_t* raw, float* values) override
+    {
+        uint16_t words[2];
+        if (!read_sensirion_words(raw, words, 2)) {
+            return false;
+        }
+        values[0] = -45.0f + 175.0f * words[0] / 65535.0f;
+        values[1] = 100.0f * words[1] / 65535.0f;
+        return true;
+    }
+
+private:
+    Layout_t _layout;
+};
+
+/**
+ * @brief BH1750 of the DLight unit, continuous high resolution mode, a conversion takes up to 180ms
+ *
+ */
+class Bh1750Driver : public ExtSensorDriver {
+public:
+    Bh1750Driver()
+    {
+        _layout.address     = 0x23;
+        _layout.intervalMs  = 200;
+        _layout.initCommand = {0x10};
+        _layout.readSize    = 2;
+        _layout.valueNames  = {"light lx"};
+    }
+
+    const char* name() const override
+    {
+        return "bh1750";
+    }
+
+    const Layout_t& layout() const override
+    {
+        return _layout;
+    }
+
+    bool decode(const uint8_t* raw, float* values) override
+    {
+        values[0] = ((raw[0] << 8) | raw[1]) / 1.2f;
+        return true;
+    }
+
+private:
+    Layout_t _layout;
+};
+
+/**
+ * @brief SCD40 of the CO2 unit, periodic measurement, a new result every 5s
+ *
+ */
+class Scd40Driver : public ExtSensorDriver {
+public:
+    Scd40Driver()
+    {
+        _layout.address        = 0x62;
+        _layout.intervalMs     = 5000;
+        _layout.initCommand    = {0x21, 0xB1};
+        _layout.trigger        = {0xEC, 0x05};
+        _layout.triggerDelayMs = 1;
+        _layout.readSize       = 9;
+        _layout.valueNames     = {"co2 ppm", "temp C", "rh %"};
+    }
+
+    const char* name() const override
+    {
+        return "scd40";
+    }
+
+    const Layout_t& layout() const override
+    {
+        return _layout;
+    }
+
+    bool decode(const uint8_t* raw, float* values) override
+    {
+        uint16_t words[3];
+        if (!read_sensirion_words(raw, words, 3)) {
+            return false;
+        }
+        values[0] = words[0];
+        values[1] = -45.0f + 175.0f * words[1] / 65535.0f;
+        values[2] = 100.0f * words[2] / 65535.0f;
+        return true;
+    }
+
+private:
+    Layout_t _layout;
+};
+
+template <typename Driver>
+static std::unique_ptr<ExtSensorDriver> make_driver()
+{
+    return std::make_unique<Driver>();
+}
+
+ExtSensorRegistry& ExtSensorRegistry::instance()
+{
+    static ExtSensorRegistry registry = []() {
+        ExtSensorRegistry builtin;
+        builtin.add(0x44, make_driver<Sht30Driver>);
+        builtin.add(0x23, make_driver<Bh1750Driver>);
+        builtin.add(0x62, make_driver<Scd40Driver>);
+        return builtin;
+    }();
+    return registry;
+}
+
+void ExtSensorRegistry::add(uint8_t address, Factory_t factory)
+{
+    _entries.push_back({address, std::move(factory)});
+}
+
+std::vector<uint8_t> ExtSensorRegistry::addresses() const
+{
+    std::vector<uint8_t> result;
+    for (const auto& entry : _entries) {
+        if (std::find(result.begin(), result.end(), entry.address) == result.end()) {
+            result.push_back(entry.address);
+        }
+    }
+    return result;
+}
+
+std::vector<std::unique_ptr<ExtSensorDriver>> ExtSensorRegistry::bind(const std::vector<uint8_t>& addresses) const
+{
+    std::vector<std::unique_ptr<ExtSensorDriver>> drivers;
+    for (uint8_t address : addresses) {
+        for (const auto& entry : _entries) {
+            if (entry.address != address) {
+                continue;
+            }
+            // A driver that declares another address or too much data is a registration mistake
+            auto driver = entry.factory();
+            if (driver && driver->layout().address == address &&
+                driver->layout().readSize <= ExtSensorDriver::MaxReadSize &&
+                driver->layout().valueNames.size() <= ExtSensorDriver::MaxValues) {
+                drivers.push_back(std::move(driver));
+            }
+            break;
+        }
+    }
+    return drivers;
+}
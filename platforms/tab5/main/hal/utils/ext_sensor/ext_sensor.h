@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Driver for an external I2C unit, declared as data so one poller can batch the reads of every bound unit
+ *
+ * A read is an optional trigger write, a wait for the conversion, then one burst read of readSize bytes, either
+ * straight from the device or from reg on. The driver only turns the raw burst into values and never touches the
+ * bus itself.
+ *
+ */
+class ExtSensorDriver {
+public:
+    static constexpr size_t MaxValues   = 8;
+    static constexpr size_t MaxReadSize = 32;
+
+    struct Layout_t {
+        uint8_t address = 0;
+        // Read period, rounded up to the poll tick
+        uint16_t intervalMs = 1000;
+        // Written once after binding, e.g. a continuous conversion mode
+        std::vector<uint8_t> initCommand;
+        // Written before every read, the result is ready triggerDelayMs later
+        std::vector<uint8_t> trigger;
+        uint16_t triggerDelayMs = 0;
+        // Register the burst starts at, -1 reads without a register write
+        int16_t reg      = -1;
+        uint8_t readSize = 0;
+        // One name per value, with the unit, e.g. "temp C"
+        std::vector<const char*> valueNames;
+    };
+
+    virtual ~ExtSensorDriver() = default;
+
+    virtual const char* name() const = 0;
+    virtual const Layout_t& layout() const = 0;
+
+    /**
+     * @brief Turn a burst into values, in the order of layout().valueNames
+     *
+     * @return false on a corrupt read, e.g. a CRC mismatch, the previous reading is kept
+     */
+    virtual bool decode(const uint8_t* raw, float* values) = 0;
+};
+
+/**
+ * @brief Drivers by the address their unit answers on, a scan binds a driver for every address found
+ *
+ * Units that share an address are told apart by registration order, the first driver registered wins.
+ *
+ */
+class ExtSensorRegistry {
+public:
+    using Factory_t = std::function<std::unique_ptr<ExtSensorDriver>()>;
+
+    // Comes with the drivers of the M5 units below
+    static ExtSensorRegistry& instance();
+
+    void add(uint8_t address, Factory_t factory);
+
+    // Registered addresses, each once, the ones a scan has to probe
+    std::vector<uint8_t> addresses() const;
+
+    /**
+     * @brief New driver instances for the addresses that answered
+     *
+     */
+    std::vector<std::unique_ptr<ExtSensorDriver>> bind(const std::vector<uint8_t>& addresses) const;
+
+private:
+    struct Entry_t {
+        uint8_t address = 0;
+        Factory_t factory;
+    };
+    std::vector<Entry_t> _entries;
+};
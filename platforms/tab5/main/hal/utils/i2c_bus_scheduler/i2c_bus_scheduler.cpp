@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "i2c_bus_scheduler.h"
+#include <algorithm>
+#include <esp_timer.h>
+
+int64_t I2cBusScheduler::now_us()
+{
+    return esp_timer_get_time();
+}
+
+void I2cBusScheduler::acquire(Priority_t priority)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    _queued[priority]++;
+    _cv.wait(lock, [&]() {
+        if (_busy) {
+            return false;
+        }
+        for (int i = 0; i < priority; i++) {
+            if (_queued[i] > 0) {
+                return false;
+            }
+        }
+        return true;
+    });
+    _queued[priority]--;
+    _busy = true;
+}
+
+void I2cBusScheduler::release(uint8_t address, int64_t waitUs, int64_t busUs, bool ok)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _busy = false;
+
+        auto it = std::find_if(_stats.begin(), _stats.end(),
+                               [&](const DeviceStats_t& stats) { return stats.address == address; });
+        if (it == _stats.end()) {
+            _stats.emplace_back();
+            it          = _stats.end() - 1;
+            it->address = address;
+        }
+        it->batches++;
+        it->errors += ok ? 0 : 1;
+        it->maxWaitUs = std::max<uint32_t>(it->maxWaitUs, waitUs);
+        it->maxBusUs  = std::max<uint32_t>(it->maxBusUs, busUs);
+        it->totalWaitUs += waitUs;
+        it->totalBusUs += busUs;
+    }
+
+    // Every waiter rechecks, the highest queued class takes the next turn
+    _cv.notify_all();
+}
+
+std::vector<I2cBusScheduler::DeviceStats_t> I2cBusScheduler::getStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+void I2cBusScheduler::resetStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.clear();
+}
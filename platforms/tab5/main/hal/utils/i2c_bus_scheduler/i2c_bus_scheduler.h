@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include "../event_trace/event_trace.h"
+
+/**
+ * @brief Priority arbiter for a shared I2C bus, a batch of transactions runs as one turn and is timed per device
+ *
+ */
+class I2cBusScheduler {
+public:
+    // Lower value runs first
+    enum Priority_t {
+        PRIORITY_TOUCH = 0,
+        PRIORITY_CODEC,
+        PRIORITY_SENSOR,
+        PRIORITY_DIAGNOSTIC,
+        PRIORITY_NUM,
+    };
+
+    struct DeviceStats_t {
+        uint8_t address      = 0;
+        uint32_t batches     = 0;
+        uint32_t errors      = 0;
+        uint32_t maxWaitUs   = 0;
+        uint32_t maxBusUs    = 0;
+        uint64_t totalWaitUs = 0;
+        uint64_t totalBusUs  = 0;
+    };
+
+    /**
+     * @brief Run transfer as one bus turn, waiting while a higher priority batch is running or queued
+     *
+     * @param priority
+     * @param address 7 bit address the stats are kept under
+     * @param transfer every transaction it issues belongs to the batch, returns false on a bus error
+     * @return transfer's result
+     */
+    template <typename Transfer>
+    bool run(Priority_t priority, uint8_t address, Transfer&& transfer)
+    {
+        int64_t wait_start = now_us();
+        TRACE_BEGIN("i2c wait");
+        acquire(priority);
+        TRACE_END("i2c wait");
+        int64_t bus_start = now_us();
+        TRACE_BEGIN("i2c");
+        bool ok = transfer();
+        TRACE_END("i2c");
+        release(address, bus_start - wait_start, now_us() - bus_start, ok);
+        return ok;
+    }
+
+    std::vector<DeviceStats_t> getStats();
+    void resetStats();
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _busy                     = false;
+    uint16_t _queued[PRIORITY_NUM] = {0};
+    std::vector<DeviceStats_t> _stats;
+
+    static int64_t now_us();
+    void acquire(Priority_t priority);
+    void release(uint8_t address, int64_t waitUs, int64_t busUs, bool ok);
+};
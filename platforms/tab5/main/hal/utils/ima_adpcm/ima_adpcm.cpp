@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "ima_adpcm.h"
+#include <algorithm>
+
+static const int16_t _step_table[89] = {
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,    19,    21,    23,    25,    28,
+    31,    34,    37,    41,    45,    50,    55,    60,    66,    73,    80,    88,    97,    107,   118,
+    130,   143,   157,   173,   190,   209,   230,   253,   279,   307,   337,   371,   408,   449,   494,
+    544,   598,   658,   724,   796,   876,   963,   1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+    2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,  5894,  6484,  7132,  7845,  8630,
+    9493,  10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+static const int8_t _index_table[16] = {-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8};
+
+bool ImaAdpcmEncoder::init(uint8_t channels, uint16_t blockAlign)
+{
+    if (channels == 0 || channels > MaxChannels || blockAlign % (4 * channels) != 0 ||
+        blockAlign <= 4 * channels) {
+        return false;
+    }
+    _channels          = channels;
+    _block_align       = blockAlign;
+    _samples_per_block = (blockAlign - 4 * channels) * 2 / channels + 1;
+    for (auto& state : _state) {
+        state = Channel_t();
+    }
+    return true;
+}
+
+// The encoder runs the decoder's reconstruction, so both sides track the same predictor
+uint8_t ImaAdpcmEncoder::encode_sample(Channel_t& state, int16_t sample)
+{
+    int32_t step = _step_table[state.index];
+    int32_t diff = sample - state.predictor;
+    uint8_t code = 0;
+    if (diff < 0) {
+        code = 8;
+        diff = -diff;
+    }
+
+    int32_t delta = step >> 3;
+    if (diff >= step) {
+        code |= 4;
+        diff -= step;
+        delta += step;
+    }
+    if (diff >= step >> 1) {
+        code |= 2;
+        diff -= step >> 1;
+        delta += step >> 1;
+    }
+    if (diff >= step >> 2) {
+        code |= 1;
+        delta += step >> 2;
+    }
+
+    state.predictor += (code & 8) ? -delta : delta;
+    state.predictor = std::clamp<int32_t>(state.predictor, INT16_MIN, INT16_MAX);
+    state.index     = std::clamp<int>(state.index + _index_table[code], 0, 88);
+    return code;
+}
+
+void ImaAdpcmEncoder::encodeBlock(const int16_t* frames, uint8_t* block)
+{
+    // Headers, the first frame is stored as it is
+    for (uint8_t c = 0; c < _channels; c++) {
+        Channel_t& state = _state[c];
+        state.predictor  = frames[c];
+        block[0]         = state.predictor & 0xFF;
+        block[1]         = (state.predictor >> 8) & 0xFF;
+        block[2]         = state.index;
+        block[3]         = 0;
+        block += 4;
+    }
+
+    // Then 8 samples of each channel in turn, two a byte with the earlier one in the low nibble
+    for (size_t group = 1; group < _samples_per_block; group += 8) {
+        for (uint8_t c = 0; c < _channels; c++) {
+            const int16_t* src = frames + group * _channels + c;
+            for (int i = 0; i < 8; i += 2) {
+                uint8_t low  = encode_sample(_state[c], src[i * _channels]);
+                uint8_t high = encode_sample(_state[c], src[(i + 1) * _channels]);
+                *block++     = low | (high << 4);
+            }
+        }
+    }
+}
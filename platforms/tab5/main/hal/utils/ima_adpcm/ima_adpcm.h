@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief IMA ADPCM encoder for the WAV block layout (format 0x11), 4 bits a sample
+ *
+ * Each block starts with a header per channel holding the first sample and the step index, followed by the rest of
+ * the samples in 8 sample groups per channel. The step index carries over from block to block.
+ *
+ */
+class ImaAdpcmEncoder {
+public:
+    static constexpr uint8_t MaxChannels = 4;
+
+    /**
+     * @param channels 1~MaxChannels
+     * @param blockAlign bytes per block, a multiple of 4 per channel
+     * @return false on an invalid layout
+     */
+    bool init(uint8_t channels, uint16_t blockAlign);
+
+    // Frames one block holds, the header sample included
+    size_t samplesPerBlock() const
+    {
+        return _samples_per_block;
+    }
+    uint16_t blockAlign() const
+    {
+        return _block_align;
+    }
+
+    /**
+     * @brief Encode samplesPerBlock() interleaved frames into one block of blockAlign() bytes
+     *
+     */
+    void encodeBlock(const int16_t* frames, uint8_t* block);
+
+private:
+    struct Channel_t {
+        int32_t predictor = 0;
+        int8_t index      = 0;
+    };
+
+    uint8_t _channels         = 0;
+    uint16_t _block_align     = 0;
+    size_t _samples_per_block = 0;
+    Channel_t _state[MaxChannels];
+
+    uint8_t encode_sample(Channel_t& state, int16_t sample);
+};
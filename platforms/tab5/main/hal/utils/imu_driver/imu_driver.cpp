@@ -0,0 +1,220 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "imu_driver.h"
+#include <stdlib.h>
+#include <vector>
+#include <accel_gyro_bmi270.h>
+#include <accel_gyro_sensor_icm20602.h>
+
+static constexpr uint8_t _imu_addr = 0x68;
+static constexpr float _gravity    = 9.8f;
+static constexpr float _deg_to_rad = 3.14159265f / 180.0f;
+
+// Both chips sit on the same footprint, mounted rotated against the screen axes
+static constexpr int8_t _accel_map[3] = {2, -1, -3};
+static constexpr int8_t _gyro_map[3]  = {2, 1, -3};
+
+void ImuDriver::Conversion_t::remapAccel(const float in[3], float out[3]) const
+{
+    for (int i = 0; i < 3; i++) {
+        out[i] = accelScale[i] < 0.0f ? -in[accelAxis[i]] : in[accelAxis[i]];
+    }
+}
+
+void ImuDriver::setConversion(float accelRangeG, float gyroRangeDps, const int8_t accelMap[3],
+                              const int8_t gyroMap[3])
+{
+    // Signed 16 bit counts span the range both ways
+    float accel_per_count = accelRangeG * _gravity / 32768.0f / 10.0f;
+    float gyro_per_count  = gyroRangeDps / 32768.0f / 10.0f;
+    for (int i = 0; i < 3; i++) {
+        _conversion.accelAxis[i]  = std::abs(accelMap[i]) - 1;
+        _conversion.accelScale[i] = accelMap[i] < 0 ? -accel_per_count : accel_per_count;
+        _conversion.gyroAxis[i]   = std::abs(gyroMap[i]) - 1;
+        _conversion.gyroScale[i]  = gyroMap[i] < 0 ? -gyro_per_count : gyro_per_count;
+    }
+    _conversion.gyroRadScale = gyroRangeDps / 32768.0f * _deg_to_rad;
+}
+
+class Bmi270Driver : public ImuDriver {
+public:
+    Bmi270Driver()
+    {
+        // The ranges accel_gyro_bmi270_enable_sensor() and the FIFO setup use
+        setConversion(4.0f, 1000.0f, _accel_map, _gyro_map);
+    }
+
+    const char* name() const override
+    {
+        return "BMI270";
+    }
+
+    bool init(i2c_master_bus_handle_t bus) override
+    {
+        if (accel_gyro_bmi270_init(bus) != ESP_OK) {
+            return false;
+        }
+        if (accel_gyro_bmi270_check_irq()) {
+            accel_gyro_bmi270_clear_irq_int();
+        }
+        return true;
+    }
+
+    void enable() override
+    {
+        accel_gyro_bmi270_enable_sensor();
+    }
+
+    bool readFrame(RawFrame_t& frame) override
+    {
+        struct bmi2_sens_data data = {};
+        accel_gyro_bmi270_get_data(&data);
+        to_frame(data.acc, data.gyr, frame);
+        return true;
+    }
+
+    uint16_t fifoEnable(uint16_t rateHz, uint16_t watermarkFrames) override
+    {
+        return accel_gyro_bmi270_fifo_enable(rateHz, watermarkFrames) ? rateHz : 0;
+    }
+
+    void fifoDisable() override
+    {
+        accel_gyro_bmi270_fifo_disable();
+    }
+
+    uint16_t fifoRead(RawFrame_t* frames, uint16_t maxFrames) override
+    {
+        _accel.resize(maxFrames);
+        _gyro.resize(maxFrames);
+        uint16_t count = accel_gyro_bmi270_fifo_read(_accel.data(), _gyro.data(), maxFrames);
+        for (uint16_t i = 0; i < count; i++) {
+            to_frame(_accel[i], _gyro[i], frames[i]);
+        }
+        return count;
+    }
+
+    uint16_t fifoCapacity() const override
+    {
+        // 2KB of 12 byte headerless frames
+        return 170;
+    }
+
+    bool hasGestures() const override
+    {
+        return true;
+    }
+
+    bool gestureEnable(uint8_t gestureMask) override
+    {
+        return accel_gyro_bmi270_gesture_enable(gestureMask);
+    }
+
+    uint8_t gesturePoll(uint8_t* portraitLandscape, uint8_t* faceDown) override
+    {
+        return accel_gyro_bmi270_gesture_poll(portraitLandscape, faceDown);
+    }
+
+    bool motionWakeup() override
+    {
+        return accel_gyro_bmi270_motion_irq();
+    }
+
+private:
+    std::vector<bmi2_sens_axes_data> _accel;
+    std::vector<bmi2_sens_axes_data> _gyro;
+
+    static void to_frame(const bmi2_sens_axes_data& acc, const bmi2_sens_axes_data& gyr, RawFrame_t& frame)
+    {
+        frame.accel[0] = acc.x;
+        frame.accel[1] = acc.y;
+        frame.accel[2] = acc.z;
+        frame.gyro[0]  = gyr.x;
+        frame.gyro[1]  = gyr.y;
+        frame.gyro[2]  = gyr.z;
+    }
+};
+
+class Icm20602Driver : public ImuDriver {
+public:
+    Icm20602Driver()
+    {
+        // Set by accel_gyro_sensor_icm20602_init()
+        setConversion(4.0f, 1000.0f, _accel_map, _gyro_map);
+    }
+
+    const char* name() const override
+    {
+        return "ICM20602";
+    }
+
+    bool init(i2c_master_bus_handle_t bus) override
+    {
+        // No wakeup interrupt is used on this chip, init leaves its interrupts off
+        return accel_gyro_sensor_icm20602_init(bus) == ESP_OK;
+    }
+
+    void enable() override
+    {
+        // Measuring since init
+    }
+
+    bool readFrame(RawFrame_t& frame) override
+    {
+        return accel_gyro_sensor_icm20602_read_raw(frame.accel, frame.gyro) == ESP_OK;
+    }
+
+    uint16_t fifoEnable(uint16_t rateHz, uint16_t watermarkFrames) override
+    {
+        // Polled like the BMI270, the watermark interrupt has nowhere to go
+        return accel_gyro_sensor_icm20602_fifo_enable(rateHz);
+    }
+
+    void fifoDisable() override
+    {
+        accel_gyro_sensor_icm20602_fifo_disable();
+    }
+
+    uint16_t fifoRead(RawFrame_t* frames, uint16_t maxFrames) override
+    {
+        static_assert(sizeof(RawFrame_t) == 6 * sizeof(int16_t), "frames are read as packed int16_t");
+        return accel_gyro_sensor_icm20602_fifo_read(reinterpret_cast<int16_t*>(frames), maxFrames);
+    }
+
+    uint16_t fifoCapacity() const override
+    {
+        // 1008 bytes of 14 byte frames, temperature included
+        return 72;
+    }
+};
+
+static bool read_chip_id(i2c_master_bus_handle_t bus, uint8_t reg, uint8_t& id)
+{
+    i2c_device_config_t dev_cfg = {};
+    dev_cfg.dev_addr_length     = I2C_ADDR_BIT_LEN_7;
+    dev_cfg.device_address      = _imu_addr;
+    dev_cfg.scl_speed_hz        = 400000;
+    i2c_master_dev_handle_t dev = nullptr;
+    if (i2c_master_bus_add_device(bus, &dev_cfg, &dev) != ESP_OK) {
+        return false;
+    }
+    esp_err_t ret = i2c_master_transmit_receive(dev, &reg, 1, &id, 1, 50);
+    i2c_master_bus_rm_device(dev);
+    return ret == ESP_OK;
+}
+
+std::unique_ptr<ImuDriver> ImuDriver::probe(i2c_master_bus_handle_t bus)
+{
+    // BMI270 CHIP_ID, then ICM20602 WHO_AM_I
+    uint8_t id = 0;
+    if (read_chip_id(bus, 0x00, id) && id == 0x24) {
+        return std::make_unique<Bmi270Driver>();
+    }
+    if (read_chip_id(bus, 0x75, id) && id == 0x12) {
+        return std::make_unique<Icm20602Driver>();
+    }
+    return nullptr;
+}
@@ -0,0 +1,120 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <memory>
+#include <driver/i2c_master.h>
+
+/**
+ * @brief One accel + gyro chip behind a common interface, readings are raw counts on the chip axes
+ *
+ * Board revisions carry either a BMI270 or an ICM20602 at the same address, probe() finds out which.
+ * Calls are not thread safe and go through the I2C scheduler, the same as the chip drivers underneath.
+ */
+class ImuDriver {
+public:
+    struct RawFrame_t {
+        int16_t accel[3];
+        int16_t gyro[3];
+    };
+
+    /**
+     * @brief Counts to IMUData_t units and axes, built once from the ranges the chip is set to
+     *
+     * Board axis i is chip axis accelAxis[i] times accelScale[i], the sign of the remap is folded into the scale.
+     * Accel is in tenths of m/s^2 and gyro in tenths of dps, as the UI has always been fed.
+     */
+    struct Conversion_t {
+        uint8_t accelAxis[3] = {0, 1, 2};
+        float accelScale[3]  = {0.0f, 0.0f, 0.0f};
+        uint8_t gyroAxis[3]  = {0, 1, 2};
+        float gyroScale[3]   = {0.0f, 0.0f, 0.0f};
+        // Chip axes, rad/s per count, for the fusion
+        float gyroRadScale = 0.0f;
+
+        // A chip frame direction on the board axes, without the scale
+        void remapAccel(const float in[3], float out[3]) const;
+    };
+
+    virtual ~ImuDriver() = default;
+
+    /**
+     * @brief Read the chip ids at the IMU address
+     *
+     * @return the driver of the chip that answered, nullptr if none did
+     */
+    static std::unique_ptr<ImuDriver> probe(i2c_master_bus_handle_t bus);
+
+    virtual const char* name() const = 0;
+
+    uint8_t address() const
+    {
+        return 0x68;
+    }
+
+    const Conversion_t& conversion() const
+    {
+        return _conversion;
+    }
+
+    // Bring the chip up and clear a latched wakeup interrupt, also how the wakeup config is undone
+    virtual bool init(i2c_master_bus_handle_t bus) = 0;
+
+    // Accel and gyro on at the ranges of conversion()
+    virtual void enable() = 0;
+
+    // Accel and gyro in one burst read
+    virtual bool readFrame(RawFrame_t& frame) = 0;
+
+    /**
+     * @brief Stream accel and gyro frames through the chip FIFO
+     *
+     * @param rateHz requested, the chip may run at the nearest rate it has
+     * @param watermarkFrames
+     * @return the rate it runs at, 0 on failure
+     */
+    virtual uint16_t fifoEnable(uint16_t rateHz, uint16_t watermarkFrames) = 0;
+    virtual void fifoDisable() = 0;
+
+    // Whole frames in the FIFO, oldest first
+    virtual uint16_t fifoRead(RawFrame_t* frames, uint16_t maxFrames) = 0;
+
+    // Frames a full FIFO holds, the most one read returns
+    virtual uint16_t fifoCapacity() const = 0;
+
+    // On chip gesture detection, the masks are the HAL ImuGesture_t ones
+    virtual bool hasGestures() const
+    {
+        return false;
+    }
+    virtual bool gestureEnable(uint8_t gestureMask)
+    {
+        return false;
+    }
+    virtual uint8_t gesturePoll(uint8_t* portraitLandscape, uint8_t* faceDown)
+    {
+        return 0;
+    }
+
+    // Arm the any motion interrupt that powers the board back up
+    virtual bool motionWakeup()
+    {
+        return false;
+    }
+
+protected:
+    Conversion_t _conversion;
+
+    /**
+     * @brief Fill the conversion for a full scale range
+     *
+     * @param accelRangeG +-g at full scale
+     * @param gyroRangeDps +-dps at full scale
+     * @param accelMap board axis from chip axis, 1 based and signed, {2, -1, -3} is x = y, y = -x, z = -z
+     * @param gyroMap
+     */
+    void setConversion(float accelRangeG, float gyroRangeDps, const int8_t accelMap[3], const int8_t gyroMap[3]);
+};
@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "imu_fusion.h"
+#include <math.h>
+
+void ImuFusion::init(const Config_t& config)
+{
+    _dt   = 1.0f / config.sampleRate;
+    _kp   = config.kp;
+    _ki   = config.ki;
+    _q0   = 1.0f;
+    _q1   = 0.0f;
+    _q2   = 0.0f;
+    _q3   = 0.0f;
+    _ix   = 0.0f;
+    _iy   = 0.0f;
+    _iz   = 0.0f;
+    _init = false;
+}
+
+void ImuFusion::init_from_accel(float ax, float ay, float az)
+{
+    // Start level with the measured gravity instead of converging from identity
+    float roll  = atan2f(ay, az);
+    float pitch = atan2f(-ax, sqrtf(ay * ay + az * az));
+    float cr    = cosf(roll * 0.5f);
+    float sr    = sinf(roll * 0.5f);
+    float cp    = cosf(pitch * 0.5f);
+    float sp    = sinf(pitch * 0.5f);
+    _q0         = cr * cp;
+    _q1         = sr * cp;
+    _q2         = cr * sp;
+    _q3         = -sr * sp;
+    _init       = true;
+}
+
+void ImuFusion::update(float gx, float gy, float gz, float ax, float ay, float az)
+{
+    float norm = ax * ax + ay * ay + az * az;
+    if (norm > 0.0f) {
+        if (!_init) {
+            init_from_accel(ax, ay, az);
+        }
+
+        norm = 1.0f / sqrtf(norm);
+        ax *= norm;
+        ay *= norm;
+        az *= norm;
+
+        // Error is the cross product of the measured and the estimated gravity direction
+        float vx = 2.0f * (_q1 * _q3 - _q0 * _q2);
+        float vy = 2.0f * (_q0 * _q1 + _q2 * _q3);
+        float vz = _q0 * _q0 - _q1 * _q1 - _q2 * _q2 + _q3 * _q3;
+        float ex = ay * vz - az * vy;
+        float ey = az * vx - ax * vz;
+        float ez = ax * vy - ay * vx;
+
+        if (_ki > 0.0f) {
+            _ix += _ki * ex * _dt;
+            _iy += _ki * ey * _dt;
+            _iz += _ki * ez * _dt;
+        }
+        gx += _kp * ex + _ix;
+        gy += _kp * ey + _iy;
+        gz += _kp * ez + _iz;
+    }
+
+    // Integrate the rate of change of the quaternion
+    gx *= 0.5f * _dt;
+    gy *= 0.5f * _dt;
+    gz *= 0.5f * _dt;
+    float q0 = _q0;
+    float q1 = _q1;
+    float q2 = _q2;
+    _q0 += -q1 * gx - q2 * gy - _q3 * gz;
+    _q1 += q0 * gx + q2 * gz - _q3 * gy;
+    _q2 += q0 * gy - q1 * gz + _q3 * gx;
+    _q3 += q0 * gz + q1 * gy - q2 * gx;
+
+    norm = 1.0f / sqrtf(_q0 * _q0 + _q1 * _q1 + _q2 * _q2 + _q3 * _q3);
+    _q0 *= norm;
+    _q1 *= norm;
+    _q2 *= norm;
+    _q3 *= norm;
+}
+
+void ImuFusion::getQuaternion(float q[4]) const
+{
+    q[0] = _q0;
+    q[1] = _q1;
+    q[2] = _q2;
+    q[3] = _q3;
+}
+
+void ImuFusion::getGravity(float g[3]) const
+{
+    g[0] = 2.0f * (_q1 * _q3 - _q0 * _q2);
+    g[1] = 2.0f * (_q0 * _q1 + _q2 * _q3);
+    g[2] = _q0 * _q0 - _q1 * _q1 - _q2 * _q2 + _q3 * _q3;
+}
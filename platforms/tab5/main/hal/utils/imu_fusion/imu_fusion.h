@@ -0,0 +1,57 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+
+/**
+ * @brief Mahony complementary filter, gyro integration corrected towards the measured gravity direction
+ *
+ */
+class ImuFusion {
+public:
+    struct Config_t {
+        // Fixed sample rate of update()
+        float sampleRate = 400.0f;
+        // Proportional and integral gains of the accel correction
+        float kp = 1.0f;
+        float ki = 0.0f;
+    };
+
+    void init(const Config_t& config);
+
+    /**
+     * @brief Advance one sample, in a right handed sensor frame
+     *
+     * @param gx gyro, rad/s
+     * @param gy
+     * @param gz
+     * @param ax accel, any unit, only the direction is used
+     * @param ay
+     * @param az
+     */
+    void update(float gx, float gy, float gz, float ax, float ay, float az);
+
+    // Sensor to world rotation, w x y z
+    void getQuaternion(float q[4]) const;
+
+    // Unit gravity direction in the sensor frame, points where a resting accelerometer reads +1g
+    void getGravity(float g[3]) const;
+
+private:
+    float _dt  = 1.0f / 400.0f;
+    float _kp  = 1.0f;
+    float _ki  = 0.0f;
+    float _q0  = 1.0f;
+    float _q1  = 0.0f;
+    float _q2  = 0.0f;
+    float _q3  = 0.0f;
+    float _ix  = 0.0f;
+    float _iy  = 0.0f;
+    float _iz  = 0.0f;
+    bool _init = false;
+
+    void init_from_accel(float ax, float ay, float az);
+};
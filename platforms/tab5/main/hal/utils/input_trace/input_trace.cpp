@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "input_trace.h"
+#include <stdio.h>
+
+static const char* _file_header = "# input trace v1: time_ms pressed x y\n";
+
+bool InputTrace::startRecord(const std::string& path, uint32_t nowMs)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_state != Idle) {
+        return false;
+    }
+
+    // Created up front, a bad path shows at the start and not after a long session
+    FILE* file = fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    fclose(file);
+
+    _path = path;
+    _events.clear();
+    _start_time = nowMs;
+    _last       = Event_t();
+    _state      = Recording;
+    return true;
+}
+
+bool InputTrace::startReplay(const std::string& path, uint32_t nowMs)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_state != Idle) {
+        return false;
+    }
+
+    FILE* file = fopen(path.c_str(), "r");
+    if (file == nullptr) {
+        return false;
+    }
+    _events.clear();
+    char line[64];
+    while (fgets(line, sizeof(line), file) != nullptr && _events.size() < MaxEvents) {
+        Event_t event;
+        unsigned long time_ms = 0;
+        int pressed = 0;
+        long x = 0;
+        long y = 0;
+        if (line[0] == '#' || sscanf(line, "%lu %d %ld %ld", &time_ms, &pressed, &x, &y) != 4) {
+            continue;
+        }
+        event.timeMs  = time_ms;
+        event.pressed = pressed != 0;
+        event.x       = x;
+        event.y       = y;
+        _events.push_back(event);
+    }
+    fclose(file);
+    if (_events.empty()) {
+        return false;
+    }
+
+    _replay_index = 0;
+    _start_time   = nowMs;
+    _last         = Event_t();
+    _state        = Replaying;
+    return true;
+}
+
+void InputTrace::stop(bool dropLastTap)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_state == Recording) {
+        // The trace then ends on the release before it
+        if (dropLastTap) {
+            while (!_events.empty() && !_events.back().pressed) {
+                _events.pop_back();
+            }
+            while (!_events.empty() && _events.back().pressed) {
+                _events.pop_back();
+            }
+        }
+        write_file();
+    }
+    _state = Idle;
+}
+
+bool InputTrace::process(uint32_t nowMs, bool& pressed, int32_t& x, int32_t& y)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    uint32_t elapsed = nowMs - _start_time;
+
+    if (_state == Recording) {
+        // Only changes, a held finger reports the same sample on every read
+        bool is_changed = _events.empty() || pressed != _last.pressed || (pressed && (x != _last.x || y != _last.y));
+        if (is_changed && _events.size() < MaxEvents) {
+            _last.timeMs  = elapsed;
+            _last.pressed = pressed;
+            _last.x       = x;
+            _last.y       = y;
+            _events.push_back(_last);
+        }
+        return false;
+    }
+
+    if (_state != Replaying) {
+        return false;
+    }
+
+    // One sample per read, so a tap shorter than the read period still presses and releases
+    if (_replay_index < _events.size() && _events[_replay_index].timeMs <= elapsed) {
+        _last = _events[_replay_index++];
+    }
+    if (_replay_index >= _events.size() && !_last.pressed) {
+        _state = Idle;
+    }
+    pressed = _last.pressed;
+    x       = _last.x;
+    y       = _last.y;
+    return _replay_index < _events.size() && _events[_replay_index].timeMs <= elapsed;
+}
+
+InputTrace::State_t InputTrace::getState()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _state;
+}
+
+size_t InputTrace::getEventCount()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _state == Replaying ? _replay_index : _events.size();
+}
+
+uint32_t InputTrace::getElapsedMs(uint32_t nowMs)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _state == Idle ? 0 : nowMs - _start_time;
+}
+
+uint32_t InputTrace::getDurationMs()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _state == Replaying ? _events.back().timeMs : 0;
+}
+
+bool InputTrace::write_file()
+{
+    FILE* file = fopen(_path.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    fputs(_file_header, file);
+    for (const auto& event : _events) {
+        fprintf(file, "%lu %d %ld %ld\n", (unsigned long)event.timeMs, event.pressed ? 1 : 0, (long)event.x,
+                (long)event.y);
+    }
+    fclose(file);
+    return true;
+}
@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Records the pointer samples an LVGL read callback reports, and feeds them back on the same timeline. Shared
+ * by the Tab5 touch driver and the desktop mouse, a trace recorded on one replays on the other
+ *
+ * File format, one text line per change of the reported state, times from the start of the recording:
+ * "<time_ms> <pressed 0|1> <x> <y>", lines starting with # are comments
+ *
+ */
+class InputTrace {
+public:
+    enum State_t {
+        Idle = 0,
+        Recording,
+        Replaying,
+    };
+
+    struct Event_t {
+        uint32_t timeMs = 0;
+        bool pressed    = false;
+        int32_t x       = 0;
+        int32_t y       = 0;
+    };
+
+    // About half an hour of continuous dragging at the touch report rate
+    static constexpr size_t MaxEvents = 200000;
+
+    /**
+     * @brief Start buffering the reported samples, written to the file on stop()
+     *
+     * @return false if busy or the file can not be created
+     */
+    bool startRecord(const std::string& path, uint32_t nowMs);
+
+    /**
+     * @brief Load a trace, its samples replace the real ones from now on
+     *
+     * @return false if busy, or the file is missing or empty
+     */
+    bool startReplay(const std::string& path, uint32_t nowMs);
+
+    /**
+     * @brief End a recording (the file is written here) or a replay
+     *
+     * @param dropLastTap leave out the last press, for a recording stopped by a tap on the screen
+     */
+    void stop(bool dropLastTap = false);
+
+    /**
+     * @brief Called by the read callback with the sample it is about to report. A recording keeps it, a replay
+     * overwrites it with the replayed one. A replay that runs out ends with a release
+     *
+     * @return true if more replayed samples are due, the callback asks LVGL to read again
+     */
+    bool process(uint32_t nowMs, bool& pressed, int32_t& x, int32_t& y);
+
+    State_t getState();
+    size_t getEventCount();
+    uint32_t getElapsedMs(uint32_t nowMs);
+    // Time of the last event of the replayed trace, 0 otherwise
+    uint32_t getDurationMs();
+
+private:
+    std::mutex _mutex;
+    State_t _state = Idle;
+    std::string _path;
+    std::vector<Event_t> _events;
+    size_t _replay_index = 0;
+    uint32_t _start_time = 0;
+    Event_t _last;
+
+    bool write_file();
+};
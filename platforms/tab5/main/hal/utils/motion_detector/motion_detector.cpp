@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "motion_detector.h"
+#include "../pixel_convert/pixel_convert.h"
+#include <algorithm>
+#include <stdlib.h>
+
+void MotionDetector::init(const Config_t& config)
+{
+    _config           = config;
+    _config.blockSize = std::max<uint8_t>(_config.blockSize, 1);
+    _width            = 0;
+    _height           = 0;
+}
+
+void MotionDetector::resize(uint16_t width, uint16_t height)
+{
+    _width    = width;
+    _height   = height;
+    _blocks_x = (width + _config.blockSize - 1) / _config.blockSize;
+    _blocks_y = (height + _config.blockSize - 1) / _config.blockSize;
+    _warmup   = _config.warmupFrames;
+    _reference.assign((size_t)width * height, 0);
+    _current.assign((size_t)width * height, 0);
+    _block_sums.assign((size_t)_blocks_x * _blocks_y, 0);
+}
+
+// Luma from the shared RGB565 kernel, returns the luma sum
+int32_t MotionDetector::to_luma(const uint16_t* frame)
+{
+    pixel_convert::Kernel<pixel_convert::FORMAT_RGB565, pixel_convert::FORMAT_GREY>::run(
+        (const uint8_t*)frame, _width * 2, _current.data(), _width, _width, _height);
+    int32_t sum = 0;
+    for (uint8_t y : _current) {
+        sum += y;
+    }
+    return sum;
+}
+
+MotionDetector::Result_t MotionDetector::update(const uint16_t* frame, uint16_t width, uint16_t height)
+{
+    if (width != _width || height != _height) {
+        resize(width, height);
+    }
+    if (_current.empty()) {
+        return compare(0);
+    }
+    return compare(to_luma(frame));
+}
+
+MotionDetector::Result_t MotionDetector::update(const uint8_t* frame, uint16_t width, uint16_t height)
+{
+    if (width != _width || height != _height) {
+        resize(width, height);
+    }
+    int32_t sum = 0;
+    for (size_t i = 0; i < _current.size(); i++) {
+        sum += frame[i];
+    }
+    std::copy(frame, frame + _current.size(), _current.begin());
+    return compare(sum);
+}
+
+// _current holds the new frame
+MotionDetector::Result_t MotionDetector::compare(int32_t lumaSum)
+{
+    Result_t result;
+    result.totalBlocks = _blocks_x * _blocks_y;
+    if (_current.empty()) {
+        return result;
+    }
+
+    int32_t mean = lumaSum / (int32_t)_current.size();
+    if (_warmup > 0) {
+        _warmup--;
+        _current.swap(_reference);
+        _reference_mean = mean;
+        return result;
+    }
+
+    // A global brightness step moves every pixel alike, it is taken out before the difference
+    int32_t offset = mean - _reference_mean;
+    uint8_t bs     = _config.blockSize;
+    std::fill(_block_sums.begin(), _block_sums.end(), 0);
+    for (uint16_t y = 0; y < _height; y++) {
+        const uint8_t* cur = &_current[(size_t)y * _width];
+        const uint8_t* ref = &_reference[(size_t)y * _width];
+        uint32_t* sums     = &_block_sums[(size_t)(y / bs) * _blocks_x];
+        for (uint16_t x0 = 0; x0 < _width; x0 += bs) {
+            uint16_t x1  = std::min<uint16_t>(x0 + bs, _width);
+            uint32_t sad = 0;
+            for (uint16_t x = x0; x < x1; x++) {
+                sad += abs(cur[x] - ref[x] - offset);
+            }
+            sums[x0 / bs] += sad;
+        }
+    }
+
+    for (uint16_t by = 0; by < _blocks_y; by++) {
+        uint32_t block_h = std::min<uint32_t>(bs, _height - by * bs);
+        for (uint16_t bx = 0; bx < _blocks_x; bx++) {
+            uint32_t block_w = std::min<uint32_t>(bs, _width - bx * bs);
+            uint32_t diff    = _block_sums[(size_t)by * _blocks_x + bx] / (block_w * block_h);
+            result.maxDiff   = std::max<uint32_t>(result.maxDiff, std::min<uint32_t>(diff, 255));
+            if (diff > _config.threshold) {
+                result.changedBlocks++;
+            }
+        }
+    }
+
+    _current.swap(_reference);
+    _reference_mean = mean;
+    return result;
+}
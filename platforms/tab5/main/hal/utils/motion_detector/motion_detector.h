@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Block wise frame difference on a small RGB565 or grey frame, each frame is compared with the previous one
+ * after taking out the change of the mean luma, so an exposure step or a light switched on is not motion
+ *
+ */
+class MotionDetector {
+public:
+    struct Config_t {
+        // Square blocks, edge blocks are cut at the frame border
+        uint8_t blockSize = 10;
+        // Mean absolute luma difference inside a block for it to count as changed, 0 ~ 255
+        uint8_t threshold = 10;
+        // Frames after init or a size change that only become the reference, the AE settles meanwhile
+        uint8_t warmupFrames = 3;
+    };
+
+    struct Result_t {
+        uint16_t changedBlocks = 0;
+        uint16_t totalBlocks   = 0;
+        // Largest block mean difference
+        uint8_t maxDiff = 0;
+    };
+
+    void init(const Config_t& config);
+
+    /**
+     * @brief Compare a frame with the previous one
+     *
+     * @param frame RGB565, rows packed
+     * @param width
+     * @param height
+     * @return no changed blocks while warming up
+     */
+    Result_t update(const uint16_t* frame, uint16_t width, uint16_t height);
+
+    /**
+     * @brief Compare a grey frame with the previous one
+     *
+     * @param frame 8 bit luma, rows packed
+     * @param width
+     * @param height
+     * @return no changed blocks while warming up
+     */
+    Result_t update(const uint8_t* frame, uint16_t width, uint16_t height);
+
+private:
+    Config_t _config;
+    uint16_t _width         = 0;
+    uint16_t _height        = 0;
+    uint16_t _blocks_x      = 0;
+    uint16_t _blocks_y      = 0;
+    uint8_t _warmup         = 0;
+    int32_t _reference_mean = 0;
+    std::vector<uint8_t> _reference;
+    std::vector<uint8_t> _current;
+    std::vector<uint32_t> _block_sums;
+
+    void resize(uint16_t width, uint16_t height);
+    int32_t to_luma(const uint16_t* frame);
+    Result_t compare(int32_t lumaSum);
+};
@@ -0,0 +1,179 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "pixel_convert.h"
+#include <array>
+#include <utility>
+#include <esp_cache.h>
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+
+using namespace pixel_convert;
+
+static const char* TAG = "pixel-convert";
+
+template <size_t... I>
+static constexpr std::array<KernelFn, FORMAT_NUM * FORMAT_NUM> make_kernel_table(std::index_sequence<I...>)
+{
+    return {{&Kernel<(Format_t)(I / FORMAT_NUM), (Format_t)(I % FORMAT_NUM)>::run...}};
+}
+
+static constexpr auto _kernels = make_kernel_table(std::make_index_sequence<FORMAT_NUM * FORMAT_NUM>());
+
+KernelFn pixel_convert::get_kernel(Format_t from, Format_t to)
+{
+    if (from >= FORMAT_NUM || to >= FORMAT_NUM) {
+        return nullptr;
+    }
+    return _kernels[from * FORMAT_NUM + to];
+}
+
+void pixel_convert::scale_rgb565(const uint8_t* src, uint32_t srcStride, uint32_t srcWidth, uint32_t srcHeight,
+                                 uint8_t* dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight)
+{
+    for (uint32_t y = 0; y < dstHeight; y++) {
+        auto src_row = (const uint16_t*)(src + (y * srcHeight / dstHeight) * srcStride);
+        auto dst_row = (uint16_t*)(dst + y * dstStride);
+        for (uint32_t x = 0; x < dstWidth; x++) {
+            dst_row[x] = src_row[x * srcWidth / dstWidth];
+        }
+    }
+}
+
+// The SRM color modes, the PPA has no grey
+static bool get_ppa_color_mode(Format_t format, ppa_srm_color_mode_t& mode)
+{
+    switch (format) {
+        case FORMAT_RGB565:
+            mode = PPA_SRM_COLOR_MODE_RGB565;
+            return true;
+        case FORMAT_RGB888:
+            mode = PPA_SRM_COLOR_MODE_RGB888;
+            return true;
+        case FORMAT_ARGB8888:
+            mode = PPA_SRM_COLOR_MODE_ARGB8888;
+            return true;
+        case FORMAT_YUV420:
+            mode = PPA_SRM_COLOR_MODE_YUV420;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Stride in whole pixels, the PPA takes rows as a picture width
+static bool get_stride_pixels(Format_t format, uint32_t stride, uint32_t& pixels)
+{
+    uint32_t bits = stride * 8;
+    if (bits % bits_per_pixel(format) != 0) {
+        return false;
+    }
+    pixels = bits / bits_per_pixel(format);
+    return format != FORMAT_YUV420 || pixels % 2 == 0;
+}
+
+PixelConverter::~PixelConverter()
+{
+    if (_ppa) {
+        ppa_unregister_client(_ppa);
+    }
+}
+
+void PixelConverter::init(const Config_t& config)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _config = config;
+}
+
+bool PixelConverter::convert(const Image_t& src, void* dst, Format_t dstFormat, uint32_t dstStride)
+{
+    KernelFn kernel = get_kernel(src.format, dstFormat);
+    if (kernel == nullptr || src.data == nullptr || dst == nullptr) {
+        return false;
+    }
+    bool is_yuv = src.format == FORMAT_YUV420 || dstFormat == FORMAT_YUV420;
+    if (is_yuv && (src.width % 2 || src.height % 2)) {
+        return false;
+    }
+
+    uint32_t src_stride = src.stride ? src.stride : row_bytes(src.format, src.width);
+    dstStride           = dstStride ? dstStride : row_bytes(dstFormat, src.width);
+    uint32_t pixels     = (uint32_t)src.width * src.height;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_config.usePpa && pixels >= _config.minPpaPixels) {
+        Image_t strided = src;
+        strided.stride  = src_stride;
+        if (convert_ppa(strided, dst, dstFormat, dstStride)) {
+            _stats.ppaCalls++;
+            _stats.ppaPixels += pixels;
+            return true;
+        }
+    }
+
+    kernel((const uint8_t*)src.data, src_stride, (uint8_t*)dst, dstStride, src.width, src.height);
+    _stats.cpuCalls++;
+    _stats.cpuPixels += pixels;
+    return true;
+}
+
+// False when the block does not fit the PPA, the CPU kernel takes it then
+bool PixelConverter::convert_ppa(const Image_t& src, void* dst, Format_t dstFormat, uint32_t dstStride)
+{
+    ppa_srm_color_mode_t in_cm;
+    ppa_srm_color_mode_t out_cm;
+    uint32_t in_pic_w  = 0;
+    uint32_t out_pic_w = 0;
+    if (_is_ppa_failed || !get_ppa_color_mode(src.format, in_cm) || !get_ppa_color_mode(dstFormat, out_cm) ||
+        !get_stride_pixels(src.format, src.stride, in_pic_w) || !get_stride_pixels(dstFormat, dstStride, out_pic_w)) {
+        return false;
+    }
+
+    // The PPA writes whole cache lines of the destination, a partial one would clobber its neighbour
+    if (_cache_align == 0 &&
+        esp_cache_get_alignment(MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA, &_cache_align) != ESP_OK) {
+        _cache_align = 128;
+    }
+    uint32_t out_size = dstStride * src.height;
+    if ((uintptr_t)dst % _cache_align || out_size % _cache_align) {
+        return false;
+    }
+
+    if (_ppa == nullptr) {
+        ppa_client_config_t ppa_config = {
+            .oper_type             = PPA_OPERATION_SRM,
+            .max_pending_trans_num = 1,
+        };
+        if (ppa_register_client(&ppa_config, &_ppa) != ESP_OK) {
+            ESP_LOGW(TAG, "no ppa client, converting on the cpu");
+            _is_ppa_failed = true;
+            return false;
+        }
+    }
+
+    ppa_srm_oper_config_t oper = {};
+    oper.in.buffer             = src.data;
+    oper.in.pic_w              = in_pic_w;
+    oper.in.pic_h              = src.height;
+    oper.in.block_w            = src.width;
+    oper.in.block_h            = src.height;
+    oper.in.srm_cm             = in_cm;
+    oper.out.buffer            = dst;
+    oper.out.buffer_size       = out_size;
+    oper.out.pic_w             = out_pic_w;
+    oper.out.pic_h             = src.height;
+    oper.out.srm_cm            = out_cm;
+    oper.rotation_angle        = PPA_SRM_ROTATION_ANGLE_0;
+    oper.scale_x               = 1.0f;
+    oper.scale_y               = 1.0f;
+    oper.mode                  = PPA_TRANS_MODE_BLOCKING;
+    return ppa_do_scale_rotate_mirror(_ppa, &oper) == ESP_OK;
+}
+
+PixelConverter::Stats_t PixelConverter::getStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
@@ -0,0 +1,413 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <mutex>
+#include <driver/ppa.h>
+
+/**
+ * @brief Pixel format conversion kernels, one per pair of formats, picked at compile time. A kernel converts a
+ * block of rows with a stride of its own on each side. Pairs without a kernel of their own go through Rgb_t one pixel
+ * at a time, the hot ones read and write whole 32 bit words
+ *
+ */
+namespace pixel_convert {
+
+enum Format_t : uint8_t {
+    // 16 bit little endian, as LVGL and the PPA store it
+    FORMAT_RGB565 = 0,
+    // B, G, R in memory
+    FORMAT_RGB888,
+    // B, G, R, A in memory
+    FORMAT_ARGB8888,
+    // 8 bit luma
+    FORMAT_GREY,
+    // The ISP's packed 4:2:0, lines in pairs, U Y Y on the first and V Y Y on the second for every two pixels. Even
+    // widths and heights only
+    FORMAT_YUV420,
+    FORMAT_NUM,
+};
+
+constexpr uint32_t bits_per_pixel(Format_t format)
+{
+    return format == FORMAT_RGB565     ? 16
+           : format == FORMAT_RGB888   ? 24
+           : format == FORMAT_ARGB8888 ? 32
+           : format == FORMAT_GREY     ? 8
+                                       : 12;
+}
+
+constexpr uint32_t row_bytes(Format_t format, uint32_t width)
+{
+    return width * bits_per_pixel(format) / 8;
+}
+
+struct Rgb_t {
+    uint8_t r = 0;
+    uint8_t g = 0;
+    uint8_t b = 0;
+    uint8_t a = 0xFF;
+};
+
+// BT.601, full range like the JPEG codec
+static inline uint8_t luma(uint8_t r, uint8_t g, uint8_t b)
+{
+    return (77 * r + 150 * g + 29 * b) >> 8;
+}
+
+static inline uint8_t clamp_u8(int32_t value)
+{
+    return value < 0 ? 0 : value > 255 ? 255 : value;
+}
+
+static inline Rgb_t rgb565_to_rgb(uint16_t c)
+{
+    Rgb_t rgb;
+    rgb.r = ((c >> 11) << 3) | (c >> 13);
+    rgb.g = (((c >> 5) & 0x3F) << 2) | ((c >> 9) & 0x03);
+    rgb.b = ((c & 0x1F) << 3) | ((c >> 2) & 0x07);
+    return rgb;
+}
+
+static inline uint16_t rgb_to_rgb565(uint8_t r, uint8_t g, uint8_t b)
+{
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+static inline Rgb_t yuv_to_rgb(int32_t y, int32_t u, int32_t v)
+{
+    u -= 128;
+    v -= 128;
+    Rgb_t rgb;
+    rgb.r = clamp_u8(y + ((359 * v) >> 8));
+    rgb.g = clamp_u8(y - ((88 * u + 183 * v) >> 8));
+    rgb.b = clamp_u8(y + ((454 * u) >> 8));
+    return rgb;
+}
+
+/* ---------------------------------- Codecs --------------------------------- */
+// Reads and writes pixel x of a row, for every format but YUV420
+template <Format_t F>
+struct Codec;
+
+template <>
+struct Codec<FORMAT_RGB565> {
+    static inline Rgb_t load(const uint8_t* row, uint32_t x)
+    {
+        return rgb565_to_rgb(((const uint16_t*)row)[x]);
+    }
+    static inline void store(uint8_t* row, uint32_t x, const Rgb_t& c)
+    {
+        ((uint16_t*)row)[x] = rgb_to_rgb565(c.r, c.g, c.b);
+    }
+};
+
+template <>
+struct Codec<FORMAT_RGB888> {
+    static inline Rgb_t load(const uint8_t* row, uint32_t x)
+    {
+        const uint8_t* p = row + x * 3;
+        Rgb_t rgb;
+        rgb.b = p[0];
+        rgb.g = p[1];
+        rgb.r = p[2];
+        return rgb;
+    }
+    static inline void store(uint8_t* row, uint32_t x, const Rgb_t& c)
+    {
+        uint8_t* p = row + x * 3;
+        p[0]       = c.b;
+        p[1]       = c.g;
+        p[2]       = c.r;
+    }
+};
+
+template <>
+struct Codec<FORMAT_ARGB8888> {
+    static inline Rgb_t load(const uint8_t* row, uint32_t x)
+    {
+        const uint8_t* p = row + x * 4;
+        Rgb_t rgb;
+        rgb.b = p[0];
+        rgb.g = p[1];
+        rgb.r = p[2];
+        rgb.a = p[3];
+        return rgb;
+    }
+    static inline void store(uint8_t* row, uint32_t x, const Rgb_t& c)
+    {
+        ((uint32_t*)row)[x] = ((uint32_t)c.a << 24) | ((uint32_t)c.r << 16) | ((uint32_t)c.g << 8) | c.b;
+    }
+};
+
+template <>
+struct Codec<FORMAT_GREY> {
+    static inline Rgb_t load(const uint8_t* row, uint32_t x)
+    {
+        Rgb_t rgb;
+        rgb.r = rgb.g = rgb.b = row[x];
+        return rgb;
+    }
+    static inline void store(uint8_t* row, uint32_t x, const Rgb_t& c)
+    {
+        row[x] = luma(c.r, c.g, c.b);
+    }
+};
+
+/* --------------------------------- Kernels --------------------------------- */
+/**
+ * @brief Converts width x height pixels, rows stride bytes apart on each side
+ *
+ */
+template <Format_t From, Format_t To>
+struct Kernel {
+    static void run(const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride, uint32_t width,
+                    uint32_t height)
+    {
+        for (uint32_t y = 0; y < height; y++) {
+            const uint8_t* src_row = src + y * srcStride;
+            uint8_t* dst_row       = dst + y * dstStride;
+            for (uint32_t x = 0; x < width; x++) {
+                Codec<To>::store(dst_row, x, Codec<From>::load(src_row, x));
+            }
+        }
+    }
+};
+
+template <Format_t F>
+struct Kernel<F, F> {
+    static void run(const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride, uint32_t width,
+                    uint32_t height)
+    {
+        uint32_t bytes = row_bytes(F, width);
+        if (srcStride == bytes && dstStride == bytes) {
+            memcpy(dst, src, bytes * height);
+            return;
+        }
+        for (uint32_t y = 0; y < height; y++) {
+            memcpy(dst + y * dstStride, src + y * srcStride, bytes);
+        }
+    }
+};
+
+// A line pair at a time, each 2x2 block shares the U of the first line and the V of the second
+template <Format_t To>
+struct Kernel<FORMAT_YUV420, To> {
+    static void run(const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride, uint32_t width,
+                    uint32_t height)
+    {
+        for (uint32_t y = 0; y + 1 < height; y += 2) {
+            const uint8_t* src_u = src + y * srcStride;
+            const uint8_t* src_v = src_u + srcStride;
+            uint8_t* dst_0       = dst + y * dstStride;
+            uint8_t* dst_1       = dst_0 + dstStride;
+            for (uint32_t x = 0; x + 1 < width; x += 2) {
+                const uint8_t* u = src_u + x / 2 * 3;
+                const uint8_t* v = src_v + x / 2 * 3;
+                Codec<To>::store(dst_0, x, yuv_to_rgb(u[1], u[0], v[0]));
+                Codec<To>::store(dst_0, x + 1, yuv_to_rgb(u[2], u[0], v[0]));
+                Codec<To>::store(dst_1, x, yuv_to_rgb(v[1], u[0], v[0]));
+                Codec<To>::store(dst_1, x + 1, yuv_to_rgb(v[2], u[0], v[0]));
+            }
+        }
+    }
+};
+
+// Chroma is the mean of the 2x2 block
+template <Format_t From>
+struct Kernel<From, FORMAT_YUV420> {
+    static void run(const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride, uint32_t width,
+                    uint32_t height)
+    {
+        for (uint32_t y = 0; y + 1 < height; y += 2) {
+            const uint8_t* src_0 = src + y * srcStride;
+            const uint8_t* src_1 = src_0 + srcStride;
+            uint8_t* dst_u       = dst + y * dstStride;
+            uint8_t* dst_v       = dst_u + dstStride;
+            for (uint32_t x = 0; x + 1 < width; x += 2) {
+                Rgb_t quad[4] = {Codec<From>::load(src_0, x), Codec<From>::load(src_0, x + 1),
+                                 Codec<From>::load(src_1, x), Codec<From>::load(src_1, x + 1)};
+                int32_t r     = quad[0].r + quad[1].r + quad[2].r + quad[3].r;
+                int32_t g     = quad[0].g + quad[1].g + quad[2].g + quad[3].g;
+                int32_t b     = quad[0].b + quad[1].b + quad[2].b + quad[3].b;
+                uint8_t* u    = dst_u + x / 2 * 3;
+                uint8_t* v    = dst_v + x / 2 * 3;
+                u[0]          = clamp_u8(((-43 * r - 85 * g + 128 * b) >> 10) + 128);
+                v[0]          = clamp_u8(((128 * r - 107 * g - 21 * b) >> 10) + 128);
+                u[1]          = luma(quad[0].r, quad[0].g, quad[0].b);
+                u[2]          = luma(quad[1].r, quad[1].g, quad[1].b);
+                v[1]          = luma(quad[2].r, quad[2].g, quad[2].b);
+                v[2]          = luma(quad[3].r, quad[3].g, quad[3].b);
+            }
+        }
+    }
+};
+
+template <>
+struct Kernel<FORMAT_YUV420, FORMAT_YUV420> {
+    static void run(const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride, uint32_t width,
+                    uint32_t height)
+    {
+        uint32_t bytes = row_bytes(FORMAT_YUV420, width);
+        for (uint32_t y = 0; y < height; y++) {
+            memcpy(dst + y * dstStride, src + y * srcStride, bytes);
+        }
+    }
+};
+
+// The luma is already there, two bytes out of every three
+template <>
+struct Kernel<FORMAT_YUV420, FORMAT_GREY> {
+    static void run(const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride, uint32_t width,
+                    uint32_t height)
+    {
+        for (uint32_t y = 0; y < height; y++) {
+            const uint8_t* s = src + y * srcStride;
+            uint8_t* d       = dst + y * dstStride;
+            for (uint32_t x = 0; x + 1 < width; x += 2, s += 3) {
+                d[x]     = s[1];
+                d[x + 1] = s[2];
+            }
+        }
+    }
+};
+
+// Two pixels per word, the motion detector and the grey previews run it on every frame
+template <>
+struct Kernel<FORMAT_RGB565, FORMAT_GREY> {
+    static inline uint8_t luma565(uint32_t c)
+    {
+        // luma() with the 5 and 6 bit channels widened inside the weights
+        return ((c >> 11) * 634 + ((c >> 5) & 0x3F) * 607 + (c & 0x1F) * 240) >> 8;
+    }
+    static void run(const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride, uint32_t width,
+                    uint32_t height)
+    {
+        for (uint32_t y = 0; y < height; y++) {
+            const uint8_t* s = src + y * srcStride;
+            uint8_t* d       = dst + y * dstStride;
+            uint32_t x       = 0;
+            if (((uintptr_t)s & 0x03) == 0) {
+                const uint32_t* words = (const uint32_t*)s;
+                for (; x + 1 < width; x += 2) {
+                    uint32_t pair = *words++;
+                    d[x]          = luma565(pair & 0xFFFF);
+                    d[x + 1]      = luma565(pair >> 16);
+                }
+            }
+            for (; x < width; x++) {
+                d[x] = luma565(((const uint16_t*)s)[x]);
+            }
+        }
+    }
+};
+
+// Two pixels per word in and a word and a half out
+template <>
+struct Kernel<FORMAT_RGB565, FORMAT_RGB888> {
+    static void run(const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride, uint32_t width,
+                    uint32_t height)
+    {
+        for (uint32_t y = 0; y < height; y++) {
+            const uint16_t* s = (const uint16_t*)(src + y * srcStride);
+            uint8_t* d        = dst + y * dstStride;
+            for (uint32_t x = 0; x < width; x++, d += 3) {
+                Rgb_t c = rgb565_to_rgb(s[x]);
+                d[0]    = c.b;
+                d[1]    = c.g;
+                d[2]    = c.r;
+            }
+        }
+    }
+};
+
+template <>
+struct Kernel<FORMAT_GREY, FORMAT_RGB565> {
+    static void run(const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride, uint32_t width,
+                    uint32_t height)
+    {
+        for (uint32_t y = 0; y < height; y++) {
+            const uint8_t* s = src + y * srcStride;
+            uint16_t* d      = (uint16_t*)(dst + y * dstStride);
+            for (uint32_t x = 0; x < width; x++) {
+                d[x] = rgb_to_rgb565(s[x], s[x], s[x]);
+            }
+        }
+    }
+};
+
+using KernelFn = void (*)(const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride, uint32_t width,
+                          uint32_t height);
+
+// The kernel of a pair picked at runtime, from a table built at compile time
+KernelFn get_kernel(Format_t from, Format_t to);
+
+/**
+ * @brief Nearest neighbour RGB565 scale of srcWidth x srcHeight pixels into dstWidth x dstHeight, rows stride bytes
+ * apart on each side. For the scales the PPA cannot do, the caller syncs the cache of dst if a DMA reads it
+ *
+ */
+void scale_rgb565(const uint8_t* src, uint32_t srcStride, uint32_t srcWidth, uint32_t srcHeight, uint8_t* dst,
+                  uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight);
+
+}  // namespace pixel_convert
+
+/**
+ * @brief Converts between the formats of pixel_convert. Large blocks with whole pixel strides and a cache aligned
+ * destination go to the PPA, everything else, grey and small or odd blocks, runs the CPU kernel on the calling task
+ *
+ */
+class PixelConverter {
+public:
+    struct Config_t {
+        // Fewer pixels than this run on the CPU, the PPA setup costs more than it saves
+        uint32_t minPpaPixels = 128 * 128;
+        bool usePpa           = true;
+    };
+
+    struct Image_t {
+        const void* data               = nullptr;
+        pixel_convert::Format_t format = pixel_convert::FORMAT_RGB565;
+        uint16_t width                 = 0;
+        uint16_t height                = 0;
+        // Bytes from one row to the next, 0 for packed rows
+        uint32_t stride = 0;
+    };
+
+    struct Stats_t {
+        uint32_t ppaCalls  = 0;
+        uint32_t cpuCalls  = 0;
+        uint64_t ppaPixels = 0;
+        uint64_t cpuPixels = 0;
+    };
+
+    ~PixelConverter();
+
+    void init(const Config_t& config);
+
+    /**
+     * @brief Convert src into dst, same size, blocking
+     *
+     * @param dst
+     * @param dstFormat
+     * @param dstStride 0 for packed rows
+     * @return false on an unsupported size, e.g. an odd YUV420 one
+     */
+    bool convert(const Image_t& src, void* dst, pixel_convert::Format_t dstFormat, uint32_t dstStride = 0);
+
+    Stats_t getStats();
+
+private:
+    Config_t _config;
+    std::mutex _mutex;
+    ppa_client_handle_t _ppa = nullptr;
+    bool _is_ppa_failed      = false;
+    size_t _cache_align      = 0;
+    Stats_t _stats;
+
+    bool convert_ppa(const Image_t& src, void* dst, pixel_convert::Format_t dstFormat, uint32_t dstStride);
+};
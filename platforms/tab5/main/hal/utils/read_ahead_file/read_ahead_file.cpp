@@ -0,0 +1,177 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "read_ahead_file.h"
+#include <atomic>
+#include <esp_log.h>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <freertos/stream_buffer.h>
+
+static const char* TAG = "read-ahead";
+
+// Blocking calls wake up this often to check for close and end of file
+static constexpr TickType_t _wait_ticks = pdMS_TO_TICKS(50);
+
+struct ReadAhead_t {
+    FILE* file       = nullptr;
+    uint8_t* storage = nullptr;
+    uint8_t* chunk   = nullptr;
+    size_t chunkSize = 0;
+    StaticStreamBuffer_t streamStruct;
+    StreamBufferHandle_t stream = nullptr;
+    SemaphoreHandle_t exitSem   = nullptr;
+    std::atomic<bool> stop{false};
+    std::atomic<bool> eof{false};
+    // Bytes handed to the reader
+    off_t pos = 0;
+};
+
+static void free_read_ahead(ReadAhead_t* ctx)
+{
+    if (ctx->stream) {
+        vStreamBufferDelete(ctx->stream);
+    }
+    if (ctx->exitSem) {
+        vSemaphoreDelete(ctx->exitSem);
+    }
+    if (ctx->file) {
+        fclose(ctx->file);
+    }
+    heap_caps_free(ctx->storage);
+    heap_caps_free(ctx->chunk);
+    delete ctx;
+}
+
+static void _read_ahead_task(void* param)
+{
+    auto ctx = (ReadAhead_t*)param;
+
+    while (!ctx->stop) {
+        size_t bytes = fread(ctx->chunk, 1, ctx->chunkSize, ctx->file);
+        if (bytes == 0) {
+            break;
+        }
+
+        size_t sent = 0;
+        while (sent < bytes && !ctx->stop) {
+            sent += xStreamBufferSend(ctx->stream, ctx->chunk + sent, bytes - sent, _wait_ticks);
+        }
+    }
+
+    ctx->eof = true;
+    xSemaphoreGive(ctx->exitSem);
+    vTaskDelete(NULL);
+}
+
+static ssize_t read_ahead_read(void* cookie, char* buf, size_t size)
+{
+    auto ctx = (ReadAhead_t*)cookie;
+
+    // Return whatever arrived first, the decoder asks again for the rest
+    while (true) {
+        size_t bytes = xStreamBufferReceive(ctx->stream, buf, size, _wait_ticks);
+        if (bytes > 0) {
+            ctx->pos += bytes;
+            return bytes;
+        }
+        if (ctx->eof && xStreamBufferIsEmpty(ctx->stream)) {
+            return 0;
+        }
+    }
+}
+
+static bool start_read_ahead_task(ReadAhead_t* ctx)
+{
+    ctx->stop = false;
+    ctx->eof  = false;
+    if (xTaskCreate(_read_ahead_task, "read_ahead", 4096, ctx, 6, nullptr) != pdPASS) {
+        ESP_LOGE(TAG, "create task failed");
+        // Nothing will fill the ring, let the reader see an empty file
+        ctx->eof = true;
+        xSemaphoreGive(ctx->exitSem);
+        return false;
+    }
+    return true;
+}
+
+static void stop_read_ahead_task(ReadAhead_t* ctx)
+{
+    ctx->stop = true;
+    xSemaphoreTake(ctx->exitSem, portMAX_DELAY);
+}
+
+// Decoders only seek while probing the header, so a seek simply restarts the read ahead at the new position
+static int read_ahead_seek(void* cookie, off_t* offset, int whence)
+{
+    auto ctx = (ReadAhead_t*)cookie;
+
+    // ftell
+    if (whence == SEEK_CUR && *offset == 0) {
+        *offset = ctx->pos;
+        return 0;
+    }
+
+    stop_read_ahead_task(ctx);
+
+    off_t base = whence == SEEK_CUR ? ctx->pos : 0;
+    if (whence == SEEK_END && fseek(ctx->file, 0, SEEK_END) == 0) {
+        base = ftell(ctx->file);
+    }
+    int ret = fseek(ctx->file, base + *offset, SEEK_SET);
+    if (ret == 0) {
+        ctx->pos = base + *offset;
+    } else {
+        fseek(ctx->file, ctx->pos, SEEK_SET);
+    }
+
+    xStreamBufferReset(ctx->stream);
+    start_read_ahead_task(ctx);
+
+    *offset = ctx->pos;
+    return ret;
+}
+
+static int read_ahead_close(void* cookie)
+{
+    auto ctx = (ReadAhead_t*)cookie;
+    stop_read_ahead_task(ctx);
+    free_read_ahead(ctx);
+    return 0;
+}
+
+FILE* read_ahead_fopen(const char* path, size_t ringSize, size_t chunkSize)
+{
+    auto ctx       = new ReadAhead_t;
+    ctx->chunkSize = chunkSize;
+    ctx->file      = fopen(path, "rb");
+    ctx->storage   = (uint8_t*)heap_caps_malloc(ringSize + 1, MALLOC_CAP_SPIRAM);
+    ctx->chunk     = (uint8_t*)heap_caps_malloc(chunkSize, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    ctx->exitSem   = xSemaphoreCreateBinary();
+    if (ctx->file == nullptr || ctx->storage == nullptr || ctx->chunk == nullptr || ctx->exitSem == nullptr) {
+        ESP_LOGE(TAG, "open %s failed", path);
+        free_read_ahead(ctx);
+        return nullptr;
+    }
+    ctx->stream = xStreamBufferCreateStatic(ringSize, 1, ctx->storage, &ctx->streamStruct);
+
+    cookie_io_functions_t functions = {
+        .read  = read_ahead_read,
+        .write = nullptr,
+        .seek  = read_ahead_seek,
+        .close = read_ahead_close,
+    };
+    FILE* fp = fopencookie(ctx, "rb", functions);
+    if (fp == nullptr) {
+        ESP_LOGE(TAG, "fopencookie failed");
+        free_read_ahead(ctx);
+        return nullptr;
+    }
+
+    start_read_ahead_task(ctx);
+    return fp;
+}
@@ -0,0 +1,21 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdio.h>
+#include <stddef.h>
+
+/**
+ * @brief Open a file for sequential reading behind a read ahead task
+ *
+ * The task keeps a PSRAM ring filled with large reads, so SD card latency spikes are absorbed before they reach the
+ * reader. The returned FILE only supports reading, seeking restarts the read ahead, fclose() also ends the task.
+ *
+ * @param path
+ * @param ringSize bytes buffered ahead
+ * @param chunkSize bytes per file read, in internal DMA capable memory
+ * @return nullptr on failure
+ */
+FILE* read_ahead_fopen(const char* path, size_t ringSize = 256 * 1024, size_t chunkSize = 16 * 1024);
@@ -0,0 +1,277 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "settings_store.h"
+#include <string.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+
+static const char* TAG = "settings";
+
+size_t SettingsStore::load(const char* nvsNamespace)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _namespace = nvsNamespace;
+
+    nvs_handle_t handle;
+    if (nvs_open(_namespace, NVS_READONLY, &handle) != ESP_OK) {
+        return 0;
+    }
+
+    // One walk over the namespace entries instead of a lookup per key
+    size_t loaded     = 0;
+    nvs_iterator_t it = nullptr;
+    esp_err_t ret     = nvs_entry_find_in_handle(handle, NVS_TYPE_ANY, &it);
+    while (ret == ESP_OK) {
+        nvs_entry_info_t info;
+        nvs_entry_info(it, &info);
+        ret = nvs_entry_next(&it);
+
+        int64_t value  = 0;
+        esp_err_t read = ESP_ERR_NVS_TYPE_MISMATCH;
+        switch (info.type) {
+            case NVS_TYPE_U8: {
+                uint8_t v;
+                read  = nvs_get_u8(handle, info.key, &v);
+                value = v;
+                break;
+            }
+            case NVS_TYPE_I8: {
+                int8_t v;
+                read  = nvs_get_i8(handle, info.key, &v);
+                value = v;
+                break;
+            }
+            case NVS_TYPE_U16: {
+                uint16_t v;
+                read  = nvs_get_u16(handle, info.key, &v);
+                value = v;
+                break;
+            }
+            case NVS_TYPE_I16: {
+                int16_t v;
+                read  = nvs_get_i16(handle, info.key, &v);
+                value = v;
+                break;
+            }
+            case NVS_TYPE_U32: {
+                uint32_t v;
+                read  = nvs_get_u32(handle, info.key, &v);
+                value = v;
+                break;
+            }
+            case NVS_TYPE_I32: {
+                int32_t v;
+                read  = nvs_get_i32(handle, info.key, &v);
+                value = v;
+                break;
+            }
+            default:
+                break;
+        }
+        if (read != ESP_OK) {
+            continue;
+        }
+
+        Entry_t* entry = find(info.key);
+        if (entry != nullptr) {
+            continue;
+        }
+        if (_count >= MaxKeys) {
+            ESP_LOGW(TAG, "more than %d keys in %s, %s ignored", (int)MaxKeys, _namespace, info.key);
+            continue;
+        }
+        entry = &_entries[_count++];
+        strncpy(entry->key, info.key, MaxKey);
+        entry->type  = info.type;
+        entry->value = value;
+        loaded++;
+    }
+    nvs_release_iterator(it);
+    nvs_close(handle);
+    return loaded;
+}
+
+bool SettingsStore::start(uint32_t quietMs)
+{
+    _quietMs = quietMs;
+    if (xTaskCreate(commit_task, "settings", 3072, this, 1, &_task) != pdPASS) {
+        ESP_LOGE(TAG, "create task failed");
+        return false;
+    }
+    return true;
+}
+
+SettingsStore::Entry_t* SettingsStore::find(const char* key)
+{
+    for (size_t i = 0; i < _count; i++) {
+        if (strncmp(_entries[i].key, key, MaxKey) == 0) {
+            return &_entries[i];
+        }
+    }
+    return nullptr;
+}
+
+bool SettingsStore::get_value(const char* key, int64_t& value)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    Entry_t* entry = find(key);
+    if (entry == nullptr) {
+        return false;
+    }
+    value = entry->value;
+    return true;
+}
+
+bool SettingsStore::set_value(const char* key, nvs_type_t type, int64_t value)
+{
+    bool was_dirty;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Entry_t* entry = find(key);
+        if (entry == nullptr) {
+            if (_count >= MaxKeys) {
+                ESP_LOGE(TAG, "no room for %s", key);
+                return false;
+            }
+            entry = &_entries[_count++];
+            strncpy(entry->key, key, MaxKey);
+            entry->type = type;
+        } else if (entry->value == value) {
+            return false;
+        }
+        entry->value   = value;
+        entry->isDirty = true;
+        was_dirty      = _isDirty;
+        _isDirty       = true;
+        _lastSetUs     = esp_timer_get_time();
+        _stats.sets++;
+    }
+
+    // Later sets only move the deadline, the task reads it when it wakes
+    if (!was_dirty && _task != nullptr) {
+        xTaskNotifyGive(_task);
+    }
+    return true;
+}
+
+esp_err_t SettingsStore::write_entries(nvs_handle_t handle, const Entry_t* entries, size_t count)
+{
+    esp_err_t ret = ESP_OK;
+    for (size_t i = 0; i < count && ret == ESP_OK; i++) {
+        const auto& entry = entries[i];
+        switch (entry.type) {
+            case NVS_TYPE_U8:
+                ret = nvs_set_u8(handle, entry.key, entry.value);
+                break;
+            case NVS_TYPE_I8:
+                ret = nvs_set_i8(handle, entry.key, entry.value);
+                break;
+            case NVS_TYPE_U16:
+                ret = nvs_set_u16(handle, entry.key, entry.value);
+                break;
+            case NVS_TYPE_I16:
+                ret = nvs_set_i16(handle, entry.key, entry.value);
+                break;
+            case NVS_TYPE_U32:
+                ret = nvs_set_u32(handle, entry.key, entry.value);
+                break;
+            default:
+                ret = nvs_set_i32(handle, entry.key, entry.value);
+                break;
+        }
+    }
+    return ret;
+}
+
+bool SettingsStore::commit()
+{
+    std::lock_guard<std::mutex> commit_lock(_commitMutex);
+
+    // Written from a copy, so sets go on while the flash is busy
+    Entry_t dirty[MaxKeys];
+    size_t count = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_isDirty || _namespace == nullptr) {
+            return true;
+        }
+        for (size_t i = 0; i < _count; i++) {
+            if (_entries[i].isDirty) {
+                dirty[count++]      = _entries[i];
+                _entries[i].isDirty = false;
+            }
+        }
+        _isDirty = false;
+    }
+
+    // One commit for all of them
+    nvs_handle_t handle;
+    esp_err_t ret = nvs_open(_namespace, NVS_READWRITE, &handle);
+    if (ret == ESP_OK) {
+        ret = write_entries(handle, dirty, count);
+        if (ret == ESP_OK) {
+            ret = nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "commit %s failed: %s", _namespace, esp_err_to_name(ret));
+        // Dirty again, the task tries once more after the quiet period
+        for (size_t i = 0; i < count; i++) {
+            Entry_t* entry = find(dirty[i].key);
+            if (entry != nullptr) {
+                entry->isDirty = true;
+            }
+        }
+        _isDirty   = true;
+        _lastSetUs = esp_timer_get_time();
+        _stats.errors++;
+        return false;
+    }
+    _stats.commits++;
+    return true;
+}
+
+bool SettingsStore::flush()
+{
+    return commit();
+}
+
+SettingsStore::Stats_t SettingsStore::getStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+void SettingsStore::commit_task(void* param)
+{
+    static_cast<SettingsStore*>(param)->commit_loop();
+}
+
+void SettingsStore::commit_loop()
+{
+    while (1) {
+        int64_t remaining_us = 0;
+        bool is_dirty;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            is_dirty = _isDirty;
+            if (is_dirty) {
+                remaining_us = _lastSetUs + (int64_t)_quietMs * 1000 - esp_timer_get_time();
+            }
+        }
+
+        if (!is_dirty) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        } else if (remaining_us > 0) {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(remaining_us / 1000 + 1));
+        } else {
+            commit();
+        }
+    }
+}
@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <mutex>
+#include <type_traits>
+#include <nvs.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+/**
+ * @brief Settings of one NVS namespace, cached in RAM. A set only updates the cache and marks the key dirty, a low
+ * priority task commits the dirty keys once no set came for the quiet period, so a slider dragged across its range
+ * costs one write. load() reads the whole namespace in one pass with a single open
+ *
+ * Values are integers up to 32 bits or bool, each key stays the NVS type of its first set or load
+ */
+class SettingsStore {
+public:
+    static constexpr size_t MaxKeys = 16;
+    // NVS keys are 15 characters at most
+    static constexpr size_t MaxKey = 15;
+
+    struct Stats_t {
+        uint32_t sets    = 0;
+        uint32_t commits = 0;
+        uint32_t errors  = 0;
+    };
+
+    /**
+     * @brief Read every key of the namespace into the cache, NVS must be initialized. Keys set before keep their
+     * values
+     *
+     * @return number of keys read, 0 for a namespace that was never written
+     */
+    size_t load(const char* nvsNamespace);
+
+    /**
+     * @brief Start the commit task, sets before this stay in the cache until it runs
+     *
+     * @param quietMs commit once no set came for this long
+     */
+    bool start(uint32_t quietMs = 2000);
+
+    template <typename T>
+    T get(const char* key, T defaultValue)
+    {
+        static_assert(std::is_integral_v<T> && sizeof(T) <= 4, "settings are integers up to 32 bits");
+        int64_t value;
+        return get_value(key, value) ? (T)value : defaultValue;
+    }
+
+    // Returns true if the value changed, an unchanged value schedules nothing
+    template <typename T>
+    bool set(const char* key, T value)
+    {
+        static_assert(std::is_integral_v<T> && sizeof(T) <= 4, "settings are integers up to 32 bits");
+        return set_value(key, nvs_type_of<T>(), value);
+    }
+
+    /**
+     * @brief Commit dirty keys now from the calling task, for a power off or a reboot
+     *
+     * @return false if NVS could not be written, the keys stay dirty
+     */
+    bool flush();
+
+    Stats_t getStats();
+
+private:
+    struct Entry_t {
+        char key[MaxKey + 1] = {0};
+        nvs_type_t type      = NVS_TYPE_ANY;
+        int64_t value        = 0;
+        bool isDirty         = false;
+    };
+
+    std::mutex _mutex;
+    // Held through a commit, so a flush and the task never write at once
+    std::mutex _commitMutex;
+    const char* _namespace = nullptr;
+    Entry_t _entries[MaxKeys];
+    size_t _count      = 0;
+    bool _isDirty      = false;
+    int64_t _lastSetUs = 0;
+    uint32_t _quietMs  = 2000;
+    TaskHandle_t _task = nullptr;
+    Stats_t _stats;
+
+    template <typename T>
+    static constexpr nvs_type_t nvs_type_of()
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            return NVS_TYPE_U8;
+        } else if constexpr (std::is_signed_v<T>) {
+            return sizeof(T) == 1 ? NVS_TYPE_I8 : sizeof(T) == 2 ? NVS_TYPE_I16 : NVS_TYPE_I32;
+        } else {
+            return sizeof(T) == 1 ? NVS_TYPE_U8 : sizeof(T) == 2 ? NVS_TYPE_U16 : NVS_TYPE_U32;
+        }
+    }
+
+    // Lock _mutex before calling
+    Entry_t* find(const char* key);
+
+    bool get_value(const char* key, int64_t& value);
+    bool set_value(const char* key, nvs_type_t type, int64_t value);
+    bool commit();
+    static esp_err_t write_entries(nvs_handle_t handle, const Entry_t* entries, size_t count);
+
+    static void commit_task(void* param);
+    void commit_loop();
+};
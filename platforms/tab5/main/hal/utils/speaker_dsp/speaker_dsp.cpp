@@ -0,0 +1,275 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "speaker_dsp.h"
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+// Samples are widened to Q23, 8 bits below the 16bit LSB keep the biquad rounding out of the output
+static constexpr int _sample_shift   = 8;
+static constexpr int32_t _full_scale = 1 << 23;
+static constexpr int _coeff_shift    = 28;
+// Above this codec volume the ceiling drops, at 100% it is this far under the threshold
+static constexpr uint8_t _volume_knee  = 70;
+static constexpr float _volume_drop_db = 5.0f;
+
+SpeakerDsp::Config_t SpeakerDsp::speakerConfig()
+{
+    Config_t config;
+    config.bands[0] = {BAND_HIGH_PASS, 150.0f, 0.0f, 0.707f};
+    config.bands[1] = {BAND_LOW_SHELF, 300.0f, 2.0f, 0.707f};
+    config.bands[2] = {BAND_PEAKING, 3200.0f, -4.0f, 1.2f};
+    config.bands[3] = {BAND_HIGH_SHELF, 10000.0f, -2.0f, 0.707f};
+    config.bandNum  = 4;
+    return config;
+}
+
+static int32_t to_q28(double value)
+{
+    return (int32_t)lround(value * (1 << _coeff_shift));
+}
+
+bool SpeakerDsp::init(const Config_t& config)
+{
+    if (config.sampleRate == 0 || config.bandNum > MaxBands || config.lookAheadFrames == 0 ||
+        config.lookAheadFrames > MaxLookAhead || config.clipKnee <= 0.0f || config.clipKnee >= 1.0f) {
+        return false;
+    }
+    _config = config;
+
+    // RBJ cookbook biquads
+    for (uint8_t i = 0; i < config.bandNum; i++) {
+        const Band_t& band = config.bands[i];
+        double w0          = 2.0 * M_PI * std::min<double>(band.freq, config.sampleRate * 0.45) / config.sampleRate;
+        double cos_w0      = cos(w0);
+        double alpha       = sin(w0) / (2.0 * std::max(band.q, 0.1f));
+        double a           = pow(10.0, band.gainDb / 40.0);
+        double sqrt_a      = sqrt(a);
+        double b0, b1, b2, a0, a1, a2;
+        switch (band.type) {
+            case BAND_HIGH_PASS:
+                b0 = (1.0 + cos_w0) / 2.0;
+                b1 = -(1.0 + cos_w0);
+                b2 = b0;
+                a0 = 1.0 + alpha;
+                a1 = -2.0 * cos_w0;
+                a2 = 1.0 - alpha;
+                break;
+            case BAND_LOW_SHELF:
+                b0 = a * ((a + 1.0) - (a - 1.0) * cos_w0 + 2.0 * sqrt_a * alpha);
+                b1 = 2.0 * a * ((a - 1.0) - (a + 1.0) * cos_w0);
+                b2 = a * ((a + 1.0) - (a - 1.0) * cos_w0 - 2.0 * sqrt_a * alpha);
+                a0 = (a + 1.0) + (a - 1.0) * cos_w0 + 2.0 * sqrt_a * alpha;
+                a1 = -2.0 * ((a - 1.0) + (a + 1.0) * cos_w0);
+                a2 = (a + 1.0) + (a - 1.0) * cos_w0 - 2.0 * sqrt_a * alpha;
+                break;
+            case BAND_HIGH_SHELF:
+                b0 = a * ((a + 1.0) + (a - 1.0) * cos_w0 + 2.0 * sqrt_a * alpha);
+                b1 = -2.0 * a * ((a - 1.0) + (a + 1.0) * cos_w0);
+                b2 = a * ((a + 1.0) + (a - 1.0) * cos_w0 - 2.0 * sqrt_a * alpha);
+                a0 = (a + 1.0) - (a - 1.0) * cos_w0 + 2.0 * sqrt_a * alpha;
+                a1 = 2.0 * ((a - 1.0) - (a + 1.0) * cos_w0);
+                a2 = (a + 1.0) - (a - 1.0) * cos_w0 - 2.0 * sqrt_a * alpha;
+                break;
+            case BAND_PEAKING:
+            default:
+                b0 = 1.0 + alpha * a;
+                b1 = -2.0 * cos_w0;
+                b2 = 1.0 - alpha * a;
+                a0 = 1.0 + alpha / a;
+                a1 = -2.0 * cos_w0;
+                a2 = 1.0 - alpha / a;
+                break;
+        }
+        Biquad_t& biquad = _biquads[i];
+        biquad.b0        = to_q28(b0 / a0);
+        biquad.b1        = to_q28(b1 / a0);
+        biquad.b2        = to_q28(b2 / a0);
+        biquad.a1        = to_q28(-a1 / a0);
+        biquad.a2        = to_q28(-a2 / a0);
+    }
+    _active_bands = config.bandNum;
+
+    // One pole release, share of the gap to the held gain closed per frame
+    double release_frames = std::max(1.0, config.releaseMs * config.sampleRate / 1000.0);
+    _release_coeff        = std::max<int32_t>(1, lround((1.0 - exp(-1.0 / release_frames)) * UnityGainQ15));
+    _knee                 = lround(config.clipKnee * _full_scale);
+    update_threshold();
+
+    _is_initialized = true;
+    reset();
+    return true;
+}
+
+void SpeakerDsp::reset()
+{
+    for (auto& biquad : _biquads) {
+        memset(biquad.state, 0, sizeof(biquad.state));
+    }
+    memset(_delay, 0, sizeof(_delay));
+    _delay_pos   = 0;
+    _gain        = UnityGainQ15;
+    _hold_gain   = UnityGainQ15;
+    _hold_frames = 0;
+    _attack_step = 0;
+}
+
+void SpeakerDsp::setBypass(bool bypass)
+{
+    if (bypass != _is_bypassed) {
+        _is_bypassed = bypass;
+        reset();
+    }
+}
+
+void SpeakerDsp::setOutputVolume(uint8_t volume)
+{
+    if (volume != _volume) {
+        _volume = volume;
+        update_threshold();
+    }
+}
+
+void SpeakerDsp::update_threshold()
+{
+    float threshold_db = _config.thresholdDb;
+    if (_volume > _volume_knee) {
+        threshold_db -= _volume_drop_db * (std::min<uint8_t>(_volume, 100) - _volume_knee) / (100 - _volume_knee);
+    }
+    _threshold = lround(powf(10.0f, threshold_db / 20.0f) * _full_scale);
+}
+
+bool SpeakerDsp::dropBand()
+{
+    if (_active_bands == 0) {
+        return false;
+    }
+    _active_bands--;
+    return true;
+}
+
+// Direct form I, the two channels step together so each coefficient is loaded once per frame
+void SpeakerDsp::run_biquad(Biquad_t& biquad, int32_t* samples, size_t frames)
+{
+    const int32_t b0 = biquad.b0, b1 = biquad.b1, b2 = biquad.b2, a1 = biquad.a1, a2 = biquad.a2;
+    int32_t lx1 = biquad.state[0][0], lx2 = biquad.state[0][1], ly1 = biquad.state[0][2], ly2 = biquad.state[0][3];
+    int32_t rx1 = biquad.state[1][0], rx2 = biquad.state[1][1], ry1 = biquad.state[1][2], ry2 = biquad.state[1][3];
+    const int64_t round = 1ll << (_coeff_shift - 1);
+
+    for (size_t i = 0; i < frames; i++) {
+        int32_t lx = samples[i * 2];
+        int32_t rx = samples[i * 2 + 1];
+        int64_t l  = round + (int64_t)b0 * lx + (int64_t)b1 * lx1 + (int64_t)b2 * lx2 + (int64_t)a1 * ly1 +
+                    (int64_t)a2 * ly2;
+        int64_t r = round + (int64_t)b0 * rx + (int64_t)b1 * rx1 + (int64_t)b2 * rx2 + (int64_t)a1 * ry1 +
+                    (int64_t)a2 * ry2;
+        int32_t ly = (int32_t)(l >> _coeff_shift);
+        int32_t ry = (int32_t)(r >> _coeff_shift);
+
+        lx2 = lx1;
+        lx1 = lx;
+        ly2 = ly1;
+        ly1 = ly;
+        rx2 = rx1;
+        rx1 = rx;
+        ry2 = ry1;
+        ry1 = ry;
+
+        samples[i * 2]     = ly;
+        samples[i * 2 + 1] = ry;
+    }
+
+    biquad.state[0][0] = lx1;
+    biquad.state[0][1] = lx2;
+    biquad.state[0][2] = ly1;
+    biquad.state[0][3] = ly2;
+    biquad.state[1][0] = rx1;
+    biquad.state[1][1] = rx2;
+    biquad.state[1][2] = ry1;
+    biquad.state[1][3] = ry2;
+}
+
+// The gain for a peak is decided when it enters the delay line and is reached by the time it leaves it, both
+// channels share the gain so the stereo image stays put
+void SpeakerDsp::run_limiter(int32_t* samples, size_t frames)
+{
+    const uint16_t look_ahead = _config.lookAheadFrames;
+
+    for (size_t i = 0; i < frames; i++) {
+        int32_t l    = samples[i * 2];
+        int32_t r    = samples[i * 2 + 1];
+        int32_t peak = std::max(abs(l), abs(r));
+
+        int32_t needed = UnityGainQ15;
+        if (peak > _threshold) {
+            needed = (int32_t)(((int64_t)_threshold * UnityGainQ15) / peak);
+        }
+        if (needed <= _hold_gain) {
+            // Lower or equal target, ramp to it over the look ahead and hold it while the peak is in the line
+            _hold_gain   = needed;
+            _hold_frames = look_ahead;
+            _attack_step = std::max<int32_t>(1, (_gain - needed + look_ahead - 1) / look_ahead);
+        } else if (_hold_frames > 0) {
+            _hold_frames--;
+        } else {
+            _hold_gain = needed;
+        }
+
+        if (_gain > _hold_gain) {
+            _gain = std::max(_hold_gain, _gain - _attack_step);
+        } else if (_gain < _hold_gain) {
+            _gain += std::max<int32_t>(1, ((_hold_gain - _gain) * _release_coeff) >> 15);
+            _gain = std::min(_gain, _hold_gain);
+        }
+
+        int32_t* slot      = &_delay[_delay_pos * 2];
+        int32_t out_l      = slot[0];
+        int32_t out_r      = slot[1];
+        slot[0]            = l;
+        slot[1]            = r;
+        _delay_pos         = _delay_pos + 1 == look_ahead ? 0 : _delay_pos + 1;
+        samples[i * 2]     = (int32_t)(((int64_t)out_l * _gain) >> 15);
+        samples[i * 2 + 1] = (int32_t)(((int64_t)out_r * _gain) >> 15);
+    }
+}
+
+// Linear up to the knee, then bends towards full scale without reaching it
+int32_t SpeakerDsp::soft_clip(int32_t x) const
+{
+    int32_t a = abs(x);
+    if (a <= _knee) {
+        return x;
+    }
+    int64_t range = _full_scale - _knee;
+    int64_t over  = a - _knee;
+    int32_t y     = _knee + (int32_t)(range * over / (over + range));
+    return x < 0 ? -y : y;
+}
+
+void SpeakerDsp::process(int16_t* block, size_t frames)
+{
+    if (!_is_initialized || _is_bypassed) {
+        return;
+    }
+
+    while (frames > 0) {
+        size_t chunk = std::min(frames, MaxBlockFrames);
+        for (size_t i = 0; i < chunk * 2; i++) {
+            _work[i] = (int32_t)block[i] << _sample_shift;
+        }
+        for (uint8_t b = 0; b < _active_bands; b++) {
+            run_biquad(_biquads[b], _work, chunk);
+        }
+        run_limiter(_work, chunk);
+        const int32_t round = 1 << (_sample_shift - 1);
+        for (size_t i = 0; i < chunk * 2; i++) {
+            int32_t y = (soft_clip(_work[i]) + round) >> _sample_shift;
+            block[i]  = (int16_t)std::clamp<int32_t>(y, INT16_MIN, INT16_MAX);
+        }
+        block += chunk * 2;
+        frames -= chunk;
+    }
+}
@@ -0,0 +1,146 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Post mixer chain for the speaker, cascaded biquad EQ, look-ahead limiter and soft clipper
+ *
+ * Fixed point on interleaved 16bit stereo, in place. Samples run at Q23 inside the chain, the biquads take Q28
+ * coefficients. The stage count is fixed at init, so every block costs the same, dropBand() sheds the last EQ band
+ * when a block still runs over its budget.
+ *
+ */
+class SpeakerDsp {
+public:
+    static constexpr size_t MaxBands       = 4;
+    static constexpr size_t MaxLookAhead   = 96;
+    static constexpr size_t MaxBlockFrames = 256;
+    static constexpr uint32_t DefaultRate  = 48000;
+    static constexpr int32_t UnityGainQ15  = 32768;
+
+    enum BandType_t {
+        BAND_HIGH_PASS = 0,
+        BAND_LOW_SHELF,
+        BAND_PEAKING,
+        BAND_HIGH_SHELF,
+    };
+
+    struct Band_t {
+        BandType_t type = BAND_PEAKING;
+        float freq      = 1000.0f;
+        float gainDb    = 0.0f;
+        float q         = 0.707f;
+    };
+
+    struct Config_t {
+        uint32_t sampleRate = DefaultRate;
+        Band_t bands[MaxBands];
+        uint8_t bandNum = 0;
+        // Limiter ceiling at full volume, the codec gain goes on top of it
+        float thresholdDb = -1.0f;
+        // Frames the limiter sees ahead, also the latency of the chain
+        uint16_t lookAheadFrames = 48;
+        float releaseMs          = 80.0f;
+        // Above this share of full scale the soft clipper bends the peaks the limiter let through
+        float clipKnee = 0.85f;
+    };
+
+    /**
+     * @brief Tuning for the Tab5 speaker, a small driver that distorts below 150Hz and is sharp around 3kHz
+     *
+     */
+    static Config_t speakerConfig();
+
+    /**
+     * @brief Compute the coefficients and clear the state
+     *
+     * @return false on an invalid config
+     */
+    bool init(const Config_t& config);
+
+    /**
+     * @brief Clear the filter and limiter state, e.g. when the output goes idle
+     *
+     */
+    void reset();
+
+    /**
+     * @brief Run the chain over interleaved stereo frames, in place, nothing is done while bypassed
+     *
+     */
+    void process(int16_t* block, size_t frames);
+
+    /**
+     * @brief Pass the samples through untouched, e.g. on headphones, the state is cleared on the switch
+     *
+     */
+    void setBypass(bool bypass);
+    bool isBypassed() const
+    {
+        return _is_bypassed;
+    }
+
+    /**
+     * @brief Lower the ceiling at high codec volume, above 70% it drops linearly to 5dB under the threshold
+     *
+     * @param volume 0~100
+     */
+    void setOutputVolume(uint8_t volume);
+
+    /**
+     * @brief Shed the last EQ band to get under the CPU budget
+     *
+     * @return false when there is no band left to shed
+     */
+    bool dropBand();
+    uint8_t activeBands() const
+    {
+        return _active_bands;
+    }
+
+    // Gain reduction of the last block, Q15, unity when the limiter is idle
+    int32_t gainQ15() const
+    {
+        return _gain;
+    }
+
+private:
+    struct Biquad_t {
+        // Q28, a1 and a2 negated so every tap is a multiply accumulate
+        int32_t b0 = 0, b1 = 0, b2 = 0, a1 = 0, a2 = 0;
+        // x1, x2, y1, y2 per channel, Q23
+        int32_t state[2][4] = {};
+    };
+
+    Config_t _config;
+    Biquad_t _biquads[MaxBands];
+    uint8_t _active_bands = 0;
+    bool _is_bypassed     = false;
+    bool _is_initialized  = false;
+
+    // Limiter, gains are Q15
+    int32_t _threshold     = 0;  // Q23
+    uint8_t _volume        = 0;
+    int32_t _gain          = UnityGainQ15;
+    int32_t _attack_step   = 0;  // Reaches the held gain when its peak leaves the delay line
+    int32_t _hold_gain     = UnityGainQ15;
+    uint16_t _hold_frames  = 0;
+    int32_t _release_coeff = 0;  // Share of the gap closed per frame
+    int32_t _delay[MaxLookAhead * 2];
+    uint16_t _delay_pos = 0;
+
+    // Soft clipper, Q23
+    int32_t _knee = 0;
+
+    int32_t _work[MaxBlockFrames * 2];
+
+    void update_threshold();
+    void run_biquad(Biquad_t& biquad, int32_t* samples, size_t frames);
+    void run_limiter(int32_t* samples, size_t frames);
+    int32_t soft_clip(int32_t x) const;
+};
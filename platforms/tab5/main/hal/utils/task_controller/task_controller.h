@@ -6,51 +6,141 @@
 #pragma once
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
-#include <thread>
-#include <mutex>
+#include <freertos/event_groups.h>
+#include <functional>
 
+/**
+ * @brief Start, pause, resume and stop with join for a task running a loop. Requests are event group bits, so a task
+ * waiting in sleep() or a pause wakes up on them right away and stop() blocks on the exit bit instead of polling
+ *
+ * The owner side calls are serialized by the owner, the task side calls are for the task's own loop
+ *
+ */
 class TaskController_t {
 public:
+    using TaskLoop_t = std::function<void(TaskController_t& task)>;
+
+    TaskController_t()
+    {
+        _event_group = xEventGroupCreateStatic(&_event_group_buffer);
+        // Never started counts as exited, a stop() before the first start() returns at once
+        xEventGroupSetBits(_event_group, BIT_EXITED);
+    }
+
     virtual ~TaskController_t()
     {
+        vEventGroupDelete(_event_group);
     }
 
-    std::mutex mutex;
+    /**
+     * @brief Create the task, it runs the loop once and is deleted when the loop returns
+     *
+     * @param core -1 for no affinity
+     * @return false if the previous task is still running or the task could not be created
+     */
+    bool start(const char* name, uint32_t stackSize, UBaseType_t priority, int core, TaskLoop_t loop)
+    {
+        if (isRunning()) {
+            return false;
+        }
+        xEventGroupClearBits(_event_group, BIT_STOP | BIT_PAUSE | BIT_WAKE | BIT_EXITED);
+        xEventGroupSetBits(_event_group, BIT_RUNNING);
+
+        _loop = std::move(loop);
+        if (xTaskCreatePinnedToCore(task_entry, name, stackSize, this, priority, NULL,
+                                    core < 0 ? tskNO_AFFINITY : core) != pdPASS) {
+            xEventGroupClearBits(_event_group, BIT_RUNNING);
+            xEventGroupSetBits(_event_group, BIT_EXITED);
+            _loop = nullptr;
+            return false;
+        }
+        return true;
+    }
 
-    void sendKillSignal()
+    // The task stops at its next checkPoint() until resume()
+    void pause()
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        _kill_signal = true;
+        xEventGroupSetBits(_event_group, BIT_PAUSE);
     }
 
-    bool checkKillSignal()
+    void resume()
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        return _kill_signal;
+        xEventGroupClearBits(_event_group, BIT_PAUSE);
+        xEventGroupSetBits(_event_group, BIT_WAKE);
     }
 
-    bool isTaskDeleted()
+    /**
+     * @brief Ask the task to stop and wait for its loop to return
+     *
+     * @param timeout 0 to only ask
+     * @return true once the task has exited, false on timeout
+     */
+    bool stop(TickType_t timeout = portMAX_DELAY)
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        return _task_deleted = true;
+        xEventGroupSetBits(_event_group, BIT_STOP);
+        return xEventGroupWaitBits(_event_group, BIT_EXITED, pdFALSE, pdTRUE, timeout) & BIT_EXITED;
     }
 
-    void setTaskDeleted()
+    bool isRunning()
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        _task_deleted = true;
+        return xEventGroupGetBits(_event_group) & BIT_RUNNING;
     }
 
-    void sendKillSignalAndWaitDelete(const TickType_t xTicksToDelay = pdMS_TO_TICKS(100))
+    // Task side, a read of the bits without blocking
+    bool isStopRequested()
     {
-        sendKillSignal();
-        while (1) {
-            vTaskDelay(xTicksToDelay);
-            if (isTaskDeleted()) break;
+        return xEventGroupGetBits(_event_group) & BIT_STOP;
+    }
+
+    /**
+     * @brief Task side, blocks while paused
+     *
+     * @return false once a stop is requested, the loop should return then
+     */
+    bool checkPoint()
+    {
+        EventBits_t bits = xEventGroupGetBits(_event_group);
+        while ((bits & BIT_PAUSE) && !(bits & BIT_STOP)) {
+            xEventGroupWaitBits(_event_group, BIT_WAKE | BIT_STOP, pdFALSE, pdFALSE, portMAX_DELAY);
+            xEventGroupClearBits(_event_group, BIT_WAKE);
+            bits = xEventGroupGetBits(_event_group);
         }
+        return !(bits & BIT_STOP);
+    }
+
+    /**
+     * @brief Task side, a delay that ends early on a stop request
+     *
+     * @return false if a stop is requested
+     */
+    bool sleep(TickType_t ticks)
+    {
+        return !(xEventGroupWaitBits(_event_group, BIT_STOP, pdFALSE, pdFALSE, ticks) & BIT_STOP);
     }
 
-protected:
-    bool _kill_signal  = false;
-    bool _task_deleted = false;
+private:
+    enum : EventBits_t {
+        BIT_RUNNING = 1 << 0,
+        BIT_STOP    = 1 << 1,
+        BIT_PAUSE   = 1 << 2,
+        // Set by resume(), so a resume between the pause check and the wait is not lost
+        BIT_WAKE   = 1 << 3,
+        BIT_EXITED = 1 << 4,
+    };
+
+    StaticEventGroup_t _event_group_buffer;
+    EventGroupHandle_t _event_group = nullptr;
+    TaskLoop_t _loop;
+
+    static void task_entry(void* param)
+    {
+        auto controller = static_cast<TaskController_t*>(param);
+        controller->_loop(*controller);
+        controller->_loop = nullptr;
+
+        // Running goes down first, a start() after a join never sees the old task as running
+        xEventGroupClearBits(controller->_event_group, BIT_RUNNING);
+        xEventGroupSetBits(controller->_event_group, BIT_EXITED);
+        vTaskDelete(NULL);
+    }
 };
@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "task_pool.h"
+#include <mooncake_log.h>
+#include <string>
+#include <freertos/task.h>
+
+static const std::string _tag = "task-pool";
+
+bool TaskPool::init(const Config_t& config)
+{
+    if (_job_sem != nullptr) {
+        return true;
+    }
+    _config  = config;
+    _job_sem = xSemaphoreCreateCounting(_config.maxPending, 0);
+    if (_job_sem == nullptr) {
+        mclog::tagError(_tag, "create semaphore failed");
+        return false;
+    }
+
+    bool is_ok = true;
+    for (int core = 0; core < _core_num; core++) {
+        _worker_params[core].pool = this;
+        _worker_params[core].core = core;
+        for (int i = 0; i < _config.workersPerCore; i++) {
+            std::string name = "pool" + std::to_string(core) + std::to_string(i);
+            if (xTaskCreatePinnedToCore(worker_task, name.c_str(), _config.stackSize, &_worker_params[core],
+                                        _config.priority, NULL, core) != pdPASS) {
+                mclog::tagError(_tag, "create worker {} failed", name);
+                is_ok = false;
+            }
+        }
+    }
+    mclog::tagInfo(_tag, "{} workers per core, priority {}", _config.workersPerCore, _config.priority);
+    return is_ok;
+}
+
+bool TaskPool::submit(std::function<void()> job, int core)
+{
+    if (_job_sem == nullptr) {
+        return false;
+    }
+    if (_pending_num.fetch_add(1) >= _config.maxPending) {
+        _pending_num--;
+        mclog::tagWarn(_tag, "pool full");
+        return false;
+    }
+
+    if (core < 0 || core >= _core_num) {
+        core = xPortGetCoreID();
+    }
+    {
+        std::lock_guard<std::mutex> lock(_queues[core].mutex);
+        _queues[core].jobs.push_back(std::move(job));
+    }
+    _submitted_num++;
+    xSemaphoreGive(_job_sem);
+    return true;
+}
+
+TaskPool::Stats_t TaskPool::getStats()
+{
+    Stats_t stats;
+    stats.submitted = _submitted_num;
+    stats.done      = _done_num;
+    stats.stolen    = _stolen_num;
+    stats.pending   = _pending_num;
+    return stats;
+}
+
+void TaskPool::worker_task(void* param)
+{
+    auto worker = static_cast<WorkerParam_t*>(param);
+    worker->pool->worker_loop(worker->core);
+}
+
+void TaskPool::worker_loop(int core)
+{
+    std::function<void()> job;
+    while (1) {
+        xSemaphoreTake(_job_sem, portMAX_DELAY);
+        if (!take_job(core, job)) {
+            continue;
+        }
+        _pending_num--;
+        job();
+        // Captures go here, not on the next wakeup
+        job = nullptr;
+        _done_num++;
+    }
+}
+
+// Own queue first, then the others. Both from the front, a stolen job is the one that has waited longest
+bool TaskPool::take_job(int core, std::function<void()>& job)
+{
+    for (int i = 0; i < _core_num; i++) {
+        Queue_t& queue = _queues[(core + i) % _core_num];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) {
+            continue;
+        }
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        if (i != 0) {
+            _stolen_num++;
+        }
+        return true;
+    }
+    return false;
+}
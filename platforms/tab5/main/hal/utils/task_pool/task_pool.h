@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+/**
+ * @brief Shared workers for short jobs, in place of a task created and deleted per use. Every core has a queue and
+ * workers pinned to it, an idle worker takes the oldest job queued for the other core
+ *
+ */
+class TaskPool {
+public:
+    struct Config_t {
+        uint32_t stackSize     = 6 * 1024;
+        UBaseType_t priority   = 4;
+        uint8_t workersPerCore = 2;
+        // Jobs waiting over all queues, submit() fails past this
+        uint32_t maxPending = 64;
+    };
+
+    struct Stats_t {
+        uint32_t submitted = 0;
+        uint32_t done      = 0;
+        uint32_t stolen    = 0;  // Run on the other core than the one queued for
+        uint32_t pending   = 0;
+    };
+
+    /**
+     * @brief Create the workers, once
+     *
+     * @param config
+     * @return false if a worker could not be created, the ones that were keep running
+     */
+    bool init(const Config_t& config);
+
+    /**
+     * @brief Queue a job, from any task
+     *
+     * @param job
+     * @param core queue to put it in, -1 for the caller's core
+     * @return false if the pool is not up or full
+     */
+    bool submit(std::function<void()> job, int core = -1);
+
+    Stats_t getStats();
+
+private:
+    static constexpr int _core_num = portNUM_PROCESSORS;
+
+    struct Queue_t {
+        std::mutex mutex;
+        std::deque<std::function<void()>> jobs;
+    };
+
+    struct WorkerParam_t {
+        TaskPool* pool = nullptr;
+        int core       = 0;
+    };
+
+    Config_t _config;
+    Queue_t _queues[_core_num];
+    WorkerParam_t _worker_params[_core_num];
+    // Counts queued jobs, a worker woken by it always finds one in some queue
+    SemaphoreHandle_t _job_sem = nullptr;
+    std::atomic<uint32_t> _pending_num{0};
+    std::atomic<uint32_t> _submitted_num{0};
+    std::atomic<uint32_t> _done_num{0};
+    std::atomic<uint32_t> _stolen_num{0};
+
+    static void worker_task(void* param);
+    void worker_loop(int core);
+    bool take_job(int core, std::function<void()>& job);
+};
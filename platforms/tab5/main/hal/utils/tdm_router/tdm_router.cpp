@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "tdm_router.h"
+#include <algorithm>
+#include <math.h>
+
+static constexpr int _gain_shift = 12;
+
+static inline int16_t saturate(int32_t value)
+{
+    return std::clamp<int32_t>(value, INT16_MIN, INT16_MAX);
+}
+
+bool TdmRouter::setRoute(uint8_t inChannels, const uint8_t* slots, uint8_t outChannels, float gain,
+                         uint8_t decimation)
+{
+    if (inChannels == 0 || outChannels == 0 || outChannels > MaxChannels || decimation == 0) {
+        return false;
+    }
+    for (uint8_t c = 0; c < outChannels; c++) {
+        if (slots[c] >= inChannels) {
+            return false;
+        }
+        _slots[c] = slots[c];
+    }
+
+    _in_channels  = inChannels;
+    _out_channels = outChannels;
+    _decimation   = decimation;
+    _gain         = (int32_t)lrintf(std::clamp(gain, 0.0f, 8.0f) * (1 << _gain_shift));
+    return true;
+}
+
+size_t TdmRouter::process(const int16_t* in, size_t inFrames, int16_t* out) const
+{
+    if (_out_channels == 0) {
+        return 0;
+    }
+
+    // The mic tests and level meters take two slots at unity gain, a plain gather without multiplies
+    if (_out_channels == 2 && _decimation == 1 && _gain == (1 << _gain_shift)) {
+        return process_stereo_copy(in, inFrames, out);
+    }
+    return process_generic(in, inFrames, out);
+}
+
+size_t TdmRouter::process_stereo_copy(const int16_t* in, size_t frames, int16_t* out) const
+{
+    const uint8_t stride = _in_channels;
+    const uint8_t a      = _slots[0];
+    const uint8_t b      = _slots[1];
+
+    // Four frames per iteration, loads and stores stay independent so the core can dual issue them
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const int16_t* f = in + i * stride;
+        int16_t* o       = out + i * 2;
+        o[0]             = f[a];
+        o[1]             = f[b];
+        o[2]             = f[stride + a];
+        o[3]             = f[stride + b];
+        o[4]             = f[stride * 2 + a];
+        o[5]             = f[stride * 2 + b];
+        o[6]             = f[stride * 3 + a];
+        o[7]             = f[stride * 3 + b];
+    }
+    for (; i < frames; i++) {
+        out[i * 2 + 0] = in[i * stride + a];
+        out[i * 2 + 1] = in[i * stride + b];
+    }
+    return frames;
+}
+
+size_t TdmRouter::process_generic(const int16_t* in, size_t inFrames, int16_t* out) const
+{
+    const uint8_t stride     = _in_channels;
+    const uint8_t channels   = _out_channels;
+    const uint8_t decimation = _decimation;
+
+    // Averaging and gain folded into one multiply, sum * gain / decimation
+    const int32_t scale = _gain / decimation;
+
+    size_t out_frames = inFrames / decimation;
+    for (size_t f = 0; f < out_frames; f++) {
+        const int16_t* frame = in + f * decimation * stride;
+        for (uint8_t c = 0; c < channels; c++) {
+            const int16_t* src = frame + _slots[c];
+            int32_t sum        = 0;
+            for (uint8_t d = 0; d < decimation; d++) {
+                sum += src[d * stride];
+            }
+            out[f * channels + c] = saturate((sum * scale) >> _gain_shift);
+        }
+    }
+    return out_frames;
+}
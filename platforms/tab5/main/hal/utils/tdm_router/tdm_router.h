@@ -0,0 +1,54 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Deinterleave interleaved int16 TDM frames into a routed N channel layout, with gain, decimation and
+ * saturation
+ *
+ */
+class TdmRouter {
+public:
+    static constexpr uint8_t MaxChannels = 8;
+
+    /**
+     * @brief Set the route
+     *
+     * @param inChannels slots per input frame
+     * @param slots input slot of each output channel, a slot can repeat, e.g. {3, 3} duplicates MIC-HP to stereo
+     * @param outChannels
+     * @param gain linear, 0 ~ 8
+     * @param decimation each output frame averages this many input frames
+     * @return false on an invalid route
+     */
+    bool setRoute(uint8_t inChannels, const uint8_t* slots, uint8_t outChannels, float gain = 1.0f,
+                  uint8_t decimation = 1);
+
+    uint8_t outChannels() const
+    {
+        return _out_channels;
+    }
+
+    /**
+     * @brief Route inFrames input frames into out
+     *
+     * @return output frame count, inFrames / decimation
+     */
+    size_t process(const int16_t* in, size_t inFrames, int16_t* out) const;
+
+private:
+    uint8_t _in_channels  = 4;
+    uint8_t _out_channels = 0;
+    uint8_t _decimation   = 1;
+    uint8_t _slots[MaxChannels];
+    // Q12, 4096 is unity
+    int32_t _gain = 4096;
+
+    size_t process_stereo_copy(const int16_t* in, size_t frames, int16_t* out) const;
+    size_t process_generic(const int16_t* in, size_t inFrames, int16_t* out) const;
+};
@@ -0,0 +1,754 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "time_series_store.h"
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <esp_log.h>
+#include <esp_rom_crc.h>
+
+static const char* TAG = "time-series";
+
+/*
+ * Files of a series, little endian, structs are packed:
+ * blocks.dat : blocks back to back, BlockHeader_t, then count - 1 zigzag varints of the delta of deltas of the times,
+ *              then the values, the first as its raw bits, every next one XORed with the one before as a control byte
+ *              (zero bytes in front in the high nibble, bytes that follow in the low one) and those bytes, high first
+ * blocks.idx : an IndexEntry_t per block, with the CRC-32 of the block
+ * minute.idx, hour.idx : a RollupRecord_t per bucket that had samples
+ * Blocks go out before their index entries and those before the rollups, so after a power loss the index is never
+ * ahead of the blocks. Bytes past the last whole entry are cut off when the series is loaded
+ */
+struct __attribute__((packed)) BlockHeader_t {
+    char magic[4]   = {'T', 'S', 'B', 'K'};
+    uint16_t count  = 0;
+    uint16_t flags  = 0;
+    int64_t firstMs = 0;
+};
+
+struct __attribute__((packed)) IndexEntry_t {
+    int64_t firstMs = 0;
+    int64_t lastMs  = 0;
+    uint32_t offset = 0;
+    uint32_t size   = 0;
+    uint32_t crc    = 0;
+    uint32_t count  = 0;
+    float min       = 0.0f;
+    float max       = 0.0f;
+    double sum      = 0.0;
+};
+
+struct __attribute__((packed)) RollupRecord_t {
+    int64_t startMs = 0;
+    uint32_t count  = 0;
+    float min       = 0.0f;
+    float max       = 0.0f;
+    double sum      = 0.0;
+};
+
+static constexpr int64_t _tier_width_ms[TimeSeriesStore::TIER_NUM] = {0, 60 * 1000, 60 * 60 * 1000};
+static const char* _tier_file[TimeSeriesStore::TIER_NUM]           = {"blocks.idx", "minute.idx", "hour.idx"};
+static const char* _blocks_file                                     = "blocks.dat";
+// Index entries and rollup records read per call on a sequential walk
+static constexpr size_t _read_batch = 16;
+
+/* -------------------------------------------------------------------------- */
+/*                                  Encoding                                  */
+/* -------------------------------------------------------------------------- */
+static int64_t floor_to(int64_t value, int64_t width)
+{
+    return value / width * width;
+}
+
+static int64_t ceil_to(int64_t value, int64_t width)
+{
+    return (value + width - 1) / width * width;
+}
+
+static void put_varint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(value);
+}
+
+static bool get_varint(const uint8_t*& p, const uint8_t* end, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        uint8_t byte = *p++;
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint64_t zigzag(int64_t value)
+{
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static int64_t unzigzag(uint64_t value)
+{
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+static uint32_t float_bits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float bits_float(uint32_t bits)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+template <typename Sample>
+static void encode_block(const Sample* samples, size_t count, std::vector<uint8_t>& out)
+{
+    BlockHeader_t header;
+    header.count   = count;
+    header.firstMs = samples[0].timeMs;
+    out.assign((const uint8_t*)&header, (const uint8_t*)&header + sizeof(header));
+
+    // Samples come at a steady rate, so the delta of deltas is mostly 0 and one byte
+    int64_t delta = 0;
+    for (size_t i = 1; i < count; i++) {
+        int64_t d = samples[i].timeMs - samples[i - 1].timeMs;
+        put_varint(out, zigzag(d - delta));
+        delta = d;
+    }
+
+    // Slow values share sign, exponent and high mantissa bits with the one before, the XOR keeps only what changed
+    uint32_t prev = float_bits(samples[0].value);
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out.push_back(prev >> shift);
+    }
+    for (size_t i = 1; i < count; i++) {
+        uint32_t bits = float_bits(samples[i].value);
+        uint32_t x    = bits ^ prev;
+        prev          = bits;
+        int leading   = x == 0 ? 4 : __builtin_clz(x) / 8;
+        int trailing  = x == 0 ? 0 : __builtin_ctz(x) / 8;
+        int size      = 4 - leading - trailing;
+        out.push_back((leading << 4) | size);
+        for (int b = size - 1; b >= 0; b--) {
+            out.push_back(x >> ((trailing + b) * 8));
+        }
+    }
+}
+
+template <typename Sample>
+static bool decode_block(const uint8_t* data, size_t size, std::vector<Sample>& samples)
+{
+    if (size < sizeof(BlockHeader_t) + 4) {
+        return false;
+    }
+    BlockHeader_t header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, "TSBK", 4) != 0 || header.count == 0) {
+        return false;
+    }
+
+    const uint8_t* p   = data + sizeof(header);
+    const uint8_t* end = data + size;
+    samples.resize(header.count);
+    samples[0].timeMs = header.firstMs;
+    int64_t delta     = 0;
+    for (size_t i = 1; i < header.count; i++) {
+        uint64_t v;
+        if (!get_varint(p, end, v)) {
+            return false;
+        }
+        delta += unzigzag(v);
+        samples[i].timeMs = samples[i - 1].timeMs + delta;
+    }
+
+    if (end - p < 4) {
+        return false;
+    }
+    uint32_t prev = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    p += 4;
+    samples[0].value = bits_float(prev);
+    for (size_t i = 1; i < header.count; i++) {
+        if (p >= end) {
+            return false;
+        }
+        int leading  = *p >> 4;
+        int length   = *p & 0x0F;
+        int trailing = 4 - leading - length;
+        p++;
+        if (trailing < 0 || end - p < length) {
+            return false;
+        }
+        uint32_t x = 0;
+        for (int b = 0; b < length; b++) {
+            x = (x << 8) | *p++;
+        }
+        prev ^= trailing < 4 ? x << (trailing * 8) : 0;
+        samples[i].value = bits_float(prev);
+    }
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Files                                   */
+/* -------------------------------------------------------------------------- */
+template <typename Record>
+static bool read_records(int fd, uint32_t index, Record* records, size_t count)
+{
+    ssize_t size = count * sizeof(Record);
+    return pread(fd, records, size, (off_t)index * sizeof(Record)) == size;
+}
+
+// First record for which isAfter is true, records are in time order so it flips once
+template <typename Record, typename Pred>
+static uint32_t lower_bound(int fd, uint32_t count, Pred isAfter)
+{
+    uint32_t low  = 0;
+    uint32_t high = count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        Record record;
+        if (!read_records(fd, mid, &record, 1)) {
+            return count;
+        }
+        if (isAfter(record)) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return low;
+}
+
+// Cuts a file down to whole records, returns how many there are
+template <typename Record>
+static uint32_t whole_records(const std::string& path)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        return 0;
+    }
+    uint32_t count = st.st_size / sizeof(Record);
+    if (st.st_size % sizeof(Record) != 0) {
+        truncate(path.c_str(), (off_t)count * sizeof(Record));
+    }
+    return count;
+}
+
+static bool write_all(int fd, off_t offset, const void* data, size_t size)
+{
+    return lseek(fd, offset, SEEK_SET) == offset && write(fd, data, size) == (ssize_t)size;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Store                                   */
+/* -------------------------------------------------------------------------- */
+void TimeSeriesStore::Aggregate_t::add(float value)
+{
+    min = count == 0 ? value : std::min(min, value);
+    max = count == 0 ? value : std::max(max, value);
+    sum += value;
+    count++;
+}
+
+void TimeSeriesStore::Aggregate_t::merge(const Aggregate_t& other)
+{
+    if (other.count == 0) {
+        return;
+    }
+    min = count == 0 ? other.min : std::min(min, other.min);
+    max = count == 0 ? other.max : std::max(max, other.max);
+    sum += other.sum;
+    count += other.count;
+}
+
+void TimeSeriesStore::init(const std::string& root, uint16_t blockSamples, size_t maxPending)
+{
+    std::lock_guard<std::mutex> io_lock(_ioMutex);
+    std::lock_guard<std::mutex> lock(_mutex);
+    _root         = root;
+    _blockSamples = std::clamp<uint16_t>(blockSamples, 16, 4096);
+    _maxPending   = std::max(maxPending, (size_t)_blockSamples);
+    for (size_t i = 0; i < _seriesCount; i++) {
+        _series[i].isLoaded = false;
+    }
+}
+
+void TimeSeriesStore::invalidate()
+{
+    std::lock_guard<std::mutex> io_lock(_ioMutex);
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (size_t i = 0; i < _seriesCount; i++) {
+        _series[i].isLoaded = false;
+    }
+}
+
+TimeSeriesStore::Series_t* TimeSeriesStore::find(const char* name, bool create)
+{
+    for (size_t i = 0; i < _seriesCount; i++) {
+        if (strncmp(_series[i].name, name, MaxName + 1) == 0) {
+            return &_series[i];
+        }
+    }
+    if (!create || _seriesCount >= MaxSeries || strlen(name) > MaxName || name[0] == '\0') {
+        return nullptr;
+    }
+    Series_t& series = _series[_seriesCount++];
+    strncpy(series.name, name, MaxName);
+    series.pending.reserve(_blockSamples);
+    return &series;
+}
+
+bool TimeSeriesStore::append(const char* series, int64_t timeMs, float value)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Series_t* s = find(series, true);
+    if (s == nullptr) {
+        return false;
+    }
+    if (timeMs <= s->lastAppendMs || s->pending.size() >= _maxPending) {
+        _stats.dropped++;
+        return false;
+    }
+    s->pending.push_back({timeMs, value});
+    s->lastAppendMs = timeMs;
+    _stats.samples++;
+    return true;
+}
+
+std::string TimeSeriesStore::path_of(const Series_t& series, const char* file)
+{
+    return file == nullptr ? _root + "/" + series.name : _root + "/" + series.name + "/" + file;
+}
+
+bool TimeSeriesStore::load(Series_t& series)
+{
+    if (series.isLoaded) {
+        return true;
+    }
+
+    series.lastMs     = 0;
+    series.blocksSize = 0;
+    series.indexCount = whole_records<IndexEntry_t>(path_of(series, _tier_file[TIER_RAW]));
+    for (int tier = TIER_MINUTE; tier < TIER_NUM; tier++) {
+        series.rollupCount[tier] = whole_records<RollupRecord_t>(path_of(series, _tier_file[tier]));
+    }
+
+    // An entry whose block did not make it to the card is dropped, as are block bytes without an entry
+    struct stat st;
+    off_t blocks_size = stat(path_of(series, _blocks_file).c_str(), &st) == 0 ? st.st_size : 0;
+    int fd            = open(path_of(series, _tier_file[TIER_RAW]).c_str(), O_RDONLY);
+    uint32_t entries  = series.indexCount;
+    IndexEntry_t last;
+    while (series.indexCount > 0) {
+        if (fd >= 0 && read_records(fd, series.indexCount - 1, &last, 1) && last.offset + last.size <= blocks_size) {
+            series.lastMs     = last.lastMs;
+            series.blocksSize = last.offset + last.size;
+            break;
+        }
+        series.indexCount--;
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (series.indexCount < entries) {
+        truncate(path_of(series, _tier_file[TIER_RAW]).c_str(), (off_t)series.indexCount * sizeof(IndexEntry_t));
+    }
+    if (blocks_size > series.blocksSize) {
+        truncate(path_of(series, _blocks_file).c_str(), series.blocksSize);
+    }
+
+    // The open buckets are rebuilt from what is on file, tiers below them are complete already
+    QueryStats_t query_stats;
+    for (int tier = TIER_MINUTE; tier < TIER_NUM; tier++) {
+        series.doneEndMs[tier] = series.lastMs > 0 ? floor_to(series.lastMs, _tier_width_ms[tier]) : 0;
+        series.buckets[tier]   = Bucket_t();
+    }
+    series.isLoaded = true;
+    if (series.lastMs > 0) {
+        for (int tier = TIER_MINUTE; tier < TIER_NUM; tier++) {
+            auto& bucket   = series.buckets[tier];
+            bucket.startMs = series.doneEndMs[tier];
+            // The open minute is not in the hour bucket yet, it goes in when it closes
+            int64_t end = tier == TIER_MINUTE ? series.lastMs + 1 : series.buckets[TIER_MINUTE].startMs;
+            query_tier(series, (Tier_t)(tier - 1), bucket.startMs, end, bucket.aggregate, query_stats);
+        }
+    }
+    ESP_LOGI(TAG, "%s: %u blocks, last at %lld", series.name, (unsigned)series.indexCount, (long long)series.lastMs);
+    return true;
+}
+
+void TimeSeriesStore::feed_rollups(Series_t& series, Tier_t tier, const Bucket_t& bucket)
+{
+    int64_t start = floor_to(bucket.startMs, _tier_width_ms[tier]);
+    auto& open    = series.buckets[tier];
+    if (open.aggregate.count > 0 && open.startMs != start) {
+        _closed[tier].push_back(open);
+        if (tier + 1 < TIER_NUM) {
+            feed_rollups(series, (Tier_t)(tier + 1), open);
+        }
+        open = Bucket_t();
+    }
+    if (open.aggregate.count == 0) {
+        open.startMs = start;
+    }
+    open.aggregate.merge(bucket.aggregate);
+}
+
+bool TimeSeriesStore::write_rollups(Series_t& series, Tier_t tier)
+{
+    auto& closed = _closed[tier];
+    if (closed.empty()) {
+        return true;
+    }
+
+    std::vector<RollupRecord_t> records(closed.size());
+    for (size_t i = 0; i < closed.size(); i++) {
+        records[i].startMs = closed[i].startMs;
+        records[i].count   = closed[i].aggregate.count;
+        records[i].min     = closed[i].aggregate.min;
+        records[i].max     = closed[i].aggregate.max;
+        records[i].sum     = closed[i].aggregate.sum;
+    }
+    closed.clear();
+
+    int fd = open(path_of(series, _tier_file[tier]).c_str(), O_WRONLY | O_CREAT, 0666);
+    if (fd < 0) {
+        return false;
+    }
+    size_t size = records.size() * sizeof(RollupRecord_t);
+    bool is_ok  = write_all(fd, (off_t)series.rollupCount[tier] * sizeof(RollupRecord_t), records.data(), size) &&
+                 fsync(fd) == 0;
+    close(fd);
+    if (!is_ok) {
+        return false;
+    }
+    series.rollupCount[tier] += records.size();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.bytesWritten += size;
+    return true;
+}
+
+bool TimeSeriesStore::write_samples(Series_t& series, std::vector<Sample_t>& samples)
+{
+    // Left from before a reboot or a card swap
+    auto fresh =
+        std::find_if(samples.begin(), samples.end(), [&](const Sample_t& s) { return s.timeMs > series.lastMs; });
+    size_t dropped = fresh - samples.begin();
+    samples.erase(samples.begin(), fresh);
+    if (dropped > 0) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stats.dropped += dropped;
+    }
+    if (samples.empty()) {
+        return true;
+    }
+
+    if (series.indexCount == 0) {
+        mkdir(_root.c_str(), 0777);
+        mkdir(path_of(series, nullptr).c_str(), 0777);
+    }
+    int blocks_fd = open(path_of(series, _blocks_file).c_str(), O_WRONLY | O_CREAT, 0666);
+    if (blocks_fd < 0) {
+        return false;
+    }
+
+    std::vector<IndexEntry_t> entries;
+    std::vector<uint8_t> block;
+    uint32_t offset = series.blocksSize;
+    bool is_ok      = true;
+    for (size_t first = 0; first < samples.size() && is_ok; first += _blockSamples) {
+        size_t count = std::min<size_t>(_blockSamples, samples.size() - first);
+        encode_block(&samples[first], count, block);
+
+        IndexEntry_t entry;
+        entry.firstMs = samples[first].timeMs;
+        entry.lastMs  = samples[first + count - 1].timeMs;
+        entry.offset  = offset;
+        entry.size    = block.size();
+        entry.crc     = esp_rom_crc32_le(0, block.data(), block.size());
+        Aggregate_t aggregate;
+        for (size_t i = first; i < first + count; i++) {
+            aggregate.add(samples[i].value);
+            Bucket_t one;
+            one.startMs = samples[i].timeMs;
+            one.aggregate.add(samples[i].value);
+            feed_rollups(series, TIER_MINUTE, one);
+        }
+        entry.count = aggregate.count;
+        entry.min   = aggregate.min;
+        entry.max   = aggregate.max;
+        entry.sum   = aggregate.sum;
+        entries.push_back(entry);
+
+        is_ok = write_all(blocks_fd, offset, block.data(), block.size());
+        offset += block.size();
+    }
+    is_ok = is_ok && fsync(blocks_fd) == 0;
+    close(blocks_fd);
+    if (!is_ok) {
+        return false;
+    }
+
+    int index_fd = open(path_of(series, _tier_file[TIER_RAW]).c_str(), O_WRONLY | O_CREAT, 0666);
+    if (index_fd < 0) {
+        return false;
+    }
+    size_t index_size = entries.size() * sizeof(IndexEntry_t);
+    is_ok = write_all(index_fd, (off_t)series.indexCount * sizeof(IndexEntry_t), entries.data(), index_size) &&
+            fsync(index_fd) == 0;
+    close(index_fd);
+    if (!is_ok) {
+        return false;
+    }
+    series.blocksSize = offset;
+    series.indexCount += entries.size();
+    series.lastMs = samples.back().timeMs;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stats.blocks += entries.size();
+        _stats.bytesWritten += offset - entries.front().offset + index_size;
+    }
+
+    for (int tier = TIER_MINUTE; tier < TIER_NUM; tier++) {
+        if (!write_rollups(series, (Tier_t)tier)) {
+            return false;
+        }
+        series.doneEndMs[tier] = series.buckets[tier].startMs;
+    }
+    return true;
+}
+
+bool TimeSeriesStore::flush(bool force)
+{
+    std::lock_guard<std::mutex> io_lock(_ioMutex);
+
+    size_t series_count;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        series_count = _seriesCount;
+    }
+
+    bool is_ok = true;
+    for (size_t i = 0; i < series_count; i++) {
+        auto& series = _series[i];
+        std::vector<Sample_t> samples;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            size_t take = force ? series.pending.size() : series.pending.size() / _blockSamples * _blockSamples;
+            if (take == 0) {
+                continue;
+            }
+            samples.assign(series.pending.begin(), series.pending.begin() + take);
+            series.pending.erase(series.pending.begin(), series.pending.begin() + take);
+        }
+
+        if (!load(series) || !write_samples(series, samples)) {
+            ESP_LOGE(TAG, "%s: write failed, %u samples lost", series.name, (unsigned)samples.size());
+            for (auto& closed : _closed) {
+                closed.clear();
+            }
+            series.isLoaded = false;
+            is_ok           = false;
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stats.writeErrors++;
+        }
+    }
+    return is_ok;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Query                                   */
+/* -------------------------------------------------------------------------- */
+void TimeSeriesStore::query_raw(Series_t& series, int64_t startMs, int64_t endMs, Aggregate_t& result,
+                                QueryStats_t& queryStats)
+{
+    if (series.indexCount == 0) {
+        return;
+    }
+    int index_fd = open(path_of(series, _tier_file[TIER_RAW]).c_str(), O_RDONLY);
+    if (index_fd < 0) {
+        return;
+    }
+    int blocks_fd = -1;
+
+    uint32_t i = lower_bound<IndexEntry_t>(index_fd, series.indexCount,
+                                           [&](const IndexEntry_t& entry) { return entry.lastMs >= startMs; });
+    IndexEntry_t entries[_read_batch];
+    std::vector<uint8_t> block;
+    std::vector<Sample_t> samples;
+    bool is_done = false;
+    while (i < series.indexCount && !is_done) {
+        size_t count = std::min<size_t>(_read_batch, series.indexCount - i);
+        if (!read_records(index_fd, i, entries, count)) {
+            break;
+        }
+        i += count;
+
+        for (size_t e = 0; e < count; e++) {
+            const auto& entry = entries[e];
+            if (entry.firstMs >= endMs) {
+                is_done = true;
+                break;
+            }
+            queryStats.indexRead++;
+
+            // Whole blocks are answered from the index
+            if (entry.firstMs >= startMs && entry.lastMs < endMs) {
+                Aggregate_t aggregate;
+                aggregate.count = entry.count;
+                aggregate.min   = entry.min;
+                aggregate.max   = entry.max;
+                aggregate.sum   = entry.sum;
+                result.merge(aggregate);
+                continue;
+            }
+
+            if (blocks_fd < 0) {
+                blocks_fd = open(path_of(series, _blocks_file).c_str(), O_RDONLY);
+            }
+            block.resize(entry.size);
+            bool is_read =
+                blocks_fd >= 0 && pread(blocks_fd, block.data(), entry.size, entry.offset) == (ssize_t)entry.size;
+            if (!is_read || esp_rom_crc32_le(0, block.data(), block.size()) != entry.crc ||
+                !decode_block(block.data(), block.size(), samples)) {
+                ESP_LOGW(TAG, "%s: bad block at %u", series.name, (unsigned)entry.offset);
+                continue;
+            }
+            queryStats.blocksDecoded++;
+            for (const auto& sample : samples) {
+                if (sample.timeMs >= startMs && sample.timeMs < endMs) {
+                    result.add(sample.value);
+                }
+            }
+        }
+    }
+
+    if (blocks_fd >= 0) {
+        close(blocks_fd);
+    }
+    close(index_fd);
+}
+
+void TimeSeriesStore::query_tier(Series_t& series, Tier_t tier, int64_t startMs, int64_t endMs, Aggregate_t& result,
+                                 QueryStats_t& queryStats)
+{
+    if (startMs >= endMs) {
+        return;
+    }
+    if (tier == TIER_RAW) {
+        query_raw(series, startMs, endMs, result, queryStats);
+        return;
+    }
+
+    // Whole buckets inside the range and on file come from this tier, the edges from the one below
+    int64_t width   = _tier_width_ms[tier];
+    int64_t first   = ceil_to(startMs, width);
+    int64_t last    = std::min(floor_to(endMs, width), series.doneEndMs[tier]);
+    auto lower_tier = (Tier_t)(tier - 1);
+    if (first >= last || series.rollupCount[tier] == 0) {
+        query_tier(series, lower_tier, startMs, endMs, result, queryStats);
+        return;
+    }
+
+    int fd = open(path_of(series, _tier_file[tier]).c_str(), O_RDONLY);
+    if (fd >= 0) {
+        uint32_t count = series.rollupCount[tier];
+        auto is_after  = [&](const RollupRecord_t& record) { return record.startMs >= first; };
+        uint32_t i     = lower_bound<RollupRecord_t>(fd, count, is_after);
+        RollupRecord_t records[_read_batch];
+        bool is_done = false;
+        while (i < count && !is_done) {
+            size_t batch = std::min<size_t>(_read_batch, count - i);
+            if (!read_records(fd, i, records, batch)) {
+                break;
+            }
+            i += batch;
+            for (size_t r = 0; r < batch; r++) {
+                if (records[r].startMs >= last) {
+                    is_done = true;
+                    break;
+                }
+                Aggregate_t aggregate;
+                aggregate.count = records[r].count;
+                aggregate.min   = records[r].min;
+                aggregate.max   = records[r].max;
+                aggregate.sum   = records[r].sum;
+                result.merge(aggregate);
+                queryStats.rollupsRead++;
+            }
+        }
+        close(fd);
+    }
+
+    query_tier(series, lower_tier, startMs, first, result, queryStats);
+    query_tier(series, lower_tier, last, endMs, result, queryStats);
+}
+
+bool TimeSeriesStore::query(const char* series, int64_t startMs, int64_t endMs, Aggregate_t& result,
+                            QueryStats_t* queryStats)
+{
+    std::lock_guard<std::mutex> io_lock(_ioMutex);
+
+    Series_t* s;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        s = find(series, false);
+        // Known from an earlier boot, the series gets a slot to load its files into
+        struct stat st;
+        if (s == nullptr && !_root.empty() && stat((_root + "/" + series).c_str(), &st) == 0) {
+            s = find(series, true);
+        }
+    }
+    if (s == nullptr) {
+        return false;
+    }
+
+    QueryStats_t stats;
+    result = Aggregate_t();
+    if (load(*s)) {
+        query_tier(*s, TIER_HOUR, startMs, endMs, result, stats);
+    }
+
+    // Pending samples come after everything on file
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& sample : s->pending) {
+        if (sample.timeMs > s->lastMs && sample.timeMs >= startMs && sample.timeMs < endMs) {
+            result.add(sample.value);
+        }
+    }
+    if (queryStats) {
+        *queryStats = stats;
+    }
+    return true;
+}
+
+size_t TimeSeriesStore::getSeriesCount()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _seriesCount;
+}
+
+TimeSeriesStore::Stats_t TimeSeriesStore::getStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
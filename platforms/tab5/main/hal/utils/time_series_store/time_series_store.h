@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Append only float series on a file system, one directory per series under a root
+ *
+ * Samples wait in RAM until a writer flushes them as compressed blocks, times as delta of deltas and values XORed with
+ * the one before. Each block gets an index entry with its time range and the count, min, max and sum of its values,
+ * and the values also go into per minute and per hour rollups. A range query takes the coarsest tier whose buckets fit
+ * in the range, finer tiers fill in the edges, and only the blocks cut by the range are read and decoded
+ *
+ * Times are ms and have to increase per series, later samples at or before the last one are dropped. append() is for
+ * any task, flush() for one writer, query() for any task and waits on a flush in progress
+ */
+class TimeSeriesStore {
+public:
+    static constexpr size_t MaxSeries = 16;
+    // Directory name, kept short for FAT
+    static constexpr size_t MaxName = 15;
+
+    enum Tier_t {
+        TIER_RAW = 0,
+        TIER_MINUTE,
+        TIER_HOUR,
+        TIER_NUM,
+    };
+
+    struct Aggregate_t {
+        uint32_t count = 0;
+        float min      = 0.0f;
+        float max      = 0.0f;
+        double sum     = 0.0;
+
+        void add(float value);
+        void merge(const Aggregate_t& other);
+    };
+
+    struct QueryStats_t {
+        uint32_t rollupsRead   = 0;
+        uint32_t indexRead     = 0;
+        uint32_t blocksDecoded = 0;
+    };
+
+    struct Stats_t {
+        uint32_t samples      = 0;
+        uint32_t dropped      = 0;
+        uint32_t blocks       = 0;
+        uint64_t bytesWritten = 0;
+        uint32_t writeErrors  = 0;
+    };
+
+    /**
+     * @param root directory the series go under, created on the first flush
+     * @param blockSamples samples per block, flush() without force leaves fewer pending
+     * @param maxPending samples a series keeps in RAM while nothing is flushed, later ones are dropped
+     */
+    void init(const std::string& root, uint16_t blockSamples, size_t maxPending);
+
+    // Files are read again before the next flush or query, for when the card was removed
+    void invalidate();
+
+    // False if the name is too long or there is no room for another series
+    bool append(const char* series, int64_t timeMs, float value);
+
+    /**
+     * @brief Write pending samples of every series, from the writer only
+     *
+     * @param force also write series with less than a block pending
+     * @return false if a write failed, the samples of that flush are lost and the series is read again from its files
+     */
+    bool flush(bool force);
+
+    // Over [startMs, endMs), false for an unknown series
+    bool query(const char* series, int64_t startMs, int64_t endMs, Aggregate_t& result,
+               QueryStats_t* queryStats = nullptr);
+
+    size_t getSeriesCount();
+    Stats_t getStats();
+
+private:
+    struct Sample_t {
+        int64_t timeMs;
+        float value;
+    };
+
+    // Open bucket of a rollup tier, the writer feeds it
+    struct Bucket_t {
+        int64_t startMs = 0;
+        Aggregate_t aggregate;
+    };
+
+    struct Series_t {
+        char name[MaxName + 1] = {0};
+        std::vector<Sample_t> pending;
+        // Last sample taken to pending, appends check against it
+        int64_t lastAppendMs = 0;
+        // File state, valid while isLoaded
+        bool isLoaded       = false;
+        int64_t lastMs      = 0;
+        uint32_t blocksSize = 0;
+        uint32_t indexCount = 0;
+        // Records in the rollup files, the raw tier has the index instead
+        uint32_t rollupCount[TIER_NUM] = {0};
+        // Buckets of a tier before this are all on file
+        int64_t doneEndMs[TIER_NUM] = {0};
+        Bucket_t buckets[TIER_NUM];
+    };
+
+    std::mutex _mutex;
+    // Held through a flush and a query, so a query never sees samples that left pending but are not on file yet
+    std::mutex _ioMutex;
+    std::string _root;
+    uint16_t _blockSamples = 512;
+    size_t _maxPending     = 4096;
+    Series_t _series[MaxSeries];
+    size_t _seriesCount = 0;
+    Stats_t _stats;
+    // Writer side, buckets a flush closed, per tier
+    std::vector<Bucket_t> _closed[TIER_NUM];
+
+    // Lock _mutex before calling
+    Series_t* find(const char* name, bool create);
+
+    std::string path_of(const Series_t& series, const char* file);
+    // Lock _ioMutex before calling
+    bool load(Series_t& series);
+    bool write_samples(Series_t& series, std::vector<Sample_t>& samples);
+    bool write_rollups(Series_t& series, Tier_t tier);
+    void feed_rollups(Series_t& series, Tier_t tier, const Bucket_t& bucket);
+    void query_tier(Series_t& series, Tier_t tier, int64_t startMs, int64_t endMs, Aggregate_t& result,
+                    QueryStats_t& queryStats);
+    void query_raw(Series_t& series, int64_t startMs, int64_t endMs, Aggregate_t& result, QueryStats_t& queryStats);
+};
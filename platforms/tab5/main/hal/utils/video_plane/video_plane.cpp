@@ -0,0 +1,55 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "video_plane.h"
+
+bool video_plane::fits(lv_obj_t* canvas, uint16_t w, uint16_t h, lv_area_t& area)
+{
+    if (lv_obj_has_flag(canvas, LV_OBJ_FLAG_HIDDEN) || lv_obj_get_style_radius(canvas, LV_PART_MAIN) != 0 ||
+        lv_obj_get_style_opa_recursive(canvas, LV_PART_MAIN) < LV_OPA_MAX ||
+        lv_obj_get_style_transform_rotation(canvas, LV_PART_MAIN) != 0 ||
+        lv_obj_get_style_transform_scale_x(canvas, LV_PART_MAIN) != LV_SCALE_NONE ||
+        lv_obj_get_style_transform_scale_y(canvas, LV_PART_MAIN) != LV_SCALE_NONE) {
+        return false;
+    }
+    lv_obj_get_coords(canvas, &area);
+    lv_display_t* display = lv_obj_get_display(canvas);
+    return lv_area_get_width(&area) == w && lv_area_get_height(&area) == h && area.x1 >= 0 && area.y1 >= 0 &&
+           area.x2 < lv_display_get_horizontal_resolution(display) &&
+           area.y2 < lv_display_get_vertical_resolution(display);
+}
+
+static void invalidate_over(lv_obj_t* obj, const lv_area_t& plane)
+{
+    lv_area_t coords;
+    lv_area_t common;
+    lv_obj_get_coords(obj, &coords);
+    if (!lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) && lv_area_intersect(&common, &coords, &plane)) {
+        lv_obj_invalidate(obj);
+    }
+}
+
+void video_plane::invalidate_overlays(lv_obj_t* canvas, const lv_area_t& plane)
+{
+    for (lv_obj_t* obj = canvas; lv_obj_get_parent(obj); obj = lv_obj_get_parent(obj)) {
+        lv_obj_t* parent = lv_obj_get_parent(obj);
+        uint32_t count   = lv_obj_get_child_count(parent);
+        for (uint32_t i = lv_obj_get_index(obj) + 1; i < count; i++) {
+            invalidate_over(lv_obj_get_child(parent, i), plane);
+        }
+    }
+    for (lv_obj_t* layer : {lv_layer_top(), lv_layer_sys()}) {
+        uint32_t count = lv_obj_get_child_count(layer);
+        for (uint32_t i = 0; i < count; i++) {
+            invalidate_over(lv_obj_get_child(layer, i), plane);
+        }
+    }
+}
+
+void video_plane::invalidate_dot(lv_obj_t* canvas, const lv_area_t& plane)
+{
+    lv_area_t dot = {plane.x1, plane.y1, plane.x1, plane.y1};
+    lv_obj_invalidate_area(canvas, &dot);
+}
@@ -0,0 +1,41 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <lvgl.h>
+
+/**
+ * @brief Helpers for a canvas shown as the display port's video plane, see lvgl_port_set_video_plane()
+ *
+ * A canvas drawn as a plain opaque rectangle does not go through LVGL composition. The frame on it is handed to the
+ * port instead, which copies it under every frame, and LVGL only renders what is drawn over it. Call from the LVGL
+ * task or with the LVGL port lock taken
+ *
+ */
+namespace video_plane {
+
+/**
+ * @brief Whether a w x h RGB565 frame on canvas can be the plane, drawn exactly over the canvas coordinates
+ *
+ * @param area set to the canvas coordinates
+ */
+bool fits(lv_obj_t* canvas, uint16_t w, uint16_t h, lv_area_t& area);
+
+/**
+ * @brief Invalidate whatever is drawn after the canvas over the plane: its later siblings and those of every parent up
+ * to the screen, and the top and system layers. Done for every new frame, so they are rendered over it for correct
+ * alpha
+ *
+ */
+void invalidate_overlays(lv_obj_t* canvas, const lv_area_t& plane);
+
+/**
+ * @brief Get LVGL to flush a frame with only the plane changed, one pixel of the canvas gets it copied
+ *
+ */
+void invalidate_dot(lv_obj_t* canvas, const lv_area_t& plane);
+
+}  // namespace video_plane
@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "voice_activity_detector.h"
+#include <algorithm>
+
+// DC blocker pole, 0.98 in Q15, about 25Hz at 8kHz
+static constexpr int32_t _dc_pole = 32113;
+// Floor rise per quiet frame, Q8 log2, about 0.2dB
+static constexpr int32_t _floor_rise = 16;
+// The energy is a power, 3dB per log2 step
+static constexpr float _db_per_log2 = 3.0103f;
+
+// log2 in Q8, the top bits after the leading one index a straight line between powers of two
+static int32_t log2_q8(uint64_t value)
+{
+    if (value == 0) {
+        return 0;
+    }
+    int msb           = 63 - __builtin_clzll(value);
+    uint32_t mantissa = msb >= 8 ? (uint32_t)(value >> (msb - 8)) & 0xFF : (uint32_t)(value << (8 - msb)) & 0xFF;
+    return msb * 256 + mantissa;
+}
+
+bool VoiceActivityDetector::init(const Config_t& config)
+{
+    if (config.sampleRate == 0 || config.frameMs == 0) {
+        return false;
+    }
+    _config        = config;
+    _frame_samples = config.sampleRate * config.frameMs / 1000;
+    if (_frame_samples == 0) {
+        return false;
+    }
+    _threshold = config.thresholdDb / _db_per_log2 * 256;
+    // Mean square of a full scale sine is 2^29, so 0dBFS sits at 29 in log2
+    _min_level  = (29.0f + config.minLevelDb / _db_per_log2) * 256;
+    _min_speech = std::max(1, config.minSpeechMs / config.frameMs);
+    _hangover   = config.hangoverMs / config.frameMs;
+    reset();
+    return true;
+}
+
+void VoiceActivityDetector::reset()
+{
+    _dc_x1         = 0;
+    _dc_y1         = 0;
+    _energy        = 0;
+    _filled        = 0;
+    _speech_frames = 0;
+    _gap_frames    = 0;
+    _is_floor_set  = false;
+    _is_triggered  = false;
+}
+
+bool VoiceActivityDetector::process(const int16_t* samples, size_t count)
+{
+    bool is_detected = false;
+    for (size_t i = 0; i < count; i++) {
+        int32_t x = samples[i];
+        int32_t y = x - _dc_x1 + (int32_t)(((int64_t)_dc_y1 * _dc_pole) >> 15);
+        _dc_x1    = x;
+        _dc_y1    = y;
+        _energy += (int64_t)y * y;
+
+        if (++_filled == _frame_samples) {
+            is_detected |= end_frame();
+            _energy = 0;
+            _filled = 0;
+        }
+    }
+    return is_detected;
+}
+
+bool VoiceActivityDetector::end_frame()
+{
+    int32_t level = log2_q8(_energy / _frame_samples);
+    if (!_is_floor_set) {
+        _floor        = level;
+        _is_floor_set = true;
+    }
+
+    bool is_voice = level >= _min_level && level - _floor >= _threshold;
+    if (is_voice) {
+        _speech_frames++;
+        _gap_frames = 0;
+    } else {
+        // The floor only learns from frames that are not voice, it drops at once and rises slowly
+        _floor = level < _floor ? level : std::min(level, _floor + _floor_rise);
+        if (++_gap_frames > _hangover) {
+            _speech_frames = 0;
+            _is_triggered  = false;
+        }
+    }
+
+    if (!_is_triggered && _speech_frames >= _min_speech) {
+        _is_triggered = true;
+        return true;
+    }
+    return false;
+}
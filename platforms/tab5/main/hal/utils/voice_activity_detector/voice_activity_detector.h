@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Fixed point energy detector for voice on a single mic channel
+ *
+ * Frames are DC blocked and their energy taken as log2 in Q8. A noise floor follows the quiet frames slowly and
+ * drops right away, a frame counts as voice when it is the threshold above the floor. Voice is reported once
+ * minSpeechMs of such frames come close together, gaps shorter than the hangover do not reset the count.
+ *
+ */
+class VoiceActivityDetector {
+public:
+    struct Config_t {
+        uint32_t sampleRate  = 8000;
+        uint16_t frameMs     = 20;
+        float thresholdDb    = 12.0f;
+        uint16_t minSpeechMs = 120;
+        uint16_t hangoverMs  = 300;
+        // Quieter frames never count as voice, e.g. a silent room above the floor of the ADC
+        float minLevelDb = -60.0f;
+    };
+
+    bool init(const Config_t& config);
+    void reset();
+
+    /**
+     * @brief Feed mono samples, any count
+     *
+     * @return true on the frame that completes a detection, again only after the voice has ended
+     */
+    bool process(const int16_t* samples, size_t count);
+
+    bool isVoice() const
+    {
+        return _is_triggered;
+    }
+    // Q8 log2 of the mean square, for tuning
+    int32_t noiseFloor() const
+    {
+        return _floor;
+    }
+
+private:
+    Config_t _config;
+    size_t _frame_samples   = 0;
+    int32_t _threshold      = 0;
+    int32_t _min_level      = 0;
+    uint16_t _speech_frames = 0;
+    uint16_t _gap_frames    = 0;
+    uint16_t _min_speech    = 0;
+    uint16_t _hangover      = 0;
+
+    // DC blocker, Q15
+    int32_t _dc_x1 = 0;
+    int32_t _dc_y1 = 0;
+
+    uint64_t _energy   = 0;
+    size_t _filled     = 0;
+    int32_t _floor     = 0;
+    bool _is_floor_set = false;
+    bool _is_triggered = false;
+
+    bool end_frame();
+};
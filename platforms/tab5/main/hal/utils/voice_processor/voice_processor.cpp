@@ -0,0 +1,169 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "voice_processor.h"
+#include <algorithm>
+#include <math.h>
+
+// Mic level above this ratio of the recent reference peak counts as near end speech, the speaker sits next to the
+// mics so the echo itself can be louder than the reference, hence above unity
+static constexpr float _double_talk_ratio = 2.0f;
+static constexpr float _ref_peak_decay    = 0.9995f;
+static constexpr uint32_t _hangover_ms    = 30;
+// Below this reference energy over the window there is nothing to learn from
+static constexpr float _min_ref_energy = 1e-5f;
+
+// Noise suppressor, gain ramps from the floor attenuation at 1x the noise floor to unity at 2x
+static constexpr float _ns_floor_gain   = 0.1f;
+static constexpr float _ns_floor_rise   = 1.01f;
+static constexpr float _ns_floor_fall   = 0.1f;
+static constexpr float _ns_gain_attack  = 0.6f;
+static constexpr float _ns_gain_release = 0.3f;
+
+bool VoiceProcessor::init(const Config_t& config, uint8_t inChannels, uint8_t refChannel)
+{
+    if (inChannels < 2 || refChannel >= inChannels || config.taps == 0) {
+        return false;
+    }
+
+    _config      = config;
+    _in_channels = inChannels;
+    _ref_channel = refChannel;
+
+    _mics.clear();
+    for (uint8_t c = 0; c < inChannels; c++) {
+        if (c == refChannel) {
+            continue;
+        }
+        Mic_t mic;
+        mic.channel = c;
+        mic.weights.assign(config.taps, 0.0f);
+        _mics.push_back(mic);
+    }
+
+    _ref_history.assign(config.taps * 2, 0.0f);
+    _ref_pos    = 0;
+    _ref_energy = 0.0f;
+    _ref_peak   = 0.0f;
+    _hangover   = 0;
+    return true;
+}
+
+bool VoiceProcessor::is_double_talk(float mic, float ref)
+{
+    _ref_peak = std::max(fabsf(ref), _ref_peak * _ref_peak_decay);
+    if (fabsf(mic) > _ref_peak * _double_talk_ratio) {
+        _hangover = _config.sampleRate * _hangover_ms / 1000;
+    } else if (_hangover > 0) {
+        _hangover--;
+    }
+    return _hangover > 0;
+}
+
+void VoiceProcessor::process(const int16_t* in, size_t frames, int16_t* out)
+{
+    const size_t taps         = _config.taps;
+    const uint8_t in_channels = _in_channels;
+    const size_t mic_num      = _mics.size();
+
+    _mic_block.resize(frames * mic_num);
+
+    for (size_t f = 0; f < frames; f++) {
+        const int16_t* frame = in + f * in_channels;
+
+        // Newest reference sample first, the one leaving the window drops out of the energy
+        float ref = frame[_ref_channel] / 32768.0f;
+        _ref_pos  = (_ref_pos + taps - 1) % taps;
+        float old = _ref_history[_ref_pos];
+        _ref_energy += ref * ref - old * old;
+        _ref_energy = std::max(_ref_energy, 0.0f);
+
+        _ref_history[_ref_pos]        = ref;
+        _ref_history[_ref_pos + taps] = ref;
+        const float* history          = &_ref_history[_ref_pos];
+
+        // Once per window, resum the energy so float rounding of the running update cannot drift
+        if (_ref_pos == 0) {
+            _ref_energy = 0.0f;
+            for (size_t k = 0; k < taps; k++) {
+                _ref_energy += history[k] * history[k];
+            }
+        }
+
+        float mic_peak = 0.0f;
+        for (const auto& mic : _mics) {
+            mic_peak = std::max(mic_peak, fabsf(frame[mic.channel] / 32768.0f));
+        }
+        bool adapt = _config.echoCancel && _ref_energy > _min_ref_energy && !is_double_talk(mic_peak, ref);
+        float step = _config.stepSize / (_ref_energy + _min_ref_energy);
+
+        for (size_t m = 0; m < mic_num; m++) {
+            auto& mic     = _mics[m];
+            float desired = frame[mic.channel] / 32768.0f;
+            float error   = desired;
+
+            if (_config.echoCancel) {
+                float* weights = mic.weights.data();
+                float echo     = 0.0f;
+                for (size_t k = 0; k < taps; k++) {
+                    echo += weights[k] * history[k];
+                }
+                error = desired - echo;
+
+                if (adapt) {
+                    float g = step * error;
+                    for (size_t k = 0; k < taps; k++) {
+                        weights[k] += g * history[k];
+                    }
+                }
+            }
+            _mic_block[m * frames + f] = error;
+        }
+    }
+
+    for (size_t m = 0; m < mic_num; m++) {
+        float* block = &_mic_block[m * frames];
+        if (_config.noiseSuppress) {
+            suppress_noise(_mics[m], block, frames);
+        }
+        for (size_t f = 0; f < frames; f++) {
+            int32_t sample       = (int32_t)lrintf(block[f] * 32768.0f);
+            out[f * mic_num + m] = std::clamp<int32_t>(sample, INT16_MIN, INT16_MAX);
+        }
+    }
+}
+
+void VoiceProcessor::suppress_noise(Mic_t& mic, float* block, size_t frames)
+{
+    if (frames == 0) {
+        return;
+    }
+
+    float energy = 0.0f;
+    for (size_t f = 0; f < frames; f++) {
+        energy += block[f] * block[f];
+    }
+    float rms = sqrtf(energy / frames);
+
+    // Floor falls quickly to quiet blocks and creeps up slowly, so speech does not lift it
+    if (mic.noiseFloor <= 0.0f || rms < mic.noiseFloor) {
+        mic.noiseFloor += (rms - mic.noiseFloor) * (mic.noiseFloor <= 0.0f ? 1.0f : _ns_floor_fall);
+    } else {
+        mic.noiseFloor *= _ns_floor_rise;
+    }
+
+    float snr    = mic.noiseFloor > 0.0f ? rms / mic.noiseFloor : 2.0f;
+    float target = std::clamp(_ns_floor_gain + (1.0f - _ns_floor_gain) * (snr - 1.0f), _ns_floor_gain, 1.0f);
+    float gain   = mic.gain + (target - mic.gain) * (target > mic.gain ? _ns_gain_attack : _ns_gain_release);
+
+    // Ramp across the block to avoid zipper noise
+    float step = (gain - mic.gain) / frames;
+    float g    = mic.gain;
+    for (size_t f = 0; f < frames; f++) {
+        g += step;
+        block[f] *= g;
+    }
+    mic.gain = gain;
+}
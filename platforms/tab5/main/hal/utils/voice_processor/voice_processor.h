@@ -0,0 +1,75 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+/**
+ * @brief Block based echo cancellation and noise suppression for mic channels against a playback reference
+ *
+ * Echo is removed by an NLMS adaptive filter per mic, frozen during double talk. Noise is reduced by a
+ * downward expander that follows the noise floor of each mic.
+ *
+ */
+class VoiceProcessor {
+public:
+    struct Config_t {
+        uint32_t sampleRate = 16000;
+        // Echo tail covered by the filter, 256 taps is 16ms at 16kHz
+        uint16_t taps      = 256;
+        float stepSize     = 0.2f;
+        bool echoCancel    = true;
+        bool noiseSuppress = true;
+    };
+
+    /**
+     * @brief Prepare the per mic state
+     *
+     * @param config
+     * @param inChannels channels per input frame
+     * @param refChannel index of the playback reference in the input frame
+     * @return false on an invalid layout
+     */
+    bool init(const Config_t& config, uint8_t inChannels, uint8_t refChannel);
+
+    // Mic channels in the output, the input layout without the reference
+    uint8_t outChannels() const
+    {
+        return _in_channels - 1;
+    }
+
+    /**
+     * @brief Process interleaved input frames into interleaved mic frames
+     *
+     */
+    void process(const int16_t* in, size_t frames, int16_t* out);
+
+private:
+    struct Mic_t {
+        uint8_t channel = 0;
+        std::vector<float> weights;
+        // Noise suppressor
+        float noiseFloor = 0.0f;
+        float gain       = 1.0f;
+    };
+
+    Config_t _config;
+    uint8_t _in_channels = 0;
+    uint8_t _ref_channel = 0;
+    std::vector<Mic_t> _mics;
+
+    // Reference history written twice, so the filter reads taps contiguous floats from any position
+    std::vector<float> _ref_history;
+    size_t _ref_pos    = 0;
+    float _ref_energy  = 0.0f;
+    float _ref_peak    = 0.0f;
+    uint32_t _hangover = 0;
+    std::vector<float> _mic_block;
+
+    bool is_double_talk(float mic, float ref);
+    void suppress_noise(Mic_t& mic, float* block, size_t frames);
+};
@@ -0,0 +1,89 @@
+"""
+Build the asset pack flashed to the "assets" partition, read in place by hal_asset_pack.cpp
+
+Layout, little endian:
+header : "M5AP", u16 version, u16 entry count, u32 total size, u32 CRC-32 of the index
+index  : per entry, name (32 bytes, NUL padded), u32 offset from the pack start, u32 size, u32 format, u32 CRC-32
+data   : each entry 16 byte aligned
+CRC-32 is the zlib one. The name is the file name, the format comes from the extension
+
+Usage: python build_asset_pack.py -o assets.bin [--max-size N] file [file ...]
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+_magic = b'M5AP'
+_format_version = 1
+_name_size = 32
+_align = 16
+
+# Same values as hal::HalBase::AssetFormat_t
+_asset_formats = {
+    '.mp3': 1,
+    '.wav': 2,
+    # LVGL binary image, lv_image_header_t followed by the pixels
+    '.bin': 3,
+}
+_asset_format_raw = 0
+
+_header = struct.Struct('<4sHHII')
+_entry = struct.Struct('<{}sIIII'.format(_name_size))
+
+
+def align_up(value):
+    return (value + _align - 1) // _align * _align
+
+
+def build_pack(paths):
+    names = [os.path.basename(path) for path in paths]
+    for name in names:
+        if len(name.encode()) >= _name_size:
+            raise ValueError('name too long: ' + name)
+    if len(set(names)) != len(names):
+        raise ValueError('duplicate names')
+
+    offset = align_up(_header.size + _entry.size * len(paths))
+    index = bytearray()
+    data = bytearray()
+    for path, name in sorted(zip(paths, names), key=lambda item: item[1]):
+        with open(path, 'rb') as f:
+            content = f.read()
+        asset_format = _asset_formats.get(os.path.splitext(name)[1].lower(), _asset_format_raw)
+        index += _entry.pack(name.encode(), offset + len(data), len(content), asset_format, zlib.crc32(content))
+        data += content
+        data += b'\0' * (align_up(len(data)) - len(data))
+
+    padding = b'\0' * (align_up(_header.size + len(index)) - _header.size - len(index))
+    total_size = _header.size + len(index) + len(padding) + len(data)
+    header = _header.pack(_magic, _format_version, len(paths), total_size, zlib.crc32(index))
+    return header + index + padding + data
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-o', '--output', required=True)
+    parser.add_argument('--max-size', type=lambda x: int(x, 0), default=0, help='partition size, 0 for no check')
+    parser.add_argument('files', nargs='+')
+    args = parser.parse_args()
+
+    try:
+        pack = build_pack(args.files)
+    except (OSError, ValueError) as e:
+        print('asset pack: {}'.format(e))
+        return 1
+    if args.max_size and len(pack) > args.max_size:
+        print('asset pack: {} bytes do not fit the {} byte partition'.format(len(pack), args.max_size))
+        return 1
+
+    with open(args.output, 'wb') as f:
+        f.write(pack)
+    print('asset pack: {} files, {} bytes'.format(len(args.files), len(pack)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,105 @@
+"""
+Turn a sampling profiler dump from hal_profiler.cpp into folded stacks, one "task;function count" line per stack,
+the input of flamegraph.pl, speedscope and inferno
+
+Dump, text:
+header : lines starting with "#", "# elf <sha256>" is the ELF SHA-256 of the running image
+sample : core, task, PC in hex and the sample count, tab separated
+
+The PCs are symbolized with addr2line against the build's ELF. With inlining the frames of the inlined functions are
+kept, outermost first, so a hot inlined helper shows under its caller. Only the interrupted PC is sampled, each stack is
+the task and the frames of that one PC.
+
+Usage: python profile_to_folded.py [--per-core] [--addr2line PATH] dump.txt build/m5stack_tab5.elf > folded.txt
+       curl http://192.168.4.1/api/profile | python profile_to_folded.py - build/m5stack_tab5.elf > folded.txt
+"""
+
+import argparse
+import collections
+import hashlib
+import subprocess
+import sys
+
+_addr2line = 'riscv32-esp-elf-addr2line'
+
+
+def read_dump(stream):
+    elf_sha = None
+    samples = []
+    for line in stream:
+        line = line.rstrip('\n')
+        if not line:
+            continue
+        if line.startswith('#'):
+            fields = line[1:].split()
+            if len(fields) == 2 and fields[0] == 'elf':
+                elf_sha = fields[1]
+            continue
+        core, task, pc, count = line.split('\t')
+        samples.append((int(core), task, int(pc, 16), int(count)))
+    return elf_sha, samples
+
+
+def elf_sha256(path):
+    digest = hashlib.sha256()
+    with open(path, 'rb') as f:
+        for block in iter(lambda: f.read(1 << 16), b''):
+            digest.update(block)
+    return digest.hexdigest()
+
+
+# PC to its frames, outermost first
+def symbolize(addr2line, elf, pcs):
+    pcs = sorted(pcs)
+    stdin = ''.join('0x{:08x}\n'.format(pc) for pc in pcs)
+    # -a puts the address before the function and location pairs of each one
+    out = subprocess.run([addr2line, '-a', '-f', '-i', '-C', '-e', elf], input=stdin, capture_output=True, text=True,
+                         check=True).stdout.splitlines()
+
+    frames = {}
+    pc = None
+    i = 0
+    while i < len(out):
+        if out[i].startswith('0x'):
+            pc = int(out[i], 16)
+            frames[pc] = []
+            i += 1
+            continue
+        if out[i] != '??':
+            frames[pc].append(out[i])
+        i += 2
+    for pc in pcs:
+        # addr2line prints the innermost frame first
+        names = list(reversed(frames.get(pc, [])))
+        frames[pc] = names if names else ['0x{:08x}'.format(pc)]
+    return frames
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('dump', help='dump file, - for stdin')
+    parser.add_argument('elf', help='ELF of the image the dump was taken on')
+    parser.add_argument('--per-core', action='store_true', help='put the core at the root of each stack')
+    parser.add_argument('--addr2line', default=_addr2line, help='addr2line of the RISC-V toolchain')
+    args = parser.parse_args()
+
+    if args.dump == '-':
+        elf_sha, samples = read_dump(sys.stdin)
+    else:
+        with open(args.dump) as f:
+            elf_sha, samples = read_dump(f)
+
+    if elf_sha and elf_sha256(args.elf) != elf_sha:
+        print('warning: the dump was taken on another build, symbols will be wrong', file=sys.stderr)
+
+    frames = symbolize(args.addr2line, args.elf, {pc for _, _, pc, _ in samples})
+    stacks = collections.Counter()
+    for core, task, pc, count in samples:
+        root = ['core{}'.format(core)] if args.per_core else []
+        stacks[';'.join(root + [task] + frames[pc])] += count
+    for stack, count in sorted(stacks.items()):
+        print('{} {}'.format(stack, count))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,169 @@
+"""
+Turn a sampling profiler dump from hal_profiler.cpp into an ESP-IDF linker fragment that places the hottest functions
+in internal RAM, so they stop missing the cache against the image in PSRAM
+
+The sampled PCs are matched against the input sections of the build's linker map. With function sections every
+function is its own .text.<name> section, so the samples add up per function without addr2line. The functions are taken
+hottest first until --budget-kb of internal RAM is used or --coverage of the samples in the image is reached, and
+written as `object:symbol (noflash)` entries, by archive. With --tables the read-only data of their objects goes along
+(noflash_data) while it fits the budget, e.g. LVGL's blend and font tables.
+
+main/CMakeLists.txt picks up main/hot_code.lf when it is there. Take the dump under the load to optimize, regenerate
+it after larger changes, the section names of an older build may have gone:
+
+Usage: python profile_to_linker_fragment.py [--budget-kb N] [--tables] dump.txt build/m5stack_tab5.map \\
+           > main/hot_code.lf
+       curl http://192.168.4.1/api/profile | python profile_to_linker_fragment.py - build/m5stack_tab5.map > ...
+"""
+
+import argparse
+import bisect
+import collections
+import os
+import re
+import sys
+
+from profile_to_folded import read_dump
+
+# Instruction bus window of the image, flash or PSRAM through the MMU. Internal RAM and TCM are outside it
+_image_text_start = 0x40000000
+_image_text_end = 0x4C000000
+
+# ldgen takes plain identifiers as symbols, clones like foo.part.0 are left out
+_symbol_re = re.compile(r'^[A-Za-z_][A-Za-z0-9_]*$')
+_section_re = re.compile(r'^ (\.(?:text|rodata)\.\S+)(?:\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(\S+))?$')
+_continued_re = re.compile(r'^\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(\S+)$')
+_input_re = re.compile(r'^(?:.*/)?([^/(]+\.a)\(([^)]+)\)$')
+
+Section = collections.namedtuple('Section', 'name address size archive obj')
+
+
+# Input sections of the archives, from the GNU ld map
+def read_map(path):
+    sections = []
+    is_memory_map = False
+    pending = None
+    with open(path) as f:
+        for line in f:
+            line = line.rstrip('\n')
+            if not is_memory_map:
+                is_memory_map = line.startswith('Linker script and memory map')
+                continue
+            if pending:
+                match = _continued_re.match(line)
+                fields = (pending,) + match.groups() if match else None
+                pending = None
+            else:
+                match = _section_re.match(line)
+                if not match:
+                    continue
+                if match.group(2) is None:
+                    # Long names put the address on the next line
+                    pending = match.group(1)
+                    continue
+                fields = match.groups()
+            if not fields:
+                continue
+            name, address, size, source = fields[0], int(fields[1], 16), int(fields[2], 16), fields[3]
+            source_match = _input_re.match(source)
+            if size == 0 or not source_match:
+                continue
+            archive, obj = source_match.groups()
+            # ldgen matches the object as <obj>.*, e.g. lv_draw_sw_blend.c.obj is lv_draw_sw_blend
+            sections.append(Section(name, address, size, archive, obj.split('.')[0]))
+    return sections
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('dump', help='dump file, - for stdin')
+    parser.add_argument('map', help='linker map of the image the dump was taken on')
+    parser.add_argument('--budget-kb', type=int, default=64, help='internal RAM to use, default 64')
+    parser.add_argument('--coverage', type=float, default=0.9, help='share of the image samples to cover, default 0.9')
+    parser.add_argument('--min-samples', type=int, default=10, help='leave out colder functions, default 10')
+    parser.add_argument('--tables', action='store_true', help='place the read-only data of their objects too')
+    args = parser.parse_args()
+
+    if args.dump == '-':
+        _, samples = read_dump(sys.stdin)
+    else:
+        with open(args.dump) as f:
+            _, samples = read_dump(f)
+
+    sections = read_map(args.map)
+    texts = sorted((s for s in sections if s.name.startswith('.text.')), key=lambda s: s.address)
+    starts = [s.address for s in texts]
+
+    # Samples already in internal RAM count for nothing, those outside a known function are reported only
+    hits = collections.Counter()
+    image_samples = 0
+    unknown_samples = 0
+    for _, _, pc, count in samples:
+        if not _image_text_start <= pc < _image_text_end:
+            continue
+        image_samples += count
+        i = bisect.bisect_right(starts, pc) - 1
+        if i >= 0 and pc < texts[i].address + texts[i].size:
+            hits[texts[i]] += count
+        else:
+            unknown_samples += count
+    if image_samples == 0:
+        sys.exit('no samples in the image, was the profiler running?')
+
+    budget = args.budget_kb * 1024
+    used = 0
+    covered = 0
+    chosen = []
+    for section, count in hits.most_common():
+        if count < args.min_samples or covered >= args.coverage * image_samples:
+            break
+        symbol = section.name[len('.text.'):]
+        if not _symbol_re.match(symbol):
+            print('skipped {} ({} samples): not a plain symbol'.format(symbol, count), file=sys.stderr)
+            continue
+        if used + section.size > budget:
+            continue
+        used += section.size
+        covered += count
+        chosen.append((section, symbol, count))
+
+    # Tables of the chosen objects, the smallest first so more of them fit
+    tables = []
+    if args.tables:
+        rodata = collections.Counter()
+        for s in sections:
+            if s.name.startswith('.rodata.'):
+                rodata[(s.archive, s.obj)] += s.size
+        objects = {(s.archive, s.obj) for s, _, _ in chosen}
+        for key in sorted(objects, key=lambda key: rodata[key]):
+            if rodata[key] and used + rodata[key] <= budget:
+                used += rodata[key]
+                tables.append(key)
+
+    by_archive = collections.defaultdict(list)
+    for section, symbol, count in chosen:
+        by_archive[section.archive].append('{}:{} (noflash)'.format(section.obj, symbol))
+    for archive, obj in tables:
+        by_archive[archive].append('{} (noflash_data)'.format(obj))
+
+    dump_name = 'stdin' if args.dump == '-' else os.path.basename(args.dump)
+    print('# Generated by tools/profile_to_linker_fragment.py from {}, do not edit'.format(dump_name))
+    print('# {} functions, {:.1f}% of {} samples in the image, {} bytes of internal RAM'.format(
+        len(chosen), 100.0 * covered / image_samples, image_samples, used))
+    for archive in sorted(by_archive):
+        print()
+        print('[mapping:hot_code_{}]'.format(re.sub(r'\W', '_', archive[:-len('.a')])))
+        print('archive: {}'.format(archive))
+        print('entries:')
+        for entry in sorted(by_archive[archive]):
+            print('    {}'.format(entry))
+
+    for section, symbol, count in chosen:
+        print('{:6.2f}%  {:6}  {}  {}'.format(100.0 * count / image_samples, section.size, section.archive, symbol),
+              file=sys.stderr)
+    if unknown_samples:
+        print('{} samples outside a function section of the map'.format(unknown_samples), file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()